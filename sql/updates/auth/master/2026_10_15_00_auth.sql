@@ -0,0 +1,8 @@
+--
+DELETE FROM `rbac_permissions` WHERE `id`=884;
+INSERT INTO `rbac_permissions` (`id`,`name`) VALUES
+(884,'Command: reload hotfixes');
+
+DELETE FROM `rbac_linked_permissions` WHERE `linkedId`=884;
+INSERT INTO `rbac_linked_permissions` (`id`,`linkedId`) VALUES
+(196,884);
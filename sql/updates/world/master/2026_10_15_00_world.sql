@@ -0,0 +1,4 @@
+--
+DELETE FROM `command` WHERE `name`='reload hotfixes';
+INSERT INTO `command` (`name`,`help`) VALUES
+('reload hotfixes','Syntax: .reload hotfixes\r\nReload hotfix_data and hotfix_blob tables in the background, new hotfixes are sent to clients logging in after the reload.');
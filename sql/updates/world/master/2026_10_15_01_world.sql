@@ -0,0 +1,4 @@
+--
+DELETE FROM `command` WHERE `name`='debug snapshot invalidate';
+INSERT INTO `command` (`name`,`help`) VALUES
+('debug snapshot invalidate','Syntax: .debug snapshot invalidate\r\nDelete the world database snapshot file, it is rebuilt from the world database on the next start.');
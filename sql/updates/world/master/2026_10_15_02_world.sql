@@ -0,0 +1,4 @@
+--
+DELETE FROM `command` WHERE `name`='debug trace dump';
+INSERT INTO `command` (`name`,`help`) VALUES
+('debug trace dump','Syntax: .debug trace dump [$seconds]\r\nWrite the traced zones of the last $seconds (default 10) to a Chrome trace file in the logs directory. Requires a build with WITH_TRACING defined.');
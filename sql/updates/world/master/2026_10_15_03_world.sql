@@ -0,0 +1,4 @@
+--
+DELETE FROM `command` WHERE `name`='debug scriptstats';
+INSERT INTO `command` (`name`,`help`) VALUES
+('debug scriptstats','Syntax: .debug scriptstats [$count|reset]\r\nList the $count (default 20) script hooks with the highest sampled time, or reset the collected statistics. Requires ScriptProfiler.SampleRate to be set.');
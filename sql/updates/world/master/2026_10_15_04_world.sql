@@ -0,0 +1,6 @@
+--
+DELETE FROM `command` WHERE `name` IN ('debug replay start','debug replay stop','debug replay status');
+INSERT INTO `command` (`name`,`help`) VALUES
+('debug replay start','Syntax: .debug replay start $fileName [$tickDiff]\r\nReplay the client packets of a PacketLog capture into the sessions of all other players in world, one captured connection per session, advancing every $tickDiff milliseconds (default 50).'),
+('debug replay stop','Syntax: .debug replay stop\r\nStop the running packet replay and show its results.'),
+('debug replay status','Syntax: .debug replay status\r\nShow the progress and the world and map update times of the running packet replay.');
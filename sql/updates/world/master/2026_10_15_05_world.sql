@@ -0,0 +1,4 @@
+--
+DELETE FROM `command` WHERE `name`='server memory';
+INSERT INTO `command` (`name`,`help`) VALUES
+('server memory','Syntax: .server memory\r\nShow allocator statistics when linked against jemalloc and the estimated memory used by each subsystem.');
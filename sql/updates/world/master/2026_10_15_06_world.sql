@@ -0,0 +1,4 @@
+--
+DELETE FROM `command` WHERE `name`='debug mapprofile';
+INSERT INTO `command` (`name`,`help`) VALUES
+('debug mapprofile','Syntax: .debug mapprofile [on|off] $mapId [$instanceId]\r\nEnable or disable update phase profiling of all instances of $mapId or only of $instanceId. Without on or off, show the update phase breakdown and the most expensive creatures of the matching maps.');
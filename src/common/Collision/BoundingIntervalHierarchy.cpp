@@ -274,6 +274,19 @@ bool BIH::readFromFile(FILE* rf)
     return uint64(check) == uint64(3 + 3 + 1 + 1 + uint64(treeSize) + uint64(count));
 }
 
+bool BIH::readFromMemory(VMAP::MappedFileReader& reader)
+{
+    uint32 treeSize;
+    G3D::Vector3 lo, hi;
+    uint32 count = 0;
+    if (!reader.read(&lo, sizeof(float) * 3) || !reader.read(&hi, sizeof(float) * 3))
+        return false;
+    bounds = G3D::AABox(lo, hi);
+    if (!reader.read(&treeSize, sizeof(uint32)) || !reader.map(tree, treeSize))
+        return false;
+    return reader.read(&count, sizeof(uint32)) && reader.map(objects, count);
+}
+
 void BIH::BuildStats::updateLeaf(int depth, int n)
 {
     numLeaves++;
@@ -23,9 +23,11 @@
 #include <G3D/AABox.h>
 
 #include "Define.h"
+#include "MappableArray.h"
 
 #include <stdexcept>
 #include <vector>
+#include <cmath>
 #include <algorithm>
 #include <limits>
 #include "string.h"
@@ -71,7 +73,8 @@ class TC_COMMON_API BIH
             objects.clear();
             // create space for the first node
             tree.push_back(3u << 30u); // dummy leaf
-            tree.insert(tree.end(), 2, 0);
+            tree.push_back(0);
+            tree.push_back(0);
         }
     public:
         BIH() { init_empty(); }
@@ -112,37 +115,35 @@ class TC_COMMON_API BIH
         }
         uint32 primCount() const { return uint32(objects.size()); }
 
+        /// Recomputes the clip planes of all nodes from the current bounds of the primitives the tree was built from,
+        /// the structure of the tree is kept. Returns the summed surface area of all nodes, it grows as the tree gets worse.
+        template <class BoundsFunc, class PrimArray>
+        float refit(PrimArray const& primitives, BoundsFunc& getBounds)
+        {
+            if (objects.empty())
+                return 0.0f;
+
+            float cost = 0.0f;
+            AABound treeBound;
+            refitNode(0, primitives, getBounds, treeBound, cost);
+            bounds = G3D::AABox(treeBound.lo, treeBound.hi);
+            return cost;
+        }
+
+        // rays traversed together by intersectRays, the lane loops are written to be vectorized by the compiler
+        static constexpr uint32 RayPacketSize = 8;
+
         template<typename RayCallback>
         void intersectRay(const G3D::Ray &r, RayCallback& intersectCallback, float &maxDist, bool stopAtFirst = false) const
         {
-            float intervalMin = -1.f;
-            float intervalMax = -1.f;
+            float intervalMin;
+            float intervalMax;
+            if (!clipToBounds(r, maxDist, intervalMin, intervalMax))
+                return;
+
             G3D::Vector3 const& org = r.origin();
             G3D::Vector3 const& dir = r.direction();
             G3D::Vector3 const& invDir = r.invDirection();
-            for (int i=0; i<3; ++i)
-            {
-                if (G3D::fuzzyNe(dir[i], 0.0f))
-                {
-                    float t1 = (bounds.low()[i]  - org[i]) * invDir[i];
-                    float t2 = (bounds.high()[i] - org[i]) * invDir[i];
-                    if (t1 > t2)
-                        std::swap(t1, t2);
-                    if (t1 > intervalMin)
-                        intervalMin = t1;
-                    if (t2 < intervalMax || intervalMax < 0.f)
-                        intervalMax = t2;
-                    // intervalMax can only become smaller for other axis,
-                    //  and intervalMin only larger respectively, so stop early
-                    if (intervalMax <= 0 || intervalMin >= maxDist)
-                        return;
-                }
-            }
-
-            if (intervalMin > intervalMax)
-                return;
-            intervalMin = std::max(intervalMin, 0.f);
-            intervalMax = std::min(intervalMax, maxDist);
 
             uint32 offsetFront[3];
             uint32 offsetBack[3];
@@ -250,6 +251,194 @@ class TC_COMMON_API BIH
             }
         }
 
+        /// Traverses the tree with up to RayPacketSize rays at once, nodes are only fetched once for all rays passing them.
+        /// rays and maxDist must hold RayPacketSize elements, rayMask selects the ones to test.
+        /// intersectCallback is called with the index of the ray as first argument.
+        template<typename RayCallback>
+        void intersectRays(G3D::Ray const* rays, uint32 rayMask, RayCallback& intersectCallback, float* maxDist, bool stopAtFirst = false) const
+        {
+            float intervalMin[RayPacketSize] = { };
+            float intervalMax[RayPacketSize] = { };
+            for (uint32 ray = 0; ray < RayPacketSize; ++ray)
+            {
+                if (!(rayMask & (1 << ray)))
+                    continue;
+
+                if (!clipToBounds(rays[ray], maxDist[ray], intervalMin[ray], intervalMax[ray]))
+                    rayMask &= ~(1 << ray);
+            }
+
+            if (!rayMask)
+                return;
+
+            // components of all rays next to each other
+            float org[3][RayPacketSize];
+            float invDir[3][RayPacketSize];
+            bool negative[3][RayPacketSize];
+            for (uint32 ray = 0; ray < RayPacketSize; ++ray)
+            {
+                for (int i = 0; i < 3; ++i)
+                {
+                    org[i][ray] = rays[ray].origin()[i];
+                    invDir[i][ray] = rays[ray].invDirection()[i];
+                    negative[i][ray] = (floatToRawIntBits(rays[ray].direction()[i]) >> 31) != 0;
+                }
+            }
+
+            struct PacketStackNode
+            {
+                uint32 node;
+                uint32 rayMask;
+                float tnear[RayPacketSize];
+                float tfar[RayPacketSize];
+            };
+
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            int node = 0;
+            // rays not yet done, a ray stops at its first hit if requested
+            uint32 activeMask = rayMask;
+
+            while (true) {
+                while (true)
+                {
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = (tn & (1 << 29)) != 0;
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node, same decisions as intersectRay made for every ray
+                            float leftClip = intBitsToFloat(tree[node + 1]);
+                            float rightClip = intBitsToFloat(tree[node + 2]);
+                            float tl[RayPacketSize];
+                            float tr[RayPacketSize];
+                            uint32 leftMask = 0;
+                            uint32 rightMask = 0;
+                            for (uint32 ray = 0; ray < RayPacketSize; ++ray)
+                            {
+                                tl[ray] = (leftClip - org[axis][ray]) * invDir[axis][ray];
+                                tr[ray] = (rightClip - org[axis][ray]) * invDir[axis][ray];
+                                // the front node is the left one for rays going along the axis
+                                bool leftHit = negative[axis][ray] ? !(tl[ray] > intervalMax[ray]) : !(tl[ray] < intervalMin[ray]);
+                                bool rightHit = negative[axis][ray] ? !(tr[ray] < intervalMin[ray]) : !(tr[ray] > intervalMax[ray]);
+                                leftMask |= uint32(leftHit) << ray;
+                                rightMask |= uint32(rightHit) << ray;
+                            }
+
+                            leftMask &= rayMask;
+                            rightMask &= rayMask;
+                            // all rays pass between clip zones
+                            if (!leftMask && !rightMask)
+                                break;
+
+                            if (leftMask && rightMask)
+                            {
+                                // push back right node
+                                PacketStackNode& right = stack[stackPos];
+                                right.node = offset + 3;
+                                right.rayMask = rightMask;
+                                for (uint32 ray = 0; ray < RayPacketSize; ++ray)
+                                {
+                                    right.tnear[ray] = (!negative[axis][ray] && tr[ray] >= intervalMin[ray]) ? tr[ray] : intervalMin[ray];
+                                    right.tfar[ray] = (negative[axis][ray] && tr[ray] <= intervalMax[ray]) ? tr[ray] : intervalMax[ray];
+                                }
+                                stackPos++;
+                            }
+
+                            if (leftMask)
+                            {
+                                node = offset;
+                                rayMask = leftMask;
+                                for (uint32 ray = 0; ray < RayPacketSize; ++ray)
+                                {
+                                    intervalMin[ray] = (negative[axis][ray] && tl[ray] >= intervalMin[ray]) ? tl[ray] : intervalMin[ray];
+                                    intervalMax[ray] = (!negative[axis][ray] && tl[ray] <= intervalMax[ray]) ? tl[ray] : intervalMax[ray];
+                                }
+                            }
+                            else
+                            {
+                                node = offset + 3;
+                                rayMask = rightMask;
+                                for (uint32 ray = 0; ray < RayPacketSize; ++ray)
+                                {
+                                    intervalMin[ray] = (!negative[axis][ray] && tr[ray] >= intervalMin[ray]) ? tr[ray] : intervalMin[ray];
+                                    intervalMax[ray] = (negative[axis][ray] && tr[ray] <= intervalMax[ray]) ? tr[ray] : intervalMax[ray];
+                                }
+                            }
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects
+                            int n = tree[node + 1];
+                            while (n > 0) {
+                                for (uint32 ray = 0; ray < RayPacketSize; ++ray)
+                                {
+                                    if (!(rayMask & (1 << ray)))
+                                        continue;
+
+                                    bool hit = intersectCallback(ray, rays[ray], objects[offset], maxDist[ray], stopAtFirst);
+                                    if (stopAtFirst && hit)
+                                    {
+                                        rayMask &= ~(1 << ray);
+                                        activeMask &= ~(1 << ray);
+                                    }
+                                }
+                                if (!activeMask)
+                                    return;
+                                --n;
+                                ++offset;
+                            }
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (axis>2)
+                            return; // should not happen
+                        float leftClip = intBitsToFloat(tree[node + 1]);
+                        float rightClip = intBitsToFloat(tree[node + 2]);
+                        for (uint32 ray = 0; ray < RayPacketSize; ++ray)
+                        {
+                            float tl = (leftClip - org[axis][ray]) * invDir[axis][ray];
+                            float tr = (rightClip - org[axis][ray]) * invDir[axis][ray];
+                            float tf = negative[axis][ray] ? tr : tl;
+                            float tb = negative[axis][ray] ? tl : tr;
+                            intervalMin[ray] = (tf >= intervalMin[ray]) ? tf : intervalMin[ray];
+                            intervalMax[ray] = (tb <= intervalMax[ray]) ? tb : intervalMax[ray];
+                            if (intervalMin[ray] > intervalMax[ray])
+                                rayMask &= ~(1 << ray);
+                        }
+                        node = offset;
+                        if (!rayMask)
+                            break;
+                        continue;
+                    }
+                } // traversal loop
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                        return;
+                    // move back up the stack
+                    stackPos--;
+                    rayMask = stack[stackPos].rayMask & activeMask;
+                    for (uint32 ray = 0; ray < RayPacketSize; ++ray)
+                        if (maxDist[ray] < stack[stackPos].tnear[ray])
+                            rayMask &= ~(1 << ray);
+                    if (!rayMask)
+                        continue;
+                    node = stack[stackPos].node;
+                    memcpy(intervalMin, stack[stackPos].tnear, sizeof(intervalMin));
+                    memcpy(intervalMax, stack[stackPos].tfar, sizeof(intervalMax));
+                    break;
+                } while (true);
+            }
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const G3D::Vector3 &p, IsectCallback& intersectCallback) const
         {
@@ -330,12 +519,101 @@ class TC_COMMON_API BIH
 
         bool writeToFile(FILE* wf) const;
         bool readFromFile(FILE* rf);
+        //! nodes and objects point into the mapped file afterwards
+        bool readFromMemory(VMAP::MappedFileReader& reader);
 
     protected:
-        std::vector<uint32> tree;
-        std::vector<uint32> objects;
+        VMAP::MappableArray<uint32> tree;
+        VMAP::MappableArray<uint32> objects;
         G3D::AABox bounds;
 
+        // interval of the ray inside the bounds of the tree, false if it misses them
+        bool clipToBounds(G3D::Ray const& r, float maxDist, float& intervalMin, float& intervalMax) const
+        {
+            intervalMin = -1.f;
+            intervalMax = -1.f;
+            G3D::Vector3 const& org = r.origin();
+            G3D::Vector3 const& dir = r.direction();
+            G3D::Vector3 const& invDir = r.invDirection();
+            for (int i=0; i<3; ++i)
+            {
+                if (G3D::fuzzyNe(dir[i], 0.0f))
+                {
+                    float t1 = (bounds.low()[i]  - org[i]) * invDir[i];
+                    float t2 = (bounds.high()[i] - org[i]) * invDir[i];
+                    if (t1 > t2)
+                        std::swap(t1, t2);
+                    if (t1 > intervalMin)
+                        intervalMin = t1;
+                    if (t2 < intervalMax || intervalMax < 0.f)
+                        intervalMax = t2;
+                    // intervalMax can only become smaller for other axis,
+                    //  and intervalMin only larger respectively, so stop early
+                    if (intervalMax <= 0 || intervalMin >= maxDist)
+                        return false;
+                }
+            }
+
+            if (intervalMin > intervalMax)
+                return false;
+            intervalMin = std::max(intervalMin, 0.f);
+            intervalMax = std::min(intervalMax, maxDist);
+            return true;
+        }
+
+        template <class BoundsFunc, class PrimArray>
+        void refitNode(uint32 node, PrimArray const& primitives, BoundsFunc& getBounds, AABound& nodeBound, float& cost)
+        {
+            nodeBound.lo = G3D::Vector3(G3D::finf(), G3D::finf(), G3D::finf());
+            nodeBound.hi = -nodeBound.lo;
+            uint32 tn = tree[node];
+            uint32 axis = (tn & (3 << 30)) >> 30;
+            bool BVH2 = (tn & (1 << 29)) != 0;
+            int offset = tn & ~(7 << 29);
+            if (BVH2)
+            {
+                // clips the space of its only child, which already counts it
+                refitNode(offset, primitives, getBounds, nodeBound, cost);
+                tree[node + 1] = floatToRawIntBits(nodeBound.lo[axis]);
+                tree[node + 2] = floatToRawIntBits(nodeBound.hi[axis]);
+                return;
+            }
+
+            if (axis < 3)
+            {
+                // a missing child is marked by an infinite clip plane
+                AABound childBound;
+                if (!std::isinf(intBitsToFloat(tree[node + 1])))
+                {
+                    refitNode(offset, primitives, getBounds, childBound, cost);
+                    tree[node + 1] = floatToRawIntBits(childBound.hi[axis]);
+                    nodeBound.lo = nodeBound.lo.min(childBound.lo);
+                    nodeBound.hi = nodeBound.hi.max(childBound.hi);
+                }
+                if (!std::isinf(intBitsToFloat(tree[node + 2])))
+                {
+                    refitNode(offset + 3, primitives, getBounds, childBound, cost);
+                    tree[node + 2] = floatToRawIntBits(childBound.lo[axis]);
+                    nodeBound.lo = nodeBound.lo.min(childBound.lo);
+                    nodeBound.hi = nodeBound.hi.max(childBound.hi);
+                }
+            }
+            else
+            {
+                G3D::AABox primBound;
+                for (uint32 i = 0; i < tree[node + 1]; ++i)
+                {
+                    getBounds(primitives[objects[offset + i]], primBound);
+                    nodeBound.lo = nodeBound.lo.min(primBound.low());
+                    nodeBound.hi = nodeBound.hi.max(primBound.high());
+                }
+            }
+
+            G3D::Vector3 d(nodeBound.hi - nodeBound.lo);
+            if (d.x >= 0.0f && d.y >= 0.0f && d.z >= 0.0f)
+                cost += 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+        }
+
         struct buildData
         {
             uint32 *indices;
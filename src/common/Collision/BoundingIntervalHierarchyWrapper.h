@@ -62,9 +62,24 @@ class BIHWrap
     G3D::Table<const T*, uint32> m_obj2Idx;
     G3D::Set<const T*> m_objects_to_push;
     int unbalanced_times;
+    bool refit_pending;
+    float build_cost;
+
+    // moved objects are refitted into the tree until it got this much worse than a fresh build
+    static constexpr float MAX_REFIT_COST_RATIO = 1.5f;
+
+    void refit()
+    {
+        refit_pending = false;
+        if (m_tree.refit(m_objects, BoundsFunc::getBounds2) > build_cost * MAX_REFIT_COST_RATIO)
+        {
+            ++unbalanced_times;
+            balance();
+        }
+    }
 
 public:
-    BIHWrap() : unbalanced_times(0) { }
+    BIHWrap() : unbalanced_times(0), refit_pending(false), build_cost(0.0f) { }
 
     void insert(const T& obj)
     {
@@ -83,10 +98,20 @@ public:
             m_objects_to_push.remove(&obj);
     }
 
+    /// obj changed its bounds but is still in this tree
+    void relocate(const T& /*obj*/)
+    {
+        refit_pending = true;
+    }
+
     void balance()
     {
         if (unbalanced_times == 0)
+        {
+            if (refit_pending)
+                refit();
             return;
+        }
 
         unbalanced_times = 0;
         m_objects.fastClear();
@@ -95,6 +120,8 @@ public:
         //assert that m_obj2Idx has all the keys
 
         m_tree.build(m_objects, BoundsFunc::getBounds2);
+        refit_pending = false;
+        build_cost = m_tree.refit(m_objects, BoundsFunc::getBounds2);
     }
 
     template<typename RayCallback>
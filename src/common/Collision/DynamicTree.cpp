@@ -81,6 +81,12 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
         ++unbalanced_times;
     }
 
+    void relocate(Model const& mdl)
+    {
+        base::relocate(mdl);
+        ++unbalanced_times;
+    }
+
     void balance()
     {
         base::balance();
@@ -122,6 +128,11 @@ void DynamicMapTree::remove(GameObjectModel const& mdl)
     impl->remove(mdl);
 }
 
+void DynamicMapTree::relocate(GameObjectModel const& mdl)
+{
+    impl->relocate(mdl);
+}
+
 bool DynamicMapTree::contains(GameObjectModel const& mdl) const
 {
     return impl->contains(mdl);
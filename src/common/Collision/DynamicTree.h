@@ -54,6 +54,8 @@ public:
 
     void insert(GameObjectModel const&);
     void remove(GameObjectModel const&);
+    // the model is in the tree and its bounds changed
+    void relocate(GameObjectModel const&);
     bool contains(GameObjectModel const&) const;
 
     void balance();
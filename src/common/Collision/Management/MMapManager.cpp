@@ -17,14 +17,22 @@
 
 #include "MMapManager.h"
 #include "Errors.h"
+#include "Hash.h"
 #include "Log.h"
 #include "MMapDefines.h"
+#include <algorithm>
 
 namespace MMAP
 {
     constexpr char MAP_FILE_NAME_FORMAT[] = "{}mmaps/{:04}.mmap";
     constexpr char TILE_FILE_NAME_FORMAT[] = "{}mmaps/{:04}{:02}{:02}.mmtile";
 
+    static std::size_t getTileDataSize(dtNavMesh const* navMesh, dtTileRef tileRef)
+    {
+        dtMeshTile const* tile = navMesh->getTileByRef(tileRef);
+        return tile ? tile->dataSize : 0;
+    }
+
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
@@ -195,10 +203,13 @@ namespace MMAP
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
+        std::unique_lock<std::shared_mutex> lock(mmap->navMeshLock);
         if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
+            mmap->pathCorridorCache.Clear();
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
+            loadedTilesMemory += fileHeader.size;
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile {:04}[{:02}, {:02}] into {:04}[{:02}, {:02}]", mapId, x, y, mapId, header->x, header->y);
             return true;
         }
@@ -258,6 +269,8 @@ namespace MMAP
         }
 
         // unload, and mark as non loaded
+        std::unique_lock<std::shared_mutex> lock(mmap->navMeshLock);
+        std::size_t tileSize = getTileDataSize(mmap->navMesh, tileRefItr->second);
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRefItr->second, nullptr, nullptr)))
         {
             // this is technically a memory leak
@@ -268,8 +281,10 @@ namespace MMAP
         }
         else
         {
+            mmap->pathCorridorCache.Clear();
             mmap->loadedTileRefs.erase(tileRefItr);
             --loadedTiles;
+            loadedTilesMemory -= tileSize;
             TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile {:04}[{:02}, {:02}] from {:03}", mapId, x, y, mapId);
             return true;
         }
@@ -289,19 +304,23 @@ namespace MMAP
 
         // unload all tiles from given map
         MMapData* mmap = itr->second;
+        std::unique_lock<std::shared_mutex> lock(mmap->navMeshLock);
         for (MMapTileSet::iterator i = mmap->loadedTileRefs.begin(); i != mmap->loadedTileRefs.end(); ++i)
         {
             uint32 x = (i->first >> 16);
             uint32 y = (i->first & 0x0000FFFF);
+            std::size_t tileSize = getTileDataSize(mmap->navMesh, i->second);
             if (dtStatusFailed(mmap->navMesh->removeTile(i->second, nullptr, nullptr)))
                 TC_LOG_ERROR("maps", "MMAP:unloadMap: Could not unload {:04}{:02}{:02}.mmtile from navmesh", mapId, x, y);
             else
             {
                 --loadedTiles;
+                loadedTilesMemory -= tileSize;
                 TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile {:04}[{:02}, {:02}] from {:04}", mapId, x, y, mapId);
             }
         }
 
+        lock.unlock();
         delete mmap;
         itr->second = nullptr;
         TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded {:04}.mmap", mapId);
@@ -336,6 +355,34 @@ namespace MMAP
         return true;
     }
 
+    dtNavMeshQuery const* MMapManager::GetNavMeshQueryForCurrentThread(uint32 mapId)
+    {
+        auto itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        MMapData* mmap = itr->second;
+        std::lock_guard<std::mutex> lock(mmap->threadNavMeshQueriesLock);
+        auto [queryItr, inserted] = mmap->threadNavMeshQueries.try_emplace(std::this_thread::get_id(), nullptr);
+        if (!inserted)
+            return queryItr->second;
+
+        // allocate mesh query
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            mmap->threadNavMeshQueries.erase(queryItr);
+            TC_LOG_ERROR("maps", "MMAP:GetNavMeshQueryForCurrentThread: Failed to initialize dtNavMeshQuery for mapId {:04}", mapId);
+            return nullptr;
+        }
+
+        TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQueryForCurrentThread: created dtNavMeshQuery for mapId {:04}, {} threads use this navmesh", mapId, mmap->threadNavMeshQueries.size());
+        queryItr->second = query;
+        return query;
+    }
+
     dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
@@ -345,6 +392,90 @@ namespace MMAP
         return itr->second->navMesh;
     }
 
+    PathCorridorCache* MMapManager::GetPathCorridorCache(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        return &itr->second->pathCorridorCache;
+    }
+
+    std::shared_lock<std::shared_mutex> MMapManager::LockNavMeshForQuery(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return {};
+
+        return std::shared_lock<std::shared_mutex>(itr->second->navMeshLock);
+    }
+
+    std::atomic<uint64> PathCorridorCache::_hits;
+    std::atomic<uint64> PathCorridorCache::_misses;
+
+    std::size_t PathCorridorCache::KeyHash::operator()(Key const& key) const
+    {
+        std::size_t hashVal = 0;
+        Trinity::hash_combine(hashVal, key.StartPoly);
+        Trinity::hash_combine(hashVal, key.EndPoly);
+        Trinity::hash_combine(hashVal, key.IncludeFlags);
+        Trinity::hash_combine(hashVal, key.ExcludeFlags);
+        return hashVal;
+    }
+
+    uint32 PathCorridorCache::Find(dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags, dtPolyRef* corridor, uint32 maxLength)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto itr = _entriesByKey.find({ startPoly, endPoly, includeFlags, excludeFlags });
+        if (itr == _entriesByKey.end() || itr->second->second.size() > maxLength)
+        {
+            ++_misses;
+            return 0;
+        }
+
+        ++_hits;
+        _entries.splice(_entries.begin(), _entries, itr->second);
+        std::vector<dtPolyRef> const& cached = itr->second->second;
+        std::copy(cached.begin(), cached.end(), corridor);
+        return uint32(cached.size());
+    }
+
+    void PathCorridorCache::Store(dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags, dtPolyRef const* corridor, uint32 length)
+    {
+        Key key{ startPoly, endPoly, includeFlags, excludeFlags };
+        std::lock_guard<std::mutex> lock(_lock);
+        auto [itr, inserted] = _entriesByKey.try_emplace(key);
+        if (!inserted)
+        {
+            // another thread searched the same corridor concurrently
+            itr->second->second.assign(corridor, corridor + length);
+            _entries.splice(_entries.begin(), _entries, itr->second);
+            return;
+        }
+
+        _entries.emplace_front(key, std::vector<dtPolyRef>(corridor, corridor + length));
+        itr->second = _entries.begin();
+
+        if (_entries.size() > MaxEntries)
+        {
+            _entriesByKey.erase(_entries.back().first);
+            _entries.pop_back();
+        }
+    }
+
+    void PathCorridorCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _entries.clear();
+        _entriesByKey.clear();
+    }
+
+    void PathCorridorCache::ConsumeStatistics(uint64& hits, uint64& misses)
+    {
+        hits = _hits.exchange(0);
+        misses = _misses.exchange(0);
+    }
+
     dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
     {
         auto itr = GetMMapData(mapId);
@@ -21,7 +21,12 @@
 #include "Define.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -30,6 +35,48 @@ namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> ThreadNavMeshQuerySet;
+
+    // polygon corridors found by earlier path searches on a navmesh, least recently used ones are dropped first
+    class TC_COMMON_API PathCorridorCache
+    {
+        public:
+            static constexpr std::size_t MaxEntries = 1024;
+
+            // return: length of the corridor copied to [corridor], 0 if none is cached or it is longer than maxLength
+            uint32 Find(dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags, dtPolyRef* corridor, uint32 maxLength);
+            void Store(dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags, dtPolyRef const* corridor, uint32 length);
+            // polygon references and the best corridors change whenever tiles are added or removed
+            void Clear();
+
+            // lookups of all caches since the last call
+            static void ConsumeStatistics(uint64& hits, uint64& misses);
+
+        private:
+            struct Key
+            {
+                dtPolyRef StartPoly;
+                dtPolyRef EndPoly;
+                uint16 IncludeFlags;
+                uint16 ExcludeFlags;
+
+                bool operator==(Key const& right) const = default;
+            };
+
+            struct KeyHash
+            {
+                std::size_t operator()(Key const& key) const;
+            };
+
+            typedef std::list<std::pair<Key, std::vector<dtPolyRef>>> EntryList;
+
+            std::mutex _lock;
+            EntryList _entries;         // most recently used first
+            std::unordered_map<Key, EntryList::iterator, KeyHash> _entriesByKey;
+
+            static std::atomic<uint64> _hits;
+            static std::atomic<uint64> _misses;
+    };
 
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
@@ -40,6 +87,9 @@ namespace MMAP
             for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
                 dtFreeNavMeshQuery(i->second);
 
+            for (ThreadNavMeshQuerySet::iterator i = threadNavMeshQueries.begin(); i != threadNavMeshQueries.end(); ++i)
+                dtFreeNavMeshQuery(i->second);
+
             if (navMesh)
                 dtFreeNavMesh(navMesh);
         }
@@ -47,6 +97,15 @@ namespace MMAP
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
 
+        // queries of all threads that ever searched paths on this mesh, independent of the instance they updated
+        std::mutex threadNavMeshQueriesLock;
+        ThreadNavMeshQuerySet threadNavMeshQueries;
+
+        PathCorridorCache pathCorridorCache;
+
+        // tiles are only added and removed while this is held exclusively, path searches on other threads hold it shared
+        std::shared_mutex navMeshLock;
+
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
     };
@@ -58,7 +117,7 @@ namespace MMAP
     class TC_COMMON_API MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) {}
+            MMapManager() : loadedTiles(0), loadedTilesMemory(0), thread_safe_environment(true) {}
             ~MMapManager();
 
             void InitializeThreadUnsafe(std::unordered_map<uint32, std::vector<uint32>> const& mapData);
@@ -70,9 +129,15 @@ namespace MMAP
 
             // the returned [dtNavMeshQuery const*] is NOT threadsafe
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            // the returned [dtNavMeshQuery const*] may only be used by the calling thread
+            dtNavMeshQuery const* GetNavMeshQueryForCurrentThread(uint32 mapId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
+            PathCorridorCache* GetPathCorridorCache(uint32 mapId);
+            // must be held while polygons or tiles of the navmesh are accessed and released before anything that can load tiles
+            std::shared_lock<std::shared_mutex> LockNavMeshForQuery(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
+            std::size_t getLoadedTilesMemory() const { return loadedTilesMemory; }
             uint32 getLoadedMapsCount() const { return uint32(loadedMMaps.size()); }
         private:
             bool loadMapData(std::string const& basePath, uint32 mapId);
@@ -81,6 +146,7 @@ namespace MMAP
             MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+            std::atomic<std::size_t> loadedTilesMemory;             // read by the world thread for memory stats while map threads load tiles
             bool thread_safe_environment;
 
             std::unordered_map<uint32, uint32> parentMapData;
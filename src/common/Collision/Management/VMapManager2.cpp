@@ -54,6 +54,7 @@ namespace VMAP
         GetLiquidFlagsPtr = &GetLiquidFlagsDummy;
         IsVMAPDisabledForPtr = &IsVMAPDisabledForDummy;
         thread_safe_environment = true;
+        _backgroundTreeLoading = false;
     }
 
     VMapManager2::~VMapManager2()
@@ -114,6 +115,7 @@ namespace VMAP
         if (!isMapLoadingEnabled())
             return LoadResult::DisabledInConfig;
 
+        std::unique_lock<std::shared_mutex> lock(InstanceMapTreesLock);
         auto instanceTree = iInstanceMapTrees.find(mapId);
         if (instanceTree == iInstanceMapTrees.end())
         {
@@ -142,6 +144,7 @@ namespace VMAP
 
     void VMapManager2::unloadMap(unsigned int mapId, int x, int y)
     {
+        std::unique_lock<std::shared_mutex> lock(InstanceMapTreesLock);
         auto instanceTree = iInstanceMapTrees.find(mapId);
         if (instanceTree != iInstanceMapTrees.end() && instanceTree->second)
         {
@@ -156,6 +159,7 @@ namespace VMAP
 
     void VMapManager2::unloadMap(unsigned int mapId)
     {
+        std::unique_lock<std::shared_mutex> lock(InstanceMapTreesLock);
         auto instanceTree = iInstanceMapTrees.find(mapId);
         if (instanceTree != iInstanceMapTrees.end() && instanceTree->second)
         {
@@ -173,6 +177,7 @@ namespace VMAP
         if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
             return true;
 
+        std::shared_lock<std::shared_mutex> lock = LockTreesForQuery();
         auto instanceTree = GetMapTree(mapId);
         if (instanceTree != iInstanceMapTrees.end())
         {
@@ -185,6 +190,29 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, float const* positions, bool* results, std::size_t count, ModelIgnoreFlags ignoreFlags)
+    {
+        std::fill_n(results, count, true);
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        std::shared_lock<std::shared_mutex> lock = LockTreesForQuery();
+        auto instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        std::vector<Vector3> pos1(count);
+        std::vector<Vector3> pos2(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float const* pair = positions + i * 6;
+            pos1[i] = convertPositionToInternalRep(pair[0], pair[1], pair[2]);
+            pos2[i] = convertPositionToInternalRep(pair[3], pair[4], pair[5]);
+        }
+
+        instanceTree->second->isInLineOfSight(pos1.data(), pos2.data(), results, count, ignoreFlags);
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -193,6 +221,7 @@ namespace VMAP
     {
         if (isLineOfSightCalcEnabled() && !IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
         {
+            std::shared_lock<std::shared_mutex> lock = LockTreesForQuery();
             auto instanceTree = GetMapTree(mapId);
             if (instanceTree != iInstanceMapTrees.end())
             {
@@ -223,6 +252,7 @@ namespace VMAP
     {
         if (isHeightCalcEnabled() && !IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_HEIGHT))
         {
+            std::shared_lock<std::shared_mutex> lock = LockTreesForQuery();
             auto instanceTree = GetMapTree(mapId);
             if (instanceTree != iInstanceMapTrees.end())
             {
@@ -242,6 +272,7 @@ namespace VMAP
     {
         if (!IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_AREAFLAG))
         {
+            std::shared_lock<std::shared_mutex> lock = LockTreesForQuery();
             auto instanceTree = GetMapTree(mapId);
             if (instanceTree != iInstanceMapTrees.end())
             {
@@ -260,6 +291,7 @@ namespace VMAP
     {
         if (!IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LIQUIDSTATUS))
         {
+            std::shared_lock<std::shared_mutex> lock = LockTreesForQuery();
             auto instanceTree = GetMapTree(mapId);
             if (instanceTree != iInstanceMapTrees.end())
             {
@@ -295,6 +327,8 @@ namespace VMAP
                 data.areaInfo.emplace(adtId, rootId, groupId, flags);
             return;
         }
+
+        std::shared_lock<std::shared_mutex> lock = LockTreesForQuery();
         InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
         if (instanceTree != iInstanceMapTrees.end())
         {
@@ -324,7 +358,7 @@ namespace VMAP
         if (model == iLoadedModelFiles.end())
         {
             ManagedModel* worldmodel = new ManagedModel();
-            if (!worldmodel->getModel()->readFile(basepath + filename + ".vmo"))
+            if (!worldmodel->getModel()->mapFile(basepath + filename + ".vmo") && !worldmodel->getModel()->readFile(basepath + filename + ".vmo"))
             {
                 TC_LOG_ERROR("misc", "VMapManager2: could not load '{}{}.vmo'", basepath, filename);
                 delete worldmodel;
@@ -367,6 +401,7 @@ namespace VMAP
 
     void VMapManager2::getInstanceMapTree(InstanceTreeMap &instanceMapTree)
     {
+        std::shared_lock<std::shared_mutex> lock = LockTreesForQuery();
         instanceMapTree = iInstanceMapTrees;
     }
 
@@ -19,6 +19,7 @@
 #define _VMAPMANAGER2_H
 
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 #include "Define.h"
@@ -72,6 +73,18 @@ namespace VMAP
             bool thread_safe_environment;
             // Mutex for iLoadedModelFiles
             std::mutex LoadedModelFilesLock;
+            // tiles can be loaded by grid preload threads while maps query the trees, loading and unloading take it exclusively
+            mutable std::shared_mutex InstanceMapTreesLock;
+            // queries only take InstanceMapTreesLock when tiles are loaded in the background
+            bool _backgroundTreeLoading;
+
+            std::shared_lock<std::shared_mutex> LockTreesForQuery() const
+            {
+                if (!_backgroundTreeLoading)
+                    return std::shared_lock<std::shared_mutex>(InstanceMapTreesLock, std::defer_lock);
+
+                return std::shared_lock<std::shared_mutex>(InstanceMapTreesLock);
+            }
 
             static uint32 GetLiquidFlagsDummy(uint32) { return 0; }
             static bool IsVMAPDisabledForDummy(uint32 /*entry*/, uint8 /*flags*/) { return false; }
@@ -87,6 +100,8 @@ namespace VMAP
             ~VMapManager2();
 
             void InitializeThreadUnsafe(std::unordered_map<uint32, std::vector<uint32>> const& mapData);
+            // must be enabled before any tile is loaded if tiles can be loaded outside of map update threads
+            void SetBackgroundTreeLoading(bool enable) { _backgroundTreeLoading = enable; }
 
             LoadResult loadMap(char const* pBasePath, unsigned int mapId, int x, int y) override;
 
@@ -95,6 +110,7 @@ namespace VMAP
             void unloadMap(unsigned int mapId) override;
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) override ;
+            void isInLineOfSight(unsigned int mapId, float const* positions, bool* results, std::size_t count, ModelIgnoreFlags ignoreFlags) override;
             /**
             fill the hit pos and return true, if an object was hit
             */
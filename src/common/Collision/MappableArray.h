@@ -0,0 +1,173 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MAPPABLEARRAY_H
+#define _MAPPABLEARRAY_H
+
+#include "Define.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace VMAP
+{
+    /*! Array of model data that either owns its elements or points into a read-only file mapping.
+        Only const access is allowed to mapped elements, anything modifying the array copies them first. */
+    template<class T>
+    class MappableArray
+    {
+        public:
+            MappableArray() : _data(nullptr), _size(0) { }
+            MappableArray(MappableArray const& other) : _data(nullptr), _size(0) { *this = other; }
+
+            MappableArray& operator=(MappableArray const& other)
+            {
+                if (this == &other)
+                    return *this;
+
+                if (other.isMapped())
+                {
+                    _storage.clear();
+                    _data = other._data;
+                    _size = other._size;
+                }
+                else
+                {
+                    _storage = other._storage;
+                    bind();
+                }
+                return *this;
+            }
+
+            MappableArray& operator=(std::vector<T> const& other)
+            {
+                _storage = other;
+                bind();
+                return *this;
+            }
+
+            //! swaps contents with a plain vector, mapped elements are copied into it
+            void swap(std::vector<T>& other)
+            {
+                makeOwned();
+                _storage.swap(other);
+                bind();
+            }
+
+            //! point at count elements of a mapping that outlives this array
+            void map(T const* data, std::size_t count)
+            {
+                std::vector<T>().swap(_storage);
+                _data = data;
+                _size = count;
+            }
+
+            bool isMapped() const { return _data && _data != _storage.data(); }
+
+            std::size_t size() const { return _size; }
+            bool empty() const { return _size == 0; }
+            T const* data() const { return _data; }
+            T const* begin() const { return _data; }
+            T const* end() const { return _data + _size; }
+            T const& operator[](std::size_t i) const { return _data[i]; }
+            T& operator[](std::size_t i) { makeOwned(); return _storage[i]; }
+
+            void clear() { _storage.clear(); bind(); }
+            void resize(std::size_t count) { makeOwned(); _storage.resize(count); bind(); }
+            void push_back(T const& value) { makeOwned(); _storage.push_back(value); bind(); }
+            void assign(std::size_t count, T const& value) { _storage.assign(count, value); bind(); }
+
+        private:
+            void makeOwned()
+            {
+                if (isMapped())
+                    _storage.assign(begin(), end());
+            }
+
+            void bind()
+            {
+                _data = _storage.data();
+                _size = _storage.size();
+            }
+
+            std::vector<T> _storage;
+            T const* _data;
+            std::size_t _size;
+    };
+
+    /*! Reads a model file mapped into memory the same way the FILE* based readers do,
+        arrays can be mapped in place instead of copied. */
+    class MappedFileReader
+    {
+        public:
+            MappedFileReader(char const* data, std::size_t size) : _pos(data), _end(data + size) { }
+
+            bool read(void* dest, std::size_t size)
+            {
+                if (std::size_t(_end - _pos) < size)
+                    return false;
+
+                memcpy(dest, _pos, size);
+                _pos += size;
+                return true;
+            }
+
+            bool readChunk(char const* compare, uint32 len)
+            {
+                if (std::size_t(_end - _pos) < len || memcmp(_pos, compare, len) != 0)
+                    return false;
+
+                _pos += len;
+                return true;
+            }
+
+            bool skip(std::size_t size)
+            {
+                if (std::size_t(_end - _pos) < size)
+                    return false;
+
+                _pos += size;
+                return true;
+            }
+
+            template<class T>
+            bool map(MappableArray<T>& array, std::size_t count)
+            {
+                if (std::size_t(_end - _pos) / sizeof(T) < count)
+                    return false;
+
+                // files written before arrays were aligned still load, just without sharing the memory
+                if (reinterpret_cast<std::uintptr_t>(_pos) % alignof(T) != 0)
+                {
+                    array.resize(count);
+                    if (count)
+                        memcpy(&array[0], _pos, sizeof(T) * count);
+                }
+                else
+                    array.map(reinterpret_cast<T const*>(_pos), count);
+
+                _pos += sizeof(T) * count;
+                return true;
+            }
+
+        private:
+            char const* _pos;
+            char const* _end;
+    };
+}
+
+#endif // _MAPPABLEARRAY_H
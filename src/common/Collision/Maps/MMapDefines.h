@@ -22,7 +22,7 @@
 #include "DetourNavMesh.h"
 
 const uint32 MMAP_MAGIC = 0x4d4d4150; // 'MMAP'
-#define MMAP_VERSION 15
+#define MMAP_VERSION 16
 
 struct MmapTileHeader
 {
@@ -32,19 +32,21 @@ struct MmapTileHeader
     uint32 size;
     char usesLiquids;
     char padding[3];
+    uint8 inputHash[20]; // SHA1 of the tile input, lets mmaps_generator skip tiles that did not change
 
     MmapTileHeader() : mmapMagic(MMAP_MAGIC), dtVersion(DT_NAVMESH_VERSION),
-        mmapVersion(MMAP_VERSION), size(0), usesLiquids(true), padding() { }
+        mmapVersion(MMAP_VERSION), size(0), usesLiquids(true), padding(), inputHash() { }
 };
 
 // All padding fields must be handled and initialized to ensure mmaps_generator will produce binary-identical *.mmtile files
-static_assert(sizeof(MmapTileHeader) == 20, "MmapTileHeader size is not correct, adjust the padding field size");
+static_assert(sizeof(MmapTileHeader) == 40, "MmapTileHeader size is not correct, adjust the padding field size");
 static_assert(sizeof(MmapTileHeader) == (sizeof(MmapTileHeader::mmapMagic) +
                                          sizeof(MmapTileHeader::dtVersion) +
                                          sizeof(MmapTileHeader::mmapVersion) +
                                          sizeof(MmapTileHeader::size) +
                                          sizeof(MmapTileHeader::usesLiquids) +
-                                         sizeof(MmapTileHeader::padding)), "MmapTileHeader has uninitialized padding fields");
+                                         sizeof(MmapTileHeader::padding) +
+                                         sizeof(MmapTileHeader::inputHash)), "MmapTileHeader has uninitialized padding fields");
 
 enum NavArea
 {
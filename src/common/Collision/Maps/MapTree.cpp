@@ -50,6 +50,24 @@ namespace VMAP
             ModelIgnoreFlags flags;
     };
 
+    class MapRayPacketCallback
+    {
+        public:
+            MapRayPacketCallback(ModelInstance* val, ModelIgnoreFlags ignoreFlags) : prims(val), hitMask(0), flags(ignoreFlags) { }
+            bool operator()(uint32 ray, G3D::Ray const& r, uint32 entry, float& distance, bool pStopAtFirstHit = true)
+            {
+                bool result = prims[entry].intersectRay(r, distance, pStopAtFirstHit, flags);
+                if (result)
+                    hitMask |= 1 << ray;
+                return result;
+            }
+            uint32 getHitMask() const { return hitMask; }
+        protected:
+            ModelInstance* prims;
+            uint32 hitMask;
+            ModelIgnoreFlags flags;
+    };
+
     class AreaInfoCallback
     {
         public:
@@ -171,6 +189,46 @@ namespace VMAP
 
         return true;
     }
+
+    void StaticMapTree::isInLineOfSight(G3D::Vector3 const* pos1, G3D::Vector3 const* pos2, bool* results, std::size_t count, ModelIgnoreFlags ignoreFlags) const
+    {
+        for (std::size_t packetStart = 0; packetStart < count; packetStart += BIH::RayPacketSize)
+        {
+            G3D::Ray rays[BIH::RayPacketSize];
+            float maxDist[BIH::RayPacketSize] = { };
+            uint32 rayMask = 0;
+            std::size_t packetSize = std::min<std::size_t>(BIH::RayPacketSize, count - packetStart);
+            for (std::size_t i = 0; i < packetSize; ++i)
+            {
+                std::size_t query = packetStart + i;
+                results[query] = true;
+
+                // same special cases as a single ray
+                float dist = (pos2[query] - pos1[query]).magnitude();
+                if (dist == std::numeric_limits<float>::max() || !std::isfinite(dist))
+                {
+                    results[query] = false;
+                    continue;
+                }
+
+                if (dist < 1e-10f)
+                    continue;
+
+                rays[i] = G3D::Ray::fromOriginAndDirection(pos1[query], (pos2[query] - pos1[query]) / dist);
+                maxDist[i] = dist;
+                rayMask |= 1 << i;
+            }
+
+            if (!rayMask)
+                continue;
+
+            MapRayPacketCallback intersectionCallBack(iTreeValues, ignoreFlags);
+            iTree.intersectRays(rays, rayMask, intersectionCallBack, maxDist, true);
+            for (std::size_t i = 0; i < packetSize; ++i)
+                if (intersectionCallBack.getHitMask() & (1 << i))
+                    results[packetStart + i] = false;
+        }
+    }
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
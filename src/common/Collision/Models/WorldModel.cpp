@@ -20,10 +20,24 @@
 #include "MapTree.h"
 #include "ModelInstance.h"
 #include "ModelIgnoreFlags.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 using G3D::Vector3;
 using G3D::Ray;
 
+namespace
+{
+    struct ModelFileMapping
+    {
+        explicit ModelFileMapping(std::string const& filename) :
+            File(filename.c_str(), boost::interprocess::read_only), Region(File, boost::interprocess::read_only) { }
+
+        boost::interprocess::file_mapping File;
+        boost::interprocess::mapped_region Region;
+    };
+}
+
 template<> struct BoundsTrait<VMAP::GroupModel>
 {
     static void getBounds(const VMAP::GroupModel& obj, G3D::AABox& out) { out = obj.GetBound(); }
@@ -31,7 +45,7 @@ template<> struct BoundsTrait<VMAP::GroupModel>
 
 namespace VMAP
 {
-    bool IntersectTriangle(MeshTriangle const& tri, std::vector<Vector3>::const_iterator points, G3D::Ray const& ray, float& distance)
+    bool IntersectTriangle(MeshTriangle const& tri, Vector3 const* points, G3D::Ray const& ray, float& distance)
     {
         static const float EPS = 1e-5f;
 
@@ -84,7 +98,7 @@ namespace VMAP
     class TriBoundFunc
     {
         public:
-            TriBoundFunc(std::vector<Vector3>& vert): vertices(vert.begin()) { }
+            TriBoundFunc(MappableArray<Vector3> const& vert): vertices(vert.begin()) { }
             void operator()(MeshTriangle const& tri, G3D::AABox& out) const
             {
                 G3D::Vector3 lo = vertices[tri.idx0];
@@ -96,7 +110,7 @@ namespace VMAP
                 out = G3D::AABox(lo, hi);
             }
         protected:
-            const std::vector<Vector3>::const_iterator vertices;
+            Vector3 const* const vertices;
     };
 
     // ===================== WmoLiquid ==================================
@@ -215,7 +229,13 @@ namespace VMAP
         return 2 * sizeof(uint32) +
                 sizeof(Vector3) +
                 sizeof(uint32) +
-                (iFlags ? ((iTilesX + 1) * (iTilesY + 1) * sizeof(float) + iTilesX * iTilesY) : sizeof(float));
+                (iFlags ? ((iTilesX + 1) * (iTilesY + 1) * sizeof(float) + iTilesX * iTilesY + GetFlagsPadding(iTilesX, iTilesY)) : sizeof(float));
+    }
+
+    uint32 WmoLiquid::GetFlagsPadding(uint32 tilesX, uint32 tilesY)
+    {
+        // keeps the arrays of following group models aligned in mapped files
+        return (4 - (tilesX * tilesY) % 4) % 4;
     }
 
     bool WmoLiquid::writeToFile(FILE* wf)
@@ -232,7 +252,9 @@ namespace VMAP
                 if (fwrite(iHeight, sizeof(float), size, wf) == size)
                 {
                     size = iTilesX * iTilesY;
-                    result = fwrite(iFlags, sizeof(uint8), size, wf) == size;
+                    uint32 const padding = 0;
+                    result = fwrite(iFlags, sizeof(uint8), size, wf) == size &&
+                        fwrite(&padding, sizeof(uint8), GetFlagsPadding(iTilesX, iTilesY), wf) == GetFlagsPadding(iTilesX, iTilesY);
                 }
             }
             else
@@ -260,7 +282,9 @@ namespace VMAP
                 {
                     size = liquid->iTilesX * liquid->iTilesY;
                     liquid->iFlags = new uint8[size];
-                    result = fread(liquid->iFlags, sizeof(uint8), size, rf) == size;
+                    uint32 padding;
+                    result = fread(liquid->iFlags, sizeof(uint8), size, rf) == size &&
+                        fread(&padding, sizeof(uint8), GetFlagsPadding(liquid->iTilesX, liquid->iTilesY), rf) == GetFlagsPadding(liquid->iTilesX, liquid->iTilesY);
                 }
             }
             else
@@ -278,6 +302,42 @@ namespace VMAP
         return result;
     }
 
+    bool WmoLiquid::readFromMemory(MappedFileReader& reader, WmoLiquid*& out)
+    {
+        bool result = false;
+        WmoLiquid* liquid = new WmoLiquid();
+
+        if (reader.read(&liquid->iTilesX, sizeof(uint32)) &&
+            reader.read(&liquid->iTilesY, sizeof(uint32)) &&
+            reader.read(&liquid->iCorner, sizeof(Vector3)) &&
+            reader.read(&liquid->iType, sizeof(uint32)))
+        {
+            if (liquid->iTilesX && liquid->iTilesY)
+            {
+                uint32 size = (liquid->iTilesX + 1) * (liquid->iTilesY + 1);
+                liquid->iHeight = new float[size];
+                if (reader.read(liquid->iHeight, sizeof(float) * size))
+                {
+                    size = liquid->iTilesX * liquid->iTilesY;
+                    liquid->iFlags = new uint8[size];
+                    result = reader.read(liquid->iFlags, size) && reader.skip(GetFlagsPadding(liquid->iTilesX, liquid->iTilesY));
+                }
+            }
+            else
+            {
+                liquid->iHeight = new float[1];
+                result = reader.read(liquid->iHeight, sizeof(float));
+            }
+        }
+
+        if (!result)
+            delete liquid;
+        else
+            out = liquid;
+
+        return result;
+    }
+
     void WmoLiquid::getPosInfo(uint32& tilesX, uint32& tilesY, G3D::Vector3& corner) const
     {
         tilesX = iTilesX;
@@ -392,17 +452,57 @@ namespace VMAP
         return result;
     }
 
+    bool GroupModel::readFromMemory(MappedFileReader& reader)
+    {
+        bool result = true;
+        uint32 chunkSize = 0;
+        uint32 count = 0;
+        triangles.clear();
+        vertices.clear();
+        delete iLiquid;
+        iLiquid = nullptr;
+
+        if (result && !reader.read(&iBound, sizeof(G3D::AABox))) result = false;
+        if (result && !reader.read(&iMogpFlags, sizeof(uint32))) result = false;
+        if (result && !reader.read(&iGroupWMOID, sizeof(uint32))) result = false;
+
+        // map vertices
+        if (result && !reader.readChunk("VERT", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
+        if (result && !reader.read(&count, sizeof(uint32))) result = false;
+        if (!count) // models without (collision) geometry end here, unsure if they are useful
+            return result;
+        if (result && !reader.map(vertices, count)) result = false;
+
+        // map triangle mesh
+        if (result && !reader.readChunk("TRIM", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
+        if (result && !reader.read(&count, sizeof(uint32))) result = false;
+        if (result && !reader.map(triangles, count)) result = false;
+
+        // map mesh BIH
+        if (result && !reader.readChunk("MBIH", 4)) result = false;
+        if (result) result = meshTree.readFromMemory(reader);
+
+        // read liquid data
+        if (result && !reader.readChunk("LIQU", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
+        if (result && chunkSize > 0)
+            result = WmoLiquid::readFromMemory(reader, iLiquid);
+        return result;
+    }
+
     struct GModelRayCallback
     {
-        GModelRayCallback(std::vector<MeshTriangle> const& tris, const std::vector<Vector3> &vert):
+        GModelRayCallback(MappableArray<MeshTriangle> const& tris, MappableArray<Vector3> const& vert):
             vertices(vert.begin()), triangles(tris.begin()), hit(false) { }
         bool operator()(G3D::Ray const& ray, uint32 entry, float& distance, bool /*pStopAtFirstHit*/)
         {
             hit = IntersectTriangle(triangles[entry], vertices, ray, distance) || hit;
             return hit;
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+        Vector3 const* vertices;
+        MeshTriangle const* triangles;
         bool hit;
     };
 
@@ -445,8 +545,8 @@ namespace VMAP
 
     void GroupModel::getMeshData(std::vector<G3D::Vector3>& outVertices, std::vector<MeshTriangle>& outTriangles, WmoLiquid*& liquid)
     {
-        outVertices = vertices;
-        outTriangles = triangles;
+        outVertices.assign(vertices.begin(), vertices.end());
+        outTriangles.assign(triangles.begin(), triangles.end());
         liquid = iLiquid;
     }
 
@@ -634,6 +734,45 @@ namespace VMAP
         return result;
     }
 
+    bool WorldModel::mapFile(std::string const& filename)
+    {
+        std::shared_ptr<ModelFileMapping> mapping;
+        try
+        {
+            mapping = std::make_shared<ModelFileMapping>(filename);
+        }
+        catch (boost::interprocess::interprocess_exception const&)
+        {
+            return false;
+        }
+
+        MappedFileReader reader(static_cast<char const*>(mapping->Region.get_address()), mapping->Region.get_size());
+        bool result = true;
+        uint32 chunkSize = 0;
+        uint32 count = 0;
+        if (!reader.readChunk(VMAP_MAGIC, 8)) result = false;
+
+        if (result && !reader.readChunk("WMOD", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
+        if (result && !reader.read(&RootWMOID, sizeof(uint32))) result = false;
+
+        // map group models
+        if (result && reader.readChunk("GMOD", 4))
+        {
+            if (result && !reader.read(&count, sizeof(uint32))) result = false;
+            if (result) groupModels.resize(count);
+            for (uint32 i = 0; i < count && result; ++i)
+                result = groupModels[i].readFromMemory(reader);
+
+            // map group BIH
+            if (result && !reader.readChunk("GBIH", 4)) result = false;
+            if (result) result = groupTree.readFromMemory(reader);
+        }
+
+        fileMapping = std::move(mapping);
+        return result;
+    }
+
     void WorldModel::getGroupModels(std::vector<GroupModel>& outGroupModels)
     {
         outGroupModels = groupModels;
@@ -24,6 +24,7 @@
 #include "BoundingIntervalHierarchy.h"
 
 #include "Define.h"
+#include <memory>
 
 namespace VMAP
 {
@@ -58,8 +59,10 @@ namespace VMAP
             uint32 GetFileSize();
             bool writeToFile(FILE* wf);
             static bool readFromFile(FILE* rf, WmoLiquid* &liquid);
+            static bool readFromMemory(MappedFileReader& reader, WmoLiquid* &liquid);
             void getPosInfo(uint32 &tilesX, uint32 &tilesY, G3D::Vector3 &corner) const;
         private:
+            static uint32 GetFlagsPadding(uint32 tilesX, uint32 tilesY);
             WmoLiquid() : iTilesX(0), iTilesY(0), iCorner(), iType(0), iHeight(nullptr), iFlags(nullptr) { }
             uint32 iTilesX;       //!< number of tiles in x direction, each
             uint32 iTilesY;
@@ -88,6 +91,8 @@ namespace VMAP
             uint32 GetLiquidType() const;
             bool writeToFile(FILE* wf);
             bool readFromFile(FILE* rf);
+            //! mesh data points into the mapped file afterwards
+            bool readFromMemory(MappedFileReader& reader);
             const G3D::AABox& GetBound() const { return iBound; }
             uint32 GetMogpFlags() const { return iMogpFlags; }
             uint32 GetWmoID() const { return iGroupWMOID; }
@@ -96,8 +101,8 @@ namespace VMAP
             G3D::AABox iBound;
             uint32 iMogpFlags;// 0x8 outdor; 0x2000 indoor
             uint32 iGroupWMOID;
-            std::vector<G3D::Vector3> vertices;
-            std::vector<MeshTriangle> triangles;
+            MappableArray<G3D::Vector3> vertices;
+            MappableArray<MeshTriangle> triangles;
             BIH meshTree;
             WmoLiquid* iLiquid;
     };
@@ -116,6 +121,8 @@ namespace VMAP
             bool GetLocationInfo(const G3D::Vector3 &p, const G3D::Vector3 &down, float &dist, GroupLocationInfo& info) const;
             bool writeFile(const std::string &filename);
             bool readFile(const std::string &filename);
+            //! maps the file read-only instead of reading it, geometry and trees are shared with every process mapping it
+            bool mapFile(std::string const& filename);
             void getGroupModels(std::vector<GroupModel>& outGroupModels);
             std::string const& GetName() const { return name; }
             void SetName(std::string newName) { name = std::move(newName); }
@@ -125,6 +132,7 @@ namespace VMAP
             std::vector<GroupModel> groupModels;
             BIH groupTree;
             std::string name;
+            std::shared_ptr<void const> fileMapping;
     };
 } // namespace VMAP
 
@@ -23,6 +23,7 @@
 #include <G3D/Ray.h>
 #include <G3D/BoundsTrait.h>
 #include <G3D/PositionTrait.h>
+#include <algorithm>
 #include <unordered_map>
 
 template<class Node>
@@ -89,6 +90,38 @@ public:
         memberTable.erase(&value);
     }
 
+    void relocate(const T& value)
+    {
+        G3D::AABox bounds;
+        BoundsFunc::getBounds(value, bounds);
+        Cell low = Cell::ComputeCell(bounds.low().x, bounds.low().y);
+        Cell high = Cell::ComputeCell(bounds.high().x, bounds.high().y);
+        auto members = Trinity::Containers::MapEqualRange(memberTable, &value);
+        bool sameCells = std::distance(members.begin(), members.end()) == (high.x - low.x + 1) * (high.y - low.y + 1);
+        for (int x = low.x; x <= high.x && sameCells; ++x)
+        {
+            for (int y = low.y; y <= high.y && sameCells; ++y)
+            {
+                Cell cell = { x, y };
+                sameCells = cell.isValid() && nodes[x][y] && std::any_of(members.begin(), members.end(), [&](typename MemberTable::value_type const& member)
+                {
+                    return member.second == nodes[x][y];
+                });
+            }
+        }
+
+        // moved to other cells
+        if (!sameCells)
+        {
+            remove(value);
+            insert(value);
+            return;
+        }
+
+        for (auto& p : members)
+            p.second->relocate(value);
+    }
+
     void balance()
     {
         for (int x = 0; x < CELL_NUMBER; ++x)
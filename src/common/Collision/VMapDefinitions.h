@@ -24,7 +24,7 @@
 
 namespace VMAP
 {
-    const char VMAP_MAGIC[] = "VMAP_4.B";
+    const char VMAP_MAGIC[] = "VMAP_4.C";
     const char RAW_VMAP_MAGIC[] = "VMAP04B";                // used in extracted vmap files with raw data
     const char GAMEOBJECT_MODELS[] = "GameObjectModels.dtree";
 
@@ -0,0 +1,100 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_FLAT_HASH_MAP_H
+#define TRINITYCORE_FLAT_HASH_MAP_H
+
+#include "FlatHashTable.h"
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+
+namespace Trinity::Containers
+{
+namespace Impl
+{
+struct FlatHashMapKeyOfValue
+{
+    template<class Pair>
+    auto const& operator()(Pair const& value) const { return value.first; }
+};
+}
+
+/// Drop-in replacement for std::unordered_map without an allocation per element, see Impl::FlatHashTable
+template<class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatHashMap : public Impl::FlatHashTable<std::pair<Key const, T>, Key, Impl::FlatHashMapKeyOfValue, Hash, KeyEqual>
+{
+    using Base = Impl::FlatHashTable<std::pair<Key const, T>, Key, Impl::FlatHashMapKeyOfValue, Hash, KeyEqual>;
+
+public:
+    using mapped_type = T;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::value_type;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(std::initializer_list<value_type> values)
+    {
+        this->reserve(values.size());
+        Base::insert(values.begin(), values.end());
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(Key const& key, Args&&... args)
+    {
+        return Base::InsertUnique(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        return Base::InsertUnique(value.first, std::move(value));
+    }
+
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(Key const& key, M&& mapped)
+    {
+        std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(mapped));
+        if (!result.second)
+            result.first->second = std::forward<M>(mapped);
+        return result;
+    }
+
+    T& operator[](Key const& key) { return try_emplace(key).first->second; }
+
+    T& at(Key const& key)
+    {
+        iterator itr = this->find(key);
+        if (itr == this->end())
+            throw std::out_of_range("FlatHashMap::at");
+        return itr->second;
+    }
+
+    T const& at(Key const& key) const
+    {
+        const_iterator itr = this->find(key);
+        if (itr == this->end())
+            throw std::out_of_range("FlatHashMap::at");
+        return itr->second;
+    }
+};
+}
+
+#endif // TRINITYCORE_FLAT_HASH_MAP_H
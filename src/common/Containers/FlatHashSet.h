@@ -0,0 +1,83 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_FLAT_HASH_SET_H
+#define TRINITYCORE_FLAT_HASH_SET_H
+
+#include "FlatHashTable.h"
+#include <functional>
+#include <initializer_list>
+
+namespace Trinity::Containers
+{
+namespace Impl
+{
+struct FlatHashSetKeyOfValue
+{
+    template<class Key>
+    Key const& operator()(Key const& value) const { return value; }
+};
+}
+
+/// Drop-in replacement for std::unordered_set without an allocation per element, see Impl::FlatHashTable
+template<class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatHashSet : public Impl::FlatHashTable<Key, Key, Impl::FlatHashSetKeyOfValue, Hash, KeyEqual>
+{
+    using Base = Impl::FlatHashTable<Key, Key, Impl::FlatHashSetKeyOfValue, Hash, KeyEqual>;
+
+public:
+    // elements can't be modified in place, that would change their hash
+    using iterator = typename Base::const_iterator;
+    using const_iterator = typename Base::const_iterator;
+
+    FlatHashSet() = default;
+
+    FlatHashSet(std::initializer_list<Key> values)
+    {
+        this->reserve(values.size());
+        Base::insert(values.begin(), values.end());
+    }
+
+    const_iterator begin() const { return Base::begin(); }
+    const_iterator end() const { return Base::end(); }
+
+    const_iterator find(Key const& key) const { return Base::find(key); }
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        Key key(std::forward<Args>(args)...);
+        return Base::InsertUnique(key, std::move(key));
+    }
+
+    friend bool operator==(FlatHashSet const& left, FlatHashSet const& right)
+    {
+        if (left.size() != right.size())
+            return false;
+
+        for (Key const& key : left)
+            if (!right.contains(key))
+                return false;
+
+        return true;
+    }
+
+    friend bool operator!=(FlatHashSet const& left, FlatHashSet const& right) { return !(left == right); }
+};
+}
+
+#endif // TRINITYCORE_FLAT_HASH_SET_H
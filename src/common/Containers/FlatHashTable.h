@@ -0,0 +1,415 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_FLAT_HASH_TABLE_H
+#define TRINITYCORE_FLAT_HASH_TABLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace Trinity::Containers::Impl
+{
+/**
+ * Open addressing hash table with linear probing, storing all elements in a single array.
+ * Every slot has a control byte that is either empty, deleted or holds 7 bits of the hash of
+ * the element stored in it, so that most mismatching slots are rejected without comparing keys.
+ *
+ * Elements are only moved by rehashing (when inserting into a full table or calling reserve),
+ * erasing never invalidates iterators or references to other elements.
+ */
+template<class Value, class Key, class KeyOfValue, class Hash, class KeyEqual>
+class FlatHashTable
+{
+    using Control = std::int8_t;
+
+    static constexpr Control Empty = -128;
+    static constexpr Control Deleted = -2;
+    static constexpr std::size_t MinCapacity = 8;
+    static constexpr std::size_t NoSlot = ~std::size_t(0);
+
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+
+    template<bool IsConst>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashTable::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, value_type const*, value_type*>;
+        using reference = std::conditional_t<IsConst, value_type const&, value_type&>;
+
+        Iterator() : _control(nullptr), _controlEnd(nullptr), _slot(nullptr) { }
+
+        // iterator -> const_iterator
+        template<bool OtherConst, std::enable_if_t<IsConst && !OtherConst, int> = 0>
+        Iterator(Iterator<OtherConst> const& other) : _control(other._control), _controlEnd(other._controlEnd), _slot(other._slot) { }
+
+        reference operator*() const { return *_slot; }
+        pointer operator->() const { return _slot; }
+
+        Iterator& operator++()
+        {
+            ++_control;
+            ++_slot;
+            SkipFree();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator itr = *this;
+            ++*this;
+            return itr;
+        }
+
+        friend bool operator==(Iterator const& left, Iterator const& right) { return left._control == right._control; }
+        friend bool operator!=(Iterator const& left, Iterator const& right) { return left._control != right._control; }
+
+    private:
+        friend FlatHashTable;
+        template<bool> friend class Iterator;
+
+        Iterator(Control const* control, Control const* controlEnd, pointer slot) : _control(control), _controlEnd(controlEnd), _slot(slot)
+        {
+            SkipFree();
+        }
+
+        void SkipFree()
+        {
+            while (_control != _controlEnd && *_control < 0)
+            {
+                ++_control;
+                ++_slot;
+            }
+        }
+
+        Control const* _control;
+        Control const* _controlEnd;
+        pointer _slot;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashTable() : _control(nullptr), _slots(nullptr), _capacity(0), _size(0), _deleted(0) { }
+
+    FlatHashTable(FlatHashTable const& other) : FlatHashTable()
+    {
+        reserve(other.size());
+        for (value_type const& value : other)
+            InsertNew(value);
+    }
+
+    FlatHashTable(FlatHashTable&& other) noexcept : FlatHashTable()
+    {
+        swap(other);
+    }
+
+    FlatHashTable& operator=(FlatHashTable const& other)
+    {
+        if (this != &other)
+        {
+            FlatHashTable copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept
+    {
+        FlatHashTable moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~FlatHashTable()
+    {
+        Destroy();
+    }
+
+    iterator begin() { return iterator(_control, _control + _capacity, _slots); }
+    const_iterator begin() const { return const_iterator(_control, _control + _capacity, _slots); }
+    const_iterator cbegin() const { return begin(); }
+
+    iterator end() { return iterator(_control + _capacity, _control + _capacity, _slots + _capacity); }
+    const_iterator end() const { return const_iterator(_control + _capacity, _control + _capacity, _slots + _capacity); }
+    const_iterator cend() const { return end(); }
+
+    bool empty() const { return _size == 0; }
+    size_type size() const { return _size; }
+    size_type capacity() const { return _capacity; }
+
+    iterator find(key_type const& key)
+    {
+        std::size_t slot = FindSlot(key);
+        return slot != NoSlot ? IteratorAt(slot) : end();
+    }
+
+    const_iterator find(key_type const& key) const
+    {
+        std::size_t slot = FindSlot(key);
+        return slot != NoSlot ? IteratorAt(slot) : end();
+    }
+
+    size_type count(key_type const& key) const { return FindSlot(key) != NoSlot ? 1 : 0; }
+    bool contains(key_type const& key) const { return FindSlot(key) != NoSlot; }
+
+    std::pair<iterator, bool> insert(value_type const& value) { return InsertUnique(KeyOfValue()(value), value); }
+    std::pair<iterator, bool> insert(value_type&& value) { return InsertUnique(KeyOfValue()(value), std::move(value)); }
+
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    size_type erase(key_type const& key)
+    {
+        std::size_t slot = FindSlot(key);
+        if (slot == NoSlot)
+            return 0;
+
+        EraseSlot(slot);
+        return 1;
+    }
+
+    iterator erase(const_iterator itr)
+    {
+        std::size_t slot = itr._control - _control;
+        EraseSlot(slot);
+        return IteratorAt(slot + 1);
+    }
+
+    iterator erase(iterator itr) { return erase(const_iterator(itr)); }
+
+    void clear()
+    {
+        if (!_size && !_deleted)
+            return;
+
+        for (std::size_t i = 0; i < _capacity; ++i)
+        {
+            if (_control[i] >= 0)
+                std::destroy_at(_slots + i);
+            _control[i] = Empty;
+        }
+
+        _size = 0;
+        _deleted = 0;
+    }
+
+    void reserve(size_type count)
+    {
+        std::size_t capacity = CapacityFor(count);
+        if (capacity > _capacity)
+            Rehash(capacity);
+    }
+
+    void swap(FlatHashTable& other) noexcept
+    {
+        std::swap(_control, other._control);
+        std::swap(_slots, other._slots);
+        std::swap(_capacity, other._capacity);
+        std::swap(_size, other._size);
+        std::swap(_deleted, other._deleted);
+    }
+
+    friend void swap(FlatHashTable& left, FlatHashTable& right) noexcept { left.swap(right); }
+
+protected:
+    /// Inserts value constructed from args if key is not present yet, args are not touched otherwise
+    template<class... Args>
+    std::pair<iterator, bool> InsertUnique(key_type const& key, Args&&... args)
+    {
+        std::size_t slot = FindSlot(key);
+        if (slot != NoSlot)
+            return { IteratorAt(slot), false };
+
+        return { IteratorAt(InsertNew(std::forward<Args>(args)...)), true };
+    }
+
+private:
+    // hashes of pointers and other identity hashes are mixed so that both the slot and the 7 bit tag are usable
+    static std::size_t MixHash(std::size_t hash)
+    {
+        std::uint64_t mixed = std::uint64_t(hash) * 0x9E3779B97F4A7C15ull;
+        return std::size_t(mixed ^ (mixed >> 32));
+    }
+
+    static Control TagOf(std::size_t hash) { return Control(hash & 0x7F); }
+
+    // at most 7/8 of all slots are used, so probing always finds an empty slot
+    static std::size_t MaxLoad(std::size_t capacity) { return capacity - capacity / 8; }
+
+    static std::size_t CapacityFor(std::size_t count)
+    {
+        std::size_t capacity = MinCapacity;
+        while (MaxLoad(capacity) < count)
+            capacity *= 2;
+        return capacity;
+    }
+
+    iterator IteratorAt(std::size_t slot) { return iterator(_control + slot, _control + _capacity, _slots + slot); }
+    const_iterator IteratorAt(std::size_t slot) const { return const_iterator(_control + slot, _control + _capacity, _slots + slot); }
+
+    std::size_t FindSlot(key_type const& key) const
+    {
+        if (!_size)
+            return NoSlot;
+
+        std::size_t hash = MixHash(Hash()(key));
+        Control tag = TagOf(hash);
+        std::size_t mask = _capacity - 1;
+        for (std::size_t slot = (hash >> 7) & mask; ; slot = (slot + 1) & mask)
+        {
+            Control control = _control[slot];
+            if (control == tag && KeyEqual()(KeyOfValue()(_slots[slot]), key))
+                return slot;
+
+            if (control == Empty)
+                return NoSlot;
+        }
+    }
+
+    /// Caller guarantees that the key of the new value is not present yet
+    template<class... Args>
+    std::size_t InsertNew(Args&&... args)
+    {
+        if (_size + _deleted + 1 > MaxLoad(_capacity))
+        {
+            // deleted slots are dropped by rehashing, only grow if there are not enough of them to reuse
+            if (_capacity && _size + 1 <= MaxLoad(_capacity) / 2)
+                Rehash(_capacity);
+            else
+                Rehash(std::max(CapacityFor(_size + 1), _capacity * 2));
+        }
+
+        // the value is constructed before probing for its slot because args might only contain parts of it
+        alignas(value_type) unsigned char buffer[sizeof(value_type)];
+        value_type* value = std::construct_at(reinterpret_cast<value_type*>(buffer), std::forward<Args>(args)...);
+        std::size_t hash = MixHash(Hash()(KeyOfValue()(*value)));
+        std::size_t slot = FindFreeSlot(hash);
+        if (_control[slot] == Deleted)
+            --_deleted;
+
+        std::construct_at(_slots + slot, std::move(*value));
+        std::destroy_at(value);
+        _control[slot] = TagOf(hash);
+        ++_size;
+        return slot;
+    }
+
+    std::size_t FindFreeSlot(std::size_t hash) const
+    {
+        std::size_t mask = _capacity - 1;
+        std::size_t slot = (hash >> 7) & mask;
+        while (_control[slot] >= 0)
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void EraseSlot(std::size_t slot)
+    {
+        std::destroy_at(_slots + slot);
+        --_size;
+
+        std::size_t mask = _capacity - 1;
+        if (_control[(slot + 1) & mask] != Empty)
+        {
+            // probe sequences of other elements might continue past this slot
+            _control[slot] = Deleted;
+            ++_deleted;
+            return;
+        }
+
+        // nothing can be found by probing past this slot, neither past the deleted slots directly before it
+        _control[slot] = Empty;
+        for (std::size_t previous = (slot - 1) & mask; _control[previous] == Deleted; previous = (previous - 1) & mask)
+        {
+            _control[previous] = Empty;
+            --_deleted;
+        }
+    }
+
+    void Rehash(std::size_t capacity)
+    {
+        Control* oldControl = _control;
+        value_type* oldSlots = _slots;
+        std::size_t oldCapacity = _capacity;
+
+        _control = std::allocator<Control>().allocate(capacity);
+        _slots = std::allocator<value_type>().allocate(capacity);
+        _capacity = capacity;
+        _deleted = 0;
+        std::uninitialized_fill_n(_control, capacity, Empty);
+
+        for (std::size_t i = 0; i < oldCapacity; ++i)
+        {
+            if (oldControl[i] < 0)
+                continue;
+
+            std::size_t hash = MixHash(Hash()(KeyOfValue()(oldSlots[i])));
+            std::size_t slot = FindFreeSlot(hash);
+            std::construct_at(_slots + slot, std::move(oldSlots[i]));
+            std::destroy_at(oldSlots + i);
+            _control[slot] = TagOf(hash);
+        }
+
+        if (oldCapacity)
+        {
+            std::allocator<Control>().deallocate(oldControl, oldCapacity);
+            std::allocator<value_type>().deallocate(oldSlots, oldCapacity);
+        }
+    }
+
+    void Destroy()
+    {
+        if (!_capacity)
+            return;
+
+        clear();
+        std::allocator<Control>().deallocate(_control, _capacity);
+        std::allocator<value_type>().deallocate(_slots, _capacity);
+        _control = nullptr;
+        _slots = nullptr;
+        _capacity = 0;
+    }
+
+    Control* _control;
+    value_type* _slots;
+    std::size_t _capacity;
+    std::size_t _size;
+    std::size_t _deleted;
+};
+}
+
+#endif // TRINITYCORE_FLAT_HASH_TABLE_H
@@ -0,0 +1,211 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_INTRUSIVE_HEAP_H
+#define TRINITYCORE_INTRUSIVE_HEAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace Trinity::Containers
+{
+/// Array backed d-ary max heap that stores the position of every element in the element itself,
+/// IndexOf returns a reference to that position so that elements can be updated and removed in O(log n).
+/// Compare is a less-than comparison, top() is the greatest element.
+template <class T, class Compare, class IndexOf, std::size_t Arity = 4>
+class IntrusiveHeap
+{
+    static_assert(Arity >= 2);
+
+public:
+    using value_type = T;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    /// Visits the elements from greatest to smallest without modifying the heap, O(log n) per step.
+    /// Invalidated by any change to the heap.
+    class ordered_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T const*;
+        using reference = T const&;
+
+        ordered_iterator() : _heap(nullptr) { }
+        explicit ordered_iterator(IntrusiveHeap const* heap) : _heap(heap)
+        {
+            if (!heap->empty())
+                _candidates.push_back(0);
+        }
+
+        reference operator*() const { return _heap->_elements[_candidates.front()]; }
+        pointer operator->() const { return &_heap->_elements[_candidates.front()]; }
+
+        ordered_iterator& operator++()
+        {
+            auto compare = CandidateCompare{ _heap };
+            std::pop_heap(_candidates.begin(), _candidates.end(), compare);
+            std::size_t index = _candidates.back();
+            _candidates.pop_back();
+
+            std::size_t firstChild = index * Arity + 1;
+            std::size_t lastChild = std::min(firstChild + Arity, _heap->_elements.size());
+            for (std::size_t child = firstChild; child < lastChild; ++child)
+            {
+                _candidates.push_back(child);
+                std::push_heap(_candidates.begin(), _candidates.end(), compare);
+            }
+            return *this;
+        }
+
+        ordered_iterator operator++(int)
+        {
+            ordered_iterator itr = *this;
+            ++(*this);
+            return itr;
+        }
+
+        bool operator==(ordered_iterator const& other) const
+        {
+            if (_candidates.empty() || other._candidates.empty())
+                return _candidates.empty() == other._candidates.empty();
+
+            return _candidates.front() == other._candidates.front();
+        }
+
+        bool operator!=(ordered_iterator const& other) const { return !(*this == other); }
+
+    private:
+        struct CandidateCompare
+        {
+            IntrusiveHeap const* Heap;
+
+            bool operator()(std::size_t left, std::size_t right) const { return Heap->_compare(Heap->_elements[left], Heap->_elements[right]); }
+        };
+
+        IntrusiveHeap const* _heap;
+        std::vector<std::size_t> _candidates;
+    };
+
+    bool empty() const { return _elements.empty(); }
+    std::size_t size() const { return _elements.size(); }
+
+    /// Elements in heap order
+    const_iterator begin() const { return _elements.begin(); }
+    const_iterator end() const { return _elements.end(); }
+
+    ordered_iterator ordered_begin() const { return ordered_iterator(this); }
+    ordered_iterator ordered_end() const { return ordered_iterator(); }
+
+    T const& top() const { return _elements.front(); }
+
+    void push(T value)
+    {
+        _elements.push_back(std::move(value));
+        SiftUp(_elements.size() - 1);
+    }
+
+    void erase(T const& value)
+    {
+        std::size_t index = _indexOf(value);
+        if (index + 1 != _elements.size())
+        {
+            _elements[index] = std::move(_elements.back());
+            _elements.pop_back();
+            if (!SiftUp(index))
+                SiftDown(index);
+        }
+        else
+            _elements.pop_back();
+    }
+
+    /// Restores the heap after value compares greater than before
+    void increase(T const& value) { SiftUp(_indexOf(value)); }
+
+    /// Restores the heap after value compares less than before
+    void decrease(T const& value) { SiftDown(_indexOf(value)); }
+
+    /// Restores the heap after any change of value
+    void update(T const& value)
+    {
+        std::size_t index = _indexOf(value);
+        if (!SiftUp(index))
+            SiftDown(index);
+    }
+
+    void clear() { _elements.clear(); }
+
+private:
+    // returns false if the element at index stayed there
+    bool SiftUp(std::size_t index)
+    {
+        std::size_t start = index;
+        T value = std::move(_elements[index]);
+        while (index > 0)
+        {
+            std::size_t parent = (index - 1) / Arity;
+            if (!_compare(_elements[parent], value))
+                break;
+
+            _elements[index] = std::move(_elements[parent]);
+            _indexOf(_elements[index]) = index;
+            index = parent;
+        }
+
+        _elements[index] = std::move(value);
+        _indexOf(_elements[index]) = index;
+        return index != start;
+    }
+
+    void SiftDown(std::size_t index)
+    {
+        std::size_t size = _elements.size();
+        T value = std::move(_elements[index]);
+        while (true)
+        {
+            std::size_t firstChild = index * Arity + 1;
+            if (firstChild >= size)
+                break;
+
+            std::size_t lastChild = std::min(firstChild + Arity, size);
+            std::size_t greatest = firstChild;
+            for (std::size_t child = firstChild + 1; child < lastChild; ++child)
+                if (_compare(_elements[greatest], _elements[child]))
+                    greatest = child;
+
+            if (!_compare(value, _elements[greatest]))
+                break;
+
+            _elements[index] = std::move(_elements[greatest]);
+            _indexOf(_elements[index]) = index;
+            index = greatest;
+        }
+
+        _elements[index] = std::move(value);
+        _indexOf(_elements[index]) = index;
+    }
+
+    std::vector<T> _elements;
+    Compare _compare;
+    IndexOf _indexOf;
+};
+}
+
+#endif // TRINITYCORE_INTRUSIVE_HEAP_H
@@ -38,6 +38,11 @@ struct WorldPacketCryptIV
         memcpy(Value.data() + sizeof(uint64), &magic, sizeof(uint32));
     }
 
+    void SetCounter(uint64 counter)
+    {
+        memcpy(Value.data(), &counter, sizeof(uint64));
+    }
+
     std::array<uint8, 12> Value;
 };
 
@@ -82,3 +87,28 @@ bool WorldPacketCrypt::EncryptSend(uint8* data, size_t length, Trinity::Crypto::
     ++_serverCounter;
     return true;
 }
+
+bool WorldPacketCrypt::EncryptSend(std::span<SendBatchEntry const> packets)
+{
+    if (!_initialized)
+    {
+        for (SendBatchEntry const& packet : packets)
+            memset(packet.Tag, 0, Trinity::Crypto::AES::TAG_SIZE_BYTES);
+
+        _serverCounter += packets.size();
+        return true;
+    }
+
+    // only the counter part of the iv changes between packets, the cipher context keeps its key schedule
+    WorldPacketCryptIV iv{ _serverCounter, 0x52565253 };
+    for (SendBatchEntry const& packet : packets)
+    {
+        iv.SetCounter(_serverCounter);
+        if (!_serverEncrypt.Process(iv.Value, packet.Data, packet.Length, *reinterpret_cast<Trinity::Crypto::AES::Tag*>(packet.Tag)))
+            return false;
+
+        ++_serverCounter;
+    }
+
+    return true;
+}
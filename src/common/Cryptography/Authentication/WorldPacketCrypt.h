@@ -19,16 +19,26 @@
 #define _WORLDPACKETCRYPT_H
 
 #include "AES.h"
+#include <span>
 
 class TC_COMMON_API WorldPacketCrypt
 {
 public:
+    struct SendBatchEntry
+    {
+        uint8* Data;
+        uint32 Length;
+        uint8* Tag;     // Trinity::Crypto::AES::TAG_SIZE_BYTES bytes
+    };
+
     WorldPacketCrypt();
 
     void Init(Trinity::Crypto::AES::Key const& key);
     bool PeekDecryptRecv(uint8* data, size_t length);
     bool DecryptRecv(uint8* data, size_t length, Trinity::Crypto::AES::Tag& tag);
     bool EncryptSend(uint8* data, size_t length, Trinity::Crypto::AES::Tag& tag);
+    /// Encrypts packets in place in the given order, same result as calling EncryptSend for each of them
+    bool EncryptSend(std::span<SendBatchEntry const> packets);
 
     bool IsInitialized() const { return _initialized; }
 
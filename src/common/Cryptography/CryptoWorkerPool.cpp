@@ -0,0 +1,85 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CryptoWorkerPool.h"
+#include "ThreadPool.h"
+
+Trinity::Crypto::CryptoWorkerPool::CryptoWorkerPool() : _queuedTasks(0), _maxQueuedTasks(0), _maxQueuedTasksPerAddress(0)
+{
+}
+
+Trinity::Crypto::CryptoWorkerPool::~CryptoWorkerPool() = default;
+
+Trinity::Crypto::CryptoWorkerPool& Trinity::Crypto::CryptoWorkerPool::Instance()
+{
+    static CryptoWorkerPool instance;
+    return instance;
+}
+
+void Trinity::Crypto::CryptoWorkerPool::Start(uint32 threadCount, uint32 maxQueuedTasks, uint32 maxQueuedTasksPerAddress)
+{
+    _maxQueuedTasks = maxQueuedTasks;
+    _maxQueuedTasksPerAddress = maxQueuedTasksPerAddress;
+    if (threadCount)
+        _threads = std::make_unique<ThreadPool>(threadCount);
+}
+
+void Trinity::Crypto::CryptoWorkerPool::Stop()
+{
+    if (!_threads)
+        return;
+
+    _threads->Join();
+    _threads.reset();
+}
+
+bool Trinity::Crypto::CryptoWorkerPool::Enqueue(std::string const& address, std::packaged_task<std::function<void()>()>&& task)
+{
+    if (!_threads)
+    {
+        task();
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        uint32& queuedForAddress = _queuedTasksByAddress[address];
+        if ((_maxQueuedTasks && _queuedTasks >= _maxQueuedTasks) || (_maxQueuedTasksPerAddress && queuedForAddress >= _maxQueuedTasksPerAddress))
+        {
+            if (!queuedForAddress)
+                _queuedTasksByAddress.erase(address);
+
+            return false;
+        }
+
+        ++_queuedTasks;
+        ++queuedForAddress;
+    }
+
+    _threads->PostWork([this, address, task = std::move(task)]() mutable
+    {
+        task();
+
+        std::lock_guard<std::mutex> lock(_queueLock);
+        --_queuedTasks;
+        auto itr = _queuedTasksByAddress.find(address);
+        if (!--itr->second)
+            _queuedTasksByAddress.erase(itr);
+    });
+
+    return true;
+}
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_CRYPTO_WORKER_POOL_H
+#define TRINITY_CRYPTO_WORKER_POOL_H
+
+#include "AsyncCallbackProcessor.h"
+#include "Define.h"
+#include "Optional.h"
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace Trinity
+{
+class ThreadPool;
+}
+
+namespace Trinity::Crypto
+{
+    // completion of work done on the crypto threads, InvokeIfReady runs it on the thread polling the callback
+    class CryptoCallback
+    {
+    public:
+        explicit CryptoCallback(std::future<std::function<void()>>&& completion) : _completion(std::move(completion)) { }
+
+        bool InvokeIfReady()
+        {
+            if (_completion.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+
+            _completion.get()();
+            return true;
+        }
+
+    private:
+        std::future<std::function<void()>> _completion;
+    };
+
+    using CryptoCallbackProcessor = AsyncCallbackProcessor<CryptoCallback>;
+
+    /**
+        Bounded pool of threads for CPU heavy hashing and key derivation, keeps network threads responsive.
+        Without threads work is done inline and its callback is ready immediately.
+    */
+    class TC_COMMON_API CryptoWorkerPool
+    {
+    public:
+        static CryptoWorkerPool& Instance();
+
+        void Start(uint32 threadCount, uint32 maxQueuedTasks, uint32 maxQueuedTasksPerAddress);
+        void Stop();
+
+        /// Queues work() and returns a callback passing its result to completion, or nothing when the pool or the address is over its limit.
+        template<typename Work, typename Completion>
+        Optional<CryptoCallback> Post(std::string const& address, Work&& work, Completion&& completion)
+        {
+            using Result = std::invoke_result_t<Work>;
+            std::packaged_task<std::function<void()>()> task([work = std::forward<Work>(work), completion = std::forward<Completion>(completion)]() mutable -> std::function<void()>
+            {
+                return [completion = std::move(completion), result = std::make_shared<Result>(work())]() mutable { completion(std::move(*result)); };
+            });
+
+            std::future<std::function<void()>> result = task.get_future();
+            if (!Enqueue(address, std::move(task)))
+                return {};
+
+            return CryptoCallback(std::move(result));
+        }
+
+    private:
+        CryptoWorkerPool();
+        ~CryptoWorkerPool();
+
+        bool Enqueue(std::string const& address, std::packaged_task<std::function<void()>()>&& task);
+
+        std::unique_ptr<ThreadPool> _threads;
+        std::mutex _queueLock;
+        std::unordered_map<std::string, uint32> _queuedTasksByAddress;
+        uint32 _queuedTasks;
+        uint32 _maxQueuedTasks;
+        uint32 _maxQueuedTasksPerAddress;
+    };
+}
+
+#define sCryptoWorkerPool Trinity::Crypto::CryptoWorkerPool::Instance()
+
+#endif
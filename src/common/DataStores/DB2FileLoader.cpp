@@ -155,6 +155,11 @@ int32 DB2FileLoadInfo::GetFieldIndexByMetaIndex(uint32 metaIndex) const
 DB2FileSource::DB2FileSource() = default;
 DB2FileSource::~DB2FileSource() = default;
 
+std::shared_ptr<uint8 const> DB2FileSource::GetMappedData() const
+{
+    return nullptr;
+}
+
 class DB2FileLoaderImpl
 {
 public:
@@ -184,6 +189,7 @@ public:
     virtual DB2SectionHeader& GetSection(uint32 section) const = 0;
     virtual bool IsSignedField(uint32 field) const = 0;
     virtual char const* GetExpectedSignMismatchReason(uint32 field) const = 0;
+    virtual std::shared_ptr<uint8 const> GetMappedData() const = 0;
 
 private:
     friend class DB2Record;
@@ -231,6 +237,7 @@ public:
     DB2SectionHeader& GetSection(uint32 section) const override;
     bool IsSignedField(uint32 field) const override;
     char const* GetExpectedSignMismatchReason(uint32 field) const override;
+    std::shared_ptr<uint8 const> GetMappedData() const override { return _mappedData; }
 
 private:
     void FillParentLookup(char* dataTable);
@@ -255,8 +262,10 @@ private:
     char const* _fileName;
     DB2FileLoadInfo const* _loadInfo;
     DB2Header const* _header;
-    std::unique_ptr<uint8[]> _data;
-    uint8* _stringTable;
+    std::unique_ptr<uint8[]> _ownedData;
+    std::shared_ptr<uint8 const> _mappedData;
+    uint8 const* _data;
+    uint8 const* _stringTable;
     std::unique_ptr<DB2SectionHeader[]> _sections;
     std::unique_ptr<DB2ColumnMeta[]> _columnMeta;
     std::unique_ptr<std::unique_ptr<DB2PalletValue[]>[]> _palletValues;
@@ -297,6 +306,7 @@ public:
     DB2SectionHeader& GetSection(uint32 section) const override;
     bool IsSignedField(uint32 field) const override;
     char const* GetExpectedSignMismatchReason(uint32 field) const override;
+    std::shared_ptr<uint8 const> GetMappedData() const override { return nullptr; }
 
 private:
     void FillParentLookup(char* dataTable);
@@ -338,6 +348,7 @@ DB2FileLoaderRegularImpl::DB2FileLoaderRegularImpl(char const* fileName, DB2File
     _fileName(fileName),
     _loadInfo(loadInfo),
     _header(header),
+    _data(nullptr),
     _stringTable(nullptr)
 {
 }
@@ -355,10 +366,30 @@ void DB2FileLoaderRegularImpl::LoadColumnData(std::unique_ptr<DB2SectionHeader[]
 
 bool DB2FileLoaderRegularImpl::LoadTableData(DB2FileSource* source, uint32 section)
 {
-    if (!_data)
+    std::size_t tableDataSize = std::size_t(_header->RecordSize) * _header->RecordCount + _header->StringTableSize;
+
+    // single section files store records followed by strings exactly like we expect them in memory, use mapped files in place
+    if (_header->SectionCount == 1)
     {
-        _data = std::make_unique<uint8[]>(_header->RecordSize * _header->RecordCount + _header->StringTableSize + 8);
-        _stringTable = &_data[_header->RecordSize * _header->RecordCount];
+        if (std::shared_ptr<uint8 const> mappedData = source->GetMappedData())
+        {
+            // RecordGetPackedValue can read up to 8 bytes past the end of table data
+            int64 position = source->GetPosition();
+            if (position >= 0 && position + int64(tableDataSize) + 8 <= source->GetFileSize())
+            {
+                _mappedData = std::move(mappedData);
+                _data = _mappedData.get() + position;
+                _stringTable = &_data[_header->RecordSize * _header->RecordCount];
+                return source->SetPosition(position + tableDataSize);
+            }
+        }
+    }
+
+    if (!_ownedData)
+    {
+        _ownedData = std::make_unique<uint8[]>(tableDataSize + 8);
+        _data = _ownedData.get();
+        _stringTable = &_ownedData[_header->RecordSize * _header->RecordCount];
     }
 
     uint32 sectionDataStart = 0;
@@ -369,10 +400,10 @@ bool DB2FileLoaderRegularImpl::LoadTableData(DB2FileSource* source, uint32 secti
         sectionStringTableStart += _sections[i].StringTableSize;
     }
 
-    if (_sections[section].RecordCount && !source->Read(&_data[sectionDataStart], _header->RecordSize * _sections[section].RecordCount))
+    if (_sections[section].RecordCount && !source->Read(&_ownedData[sectionDataStart], _header->RecordSize * _sections[section].RecordCount))
         return false;
 
-    if (_sections[section].StringTableSize && !source->Read(&_stringTable[sectionStringTableStart], _sections[section].StringTableSize))
+    if (_sections[section].StringTableSize && !source->Read(&_ownedData[_header->RecordSize * _header->RecordCount + sectionStringTableStart], _sections[section].StringTableSize))
         return false;
 
     return true;
@@ -537,8 +568,15 @@ char* DB2FileLoaderRegularImpl::AutoProduceStrings(char** indexTable, uint32 ind
     if (!_loadInfo->GetStringFieldCount(false))
         return nullptr;
 
-    char* stringPool = new char[_header->StringTableSize];
-    memcpy(stringPool, _stringTable, _header->StringTableSize);
+    // strings of mapped files are used in place, caller keeps the mapping alive
+    char* stringPool = nullptr;
+    char const* strings = reinterpret_cast<char const*>(_stringTable);
+    if (!_mappedData)
+    {
+        stringPool = new char[_header->StringTableSize];
+        memcpy(stringPool, _stringTable, _header->StringTableSize);
+        strings = stringPool;
+    }
 
     uint32 y = 0;
 
@@ -594,13 +632,13 @@ char* DB2FileLoaderRegularImpl::AutoProduceStrings(char** indexTable, uint32 ind
                             break;
                         case FT_STRING:
                             if (char const* string = RecordGetString(rawRecord, x, z))
-                                reinterpret_cast<LocalizedString*>(&recordData[offset])->Str[locale] = stringPool + (string - reinterpret_cast<char const*>(_stringTable));
+                                reinterpret_cast<LocalizedString*>(&recordData[offset])->Str[locale] = strings + (string - reinterpret_cast<char const*>(_stringTable));
 
                             offset += sizeof(LocalizedString);
                             break;
                         case FT_STRING_NOT_LOCALIZED:
                             if (char const* string = RecordGetString(rawRecord, x, z))
-                                *reinterpret_cast<char**>(&recordData[offset]) = stringPool + (string - reinterpret_cast<char const*>(_stringTable));
+                                *reinterpret_cast<char const**>(&recordData[offset]) = strings + (string - reinterpret_cast<char const*>(_stringTable));
 
                             offset += sizeof(char*);
                             break;
@@ -823,7 +861,7 @@ T DB2FileLoaderRegularImpl::RecordGetVarInt(uint8 const* record, uint32 field, u
         }
         case DB2ColumnCompression::CommonData:
         {
-            uint32 id = RecordGetId(record, (record - _data.get()) / _header->RecordSize);
+            uint32 id = RecordGetId(record, (record - _data) / _header->RecordSize);
             T value;
             auto valueItr = _commonValues[field].find(id);
             if (valueItr != _commonValues[field].end())
@@ -2136,3 +2174,8 @@ DB2RecordCopy DB2FileLoader::GetRecordCopy(uint32 copyNumber) const
 {
     return _impl->GetRecordCopy(copyNumber);
 }
+
+std::shared_ptr<uint8 const> DB2FileLoader::GetMappedData() const
+{
+    return _impl->GetMappedData();
+}
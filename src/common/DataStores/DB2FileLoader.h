@@ -20,6 +20,7 @@
 
 #include "Common.h"
 #include <exception>
+#include <memory>
 #include <string>
 
 class DB2FileLoaderImpl;
@@ -122,6 +123,10 @@ struct TC_COMMON_API DB2FileSource
     virtual char const* GetFileName() const = 0;
 
     virtual DB2EncryptedSectionHandling HandleEncryptedSection(DB2SectionHeader const& sectionHeader) const = 0;
+
+    // Returns entire file contents mapped read-only into memory, nullptr if source is not memory mapped
+    // Mapping stays valid for as long as the returned pointer is kept alive
+    virtual std::shared_ptr<uint8 const> GetMappedData() const;
 };
 
 class TC_COMMON_API DB2Record
@@ -214,6 +219,9 @@ public:
     DB2Record GetRecord(uint32 recordNumber) const;
     DB2RecordCopy GetRecordCopy(uint32 copyNumber) const;
 
+    // Returns the source mapping if strings produced by AutoProduceStrings point into it
+    std::shared_ptr<uint8 const> GetMappedData() const;
+
 private:
     DB2FileLoaderImpl* _impl;
     DB2Header _header;
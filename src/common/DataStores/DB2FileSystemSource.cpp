@@ -17,10 +17,29 @@
 
 #include "DB2FileSystemSource.h"
 #include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <cstring>
 
-DB2FileSystemSource::DB2FileSystemSource(std::string const& fileName)
+DB2FileSystemSource::DB2FileSystemSource(std::string const& fileName, bool memoryMapped /*= false*/) : _file(nullptr), _mappingPosition(0)
 {
     _fileName = fileName;
+
+    if (memoryMapped)
+    {
+        try
+        {
+            _mapping = std::make_shared<boost::iostreams::mapped_file_source>(_fileName);
+            if (_mapping->is_open())
+                return;
+        }
+        catch (std::exception const&)
+        {
+            // fall back to regular file reads, missing files are reported by IsOpen
+        }
+
+        _mapping = nullptr;
+    }
+
     _file = fopen(_fileName.c_str(), "rb");
 }
 
@@ -32,26 +51,51 @@ DB2FileSystemSource::~DB2FileSystemSource()
 
 bool DB2FileSystemSource::IsOpen() const
 {
-    return _file != nullptr;
+    return _file != nullptr || _mapping != nullptr;
 }
 
 bool DB2FileSystemSource::Read(void* buffer, std::size_t numBytes)
 {
+    if (_mapping)
+    {
+        if (_mappingPosition + int64(numBytes) > int64(_mapping->size()))
+            return false;
+
+        memcpy(buffer, _mapping->data() + _mappingPosition, numBytes);
+        _mappingPosition += numBytes;
+        return true;
+    }
+
     return fread(buffer, numBytes, 1, _file) == 1;
 }
 
 int64 DB2FileSystemSource::GetPosition() const
 {
+    if (_mapping)
+        return _mappingPosition;
+
     return ftell(_file);
 }
 
 bool DB2FileSystemSource::SetPosition(int64 position)
 {
+    if (_mapping)
+    {
+        if (position < 0 || position > int64(_mapping->size()))
+            return false;
+
+        _mappingPosition = position;
+        return true;
+    }
+
     return fseek(_file, position, SEEK_SET) == 0;
 }
 
 int64 DB2FileSystemSource::GetFileSize() const
 {
+    if (_mapping)
+        return _mapping->size();
+
     boost::system::error_code error;
     int64 size = boost::filesystem::file_size(_fileName, error);
     return !error ? size : 0;
@@ -66,3 +110,11 @@ DB2EncryptedSectionHandling DB2FileSystemSource::HandleEncryptedSection(DB2Secti
 {
     return DB2EncryptedSectionHandling::Skip;
 }
+
+std::shared_ptr<uint8 const> DB2FileSystemSource::GetMappedData() const
+{
+    if (!_mapping)
+        return nullptr;
+
+    return std::shared_ptr<uint8 const>(_mapping, reinterpret_cast<uint8 const*>(_mapping->data()));
+}
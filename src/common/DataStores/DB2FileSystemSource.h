@@ -21,9 +21,14 @@
 #include "DB2FileLoader.h"
 #include <string>
 
+namespace boost::iostreams
+{
+class mapped_file_source;
+}
+
 struct TC_COMMON_API DB2FileSystemSource : public DB2FileSource
 {
-    DB2FileSystemSource(std::string const& fileName);
+    DB2FileSystemSource(std::string const& fileName, bool memoryMapped = false);
     DB2FileSystemSource(DB2FileSystemSource const& other) = delete;
     DB2FileSystemSource(DB2FileSystemSource&& other) noexcept = delete;
     DB2FileSystemSource& operator=(DB2FileSystemSource const& other) = delete;
@@ -36,10 +41,13 @@ struct TC_COMMON_API DB2FileSystemSource : public DB2FileSource
     int64 GetFileSize() const override;
     char const* GetFileName() const override;
     DB2EncryptedSectionHandling HandleEncryptedSection(DB2SectionHeader const& sectionHeader) const override;
+    std::shared_ptr<uint8 const> GetMappedData() const override;
 
 private:
     std::string _fileName;
     FILE* _file;
+    std::shared_ptr<boost::iostreams::mapped_file_source> _mapping;
+    int64 _mappingPosition;
 };
 
 #endif // DB2FileSystemSource_h__
@@ -29,7 +29,12 @@
 #include "Util.h"
 #include <sstream>
 
-Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr)
+namespace
+{
+    thread_local std::vector<std::unique_ptr<LogMessage>>* CapturedMessages = nullptr;
+}
+
+Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr), _deferFormatting(false)
 {
     m_logsTimestamp = "_" + GetTimestampStr();
     RegisterAppender<AppenderConsole>();
@@ -226,6 +231,25 @@ void Log::OutMessageImpl(std::string_view filter, LogLevel level, std::string&&
     write(std::make_unique<LogMessage>(level, std::string(filter), std::move(message)));
 }
 
+void Log::OutMessageDeferredImpl(std::string_view filter, LogLevel level, std::function<std::string()>&& formatter)
+{
+    if (CapturedMessages)
+    {
+        CapturedMessages->push_back(std::make_unique<LogMessage>(level, std::string(filter), formatter()));
+        return;
+    }
+
+    Logger const* logger = GetLoggerByType(filter);
+    time_t messageTime = time(nullptr);
+    Trinity::Asio::post(*_ioContext, Trinity::Asio::bind_executor(*_strand,
+        [logger, level, type = std::string(filter), messageTime, formatter = std::move(formatter)]()
+    {
+        LogMessage message(level, type, formatter());
+        message.mtime = messageTime;
+        logger->write(&message);
+    }));
+}
+
 void Log::OutCommandImpl(std::string&& message, std::string&& param1)
 {
     write(std::make_unique<LogMessage>(LOG_LEVEL_INFO, "commands.gm", std::move(message), std::move(param1)));
@@ -233,6 +257,12 @@ void Log::OutCommandImpl(std::string&& message, std::string&& param1)
 
 void Log::write(std::unique_ptr<LogMessage>&& msg) const
 {
+    if (CapturedMessages)
+    {
+        CapturedMessages->push_back(std::move(msg));
+        return;
+    }
+
     Logger const* logger = GetLoggerByType(msg->type);
 
     if (_ioContext)
@@ -244,6 +274,19 @@ void Log::write(std::unique_ptr<LogMessage>&& msg) const
         logger->write(msg.get());
 }
 
+void Log::SetMessageCapture(std::vector<std::unique_ptr<LogMessage>>* messages)
+{
+    CapturedMessages = messages;
+}
+
+void Log::WriteCapturedMessages(std::vector<std::unique_ptr<LogMessage>>& messages) const
+{
+    for (std::unique_ptr<LogMessage>& message : messages)
+        write(std::move(message));
+
+    messages.clear();
+}
+
 Logger const* Log::GetLoggerByType(std::string_view type) const
 {
     auto it = loggers.find(type);
@@ -390,6 +433,7 @@ void Log::SetSynchronous()
     delete _strand;
     _strand = nullptr;
     _ioContext = nullptr;
+    _deferFormatting = false;
 }
 
 void Log::LoadFromConfig()
@@ -405,4 +449,6 @@ void Log::LoadFromConfig()
 
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+
+    _deferFormatting = _ioContext && sConfigMgr->GetBoolDefault("Log.Async.DeferFormatting", false);
 }
@@ -22,7 +22,11 @@
 #include "AsioHacksFwd.h"
 #include "LogCommon.h"
 #include "StringFormat.h"
+#include <functional>
 #include <memory>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -42,6 +46,23 @@ namespace Trinity
 
 typedef Appender*(*AppenderCreatorFn)(uint8 id, std::string const& name, LogLevel level, AppenderFlags flags, std::vector<std::string_view> const& extraArgs);
 
+namespace Trinity::Impl
+{
+    // arguments that can still be formatted after the caller returned, strings are copied
+    template<typename T>
+    struct DeferredLogArg
+    {
+        static constexpr bool Value = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+        using Type = T;
+    };
+
+    template<>
+    struct DeferredLogArg<std::string> { static constexpr bool Value = true; using Type = std::string; };
+
+    template<>
+    struct DeferredLogArg<std::string_view> { static constexpr bool Value = true; using Type = std::string; };
+}
+
 template <class AppenderImpl>
 Appender* CreateAppender(uint8 id, std::string const& name, LogLevel level, AppenderFlags flags, std::vector<std::string_view> const& extraArgs)
 {
@@ -71,6 +92,29 @@ class TC_COMMON_API Log
         template<typename... Args>
         void OutMessage(std::string_view filter, LogLevel const level, Trinity::FormatString<Args...> fmt, Args&&... args)
         {
+            if constexpr ((Trinity::Impl::DeferredLogArg<std::decay_t<Args>>::Value && ...))
+            {
+                if (_deferFormatting)
+                {
+                    // format strings are literals, only their view is kept
+                    OutMessageDeferredImpl(filter, level, [fmt = fmt::string_view(fmt), formatArgs = std::tuple<typename Trinity::Impl::DeferredLogArg<std::decay_t<Args>>::Type...>(std::forward<Args>(args)...)]()
+                    {
+                        return std::apply([fmt](auto const&... formatArgs) -> std::string
+                        {
+                            try
+                            {
+                                return fmt::vformat(fmt, fmt::make_format_args(formatArgs...));
+                            }
+                            catch (std::exception const& formatError)
+                            {
+                                return fmt::format("An error occurred formatting string \"{}\" : {}", fmt, formatError.what());
+                            }
+                        }, formatArgs);
+                    });
+                    return;
+                }
+            }
+
             OutMessageImpl(filter, level, Trinity::StringFormat(fmt, std::forward<Args>(args)...));
         }
 
@@ -85,6 +129,11 @@ class TC_COMMON_API Log
 
         void OutCharDump(char const* str, uint32 account_id, uint64 guid, char const* name);
 
+        /// Messages logged by the calling thread are moved to messages instead of being written, nullptr stops capturing
+        static void SetMessageCapture(std::vector<std::unique_ptr<LogMessage>>* messages);
+        /// Writes messages collected with SetMessageCapture in their original order
+        void WriteCapturedMessages(std::vector<std::unique_ptr<LogMessage>>& messages) const;
+
         void SetRealmId(uint32 id);
 
         template<class AppenderImpl>
@@ -112,6 +161,7 @@ class TC_COMMON_API Log
         void ReadLoggersFromConfig();
         void RegisterAppender(uint8 index, AppenderCreatorFn appenderCreateFn);
         void OutMessageImpl(std::string_view filter, LogLevel level, std::string&& message);
+        void OutMessageDeferredImpl(std::string_view filter, LogLevel level, std::function<std::string()>&& formatter);
         void OutCommandImpl(std::string&& message, std::string&& param1);
 
         std::unordered_map<uint8, AppenderCreatorFn> appenderFactory;
@@ -125,6 +175,9 @@ class TC_COMMON_API Log
 
         Trinity::Asio::IoContext* _ioContext;
         Trinity::Asio::Strand* _strand;
+
+        // messages with only value and string arguments are formatted on the logging strand
+        bool _deferFormatting;
 };
 
 #define sLog Log::instance()
@@ -0,0 +1,206 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryStats.h"
+#include "Metric.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS || TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
+#include <malloc.h>
+#endif
+
+#ifdef TRINITY_HAS_JEMALLOC
+// jemalloc is built without a symbol prefix, only the control interface is needed here
+extern "C" int mallctl(char const* name, void* oldp, std::size_t* oldlenp, void* newp, std::size_t newlen);
+#endif
+
+namespace
+{
+struct Registry
+{
+    std::mutex Lock;
+    std::vector<std::pair<std::string, std::vector<unsigned>>> Arenas;
+    std::vector<std::pair<std::string, std::function<std::size_t()>>> Owners;
+
+    static Registry& Instance()
+    {
+        static Registry instance;
+        return instance;
+    }
+};
+
+#ifdef TRINITY_HAS_JEMALLOC
+template<typename T>
+bool ReadValue(char const* name, T& value)
+{
+    std::size_t size = sizeof(T);
+    return mallctl(name, &value, &size, nullptr, 0) == 0;
+}
+
+// jemalloc caches statistics until the epoch is advanced
+void RefreshStats()
+{
+    uint64 epoch = 1;
+    std::size_t size = sizeof(epoch);
+    mallctl("epoch", &epoch, &size, &epoch, size);
+}
+#endif
+}
+
+bool Trinity::MemoryStats::IsAllocatorIntrospectionAvailable()
+{
+#ifdef TRINITY_HAS_JEMALLOC
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool Trinity::MemoryStats::GetAllocatorStats(AllocatorStats& stats)
+{
+#ifdef TRINITY_HAS_JEMALLOC
+    RefreshStats();
+
+    std::size_t allocated = 0, active = 0, metadata = 0, resident = 0, mapped = 0, retained = 0;
+    if (!ReadValue("stats.allocated", allocated)
+        || !ReadValue("stats.active", active)
+        || !ReadValue("stats.metadata", metadata)
+        || !ReadValue("stats.resident", resident)
+        || !ReadValue("stats.mapped", mapped)
+        || !ReadValue("stats.retained", retained))
+        return false;
+
+    stats.Allocated = allocated;
+    stats.Active = active;
+    stats.Metadata = metadata;
+    stats.Resident = resident;
+    stats.Mapped = mapped;
+    stats.Retained = retained;
+    return true;
+#else
+    (void)stats;
+    return false;
+#endif
+}
+
+void Trinity::MemoryStats::BindThreadArena(std::string const& name)
+{
+#ifdef TRINITY_HAS_JEMALLOC
+    unsigned arena = 0;
+    if (!ReadValue("arenas.create", arena))
+        return;
+
+    if (mallctl("thread.arena", nullptr, nullptr, &arena, sizeof(arena)) != 0)
+        return;
+
+    Registry& registry = Registry::Instance();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    auto itr = std::find_if(registry.Arenas.begin(), registry.Arenas.end(), [&](std::pair<std::string, std::vector<unsigned>> const& group) { return group.first == name; });
+    if (itr == registry.Arenas.end())
+        itr = registry.Arenas.emplace(registry.Arenas.end(), name, std::vector<unsigned>());
+
+    itr->second.push_back(arena);
+#else
+    (void)name;
+#endif
+}
+
+std::vector<Trinity::MemoryStats::ArenaStats> Trinity::MemoryStats::GetArenaStats()
+{
+    std::vector<ArenaStats> result;
+#ifdef TRINITY_HAS_JEMALLOC
+    RefreshStats();
+
+    Registry& registry = Registry::Instance();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    result.reserve(registry.Arenas.size());
+    for (auto const& [name, arenas] : registry.Arenas)
+    {
+        ArenaStats& stats = result.emplace_back();
+        stats.Name = name;
+        stats.Threads = uint32(arenas.size());
+        for (unsigned arena : arenas)
+        {
+            std::size_t small = 0, large = 0;
+            ReadValue(Trinity::StringFormat("stats.arenas.{}.small.allocated", arena).c_str(), small);
+            ReadValue(Trinity::StringFormat("stats.arenas.{}.large.allocated", arena).c_str(), large);
+            stats.Allocated += small + large;
+        }
+    }
+#endif
+    return result;
+}
+
+std::size_t Trinity::MemoryStats::GetAllocationSize(void const* ptr)
+{
+    if (!ptr)
+        return 0;
+
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS
+    return _msize(const_cast<void*>(ptr));
+#elif TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
+    return malloc_usable_size(const_cast<void*>(ptr));
+#else
+    return 0;
+#endif
+}
+
+void Trinity::MemoryStats::RegisterOwner(std::string name, std::function<std::size_t()> estimator)
+{
+    Registry& registry = Registry::Instance();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    registry.Owners.emplace_back(std::move(name), std::move(estimator));
+}
+
+std::vector<Trinity::MemoryStats::OwnerStats> Trinity::MemoryStats::GetOwnerStats()
+{
+    std::vector<OwnerStats> result;
+
+    Registry& registry = Registry::Instance();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    result.reserve(registry.Owners.size());
+    for (auto const& [name, estimator] : registry.Owners)
+        result.push_back({ name, estimator() });
+
+    return result;
+}
+
+void Trinity::MemoryStats::LogMetrics()
+{
+    if (!sMetric->IsEnabled())
+        return;
+
+    AllocatorStats allocator;
+    if (GetAllocatorStats(allocator))
+    {
+        TC_METRIC_VALUE("memory_allocator", allocator.Allocated, TC_METRIC_TAG("type", "allocated"));
+        TC_METRIC_VALUE("memory_allocator", allocator.Active, TC_METRIC_TAG("type", "active"));
+        TC_METRIC_VALUE("memory_allocator", allocator.Metadata, TC_METRIC_TAG("type", "metadata"));
+        TC_METRIC_VALUE("memory_allocator", allocator.Resident, TC_METRIC_TAG("type", "resident"));
+        TC_METRIC_VALUE("memory_allocator", allocator.Mapped, TC_METRIC_TAG("type", "mapped"));
+        TC_METRIC_VALUE("memory_allocator", allocator.Retained, TC_METRIC_TAG("type", "retained"));
+    }
+
+    for (ArenaStats const& arena : GetArenaStats())
+        TC_METRIC_VALUE("memory_arena", arena.Allocated, TC_METRIC_TAG("arena", arena.Name));
+
+    for (OwnerStats const& owner : GetOwnerStats())
+        TC_METRIC_VALUE("memory_owner", owner.Size, TC_METRIC_TAG("owner", owner.Name));
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MEMORY_STATS_H
+#define TRINITY_MEMORY_STATS_H
+
+#include "Define.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * In-process view of where memory goes.
+ *
+ * Allocator and arena statistics come from jemalloc and are only available when the server
+ * is linked against it (Linux builds without NOJEM). Owner statistics are estimates reported
+ * by the subsystems holding the most memory and are available everywhere.
+ */
+namespace Trinity::MemoryStats
+{
+    struct AllocatorStats
+    {
+        uint64 Allocated = 0;   // bytes requested by the application
+        uint64 Active = 0;      // bytes in pages holding allocations
+        uint64 Metadata = 0;    // allocator bookkeeping
+        uint64 Resident = 0;    // bytes in physically resident pages mapped by the allocator
+        uint64 Mapped = 0;
+        uint64 Retained = 0;    // virtual memory kept for reuse but returned to the os
+    };
+
+    struct ArenaStats
+    {
+        std::string Name;
+        uint32 Threads = 0;
+        uint64 Allocated = 0;
+    };
+
+    struct OwnerStats
+    {
+        std::string Name;
+        uint64 Size = 0;
+    };
+
+    TC_COMMON_API bool IsAllocatorIntrospectionAvailable();
+    TC_COMMON_API bool GetAllocatorStats(AllocatorStats& stats);
+
+    // moves allocations made by the calling thread to a new arena reported under name,
+    // the same name is used by all threads of a pool so they are reported together
+    TC_COMMON_API void BindThreadArena(std::string const& name);
+    TC_COMMON_API std::vector<ArenaStats> GetArenaStats();
+
+    // size of the heap block ptr points to, 0 if the platform can't tell
+    TC_COMMON_API std::size_t GetAllocationSize(void const* ptr);
+
+    // estimators must be callable on the world thread, that is where GetOwnerStats and LogMetrics run
+    TC_COMMON_API void RegisterOwner(std::string name, std::function<std::size_t()> estimator);
+    TC_COMMON_API std::vector<OwnerStats> GetOwnerStats();
+
+    TC_COMMON_API void LogMetrics();
+
+    // shallow estimate, memory owned by the elements themselves (strings, nested containers) is not included
+    template<class Container>
+    std::size_t EstimateContainerMemory(Container const& container)
+    {
+        if constexpr (requires { container.capacity(); })
+            return container.capacity() * sizeof(typename Container::value_type);
+        else if constexpr (requires { container.bucket_count(); })
+            return container.size() * (sizeof(typename Container::value_type) + sizeof(void*) * 2) + container.bucket_count() * sizeof(void*);
+        else
+            return container.size() * (sizeof(typename Container::value_type) + sizeof(void*) * 4);
+    }
+}
+
+#endif // TRINITY_MEMORY_STATS_H
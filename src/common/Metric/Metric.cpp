@@ -19,15 +19,57 @@
 #include "Config.h"
 #include "DeadlineTimer.h"
 #include "Log.h"
+#include "MetricScrapeServer.h"
 #include "Strand.h"
+#include "StringFormat.h"
 #include "Util.h"
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <map>
+
+MetricHandle::MetricHandle(MetricHandleType type, std::string category, std::string series, std::string labels) : _type(type),
+    _category(std::move(category)), _series(std::move(series)), _labels(std::move(labels)),
+    _count(0), _sum(0), _last(0), _min(std::numeric_limits<int64>::max()), _max(std::numeric_limits<int64>::min()),
+    _totalCount(0), _totalSum(0)
+{
+}
+
+std::string MetricHandle::ConsumeInterval()
+{
+    int64 count = _count.exchange(0, std::memory_order_relaxed);
+    if (!count)
+        return {};
+
+    _totalCount += count;
+    switch (_type)
+    {
+        case MetricHandleType::Counter:
+        {
+            int64 sum = _sum.exchange(0, std::memory_order_relaxed);
+            _totalSum += sum;
+            return Trinity::StringFormat("value={}i", sum);
+        }
+        case MetricHandleType::Gauge:
+            return Trinity::StringFormat("value={}i", _last.load(std::memory_order_relaxed));
+        case MetricHandleType::Histogram:
+        {
+            int64 sum = _sum.exchange(0, std::memory_order_relaxed);
+            int64 min = _min.exchange(std::numeric_limits<int64>::max(), std::memory_order_relaxed);
+            int64 max = _max.exchange(std::numeric_limits<int64>::min(), std::memory_order_relaxed);
+            _totalSum += sum;
+            return Trinity::StringFormat("value={}i,min={}i,max={}i,count={}i", sum / count, min, max, count);
+        }
+    }
+
+    return {};
+}
 
 void Metric::Initialize(std::string const& realmName, Trinity::Asio::IoContext& ioContext, std::function<void()> overallStatusLogger)
 {
     _dataStream = std::make_unique<boost::asio::ip::tcp::iostream>();
     _realmName = FormatInfluxDBTagValue(realmName);
+    if (!realmName.empty())
+        _openMetricsRealmLabel = "realm=\"" + FormatOpenMetricsLabelValue(realmName) + '"';
     _batchTimer = std::make_unique<Trinity::Asio::DeadlineTimer>(ioContext);
     _overallStatusTimer = std::make_unique<Trinity::Asio::DeadlineTimer>(ioContext);
     _overallStatusLogger = overallStatusLogger;
@@ -82,23 +124,31 @@ void Metric::LoadFromConfigs()
     if (_enabled && !previousValue)
     {
         std::string connectionInfo = sConfigMgr->GetStringDefault("Metric.ConnectionInfo", "");
-        if (connectionInfo.empty())
+        int32 openMetricsPort = sConfigMgr->GetIntDefault("Metric.OpenMetrics.Port", 0);
+        if (connectionInfo.empty() && openMetricsPort <= 0)
         {
-            TC_LOG_ERROR("metric", "'Metric.ConnectionInfo' not specified in configuration file.");
+            TC_LOG_ERROR("metric", "Neither 'Metric.ConnectionInfo' nor 'Metric.OpenMetrics.Port' specified in configuration file.");
             return;
         }
 
-        std::vector<std::string_view> tokens = Trinity::Tokenize(connectionInfo, ';', true);
-        if (tokens.size() != 3)
+        _hostname.clear();
+        if (!connectionInfo.empty())
         {
-            TC_LOG_ERROR("metric", "'Metric.ConnectionInfo' specified with wrong format in configuration file.");
-            return;
+            std::vector<std::string_view> tokens = Trinity::Tokenize(connectionInfo, ';', true);
+            if (tokens.size() != 3)
+            {
+                TC_LOG_ERROR("metric", "'Metric.ConnectionInfo' specified with wrong format in configuration file.");
+                return;
+            }
+
+            _hostname.assign(tokens[0]);
+            _port.assign(tokens[1]);
+            _databaseName.assign(tokens[2]);
+            Connect();
         }
 
-        _hostname.assign(tokens[0]);
-        _port.assign(tokens[1]);
-        _databaseName.assign(tokens[2]);
-        Connect();
+        if (openMetricsPort > 0)
+            StartScrapeServer();
 
         ScheduleSend();
         ScheduleOverallStatusLog();
@@ -122,6 +172,29 @@ bool Metric::ShouldLog(std::string const& category, int64 value) const
     return value >= threshold->second;
 }
 
+std::shared_ptr<MetricHandle> Metric::RegisterHandle(MetricHandleType type, std::string const& category, std::initializer_list<MetricTag> tags)
+{
+    std::string series = category;
+    std::string labels;
+    for (MetricTag const& tag : tags)
+    {
+        if (tag.first.empty())
+            continue;
+
+        series.append(",").append(tag.first).append("=").append(FormatInfluxDBTagValue(tag.second));
+        if (!labels.empty())
+            labels.append(",");
+        labels.append(tag.first).append("=\"").append(FormatOpenMetricsLabelValue(tag.second)).append("\"");
+    }
+
+    std::lock_guard<std::mutex> lock(_handlesLock);
+    std::shared_ptr<MetricHandle>& handle = _handles[series];
+    if (!handle)
+        handle = std::make_shared<MetricHandle>(type, category, series, std::move(labels));
+
+    return handle;
+}
+
 void Metric::LogEvent(std::string category, std::string title, std::string description)
 {
     using namespace std::chrono;
@@ -133,7 +206,8 @@ void Metric::LogEvent(std::string category, std::string title, std::string descr
     data->Title = std::move(title);
     data->ValueOrEventText = std::move(description);
 
-    _queuedData.Enqueue(data);
+    if (!_queuedData.Enqueue(data))
+        delete data;
 }
 
 void Metric::SendBatch()
@@ -181,8 +255,41 @@ void Metric::SendBatch()
         delete data;
     }
 
+    {
+        std::string timestamp = std::to_string(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+        std::lock_guard<std::mutex> lock(_handlesLock);
+        for (auto itr = _handles.begin(); itr != _handles.end();)
+        {
+            std::string fields = itr->second->ConsumeInterval();
+            if (!fields.empty())
+            {
+                if (!firstLoop)
+                    batchedData << "\n";
+
+                batchedData << itr->second->_series;
+                if (!_realmName.empty())
+                    batchedData << ",realm=" << _realmName;
+
+                batchedData << " " << fields << " " << timestamp;
+                firstLoop = false;
+            }
+
+            // nothing can record to it anymore
+            if (itr->second.use_count() == 1)
+                itr = _handles.erase(itr);
+            else
+                ++itr;
+        }
+
+        if (_scrapeServer)
+            UpdateOpenMetrics();
+    }
+
+    if (std::size_t rejected = _queuedData.ConsumeRejectedCount())
+        TC_LOG_ERROR("metric", "Metric queue was full, {} values and events were dropped", rejected);
+
     // Check if there's any data to send
-    if (batchedData.tellp() == std::streampos(0))
+    if (batchedData.tellp() == std::streampos(0) || _hostname.empty())
     {
         ScheduleSend();
         return;
@@ -230,6 +337,7 @@ void Metric::ScheduleSend()
     }
     else
     {
+        StopScrapeServer();
         static_cast<boost::asio::ip::tcp::iostream&>(GetDataStream()).close();
         MetricData* data;
         // Clear the queue
@@ -247,10 +355,99 @@ void Metric::Unload()
         SendBatch();
     }
 
+    StopScrapeServer();
     _batchTimer->cancel();
     _overallStatusTimer->cancel();
 }
 
+void Metric::StartScrapeServer()
+{
+    std::string bindIp = sConfigMgr->GetStringDefault("Metric.OpenMetrics.BindIP", "127.0.0.1");
+    int32 port = sConfigMgr->GetIntDefault("Metric.OpenMetrics.Port", 0);
+    if (port > std::numeric_limits<uint16>::max())
+    {
+        TC_LOG_ERROR("metric", "'Metric.OpenMetrics.Port' config set to {}, which is not a valid port.", port);
+        return;
+    }
+
+    StopScrapeServer();
+    _scrapeServer = std::make_shared<MetricScrapeServer>(Trinity::Asio::get_io_context(*_batchTimer), [this]() { return GetOpenMetrics(); });
+    if (_scrapeServer->Start(bindIp, uint16(port)))
+        TC_LOG_INFO("metric", "Serving OpenMetrics scrapes on {}:{}", bindIp, port);
+    else
+        _scrapeServer = nullptr;
+}
+
+void Metric::StopScrapeServer()
+{
+    if (!_scrapeServer)
+        return;
+
+    _scrapeServer->Close();
+    _scrapeServer = nullptr;
+}
+
+// called with _handlesLock held
+void Metric::UpdateOpenMetrics()
+{
+    char const* const TypeNames[] = { "counter", "gauge", "summary" };
+
+    // samples of a metric family must be contiguous, handles of the same category are grouped here
+    std::multimap<std::string_view, MetricHandle const*> families;
+    for (auto const& [series, handle] : _handles)
+        families.emplace(handle->_category, handle.get());
+
+    std::string text;
+    text.reserve(families.size() * 64);
+    std::string_view previousCategory;
+    for (auto const& [category, handle] : families)
+    {
+        if (category != previousCategory)
+        {
+            text.append("# TYPE ").append(category).append(" ").append(TypeNames[AsUnderlyingType(handle->_type)]).append("\n");
+            previousCategory = category;
+        }
+
+        std::string labels = _openMetricsRealmLabel;
+        if (!handle->_labels.empty())
+        {
+            if (!labels.empty())
+                labels.append(",");
+            labels.append(handle->_labels);
+        }
+        if (!labels.empty())
+            labels = "{" + labels + "}";
+
+        switch (handle->_type)
+        {
+            case MetricHandleType::Counter:
+                text.append(category).append("_total").append(labels).append(" ").append(std::to_string(handle->_totalSum)).append("\n");
+                break;
+            case MetricHandleType::Gauge:
+                text.append(category).append(labels).append(" ").append(std::to_string(handle->_last.load(std::memory_order_relaxed))).append("\n");
+                break;
+            case MetricHandleType::Histogram:
+                text.append(category).append("_count").append(labels).append(" ").append(std::to_string(handle->_totalCount)).append("\n");
+                text.append(category).append("_sum").append(labels).append(" ").append(std::to_string(handle->_totalSum)).append("\n");
+                break;
+        }
+    }
+    text.append("# EOF\n");
+
+    std::shared_ptr<std::string const> openMetrics = std::make_shared<std::string const>(std::move(text));
+    std::lock_guard<std::mutex> lock(_openMetricsLock);
+    _openMetrics.swap(openMetrics);
+}
+
+std::shared_ptr<std::string const> Metric::GetOpenMetrics()
+{
+    std::lock_guard<std::mutex> lock(_openMetricsLock);
+    if (!_openMetrics)
+        _openMetrics = std::make_shared<std::string const>("# EOF\n");
+
+    return _openMetrics;
+}
+
 void Metric::ScheduleOverallStatusLog()
 {
     if (_enabled)
@@ -301,17 +498,37 @@ std::string Metric::FormatInfluxDBTagValue(std::string const& value)
     return boost::replace_all_copy(value, " ", "\\ ");
 }
 
+std::string Metric::FormatOpenMetricsLabelValue(std::string const& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value)
+    {
+        switch (c)
+        {
+            case '\\': escaped.append("\\\\"); break;
+            case '"': escaped.append("\\\""); break;
+            case '\n': escaped.append("\\n"); break;
+            default: escaped.push_back(c); break;
+        }
+    }
+    return escaped;
+}
+
 std::string Metric::FormatInfluxDBValue(std::chrono::nanoseconds value)
 {
     return FormatInfluxDBValue(std::chrono::duration_cast<Milliseconds>(value).count());
 }
 
-Metric::Metric()
+Metric::Metric() : _queuedData(MaxQueuedData)
 {
 }
 
 Metric::~Metric()
 {
+    MetricData* data;
+    while (_queuedData.Dequeue(data))
+        delete data;
 }
 
 Metric* Metric::instance()
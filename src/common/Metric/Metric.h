@@ -22,9 +22,13 @@
 #include "Duration.h"
 #include "MPSCQueue.h"
 #include "Optional.h"
+#include <atomic>
 #include <functional>
+#include <initializer_list>
 #include <iosfwd>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -39,6 +43,8 @@ namespace Trinity
     }
 }
 
+class MetricScrapeServer;
+
 enum MetricDataType
 {
     METRIC_DATA_VALUE,
@@ -60,9 +66,76 @@ struct MetricData
     std::string Title;
 
     std::string ValueOrEventText;
+};
+
+enum class MetricHandleType
+{
+    Counter,    // sends the sum of values recorded in the interval
+    Gauge,      // sends the last value recorded in the interval
+    Histogram   // sends mean, min, max and count of values recorded in the interval
+};
+
+/**
+ * Series registered once with its category and tags, values recorded to it are aggregated
+ * in place and sent as a single line every batch interval instead of one line per value.
+ *
+ * Recording is lock free and does not allocate. A value recorded while the interval is
+ * being flushed may be counted in the next interval.
+ */
+class TC_COMMON_API MetricHandle
+{
+public:
+    MetricHandle(MetricHandleType type, std::string category, std::string series, std::string labels);
+
+    void Record(int64 value)
+    {
+        _count.fetch_add(1, std::memory_order_relaxed);
+        switch (_type)
+        {
+            case MetricHandleType::Counter:
+                _sum.fetch_add(value, std::memory_order_relaxed);
+                break;
+            case MetricHandleType::Gauge:
+                _last.store(value, std::memory_order_relaxed);
+                break;
+            case MetricHandleType::Histogram:
+            {
+                _sum.fetch_add(value, std::memory_order_relaxed);
+                int64 min = _min.load(std::memory_order_relaxed);
+                while (value < min && !_min.compare_exchange_weak(min, value, std::memory_order_relaxed))
+                    ;
+                int64 max = _max.load(std::memory_order_relaxed);
+                while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+                    ;
+                break;
+            }
+        }
+    }
 
-    // intrusive queue link
-    std::atomic<MetricData*> QueueLink;
+    void Record(std::chrono::nanoseconds value)
+    {
+        Record(int64(std::chrono::duration_cast<Milliseconds>(value).count()));
+    }
+
+private:
+    friend class Metric;
+
+    // resets the interval and adds it to the totals, returns the InfluxDB fields of it or an empty string if nothing was recorded
+    std::string ConsumeInterval();
+
+    MetricHandleType const _type;
+    std::string const _category;
+    std::string const _series;  // category and InfluxDB tags, without realm
+    std::string const _labels;  // OpenMetrics labels, without realm
+    std::atomic<int64> _count;
+    std::atomic<int64> _sum;
+    std::atomic<int64> _last;
+    std::atomic<int64> _min;
+    std::atomic<int64> _max;
+
+    // totals of all consumed intervals, only accessed by Metric
+    int64 _totalCount;
+    int64 _totalSum;
 };
 
 class TC_COMMON_API Metric
@@ -70,7 +143,9 @@ class TC_COMMON_API Metric
 private:
     std::iostream& GetDataStream() { return *_dataStream; }
     std::unique_ptr<std::iostream> _dataStream;
-    MPSCQueue<MetricData, &MetricData::QueueLink> _queuedData;
+    // bounded so that an unreachable database can not grow it without limit, data over capacity is dropped
+    static constexpr std::size_t MaxQueuedData = 32768;
+    Trinity::MPSCQueueBounded<MetricData*> _queuedData;
     std::unique_ptr<Trinity::Asio::DeadlineTimer> _batchTimer;
     std::unique_ptr<Trinity::Asio::DeadlineTimer> _overallStatusTimer;
     int32 _updateInterval = 0;
@@ -80,14 +155,24 @@ private:
     std::string _hostname;
     std::string _port;
     std::string _databaseName;
+    std::shared_ptr<MetricScrapeServer> _scrapeServer;
+    std::mutex _openMetricsLock;
+    std::shared_ptr<std::string const> _openMetrics;
     std::function<void()> _overallStatusLogger;
     std::string _realmName;
+    std::string _openMetricsRealmLabel;
     std::unordered_map<std::string, int64> _thresholds;
+    std::mutex _handlesLock;
+    std::unordered_map<std::string, std::shared_ptr<MetricHandle>> _handles;
 
     bool Connect();
     void SendBatch();
     void ScheduleSend();
     void ScheduleOverallStatusLog();
+    void StartScrapeServer();
+    void StopScrapeServer();
+    void UpdateOpenMetrics();
+    std::shared_ptr<std::string const> GetOpenMetrics();
 
     static std::string FormatInfluxDBValue(bool value);
     template <class T>
@@ -99,6 +184,7 @@ private:
     static std::string FormatInfluxDBValue(std::chrono::nanoseconds value);
 
     static std::string FormatInfluxDBTagValue(std::string const& value);
+    static std::string FormatOpenMetricsLabelValue(std::string const& value);
 
     // ToDo: should format TagKey and FieldKey too in the same way as TagValue
 
@@ -112,6 +198,10 @@ public:
     void Update();
     bool ShouldLog(std::string const& category, int64 value) const;
 
+    // returns the handle of the series, handles are shared by all callers registering the same category and tags
+    // and are unregistered after the last reference to them is released and their values were sent
+    std::shared_ptr<MetricHandle> RegisterHandle(MetricHandleType type, std::string const& category, std::initializer_list<MetricTag> tags = {});
+
     template<class T, class... TagsList>
     void LogValue(std::string category, T value, TagsList&&... tags)
     {
@@ -137,7 +227,8 @@ public:
             }
         }
 
-        _queuedData.Enqueue(data);
+        if (!_queuedData.Enqueue(data))
+            delete data;
     }
 
     void LogEvent(std::string category, std::string title, std::string description);
@@ -190,6 +281,8 @@ Optional<MetricStopWatch<LoggerType>> MakeMetricStopWatch(LoggerType&& loggerFun
 #define TC_METRIC_DETAILED_EVENT(category, title, description) ((void)0)
 #define TC_METRIC_DETAILED_TIMER(category, ...) ((void)0)
 #define TC_METRIC_DETAILED_NO_THRESHOLD_TIMER(category, ...) ((void)0)
+#define TC_METRIC_HANDLE_VALUE(handle, value) ((void)0)
+#define TC_METRIC_HANDLE_TIMER(handle) ((void)0)
 #else
 #  if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
 #define TC_METRIC_EVENT(category, title, description)                  \
@@ -202,6 +295,11 @@ Optional<MetricStopWatch<LoggerType>> MakeMetricStopWatch(LoggerType&& loggerFun
             if (sMetric->IsEnabled())                                  \
                 sMetric->LogValue(category, value, ##__VA_ARGS__);     \
         } while (0)
+#define TC_METRIC_HANDLE_VALUE(handle, value)                          \
+        do {                                                           \
+            if (sMetric->IsEnabled())                                  \
+                (handle)->Record(value);                               \
+        } while (0)
 #  else
 #define TC_METRIC_EVENT(category, title, description)                  \
         __pragma(warning(push))                                        \
@@ -219,7 +317,20 @@ Optional<MetricStopWatch<LoggerType>> MakeMetricStopWatch(LoggerType&& loggerFun
                 sMetric->LogValue(category, value, ##__VA_ARGS__);     \
         } while (0)                                                    \
         __pragma(warning(pop))
+#define TC_METRIC_HANDLE_VALUE(handle, value)                          \
+        __pragma(warning(push))                                        \
+        __pragma(warning(disable:4127))                                \
+        do {                                                           \
+            if (sMetric->IsEnabled())                                  \
+                (handle)->Record(value);                               \
+        } while (0)                                                    \
+        __pragma(warning(pop))
 #  endif
+#define TC_METRIC_HANDLE_TIMER(handle)                                                                           \
+        auto TC_METRIC_UNIQUE_NAME(__tc_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start)            \
+        {                                                                                                        \
+            (handle)->Record(std::chrono::steady_clock::now() - start);                                          \
+        });
 #define TC_METRIC_TIMER(category, ...)                                                                           \
         auto TC_METRIC_UNIQUE_NAME(__tc_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start)            \
         {                                                                                                        \
@@ -0,0 +1,165 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricScrapeServer.h"
+#include "DeadlineTimer.h"
+#include "IpAddress.h"
+#include "Log.h"
+#include "StringFormat.h"
+#include <boost/asio/post.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+#include <array>
+#include <istream>
+
+namespace
+{
+// scrape requests are a single line and a few headers
+constexpr std::size_t MaxRequestSize = 8192;
+constexpr int32 RequestTimeoutSeconds = 10;
+
+class ScrapeConnection : public std::enable_shared_from_this<ScrapeConnection>
+{
+public:
+    ScrapeConnection(boost::asio::io_context& ioContext, boost::asio::ip::tcp::socket&& socket, MetricScrapeServer::SnapshotGetter const& getSnapshot)
+        : _socket(std::move(socket)), _timeout(ioContext), _request(MaxRequestSize), _getSnapshot(getSnapshot)
+    {
+    }
+
+    void Start()
+    {
+        _timeout.expires_from_now(boost::posix_time::seconds(RequestTimeoutSeconds));
+        _timeout.async_wait([self = shared_from_this()](boost::system::error_code const& error)
+        {
+            if (!error)
+                self->Close();
+        });
+
+        boost::asio::async_read_until(_socket, _request, "\r\n\r\n", [self = shared_from_this()](boost::system::error_code const& error, std::size_t /*length*/)
+        {
+            if (error)
+                self->Close();
+            else
+                self->HandleRequest();
+        });
+    }
+
+private:
+    void HandleRequest()
+    {
+        std::istream request(&_request);
+        std::string method, target;
+        request >> method >> target;
+
+        if (method == "GET" && (target == "/metrics" || target.starts_with("/metrics?")))
+            _body = _getSnapshot();
+
+        char const* status = "200 OK";
+        if (!_body)
+        {
+            status = "404 Not Found";
+            _body = std::make_shared<std::string const>();
+        }
+
+        _header = Trinity::StringFormat("HTTP/1.1 {}\r\n"
+            "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+            "Content-Length: {}\r\n"
+            "Connection: close\r\n\r\n", status, _body->size());
+
+        std::array<boost::asio::const_buffer, 2> buffers = { boost::asio::buffer(_header), boost::asio::buffer(*_body) };
+        boost::asio::async_write(_socket, buffers, [self = shared_from_this()](boost::system::error_code const& /*error*/, std::size_t /*length*/)
+        {
+            self->Close();
+        });
+    }
+
+    void Close()
+    {
+        boost::system::error_code ignored;
+        _socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+        _socket.close(ignored);
+        _timeout.cancel();
+    }
+
+    boost::asio::ip::tcp::socket _socket;
+    Trinity::Asio::DeadlineTimer _timeout;
+    boost::asio::streambuf _request;
+    MetricScrapeServer::SnapshotGetter _getSnapshot;
+    std::string _header;
+    std::shared_ptr<std::string const> _body;
+};
+}
+
+MetricScrapeServer::MetricScrapeServer(boost::asio::io_context& ioContext, SnapshotGetter getSnapshot)
+    : _ioContext(ioContext), _acceptor(ioContext), _getSnapshot(std::move(getSnapshot))
+{
+}
+
+bool MetricScrapeServer::Start(std::string const& bindIp, uint16 port)
+{
+    boost::system::error_code error;
+    boost::asio::ip::address address = Trinity::Net::make_address(bindIp, error);
+    if (error)
+    {
+        TC_LOG_ERROR("metric", "Invalid OpenMetrics bind address '{}': {}", bindIp, error.message());
+        return false;
+    }
+
+    boost::asio::ip::tcp::endpoint endpoint(address, port);
+    _acceptor.open(endpoint.protocol(), error);
+#if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
+    if (!error)
+        _acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), error);
+#endif
+    if (!error)
+        _acceptor.bind(endpoint, error);
+    if (!error)
+        _acceptor.listen(boost::asio::socket_base::max_listen_connections, error);
+
+    if (error)
+    {
+        TC_LOG_ERROR("metric", "Could not listen for OpenMetrics scrapes on {}:{}: {}", bindIp, port, error.message());
+        return false;
+    }
+
+    AsyncAccept();
+    return true;
+}
+
+void MetricScrapeServer::Close()
+{
+    boost::asio::post(_ioContext, [self = shared_from_this()]
+    {
+        boost::system::error_code ignored;
+        self->_acceptor.close(ignored);
+    });
+}
+
+void MetricScrapeServer::AsyncAccept()
+{
+    _acceptor.async_accept([self = shared_from_this()](boost::system::error_code const& error, boost::asio::ip::tcp::socket socket)
+    {
+        if (error == boost::asio::error::operation_aborted)
+            return;
+
+        if (!error)
+            std::make_shared<ScrapeConnection>(self->_ioContext, std::move(socket), self->_getSnapshot)->Start();
+
+        self->AsyncAccept();
+    });
+}
@@ -0,0 +1,50 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MetricScrapeServer_h__
+#define MetricScrapeServer_h__
+
+#include "Define.h"
+#include <boost/asio/ip/tcp.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * Minimal HTTP server answering GET /metrics with the last OpenMetrics text built by Metric.
+ *
+ * Runs entirely on the io context threads, a scrape only copies a shared pointer to the text.
+ */
+class MetricScrapeServer : public std::enable_shared_from_this<MetricScrapeServer>
+{
+public:
+    using SnapshotGetter = std::function<std::shared_ptr<std::string const>()>;
+
+    MetricScrapeServer(boost::asio::io_context& ioContext, SnapshotGetter getSnapshot);
+
+    bool Start(std::string const& bindIp, uint16 port);
+    void Close();
+
+private:
+    void AsyncAccept();
+
+    boost::asio::io_context& _ioContext;
+    boost::asio::ip::tcp::acceptor _acceptor;
+    SnapshotGetter _getSnapshot;
+};
+
+#endif // MetricScrapeServer_h__
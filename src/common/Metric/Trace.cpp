@@ -0,0 +1,187 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Trace.h"
+#include "StringFormat.h"
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+// per thread, about a minute of a busy map thread
+constexpr std::size_t RingSize = 1 << 16;
+
+struct ZoneRecord
+{
+    // atomic so that dumping while the owning thread keeps writing is not a data race
+    std::atomic<char const*> Name;
+    std::atomic<int64> Start;
+    std::atomic<int64> Duration;
+};
+
+struct ThreadRing
+{
+    explicit ThreadRing(uint32 id) : Id(id), Written(0), Records(std::make_unique<ZoneRecord[]>(RingSize)) { }
+
+    uint32 const Id;
+    std::atomic<uint64> Written;
+    std::unique_ptr<ZoneRecord[]> Records;
+    std::string Name;   // guarded by Registry::Lock
+};
+
+struct Registry
+{
+    std::mutex Lock;
+    std::vector<std::shared_ptr<ThreadRing>> Rings;
+    uint32 NextThreadId = 1;
+};
+
+Registry& GetRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+ThreadRing& GetThreadRing()
+{
+    // the registry keeps the ring of exited threads until the next dump
+    thread_local std::shared_ptr<ThreadRing> const ring = []
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Lock);
+        std::shared_ptr<ThreadRing> newRing = std::make_shared<ThreadRing>(registry.NextThreadId++);
+        registry.Rings.push_back(newRing);
+        return newRing;
+    }();
+    return *ring;
+}
+
+int64 ToNanoseconds(TimePoint time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+void AppendJsonString(std::string& out, std::string_view value)
+{
+    out.push_back('"');
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+            out.push_back('\\');
+        if (uint8(c) >= 0x20)
+            out.push_back(c);
+    }
+    out.push_back('"');
+}
+}
+
+Trinity::Trace::Zone::~Zone()
+{
+    TimePoint end = std::chrono::steady_clock::now();
+    ThreadRing& ring = GetThreadRing();
+    uint64 index = ring.Written.load(std::memory_order_relaxed);
+    ZoneRecord& record = ring.Records[index & (RingSize - 1)];
+    record.Name.store(_name, std::memory_order_relaxed);
+    record.Start.store(ToNanoseconds(_start), std::memory_order_relaxed);
+    record.Duration.store(std::chrono::duration_cast<std::chrono::nanoseconds>(end - _start).count(), std::memory_order_relaxed);
+    ring.Written.store(index + 1, std::memory_order_release);
+}
+
+void Trinity::Trace::SetThreadName(std::string name)
+{
+    ThreadRing& ring = GetThreadRing();
+    std::lock_guard<std::mutex> lock(GetRegistry().Lock);
+    ring.Name = std::move(name);
+}
+
+bool Trinity::Trace::WriteChromeTrace(std::string const& fileName, Seconds duration, std::size_t* writtenZones)
+{
+    int64 since = ToNanoseconds(std::chrono::steady_clock::now() - duration);
+
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Lock);
+        rings = registry.Rings;
+
+        // rings only referenced by the registry belong to exited threads, this is their last dump
+        std::erase_if(registry.Rings, [](std::shared_ptr<ThreadRing> const& ring) { return ring.use_count() == 2; });
+    }
+
+    std::string json = "{\"traceEvents\":[";
+    std::size_t zones = 0;
+    bool first = true;
+    auto separate = [&]()
+    {
+        if (!first)
+            json.append(",\n");
+        first = false;
+    };
+
+    for (std::shared_ptr<ThreadRing> const& ring : rings)
+    {
+        {
+            std::lock_guard<std::mutex> lock(GetRegistry().Lock);
+            if (!ring->Name.empty())
+            {
+                separate();
+                json.append(Trinity::StringFormat(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":)", ring->Id));
+                AppendJsonString(json, ring->Name);
+                json.append("}}");
+            }
+        }
+
+        uint64 written = ring->Written.load(std::memory_order_acquire);
+        uint64 begin = written > RingSize ? written - RingSize : 0;
+        for (uint64 index = begin; index < written; ++index)
+        {
+            ZoneRecord const& record = ring->Records[index & (RingSize - 1)];
+            char const* name = record.Name.load(std::memory_order_relaxed);
+            int64 start = record.Start.load(std::memory_order_relaxed);
+            int64 zoneDuration = record.Duration.load(std::memory_order_relaxed);
+
+            // the owning thread kept writing and may have replaced this record while it was read
+            uint64 reused = ring->Written.load(std::memory_order_acquire);
+            if (reused >= RingSize && index <= reused - RingSize)
+                continue;
+
+            if (start + zoneDuration < since)
+                continue;
+
+            separate();
+            json.append(R"({"name":)");
+            AppendJsonString(json, name);
+            json.append(Trinity::StringFormat(R"(,"ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})", ring->Id, start / 1000.0, zoneDuration / 1000.0));
+            ++zones;
+        }
+    }
+
+    json.append("],\"displayTimeUnit\":\"ms\"}\n");
+
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file)
+        return false;
+
+    file.write(json.data(), json.size());
+    if (writtenZones)
+        *writtenZones = zones;
+
+    return bool(file);
+}
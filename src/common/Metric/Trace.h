@@ -0,0 +1,67 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TRACE_H
+#define TRINITY_TRACE_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <string>
+
+/**
+ * Scoped zone tracer, compiled in with WITH_TRACING.
+ *
+ * Every thread records the zones it leaves into its own ring buffer without locking,
+ * WriteChromeTrace dumps the zones of all threads ended in the last seconds as a
+ * Chrome trace event file that can be opened in chrome://tracing or Perfetto.
+ */
+namespace Trinity::Trace
+{
+    class TC_COMMON_API Zone
+    {
+    public:
+        // name must be a string literal, only the pointer is stored
+        explicit Zone(char const* name) : _name(name), _start(std::chrono::steady_clock::now()) { }
+        ~Zone();
+
+        Zone(Zone const&) = delete;
+        Zone& operator=(Zone const&) = delete;
+
+    private:
+        char const* _name;
+        TimePoint _start;
+    };
+
+    // names the calling thread in the trace
+    TC_COMMON_API void SetThreadName(std::string name);
+
+    // returns false if the file could not be written
+    TC_COMMON_API bool WriteChromeTrace(std::string const& fileName, Seconds duration, std::size_t* writtenZones = nullptr);
+}
+
+#define TC_TRACE_DO_CONCAT(a, b) a ## b
+#define TC_TRACE_CONCAT(a, b) TC_TRACE_DO_CONCAT(a, b)
+
+#if defined WITH_TRACING
+#define TC_TRACE_ZONE(name) Trinity::Trace::Zone TC_TRACE_CONCAT(__tc_trace_zone, __LINE__)(name)
+#define TC_TRACE_THREAD_NAME(name) Trinity::Trace::SetThreadName(name)
+#else
+#define TC_TRACE_ZONE(name) ((void)0)
+#define TC_TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif // TRINITY_TRACE_H
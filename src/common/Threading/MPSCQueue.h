@@ -20,7 +20,9 @@
 
 #include <array>
 #include <atomic>
+#include <memory>
 #include <new>
+#include <thread>
 
 namespace Trinity
 {
@@ -169,6 +171,104 @@ private:
 }
 }
 
+namespace Trinity
+{
+enum class MPSCQueueOverflowPolicy
+{
+    Drop,   // Enqueue fails and the rejected count is increased
+    Block   // Enqueue yields until the consumer made room
+};
+
+// Bounded array based MPSC queue, based on Dmitry Vyukov's bounded MPMC queue
+// http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+// Cells are allocated once, enqueuing never allocates
+template<typename T, MPSCQueueOverflowPolicy OverflowPolicy = MPSCQueueOverflowPolicy::Drop>
+class MPSCQueueBounded
+{
+public:
+    // capacity is rounded up to a power of two
+    explicit MPSCQueueBounded(std::size_t capacity) : _enqueuePos(0), _rejected(0), _dequeuePos(0)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+
+        _mask = size - 1;
+        _cells = std::make_unique<Cell[]>(size);
+        for (std::size_t i = 0; i < size; ++i)
+            _cells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    bool Enqueue(T input)
+    {
+        Cell* cell;
+        std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &_cells[pos & _mask];
+            std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos);
+            if (!diff)
+            {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                if constexpr (OverflowPolicy == MPSCQueueOverflowPolicy::Drop)
+                {
+                    _rejected.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+            else
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+
+        cell->Data = std::move(input);
+        cell->Sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Dequeue(T& result)
+    {
+        Cell* cell = &_cells[_dequeuePos & _mask];
+        std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+        if (std::ptrdiff_t(sequence) - std::ptrdiff_t(_dequeuePos + 1) < 0)
+            return false;
+
+        result = std::move(cell->Data);
+        cell->Sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+        ++_dequeuePos;
+        return true;
+    }
+
+    // number of Enqueue calls that failed since the last call
+    std::size_t ConsumeRejectedCount() { return _rejected.exchange(0, std::memory_order_relaxed); }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> Sequence;
+        T Data;
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    std::size_t _mask;
+    alignas(64) std::atomic<std::size_t> _enqueuePos;
+    std::atomic<std::size_t> _rejected;
+    alignas(64) std::size_t _dequeuePos;
+
+    MPSCQueueBounded(MPSCQueueBounded const&) = delete;
+    MPSCQueueBounded& operator=(MPSCQueueBounded const&) = delete;
+};
+}
+
 template<typename T, std::atomic<T*> T::* IntrusiveLink = nullptr>
 using MPSCQueue = std::conditional_t<IntrusiveLink != nullptr, Trinity::Impl::MPSCQueueIntrusive<T, IntrusiveLink>, Trinity::Impl::MPSCQueueNonIntrusive<T>>;
 
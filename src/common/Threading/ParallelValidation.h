@@ -0,0 +1,90 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PARALLEL_VALIDATION_H
+#define TRINITY_PARALLEL_VALIDATION_H
+
+#include "Log.h"
+#include "LogMessage.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <future>
+#include <iterator>
+#include <vector>
+
+namespace Trinity
+{
+/**
+ * Calls check for every element in [begin, end) using up to threads threads (0 - one per CPU core).
+ * check must only modify the element it is called with.
+ *
+ * Messages logged by check are held back until all elements are validated and then written in element order,
+ * startup logs look the same as if elements were validated one after another.
+ */
+template<typename Iterator, typename Check>
+void ValidateInParallel(Iterator begin, Iterator end, std::size_t threads, Check check)
+{
+    std::size_t count = std::distance(begin, end);
+    if (!threads)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    threads = std::min(threads, count);
+    if (threads <= 1)
+    {
+        for (; begin != end; ++begin)
+            check(*begin);
+        return;
+    }
+
+    // more ranges than threads to even out elements that are more expensive to check than others
+    std::size_t ranges = std::min(threads * 8, count);
+    std::vector<std::vector<std::unique_ptr<LogMessage>>> messages(ranges);
+    std::vector<std::future<void>> results;
+    results.reserve(ranges);
+
+    ThreadPool pool(threads);
+    for (std::size_t i = 0; i < ranges; ++i)
+    {
+        Iterator rangeEnd = std::next(begin, count / ranges + (i < count % ranges ? 1 : 0));
+        std::packaged_task<void()> task([rangeBegin = begin, rangeEnd, &check, &rangeMessages = messages[i]]()
+        {
+            struct CaptureGuard
+            {
+                explicit CaptureGuard(std::vector<std::unique_ptr<LogMessage>>* capture) { Log::SetMessageCapture(capture); }
+                ~CaptureGuard() { Log::SetMessageCapture(nullptr); }
+            } guard(&rangeMessages);
+
+            for (Iterator itr = rangeBegin; itr != rangeEnd; ++itr)
+                check(*itr);
+        });
+        results.push_back(task.get_future());
+        pool.PostWork(std::move(task));
+        begin = rangeEnd;
+    }
+
+    pool.Join();
+
+    for (std::vector<std::unique_ptr<LogMessage>>& rangeMessages : messages)
+        sLog->WriteCapturedMessages(rangeMessages);
+
+    // rethrow unexpected errors the same way serial validation would
+    for (std::future<void>& result : results)
+        result.get();
+}
+}
+
+#endif // TRINITY_PARALLEL_VALIDATION_H
@@ -17,6 +17,10 @@
 
 #include "ProcessPriority.h"
 #include "Log.h"
+#include "StringConvert.h"
+#include "Util.h"
+#include <array>
+#include <vector>
 
 #ifdef _WIN32 // Windows
 #include <Windows.h>
@@ -96,3 +100,75 @@ void SetProcessPriority(std::string const& logChannel, uint32 affinity, bool hig
     (void)highPriority;
 #endif
 }
+
+namespace
+{
+std::array<std::vector<uint32>, size_t(ThreadClass::Max)> ThreadClassProcessors;
+
+bool SetCurrentThreadAffinity(std::vector<uint32> const& processors)
+{
+#ifdef _WIN32
+    DWORD_PTR mask = 0;
+    for (uint32 processor : processors)
+        if (processor < sizeof(mask) * 8)
+            mask |= DWORD_PTR(1) << processor;
+
+    return mask && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (uint32 processor : processors)
+        if (processor < CPU_SETSIZE)
+            CPU_SET(processor, &mask);
+
+    // pid 0 is the calling thread
+    return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+    (void)processors;
+    return false;
+#endif
+}
+}
+
+void SetThreadClassAffinity(std::string const& logChannel, ThreadClass threadClass, std::string const& cpuList)
+{
+    std::vector<uint32>& processors = ThreadClassProcessors[size_t(threadClass)];
+    processors.clear();
+
+    for (std::string_view range : Trinity::Tokenize(cpuList, ',', false))
+    {
+        std::vector<std::string_view> bounds = Trinity::Tokenize(range, '-', true);
+        Optional<uint32> first = bounds.size() >= 1 && bounds.size() <= 2 ? Trinity::StringTo<uint32>(bounds[0]) : Optional<uint32>();
+        Optional<uint32> last = bounds.size() == 2 ? Trinity::StringTo<uint32>(bounds[1]) : first;
+        if (!first || !last || *first > *last)
+        {
+            TC_LOG_ERROR(logChannel, "Invalid processor range '{}' in thread affinity list '{}', threads of this class are not pinned", range, cpuList);
+            processors.clear();
+            return;
+        }
+
+        for (uint32 processor = *first; processor <= *last; ++processor)
+            processors.push_back(processor);
+    }
+}
+
+void ApplyThreadClassAffinity(ThreadClass threadClass)
+{
+    std::vector<uint32> const& processors = ThreadClassProcessors[size_t(threadClass)];
+    if (processors.empty())
+        return;
+
+    if (!SetCurrentThreadAffinity(processors))
+        TC_LOG_ERROR("server", "Can't set affinity of thread class {} to {} processors", uint32(threadClass), processors.size());
+}
+
+void ApplyThreadClassAffinity(ThreadClass threadClass, std::size_t index)
+{
+    std::vector<uint32> const& processors = ThreadClassProcessors[size_t(threadClass)];
+    if (processors.empty())
+        return;
+
+    uint32 processor = processors[index % processors.size()];
+    if (!SetCurrentThreadAffinity({ processor }))
+        TC_LOG_ERROR("server", "Can't pin thread {} of class {} to processor {}", index, uint32(threadClass), processor);
+}
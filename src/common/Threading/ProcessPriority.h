@@ -26,4 +26,22 @@
 
 void TC_COMMON_API SetProcessPriority(std::string const& logChannel, uint32 affinity, bool highPriority);
 
+enum class ThreadClass : uint8
+{
+    MapUpdate,
+    Network,
+    Database,
+
+    Max
+};
+
+// cpuList is a comma separated list of processor numbers and ranges ("0-7,16-23"), empty leaves the class unpinned
+// must be called before threads of the class are started
+void TC_COMMON_API SetThreadClassAffinity(std::string const& logChannel, ThreadClass threadClass, std::string const& cpuList);
+
+// pins the calling thread to the processors configured for its class, threads given an index are pinned
+// to a single processor of the list so that the data they touch stays on one core and NUMA node
+void TC_COMMON_API ApplyThreadClassAffinity(ThreadClass threadClass);
+void TC_COMMON_API ApplyThreadClassAffinity(ThreadClass threadClass, std::size_t index);
+
 #endif
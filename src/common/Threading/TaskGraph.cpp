@@ -0,0 +1,91 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskGraph.h"
+#include "Errors.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace Trinity
+{
+TaskGraph::TaskId TaskGraph::AddTask(std::function<void()> task, std::initializer_list<TaskId> dependencies /*= {}*/)
+{
+    TaskId id = _nodes.size();
+    Node& node = _nodes.emplace_back();
+    node.Task = std::move(task);
+    for (TaskId dependency : dependencies)
+    {
+        ASSERT(dependency < id, "Task dependencies must be added before tasks that depend on them");
+        _nodes[dependency].Dependents.push_back(id);
+        ++node.DependencyCount;
+    }
+
+    return id;
+}
+
+void TaskGraph::Run(std::size_t numThreads)
+{
+    if (numThreads <= 1 || _nodes.size() <= 1)
+    {
+        for (Node& node : _nodes)
+            node.Task();
+
+        return;
+    }
+
+    ThreadPool pool(std::min(numThreads, _nodes.size()));
+    std::unique_ptr<std::atomic<std::size_t>[]> remainingDependencies = std::make_unique<std::atomic<std::size_t>[]>(_nodes.size());
+    std::mutex errorLock;
+    std::exception_ptr error;
+
+    std::function<void(TaskId)> execute = [&](TaskId id)
+    {
+        try
+        {
+            _nodes[id].Task();
+        }
+        catch (...)
+        {
+            // tasks that depend on a failed one are never started
+            std::lock_guard<std::mutex> lock(errorLock);
+            if (!error)
+                error = std::current_exception();
+            return;
+        }
+
+        for (TaskId dependent : _nodes[id].Dependents)
+            if (--remainingDependencies[dependent] == 0)
+                pool.PostWork([&execute, dependent]() { execute(dependent); });
+    };
+
+    for (TaskId id = 0; id < _nodes.size(); ++id)
+        remainingDependencies[id] = _nodes[id].DependencyCount;
+
+    for (TaskId id = 0; id < _nodes.size(); ++id)
+        if (!_nodes[id].DependencyCount)
+            pool.PostWork([&execute, id]() { execute(id); });
+
+    // waits until no more work is queued, including tasks posted by finished ones
+    pool.Join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+}
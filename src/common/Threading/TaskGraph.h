@@ -0,0 +1,53 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TASK_GRAPH_H
+#define TRINITY_TASK_GRAPH_H
+
+#include "Define.h"
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+namespace Trinity
+{
+/// Runs a set of tasks, every task starts only after all of its dependencies have finished
+class TC_COMMON_API TaskGraph
+{
+public:
+    using TaskId = std::size_t;
+
+    /// Dependencies must be added before the task that depends on them, insertion order is always a valid serial order
+    TaskId AddTask(std::function<void()> task, std::initializer_list<TaskId> dependencies = {});
+
+    /// Executes all tasks and returns once they are finished, rethrows the first exception thrown by a task
+    /// numThreads <= 1 runs tasks one after another in insertion order
+    void Run(std::size_t numThreads);
+
+private:
+    struct Node
+    {
+        std::function<void()> Task;
+        std::vector<TaskId> Dependents;
+        std::size_t DependencyCount = 0;
+    };
+
+    std::vector<Node> _nodes;
+};
+}
+
+#endif // TRINITY_TASK_GRAPH_H
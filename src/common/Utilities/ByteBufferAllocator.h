@@ -0,0 +1,76 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_BYTEBUFFER_ALLOCATOR_H
+#define TRINITY_BYTEBUFFER_ALLOCATOR_H
+
+#include "RecyclingAllocator.h"
+#include <array>
+#include <new>
+
+namespace Trinity
+{
+/// Allocator of ByteBuffer and MessageBuffer storage, rounds sizes up to a few size classes that are recycled by
+/// Trinity::RecyclingAllocator so that packets which are constantly built and destroyed reuse the
+/// storage of previous ones on the same thread, bigger buffers use the heap
+template<typename T>
+class ByteBufferAllocator
+{
+public:
+    using value_type = T;
+
+    static constexpr std::array<std::size_t, 3> SizeClasses = { 0x100, 0x1000, 0x10000 };
+
+    /// Smallest size class that fits size bytes, 0 if it needs the heap
+    static constexpr std::size_t GetSizeClass(std::size_t size)
+    {
+        for (std::size_t sizeClass : SizeClasses)
+            if (size <= sizeClass)
+                return sizeClass;
+
+        return 0;
+    }
+
+    ByteBufferAllocator() noexcept = default;
+
+    template<typename U>
+    ByteBufferAllocator(ByteBufferAllocator<U> const&) noexcept { }
+
+    T* allocate(std::size_t n)
+    {
+        std::size_t size = n * sizeof(T);
+        if (std::size_t sizeClass = GetSizeClass(size))
+            return static_cast<T*>(RecyclingAllocator::Allocate(sizeClass));
+
+        return static_cast<T*>(::operator new(size));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        std::size_t size = n * sizeof(T);
+        if (std::size_t sizeClass = GetSizeClass(size))
+            RecyclingAllocator::Deallocate(ptr, sizeClass);
+        else
+            ::operator delete(ptr);
+    }
+
+    template<typename U>
+    bool operator==(ByteBufferAllocator<U> const&) const noexcept { return true; }
+};
+}
+
+#endif // TRINITY_BYTEBUFFER_ALLOCATOR_H
@@ -25,6 +25,9 @@
 #include <chrono>
 #endif
 
+/// Microseconds shorthand typedef.
+typedef std::chrono::microseconds Microseconds;
+
 /// Milliseconds shorthand typedef.
 typedef std::chrono::milliseconds Milliseconds;
 
@@ -17,6 +17,7 @@
 
 #include "EventMap.h"
 #include "Random.h"
+#include <algorithm>
 
 void EventMap::Reset()
 {
@@ -41,7 +42,7 @@ void EventMap::ScheduleEvent(uint32 eventId, Milliseconds time, uint32 group /*=
     if (phase && phase <= 8)
         eventId |= (1 << (phase + 23));
 
-    _eventMap.insert(EventStore::value_type(_time + time, eventId));
+    InsertEvent(_time + time, eventId);
 }
 
 void EventMap::ScheduleEvent(uint32 eventId, Milliseconds minTime, Milliseconds maxTime, uint32 group /*= 0*/, uint8 phase /*= 0*/)
@@ -62,7 +63,7 @@ void EventMap::RescheduleEvent(uint32 eventId, Milliseconds minTime, Millisecond
 
 void EventMap::Repeat(Milliseconds time)
 {
-    _eventMap.insert(EventStore::value_type(_time + time, _lastEvent));
+    InsertEvent(_time + time, _lastEvent);
 }
 
 void EventMap::Repeat(Milliseconds minTime, Milliseconds maxTime)
@@ -74,17 +75,17 @@ uint32 EventMap::ExecuteEvent()
 {
     while (!Empty())
     {
-        EventStore::iterator itr = _eventMap.begin();
+        Event const& event = _eventMap.back();
 
-        if (itr->first > _time)
+        if (event.Time > _time)
             return 0;
-        else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
-            _eventMap.erase(itr);
+        else if (_phase && (event.Data & 0xFF000000) && !((event.Data >> 24) & _phase))
+            _eventMap.pop_back();
         else
         {
-            uint32 eventId = (itr->second & 0x0000FFFF);
-            _lastEvent = itr->second; // include phase/group
-            _eventMap.erase(itr);
+            uint32 eventId = (event.Data & 0x0000FFFF);
+            _lastEvent = event.Data; // include phase/group
+            _eventMap.pop_back();
             return eventId;
         }
     }
@@ -94,16 +95,8 @@ uint32 EventMap::ExecuteEvent()
 
 void EventMap::DelayEvents(Milliseconds delay)
 {
-    if (Empty())
-        return;
-
-    EventStore delayed = std::move(_eventMap);
-    for (EventStore::iterator itr = delayed.begin(); itr != delayed.end();)
-    {
-        EventStore::node_type node = delayed.extract(itr++);
-        node.key() = node.key() + delay;
-        _eventMap.insert(_eventMap.end(), std::move(node));
-    }
+    for (Event& event : _eventMap)
+        event.Time += delay;
 }
 
 void EventMap::DelayEvents(Milliseconds delay, uint32 group)
@@ -111,20 +104,18 @@ void EventMap::DelayEvents(Milliseconds delay, uint32 group)
     if (!group || group > 8 || Empty())
         return;
 
-    EventStore delayed;
+    // delayed events are scheduled again in their previous order, after events that already have the same time
+    boost::container::small_vector<Event, 8> delayed;
+    for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
+        if (itr->Data & (1 << (group + 15)))
+            delayed.push_back({ itr->Time + delay, itr->Data });
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
-    {
-        if (itr->second & (1 << (group + 15)))
-        {
-            delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
-            _eventMap.erase(itr++);
-        }
-        else
-            ++itr;
-    }
+    if (delayed.empty())
+        return;
 
-    _eventMap.insert(delayed.begin(), delayed.end());
+    CancelEventGroup(group);
+    for (Event const& event : delayed)
+        InsertEvent(event.Time, event.Data);
 }
 
 void EventMap::CancelEvent(uint32 eventId)
@@ -132,13 +123,10 @@ void EventMap::CancelEvent(uint32 eventId)
     if (Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), [eventId](Event const& event)
     {
-        if (eventId == (itr->second & 0x0000FFFF))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+        return eventId == (event.Data & 0x0000FFFF);
+    }), _eventMap.end());
 }
 
 void EventMap::CancelEventGroup(uint32 group)
@@ -146,20 +134,27 @@ void EventMap::CancelEventGroup(uint32 group)
     if (!group || group > 8 || Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.erase(std::remove_if(_eventMap.begin(), _eventMap.end(), [group](Event const& event)
     {
-        if (itr->second & (1 << (group + 15)))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+        return (event.Data & (1 << (group + 15))) != 0;
+    }), _eventMap.end());
 }
 
 Milliseconds EventMap::GetTimeUntilEvent(uint32 eventId) const
 {
-    for (std::pair<TimePoint const, uint32> const& itr : _eventMap)
-        if (eventId == (itr.second & 0x0000FFFF))
-            return std::chrono::duration_cast<Milliseconds>(itr.first - _time);
+    for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
+        if (eventId == (itr->Data & 0x0000FFFF))
+            return std::chrono::duration_cast<Milliseconds>(itr->Time - _time);
 
     return Milliseconds::max();
 }
+
+void EventMap::InsertEvent(TimePoint time, uint32 data)
+{
+    // in front of all events with the same time, they execute before this one
+    auto itr = std::lower_bound(_eventMap.begin(), _eventMap.end(), time, [](Event const& event, TimePoint time)
+    {
+        return event.Time > time;
+    });
+    _eventMap.insert(itr, { time, data });
+}
@@ -20,22 +20,32 @@
 
 #include "Define.h"
 #include "Duration.h"
-#include <map>
+#include <boost/container/small_vector.hpp>
 
 class TC_COMMON_API EventMap
 {
     /**
     * Internal storage type.
-    * Key: Time as TimePoint when the event should occur.
-    * Value: The event data as uint32.
+    * Time: TimePoint when the event should occur.
+    * Data: The event data as uint32.
     *
     * Structure of event data:
     * - Bit  0 - 15: Event Id.
     * - Bit 16 - 23: Group
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
+    *
+    * Events are sorted by descending time, events with the same time
+    * are stored in reverse scheduling order so that the next event
+    * to execute is always at the back.
     */
-    typedef std::multimap<TimePoint, uint32> EventStore;
+    struct Event
+    {
+        TimePoint Time;
+        uint32 Data;
+    };
+
+    typedef boost::container::small_vector<Event, 8> EventStore;
 
 public:
     EventMap() : _time(TimePoint::min()), _phase(0), _lastEvent(0) { }
@@ -257,6 +267,8 @@ private:
     */
     EventStore _eventMap;
 
+    void InsertEvent(TimePoint time, uint32 data);
+
     /**
     * @name _lastEvent
     * @brief Stores information on the most recently executed event
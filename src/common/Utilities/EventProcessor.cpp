@@ -17,6 +17,18 @@
 
 #include "EventProcessor.h"
 #include "Errors.h"
+#include <algorithm>
+
+namespace
+{
+// std heap functions keep the largest element on top, order by latest time and sequence first
+bool ExecutesLater(EventProcessor::ScheduledEvent const& left, EventProcessor::ScheduledEvent const& right)
+{
+    if (left.ExecTime != right.ExecTime)
+        return left.ExecTime > right.ExecTime;
+    return left.Sequence > right.Sequence;
+}
+}
 
 void BasicEvent::ScheduleAbort()
 {
@@ -43,12 +55,10 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    std::multimap<uint64, BasicEvent*>::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (!m_events.empty() && m_events.front().ExecTime <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
+        BasicEvent* event = PopEvent();
 
         if (event->IsRunning())
         {
@@ -81,33 +91,38 @@ void EventProcessor::Update(uint32 p_time)
 
 void EventProcessor::KillAllEvents(bool force)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    // events can be added by Abort handlers, work on a detached queue
+    std::vector<ScheduledEvent> events;
+    events.swap(m_events);
+
+    std::vector<ScheduledEvent> keptEvents;
+    for (ScheduledEvent const& scheduledEvent : events)
     {
+        BasicEvent* event = scheduledEvent.Event;
+
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
         // Skip non-deletable events when we are
         // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
+        if (!force && !event->IsDeletable())
         {
-            ++itr;
+            keptEvents.push_back(scheduledEvent);
             continue;
         }
 
-        delete itr->second;
-
-        if (force)
-            ++itr; // Clear the whole container when forcing
-        else
-            itr = m_events.erase(itr);
+        delete event;
     }
 
-    if (force)
-        m_events.clear();
+    for (ScheduledEvent const& scheduledEvent : keptEvents)
+    {
+        m_events.push_back(scheduledEvent);
+        std::push_heap(m_events.begin(), m_events.end(), &ExecutesLater);
+    }
 }
 
 void EventProcessor::AddEvent(BasicEvent* event, Milliseconds e_time, bool set_addtime)
@@ -115,19 +130,31 @@ void EventProcessor::AddEvent(BasicEvent* event, Milliseconds e_time, bool set_a
     if (set_addtime)
         event->m_addTime = m_time;
     event->m_execTime = e_time.count();
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time.count(), event));
+    PushEvent(event, e_time.count());
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* event, Milliseconds newTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != event)
-            continue;
+    auto itr = std::find_if(m_events.begin(), m_events.end(), [event](ScheduledEvent const& scheduledEvent) { return scheduledEvent.Event == event; });
+    if (itr == m_events.end())
+        return;
+
+    event->m_execTime = newTime.count();
+    m_events.erase(itr);
+    std::make_heap(m_events.begin(), m_events.end(), &ExecutesLater);
+    PushEvent(event, newTime.count());
+}
 
-        event->m_execTime = newTime.count();
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(newTime.count(), event));
-        break;
-    }
+void EventProcessor::PushEvent(BasicEvent* event, uint64 execTime)
+{
+    m_events.push_back({ execTime, m_sequence++, event });
+    std::push_heap(m_events.begin(), m_events.end(), &ExecutesLater);
+}
+
+BasicEvent* EventProcessor::PopEvent()
+{
+    std::pop_heap(m_events.begin(), m_events.end(), &ExecutesLater);
+    BasicEvent* event = m_events.back().Event;
+    m_events.pop_back();
+    return event;
 }
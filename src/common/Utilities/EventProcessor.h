@@ -21,8 +21,9 @@
 #include "Define.h"
 #include "Duration.h"
 #include "Random.h"
-#include <map>
+#include "RecyclingAllocator.h"
 #include <type_traits>
+#include <vector>
 
 class EventProcessor;
 
@@ -82,7 +83,25 @@ public:
         return true;
     }
 
+    // sizes are rounded up so that lambdas of similar size share a few recycled size classes, big captures use the heap
+    static void* operator new(std::size_t size)
+    {
+        if (size > MaxRecycledSize)
+            return ::operator new(size);
+        return Trinity::RecyclingAllocator::Allocate(GetRecycledSize(size));
+    }
+
+    static void operator delete(void* ptr, std::size_t size)
+    {
+        if (size > MaxRecycledSize)
+            ::operator delete(ptr);
+        else
+            Trinity::RecyclingAllocator::Deallocate(ptr, GetRecycledSize(size));
+    }
+
 private:
+    static constexpr std::size_t MaxRecycledSize = 256;
+    static constexpr std::size_t GetRecycledSize(std::size_t size) { return (size + 63) & ~std::size_t(63); }
 
     T _callback;
 };
@@ -93,7 +112,7 @@ using is_lambda_event = std::enable_if_t<!std::is_base_of_v<BasicEvent, std::rem
 class TC_COMMON_API EventProcessor
 {
     public:
-        EventProcessor() : m_time(0) { }
+        EventProcessor() : m_time(0), m_sequence(0) { }
         ~EventProcessor();
 
         void Update(uint32 p_time);
@@ -110,11 +129,25 @@ class TC_COMMON_API EventProcessor
         is_lambda_event<T> AddEventAtOffset(T&& event, Milliseconds offset, Milliseconds offset2) { AddEventAtOffset(new LambdaBasicEvent<T>(std::move(event)), offset, offset2); }
         void ModifyEventTime(BasicEvent* event, Milliseconds newTime);
         Milliseconds CalculateTime(Milliseconds t_offset) const { return Milliseconds(m_time) + t_offset; }
-        std::multimap<uint64, BasicEvent*> const& GetEvents() const { return m_events; }
+
+        struct ScheduledEvent
+        {
+            uint64 ExecTime;
+            uint64 Sequence;                                // keeps events of the same time in the order they were added
+            BasicEvent* Event;
+        };
+
+        // binary heap on execution time, iteration order is unspecified
+        std::vector<ScheduledEvent> const& GetEvents() const { return m_events; }
 
     protected:
         uint64 m_time;
-        std::multimap<uint64, BasicEvent*> m_events;
+        uint64 m_sequence;
+        std::vector<ScheduledEvent> m_events;
+
+    private:
+        void PushEvent(BasicEvent* event, uint64 execTime);
+        BasicEvent* PopEvent();
 };
 
 #endif
@@ -19,12 +19,17 @@
 #define __MESSAGEBUFFER_H_
 
 #include "Define.h"
+#include "ByteBufferAllocator.h"
 #include <vector>
 #include <cstring>
 
 class MessageBuffer
 {
-    typedef std::vector<uint8>::size_type size_type;
+public:
+    using Storage = std::vector<uint8, Trinity::ByteBufferAllocator<uint8>>;
+
+private:
+    typedef Storage::size_type size_type;
 
 public:
     MessageBuffer() : _wpos(0), _rpos(0), _storage()
@@ -99,7 +104,7 @@ public:
         }
     }
 
-    std::vector<uint8>&& Move()
+    Storage&& Move()
     {
         _wpos = 0;
         _rpos = 0;
@@ -133,7 +138,7 @@ public:
 private:
     size_type _wpos;
     size_type _rpos;
-    std::vector<uint8> _storage;
+    Storage _storage;
 };
 
 #endif /* __MESSAGEBUFFER_H_ */
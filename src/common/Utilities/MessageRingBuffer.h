@@ -0,0 +1,166 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MessageRingBuffer_h__
+#define MessageRingBuffer_h__
+
+#include "Define.h"
+#include "ByteBufferAllocator.h"
+#include <algorithm>
+#include <vector>
+#include <cstring>
+
+/**
+    @class MessageRingBuffer
+
+    Circular receive buffer with the same interface as MessageBuffer for socket reads.
+    Unread data is never moved to the front of the storage, free space is instead exposed
+    as up to two regions (see GetWriteRegion/GetWrapWriteRegion) so that reads can scatter across the wrap boundary.
+    Data is consumed with Read() which copies across the wrap boundary transparently.
+*/
+class MessageRingBuffer
+{
+public:
+    using Storage = std::vector<uint8, Trinity::ByteBufferAllocator<uint8>>;
+
+private:
+    typedef Storage::size_type size_type;
+
+public:
+    MessageRingBuffer() : _rpos(0), _activeSize(0), _storage()
+    {
+        _storage.resize(4096);
+    }
+
+    explicit MessageRingBuffer(std::size_t initialSize) : _rpos(0), _activeSize(0), _storage()
+    {
+        _storage.resize(initialSize);
+    }
+
+    void Reset()
+    {
+        _rpos = 0;
+        _activeSize = 0;
+    }
+
+    // Only grows the buffer, active data is preserved
+    void Resize(size_type bytes)
+    {
+        if (bytes > _storage.size())
+            Grow(bytes);
+    }
+
+    uint8* GetBasePointer() { return _storage.data(); }
+
+    uint8* GetReadPointer() { return _storage.data() + _rpos; }
+
+    uint8* GetWritePointer() { return _storage.data() + GetWritePosition(); }
+
+    void ReadCompleted(size_type bytes)
+    {
+        _rpos += bytes;
+        if (_rpos >= _storage.size())
+            _rpos -= _storage.size();
+        _activeSize -= bytes;
+    }
+
+    void WriteCompleted(size_type bytes) { _activeSize += bytes; }
+
+    size_type GetActiveSize() const { return _activeSize; }
+
+    // Number of unread bytes available at GetReadPointer() without wrapping
+    size_type GetContiguousActiveSize() const { return std::min(_activeSize, _storage.size() - _rpos); }
+
+    size_type GetRemainingSpace() const { return _storage.size() - _activeSize; }
+
+    size_type GetBufferSize() const { return _storage.size(); }
+
+    // First free region, starts at GetWritePointer()
+    size_type GetWriteRegion() const
+    {
+        size_type wpos = GetWritePosition();
+        return wpos < _rpos || (wpos == _rpos && _activeSize) ? _rpos - wpos : _storage.size() - wpos;
+    }
+
+    // Free region following the wrap boundary, starts at the beginning of the storage
+    size_type GetWrapWriteRegion() const { return GetRemainingSpace() - GetWriteRegion(); }
+
+    // Rewinds to the start of the storage when all data was consumed, unread data is never moved
+    void Normalize()
+    {
+        if (!_activeSize)
+            _rpos = 0;
+    }
+
+    // Ensures there's "some" free space
+    void EnsureFreeSpace()
+    {
+        // resize buffer if it's already full
+        if (GetRemainingSpace() == 0)
+            Grow(_storage.size() * 3 / 2);
+    }
+
+    // Copies up to size unread bytes into data, returns number of bytes copied
+    size_type Read(void* data, size_type size)
+    {
+        size = std::min(size, _activeSize);
+        size_type head = std::min(size, _storage.size() - _rpos);
+        memcpy(data, GetReadPointer(), head);
+        if (head < size)
+            memcpy(static_cast<uint8*>(data) + head, _storage.data(), size - head);
+
+        ReadCompleted(size);
+        return size;
+    }
+
+    void Write(void const* data, std::size_t size)
+    {
+        if (size)
+        {
+            size_type head = std::min<size_type>(size, GetWriteRegion());
+            memcpy(GetWritePointer(), data, head);
+            if (head < size)
+                memcpy(_storage.data(), static_cast<uint8 const*>(data) + head, size - head);
+
+            WriteCompleted(size);
+        }
+    }
+
+private:
+    size_type GetWritePosition() const
+    {
+        size_type wpos = _rpos + _activeSize;
+        return wpos >= _storage.size() ? wpos - _storage.size() : wpos;
+    }
+
+    void Grow(size_type bytes)
+    {
+        Storage storage(bytes);
+        size_type activeSize = _activeSize;
+        Read(storage.data(), activeSize);
+        _storage = std::move(storage);
+        _rpos = 0;
+        _activeSize = activeSize;
+    }
+
+    size_type _rpos;
+    size_type _activeSize;
+    Storage _storage;
+};
+
+#endif // MessageRingBuffer_h__
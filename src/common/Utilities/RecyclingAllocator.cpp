@@ -0,0 +1,116 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "RecyclingAllocator.h"
+#include <array>
+#include <new>
+
+namespace
+{
+struct FreeBlock
+{
+    FreeBlock* Next;
+};
+
+struct SizeClass
+{
+    std::size_t Size = 0;
+    std::size_t Count = 0;
+    FreeBlock* Head = nullptr;
+};
+
+// trivially destructible so that it can still be read after the cache of the thread was destroyed
+thread_local bool ThreadCacheDestroyed = false;
+
+struct ThreadCache
+{
+    ~ThreadCache()
+    {
+        ThreadCacheDestroyed = true;
+        for (SizeClass& sizeClass : SizeClasses)
+        {
+            while (FreeBlock* block = sizeClass.Head)
+            {
+                sizeClass.Head = block->Next;
+                ::operator delete(block);
+            }
+        }
+    }
+
+    SizeClass* Find(std::size_t size)
+    {
+        for (SizeClass& sizeClass : SizeClasses)
+        {
+            if (sizeClass.Size == size)
+                return &sizeClass;
+
+            if (!sizeClass.Size)
+            {
+                sizeClass.Size = size;
+                return &sizeClass;
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::array<SizeClass, Trinity::RecyclingAllocator::MaxSizeClasses> SizeClasses;
+};
+
+thread_local ThreadCache Cache;
+}
+
+void* Trinity::RecyclingAllocator::Allocate(std::size_t size)
+{
+    if (!ThreadCacheDestroyed)
+    {
+        if (SizeClass* sizeClass = Cache.Find(size))
+        {
+            if (FreeBlock* block = sizeClass->Head)
+            {
+                sizeClass->Head = block->Next;
+                --sizeClass->Count;
+                return block;
+            }
+        }
+    }
+
+    return ::operator new(size);
+}
+
+void Trinity::RecyclingAllocator::Deallocate(void* ptr, std::size_t size)
+{
+    if (!ptr)
+        return;
+
+    // memory allocated by another thread is kept by the thread that frees it
+    if (!ThreadCacheDestroyed && size >= sizeof(FreeBlock))
+    {
+        SizeClass* sizeClass = Cache.Find(size);
+        if (sizeClass && sizeClass->Count < MaxCachedBlocksPerSizeClass)
+        {
+            FreeBlock* block = new (ptr) FreeBlock();
+            block->Next = sizeClass->Head;
+            sizeClass->Head = block;
+            ++sizeClass->Count;
+            return;
+        }
+    }
+
+    ::operator delete(ptr);
+}
@@ -0,0 +1,45 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_RECYCLING_ALLOCATOR_H
+#define TRINITY_RECYCLING_ALLOCATOR_H
+
+#include "Define.h"
+#include <cstddef>
+
+namespace Trinity
+{
+/// Keeps memory of deleted objects in per thread free lists, one for each object size,
+/// so that objects that are constantly recreated don't go through the heap every time
+class TC_COMMON_API RecyclingAllocator
+{
+public:
+    static constexpr std::size_t MaxSizeClasses = 16;
+    static constexpr std::size_t MaxCachedBlocksPerSizeClass = 128;
+
+    static void* Allocate(std::size_t size);
+    static void Deallocate(void* ptr, std::size_t size);
+};
+}
+
+/// Routes all allocations of the class and classes derived from it through Trinity::RecyclingAllocator
+/// Requires a virtual destructor when objects are deleted through a base pointer
+#define TRINITY_RECYCLED_ALLOCATION \
+    static void* operator new(std::size_t size) { return Trinity::RecyclingAllocator::Allocate(size); } \
+    static void operator delete(void* ptr, std::size_t size) { Trinity::RecyclingAllocator::Deallocate(ptr, size); }
+
+#endif // TRINITY_RECYCLING_ALLOCATOR_H
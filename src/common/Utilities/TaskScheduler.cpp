@@ -112,21 +112,32 @@ void TaskScheduler::Dispatch(success_t const& callback/* = nullptr*/)
         callback();
 }
 
+bool TaskScheduler::TaskQueue::EndsLater(QueuedTask const& left, QueuedTask const& right)
+{
+    if (right.Task->_end < left.Task->_end)
+        return true;
+    if (left.Task->_end < right.Task->_end)
+        return false;
+    return left.Sequence > right.Sequence;
+}
+
 void TaskScheduler::TaskQueue::Push(TaskContainer&& task)
 {
-    container.emplace(std::move(task));
+    container.push_back({ std::move(task), sequence++ });
+    std::push_heap(container.begin(), container.end(), &EndsLater);
 }
 
 auto TaskScheduler::TaskQueue::Pop() -> TaskContainer
 {
-    TaskContainer result = *container.begin();
-    container.erase(container.begin());
+    std::pop_heap(container.begin(), container.end(), &EndsLater);
+    TaskContainer result = std::move(container.back().Task);
+    container.pop_back();
     return result;
 }
 
 auto TaskScheduler::TaskQueue::First() const -> TaskContainer const&
 {
-    return *container.begin();
+    return container.front().Task;
 }
 
 void TaskScheduler::TaskQueue::Clear()
@@ -136,26 +147,35 @@ void TaskScheduler::TaskQueue::Clear()
 
 void TaskScheduler::TaskQueue::RemoveIf(std::function<bool(TaskContainer const&)> const& filter)
 {
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-            itr = container.erase(itr);
-        else
-            ++itr;
+    std::size_t size = container.size();
+    std::erase_if(container, [&filter](QueuedTask const& queued) { return filter(queued.Task); });
+    if (container.size() != size)
+        std::make_heap(container.begin(), container.end(), &EndsLater);
 }
 
 void TaskScheduler::TaskQueue::ModifyIf(std::function<bool(TaskContainer const&)> const& filter)
 {
-    std::vector<TaskContainer> cache;
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-        {
-            cache.push_back(*itr);
-            itr = container.erase(itr);
-        }
-        else
-            ++itr;
-
-    container.insert(cache.begin(), cache.end());
+    // modified tasks are queued again after all tasks with the same end, in their previous order
+    std::sort(container.begin(), container.end(), [](QueuedTask const& left, QueuedTask const& right) { return EndsLater(right, left); });
+
+    std::vector<QueuedTask> cache;
+    std::erase_if(container, [&filter, &cache](QueuedTask& queued)
+    {
+        if (!filter(queued.Task))
+            return false;
+
+        cache.push_back(std::move(queued));
+        return true;
+    });
+
+    if (cache.empty())
+        return;
+
+    for (QueuedTask& queued : cache)
+        queued.Sequence = sequence++;
+
+    container.insert(container.end(), std::make_move_iterator(cache.begin()), std::make_move_iterator(cache.end()));
+    std::make_heap(container.begin(), container.end(), &EndsLater);
 }
 
 bool TaskScheduler::TaskQueue::IsEmpty() const
@@ -27,7 +27,6 @@
 #include <queue>
 #include <memory>
 #include <utility>
-#include <set>
 
 class TaskContext;
 
@@ -131,7 +130,17 @@ class TC_COMMON_API TaskScheduler
 
     class TC_COMMON_API TaskQueue
     {
-        std::multiset<TaskContainer, Compare> container;
+        struct QueuedTask
+        {
+            TaskContainer Task;
+            uint64 Sequence;    // keeps tasks with the same end in the order they were pushed
+        };
+
+        // binary heap, the task that ends first is at the front
+        std::vector<QueuedTask> container;
+        uint64 sequence = 0;
+
+        static bool EndsLater(QueuedTask const& left, QueuedTask const& right);
 
     public:
         // Pushes the task in the container
@@ -371,7 +380,7 @@ private:
     TaskScheduler& ScheduleAt(timepoint_t end,
         std::chrono::duration<_Rep, _Period> time, task_handler_t task)
     {
-        return InsertTask(TaskContainer(new Task(end + time, time, std::move(task))));
+        return InsertTask(std::make_shared<Task>(end + time, time, std::move(task)));
     }
 
     /// Schedule an event with a fixed rate.
@@ -382,7 +391,7 @@ private:
         group_t const group, task_handler_t task)
     {
         static repeated_t const DEFAULT_REPEATED = 0;
-        return InsertTask(TaskContainer(new Task(end + time, time, group, DEFAULT_REPEATED, std::move(task))));
+        return InsertTask(std::make_shared<Task>(end + time, time, group, DEFAULT_REPEATED, std::move(task)));
     }
 
     /// Dispatch remaining tasks
@@ -469,7 +478,12 @@ public:
         _task->_end += duration;
         _task->_repeated += 1;
         (*_consumed) = true;
-        return Dispatch(std::bind(&TaskScheduler::InsertTask, std::placeholders::_1, _task));
+
+        // the same task object is pushed again, no need to go through a type erased Dispatch call
+        if (std::shared_ptr<TaskScheduler> owner = _owner.lock())
+            owner->InsertTask(_task);
+
+        return *this;
     }
 
     /// Repeats the event with the same duration.
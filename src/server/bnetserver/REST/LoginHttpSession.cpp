@@ -0,0 +1,168 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoginHttpSession.h"
+#include "Base64.h"
+#include "DatabaseEnv.h"
+#include "LoginRESTService.h"
+#include "QueryCallback.h"
+#include "StringFormat.h"
+
+namespace http = boost::beast::http;
+
+LoginHttpSession::LoginHttpSession(tcp::socket&& socket) : BaseSocket(std::move(socket)), _readPending(true), _requestInProgress(false), _keepAlive(false)
+{
+    ResetParser();
+}
+
+LoginHttpSession::~LoginHttpSession() = default;
+
+void LoginHttpSession::Start()
+{
+    TC_LOG_TRACE("server.rest", "[{}:{}] Accepted connection", GetRemoteIpAddress().to_string(), GetRemotePort());
+
+    underlying_stream().async_handshake(boost::asio::ssl::stream_base::server, std::bind(&LoginHttpSession::HandshakeHandler, shared_from_this(), std::placeholders::_1));
+}
+
+bool LoginHttpSession::Update()
+{
+    if (!BaseSocket::Update())
+        return false;
+
+    _queryProcessor.ProcessReadyCallbacks();
+
+    // response to the previous request was sent from a database callback, continue with data that was already received
+    if (!_readPending && !_requestInProgress && IsOpen())
+        ReadHandler();
+
+    return true;
+}
+
+void LoginHttpSession::HandshakeHandler(boost::system::error_code const& error)
+{
+    if (error)
+    {
+        TC_LOG_DEBUG("server.rest", "[{}:{}] Failed SSL handshake {}", GetRemoteIpAddress().to_string(), GetRemotePort(), error.message());
+        CloseSocket();
+        return;
+    }
+
+    AsyncReadRequest();
+}
+
+void LoginHttpSession::AsyncReadRequest()
+{
+    _readPending = true;
+    AsyncRead();
+}
+
+void LoginHttpSession::ResetParser()
+{
+    _parser.emplace();
+    _parser->eager(true);
+    _parser->body_limit(64 * 1024);
+}
+
+void LoginHttpSession::ReadHandler()
+{
+    _readPending = false;
+    if (!IsOpen())
+        return;
+
+    MessageBuffer& packet = GetReadBuffer();
+    while (packet.GetActiveSize() > 0 && !_requestInProgress)
+    {
+        boost::system::error_code error;
+        std::size_t parsedBytes = _parser->put(boost::asio::buffer(packet.GetReadPointer(), packet.GetActiveSize()), error);
+        packet.ReadCompleted(parsedBytes);
+
+        if (error == http::error::need_more)
+            break;
+
+        if (error)
+        {
+            TC_LOG_DEBUG("server.rest", "[{}:{}] Malformed request: {}", GetRemoteIpAddress().to_string(), GetRemotePort(), error.message());
+            CloseSocket();
+            return;
+        }
+
+        if (_parser->is_done())
+            HandleRequest();
+    }
+
+    if (!_requestInProgress && IsOpen())
+        AsyncReadRequest();
+}
+
+void LoginHttpSession::HandleRequest()
+{
+    http::request<http::string_body>& message = _parser->get();
+
+    LoginHttpRequest request;
+    if (GetRemoteIpAddress().is_v4())
+        request.RemoteAddress = GetRemoteIpAddress().to_v4();
+
+    request.RemotePort = GetRemotePort();
+
+    std::string_view target(message.target().data(), message.target().size());
+    request.Path = target.substr(0, target.find('?'));
+
+    auto authorization = message.find(http::field::authorization);
+    if (authorization != message.end())
+    {
+        std::string_view value(authorization->value().data(), authorization->value().size());
+        if (value.substr(0, 6) == "Basic ")
+        {
+            if (Optional<std::vector<uint8>> credentials = Trinity::Encoding::Base64::Decode(std::string(value.substr(6))))
+            {
+                std::string_view userPass(reinterpret_cast<char const*>(credentials->data()), credentials->size());
+                request.UserId = userPass.substr(0, userPass.find(':'));
+            }
+        }
+    }
+
+    request.Body = std::move(message.body());
+    _keepAlive = message.keep_alive();
+    _requestInProgress = true;
+
+    std::string method(message.method_string());
+    sLoginService.HandleHttpRequest(method.c_str(), request, [this](uint32 status, std::string body)
+    {
+        SendResponse(status, body);
+    }, _queryProcessor);
+}
+
+void LoginHttpSession::SendResponse(uint32 status, std::string const& body)
+{
+    boost::beast::string_view reason = http::obsolete_reason(http::int_to_status(status));
+    std::string header = Trinity::StringFormat("HTTP/1.1 {} {}\r\nContent-Type: application/json;charset=utf-8\r\nContent-Length: {}\r\nConnection: {}\r\n\r\n",
+        status, std::string_view(reason.data(), reason.size()), body.length(), _keepAlive ? "keep-alive" : "close");
+
+    MessageBuffer packet(header.length() + body.length());
+    packet.Write(header.data(), header.length());
+    packet.Write(body.data(), body.length());
+    QueuePacket(std::move(packet));
+
+    _requestInProgress = false;
+    if (!_keepAlive)
+    {
+        DelayedCloseSocket();
+        return;
+    }
+
+    ResetParser();
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LoginHttpSession_h__
+#define LoginHttpSession_h__
+
+#include "AsyncCallbackProcessor.h"
+#include "DatabaseEnvFwd.h"
+#include "Optional.h"
+#include "Socket.h"
+#include "SslContext.h"
+#include "SslSocket.h"
+#include <boost/beast/http/parser.hpp>
+#include <boost/beast/http/string_body.hpp>
+
+/**
+    @class LoginHttpSession
+
+    HTTP/1.1 over TLS connection to the login REST endpoints, served by the network threads of LoginHttpSessionManager.
+    Requests on a keep-alive connection are handled one at a time, the next one is parsed after the response was queued.
+*/
+class LoginHttpSession : public Socket<LoginHttpSession, SslSocket<Battlenet::SslContext>>
+{
+    typedef Socket<LoginHttpSession, SslSocket<Battlenet::SslContext>> BaseSocket;
+
+public:
+    explicit LoginHttpSession(tcp::socket&& socket);
+    ~LoginHttpSession();
+
+    void Start() override;
+    bool Update() override;
+
+protected:
+    void ReadHandler() override;
+
+private:
+    void HandshakeHandler(boost::system::error_code const& error);
+    void AsyncReadRequest();
+    void ResetParser();
+    void HandleRequest();
+    void SendResponse(uint32 status, std::string const& body);
+
+    Optional<boost::beast::http::request_parser<boost::beast::http::string_body>> _parser;
+    QueryCallbackProcessor _queryProcessor;
+    bool _readPending;
+    bool _requestInProgress;
+    bool _keepAlive;
+};
+
+#endif // LoginHttpSession_h__
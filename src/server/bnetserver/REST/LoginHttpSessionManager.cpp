@@ -0,0 +1,44 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoginHttpSessionManager.h"
+
+bool LoginHttpSessionManager::StartNetwork(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int threadCount)
+{
+    if (!BaseSocketMgr::StartNetwork(ioContext, bindIp, port, threadCount))
+        return false;
+
+    _acceptor->SetSocketFactory(std::bind(&BaseSocketMgr::GetSocketForAccept, this));
+    _acceptor->AsyncAcceptWithCallback<&OnSocketAccept>();
+    return true;
+}
+
+NetworkThread<LoginHttpSession>* LoginHttpSessionManager::CreateThreads() const
+{
+    return new NetworkThread<LoginHttpSession>[GetNetworkThreadCount()];
+}
+
+void LoginHttpSessionManager::OnSocketAccept(tcp::socket&& sock, uint32 threadIndex)
+{
+    sLoginHttpSessionMgr.OnSocketOpen(std::forward<tcp::socket>(sock), threadIndex);
+}
+
+LoginHttpSessionManager& LoginHttpSessionManager::Instance()
+{
+    static LoginHttpSessionManager instance;
+    return instance;
+}
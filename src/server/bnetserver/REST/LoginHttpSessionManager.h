@@ -0,0 +1,42 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LoginHttpSessionManager_h__
+#define LoginHttpSessionManager_h__
+
+#include "SocketMgr.h"
+#include "LoginHttpSession.h"
+
+class LoginHttpSessionManager : public SocketMgr<LoginHttpSession>
+{
+    typedef SocketMgr<LoginHttpSession> BaseSocketMgr;
+
+public:
+    static LoginHttpSessionManager& Instance();
+
+    bool StartNetwork(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int threadCount) override;
+
+protected:
+    NetworkThread<LoginHttpSession>* CreateThreads() const override;
+
+private:
+    static void OnSocketAccept(tcp::socket&& sock, uint32 threadIndex);
+};
+
+#define sLoginHttpSessionMgr LoginHttpSessionManager::Instance()
+
+#endif // LoginHttpSessionManager_h__
@@ -22,6 +22,7 @@
 #include "DatabaseEnv.h"
 #include "Errors.h"
 #include "IpNetwork.h"
+#include "LoginHttpSessionManager.h"
 #include "ProtobufJSON.h"
 #include "Resolver.h"
 #include "SslContext.h"
@@ -35,7 +36,7 @@ int ns1__executeCommand(soap*, char*, char**) { return SOAP_OK; }
 class AsyncRequest
 {
 public:
-    AsyncRequest(soap const& server) : _client(server), _responseStatus(0) { }
+    AsyncRequest(soap const& server) : _client(server) { }
 
     AsyncRequest(AsyncRequest const&) = delete;
     AsyncRequest& operator=(AsyncRequest const&) = delete;
@@ -44,29 +45,26 @@ public:
 
     bool InvokeIfReady()
     {
-        ASSERT(_callback);
-        return _callback->InvokeIfReady();
+        _queryProcessor.ProcessReadyCallbacks();
+        return _queryProcessor.Empty();
     }
 
     soap* GetClient() { return &_client; }
-    void SetCallback(std::unique_ptr<QueryCallback> callback) { _callback = std::move(callback); }
-    int32 GetResponseStatus() const { return _responseStatus; }
-    void SetResponseStatus(int32 responseStatus) { _responseStatus = responseStatus; }
+    QueryCallbackProcessor& GetQueryProcessor() { return _queryProcessor; }
 
 private:
     soap _client;
-    std::unique_ptr<QueryCallback> _callback;
-    int32 _responseStatus;
+    QueryCallbackProcessor _queryProcessor;
 };
 
 int32 handle_get_plugin(soap* soapClient)
 {
-    return sLoginService.HandleHttpRequest(soapClient, "GET", sLoginService._getHandlers);
+    return sLoginService.HandleSoapRequest(soapClient, "GET");
 }
 
 int32 handle_post_plugin(soap* soapClient)
 {
-    return sLoginService.HandleHttpRequest(soapClient, "POST", sLoginService._postHandlers);
+    return sLoginService.HandleSoapRequest(soapClient, "POST");
 }
 
 bool LoginRESTService::Start(Trinity::Asio::IoContext* ioContext)
@@ -125,12 +123,38 @@ bool LoginRESTService::Start(Trinity::Asio::IoContext* ioContext)
 
     _loginTicketDuration = sConfigMgr->GetIntDefault("LoginREST.TicketDuration", 3600);
 
+    _getHandlers["/bnetserver/login/"] = &LoginRESTService::HandleGetForm;
+    _getHandlers["/bnetserver/gameAccounts/"] = &LoginRESTService::HandleGetGameAccounts;
+    _getHandlers["/bnetserver/portal/"] = &LoginRESTService::HandleGetPortal;
+
+    _postHandlers["/bnetserver/login/"] = &LoginRESTService::HandlePostLogin;
+    _postHandlers["/bnetserver/refreshLoginTicket/"] = &LoginRESTService::HandlePostRefreshLoginTicket;
+
+    _networkThreads = sConfigMgr->GetIntDefault("LoginREST.NetworkThreads", 0);
+    if (_networkThreads > 0)
+    {
+        if (!sLoginHttpSessionMgr.StartNetwork(*ioContext, _bindIP, _port, _networkThreads))
+        {
+            TC_LOG_ERROR("server.rest", "Couldn't bind to {}:{}", _bindIP, _port);
+            return false;
+        }
+
+        TC_LOG_INFO("server.rest", "Login service bound to https://{}:{} using {} network threads", _bindIP, _port, _networkThreads);
+        return true;
+    }
+
     _thread = std::thread(std::bind(&LoginRESTService::Run, this));
     return true;
 }
 
 void LoginRESTService::Stop()
 {
+    if (_networkThreads > 0)
+    {
+        sLoginHttpSessionMgr.StopNetwork();
+        return;
+    }
+
     _stopped = true;
     _thread.join();
 }
@@ -171,13 +195,6 @@ void LoginRESTService::Run()
         { nullptr, nullptr }
     };
 
-    _getHandlers["/bnetserver/login/"] = &LoginRESTService::HandleGetForm;
-    _getHandlers["/bnetserver/gameAccounts/"] = &LoginRESTService::HandleGetGameAccounts;
-    _getHandlers["/bnetserver/portal/"] = &LoginRESTService::HandleGetPortal;
-
-    _postHandlers["/bnetserver/login/"] = &LoginRESTService::HandlePostLogin;
-    _postHandlers["/bnetserver/refreshLoginTicket/"] = &LoginRESTService::HandlePostRefreshLoginTicket;
-
     soap_register_plugin_arg(&soapServer, &http_get, (void*)&handle_get_plugin);
     soap_register_plugin_arg(&soapServer, &http_post, handlers);
     soap_register_plugin_arg(&soapServer, &ContentTypePlugin::Init, (void*)"application/json;charset=utf-8");
@@ -215,48 +232,74 @@ void LoginRESTService::Run()
     TC_LOG_INFO("server.rest", "Login service exiting...");
 }
 
-int32 LoginRESTService::HandleHttpRequest(soap* soapClient, char const* method, HttpMethodHandlerMap const& handlers)
+int32 LoginRESTService::HandleSoapRequest(soap* soapClient, char const* method)
 {
-    TC_LOG_DEBUG("server.rest", "[{}:{}] Handling {} request path=\"{}\"",
-        boost::asio::ip::address_v4(soapClient->ip).to_string(), soapClient->port, method, soapClient->path);
+    std::shared_ptr<AsyncRequest> asyncRequest = *reinterpret_cast<std::shared_ptr<AsyncRequest>*>(soapClient->user);
+
+    LoginHttpRequest request;
+    request.RemoteAddress = boost::asio::ip::address_v4(soapClient->ip);
+    request.RemotePort = soapClient->port;
+    request.Path = soapClient->path;
+    if (std::size_t queryPart = request.Path.find('?'); queryPart != std::string::npos)
+        request.Path.resize(queryPart);
 
-    size_t pathLength = strlen(soapClient->path);
-    if (char const* queryPart = strchr(soapClient->path, '?'))
-        pathLength = queryPart - soapClient->path;
+    if (soapClient->userid)
+        request.UserId = soapClient->userid;
 
-    auto handler = handlers.find(std::string{ soapClient->path, pathLength });
-    if (handler != handlers.end())
+    if (!strcmp(method, "POST"))
     {
-        int32 status = (this->*handler->second)(*reinterpret_cast<std::shared_ptr<AsyncRequest>*>(soapClient->user));
-        if (status != SOAP_OK)
-        {
-            ResponseCodePlugin::GetForClient(soapClient)->ErrorCode = status;
-            return SendResponse(soapClient, Battlenet::JSON::Login::ErrorResponse());
-        }
+        char* buf = nullptr;
+        size_t len = 0;
+        soap_http_body(soapClient, &buf, &len);
+        if (buf)
+            request.Body.assign(buf, len);
+    }
+
+    HandleHttpRequest(method, request, [asyncRequest](uint32 status, std::string body)
+    {
+        SendSoapResponse(asyncRequest->GetClient(), status, body);
+    }, asyncRequest->GetQueryProcessor());
+
+    if (!asyncRequest->GetQueryProcessor().Empty())
+        Trinity::Asio::post(*_ioContext, [this, asyncRequest]() { HandleAsyncRequest(asyncRequest); });
+
+    return SOAP_OK;
+}
 
-        return SOAP_OK;
+void LoginRESTService::HandleHttpRequest(char const* method, LoginHttpRequest const& request, LoginHttpResponder responder, QueryCallbackProcessor& queryProcessor)
+{
+    TC_LOG_DEBUG("server.rest", "[{}:{}] Handling {} request path=\"{}\"",
+        request.RemoteAddress.to_string(), request.RemotePort, method, request.Path);
+
+    HttpMethodHandlerMap const& handlers = !strcmp(method, "POST") ? _postHandlers : _getHandlers;
+    auto handler = handlers.find(request.Path);
+    if (handler == handlers.end() || (strcmp(method, "GET") && strcmp(method, "POST")))
+    {
+        SendResponse(responder, 404, Battlenet::JSON::Login::ErrorResponse());
+        return;
     }
 
-    ResponseCodePlugin::GetForClient(soapClient)->ErrorCode = 404;
-    return SendResponse(soapClient, Battlenet::JSON::Login::ErrorResponse());
+    (this->*handler->second)(request, std::move(responder), queryProcessor);
 }
 
-int32 LoginRESTService::HandleGetForm(std::shared_ptr<AsyncRequest> request)
+void LoginRESTService::HandleGetForm(LoginHttpRequest const& /*request*/, LoginHttpResponder responder, QueryCallbackProcessor& /*queryProcessor*/)
 {
-    return SendResponse(request->GetClient(), _formInputs);
+    SendResponse(responder, 200, _formInputs);
 }
 
-int32 LoginRESTService::HandleGetGameAccounts(std::shared_ptr<AsyncRequest> request)
+void LoginRESTService::HandleGetGameAccounts(LoginHttpRequest const& request, LoginHttpResponder responder, QueryCallbackProcessor& queryProcessor)
 {
-    if (!request->GetClient()->userid)
-        return 401;
-
-    request->SetCallback(std::make_unique<QueryCallback>(LoginDatabase.AsyncQuery([&] {
-        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_BNET_GAME_ACCOUNT_LIST);
-        stmt->setString(0, request->GetClient()->userid);
-        return stmt;
-    }())
-        .WithPreparedCallback([this, request](PreparedQueryResult result)
+    if (request.UserId.empty())
+    {
+        SendResponse(responder, 401, Battlenet::JSON::Login::ErrorResponse());
+        return;
+    }
+
+    LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_BNET_GAME_ACCOUNT_LIST);
+    stmt->setString(0, request.UserId);
+
+    queryProcessor.AddCallback(LoginDatabase.AsyncQuery(stmt)
+        .WithPreparedCallback([responder = std::move(responder)](PreparedQueryResult result)
     {
         Battlenet::JSON::Login::GameAccountList response;
         if (result)
@@ -288,40 +331,27 @@ int32 LoginRESTService::HandleGetGameAccounts(std::shared_ptr<AsyncRequest> requ
             } while (result->NextRow());
         }
 
-        SendResponse(request->GetClient(), response);
-    })));
-
-    Trinity::Asio::post(*_ioContext, [this, request]() { HandleAsyncRequest(request); });
-
-    return SOAP_OK;
+        SendResponse(responder, 200, response);
+    }));
 }
 
-int32 LoginRESTService::HandleGetPortal(std::shared_ptr<AsyncRequest> request)
+void LoginRESTService::HandleGetPortal(LoginHttpRequest const& request, LoginHttpResponder responder, QueryCallbackProcessor& /*queryProcessor*/)
 {
-    boost::asio::ip::tcp::endpoint const& endpoint = GetAddressForClient(boost::asio::ip::address_v4(request->GetClient()->ip));
-    std::string response = Trinity::StringFormat("{}:{}", endpoint.address().to_string(), sConfigMgr->GetIntDefault("BattlenetPort", 1119));
-
-    soap_response(request->GetClient(), SOAP_FILE);
-    soap_send_raw(request->GetClient(), response.c_str(), response.length());
-    return soap_end_send(request->GetClient());
+    boost::asio::ip::tcp::endpoint const& endpoint = GetAddressForClient(request.RemoteAddress);
+    responder(200, Trinity::StringFormat("{}:{}", endpoint.address().to_string(), sConfigMgr->GetIntDefault("BattlenetPort", 1119)));
 }
 
-int32 LoginRESTService::HandlePostLogin(std::shared_ptr<AsyncRequest> request)
+void LoginRESTService::HandlePostLogin(LoginHttpRequest const& request, LoginHttpResponder responder, QueryCallbackProcessor& queryProcessor)
 {
-    char* buf = nullptr;
-    size_t len = 0;
-    soap_http_body(request->GetClient(), &buf, &len);
-
     Battlenet::JSON::Login::LoginForm loginForm;
-    if (!buf || !JSON::Deserialize(buf, &loginForm))
+    if (request.Body.empty() || !JSON::Deserialize(request.Body, &loginForm))
     {
-        ResponseCodePlugin::GetForClient(request->GetClient())->ErrorCode = 400;
-
         Battlenet::JSON::Login::LoginResult loginResult;
         loginResult.set_authentication_state(Battlenet::JSON::Login::LOGIN);
         loginResult.set_error_code("UNABLE_TO_DECODE");
         loginResult.set_error_message("There was an internal error while connecting to Battle.net. Please try again later.");
-        return SendResponse(request->GetClient(), loginResult);
+        SendResponse(responder, 400, loginResult);
+        return;
     }
 
     std::string login;
@@ -343,8 +373,8 @@ int32 LoginRESTService::HandlePostLogin(std::shared_ptr<AsyncRequest> request)
 
     std::string sentPasswordHash = CalculateShaPassHash(login, password);
 
-    request->SetCallback(std::make_unique<QueryCallback>(LoginDatabase.AsyncQuery(stmt)
-        .WithChainingPreparedCallback([request, login, sentPasswordHash, this](QueryCallback& callback, PreparedQueryResult result)
+    queryProcessor.AddCallback(LoginDatabase.AsyncQuery(stmt)
+        .WithChainingPreparedCallback([responder, ip_address = request.RemoteAddress.to_string(), login, sentPasswordHash, this](QueryCallback& callback, PreparedQueryResult result)
     {
         if (result)
         {
@@ -369,18 +399,17 @@ int32 LoginRESTService::HandlePostLogin(std::shared_ptr<AsyncRequest> request)
                 stmt->setString(0, loginTicket);
                 stmt->setUInt32(1, time(nullptr) + _loginTicketDuration);
                 stmt->setUInt32(2, accountId);
-                callback.WithPreparedCallback([request, loginTicket](PreparedQueryResult)
+                callback.WithPreparedCallback([responder, loginTicket](PreparedQueryResult)
                 {
                     Battlenet::JSON::Login::LoginResult loginResult;
                     loginResult.set_authentication_state(Battlenet::JSON::Login::DONE);
                     loginResult.set_login_ticket(loginTicket);
-                    sLoginService.SendResponse(request->GetClient(), loginResult);
+                    SendResponse(responder, 200, loginResult);
                 }).SetNextQuery(LoginDatabase.AsyncQuery(stmt));
                 return;
             }
             else if (!isBanned)
             {
-                std::string ip_address = boost::asio::ip::address_v4(request->GetClient()->ip).to_string();
                 uint32 maxWrongPassword = uint32(sConfigMgr->GetIntDefault("WrongPass.MaxCount", 0));
 
                 if (sConfigMgr->GetBoolDefault("WrongPass.Logging", false))
@@ -428,25 +457,23 @@ int32 LoginRESTService::HandlePostLogin(std::shared_ptr<AsyncRequest> request)
 
         Battlenet::JSON::Login::LoginResult loginResult;
         loginResult.set_authentication_state(Battlenet::JSON::Login::DONE);
-        sLoginService.SendResponse(request->GetClient(), loginResult);
-    })));
-
-    Trinity::Asio::post(*_ioContext, [this, request]() { HandleAsyncRequest(request); });
-
-    return SOAP_OK;
+        SendResponse(responder, 200, loginResult);
+    }));
 }
 
-int32 LoginRESTService::HandlePostRefreshLoginTicket(std::shared_ptr<AsyncRequest> request)
+void LoginRESTService::HandlePostRefreshLoginTicket(LoginHttpRequest const& request, LoginHttpResponder responder, QueryCallbackProcessor& queryProcessor)
 {
-    if (!request->GetClient()->userid)
-        return 401;
-
-    request->SetCallback(std::make_unique<QueryCallback>(LoginDatabase.AsyncQuery([&] {
-        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_BNET_EXISTING_AUTHENTICATION);
-        stmt->setString(0, request->GetClient()->userid);
-        return stmt;
-    }())
-        .WithPreparedCallback([this, request](PreparedQueryResult result)
+    if (request.UserId.empty())
+    {
+        SendResponse(responder, 401, Battlenet::JSON::Login::ErrorResponse());
+        return;
+    }
+
+    LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_BNET_EXISTING_AUTHENTICATION);
+    stmt->setString(0, request.UserId);
+
+    queryProcessor.AddCallback(LoginDatabase.AsyncQuery(stmt)
+        .WithPreparedCallback([this, userId = request.UserId, responder = std::move(responder)](PreparedQueryResult result)
     {
         Battlenet::JSON::Login::LoginRefreshResult loginRefreshResult;
         if (result)
@@ -459,7 +486,7 @@ int32 LoginRESTService::HandlePostRefreshLoginTicket(std::shared_ptr<AsyncReques
 
                 LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_BNET_EXISTING_AUTHENTICATION);
                 stmt->setUInt32(0, uint32(now + _loginTicketDuration));
-                stmt->setString(1, request->GetClient()->userid);
+                stmt->setString(1, userId);
                 LoginDatabase.Execute(stmt);
             }
             else
@@ -468,34 +495,29 @@ int32 LoginRESTService::HandlePostRefreshLoginTicket(std::shared_ptr<AsyncReques
         else
             loginRefreshResult.set_is_expired(true);
 
-        SendResponse(request->GetClient(), loginRefreshResult);
-    })));
-
-    Trinity::Asio::post(*_ioContext, [this, request]() { HandleAsyncRequest(request); });
+        SendResponse(responder, 200, loginRefreshResult);
+    }));
+}
 
-    return SOAP_OK;
+void LoginRESTService::SendResponse(LoginHttpResponder const& responder, uint32 status, google::protobuf::Message const& response)
+{
+    responder(status, JSON::Serialize(response));
 }
 
-int32 LoginRESTService::SendResponse(soap* soapClient, google::protobuf::Message const& response)
+int32 LoginRESTService::SendSoapResponse(soap* soapClient, uint32 status, std::string const& body)
 {
-    std::string jsonResponse = JSON::Serialize(response);
+    if (status != 200)
+        ResponseCodePlugin::GetForClient(soapClient)->ErrorCode = status;
 
     soap_response(soapClient, SOAP_FILE);
-    soap_send_raw(soapClient, jsonResponse.c_str(), jsonResponse.length());
+    soap_send_raw(soapClient, body.c_str(), body.length());
     return soap_end_send(soapClient);
 }
 
 void LoginRESTService::HandleAsyncRequest(std::shared_ptr<AsyncRequest> request)
 {
     if (!request->InvokeIfReady())
-    {
         Trinity::Asio::post(*_ioContext, [this, request]() { HandleAsyncRequest(request); });
-    }
-    else if (request->GetResponseStatus())
-    {
-        ResponseCodePlugin::GetForClient(request->GetClient())->ErrorCode = request->GetResponseStatus();
-        SendResponse(request->GetClient(), Battlenet::JSON::Login::ErrorResponse());
-    }
 }
 
 std::string LoginRESTService::CalculateShaPassHash(std::string const& name, std::string const& password)
@@ -19,11 +19,14 @@
 #define LoginRESTService_h__
 
 #include "Define.h"
+#include "AsyncCallbackProcessor.h"
+#include "DatabaseEnvFwd.h"
 #include "IoContext.h"
 #include "Login.pb.h"
 #include "Session.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <atomic>
+#include <functional>
 #include <thread>
 
 class AsyncRequest;
@@ -36,10 +39,23 @@ enum class BanMode
     BAN_ACCOUNT = 1
 };
 
+// transport independent view of a request to one of the login endpoints
+struct LoginHttpRequest
+{
+    boost::asio::ip::address_v4 RemoteAddress;
+    uint16 RemotePort = 0;
+    std::string Path;   // without query string
+    std::string UserId; // user name sent with basic authentication
+    std::string Body;
+};
+
+// receives http status code and json body of the response, must be called exactly once per request
+using LoginHttpResponder = std::function<void(uint32 status, std::string body)>;
+
 class LoginRESTService
 {
 public:
-    LoginRESTService() : _ioContext(nullptr), _stopped(false), _port(0), _loginTicketDuration(0) { }
+    LoginRESTService() : _ioContext(nullptr), _stopped(false), _port(0), _networkThreads(0), _loginTicketDuration(0) { }
 
     static LoginRESTService& Instance();
 
@@ -48,23 +64,27 @@ public:
 
     boost::asio::ip::tcp::endpoint const& GetAddressForClient(boost::asio::ip::address const& address) const;
 
+    // database callbacks of the request are added to queryProcessor, the caller keeps processing it until the responder was called
+    void HandleHttpRequest(char const* method, LoginHttpRequest const& request, LoginHttpResponder responder, QueryCallbackProcessor& queryProcessor);
+
 private:
     void Run();
 
     friend int32 handle_get_plugin(soap* soapClient);
     friend int32 handle_post_plugin(soap* soapClient);
 
-    using HttpMethodHandlerMap = std::unordered_map<std::string, int32(LoginRESTService::*)(std::shared_ptr<AsyncRequest>)>;
-    int32 HandleHttpRequest(soap* soapClient, char const* method, HttpMethodHandlerMap const& handlers);
+    using HttpMethodHandlerMap = std::unordered_map<std::string, void(LoginRESTService::*)(LoginHttpRequest const&, LoginHttpResponder, QueryCallbackProcessor&)>;
+    int32 HandleSoapRequest(soap* soapClient, char const* method);
 
-    int32 HandleGetForm(std::shared_ptr<AsyncRequest> request);
-    int32 HandleGetGameAccounts(std::shared_ptr<AsyncRequest> request);
-    int32 HandleGetPortal(std::shared_ptr<AsyncRequest> request);
+    void HandleGetForm(LoginHttpRequest const& request, LoginHttpResponder responder, QueryCallbackProcessor& queryProcessor);
+    void HandleGetGameAccounts(LoginHttpRequest const& request, LoginHttpResponder responder, QueryCallbackProcessor& queryProcessor);
+    void HandleGetPortal(LoginHttpRequest const& request, LoginHttpResponder responder, QueryCallbackProcessor& queryProcessor);
 
-    int32 HandlePostLogin(std::shared_ptr<AsyncRequest> request);
-    int32 HandlePostRefreshLoginTicket(std::shared_ptr<AsyncRequest> request);
+    void HandlePostLogin(LoginHttpRequest const& request, LoginHttpResponder responder, QueryCallbackProcessor& queryProcessor);
+    void HandlePostRefreshLoginTicket(LoginHttpRequest const& request, LoginHttpResponder responder, QueryCallbackProcessor& queryProcessor);
 
-    int32 SendResponse(soap* soapClient, google::protobuf::Message const& response);
+    static void SendResponse(LoginHttpResponder const& responder, uint32 status, google::protobuf::Message const& response);
+    static int32 SendSoapResponse(soap* soapClient, uint32 status, std::string const& body);
 
     void HandleAsyncRequest(std::shared_ptr<AsyncRequest> request);
 
@@ -101,6 +121,7 @@ private:
     Battlenet::JSON::Login::FormInputs _formInputs;
     std::string _bindIP;
     int32 _port;
+    int32 _networkThreads;
     boost::asio::ip::tcp::endpoint _externalAddress;
     boost::asio::ip::tcp::endpoint _localAddress;
     boost::asio::ip::address_v4 _localNetmask;
@@ -132,12 +132,28 @@ bool Battlenet::Session::Update()
     return true;
 }
 
-void Battlenet::Session::AsyncWrite(MessageBuffer* packet)
+void Battlenet::Session::AsyncWrite(pb::Message const& header, pb::Message const* message)
 {
     if (!IsOpen())
         return;
 
-    QueuePacket(std::move(*packet));
+    // message sizes were computed by the caller when filling header, serialize with the cached ones
+    // into a buffer reused from the network thread instead of walking every message twice
+    uint16 headerSize = header.ByteSize();
+    std::size_t messageSize = message ? message->GetCachedSize() : 0;
+    MessageBuffer packet = AcquireSendBuffer(sizeof(headerSize) + headerSize + messageSize);
+
+    EndianConvertReverse(headerSize);
+    packet.Write(&headerSize, sizeof(headerSize));
+    header.SerializeWithCachedSizesToArray(packet.GetWritePointer());
+    packet.WriteCompleted(header.GetCachedSize());
+    if (message)
+    {
+        message->SerializeWithCachedSizesToArray(packet.GetWritePointer());
+        packet.WriteCompleted(messageSize);
+    }
+
+    QueuePacket(std::move(packet));
 }
 
 void Battlenet::Session::SendResponse(uint32 token, pb::Message const* response)
@@ -147,19 +163,7 @@ void Battlenet::Session::SendResponse(uint32 token, pb::Message const* response)
     header.set_service_id(0xFE);
     header.set_size(response->ByteSize());
 
-    uint16 headerSize = header.ByteSize();
-    EndianConvertReverse(headerSize);
-
-    MessageBuffer packet(sizeof(headerSize) + header.GetCachedSize() + response->GetCachedSize());
-    packet.Write(&headerSize, sizeof(headerSize));
-    uint8* ptr = packet.GetWritePointer();
-    packet.WriteCompleted(header.GetCachedSize());
-    header.SerializePartialToArray(ptr, header.GetCachedSize());
-    ptr = packet.GetWritePointer();
-    packet.WriteCompleted(response->GetCachedSize());
-    response->SerializeToArray(ptr, response->GetCachedSize());
-
-    AsyncWrite(&packet);
+    AsyncWrite(header, response);
 }
 
 void Battlenet::Session::SendResponse(uint32 token, uint32 status)
@@ -169,16 +173,7 @@ void Battlenet::Session::SendResponse(uint32 token, uint32 status)
     header.set_status(status);
     header.set_service_id(0xFE);
 
-    uint16 headerSize = header.ByteSize();
-    EndianConvertReverse(headerSize);
-
-    MessageBuffer packet(sizeof(headerSize) + header.GetCachedSize());
-    packet.Write(&headerSize, sizeof(headerSize));
-    uint8* ptr = packet.GetWritePointer();
-    packet.WriteCompleted(header.GetCachedSize());
-    header.SerializeToArray(ptr, header.GetCachedSize());
-
-    AsyncWrite(&packet);
+    AsyncWrite(header, nullptr);
 }
 
 void Battlenet::Session::SendRequest(uint32 serviceHash, uint32 methodId, pb::Message const* request)
@@ -190,19 +185,7 @@ void Battlenet::Session::SendRequest(uint32 serviceHash, uint32 methodId, pb::Me
     header.set_size(request->ByteSize());
     header.set_token(_requestToken++);
 
-    uint16 headerSize = header.ByteSize();
-    EndianConvertReverse(headerSize);
-
-    MessageBuffer packet(sizeof(headerSize) + header.GetCachedSize() + request->GetCachedSize());
-    packet.Write(&headerSize, sizeof(headerSize));
-    uint8* ptr = packet.GetWritePointer();
-    packet.WriteCompleted(header.GetCachedSize());
-    header.SerializeToArray(ptr, header.GetCachedSize());
-    ptr = packet.GetWritePointer();
-    packet.WriteCompleted(request->GetCachedSize());
-    request->SerializeToArray(ptr, request->GetCachedSize());
-
-    AsyncWrite(&packet);
+    AsyncWrite(header, request);
 }
 
 uint32 Battlenet::Session::HandleLogon(authentication::v1::LogonRequest const* logonRequest, std::function<void(ServiceBase*, uint32, ::google::protobuf::Message const*)>& continuation)
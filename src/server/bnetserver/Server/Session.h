@@ -149,7 +149,7 @@ namespace Battlenet
         bool ReadDataHandler();
 
     private:
-        void AsyncWrite(MessageBuffer* packet);
+        void AsyncWrite(pb::Message const& header, pb::Message const* message);
 
         void AsyncHandshake();
 
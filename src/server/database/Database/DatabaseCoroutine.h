@@ -0,0 +1,184 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DatabaseCoroutine_h__
+#define DatabaseCoroutine_h__
+
+#include "AsyncCallbackProcessor.h"
+#include "DatabaseEnvFwd.h"
+#include "QueryCallback.h"
+#include "QueryHolder.h"
+#include "Transaction.h"
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+namespace Trinity
+{
+//! Return type of coroutines awaiting database results, for example
+//!     Trinity::DatabaseCoroutine WorldSession::DoSomething(ObjectGuid guid)
+//!     {
+//!         PreparedQueryResult result = co_await Trinity::AwaitPreparedQuery(GetQueryProcessor(), CharacterDatabase.AsyncQuery(stmt));
+//!         ...
+//!     }
+//! The coroutine starts running immediately and is resumed by ProcessReadyCallbacks of the processor it awaited on,
+//! on the thread that owns that processor. When the processor is destroyed before the result arrives (e.g. the session
+//! is deleted) the coroutine is destroyed without being resumed, so everything used after co_await must be owned by
+//! the processor owner or by the coroutine itself - never pass references to packets or other temporaries as arguments.
+struct DatabaseCoroutine
+{
+    struct promise_type
+    {
+        DatabaseCoroutine get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept { }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+namespace Impl
+{
+//! Owned by the callback stored in the processor, resumes the coroutine once or destroys it with the callback
+class CoroutineResumer
+{
+public:
+    explicit CoroutineResumer(std::coroutine_handle<> handle) : _handle(handle) { }
+    CoroutineResumer(CoroutineResumer const&) = delete;
+    CoroutineResumer& operator=(CoroutineResumer const&) = delete;
+    ~CoroutineResumer()
+    {
+        if (_handle)
+            _handle.destroy();
+    }
+
+    void Resume() { std::exchange(_handle, nullptr).resume(); }
+
+private:
+    std::coroutine_handle<> _handle;
+};
+}
+
+template<typename Result>
+class QueryAwaiter
+{
+public:
+    QueryAwaiter(QueryCallbackProcessor& processor, QueryCallback&& callback)
+        : _processor(processor), _callback(std::move(callback)) { }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        auto onResult = [this, resumer = std::make_shared<Impl::CoroutineResumer>(handle)](Result result)
+        {
+            _result = std::move(result);
+            resumer->Resume();
+        };
+
+        if constexpr (std::is_same_v<Result, PreparedQueryResult>)
+            _processor.AddCallback(_callback.WithPreparedCallback(std::move(onResult)));
+        else
+            _processor.AddCallback(_callback.WithCallback(std::move(onResult)));
+    }
+
+    Result await_resume() { return std::move(_result); }
+
+private:
+    QueryCallbackProcessor& _processor;
+    QueryCallback _callback;
+    Result _result;
+};
+
+class QueryHolderAwaiter
+{
+public:
+    QueryHolderAwaiter(AsyncCallbackProcessor<SQLQueryHolderCallback>& processor, SQLQueryHolderCallback&& callback)
+        : _processor(processor), _callback(std::move(callback)) { }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        _callback.AfterComplete([resumer = std::make_shared<Impl::CoroutineResumer>(handle)](SQLQueryHolderBase const& /*holder*/)
+        {
+            resumer->Resume();
+        });
+        _processor.AddCallback(std::move(_callback));
+    }
+
+    //! Results are read from the holder passed to DelayQueryHolder, which the caller keeps alive
+    void await_resume() const noexcept { }
+
+private:
+    AsyncCallbackProcessor<SQLQueryHolderCallback>& _processor;
+    SQLQueryHolderCallback _callback;
+};
+
+class TransactionAwaiter
+{
+public:
+    TransactionAwaiter(AsyncCallbackProcessor<TransactionCallback>& processor, TransactionCallback&& callback)
+        : _processor(processor), _callback(std::move(callback)), _success(false) { }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        _callback.AfterComplete([this, resumer = std::make_shared<Impl::CoroutineResumer>(handle)](bool success)
+        {
+            _success = success;
+            resumer->Resume();
+        });
+        _processor.AddCallback(std::move(_callback));
+    }
+
+    bool await_resume() const noexcept { return _success; }
+
+private:
+    AsyncCallbackProcessor<TransactionCallback>& _processor;
+    TransactionCallback _callback;
+    bool _success;
+};
+
+//! co_await yields the QueryResult of an AsyncQuery(char const*) call
+inline QueryAwaiter<QueryResult> AwaitQuery(QueryCallbackProcessor& processor, QueryCallback&& callback)
+{
+    return { processor, std::move(callback) };
+}
+
+//! co_await yields the PreparedQueryResult of an AsyncQuery(PreparedStatement*) call
+inline QueryAwaiter<PreparedQueryResult> AwaitPreparedQuery(QueryCallbackProcessor& processor, QueryCallback&& callback)
+{
+    return { processor, std::move(callback) };
+}
+
+//! co_await completes once every query of the holder passed to DelayQueryHolder was executed
+inline QueryHolderAwaiter AwaitQueryHolder(AsyncCallbackProcessor<SQLQueryHolderCallback>& processor, SQLQueryHolderCallback&& callback)
+{
+    return { processor, std::move(callback) };
+}
+
+//! co_await yields whether the transaction passed to AsyncCommitTransaction was committed
+inline TransactionAwaiter AwaitTransaction(AsyncCallbackProcessor<TransactionCallback>& processor, TransactionCallback&& callback)
+{
+    return { processor, std::move(callback) };
+}
+}
+
+#endif // DatabaseCoroutine_h__
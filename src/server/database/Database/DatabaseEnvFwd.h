@@ -18,6 +18,7 @@
 #ifndef DatabaseEnvFwd_h__
 #define DatabaseEnvFwd_h__
 
+#include "Define.h"
 #include <future>
 #include <memory>
 
@@ -88,6 +89,18 @@ using WorldDatabaseQueryHolder = SQLQueryHolder<WorldDatabaseConnection>;
 
 class SQLQueryHolderCallback;
 
+//! Scheduling class of asynchronous operations, lower values are executed first
+enum class SQLOperationPriority : uint8
+{
+    Interactive,    // reads a player is actively waiting for
+    Normal,
+    Bulk,           // large background writes that may be delayed
+
+    Max
+};
+
+class DatabaseWorkQueue;
+
 // mysql
 struct MySQLHandle;
 struct MySQLResult;
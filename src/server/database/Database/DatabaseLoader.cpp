@@ -53,7 +53,35 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
 
         uint8 const synchThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.SynchThreads", 1));
 
+        uint8 const maxAsyncThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.MaxWorkerThreads", 0));
+        if (maxAsyncThreads > 32)
+        {
+            TC_LOG_ERROR(_logger, "{} database: invalid maximum number of worker threads specified. "
+                "Please pick a value between 0 and 32.", name);
+            return false;
+        }
+
         pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
+        pool.SetMaxAsyncThreads(maxAsyncThreads);
+        pool.SetQueryHolderParts(uint8(sConfigMgr->GetIntDefault(name + "Database.QueryHolderParts", 1)));
+
+        std::string const replicaString = sConfigMgr->GetStringDefault(name + "Database.ReplicaInfo", "");
+        if (!replicaString.empty())
+        {
+            uint8 const replicaThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.ReplicaWorkerThreads", 1));
+            if (replicaThreads < 1 || replicaThreads > 32)
+            {
+                TC_LOG_ERROR(_logger, "{} database: invalid number of replica worker threads specified. "
+                    "Please pick a value between 1 and 32.", name);
+                return false;
+            }
+
+            pool.SetReplicaConnectionInfo(replicaString, replicaThreads,
+                Milliseconds(sConfigMgr->GetIntDefault(name + "Database.ReplicaMaxLag", 1000)));
+        }
+
+        if (sConfigMgr->GetBoolDefault("Database.StatementStatistics", false))
+            pool.EnableStatementStatistics(Milliseconds(sConfigMgr->GetIntDefault("Database.SlowStatementThreshold", 0)));
         if (uint32 error = pool.Open())
         {
             // Database does not exist
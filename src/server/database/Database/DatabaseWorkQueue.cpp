@@ -0,0 +1,182 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseWorkQueue.h"
+#include "SQLOperation.h"
+#include <algorithm>
+#include <utility>
+
+DatabaseWorkQueue::DatabaseWorkQueue() : _maxWaitTimes(), _busyTime(0), _nextSequence(0), _workers(0), _busyNonInteractiveWorkers(0), _shutdown(false)
+{
+}
+
+DatabaseWorkQueue::~DatabaseWorkQueue()
+{
+    Cancel();
+}
+
+void DatabaseWorkQueue::Push(SQLOperation* operation, SQLOperationPriority priority)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _queues[size_t(priority)].push({ .Operation = operation, .QueuedAt = std::chrono::steady_clock::now(), .Sequence = _nextSequence++ });
+
+    _condition.notify_one();
+}
+
+SQLOperation* DatabaseWorkQueue::WaitAndPop(SQLOperationPriority& priority, std::atomic<bool> const& cancelationToken)
+{
+    std::unique_lock<std::mutex> lock(_lock);
+
+    for (;;)
+    {
+        if (_shutdown || cancelationToken)
+            return nullptr;
+
+        // oldest queued operation that is not an interactive read
+        size_t oldest = _queues.size();
+        for (size_t i = size_t(SQLOperationPriority::Interactive) + 1; i < _queues.size(); ++i)
+            if (!_queues[i].empty() && (oldest == _queues.size() || _queues[i].front().Sequence < _queues[oldest].front().Sequence))
+                oldest = i;
+
+        std::queue<QueuedOperation> const& interactive = _queues[size_t(SQLOperationPriority::Interactive)];
+        if (!interactive.empty())
+        {
+            if (oldest == _queues.size() || interactive.front().Sequence < _queues[oldest].front().Sequence)
+                return Pop(size_t(SQLOperationPriority::Interactive), priority);
+
+            // the read waits for an earlier write, which may use the worker kept free for reads
+            ++_busyNonInteractiveWorkers;
+            return Pop(oldest, priority);
+        }
+
+        if (oldest != _queues.size() && CanRunNonInteractive())
+        {
+            for (size_t i = size_t(SQLOperationPriority::Interactive) + 1; i < _queues.size(); ++i)
+            {
+                if (!_queues[i].empty())
+                {
+                    ++_busyNonInteractiveWorkers;
+                    return Pop(i, priority);
+                }
+            }
+        }
+
+        _condition.wait(lock);
+    }
+}
+
+SQLOperation* DatabaseWorkQueue::Pop(size_t queueIndex, SQLOperationPriority& priority)
+{
+    QueuedOperation queued = _queues[queueIndex].front();
+    _queues[queueIndex].pop();
+
+    Milliseconds waitTime = std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - queued.QueuedAt);
+    _maxWaitTimes[queueIndex] = std::max(_maxWaitTimes[queueIndex], waitTime);
+
+    priority = SQLOperationPriority(queueIndex);
+    return queued.Operation;
+}
+
+void DatabaseWorkQueue::OperationDone(SQLOperationPriority priority, Microseconds executionTime)
+{
+    _busyTime.fetch_add(executionTime.count(), std::memory_order_relaxed);
+
+    if (priority == SQLOperationPriority::Interactive)
+        return;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    --_busyNonInteractiveWorkers;
+
+    // the finishing worker goes back to WaitAndPop itself, wake an idle one in case work was held back
+    _condition.notify_one();
+}
+
+void DatabaseWorkQueue::AddWorker()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    ++_workers;
+}
+
+void DatabaseWorkQueue::RemoveWorker()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    --_workers;
+}
+
+void DatabaseWorkQueue::WakeWorkers()
+{
+    // taking the lock orders this after a worker checked its token and before it starts waiting
+    std::lock_guard<std::mutex> lock(_lock);
+    _condition.notify_all();
+}
+
+void DatabaseWorkQueue::Cancel()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    for (std::queue<QueuedOperation>& queue : _queues)
+    {
+        while (!queue.empty())
+        {
+            delete queue.front().Operation;
+            queue.pop();
+        }
+    }
+
+    _shutdown = true;
+
+    _condition.notify_all();
+}
+
+std::size_t DatabaseWorkQueue::Size() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    std::size_t size = 0;
+    for (std::queue<QueuedOperation> const& queue : _queues)
+        size += queue.size();
+
+    return size;
+}
+
+std::size_t DatabaseWorkQueue::Size(SQLOperationPriority priority) const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    return _queues[size_t(priority)].size();
+}
+
+Milliseconds DatabaseWorkQueue::PopMaxWaitTime(SQLOperationPriority priority)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    return std::exchange(_maxWaitTimes[size_t(priority)], Milliseconds::zero());
+}
+
+Microseconds DatabaseWorkQueue::PopBusyTime()
+{
+    return Microseconds(_busyTime.exchange(0, std::memory_order_relaxed));
+}
+
+bool DatabaseWorkQueue::CanRunNonInteractive() const
+{
+    // a single worker has nothing to reserve
+    if (_workers <= 1)
+        return true;
+
+    return _busyNonInteractiveWorkers + 1 < _workers;
+}
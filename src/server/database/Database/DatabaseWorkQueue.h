@@ -0,0 +1,96 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DATABASEWORKQUEUE_H
+#define _DATABASEWORKQUEUE_H
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include "Duration.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+
+class SQLOperation;
+
+//! Queue shared by async worker threads of one DatabaseWorkerPool.
+//! Operations are taken in priority order, when more than one worker is attached
+//! one of them is always kept free for SQLOperationPriority::Interactive work.
+//! Interactive reads never overtake operations queued before them so that they
+//! always see the result of earlier writes (logout save followed by relog).
+class TC_DATABASE_API DatabaseWorkQueue
+{
+    public:
+        DatabaseWorkQueue();
+        ~DatabaseWorkQueue();
+
+        void Push(SQLOperation* operation, SQLOperationPriority priority);
+
+        //! Blocks until an operation the calling worker is allowed to run is queued.
+        //! Returns nullptr once the queue has been canceled or cancelationToken of the worker was set.
+        SQLOperation* WaitAndPop(SQLOperationPriority& priority, std::atomic<bool> const& cancelationToken);
+
+        //! Must be called by the worker after the operation returned by WaitAndPop was executed.
+        void OperationDone(SQLOperationPriority priority, Microseconds executionTime);
+
+        void AddWorker();
+        void RemoveWorker();
+
+        //! Wakes up all waiting workers so they can check their cancelation token.
+        void WakeWorkers();
+
+        //! Deletes all queued operations and wakes up all waiting workers.
+        void Cancel();
+
+        std::size_t Size() const;
+        std::size_t Size(SQLOperationPriority priority) const;
+
+        //! Longest time an operation of the given class waited in the queue since the previous call.
+        Milliseconds PopMaxWaitTime(SQLOperationPriority priority);
+
+        //! Total time workers spent executing operations since the previous call.
+        Microseconds PopBusyTime();
+
+    private:
+        struct QueuedOperation
+        {
+            SQLOperation* Operation;
+            TimePoint QueuedAt;
+            uint64 Sequence;
+        };
+
+        SQLOperation* Pop(size_t queueIndex, SQLOperationPriority& priority);
+
+        bool CanRunNonInteractive() const;
+
+        mutable std::mutex _lock;
+        std::condition_variable _condition;
+        std::array<std::queue<QueuedOperation>, size_t(SQLOperationPriority::Max)> _queues;
+        std::array<Milliseconds, size_t(SQLOperationPriority::Max)> _maxWaitTimes;
+        std::atomic<int64> _busyTime;
+        uint64 _nextSequence;
+        uint32 _workers;
+        uint32 _busyNonInteractiveWorkers;
+        bool _shutdown;
+
+        DatabaseWorkQueue(DatabaseWorkQueue const& right) = delete;
+        DatabaseWorkQueue& operator=(DatabaseWorkQueue const& right) = delete;
+};
+
+#endif
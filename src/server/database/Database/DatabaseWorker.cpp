@@ -16,24 +16,37 @@
  */
 
 #include "DatabaseWorker.h"
+#include "DatabaseWorkQueue.h"
+#include "Duration.h"
+#include "MemoryStats.h"
+#include "ProcessPriority.h"
 #include "SQLOperation.h"
-#include "ProducerConsumerQueue.h"
+#include "Trace.h"
 
-DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
+DatabaseWorker::DatabaseWorker(DatabaseWorkQueue* newQueue, MySQLConnection* connection)
 {
     _connection = connection;
     _queue = newQueue;
     _cancelationToken = false;
+    _finished = false;
+    _queue->AddWorker();
     _workerThread = std::thread(&DatabaseWorker::WorkerThread, this);
 }
 
 DatabaseWorker::~DatabaseWorker()
 {
-    _cancelationToken = true;
-
-    _queue->Cancel();
+    RequestStop();
 
     _workerThread.join();
+
+    _queue->RemoveWorker();
+}
+
+void DatabaseWorker::RequestStop()
+{
+    _cancelationToken = true;
+
+    _queue->WakeWorkers();
 }
 
 void DatabaseWorker::WorkerThread()
@@ -41,18 +54,29 @@ void DatabaseWorker::WorkerThread()
     if (!_queue)
         return;
 
+    TC_TRACE_THREAD_NAME("Database worker");
+    Trinity::MemoryStats::BindThreadArena("Database worker");
+    ApplyThreadClassAffinity(ThreadClass::Database);
+
     for (;;)
     {
-        SQLOperation* operation = nullptr;
+        SQLOperationPriority priority;
+        SQLOperation* operation = _queue->WaitAndPop(priority, _cancelationToken);
 
-        _queue->WaitAndPop(operation);
+        if (!operation)
+            break;
 
-        if (_cancelationToken || !operation)
-            return;
-
-        operation->SetConnection(_connection);
-        operation->call();
+        TimePoint const start = std::chrono::steady_clock::now();
+        {
+            TC_TRACE_ZONE("SQLOperation");
+            operation->SetConnection(_connection);
+            operation->call();
+        }
 
         delete operation;
+
+        _queue->OperationDone(priority, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start));
     }
+
+    _finished = true;
 }
@@ -22,26 +22,30 @@
 #include <atomic>
 #include <thread>
 
-template <typename T>
-class ProducerConsumerQueue;
-
+class DatabaseWorkQueue;
 class MySQLConnection;
-class SQLOperation;
 
 class TC_DATABASE_API DatabaseWorker
 {
     public:
-        DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
+        DatabaseWorker(DatabaseWorkQueue* newQueue, MySQLConnection* connection);
         ~DatabaseWorker();
 
+        //! Asks the thread to exit once its current operation is done, without canceling the queue
+        void RequestStop();
+
+        //! True once the thread left its loop, destroying the worker will not block anymore
+        bool IsFinished() const { return _finished; }
+
     private:
-        ProducerConsumerQueue<SQLOperation*>* _queue;
+        DatabaseWorkQueue* _queue;
         MySQLConnection* _connection;
 
         void WorkerThread();
         std::thread _workerThread;
 
         std::atomic<bool> _cancelationToken;
+        std::atomic<bool> _finished;
 
         DatabaseWorker(DatabaseWorker const& right) = delete;
         DatabaseWorker& operator=(DatabaseWorker const& right) = delete;
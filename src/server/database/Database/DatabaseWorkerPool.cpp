@@ -18,6 +18,7 @@
 #include "DatabaseWorkerPool.h"
 #include "AdhocStatement.h"
 #include "Common.h"
+#include "DatabaseWorkQueue.h"
 #include "Errors.h"
 #include "Implementation/LoginDatabase.h"
 #include "Implementation/WorldDatabase.h"
@@ -26,7 +27,7 @@
 #include "Log.h"
 #include "MySQLPreparedStatement.h"
 #include "PreparedStatement.h"
-#include "ProducerConsumerQueue.h"
+#include "PreparedStatementStatistics.h"
 #include "QueryCallback.h"
 #include "QueryHolder.h"
 #include "QueryResult.h"
@@ -34,6 +35,8 @@
 #include "Transaction.h"
 #include "MySQLWorkaround.h"
 #include <mysqld_error.h>
+#include <algorithm>
+#include <future>
 #ifdef TRINITY_DEBUG
 #include <sstream>
 #include <boost/stacktrace.hpp>
@@ -61,8 +64,8 @@ class PingOperation : public SQLOperation
 
 template <class T>
 DatabaseWorkerPool<T>::DatabaseWorkerPool()
-    : _queue(new ProducerConsumerQueue<SQLOperation*>()),
-      _async_threads(0), _synch_threads(0)
+    : _queue(new DatabaseWorkQueue()), _replicaMaxLag(0), _replica_threads(0),
+      _async_threads(0), _synch_threads(0), _max_async_threads(0), _queryHolderParts(1)
 {
     WPFatal(mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
 
@@ -79,6 +82,8 @@ template <class T>
 DatabaseWorkerPool<T>::~DatabaseWorkerPool()
 {
     _queue->Cancel();
+    if (_replicaQueue)
+        _replicaQueue->Cancel();
 }
 
 template <class T>
@@ -91,6 +96,18 @@ void DatabaseWorkerPool<T>::SetConnectionInfo(std::string const& infoString,
     _synch_threads = synchThreads;
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::SetReplicaConnectionInfo(std::string const& infoString,
+    uint8 const replicaThreads, Milliseconds maxLag)
+{
+    if (!_replicaQueue)
+        _replicaQueue = std::make_unique<DatabaseWorkQueue>();
+
+    _replicaConnectionInfo = std::make_unique<MySQLConnectionInfo>(infoString);
+    _replicaMaxLag = maxLag;
+    _replica_threads = replicaThreads;
+}
+
 template <class T>
 uint32 DatabaseWorkerPool<T>::Open()
 {
@@ -101,17 +118,26 @@ uint32 DatabaseWorkerPool<T>::Open()
         GetDatabaseName(), _async_threads, _synch_threads);
 
     uint32 error = OpenConnections(IDX_ASYNC, _async_threads);
+    _lastWorkerAdjustment = std::chrono::steady_clock::now();
 
     if (error)
         return error;
 
     error = OpenConnections(IDX_SYNCH, _synch_threads);
 
+    if (!error && _replicaConnectionInfo)
+    {
+        TC_LOG_INFO("sql.driver", "Opening read replica of DatabasePool '{}' on {}:{}. Replica connections: {}.",
+            GetDatabaseName(), _replicaConnectionInfo->host, _replicaConnectionInfo->port_or_socket, _replica_threads);
+
+        error = OpenConnections(IDX_REPLICA, _replica_threads);
+    }
+
     if (!error)
     {
         TC_LOG_INFO("sql.driver", "DatabasePool '{}' opened successfully. "
                     "{} total connections running.", GetDatabaseName(),
-                    (_connections[IDX_SYNCH].size() + _connections[IDX_ASYNC].size()));
+                    (_connections[IDX_SYNCH].size() + _connections[IDX_ASYNC].size() + _connections[IDX_REPLICA].size()));
     }
 
     return error;
@@ -122,8 +148,17 @@ void DatabaseWorkerPool<T>::Close()
 {
     TC_LOG_INFO("sql.driver", "Closing down DatabasePool '{}'.", GetDatabaseName());
 
+    //! Wait for a connection opened by AdjustAsyncWorkers, it is closed with the result
+    if (_pendingAsyncConnection.valid())
+        _pendingAsyncConnection.get();
+
     //! Closes the actualy MySQL connection.
+    _queue->Cancel();
+    _retiringConnections.clear();
     _connections[IDX_ASYNC].clear();
+    if (_replicaQueue)
+        _replicaQueue->Cancel();
+    _connections[IDX_REPLICA].clear();
 
     TC_LOG_INFO("sql.driver", "Asynchronous connections on DatabasePool '{}' terminated. "
                 "Proceeding with synchronous connections.",
@@ -179,9 +214,32 @@ bool DatabaseWorkerPool<T>::PrepareStatements()
         }
     }
 
+    //! Every replica connection prepares the same statements, remember which ones it accepts for routing
+    if (!_connections[IDX_REPLICA].empty())
+    {
+        T const* replica = _connections[IDX_REPLICA].front().get();
+        _replicaStatements.assign(replica->m_stmts.size(), false);
+        for (size_t i = 0; i < replica->m_stmts.size(); ++i)
+            _replicaStatements[i] = replica->m_stmts[i] != nullptr;
+    }
+
+    if (_slowStatementThreshold && !_statementStatistics)
+    {
+        _statementStatistics = std::make_unique<PreparedStatementStatistics>(_preparedStatementSize.size(), *_slowStatementThreshold);
+        for (auto& connections : _connections)
+            for (auto& connection : connections)
+                connection->m_statementStatistics = _statementStatistics.get();
+    }
+
     return true;
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::EnableStatementStatistics(Milliseconds slowStatementThreshold)
+{
+    _slowStatementThreshold = slowStatementThreshold;
+}
+
 template <class T>
 QueryResult DatabaseWorkerPool<T>::Query(char const* sql, T* connection /*= nullptr*/)
 {
@@ -199,6 +257,28 @@ QueryResult DatabaseWorkerPool<T>::Query(char const* sql, T* connection /*= null
     return QueryResult(result);
 }
 
+template <class T>
+QueryResult DatabaseWorkerPool<T>::StreamQuery(char const* sql)
+{
+    T* connection = GetFreeConnection();
+    ResultSet* result = connection->StreamQuery(sql);
+    if (!result)
+    {
+        connection->Unlock();
+        return QueryResult(nullptr);
+    }
+
+    // unlocked once all rows were read or the result was discarded early
+    result->SetReleaseCallback([connection]() { connection->Unlock(); });
+    if (!result->NextRow())
+    {
+        delete result;
+        return QueryResult(nullptr);
+    }
+
+    return QueryResult(result);
+}
+
 template <class T>
 PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
 {
@@ -224,27 +304,48 @@ QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql)
     BasicStatementTask* task = new BasicStatementTask(sql, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     QueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, SQLOperationPriority::Interactive);
     return QueryCallback(std::move(result));
 }
 
 template <class T>
-QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
+QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt, TimePoint lastWrite /*= {}*/)
 {
+    bool const useReplica = CanUseReplica(stmt->GetIndex(), lastWrite);
     PreparedStatementTask* task = new PreparedStatementTask(stmt, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     PreparedQueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+    if (useReplica)
+        _replicaQueue->Push(task, SQLOperationPriority::Interactive);
+    else
+        Enqueue(task, SQLOperationPriority::Interactive);
     return QueryCallback(std::move(result));
 }
 
 template <class T>
-SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder)
+SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, SQLOperationPriority priority /*= SQLOperationPriority::Interactive*/,
+    TimePoint lastWrite /*= {}*/)
 {
-    SQLQueryHolderTask* task = new SQLQueryHolderTask(holder);
-    // Store future result before enqueueing - task might get already processed and deleted before returning from this method
-    QueryResultHolderFuture result = task->GetFuture();
-    Enqueue(task);
+    bool const useReplica = _replicaQueue && !_replicaStatements.empty()
+        && holder->AllStatements([&](uint32 index) { return CanUseReplica(index, lastWrite); });
+    DatabaseWorkQueue* queue = useReplica ? _replicaQueue.get() : _queue.get();
+    size_t const queryCount = holder->GetSize();
+    size_t const parts = std::min({ size_t(_queryHolderParts), size_t(useReplica ? _replica_threads : _async_threads), queryCount });
+    if (parts <= 1)
+    {
+        SQLQueryHolderTask* task = new SQLQueryHolderTask(holder);
+        // Store future result before enqueueing - task might get already processed and deleted before returning from this method
+        QueryResultHolderFuture result = task->GetFuture();
+        queue->Push(task, priority);
+        return { std::move(holder), std::move(result) };
+    }
+
+    // queries of a holder are independent, spread them over several connections and complete when all parts are done
+    std::shared_ptr<SQLQueryHolderTask::SharedResult> sharedResult = std::make_shared<SQLQueryHolderTask::SharedResult>(parts);
+    QueryResultHolderFuture result = sharedResult->Promise.get_future();
+    for (size_t part = 0; part < parts; ++part)
+        queue->Push(new SQLQueryHolderTask(holder, sharedResult, queryCount * part / parts, queryCount * (part + 1) / parts), priority);
+
     return { std::move(holder), std::move(result) };
 }
 
@@ -255,7 +356,7 @@ SQLTransaction<T> DatabaseWorkerPool<T>::BeginTransaction()
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
+void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction, SQLOperationPriority priority /*= SQLOperationPriority::Normal*/)
 {
 #ifdef TRINITY_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
@@ -274,7 +375,7 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
     }
 #endif // TRINITY_DEBUG
 
-    Enqueue(new TransactionTask(transaction));
+    Enqueue(new TransactionTask(transaction), priority);
 }
 
 template <class T>
@@ -299,7 +400,7 @@ TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction
 
     TransactionWithResultTask* task = new TransactionWithResultTask(transaction);
     TransactionFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, SQLOperationPriority::Normal);
     return TransactionCallback(std::move(result));
 }
 
@@ -367,9 +468,77 @@ void DatabaseWorkerPool<T>::KeepAlive()
     //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
     //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
     //! as the sole purpose is to prevent connections from idling.
+    //! Pings are queued as interactive work so workers reserved for that class receive them too.
     auto const count = _connections[IDX_ASYNC].size();
     for (uint8 i = 0; i < count; ++i)
-        Enqueue(new PingOperation);
+        Enqueue(new PingOperation, SQLOperationPriority::Interactive);
+
+    for (size_t i = 0; i < _connections[IDX_REPLICA].size(); ++i)
+        _replicaQueue->Push(new PingOperation, SQLOperationPriority::Interactive);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::AdjustAsyncWorkers()
+{
+    if (_max_async_threads <= _async_threads)
+        return;
+
+    if (_pendingAsyncConnection.valid() && _pendingAsyncConnection.wait_for(0s) == std::future_status::ready)
+    {
+        if (std::unique_ptr<T> connection = _pendingAsyncConnection.get())
+        {
+            _connections[IDX_ASYNC].push_back(std::move(connection));
+            TC_LOG_INFO("sql.driver", "DatabasePool '{}' opened an asynchronous connection, {} running.",
+                GetDatabaseName(), _connections[IDX_ASYNC].size());
+        }
+    }
+
+    std::erase_if(_retiringConnections, [](std::unique_ptr<T> const& connection) { return connection->IsWorkerFinished(); });
+
+    TimePoint const now = std::chrono::steady_clock::now();
+    Microseconds const elapsed = std::chrono::duration_cast<Microseconds>(now - _lastWorkerAdjustment);
+    Microseconds const busyTime = _queue->PopBusyTime();
+    _lastWorkerAdjustment = now;
+
+    std::size_t const workers = _connections[IDX_ASYNC].size();
+    if (!workers || elapsed <= 0us)
+        return;
+
+    // share of the elapsed time the workers spent executing operations
+    float const utilization = float(busyTime.count()) / (float(elapsed.count()) * workers);
+    std::size_t const queued = _queue->Size();
+    if ((queued > workers || utilization > 0.8f) && workers < _max_async_threads)
+    {
+        if (!_pendingAsyncConnection.valid())
+            _pendingAsyncConnection = std::async(std::launch::async, &DatabaseWorkerPool<T>::OpenAsyncConnection, this);
+    }
+    else if (!queued && utilization < 0.2f && workers > _async_threads)
+    {
+        std::unique_ptr<T> connection = std::move(_connections[IDX_ASYNC].back());
+        _connections[IDX_ASYNC].pop_back();
+
+        // the worker finishes its current operation first, the connection is destroyed on a later call
+        connection->RequestWorkerStop();
+        _retiringConnections.push_back(std::move(connection));
+
+        TC_LOG_INFO("sql.driver", "DatabasePool '{}' closing an asynchronous connection, {} running.",
+            GetDatabaseName(), _connections[IDX_ASYNC].size());
+    }
+}
+
+template <class T>
+std::unique_ptr<T> DatabaseWorkerPool<T>::OpenAsyncConnection()
+{
+    std::unique_ptr<T> connection = std::make_unique<T>(_queue.get(), *_connectionInfo);
+    if (connection->Open())
+        return nullptr;
+
+    if (!connection->PrepareStatements())
+        return nullptr;
+
+    connection->m_statementStatistics = _statementStatistics.get();
+    connection->StartWorker();
+    return connection;
 }
 
 template <class T>
@@ -385,6 +554,13 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
                 return std::make_unique<T>(_queue.get(), *_connectionInfo);
             case IDX_SYNCH:
                 return std::make_unique<T>(*_connectionInfo);
+            case IDX_REPLICA:
+            {
+                // replica connections are async connections that only prepare read only statements
+                auto replica = std::make_unique<T>(_replicaQueue.get(), *_replicaConnectionInfo);
+                replica->m_connectionFlags = CONNECTION_READONLY;
+                return replica;
+            }
             default:
                 ABORT();
             }
@@ -412,6 +588,9 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
         }
         else
         {
+            if (type != IDX_SYNCH)
+                connection->StartWorker();
+
             _connections[type].push_back(std::move(connection));
         }
     }
@@ -430,9 +609,19 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, un
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op)
+void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op, SQLOperationPriority priority)
 {
-    _queue->Push(op);
+    _queue->Push(op, priority);
+}
+
+template <class T>
+bool DatabaseWorkerPool<T>::CanUseReplica(uint32 index, TimePoint lastWrite) const
+{
+    if (index >= _replicaStatements.size() || !_replicaStatements[index])
+        return false;
+
+    //! Read your own writes - callers that modified the data recently must not see a lagging replica
+    return lastWrite + _replicaMaxLag <= std::chrono::steady_clock::now();
 }
 
 template <class T>
@@ -441,6 +630,18 @@ size_t DatabaseWorkerPool<T>::QueueSize() const
     return _queue->Size();
 }
 
+template <class T>
+size_t DatabaseWorkerPool<T>::QueueSize(SQLOperationPriority priority) const
+{
+    return _queue->Size(priority);
+}
+
+template <class T>
+Milliseconds DatabaseWorkerPool<T>::PopMaxQueueWaitTime(SQLOperationPriority priority)
+{
+    return _queue->PopMaxWaitTime(priority);
+}
+
 template <class T>
 T* DatabaseWorkerPool<T>::GetFreeConnection()
 {
@@ -481,14 +682,14 @@ void DatabaseWorkerPool<T>::Execute(char const* sql)
         return;
 
     BasicStatementTask* task = new BasicStatementTask(sql);
-    Enqueue(task);
+    Enqueue(task, SQLOperationPriority::Normal);
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt)
+void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt, SQLOperationPriority priority /*= SQLOperationPriority::Normal*/)
 {
     PreparedStatementTask* task = new PreparedStatementTask(stmt);
-    Enqueue(task);
+    Enqueue(task, priority);
 }
 
 template <class T>
@@ -20,14 +20,14 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "Duration.h"
+#include "Optional.h"
 #include "StringFormat.h"
 #include <array>
 #include <string>
 #include <vector>
 
-template <typename T>
-class ProducerConsumerQueue;
-
+class PreparedStatementStatistics;
 class SQLOperation;
 struct MySQLConnectionInfo;
 
@@ -39,6 +39,7 @@ class DatabaseWorkerPool
         {
             IDX_ASYNC,
             IDX_SYNCH,
+            IDX_REPLICA,
             IDX_SIZE
         };
 
@@ -50,6 +51,24 @@ class DatabaseWorkerPool
 
         void SetConnectionInfo(std::string const& infoString, uint8 const asyncThreads, uint8 const synchThreads);
 
+        //! Async connections to a read replica, statements prepared with CONNECTION_ASYNC_READONLY are executed on them
+        //! unless the caller wrote to the database less than maxLag ago
+        void SetReplicaConnectionInfo(std::string const& infoString, uint8 const replicaThreads, Milliseconds maxLag);
+
+        //! Upper bound of async connections opened by AdjustAsyncWorkers, the asyncThreads passed to SetConnectionInfo are
+        //! the lower bound. Values not above that lower bound keep the number of async connections fixed.
+        void SetMaxAsyncThreads(uint8 maxThreads) { _max_async_threads = maxThreads; }
+
+        //! Number of async connections a single query holder may be split across, 1 executes holders on one connection
+        void SetQueryHolderParts(uint8 parts) { _queryHolderParts = parts; }
+
+        //! Records per statement latency histograms once statements are prepared, statements slower than
+        //! slowStatementThreshold are logged (zero disables logging)
+        void EnableStatementStatistics(Milliseconds slowStatementThreshold);
+
+        //! Returns null if statement statistics are not enabled
+        PreparedStatementStatistics* GetStatementStatistics() const { return _statementStatistics.get(); }
+
         uint32 Open();
 
         void Close();
@@ -83,7 +102,7 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        void Execute(PreparedStatement<T>* stmt);
+        void Execute(PreparedStatement<T>* stmt, SQLOperationPriority priority = SQLOperationPriority::Normal);
 
         /**
             Direct synchronous one-way statement methods.
@@ -143,6 +162,24 @@ class DatabaseWorkerPool
         //! Statement must be prepared with CONNECTION_SYNCH flag.
         PreparedQueryResult Query(PreparedStatement<T>* stmt);
 
+        //! Executes an SQL query in string format and returns its rows while they are still being transferred,
+        //! without buffering the whole result first. Intended for loading huge tables.
+        //! A synchronous connection stays reserved until the result is released, either after NextRow returned false
+        //! or when it is destroyed - do not run other synchronous queries on this database while iterating.
+        //! GetRowCount() is not available on the returned result.
+        QueryResult StreamQuery(char const* sql);
+
+        //! Executes an SQL query in string format -with variable args- and returns its rows while they are still being transferred.
+        //! Same restrictions as StreamQuery apply.
+        template<typename... Args>
+        QueryResult PStreamQuery(Trinity::FormatString<Args...> sql, Args&&... args)
+        {
+            if (Trinity::IsFormatEmptyOrNull(sql))
+                return QueryResult(nullptr);
+
+            return StreamQuery(Trinity::StringFormat(sql, std::forward<Args>(args)...).c_str());
+        }
+
         /**
             Asynchronous query (with resultset) methods.
         */
@@ -154,13 +191,17 @@ class DatabaseWorkerPool
         //! Enqueues a query in prepared format that will set the value of the PreparedQueryResultFuture return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        QueryCallback AsyncQuery(PreparedStatement<T>* stmt);
+        //! Statements prepared with CONNECTION_ASYNC_READONLY are sent to the read replica if one is configured and
+        //! lastWrite (time the last write the query must observe completed, not when it was enqueued) is older than the replica lag limit.
+        QueryCallback AsyncQuery(PreparedStatement<T>* stmt, TimePoint lastWrite = {});
 
         //! Enqueues a vector of SQL operations (can be both adhoc and prepared) that will set the value of the QueryResultHolderFuture
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder);
+        //! Holders made only of CONNECTION_ASYNC_READONLY statements are routed like AsyncQuery.
+        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, SQLOperationPriority priority = SQLOperationPriority::Interactive,
+            TimePoint lastWrite = {});
 
         /**
             Transaction context methods.
@@ -171,7 +212,7 @@ class DatabaseWorkerPool
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
-        void CommitTransaction(SQLTransaction<T> transaction);
+        void CommitTransaction(SQLTransaction<T> transaction, SQLOperationPriority priority = SQLOperationPriority::Normal);
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
@@ -206,6 +247,11 @@ class DatabaseWorkerPool
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive();
 
+        //! Opens or closes one async connection depending on queue depth and worker utilization since the previous call.
+        //! New connections are opened and prepared on a background thread and join the pool on a later call.
+        //! Must be called periodically from the same thread as KeepAlive.
+        void AdjustAsyncWorkers();
+
         void WarnAboutSyncQueries([[maybe_unused]] bool warn)
         {
 #ifdef TRINITY_DEBUG
@@ -214,13 +260,23 @@ class DatabaseWorkerPool
         }
 
         size_t QueueSize() const;
+        size_t QueueSize(SQLOperationPriority priority) const;
+
+        //! Longest time an async operation of the given class waited before execution since the previous call
+        Milliseconds PopMaxQueueWaitTime(SQLOperationPriority priority);
 
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
+        //! Opens and prepares one additional async connection, its worker starts only once it is ready
+        std::unique_ptr<T> OpenAsyncConnection();
+
         unsigned long EscapeString(char* to, char const* from, unsigned long length);
 
-        void Enqueue(SQLOperation* op);
+        void Enqueue(SQLOperation* op, SQLOperationPriority priority);
+
+        //! True if statement may be executed on the read replica by a caller that last wrote at lastWrite
+        bool CanUseReplica(uint32 index, TimePoint lastWrite) const;
 
         //! Gets a free connection in the synchronous connection pool.
         //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
@@ -229,11 +285,25 @@ class DatabaseWorkerPool
         char const* GetDatabaseName() const;
 
         //! Queue shared by async worker threads.
-        std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> _queue;
+        std::unique_ptr<DatabaseWorkQueue> _queue;
         std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
         std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
+        //! Queue shared by read replica worker threads, null when no replica is configured.
+        std::unique_ptr<DatabaseWorkQueue> _replicaQueue;
+        std::unique_ptr<MySQLConnectionInfo> _replicaConnectionInfo;
+        std::vector<bool> _replicaStatements;
+        Milliseconds _replicaMaxLag;
+        uint8 _replica_threads;
         std::vector<uint8> _preparedStatementSize;
+        std::unique_ptr<PreparedStatementStatistics> _statementStatistics;
+        Optional<Milliseconds> _slowStatementThreshold;
         uint8 _async_threads, _synch_threads;
+        uint8 _max_async_threads;
+        std::future<std::unique_ptr<T>> _pendingAsyncConnection;
+        //! Async connections whose worker was asked to stop, destroyed once the worker finished
+        std::vector<std::unique_ptr<T>> _retiringConnections;
+        TimePoint _lastWorkerAdjustment;
+        uint8 _queryHolderParts;
 #ifdef TRINITY_DEBUG
         static inline thread_local bool _warnSyncQueries = false;
 #endif
@@ -95,6 +95,7 @@ enum CharacterDatabaseStatements : uint32
     CHAR_SEL_CHARACTER_ACTIONS_SPEC,
     CHAR_SEL_MAIL_COUNT,
     CHAR_SEL_CHARACTER_SOCIALLIST,
+    CHAR_SEL_CHARACTER_SOCIAL_FLAGS,
     CHAR_SEL_CHARACTER_HOMEBIND,
     CHAR_SEL_CHARACTER_SPELLCOOLDOWNS,
     CHAR_SEL_CHARACTER_SPELL_CHARGES,
@@ -655,7 +656,7 @@ public:
 
     //- Constructors for sync and async connections
     CharacterDatabaseConnection(MySQLConnectionInfo& connInfo);
-    CharacterDatabaseConnection(ProducerConsumerQueue<SQLOperation*>* q, MySQLConnectionInfo& connInfo);
+    CharacterDatabaseConnection(DatabaseWorkQueue* q, MySQLConnectionInfo& connInfo);
     ~CharacterDatabaseConnection();
 
     //- Loads database type specific prepared statements
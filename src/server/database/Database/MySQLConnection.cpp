@@ -22,6 +22,7 @@
 #include "MySQLHacks.h"
 #include "MySQLPreparedStatement.h"
 #include "PreparedStatement.h"
+#include "PreparedStatementStatistics.h"
 #include "QueryResult.h"
 #include "Timer.h"
 #include "Transaction.h"
@@ -53,22 +54,38 @@ m_prepareError(false),
 m_queue(nullptr),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
+m_statementStatistics(nullptr),
 m_connectionFlags(CONNECTION_SYNCH) { }
 
-MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
+MySQLConnection::MySQLConnection(DatabaseWorkQueue* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
 m_queue(queue),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_ASYNC)
+m_statementStatistics(nullptr),
+m_connectionFlags(CONNECTION_ASYNC) { }
+
+MySQLConnection::~MySQLConnection()
+{
+    Close();
+}
+
+void MySQLConnection::StartWorker()
 {
+    ASSERT(m_queue && !m_worker);
     m_worker = std::make_unique<DatabaseWorker>(m_queue, this);
 }
 
-MySQLConnection::~MySQLConnection()
+void MySQLConnection::RequestWorkerStop()
 {
-    Close();
+    if (m_worker)
+        m_worker->RequestStop();
+}
+
+bool MySQLConnection::IsWorkerFinished() const
+{
+    return !m_worker || m_worker->IsFinished();
 }
 
 void MySQLConnection::Close()
@@ -76,6 +93,7 @@ void MySQLConnection::Close()
     // Stop the worker thread before the statements are cleared
     m_worker.reset();
 
+    m_multiRowStmts.clear();
     m_stmts.clear();
 
     if (m_Mysql)
@@ -182,7 +200,11 @@ uint32 MySQLConnection::Open()
 
 bool MySQLConnection::PrepareStatements()
 {
+    // multi row statements are prepared again on first use
+    m_multiRowStmts.clear();
+
     DoPrepareStatements();
+    m_multiRowMaxRows.assign(m_stmts.size(), 0);
     return !m_prepareError;
 }
 
@@ -229,6 +251,7 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
     MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
     uint32 _s = getMSTime();
+    TimePoint executeStart = std::chrono::steady_clock::now();
 
     if (mysql_stmt_bind_param(msql_STMT, msql_BIND))
     {
@@ -256,6 +279,9 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
 
     TC_LOG_DEBUG("sql.sql", "[{} ms] SQL(p): {}", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString());
 
+    if (m_statementStatistics)
+        m_statementStatistics->Record(stmt, m_mStmt, PREPARED_STATEMENT_PHASE_EXECUTE, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - executeStart));
+
     m_mStmt->ClearParameters();
     return true;
 }
@@ -277,6 +303,7 @@ bool MySQLConnection::_Query(PreparedStatementBase* stmt, MySQLPreparedStatement
     MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
     uint32 _s = getMSTime();
+    TimePoint executeStart = std::chrono::steady_clock::now();
 
     if (mysql_stmt_bind_param(msql_STMT, msql_BIND))
     {
@@ -305,6 +332,9 @@ bool MySQLConnection::_Query(PreparedStatementBase* stmt, MySQLPreparedStatement
 
     TC_LOG_DEBUG("sql.sql", "[{} ms] SQL(p): {}", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString());
 
+    if (m_statementStatistics)
+        m_statementStatistics->Record(stmt, m_mStmt, PREPARED_STATEMENT_PHASE_EXECUTE, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - executeStart));
+
     m_mStmt->ClearParameters();
 
     *pResult = reinterpret_cast<MySQLResult*>(mysql_stmt_result_metadata(msql_STMT));
@@ -330,6 +360,35 @@ ResultSet* MySQLConnection::Query(char const* sql)
     return new ResultSet(result, fields, rowCount, fieldCount);
 }
 
+ResultSet* MySQLConnection::StreamQuery(char const* sql)
+{
+    if (!sql || !m_Mysql)
+        return nullptr;
+
+    uint32 _s = getMSTime();
+
+    if (mysql_query(m_Mysql, sql))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        TC_LOG_INFO("sql.sql", "SQL: {}", sql);
+        TC_LOG_ERROR("sql.sql", "[{}] {}", lErrno, mysql_error(m_Mysql));
+
+        if (_HandleMySQLErrno(lErrno))      // If it returns true, an error was handled successfully (i.e. reconnection)
+            return StreamQuery(sql);        // We try again
+
+        return nullptr;
+    }
+
+    TC_LOG_DEBUG("sql.sql", "[{} ms] SQL(stream): {}", getMSTimeDiff(_s, getMSTime()), sql);
+
+    MySQLResult* result = reinterpret_cast<MySQLResult*>(mysql_use_result(m_Mysql));
+    if (!result)
+        return nullptr;
+
+    // row count is only known after all rows were fetched
+    return new ResultSet(result, reinterpret_cast<MySQLField*>(mysql_fetch_fields(result)), 0, mysql_field_count(m_Mysql), true);
+}
+
 bool MySQLConnection::_Query(const char* sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount)
 {
     if (!m_Mysql)
@@ -394,6 +453,7 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
 
     BeginTransaction();
 
+    std::vector<PreparedStatementBase*> multiRowStmts;
     for (auto itr = queries.begin(); itr != queries.end(); ++itr)
     {
         SQLElementData const& data = *itr;
@@ -403,6 +463,43 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
             {
                 PreparedStatementBase* stmt = data.element.stmt;
                 ASSERT(stmt);
+
+                // consecutive executions of the same INSERT/REPLACE statement are sent to the server as one statement
+                uint32 maxRows = GetMultiRowStatementMaxRows(stmt->GetIndex());
+                if (maxRows > 1)
+                {
+                    multiRowStmts.clear();
+                    multiRowStmts.push_back(stmt);
+                    while (multiRowStmts.size() < maxRows && itr + 1 != queries.end() && (itr + 1)->type == SQL_ELEMENT_PREPARED
+                        && (itr + 1)->element.stmt->GetIndex() == stmt->GetIndex())
+                    {
+                        ++itr;
+                        multiRowStmts.push_back(itr->element.stmt);
+                    }
+
+                    // only power of two row counts are prepared to limit the number of statements kept on each connection
+                    bool success = true;
+                    std::size_t executed = 0;
+                    while (success && executed < multiRowStmts.size())
+                    {
+                        uint32 rowCount = 1;
+                        while (rowCount * 2 <= multiRowStmts.size() - executed)
+                            rowCount *= 2;
+
+                        success = rowCount > 1 ? ExecuteMultiRow(&multiRowStmts[executed], rowCount) : Execute(multiRowStmts[executed]);
+                        executed += rowCount;
+                    }
+
+                    if (!success)
+                    {
+                        TC_LOG_WARN("sql.sql", "Transaction aborted. {} queries not executed.", (uint32)queries.size());
+                        int errorCode = GetLastError();
+                        RollbackTransaction();
+                        return errorCode;
+                    }
+                    break;
+                }
+
                 if (!Execute(stmt))
                 {
                     TC_LOG_WARN("sql.sql", "Transaction aborted. {} queries not executed.", (uint32)queries.size());
@@ -437,6 +534,54 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
     return 0;
 }
 
+bool MySQLConnection::ExecuteMultiRow(PreparedStatementBase* const* stmts, uint32 rowCount)
+{
+    if (!m_Mysql)
+        return false;
+
+    uint32 index = stmts[0]->GetIndex();
+
+    MySQLPreparedStatement* m_mStmt = GetMultiRowPreparedStatement(index, rowCount);
+    if (!m_mStmt)
+    {
+        // fall back to executing rows one by one
+        for (uint32 i = 0; i < rowCount; ++i)
+            if (!Execute(stmts[i]))
+                return false;
+
+        return true;
+    }
+
+    m_mStmt->BindParameters(stmts, rowCount);
+
+    MYSQL_STMT* msql_STMT = m_mStmt->GetSTMT();
+    MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
+
+    uint32 _s = getMSTime();
+    TimePoint executeStart = std::chrono::steady_clock::now();
+
+    if (mysql_stmt_bind_param(msql_STMT, msql_BIND) || mysql_stmt_execute(msql_STMT))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        TC_LOG_ERROR("sql.sql", "SQL(p): {}\n [ERROR]: [{}] {}", m_mStmt->getQueryString(), lErrno, mysql_stmt_error(msql_STMT));
+
+        m_mStmt->ClearParameters();
+
+        if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            return ExecuteMultiRow(stmts, rowCount);       // Try again
+
+        return false;
+    }
+
+    TC_LOG_DEBUG("sql.sql", "[{} ms] SQL(p) x{}: {}", getMSTimeDiff(_s, getMSTime()), rowCount, m_mStmt->getQueryString());
+
+    if (m_statementStatistics)
+        m_statementStatistics->Record(stmts[0], m_mStmt, PREPARED_STATEMENT_PHASE_EXECUTE, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - executeStart));
+
+    m_mStmt->ClearParameters();
+    return true;
+}
+
 size_t MySQLConnection::EscapeString(char* to, const char* from, size_t length)
 {
     return mysql_real_escape_string(m_Mysql, to, from, length);
@@ -479,6 +624,133 @@ MySQLPreparedStatement* MySQLConnection::GetPreparedStatement(uint32 index)
     return ret;
 }
 
+namespace
+{
+uint32 const MaxMultiRowStatementRows = 64;
+uint32 const MaxStatementParameters = 65535;
+
+// Finds the single row "(?, ?, ...)" following VALUES of an INSERT/REPLACE statement
+// Statements with placeholders outside of that row cannot be repeated and return false
+bool FindInsertValuesRow(std::string_view sql, std::size_t& rowBegin, std::size_t& rowEnd)
+{
+    std::size_t start = sql.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos)
+        return false;
+
+    if (!StringStartsWithI(sql.substr(start), "INSERT") && !StringStartsWithI(sql.substr(start), "REPLACE"))
+        return false;
+
+    std::size_t values = std::string_view::npos;
+    for (std::size_t i = start; i + 6 <= sql.length(); ++i)
+    {
+        if (StringEqualI(sql.substr(i, 6), "VALUES"))
+        {
+            values = i;
+            break;
+        }
+    }
+
+    if (values == std::string_view::npos || sql.substr(0, values).find('?') != std::string_view::npos)
+        return false;
+
+    rowBegin = sql.find_first_not_of(" \t\r\n", values + 6);
+    if (rowBegin == std::string_view::npos || sql[rowBegin] != '(')
+        return false;
+
+    int32 depth = 0;
+    char quote = 0;
+    for (std::size_t i = rowBegin; i < sql.length(); ++i)
+    {
+        char c = sql[i];
+        if (quote)
+        {
+            if (c == quote)
+                quote = 0;
+            continue;
+        }
+
+        if (c == '\'' || c == '"' || c == '`')
+            quote = c;
+        else if (c == '(')
+            ++depth;
+        else if (c == ')' && --depth == 0)
+        {
+            rowEnd = i + 1;
+
+            // ON DUPLICATE KEY UPDATE applies to every row, as long as it does not bind anything
+            std::string_view remainder = sql.substr(rowEnd);
+            std::size_t next = remainder.find_first_not_of(" \t\r\n;");
+            return remainder.find('?') == std::string_view::npos
+                && (next == std::string_view::npos || StringStartsWithI(remainder.substr(next), "ON DUPLICATE KEY UPDATE"));
+        }
+    }
+
+    return false;
+}
+}
+
+uint32 MySQLConnection::GetMultiRowStatementMaxRows(uint32 index)
+{
+    if (index >= m_multiRowMaxRows.size())
+        return 1;
+
+    uint32& maxRows = m_multiRowMaxRows[index];
+    if (!maxRows)
+    {
+        maxRows = 1;
+        if (MySQLPreparedStatement const* stmt = m_stmts[index].get())
+        {
+            std::size_t rowBegin, rowEnd;
+            if (stmt->GetParameterCount() && FindInsertValuesRow(stmt->m_queryString, rowBegin, rowEnd))
+                maxRows = std::min(MaxMultiRowStatementRows, MaxStatementParameters / stmt->GetParameterCount());
+        }
+    }
+
+    return maxRows;
+}
+
+MySQLPreparedStatement* MySQLConnection::GetMultiRowPreparedStatement(uint32 index, uint32 rowCount)
+{
+    auto itr = m_multiRowStmts.find({ index, rowCount });
+    if (itr != m_multiRowStmts.end())
+        return itr->second.get();
+
+    std::unique_ptr<MySQLPreparedStatement>& multiRowStmt = m_multiRowStmts[{ index, rowCount }];
+
+    MySQLPreparedStatement const* stmt = GetPreparedStatement(index);
+    std::size_t rowBegin, rowEnd;
+    if (!stmt || !FindInsertValuesRow(stmt->m_queryString, rowBegin, rowEnd))
+        return nullptr;
+
+    std::string_view sql = stmt->m_queryString;
+    std::string_view row = sql.substr(rowBegin, rowEnd - rowBegin);
+    std::string multiRowSql;
+    multiRowSql.reserve(sql.length() + (row.length() + 2) * (rowCount - 1));
+    multiRowSql.append(sql.substr(0, rowEnd));
+    for (uint32 i = 1; i < rowCount; ++i)
+        multiRowSql.append(", ").append(row);
+    multiRowSql.append(sql.substr(rowEnd));
+
+    MYSQL_STMT* mysqlStmt = mysql_stmt_init(m_Mysql);
+    if (!mysqlStmt)
+    {
+        TC_LOG_ERROR("sql.sql", "In mysql_stmt_init() id: {}, sql: \"{}\"", index, multiRowSql);
+        TC_LOG_ERROR("sql.sql", "{}", mysql_error(m_Mysql));
+        return nullptr;
+    }
+
+    if (mysql_stmt_prepare(mysqlStmt, multiRowSql.c_str(), static_cast<unsigned long>(multiRowSql.length())))
+    {
+        TC_LOG_ERROR("sql.sql", "In mysql_stmt_prepare() id: {}, sql: \"{}\"", index, multiRowSql);
+        TC_LOG_ERROR("sql.sql", "{}", mysql_stmt_error(mysqlStmt));
+        mysql_stmt_close(mysqlStmt);
+        return nullptr;
+    }
+
+    multiRowStmt = std::make_unique<MySQLPreparedStatement>(reinterpret_cast<MySQLStmt*>(mysqlStmt), std::move(multiRowSql));
+    return multiRowStmt.get();
+}
+
 void MySQLConnection::PrepareStatement(uint32 index, std::string_view sql, ConnectionFlags flags)
 {
     // Check if specified query should be prepared on this connection
@@ -525,7 +797,15 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatementBase* stmt)
     {
         mysql_next_result(m_Mysql);
     }
-    return new PreparedResultSet(mysqlStmt->GetSTMT(), result, rowCount, fieldCount);
+
+    if (!m_statementStatistics)
+        return new PreparedResultSet(mysqlStmt->GetSTMT(), result, rowCount, fieldCount);
+
+    // rows are transferred from the server while the result set is constructed
+    TimePoint fetchStart = std::chrono::steady_clock::now();
+    PreparedResultSet* resultSet = new PreparedResultSet(mysqlStmt->GetSTMT(), result, rowCount, fieldCount);
+    m_statementStatistics->Record(stmt, mysqlStmt, PREPARED_STATEMENT_PHASE_FETCH, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - fetchStart));
+    return resultSet;
 }
 
 bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, uint8 attempts /*= 5*/)
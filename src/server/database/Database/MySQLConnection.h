@@ -20,23 +20,25 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
-template <typename T>
-class ProducerConsumerQueue;
-
+class DatabaseWorkQueue;
 class DatabaseWorker;
 class MySQLPreparedStatement;
+class PreparedStatementStatistics;
 class SQLOperation;
 
 enum ConnectionFlags
 {
     CONNECTION_ASYNC = 0x1,
     CONNECTION_SYNCH = 0x2,
-    CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH
+    CONNECTION_READONLY = 0x4,                                  //! Read replica connection, only read only statements are prepared on it
+    CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH,
+    CONNECTION_ASYNC_READONLY = CONNECTION_ASYNC | CONNECTION_READONLY //! Async SELECT that may be answered by a read replica
 };
 
 struct TC_DATABASE_API MySQLConnectionInfo
@@ -58,7 +60,7 @@ class TC_DATABASE_API MySQLConnection
 
     public:
         MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
-        MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
+        MySQLConnection(DatabaseWorkQueue* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
         virtual ~MySQLConnection();
 
         virtual uint32 Open();
@@ -68,7 +70,10 @@ class TC_DATABASE_API MySQLConnection
 
         bool Execute(char const* sql);
         bool Execute(PreparedStatementBase* stmt);
+        bool ExecuteMultiRow(PreparedStatementBase* const* stmts, uint32 rowCount);
         ResultSet* Query(char const* sql);
+        //! Rows are transferred while reading the result, no other query may be sent until it is released
+        ResultSet* StreamQuery(char const* sql);
         PreparedResultSet* Query(PreparedStatementBase* stmt);
         bool _Query(char const* sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount);
         bool _Query(PreparedStatementBase* stmt, MySQLPreparedStatement** mysqlStmt, MySQLResult** pResult, uint64* pRowCount, uint32* pFieldCount);
@@ -90,25 +95,42 @@ class TC_DATABASE_API MySQLConnection
         /// Called by parent databasepool. Will let other threads access this connection
         void Unlock();
 
+        /// Starts the worker thread of an asynchronous connection, called once the connection is ready to execute queries
+        void StartWorker();
+
+        /// Asks the worker thread to exit after its current operation, other workers of the queue keep running
+        void RequestWorkerStop();
+
+        /// True once the worker thread exited, the connection can be destroyed without blocking
+        bool IsWorkerFinished() const;
+
         uint32 GetServerVersion() const;
         MySQLPreparedStatement* GetPreparedStatement(uint32 index);
         void PrepareStatement(uint32 index, std::string_view sql, ConnectionFlags flags);
 
+        /// Returns maximum number of rows a single INSERT/REPLACE statement can be combined into, 1 if it cannot be combined
+        uint32 GetMultiRowStatementMaxRows(uint32 index);
+        /// Returns prepared statement inserting rowCount rows at once, prepared on first use
+        MySQLPreparedStatement* GetMultiRowPreparedStatement(uint32 index, uint32 rowCount);
+
         virtual void DoPrepareStatements() = 0;
 
         typedef std::vector<std::unique_ptr<MySQLPreparedStatement>> PreparedStatementContainer;
 
         PreparedStatementContainer           m_stmts;         //! PreparedStatements storage
+        std::map<std::pair<uint32, uint32>, std::unique_ptr<MySQLPreparedStatement>> m_multiRowStmts; //! Multi row variants of m_stmts, by index and row count
+        std::vector<uint32>                  m_multiRowMaxRows; //! Cached GetMultiRowStatementMaxRows results, 0 if not checked yet
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
 
     private:
         bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
 
-        ProducerConsumerQueue<SQLOperation*>* m_queue;      //! Queue shared with other asynchronous connections.
+        DatabaseWorkQueue* m_queue;                         //! Queue shared with other asynchronous connections.
         std::unique_ptr<DatabaseWorker> m_worker;           //! Core worker task.
         MySQLHandle*          m_Mysql;                      //! MySQL Handle.
         MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
+        PreparedStatementStatistics* m_statementStatistics; //! Latency histograms shared by connections of the pool, null when disabled
         ConnectionFlags       m_connectionFlags;            //! Connection flags (for preparing relevant statements)
         std::mutex            m_Mutex;
 
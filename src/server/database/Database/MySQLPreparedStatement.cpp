@@ -37,7 +37,7 @@ template<> struct MySQLType<float> : std::integral_constant<enum_field_types, MY
 template<> struct MySQLType<double> : std::integral_constant<enum_field_types, MYSQL_TYPE_DOUBLE> { };
 
 MySQLPreparedStatement::MySQLPreparedStatement(MySQLStmt* stmt, std::string queryString) :
-    m_stmt(nullptr), m_Mstmt(stmt), m_bind(nullptr), m_queryString(std::move(queryString))
+    m_stmt(nullptr), m_Mstmt(stmt), m_bind(nullptr), m_queryString(std::move(queryString)), m_boundStmts(nullptr), m_boundStmtCount(0)
 {
     /// Initialize variable parameters
     m_paramCount = mysql_stmt_param_count(stmt);
@@ -65,19 +65,30 @@ MySQLPreparedStatement::~MySQLPreparedStatement()
 void MySQLPreparedStatement::BindParameters(PreparedStatementBase* stmt)
 {
     m_stmt = stmt;     // Cross reference them for debug output
+    BindParameters(&m_stmt, 1);
+}
+
+void MySQLPreparedStatement::BindParameters(PreparedStatementBase* const* stmts, std::size_t count)
+{
+    m_stmt = stmts[0];
+    m_boundStmts = stmts;
+    m_boundStmtCount = count;
 
-    uint8 pos = 0;
-    for (PreparedStatementData const& data : stmt->GetParameters())
+    uint32 pos = 0;
+    for (std::size_t i = 0; i < count; ++i)
     {
-        std::visit([&](auto&& param)
+        for (PreparedStatementData const& data : stmts[i]->GetParameters())
         {
-            SetParameter(pos, param);
-        }, data.data);
-        ++pos;
+            std::visit([&](auto&& param)
+            {
+                SetParameter(pos, param);
+            }, data.data);
+            ++pos;
+        }
     }
 #ifdef _DEBUG
     if (pos < m_paramCount)
-        TC_LOG_WARN("sql.sql", "[WARNING]: BindParameters() for statement {} did not bind all allocated parameters", stmt->GetIndex());
+        TC_LOG_WARN("sql.sql", "[WARNING]: BindParameters() for statement {} did not bind all allocated parameters", m_stmt->GetIndex());
 #endif
 }
 
@@ -93,14 +104,14 @@ void MySQLPreparedStatement::ClearParameters()
     }
 }
 
-static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint8 index, uint32 paramCount)
+static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint32 index, uint32 paramCount)
 {
     TC_LOG_ERROR("sql.driver", "Attempted to bind parameter {}{} on a PreparedStatement {} (statement has only {} parameters)", uint32(index) + 1, (index == 1 ? "st" : (index == 2 ? "nd" : (index == 3 ? "rd" : "nd"))), stmtIndex, paramCount);
     return false;
 }
 
 //- Bind on mysql level
-void MySQLPreparedStatement::AssertValidIndex(uint8 index)
+void MySQLPreparedStatement::AssertValidIndex(uint32 index)
 {
     ASSERT(index < m_paramCount || ParamenterIndexAssertFail(m_stmt->GetIndex(), index, m_paramCount));
 
@@ -108,7 +119,7 @@ void MySQLPreparedStatement::AssertValidIndex(uint8 index)
         TC_LOG_ERROR("sql.sql", "[ERROR] Prepared Statement (id: {}) trying to bind value on already bound index ({}).", m_stmt->GetIndex(), index);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::nullptr_t)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::nullptr_t)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -122,13 +133,13 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::nullptr_t)
     param->length = nullptr;
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, bool value)
+void MySQLPreparedStatement::SetParameter(uint32 index, bool value)
 {
     SetParameter(index, uint8(value ? 1 : 0));
 }
 
 template<typename T>
-void MySQLPreparedStatement::SetParameter(uint8 index, T value)
+void MySQLPreparedStatement::SetParameter(uint32 index, T value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -145,7 +156,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, T value)
     memcpy(param->buffer, &value, len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::string const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -162,7 +173,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
     memcpy(param->buffer, value.c_str(), len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::vector<uint8> const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::vector<uint8> const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -184,17 +195,20 @@ std::string MySQLPreparedStatement::getQueryString() const
     std::string queryString(m_queryString);
 
     size_t pos = 0;
-    for (PreparedStatementData const& data : m_stmt->GetParameters())
+    for (std::size_t i = 0; i < m_boundStmtCount; ++i)
     {
-        pos = queryString.find('?', pos);
-
-        std::string replaceStr = std::visit([&](auto&& data)
+        for (PreparedStatementData const& data : m_boundStmts[i]->GetParameters())
         {
-            return PreparedStatementData::ToString(data);
-        }, data.data);
+            pos = queryString.find('?', pos);
+
+            std::string replaceStr = std::visit([&](auto&& data)
+            {
+                return PreparedStatementData::ToString(data);
+            }, data.data);
 
-        queryString.replace(pos, 1, replaceStr);
-        pos += replaceStr.length();
+            queryString.replace(pos, 1, replaceStr);
+            pos += replaceStr.length();
+        }
     }
 
     return queryString;
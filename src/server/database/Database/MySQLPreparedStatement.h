@@ -39,22 +39,25 @@ class TC_DATABASE_API MySQLPreparedStatement
         ~MySQLPreparedStatement();
 
         void BindParameters(PreparedStatementBase* stmt);
+        //- Binds parameters of count statements one after another, used by multi row statements
+        void BindParameters(PreparedStatementBase* const* stmts, std::size_t count);
 
         uint32 GetParameterCount() const { return m_paramCount; }
+        std::string const& GetSqlString() const { return m_queryString; }
 
     protected:
-        void SetParameter(uint8 index, std::nullptr_t);
-        void SetParameter(uint8 index, bool value);
+        void SetParameter(uint32 index, std::nullptr_t);
+        void SetParameter(uint32 index, bool value);
         template<typename T>
-        void SetParameter(uint8 index, T value);
-        void SetParameter(uint8 index, std::string const& value);
-        void SetParameter(uint8 index, std::vector<uint8> const& value);
+        void SetParameter(uint32 index, T value);
+        void SetParameter(uint32 index, std::string const& value);
+        void SetParameter(uint32 index, std::vector<uint8> const& value);
 
         MySQLStmt* GetSTMT() { return m_Mstmt; }
         MySQLBind* GetBind() { return m_bind; }
         PreparedStatementBase* m_stmt;
         void ClearParameters();
-        void AssertValidIndex(uint8 index);
+        void AssertValidIndex(uint32 index);
         std::string getQueryString() const;
 
     private:
@@ -63,6 +66,8 @@ class TC_DATABASE_API MySQLPreparedStatement
         std::vector<bool> m_paramsSet;
         MySQLBind* m_bind;
         std::string const m_queryString;
+        PreparedStatementBase* const* m_boundStmts;
+        std::size_t m_boundStmtCount;
 
         MySQLPreparedStatement(MySQLPreparedStatement const& right) = delete;
         MySQLPreparedStatement& operator=(MySQLPreparedStatement const& right) = delete;
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PreparedStatementStatistics.h"
+#include "Log.h"
+#include "MySQLPreparedStatement.h"
+#include "PreparedStatement.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+// same order as PreparedStatementData::data alternatives
+constexpr std::array<char const*, 14> ParameterTypeNames =
+{
+    "bool", "uint8", "uint16", "uint32", "uint64", "int8", "int16", "int32", "int64", "float", "double", "string", "binary", "null"
+};
+
+std::string GetParameterTypes(PreparedStatementBase const* stmt)
+{
+    std::string types;
+    for (PreparedStatementData const& parameter : stmt->GetParameters())
+    {
+        if (!types.empty())
+            types += ", ";
+
+        types += ParameterTypeNames[parameter.data.index()];
+    }
+
+    return types;
+}
+}
+
+PreparedStatementStatistics::PreparedStatementStatistics(size_t statementCount, Milliseconds slowStatementThreshold)
+    : _statementCount(statementCount), _buckets(std::make_unique<std::atomic<uint32>[]>(statementCount * MAX_PREPARED_STATEMENT_PHASE * BucketCount)),
+    _slowStatementThreshold(slowStatementThreshold)
+{
+}
+
+PreparedStatementStatistics::~PreparedStatementStatistics() = default;
+
+void PreparedStatementStatistics::Record(PreparedStatementBase const* stmt, MySQLPreparedStatement const* mysqlStmt, PreparedStatementPhase phase, Microseconds duration)
+{
+    uint32 index = stmt->GetIndex();
+    if (index >= _statementCount)
+        return;
+
+    uint32 microseconds = uint32(std::min<int64>(duration.count(), std::numeric_limits<uint32>::max()));
+    size_t bucket = std::lower_bound(BucketUpperBounds.begin(), BucketUpperBounds.end(), microseconds) - BucketUpperBounds.begin();
+    GetBucket(index, phase, bucket).fetch_add(1, std::memory_order_relaxed);
+
+    if (_slowStatementThreshold > Microseconds::zero() && duration >= _slowStatementThreshold)
+        TC_LOG_WARN("sql.sql", "Slow statement {} ({} {} us, parameters: {}): {}", index, phase == PREPARED_STATEMENT_PHASE_EXECUTE ? "execute" : "fetch",
+            duration.count(), GetParameterTypes(stmt), mysqlStmt->GetSqlString());
+}
+
+void PreparedStatementStatistics::Collect(std::function<void(uint32 index, PreparedStatementPhase phase, Histogram const& histogram)> const& callback)
+{
+    for (uint32 index = 0; index < _statementCount; ++index)
+    {
+        for (uint8 phase = 0; phase < MAX_PREPARED_STATEMENT_PHASE; ++phase)
+        {
+            Histogram histogram;
+            bool hasSamples = false;
+            for (size_t bucket = 0; bucket < BucketCount; ++bucket)
+            {
+                histogram[bucket] = GetBucket(index, PreparedStatementPhase(phase), bucket).exchange(0, std::memory_order_relaxed);
+                hasSamples = hasSamples || histogram[bucket];
+            }
+
+            if (hasSamples)
+                callback(index, PreparedStatementPhase(phase), histogram);
+        }
+    }
+}
+
+std::atomic<uint32>& PreparedStatementStatistics::GetBucket(uint32 index, PreparedStatementPhase phase, size_t bucket)
+{
+    return _buckets[(size_t(index) * MAX_PREPARED_STATEMENT_PHASE + phase) * BucketCount + bucket];
+}
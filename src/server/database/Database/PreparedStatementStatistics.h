@@ -0,0 +1,69 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PREPAREDSTATEMENTSTATISTICS_H
+#define _PREPAREDSTATEMENTSTATISTICS_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class MySQLPreparedStatement;
+class PreparedStatementBase;
+
+enum PreparedStatementPhase : uint8
+{
+    PREPARED_STATEMENT_PHASE_EXECUTE,
+    PREPARED_STATEMENT_PHASE_FETCH,
+
+    MAX_PREPARED_STATEMENT_PHASE
+};
+
+//! Per statement index latency histograms, shared by all connections of one DatabaseWorkerPool
+class TC_DATABASE_API PreparedStatementStatistics
+{
+    public:
+        //! Upper bounds of histogram buckets in microseconds, one more bucket collects everything above the last bound
+        static constexpr std::array<uint32, 14> BucketUpperBounds = { 50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000 };
+        static constexpr size_t BucketCount = BucketUpperBounds.size() + 1;
+
+        using Histogram = std::array<uint32, BucketCount>;
+
+        PreparedStatementStatistics(size_t statementCount, Milliseconds slowStatementThreshold);
+        ~PreparedStatementStatistics();
+
+        //! Records duration into the histogram of the statement and logs it when it exceeds the slow statement threshold
+        void Record(PreparedStatementBase const* stmt, MySQLPreparedStatement const* mysqlStmt, PreparedStatementPhase phase, Microseconds duration);
+
+        //! Calls callback for every statement and phase with samples recorded since the previous call and resets them
+        void Collect(std::function<void(uint32 index, PreparedStatementPhase phase, Histogram const& histogram)> const& callback);
+
+    private:
+        std::atomic<uint32>& GetBucket(uint32 index, PreparedStatementPhase phase, size_t bucket);
+
+        size_t _statementCount;
+        std::unique_ptr<std::atomic<uint32>[]> _buckets;
+        Microseconds _slowStatementThreshold;
+
+        PreparedStatementStatistics(PreparedStatementStatistics const& right) = delete;
+        PreparedStatementStatistics& operator=(PreparedStatementStatistics const& right) = delete;
+};
+
+#endif
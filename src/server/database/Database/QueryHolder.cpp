@@ -66,22 +66,39 @@ SQLQueryHolderBase::~SQLQueryHolderBase()
     }
 }
 
+bool SQLQueryHolderBase::AllStatements(std::function<bool(uint32)> const& predicate) const
+{
+    for (std::pair<PreparedStatementBase*, PreparedQueryResult> const& query : m_queries)
+        if (query.first && !predicate(query.first->GetIndex()))
+            return false;
+
+    return true;
+}
+
 void SQLQueryHolderBase::SetSize(size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
     m_queries.resize(size);
 }
 
+SQLQueryHolderTask::SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder)
+    : m_holder(std::move(holder)), m_result(std::make_shared<SharedResult>(1)), m_begin(0), m_end(m_holder->m_queries.size())
+{
+}
+
 SQLQueryHolderTask::~SQLQueryHolderTask() = default;
 
 bool SQLQueryHolderTask::Execute()
 {
-    /// execute all queries in the holder and pass the results
-    for (size_t i = 0; i < m_holder->m_queries.size(); ++i)
+    /// execute the queries of this part and pass the results
+    /// parts never share indexes so they can write their results concurrently
+    for (size_t i = m_begin; i < m_end; ++i)
         if (PreparedStatementBase* stmt = m_holder->m_queries[i].first)
             m_holder->SetPreparedResult(i, m_conn->Query(stmt));
 
-    m_result.set_value();
+    if (--m_result->RemainingParts == 0)
+        m_result->Promise.set_value();
+
     return true;
 }
 
@@ -19,6 +19,8 @@
 #define _QUERYHOLDER_H
 
 #include "SQLOperation.h"
+#include <atomic>
+#include <functional>
 #include <vector>
 
 class TC_DATABASE_API SQLQueryHolderBase
@@ -32,6 +34,9 @@ class TC_DATABASE_API SQLQueryHolderBase
         void SetSize(size_t size);
         PreparedQueryResult GetPreparedResult(size_t index) const;
         void SetPreparedResult(size_t index, PreparedResultSet* result);
+        size_t GetSize() const { return m_queries.size(); }
+        //! Returns true if predicate is true for statement index of every query set in this holder
+        bool AllStatements(std::function<bool(uint32)> const& predicate) const;
 
     protected:
         bool SetPreparedQueryImpl(size_t index, PreparedStatementBase* stmt);
@@ -49,18 +54,33 @@ public:
 
 class TC_DATABASE_API SQLQueryHolderTask : public SQLOperation
 {
+    public:
+        //! Completion state shared by all tasks executing parts of the same holder
+        struct SharedResult
+        {
+            explicit SharedResult(size_t parts) : RemainingParts(parts) { }
+
+            QueryResultHolderPromise Promise;
+            std::atomic<size_t> RemainingParts;
+        };
+
     private:
         std::shared_ptr<SQLQueryHolderBase> m_holder;
-        QueryResultHolderPromise m_result;
+        std::shared_ptr<SharedResult> m_result;
+        size_t m_begin;
+        size_t m_end;
 
     public:
-        explicit SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder)
-            : m_holder(std::move(holder)) { }
+        explicit SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder);
+
+        //! Executes queries [begin, end) of the holder, the promise is fulfilled by the last part to finish
+        SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder, std::shared_ptr<SharedResult> result, size_t begin, size_t end)
+            : m_holder(std::move(holder)), m_result(std::move(result)), m_begin(begin), m_end(end) { }
 
         ~SQLQueryHolderTask();
 
         bool Execute() override;
-        QueryResultHolderFuture GetFuture() { return m_result.get_future(); }
+        QueryResultHolderFuture GetFuture() { return m_result->Promise.get_future(); }
 };
 
 class TC_DATABASE_API SQLQueryHolderCallback
@@ -22,7 +22,9 @@
 #include "Log.h"
 #include "MySQLHacks.h"
 #include "MySQLWorkaround.h"
+#include "QueryResultSnapshot.h"
 #include <cstring>
+#include <utility>
 
 namespace
 {
@@ -203,11 +205,14 @@ void InitializeDatabaseFieldMetadata(QueryResultFieldMetadata* meta, MySQLField
 }
 }
 
-ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount) :
+ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount, bool streamed /*= false*/) :
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_snapshotValue(0),
+_snapshotOffset(0),
+_streamed(streamed)
 {
     _fieldMetadata.resize(_fieldCount);
     _currentRow = new Field[_fieldCount];
@@ -218,7 +223,37 @@ _fields(fields)
     }
 }
 
+ResultSet::ResultSet(std::shared_ptr<QueryResultSnapshot const> snapshot) :
+_rowCount(snapshot->RowCount),
+_fieldCount(snapshot->Columns.size()),
+_result(nullptr),
+_fields(nullptr),
+_snapshot(std::move(snapshot)),
+_snapshotValue(0),
+_snapshotOffset(0),
+_streamed(false)
+{
+    _fieldMetadata.resize(_fieldCount);
+    _currentRow = new Field[_fieldCount];
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        QueryResultSnapshot::Column const& column = _snapshot->Columns[i];
+        QueryResultFieldMetadata& meta = _fieldMetadata[i];
+        meta.TableName = column.TableName.c_str();
+        meta.TableAlias = column.TableAlias.c_str();
+        meta.Name = column.Name.c_str();
+        meta.Alias = column.Alias.c_str();
+        meta.TypeName = column.TypeName.c_str();
+        meta.Index = i;
+        meta.Type = column.Type;
+        meta.Converter = FromStringValueConverters[AsUnderlyingType(meta.Type)].get();
+        _currentRow[i].SetMetadata(&meta);
+    }
+}
+
 PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount) :
+m_data(nullptr),
+m_rowSize(0),
 m_rowCount(rowCount),
 m_rowPosition(0),
 m_fieldCount(fieldCount),
@@ -262,10 +297,12 @@ m_metadataResult(result)
     //- This is where we prepare the buffer based on metadata
     MySQLField* field = reinterpret_cast<MySQLField*>(mysql_fetch_fields(m_metadataResult));
     m_fieldMetadata.resize(m_fieldCount);
+    m_fieldOffsets.resize(m_fieldCount);
     std::size_t rowSize = 0;
     for (uint32 i = 0; i < m_fieldCount; ++i)
     {
         uint32 size = SizeForType(&field[i]);
+        m_fieldOffsets[i] = uint32(rowSize);
         rowSize += size;
 
         InitializeDatabaseFieldMetadata(&m_fieldMetadata[i], &field[i], i, true);
@@ -279,6 +316,8 @@ m_metadataResult(result)
     }
 
     char* dataBuffer = new char[rowSize * m_rowCount];
+    m_data = dataBuffer;
+    m_rowSize = rowSize;
     for (uint32 i = 0, offset = 0; i < m_fieldCount; ++i)
     {
         m_rBind[i].buffer = dataBuffer + offset;
@@ -296,13 +335,13 @@ m_metadataResult(result)
         return;
     }
 
-    m_rows.resize(uint32(m_rowCount) * m_fieldCount);
+    // rows are kept in the fetch buffer, only lengths are stored per field
+    // and a single row of Field objects is pointed at the current row when iterating
+    m_lengths.resize(std::size_t(m_rowCount) * m_fieldCount);
     while (_NextRow())
     {
         for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
-            m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetMetadata(&m_fieldMetadata[fIndex]);
-
             unsigned long buffer_length = m_rBind[fIndex].buffer_length;
             unsigned long fetched_length = *m_rBind[fIndex].length;
             if (!*m_rBind[fIndex].is_null)
@@ -328,19 +367,13 @@ m_metadataResult(result)
                         break;
                 }
 
-                m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetValue(
-                    (char const*)buffer,
-                    fetched_length);
-
-                // move buffer pointer to next part
-                m_stmt->bind[fIndex].buffer = (char*)buffer + rowSize;
+                m_lengths[std::size_t(m_rowPosition) * m_fieldCount + fIndex] = uint32(fetched_length);
             }
             else
-            {
-                m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetValue(
-                    nullptr,
-                    *m_rBind[fIndex].length);
-            }
+                m_lengths[std::size_t(m_rowPosition) * m_fieldCount + fIndex] = NullLength;
+
+            // move buffer pointer to next row, also for NULL values so every row starts at a fixed offset
+            m_stmt->bind[fIndex].buffer = (char*)m_stmt->bind[fIndex].buffer + rowSize;
         }
         m_rowPosition++;
     }
@@ -348,6 +381,13 @@ m_metadataResult(result)
 
     /// All data is buffered, let go of mysql c api structures
     mysql_stmt_free_result(m_stmt);
+
+    m_currentRow.resize(m_fieldCount);
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+        m_currentRow[i].SetMetadata(&m_fieldMetadata[i]);
+
+    if (m_rowCount)
+        LoadCurrentRow();
 }
 
 ResultSet::~ResultSet()
@@ -364,12 +404,23 @@ bool ResultSet::NextRow()
 {
     MYSQL_ROW row;
 
+    if (_snapshot)
+        return NextSnapshotRow();
+
     if (!_result)
         return false;
 
     row = mysql_fetch_row(_result);
     if (!row)
     {
+        // streamed results fetch rows from the server here, a lost connection must not look like the end of the table
+        // or the caller silently loads a partial result, buffered results have no connection to ask anymore
+        if (uint32 lErrno = _streamed ? mysql_errno(_result->handle) : 0)
+        {
+            TC_LOG_FATAL("sql.sql", "{}:mysql_fetch_row, result stream interrupted. Error [{}] {}", __FUNCTION__, lErrno, mysql_error(_result->handle));
+            ABORT_MSG("Streamed query result was interrupted by error %u, aborting to not continue with incomplete data", lErrno);
+        }
+
         CleanUp();
         return false;
     }
@@ -388,6 +439,73 @@ bool ResultSet::NextRow()
     return true;
 }
 
+bool ResultSet::NextSnapshotRow()
+{
+    if (_snapshotValue >= _snapshot->Lengths.size())
+    {
+        CleanUp();
+        return false;
+    }
+
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        uint32 length = _snapshot->Lengths[_snapshotValue++];
+        if (length == QueryResultSnapshot::NullLength)
+        {
+            _currentRow[i].SetValue(nullptr, 0);
+            continue;
+        }
+
+        _currentRow[i].SetValue(_snapshot->Data.data() + _snapshotOffset, length);
+        _snapshotOffset += length + 1;
+    }
+
+    return true;
+}
+
+std::shared_ptr<QueryResultSnapshot> ResultSet::TakeSnapshot()
+{
+    std::shared_ptr<QueryResultSnapshot> snapshot = std::make_shared<QueryResultSnapshot>();
+    snapshot->Columns.resize(_fieldCount);
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        auto toString = [](char const* value) { return std::string(value ? value : ""); };
+
+        QueryResultFieldMetadata const& meta = _fieldMetadata[i];
+        QueryResultSnapshot::Column& column = snapshot->Columns[i];
+        column.TableName = toString(meta.TableName);
+        column.TableAlias = toString(meta.TableAlias);
+        column.Name = toString(meta.Name);
+        column.Alias = toString(meta.Alias);
+        column.TypeName = toString(meta.TypeName);
+        column.Type = meta.Type;
+    }
+
+    if (!_currentRow)
+        return snapshot;
+
+    do
+    {
+        for (uint32 i = 0; i < _fieldCount; i++)
+        {
+            Field const& field = _currentRow[i];
+            if (field.IsNull())
+            {
+                snapshot->Lengths.push_back(QueryResultSnapshot::NullLength);
+                continue;
+            }
+
+            snapshot->Lengths.push_back(field._length);
+            snapshot->Data.append(field._value, field._length);
+            snapshot->Data.push_back('\0');
+        }
+
+        ++snapshot->RowCount;
+    } while (NextRow());
+
+    return snapshot;
+}
+
 bool PreparedResultSet::NextRow()
 {
     /// Only updates the m_rowPosition so upper level code knows in which element
@@ -395,9 +513,23 @@ bool PreparedResultSet::NextRow()
     if (++m_rowPosition >= m_rowCount)
         return false;
 
+    LoadCurrentRow();
     return true;
 }
 
+void PreparedResultSet::LoadCurrentRow()
+{
+    char const* row = m_data + std::size_t(m_rowPosition) * m_rowSize;
+    uint32 const* lengths = &m_lengths[std::size_t(m_rowPosition) * m_fieldCount];
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        if (lengths[i] != NullLength)
+            m_currentRow[i].SetValue(row + m_fieldOffsets[i], lengths[i]);
+        else
+            m_currentRow[i].SetValue(nullptr, 0);
+    }
+}
+
 bool PreparedResultSet::_NextRow()
 {
     /// Only called in low-level code, namely the constructor
@@ -422,6 +554,11 @@ void ResultSet::CleanUp()
         mysql_free_result(_result);
         _result = nullptr;
     }
+
+    _snapshot = nullptr;
+
+    if (_releaseCallback)
+        std::exchange(_releaseCallback, nullptr)();
 }
 
 void PreparedResultSet::CleanUp()
@@ -446,12 +583,12 @@ Field const& ResultSet::operator[](std::size_t index) const
 Field* PreparedResultSet::Fetch() const
 {
     ASSERT(m_rowPosition < m_rowCount);
-    return const_cast<Field*>(&m_rows[uint32(m_rowPosition) * m_fieldCount]);
+    return const_cast<Field*>(m_currentRow.data());
 }
 
 Field const& PreparedResultSet::operator[](std::size_t index) const
 {
     ASSERT(m_rowPosition < m_rowCount);
     ASSERT(index < m_fieldCount);
-    return m_rows[uint32(m_rowPosition) * m_fieldCount + index];
+    return m_currentRow[index];
 }
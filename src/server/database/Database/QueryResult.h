@@ -20,12 +20,20 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <functional>
+#include <limits>
+#include <memory>
 #include <vector>
 
+struct QueryResultSnapshot;
+
 class TC_DATABASE_API ResultSet
 {
     public:
-        ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount);
+        //! streamed results come from mysql_use_result and fetch their rows from the server while iterating
+        ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount, bool streamed = false);
+        //! Iterates rows of a snapshot instead of a MySQL result, NextRow must be called once before accessing the first row
+        explicit ResultSet(std::shared_ptr<QueryResultSnapshot const> snapshot);
         ~ResultSet();
 
         bool NextRow();
@@ -35,6 +43,12 @@ class TC_DATABASE_API ResultSet
         Field* Fetch() const { return _currentRow; }
         Field const& operator[](std::size_t index) const;
 
+        //! Called once the result is released, after the last row was read or on destruction
+        void SetReleaseCallback(std::function<void()> callback) { _releaseCallback = std::move(callback); }
+
+        //! Copies the current and all remaining rows, the result is exhausted afterwards
+        std::shared_ptr<QueryResultSnapshot> TakeSnapshot();
+
     protected:
         std::vector<QueryResultFieldMetadata> _fieldMetadata;
         uint64 _rowCount;
@@ -45,6 +59,13 @@ class TC_DATABASE_API ResultSet
         void CleanUp();
         MySQLResult* _result;
         MySQLField* _fields;
+        std::function<void()> _releaseCallback;
+        std::shared_ptr<QueryResultSnapshot const> _snapshot;
+        std::size_t _snapshotValue;     ///< Index of the next value in _snapshot->Lengths
+        std::size_t _snapshotOffset;    ///< Offset of the next non NULL value in _snapshot->Data
+        bool _streamed;
+
+        bool NextSnapshotRow();
 
         ResultSet(ResultSet const& right) = delete;
         ResultSet& operator=(ResultSet const& right) = delete;
@@ -65,18 +86,25 @@ class TC_DATABASE_API PreparedResultSet
 
     protected:
         std::vector<QueryResultFieldMetadata> m_fieldMetadata;
-        std::vector<Field> m_rows;
+        std::vector<Field> m_currentRow;  ///< Reused for every row, points into m_data at m_rowPosition
+        std::vector<uint32> m_lengths;    ///< Value length of every field of every row, NullLength for NULL values
+        std::vector<uint32> m_fieldOffsets; ///< Offset of each field inside a row of m_data
+        char const* m_data;               ///< All rows, m_rowSize bytes each
+        std::size_t m_rowSize;
         uint64 m_rowCount;
         uint64 m_rowPosition;
         uint32 m_fieldCount;
 
     private:
+        static constexpr uint32 NullLength = std::numeric_limits<uint32>::max();
+
         MySQLBind* m_rBind;
         MySQLStmt* m_stmt;
         MySQLResult* m_metadataResult;    ///< Field metadata, returned by mysql_stmt_result_metadata
 
         void CleanUp();
         bool _NextRow();
+        void LoadCurrentRow();
 
         PreparedResultSet(PreparedResultSet const& right) = delete;
         PreparedResultSet& operator=(PreparedResultSet const& right) = delete;
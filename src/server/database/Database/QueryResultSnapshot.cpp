@@ -0,0 +1,112 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "QueryResultSnapshot.h"
+#include <istream>
+#include <ostream>
+
+namespace
+{
+template <typename T>
+void WriteValue(std::ostream& out, T value)
+{
+    out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+void WriteString(std::ostream& out, std::string const& value)
+{
+    WriteValue<uint32>(out, value.size());
+    out.write(value.data(), value.size());
+}
+
+template <typename T>
+bool ReadValue(std::istream& in, T& value)
+{
+    return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool ReadString(std::istream& in, std::string& value)
+{
+    uint32 size = 0;
+    if (!ReadValue(in, size))
+        return false;
+
+    value.resize(size);
+    return bool(in.read(value.data(), size));
+}
+}
+
+void QueryResultSnapshot::Write(std::ostream& out) const
+{
+    WriteValue<uint32>(out, Columns.size());
+    for (Column const& column : Columns)
+    {
+        WriteString(out, column.TableName);
+        WriteString(out, column.TableAlias);
+        WriteString(out, column.Name);
+        WriteString(out, column.Alias);
+        WriteString(out, column.TypeName);
+        WriteValue(out, column.Type);
+    }
+
+    WriteValue(out, RowCount);
+    WriteValue<uint64>(out, Lengths.size());
+    out.write(reinterpret_cast<char const*>(Lengths.data()), Lengths.size() * sizeof(uint32));
+    WriteValue<uint64>(out, Data.size());
+    out.write(Data.data(), Data.size());
+}
+
+bool QueryResultSnapshot::Read(std::istream& in)
+{
+    uint32 columnCount = 0;
+    if (!ReadValue(in, columnCount))
+        return false;
+
+    Columns.resize(columnCount);
+    for (Column& column : Columns)
+    {
+        if (!ReadString(in, column.TableName) || !ReadString(in, column.TableAlias) || !ReadString(in, column.Name)
+            || !ReadString(in, column.Alias) || !ReadString(in, column.TypeName) || !ReadValue(in, column.Type))
+            return false;
+
+        if (column.Type > DatabaseFieldTypes::Binary)
+            return false;
+    }
+
+    uint64 valueCount = 0;
+    if (!ReadValue(in, RowCount) || !ReadValue(in, valueCount) || valueCount != RowCount * columnCount)
+        return false;
+
+    Lengths.resize(valueCount);
+    if (!in.read(reinterpret_cast<char*>(Lengths.data()), valueCount * sizeof(uint32)))
+        return false;
+
+    uint64 dataSize = 0;
+    if (!ReadValue(in, dataSize))
+        return false;
+
+    // every value must fit inside Data, otherwise rows would be read past its end
+    uint64 expectedSize = 0;
+    for (uint32 length : Lengths)
+        if (length != NullLength)
+            expectedSize += uint64(length) + 1;
+
+    if (expectedSize != dataSize)
+        return false;
+
+    Data.resize(dataSize);
+    return bool(in.read(Data.data(), dataSize));
+}
@@ -0,0 +1,51 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef QUERYRESULTSNAPSHOT_H
+#define QUERYRESULTSNAPSHOT_H
+
+#include "Define.h"
+#include "Field.h"
+#include <iosfwd>
+#include <limits>
+#include <string>
+#include <vector>
+
+/// Owned copy of all rows of a text protocol query result, independent of the connection it was read from
+struct TC_DATABASE_API QueryResultSnapshot
+{
+    static constexpr uint32 NullLength = std::numeric_limits<uint32>::max();
+
+    struct Column
+    {
+        std::string TableName;
+        std::string TableAlias;
+        std::string Name;
+        std::string Alias;
+        std::string TypeName;
+        DatabaseFieldTypes Type = DatabaseFieldTypes::Null;
+    };
+
+    std::vector<Column> Columns;
+    std::vector<uint32> Lengths;    ///< Length of every value of every row, NullLength for NULL values
+    std::string Data;               ///< All non NULL values in row order, each one followed by a null terminator
+    uint64 RowCount = 0;
+
+    void Write(std::ostream& out) const;
+    bool Read(std::istream& in);
+};
+
+#endif
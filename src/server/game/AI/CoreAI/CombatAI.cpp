@@ -49,6 +49,12 @@ void AggressorAI::UpdateAI(uint32 /*diff*/)
     DoMeleeAttackIfReady();
 }
 
+bool AggressorAI::IsLineOfSightReactive() const
+{
+    // same conditions as CreatureAI::MoveInLineOfSight
+    return !me->IsEngaged() && me->HasReactState(REACT_AGGRESSIVE);
+}
+
 /////////////////
 // CombatAI
 /////////////////
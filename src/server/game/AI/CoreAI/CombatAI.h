@@ -29,6 +29,7 @@ class TC_GAME_API AggressorAI : public CreatureAI
         using CreatureAI::CreatureAI;
 
         void UpdateAI(uint32) override;
+        bool IsLineOfSightReactive() const override;
         static int32 Permissible(Creature const* creature);
 };
 
@@ -101,7 +102,7 @@ struct TC_GAME_API VehicleAI : public CreatureAI
         explicit VehicleAI(Creature* creature, uint32 scriptId = {});
 
         void UpdateAI(uint32 diff) override;
-        void MoveInLineOfSight(Unit*) override { }
+        void MoveInLineOfSight(Unit*) override { IgnoreMoveInLineOfSight(); }
         void AttackStart(Unit*) override { }
         void OnCharmed(bool isNew) override;
 
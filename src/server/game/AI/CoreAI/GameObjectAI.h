@@ -70,6 +70,7 @@ class TC_GAME_API GameObjectAI
         static int32 Permissible(GameObject const* go);
 
         // Called when the dialog status between a player and the gameobject is requested.
+        // After quest rewards only givers of affected quests are queried again, call Player::SendQuestGiverStatusMultiple when a scripted status changes otherwise
         virtual Optional<QuestGiverStatus> GetDialogStatus(Player* player);
 
         // Called when a player opens a gossip dialog with the gameobject.
@@ -25,7 +25,7 @@ class TC_GAME_API PassiveAI : public CreatureAI
     public:
         explicit PassiveAI(Creature* creature, uint32 scriptId = {});
 
-        void MoveInLineOfSight(Unit*) override { }
+        void MoveInLineOfSight(Unit*) override { IgnoreMoveInLineOfSight(); }
         void AttackStart(Unit*) override { }
         void UpdateAI(uint32) override;
 
@@ -37,7 +37,7 @@ class TC_GAME_API PossessedAI : public CreatureAI
     public:
         explicit PossessedAI(Creature* creature, uint32 scriptId = {});
 
-        void MoveInLineOfSight(Unit*) override { }
+        void MoveInLineOfSight(Unit*) override { IgnoreMoveInLineOfSight(); }
         void AttackStart(Unit* target) override;
         void JustEnteredCombat(Unit* who) override { EngagementStart(who); }
         void JustExitedCombat() override { EngagementOver(); }
@@ -55,7 +55,7 @@ class TC_GAME_API NullCreatureAI : public CreatureAI
     public:
         explicit NullCreatureAI(Creature* creature, uint32 scriptId = {});
 
-        void MoveInLineOfSight(Unit*) override { }
+        void MoveInLineOfSight(Unit*) override { IgnoreMoveInLineOfSight(); }
         void AttackStart(Unit*) override { }
         void JustStartedThreateningMe(Unit*) override { }
         void JustEnteredCombat(Unit*) override { }
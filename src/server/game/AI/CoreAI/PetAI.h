@@ -51,7 +51,7 @@ class TC_GAME_API PetAI : public CreatureAI
         // The following aren't used by the PetAI but need to be defined to override
         // default CreatureAI functions which interfere with the PetAI
 
-        void MoveInLineOfSight(Unit* /*who*/) override { } // CreatureAI interferes with returning pets
+        void MoveInLineOfSight(Unit* /*who*/) override { IgnoreMoveInLineOfSight(); } // CreatureAI interferes with returning pets
         void MoveInLineOfSight_Safe(Unit* /*who*/) { } // CreatureAI interferes with returning pets
         void JustAppeared() override { } // we will control following manually
         void EnterEvadeMode(EvadeReason /*why*/) override { } // For fleeing, pets don't use this type of Evade mechanic
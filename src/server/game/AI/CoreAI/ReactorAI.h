@@ -25,7 +25,7 @@ class TC_GAME_API ReactorAI : public CreatureAI
     public:
         using CreatureAI::CreatureAI;
 
-        void MoveInLineOfSight(Unit*) override { }
+        void MoveInLineOfSight(Unit*) override { IgnoreMoveInLineOfSight(); }
         void UpdateAI(uint32 diff) override;
 
         static int32 Permissible(Creature const* creature);
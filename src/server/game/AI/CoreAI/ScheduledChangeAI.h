@@ -25,7 +25,7 @@ class TC_GAME_API ScheduledChangeAI final : public CreatureAI
     public:
         explicit ScheduledChangeAI(Creature* creature, uint32 scriptId = {});
 
-        void MoveInLineOfSight(Unit*) override { }
+        void MoveInLineOfSight(Unit*) override { IgnoreMoveInLineOfSight(); }
         void AttackStart(Unit*) override { }
         void JustStartedThreateningMe(Unit*) override { }
         void JustEnteredCombat(Unit*) override { }
@@ -83,6 +83,9 @@ class TC_GAME_API CreatureAI : public UnitAI
         // Called if IsVisible(Unit* who) is true at each who move, reaction at visibility zone enter
         void MoveInLineOfSight_Safe(Unit* who);
 
+        // False while MoveInLineOfSight can't do anything, relocations then skip the visibility checks for it
+        virtual bool IsLineOfSightReactive() const { return !_ignoresMoveInLineOfSight; }
+
         // Trigger Creature "Alert" state (creature can see stealthed unit)
         void TriggerAlert(Unit const* who) const;
 
@@ -189,6 +192,7 @@ class TC_GAME_API CreatureAI : public UnitAI
         /// == Gossip system ================================
 
         // Called when the dialog status between a player and the creature is requested.
+        // After quest rewards only givers of affected quests are queried again, call Player::SendQuestGiverStatusMultiple when a scripted status changes otherwise
         virtual Optional<QuestGiverStatus> GetDialogStatus(Player* player);
 
         // Called when a player opens a gossip dialog with the creature.
@@ -240,6 +244,8 @@ class TC_GAME_API CreatureAI : public UnitAI
         void EngagementStart(Unit* who);
         void EngagementOver();
         virtual void MoveInLineOfSight(Unit* /*who*/);
+        // For MoveInLineOfSight implementations that never react to anything
+        void IgnoreMoveInLineOfSight() { _ignoresMoveInLineOfSight = true; }
 
         bool _EnterEvadeMode(EvadeReason why = EvadeReason::Other);
 
@@ -252,6 +258,7 @@ class TC_GAME_API CreatureAI : public UnitAI
         uint32 const _scriptId;
         bool _isEngaged;
         bool _moveInLOSLocked;
+        bool _ignoresMoveInLineOfSight;
 };
 
 #endif
@@ -455,6 +455,17 @@ void SmartAI::MoveInLineOfSight(Unit* who)
     CreatureAI::MoveInLineOfSight(who);
 }
 
+bool SmartAI::IsLineOfSightReactive() const
+{
+    if (_script.HasLineOfSightEvents())
+        return true;
+
+    if (!IsAIControlled())
+        return false;
+
+    return HasEscortState(SMART_ESCORT_ESCORTING) || (!me->IsEngaged() && me->HasReactState(REACT_AGGRESSIVE));
+}
+
 bool SmartAI::AssistPlayerInCombatAgainst(Unit* who)
 {
     if (me->HasReactState(REACT_PASSIVE) || !IsAIControlled())
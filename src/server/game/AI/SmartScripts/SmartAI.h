@@ -112,6 +112,7 @@ class TC_GAME_API SmartAI : public CreatureAI
 
         // Called if IsVisible(Unit* who) is true at each *who move, reaction at visibility zone enter
         void MoveInLineOfSight(Unit* who) override;
+        bool IsLineOfSightReactive() const override;
 
         // Called when hit by a spell
         void SpellHit(WorldObject* caster, SpellInfo const* spellInfo) override;
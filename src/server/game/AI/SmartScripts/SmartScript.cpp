@@ -18,6 +18,7 @@
 #include "SmartScript.h"
 #include "CellImpl.h"
 #include "ChatTextBuilder.h"
+#include "ConditionMgr.h"
 #include "Containers.h"
 #include "Creature.h"
 #include "CreatureTextMgr.h"
@@ -64,8 +65,11 @@ SmartScript::SmartScript()
     isProcessingTimedActionList = false;
     mCurrentPriority = 0;
     mEventSortingRequired = false;
+    mEventIndexRebuildRequired = true;
+    mEventIndexConditionsReloadCounter = 0;
     mNestedEventsCounter = 0;
     mAllEventFlags = 0;
+    mHasLineOfSightEvents = false;
 }
 
 SmartScript::~SmartScript()
@@ -245,15 +249,22 @@ void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint3
     }
     else
     {
-        for (SmartScriptHolder& event : mEvents)
+        if (mEventIndexRebuildRequired || mEventIndexConditionsReloadCounter != sConditionMgr->GetReloadCounter())
+            BuildEventIndex();
+
+        // walk by position, nested calls may rebuild the index
+        std::size_t i = std::distance(mEventIndex.begin(), std::lower_bound(mEventIndex.begin(), mEventIndex.end(), std::make_pair(uint32(e), uint32(0))));
+        for (; i < mEventIndex.size() && mEventIndex[i].first == uint32(e); ++i)
         {
-            SMART_EVENT eventType = SMART_EVENT(event.GetEventType());
-            if (eventType == SMART_EVENT_LINK)//special handling
-                continue;
+            SmartScriptHolder& event = mEvents[mEventIndex[i].second];
+            if (event.conditions)
+            {
+                ConditionSourceInfo sourceInfo(unit, GetBaseObject());
+                if (!sConditionMgr->IsObjectMeetToConditions(sourceInfo, *event.conditions))
+                    continue;
+            }
 
-            if (eventType == e)
-                if (sConditionMgr->IsObjectMeetingSmartEventConditions(event.entryOrGuid, event.event_id, event.source_type, unit, GetBaseObject()))
-                    ProcessEvent(event, unit, var0, var1, bvar, spell, gob, varString);
+            ProcessEvent(event, unit, var0, var1, bvar, spell, gob, varString);
         }
     }
 
@@ -3712,14 +3723,23 @@ bool SmartScript::CheckTimer(SmartScriptHolder const& e) const
     return e.active;
 }
 
+static bool IsLineOfSightEvent(SmartScriptHolder const& e)
+{
+    return e.GetEventType() == SMART_EVENT_OOC_LOS || e.GetEventType() == SMART_EVENT_IC_LOS;
+}
+
 void SmartScript::InstallEvents()
 {
     if (!mInstallEvents.empty())
     {
         for (SmartScriptHolder& installevent : mInstallEvents)
+        {
+            mHasLineOfSightEvents = mHasLineOfSightEvents || IsLineOfSightEvent(installevent);
             mEvents.push_back(installevent);//must be before UpdateTimers
+        }
 
         mInstallEvents.clear();
+        mEventIndexRebuildRequired = true;
     }
 }
 
@@ -3824,6 +3844,7 @@ void SmartScript::OnUpdate(uint32 const diff)
     {
         SortEvents(mEvents);
         mEventSortingRequired = false;
+        mEventIndexRebuildRequired = true;
     }
 
     for (SmartScriptHolder& mEvent : mEvents)
@@ -3888,6 +3909,22 @@ void SmartScript::SortEvents(SmartAIEventList& events)
     std::sort(events.begin(), events.end());
 }
 
+void SmartScript::BuildEventIndex()
+{
+    mEventIndex.clear();
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+    {
+        SmartScriptHolder& event = mEvents[i];
+        event.conditions = sConditionMgr->GetConditionsForSmartEvent(event.entryOrGuid, event.event_id, event.source_type);
+        if (event.GetEventType() != SMART_EVENT_LINK) // linked events are only processed by their parent
+            mEventIndex.emplace_back(event.GetEventType(), i);
+    }
+
+    std::sort(mEventIndex.begin(), mEventIndex.end());
+    mEventIndexRebuildRequired = false;
+    mEventIndexConditionsReloadCounter = sConditionMgr->GetReloadCounter();
+}
+
 void SmartScript::RaisePriority(SmartScriptHolder& e)
 {
     e.timer = 1;
@@ -3962,8 +3999,11 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
             }
         }
         mAllEventFlags |= scriptholder.event.event_flags;
+        mHasLineOfSightEvents = mHasLineOfSightEvents || IsLineOfSightEvent(scriptholder);
         mEvents.push_back(scriptholder);//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+
+    mEventIndexRebuildRequired = true;
 }
 
 void SmartScript::GetScript()
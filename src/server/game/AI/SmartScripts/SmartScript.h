@@ -58,6 +58,7 @@ class TC_GAME_API SmartScript
         WorldObject* GetBaseObject() const;
         WorldObject* GetBaseObjectOrUnitInvoker(Unit* invoker);
         bool HasAnyEventWithFlag(uint32 flag) const { return mAllEventFlags & flag; }
+        bool HasLineOfSightEvents() const { return mHasLineOfSightEvents; }
         static bool IsUnit(WorldObject* obj);
         static bool IsPlayer(WorldObject* obj);
         static bool IsCreature(WorldObject* obj);
@@ -105,6 +106,7 @@ class TC_GAME_API SmartScript
         bool IsInPhase(uint32 p) const;
 
         void SortEvents(SmartAIEventList& events);
+        void BuildEventIndex();
         void RaisePriority(SmartScriptHolder& e);
         void RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll = false);
 
@@ -135,8 +137,12 @@ class TC_GAME_API SmartScript
         bool mUseTextTimer;
         uint32 mCurrentPriority;
         bool mEventSortingRequired;
+        std::vector<std::pair<uint32 /*eventType*/, uint32 /*mEvents position*/>> mEventIndex; // sorted, events of a type keep their mEvents order
+        bool mEventIndexRebuildRequired;
+        uint32 mEventIndexConditionsReloadCounter;
         uint32 mNestedEventsCounter;
         uint32 mAllEventFlags;
+        bool mHasLineOfSightEvents;                         // SMART_EVENT_OOC_LOS or SMART_EVENT_IC_LOS in mEvents
 
         // Max number of nested ProcessEventsFor() calls to avoid infinite loops
         static constexpr uint32 MAX_NESTED_EVENTS = 10;
@@ -28,6 +28,7 @@
 #include <unordered_map>
 
 class WorldObject;
+struct Condition;
 enum SpellEffIndex : uint8;
 typedef uint32 SAIBool;
 
@@ -1620,7 +1621,7 @@ struct SmartScriptHolder
 {
     SmartScriptHolder() : entryOrGuid(0), source_type(SMART_SCRIPT_TYPE_CREATURE)
         , event_id(0), link(0), event(), action(), target(), timer(0), priority(DEFAULT_PRIORITY), active(false), runOnce(false)
-        , enableTimed(false) { }
+        , enableTimed(false), conditions(nullptr) { }
 
     int64 entryOrGuid;
     SmartScriptType source_type;
@@ -1641,6 +1642,7 @@ struct SmartScriptHolder
     bool active;
     bool runOnce;
     bool enableTimed;
+    std::vector<Condition*> const* conditions;  // smart event conditions, only set for events installed by SmartScript
 
     operator bool() const { return entryOrGuid != 0; }
     // Default comparision operator using priority field as first ordering field
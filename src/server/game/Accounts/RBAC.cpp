@@ -230,6 +230,11 @@ void RBACData::CalculateNewPermissions()
     RBACPermissionContainer revoked = GetDeniedPermissions();
     ExpandPermissions(revoked);
     RemovePermissions(_globalPerms, revoked);
+
+    // Dense copy of _globalPerms so HasPermission is a single bit test
+    _globalPermsMask.assign(_globalPerms.empty() ? 0 : *_globalPerms.rbegin() / 64 + 1, 0);
+    for (uint32 permission : _globalPerms)
+        _globalPermsMask[permission / 64] |= UI64LIT(1) << (permission % 64);
 }
 
 void RBACData::AddPermissions(RBACPermissionContainer const& permsFrom, RBACPermissionContainer& permsTo)
@@ -277,6 +282,7 @@ void RBACData::ClearData()
     _grantedPerms.clear();
     _deniedPerms.clear();
     _globalPerms.clear();
+    _globalPermsMask.clear();
 }
 
 }
@@ -45,6 +45,7 @@
 #include <string>
 #include <set>
 #include <map>
+#include <vector>
 
 namespace rbac
 {
@@ -749,6 +750,7 @@ enum RBACPermissions
     RBAC_PERM_COMMAND_RELOAD_VEHICLE_TEMPLATE                = 881,
     RBAC_PERM_COMMAND_RELOAD_SPELL_SCRIPT_NAMES              = 882,
     RBAC_PERM_COMMAND_QUEST_OBJECTIVE_COMPLETE               = 883,
+    RBAC_PERM_COMMAND_RELOAD_HOTFIXES                        = 884,
     //
     // IF YOU ADD NEW PERMISSIONS, ADD THEM IN 3.3.5 BRANCH AS WELL!
     //
@@ -808,7 +810,7 @@ class TC_GAME_API RBACData
     public:
         RBACData(uint32 id, std::string const& name, int32 realmId, uint8 secLevel = 255):
             _id(id), _name(name), _realmId(realmId), _secLevel(secLevel),
-            _grantedPerms(), _deniedPerms(), _globalPerms() { }
+            _grantedPerms(), _deniedPerms(), _globalPerms(), _globalPermsMask() { }
 
         /// Gets the Name of the Object
         std::string const& GetName() const { return _name; }
@@ -833,7 +835,8 @@ class TC_GAME_API RBACData
          */
         bool HasPermission(uint32 permission) const
         {
-            return _globalPerms.find(permission) != _globalPerms.end();
+            std::size_t word = permission / 64;
+            return word < _globalPermsMask.size() && (_globalPermsMask[word] & (UI64LIT(1) << (permission % 64))) != 0;
         }
 
         // Functions enabled to be used by command system
@@ -1011,6 +1014,7 @@ class TC_GAME_API RBACData
         RBACPermissionContainer _grantedPerms;             ///> Granted permissions
         RBACPermissionContainer _deniedPerms;              ///> Denied permissions
         RBACPermissionContainer _globalPerms;              ///> Calculated permissions
+        std::vector<uint64> _globalPermsMask;              ///> Calculated permissions as a bitmask indexed by permission id
 };
 
 }
@@ -21,6 +21,7 @@
 #include "DB2Stores.h"
 #include "CellImpl.h"
 #include "ChatTextBuilder.h"
+#include "ConditionMgr.h"
 #include "Containers.h"
 #include "DatabaseEnv.h"
 #include "GameTime.h"
@@ -128,6 +129,16 @@ bool AchievementMgr::CanUpdateCriteriaTree(Criteria const* criteria, CriteriaTre
     return CriteriaHandler::CanUpdateCriteriaTree(criteria, tree, referencePlayer);
 }
 
+bool AchievementMgr::IsCriteriaExhausted(Criteria const* /*criteria*/, CriteriaTreeList const* trees) const
+{
+    // achievements are never taken away outside of Reset, once every achievement using this criteria is earned it stays dead
+    for (CriteriaTree const* tree : *trees)
+        if (!tree->Achievement || !HasAchieved(tree->Achievement->ID))
+            return false;
+
+    return !trees->empty();
+}
+
 bool AchievementMgr::CanCompleteCriteriaTree(CriteriaTree const* tree)
 {
     AchievementEntry const* achievement = tree->Achievement;
@@ -1112,6 +1123,27 @@ void AchievementGlobalMgr::SetRealmCompleted(AchievementEntry const* achievement
         return;
 
     _allCompletedAchievements[achievement->ID] = GameTime::GetSystemTime();
+
+    // IsRealmCompleted only starts returning true once the grace period is over
+    if (achievement->Flags & ACHIEVEMENT_FLAG_REALM_FIRST_KILL)
+    {
+        std::lock_guard<std::mutex> lock(_pendingRealmFirstKillsLock);
+        _pendingRealmFirstKills.push_back(achievement);
+    }
+    else
+        sConditionMgr->NotifyConditionTypeChanged(CONDITION_REALM_ACHIEVEMENT);
+}
+
+void AchievementGlobalMgr::Update()
+{
+    std::lock_guard<std::mutex> lock(_pendingRealmFirstKillsLock);
+    if (_pendingRealmFirstKills.empty())
+        return;
+
+    std::size_t pending = _pendingRealmFirstKills.size();
+    std::erase_if(_pendingRealmFirstKills, [this](AchievementEntry const* achievement) { return IsRealmCompleted(achievement); });
+    if (_pendingRealmFirstKills.size() != pending)
+        sConditionMgr->NotifyConditionTypeChanged(CONDITION_REALM_ACHIEVEMENT);
 }
 
 //==========================================================
@@ -20,6 +20,7 @@
 
 #include "CriteriaHandler.h"
 #include "DatabaseEnvFwd.h"
+#include <mutex>
 
 class Guild;
 
@@ -61,6 +62,7 @@ public:
 
 protected:
     bool CanUpdateCriteriaTree(Criteria const* criteria, CriteriaTree const* tree, Player* referencePlayer) const override;
+    bool IsCriteriaExhausted(Criteria const* criteria, CriteriaTreeList const* trees) const override;
     bool CanCompleteCriteriaTree(CriteriaTree const* tree) override;
     void CompletedCriteriaTree(CriteriaTree const* tree, Player* referencePlayer) override;
     void AfterCriteriaTreeUpdate(CriteriaTree const* tree, Player* referencePlayer) override;
@@ -166,6 +168,9 @@ public:
     bool IsRealmCompleted(AchievementEntry const* achievement) const;
     void SetRealmCompleted(AchievementEntry const* achievement);
 
+    // notifies realm achievement conditions when realm first kills stop being available to other groups
+    void Update();
+
     void LoadAchievementReferenceList();
     void LoadAchievementScripts();
     void LoadCompletedAchievements();
@@ -183,6 +188,10 @@ private:
     // SystemTimePoint::max() is a value assigned to realm firsts complete before worldserver started
     std::unordered_map<uint32 /*achievementId*/, SystemTimePoint /*completionTime*/> _allCompletedAchievements;
 
+    // realm first kills completed less than a minute ago, SetRealmCompleted is called from map threads
+    std::mutex _pendingRealmFirstKillsLock;
+    std::vector<AchievementEntry const*> _pendingRealmFirstKills;
+
     std::unordered_map<uint32, AchievementReward> _achievementRewards;
     std::unordered_map<uint32, AchievementRewardLocale> _achievementRewardLocales;
     std::unordered_map<uint32, uint32> _achievementScripts;
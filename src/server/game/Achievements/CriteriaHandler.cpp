@@ -454,6 +454,7 @@ void CriteriaHandler::Reset()
         SendCriteriaProgressRemoved(criteriaprogress.first);
 
     _criteriaProgress.clear();
+    _exhaustedCriteria.clear();
 }
 
 /**
@@ -488,9 +489,17 @@ void CriteriaHandler::UpdateCriteria(CriteriaType type, uint64 miscValue1 /*= 0*
     CriteriaList const& criteriaList = GetCriteriaByType(type, uint32(miscValue1));
     for (Criteria const* criteria : criteriaList)
     {
+        if (_exhaustedCriteria.contains(criteria->ID))
+            continue;
+
         CriteriaTreeList const* trees = sCriteriaMgr->GetCriteriaTreesByCriteria(criteria->ID);
         if (!CanUpdateCriteria(criteria, trees, miscValue1, miscValue2, miscValue3, ref, referencePlayer))
+        {
+            // only checked on failure, criteria that are still updated never pay for it
+            if (IsCriteriaExhausted(criteria, trees))
+                _exhaustedCriteria.insert(criteria->ID);
             continue;
+        }
 
         // requirements not found in the dbc
         if (CriteriaDataSet const* data = sCriteriaMgr->GetCriteriaDataSet(criteria))
@@ -4413,6 +4422,14 @@ inline bool IsCriteriaTypeStoredByAsset(CriteriaType type)
         case CriteriaType::GetLootByType:
         case CriteriaType::LandTargetedSpellOnTarget:
         case CriteriaType::LearnTradeskillSkillLine:
+        case CriteriaType::EnterTopLevelArea:
+        case CriteriaType::CurrencyGained:
+        case CriteriaType::WinArena:
+        case CriteriaType::PlaceGarrisonBuilding:
+        case CriteriaType::ActivateGarrisonBuilding:
+        case CriteriaType::RecruitGarrisonFollower:
+        case CriteriaType::CollectTransmogSetFromGroup:
+        case CriteriaType::ActivelyReachLevel:
             return true;
         default:
             break;
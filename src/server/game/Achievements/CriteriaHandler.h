@@ -21,6 +21,7 @@
 #include "Common.h"
 #include "DBCEnums.h"
 #include "Duration.h"
+#include "FlatHashSet.h"
 #include "ObjectGuid.h"
 #include <map>
 #include <unordered_map>
@@ -299,6 +300,8 @@ protected:
 
     bool IsCompletedCriteria(Criteria const* criteria, uint64 requiredAmount);
     bool CanUpdateCriteria(Criteria const* criteria, CriteriaTreeList const* trees, uint64 miscValue1, uint64 miscValue2, uint64 miscValue3, WorldObject const* ref, Player* referencePlayer);
+    // criteria that can never progress again for this owner, skipped by UpdateCriteria without evaluating any requirement
+    virtual bool IsCriteriaExhausted(Criteria const* /*criteria*/, CriteriaTreeList const* /*trees*/) const { return false; }
 
     virtual void SendPacket(WorldPacket const* data) const = 0;
 
@@ -313,6 +316,7 @@ protected:
 
     CriteriaProgressMap _criteriaProgress;
     std::map<uint32, uint32 /*ms time left*/> _timeCriteriaTrees;
+    Trinity::Containers::FlatHashSet<uint32> _exhaustedCriteria;
 };
 
 class TC_GAME_API CriteriaMgr
@@ -31,11 +31,13 @@
 #include "Language.h"
 #include "Log.h"
 #include "Mail.h"
+#include "MemoryStats.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Player.h"
 #include "Realm.h"
 #include "ScriptMgr.h"
+#include "ThreadPool.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -458,6 +460,16 @@ Item* AuctionHouseMgr::GetAItem(ObjectGuid itemGuid)
     return Trinity::Containers::MapGetValuePtr(_itemsByGuid, itemGuid);
 }
 
+std::size_t AuctionHouseMgr::GetMemoryUsage() const
+{
+    return mHordeAuctions.GetMemoryUsage()
+        + mAllianceAuctions.GetMemoryUsage()
+        + mNeutralAuctions.GetMemoryUsage()
+        + mGoblinAuctions.GetMemoryUsage()
+        + Trinity::MemoryStats::EstimateContainerMemory(_itemsByGuid)
+        + _itemsByGuid.size() * sizeof(Item);
+}
+
 uint64 AuctionHouseMgr::GetCommodityAuctionDeposit(ItemTemplate const* item, Minutes time, uint32 quantity)
 {
     uint32 sellPrice = item->GetSellPrice();
@@ -524,6 +536,9 @@ void AuctionHouseMgr::LoadAuctions()
 {
     uint32 oldMSTime = getMSTime();
 
+    if (!_browsePool && sWorld->getIntConfig(CONFIG_AUCTION_BROWSE_THREADS))
+        _browsePool = std::make_unique<Trinity::ThreadPool>(sWorld->getIntConfig(CONFIG_AUCTION_BROWSE_THREADS));
+
     // need to clear in case we are reloading
     if (!_itemsByGuid.empty())
     {
@@ -870,7 +885,8 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTem
     return sAuctionHouseStore.LookupEntry(houseid);
 }
 
-AuctionHouseObject::AuctionHouseObject(uint32 auctionHouseId) : _auctionHouse(sAuctionHouseStore.AssertEntry(auctionHouseId))
+AuctionHouseObject::AuctionHouseObject(uint32 auctionHouseId) : _auctionHouse(sAuctionHouseStore.AssertEntry(auctionHouseId)),
+    _browseSnapshotDirty(false), _nextBrowseSnapshotUpdate(TimePoint::min())
 {
 }
 
@@ -881,6 +897,19 @@ uint32 AuctionHouseObject::GetAuctionHouseId() const
     return _auctionHouse->ID;
 }
 
+std::size_t AuctionHouseObject::GetMemoryUsage() const
+{
+    using Trinity::MemoryStats::EstimateContainerMemory;
+
+    return EstimateContainerMemory(_itemsByAuctionId)
+        + EstimateContainerMemory(_soldItemsById)
+        + EstimateContainerMemory(_buckets)
+        + EstimateContainerMemory(_commodityQuotes)
+        + EstimateContainerMemory(_playerOwnedAuctions)
+        + EstimateContainerMemory(_playerBidderAuctions)
+        + EstimateContainerMemory(_replicateThrottleMap);
+}
+
 AuctionPosting* AuctionHouseObject::GetAuction(uint32 auctionId)
 {
     return Trinity::Containers::MapGetValuePtr(_itemsByAuctionId, auctionId);
@@ -941,10 +970,14 @@ void AuctionHouseObject::AddAuction(CharacterDatabaseTransaction trans, AuctionP
 
             bucket->FullName[locale] = wstrCaseAccentInsensitiveParse(utf16name, locale);
         }
+
+        AddBucketToIndexes(bucket);
     }
     else
         bucket = &bucketItr->second;
 
+    InvalidateBrowseSnapshot(bucket);
+
     // update cache fields
     uint64 priceToDisplay = auction.BuyoutOrUnitPrice ? auction.BuyoutOrUnitPrice : auction.BidAmount;
     if (!bucket->MinPrice || priceToDisplay < bucket->MinPrice)
@@ -1036,6 +1069,7 @@ void AuctionHouseObject::AddAuction(CharacterDatabaseTransaction trans, AuctionP
 void AuctionHouseObject::RemoveAuction(CharacterDatabaseTransaction trans, AuctionPosting* auction, std::map<uint32, AuctionPosting>::iterator* auctionItr /*= nullptr*/)
 {
     AuctionsBucketData* bucket = auction->Bucket;
+    InvalidateBrowseSnapshot(bucket);
 
     bucket->Auctions.erase(std::remove(bucket->Auctions.begin(), bucket->Auctions.end(), auction), bucket->Auctions.end());
     if (!bucket->Auctions.empty())
@@ -1092,7 +1126,10 @@ void AuctionHouseObject::RemoveAuction(CharacterDatabaseTransaction trans, Aucti
             bucket->QualityMask &= static_cast<AuctionHouseFilterMask>(~(1 << (quality + 4)));
     }
     else
+    {
+        RemoveBucketFromIndexes(bucket);
         _buckets.erase(bucket->Key);
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_AUCTION);
     stmt->setUInt32(0, auction->Id);
@@ -1117,6 +1154,9 @@ void AuctionHouseObject::Update()
 {
     SystemTimePoint curTime = GameTime::GetSystemTime();
     TimePoint curTimeSteady = GameTime::Now();
+
+    if (_browseSnapshot && _browseSnapshotDirty && curTimeSteady >= _nextBrowseSnapshotUpdate)
+        UpdateBrowseSnapshot();
     ///- Handle expired auctions
 
     // Clear expired throttled players
@@ -1176,6 +1216,132 @@ void AuctionHouseObject::Update()
     CharacterDatabase.CommitTransaction(trans);
 }
 
+namespace
+{
+constexpr std::size_t NameTrigramLength = 3;
+
+// Filters that only depend on bucket data, safe to run on a browse snapshot outside of the world thread
+bool MatchesBrowseFilters(AuctionsBucketData const* bucketData, std::wstring const& name, LocaleConstant locale, uint8 minLevel, uint8 maxLevel,
+    EnumFlag<AuctionHouseFilterMask> filters, Optional<AuctionSearchClassFilters> const& classFilters)
+{
+    if (!name.empty())
+    {
+        if (filters.HasFlag(AuctionHouseFilterMask::ExactMatch))
+        {
+            if (bucketData->FullName[locale] != name)
+                return false;
+        }
+        else
+            if (bucketData->FullName[locale].find(name) == std::wstring::npos)
+                return false;
+    }
+
+    if (minLevel && bucketData->RequiredLevel < minLevel)
+        return false;
+
+    if (maxLevel && bucketData->RequiredLevel > maxLevel)
+        return false;
+
+    if (!filters.HasFlag(bucketData->QualityMask))
+        return false;
+
+    if (classFilters)
+    {
+        // if we dont want any class filters, Optional is not initialized
+        // if we dont want this class included, SubclassMask is set to FILTER_SKIP_CLASS
+        // if we want this class and did not specify and subclasses, its set to FILTER_SKIP_SUBCLASS
+        // otherwise full restrictions apply
+        if (classFilters->Classes[bucketData->ItemClass].SubclassMask == AuctionSearchClassFilters::FILTER_SKIP_CLASS)
+            return false;
+
+        if (classFilters->Classes[bucketData->ItemClass].SubclassMask != AuctionSearchClassFilters::FILTER_SKIP_SUBCLASS)
+        {
+            if (!(classFilters->Classes[bucketData->ItemClass].SubclassMask & (1 << bucketData->ItemSubClass)))
+                return false;
+
+            if (!(classFilters->Classes[bucketData->ItemClass].InvTypes[bucketData->ItemSubClass] & (UI64LIT(1) << bucketData->InventoryType)))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename Callback>
+void ForEachNameTrigram(std::wstring const& name, Callback&& callback)
+{
+    // 21 bits are enough for any unicode code point
+    for (std::size_t i = 0; i + NameTrigramLength <= name.length(); ++i)
+        callback(uint64(name[i] & 0x1FFFFF) << 42 | uint64(name[i + 1] & 0x1FFFFF) << 21 | uint64(name[i + 2] & 0x1FFFFF));
+}
+}
+
+void AuctionHouseObject::AddBucketToIndexes(AuctionsBucketData const* bucket)
+{
+    if (bucket->ItemClass < MAX_ITEM_CLASS && bucket->ItemSubClass < MAX_ITEM_SUBCLASS_TOTAL)
+        _bucketsByClass[bucket->ItemClass][bucket->ItemSubClass].insert(bucket);
+
+    for (std::size_t locale = 0; locale < TOTAL_LOCALES; ++locale)
+        if (_bucketsByNameTrigram[locale])
+            ForEachNameTrigram(bucket->FullName[locale], [&](uint64 trigram) { (*_bucketsByNameTrigram[locale])[trigram].insert(bucket); });
+}
+
+void AuctionHouseObject::RemoveBucketFromIndexes(AuctionsBucketData const* bucket)
+{
+    if (bucket->ItemClass < MAX_ITEM_CLASS && bucket->ItemSubClass < MAX_ITEM_SUBCLASS_TOTAL)
+        _bucketsByClass[bucket->ItemClass][bucket->ItemSubClass].erase(bucket);
+
+    for (std::size_t locale = 0; locale < TOTAL_LOCALES; ++locale)
+    {
+        if (!_bucketsByNameTrigram[locale])
+            continue;
+
+        NameTrigramIndex& index = *_bucketsByNameTrigram[locale];
+        ForEachNameTrigram(bucket->FullName[locale], [&](uint64 trigram)
+        {
+            auto itr = index.find(trigram);
+            if (itr == index.end())
+                return;
+
+            itr->second.erase(bucket);
+            if (itr->second.empty())
+                index.erase(itr);
+        });
+    }
+}
+
+// Returns all buckets sharing the rarest trigram of name, nullptr when name is too short to use the index
+AuctionHouseObject::BucketSet const* AuctionHouseObject::FindBucketsByName(std::wstring const& name, LocaleConstant locale)
+{
+    static BucketSet const NoBuckets;
+
+    if (name.length() < NameTrigramLength || locale >= TOTAL_LOCALES)
+        return nullptr;
+
+    if (!_bucketsByNameTrigram[locale])
+    {
+        NameTrigramIndex& index = _bucketsByNameTrigram[locale].emplace();
+        for (std::pair<AuctionsBucketKey const, AuctionsBucketData> const& bucket : _buckets)
+            ForEachNameTrigram(bucket.second.FullName[locale], [&](uint64 trigram) { index[trigram].insert(&bucket.second); });
+    }
+
+    NameTrigramIndex const& index = *_bucketsByNameTrigram[locale];
+    BucketSet const* rarest = nullptr;
+    ForEachNameTrigram(name, [&](uint64 trigram)
+    {
+        if (rarest == &NoBuckets)
+            return;
+
+        auto itr = index.find(trigram);
+        if (itr == index.end())
+            rarest = &NoBuckets;
+        else if (!rarest || itr->second.size() < rarest->size())
+            rarest = &itr->second;
+    });
+
+    return rarest;
+}
+
 void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionListBucketsResult& listBucketsResult, Player* player,
     std::wstring const& name, uint8 minLevel, uint8 maxLevel, EnumFlag<AuctionHouseFilterMask> filters, Optional<AuctionSearchClassFilters> const& classFilters,
     uint8 const* knownPetBits, std::size_t knownPetBitsCount, uint8 maxKnownPetLevel, uint32 offset, WorldPackets::AuctionHouse::AuctionSortDef const* sorts, std::size_t sortCount)
@@ -1191,50 +1357,13 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
             knownPetSpecies.resize(sBattlePetSpeciesStore.GetNumRows());
     }
 
-    AuctionsResultBuilder<AuctionsBucketData> builder(offset, player->GetSession()->GetSessionDbcLocale(), sorts, sortCount, AuctionHouseResultLimits::Browse);
+    LocaleConstant locale = player->GetSession()->GetSessionDbcLocale();
+    AuctionsResultBuilder<AuctionsBucketData> builder(offset, locale, sorts, sortCount, AuctionHouseResultLimits::Browse);
 
-    for (std::pair<AuctionsBucketKey const, AuctionsBucketData> const& bucket : _buckets)
+    auto addIfMatches = [&](AuctionsBucketData const* bucketData)
     {
-        AuctionsBucketData const* bucketData = &bucket.second;
-        if (!name.empty())
-        {
-            if (filters.HasFlag(AuctionHouseFilterMask::ExactMatch))
-            {
-                if (bucketData->FullName[player->GetSession()->GetSessionDbcLocale()] != name)
-                    continue;
-            }
-            else
-                if (bucketData->FullName[player->GetSession()->GetSessionDbcLocale()].find(name) == std::wstring::npos)
-                    continue;
-        }
-
-        if (minLevel && bucketData->RequiredLevel < minLevel)
-            continue;
-
-        if (maxLevel && bucketData->RequiredLevel > maxLevel)
-            continue;
-
-        if (!filters.HasFlag(bucketData->QualityMask))
-            continue;
-
-        if (classFilters)
-        {
-            // if we dont want any class filters, Optional is not initialized
-            // if we dont want this class included, SubclassMask is set to FILTER_SKIP_CLASS
-            // if we want this class and did not specify and subclasses, its set to FILTER_SKIP_SUBCLASS
-            // otherwise full restrictions apply
-            if (classFilters->Classes[bucketData->ItemClass].SubclassMask == AuctionSearchClassFilters::FILTER_SKIP_CLASS)
-                continue;
-
-            if (classFilters->Classes[bucketData->ItemClass].SubclassMask != AuctionSearchClassFilters::FILTER_SKIP_SUBCLASS)
-            {
-                if (!(classFilters->Classes[bucketData->ItemClass].SubclassMask & (1 << bucketData->ItemSubClass)))
-                    continue;
-
-                if (!(classFilters->Classes[bucketData->ItemClass].InvTypes[bucketData->ItemSubClass] & (UI64LIT(1) << bucketData->InventoryType)))
-                    continue;
-            }
-        }
+        if (!MatchesBrowseFilters(bucketData, name, locale, minLevel, maxLevel, filters, classFilters))
+            return;
 
         if (filters.HasFlag(AuctionHouseFilterMask::UncollectedOnly))
         {
@@ -1255,34 +1384,34 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
                 }
 
                 if (hasAll)
-                    continue;
+                    return;
             }
             // caged pets
-            else if (bucket.first.BattlePetSpeciesId)
+            else if (bucketData->Key.BattlePetSpeciesId)
             {
-                if (knownPetSpecies.test(bucket.first.BattlePetSpeciesId))
-                    continue;
+                if (knownPetSpecies.test(bucketData->Key.BattlePetSpeciesId))
+                    return;
             }
             // toys
-            else if (sDB2Manager.IsToyItem(bucket.first.ItemId))
+            else if (sDB2Manager.IsToyItem(bucketData->Key.ItemId))
             {
-                if (player->GetSession()->GetCollectionMgr()->HasToy(bucket.first.ItemId))
-                    continue;
+                if (player->GetSession()->GetCollectionMgr()->HasToy(bucketData->Key.ItemId))
+                    return;
             }
             // mounts
             // recipes
             // pet items
             else if (bucketData->ItemClass == ITEM_CLASS_CONSUMABLE || bucketData->ItemClass == ITEM_CLASS_RECIPE || bucketData->ItemClass == ITEM_CLASS_MISCELLANEOUS)
             {
-                ItemTemplate const* itemTemplate = ASSERT_NOTNULL(sObjectMgr->GetItemTemplate(bucket.first.ItemId));
+                ItemTemplate const* itemTemplate = ASSERT_NOTNULL(sObjectMgr->GetItemTemplate(bucketData->Key.ItemId));
                 if (itemTemplate->Effects.size() >= 2 && (itemTemplate->Effects[0]->SpellID == 483 || itemTemplate->Effects[0]->SpellID == 55884))
                 {
                     if (player->HasSpell(itemTemplate->Effects[1]->SpellID))
-                        continue;
+                        return;
 
                     if (BattlePetSpeciesEntry const* battlePetSpecies = BattlePets::BattlePetMgr::GetBattlePetSpeciesBySpell(itemTemplate->Effects[1]->SpellID))
                         if (knownPetSpecies.test(battlePetSpecies->ID))
-                            continue;
+                            return;
                 }
             }
         }
@@ -1290,14 +1419,14 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
         if (filters.HasFlag(AuctionHouseFilterMask::UsableOnly))
         {
             if (bucketData->RequiredLevel && player->GetLevel() < bucketData->RequiredLevel)
-                continue;
+                return;
 
-            if (player->CanUseItem(sObjectMgr->GetItemTemplate(bucket.first.ItemId), true) != EQUIP_ERR_OK)
-                continue;
+            if (player->CanUseItem(sObjectMgr->GetItemTemplate(bucketData->Key.ItemId), true) != EQUIP_ERR_OK)
+                return;
 
             // cannot learn caged pets whose level exceeds highest level of currently owned pet
             if (bucketData->MinBattlePetLevel && bucketData->MinBattlePetLevel > maxKnownPetLevel)
-                continue;
+                return;
         }
 
         // TODO: this one needs to access loot history to know highest item level for every inventory type
@@ -1306,6 +1435,63 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
         //}
 
         builder.AddItem(bucketData);
+    };
+
+    // pick candidates from the most selective index, every candidate still goes through all filters
+    std::vector<AuctionsBucketData const*> candidates;
+    bool hasCandidates = false;
+    if (BucketSet const* nameBuckets = FindBucketsByName(name, locale))
+    {
+        candidates.assign(nameBuckets->begin(), nameBuckets->end());
+        hasCandidates = true;
+    }
+
+    if (classFilters)
+    {
+        std::vector<BucketSet const*> classBuckets;
+        std::size_t classBucketCount = 0;
+        for (uint32 itemClass = 0; itemClass < MAX_ITEM_CLASS; ++itemClass)
+        {
+            uint32 subclassMask = classFilters->Classes[itemClass].SubclassMask;
+            if (subclassMask == AuctionSearchClassFilters::FILTER_SKIP_CLASS)
+                continue;
+
+            for (uint32 itemSubClass = 0; itemSubClass < MAX_ITEM_SUBCLASS_TOTAL; ++itemSubClass)
+            {
+                if (subclassMask != AuctionSearchClassFilters::FILTER_SKIP_SUBCLASS && !(subclassMask & (1 << itemSubClass)))
+                    continue;
+
+                classBuckets.push_back(&_bucketsByClass[itemClass][itemSubClass]);
+                classBucketCount += classBuckets.back()->size();
+            }
+        }
+
+        if (!hasCandidates || classBucketCount < candidates.size())
+        {
+            candidates.clear();
+            candidates.reserve(classBucketCount);
+            for (BucketSet const* buckets : classBuckets)
+                candidates.insert(candidates.end(), buckets->begin(), buckets->end());
+
+            hasCandidates = true;
+        }
+    }
+
+    if (hasCandidates)
+    {
+        // keep the order of a full scan, AddItem places buckets that sort equal in the order they are added
+        std::sort(candidates.begin(), candidates.end(), [](AuctionsBucketData const* left, AuctionsBucketData const* right)
+        {
+            return left->Key < right->Key;
+        });
+
+        for (AuctionsBucketData const* bucketData : candidates)
+            addIfMatches(bucketData);
+    }
+    else
+    {
+        for (std::pair<AuctionsBucketKey const, AuctionsBucketData> const& bucket : _buckets)
+            addIfMatches(&bucket.second);
     }
 
     for (AuctionsBucketData const* resultBucket : builder.GetResultRange())
@@ -1345,6 +1531,103 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
 
 }
 
+void AuctionHouseObject::InvalidateBrowseSnapshot(AuctionsBucketData const* bucket)
+{
+    if (!_browseSnapshot)
+        return;
+
+    _browseBucketCopies.erase(bucket);
+    _browseSnapshotDirty = true;
+}
+
+void AuctionHouseObject::UpdateBrowseSnapshot()
+{
+    std::shared_ptr<BrowseSnapshot> snapshot = std::make_shared<BrowseSnapshot>();
+    snapshot->reserve(_buckets.size());
+
+    std::unordered_map<AuctionsBucketData const*, std::shared_ptr<AuctionsBucketData const>> bucketCopies;
+    bucketCopies.reserve(_buckets.size());
+    for (std::pair<AuctionsBucketKey const, AuctionsBucketData> const& bucket : _buckets)
+    {
+        std::shared_ptr<AuctionsBucketData const> bucketCopy;
+        auto itr = _browseBucketCopies.find(&bucket.second);
+        if (itr != _browseBucketCopies.end())
+            bucketCopy = itr->second;
+        else
+        {
+            // postings are only needed on the world thread when building the response
+            std::shared_ptr<AuctionsBucketData> newCopy = std::make_shared<AuctionsBucketData>(bucket.second);
+            newCopy->Auctions.clear();
+            newCopy->Auctions.shrink_to_fit();
+            bucketCopy = std::move(newCopy);
+        }
+
+        snapshot->push_back(bucketCopy);
+        bucketCopies[&bucket.second] = std::move(bucketCopy);
+    }
+
+    _browseSnapshot = std::move(snapshot);
+    _browseBucketCopies = std::move(bucketCopies);
+    _browseSnapshotDirty = false;
+    _nextBrowseSnapshotUpdate = GameTime::Now() + Milliseconds(sWorld->getIntConfig(CONFIG_AUCTION_BROWSE_SNAPSHOT_INTERVAL));
+}
+
+AuctionBrowseCallback AuctionHouseObject::BuildListBucketsAsync(Trinity::ThreadPool& pool, std::wstring const& name, uint8 minLevel, uint8 maxLevel, EnumFlag<AuctionHouseFilterMask> filters,
+    Optional<AuctionSearchClassFilters> const& classFilters, LocaleConstant locale, uint32 offset, WorldPackets::AuctionHouse::AuctionSortDef const* sorts, std::size_t sortCount)
+{
+    if (!_browseSnapshot)
+        UpdateBrowseSnapshot();
+
+    std::shared_ptr<std::promise<AuctionBrowseResult>> promise = std::make_shared<std::promise<AuctionBrowseResult>>();
+    AuctionBrowseCallback callback(promise->get_future());
+
+    // everything the query needs is copied, the packet and this object may change before it runs
+    pool.PostWork([promise, snapshot = _browseSnapshot, name, minLevel, maxLevel, filters, classFilters, locale, offset,
+        sorts = std::vector<WorldPackets::AuctionHouse::AuctionSortDef>(sorts, sorts + sortCount)]()
+    {
+        AuctionsResultBuilder<AuctionsBucketData> builder(offset, locale, sorts.data(), sorts.size(), AuctionHouseResultLimits::Browse);
+        for (std::shared_ptr<AuctionsBucketData const> const& bucket : *snapshot)
+            if (MatchesBrowseFilters(bucket.get(), name, locale, minLevel, maxLevel, filters, classFilters))
+                builder.AddItem(bucket.get());
+
+        AuctionBrowseResult result;
+        for (AuctionsBucketData const* resultBucket : builder.GetResultRange())
+            result.Buckets.push_back(resultBucket->Key);
+
+        result.HasMoreResults = builder.HasMoreResults();
+        promise->set_value(std::move(result));
+    });
+
+    return callback;
+}
+
+void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionListBucketsResult& listBucketsResult, Player* player, AuctionBrowseResult const& browseResult)
+{
+    for (AuctionsBucketKey const& key : browseResult.Buckets)
+    {
+        AuctionsBucketData const* bucket = Trinity::Containers::MapGetValuePtr(_buckets, key);
+        if (!bucket)
+            continue;
+
+        listBucketsResult.Buckets.emplace_back();
+        WorldPackets::AuctionHouse::BucketInfo& bucketInfo = listBucketsResult.Buckets.back();
+        bucket->BuildBucketInfo(&bucketInfo, player);
+    }
+
+    listBucketsResult.HasMoreResults = browseResult.HasMoreResults;
+}
+
+bool AuctionBrowseCallback::InvokeIfReady()
+{
+    if (m_future.valid() && m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        m_callback(m_future.get());
+        return true;
+    }
+
+    return false;
+}
+
 void AuctionHouseObject::BuildListBiddedItems(WorldPackets::AuctionHouse::AuctionListBiddedItemsResult& listBiddedItemsResult, Player* player,
     uint32 /*offset*/, WorldPackets::AuctionHouse::AuctionSortDef const* sorts, std::size_t sortCount) const
 {
@@ -25,13 +25,23 @@
 #include "ItemTemplate.h"
 #include "ObjectGuid.h"
 #include "Optional.h"
+#include <array>
+#include <functional>
+#include <future>
 #include <map>
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 class Item;
 class Player;
 class WorldPacket;
 
+namespace Trinity
+{
+    class ThreadPool;
+}
+
 namespace WorldPackets
 {
     namespace AuctionHouse
@@ -223,6 +233,32 @@ struct AuctionsBucketData
     class Sorter;
 };
 
+// Page of buckets found by a browse query running outside of the world thread
+struct AuctionBrowseResult
+{
+    std::vector<AuctionsBucketKey> Buckets;
+    bool HasMoreResults = false;
+};
+
+class TC_GAME_API AuctionBrowseCallback
+{
+public:
+    AuctionBrowseCallback(std::future<AuctionBrowseResult>&& future) : m_future(std::move(future)) { }
+    AuctionBrowseCallback(AuctionBrowseCallback&&) = default;
+
+    AuctionBrowseCallback& operator=(AuctionBrowseCallback&&) = default;
+
+    void AfterComplete(std::function<void(AuctionBrowseResult&&)> callback) &
+    {
+        m_callback = std::move(callback);
+    }
+
+    bool InvokeIfReady();
+
+    std::future<AuctionBrowseResult> m_future;
+    std::function<void(AuctionBrowseResult&&)> m_callback;
+};
+
 enum class AuctionPostingServerFlag : uint8
 {
     None        = 0x0,
@@ -292,6 +328,7 @@ public:
     };
 
     uint32 GetAuctionHouseId() const;
+    std::size_t GetMemoryUsage() const;
 
     std::map<uint32, AuctionPosting>::iterator GetAuctionsBegin() { return _itemsByAuctionId.begin(); }
     std::map<uint32, AuctionPosting>::iterator GetAuctionsEnd() { return _itemsByAuctionId.end(); }
@@ -311,6 +348,11 @@ public:
     void BuildListBuckets(WorldPackets::AuctionHouse::AuctionListBucketsResult& listBucketsResult, Player* player,
         WorldPackets::AuctionHouse::AuctionBucketKey const* keys, std::size_t keysCount,
         WorldPackets::AuctionHouse::AuctionSortDef const* sorts, std::size_t sortCount);
+    // Runs a browse query on a periodically refreshed copy of the buckets in pool, player dependent filters (usable, uncollected) are not supported
+    AuctionBrowseCallback BuildListBucketsAsync(Trinity::ThreadPool& pool, std::wstring const& name, uint8 minLevel, uint8 maxLevel, EnumFlag<AuctionHouseFilterMask> filters,
+        Optional<AuctionSearchClassFilters> const& classFilters, LocaleConstant locale, uint32 offset, WorldPackets::AuctionHouse::AuctionSortDef const* sorts, std::size_t sortCount);
+    // Completes the result of BuildListBucketsAsync with current bucket data, buckets that were removed in the meantime are skipped
+    void BuildListBuckets(WorldPackets::AuctionHouse::AuctionListBucketsResult& listBucketsResult, Player* player, AuctionBrowseResult const& browseResult);
     void BuildListBiddedItems(WorldPackets::AuctionHouse::AuctionListBiddedItemsResult& listBiddedItemsResult, Player* player,
         uint32 offset, WorldPackets::AuctionHouse::AuctionSortDef const* sorts, std::size_t sortCount) const;
     void BuildListAuctionItems(WorldPackets::AuctionHouse::AuctionListItemsResult& listItemsResult, Player* player, AuctionsBucketKey const& bucketKey,
@@ -337,11 +379,31 @@ public:
     void SendAuctionInvoice(AuctionPosting const* auction, Player* owner, CharacterDatabaseTransaction trans);
 
 private:
+    using BucketSet = std::unordered_set<AuctionsBucketData const*>;
+    using NameTrigramIndex = std::unordered_map<uint64, BucketSet>;
+    using BrowseSnapshot = std::vector<std::shared_ptr<AuctionsBucketData const>>;
+
+    void AddBucketToIndexes(AuctionsBucketData const* bucket);
+    void RemoveBucketFromIndexes(AuctionsBucketData const* bucket);
+    BucketSet const* FindBucketsByName(std::wstring const& name, LocaleConstant locale);
+
+    void InvalidateBrowseSnapshot(AuctionsBucketData const* bucket);
+    void UpdateBrowseSnapshot();
+
     AuctionHouseEntry const* _auctionHouse;
 
     std::map<uint32, AuctionPosting> _itemsByAuctionId; // ordered for replicate
     std::unordered_map<uint32, AuctionPosting> _soldItemsById;
     std::map<AuctionsBucketKey, AuctionsBucketData> _buckets; // ordered for search by itemid only
+    std::array<std::array<BucketSet, MAX_ITEM_SUBCLASS_TOTAL>, MAX_ITEM_CLASS> _bucketsByClass;
+    std::array<Optional<NameTrigramIndex>, TOTAL_LOCALES> _bucketsByNameTrigram; // built on first search in each locale
+
+    // copy on write: unchanged buckets share their copy with the previous snapshot, created on first BuildListBucketsAsync
+    std::shared_ptr<BrowseSnapshot const> _browseSnapshot;
+    std::unordered_map<AuctionsBucketData const*, std::shared_ptr<AuctionsBucketData const>> _browseBucketCopies;
+    bool _browseSnapshotDirty;
+    TimePoint _nextBrowseSnapshotUpdate;
+
     std::unordered_map<ObjectGuid, CommodityQuote> _commodityQuotes;
 
     std::unordered_multimap<ObjectGuid, uint32> _playerOwnedAuctions;
@@ -366,6 +428,9 @@ class TC_GAME_API AuctionHouseMgr
 
         Item* GetAItem(ObjectGuid itemGuid);
 
+        // shallow estimate of auctions, buckets and auctioned items of all houses
+        std::size_t GetMemoryUsage() const;
+
         static std::string BuildItemAuctionMailSubject(AuctionMailType type, AuctionPosting const* auction);
         static std::string BuildCommodityAuctionMailSubject(AuctionMailType type, uint32 itemId, uint32 itemCount);
         static std::string BuildAuctionMailSubject(uint32 itemId, AuctionMailType type, uint32 auctionId, uint32 itemCount, uint32 battlePetSpeciesId,
@@ -382,6 +447,9 @@ class TC_GAME_API AuctionHouseMgr
 
         void LoadAuctions();
 
+        // nullptr when browse queries run on the world thread
+        Trinity::ThreadPool* GetBrowsePool() const { return _browsePool.get(); }
+
         void AddAItem(Item* item);
         bool RemoveAItem(ObjectGuid itemGuid, bool deleteItem = false, CharacterDatabaseTransaction* trans = nullptr);
         bool PendingAuctionAdd(Player* player, uint32 auctionHouseId, uint32 auctionId, uint64 deposit);
@@ -428,6 +496,8 @@ class TC_GAME_API AuctionHouseMgr
 
         std::unordered_map<ObjectGuid, PlayerThrottleObject> _playerThrottleObjects;
         TimePoint _playerThrottleObjectsCleanupTime;
+
+        std::unique_ptr<Trinity::ThreadPool> _browsePool;
 };
 
 #define sAuctionMgr AuctionHouseMgr::instance()
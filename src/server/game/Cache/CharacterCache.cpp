@@ -18,17 +18,78 @@
 #include "CharacterCache.h"
 #include "ArenaTeam.h"
 #include "DatabaseEnv.h"
+#include "Hash.h"
 #include "Log.h"
 #include "MiscPackets.h"
 #include "Player.h"
 #include "Timer.h"
+#include "Util.h"
 #include "World.h"
 #include <unordered_map>
+#include <utf8.h>
 
 namespace
 {
+    // Case folds a name one code point at a time, straight from its UTF-8 bytes
+    // Invalid UTF-8 is not folded, it never matches a cached name anyway
+    class CharacterNameFolder
+    {
+    public:
+        explicit CharacterNameFolder(std::string_view name) : _itr(name.data()), _end(name.data() + name.size()),
+            _valid(utf8::find_invalid(_itr, _end) == _end) { }
+
+        bool IsValid() const { return _valid; }
+        bool HasNext() const { return _itr != _end; }
+
+        uint32 Next()
+        {
+            if (!_valid)
+                return uint8(*_itr++);
+
+            return wcharToLower(wchar_t(utf8::unchecked::next(_itr)));
+        }
+
+    private:
+        char const* _itr;
+        char const* _end;
+        bool _valid;
+    };
+
+    struct CharacterNameHash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view name) const
+        {
+            std::size_t hashVal = 0;
+            for (CharacterNameFolder folder(name); folder.HasNext();)
+                Trinity::hash_combine(hashVal, folder.Next());
+
+            return hashVal;
+        }
+    };
+
+    struct CharacterNameEqual
+    {
+        using is_transparent = void;
+
+        bool operator()(std::string_view left, std::string_view right) const
+        {
+            CharacterNameFolder leftFolder(left);
+            CharacterNameFolder rightFolder(right);
+            if (leftFolder.IsValid() != rightFolder.IsValid())
+                return false;
+
+            while (leftFolder.HasNext() && rightFolder.HasNext())
+                if (leftFolder.Next() != rightFolder.Next())
+                    return false;
+
+            return !leftFolder.HasNext() && !rightFolder.HasNext();
+        }
+    };
+
     std::unordered_map<ObjectGuid, CharacterCacheEntry> _characterCacheStore;
-    std::unordered_map<std::string, CharacterCacheEntry*> _characterCacheByNameStore;
+    std::unordered_map<std::string, CharacterCacheEntry*, CharacterNameHash, CharacterNameEqual> _characterCacheByNameStore;
 }
 
 CharacterCache::CharacterCache()
@@ -215,7 +276,7 @@ CharacterCacheEntry const* CharacterCache::GetCharacterCacheByGuid(ObjectGuid co
     return nullptr;
 }
 
-CharacterCacheEntry const* CharacterCache::GetCharacterCacheByName(std::string const& name) const
+CharacterCacheEntry const* CharacterCache::GetCharacterCacheByName(std::string_view name) const
 {
     auto itr = _characterCacheByNameStore.find(name);
     if (itr != _characterCacheByNameStore.end())
@@ -224,7 +285,7 @@ CharacterCacheEntry const* CharacterCache::GetCharacterCacheByName(std::string c
     return nullptr;
 }
 
-ObjectGuid CharacterCache::GetCharacterGuidByName(std::string const& name) const
+ObjectGuid CharacterCache::GetCharacterGuidByName(std::string_view name) const
 {
     auto itr = _characterCacheByNameStore.find(name);
     if (itr != _characterCacheByNameStore.end())
@@ -261,7 +322,7 @@ uint32 CharacterCache::GetCharacterAccountIdByGuid(ObjectGuid guid) const
     return itr->second.AccountId;
 }
 
-uint32 CharacterCache::GetCharacterAccountIdByName(std::string const& name) const
+uint32 CharacterCache::GetCharacterAccountIdByName(std::string_view name) const
 {
     auto itr = _characterCacheByNameStore.find(name);
     if (itr != _characterCacheByNameStore.end())
@@ -22,6 +22,7 @@
 #include "ObjectGuid.h"
 #include "Optional.h"
 #include <string>
+#include <string_view>
 
 struct CharacterCacheEntry
 {
@@ -58,13 +59,13 @@ class TC_GAME_API CharacterCache
 
         bool HasCharacterCacheEntry(ObjectGuid const& guid) const;
         CharacterCacheEntry const* GetCharacterCacheByGuid(ObjectGuid const& guid) const;
-        CharacterCacheEntry const* GetCharacterCacheByName(std::string const& name) const;
+        CharacterCacheEntry const* GetCharacterCacheByName(std::string_view name) const;
 
-        ObjectGuid GetCharacterGuidByName(std::string const& name) const;
+        ObjectGuid GetCharacterGuidByName(std::string_view name) const;
         bool GetCharacterNameByGuid(ObjectGuid guid, std::string& name) const;
         uint32 GetCharacterTeamByGuid(ObjectGuid guid) const;
         uint32 GetCharacterAccountIdByGuid(ObjectGuid guid) const;
-        uint32 GetCharacterAccountIdByName(std::string const& name) const;
+        uint32 GetCharacterAccountIdByName(std::string_view name) const;
         uint8 GetCharacterLevelByGuid(ObjectGuid guid) const;
         ObjectGuid::LowType GetCharacterGuildIdByGuid(ObjectGuid guid) const;
         uint32 GetCharacterArenaTeamIdByGuid(ObjectGuid guid, uint8 type) const;
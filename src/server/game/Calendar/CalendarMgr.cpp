@@ -25,6 +25,7 @@
 #include "Log.h"
 #include "Mail.h"
 #include "ObjectAccessor.h"
+#include "MapUtils.h"
 #include "Player.h"
 #include <sstream>
 
@@ -91,6 +92,7 @@ void CalendarMgr::LoadFromDB()
 
             CalendarEvent* calendarEvent = new CalendarEvent(eventID, ownerGUID, guildID, type, textureID, date, flags, title, description, lockDate);
             _events.insert(calendarEvent);
+            IndexEvent(calendarEvent);
 
             _maxEventId = std::max(_maxEventId, eventID);
 
@@ -119,6 +121,7 @@ void CalendarMgr::LoadFromDB()
 
             CalendarInvite* invite = new CalendarInvite(inviteId, eventId, invitee, senderGUID, responseTime, status, rank, note);
             _invites[eventId].push_back(invite);
+            IndexInvite(invite);
 
             _maxInviteId = std::max(_maxInviteId, inviteId);
 
@@ -137,9 +140,68 @@ void CalendarMgr::LoadFromDB()
             _freeInviteIds.push_back(i);
 }
 
+void CalendarMgr::IndexEvent(CalendarEvent* calendarEvent)
+{
+    IndexedEvent& indexed = _eventsById[calendarEvent->GetEventId()];
+    indexed.Event = calendarEvent;
+    indexed.GuildId = calendarEvent->GetGuildId();
+    indexed.DateItr = _eventsByDate.emplace(calendarEvent->GetDate(), calendarEvent);
+
+    _eventsByOwner[calendarEvent->GetOwnerGUID()].insert(calendarEvent);
+    if (indexed.GuildId)
+        _eventsByGuild[indexed.GuildId].insert(calendarEvent);
+}
+
+void CalendarMgr::UnindexEvent(CalendarEvent* calendarEvent)
+{
+    auto itr = _eventsById.find(calendarEvent->GetEventId());
+    if (itr == _eventsById.end())
+        return;
+
+    _eventsByDate.erase(itr->second.DateItr);
+
+    auto ownerItr = _eventsByOwner.find(calendarEvent->GetOwnerGUID());
+    if (ownerItr != _eventsByOwner.end())
+    {
+        ownerItr->second.erase(calendarEvent);
+        if (ownerItr->second.empty())
+            _eventsByOwner.erase(ownerItr);
+    }
+
+    auto guildItr = _eventsByGuild.find(itr->second.GuildId);
+    if (guildItr != _eventsByGuild.end())
+    {
+        guildItr->second.erase(calendarEvent);
+        if (guildItr->second.empty())
+            _eventsByGuild.erase(guildItr);
+    }
+
+    _eventsById.erase(itr);
+}
+
+void CalendarMgr::IndexInvite(CalendarInvite* invite)
+{
+    _invitesById[invite->GetInviteId()] = invite;
+    _invitesByInvitee[invite->GetInviteeGUID()].push_back(invite);
+}
+
+void CalendarMgr::UnindexInvite(CalendarInvite* invite)
+{
+    _invitesById.erase(invite->GetInviteId());
+
+    auto itr = _invitesByInvitee.find(invite->GetInviteeGUID());
+    if (itr == _invitesByInvitee.end())
+        return;
+
+    itr->second.erase(std::remove(itr->second.begin(), itr->second.end(), invite), itr->second.end());
+    if (itr->second.empty())
+        _invitesByInvitee.erase(itr);
+}
+
 void CalendarMgr::AddEvent(CalendarEvent* calendarEvent, CalendarSendEventType sendType)
 {
     _events.insert(calendarEvent);
+    IndexEvent(calendarEvent);
     UpdateEvent(calendarEvent);
     SendCalendarEvent(calendarEvent->GetOwnerGUID(), *calendarEvent, sendType);
 }
@@ -155,6 +217,7 @@ void CalendarMgr::AddInvite(CalendarEvent* calendarEvent, CalendarInvite* invite
     if (!calendarEvent->IsGuildAnnouncement())
     {
         _invites[invite->GetEventId()].push_back(invite);
+        IndexInvite(invite);
         UpdateInvite(invite, trans);
     }
 }
@@ -199,6 +262,7 @@ void CalendarMgr::RemoveEvent(CalendarEvent* calendarEvent, ObjectGuid remover)
         if (!remover.IsEmpty() && invite->GetInviteeGUID() != remover)
             mail.SendMailTo(trans, MailReceiver(invite->GetInviteeGUID().GetCounter()), calendarEvent, MAIL_CHECK_MASK_COPIED);
 
+        UnindexInvite(invite);
         delete invite;
     }
 
@@ -210,6 +274,7 @@ void CalendarMgr::RemoveEvent(CalendarEvent* calendarEvent, ObjectGuid remover)
     CharacterDatabase.CommitTransaction(trans);
 
     _events.erase(calendarEvent);
+    UnindexEvent(calendarEvent);
     delete calendarEvent;
 }
 
@@ -244,12 +309,17 @@ void CalendarMgr::RemoveInvite(uint64 inviteId, uint64 eventId, ObjectGuid /*rem
     //    MailDraft(calendarEvent->BuildCalendarMailSubject(remover), calendarEvent->BuildCalendarMailBody())
     //        .SendMailTo(trans, MailReceiver((*itr)->GetInvitee()), calendarEvent, MAIL_CHECK_MASK_COPIED);
 
+    UnindexInvite(*itr);
     delete *itr;
     _invites[eventId].erase(itr);
 }
 
 void CalendarMgr::UpdateEvent(CalendarEvent* calendarEvent)
 {
+    // date and flags may have changed
+    UnindexEvent(calendarEvent);
+    IndexEvent(calendarEvent);
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CALENDAR_EVENT);
     stmt->setUInt64(0, calendarEvent->GetEventId());
     stmt->setUInt64(1, calendarEvent->GetOwnerGUID().GetCounter());
@@ -279,11 +349,10 @@ void CalendarMgr::UpdateInvite(CalendarInvite* invite, CharacterDatabaseTransact
 
 void CalendarMgr::RemoveAllPlayerEventsAndInvites(ObjectGuid guid)
 {
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end();)
+    if (CalendarEventStore const* ownedEvents = Trinity::Containers::MapGetValuePtr(_eventsByOwner, guid))
     {
-        CalendarEvent* event = *itr;
-        ++itr;
-        if (event->GetOwnerGUID() == guid)
+        CalendarEventStore events = *ownedEvents;
+        for (CalendarEvent* event : events)
             RemoveEvent(event, ObjectGuid::Empty); // don't send mail if removing a character
     }
 
@@ -294,9 +363,9 @@ void CalendarMgr::RemoveAllPlayerEventsAndInvites(ObjectGuid guid)
 
 void CalendarMgr::RemovePlayerGuildEventsAndSignups(ObjectGuid guid, ObjectGuid::LowType guildId)
 {
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end(); ++itr)
-        if ((*itr)->GetOwnerGUID() == guid && ((*itr)->IsGuildEvent() || (*itr)->IsGuildAnnouncement()))
-            RemoveEvent((*itr)->GetEventId(), guid);
+    for (CalendarEvent* event : GetEventsCreatedBy(guid, true))
+        if (event->IsGuildEvent() || event->IsGuildAnnouncement())
+            RemoveEvent(event, guid);
 
     CalendarInviteStore playerInvites = GetPlayerInvites(guid);
     for (CalendarInviteStore::const_iterator itr = playerInvites.begin(); itr != playerInvites.end(); ++itr)
@@ -307,9 +376,9 @@ void CalendarMgr::RemovePlayerGuildEventsAndSignups(ObjectGuid guid, ObjectGuid:
 
 CalendarEvent* CalendarMgr::GetEvent(uint64 eventId) const
 {
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end(); ++itr)
-        if ((*itr)->GetEventId() == eventId)
-            return *itr;
+    auto itr = _eventsById.find(eventId);
+    if (itr != _eventsById.end())
+        return itr->second.Event;
 
     TC_LOG_DEBUG("calendar", "CalendarMgr::GetEvent: [{}] not found!", eventId);
     return nullptr;
@@ -317,10 +386,8 @@ CalendarEvent* CalendarMgr::GetEvent(uint64 eventId) const
 
 CalendarInvite* CalendarMgr::GetInvite(uint64 inviteId) const
 {
-    for (CalendarEventInviteStore::const_iterator itr = _invites.begin(); itr != _invites.end(); ++itr)
-        for (CalendarInviteStore::const_iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2)
-            if ((*itr2)->GetInviteId() == inviteId)
-                return *itr2;
+    if (CalendarInvite* invite = Trinity::Containers::MapGetValuePtr(_invitesById, inviteId))
+        return invite;
 
     TC_LOG_DEBUG("calendar", "CalendarMgr::GetInvite: [{}] not found!", inviteId);
     return nullptr;
@@ -366,21 +433,21 @@ void CalendarMgr::DeleteOldEvents()
 {
     time_t oldEventsTime = GameTime::GetGameTime() - CALENDAR_OLD_EVENTS_DELETION_TIME;
 
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end();)
-    {
-        CalendarEvent* event = *itr;
-        ++itr;
-        if (event->GetDate() < oldEventsTime)
-            RemoveEvent(event, ObjectGuid::Empty);
-    }
+    std::vector<CalendarEvent*> oldEvents;
+    for (auto itr = _eventsByDate.begin(); itr != _eventsByDate.end() && itr->first < oldEventsTime; ++itr)
+        oldEvents.push_back(itr->second);
+
+    for (CalendarEvent* event : oldEvents)
+        RemoveEvent(event, ObjectGuid::Empty);
 }
 
 CalendarEventStore CalendarMgr::GetEventsCreatedBy(ObjectGuid guid, bool includeGuildEvents)
 {
     CalendarEventStore result;
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end(); ++itr)
-        if ((*itr)->GetOwnerGUID() == guid && (includeGuildEvents || (!(*itr)->IsGuildEvent() && !(*itr)->IsGuildAnnouncement())))
-            result.insert(*itr);
+    if (CalendarEventStore const* events = Trinity::Containers::MapGetValuePtr(_eventsByOwner, guid))
+        for (CalendarEvent* event : *events)
+            if (includeGuildEvents || (!event->IsGuildEvent() && !event->IsGuildAnnouncement()))
+                result.insert(event);
 
     return result;
 }
@@ -392,10 +459,10 @@ CalendarEventStore CalendarMgr::GetGuildEvents(ObjectGuid::LowType guildId)
     if (!guildId)
         return result;
 
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end(); ++itr)
-        if ((*itr)->IsGuildEvent() || (*itr)->IsGuildAnnouncement())
-            if ((*itr)->GetGuildId() == guildId)
-                result.insert(*itr);
+    if (CalendarEventStore const* events = Trinity::Containers::MapGetValuePtr(_eventsByGuild, guildId))
+        for (CalendarEvent* event : *events)
+            if (event->IsGuildEvent() || event->IsGuildAnnouncement())
+                result.insert(event);
 
     return result;
 }
@@ -404,17 +471,14 @@ CalendarEventStore CalendarMgr::GetPlayerEvents(ObjectGuid guid)
 {
     CalendarEventStore events;
 
-    for (CalendarEventInviteStore::const_iterator itr = _invites.begin(); itr != _invites.end(); ++itr)
-        for (CalendarInviteStore::const_iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2)
-            if ((*itr2)->GetInviteeGUID() == guid)
-                if (CalendarEvent* event = GetEvent(itr->first)) // NULL check added as attempt to fix #11512
-                    events.insert(event);
+    for (CalendarInvite const* invite : GetPlayerInvites(guid))
+        if (CalendarEvent* event = GetEvent(invite->GetEventId())) // NULL check added as attempt to fix #11512
+            events.insert(event);
 
     if (Player* player = ObjectAccessor::FindConnectedPlayer(guid))
         if (player->GetGuildId())
-            for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end(); ++itr)
-                if ((*itr)->GetGuildId() == player->GetGuildId())
-                    events.insert(*itr);
+            if (CalendarEventStore const* guildEvents = Trinity::Containers::MapGetValuePtr(_eventsByGuild, player->GetGuildId()))
+                events.insert(guildEvents->begin(), guildEvents->end());
 
     return events;
 }
@@ -424,16 +488,13 @@ CalendarInviteStore const& CalendarMgr::GetEventInvites(uint64 eventId)
     return _invites[eventId];
 }
 
-CalendarInviteStore CalendarMgr::GetPlayerInvites(ObjectGuid guid)
+CalendarInviteStore const& CalendarMgr::GetPlayerInvites(ObjectGuid guid) const
 {
-    CalendarInviteStore invites;
-
-    for (CalendarEventInviteStore::const_iterator itr = _invites.begin(); itr != _invites.end(); ++itr)
-        for (CalendarInviteStore::const_iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2)
-            if ((*itr2)->GetInviteeGUID() == guid)
-                invites.push_back(*itr2);
+    static CalendarInviteStore const emptyInvites;
+    if (CalendarInviteStore const* invites = Trinity::Containers::MapGetValuePtr(_invitesByInvitee, guid))
+        return *invites;
 
-    return invites;
+    return emptyInvites;
 }
 
 uint32 CalendarMgr::GetPlayerNumPending(ObjectGuid guid)
@@ -24,6 +24,7 @@
 #include <deque>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 class WorldPacket;
@@ -290,6 +291,25 @@ class TC_GAME_API CalendarMgr
         CalendarEventStore _events;
         CalendarEventInviteStore _invites;
 
+        // secondary indexes, events remember the keys they were indexed with to be reindexed after changes
+        struct IndexedEvent
+        {
+            CalendarEvent* Event;
+            ObjectGuid::LowType GuildId;
+            std::multimap<time_t, CalendarEvent*>::iterator DateItr;
+        };
+        std::unordered_map<uint64, IndexedEvent> _eventsById;
+        std::unordered_map<ObjectGuid, CalendarEventStore> _eventsByOwner;
+        std::unordered_map<ObjectGuid::LowType, CalendarEventStore> _eventsByGuild;
+        std::multimap<time_t, CalendarEvent*> _eventsByDate;
+        std::unordered_map<uint64, CalendarInvite*> _invitesById;
+        std::unordered_map<ObjectGuid, CalendarInviteStore> _invitesByInvitee;
+
+        void IndexEvent(CalendarEvent* calendarEvent);
+        void UnindexEvent(CalendarEvent* calendarEvent);
+        void IndexInvite(CalendarInvite* invite);
+        void UnindexInvite(CalendarInvite* invite);
+
         std::deque<uint64> _freeEventIds;
         std::deque<uint64> _freeInviteIds;
         uint64 _maxEventId;
@@ -309,7 +329,7 @@ class TC_GAME_API CalendarMgr
         CalendarInvite* GetInvite(uint64 inviteId) const;
         CalendarEventInviteStore const& GetInvites() const { return _invites; }
         CalendarInviteStore const& GetEventInvites(uint64 eventId);
-        CalendarInviteStore GetPlayerInvites(ObjectGuid guid);
+        CalendarInviteStore const& GetPlayerInvites(ObjectGuid guid) const;
 
         void FreeEventId(uint64 id);
         uint64 GetFreeEventId();
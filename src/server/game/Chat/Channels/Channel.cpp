@@ -729,7 +729,7 @@ void Channel::Say(ObjectGuid const& guid, std::string const& what, uint32 lang)
         !playerInfo.IsModerator() && player ? player->GetSession()->GetAccountGUID() : ObjectGuid::Empty);
 }
 
-void Channel::AddonSay(ObjectGuid const& guid, std::string const& prefix, std::string const& what, bool isLogged) const
+void Channel::AddonSay(ObjectGuid const& guid, std::string_view prefix, std::string_view what, bool isLogged) const
 {
     if (what.empty())
         return;
@@ -1015,7 +1015,7 @@ void Channel::SendToOne(Builder& builder, ObjectGuid const& who) const
 }
 
 template <class Builder>
-void Channel::SendToAllWithAddon(Builder& builder, std::string const& addonPrefix, ObjectGuid const& guid /*= ObjectGuid::Empty*/,
+void Channel::SendToAllWithAddon(Builder& builder, std::string_view addonPrefix, ObjectGuid const& guid /*= ObjectGuid::Empty*/,
     ObjectGuid const& accountGuid /*= ObjectGuid::Empty*/) const
 {
     Trinity::LocalizedDo<Builder> localizer(builder);
@@ -19,6 +19,7 @@
 #include "Common.h"
 #include "DB2Stores.h"
 #include "Errors.h"
+#include "GameTime.h"
 #include "ItemTemplate.h"
 #include "ObjectMgr.h"
 #include "QuestDef.h"
@@ -27,6 +28,7 @@
 #include "SpellMgr.h"
 #include "StringFormat.h"
 #include "World.h"
+#include <unordered_map>
 
 using namespace Trinity::Hyperlinks;
 
@@ -736,9 +738,56 @@ static bool ValidateLinkInfo(HyperlinkInfo const& info)
     return false;
 }
 
+// Remembers links that passed validation so that the same link spammed in chat (trade channel) is only validated once
+// Entries are dropped every minute to pick up reloaded data, and whenever link checking severity changes
+class ValidatedLinkCache
+{
+public:
+    bool Contains(std::string_view link)
+    {
+        Refresh();
+        auto itr = _links.find(std::hash<std::string_view>()(link));
+        return itr != _links.end() && itr->second == link;
+    }
+
+    void Add(std::string_view link)
+    {
+        if (_links.size() >= MaxLinks)
+            _links.clear();
+
+        _links[std::hash<std::string_view>()(link)] = link;
+    }
+
+private:
+    static constexpr std::size_t MaxLinks = 1024;
+
+    void Refresh()
+    {
+        time_t minute = GameTime::GetGameTime() / MINUTE;
+        uint32 severity = sWorld->getIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY);
+        if (minute != _minute || severity != _severity)
+        {
+            _links.clear();
+            _minute = minute;
+            _severity = severity;
+        }
+    }
+
+    std::unordered_map<std::size_t, std::string> _links;
+    time_t _minute = 0;
+    uint32 _severity = 0;
+};
+
 // Validates all hyperlinks and control sequences contained in str
 bool Trinity::Hyperlinks::CheckAllLinks(std::string_view str)
 {
+    // Fast path for plain text, find() is a vectorized memchr
+    if (str.find('|') == std::string_view::npos)
+        return true;
+
+    // Sessions are also updated from map update threads
+    thread_local ValidatedLinkCache validatedLinks;
+
     // Step 1: Disallow all control sequences except ||, |H, |h, |c and |r
     {
         std::string_view::size_type pos = 0;
@@ -772,9 +821,18 @@ bool Trinity::Hyperlinks::CheckAllLinks(std::string_view str)
             }
 
             HyperlinkInfo info = ParseSingleHyperlink(str.substr(pos));
-            if (!info || !ValidateLinkInfo(info))
+            if (!info)
                 return false;
 
+            std::string_view link = str.substr(pos, info.tail.data() - str.data() - pos);
+            if (!validatedLinks.Contains(link))
+            {
+                if (!ValidateLinkInfo(info))
+                    return false;
+
+                validatedLinks.Add(link);
+            }
+
             // tag is fine, find the next one
             str = info.tail;
         }
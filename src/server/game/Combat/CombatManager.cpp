@@ -21,6 +21,31 @@
 #include "CreatureAI.h"
 #include "Player.h"
 
+namespace
+{
+// begin() of a flat hash map skips every slot emptied before it, so draining one through begin() is quadratic
+// fn is called for the references of a snapshot of the keys instead and may remove or add any of them,
+// references added meanwhile are handled by the next pass
+template<class RefMap, class Fn>
+void DrainRefs(RefMap& refs, Fn fn)
+{
+    std::vector<ObjectGuid> guids;
+    while (!refs.empty())
+    {
+        guids.clear();
+        for (auto const& [guid, ref] : refs)
+            guids.push_back(guid);
+
+        for (ObjectGuid const& guid : guids)
+        {
+            auto itr = refs.find(guid);
+            if (itr != refs.end())
+                fn(itr->second);
+        }
+    }
+}
+}
+
 /*static*/ bool CombatManager::CanBeginCombat(Unit const* a, Unit const* b)
 {
     // Checks combat validity before initial reference creation.
@@ -309,8 +334,7 @@ void CombatManager::EndAllPvECombat()
     // cannot have threat without combat
     _owner->GetThreatManager().RemoveMeFromThreatLists();
     _owner->GetThreatManager().ClearAllThreat();
-    while (!_pveRefs.empty())
-        _pveRefs.begin()->second->EndCombat();
+    DrainRefs(_pveRefs, [](CombatReference* ref) { ref->EndCombat(); });
 }
 
 void CombatManager::RevalidateCombat()
@@ -344,8 +368,7 @@ void CombatManager::RevalidateCombat()
 
 void CombatManager::EndAllPvPCombat()
 {
-    while (!_pvpRefs.empty())
-        _pvpRefs.begin()->second->EndCombat();
+    DrainRefs(_pvpRefs, [](PvPCombatReference* ref) { ref->EndCombat(); });
 }
 
 /*static*/ void CombatManager::NotifyAICombat(Unit* me, Unit* other)
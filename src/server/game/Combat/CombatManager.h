@@ -19,8 +19,8 @@
 #define TRINITY_COMBATMANAGER_H
 
 #include "Common.h"
+#include "FlatHashMap.h"
 #include "ObjectGuid.h"
-#include <unordered_map>
 
 class Unit;
 
@@ -108,9 +108,9 @@ class TC_GAME_API CombatManager
         bool HasCombat() const { return HasPvECombat() || HasPvPCombat(); }
         bool HasPvECombat() const;
         bool HasPvECombatWithPlayers() const;
-        std::unordered_map<ObjectGuid, CombatReference*> const& GetPvECombatRefs() const { return _pveRefs; }
+        Trinity::Containers::FlatHashMap<ObjectGuid, CombatReference*> const& GetPvECombatRefs() const { return _pveRefs; }
         bool HasPvPCombat() const;
-        std::unordered_map<ObjectGuid, PvPCombatReference*> const& GetPvPCombatRefs() const { return _pvpRefs; }
+        Trinity::Containers::FlatHashMap<ObjectGuid, PvPCombatReference*> const& GetPvPCombatRefs() const { return _pvpRefs; }
         // If the Unit is in combat, returns an arbitrary Unit that it's in combat with. Otherwise, returns nullptr.
         Unit* GetAnyTarget() const;
 
@@ -136,8 +136,8 @@ class TC_GAME_API CombatManager
         void PurgeReference(ObjectGuid const& guid, bool pvp);
         bool UpdateOwnerCombatState() const;
         Unit* const _owner;
-        std::unordered_map<ObjectGuid, CombatReference*> _pveRefs;
-        std::unordered_map<ObjectGuid, PvPCombatReference*> _pvpRefs;
+        Trinity::Containers::FlatHashMap<ObjectGuid, CombatReference*> _pveRefs;
+        Trinity::Containers::FlatHashMap<ObjectGuid, PvPCombatReference*> _pvpRefs;
 
     friend struct CombatReference;
     friend struct PvPCombatReference;
@@ -20,23 +20,49 @@
 #include "CombatPackets.h"
 #include "CreatureAI.h"
 #include "CreatureGroups.h"
+#include "IntrusiveHeap.h"
 #include "MotionMaster.h"
 #include "ObjectAccessor.h"
 #include "Player.h"
 #include "SpellAuraEffects.h"
 #include "SpellMgr.h"
 #include "TemporarySummon.h"
-#include <boost/heap/fibonacci_heap.hpp>
 
-#include "Hacks/boost_1_74_fibonacci_heap.h"
+namespace
+{
+// begin() of a flat hash map skips every slot emptied before it, so draining one through begin() is quadratic
+// fn is called for the references of a snapshot of the keys instead and may remove or add any of them,
+// references added meanwhile are handled by the next pass
+template<class RefMap, class Fn>
+void DrainRefs(RefMap& refs, Fn fn)
+{
+    std::vector<ObjectGuid> guids;
+    while (!refs.empty())
+    {
+        guids.clear();
+        for (auto const& [guid, ref] : refs)
+            guids.push_back(guid);
+
+        for (ObjectGuid const& guid : guids)
+        {
+            auto itr = refs.find(guid);
+            if (itr != refs.end())
+                fn(itr->second);
+        }
+    }
+}
+}
 
 const CompareThreatLessThan ThreatManager::CompareThreat;
 
-class ThreatManager::Heap : public boost::heap::fibonacci_heap<ThreatReference const*, boost::heap::compare<CompareThreatLessThan>>
+struct ThreatReferenceHeapIndex
 {
+    std::size_t& operator()(ThreatReference const* ref) const;
 };
 
-BOOST_1_74_FIBONACCI_HEAP_MSVC_COMPILE_FIX(ThreatManager::Heap::value_type)
+class ThreatManager::Heap : public Trinity::Containers::IntrusiveHeap<ThreatReference const*, CompareThreatLessThan, ThreatReferenceHeapIndex>
+{
+};
 
 void ThreatReference::AddThreat(float amount)
 {
@@ -157,19 +183,27 @@ void ThreatReference::UnregisterAndFree()
 class ThreatReferenceImpl : public ThreatReference
 {
 public:
-    explicit ThreatReferenceImpl(ThreatManager* mgr, Unit* victim) : ThreatReference(mgr, victim) { }
+    explicit ThreatReferenceImpl(ThreatManager* mgr, Unit* victim) : ThreatReference(mgr, victim), _heapIndex(0) { }
 
-    ThreatManager::Heap::handle_type _handle;
+    // position in ThreatManager::_sortedThreatList, maintained by the heap
+    mutable std::size_t _heapIndex;
 };
 
+inline std::size_t& ThreatReferenceHeapIndex::operator()(ThreatReference const* ref) const
+{
+    return static_cast<ThreatReferenceImpl const*>(ref)->_heapIndex;
+}
+
 void ThreatReference::HeapNotifyIncreased()
 {
-    _mgr._sortedThreatList->increase(static_cast<ThreatReferenceImpl*>(this)->_handle);
+    _mgr._sortedThreatList->increase(this);
+    _mgr.InvalidateSortedThreatListCache();
 }
 
 void ThreatReference::HeapNotifyDecreased()
 {
-    _mgr._sortedThreatList->decrease(static_cast<ThreatReferenceImpl*>(this)->_handle);
+    _mgr._sortedThreatList->decrease(this);
+    _mgr.InvalidateSortedThreatListCache();
 }
 
 /*static*/ bool ThreatManager::CanHaveThreatList(Unit const* who)
@@ -193,7 +227,7 @@ void ThreatReference::HeapNotifyDecreased()
 }
 
 ThreatManager::ThreatManager(Unit* owner) : _owner(owner), _ownerCanHaveThreatList(false), _needClientUpdate(false), _updateTimer(THREAT_UPDATE_INTERVAL),
-    _sortedThreatList(std::make_unique<Heap>()), _currentVictimRef(nullptr), _fixateRef(nullptr)
+    _sortedThreatList(std::make_unique<Heap>()), _sortedThreatListCacheValid(false), _currentVictimRef(nullptr), _fixateRef(nullptr)
 {
     for (int8 i = 0; i < MAX_SPELL_SCHOOL; ++i)
         _singleSchoolModifiers[i] = 1.0f;
@@ -279,40 +313,30 @@ size_t ThreatManager::GetThreatListSize() const
     return _sortedThreatList->size();
 }
 
-Trinity::IteratorPair<ThreatManager::ThreatListIterator, std::nullptr_t> ThreatManager::GetUnsortedThreatList() const
+Trinity::IteratorPair<ThreatManager::UnsortedThreatListIterator> ThreatManager::GetUnsortedThreatList() const
 {
-    auto itr = _myThreatListEntries.begin();
-    auto end = _myThreatListEntries.end();
-    std::function<ThreatReference const* ()> generator = [itr, end]() mutable -> ThreatReference const*
-    {
-        if (itr == end)
-            return nullptr;
-
-        return (itr++)->second;
-    };
-    return { ThreatListIterator{ std::move(generator) }, nullptr };
+    return { UnsortedThreatListIterator(_myThreatListEntries.begin()), UnsortedThreatListIterator(_myThreatListEntries.end()) };
 }
 
-Trinity::IteratorPair<ThreatManager::ThreatListIterator, std::nullptr_t> ThreatManager::GetSortedThreatList() const
+Trinity::IteratorPair<ThreatManager::SortedThreatListIterator> ThreatManager::GetSortedThreatList() const
 {
-    auto itr = _sortedThreatList->ordered_begin();
-    auto end = _sortedThreatList->ordered_end();
-    std::function<ThreatReference const* ()> generator = [itr, end]() mutable -> ThreatReference const*
+    if (!_sortedThreatListCacheValid)
     {
-        if (itr == end)
-            return nullptr;
+        // ordered iteration of the heap allocates and costs O(log n) per step, many lists are iterated several times between changes
+        _sortedThreatListCache.assign(_sortedThreatList->begin(), _sortedThreatList->end());
+        std::sort(_sortedThreatListCache.begin(), _sortedThreatListCache.end(), [](ThreatReference const* a, ThreatReference const* b) { return CompareThreat(b, a); });
+        _sortedThreatListCacheValid = true;
+    }
 
-        return *(itr++);
-    };
-    return { ThreatListIterator{ std::move(generator) }, nullptr };
+    return { SortedThreatListIterator(_sortedThreatListCache.cbegin()), SortedThreatListIterator(_sortedThreatListCache.cend()) };
 }
 
 std::vector<ThreatReference*> ThreatManager::GetModifiableThreatList()
 {
     std::vector<ThreatReference*> list;
     list.reserve(_myThreatListEntries.size());
-    for (auto it = _sortedThreatList->ordered_begin(), end = _sortedThreatList->ordered_end(); it != end; ++it)
-        list.push_back(const_cast<ThreatReference*>(*it));
+    for (ThreatReference const* ref : GetSortedThreatList())
+        list.push_back(const_cast<ThreatReference*>(ref));
     return list;
 }
 
@@ -496,7 +520,7 @@ void ThreatManager::MatchUnitThreatToHighestThreat(Unit* target)
 
 void ThreatManager::TauntUpdate()
 {
-    std::list<AuraEffect*> const& tauntEffects = _owner->GetAuraEffectsByType(SPELL_AURA_MOD_TAUNT);
+    Unit::AuraEffectList const& tauntEffects = _owner->GetAuraEffectsByType(SPELL_AURA_MOD_TAUNT);
 
     uint32 state = ThreatReference::TAUNT_STATE_TAUNT;
     std::unordered_map<ObjectGuid, ThreatReference::TauntState> tauntStates;
@@ -543,9 +567,7 @@ void ThreatManager::ClearAllThreat()
     if (!_myThreatListEntries.empty())
     {
         SendClearAllThreatToClients();
-        do
-            _myThreatListEntries.begin()->second->UnregisterAndFree();
-        while (!_myThreatListEntries.empty());
+        DrainRefs(_myThreatListEntries, [](ThreatReference* ref) { ref->UnregisterAndFree(); });
     }
 }
 
@@ -747,11 +769,7 @@ void ThreatManager::ForwardThreatForAssistingMe(Unit* assistant, float baseAmoun
 
 void ThreatManager::RemoveMeFromThreatLists()
 {
-    while (!_threatenedByMe.empty())
-    {
-        auto& ref = _threatenedByMe.begin()->second;
-        ref->_mgr.ClearThreat(_owner);
-    }
+    DrainRefs(_threatenedByMe, [this](ThreatReference* ref) { ref->_mgr.ClearThreat(_owner); });
 }
 
 void ThreatManager::UpdateMyTempModifiers()
@@ -863,7 +881,8 @@ void ThreatManager::PutThreatListRef(ObjectGuid const& guid, ThreatReference* re
     auto& inMap = _myThreatListEntries[guid];
     ASSERT(!inMap, "Duplicate threat reference at %p being inserted on %s for %s - memory leak!", ref, _owner->GetGUID().ToString().c_str(), guid.ToString().c_str());
     inMap = ref;
-    static_cast<ThreatReferenceImpl*>(ref)->_handle = _sortedThreatList->push(ref);
+    _sortedThreatList->push(ref);
+    InvalidateSortedThreatListCache();
 }
 
 void ThreatManager::PurgeThreatListRef(ObjectGuid const& guid)
@@ -873,7 +892,8 @@ void ThreatManager::PurgeThreatListRef(ObjectGuid const& guid)
         return;
     ThreatReference* ref = it->second;
     _myThreatListEntries.erase(it);
-    _sortedThreatList->erase(static_cast<ThreatReferenceImpl*>(ref)->_handle);
+    _sortedThreatList->erase(ref);
+    InvalidateSortedThreatListCache();
 
     if (_fixateRef == ref)
         _fixateRef = nullptr;
@@ -19,6 +19,7 @@
  #define TRINITY_THREATMANAGER_H
 
 #include "Common.h"
+#include "FlatHashMap.h"
 #include "IteratorPair.h"
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
@@ -82,7 +83,10 @@ class TC_GAME_API ThreatManager
 {
     public:
         class Heap;
+        template<typename Iterator>
         class ThreatListIterator;
+        using UnsortedThreatListIterator = ThreatListIterator<Trinity::Containers::FlatHashMap<ObjectGuid, ThreatReference*>::const_iterator>;
+        using SortedThreatListIterator = ThreatListIterator<std::vector<ThreatReference const*>::const_iterator>;
         static const uint32 THREAT_UPDATE_INTERVAL = 1000u;
 
         static bool CanHaveThreatList(Unit const* who);
@@ -118,11 +122,11 @@ class TC_GAME_API ThreatManager
         size_t GetThreatListSize() const;
         // fastest of the three threat list getters - gets the threat list in "arbitrary" order
         // iterators will invalidate on adding/removing entries from the threat list; slightly less finicky than GetSorted.
-        Trinity::IteratorPair<ThreatListIterator, std::nullptr_t> GetUnsortedThreatList() const;
+        Trinity::IteratorPair<UnsortedThreatListIterator> GetUnsortedThreatList() const;
         // slightly slower than GetUnsorted, but, well...sorted - only use it if you need the sorted property, of course
         // this iterator pair will invalidate on any modification (even indirect) of the threat list; spell casts and similar can all induce this!
         // note: current tank is NOT guaranteed to be the first entry in this list - check GetLastVictim separately if you want that!
-        Trinity::IteratorPair<ThreatListIterator, std::nullptr_t> GetSortedThreatList() const;
+        Trinity::IteratorPair<SortedThreatListIterator> GetSortedThreatList() const;
         // slowest of the three threat list getters (by far), but lets you modify the threat references - this is also sorted
         std::vector<ThreatReference*> GetModifiableThreatList();
 
@@ -199,7 +203,11 @@ class TC_GAME_API ThreatManager
         bool _needClientUpdate;
         uint32 _updateTimer;
         std::unique_ptr<Heap> _sortedThreatList;
-        std::unordered_map<ObjectGuid, ThreatReference*> _myThreatListEntries;
+        Trinity::Containers::FlatHashMap<ObjectGuid, ThreatReference*> _myThreatListEntries;
+        // ordered copy of the heap for GetSortedThreatList, rebuilt on the next call after the heap changed
+        mutable std::vector<ThreatReference const*> _sortedThreatListCache;
+        mutable bool _sortedThreatListCacheValid;
+        void InvalidateSortedThreatListCache() { _sortedThreatListCacheValid = false; }
 
         // AI notifies are delayed to ensure we are in a consistent state before we call out to arbitrary logic
         // threat references might register themselves here when ::UpdateOffline() is called - MAKE SURE THIS IS PROCESSED JUST BEFORE YOU EXIT THREATMANAGER LOGIC
@@ -216,7 +224,7 @@ class TC_GAME_API ThreatManager
         ///== OTHERS' THREAT LISTS ==
         void PutThreatenedByMeRef(ObjectGuid const& guid, ThreatReference* ref);
         void PurgeThreatenedByMeRef(ObjectGuid const& guid);
-        std::unordered_map<ObjectGuid, ThreatReference*> _threatenedByMe; // these refs are entries for myself on other units' threat lists
+        Trinity::Containers::FlatHashMap<ObjectGuid, ThreatReference*> _threatenedByMe; // these refs are entries for myself on other units' threat lists
         std::array<float, MAX_SPELL_SCHOOL> _singleSchoolModifiers; // most spells are single school - we pre-calculate these and store them
         mutable std::unordered_map<std::underlying_type<SpellSchoolMask>::type, float> _multiSchoolModifiers; // these are calculated on demand
 
@@ -229,24 +237,25 @@ class TC_GAME_API ThreatManager
         ThreatManager(ThreatManager const&) = delete;
         ThreatManager& operator=(ThreatManager const&) = delete;
 
+        // walks the storage directly, map entries yield their value
+        template<typename Iterator>
         class ThreatListIterator
         {
         private:
-            std::function<ThreatReference const* ()> _generator;
-            ThreatReference const* _current;
+            Iterator _itr;
 
             friend ThreatManager;
-            explicit ThreatListIterator(std::function<ThreatReference const* ()>&& generator)
-                : _generator(std::move(generator)), _current(_generator()) {}
+            explicit ThreatListIterator(Iterator itr) : _itr(itr) { }
+
+            static ThreatReference const* Get(ThreatReference const* ref) { return ref; }
+            static ThreatReference const* Get(std::pair<ObjectGuid const, ThreatReference*> const& entry) { return entry.second; }
 
         public:
-            ThreatReference const* operator*() const { return _current; }
-            ThreatReference const* operator->() const { return _current; }
-            ThreatListIterator& operator++() { _current = _generator(); return *this; }
-            bool operator==(ThreatListIterator const& o) const { return _current == o._current; }
-            bool operator!=(ThreatListIterator const& o) const { return _current != o._current; }
-            bool operator==(std::nullptr_t) const { return _current == nullptr; }
-            bool operator!=(std::nullptr_t) const { return _current != nullptr; }
+            ThreatReference const* operator*() const { return Get(*_itr); }
+            ThreatReference const* operator->() const { return Get(*_itr); }
+            ThreatListIterator& operator++() { ++_itr; return *this; }
+            bool operator==(ThreatListIterator const& o) const { return _itr == o._itr; }
+            bool operator!=(ThreatListIterator const& o) const { return _itr != o._itr; }
         };
 
     friend class ThreatReference;
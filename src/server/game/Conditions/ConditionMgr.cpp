@@ -50,8 +50,11 @@
 #include "SpellAuraEffects.h"
 #include "SpellMgr.h"
 #include "World.h"
+#include "WorldDatabaseSnapshot.h"
 #include "WorldSession.h"
 #include "WorldStateMgr.h"
+#include <boost/container/small_vector.hpp>
+#include <limits>
 #include <random>
 #include <sstream>
 
@@ -947,18 +950,18 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionContainer cons
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const
 {
     //     groupId, groupCheckPassed
-    std::map<uint32, bool> elseGroupStore;
+    boost::container::small_vector<std::pair<uint32, bool>, 4> elseGroupStore;
     for (Condition const* condition : conditions)
     {
         TC_LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList {} val1: {}", condition->ToString(), condition->ConditionValue1);
         if (condition->isLoaded())
         {
             //! Find ElseGroup in ElseGroupStore
-            std::map<uint32, bool>::const_iterator itr = elseGroupStore.find(condition->ElseGroup);
+            auto itr = std::find_if(elseGroupStore.begin(), elseGroupStore.end(), [condition](std::pair<uint32, bool> const& group) { return group.first == condition->ElseGroup; });
             //! If not found, add an entry in the store and set to true (placeholder)
             if (itr == elseGroupStore.end())
-                elseGroupStore[condition->ElseGroup] = true;
-            else if (!(*itr).second) //! If another condition in this group was unmatched before this, don't bother checking (the group is false anyway)
+                itr = elseGroupStore.emplace(elseGroupStore.end(), condition->ElseGroup, true);
+            else if (!itr->second) //! If another condition in this group was unmatched before this, don't bother checking (the group is false anyway)
                 continue;
 
             if (condition->ReferenceId)//handle reference
@@ -967,7 +970,7 @@ bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo,
                 if (ref != ConditionReferenceStore.end())
                 {
                     if (!IsObjectMeetToConditionList(sourceInfo, ref->second))
-                        elseGroupStore[condition->ElseGroup] = false;
+                        itr->second = false;
                 }
                 else
                 {
@@ -979,12 +982,12 @@ bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo,
             else //handle normal condition
             {
                 if (!condition->Meets(sourceInfo))
-                    elseGroupStore[condition->ElseGroup] = false;
+                    itr->second = false;
             }
         }
     }
-    for (std::map<uint32, bool>::const_iterator i = elseGroupStore.begin(); i != elseGroupStore.end(); ++i)
-        if (i->second)
+    for (std::pair<uint32, bool> const& group : elseGroupStore)
+        if (group.second)
             return true;
 
     return false;
@@ -1038,6 +1041,70 @@ bool ConditionMgr::CanHaveSourceGroupSet(ConditionSourceType sourceType)
             sourceType == CONDITION_SOURCE_TYPE_OBJECT_ID_VISIBILITY);
 }
 
+namespace
+{
+// rough evaluation cost of a condition, cheap checks of object fields come first
+uint32 GetConditionCost(Condition const* condition)
+{
+    if (condition->ReferenceId || condition->ScriptId)
+        return 3;
+
+    switch (condition->ConditionType)
+    {
+        case CONDITION_NONE:
+        case CONDITION_ZONEID:
+        case CONDITION_TEAM:
+        case CONDITION_DRUNKENSTATE:
+        case CONDITION_CLASS:
+        case CONDITION_RACE:
+        case CONDITION_GENDER:
+        case CONDITION_UNIT_STATE:
+        case CONDITION_MAPID:
+        case CONDITION_AREAID:
+        case CONDITION_CREATURE_TYPE:
+        case CONDITION_LEVEL:
+        case CONDITION_OBJECT_ENTRY_GUID_LEGACY:
+        case CONDITION_TYPE_MASK_LEGACY:
+        case CONDITION_ALIVE:
+        case CONDITION_HP_VAL:
+        case CONDITION_HP_PCT:
+        case CONDITION_IN_WATER:
+        case CONDITION_STAND_STATE:
+        case CONDITION_CHARMED:
+        case CONDITION_PET_TYPE:
+        case CONDITION_TAXI:
+        case CONDITION_DIFFICULTY_ID:
+        case CONDITION_GAMEMASTER:
+        case CONDITION_OBJECT_ENTRY_GUID:
+        case CONDITION_TYPE_MASK:
+            return 0;
+        case CONDITION_NEAR_CREATURE:
+        case CONDITION_NEAR_GAMEOBJECT:
+        case CONDITION_PLAYER_CONDITION:
+            return 2;
+        default:
+            return 1;
+    }
+}
+}
+
+/*static*/ void ConditionMgr::AddToConditionContainer(ConditionContainer& conditions, Condition* condition)
+{
+    // spell cast errors come from the last failed condition, keep the order of the database
+    if (condition->SourceType == CONDITION_SOURCE_TYPE_SPELL)
+    {
+        conditions.push_back(condition);
+        return;
+    }
+
+    // conditions of equal cost keep their database order
+    auto itr = std::upper_bound(conditions.begin(), conditions.end(), condition, [](Condition const* left, Condition const* right)
+    {
+        return std::make_pair(left->ElseGroup, GetConditionCost(left)) < std::make_pair(right->ElseGroup, GetConditionCost(right));
+    });
+    conditions.insert(itr, condition);
+}
+
 bool ConditionMgr::CanHaveSourceIdSet(ConditionSourceType sourceType)
 {
     return (sourceType == CONDITION_SOURCE_TYPE_SMART_EVENT);
@@ -1105,6 +1172,93 @@ bool ConditionMgr::HasConditionsForNotGroupedEntry(ConditionSourceType sourceTyp
     return false;
 }
 
+uint64 ConditionMgr::GetConditionTypeMaskForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const
+{
+    if (sourceType > CONDITION_SOURCE_TYPE_NONE && sourceType < CONDITION_SOURCE_TYPE_MAX)
+        if (ConditionContainer const* conditions = Trinity::Containers::MapGetValuePtr(ConditionStore[sourceType], entry))
+            return GetConditionTypeMaskForConditionList(*conditions);
+
+    return 0;
+}
+
+uint64 ConditionMgr::GetConditionTypeMaskForConditionList(ConditionContainer const& conditions) const
+{
+    static_assert(CONDITION_MAX <= 64, "Condition types no longer fit in a 64 bit mask");
+
+    uint64 mask = 0;
+    for (Condition const* condition : conditions)
+    {
+        if (condition->ScriptId)
+            return std::numeric_limits<uint64>::max();
+
+        if (condition->ReferenceId)
+        {
+            if (ConditionContainer const* reference = Trinity::Containers::MapGetValuePtr(ConditionReferenceStore, condition->ReferenceId))
+                mask |= GetConditionTypeMaskForConditionList(*reference);
+        }
+        else
+            mask |= UI64LIT(1) << condition->ConditionType;
+    }
+
+    return mask;
+}
+
+void ConditionMgr::LoadQuestAvailableDependencies()
+{
+    // returns false if the conditions check anything but quest states, including references and scripts
+    auto collectQuestStates = [this](ConditionContainer const& conditions, std::vector<uint32>& questIds, auto const& self) -> bool
+    {
+        bool onlyQuestStates = true;
+        for (Condition const* condition : conditions)
+        {
+            if (condition->ScriptId)
+                onlyQuestStates = false;
+            else if (condition->ReferenceId)
+            {
+                if (ConditionContainer const* reference = Trinity::Containers::MapGetValuePtr(ConditionReferenceStore, condition->ReferenceId))
+                    onlyQuestStates = self(*reference, questIds, self) && onlyQuestStates;
+            }
+            else
+            {
+                switch (condition->ConditionType)
+                {
+                    case CONDITION_QUESTREWARDED:
+                    case CONDITION_QUESTTAKEN:
+                    case CONDITION_QUEST_NONE:
+                    case CONDITION_QUEST_COMPLETE:
+                    case CONDITION_QUESTSTATE:
+                        questIds.push_back(condition->ConditionValue1);
+                        break;
+                    default:
+                        onlyQuestStates = false;
+                        break;
+                }
+            }
+        }
+
+        return onlyQuestStates;
+    };
+
+    for (auto const& [questId, conditions] : ConditionStore[CONDITION_SOURCE_TYPE_QUEST_AVAILABLE])
+    {
+        std::vector<uint32> questIds;
+        if (!collectQuestStates(conditions, questIds, collectQuestStates))
+            QuestsWithNonQuestStateAvailableConditions.push_back(questId);
+
+        for (uint32 conditionQuestId : questIds)
+        {
+            std::vector<uint32>& dependents = QuestStateAvailableConditionDependents[conditionQuestId];
+            if (std::find(dependents.begin(), dependents.end(), questId) == dependents.end())
+                dependents.push_back(questId);
+        }
+    }
+}
+
+std::vector<uint32> const* ConditionMgr::GetQuestStateAvailableConditionDependents(uint32 questId) const
+{
+    return Trinity::Containers::MapGetValuePtr(QuestStateAvailableConditionDependents, questId);
+}
+
 bool ConditionMgr::IsObjectMeetingSpellClickConditions(uint32 creatureId, uint32 spellId, WorldObject const* clicker, WorldObject const* target) const
 {
     ConditionEntriesByCreatureIdMap::const_iterator itr = SpellClickEventConditionStore.find(creatureId);
@@ -1153,6 +1307,16 @@ bool ConditionMgr::IsObjectMeetingVehicleSpellConditions(uint32 creatureId, uint
 }
 
 bool ConditionMgr::IsObjectMeetingSmartEventConditions(int64 entryOrGuid, uint32 eventId, uint32 sourceType, Unit const* unit, WorldObject const* baseObject) const
+{
+    if (ConditionContainer const* conditions = GetConditionsForSmartEvent(entryOrGuid, eventId, sourceType))
+    {
+        ConditionSourceInfo sourceInfo(unit, baseObject);
+        return IsObjectMeetToConditions(sourceInfo, *conditions);
+    }
+    return true;
+}
+
+ConditionContainer const* ConditionMgr::GetConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType) const
 {
     SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
     if (itr != SmartEventConditionStore.end())
@@ -1161,11 +1325,10 @@ bool ConditionMgr::IsObjectMeetingSmartEventConditions(int64 entryOrGuid, uint32
         if (i != itr->second.end())
         {
             TC_LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid {} eventId {}", entryOrGuid, eventId);
-            ConditionSourceInfo sourceInfo(unit, baseObject);
-            return IsObjectMeetToConditions(sourceInfo, i->second);
+            return &i->second;
         }
     }
-    return true;
+    return nullptr;
 }
 
 bool ConditionMgr::IsObjectMeetingVendorItemConditions(uint32 creatureId, uint32 itemId, Player const* player, Creature const* vendor) const
@@ -1259,12 +1422,13 @@ void ConditionMgr::LoadConditions(bool isReload)
         sObjectMgr->UnloadPhaseConditions();
     }
 
-    QueryResult result = WorldDatabase.Query("SELECT SourceTypeOrReferenceId, SourceGroup, SourceEntry, SourceId, ElseGroup, ConditionTypeOrReference, ConditionTarget, "
+    QueryResult result = sWorldDatabaseSnapshot->Query("SELECT SourceTypeOrReferenceId, SourceGroup, SourceEntry, SourceId, ElseGroup, ConditionTypeOrReference, ConditionTarget, "
                                              " ConditionValue1, ConditionValue2, ConditionValue3, NegativeCondition, ErrorType, ErrorTextId, ScriptName FROM conditions");
 
     if (!result)
     {
         TC_LOG_INFO("server.loading", ">> Loaded 0 conditions. DB table `conditions` is empty!");
+        ++_reloadCounter;
         return;
     }
 
@@ -1421,7 +1585,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT:
                 {
-                    SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionContainer(SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                     if (cond->ConditionType == CONDITION_AURA)
                         SpellsUsedInSpellClickConditions.insert(cond->ConditionValue1);
                     valid = true;
@@ -1433,7 +1597,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
                 {
-                    VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionContainer(VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                     valid = true;
                     ++count;
                     continue;   // do not add to m_AllocatedMemory to avoid double deleting
@@ -1442,14 +1606,14 @@ void ConditionMgr::LoadConditions(bool isReload)
                 {
                     //! TODO: PAIR_32 ?
                     std::pair<int32, uint32> key = std::make_pair(cond->SourceEntry, cond->SourceId);
-                    SmartEventConditionStore[key][cond->SourceGroup].push_back(cond);
+                    AddToConditionContainer(SmartEventConditionStore[key][cond->SourceGroup], cond);
                     valid = true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_NPC_VENDOR:
                 {
-                    NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionContainer(NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry], cond);
                     valid = true;
                     ++count;
                     continue;
@@ -1459,21 +1623,21 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_AREATRIGGER:
                 {
-                    AreaTriggerConditionContainerStore[{ cond->SourceGroup, cond->SourceEntry }].push_back(cond);
+                    AddToConditionContainer(AreaTriggerConditionContainerStore[{ cond->SourceGroup, cond->SourceEntry }], cond);
                     valid = true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_TRAINER_SPELL:
                 {
-                    TrainerSpellConditionContainerStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionContainer(TrainerSpellConditionContainerStore[cond->SourceGroup][cond->SourceEntry], cond);
                     valid = true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_OBJECT_ID_VISIBILITY:
                 {
-                    ObjectVisibilityConditionStore[{ cond->SourceGroup, uint32(cond->SourceEntry) }].push_back(cond);
+                    AddToConditionContainer(ObjectVisibilityConditionStore[{ cond->SourceGroup, uint32(cond->SourceEntry) }], cond);
                     valid = true;
                     ++count;
                     continue;
@@ -1499,11 +1663,15 @@ void ConditionMgr::LoadConditions(bool isReload)
         //add new Condition to storage based on Type/Entry
         if (cond->SourceType == CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT && cond->ConditionType == CONDITION_AURA)
             SpellsUsedInSpellClickConditions.insert(cond->ConditionValue1);
-        ConditionStore[cond->SourceType][cond->SourceEntry].push_back(cond);
+        AddToConditionContainer(ConditionStore[cond->SourceType][cond->SourceEntry], cond);
         ++count;
     }
     while (result->NextRow());
 
+    LoadQuestAvailableDependencies();
+
+    ++_reloadCounter;
+
     TC_LOG_INFO("server.loading", ">> Loaded {} conditions in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -1531,7 +1699,7 @@ bool ConditionMgr::addToGossipMenus(Condition* cond) const
         for (GossipMenusContainer::iterator itr = pMenuBounds.first; itr != pMenuBounds.second; ++itr)
         {
             if (itr->second.MenuID == cond->SourceGroup && (itr->second.TextID == uint32(cond->SourceEntry) || cond->SourceEntry == 0))
-                itr->second.Conditions.push_back(cond);
+                AddToConditionContainer(itr->second.Conditions, cond);
         }
         return true;
     }
@@ -1547,7 +1715,7 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond) const
     {
         if (gossipMenuItem.MenuID == cond->SourceGroup && gossipMenuItem.OrderIndex == uint32(cond->SourceEntry))
         {
-            gossipMenuItem.Conditions.push_back(cond);
+            AddToConditionContainer(gossipMenuItem.Conditions, cond);
             return true;
         }
     }
@@ -1664,7 +1832,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
                         break;
                     }
                 }
-                sharedList->push_back(cond);
+                AddToConditionContainer(*sharedList, cond);
                 break;
             }
         }
@@ -1688,7 +1856,7 @@ bool ConditionMgr::addToPhases(Condition* cond) const
                     {
                         if (phase.PhaseInfo->Id == cond->SourceGroup)
                         {
-                            phase.Conditions.push_back(cond);
+                            AddToConditionContainer(phase.Conditions, cond);
                             found = true;
                         }
                     }
@@ -1705,7 +1873,7 @@ bool ConditionMgr::addToPhases(Condition* cond) const
         {
             if (phase.PhaseInfo->Id == cond->SourceGroup)
             {
-                phase.Conditions.push_back(cond);
+                AddToConditionContainer(phase.Conditions, cond);
                 return true;
             }
         }
@@ -2798,6 +2966,8 @@ void ConditionMgr::Clean()
 
     SpellClickEventConditionStore.clear();
     SpellsUsedInSpellClickConditions.clear();
+    QuestStateAvailableConditionDependents.clear();
+    QuestsWithNonQuestStateAvailableConditions.clear();
 
     for (ConditionEntriesByCreatureIdMap::iterator itr = NpcVendorConditionContainerStore.begin(); itr != NpcVendorConditionContainerStore.end(); ++itr)
         for (ConditionsByEntryMap::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
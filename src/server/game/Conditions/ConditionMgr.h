@@ -21,6 +21,7 @@
 #include "Define.h"
 #include "Hash.h"
 #include <array>
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -290,22 +291,37 @@ class TC_GAME_API ConditionMgr
         static bool CanHaveSourceGroupSet(ConditionSourceType sourceType);
         static bool CanHaveSourceIdSet(ConditionSourceType sourceType);
         static bool CanHaveConditionType(ConditionSourceType sourceType, ConditionTypes conditionType);
+        // keeps conditions of each else group together, cheapest first, so that failing groups stop early
+        static void AddToConditionContainer(ConditionContainer& conditions, Condition* condition);
         bool IsObjectMeetingNotGroupedConditions(ConditionSourceType sourceType, uint32 entry, ConditionSourceInfo& sourceInfo) const;
         bool IsObjectMeetingNotGroupedConditions(ConditionSourceType sourceType, uint32 entry, WorldObject const* target0, WorldObject const* target1 = nullptr, WorldObject const* target2 = nullptr) const;
         bool IsMapMeetingNotGroupedConditions(ConditionSourceType sourceType, uint32 entry, Map const* map) const;
         bool HasConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const;
+        // mask of (1 << ConditionTypes) used by the entry including references, all bits are set for script conditions
+        uint64 GetConditionTypeMaskForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const;
         bool IsObjectMeetingSpellClickConditions(uint32 creatureId, uint32 spellId, WorldObject const* clicker, WorldObject const* target) const;
         ConditionContainer const* GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId) const;
         bool IsObjectMeetingVehicleSpellConditions(uint32 creatureId, uint32 spellId, Player const* player, Unit const* vehicle) const;
         bool IsObjectMeetingSmartEventConditions(int64 entryOrGuid, uint32 eventId, uint32 sourceType, Unit const* unit, WorldObject const* baseObject) const;
+        ConditionContainer const* GetConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType) const;
         bool IsObjectMeetingVendorItemConditions(uint32 creatureId, uint32 itemId, Player const* player, Creature const* vendor) const;
 
         bool IsSpellUsedInSpellClickConditions(uint32 spellId) const;
 
+        // quests whose CONDITION_SOURCE_TYPE_QUEST_AVAILABLE conditions check the state of questId
+        std::vector<uint32> const* GetQuestStateAvailableConditionDependents(uint32 questId) const;
+        // quests whose CONDITION_SOURCE_TYPE_QUEST_AVAILABLE conditions check anything but quest states
+        std::vector<uint32> const& GetQuestsWithNonQuestStateAvailableConditions() const { return QuestsWithNonQuestStateAvailableConditions; }
+
         ConditionContainer const* GetConditionsForAreaTrigger(uint32 areaTriggerId, bool isServerSide) const;
         bool IsObjectMeetingTrainerSpellConditions(uint32 trainerId, uint32 spellId, Player* player) const;
         bool IsObjectMeetingVisibilityByObjectIdConditions(uint32 objectType, uint32 entry, WorldObject const* seer) const;
 
+        // lets maps re-evaluate conditions not depending on players only when their inputs changed
+        void NotifyConditionTypeChanged(ConditionTypes conditionType) { ++_conditionTypeChangeCounters[conditionType]; }
+        uint32 GetConditionTypeChangeCounter(ConditionTypes conditionType) const { return _conditionTypeChangeCounters[conditionType]; }
+        uint32 GetReloadCounter() const { return _reloadCounter; }
+
         static uint32 GetPlayerConditionLfgValue(Player const* player, PlayerConditionLfgStatus status);
         static bool IsPlayerMeetingCondition(Player const* player, PlayerConditionEntry const* condition);
         static bool IsPlayerMeetingExpression(Player const* player, WorldStateExpressionEntry const* expression);
@@ -329,6 +345,8 @@ class TC_GAME_API ConditionMgr
         bool addToSpellImplicitTargetConditions(Condition* cond) const;
         bool addToPhases(Condition* cond) const;
         bool IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const;
+        uint64 GetConditionTypeMaskForConditionList(ConditionContainer const& conditions) const;
+        void LoadQuestAvailableDependencies();
 
         static void LogUselessConditionValue(Condition* cond, uint8 index, uint32 value);
 
@@ -343,9 +361,14 @@ class TC_GAME_API ConditionMgr
         SmartEventConditionContainer    SmartEventConditionStore;
 
         std::unordered_set<uint32> SpellsUsedInSpellClickConditions;
+        std::unordered_map<uint32, std::vector<uint32>> QuestStateAvailableConditionDependents;
+        std::vector<uint32> QuestsWithNonQuestStateAvailableConditions;
         ConditionEntriesByAreaTriggerIdMap AreaTriggerConditionContainerStore;
         ConditionEntriesByCreatureIdMap TrainerSpellConditionContainerStore;
         std::unordered_map<std::pair<uint32 /*object type*/, uint32 /*object id*/>, ConditionContainer> ObjectVisibilityConditionStore;
+
+        std::array<std::atomic<uint32>, CONDITION_MAX> _conditionTypeChangeCounters = { };
+        std::atomic<uint32> _reloadCounter = 0;
 };
 
 #define sConditionMgr ConditionMgr::instance()
@@ -16,6 +16,7 @@
  */
 
 #include "DB2Stores.h"
+#include "ByteBuffer.h"
 #include "Containers.h"
 #include "DatabaseEnv.h"
 #include "DB2LoadInfo.h"
@@ -25,12 +26,14 @@
 #include "Log.h"
 #include "Random.h"
 #include "Regex.h"
+#include "ThreadPool.h"
 #include "Timer.h"
 #include "Util.h"
 #include "World.h"
 #include <boost/filesystem/operations.hpp>
 #include <array>
 #include <bitset>
+#include <future>
 #include <numeric>
 #include <sstream>
 #include <cctype>
@@ -439,6 +442,18 @@ namespace
     std::array<HotfixBlobMap, TOTAL_LOCALES> _hotfixBlob;
     std::unordered_multimap<uint32 /*tableHash*/, AllowedHotfixOptionalData> _allowedHotfixOptionalData;
     std::array<std::map<HotfixBlobKey, std::vector<DB2Manager::HotfixOptionalData>>, TOTAL_LOCALES> _hotfixOptionalData;
+    std::array<HotfixBlobMap, TOTAL_LOCALES> _hotfixReplyData;
+    std::vector<DB2Manager::HotfixRecord> _generatedHotfixes;
+
+    struct HotfixReloadData
+    {
+        DB2Manager::HotfixContainer Data;
+        std::array<HotfixBlobMap, TOTAL_LOCALES> Blob;
+        std::array<HotfixBlobMap, TOTAL_LOCALES> ReplyData;
+        int32 MaxHotfixId = 0;
+    };
+
+    std::future<std::unique_ptr<HotfixReloadData>> _hotfixReload;
 
     AreaGroupMemberContainer _areaGroupMembers;
     ArtifactPowersContainer _artifactPowers;
@@ -526,8 +541,19 @@ namespace
 template<typename T>
 constexpr std::size_t GetCppRecordSize(DB2Storage<T> const&) { return sizeof(T); }
 
-void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::string>& errlist, StorageMap& stores, DB2StorageBase* storage, std::string const& db2Path,
-    LocaleConstant defaultLocale, std::size_t cppRecordSize)
+struct DB2LoadTask
+{
+    DB2LoadTask(DB2StorageBase* storage, std::size_t cppRecordSize) : Storage(storage), CppRecordSize(cppRecordSize), Loaded(false), LoadTime(0) { }
+
+    DB2StorageBase* Storage;
+    std::size_t CppRecordSize;
+    std::vector<std::string> Errors;
+    bool Loaded;
+    uint32 LoadTime;
+};
+
+bool LoadDB2(std::bitset<TOTAL_LOCALES> const& availableDb2Locales, std::vector<std::string>& errlist, DB2StorageBase* storage, std::string const& db2Path,
+    LocaleConstant defaultLocale, std::size_t cppRecordSize, bool memoryMapped)
 {
     // validate structure
     {
@@ -562,7 +588,7 @@ void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::s
 
     try
     {
-        storage->Load(db2Path + localeNames[defaultLocale] + '/', defaultLocale);
+        storage->Load(db2Path + localeNames[defaultLocale] + '/', defaultLocale, memoryMapped);
     }
     catch (std::system_error const& e)
     {
@@ -576,7 +602,7 @@ void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::s
     catch (std::exception const& e)
     {
         errlist.emplace_back(e.what());
-        return;
+        return false;
     }
 
     // load additional data and enUS strings from db
@@ -589,7 +615,7 @@ void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::s
 
         try
         {
-            storage->LoadStringsFrom((db2Path + localeNames[i] + '/'), i);
+            storage->LoadStringsFrom((db2Path + localeNames[i] + '/'), i, memoryMapped);
         }
         catch (std::system_error const& e)
         {
@@ -608,7 +634,8 @@ void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::s
         if (availableDb2Locales[i])
             storage->LoadStringsFromDB(i);
 
-    stores[storage->GetTableHash()] = storage;
+    storage->CompactIndex();
+    return true;
 }
 
 DB2Manager& DB2Manager::Instance()
@@ -642,7 +669,16 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
     if (!availableDb2Locales[defaultLocale])
         return 0;
 
-#define LOAD_DB2(store) LoadDB2(availableDb2Locales, loadErrors, _stores, &(store), db2Path, defaultLocale, GetCppRecordSize(store))
+    // every loaded locale costs a string block in every store, skip locales that nobody uses
+    if (uint32 localeMask = sWorld->getIntConfig(CONFIG_DB2_LOCALE_MASK))
+    {
+        availableDb2Locales &= std::bitset<TOTAL_LOCALES>(localeMask);
+        availableDb2Locales[defaultLocale] = true;
+    }
+
+    std::vector<DB2LoadTask> loadTasks;
+
+#define LOAD_DB2(store) loadTasks.emplace_back(&(store), GetCppRecordSize(store))
 
     LOAD_DB2(sAchievementStore);
     LOAD_DB2(sAchievementCategoryStore);
@@ -968,6 +1004,52 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
 
 #undef LOAD_DB2
 
+    // every store only touches its own data, load them concurrently and register them in declaration order afterwards
+    bool memoryMapped = sWorld->getBoolConfig(CONFIG_DB2_MEMORY_MAPPED);
+    auto loadStore = [&](DB2LoadTask& loadTask)
+    {
+        uint32 storeMSTime = getMSTime();
+        loadTask.Loaded = LoadDB2(availableDb2Locales, loadTask.Errors, loadTask.Storage, db2Path, defaultLocale, loadTask.CppRecordSize, memoryMapped);
+        loadTask.LoadTime = GetMSTimeDiffToNow(storeMSTime);
+    };
+
+    std::size_t loadThreads = sWorld->getIntConfig(CONFIG_DB2_LOAD_THREADS);
+    if (!loadThreads)
+        loadThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    if (loadThreads > 1)
+    {
+        Trinity::ThreadPool loadPool(std::min(loadThreads, loadTasks.size()));
+        std::vector<std::future<void>> results;
+        results.reserve(loadTasks.size());
+        for (DB2LoadTask& loadTask : loadTasks)
+        {
+            std::packaged_task<void()> task([&loadStore, &loadTask]() { loadStore(loadTask); });
+            results.push_back(task.get_future());
+            loadPool.PostWork(std::move(task));
+        }
+
+        loadPool.Join();
+
+        // rethrow unexpected errors the same way serial loading would
+        for (std::future<void>& result : results)
+            result.get();
+    }
+    else
+    {
+        for (DB2LoadTask& loadTask : loadTasks)
+            loadStore(loadTask);
+    }
+
+    for (DB2LoadTask& loadTask : loadTasks)
+    {
+        TC_LOG_DEBUG("server.loading", ">> Loaded DB2 store {} in {} ms", loadTask.Storage->GetFileName(), loadTask.LoadTime);
+
+        std::move(loadTask.Errors.begin(), loadTask.Errors.end(), std::back_inserter(loadErrors));
+        if (loadTask.Loaded)
+            _stores[loadTask.Storage->GetTableHash()] = loadTask.Storage;
+    }
+
     // error checks
     if (!loadErrors.empty())
     {
@@ -1639,22 +1721,26 @@ DB2StorageBase const* DB2Manager::GetStorage(uint32 type) const
     return nullptr;
 }
 
-void DB2Manager::LoadHotfixData()
+std::size_t DB2Manager::GetMemoryUsage() const
 {
-    uint32 oldMSTime = getMSTime();
+    // the derived lookup containers built in LoadStores are not included
+    std::size_t size = 0;
+    for (auto const& [tableHash, storage] : _stores)
+        size += storage->GetMemoryUsage();
 
-    QueryResult result = HotfixDatabase.Query("SELECT Id, UniqueId, TableHash, RecordId, Status FROM hotfix_data ORDER BY Id");
+    return size;
+}
 
+using HotfixRemovedRecords = std::map<std::pair<uint32 /*tableHash*/, int32 /*recordId*/>, bool /*removed*/>;
+
+static uint32 LoadHotfixRecords(DB2Manager::HotfixContainer& hotfixData, std::array<HotfixBlobMap, TOTAL_LOCALES> const& hotfixBlob, int32& maxHotfixId,
+    HotfixRemovedRecords& removedRecords)
+{
+    QueryResult result = HotfixDatabase.Query("SELECT Id, UniqueId, TableHash, RecordId, Status FROM hotfix_data ORDER BY Id");
     if (!result)
-    {
-        TC_LOG_INFO("server.loading", ">> Loaded 0 hotfix info entries.");
-        return;
-    }
+        return 0;
 
     uint32 count = 0;
-
-    std::map<std::pair<uint32, int32>, bool> deletedRecords;
-
     do
     {
         Field* fields = result->Fetch();
@@ -1663,29 +1749,39 @@ void DB2Manager::LoadHotfixData()
         uint32 uniqueId = fields[1].GetUInt32();
         uint32 tableHash = fields[2].GetUInt32();
         int32 recordId = fields[3].GetInt32();
-        HotfixRecord::Status status = static_cast<HotfixRecord::Status>(fields[4].GetUInt8());
-        if (status == HotfixRecord::Status::Valid && _stores.find(tableHash) == _stores.end())
+        DB2Manager::HotfixRecord::Status status = static_cast<DB2Manager::HotfixRecord::Status>(fields[4].GetUInt8());
+        if (status == DB2Manager::HotfixRecord::Status::Valid && _stores.find(tableHash) == _stores.end())
         {
             HotfixBlobKey key = std::make_pair(tableHash, recordId);
-            if (std::none_of(_hotfixBlob.begin(), _hotfixBlob.end(), [key](HotfixBlobMap const& blob) { return blob.find(key) != blob.end(); }))
+            if (std::none_of(hotfixBlob.begin(), hotfixBlob.end(), [key](HotfixBlobMap const& blob) { return blob.find(key) != blob.end(); }))
             {
                 TC_LOG_ERROR("sql.sql", "Table `hotfix_data` references unknown DB2 store by hash 0x{:X} and has no reference to `hotfix_blob` in hotfix id {} with RecordID: {}", tableHash, id, recordId);
                 continue;
             }
         }
 
-        _maxHotfixId = std::max(_maxHotfixId, id);
-        HotfixRecord hotfixRecord;
+        maxHotfixId = std::max(maxHotfixId, id);
+        DB2Manager::HotfixRecord hotfixRecord;
         hotfixRecord.TableHash = tableHash;
         hotfixRecord.RecordID = recordId;
         hotfixRecord.ID.PushID = id;
         hotfixRecord.ID.UniqueID = uniqueId;
         hotfixRecord.HotfixStatus = status;
-        _hotfixData[id].push_back(hotfixRecord);
-        deletedRecords[std::make_pair(tableHash, recordId)] = status == HotfixRecord::Status::RecordRemoved;
+        hotfixData[id].push_back(hotfixRecord);
+        removedRecords[std::make_pair(tableHash, recordId)] = status == DB2Manager::HotfixRecord::Status::RecordRemoved;
         ++count;
     } while (result->NextRow());
 
+    return count;
+}
+
+void DB2Manager::LoadHotfixData()
+{
+    uint32 oldMSTime = getMSTime();
+
+    HotfixRemovedRecords deletedRecords;
+    uint32 count = LoadHotfixRecords(_hotfixData, _hotfixBlob, _maxHotfixId, deletedRecords);
+
     for (auto itr = deletedRecords.begin(); itr != deletedRecords.end(); ++itr)
         if (itr->second)
             if (DB2StorageBase* store = Trinity::Containers::MapGetValuePtr(_stores, itr->first.first))
@@ -1694,17 +1790,11 @@ void DB2Manager::LoadHotfixData()
     TC_LOG_INFO("server.loading", ">> Loaded {} hotfix records in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
-void DB2Manager::LoadHotfixBlob(uint32 localeMask)
+static uint32 LoadHotfixBlobRecords(std::array<HotfixBlobMap, TOTAL_LOCALES>& hotfixBlob, uint32 localeMask)
 {
-    uint32 oldMSTime = getMSTime();
-
     QueryResult result = HotfixDatabase.Query("SELECT TableHash, RecordId, locale, `Blob` FROM hotfix_blob ORDER BY TableHash");
-
     if (!result)
-    {
-        TC_LOG_INFO("server.loading", ">> Loaded 0 hotfix blob entries.");
-        return;
-    }
+        return 0;
 
     std::bitset<TOTAL_LOCALES> availableDb2Locales = localeMask;
     uint32 hotfixBlobCount = 0;
@@ -1734,10 +1824,19 @@ void DB2Manager::LoadHotfixBlob(uint32 localeMask)
         if (!availableDb2Locales[locale])
             continue;
 
-        _hotfixBlob[locale][std::make_pair(tableHash, recordId)] = fields[3].GetBinary();
+        hotfixBlob[locale][std::make_pair(tableHash, recordId)] = fields[3].GetBinary();
         hotfixBlobCount++;
     } while (result->NextRow());
 
+    return hotfixBlobCount;
+}
+
+void DB2Manager::LoadHotfixBlob(uint32 localeMask)
+{
+    uint32 oldMSTime = getMSTime();
+
+    uint32 hotfixBlobCount = LoadHotfixBlobRecords(_hotfixBlob, localeMask);
+
     TC_LOG_INFO("server.loading", ">> Loaded {} hotfix blob records in {} ms", hotfixBlobCount, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -1823,6 +1922,108 @@ void DB2Manager::LoadHotfixOptionalData(uint32 localeMask)
     TC_LOG_INFO("server.loading", ">> Loaded {} hotfix optional data records in {} ms", hotfixOptionalDataCount, GetMSTimeDiffToNow(oldMSTime));
 }
 
+static uint32 SerializeHotfixRecords(std::array<HotfixBlobMap, TOTAL_LOCALES>& hotfixReplyData, DB2Manager::HotfixContainer const& hotfixData, uint32 localeMask)
+{
+    std::bitset<TOTAL_LOCALES> availableDb2Locales = localeMask;
+    uint32 replyDataCount = 0;
+    for (auto const& [pushId, hotfixRecords] : hotfixData)
+    {
+        for (DB2Manager::HotfixRecord const& hotfixRecord : hotfixRecords)
+        {
+            if (hotfixRecord.HotfixStatus != DB2Manager::HotfixRecord::Status::Valid)
+                continue;
+
+            // records only present in hotfix_blob are already stored serialized
+            DB2StorageBase const* storage = sDB2Manager.GetStorage(hotfixRecord.TableHash);
+            if (!storage || !storage->HasRecord(uint32(hotfixRecord.RecordID)))
+                continue;
+
+            for (uint32 locale = 0; locale < TOTAL_LOCALES; ++locale)
+            {
+                if (!availableDb2Locales[locale])
+                    continue;
+
+                auto [itr, inserted] = hotfixReplyData[locale].try_emplace(std::make_pair(hotfixRecord.TableHash, hotfixRecord.RecordID));
+                if (!inserted)
+                    continue;
+
+                ByteBuffer buffer;
+                sDB2Manager.WriteRecordWithOptionalData(*storage, uint32(hotfixRecord.RecordID), LocaleConstant(locale), buffer);
+                if (!buffer.empty())
+                    itr->second.assign(buffer.contents(), buffer.contents() + buffer.size());
+
+                ++replyDataCount;
+            }
+        }
+    }
+
+    return replyDataCount;
+}
+
+void DB2Manager::InitializeHotfixReplyData(uint32 localeMask)
+{
+    uint32 oldMSTime = getMSTime();
+
+    for (HotfixBlobMap& replyData : _hotfixReplyData)
+        replyData.clear();
+
+    uint32 replyDataCount = SerializeHotfixRecords(_hotfixReplyData, _hotfixData, localeMask);
+
+    TC_LOG_INFO("server.loading", ">> Serialized {} hotfix records in {} ms", replyDataCount, GetMSTimeDiffToNow(oldMSTime));
+}
+
+bool DB2Manager::ReloadHotfixesAsync(uint32 localeMask)
+{
+    if (_hotfixReload.valid())
+        return false;
+
+    bool serializeRecords = sWorld->getBoolConfig(CONFIG_CACHE_DATA_QUERIES);
+    std::vector<HotfixRecord> generatedHotfixes = _generatedHotfixes;
+
+    // only reads the loaded stores, which never change after startup
+    _hotfixReload = std::async(std::launch::async, [localeMask, serializeRecords, generatedHotfixes = std::move(generatedHotfixes)]()
+    {
+        uint32 oldMSTime = getMSTime();
+
+        std::unique_ptr<HotfixReloadData> reload = std::make_unique<HotfixReloadData>();
+        uint32 blobCount = LoadHotfixBlobRecords(reload->Blob, localeMask);
+
+        HotfixRemovedRecords removedRecords;
+        uint32 count = LoadHotfixRecords(reload->Data, reload->Blob, reload->MaxHotfixId, removedRecords);
+        for (auto const& [key, removed] : removedRecords)
+            if (removed)
+                if (DB2StorageBase const* store = Trinity::Containers::MapGetValuePtr(_stores, key.first))
+                    if (store->HasRecord(uint32(key.second)))
+                        TC_LOG_ERROR("server.loading", "Hotfix removing record {} from DB2 store {} requires a restart to take effect on server side", key.second, store->GetFileName());
+
+        for (HotfixRecord hotfixRecord : generatedHotfixes)
+        {
+            hotfixRecord.ID.PushID = ++reload->MaxHotfixId;
+            reload->Data[hotfixRecord.ID.PushID].push_back(hotfixRecord);
+        }
+
+        if (serializeRecords)
+            SerializeHotfixRecords(reload->ReplyData, reload->Data, localeMask);
+
+        TC_LOG_INFO("server.loading", ">> Reloaded {} hotfix records and {} hotfix blob records in {} ms", count, blobCount, GetMSTimeDiffToNow(oldMSTime));
+        return reload;
+    });
+
+    return true;
+}
+
+void DB2Manager::PublishReloadedHotfixes()
+{
+    if (!_hotfixReload.valid() || _hotfixReload.wait_for(0s) != std::future_status::ready)
+        return;
+
+    std::unique_ptr<HotfixReloadData> reload = _hotfixReload.get();
+    _hotfixData = std::move(reload->Data);
+    _hotfixBlob = std::move(reload->Blob);
+    _hotfixReplyData = std::move(reload->ReplyData);
+    _maxHotfixId = reload->MaxHotfixId;
+}
+
 uint32 DB2Manager::GetHotfixCount() const
 {
     return _hotfixData.size();
@@ -1847,6 +2048,27 @@ std::vector<DB2Manager::HotfixOptionalData> const* DB2Manager::GetHotfixOptional
     return Trinity::Containers::MapGetValuePtr(_hotfixOptionalData[locale], std::make_pair(tableHash, recordId));
 }
 
+std::vector<uint8> const* DB2Manager::GetHotfixReplyData(uint32 tableHash, int32 recordId, LocaleConstant locale) const
+{
+    ASSERT(IsValidLocale(locale), "Locale %u is invalid locale", uint32(locale));
+
+    return Trinity::Containers::MapGetValuePtr(_hotfixReplyData[locale], std::make_pair(tableHash, recordId));
+}
+
+void DB2Manager::WriteRecordWithOptionalData(DB2StorageBase const& storage, uint32 recordId, LocaleConstant locale, ByteBuffer& buffer) const
+{
+    storage.WriteRecord(recordId, locale, buffer);
+
+    if (std::vector<HotfixOptionalData> const* optionalDataEntries = GetHotfixOptionalData(storage.GetTableHash(), recordId, locale))
+    {
+        for (HotfixOptionalData const& optionalData : *optionalDataEntries)
+        {
+            buffer << uint32(optionalData.Key);
+            buffer.append(optionalData.Data.data(), optionalData.Data.size());
+        }
+    }
+}
+
 uint32 DB2Manager::GetEmptyAnimStateID() const
 {
     return sAnimationDataStore.GetNumRows();
@@ -1860,6 +2082,7 @@ void DB2Manager::InsertNewHotfix(uint32 tableHash, uint32 recordId)
     hotfixRecord.ID.PushID = ++_maxHotfixId;
     hotfixRecord.ID.UniqueID = rand32();
     _hotfixData[hotfixRecord.ID.PushID].push_back(hotfixRecord);
+    _generatedHotfixes.push_back(hotfixRecord);
 }
 
 std::vector<uint32> DB2Manager::GetAreasForGroup(uint32 areaGroupId) const
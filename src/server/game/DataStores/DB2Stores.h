@@ -383,14 +383,24 @@ public:
 
     uint32 LoadStores(std::string const& dataPath, LocaleConstant defaultLocale);
     DB2StorageBase const* GetStorage(uint32 type) const;
+    std::size_t GetMemoryUsage() const;
 
     void LoadHotfixData();
     void LoadHotfixBlob(uint32 localeMask);
     void LoadHotfixOptionalData(uint32 localeMask);
+    void InitializeHotfixReplyData(uint32 localeMask);
+    /// Loads `hotfix_data` and `hotfix_blob` again in a background thread, false if a reload is already in progress
+    bool ReloadHotfixesAsync(uint32 localeMask);
+    /// Replaces the hotfix data once ReloadHotfixesAsync is done, must not be called while query packets are processed
+    void PublishReloadedHotfixes();
     uint32 GetHotfixCount() const;
     HotfixContainer const& GetHotfixData() const;
     std::vector<uint8> const* GetHotfixBlobData(uint32 tableHash, int32 recordId, LocaleConstant locale) const;
     std::vector<HotfixOptionalData> const* GetHotfixOptionalData(uint32 tableHash, int32 recordId, LocaleConstant locale) const;
+    /// Record content of a valid hotfix serialized by InitializeHotfixReplyData, nullptr when not cached
+    std::vector<uint8> const* GetHotfixReplyData(uint32 tableHash, int32 recordId, LocaleConstant locale) const;
+    /// Writes the record followed by its optional hotfix data, as sent to clients in hotfix and db query replies
+    void WriteRecordWithOptionalData(DB2StorageBase const& storage, uint32 recordId, LocaleConstant locale, ByteBuffer& buffer) const;
 
     uint32 GetEmptyAnimStateID() const;
     std::vector<uint32> GetAreasForGroup(uint32 areaGroupId) const;
@@ -35,6 +35,7 @@
 #include "RBAC.h"
 #include "SharedDefines.h"
 #include "SocialMgr.h"
+#include "ThreadPool.h"
 #include "World.h"
 #include "WorldSession.h"
 #include <sstream>
@@ -62,6 +63,9 @@ LFGMgr::LFGMgr() : m_QueueTimer(0), m_lfgProposalId(1),
 
 LFGMgr::~LFGMgr()
 {
+    if (AsyncMatchResult.valid())
+        AsyncMatchResult.wait();
+
     for (LfgRewardContainer::iterator itr = RewardMapStore.begin(); itr != RewardMapStore.end(); ++itr)
         delete itr->second;
 }
@@ -341,16 +345,22 @@ void LFGMgr::Update(uint32 diff)
 
     uint32 lastProposalId = m_lfgProposalId;
     // Check if a proposal can be formed with the new groups being added
-    for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
-        if (uint8 newProposals = it->second.FindGroups())
-            TC_LOG_DEBUG("lfg.update", "Found {} new groups in queue {}", newProposals, it->first);
+    if (sWorld->getBoolConfig(CONFIG_LFG_ASYNC_MATCHING) || AsyncMatchResult.valid())
+        UpdateAsyncMatching();
+    else
+    {
+        for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
+            if (uint8 newProposals = it->second.FindGroups())
+                TC_LOG_DEBUG("lfg.update", "Found {} new groups in queue {}", newProposals, it->first);
+    }
 
     if (lastProposalId != m_lfgProposalId)
     {
-        // FIXME lastProposalId ? lastProposalId +1 ?
-        for (LfgProposalContainer::const_iterator itProposal = ProposalsStore.find(m_lfgProposalId); itProposal != ProposalsStore.end(); ++itProposal)
+        // UpdateProposal can remove the proposal it is called for
+        for (LfgProposalContainer::const_iterator itProposal = ProposalsStore.upper_bound(lastProposalId); itProposal != ProposalsStore.end();)
         {
             uint32 proposalId = itProposal->first;
+            ++itProposal;
             LfgProposal& proposal = ProposalsStore[proposalId];
 
             ObjectGuid guid;
@@ -1035,6 +1045,86 @@ void LFGMgr::MakeNewGroup(LfgProposal const& proposal)
     grp->SendUpdate();
 }
 
+/**
+   Adds the proposals of a finished async match and starts matching queues with new groups on AsyncMatchPool.
+   Queues are copied with the LFGMgr data matching reads, the world thread keeps changing the originals meanwhile
+*/
+void LFGMgr::UpdateAsyncMatching()
+{
+    if (AsyncMatchResult.valid())
+    {
+        if (AsyncMatchResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+
+        AsyncMatchResult.get();
+        for (LfgAsyncMatch& match : AsyncMatches)
+        {
+            QueuesStore[match.queueId].FinishAsyncMatch(match.matcher, match.proposals);
+            for (LfgProposal& proposal : match.proposals)
+                AddProposal(proposal);
+
+            if (!match.proposals.empty())
+                TC_LOG_DEBUG("lfg.update", "Found {} new groups in queue {}", uint32(match.proposals.size()), match.queueId);
+        }
+
+        AsyncMatches.clear();
+    }
+
+    if (!sWorld->getBoolConfig(CONFIG_LFG_ASYNC_MATCHING))
+        return;
+
+    for (auto& [queueId, queue] : QueuesStore)
+    {
+        if (!queue.HasNewToQueue())
+            continue;
+
+        LfgAsyncMatch& match = AsyncMatches.emplace_back();
+        match.queueId = queueId;
+        queue.StartAsyncMatch(match.matcher);
+        BuildMatchSnapshot(match.matcher.GetQueueData(), match.snapshot);
+    }
+
+    if (AsyncMatches.empty())
+        return;
+
+    if (!AsyncMatchPool)
+        AsyncMatchPool = std::make_unique<Trinity::ThreadPool>(1);
+
+    std::packaged_task<void()> task([matches = &AsyncMatches]()
+    {
+        for (LfgAsyncMatch& match : *matches)
+            match.matcher.FindGroups(match.snapshot, match.proposals);
+    });
+
+    AsyncMatchResult = task.get_future();
+    AsyncMatchPool->PostWork(std::move(task));
+}
+
+void LFGMgr::BuildMatchSnapshot(LfgQueueDataContainer const& queueData, LfgMatchSnapshot& snapshot)
+{
+    for (auto const& [guid, data] : queueData)
+    {
+        snapshot.States[guid] = GetState(guid);
+        snapshot.OldStates[guid] = GetOldState(guid);
+        if (IsLfgGroup(guid))
+            snapshot.LfgGroups.insert(guid);
+
+        for (auto const& [playerGuid, roles] : data.roles)
+        {
+            Player* player = ObjectAccessor::FindConnectedPlayer(playerGuid);
+            if (!player)
+                continue;
+
+            snapshot.AccountGuids[playerGuid] = player->GetSession()->GetAccountGUID();
+
+            LfgMatchIgnores ignores;
+            player->GetSocial()->GetIgnoreList(ignores.Characters, ignores.Accounts);
+            if (!ignores.Characters.empty() || !ignores.Accounts.empty())
+                snapshot.Ignores[playerGuid] = std::move(ignores);
+        }
+    }
+}
+
 uint32 LFGMgr::AddProposal(LfgProposal& proposal)
 {
     proposal.id = ++m_lfgProposalId;
@@ -24,6 +24,7 @@
 #include "LFGQueue.h"
 #include "LFGGroupData.h"
 #include "LFGPlayerData.h"
+#include <future>
 #include <unordered_map>
 
 class Group;
@@ -41,6 +42,11 @@ namespace WorldPackets
     }
 }
 
+namespace Trinity
+{
+class ThreadPool;
+}
+
 namespace lfg
 {
 
@@ -311,6 +317,15 @@ struct LFGDungeonData
     uint32 Entry() const { return id + (type << 24); }
 };
 
+/// Queue copy and snapshot matched on the async matching thread
+struct LfgAsyncMatch
+{
+    uint8 queueId = 0;
+    LFGQueue matcher;
+    LfgMatchSnapshot snapshot;
+    std::vector<LfgProposal> proposals;
+};
+
 class TC_GAME_API LFGMgr
 {
     private:
@@ -462,6 +477,10 @@ class TC_GAME_API LFGMgr
         void _SaveToDB(ObjectGuid guid, uint32 db_guid);
         LFGDungeonData const* GetLFGDungeon(uint32 id);
 
+        // Matching on a worker thread
+        void UpdateAsyncMatching();
+        void BuildMatchSnapshot(LfgQueueDataContainer const& queueData, LfgMatchSnapshot& snapshot);
+
         // Proposals
         void RemoveProposal(LfgProposalContainer::iterator itProposal, LfgUpdateType type);
         void MakeNewGroup(LfgProposal const& proposal);
@@ -497,6 +516,10 @@ class TC_GAME_API LFGMgr
         LfgPlayerBootContainer BootsStore;                 /// Current player kicks
         LfgPlayerDataContainer PlayersStore;               /// Player data
         LfgGroupDataContainer GroupsStore;                 /// Group data
+        // Async matching
+        std::vector<LfgAsyncMatch> AsyncMatches;           /// Queues being matched on AsyncMatchPool
+        std::future<void> AsyncMatchResult;
+        std::unique_ptr<Trinity::ThreadPool> AsyncMatchPool;
 };
 
 } // namespace lfg
@@ -19,6 +19,7 @@
 #include "Containers.h"
 #include "GameTime.h"
 #include "Group.h"
+#include "Hash.h"
 #include "LFGMgr.h"
 #include "Log.h"
 #include <sstream>
@@ -26,30 +27,45 @@
 namespace lfg
 {
 
-/**
-   Given a list of guids returns the concatenation using | as delimiter
-
-   @param[in]     check list of guids
-   @returns Concatenated string
-*/
-std::string ConcatenateGuids(GuidList const& check)
+LfgCompatibilityKey::LfgCompatibilityKey(GuidList const& check) : Size(0)
 {
-    if (check.empty())
-        return "";
+    ASSERT(check.size() <= Guids.size());
+
+    for (ObjectGuid guid : check)
+        Guids[Size++] = guid;
 
     // need the guids in order to avoid duplicates
-    GuidSet guids(check.begin(), check.end());
+    std::sort(Guids.begin(), Guids.begin() + Size);
+    std::fill(Guids.begin() + Size, Guids.end(), ObjectGuid::Empty);
+}
 
-    std::ostringstream o;
+bool LfgCompatibilityKey::Contains(ObjectGuid guid) const
+{
+    return std::find(Guids.begin(), Guids.begin() + Size, guid) != Guids.begin() + Size;
+}
 
-    GuidSet::const_iterator it = guids.begin();
-    o << it->ToHexString();
-    for (++it; it != guids.end(); ++it)
-        o << '|' << it->ToHexString();
+std::string LfgCompatibilityKey::ToString() const
+{
+    std::ostringstream o;
+    for (uint8 i = 0; i < Size; ++i)
+    {
+        if (i)
+            o << '|';
+        o << Guids[i].ToHexString();
+    }
 
     return o.str();
 }
 
+std::size_t LfgCompatibilityKeyHash::operator()(LfgCompatibilityKey const& key) const
+{
+    std::size_t hashVal = 0;
+    for (uint8 i = 0; i < key.Size; ++i)
+        Trinity::hash_combine(hashVal, key.Guids[i]);
+
+    return hashVal;
+}
+
 char const* GetCompatibleString(LfgCompatibility compatibles)
 {
     switch (compatibles)
@@ -79,6 +95,47 @@ char const* GetCompatibleString(LfgCompatibility compatibles)
     }
 }
 
+bool LfgMatchSnapshot::AllQueued(GuidList const& check) const
+{
+    if (check.empty())
+        return false;
+
+    for (ObjectGuid guid : check)
+    {
+        LfgState const* state = Trinity::Containers::MapGetValuePtr(States, guid);
+        if (!state || *state != LFG_STATE_QUEUED)
+            return false;
+    }
+
+    return true;
+}
+
+bool LfgMatchSnapshot::HasIgnore(ObjectGuid guid1, ObjectGuid guid2) const
+{
+    ObjectGuid const* account1 = Trinity::Containers::MapGetValuePtr(AccountGuids, guid1);
+    ObjectGuid const* account2 = Trinity::Containers::MapGetValuePtr(AccountGuids, guid2);
+    if (!account1 || !account2)
+        return false;
+
+    if (LfgMatchIgnores const* ignores = Trinity::Containers::MapGetValuePtr(Ignores, guid1))
+        if (ignores->Characters.contains(guid2) || ignores->Accounts.contains(*account2))
+            return true;
+
+    if (LfgMatchIgnores const* ignores = Trinity::Containers::MapGetValuePtr(Ignores, guid2))
+        if (ignores->Characters.contains(guid1) || ignores->Accounts.contains(*account1))
+            return true;
+
+    return false;
+}
+
+LfgState LfgMatchSnapshot::GetOldState(ObjectGuid guid) const
+{
+    if (LfgState const* state = Trinity::Containers::MapGetValuePtr(OldStates, guid))
+        return *state;
+
+    return LFG_STATE_NONE;
+}
+
 LfgQueueData::LfgQueueData() : joinTime(GameTime::GetGameTime()), tanks(LFG_TANKS_NEEDED),
 healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED)
 { }
@@ -137,19 +194,20 @@ void LFGQueue::AddToQueue(ObjectGuid guid, bool reAdd)
 
 void LFGQueue::RemoveFromQueue(ObjectGuid guid)
 {
+    if (_asyncMatchInFlight)
+        _removedDuringAsyncMatch.insert(guid);
+
     RemoveFromNewQueue(guid);
     RemoveFromCurrentQueue(guid);
     RemoveFromCompatibles(guid);
 
-    std::string sguid = guid.ToHexString();
-
     LfgQueueDataContainer::iterator itDelete = QueueDataStore.end();
     for (LfgQueueDataContainer::iterator itr = QueueDataStore.begin(); itr != QueueDataStore.end(); ++itr)
         if (itr->first != guid)
         {
-            if (std::string::npos != itr->second.bestCompatible.find(sguid))
+            if (itr->second.bestCompatible.Contains(guid))
             {
-                itr->second.bestCompatible.clear();
+                itr->second.bestCompatible = LfgCompatibilityKey();
                 FindBestCompatibleInQueue(itr);
             }
         }
@@ -233,30 +291,23 @@ void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
 */
 void LFGQueue::RemoveFromCompatibles(ObjectGuid guid)
 {
-    std::string strGuid = guid.ToHexString();
-
     TC_LOG_DEBUG("lfg.queue.data.compatibles.remove", "Removing {}", guid.ToString());
-    for (LfgCompatibleContainer::iterator itNext = CompatibleMapStore.begin(); itNext != CompatibleMapStore.end();)
-    {
-        LfgCompatibleContainer::iterator it = itNext++;
-        if (std::string::npos != it->first.find(strGuid))
-            CompatibleMapStore.erase(it);
-    }
+    std::erase_if(CompatibleMapStore, [guid](LfgCompatibleContainer::value_type const& compatible) { return compatible.first.Contains(guid); });
 }
 
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted guids
    @param[in]     compatibles type of compatibility
 */
-void LFGQueue::SetCompatibles(std::string const& key, LfgCompatibility compatibles)
+void LFGQueue::SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles)
 {
     LfgCompatibilityData& data = CompatibleMapStore[key];
     data.compatibility = compatibles;
 }
 
-void LFGQueue::SetCompatibilityData(std::string const& key, LfgCompatibilityData const& data)
+void LFGQueue::SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& data)
 {
     CompatibleMapStore[key] = data;
 }
@@ -264,10 +315,10 @@ void LFGQueue::SetCompatibilityData(std::string const& key, LfgCompatibilityData
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted guids
    @return LfgCompatibility type of compatibility
 */
-LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
+LfgCompatibility LFGQueue::GetCompatibles(LfgCompatibilityKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -276,7 +327,7 @@ LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
     return LFG_COMPATIBILITY_PENDING;
 }
 
-LfgCompatibilityData* LFGQueue::GetCompatibilityData(std::string const& key)
+LfgCompatibilityData* LFGQueue::GetCompatibilityData(LfgCompatibilityKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -310,6 +361,149 @@ uint8 LFGQueue::FindGroups()
     return proposals;
 }
 
+/**
+   Runs FindGroups on a matcher copy prepared by StartAsyncMatch, reading LFGMgr data from snapshot
+
+   @param[in]     snapshot LFGMgr data of queued players and groups
+   @param[out]    proposals Proposals formed, added to LFGMgr by FinishAsyncMatch
+   @return Number of proposals formed
+*/
+uint8 LFGQueue::FindGroups(LfgMatchSnapshot const& snapshot, std::vector<LfgProposal>& proposals)
+{
+    _matchSnapshot = &snapshot;
+    _matchProposals = &proposals;
+    uint8 newProposals = FindGroups();
+    _matchSnapshot = nullptr;
+    _matchProposals = nullptr;
+    return newProposals;
+}
+
+/**
+   Copies the queue into matcher and lends it the compatibility cache until FinishAsyncMatch
+
+   @param[out]    matcher Queue copy to be used by the worker thread
+*/
+void LFGQueue::StartAsyncMatch(LFGQueue& matcher)
+{
+    ASSERT(!_asyncMatchInFlight);
+
+    matcher.QueueDataStore = QueueDataStore;
+    matcher.currentQueueStore = currentQueueStore;
+    matcher.newToQueueStore = newToQueueStore;
+    matcher.CompatibleMapStore = std::move(CompatibleMapStore);
+    CompatibleMapStore.clear();
+
+    _asyncMatchInFlight = true;
+    _asyncMatchNewToQueue = newToQueueStore;
+    _removedDuringAsyncMatch.clear();
+}
+
+/**
+   Takes back the results of matcher. Proposals that are no longer valid are dropped,
+   groups in the remaining ones are removed from this queue
+
+   @param[in]     matcher Queue copy the worker thread matched in
+   @param[in,out] proposals Proposals formed by the worker thread, on return the ones to add to LFGMgr
+*/
+void LFGQueue::FinishAsyncMatch(LFGQueue& matcher, std::vector<LfgProposal>& proposals)
+{
+    ASSERT(_asyncMatchInFlight);
+    _asyncMatchInFlight = false;
+
+    // cached results involving groups that left meanwhile are outdated
+    CompatibleMapStore = std::move(matcher.CompatibleMapStore);
+    if (!_removedDuringAsyncMatch.empty())
+        std::erase_if(CompatibleMapStore, [&](LfgCompatibleContainer::value_type const& compatible)
+        {
+            return std::any_of(compatible.first.Guids.begin(), compatible.first.Guids.begin() + compatible.first.Size,
+                [&](ObjectGuid guid) { return _removedDuringAsyncMatch.contains(guid); });
+        });
+
+    for (auto const& [guid, matcherData] : matcher.QueueDataStore)
+    {
+        if (_removedDuringAsyncMatch.contains(guid))
+            continue;
+
+        if (LfgQueueData* queueData = Trinity::Containers::MapGetValuePtr(QueueDataStore, guid))
+        {
+            queueData->bestCompatible = matcherData.bestCompatible;
+            queueData->tanks = matcherData.tanks;
+            queueData->healers = matcherData.healers;
+            queueData->dps = matcherData.dps;
+        }
+    }
+
+    GuidSet dropped;
+    for (auto itr = proposals.begin(); itr != proposals.end();)
+    {
+        bool valid = std::none_of(itr->queues.begin(), itr->queues.end(), [&](ObjectGuid guid)
+        {
+            return _removedDuringAsyncMatch.contains(guid) || !QueueDataStore.contains(guid);
+        }) && sLFGMgr->AllQueued(itr->queues);
+
+        if (!valid)
+        {
+            TC_LOG_DEBUG("lfg.queue.match.async", "Guids: ({}) proposal dropped, queue changed while matching", GetDetailedMatchRoles(itr->queues));
+            CompatibleMapStore.erase(LfgCompatibilityKey(itr->queues));
+            dropped.insert(itr->queues.begin(), itr->queues.end());
+            itr = proposals.erase(itr);
+            continue;
+        }
+
+        for (ObjectGuid guid : itr->queues)
+        {
+            RemoveFromNewQueue(guid);
+            RemoveFromCurrentQueue(guid);
+        }
+
+        ++itr;
+    }
+
+    // checked new groups that did not get a proposal join the main queue, same as in FindGroups
+    for (ObjectGuid guid : _asyncMatchNewToQueue)
+    {
+        if (_removedDuringAsyncMatch.contains(guid) || dropped.contains(guid))
+            continue;
+
+        if (std::find(newToQueueStore.begin(), newToQueueStore.end(), guid) == newToQueueStore.end())
+            continue;
+
+        RemoveFromNewQueue(guid);
+        AddToCurrentQueue(guid);
+    }
+
+    _asyncMatchNewToQueue.clear();
+    _removedDuringAsyncMatch.clear();
+}
+
+bool LFGQueue::AllQueued(GuidList const& check) const
+{
+    return _matchSnapshot ? _matchSnapshot->AllQueued(check) : sLFGMgr->AllQueued(check);
+}
+
+bool LFGQueue::IsLfgGroup(ObjectGuid guid) const
+{
+    return _matchSnapshot ? _matchSnapshot->IsLfgGroup(guid) : sLFGMgr->IsLfgGroup(guid);
+}
+
+bool LFGQueue::HasIgnore(ObjectGuid guid1, ObjectGuid guid2) const
+{
+    return _matchSnapshot ? _matchSnapshot->HasIgnore(guid1, guid2) : LFGMgr::HasIgnore(guid1, guid2);
+}
+
+LfgState LFGQueue::GetOldState(ObjectGuid guid) const
+{
+    return _matchSnapshot ? _matchSnapshot->GetOldState(guid) : sLFGMgr->GetOldState(guid);
+}
+
+void LFGQueue::AddProposal(LfgProposal& proposal)
+{
+    if (_matchProposals)
+        _matchProposals->push_back(proposal);
+    else
+        sLFGMgr->AddProposal(proposal);
+}
+
 /**
    Checks que main queue to try to form a Lfg group. Returns first match found (if any)
 
@@ -319,17 +513,17 @@ uint8 LFGQueue::FindGroups()
 */
 LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 {
-    std::string strGuids = ConcatenateGuids(check);
-    LfgCompatibility compatibles = GetCompatibles(strGuids);
+    LfgCompatibilityKey key(check);
+    LfgCompatibility compatibles = GetCompatibles(key);
 
     TC_LOG_DEBUG("lfg.queue.match.check", "Guids: ({}): {} - all({})", GetDetailedMatchRoles(check), GetCompatibleString(compatibles), GetDetailedMatchRoles(all));
     if (compatibles == LFG_COMPATIBILITY_PENDING) // Not previously cached, calculate
         compatibles = CheckCompatibility(check);
 
-    if (compatibles == LFG_COMPATIBLES_BAD_STATES && sLFGMgr->AllQueued(check))
+    if (compatibles == LFG_COMPATIBLES_BAD_STATES && AllQueued(check))
     {
         TC_LOG_DEBUG("lfg.queue.match.check", "Guids: ({}) compatibles (cached) changed from bad states to match", GetDetailedMatchRoles(check));
-        SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+        SetCompatibles(key, LFG_COMPATIBLES_MATCH);
         return LFG_COMPATIBLES_MATCH;
     }
 
@@ -357,7 +551,6 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 */
 LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 {
-    std::string strGuids = ConcatenateGuids(check);
     LfgProposal proposal;
     LfgDungeonSet proposalDungeons;
     LfgGroupsMap proposalGroups;
@@ -370,6 +563,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
     }
 
+    LfgCompatibilityKey key(check);
+
     // Check all-but-new compatiblitity
     if (check.size() > 2)
     {
@@ -380,8 +575,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         LfgCompatibility child_compatibles = CheckCompatibility(check);
         if (child_compatibles < LFG_COMPATIBLES_WITH_LESS_PLAYERS) // Group not compatible
         {
-            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) child {} not compatibles", strGuids, GetDetailedMatchRoles(check));
-            SetCompatibles(strGuids, child_compatibles);
+            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) child {} not compatibles", key.ToString(), GetDetailedMatchRoles(check));
+            SetCompatibles(key, child_compatibles);
             return child_compatibles;
         }
         check.push_front(frontGuid);
@@ -407,7 +602,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 
         numPlayers += itQueue->second.roles.size();
 
-        if (sLFGMgr->IsLfgGroup(guid))
+        if (IsLfgGroup(guid))
         {
             if (!numLfgGroups)
                 proposal.group = guid;
@@ -425,22 +620,22 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         data.roles = itQueue->second.roles;
         LFGMgr::CheckGroupRoles(data.roles);
 
-        UpdateBestCompatibleInQueue(itQueue, strGuids, data.roles);
-        SetCompatibilityData(strGuids, data);
+        UpdateBestCompatibleInQueue(itQueue, key, data.roles);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
     if (numLfgGroups > 1)
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) More than one Lfggroup ({})", GetDetailedMatchRoles(check), numLfgGroups);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
+        SetCompatibles(key, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
         return LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS;
     }
 
     if (numPlayers > MAX_GROUP_SIZE)
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) Too many players ({})", GetDetailedMatchRoles(check), numPlayers);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
+        SetCompatibles(key, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
         return LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS;
     }
 
@@ -457,7 +652,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
                 {
                     if (itRoles->first == itPlayer->first)
                         TC_LOG_ERROR("lfg.queue.match.compatibility.check", "Guids: ERROR! Player multiple times in queue! [{}]", itRoles->first.ToString());
-                    else if (sLFGMgr->HasIgnore(itRoles->first, itPlayer->first))
+                    else if (HasIgnore(itRoles->first, itPlayer->first))
                         break;
                 }
                 if (itPlayer == proposalRoles.end())
@@ -468,11 +663,16 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         if (uint8 playersize = numPlayers - proposalRoles.size())
         {
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) not compatible, {} players are ignoring each other", GetDetailedMatchRoles(check), playersize);
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_HAS_IGNORES);
+            SetCompatibles(key, LFG_INCOMPATIBLES_HAS_IGNORES);
             return LFG_INCOMPATIBLES_HAS_IGNORES;
         }
 
-        LfgRolesMap debugRoles = proposalRoles;
+        // CheckGroupRoles overwrites the roles, keep the requested ones only when they are logged
+        bool logRoles = sLog->ShouldLog("lfg.queue.match.compatibility.check", LOG_LEVEL_DEBUG);
+        LfgRolesMap debugRoles;
+        if (logRoles)
+            debugRoles = proposalRoles;
+
         if (!LFGMgr::CheckGroupRoles(proposalRoles))
         {
             std::ostringstream o;
@@ -480,7 +680,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
                 o << ", " << it->first.ToHexString() << ": " << GetRolesString(it->second);
 
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) Roles not compatible{}", GetDetailedMatchRoles(check), o.str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_ROLES);
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_ROLES);
             return LFG_INCOMPATIBLES_NO_ROLES;
         }
 
@@ -500,7 +700,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         if (proposalDungeons.empty())
         {
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) No compatible dungeons{}", GetDetailedMatchRoles(check), o.str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_DUNGEONS);
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_DUNGEONS);
             return LFG_INCOMPATIBLES_NO_DUNGEONS;
         }
     }
@@ -521,20 +721,20 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         data.roles = proposalRoles;
 
         for (GuidList::const_iterator itr = check.begin(); itr != check.end(); ++itr)
-            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), strGuids, data.roles);
+            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), key, data.roles);
 
-        SetCompatibilityData(strGuids, data);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
     ObjectGuid gguid = *check.begin();
     proposal.queues = check;
-    proposal.isNew = numLfgGroups != 1 || sLFGMgr->GetOldState(gguid) != LFG_STATE_DUNGEON;
+    proposal.isNew = numLfgGroups != 1 || GetOldState(gguid) != LFG_STATE_DUNGEON;
 
-    if (!sLFGMgr->AllQueued(check))
+    if (!AllQueued(check))
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) Group MATCH but can't create proposal!", GetDetailedMatchRoles(check));
-        SetCompatibles(strGuids, LFG_COMPATIBLES_BAD_STATES);
+        SetCompatibles(key, LFG_COMPATIBLES_BAD_STATES);
         return LFG_COMPATIBLES_BAD_STATES;
     }
 
@@ -573,10 +773,10 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         RemoveFromCurrentQueue(guid);
     }
 
-    sLFGMgr->AddProposal(proposal);
+    AddProposal(proposal);
 
     TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) MATCH! Group formed", GetDetailedMatchRoles(check));
-    SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+    SetCompatibles(key, LFG_COMPATIBLES_MATCH);
     return LFG_COMPATIBLES_MATCH;
 }
 
@@ -618,7 +818,7 @@ void LFGQueue::UpdateQueueTimers(uint8 queueId, time_t currTime)
                 break;
         }
 
-        if (queueinfo.bestCompatible.empty())
+        if (queueinfo.bestCompatible.IsEmpty())
             FindBestCompatibleInQueue(itQueue);
 
         LfgQueueStatusData queueData(queueId, dungeonId, waitTime, wtAvg, wtTank, wtHealer, wtDps, queuedTime, queueinfo.tanks, queueinfo.healers, queueinfo.dps);
@@ -672,7 +872,7 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
     if (full)
         for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
         {
-            o << "(" << itr->first << "): " << GetCompatibleString(itr->second.compatibility);
+            o << "(" << itr->first.ToString() << "): " << GetCompatibleString(itr->second.compatibility);
             if (!itr->second.roles.empty())
             {
                 o << " (";
@@ -695,30 +895,23 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
 void LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
 {
     TC_LOG_DEBUG("lfg.queue.compatibles.find", "{}", itrQueue->first.ToString());
-    std::string sguid = itrQueue->first.ToHexString();
-
     for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
         if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS &&
-            std::string::npos != itr->first.find(sguid))
+            itr->first.Contains(itrQueue->first))
         {
             UpdateBestCompatibleInQueue(itrQueue, itr->first, itr->second.roles);
         }
 }
 
-void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles)
+void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles)
 {
     LfgQueueData& queueData = itrQueue->second;
 
-    uint8 storedSize = queueData.bestCompatible.empty() ? 0 :
-        std::count(queueData.bestCompatible.begin(), queueData.bestCompatible.end(), '|') + 1;
-
-    uint8 size = std::count(key.begin(), key.end(), '|') + 1;
-
-    if (size <= storedSize)
+    if (key.Size <= queueData.bestCompatible.Size)
         return;
 
     TC_LOG_DEBUG("lfg.queue.compatibles.update", "Changed ({}) to ({}) as best compatible group for {}",
-        queueData.bestCompatible, key, itrQueue->first.ToString());
+        queueData.bestCompatible.ToString(), key.ToString(), itrQueue->first.ToString());
 
     queueData.bestCompatible = key;
     queueData.tanks = LFG_TANKS_NEEDED;
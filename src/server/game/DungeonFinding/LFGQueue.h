@@ -19,11 +19,16 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
+#include <array>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 namespace lfg
 {
 
+struct LfgProposal;
+
 enum LfgCompatibility
 {
     LFG_COMPATIBILITY_PENDING,
@@ -38,6 +43,27 @@ enum LfgCompatibility
     LFG_COMPATIBLES_MATCH                                  // Must be the last one
 };
 
+/// Sorted guids of a combination of queued players and groups, key of the compatibility cache
+struct LfgCompatibilityKey
+{
+    LfgCompatibilityKey() : Size(0) { }
+    explicit LfgCompatibilityKey(GuidList const& check);
+
+    bool IsEmpty() const { return Size == 0; }
+    bool Contains(ObjectGuid guid) const;
+    std::string ToString() const;
+
+    friend bool operator==(LfgCompatibilityKey const& left, LfgCompatibilityKey const& right) = default;
+
+    std::array<ObjectGuid, LFG_TANKS_NEEDED + LFG_HEALERS_NEEDED + LFG_DPS_NEEDED> Guids;   ///< A full group has one queue entry per member at most
+    uint8 Size;
+};
+
+struct LfgCompatibilityKeyHash
+{
+    std::size_t operator()(LfgCompatibilityKey const& key) const;
+};
+
 struct LfgCompatibilityData
 {
     LfgCompatibilityData(): compatibility(LFG_COMPATIBILITY_PENDING) { }
@@ -65,7 +91,7 @@ struct LfgQueueData
     uint8 dps;                                             ///< Dps needed
     LfgDungeonSet dungeons;                                ///< Selected Player/Group Dungeon/s
     LfgRolesMap roles;                                     ///< Selected Player Role/s
-    std::string bestCompatible;                            ///< Best compatible combination of people queued
+    LfgCompatibilityKey bestCompatible;                    ///< Best compatible combination of people queued
 };
 
 struct LfgWaitTime
@@ -75,8 +101,29 @@ struct LfgWaitTime
     uint32 number;                                         ///< Number of people used to get that wait time
 };
 
+struct LfgMatchIgnores
+{
+    GuidUnorderedSet Characters;
+    GuidUnorderedSet Accounts;
+};
+
+/// LFGMgr data read by matching, copied on the world thread when matching runs on a worker thread
+struct LfgMatchSnapshot
+{
+    bool AllQueued(GuidList const& check) const;
+    bool IsLfgGroup(ObjectGuid guid) const { return LfgGroups.contains(guid); }
+    bool HasIgnore(ObjectGuid guid1, ObjectGuid guid2) const;
+    LfgState GetOldState(ObjectGuid guid) const;
+
+    std::unordered_map<ObjectGuid, LfgState> States;
+    std::unordered_map<ObjectGuid, LfgState> OldStates;
+    GuidUnorderedSet LfgGroups;
+    std::unordered_map<ObjectGuid, ObjectGuid> AccountGuids;   ///< Connected players only
+    std::unordered_map<ObjectGuid, LfgMatchIgnores> Ignores;   ///< Connected players ignoring someone
+};
+
 typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
-typedef std::map<std::string, LfgCompatibilityData> LfgCompatibleContainer;
+typedef std::unordered_map<LfgCompatibilityKey, LfgCompatibilityData, LfgCompatibilityKeyHash> LfgCompatibleContainer;
 typedef std::map<ObjectGuid, LfgQueueData> LfgQueueDataContainer;
 
 /**
@@ -106,31 +153,44 @@ class TC_GAME_API LFGQueue
         // Find new group
         uint8 FindGroups();
 
+        // Matching on a worker thread, the world thread keeps using this queue meanwhile
+        bool IsMatchingAsync() const { return _asyncMatchInFlight; }
+        bool HasNewToQueue() const { return !newToQueueStore.empty(); }
+        LfgQueueDataContainer const& GetQueueData() const { return QueueDataStore; }
+        void StartAsyncMatch(LFGQueue& matcher);
+        uint8 FindGroups(LfgMatchSnapshot const& snapshot, std::vector<LfgProposal>& proposals);
+        void FinishAsyncMatch(LFGQueue& matcher, std::vector<LfgProposal>& proposals);
+
         // Just for debugging purposes
         std::string DumpQueueInfo() const;
         std::string DumpCompatibleInfo(bool full = false) const;
 
     private:
-        void SetQueueUpdateData(std::string const& strGuids, LfgRolesMap const& proposalRoles);
-
         void AddToNewQueue(ObjectGuid guid);
         void AddToCurrentQueue(ObjectGuid guid);
         void AddToFrontCurrentQueue(ObjectGuid guid);
         void RemoveFromNewQueue(ObjectGuid guid);
         void RemoveFromCurrentQueue(ObjectGuid guid);
 
-        void SetCompatibles(std::string const& key, LfgCompatibility compatibles);
-        LfgCompatibility GetCompatibles(std::string const& key);
+        void SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles);
+        LfgCompatibility GetCompatibles(LfgCompatibilityKey const& key);
         void RemoveFromCompatibles(ObjectGuid guid);
 
-        void SetCompatibilityData(std::string const& key, LfgCompatibilityData const& compatibles);
-        LfgCompatibilityData* GetCompatibilityData(std::string const& key);
+        void SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& compatibles);
+        LfgCompatibilityData* GetCompatibilityData(LfgCompatibilityKey const& key);
         void FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
-        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles);
+        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles);
 
         LfgCompatibility FindNewGroups(GuidList& check, GuidList& all);
         LfgCompatibility CheckCompatibility(GuidList check);
 
+        // LFGMgr data, from the snapshot when matching on a worker thread
+        bool AllQueued(GuidList const& check) const;
+        bool IsLfgGroup(ObjectGuid guid) const;
+        bool HasIgnore(ObjectGuid guid1, ObjectGuid guid2) const;
+        LfgState GetOldState(ObjectGuid guid) const;
+        void AddProposal(LfgProposal& proposal);
+
         // Queue
         LfgQueueDataContainer QueueDataStore;              ///< Queued groups
         LfgCompatibleContainer CompatibleMapStore;         ///< Compatible dungeons
@@ -141,6 +201,12 @@ class TC_GAME_API LFGQueue
         LfgWaitTimesContainer waitTimesDpsStore;           ///< Average wait time to find a group queuing as dps
         GuidList currentQueueStore;                        ///< Ordered list. Used to find groups
         GuidList newToQueueStore;                          ///< New groups to add to queue
+
+        LfgMatchSnapshot const* _matchSnapshot = nullptr;  ///< Set while this is the matcher copy of an async match
+        std::vector<LfgProposal>* _matchProposals = nullptr;
+        bool _asyncMatchInFlight = false;                  ///< Compatibility cache is lent to the matcher copy
+        GuidList _asyncMatchNewToQueue;                    ///< New groups the matcher copy checks
+        GuidSet _removedDuringAsyncMatch;
 };
 
 } // namespace lfg
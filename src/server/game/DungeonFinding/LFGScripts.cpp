@@ -35,7 +35,7 @@
 namespace lfg
 {
 
-LFGPlayerScript::LFGPlayerScript() : PlayerScript("LFGPlayerScript") { }
+LFGPlayerScript::LFGPlayerScript() : PlayerScript("LFGPlayerScript", { PlayerScriptHook::OnLogout, PlayerScriptHook::OnLogin, PlayerScriptHook::OnMapChanged }) { }
 
 void LFGPlayerScript::OnLogout(Player* player)
 {
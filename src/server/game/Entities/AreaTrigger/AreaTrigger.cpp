@@ -81,6 +81,8 @@ void AreaTrigger::RemoveFromWorld()
 
         // Handle removal of all units, calling OnUnitExit & deleting auras if needed
         HandleUnitEnterExit({});
+        _targetCandidates.clear();
+        _targetCandidatesVersion.reset();
 
         _ai->OnRemove();
 
@@ -360,34 +362,87 @@ float AreaTrigger::GetProgress() const
     return GetTimeSinceCreated() < GetTimeToTargetScale() ? float(GetTimeSinceCreated()) / float(GetTimeToTargetScale()) : 1.0f;
 }
 
-void AreaTrigger::UpdateTargetList()
+namespace
 {
-    std::vector<Unit*> targetList;
+// alive state and phase can change without the unit being relocated, they are checked by UpdateTargetList instead
+class AreaTriggerCandidateSearcher
+{
+public:
+    AreaTriggerCandidateSearcher(AreaTrigger const* areaTrigger, std::vector<Unit*>& candidates, float radius, bool check3D)
+        : _areaTrigger(areaTrigger), _candidates(candidates), _radius(radius), _check3D(check3D), _playersOnly(areaTrigger->IsServerSide()) { }
 
-    switch (_shape.Type)
+    void Visit(PlayerMapType& m) { Collect(m); }
+    void Visit(CreatureMapType& m) { if (!_playersOnly) Collect(m); }
+    template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) { }
+
+private:
+    template<class T>
+    void Collect(GridRefManager<T>& m)
     {
-        case AREATRIGGER_TYPE_SPHERE:
-            SearchUnitInSphere(targetList);
-            break;
-        case AREATRIGGER_TYPE_BOX:
-            SearchUnitInBox(targetList);
-            break;
-        case AREATRIGGER_TYPE_POLYGON:
-            SearchUnitInPolygon(targetList);
-            break;
-        case AREATRIGGER_TYPE_CYLINDER:
-            SearchUnitInCylinder(targetList);
-            break;
-        case AREATRIGGER_TYPE_DISK:
-            SearchUnitInDisk(targetList);
-            break;
-        case AREATRIGGER_TYPE_BOUNDED_PLANE:
-            SearchUnitInBoundedPlane(targetList);
-            break;
-        default:
-            break;
+        m.GetDenseContainer().ForEach([&](T* unit)
+        {
+            if (_areaTrigger->IsWithinDist(unit, _radius, _check3D))
+                _candidates.push_back(unit);
+        });
+    }
+
+    AreaTrigger const* _areaTrigger;
+    std::vector<Unit*>& _candidates;
+    float _radius;
+    bool _check3D;
+    bool _playersOnly;
+};
+
+struct GridPositionIndexVersionSum
+{
+    void Visit(PlayerMapType& m) { Version += m.GetPositionIndex().GetVersion(); }
+    void Visit(CreatureMapType& m) { Version += m.GetPositionIndex().GetVersion(); }
+    template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) { }
+
+    uint64 Version = 0;
+};
+}
+
+void AreaTrigger::UpdateTargetList()
+{
+    uint64 footprintVersion = GetTargetSearchFootprintVersion();
+    if (!CanReuseTargetCandidates(footprintVersion))
+    {
+        _targetCandidates.clear();
+        _targetCandidatesVersion = footprintVersion;
+        _targetCandidatesPosition = GetPosition();
+
+        switch (_shape.Type)
+        {
+            case AREATRIGGER_TYPE_SPHERE:
+                SearchUnitInSphere(_targetCandidates);
+                break;
+            case AREATRIGGER_TYPE_BOX:
+                SearchUnitInBox(_targetCandidates);
+                break;
+            case AREATRIGGER_TYPE_POLYGON:
+                SearchUnitInPolygon(_targetCandidates);
+                break;
+            case AREATRIGGER_TYPE_CYLINDER:
+                SearchUnitInCylinder(_targetCandidates);
+                break;
+            case AREATRIGGER_TYPE_DISK:
+                SearchUnitInDisk(_targetCandidates);
+                break;
+            case AREATRIGGER_TYPE_BOUNDED_PLANE:
+                SearchUnitInBoundedPlane(_targetCandidates);
+                break;
+            default:
+                break;
+        }
     }
 
+    std::vector<Unit*> targetList;
+    targetList.reserve(_targetCandidates.size());
+    for (Unit* unit : _targetCandidates)
+        if (unit->IsAlive() && unit->InSamePhase(GetPhaseShift()))
+            targetList.push_back(unit);
+
     if (GetTemplate())
     {
         if (ConditionContainer const* conditions = sConditionMgr->GetConditionsForAreaTrigger(GetTemplate()->Id.Id, GetTemplate()->Id.IsServerSide))
@@ -402,19 +457,38 @@ void AreaTrigger::UpdateTargetList()
     HandleUnitEnterExit(targetList);
 }
 
+bool AreaTrigger::CanReuseTargetCandidates(uint64 footprintVersion) const
+{
+    // shape changes over time
+    if (GetTemplate() && GetTemplate()->HasFlag(AREATRIGGER_FLAG_HAS_DYNAMIC_SHAPE))
+        return false;
+
+    // the areatrigger might cover different cells now
+    if (!_targetCandidatesVersion || !(_targetCandidatesPosition == GetPosition()))
+        return false;
+
+    // the cached units are only guaranteed to still exist if no unit moved, entered or left the searched cells
+    return *_targetCandidatesVersion == footprintVersion;
+}
+
+uint64 AreaTrigger::GetTargetSearchFootprintVersion() const
+{
+    GridPositionIndexVersionSum versionSum;
+    if (IsServerSide())
+        Cell::VisitWorldObjects(this, versionSum, GetMaxSearchRadius());
+    else
+        Cell::VisitAllObjects(this, versionSum, GetMaxSearchRadius());
+
+    return versionSum.Version;
+}
+
 void AreaTrigger::SearchUnits(std::vector<Unit*>& targetList, float radius, bool check3D)
 {
-    Trinity::AnyUnitInObjectRangeCheck check(this, radius, check3D);
+    AreaTriggerCandidateSearcher searcher(this, targetList, radius, check3D);
     if (IsServerSide())
-    {
-        Trinity::PlayerListSearcher<Trinity::AnyUnitInObjectRangeCheck> searcher(this, targetList, check);
         Cell::VisitWorldObjects(this, searcher, GetMaxSearchRadius());
-    }
     else
-    {
-        Trinity::UnitListSearcher<Trinity::AnyUnitInObjectRangeCheck> searcher(this, targetList, check);
         Cell::VisitAllObjects(this, searcher, GetMaxSearchRadius());
-    }
 }
 
 void AreaTrigger::SearchUnitInSphere(std::vector<Unit*>& targetList)
@@ -135,6 +135,8 @@ class TC_GAME_API AreaTrigger : public WorldObject, public GridObject<AreaTrigge
         float GetProgress() const;
 
         void UpdateTargetList();
+        bool CanReuseTargetCandidates(uint64 footprintVersion) const;
+        uint64 GetTargetSearchFootprintVersion() const;
         void SearchUnits(std::vector<Unit*>& targetList, float radius, bool check3D);
         void SearchUnitInSphere(std::vector<Unit*>& targetList);
         void SearchUnitInBox(std::vector<Unit*>& targetList);
@@ -186,6 +188,12 @@ class TC_GAME_API AreaTrigger : public WorldObject, public GridObject<AreaTrigge
         AreaTriggerTemplate const* _areaTriggerTemplate;
         GuidUnorderedSet _insideUnits;
 
+        // units within the shape before alive state, phase and conditions are checked
+        // only valid while no unit in the searched cells was added, removed or moved
+        std::vector<Unit*> _targetCandidates;
+        Optional<uint64> _targetCandidatesVersion;
+        Position _targetCandidatesPosition;
+
         std::unique_ptr<AreaTriggerAI> _ai;
 };
 
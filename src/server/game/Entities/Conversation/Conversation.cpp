@@ -306,6 +306,19 @@ void Conversation::BuildValuesUpdate(ByteBuffer* data, Player const* target) con
     data->put<uint32>(sizePos, data->wpos() - sizePos - 4);
 }
 
+bool Conversation::HasViewerDependentChanges() const
+{
+    if (Object::HasViewerDependentChanges())
+        return true;
+
+    if (!m_values.HasChanged(TYPEID_CONVERSATION))
+        return false;
+
+    // ConversationLine::StartTime is viewer dependent too
+    return m_conversationData->HasChanged(&UF::ConversationData::Lines)
+        || m_conversationData->HasChanged(&UF::ConversationData::LastLineEndTime);
+}
+
 void Conversation::BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::Mask const& requestedObjectMask,
     UF::ConversationData::Mask const& requestedConversationMask, Player const* target) const
 {
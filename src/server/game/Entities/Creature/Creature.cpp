@@ -289,11 +289,13 @@ bool ForcedDespawnDelayEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
     return true;
 }
 
-Creature::Creature(bool isWorldObject) : Unit(isWorldObject), MapObject(), m_PlayerDamageReq(0), m_dontClearTapListOnEvade(false), _pickpocketLootRestore(0),
+static_assert(alignof(Creature) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "TRINITY_RECYCLED_ALLOCATION does not support over-aligned types");
+
+Creature::Creature(bool isWorldObject) : Unit(isWorldObject), MapObject(), m_PlayerDamageReq(0), m_dontClearTapListOnEvade(false), m_pendingPersonalLootMode(0), _pickpocketLootRestore(0),
     m_corpseRemoveTime(0), m_respawnTime(0), m_respawnDelay(300), m_corpseDelay(60), m_ignoreCorpseDecayRatio(false), m_wanderDistance(0.0f), m_boundaryCheckTime(2500), m_combatPulseTime(0), m_combatPulseDelay(0), m_reactState(REACT_AGGRESSIVE),
     m_defaultMovementType(IDLE_MOTION_TYPE), m_spawnId(UI64LIT(0)), m_equipmentId(0), m_originalEquipmentId(0), m_AlreadyCallAssistance(false), m_AlreadySearchedAssistance(false), m_cannotReachTarget(false), m_cannotReachTimer(0),
     m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL), m_originalEntry(0), m_homePosition(), m_transportHomePosition(), m_creatureInfo(nullptr), m_creatureData(nullptr), _waypointPathId(0), _currentWaypointNodeInfo(0, 0),
-    m_formation(nullptr), m_triggerJustAppeared(true), m_respawnCompatibilityMode(false), _lastDamagedTime(0),
+    m_formation(nullptr), m_triggerJustAppeared(true), m_respawnCompatibilityMode(false), _lastDamagedTime(0), _deferredUpdateDiff(0), _deferredUpdateTicks(0),
     _regenerateHealth(true), _isMissingCanSwimFlagOutOfCombat(false), _gossipMenuId(0), _sparringHealthPct(0)
 {
     m_regenTimer = CREATURE_REGEN_INTERVAL;
@@ -409,6 +411,7 @@ void Creature::RemoveCorpse(bool setSpawnTime, bool destroyForNearbyPlayers)
         setDeathState(DEAD);
         RemoveAllAuras();
         m_loot = nullptr;
+        ClearPendingPersonalLoot();
         uint32 respawnDelay = m_respawnDelay;
         if (CreatureAI* ai = AI())
             ai->CorpseRemoved(respawnDelay);
@@ -1359,20 +1362,55 @@ bool Creature::isTappedBy(Player const* player) const
 
 Loot* Creature::GetLootForPlayer(Player const* player) const
 {
-    if (m_personalLoot.empty())
+    if (m_personalLoot.empty() && m_pendingPersonalLoot.empty())
         return m_loot.get();
 
     if (std::unique_ptr<Loot> const* loot = Trinity::Containers::MapGetValuePtr(m_personalLoot, player->GetGUID()))
         return loot->get();
 
+    if (HasPendingPersonalLootFor(player))
+        return const_cast<Creature*>(this)->GeneratePendingPersonalLoot(player);
+
     return nullptr;
 }
 
+void Creature::SetPendingPersonalLoot(GuidUnorderedSet looters, uint16 lootMode)
+{
+    m_pendingPersonalLoot = std::move(looters);
+    m_pendingPersonalLootMode = lootMode;
+}
+
+bool Creature::HasPendingPersonalLootFor(Player const* player) const
+{
+    return m_pendingPersonalLoot.contains(player->GetGUID());
+}
+
+// Rolls the corpse loot of a tapper that was deferred at death, see Corpse.LootOnDemand
+Loot* Creature::GeneratePendingPersonalLoot(Player const* player)
+{
+    if (!m_pendingPersonalLoot.erase(player->GetGUID()))
+        return nullptr;
+
+    Loot* loot = new Loot(GetMap(), GetGUID(), LOOT_CORPSE, nullptr);
+
+    if (uint32 lootid = GetLootId())
+        loot->FillLoot(lootid, LootTemplates_Creature, const_cast<Player*>(player), true, false, m_pendingPersonalLootMode, GetMap()->GetDifficultyLootItemContext());
+
+    if (m_pendingPersonalLootMode > 0)
+        loot->generateMoneyLoot(GetCreatureTemplate()->mingold, GetCreatureTemplate()->maxgold);
+
+    m_personalLoot[player->GetGUID()].reset(loot);
+    return loot;
+}
+
 bool Creature::IsFullyLooted() const
 {
     if (m_loot && !m_loot->isLooted())
         return false;
 
+    if (!m_pendingPersonalLoot.empty())
+        return false;
+
     for (auto const& [_, loot] : m_personalLoot)
         if (!loot->isLooted())
             return false;
@@ -1407,7 +1445,7 @@ void Creature::SaveToDB()
     SaveToDB(mapId, data->spawnDifficulties);
 }
 
-void Creature::SaveToDB(uint32 mapid, std::vector<Difficulty> const& spawnDifficulties)
+void Creature::SaveToDB(uint32 mapid, std::span<Difficulty const> spawnDifficulties)
 {
     // update in loaded data
     if (!m_spawnId)
@@ -1471,7 +1509,7 @@ void Creature::SaveToDB(uint32 mapid, std::vector<Difficulty> const& spawnDiffic
     // prevent add data integrity problems
     data.movementType = !m_wanderDistance && GetDefaultMovementType() == RANDOM_MOTION_TYPE
         ? IDLE_MOTION_TYPE : GetDefaultMovementType();
-    data.spawnDifficulties = spawnDifficulties;
+    data.spawnDifficulties = sObjectMgr->GetSpawnDifficultySet(spawnDifficulties);
     data.npcflag = npcflag;
     data.unit_flags = unitFlags;
     data.unit_flags2 = unitFlags2;
@@ -2917,6 +2955,9 @@ void Creature::AllLootRemovedFromCorpse()
         if (m_loot && m_loot->loot_type == LOOT_SKINNING && m_loot->isLooted())
             return true;
 
+        if (!m_pendingPersonalLoot.empty())
+            return false;
+
         for (auto const& [_, loot] : m_personalLoot)
             if (loot->loot_type != LOOT_SKINNING || !loot->isLooted())
                 return false;
@@ -3494,6 +3535,42 @@ bool Creature::CanGiveExperience() const
     return !_staticFlags.HasFlag(CREATURE_STATIC_FLAG_NO_XP);
 }
 
+bool Creature::CanHaveReducedUpdateRate() const
+{
+    if (IsEngaged() || IsInEvadeMode() || isActiveObject())
+        return false;
+
+    // pets, guardians and charmed creatures follow their players
+    if (IsCharmedOwnedByPlayerOrPlayer())
+        return false;
+
+    if (Vehicle const* vehicle = GetVehicleKit())
+        if (vehicle->IsVehicleInUse())
+            return false;
+
+    return true;
+}
+
+bool Creature::DeferUpdate(uint32 diff, uint32 ticks)
+{
+    if (++_deferredUpdateTicks >= ticks)
+    {
+        _deferredUpdateTicks = 0;
+        return false;
+    }
+
+    _deferredUpdateDiff += diff;
+    return true;
+}
+
+uint32 Creature::ConsumeDeferredUpdateDiff()
+{
+    uint32 diff = _deferredUpdateDiff;
+    _deferredUpdateDiff = 0;
+    _deferredUpdateTicks = 0;
+    return diff;
+}
+
 bool Creature::IsEngaged() const
 {
     if (CreatureAI const* ai = AI())
@@ -25,6 +25,7 @@
 #include "Duration.h"
 #include "GridObject.h"
 #include "MapObject.h"
+#include "RecyclingAllocator.h"
 #include <list>
 
 class CreatureAI;
@@ -72,6 +73,9 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         explicit Creature(bool isWorldObject = false);
         ~Creature();
 
+        // respawns and summons recreate creatures all the time, recycle their memory
+        TRINITY_RECYCLED_ALLOCATION
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
 
@@ -232,7 +236,7 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         bool LoadFromDB(ObjectGuid::LowType spawnId, Map* map, bool addToMap, bool allowDuplicate);
         void SaveToDB();
                                                             // overriden in Pet
-        virtual void SaveToDB(uint32 mapid, std::vector<Difficulty> const& spawnDifficulties);
+        virtual void SaveToDB(uint32 mapid, std::span<Difficulty const> spawnDifficulties);
         static bool DeleteFromDB(ObjectGuid::LowType spawnId);
 
         bool CanHaveLoot() const { return !_staticFlags.HasFlag(CREATURE_STATIC_FLAG_NO_LOOT); }
@@ -241,6 +245,9 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         void SetLootId(Optional<uint32> lootId);
         std::unique_ptr<Loot> m_loot;
         std::unordered_map<ObjectGuid, std::unique_ptr<Loot>> m_personalLoot;
+        void SetPendingPersonalLoot(GuidUnorderedSet looters, uint16 lootMode);
+        void ClearPendingPersonalLoot() { m_pendingPersonalLoot.clear(); }
+        bool HasPendingPersonalLootFor(Player const* player) const;
         void StartPickPocketRefillTimer();
         void ResetPickPocketRefillTimer() { _pickpocketLootRestore = 0; }
         bool CanGeneratePickPocketLoot() const;
@@ -251,6 +258,7 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         void SetDontClearTapListOnEvade(bool dontClear);
         bool isTappedBy(Player const* player) const;                          // return true if the creature is tapped by the player or a member of his party.
         Loot* GetLootForPlayer(Player const* player) const override;
+        Loot* GeneratePendingPersonalLoot(Player const* player);
         bool IsFullyLooted() const;
         bool IsSkinnedBy(Player const* player) const;
 
@@ -395,6 +403,11 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         void AtEngage(Unit* target) override;
         void AtDisengage() override;
 
+        // Update level of detail, see MapUpdate.CreatureLOD.Distance
+        bool CanHaveReducedUpdateRate() const;
+        bool DeferUpdate(uint32 diff, uint32 ticks);
+        uint32 ConsumeDeferredUpdateDiff();
+
         void OverrideSparringHealthPct(std::vector<float> const& healthPct);
         float GetSparringHealthPct() { return _sparringHealthPct; }
         uint32 CalculateDamageForSparring(Unit* attacker, uint32 damage);
@@ -439,6 +452,9 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         GuidUnorderedSet m_tapList;
         bool m_dontClearTapListOnEvade;
 
+        GuidUnorderedSet m_pendingPersonalLoot;             // tappers whose corpse loot is generated when they first access it
+        uint16 m_pendingPersonalLootMode;
+
         /// Timers
         time_t _pickpocketLootRestore;
         time_t m_corpseRemoveTime;                          // (msecs)timer for death or corpse disappearance
@@ -507,6 +523,8 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         } _spellFocusInfo;
 
         time_t _lastDamagedTime; // Part of Evade mechanics
+        uint32 _deferredUpdateDiff;
+        uint32 _deferredUpdateTicks;
         CreatureTextRepeatGroup m_textRepeat;
 
         CreatureStaticFlagsHolder _staticFlags;
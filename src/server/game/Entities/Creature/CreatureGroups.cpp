@@ -23,6 +23,7 @@
 #include "Log.h"
 #include "Map.h"
 #include "MotionMaster.h"
+#include "MoveSpline.h"
 #include "MovementGenerator.h"
 #include "ObjectMgr.h"
 
@@ -292,6 +293,24 @@ void CreatureGroup::LeaderStartedMoving()
     }
 }
 
+Position const& CreatureGroup::PredictLeaderDestination(float travelDist, float relativeAngle)
+{
+    // every member asks for the same prediction while the leader did not move, only trace it once
+    uint32 splineId = _leader->movespline->GetId();
+    if (_leaderPrediction.SplineId != splineId || _leaderPrediction.TravelDist != travelDist || _leaderPrediction.RelativeAngle != relativeAngle
+        || _leaderPrediction.LeaderPosition != _leader->GetPosition())
+    {
+        _leaderPrediction.SplineId = splineId;
+        _leaderPrediction.TravelDist = travelDist;
+        _leaderPrediction.RelativeAngle = relativeAngle;
+        _leaderPrediction.LeaderPosition = _leader->GetPosition();
+        _leaderPrediction.Destination = _leader->GetPosition();
+        _leader->MovePositionToFirstCollision(_leaderPrediction.Destination, travelDist, relativeAngle);
+    }
+
+    return _leaderPrediction.Destination;
+}
+
 bool CreatureGroup::CanLeaderStartMoving() const
 {
     for (std::unordered_map<Creature*, FormationInfo*>::value_type const& pair : _members)
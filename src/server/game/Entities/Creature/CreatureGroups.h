@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "ObjectGuid.h"
+#include "Position.h"
 #include <unordered_map>
 
 enum GroupAIFlags
@@ -34,7 +35,6 @@ enum GroupAIFlags
 class Creature;
 class CreatureGroup;
 class Unit;
-struct Position;
 
 struct FormationInfo
 {
@@ -75,6 +75,16 @@ class TC_GAME_API CreatureGroup
         bool _formed;
         bool _engaging;
 
+        // last leader destination predicted for formation movement, members launching on the same leader step reuse it
+        struct LeaderPrediction
+        {
+            uint32 SplineId = 0;
+            float TravelDist = 0.f;
+            float RelativeAngle = 0.f;
+            Position LeaderPosition;
+            Position Destination;
+        } _leaderPrediction;
+
     public:
         //Group cannot be created empty
         explicit CreatureGroup(ObjectGuid::LowType leaderSpawnId);
@@ -92,6 +102,7 @@ class TC_GAME_API CreatureGroup
         void FormationReset(bool dismiss);
 
         void LeaderStartedMoving();
+        Position const& PredictLeaderDestination(float travelDist, float relativeAngle);
         void MemberEngagingTarget(Creature* member, Unit* target);
         bool CanLeaderStartMoving() const;
 };
@@ -54,7 +54,7 @@ class TC_GAME_API TempSummon : public Creature
         virtual void UnSummon(uint32 msTime = 0);
         void RemoveFromWorld() override;
         void SetTempSummonType(TempSummonType type);
-        void SaveToDB(uint32 /*mapid*/, std::vector<Difficulty> const& /*spawnDifficulties*/) override { }
+        void SaveToDB(uint32 /*mapid*/, std::span<Difficulty const> /*spawnDifficulties*/) override { }
         WorldObject* GetSummoner() const;
         Unit* GetSummonerUnit() const;
         Creature* GetSummonerCreatureBase() const;
@@ -504,6 +504,8 @@ void SetTransportAutoCycleBetweenStopFrames::Execute(GameObjectTypeBase& type) c
 }
 }
 
+static_assert(alignof(GameObject) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "TRINITY_RECYCLED_ALLOCATION does not support over-aligned types");
+
 GameObject::GameObject() : WorldObject(false), MapObject(),
     m_model(nullptr), m_goValue(), m_AI(nullptr), m_respawnCompatibilityMode(false), _animKitId(0), _worldEffectID(0)
 {
@@ -1515,7 +1517,7 @@ void GameObject::SaveToDB()
     SaveToDB(mapId, data->spawnDifficulties);
 }
 
-void GameObject::SaveToDB(uint32 mapid, std::vector<Difficulty> const& spawnDifficulties)
+void GameObject::SaveToDB(uint32 mapid, std::span<Difficulty const> spawnDifficulties)
 {
     GameObjectTemplate const* goI = GetGOInfo();
     if (!goI)
@@ -1537,7 +1539,7 @@ void GameObject::SaveToDB(uint32 mapid, std::vector<Difficulty> const& spawnDiff
     data.spawntimesecs = m_spawnedByDefault ? m_respawnDelayTime : -(int32)m_respawnDelayTime;
     data.animprogress = GetGoAnimProgress();
     data.goState = GetGoState();
-    data.spawnDifficulties = spawnDifficulties;
+    data.spawnDifficulties = sObjectMgr->GetSpawnDifficultySet(spawnDifficulties);
     data.artKit = GetGoArtKit();
     if (!data.spawnGroupData)
         data.spawnGroupData = sObjectMgr->GetDefaultSpawnGroup();
@@ -3478,6 +3480,9 @@ void GameObject::EnableCollision(bool enable)
         GetMap()->InsertGameObjectModel(*m_model);*/
 
     m_model->enableCollision(enable);
+
+    if (IsInWorld())
+        GetMap()->InvalidateLineOfSightCache();
 }
 
 void GameObject::UpdateModel()
@@ -3554,6 +3559,18 @@ void GameObject::BuildValuesUpdate(ByteBuffer* data, Player const* target) const
     data->put<uint32>(sizePos, data->wpos() - sizePos - 4);
 }
 
+bool GameObject::HasViewerDependentChanges() const
+{
+    if (Object::HasViewerDependentChanges())
+        return true;
+
+    if (!m_values.HasChanged(TYPEID_GAMEOBJECT))
+        return false;
+
+    return m_gameObjectData->HasChanged(&UF::GameObjectData::Flags)
+        || m_gameObjectData->HasChanged(&UF::GameObjectData::State);
+}
+
 void GameObject::BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::Mask const& requestedObjectMask,
     UF::GameObjectData::Mask const& requestedGameObjectMask, Player const* target) const
 {
@@ -3714,9 +3731,8 @@ void GameObject::UpdateModelPosition()
 
     if (GetMap()->ContainsGameObjectModel(*m_model))
     {
-        GetMap()->RemoveGameObjectModel(*m_model);
         m_model->UpdatePosition();
-        GetMap()->InsertGameObjectModel(*m_model);
+        GetMap()->RelocateGameObjectModel(*m_model);
     }
 }
 
@@ -22,6 +22,7 @@
 #include "GridObject.h"
 #include "GameObjectData.h"
 #include "MapObject.h"
+#include "RecyclingAllocator.h"
 #include "SharedDefines.h"
 
 class GameObject;
@@ -127,12 +128,16 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         explicit GameObject();
         ~GameObject();
 
+        // respawns and summons recreate gameobjects all the time, recycle their memory
+        TRINITY_RECYCLED_ALLOCATION
+
     protected:
         void BuildValuesCreate(ByteBuffer* data, Player const* target) const override;
         void BuildValuesUpdate(ByteBuffer* data, Player const* target) const override;
         void ClearUpdateMask(bool remove) override;
 
     public:
+        bool HasViewerDependentChanges() const override;
         void BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::Mask const& requestedObjectMask,
             UF::GameObjectData::Mask const& requestedGameObjectMask, Player const* target) const;
 
@@ -183,7 +188,7 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         std::string GetNameForLocaleIdx(LocaleConstant locale) const override;
 
         void SaveToDB();
-        void SaveToDB(uint32 mapid, std::vector<Difficulty> const& spawnDifficulties);
+        void SaveToDB(uint32 mapid, std::span<Difficulty const> spawnDifficulties);
         bool LoadFromDB(ObjectGuid::LowType spawnId, Map* map, bool addToMap, bool = true); // arg4 is unused, only present to match the signature on Creature
         static bool DeleteFromDB(ObjectGuid::LowType spawnId);
 
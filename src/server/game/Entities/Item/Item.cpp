@@ -1469,12 +1469,17 @@ void Item::ClearEnchantment(EnchantmentSlot slot)
     if (!GetEnchantmentId(slot))
         return;
 
+    // the expiry of the cleared enchantment must not remove a later one in the same slot
+    Player* owner = GetOwner();
+    if (owner)
+        owner->RemoveEnchantmentDuration(this, slot);
+
     auto enchantmentField = m_values.ModifyValue(&Item::m_itemData).ModifyValue(&UF::ItemData::Enchantment, slot);
     SetUpdateFieldValue(enchantmentField.ModifyValue(&UF::ItemEnchantment::ID), 0);
     SetUpdateFieldValue(enchantmentField.ModifyValue(&UF::ItemEnchantment::Duration), 0);
     SetUpdateFieldValue(enchantmentField.ModifyValue(&UF::ItemEnchantment::Charges), 0);
     SetUpdateFieldValue(enchantmentField.ModifyValue(&UF::ItemEnchantment::Inactive), 0);
-    SetState(ITEM_CHANGED, GetOwner());
+    SetState(ITEM_CHANGED, owner);
 }
 
 UF::SocketedGem const* Item::GetGem(uint16 slot) const
@@ -1784,11 +1789,11 @@ void Item::ClearUpdateMask(bool remove)
     Object::ClearUpdateMask(remove);
 }
 
-bool Item::AddToObjectUpdate()
+bool Item::AddToObjectUpdate(UF::UpdateFieldPriority priority)
 {
     if (Player* owner = GetOwner())
     {
-        owner->GetMap()->AddUpdateObject(this);
+        owner->GetMap()->AddUpdateObject(this, priority);
         return true;
     }
 
@@ -396,7 +396,7 @@ class TC_GAME_API Item : public Object
             void operator()(Player const* player) const;
         };
 
-        bool AddToObjectUpdate() override;
+        bool AddToObjectUpdate(UF::UpdateFieldPriority priority) override;
         void RemoveFromObjectUpdate() override;
 
         uint32 GetScriptId() const { return GetTemplate()->ScriptId; }
@@ -292,3 +292,19 @@ std::size_t ItemTemplate::CalculateItemSpecBit(ChrSpecializationEntry const* spe
 {
     return (spec->ClassID - 1) * MAX_SPECIALIZATIONS + spec->OrderIndex;
 }
+
+void ItemTemplate::InitializeQueryData()
+{
+    for (uint8 loc = LOCALE_enUS; loc < TOTAL_LOCALES; ++loc)
+    {
+        // sessions never use a dbc locale that was not loaded
+        SparseRecordData[loc].clear();
+        if (sWorld->GetAvailableDbcLocale(LocaleConstant(loc)) != loc)
+            continue;
+
+        ByteBuffer buffer;
+        sDB2Manager.WriteRecordWithOptionalData(sItemSparseStore, GetId(), LocaleConstant(loc), buffer);
+        if (!buffer.empty())
+            SparseRecordData[loc].assign(buffer.contents(), buffer.contents() + buffer.size());
+    }
+}
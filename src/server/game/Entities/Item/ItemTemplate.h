@@ -22,6 +22,7 @@
 #include "DB2Structure.h"
 #include "Errors.h"
 #include "SharedDefines.h"
+#include <array>
 #include <bitset>
 #include <vector>
 
@@ -826,6 +827,9 @@ struct TC_GAME_API ItemTemplate
     uint32 RandomBonusListTemplateId;
     std::bitset<MAX_CLASSES * MAX_SPECIALIZATIONS> Specializations[3];  // one set for 1-40 level range and another for 41-109 and one for 110
     uint32 ItemSpecClassMask;
+    std::array<std::vector<uint8>, TOTAL_LOCALES> SparseRecordData;     // ItemSparse record as written into db query replies, only for available dbc locales
+
+    void InitializeQueryData();
 
     // helpers
     bool CanChangeEquipStateInCombat() const;
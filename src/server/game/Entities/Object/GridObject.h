@@ -25,13 +25,35 @@ template<class T>
 class GridObject
 {
     public:
+        GridObject() : _gridSlot(0) { }
         virtual ~GridObject() { }
 
         bool IsInGrid() const { return _gridRef.isValid(); }
-        void AddToGrid(GridRefManager<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
-        void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); }
+        void AddToGrid(GridRefManager<T>& m)
+        {
+            ASSERT(!IsInGrid());
+            _gridRef.link(&m, (T*)this);
+            m.GetDenseContainer().Insert((T*)this);
+            if (GridOccupancy* occupancy = m.GetOccupancy())
+                occupancy->Add(GridMapTypeMaskOf<T>);
+            if constexpr (IsGridPositionIndexed<T>)
+                m.GetPositionIndex().Insert((T*)this);
+        }
+        void RemoveFromGrid()
+        {
+            ASSERT(IsInGrid());
+            if constexpr (IsGridPositionIndexed<T>)
+                _gridRef.getTarget()->GetPositionIndex().Remove((T*)this);
+            _gridRef.getTarget()->GetDenseContainer().Remove((T*)this);
+            if (GridOccupancy* occupancy = _gridRef.getTarget()->GetOccupancy())
+                occupancy->Remove(GridMapTypeMaskOf<T>);
+            _gridRef.unlink();
+        }
     private:
+        friend class GridDenseContainer<T>;
+
         GridReference<T> _gridRef;
+        uint32 _gridSlot;
 };
 
 #endif
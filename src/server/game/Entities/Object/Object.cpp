@@ -79,6 +79,7 @@ Object::Object() : m_values(this)
     m_isNewObject       = false;
     m_isDestroyedObject = false;
     m_objectUpdated     = false;
+    m_objectUpdatePriority = UF::UpdateFieldPriority::Immediate;
 }
 
 Object::~Object()
@@ -773,10 +774,17 @@ void Object::BuildValuesUpdateWithFlag(ByteBuffer* data, UF::UpdateFieldFlag /*f
     data->put<uint32>(sizePos, data->wpos() - sizePos - 4);
 }
 
-void Object::AddToObjectUpdateIfNeeded()
+void Object::AddToObjectUpdateIfNeeded(UF::UpdateFieldPriority priority /*= UF::UpdateFieldPriority::Immediate*/)
 {
-    if (m_inWorld && !m_objectUpdated)
-        m_objectUpdated = AddToObjectUpdate();
+    if (!m_inWorld)
+        return;
+
+    // an immediate change also flushes coalesced changes queued earlier
+    if (m_objectUpdated && priority >= m_objectUpdatePriority)
+        return;
+
+    m_objectUpdated = AddToObjectUpdate(priority);
+    m_objectUpdatePriority = priority;
 }
 
 void Object::ClearUpdateMask(bool remove)
@@ -791,7 +799,16 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+bool Object::HasViewerDependentChanges() const
+{
+    if (!m_values.HasChanged(TYPEID_OBJECT))
+        return false;
+
+    return m_objectData->HasChanged(&UF::ObjectData::EntryID)
+        || m_objectData->HasChanged(&UF::ObjectData::DynamicFlags);
+}
+
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateCache* cache /*= nullptr*/) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -802,7 +819,25 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    // players also receive their own ActivePlayerData, which nobody else does
+    if (!cache || player == this)
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    UF::UpdateFieldFlag flags = GetUpdateFieldFlagsFor(player);
+    ByteBuffer& buf = PrepareValuesUpdateBuffer(&iter->second);
+    if (ByteBuffer const* block = cache->Find(flags))
+        buf.append(*block);
+    else
+    {
+        std::size_t blockPos = buf.wpos();
+        BuildValuesUpdate(&buf, player);
+        cache->Add(flags, buf.contents() + blockPos, buf.wpos() - blockPos);
+    }
+
+    iter->second.AddUpdateBlock();
 }
 
 std::string Object::GetDebugInfo() const
@@ -875,6 +910,32 @@ m_currMap(nullptr), m_InstanceId(0), _dbPhase(0), m_notifyflags(0)
     m_serverSideVisibilityDetect.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE);
 }
 
+struct CombatLogObserverCache
+{
+    uint32 GameTimeMS = 0;
+    std::vector<ObjectGuid> Observers;
+};
+
+struct TerrainStatusCache
+{
+    // moving less than this keeps the cached terrain status, small enough for the same floor, WMO group and liquid surface
+    static constexpr float MaxDistance = 0.1f;
+    static constexpr float AreaCellSize = SIZE_OF_GRIDS / 16.0f;
+
+    bool IsValidFor(Position const& pos, float collisionHeight) const
+    {
+        return Status
+            && CollisionHeight == collisionHeight
+            && Pos.GetExactDistSq(pos) <= MaxDistance * MaxDistance
+            && std::floor(Pos.GetPositionX() / AreaCellSize) == std::floor(pos.GetPositionX() / AreaCellSize)
+            && std::floor(Pos.GetPositionY() / AreaCellSize) == std::floor(pos.GetPositionY() / AreaCellSize);
+    }
+
+    Position Pos;
+    float CollisionHeight = 0.0f;
+    Optional<PositionFullTerrainStatus> Status;
+};
+
 WorldObject::~WorldObject()
 {
     // this may happen because there are many !create/delete
@@ -986,9 +1047,25 @@ void WorldObject::CleanupsBeforeDelete(bool /*finalCleanup*/)
 
 void WorldObject::UpdatePositionData()
 {
-    PositionFullTerrainStatus data;
-    GetMap()->GetFullTerrainStatusForPosition(_phaseShift, GetPositionX(), GetPositionY(), GetPositionZ(), data, map_liquidHeaderTypeFlags::AllLiquids, GetCollisionHeight());
-    ProcessPositionDataChanged(data);
+    if (!_terrainStatusCache)
+        _terrainStatusCache = std::make_unique<TerrainStatusCache>();
+
+    float collisionHeight = GetCollisionHeight();
+    if (!_terrainStatusCache->IsValidFor(GetPosition(), collisionHeight))
+    {
+        PositionFullTerrainStatus& data = _terrainStatusCache->Status.emplace();
+        GetMap()->GetFullTerrainStatusForPosition(_phaseShift, GetPositionX(), GetPositionY(), GetPositionZ(), data, map_liquidHeaderTypeFlags::AllLiquids, collisionHeight);
+        _terrainStatusCache->Pos.Relocate(GetPosition());
+        _terrainStatusCache->CollisionHeight = collisionHeight;
+    }
+
+    ProcessPositionDataChanged(*_terrainStatusCache->Status);
+}
+
+void WorldObject::InvalidateTerrainStatusCache()
+{
+    if (_terrainStatusCache)
+        _terrainStatusCache->Status.reset();
 }
 
 void WorldObject::ProcessPositionDataChanged(PositionFullTerrainStatus const& data)
@@ -1156,17 +1233,9 @@ bool WorldObject::IsWithinLOS(float ox, float oy, float oz, LineOfSightChecks ch
 {
     if (IsInWorld())
     {
-        oz += GetCollisionHeight();
-        float x, y, z;
-        if (GetTypeId() == TYPEID_PLAYER)
-        {
-            GetPosition(x, y, z);
-            z += GetCollisionHeight();
-        }
-        else
-            GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
-
-        return GetMap()->isInLineOfSight(GetPhaseShift(), x, y, z, ox, oy, oz, checks, ignoreFlags);
+        float positions[6];
+        GetLineOfSightPositions(ox, oy, oz, positions);
+        return GetMap()->isInLineOfSight(GetPhaseShift(), positions[0], positions[1], positions[2], positions[3], positions[4], positions[5], checks, ignoreFlags);
     }
 
     return true;
@@ -1177,25 +1246,42 @@ bool WorldObject::IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks che
     if (!IsInMap(obj))
         return false;
 
-    float ox, oy, oz;
+    float positions[6];
+    GetLineOfSightPositions(obj, positions);
+    return GetMap()->isInLineOfSight(GetPhaseShift(), positions[0], positions[1], positions[2], positions[3], positions[4], positions[5], checks, ignoreFlags);
+}
+
+void WorldObject::GetLineOfSightPositions(float x, float y, float z, float* positions) const
+{
+    positions[3] = x;
+    positions[4] = y;
+    positions[5] = z + GetCollisionHeight();
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        GetPosition(positions[0], positions[1], positions[2]);
+        positions[2] += GetCollisionHeight();
+    }
+    else
+        GetHitSpherePointFor({ positions[3], positions[4], positions[5] }, positions[0], positions[1], positions[2]);
+}
+
+void WorldObject::GetLineOfSightPositions(WorldObject const* obj, float* positions) const
+{
     if (obj->GetTypeId() == TYPEID_PLAYER)
     {
-        obj->GetPosition(ox, oy, oz);
-        oz += GetCollisionHeight();
+        obj->GetPosition(positions[3], positions[4], positions[5]);
+        positions[5] += GetCollisionHeight();
     }
     else
-        obj->GetHitSpherePointFor({ GetPositionX(), GetPositionY(), GetPositionZ() + GetCollisionHeight() }, ox, oy, oz);
+        obj->GetHitSpherePointFor({ GetPositionX(), GetPositionY(), GetPositionZ() + GetCollisionHeight() }, positions[3], positions[4], positions[5]);
 
-    float x, y, z;
     if (GetTypeId() == TYPEID_PLAYER)
     {
-        GetPosition(x, y, z);
-        z += GetCollisionHeight();
+        GetPosition(positions[0], positions[1], positions[2]);
+        positions[2] += GetCollisionHeight();
     }
     else
-        GetHitSpherePointFor({ obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ() + obj->GetCollisionHeight() }, x, y, z);
-
-    return GetMap()->isInLineOfSight(GetPhaseShift(), x, y, z, ox, oy, oz, checks, ignoreFlags);
+        GetHitSpherePointFor({ obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ() + obj->GetCollisionHeight() }, positions[0], positions[1], positions[2]);
 }
 
 void WorldObject::GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const
@@ -1753,32 +1839,58 @@ void WorldObject::SendMessageToSet(WorldPacket const* data, Player const* skippe
 
 struct CombatLogSender
 {
-    WorldPackets::CombatLog::CombatLogServerPacket const* i_message;
+    // both variants are serialized once and shared by all receivers of that variant
+    Trinity::PacketSenderRef BasicLog;
+    Trinity::PacketSenderRef FullLog;
 
-    explicit CombatLogSender(WorldPackets::CombatLog::CombatLogServerPacket* msg)
-        : i_message(msg)
-    {
-        msg->Write();
-    }
+    explicit CombatLogSender(WorldPackets::CombatLog::CombatLogServerPacket const* msg)
+        : BasicLog(msg->GetBasicLogPacket()), FullLog(msg->GetFullLogPacket()) { }
 
     void operator()(Player const* player) const
     {
         if (player->IsAdvancedCombatLoggingEnabled())
-            player->SendDirectMessage(i_message->GetFullLogPacket());
+            FullLog(player);
         else
-            player->SendDirectMessage(i_message->GetBasicLogPacket());
+            BasicLog(player);
+    }
+};
+
+struct CombatLogObserverCollector
+{
+    std::vector<ObjectGuid>& Observers;
+
+    void operator()(Player const* player) const
+    {
+        Observers.push_back(player->GetGUID());
     }
 };
 
 void WorldObject::SendCombatLogMessage(WorldPackets::CombatLog::CombatLogServerPacket* combatLog) const
 {
+    combatLog->Write();
     CombatLogSender combatLogSender(combatLog);
 
     if (Player const* self = ToPlayer())
         combatLogSender(self);
 
-    Trinity::MessageDistDeliverer<CombatLogSender> notifier(this, combatLogSender, GetVisibilityRange());
-    Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
+    // multi target spells and fast periodic effects send many logs per tick, receivers are searched once per tick
+    uint32 const gameTimeMS = GameTime::GetGameTimeMS();
+    if (!_combatLogObservers || _combatLogObservers->GameTimeMS != gameTimeMS)
+    {
+        if (!_combatLogObservers)
+            _combatLogObservers = std::make_unique<CombatLogObserverCache>();
+
+        _combatLogObservers->GameTimeMS = gameTimeMS;
+        _combatLogObservers->Observers.clear();
+
+        CombatLogObserverCollector collector{ _combatLogObservers->Observers };
+        Trinity::MessageDistDeliverer<CombatLogObserverCollector> notifier(this, collector, GetVisibilityRange());
+        Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
+    }
+
+    for (ObjectGuid const& observerGuid : _combatLogObservers->Observers)
+        if (Player const* observer = ObjectAccessor::GetPlayer(*this, observerGuid))
+            combatLogSender(observer);
 }
 
 void WorldObject::SetMap(Map* map)
@@ -1795,6 +1907,7 @@ void WorldObject::SetMap(Map* map)
     m_currMap = map;
     m_mapId = map->GetId();
     m_InstanceId = map->GetInstanceId();
+    InvalidateTerrainStatusCache();
     if (IsWorldObject())
         m_currMap->AddWorldObject(this);
 }
@@ -3576,7 +3689,9 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
     GuidSet plr_list;
-    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) { }
+    ValuesUpdateCache i_valuesCache;
+    bool i_useValuesCache;
+    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj), i_useValuesCache(!obj.HasViewerDependentChanges()) { }
     void Visit(PlayerMapType &m)
     {
         Player* source = nullptr;
@@ -3633,7 +3748,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, i_useValuesCache ? &i_valuesCache : nullptr);
             plr_list.insert(player->GetGUID());
         }
     }
@@ -3650,9 +3765,9 @@ void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
     ClearUpdateMask(false);
 }
 
-bool WorldObject::AddToObjectUpdate()
+bool WorldObject::AddToObjectUpdate(UF::UpdateFieldPriority priority)
 {
-    GetMap()->AddUpdateObject(this);
+    GetMap()->AddUpdateObject(this, priority);
     return true;
 }
 
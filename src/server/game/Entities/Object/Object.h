@@ -60,10 +60,12 @@ class UpdateData;
 class WorldObject;
 class WorldPacket;
 class ZoneScript;
+struct CombatLogObserverCache;
 struct FactionTemplateEntry;
 struct Loot;
 struct PositionFullTerrainStatus;
 struct QuaternionData;
+struct TerrainStatusCache;
 enum ZLiquidStatus : uint32;
 
 namespace WorldPackets
@@ -76,6 +78,30 @@ namespace WorldPackets
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
+// Values update blocks of a single object shared by all receivers with the same UF::UpdateFieldFlag,
+// only valid until the changes mask of that object is cleared
+class ValuesUpdateCache
+{
+public:
+    ByteBuffer const* Find(UF::UpdateFieldFlag flags) const
+    {
+        for (std::pair<UF::UpdateFieldFlag, ByteBuffer> const& block : _blocks)
+            if (block.first == flags)
+                return &block.second;
+
+        return nullptr;
+    }
+
+    void Add(UF::UpdateFieldFlag flags, uint8 const* data, std::size_t size)
+    {
+        ByteBuffer& block = _blocks.emplace_back(flags, ByteBuffer(size, ByteBuffer::Reserve{})).second;
+        block.append(data, size);
+    }
+
+private:
+    std::vector<std::pair<UF::UpdateFieldFlag, ByteBuffer>> _blocks; // only a handful of flag combinations exist
+};
+
 struct CreateObjectBits
 {
     bool NoBirthAnim : 1;
@@ -193,7 +219,7 @@ class TC_GAME_API Object
         bool IsDestroyedObject() const { return m_isDestroyedObject; }
         void SetDestroyedObject(bool destroyed) { m_isDestroyedObject = destroyed; }
         virtual void BuildUpdate(UpdateDataMapType&) { }
-        void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, ValuesUpdateCache* cache = nullptr) const;
 
         inline bool IsPlayer() const { return GetTypeId() == TYPEID_PLAYER; }
         static Player* ToPlayer(Object* o) { return o ? o->ToPlayer() : nullptr; }
@@ -274,6 +300,13 @@ class TC_GAME_API Object
                 AddToObjectUpdateIfNeeded();
         }
 
+        template<typename T>
+        void SetUpdateFieldValue(UF::UpdateFieldSetter<T> setter, typename UF::UpdateFieldSetter<T>::value_type value, UF::UpdateFieldPriority priority)
+        {
+            if (UF::SetUpdateFieldValue(setter, std::move(value)))
+                AddToObjectUpdateIfNeeded(priority);
+        }
+
         template<typename T>
         void SetUpdateFieldFlagValue(UF::UpdateFieldSetter<T> setter, typename UF::UpdateFieldSetter<T>::value_type flag)
         {
@@ -380,6 +413,8 @@ class TC_GAME_API Object
 
     public:
         virtual void BuildValuesUpdateWithFlag(ByteBuffer* data, UF::UpdateFieldFlag flags, Player const* target) const;
+        // true when a changed field is written through ViewerDependentValue and may differ between receivers with the same flags
+        virtual bool HasViewerDependentChanges() const;
 
     protected:
         uint16 m_objectType;
@@ -387,11 +422,12 @@ class TC_GAME_API Object
         TypeID m_objectTypeId;
         CreateObjectBits m_updateFlag;
 
-        virtual bool AddToObjectUpdate() = 0;
+        virtual bool AddToObjectUpdate(UF::UpdateFieldPriority priority) = 0;
         virtual void RemoveFromObjectUpdate() = 0;
-        void AddToObjectUpdateIfNeeded();
+        void AddToObjectUpdateIfNeeded(UF::UpdateFieldPriority priority = UF::UpdateFieldPriority::Immediate);
 
         bool m_objectUpdated;
+        UF::UpdateFieldPriority m_objectUpdatePriority;
 
     private:
         ObjectGuid m_guid;
@@ -565,6 +601,9 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true, bool incOwnRadius = true, bool incTargetRadius = true) const;
         bool IsWithinLOS(float x, float y, float z, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
         bool IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
+        // positions checked by IsWithinLOS and IsWithinLOSInMap, as x1, y1, z1, x2, y2, z2
+        void GetLineOfSightPositions(float x, float y, float z, float* positions) const;
+        void GetLineOfSightPositions(WorldObject const* obj, float* positions) const;
         Position GetHitSpherePointFor(Position const& dest) const;
         void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const;
         bool GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D = true) const;
@@ -706,9 +745,11 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         virtual void UpdateObjectVisibilityOnCreate() { UpdateObjectVisibility(true); }
         virtual void UpdateObjectVisibilityOnDestroy() { DestroyForNearbyPlayers(); }
         void UpdatePositionData();
+        /// Forces the next UpdatePositionData call to query terrain again, for changes that are not caused by moving (phases, transports, maps)
+        void InvalidateTerrainStatusCache();
 
         void BuildUpdate(UpdateDataMapType&) override;
-        bool AddToObjectUpdate() override;
+        bool AddToObjectUpdate(UF::UpdateFieldPriority priority) override;
         void RemoveFromObjectUpdate() override;
 
         //relocation and visibility system functions
@@ -739,7 +780,7 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         uint32 GetTransTime()   const { return m_movementInfo.transport.time; }
         int8 GetTransSeat()     const { return m_movementInfo.transport.seat; }
         virtual ObjectGuid GetTransGUID() const;
-        void SetTransport(TransportBase* t) { m_transport = t; }
+        void SetTransport(TransportBase* t) { m_transport = t; InvalidateTerrainStatusCache(); }
 
         MovementInfo m_movementInfo;
 
@@ -819,6 +860,10 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
 
         std::unique_ptr<SmoothPhasing> _smoothPhasing;
 
+        mutable std::unique_ptr<CombatLogObserverCache> _combatLogObservers;   // receivers of combat log messages sent during the current world tick
+
+        std::unique_ptr<TerrainStatusCache> _terrainStatusCache;                // terrain status of the last position UpdatePositionData queried
+
         virtual bool _IsWithinDist(WorldObject const* obj, float dist2compare, bool is3D, bool incOwnRadius = true, bool incTargetRadius = true) const;
 
         bool CanDetect(WorldObject const* obj, bool ignoreStealth, bool checkAlert = false) const;
@@ -68,5 +68,4 @@ void UpdateData::Clear()
     m_destroyGUIDs.clear();
     m_outOfRangeGUIDs.clear();
     m_blockCount = 0;
-    m_map = 0;
 }
@@ -41,6 +41,13 @@ namespace UF
 
     DEFINE_ENUM_FLAG(UpdateFieldFlag);
 
+    // how soon a changed field has to reach clients, lower values win when an object has changes of both kinds
+    enum class UpdateFieldPriority : uint8
+    {
+        Immediate = 0,  // sent on the next map update
+        Coalesced = 1   // cosmetic or slowly varying, may be held back for MapUpdate.CoalescedObjectUpdateInterval
+    };
+
     template<typename T>
     class UpdateFieldBase;
 
@@ -592,6 +599,22 @@ namespace UF
             _changesMask.Reset(Bit);
         }
 
+        template<typename Derived, typename T, int32 BlockBit, uint32 Bit>
+        bool HasChanged(UpdateField<T, BlockBit, Bit>(Derived::*)) const
+        {
+            static_assert(std::is_base_of_v<Base, Derived>, "Given field argument must belong to the same structure as this HasChangesMask");
+
+            return _changesMask[Bit];
+        }
+
+        template<typename Derived, typename T, std::size_t Size, uint32 Bit, uint32 FirstElementBit>
+        bool HasChanged(UpdateFieldArray<T, Size, Bit, FirstElementBit>(Derived::*)) const
+        {
+            static_assert(std::is_base_of_v<Base, Derived>, "Given field argument must belong to the same structure as this HasChangesMask");
+
+            return _changesMask[Bit];
+        }
+
         Mask const& GetChangesMask() const { return _changesMask; }
 
     protected:
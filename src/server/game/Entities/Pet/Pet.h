@@ -164,7 +164,7 @@ class TC_GAME_API Pet : public Guardian
         uint16 m_petSpecialization;
 
     private:
-        void SaveToDB(uint32, std::vector<Difficulty> const&) override              // override of Creature::SaveToDB     - must not be called
+        void SaveToDB(uint32, std::span<Difficulty const>) override              // override of Creature::SaveToDB     - must not be called
         {
             ABORT();
         }
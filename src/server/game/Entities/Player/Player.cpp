@@ -68,6 +68,7 @@
 #include "GameTime.h"
 #include "Guild.h"
 #include "GuildMgr.h"
+#include "Hash.h"
 #include "InstanceLockMgr.h"
 #include "InstancePackets.h"
 #include "InstanceScript.h"
@@ -181,6 +182,8 @@ Player::Player(WorldSession* session) : Unit(true), m_sceneMgr(this)
 
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
     m_customizationsChanged = false;
+    m_saveDirtyFlags = PlayerSaveDirtyFlags::None;
+    m_lastSavedStatsHash = 0;
 
     memset(m_items, 0, sizeof(Item*)*PLAYER_SLOTS_COUNT);
 
@@ -239,6 +242,11 @@ Player::Player(WorldSession* session) : Unit(true), m_sceneMgr(this)
 
     m_logintime = GameTime::GetGameTime();
     m_Last_tick = m_logintime;
+    m_enchantDurationTimer = 0;
+    m_nextEnchantDurationExpireTime = std::numeric_limits<uint64>::max();
+    m_itemDurationTimer = 0;
+    m_nextItemDurationExpireTime = std::numeric_limits<uint32>::max();
+    m_nextSoulboundTradeExpireTime = std::numeric_limits<uint32>::max();
     m_Played_time[PLAYED_TIME_TOTAL] = 0;
     m_Played_time[PLAYED_TIME_LEVEL] = 0;
     m_WeaponProficiency = 0;
@@ -256,6 +264,8 @@ Player::Player(WorldSession* session) : Unit(true), m_sceneMgr(this)
     m_lastpetnumber = 0;
 
     m_mailsUpdated = false;
+    m_mailItemsLoaded = true;
+    m_mailItemsLoading = false;
     unReadMails = 0;
     m_nextMailDelivereTime = 0;
 
@@ -318,6 +328,8 @@ Player::Player(WorldSession* session) : Unit(true), m_sceneMgr(this)
     m_lastFallTime = 0;
     m_lastFallZ = 0;
 
+    m_lastVisibilityUpdateRadius = 0.0f;
+
     m_fishingSteps = 0;
 
     m_ControlledByPlayer = true;
@@ -352,7 +364,7 @@ Player::Player(WorldSession* session) : Unit(true), m_sceneMgr(this)
     for (uint8 i = 0; i < MAX_CUF_PROFILES; ++i)
         _CUFProfiles[i] = nullptr;
 
-    m_groupUpdateTimer.Reset(5000);
+    m_groupUpdateTimer.Reset(sWorld->getIntConfig(CONFIG_GROUP_OUT_OF_RANGE_UPDATE_INTERVAL));
 
     _advancedCombatLoggingEnabled = false;
 
@@ -970,9 +982,19 @@ void Player::Update(uint32 p_time)
 
     Unit::AIUpdateTick(p_time);
 
-    // Update items that have just a limited lifetime
+    // reputation changes since the last update are sent in one packet
+    m_reputationMgr->SendPendingStates();
+
+    // objects that became visible in a crowd are created a batch per update
+    SendPendingVisibleObjects();
+
+    // Update items that have just a limited lifetime, they are only visited once the first of them expires
     if (now > m_Last_tick)
-        UpdateItemDuration(uint32(now - m_Last_tick));
+    {
+        m_itemDurationTimer += uint32(now - m_Last_tick);
+        if (m_itemDurationTimer >= m_nextItemDurationExpireTime)
+            UpdateItemDurationTimer();
+    }
 
     // check every second
     if (now > m_Last_tick + 1)
@@ -1213,7 +1235,7 @@ void Player::Update(uint32 p_time)
     if (m_groupUpdateTimer.Passed())
     {
         SendUpdateToOutOfRangeGroupMembers();
-        m_groupUpdateTimer.Reset(5000);
+        m_groupUpdateTimer.Reset(sWorld->getIntConfig(CONFIG_GROUP_OUT_OF_RANGE_UPDATE_INTERVAL));
     }
 
     Pet* pet = GetPet();
@@ -2768,6 +2790,9 @@ bool Player::AddTalent(TalentEntry const* talent, uint8 spec, bool learning)
     else
         (*GetTalentMap(spec))[talent->ID] = learning ? PLAYERSPELL_NEW : PLAYERSPELL_UNCHANGED;
 
+    if (learning)
+        SetSaveDirty(PlayerSaveDirtyFlags::Talents);
+
     if (spec == GetActiveTalentGroup())
     {
         LearnSpell(talent->SpellID, true);
@@ -2800,7 +2825,10 @@ void Player::RemoveTalent(TalentEntry const* talent)
     // if this talent rank can be found in the PlayerTalentMap, mark the talent as removed so it gets deleted
     PlayerTalentMap::iterator plrTalent = GetTalentMap(GetActiveTalentGroup())->find(talent->ID);
     if (plrTalent != GetTalentMap(GetActiveTalentGroup())->end())
+    {
         plrTalent->second = PLAYERSPELL_REMOVED;
+        SetSaveDirty(PlayerSaveDirtyFlags::Talents);
+    }
 }
 
 void Player::AddStoredAuraTeleportLocation(uint32 spellId)
@@ -3597,6 +3625,11 @@ void Player::ResetPvpTalents()
 
 Mail* Player::GetMail(uint64 id)
 {
+    // mail state may change after this, which must not happen with unknown attachments
+    // the client only acts on mails it received in the mail list, which is sent after the items were loaded
+    if (!m_mailItemsLoaded)
+        return nullptr;
+
     for (PlayerMails::iterator itr = m_mail.begin(); itr != m_mail.end(); ++itr)
         if ((*itr)->messageID == id)
             return (*itr);
@@ -6312,6 +6345,11 @@ void Player::SendDirectMessage(WorldPacket const* data) const
     m_session->SendPacket(data);
 }
 
+void Player::SendDirectMessage(std::shared_ptr<SharedWorldPacket const> const& data) const
+{
+    m_session->SendPacket(data);
+}
+
 void Player::SendCinematicStart(uint32 CinematicSequenceId) const
 {
     WorldPackets::Misc::TriggerCinematic packet;
@@ -7501,7 +7539,7 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea)
     m_zoneUpdateId = newZone;
     m_zoneUpdateTimer = ZONE_UPDATE_INTERVAL;
 
-    GetMap()->UpdatePlayerZoneStats(oldZone, newZone);
+    GetMap()->UpdatePlayerZoneStats(this, oldZone, newZone);
 
     // call leave script hooks immedately (before updating flags)
     if (oldZone != newZone)
@@ -9424,6 +9462,17 @@ uint32 Player::GetItemCount(uint32 item, bool inBankAlso, Item* skipItem) const
         location |= ItemSearchLocation::Bank;
 
     uint32 count = 0;
+    if (!countGems)
+    {
+        if (std::vector<Item*> const* items = Trinity::Containers::MapGetValuePtr(m_storedItemsByEntry, item))
+            for (Item* pItem : *items)
+                if (pItem != skipItem && GetStoredItemLocation(pItem).HasFlag(location))
+                    count += pItem->GetCount();
+
+        return count;
+    }
+
+    // gems socketed into other items are not indexed
     ForEachItem(location, [&count, item, skipItem, countGems](Item* pItem)
     {
         if (pItem != skipItem)
@@ -9472,18 +9521,83 @@ std::vector<Item*> Player::GetCraftingReagentItemsToDeposit()
 
 Item* Player::GetItemByGuid(ObjectGuid guid) const
 {
-    Item* result = nullptr;
-    ForEachItem(ItemSearchLocation::Everywhere, [&result, guid](Item* item)
+    if (Item* item = Trinity::Containers::MapGetValuePtr(m_storedItemsByGuid, guid))
+        if (GetStoredItemLocation(item).HasFlag(ItemSearchLocation::Everywhere))
+            return item;
+
+    return nullptr;
+}
+
+void Player::AddStoredItemToIndex(Item* item)
+{
+    if (!m_storedItemsByGuid.try_emplace(item->GetGUID(), item).second)
+        return;
+
+    m_storedItemsByEntry[item->GetEntry()].push_back(item);
+
+    // bags carry their contents with them
+    if (Bag* bag = item->ToBag())
+        for (uint32 i = 0; i < bag->GetBagSize(); ++i)
+            if (Item* bagItem = bag->GetItemByPos(i))
+                AddStoredItemToIndex(bagItem);
+}
+
+void Player::ChangeStoredItemEntry(Item* item, uint32 entry)
+{
+    bool indexed = m_storedItemsByGuid.find(item->GetGUID()) != m_storedItemsByGuid.end();
+    if (indexed)
+        RemoveStoredItemFromIndex(item);
+
+    item->SetEntry(entry);
+
+    if (indexed)
+        AddStoredItemToIndex(item);
+}
+
+void Player::RemoveStoredItemFromIndex(Item* item)
+{
+    if (!m_storedItemsByGuid.erase(item->GetGUID()))
+        return;
+
+    auto itr = m_storedItemsByEntry.find(item->GetEntry());
+    if (itr != m_storedItemsByEntry.end())
     {
-        if (item->GetGUID() == guid)
-        {
-            result = item;
-            return ItemSearchCallbackResult::Stop;
-        }
+        std::erase(itr->second, item);
+        if (itr->second.empty())
+            m_storedItemsByEntry.erase(itr);
+    }
 
-        return ItemSearchCallbackResult::Continue;
-    });
-    return result;
+    if (Bag* bag = item->ToBag())
+        for (uint32 i = 0; i < bag->GetBagSize(); ++i)
+            if (Item* bagItem = bag->GetItemByPos(i))
+                RemoveStoredItemFromIndex(bagItem);
+}
+
+// must match the slots visited by ForEachItem for each location
+EnumFlag<ItemSearchLocation> Player::GetStoredItemLocation(Item const* item) const
+{
+    uint8 bag = item->GetBagSlot();
+    uint8 slot = item->GetSlot();
+    if (bag == INVENTORY_SLOT_BAG_0)
+    {
+        if (slot < EQUIPMENT_SLOT_END || (slot >= PROFESSION_SLOT_START && slot < PROFESSION_SLOT_END))
+            return ItemSearchLocation::Equipment;
+        if ((slot >= INVENTORY_SLOT_BAG_START && slot < INVENTORY_SLOT_ITEM_START + GetInventorySlotCount())
+            || (slot >= CHILD_EQUIPMENT_SLOT_START && slot < CHILD_EQUIPMENT_SLOT_END))
+            return ItemSearchLocation::Inventory;
+        if (slot >= BANK_SLOT_ITEM_START && slot < BANK_SLOT_BAG_END)
+            return ItemSearchLocation::Bank;
+        if (slot >= REAGENT_SLOT_START && slot < REAGENT_SLOT_END)
+            return ItemSearchLocation::ReagentBank;
+    }
+    else if (bag >= INVENTORY_SLOT_BAG_START && bag < INVENTORY_SLOT_BAG_END)
+        return ItemSearchLocation::Inventory;
+    else if (bag >= BANK_SLOT_BAG_START && bag < BANK_SLOT_BAG_END)
+        return ItemSearchLocation::Bank;
+    else if (bag >= REAGENT_BAG_SLOT_START && bag < REAGENT_BAG_SLOT_END)
+        return ItemSearchLocation::ReagentBank;
+
+    return ItemSearchLocation(0);
 }
 
 Item* Player::GetItemByPos(uint16 pos) const
@@ -9798,17 +9912,22 @@ bool Player::HasItemCount(uint32 item, uint32 count, bool inBankAlso) const
     if (inBankAlso)
         location |= ItemSearchLocation::Bank;
 
+    std::vector<Item*> const* items = Trinity::Containers::MapGetValuePtr(m_storedItemsByEntry, item);
+    if (!items)
+        return false;
+
     uint32 currentCount = 0;
-    return !ForEachItem(location, [item, count, &currentCount](Item* pItem)
+    for (Item* pItem : *items)
     {
-        if (pItem->GetEntry() == item && !pItem->IsInTrade())
+        if (!pItem->IsInTrade() && GetStoredItemLocation(pItem).HasFlag(location))
         {
             currentCount += pItem->GetCount();
             if (currentCount >= count)
-                return ItemSearchCallbackResult::Stop;
+                return true;
         }
-        return ItemSearchCallbackResult::Continue;
-    });
+    }
+
+    return false;
 }
 
 bool Player::HasItemOrGemWithIdEquipped(uint32 item, uint32 count, uint8 except_slot) const
@@ -11578,6 +11697,8 @@ Item* Player::_StoreItem(uint16 pos, Item* pItem, uint32 count, bool clone, bool
         else
             pBag->StoreItem(slot, pItem, update);
 
+        AddStoredItemToIndex(pItem);
+
         if (IsInWorld() && update)
         {
             pItem->AddToWorld();
@@ -11932,6 +12053,7 @@ void Player::VisualizeItem(uint8 slot, Item* pItem)
     pItem->SetOwnerGUID(GetGUID());
     pItem->SetSlot(slot);
     pItem->SetContainer(nullptr);
+    AddStoredItemToIndex(pItem);
 
     if (slot < EQUIPMENT_SLOT_END)
         SetVisibleItemSlot(slot, pItem);
@@ -12016,6 +12138,8 @@ void Player::RemoveItem(uint8 bag, uint8 slot, bool update)
         else if (Bag* pBag = GetBagByPos(bag))
             pBag->RemoveItem(slot, update);
 
+        RemoveStoredItemFromIndex(pItem);
+
         pItem->SetContainedIn(ObjectGuid::Empty);
         // pItem->SetUInt64Value(ITEM_FIELD_OWNER, 0); not clear owner at remove (it will be set at store). This used in mail and auction code
         pItem->SetSlot(NULL_SLOT);
@@ -12152,6 +12276,8 @@ void Player::DestroyItem(uint8 bag, uint8 slot, bool update)
         else if (Bag* pBag = GetBagByPos(bag))
             pBag->RemoveItem(slot, update);
 
+        RemoveStoredItemFromIndex(pItem);
+
         // Delete rolled money / loot from db.
         // MUST be done before RemoveFromWorld() or GetTemplate() fails
         if (pProto->HasFlag(ITEM_FLAG_HAS_LOOT))
@@ -12487,18 +12613,12 @@ void Player::DestroyConjuredItems(bool update)
 
 Item* Player::GetItemByEntry(uint32 entry, ItemSearchLocation where /*= ItemSearchLocation::Default */) const
 {
-    Item* result = nullptr;
-    ForEachItem(where, [&result, entry](Item* item)
-    {
-        if (item->GetEntry() == entry)
-        {
-            result = item;
-            return ItemSearchCallbackResult::Stop;
-        }
+    if (std::vector<Item*> const* items = Trinity::Containers::MapGetValuePtr(m_storedItemsByEntry, entry))
+        for (Item* item : *items)
+            if (GetStoredItemLocation(item).HasFlag(where))
+                return item;
 
-        return ItemSearchCallbackResult::Continue;
-    });
-    return result;
+    return nullptr;
 }
 
 std::vector<Item*> Player::GetItemListByEntry(uint32 entry, bool inBankAlso) const
@@ -12508,13 +12628,11 @@ std::vector<Item*> Player::GetItemListByEntry(uint32 entry, bool inBankAlso) con
         location |= ItemSearchLocation::Bank;
 
     std::vector<Item*> itemList = std::vector<Item*>();
-    ForEachItem(location, [&itemList, entry](Item* item)
-    {
-        if (item->GetEntry() == entry)
-            itemList.push_back(item);
+    if (std::vector<Item*> const* items = Trinity::Containers::MapGetValuePtr(m_storedItemsByEntry, entry))
+        for (Item* item : *items)
+            if (GetStoredItemLocation(item).HasFlag(location))
+                itemList.push_back(item);
 
-        return ItemSearchCallbackResult::Continue;
-    });
     return itemList;
 }
 
@@ -13294,20 +13412,28 @@ void Player::TradeCancel(bool sendback)
 
 void Player::UpdateSoulboundTradeItems()
 {
+    if (m_itemSoulboundTradeable.empty() || m_nextSoulboundTradeExpireTime >= GetTotalPlayedTime())
+        return;
+
     // also checks for garbage data
+    m_nextSoulboundTradeExpireTime = std::numeric_limits<uint32>::max();
     for (GuidUnorderedSet::iterator itr = m_itemSoulboundTradeable.begin(); itr != m_itemSoulboundTradeable.end();)
     {
         Item* item = GetItemByGuid(*itr);
         if (!item || item->GetOwnerGUID() != GetGUID() || item->CheckSoulboundTradeExpire())
             itr = m_itemSoulboundTradeable.erase(itr);
         else
+        {
+            m_nextSoulboundTradeExpireTime = std::min<uint32>(m_nextSoulboundTradeExpireTime, item->m_itemData->CreatePlayedTime + 2 * HOUR);
             ++itr;
+        }
     }
 }
 
 void Player::AddTradeableItem(Item* item)
 {
     m_itemSoulboundTradeable.insert(item->GetGUID());
+    m_nextSoulboundTradeExpireTime = std::min<uint32>(m_nextSoulboundTradeExpireTime, item->m_itemData->CreatePlayedTime + 2 * HOUR);
 }
 
 void Player::RemoveTradeableItem(Item* item)
@@ -13323,18 +13449,61 @@ void Player::UpdateItemDuration(uint32 time, bool realtimeonly)
     TC_LOG_DEBUG("entities.player.items", "Player::UpdateItemDuration: Player '{}' ({}), Time: {}, RealTimeOnly: {}",
         GetName(), GetGUID().ToString(), time, realtimeonly);
 
-    for (ItemDurationList::const_iterator itr = m_itemDuration.begin(); itr != m_itemDuration.end();)
+    for (ItemDurationList::iterator itr = m_itemDuration.begin(); itr != m_itemDuration.end();)
     {
-        Item* item = *itr;
+        Item* item = itr->item;
+        itr->updateTime = m_itemDurationTimer;
         ++itr;                                              // current element can be erased in UpdateDuration
 
         if (!realtimeonly || item->GetTemplate()->HasFlag(ITEM_FLAG_REAL_DURATION))
             item->UpdateDuration(this, time);
     }
+
+    m_nextItemDurationExpireTime = std::numeric_limits<uint32>::max();
+    for (ItemDuration const& itemDuration : m_itemDuration)
+        if (uint32 expiration = itemDuration.item->m_itemData->Expiration)
+            m_nextItemDurationExpireTime = std::min(m_nextItemDurationExpireTime, itemDuration.updateTime + expiration);
+}
+
+void Player::UpdateItemDurationTimer()
+{
+    for (ItemDurationList::iterator itr = m_itemDuration.begin(); itr != m_itemDuration.end();)
+    {
+        Item* item = itr->item;
+        uint32 time = m_itemDurationTimer - itr->updateTime;
+        itr->updateTime = m_itemDurationTimer;
+        ++itr;                                              // current element can be erased in UpdateDuration
+
+        if (time)
+            item->UpdateDuration(this, time);
+    }
+
+    m_nextItemDurationExpireTime = std::numeric_limits<uint32>::max();
+    for (ItemDuration const& itemDuration : m_itemDuration)
+        if (uint32 expiration = itemDuration.item->m_itemData->Expiration)
+            m_nextItemDurationExpireTime = std::min(m_nextItemDurationExpireTime, itemDuration.updateTime + expiration);
+}
+
+void Player::StoreElapsedItemDuration(ItemDuration& itemDuration)
+{
+    uint32 time = m_itemDurationTimer - itemDuration.updateTime;
+    if (!time)
+        return;
+
+    // expired items are left to the next UpdateItemDurationTimer, items must not be destroyed while saving or sending
+    itemDuration.updateTime = m_itemDurationTimer;
+    uint32 duration = itemDuration.item->m_itemData->Expiration;
+    itemDuration.item->SetExpiration(duration > time ? duration - time : 1);
+    itemDuration.item->SetState(ITEM_CHANGED, this);
 }
 
 void Player::UpdateEnchantTime(uint32 time)
 {
+    m_enchantDurationTimer += time;
+    if (m_enchantDurationTimer < m_nextEnchantDurationExpireTime)
+        return;
+
+    m_nextEnchantDurationExpireTime = std::numeric_limits<uint64>::max();
     for (EnchantDurationList::iterator itr = m_enchantDuration.begin(), next; itr != m_enchantDuration.end(); itr = next)
     {
         ASSERT(itr->item);
@@ -13343,20 +13512,30 @@ void Player::UpdateEnchantTime(uint32 time)
         {
             next = m_enchantDuration.erase(itr);
         }
-        else if (itr->leftduration <= time)
+        else if (itr->expireTime <= m_enchantDurationTimer)
         {
-            ApplyEnchantment(itr->item, itr->slot, false, false);
-            itr->item->ClearEnchantment(itr->slot);
+            Item* item = itr->item;
+            EnchantmentSlot slot = itr->slot;
             next = m_enchantDuration.erase(itr);
+            ApplyEnchantment(item, slot, false, false);
+            item->ClearEnchantment(slot);
         }
-        else if (itr->leftduration > time)
+        else
         {
-            itr->leftduration -= time;
+            m_nextEnchantDurationExpireTime = std::min(m_nextEnchantDurationExpireTime, itr->expireTime);
             ++next;
         }
     }
 }
 
+uint32 Player::GetEnchantmentDurationLeft(EnchantDuration const& enchantDuration) const
+{
+    if (enchantDuration.expireTime <= m_enchantDurationTimer)
+        return 0;
+
+    return uint32(enchantDuration.expireTime - m_enchantDurationTimer);
+}
+
 void Player::AddEnchantmentDurations(Item* item)
 {
     for (int x = 0; x < MAX_ENCHANTMENT_SLOT; ++x)
@@ -13377,7 +13556,7 @@ void Player::RemoveEnchantmentDurations(Item* item)
         if (itr->item == item)
         {
             // save duration in item
-            item->SetEnchantmentDuration(EnchantmentSlot(itr->slot), itr->leftduration, this);
+            item->SetEnchantmentDuration(EnchantmentSlot(itr->slot), GetEnchantmentDurationLeft(*itr), this);
             itr = m_enchantDuration.erase(itr);
         }
         else
@@ -13385,6 +13564,13 @@ void Player::RemoveEnchantmentDurations(Item* item)
     }
 }
 
+void Player::RemoveEnchantmentDuration(Item* item, EnchantmentSlot slot)
+{
+    auto itr = std::ranges::find_if(m_enchantDuration, [&](EnchantDuration const& enchantDuration) { return enchantDuration.item == item && enchantDuration.slot == slot; });
+    if (itr != m_enchantDuration.end())
+        m_enchantDuration.erase(itr);
+}
+
 void Player::RemoveEnchantmentDurationsReferences(Item* item)
 {
     for (EnchantDurationList::iterator itr = m_enchantDuration.begin(); itr != m_enchantDuration.end();)
@@ -13412,10 +13598,14 @@ void Player::RemoveArenaEnchantments(EnchantmentSlot slot)
                     ++next;
                     continue;
                 }
+                Item* item = itr->item;
+                // remove from update list
+                next = m_enchantDuration.erase(itr);
                 // remove from stats
-                ApplyEnchantment(itr->item, slot, false, false);
+                ApplyEnchantment(item, slot, false, false);
                 // remove visual
-                itr->item->ClearEnchantment(slot);
+                item->ClearEnchantment(slot);
+                continue;
             }
             // remove from update list
             next = m_enchantDuration.erase(itr);
@@ -13455,7 +13645,7 @@ void Player::AddEnchantmentDuration(Item* item, EnchantmentSlot slot, uint32 dur
     {
         if (itr->item == item && itr->slot == slot)
         {
-            itr->item->SetEnchantmentDuration(itr->slot, itr->leftduration, this);
+            itr->item->SetEnchantmentDuration(itr->slot, GetEnchantmentDurationLeft(*itr), this);
             m_enchantDuration.erase(itr);
             break;
         }
@@ -13463,7 +13653,8 @@ void Player::AddEnchantmentDuration(Item* item, EnchantmentSlot slot, uint32 dur
     if (duration > 0)
     {
         GetSession()->SendItemEnchantTimeUpdate(GetGUID(), item->GetGUID(), slot, uint32(duration/1000));
-        m_enchantDuration.push_back(EnchantDuration(item, slot, duration));
+        m_enchantDuration.push_back(EnchantDuration(item, slot, m_enchantDurationTimer + duration));
+        m_nextEnchantDurationExpireTime = std::min(m_nextEnchantDurationExpireTime, m_enchantDurationTimer + duration);
     }
 }
 
@@ -13877,13 +14068,17 @@ void Player::UpdateSkillEnchantments(uint16 skill_id, uint16 curr_value, uint16
 void Player::SendEnchantmentDurations()
 {
     for (EnchantDurationList::const_iterator itr = m_enchantDuration.begin(); itr != m_enchantDuration.end(); ++itr)
-        GetSession()->SendItemEnchantTimeUpdate(GetGUID(), itr->item->GetGUID(), itr->slot, uint32(itr->leftduration) / 1000);
+        if (itr->item->GetEnchantmentId(itr->slot))
+            GetSession()->SendItemEnchantTimeUpdate(GetGUID(), itr->item->GetGUID(), itr->slot, GetEnchantmentDurationLeft(*itr) / 1000);
 }
 
 void Player::SendItemDurations()
 {
-    for (ItemDurationList::const_iterator itr = m_itemDuration.begin(); itr != m_itemDuration.end(); ++itr)
-        (*itr)->SendTimeUpdate(this);
+    for (ItemDurationList::iterator itr = m_itemDuration.begin(); itr != m_itemDuration.end(); ++itr)
+    {
+        StoreElapsedItemDuration(*itr);
+        itr->item->SendTimeUpdate(this);
+    }
 }
 
 void Player::SendNewItem(Item* item, uint32 quantity, bool pushed, bool created, bool broadcast /*= false*/, uint32 dungeonEncounterId /*= 0*/)
@@ -15081,6 +15276,7 @@ void Player::RewardQuest(Quest const* quest, LootItemType rewardType, uint32 rew
 
     uint32 quest_id = quest->GetQuestId();
     QuestStatus oldStatus = GetQuestStatus(quest_id);
+    uint8 oldLevel = GetLevel();
 
     for (QuestObjective const& obj : quest->GetObjectives())
     {
@@ -15306,7 +15502,11 @@ void Player::RewardQuest(Quest const* quest, LootItemType rewardType, uint32 rew
         UpdatePvPState();
     }
 
-    SendQuestGiverStatusMultiple();
+    // level ups change the availability of quests everywhere
+    if (GetLevel() != oldLevel)
+        SendQuestGiverStatusMultiple();
+    else
+        SendQuestGiverStatusForQuest(quest_id);
 
     bool conditionChanged = SendQuestUpdate(quest_id, false);
 
@@ -17059,39 +17259,138 @@ void Player::SendQuestUpdateAddPlayer(Quest const* quest, uint16 newCount) const
 
 void Player::SendQuestGiverStatusMultiple()
 {
+    m_questGiverStatusCache.clear();
     SendQuestGiverStatusMultiple(m_clientGUIDs);
 }
 
-void Player::SendQuestGiverStatusMultiple(GuidUnorderedSet const& guids)
+void Player::SendQuestGiverStatusMultiple(GuidFlatSet const& guids)
 {
     WorldPackets::Quest::QuestGiverStatusMultiple response;
 
     for (auto itr = guids.begin(); itr != guids.end(); ++itr)
     {
-        if (itr->IsAnyTypeCreature())
+        if (Optional<QuestGiverStatus> status = GetQuestGiverStatusFor(*itr))
         {
-            // need also pet quests case support
-            Creature* questgiver = ObjectAccessor::GetCreatureOrPetOrVehicle(*this, *itr);
-            if (!questgiver || questgiver->IsHostileTo(this))
-                continue;
-            if (!questgiver->HasNpcFlag(UNIT_NPC_FLAG_QUESTGIVER))
-                continue;
-
-            response.QuestGiver.emplace_back(questgiver->GetGUID(), GetQuestDialogStatus(questgiver));
-        }
-        else if (itr->IsGameObject())
-        {
-            GameObject* questgiver = GetMap()->GetGameObject(*itr);
-            if (!questgiver || questgiver->GetGoType() != GAMEOBJECT_TYPE_QUESTGIVER)
-                continue;
-
-            response.QuestGiver.emplace_back(questgiver->GetGUID(), GetQuestDialogStatus(questgiver));
+            response.QuestGiver.emplace_back(*itr, *status);
+            m_questGiverStatusCache[*itr] = *status;
         }
     }
 
     SendDirectMessage(response.Write());
 }
 
+void Player::SendQuestGiverStatusForQuest(uint32 questId)
+{
+    Quest const* quest = sObjectMgr->GetQuestTemplate(questId);
+    if (!quest)
+        return;
+
+    // only quest givers starting or ending a quest whose availability or completion the reward can change need to be recomputed
+    Trinity::Containers::FlatHashSet<uint32> creatureEntries;
+    Trinity::Containers::FlatHashSet<uint32> gameObjectEntries;
+    auto addQuestGivers = [&](uint32 affectedQuestId)
+    {
+        for (auto const& [_, entry] : sObjectMgr->GetCreatureQuestRelationReverseBounds(affectedQuestId))
+            creatureEntries.insert(entry);
+        for (auto const& [_, entry] : sObjectMgr->GetGameEventCreatureQuestRelationReverseBounds(affectedQuestId))
+            creatureEntries.insert(entry);
+        for (auto const& [_, entry] : sObjectMgr->GetCreatureQuestInvolvedRelationReverseBounds(affectedQuestId))
+            creatureEntries.insert(entry);
+        for (auto const& [_, entry] : sObjectMgr->GetGOQuestRelationReverseBounds(affectedQuestId))
+            gameObjectEntries.insert(entry);
+        for (auto const& [_, entry] : sObjectMgr->GetGameEventGOQuestRelationReverseBounds(affectedQuestId))
+            gameObjectEntries.insert(entry);
+        for (auto const& [_, entry] : sObjectMgr->GetGOQuestInvolvedRelationReverseBounds(affectedQuestId))
+            gameObjectEntries.insert(entry);
+    };
+
+    // quest chains, breadcrumbs, exclusive groups and quest state conditions
+    addQuestGivers(questId);
+
+    if (std::vector<uint32> const* dependents = sObjectMgr->GetQuestStatusDependents(questId))
+        for (uint32 dependentQuestId : *dependents)
+            addQuestGivers(dependentQuestId);
+
+    if (std::vector<uint32> const* dependents = sConditionMgr->GetQuestStateAvailableConditionDependents(questId))
+        for (uint32 dependentQuestId : *dependents)
+            addQuestGivers(dependentQuestId);
+
+    if (quest->GetExclusiveGroup())
+        for (auto const& [_, groupQuestId] : Trinity::Containers::MakeIteratorPair(sObjectMgr->GetExclusiveQuestGroupBounds(quest->GetExclusiveGroup())))
+            addQuestGivers(groupQuestId);
+
+    // rewards change reputation, items, auras and skills which other requirements and conditions can check
+    for (uint32 affectedQuestId : sObjectMgr->GetQuestsWithReputationOrSkillRequirements())
+        addQuestGivers(affectedQuestId);
+
+    for (uint32 affectedQuestId : sConditionMgr->GetQuestsWithNonQuestStateAvailableConditions())
+        addQuestGivers(affectedQuestId);
+
+    // reward items can complete objectives and the reward can start follow-up quests
+    for (uint8 slot = 0; slot < MAX_QUEST_LOG_SIZE; ++slot)
+        if (uint32 logQuestId = GetQuestSlotQuestId(slot))
+            addQuestGivers(logQuestId);
+
+    // givers that left the client since the last update are queried again by it when they come back
+    for (auto itr = m_questGiverStatusCache.begin(); itr != m_questGiverStatusCache.end();)
+    {
+        if (!m_clientGUIDs.contains(itr->first))
+            itr = m_questGiverStatusCache.erase(itr);
+        else
+            ++itr;
+    }
+
+    if (creatureEntries.empty() && gameObjectEntries.empty())
+        return;
+
+    WorldPackets::Quest::QuestGiverStatusMultiple response;
+
+    for (ObjectGuid const& guid : m_clientGUIDs)
+    {
+        if (guid.IsAnyTypeCreature() ? !creatureEntries.contains(guid.GetEntry()) : !guid.IsGameObject() || !gameObjectEntries.contains(guid.GetEntry()))
+            continue;
+
+        Optional<QuestGiverStatus> status = GetQuestGiverStatusFor(guid);
+        if (!status)
+            continue;
+
+        QuestGiverStatus* cachedStatus = Trinity::Containers::MapGetValuePtr(m_questGiverStatusCache, guid);
+        if (cachedStatus && *cachedStatus == *status)
+            continue;
+
+        response.QuestGiver.emplace_back(guid, *status);
+        m_questGiverStatusCache[guid] = *status;
+    }
+
+    if (!response.QuestGiver.empty())
+        SendDirectMessage(response.Write());
+}
+
+Optional<QuestGiverStatus> Player::GetQuestGiverStatusFor(ObjectGuid const& guid)
+{
+    if (guid.IsAnyTypeCreature())
+    {
+        // need also pet quests case support
+        Creature* questgiver = ObjectAccessor::GetCreatureOrPetOrVehicle(*this, guid);
+        if (!questgiver || questgiver->IsHostileTo(this))
+            return {};
+        if (!questgiver->HasNpcFlag(UNIT_NPC_FLAG_QUESTGIVER))
+            return {};
+
+        return GetQuestDialogStatus(questgiver);
+    }
+    else if (guid.IsGameObject())
+    {
+        GameObject* questgiver = GetMap()->GetGameObject(guid);
+        if (!questgiver || questgiver->GetGoType() != GAMEOBJECT_TYPE_QUESTGIVER)
+            return {};
+
+        return GetQuestDialogStatus(questgiver);
+    }
+
+    return {};
+}
+
 bool Player::HasPvPForcingQuest() const
 {
     for (uint8 i = 0; i < MAX_QUEST_LOG_SIZE; ++i)
@@ -17960,6 +18259,8 @@ bool Player::LoadFromDB(ObjectGuid guid, CharacterDatabaseQueryHolder const& hol
     UpdateDisplayPower();
     _LoadTalents(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_TALENTS));
     _LoadPvpTalents(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_PVP_TALENTS));
+    // talents read from the database don't need to be written back, later corrections at load mark them again
+    m_saveDirtyFlags = PlayerSaveDirtyFlags::None;
     _LoadSpells(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_SPELLS), holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_SPELL_FAVORITES));
     GetSession()->GetCollectionMgr()->LoadToys();
     GetSession()->GetCollectionMgr()->LoadHeirlooms();
@@ -18017,6 +18318,7 @@ bool Player::LoadFromDB(ObjectGuid guid, CharacterDatabaseQueryHolder const& hol
     StartLoadingActionButtons();
 
     // unread mails and next delivery time, actual mails not loaded
+    m_mailItemsLoaded = !sWorld->getBoolConfig(CONFIG_MAIL_LOAD_ITEMS_ON_DEMAND);
     _LoadMail(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAILS),
         holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS),
         holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_ARTIFACT),
@@ -18151,13 +18453,16 @@ bool Player::LoadFromDB(ObjectGuid guid, CharacterDatabaseQueryHolder const& hol
 
     _LoadCUFProfiles(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_CUF_PROFILES));
 
-    std::unique_ptr<Garrison> garrison = std::make_unique<Garrison>(this);
-    if (garrison->LoadFromDB(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_BLUEPRINTS),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_BUILDINGS),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_FOLLOWERS),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_FOLLOWER_ABILITIES)))
-        _garrison = std::move(garrison);
+    // most characters never use their garrison, only parse it when something asks for it
+    if (PreparedQueryResult garrisonResult = holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON))
+    {
+        _garrisonLoadResults = std::make_unique<GarrisonLoadResults>();
+        _garrisonLoadResults->Garrison = std::move(garrisonResult);
+        _garrisonLoadResults->Blueprints = holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_BLUEPRINTS);
+        _garrisonLoadResults->Buildings = holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_BUILDINGS);
+        _garrisonLoadResults->Followers = holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_FOLLOWERS);
+        _garrisonLoadResults->Abilities = holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_FOLLOWER_ABILITIES);
+    }
 
     _InitHonorLevelOnLoadFromDB(fields.honor, fields.honorLevel);
 
@@ -18257,6 +18562,10 @@ bool Player::isAllowedToLoot(const Creature* creature) const
     if (HasPendingBind())
         return false;
 
+    // loot is rolled when the corpse is opened, assume there is something to take until then
+    if (creature->HasPendingPersonalLootFor(this))
+        return true;
+
     Loot const* loot = creature->GetLootForPlayer(this);
     if (!loot || loot->isLooted()) // nothing to loot or everything looted.
         return false;
@@ -18912,8 +19221,6 @@ Item* Player::_LoadMailedItem(ObjectGuid const& playerGuid, Player* player, uint
 void Player::_LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mailItemsResult, PreparedQueryResult artifactResult, PreparedQueryResult azeriteItemResult,
     PreparedQueryResult azeriteItemMilestonePowersResult, PreparedQueryResult azeriteItemUnlockedEssencesResult, PreparedQueryResult azeriteEmpoweredItemResult)
 {
-    std::unordered_map<uint64, Mail*> mailById;
-
     if (mailsResult)
     {
         do
@@ -18944,26 +19251,114 @@ void Player::_LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mail
             m->state = MAIL_STATE_UNCHANGED;
 
             m_mail.push_back(m);
-            mailById[m->messageID] = m;
         }
         while (mailsResult->NextRow());
     }
 
-    if (mailItemsResult)
+    if (m_mailItemsLoaded)
+        _LoadMailedItems(mailItemsResult, artifactResult, azeriteItemResult, azeriteItemMilestonePowersResult, azeriteItemUnlockedEssencesResult, azeriteEmpoweredItemResult);
+
+    UpdateNextMailTimeAndUnreads();
+}
+
+void Player::_LoadMailedItems(PreparedQueryResult mailItemsResult, PreparedQueryResult artifactResult, PreparedQueryResult azeriteItemResult,
+    PreparedQueryResult azeriteItemMilestonePowersResult, PreparedQueryResult azeriteItemUnlockedEssencesResult, PreparedQueryResult azeriteEmpoweredItemResult)
+{
+    if (!mailItemsResult)
+        return;
+
+    std::unordered_map<uint64, Mail*> mailById;
+    for (Mail* mail : m_mail)
+        mailById[mail->messageID] = mail;
+
+    std::unordered_map<ObjectGuid::LowType, ItemAdditionalLoadInfo> additionalData;
+    ItemAdditionalLoadInfo::Init(&additionalData, artifactResult, azeriteItemResult, azeriteItemMilestonePowersResult,
+        azeriteItemUnlockedEssencesResult, azeriteEmpoweredItemResult);
+
+    do
     {
-        std::unordered_map<ObjectGuid::LowType, ItemAdditionalLoadInfo> additionalData;
-        ItemAdditionalLoadInfo::Init(&additionalData, artifactResult, azeriteItemResult, azeriteItemMilestonePowersResult,
-            azeriteItemUnlockedEssencesResult, azeriteEmpoweredItemResult);
+        Field* fields = mailItemsResult->Fetch();
 
-        do
+        // already known, delivered while online after the mail headers were loaded
+        if (GetMItem(fields[0].GetUInt64()))
+            continue;
+
+        uint64 mailId = fields[52].GetUInt64();
+        _LoadMailedItem(GetGUID(), this, mailId, mailById[mailId], fields, Trinity::Containers::MapGetValuePtr(additionalData, fields[0].GetUInt64()));
+    } while (mailItemsResult->NextRow());
+}
+
+class MailedItemsQueryHolder : public CharacterDatabaseQueryHolder
+{
+public:
+    enum
+    {
+        MAIL_ITEMS,
+        ARTIFACT,
+        AZERITE,
+        AZERITE_MILESTONE_POWER,
+        AZERITE_UNLOCKED_ESSENCE,
+        AZERITE_EMPOWERED,
+
+        MAX
+    };
+
+    MailedItemsQueryHolder(ObjectGuid::LowType lowGuid)
+    {
+        SetSize(MAX);
+
+        auto setQuery = [&](std::size_t index, CharacterDatabaseStatements statement)
         {
-            Field* fields = mailItemsResult->Fetch();
-            uint64 mailId = fields[52].GetUInt64();
-            _LoadMailedItem(GetGUID(), this, mailId, mailById[mailId], fields, Trinity::Containers::MapGetValuePtr(additionalData, fields[0].GetUInt64()));
-        } while (mailItemsResult->NextRow());
+            CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(statement);
+            stmt->setUInt64(0, lowGuid);
+            SetPreparedQuery(index, stmt);
+        };
+
+        setQuery(MAIL_ITEMS, CHAR_SEL_MAILITEMS);
+        setQuery(ARTIFACT, CHAR_SEL_MAILITEMS_ARTIFACT);
+        setQuery(AZERITE, CHAR_SEL_MAILITEMS_AZERITE);
+        setQuery(AZERITE_MILESTONE_POWER, CHAR_SEL_MAILITEMS_AZERITE_MILESTONE_POWER);
+        setQuery(AZERITE_UNLOCKED_ESSENCE, CHAR_SEL_MAILITEMS_AZERITE_UNLOCKED_ESSENCE);
+        setQuery(AZERITE_EMPOWERED, CHAR_SEL_MAILITEMS_AZERITE_EMPOWERED);
     }
+};
 
-    UpdateNextMailTimeAndUnreads();
+// Mail.LoadItemsOnDemand - items attached to mails are loaded the first time the mailbox is used
+// callback is only called for the request that started the load, later requests are dropped until it completes
+void Player::StartLoadingMailedItems(std::function<void()>&& callback)
+{
+    if (m_mailItemsLoaded)
+    {
+        callback();
+        return;
+    }
+
+    if (m_mailItemsLoading)
+        return;
+
+    m_mailItemsLoading = true;
+
+    WorldSession* mySess = GetSession();
+    mySess->AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(std::make_shared<MailedItemsQueryHolder>(GetGUID().GetCounter())))
+        .AfterComplete([mySess, myGuid = GetGUID(), callback = std::move(callback)](SQLQueryHolderBase const& holder)
+    {
+        // safe callback, we can't pass this pointer directly
+        // in case player logs out before db response (player would be deleted in that case)
+        Player* thisPlayer = mySess->GetPlayer();
+        if (!thisPlayer || thisPlayer->GetGUID() != myGuid)
+            return;
+
+        thisPlayer->m_mailItemsLoading = false;
+        thisPlayer->m_mailItemsLoaded = true;
+        thisPlayer->_LoadMailedItems(holder.GetPreparedResult(MailedItemsQueryHolder::MAIL_ITEMS),
+            holder.GetPreparedResult(MailedItemsQueryHolder::ARTIFACT),
+            holder.GetPreparedResult(MailedItemsQueryHolder::AZERITE),
+            holder.GetPreparedResult(MailedItemsQueryHolder::AZERITE_MILESTONE_POWER),
+            holder.GetPreparedResult(MailedItemsQueryHolder::AZERITE_UNLOCKED_ESSENCE),
+            holder.GetPreparedResult(MailedItemsQueryHolder::AZERITE_EMPOWERED));
+
+        callback();
+    });
 }
 
 void Player::_LoadQuestStatus(PreparedQueryResult result)
@@ -19635,6 +20030,13 @@ void Player::SaveToDB(LoginDatabaseTransaction loginTransaction, CharacterDataba
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
 
+    // new characters and full saves write every subsystem regardless of what changed
+    if (create || !sWorld->getBoolConfig(CONFIG_PLAYER_SAVE_INCREMENTAL))
+    {
+        m_saveDirtyFlags = PlayerSaveDirtyFlags::All;
+        m_lastSavedStatsHash = 0;
+    }
+
     //lets allow only players in world to be saved
     if (IsBeingTeleportedFar())
     {
@@ -20183,6 +20585,10 @@ void Player::_SaveAuras(CharacterDatabaseTransaction trans)
 
 void Player::_SaveInventory(CharacterDatabaseTransaction trans)
 {
+    // store the time elapsed since the last expiry check in the items
+    for (ItemDuration& itemDuration : m_itemDuration)
+        StoreElapsedItemDuration(itemDuration);
+
     CharacterDatabasePreparedStatement* stmt;
     // force items in buyback slots to new state
     // and remove those that aren't already
@@ -20237,7 +20643,8 @@ void Player::_SaveInventory(CharacterDatabaseTransaction trans)
 
     // update enchantment durations
     for (EnchantDurationList::iterator itr = m_enchantDuration.begin(); itr != m_enchantDuration.end(); ++itr)
-        itr->item->SetEnchantmentDuration(itr->slot, itr->leftduration, this);
+        if (itr->item->GetEnchantmentId(itr->slot))
+            itr->item->SetEnchantmentDuration(itr->slot, GetEnchantmentDurationLeft(*itr), this);
 
     // if no changes
     if (m_itemUpdateQueue.empty())
@@ -20809,12 +21216,37 @@ void Player::_SaveStoredAuraTeleportLocations(CharacterDatabaseTransaction trans
 
 // save player stats -- only for external usage
 // real stats will be recalculated on player login
-void Player::_SaveStats(CharacterDatabaseTransaction trans) const
+void Player::_SaveStats(CharacterDatabaseTransaction trans)
 {
     // check if stat saving is enabled and if char level is high enough
     if (!sWorld->getIntConfig(CONFIG_MIN_LEVEL_STAT_SAVE) || GetLevel() < sWorld->getIntConfig(CONFIG_MIN_LEVEL_STAT_SAVE))
         return;
 
+    std::size_t statsHash = 0;
+    Trinity::hash_combine(statsHash, GetMaxHealth());
+    for (uint8 i = 0; i < MAX_POWERS_PER_CLASS; ++i)
+        Trinity::hash_combine(statsHash, m_unitData->MaxPower[i]);
+    for (uint8 i = 0; i < MAX_STATS; ++i)
+        Trinity::hash_combine(statsHash, GetStat(Stats(i)));
+    for (int i = 0; i < MAX_SPELL_SCHOOL; ++i)
+        Trinity::hash_combine(statsHash, GetResistance(SpellSchools(i)));
+    Trinity::hash_combine(statsHash, *m_activePlayerData->BlockPercentage);
+    Trinity::hash_combine(statsHash, *m_activePlayerData->DodgePercentage);
+    Trinity::hash_combine(statsHash, *m_activePlayerData->ParryPercentage);
+    Trinity::hash_combine(statsHash, *m_activePlayerData->CritPercentage);
+    Trinity::hash_combine(statsHash, *m_activePlayerData->RangedCritPercentage);
+    Trinity::hash_combine(statsHash, *m_activePlayerData->SpellCritPercentage);
+    Trinity::hash_combine(statsHash, *m_unitData->AttackPower);
+    Trinity::hash_combine(statsHash, *m_unitData->RangedAttackPower);
+    Trinity::hash_combine(statsHash, GetBaseSpellPowerBonus());
+    Trinity::hash_combine(statsHash, m_activePlayerData->CombatRatings[CR_RESILIENCE_PLAYER_DAMAGE]);
+
+    // stats are derived from many sources, compare against what was written last instead of tracking every change
+    if (statsHash == m_lastSavedStatsHash)
+        return;
+
+    m_lastSavedStatsHash = statsHash;
+
     CharacterDatabasePreparedStatement* stmt;
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_STATS);
@@ -21395,7 +21827,7 @@ void Player::TextEmote(std::string_view text, WorldObject const* /*= nullptr*/,
     SendMessageToSetInRange(packet.Write(), sWorld->getFloatConfig(CONFIG_LISTEN_RANGE_TEXTEMOTE), true, !GetSession()->HasPermission(rbac::RBAC_PERM_TWO_SIDE_INTERACTION_CHAT), true);
 }
 
-void Player::WhisperAddon(std::string const& text, std::string const& prefix, bool isLogged, Player* receiver)
+void Player::WhisperAddon(std::string_view text, std::string_view prefix, bool isLogged, Player* receiver)
 {
     std::string _text(text);
     sScriptMgr->OnPlayerChat(this, CHAT_MSG_WHISPER, uint32(isLogged ? LANG_ADDON_LOGGED : LANG_ADDON), _text, receiver);
@@ -23415,33 +23847,39 @@ bool Player::IsVisibleGloballyFor(Player const* u) const
 }
 
 template<class T>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, T* target, std::set<Unit*>& /*v*/)
+inline void UpdateVisibilityOf_helper(GuidFlatSet& s64, T* target, std::set<Unit*>& /*v*/)
 {
     s64.insert(target->GetGUID());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Creature* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(GuidFlatSet& s64, Creature* target, std::set<Unit*>& v)
 {
     s64.insert(target->GetGUID());
     v.insert(target);
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Player* target, std::set<Unit*>& v)
+inline void UpdateVisibilityOf_helper(GuidFlatSet& s64, Player* target, std::set<Unit*>& v)
 {
     s64.insert(target->GetGUID());
     v.insert(target);
 }
 
 template<class T>
-inline void BeforeVisibilityDestroy(T* /*t*/, Player* /*p*/) { }
+inline void BeforeVisibilityDestroy(T* /*t*/, Player* /*p*/, Trinity::RelocationDeferredActions* /*deferred*/ = nullptr) { }
 
 template<>
-inline void BeforeVisibilityDestroy<Creature>(Creature* t, Player* p)
+inline void BeforeVisibilityDestroy<Creature>(Creature* t, Player* p, Trinity::RelocationDeferredActions* deferred)
 {
     if (p->GetPetGUID() == t->GetGUID() && t->IsPet())
-        t->ToPet()->Remove(PET_SAVE_NOT_IN_SLOT, true);
+    {
+        // removing a pet changes map wide state, never do it while regions are processed in parallel
+        if (deferred)
+            deferred->PetRemovals.push_back(p);
+        else
+            t->ToPet()->Remove(PET_SAVE_NOT_IN_SLOT, true);
+    }
 }
 
 void Player::UpdateVisibilityOf(Trinity::IteratorPair<WorldObject**> targets)
@@ -23453,40 +23891,8 @@ void Player::UpdateVisibilityOf(Trinity::IteratorPair<WorldObject**> targets)
     std::set<Unit*> newVisibleUnits;
 
     for (WorldObject* target : targets)
-    {
-        if (target == this)
-            continue;
-
-        switch (target->GetTypeId())
-        {
-            case TYPEID_UNIT:
-                UpdateVisibilityOf(target->ToCreature(), udata, newVisibleUnits);
-                break;
-            case TYPEID_PLAYER:
-                UpdateVisibilityOf(target->ToPlayer(), udata, newVisibleUnits);
-                break;
-            case TYPEID_GAMEOBJECT:
-                UpdateVisibilityOf(target->ToGameObject(), udata, newVisibleUnits);
-                break;
-            case TYPEID_DYNAMICOBJECT:
-                UpdateVisibilityOf(target->ToDynObject(), udata, newVisibleUnits);
-                break;
-            case TYPEID_CORPSE:
-                UpdateVisibilityOf(target->ToCorpse(), udata, newVisibleUnits);
-                break;
-            case TYPEID_AREATRIGGER:
-                UpdateVisibilityOf(target->ToAreaTrigger(), udata, newVisibleUnits);
-                break;
-            case TYPEID_SCENEOBJECT:
-                UpdateVisibilityOf(target->ToSceneObject(), udata, newVisibleUnits);
-                break;
-            case TYPEID_CONVERSATION:
-                UpdateVisibilityOf(target->ToConversation(), udata, newVisibleUnits);
-                break;
-            default:
-                break;
-        }
-    }
+        if (target != this)
+            UpdateVisibilityOf(target, udata, newVisibleUnits);
 
     if (!udata.HasData())
         return;
@@ -23591,13 +23997,13 @@ void Player::SendInitialVisiblePackets(Unit* target) const
 }
 
 template<class T>
-void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& visibleNow)
+void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& visibleNow, Trinity::RelocationDeferredActions* deferred /*= nullptr*/)
 {
     if (HaveAtClient(target))
     {
         if (!CanSeeOrDetect(target, false, true))
         {
-            BeforeVisibilityDestroy<T>(target, this);
+            BeforeVisibilityDestroy<T>(target, this, deferred);
 
             if (!target->IsDestroyedObject())
                 target->BuildOutOfRangeUpdateBlock(&data);
@@ -23625,14 +24031,162 @@ void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& vi
     }
 }
 
-template void Player::UpdateVisibilityOf(Player*        target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(Creature*      target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(Corpse*        target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(GameObject*    target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(AreaTrigger*   target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(SceneObject*   target, UpdateData& data, std::set<Unit*>& visibleNow);
-template void Player::UpdateVisibilityOf(Conversation*  target, UpdateData& data, std::set<Unit*>& visibleNow);
+template void Player::UpdateVisibilityOf(Player*        target, UpdateData& data, std::set<Unit*>& visibleNow, Trinity::RelocationDeferredActions* deferred);
+template void Player::UpdateVisibilityOf(Creature*      target, UpdateData& data, std::set<Unit*>& visibleNow, Trinity::RelocationDeferredActions* deferred);
+template void Player::UpdateVisibilityOf(Corpse*        target, UpdateData& data, std::set<Unit*>& visibleNow, Trinity::RelocationDeferredActions* deferred);
+template void Player::UpdateVisibilityOf(GameObject*    target, UpdateData& data, std::set<Unit*>& visibleNow, Trinity::RelocationDeferredActions* deferred);
+template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data, std::set<Unit*>& visibleNow, Trinity::RelocationDeferredActions* deferred);
+template void Player::UpdateVisibilityOf(AreaTrigger*   target, UpdateData& data, std::set<Unit*>& visibleNow, Trinity::RelocationDeferredActions* deferred);
+template void Player::UpdateVisibilityOf(SceneObject*   target, UpdateData& data, std::set<Unit*>& visibleNow, Trinity::RelocationDeferredActions* deferred);
+template void Player::UpdateVisibilityOf(Conversation*  target, UpdateData& data, std::set<Unit*>& visibleNow, Trinity::RelocationDeferredActions* deferred);
+
+void Player::UpdateVisibilityOf(WorldObject* target, UpdateData& data, std::set<Unit*>& visibleNow)
+{
+    switch (target->GetTypeId())
+    {
+        case TYPEID_UNIT:
+            UpdateVisibilityOf(target->ToCreature(), data, visibleNow);
+            break;
+        case TYPEID_PLAYER:
+            UpdateVisibilityOf(target->ToPlayer(), data, visibleNow);
+            break;
+        case TYPEID_GAMEOBJECT:
+            UpdateVisibilityOf(target->ToGameObject(), data, visibleNow);
+            break;
+        case TYPEID_DYNAMICOBJECT:
+            UpdateVisibilityOf(target->ToDynObject(), data, visibleNow);
+            break;
+        case TYPEID_CORPSE:
+            UpdateVisibilityOf(target->ToCorpse(), data, visibleNow);
+            break;
+        case TYPEID_AREATRIGGER:
+            UpdateVisibilityOf(target->ToAreaTrigger(), data, visibleNow);
+            break;
+        case TYPEID_SCENEOBJECT:
+            UpdateVisibilityOf(target->ToSceneObject(), data, visibleNow);
+            break;
+        case TYPEID_CONVERSATION:
+            UpdateVisibilityOf(target->ToConversation(), data, visibleNow);
+            break;
+        default:
+            break;
+    }
+}
+
+// sends the create blocks gathered so far once they reach the configured packet size
+static void FlushVisibleObjectCreates(Player* player, UpdateData& data)
+{
+    if (data.GetBuffer().size() < sWorld->getIntConfig(CONFIG_VISIBILITY_PACED_CREATE_PACKET_SIZE))
+        return;
+
+    WorldPacket packet;
+    data.BuildPacket(&packet);
+    player->SendDirectMessage(&packet);
+    data.Clear();
+}
+
+// the client drops packets about objects it does not know, so units fighting or targeting the player are never deferred
+static bool IsVisibleObjectCreateUrgent(Player const* player, WorldObject const* target)
+{
+    Unit const* unit = target->ToUnit();
+    if (!unit)
+        return false;
+
+    return unit->GetVictim() == player || unit->GetTarget() == player->GetGUID() || player->IsInCombatWith(unit);
+}
+
+void Player::AddVisibleObjects(std::vector<WorldObject*>& targets, UpdateData& data, std::set<Unit*>& visibleNow)
+{
+    auto addVisibleObject = [&](WorldObject* target)
+    {
+        target->BuildCreateUpdateBlockForPlayer(&data, this);
+        m_clientGUIDs.insert(target->GetGUID());
+        if (target->IsCreature() || target->IsPlayer())
+            visibleNow.insert(target->ToUnit());
+    };
+
+    uint32 batchSize = sWorld->getIntConfig(CONFIG_VISIBILITY_PACED_CREATE_BATCH_SIZE);
+    if (!batchSize || targets.size() <= batchSize)
+    {
+        for (WorldObject* target : targets)
+            addVisibleObject(target);
+        return;
+    }
+
+    std::ranges::sort(targets, {}, [seer = m_seer](WorldObject const* target) { return target->GetExactDist2dSq(seer); });
+
+    // urgent creates go first and may exceed the batch size
+    auto urgentEnd = std::stable_partition(targets.begin(), targets.end(), [this](WorldObject const* target) { return IsVisibleObjectCreateUrgent(this, target); });
+    batchSize = std::max<uint32>(batchSize, uint32(std::distance(targets.begin(), urgentEnd)));
+
+    for (std::size_t i = 0; i < batchSize; ++i)
+    {
+        addVisibleObject(targets[i]);
+        FlushVisibleObjectCreates(this, data);
+    }
+
+    // objects still waiting from an earlier update that were not visited again keep their place behind the new ones
+    GuidUnorderedSet deferred;
+    std::vector<ObjectGuid> pending;
+    pending.reserve(targets.size() - batchSize + m_pendingVisibleGUIDs.size());
+    for (std::size_t i = batchSize; i < targets.size(); ++i)
+    {
+        deferred.insert(targets[i]->GetGUID());
+        pending.push_back(targets[i]->GetGUID());
+    }
+
+    for (ObjectGuid const& guid : m_pendingVisibleGUIDs)
+        if (!deferred.contains(guid) && !m_clientGUIDs.contains(guid))
+            pending.push_back(guid);
+
+    m_pendingVisibleGUIDs = std::move(pending);
+}
+
+void Player::SendPendingVisibleObjects()
+{
+    if (m_pendingVisibleGUIDs.empty())
+        return;
+
+    UpdateData udata(GetMapId());
+    std::set<Unit*> newVisibleUnits;
+    uint32 batchSize = std::max<uint32>(sWorld->getIntConfig(CONFIG_VISIBILITY_PACED_CREATE_BATCH_SIZE), 1);
+    uint32 created = 0;
+
+    // once the batch is full, the rest of the queue is only scanned for units that started fighting or targeting the player
+    std::vector<ObjectGuid> remaining;
+    for (ObjectGuid const& guid : m_pendingVisibleGUIDs)
+    {
+        if (m_clientGUIDs.contains(guid))
+            continue;
+
+        // visibility is checked again, the object may have moved away or despawned in the meantime
+        WorldObject* target = ObjectAccessor::GetWorldObject(*this, guid);
+        if (!target)
+            continue;
+
+        if (created >= batchSize && !IsVisibleObjectCreateUrgent(this, target))
+        {
+            remaining.push_back(guid);
+            continue;
+        }
+
+        UpdateVisibilityOf(target, udata, newVisibleUnits);
+        FlushVisibleObjectCreates(this, udata);
+        ++created;
+    }
+
+    m_pendingVisibleGUIDs = std::move(remaining);
+
+    if (udata.HasData())
+    {
+        WorldPacket packet;
+        udata.BuildPacket(&packet);
+        SendDirectMessage(&packet);
+    }
+
+    for (Unit* visibleUnit : newVisibleUnits)
+        SendInitialVisiblePackets(visibleUnit);
+}
 
 void Player::UpdateObjectVisibility(bool forced)
 {
@@ -23640,6 +24194,9 @@ void Player::UpdateObjectVisibility(bool forced)
     if (!IsInWorld())
         return;
 
+    // something else than our position changed, every object has to be checked again
+    m_lastVisibilityUpdatePosition.reset();
+
     if (!forced)
         AddToNotify(NOTIFY_VISIBILITY_CHANGED);
     else
@@ -23655,6 +24212,39 @@ void Player::UpdateVisibilityForPlayer()
     Trinity::VisibleNotifier notifier(*this);
     Cell::VisitAllObjects(m_seer, notifier, GetSightRange());
     notifier.SendToSelf();   // send gathered data
+    SetVisibilityUpdated(GetSightRange());
+}
+
+void Player::UpdateObjectVisibilityOnRelocation()
+{
+    if (!IsInWorld())
+        return;
+
+    AddToNotify(NOTIFY_VISIBILITY_CHANGED);
+}
+
+Position const* Player::GetIncrementalVisibilityCenter(float radius) const
+{
+    if (!m_lastVisibilityUpdatePosition || m_lastVisibilityUpdateRadius != radius || m_seer != this)
+        return nullptr;
+
+    if (sWorld->getFloatConfig(CONFIG_VISIBILITY_INCREMENTAL_NEAR_DISTANCE) <= 0.0f)
+        return nullptr;
+
+    return &*m_lastVisibilityUpdatePosition;
+}
+
+void Player::SetVisibilityUpdated(float radius)
+{
+    // viewpoints can move without notifying us
+    if (m_seer != this)
+    {
+        m_lastVisibilityUpdatePosition.reset();
+        return;
+    }
+
+    m_lastVisibilityUpdatePosition = GetPosition();
+    m_lastVisibilityUpdateRadius = radius;
 }
 
 void Player::InitPrimaryProfessions()
@@ -23944,8 +24534,16 @@ void Player::SendInitialPacketsAfterAddToMap()
 
     PhasingHandler::OnMapChange(this);
 
-    if (_garrison)
-        _garrison->SendRemoteInfo();
+    // remote info is only sent on the continent of the garrison, do not load a garrison that is not there
+    bool sendGarrisonRemoteInfo = _garrison != nullptr;
+    if (_garrisonLoadResults)
+        if (GarrSiteLevelEntry const* siteLevel = sGarrSiteLevelStore.LookupEntry(_garrisonLoadResults->Garrison->Fetch()[0].GetUInt32()))
+            if (MapEntry const* garrisonMap = sMapStore.LookupEntry(siteLevel->MapID))
+                sendGarrisonRemoteInfo = int32(GetMapId()) == garrisonMap->ParentMapID;
+
+    if (sendGarrisonRemoteInfo)
+        if (Garrison* garrison = GetGarrison())
+            garrison->SendRemoteInfo();
 
     UpdateItemLevelAreaBasedScaling();
 
@@ -24397,8 +24995,11 @@ void Player::DailyReset()
     m_DailyQuestChanged = false;
     m_lastDailyQuestTime = 0;
 
+    // do not build a garrison just to reset it, an unloaded one is reset when it is built
     if (_garrison)
         _garrison->ResetFollowerActivationLimit();
+    else if (_garrisonLoadResults)
+        _garrisonLoadResults->ResetFollowerActivationLimit = true;
 }
 
 void Player::ResetWeeklyQuestStatus()
@@ -24837,8 +25438,10 @@ void Player::RemoveItemDurations(Item* item)
 {
     for (ItemDurationList::iterator itr = m_itemDuration.begin(); itr != m_itemDuration.end(); ++itr)
     {
-        if (*itr == item)
+        if (itr->item == item)
         {
+            // save time elapsed since the last update in item, expiring is left to the next owner update
+            StoreElapsedItemDuration(*itr);
             m_itemDuration.erase(itr);
             break;
         }
@@ -24847,9 +25450,10 @@ void Player::RemoveItemDurations(Item* item)
 
 void Player::AddItemDurations(Item* item)
 {
-    if (*item->m_itemData->Expiration)
+    if (uint32 expiration = item->m_itemData->Expiration)
     {
-        m_itemDuration.push_back(item);
+        m_itemDuration.emplace_back(item, m_itemDurationTimer);
+        m_nextItemDurationExpireTime = std::min(m_nextItemDurationExpireTime, m_itemDurationTimer + expiration);
         item->SendTimeUpdate(this);
     }
 }
@@ -26430,7 +27034,11 @@ bool Player::AddPvpTalent(PvpTalentEntry const* talent, uint8 activeTalentGroup,
             AddOverrideSpell(talent->OverridesSpellID, talent->SpellID);
     }
 
-    GetPvpTalentMap(activeTalentGroup)[slot] = talent->ID;
+    if (GetPvpTalentMap(activeTalentGroup)[slot] != talent->ID)
+    {
+        GetPvpTalentMap(activeTalentGroup)[slot] = talent->ID;
+        SetSaveDirty(PlayerSaveDirtyFlags::Talents);
+    }
 
     return true;
 }
@@ -26450,7 +27058,10 @@ void Player::RemovePvpTalent(PvpTalentEntry const* talent, uint8 activeTalentGro
     // if this talent rank can be found in the PlayerTalentMap, mark the talent as removed so it gets deleted
     auto plrPvpTalent = std::find(GetPvpTalentMap(activeTalentGroup).begin(), GetPvpTalentMap(activeTalentGroup).end(), talent->ID);
     if (plrPvpTalent != GetPvpTalentMap(activeTalentGroup).end())
+    {
         *plrPvpTalent = 0;
+        SetSaveDirty(PlayerSaveDirtyFlags::Talents);
+    }
 }
 
 void Player::TogglePvpTalents(bool enable)
@@ -26936,8 +27547,13 @@ void Player::_LoadGlyphs(PreparedQueryResult result)
     } while (result->NextRow());
 }
 
-void Player::_SaveGlyphs(CharacterDatabaseTransaction trans) const
+void Player::_SaveGlyphs(CharacterDatabaseTransaction trans)
 {
+    if ((m_saveDirtyFlags & PlayerSaveDirtyFlags::Glyphs) == PlayerSaveDirtyFlags::None)
+        return;
+
+    m_saveDirtyFlags &= ~PlayerSaveDirtyFlags::Glyphs;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_GLYPHS);
     stmt->setUInt64(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -27125,6 +27741,11 @@ void Player::_LoadTraits(PreparedQueryResult configsResult, PreparedQueryResult
 
 void Player::_SaveTalents(CharacterDatabaseTransaction trans)
 {
+    if ((m_saveDirtyFlags & PlayerSaveDirtyFlags::Talents) == PlayerSaveDirtyFlags::None)
+        return;
+
+    m_saveDirtyFlags &= ~PlayerSaveDirtyFlags::Talents;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_TALENT);
     stmt->setUInt64(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -28354,18 +28975,39 @@ void Player::CreateGarrison(uint32 garrSiteId)
 {
     std::unique_ptr<Garrison> garrison(new Garrison(this));
     if (garrison->Create(garrSiteId))
+    {
         _garrison = std::move(garrison);
+        _garrisonLoadResults.reset();
+    }
 }
 
 void Player::DeleteGarrison()
 {
-    if (_garrison)
+    if (Garrison* garrison = GetGarrison())
     {
-        _garrison->Delete();
+        garrison->Delete();
         _garrison.reset();
     }
 }
 
+Garrison* Player::GetGarrison() const
+{
+    if (_garrisonLoadResults)
+    {
+        std::unique_ptr<GarrisonLoadResults> loadResults = std::move(_garrisonLoadResults);
+        std::unique_ptr<Garrison> garrison = std::make_unique<Garrison>(const_cast<Player*>(this));
+        if (garrison->LoadFromDB(loadResults->Garrison, loadResults->Blueprints, loadResults->Buildings, loadResults->Followers, loadResults->Abilities))
+        {
+            if (loadResults->ResetFollowerActivationLimit)
+                garrison->ResetFollowerActivationLimit();
+
+            _garrison = std::move(garrison);
+        }
+    }
+
+    return _garrison.get();
+}
+
 void Player::SendMovementSetCollisionHeight(float height, WorldPackets::Movement::UpdateCollisionHeightReason reason)
 {
     WorldPackets::Movement::MoveSetCollisionHeight setCollisionHeight;
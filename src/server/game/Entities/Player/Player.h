@@ -24,6 +24,7 @@
 #include "DatabaseEnvFwd.h"
 #include "DBCEnums.h"
 #include "EquipmentSet.h"
+#include "FlatHashMap.h"
 #include "GroupReference.h"
 #include "Hash.h"
 #include "ItemDefines.h"
@@ -74,6 +75,7 @@ class CinematicMgr;
 class Creature;
 class DynamicObject;
 class Garrison;
+struct GarrisonLoadResults;
 class Group;
 class Guild;
 class Item;
@@ -89,6 +91,7 @@ class PlayerSocial;
 class QuestObjectiveCriteriaMgr;
 class ReputationMgr;
 class RestMgr;
+class SharedWorldPacket;
 class SpellCastTargets;
 class TradeData;
 
@@ -109,6 +112,11 @@ namespace BattlePets
     struct BattlePet;
 }
 
+namespace Trinity
+{
+    struct RelocationDeferredActions;
+}
+
 namespace WorldPackets
 {
     namespace Character
@@ -432,17 +440,25 @@ struct Runes
 
 struct EnchantDuration
 {
-    EnchantDuration() : item(nullptr), slot(MAX_ENCHANTMENT_SLOT), leftduration(0) { }
-    EnchantDuration(Item* _item, EnchantmentSlot _slot, uint32 _leftduration) : item(_item), slot(_slot),
-        leftduration(_leftduration){ ASSERT(item); }
+    EnchantDuration() : item(nullptr), slot(MAX_ENCHANTMENT_SLOT), expireTime(0) { }
+    EnchantDuration(Item* _item, EnchantmentSlot _slot, uint64 _expireTime) : item(_item), slot(_slot),
+        expireTime(_expireTime){ ASSERT(item); }
 
     Item* item;
     EnchantmentSlot slot;
-    uint32 leftduration;
+    uint64 expireTime;                                      // in Player::m_enchantDurationTimer units
+};
+
+struct ItemDuration
+{
+    ItemDuration(Item* _item, uint32 _updateTime) : item(_item), updateTime(_updateTime) { }
+
+    Item* item;
+    uint32 updateTime;                                      // Player::m_itemDurationTimer value when Expiration was last reduced
 };
 
 typedef std::list<EnchantDuration> EnchantDurationList;
-typedef std::list<Item*> ItemDurationList;
+typedef std::list<ItemDuration> ItemDurationList;
 
 enum DrunkenState
 {
@@ -526,6 +542,18 @@ enum PlayerLocalFlags
 
 DEFINE_ENUM_FLAG(PlayerLocalFlags);
 
+// subsystems changed since the last save, saving is skipped for clean ones
+enum class PlayerSaveDirtyFlags : uint8
+{
+    None        = 0x00,
+    Talents     = 0x01,     // character_talent and character_pvp_talent
+    Glyphs      = 0x02,
+
+    All         = 0x03
+};
+
+DEFINE_ENUM_FLAG(PlayerSaveDirtyFlags);
+
 // used in PLAYER_FIELD_BYTES2 values
 enum PlayerFieldByte2Flags
 {
@@ -1275,7 +1303,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         /// Handles whispers from Addons and players based on sender, receiver's guid and language.
         void Whisper(std::string_view text, Language language, Player* receiver, bool = false) override;
         void Whisper(uint32 textId, Player* target, bool isBossWhisper = false) override;
-        void WhisperAddon(std::string const& text, std::string const& prefix, bool isLogged, Player* receiver);
+        void WhisperAddon(std::string_view text, std::string_view prefix, bool isLogged, Player* receiver);
 
         bool CanUnderstandLanguage(Language language) const;
 
@@ -1372,6 +1400,8 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         Item* GetItemByGuid(ObjectGuid guid) const;
         Item* GetItemByEntry(uint32 entry, ItemSearchLocation where = ItemSearchLocation::Default) const;
         std::vector<Item*> GetItemListByEntry(uint32 entry, bool inBankAlso = false) const;
+        // Item::SetEntry for items the player owns, keeps the entry lookups pointing at the new entry
+        void ChangeStoredItemEntry(Item* item, uint32 entry);
         Item* GetItemByPos(uint16 pos) const;
         Item* GetItemByPos(uint8 bag, uint8 slot) const;
         Item* GetUseableItemByPos(uint8 bag, uint8 slot) const;
@@ -1527,11 +1557,14 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void AddTradeableItem(Item* item);
         void RemoveTradeableItem(Item* item);
         void UpdateItemDuration(uint32 time, bool realtimeonly = false);
+        void UpdateItemDurationTimer();
         void AddEnchantmentDurations(Item* item);
         void RemoveEnchantmentDurations(Item* item);
+        void RemoveEnchantmentDuration(Item* item, EnchantmentSlot slot);
         void RemoveEnchantmentDurationsReferences(Item* item);
         void RemoveArenaEnchantments(EnchantmentSlot slot);
         void AddEnchantmentDuration(Item* item, EnchantmentSlot slot, uint32 duration);
+        uint32 GetEnchantmentDurationLeft(EnchantDuration const& enchantDuration) const;
         void ApplyEnchantment(Item* item, EnchantmentSlot slot, bool apply, bool apply_dur = true, bool ignore_condition = false);
         void ApplyEnchantment(Item* item, bool apply);
         void UpdateSkillEnchantments(uint16 skill_id, uint16 curr_value, uint16 new_value);
@@ -1682,7 +1715,9 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void SendQuestUpdateAddCreditSimple(QuestObjective const& obj) const;
         void SendQuestUpdateAddPlayer(Quest const* quest, uint16 newCount) const;
         void SendQuestGiverStatusMultiple();
-        void SendQuestGiverStatusMultiple(GuidUnorderedSet const& guids);
+        void SendQuestGiverStatusMultiple(GuidFlatSet const& guids);
+        void SendQuestGiverStatusForQuest(uint32 questId);
+        void SetSentQuestGiverStatus(ObjectGuid const& guid, QuestGiverStatus status) { m_questGiverStatusCache[guid] = status; }
         void SendDisplayToast(uint32 entry, DisplayToastType type, bool isBonusRoll, uint32 quantity, DisplayToastMethod method, uint32 questId = 0, Item* item = nullptr) const;
 
         uint32 GetSharedQuestID() const { return m_sharedQuestId; }
@@ -1742,6 +1777,8 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         static void DeleteOldCharacters(uint32 keepDays);
 
         bool m_mailsUpdated;
+        bool m_mailItemsLoaded;
+        bool m_mailItemsLoading;
 
         void SetBindPoint(ObjectGuid guid) const;
         void SendRespecWipeConfirm(ObjectGuid const& guid, uint32 cost, SpecResetType respecType) const;
@@ -1782,6 +1819,9 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         Mail* GetMail(uint64 id);
 
         PlayerMails const& GetMails() const { return m_mail; }
+        // Mail.LoadItemsOnDemand - GetMail returns nullptr until the items attached to the mails were loaded
+        bool HasMailedItemsLoaded() const { return m_mailItemsLoaded; }
+        void StartLoadingMailedItems(std::function<void()>&& callback);
 
         void SendItemRetrievalMail(uint32 itemEntry, uint32 count, ItemContext context); // Item retrieval mails sent by The Postmaster (34337), used in multiple places.
 
@@ -1892,6 +1932,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         PlayerPvpTalentMap& GetPvpTalentMap(uint8 spec) { return _specializationInfo.PvpTalents[spec]; }
         std::vector<uint32> const& GetGlyphs(uint8 spec) const { return _specializationInfo.Glyphs[spec]; }
         std::vector<uint32>& GetGlyphs(uint8 spec) { return _specializationInfo.Glyphs[spec]; }
+        void SetSaveDirty(PlayerSaveDirtyFlags flags) { m_saveDirtyFlags |= flags; }
         ActionButtonList const& GetActionButtons() const { return m_actionButtons; }
         void StartLoadingActionButtons(std::function<void()>&& callback = nullptr);
         void LoadActions(PreparedQueryResult result);
@@ -2389,6 +2430,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void SendInitWorldStates(uint32 zoneId, uint32 areaId);
         void SendUpdateWorldState(uint32 variable, uint32 value, bool hidden = false) const;
         void SendDirectMessage(WorldPacket const* data) const;
+        void SendDirectMessage(std::shared_ptr<SharedWorldPacket const> const& data) const;
 
         void SendAurasForTarget(Unit* target) const;
 
@@ -2521,7 +2563,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         uint8 GetStartLevel(uint8 race, uint8 playerClass, Optional<int32> characterTemplateId) const;
 
         // currently visible objects at player client
-        GuidUnorderedSet m_clientGUIDs;
+        GuidFlatSet m_clientGUIDs;
         GuidUnorderedSet m_visibleTransports;
 
         bool HaveAtClient(Object const* u) const;
@@ -2534,12 +2576,21 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void OnPhaseChange() override;
         void UpdateObjectVisibility(bool forced = true) override;
         void UpdateVisibilityForPlayer();
+        void UpdateObjectVisibilityOnRelocation();
+        Position const* GetIncrementalVisibilityCenter(float radius) const;
+        void SetVisibilityUpdated(float radius);
         void UpdateVisibilityOf(WorldObject* target);
         void UpdateVisibilityOf(Trinity::IteratorPair<WorldObject**> targets);
         void UpdateTriggerVisibility();
 
+        // deferred collects side effects reaching outside of the map region when called while regions are processed in parallel
         template<class T>
-        void UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& visibleNow);
+        void UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& visibleNow, Trinity::RelocationDeferredActions* deferred = nullptr);
+        void UpdateVisibilityOf(WorldObject* target, UpdateData& data, std::set<Unit*>& visibleNow);
+        // creates objects that just became visible, nearest first and in batches over several updates when there are many
+        void AddVisibleObjects(std::vector<WorldObject*>& targets, UpdateData& data, std::set<Unit*>& visibleNow);
+        void SendPendingVisibleObjects();
+        void ClearPendingVisibleObjects() { m_pendingVisibleGUIDs.clear(); }
 
         uint8 m_forced_speed_changes[MAX_MOVE_TYPE];
         uint8 m_movementForceModMagnitudeChanges;
@@ -2714,7 +2765,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 
         void CreateGarrison(uint32 garrSiteId);
         void DeleteGarrison();
-        Garrison* GetGarrison() const { return _garrison.get(); }
+        Garrison* GetGarrison() const;
 
         bool IsAdvancedCombatLoggingEnabled() const { return _advancedCombatLoggingEnabled; }
         void SetAdvancedCombatLogging(bool enabled) { _advancedCombatLoggingEnabled = enabled; }
@@ -2934,6 +2985,8 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void _LoadVoidStorage(PreparedQueryResult result);
         void _LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mailItemsResult, PreparedQueryResult artifactResult, PreparedQueryResult azeriteItemResult,
             PreparedQueryResult azeriteItemMilestonePowersResult, PreparedQueryResult azeriteItemUnlockedEssencesResult, PreparedQueryResult azeriteEmpoweredItemResult);
+        void _LoadMailedItems(PreparedQueryResult mailItemsResult, PreparedQueryResult artifactResult, PreparedQueryResult azeriteItemResult,
+            PreparedQueryResult azeriteItemMilestonePowersResult, PreparedQueryResult azeriteItemUnlockedEssencesResult, PreparedQueryResult azeriteEmpoweredItemResult);
         static Item* _LoadMailedItem(ObjectGuid const& playerGuid, Player* player, uint64 mailId, Mail* mail, Field* fields, ItemAdditionalLoadInfo* addionalData);
         void _LoadQuestStatus(PreparedQueryResult result);
         void _LoadQuestStatusObjectives(PreparedQueryResult result);
@@ -2970,6 +3023,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void _SaveActions(CharacterDatabaseTransaction trans);
         void _SaveAuras(CharacterDatabaseTransaction trans);
         void _SaveInventory(CharacterDatabaseTransaction trans);
+        void StoreElapsedItemDuration(ItemDuration& itemDuration);
         void _SaveVoidStorage(CharacterDatabaseTransaction trans);
         void _SaveMail(CharacterDatabaseTransaction trans);
         void _SaveQuestStatus(CharacterDatabaseTransaction trans);
@@ -2982,10 +3036,10 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         void _SaveStoredAuraTeleportLocations(CharacterDatabaseTransaction trans);
         void _SaveEquipmentSets(CharacterDatabaseTransaction trans);
         void _SaveBGData(CharacterDatabaseTransaction trans);
-        void _SaveGlyphs(CharacterDatabaseTransaction trans) const;
+        void _SaveGlyphs(CharacterDatabaseTransaction trans);
         void _SaveTalents(CharacterDatabaseTransaction trans);
         void _SaveTraits(CharacterDatabaseTransaction trans);
-        void _SaveStats(CharacterDatabaseTransaction trans) const;
+        void _SaveStats(CharacterDatabaseTransaction trans);
         void _SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans);
         void _SaveCurrency(CharacterDatabaseTransaction trans);
         void _SaveCUFProfiles(CharacterDatabaseTransaction trans);
@@ -3009,6 +3063,8 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         uint32 m_team;
         uint32 m_nextSave;
         bool m_customizationsChanged;
+        PlayerSaveDirtyFlags m_saveDirtyFlags;
+        std::size_t m_lastSavedStatsHash;
         std::array<ChatFloodThrottle, ChatFloodThrottle::MAX> m_chatFloodData;
         Difficulty m_dungeonDifficulty;
         Difficulty m_raidDifficulty;
@@ -3019,6 +3075,14 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         Item* m_items[PLAYER_SLOTS_COUNT];
         uint32 m_currentBuybackSlot;
 
+        // every item in m_items (except buyback) and in equipped/bank bags, kept in sync by the functions that fill and clear those slots
+        // lets entry and guid lookups skip scanning all storage slots, the location of an item is derived from its current position when queried
+        Trinity::Containers::FlatHashMap<uint32, std::vector<Item*>> m_storedItemsByEntry;
+        Trinity::Containers::FlatHashMap<ObjectGuid, Item*> m_storedItemsByGuid;
+        void AddStoredItemToIndex(Item* item);
+        void RemoveStoredItemFromIndex(Item* item);
+        EnumFlag<ItemSearchLocation> GetStoredItemLocation(Item const* item) const;
+
         PlayerCurrenciesMap _currencyStorage;
 
         VoidStorageItem* _voidStorageItems[VOID_STORAGE_MAX_SLOT];
@@ -3035,6 +3099,10 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         RewardedQuestSet m_RewardedQuests;
         QuestStatusSaveMap m_RewardedQuestsSave;
 
+        // last quest giver status sent to the client, SendQuestGiverStatusForQuest only sends givers that changed
+        Trinity::Containers::FlatHashMap<ObjectGuid, QuestGiverStatus> m_questGiverStatusCache;
+        Optional<QuestGiverStatus> GetQuestGiverStatusFor(ObjectGuid const& guid);
+
         SkillStatusMap mSkillStatus;
 
         ObjectGuid::LowType m_GuildIdInvited;
@@ -3062,9 +3130,15 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 
         SpellModContainer m_spellMods[MAX_SPELLMOD][SPELLMOD_END];
 
+        // timed entries are only visited when the earliest of them expires
         EnchantDurationList m_enchantDuration;
+        uint64 m_enchantDurationTimer;
+        uint64 m_nextEnchantDurationExpireTime;
         ItemDurationList m_itemDuration;
+        uint32 m_itemDurationTimer;
+        uint32 m_nextItemDurationExpireTime;
         GuidUnorderedSet m_itemSoulboundTradeable;
+        uint32 m_nextSoulboundTradeExpireTime;
 
         std::unique_ptr<ResurrectionData> _resurrectionData;
 
@@ -3173,6 +3247,11 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         uint32 m_lastFallTime;
         float  m_lastFallZ;
 
+        // seer position of the last visibility update, unset when the next one has to check all cells
+        Optional<Position> m_lastVisibilityUpdatePosition;
+        float m_lastVisibilityUpdateRadius;
+        std::vector<ObjectGuid> m_pendingVisibleGUIDs;  // visible objects not yet created at client, nearest first
+
         int32 m_MirrorTimer[MAX_TIMERS];
         uint8 m_MirrorTimerFlags;
         uint8 m_MirrorTimerFlagsLast;
@@ -3206,7 +3285,9 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 
         uint32 _activeCheats;
 
-        std::unique_ptr<Garrison> _garrison;
+        // garrison is only built from its login query results on first GetGarrison() call
+        mutable std::unique_ptr<Garrison> _garrison;
+        mutable std::unique_ptr<GarrisonLoadResults> _garrisonLoadResults;
 
         bool _advancedCombatLoggingEnabled;
 
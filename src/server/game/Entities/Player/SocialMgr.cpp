@@ -43,6 +43,9 @@ bool PlayerSocial::AddToSocialList(ObjectGuid const& friendGuid, ObjectGuid cons
     PlayerSocialMap::iterator itr = _playerSocialMap.find(friendGuid);
     if (itr != _playerSocialMap.end())
     {
+        if ((flag & SOCIAL_FLAG_FRIEND) && !(itr->second.Flags & SOCIAL_FLAG_FRIEND))
+            sSocialMgr->AddFriendLister(friendGuid, GetPlayerGUID());
+
         itr->second.Flags |= flag;
         itr->second.WowAccountGuid = accountGuid;
 
@@ -57,6 +60,8 @@ bool PlayerSocial::AddToSocialList(ObjectGuid const& friendGuid, ObjectGuid cons
     else
     {
         itr = _playerSocialMap.emplace(std::piecewise_construct, std::forward_as_tuple(friendGuid), std::forward_as_tuple()).first;
+        if (flag & SOCIAL_FLAG_FRIEND)
+            sSocialMgr->AddFriendLister(friendGuid, GetPlayerGUID());
 
         itr->second.Flags |= flag;
         itr->second.WowAccountGuid = accountGuid;
@@ -82,6 +87,9 @@ void PlayerSocial::RemoveFromSocialList(ObjectGuid const& friendGuid, SocialFlag
     if (itr == _playerSocialMap.end())
         return;
 
+    if ((flag & SOCIAL_FLAG_FRIEND) && (itr->second.Flags & SOCIAL_FLAG_FRIEND))
+        sSocialMgr->RemoveFriendLister(friendGuid, GetPlayerGUID());
+
     itr->second.Flags &= ~flag;
 
     if (!itr->second.Flags)
@@ -191,12 +199,52 @@ bool PlayerSocial::HasIgnore(ObjectGuid const& ignoreGuid, ObjectGuid const& ign
     return _HasContact(ignoreGuid, SOCIAL_FLAG_IGNORED) || _ignoredAccounts.find(ignoreAccountGuid) != _ignoredAccounts.end();
 }
 
+void PlayerSocial::GetIgnoreList(GuidUnorderedSet& characters, GuidUnorderedSet& accounts) const
+{
+    for (auto const& [guid, friendInfo] : _playerSocialMap)
+        if (friendInfo.Flags & SOCIAL_FLAG_IGNORED)
+            characters.insert(guid);
+
+    accounts.insert(_ignoredAccounts.begin(), _ignoredAccounts.end());
+}
+
 SocialMgr* SocialMgr::instance()
 {
     static SocialMgr instance;
     return &instance;
 }
 
+void SocialMgr::RemovePlayerSocial(ObjectGuid const& guid)
+{
+    auto itr = _socialMap.find(guid);
+    if (itr == _socialMap.end())
+        return;
+
+    for (auto const& [friendGuid, friendInfo] : itr->second._playerSocialMap)
+        if (friendInfo.Flags & SOCIAL_FLAG_FRIEND)
+            RemoveFriendLister(friendGuid, guid);
+
+    _socialMap.erase(itr);
+}
+
+void SocialMgr::AddFriendLister(ObjectGuid const& friendGuid, ObjectGuid const& listerGuid)
+{
+    std::unique_lock<std::shared_mutex> lock(_friendListersLock);
+    _friendListers[friendGuid].insert(listerGuid);
+}
+
+void SocialMgr::RemoveFriendLister(ObjectGuid const& friendGuid, ObjectGuid const& listerGuid)
+{
+    std::unique_lock<std::shared_mutex> lock(_friendListersLock);
+    auto itr = _friendListers.find(friendGuid);
+    if (itr == _friendListers.end())
+        return;
+
+    itr->second.erase(listerGuid);
+    if (itr->second.empty())
+        _friendListers.erase(itr);
+}
+
 void SocialMgr::GetFriendInfo(Player* player, ObjectGuid const& friendGUID, FriendInfo& friendInfo)
 {
     if (!player)
@@ -265,25 +313,27 @@ void SocialMgr::BroadcastToFriendListers(Player* player, WorldPacket const* pack
     ASSERT(player);
 
     AccountTypes gmSecLevel = AccountTypes(sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_WHO_LIST));
-    for (SocialMap::const_iterator itr = _socialMap.begin(); itr != _socialMap.end(); ++itr)
+
+    std::shared_lock<std::shared_mutex> lock(_friendListersLock);
+    auto listers = _friendListers.find(player->GetGUID());
+    if (listers == _friendListers.end())
+        return;
+
+    for (ObjectGuid const& listerGuid : listers->second)
     {
-        PlayerSocial::PlayerSocialMap::const_iterator itr2 = itr->second._playerSocialMap.find(player->GetGUID());
-        if (itr2 != itr->second._playerSocialMap.end() && (itr2->second.Flags & SOCIAL_FLAG_FRIEND) != 0)
-        {
-            Player* target = ObjectAccessor::FindPlayer(itr->first);
-            if (!target)
-                continue;
+        Player* target = ObjectAccessor::FindPlayer(listerGuid);
+        if (!target)
+            continue;
 
-            WorldSession* session = target->GetSession();
-            if (!session->HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS) && player->GetSession()->GetSecurity() > gmSecLevel)
-                continue;
+        WorldSession* session = target->GetSession();
+        if (!session->HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS) && player->GetSession()->GetSecurity() > gmSecLevel)
+            continue;
 
-            if (target->GetTeam() != player->GetTeam() && !session->HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST))
-                continue;
+        if (target->GetTeam() != player->GetTeam() && !session->HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST))
+            continue;
 
-            if (player->IsVisibleGloballyFor(target))
-                session->SendPacket(packet);
-        }
+        if (player->IsVisibleGloballyFor(target))
+            session->SendPacket(packet);
     }
 }
 
@@ -292,6 +342,14 @@ PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, ObjectGuid const
     PlayerSocial* social = &_socialMap[guid];
     social->SetPlayerGUID(guid);
 
+    // relogging before the previous social list was removed, the database has all of its changes
+    for (auto const& [friendGuid, friendInfo] : social->_playerSocialMap)
+        if (friendInfo.Flags & SOCIAL_FLAG_FRIEND)
+            RemoveFriendLister(friendGuid, guid);
+
+    social->_playerSocialMap.clear();
+    social->_ignoredAccounts.clear();
+
     if (result)
     {
         do
@@ -303,6 +361,8 @@ PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, ObjectGuid const
 
             uint8 flag = fields[2].GetUInt8();
             social->_playerSocialMap[friendGuid] = FriendInfo(friendAccountGuid, flag, fields[3].GetString());
+            if (flag & SOCIAL_FLAG_FRIEND)
+                AddFriendLister(friendGuid, guid);
             if (flag & SOCIAL_FLAG_IGNORED)
                 social->_ignoredAccounts.insert(friendAccountGuid);
         }
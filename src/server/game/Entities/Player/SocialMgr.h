@@ -22,6 +22,8 @@
 #include "Common.h"
 #include "ObjectGuid.h"
 #include <map>
+#include <shared_mutex>
+#include <unordered_map>
 
 class Player;
 class WorldPacket;
@@ -116,6 +118,7 @@ class TC_GAME_API PlayerSocial
         // Misc
         bool HasFriend(ObjectGuid const& friendGuid);
         bool HasIgnore(ObjectGuid const& ignoreGuid, ObjectGuid const& ignoreAccountGuid);
+        void GetIgnoreList(GuidUnorderedSet& characters, GuidUnorderedSet& accounts) const;
 
         ObjectGuid const& GetPlayerGUID() const { return _playerGUID; }
         void SetPlayerGUID(ObjectGuid const& guid) { _playerGUID = guid; }
@@ -142,7 +145,7 @@ class SocialMgr
         static SocialMgr* instance();
 
         // Misc
-        void RemovePlayerSocial(ObjectGuid const& guid) { _socialMap.erase(guid); }
+        void RemovePlayerSocial(ObjectGuid const& guid);
 
         static void GetFriendInfo(Player* player, ObjectGuid const& friendGUID, FriendInfo& friendInfo);
 
@@ -154,8 +157,17 @@ class SocialMgr
         PlayerSocial* LoadFromDB(PreparedQueryResult result, ObjectGuid const& guid);
 
     private:
+        friend class PlayerSocial;
+
+        void AddFriendLister(ObjectGuid const& friendGuid, ObjectGuid const& listerGuid);
+        void RemoveFriendLister(ObjectGuid const& friendGuid, ObjectGuid const& listerGuid);
+
         typedef std::map<ObjectGuid, PlayerSocial> SocialMap;
         SocialMap _socialMap;
+
+        // reverse of the friend lists of loaded players, friend -> players that have them on their friend list
+        std::unordered_map<ObjectGuid, GuidUnorderedSet> _friendListers;
+        std::shared_mutex _friendListersLock;
 };
 
 #define sSocialMgr SocialMgr::instance()
@@ -704,13 +704,62 @@ void Transport::TeleportPassengersAndHideTransport(uint32 newMapid, float x, flo
 
 void Transport::UpdatePassengerPositions(PassengerSet const& passengers)
 {
-    for (WorldObject* passenger : passengers)
+    if (passengers.empty())
+        return;
+
+    // Offsets of all passengers (followed by transport home positions of creatures) are stored as
+    // separate x, y, z and o planes and transformed in one loop with the rotation computed only once
+    _passengerUpdateObjects.assign(passengers.begin(), passengers.end());
+    std::size_t homeCount = std::count_if(passengers.begin(), passengers.end(), [](WorldObject const* passenger) { return passenger->IsCreature(); });
+    std::size_t count = passengers.size() + homeCount;
+
+    _passengerUpdateCoords.resize(count * 4);
+    float* xs = _passengerUpdateCoords.data();
+    float* ys = xs + count;
+    float* zs = ys + count;
+    float* os = zs + count;
+
+    std::size_t homeIndex = passengers.size();
+    for (std::size_t i = 0; i < passengers.size(); ++i)
     {
-        float x, y, z, o;
-        passenger->m_movementInfo.transport.pos.GetPosition(x, y, z, o);
-        CalculatePassengerPosition(x, y, z, &o);
-        UpdatePassengerPosition(GetMap(), passenger, x, y, z, o, true);
+        WorldObject const* passenger = _passengerUpdateObjects[i];
+        passenger->m_movementInfo.transport.pos.GetPosition(xs[i], ys[i], zs[i], os[i]);
+        if (Creature const* creature = passenger->ToCreature())
+        {
+            creature->GetTransportHomePosition(xs[homeIndex], ys[homeIndex], zs[homeIndex], os[homeIndex]);
+            ++homeIndex;
+        }
     }
+
+    float transX = GetPositionX();
+    float transY = GetPositionY();
+    float transZ = GetPositionZ();
+    float transO = GetTransportOrientation();
+    float transSin = std::sin(transO);
+    float transCos = std::cos(transO);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float inx = xs[i];
+        float iny = ys[i];
+        xs[i] = transX + inx * transCos - iny * transSin;
+        ys[i] = transY + iny * transCos + inx * transSin;
+        zs[i] += transZ;
+        os[i] += transO;
+    }
+
+    homeIndex = passengers.size();
+    for (std::size_t i = 0; i < passengers.size(); ++i)
+    {
+        WorldObject* passenger = _passengerUpdateObjects[i];
+        UpdatePassengerPosition(GetMap(), passenger, xs[i], ys[i], zs[i], Position::NormalizeOrientation(os[i]), false);
+        if (Creature* creature = passenger->ToCreature())
+        {
+            creature->SetHomePosition(xs[homeIndex], ys[homeIndex], zs[homeIndex], Position::NormalizeOrientation(os[homeIndex]));
+            ++homeIndex;
+        }
+    }
+
+    _passengerUpdateObjects.clear();
 }
 
 void Transport::BuildUpdate(UpdateDataMapType& data_map)
@@ -719,9 +768,11 @@ void Transport::BuildUpdate(UpdateDataMapType& data_map)
     if (players.isEmpty())
         return;
 
+    ValuesUpdateCache valuesCache;
+    ValuesUpdateCache* cache = HasViewerDependentChanges() ? nullptr : &valuesCache;
     for (MapReference const& playerReference : players)
         if (playerReference.GetSource()->InSamePhase(this))
-            BuildFieldsUpdate(playerReference.GetSource(), data_map);
+            BuildFieldsUpdate(playerReference.GetSource(), data_map, cache);
 
     ClearUpdateMask(true);
 }
@@ -123,6 +123,10 @@ class TC_GAME_API Transport : public GameObject, public TransportBase
         PassengerSet _passengers;
         PassengerSet _staticPassengers;
 
+        // scratch space of UpdatePassengerPositions, kept between updates to avoid reallocating it
+        std::vector<WorldObject*> _passengerUpdateObjects;
+        std::vector<float> _passengerUpdateCoords;
+
         bool _delayedAddModel;
 };
 
@@ -38,6 +38,7 @@
 #include "CreatureAIFactory.h"
 #include "CreatureGroups.h"
 #include "DB2Stores.h"
+#include "FlightRecorder.h"
 #include "Formulas.h"
 #include "GameObjectAI.h"
 #include "GameTime.h"
@@ -69,6 +70,7 @@
 #include "QuestDef.h"
 #include "Spell.h"
 #include "ScheduledChangeAI.h"
+#include "ScriptProfiler.h"
 #include "SpellAuraEffects.h"
 #include "SpellAuras.h"
 #include "SpellHistory.h"
@@ -85,6 +87,7 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
+#include <atomic>
 #include <queue>
 #include <sstream>
 #include <cmath>
@@ -115,6 +118,14 @@ float playerBaseMoveSpeed[MAX_MOVE_TYPE] =
     3.14f                  // MOVE_PITCH_RATE
 };
 
+namespace
+{
+std::atomic<uint32> AuraTotalCacheGeneration;
+std::atomic<uint64> AuraTotalCacheHits;
+std::atomic<uint64> AuraTotalCacheMisses;
+std::atomic<uint32> ProcAuraIndexGeneration;
+}
+
 DispelableAura::DispelableAura(Aura* aura, int32 dispelChance, uint8 dispelCharges) :
     _aura(aura), _chance(dispelChance), _charges(dispelCharges)
 {
@@ -300,15 +311,17 @@ SpellNonMeleeDamage::SpellNonMeleeDamage(Unit* _attacker, Unit* _target, SpellIn
 {
 }
 
+Unit::AuraEffectList const Unit::EmptyAuraEffectList;
+
 Unit::Unit(bool isWorldObject) :
     WorldObject(isWorldObject), m_lastSanctuaryTime(0), LastCharmerGUID(), movespline(new Movement::MoveSpline()),
     m_ControlledByPlayer(false), m_procDeep(0), m_transformSpell(0),
-    m_removedAurasCount(0), m_interruptMask(SpellAuraInterruptFlags::None), m_interruptMask2(SpellAuraInterruptFlags2::None),
+    m_removedAurasCount(0), m_modAuraListIndex(), m_auraTotalCacheGeneration(0), m_procAuraIndexGeneration(0), m_interruptMask(SpellAuraInterruptFlags::None), m_interruptMask2(SpellAuraInterruptFlags2::None),
     m_unitMovedByMe(nullptr), m_playerMovingMe(nullptr), m_charmer(nullptr), m_charmed(nullptr),
     i_motionMaster(new MotionMaster(this)), m_regenTimer(0), m_vehicle(nullptr),
     m_vehicleKit(nullptr), m_unitTypeMask(UNIT_MASK_NONE), m_Diminishing(), m_combatManager(this),
     m_threatManager(this), m_aiLocked(false), _playHoverAnim(false), _aiAnimKitId(0), _movementAnimKitId(0), _meleeAnimKitId(0),
-    _spellHistory(new SpellHistory(this))
+    _spellHistory(new SpellHistory(this)), _periodicAuraLogBatchDepth(0), m_gridPositionIndex(nullptr), m_gridPositionIndexSlot(0)
 {
     m_objectType |= TYPEMASK_UNIT;
     m_objectTypeId = TYPEID_UNIT;
@@ -426,6 +439,10 @@ Unit::~Unit()
     delete movespline;
     delete _spellHistory;
 
+    // GridObject only unlinks its grid reference when deleted in grid
+    if (m_gridPositionIndex)
+        m_gridPositionIndex->Remove(this);
+
     ASSERT(!m_duringRemoveFromWorld);
     ASSERT(!m_attacking);
     ASSERT(m_attackers.empty());
@@ -1800,7 +1817,7 @@ void Unit::HandleEmoteCommand(Emote emoteId, Player* target /*=nullptr*/, Trinit
     // We're going to call functions which can modify content of the list during iteration over it's elements
     // Let's copy the list so we can prevent iterator invalidation
     AuraEffectList vSchoolAbsorbCopy(damageInfo.GetVictim()->GetAuraEffectsByType(SPELL_AURA_SCHOOL_ABSORB));
-    vSchoolAbsorbCopy.sort(Trinity::AbsorbAuraOrderPred());
+    std::stable_sort(vSchoolAbsorbCopy.begin(), vSchoolAbsorbCopy.end(), Trinity::AbsorbAuraOrderPred());
 
     // absorb without mana cost
     for (AuraEffectList::iterator itr = vSchoolAbsorbCopy.begin(); (itr != vSchoolAbsorbCopy.end()) && (damageInfo.GetDamage() > 0); ++itr)
@@ -2016,7 +2033,8 @@ void Unit::HandleEmoteCommand(Emote emoteId, Player* target /*=nullptr*/, Trinit
     bool existExpired = false;
 
     // absorb without mana cost
-    AuraEffectList const& vHealAbsorb = healInfo.GetTarget()->GetAuraEffectsByType(SPELL_AURA_SCHOOL_HEAL_ABSORB);
+    // scripts can remove auras during iteration, copy the list to prevent iterator invalidation
+    AuraEffectList vHealAbsorb(healInfo.GetTarget()->GetAuraEffectsByType(SPELL_AURA_SCHOOL_HEAL_ABSORB));
     for (AuraEffectList::const_iterator i = vHealAbsorb.begin(); i != vHealAbsorb.end() && healInfo.GetHeal() > 0; ++i)
     {
         AuraEffect* absorbAurEff = *i;
@@ -2078,18 +2096,9 @@ void Unit::HandleEmoteCommand(Emote emoteId, Player* target /*=nullptr*/, Trinit
     // Remove all expired absorb auras
     if (existExpired)
     {
-        for (AuraEffectList::const_iterator i = vHealAbsorb.begin(); i != vHealAbsorb.end();)
-        {
-            AuraEffect* auraEff = *i;
-            ++i;
-            if (auraEff->GetAmount() <= 0)
-            {
-                uint32 removedAuras = healInfo.GetTarget()->m_removedAurasCount;
+        for (AuraEffect* auraEff : vHealAbsorb)
+            if (!auraEff->GetBase()->IsRemoved() && auraEff->GetAmount() <= 0)
                 auraEff->GetBase()->Remove(AURA_REMOVE_BY_ENEMY_SPELL);
-                if (removedAuras + 1 < healInfo.GetTarget()->m_removedAurasCount)
-                    i = vHealAbsorb.begin();
-            }
-        }
     }
 }
 
@@ -3288,6 +3297,7 @@ AuraApplication* Unit::_CreateAuraApplication(Aura* aura, uint32 effMask)
 
     AuraApplication * aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
+    AddProcAuraIndexEntry(aurApp);
 
     if (aurSpellInfo->HasAnyAuraInterruptFlag())
     {
@@ -3383,6 +3393,7 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMo
 
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
+    RemoveProcAuraIndexEntry(aurApp);
 
     if (aura->GetSpellInfo()->HasAnyAuraInterruptFlag())
     {
@@ -3509,10 +3520,38 @@ void Unit::_RemoveNoStackAurasDueToAura(Aura* aura)
 
 void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
 {
+    AuraType auraType = aurEff->GetAuraType();
+    InvalidateAuraTotalCache(auraType);
+
     if (apply)
-        m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
-    else
-        m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+    {
+        uint16& listIndex = m_modAuraListIndex[auraType];
+        if (!listIndex)
+        {
+            m_modAuraLists.push_back(std::make_unique<AuraEffectList>());
+            listIndex = uint16(m_modAuraLists.size());
+        }
+
+        m_modAuraLists[listIndex - 1]->push_back(aurEff);
+    }
+    else if (uint16 listIndex = m_modAuraListIndex[auraType])
+    {
+        AuraEffectList& auras = *m_modAuraLists[listIndex - 1];
+        // keep the order, some handlers use the first or last applied effect
+        AuraEffectList::iterator itr = std::find(auras.begin(), auras.end(), aurEff);
+        if (itr != auras.end())
+            auras.erase(itr);
+    }
+}
+
+/*static*/ void Unit::NextAuraEffectAfterRemoval(AuraEffectList const& auras, std::size_t& index, AuraEffect const* removed, bool removedOthers)
+{
+    // other auras could have been anywhere in the list, start over
+    if (removedOthers)
+        index = 0;
+    // removing the aura took its effects out of the list and the next one moved into their place
+    else if (index < auras.size() && auras[index] == removed)
+        ++index;
 }
 
 // All aura base removes should go through this function!
@@ -3722,20 +3761,23 @@ void Unit::RemoveOwnedAuras(uint32 spellId, std::function<bool(Aura const*)> con
 
 void Unit::RemoveAurasByType(AuraType auraType, std::function<bool(AuraApplication const*)> const& check, AuraRemoveMode removeMode /*= AURA_REMOVE_BY_DEFAULT*/)
 {
-    for (AuraEffectList::iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    AuraEffectList const& auras = GetAuraEffectsByType(auraType);
+    for (std::size_t i = 0; i < auras.size();)
     {
-        Aura* aura = (*iter)->GetBase();
+        AuraEffect* aurEff = auras[i];
+        Aura* aura = aurEff->GetBase();
         AuraApplication * aurApp = aura->GetApplicationOfTarget(GetGUID());
         ASSERT(aurApp);
 
-        ++iter;
-        if (check(aurApp))
+        if (!check(aurApp))
         {
-            uint32 removedAuras = m_removedAurasCount;
-            RemoveAura(aurApp, removeMode);
-            if (m_removedAurasCount > removedAuras + 1)
-                iter = m_modAuras[auraType].begin();
+            ++i;
+            continue;
         }
+
+        uint32 removedAuras = m_removedAurasCount;
+        RemoveAura(aurApp, removeMode);
+        NextAuraEffectAfterRemoval(auras, i, aurEff, m_removedAurasCount > removedAuras + 1);
     }
 }
 
@@ -3900,21 +3942,24 @@ void Unit::RemoveAurasDueToItemSpell(uint32 spellId, ObjectGuid castItemGuid)
 
 void Unit::RemoveAurasByType(AuraType auraType, ObjectGuid casterGUID, Aura* except, bool negative, bool positive)
 {
-    for (AuraEffectList::iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    AuraEffectList const& auras = GetAuraEffectsByType(auraType);
+    for (std::size_t i = 0; i < auras.size();)
     {
-        Aura* aura = (*iter)->GetBase();
+        AuraEffect* aurEff = auras[i];
+        Aura* aura = aurEff->GetBase();
         AuraApplication * aurApp = aura->GetApplicationOfTarget(GetGUID());
         ASSERT(aurApp);
 
-        ++iter;
-        if (aura != except && (!casterGUID || aura->GetCasterGUID() == casterGUID)
-            && ((negative && !aurApp->IsPositive()) || (positive && aurApp->IsPositive())))
+        if (aura == except || (!casterGUID.IsEmpty() && aura->GetCasterGUID() != casterGUID)
+            || !((negative && !aurApp->IsPositive()) || (positive && aurApp->IsPositive())))
         {
-            uint32 removedAuras = m_removedAurasCount;
-            RemoveAura(aurApp);
-            if (m_removedAurasCount > removedAuras + 1)
-                iter = m_modAuras[auraType].begin();
+            ++i;
+            continue;
         }
+
+        uint32 removedAuras = m_removedAurasCount;
+        RemoveAura(aurApp);
+        NextAuraEffectAfterRemoval(auras, i, aurEff, m_removedAurasCount > removedAuras + 1);
     }
 }
 
@@ -4584,7 +4629,7 @@ bool Unit::HasAura(std::function<bool(Aura const*)> const& predicate) const
 
 bool Unit::HasAuraType(AuraType auraType) const
 {
-    return (!m_modAuras[auraType].empty());
+    return !GetAuraEffectsByType(auraType).empty();
 }
 
 bool Unit::HasAuraTypeWithCaster(AuraType auraType, ObjectGuid caster) const
@@ -4707,7 +4752,7 @@ uint32 Unit::GetDiseasesByCaster(ObjectGuid casterGUID, bool remove)
     uint32 diseases = 0;
     for (AuraType aType : diseaseAuraTypes)
     {
-        for (auto itr = m_modAuras[aType].begin(); itr != m_modAuras[aType].end();)
+        for (auto itr = GetAuraEffectsByType(aType).begin(); itr != GetAuraEffectsByType(aType).end();)
         {
             // Get auras with disease dispel type by caster
             if ((*itr)->GetSpellInfo()->Dispel == DISPEL_DISEASE
@@ -4718,7 +4763,7 @@ uint32 Unit::GetDiseasesByCaster(ObjectGuid casterGUID, bool remove)
                 if (remove)
                 {
                     RemoveAura((*itr)->GetId(), (*itr)->GetCasterGUID());
-                    itr = m_modAuras[aType].begin();
+                    itr = GetAuraEffectsByType(aType).begin();
                     continue;
                 }
             }
@@ -4751,7 +4796,8 @@ uint32 Unit::GetDoTsByCaster(ObjectGuid casterGUID) const
     return dots;
 }
 
-int32 Unit::GetTotalAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+template<typename Predicate>
+int32 Unit::_GetTotalAuraModifier(AuraType auraType, Predicate const& predicate) const
 {
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auraType);
     if (mTotalAuraList.empty())
@@ -4778,7 +4824,8 @@ int32 Unit::GetTotalAuraModifier(AuraType auraType, std::function<bool(AuraEffec
     return modifier;
 }
 
-float Unit::GetTotalAuraMultiplier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+template<typename Predicate>
+float Unit::_GetTotalAuraMultiplier(AuraType auraType, Predicate const& predicate) const
 {
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auraType);
     if (mTotalAuraList.empty())
@@ -4805,7 +4852,8 @@ float Unit::GetTotalAuraMultiplier(AuraType auraType, std::function<bool(AuraEff
     return multiplier;
 }
 
-int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+template<typename Predicate>
+int32 Unit::_GetMaxPositiveAuraModifier(AuraType auraType, Predicate const& predicate) const
 {
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auraType);
     if (mTotalAuraList.empty())
@@ -4821,7 +4869,8 @@ int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType, std::function<bool(Aur
     return modifier;
 }
 
-int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+template<typename Predicate>
+int32 Unit::_GetMaxNegativeAuraModifier(AuraType auraType, Predicate const& predicate) const
 {
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auraType);
     if (mTotalAuraList.empty())
@@ -4837,29 +4886,111 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType, std::function<bool(Aur
     return modifier;
 }
 
+int32 Unit::GetTotalAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+{
+    return _GetTotalAuraModifier(auraType, predicate);
+}
+
+float Unit::GetTotalAuraMultiplier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+{
+    return _GetTotalAuraMultiplier(auraType, predicate);
+}
+
+int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+{
+    return _GetMaxPositiveAuraModifier(auraType, predicate);
+}
+
+int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType, std::function<bool(AuraEffect const*)> const& predicate) const
+{
+    return _GetMaxNegativeAuraModifier(auraType, predicate);
+}
+
+Unit::AuraTotalCacheEntry* Unit::GetAuraTotalCacheEntry(AuraType auraType) const
+{
+    if (!sWorld->getBoolConfig(CONFIG_AURA_TOTAL_CACHE))
+        return nullptr;
+
+    // spell group stack rules were reloaded since the totals were summed
+    uint32 generation = AuraTotalCacheGeneration.load(std::memory_order_relaxed);
+    if (m_auraTotalCacheGeneration != generation)
+    {
+        m_auraTotalCache.clear();
+        m_auraTotalCacheGeneration = generation;
+    }
+
+    return &m_auraTotalCache[auraType];
+}
+
+void Unit::InvalidateAuraTotalCache(AuraType auraType)
+{
+    m_auraTotalCache.erase(auraType);
+}
+
+/*static*/ void Unit::InvalidateAllAuraTotalCaches()
+{
+    ++AuraTotalCacheGeneration;
+}
+
+/*static*/ void Unit::ConsumeAuraTotalCacheStatistics(uint64& hits, uint64& misses)
+{
+    hits = AuraTotalCacheHits.exchange(0);
+    misses = AuraTotalCacheMisses.exchange(0);
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auraType) const
 {
-    return GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    if (GetAuraEffectsByType(auraType).empty())
+        return 0;
+
+    AuraTotalCacheEntry* cache = GetAuraTotalCacheEntry(auraType);
+    if (!cache)
+        return _GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+
+    if (cache->Modifier)
+    {
+        ++AuraTotalCacheHits;
+        return *cache->Modifier;
+    }
+
+    ++AuraTotalCacheMisses;
+    cache->Modifier = _GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return *cache->Modifier;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auraType) const
 {
-    return GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    if (GetAuraEffectsByType(auraType).empty())
+        return 1.0f;
+
+    AuraTotalCacheEntry* cache = GetAuraTotalCacheEntry(auraType);
+    if (!cache)
+        return _GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+
+    if (cache->Multiplier)
+    {
+        ++AuraTotalCacheHits;
+        return *cache->Multiplier;
+    }
+
+    ++AuraTotalCacheMisses;
+    cache->Multiplier = _GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return *cache->Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return _GetMaxPositiveAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return _GetMaxNegativeAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+    return _GetTotalAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
     {
         if ((aurEff->GetMiscValue() & miscMask) != 0)
             return true;
@@ -4869,7 +5000,7 @@ int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) c
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraMultiplier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+    return _GetTotalAuraMultiplier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
     {
         if ((aurEff->GetMiscValue() & miscMask) != 0)
             return true;
@@ -4879,7 +5010,7 @@ float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auraType, uint32 miscMask)
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auraType, uint32 miscMask, AuraEffect const* except /*= nullptr*/) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [miscMask, except](AuraEffect const* aurEff) -> bool
+    return _GetMaxPositiveAuraModifier(auraType, [miscMask, except](AuraEffect const* aurEff) -> bool
     {
         if (except != aurEff && (aurEff->GetMiscValue() & miscMask) != 0)
             return true;
@@ -4889,7 +5020,7 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auraType, uint32 miscM
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+    return _GetMaxNegativeAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
     {
         if ((aurEff->GetMiscValue() & miscMask) != 0)
             return true;
@@ -4899,7 +5030,7 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auraType, uint32 miscM
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetTotalAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return _GetTotalAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->GetMiscValue() == miscValue)
             return true;
@@ -4909,7 +5040,7 @@ int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auraType, int32 miscValue)
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetTotalAuraMultiplier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return _GetTotalAuraMultiplier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->GetMiscValue() == miscValue)
             return true;
@@ -4919,7 +5050,7 @@ float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auraType, int32 miscValue
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return _GetMaxPositiveAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->GetMiscValue() == miscValue)
             return true;
@@ -4929,7 +5060,7 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auraType, int32 miscV
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return _GetMaxNegativeAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->GetMiscValue() == miscValue)
             return true;
@@ -4939,7 +5070,7 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auraType, int32 miscV
 
 int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const
 {
-    return GetTotalAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
+    return _GetTotalAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->IsAffectingSpell(affectedSpell))
             return true;
@@ -4949,7 +5080,7 @@ int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auraType, SpellInfo const*
 
 float Unit::GetTotalAuraMultiplierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const
 {
-    return GetTotalAuraMultiplier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
+    return _GetTotalAuraMultiplier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->IsAffectingSpell(affectedSpell))
             return true;
@@ -4959,7 +5090,7 @@ float Unit::GetTotalAuraMultiplierByAffectMask(AuraType auraType, SpellInfo cons
 
 int32 Unit::GetMaxPositiveAuraModifierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
+    return _GetMaxPositiveAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->IsAffectingSpell(affectedSpell))
             return true;
@@ -4969,7 +5100,7 @@ int32 Unit::GetMaxPositiveAuraModifierByAffectMask(AuraType auraType, SpellInfo
 
 int32 Unit::GetMaxNegativeAuraModifierByAffectMask(AuraType auraType, SpellInfo const* affectedSpell) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
+    return _GetMaxNegativeAuraModifier(auraType, [affectedSpell](AuraEffect const* aurEff) -> bool
     {
         if (aurEff->IsAffectingSpell(affectedSpell))
             return true;
@@ -5325,6 +5456,12 @@ void Unit::SendSpellNonMeleeDamageLog(SpellNonMeleeDamage const* log)
                                          ProcFlagsSpellType spellTypeMask, ProcFlagsSpellPhase spellPhaseMask, ProcFlagsHit hitMask,
                                          Spell* spell, DamageInfo* damageInfo, HealInfo* healInfo)
 {
+    // logs of the periodic ticks causing these procs must reach clients before anything the procs log
+    if (actor)
+        actor->SendPendingPeriodicAuraLog();
+    if (actionTarget)
+        actionTarget->SendPendingPeriodicAuraLog();
+
     WeaponAttackType attType = damageInfo ? damageInfo->GetAttackType() : BASE_ATTACK;
     if (typeMaskActor && actor)
         actor->ProcSkillsAndReactives(false, actionTarget, typeMaskActor, hitMask, attType);
@@ -5339,11 +5476,26 @@ void Unit::SendSpellNonMeleeDamageLog(SpellNonMeleeDamage const* log)
 void Unit::SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* info)
 {
     AuraEffect const* aura = info->auraEff;
-    WorldPackets::CombatLog::SpellPeriodicAuraLog data;
-    data.TargetGUID = GetGUID();
-    data.CasterGUID = aura->GetCasterGUID();
-    data.SpellID = aura->GetId();
-    data.LogData.Initialize(this);
+    if (_pendingPeriodicAuraLog && (_pendingPeriodicAuraLog->CasterGUID != aura->GetCasterGUID() || _pendingPeriodicAuraLog->SpellID != int32(aura->GetId())))
+        SendPendingPeriodicAuraLog();
+
+    WorldPackets::CombatLog::SpellPeriodicAuraLog immediateData;
+    WorldPackets::CombatLog::SpellPeriodicAuraLog* data = &immediateData;
+    if (_periodicAuraLogBatchDepth)
+    {
+        if (!_pendingPeriodicAuraLog)
+            _pendingPeriodicAuraLog = std::make_unique<WorldPackets::CombatLog::SpellPeriodicAuraLog>();
+
+        data = _pendingPeriodicAuraLog.get();
+    }
+
+    if (data->Effects.empty())
+    {
+        data->TargetGUID = GetGUID();
+        data->CasterGUID = aura->GetCasterGUID();
+        data->SpellID = aura->GetId();
+        data->LogData.Initialize(this);
+    }
 
     WorldPackets::CombatLog::SpellPeriodicAuraLog::SpellLogEffect spellLogEffect;
     spellLogEffect.Effect = aura->GetAuraType();
@@ -5361,9 +5513,27 @@ void Unit::SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* info)
         if (contentTuningParams.GenerateDataForUnits(caster, this))
             spellLogEffect.ContentTuning = contentTuningParams;
 
-    data.Effects.push_back(spellLogEffect);
+    data->Effects.push_back(spellLogEffect);
 
-    SendCombatLogMessage(&data);
+    if (!_periodicAuraLogBatchDepth)
+        SendCombatLogMessage(data);
+}
+
+void Unit::EndPeriodicAuraLogBatch()
+{
+    ASSERT(_periodicAuraLogBatchDepth);
+    if (!--_periodicAuraLogBatchDepth)
+        SendPendingPeriodicAuraLog();
+}
+
+void Unit::SendPendingPeriodicAuraLog()
+{
+    if (!_pendingPeriodicAuraLog)
+        return;
+
+    // reset before sending, this unit could be asked to log more while it is being sent
+    std::unique_ptr<WorldPackets::CombatLog::SpellPeriodicAuraLog> data = std::move(_pendingPeriodicAuraLog);
+    SendCombatLogMessage(data.get());
 }
 
 void Unit::SendSpellDamageResist(Unit* target, uint32 spellId)
@@ -9153,7 +9323,7 @@ void Unit::SetHealth(uint64 val)
     }
 
     uint64 oldVal = GetHealth();
-    SetUpdateFieldValue(m_values.ModifyValue(&Unit::m_unitData).ModifyValue(&UF::UnitData::Health), val);
+    SetUpdateFieldValue(m_values.ModifyValue(&Unit::m_unitData).ModifyValue(&UF::UnitData::Health), val, GetResourceUpdateFieldPriority());
 
     TriggerOnHealthChangeAuras(oldVal, val);
 
@@ -9170,6 +9340,14 @@ void Unit::SetHealth(uint64 val)
     }
 }
 
+UF::UpdateFieldPriority Unit::GetResourceUpdateFieldPriority() const
+{
+    if (IsControlledByPlayer() || IsInCombat() || !IsAlive())
+        return UF::UpdateFieldPriority::Immediate;
+
+    return UF::UpdateFieldPriority::Coalesced;
+}
+
 void Unit::SetMaxHealth(uint64 val)
 {
     if (!val)
@@ -9223,7 +9401,7 @@ void Unit::SetPower(Powers power, int32 val, bool withPowerUpdate /*= true*/)
         val = maxPower;
 
     int32 oldPower = m_unitData->Power[powerIndex];
-    SetUpdateFieldValue(m_values.ModifyValue(&Unit::m_unitData).ModifyValue(&UF::UnitData::Power, powerIndex), val);
+    SetUpdateFieldValue(m_values.ModifyValue(&Unit::m_unitData).ModifyValue(&UF::UnitData::Power, powerIndex), val, GetResourceUpdateFieldPriority());
 
     if (IsInWorld() && withPowerUpdate)
     {
@@ -9278,7 +9456,7 @@ void Unit::TriggerOnPowerChangeAuras(Powers power, int32 oldVal, int32 newVal)
 {
     AuraEffectList effects       = GetAuraEffectsByType(SPELL_AURA_TRIGGER_SPELL_ON_POWER_PCT);
     AuraEffectList effectsAmount = GetAuraEffectsByType(SPELL_AURA_TRIGGER_SPELL_ON_POWER_AMOUNT);
-    effects.splice(effects.end(), effectsAmount);
+    effects.insert(effects.end(), effectsAmount.begin(), effectsAmount.end());
 
     for (AuraEffect const* effect : effects)
     {
@@ -9320,9 +9498,24 @@ void Unit::AIUpdateTick(uint32 diff)
 {
     if (UnitAI* ai = GetAI())
     {
+        bool recordScript = GetTypeId() == TYPEID_UNIT && sFlightRecorder->IsEnabled();
+        bool profileScript = GetTypeId() == TYPEID_UNIT && sScriptProfiler->ShouldSample();
+        Optional<TimePoint> start;
+        if (recordScript || profileScript)
+            start = std::chrono::steady_clock::now();
+
         m_aiLocked = true;
         ai->UpdateAI(diff);
         m_aiLocked = false;
+
+        if (start)
+        {
+            Microseconds duration = std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - *start);
+            if (recordScript)
+                sFlightRecorder->RecordScript(*ToCreature(), duration);
+            if (profileScript)
+                sScriptProfiler->RecordCreatureAI(*ToCreature(), duration);
+        }
     }
 }
 
@@ -9975,11 +10168,63 @@ void Unit::GetProcAurasTriggeredOnEvent(AuraApplicationProcContainer& aurasTrigg
     // or generate one on our own
     else
     {
-        for (AuraApplicationMap::iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
-            processAuraApplication(itr->second);
+        RebuildProcAuraIndexIfNeeded();
+
+        // auras without spell_proc entry never proc, neither do auras with proc flags not matching the event
+        // by index, proc checks of scripts may apply auras
+        ProcFlagsInit typeMask = eventInfo.GetTypeMask();
+        for (std::size_t i = 0; i < m_procAuraIndex.size(); ++i)
+            if (m_procAuraIndex[i].CheckOnAllEvents || (m_procAuraIndex[i].ProcFlags & typeMask))
+                processAuraApplication(m_procAuraIndex[i].Application);
     }
 }
 
+void Unit::AddProcAuraIndexEntry(AuraApplication* aurApp)
+{
+    SpellInfo const* spellInfo = aurApp->GetBase()->GetSpellInfo();
+    SpellProcEntry const* procEntry = sSpellMgr->GetSpellProcEntry(spellInfo);
+    if (!procEntry)
+        return;
+
+    bool checkOnAllEvents = spellInfo->HasAttribute(SPELL_ATTR0_PROC_FAILURE_BURNS_CHARGE) || spellInfo->HasAttribute(SPELL_ATTR2_PROC_COOLDOWN_ON_FAILURE);
+    if (!procEntry->ProcFlags && !checkOnAllEvents)
+        return;
+
+    // keep the order of m_appliedAuras, new applications go after others of the same spell
+    auto itr = std::upper_bound(m_procAuraIndex.begin(), m_procAuraIndex.end(), spellInfo->Id, [](uint32 spellId, ProcAuraIndexEntry const& entry)
+    {
+        return spellId < entry.Application->GetBase()->GetId();
+    });
+    m_procAuraIndex.insert(itr, { aurApp, procEntry->ProcFlags, checkOnAllEvents });
+}
+
+void Unit::RemoveProcAuraIndexEntry(AuraApplication const* aurApp)
+{
+    auto itr = std::find_if(m_procAuraIndex.begin(), m_procAuraIndex.end(), [aurApp](ProcAuraIndexEntry const& entry)
+    {
+        return entry.Application == aurApp;
+    });
+    if (itr != m_procAuraIndex.end())
+        m_procAuraIndex.erase(itr);
+}
+
+void Unit::RebuildProcAuraIndexIfNeeded()
+{
+    uint32 generation = ProcAuraIndexGeneration.load(std::memory_order_relaxed);
+    if (m_procAuraIndexGeneration == generation)
+        return;
+
+    m_procAuraIndexGeneration = generation;
+    m_procAuraIndex.clear();
+    for (AuraApplicationMap::value_type const& pair : m_appliedAuras)
+        AddProcAuraIndexEntry(pair.second);
+}
+
+/*static*/ void Unit::InvalidateAllProcAuraIndexes()
+{
+    ++ProcAuraIndexGeneration;
+}
+
 void Unit::TriggerAurasProcOnEvent(AuraApplicationList* myProcAuras, AuraApplicationList* targetProcAuras, Unit* actionTarget,
                                    ProcFlagsInit const& typeMaskActor, ProcFlagsInit const& typeMaskActionTarget, ProcFlagsSpellType spellTypeMask,
                                    ProcFlagsSpellPhase spellPhaseMask, ProcFlagsHit hitMask, Spell* spell, DamageInfo* damageInfo, HealInfo* healInfo)
@@ -10738,6 +10983,8 @@ void Unit::SetMeleeAnimKitId(uint16 animKitId)
         // Generate loot before updating looter
         if (creature)
         {
+            creature->ClearPendingPersonalLoot();
+
             DungeonEncounterEntry const* dungeonEncounter = nullptr;
             if (InstanceScript const* instance = creature->GetInstanceScript())
                 dungeonEncounter = instance->GetBossDungeonEncounter(creature);
@@ -10774,6 +11021,18 @@ void Unit::SetMeleeAnimKitId(uint16 animKitId)
                             tapperGroup->UpdateLooterGuid(creature);
                 }
             }
+            else if (!dungeonEncounter && sWorld->getBoolConfig(CONFIG_CORPSE_LOOT_ON_DEMAND))
+            {
+                // roll the loot of each tapper when they open the corpse, most farmed corpses are never looted
+                GuidUnorderedSet looters;
+                for (Player* tapper : tappers)
+                {
+                    creature->m_personalLoot.erase(tapper->GetGUID());
+                    looters.insert(tapper->GetGUID());
+                }
+
+                creature->SetPendingPersonalLoot(std::move(looters), creature->GetLootMode());
+            }
             else
             {
                 for (Player* tapper : tappers)
@@ -11794,13 +12053,13 @@ void Unit::SendCancelSpellVisualKit(uint32 id)
 void Unit::CancelSpellMissiles(uint32 spellId, bool reverseMissile /*= false*/)
 {
     bool hasMissile = false;
-    for (std::pair<uint64 const, BasicEvent*> const& itr : m_Events.GetEvents())
+    for (EventProcessor::ScheduledEvent const& scheduledEvent : m_Events.GetEvents())
     {
-        if (Spell const* spell = Spell::ExtractSpellFromEvent(itr.second))
+        if (Spell const* spell = Spell::ExtractSpellFromEvent(scheduledEvent.Event))
         {
             if (spell->GetSpellInfo()->Id == spellId)
             {
-                itr.second->ScheduleAbort();
+                scheduledEvent.Event->ScheduleAbort();
                 hasMissile = true;
             }
         }
@@ -13437,6 +13696,23 @@ void Unit::BuildValuesUpdate(ByteBuffer* data, Player const* target) const
     data->put<uint32>(sizePos, data->wpos() - sizePos - 4);
 }
 
+bool Unit::HasViewerDependentChanges() const
+{
+    if (Object::HasViewerDependentChanges())
+        return true;
+
+    if (!m_values.HasChanged(TYPEID_UNIT))
+        return false;
+
+    return m_unitData->HasChanged(&UF::UnitData::DisplayID)
+        || m_unitData->HasChanged(&UF::UnitData::NpcFlags)
+        || m_unitData->HasChanged(&UF::UnitData::FactionTemplate)
+        || m_unitData->HasChanged(&UF::UnitData::Flags)
+        || m_unitData->HasChanged(&UF::UnitData::Flags3)
+        || m_unitData->HasChanged(&UF::UnitData::AuraState)
+        || m_unitData->HasChanged(&UF::UnitData::PvpFlags);
+}
+
 void Unit::BuildValuesUpdateWithFlag(ByteBuffer* data, UF::UpdateFieldFlag flags, Player const* target) const
 {
     UpdateMask<NUM_CLIENT_OBJECT_TYPES> valuesMask;
@@ -13555,10 +13831,9 @@ bool Unit::IsHighestExclusiveAura(Aura const* aura, bool removeOtherAuraApplicat
 bool Unit::IsHighestExclusiveAuraEffect(SpellInfo const* spellInfo, AuraType auraType, int32 effectAmount, uint32 auraEffectMask, bool removeOtherAuraApplications /*= false*/)
 {
     AuraEffectList const& auras = GetAuraEffectsByType(auraType);
-    for (Unit::AuraEffectList::const_iterator itr = auras.begin(); itr != auras.end();)
+    for (std::size_t index = 0; index < auras.size();)
     {
-        AuraEffect const* existingAurEff = (*itr);
-        ++itr;
+        AuraEffect const* existingAurEff = auras[index];
 
         if (sSpellMgr->CheckSpellGroupStackRules(spellInfo, existingAurEff->GetSpellInfo()) == SPELL_GROUP_STACK_RULE_EXCLUSIVE_HIGHEST)
         {
@@ -13575,17 +13850,18 @@ bool Unit::IsHighestExclusiveAuraEffect(SpellInfo const* spellInfo, AuraType aur
                 {
                     if (AuraApplication* aurApp = existingAurEff->GetBase()->GetApplicationOfTarget(GetGUID()))
                     {
-                        bool hasMoreThanOneEffect = base->HasMoreThanOneEffectForType(auraType);
                         uint32 removedAuras = m_removedAurasCount;
                         RemoveAura(aurApp);
-                        if (hasMoreThanOneEffect || m_removedAurasCount > removedAuras + 1)
-                            itr = auras.begin();
+                        NextAuraEffectAfterRemoval(auras, index, existingAurEff, m_removedAurasCount > removedAuras + 1);
+                        continue;
                     }
                 }
             }
             else if (diff < 0)
                 return false;
         }
+
+        ++index;
     }
 
     return true;
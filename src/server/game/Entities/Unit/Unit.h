@@ -21,6 +21,7 @@
 #include "Object.h"
 #include "CombatManager.h"
 #include "FlatSet.h"
+#include "GridPositionIndex.h"
 #include "SpellAuraDefines.h"
 #include "ThreatManager.h"
 #include "Timer.h"
@@ -30,6 +31,8 @@
 #include <map>
 #include <memory>
 #include <stack>
+#include <unordered_map>
+#include <vector>
 
 #define VISUAL_WAYPOINT 1 // Creature Entry ID used for waypoints show, visible only for GMs
 #define WORLD_TRIGGER 12999
@@ -111,6 +114,14 @@ namespace Movement
     struct SpellEffectExtraData;
 }
 
+namespace WorldPackets
+{
+    namespace CombatLog
+    {
+        class SpellPeriodicAuraLog;
+    }
+}
+
 typedef std::list<Unit*> UnitList;
 
 class TC_GAME_API DispelableAura
@@ -759,7 +770,7 @@ class TC_GAME_API Unit : public WorldObject
         typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
         typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
-        typedef std::list<AuraEffect*> AuraEffectList;
+        typedef std::vector<AuraEffect*> AuraEffectList;
         typedef std::list<Aura*> AuraList;
         typedef std::list<AuraApplication*> AuraApplicationList;
         typedef std::array<DiminishingReturn, DIMINISHING_MAX> Diminishing;
@@ -800,6 +811,13 @@ class TC_GAME_API Unit : public WorldObject
 
         virtual void Update(uint32 time) override;
 
+        // hide Position::Relocate to keep the position index of the grid cell containing this unit up to date
+        void Relocate(float x, float y) { Position::Relocate(x, y); UpdateGridPositionIndex(); }
+        void Relocate(float x, float y, float z) { Position::Relocate(x, y, z); UpdateGridPositionIndex(); }
+        void Relocate(float x, float y, float z, float o) { Position::Relocate(x, y, z, o); UpdateGridPositionIndex(); }
+        void Relocate(Position const& pos) { Position::Relocate(pos); UpdateGridPositionIndex(); }
+        void Relocate(Position const* pos) { Position::Relocate(pos); UpdateGridPositionIndex(); }
+
         void setAttackTimer(WeaponAttackType type, uint32 time) { m_attackTimer[type] = time; }
         void resetAttackTimer(WeaponAttackType type = BASE_ATTACK);
         uint32 getAttackTimer(WeaponAttackType type) const { return m_attackTimer[type]; }
@@ -808,7 +826,12 @@ class TC_GAME_API Unit : public WorldObject
         bool CanDualWield() const { return m_canDualWield; }
         virtual void SetCanDualWield(bool value) { m_canDualWield = value; }
         float GetCombatReach() const override { return m_unitData->CombatReach; }
-        void SetCombatReach(float combatReach) { SetUpdateFieldValue(m_values.ModifyValue(&Unit::m_unitData).ModifyValue(&UF::UnitData::CombatReach), combatReach); }
+        void SetCombatReach(float combatReach)
+        {
+            SetUpdateFieldValue(m_values.ModifyValue(&Unit::m_unitData).ModifyValue(&UF::UnitData::CombatReach), combatReach);
+            if (m_gridPositionIndex)
+                m_gridPositionIndex->SetCombatReach(m_gridPositionIndexSlot, combatReach);
+        }
         float GetBoundingRadius() const { return m_unitData->BoundingRadius; }
         void SetBoundingRadius(float boundingRadius) { SetUpdateFieldValue(m_values.ModifyValue(&Unit::m_unitData).ModifyValue(&UF::UnitData::BoundingRadius), boundingRadius); }
         bool IsWithinCombatRange(Unit const* obj, float dist2compare) const;
@@ -907,6 +930,8 @@ class TC_GAME_API Unit : public WorldObject
         int64 ModifyHealth(int64 val);
         int64 GetHealthGain(int64 dVal);
         void TriggerOnHealthChangeAuras(uint64 oldVal, uint64 newVal);
+        // health and power of creatures nobody fights only change by regeneration, clients can see those late
+        UF::UpdateFieldPriority GetResourceUpdateFieldPriority() const;
 
         virtual float GetHealthMultiplierForTarget(WorldObject const* /*target*/) const { return 1.0f; }
         virtual float GetDamageMultiplierForTarget(WorldObject const* /*target*/) const { return 1.0f; }
@@ -1042,6 +1067,7 @@ class TC_GAME_API Unit : public WorldObject
                                 DamageInfo* damageInfo, HealInfo* healInfo);
 
         void GetProcAurasTriggeredOnEvent(AuraApplicationProcContainer& aurasTriggeringProc, AuraApplicationList* procAuras, ProcEventInfo& eventInfo);
+        static void InvalidateAllProcAuraIndexes();     // spell_proc was reloaded
         void TriggerAurasProcOnEvent(AuraApplicationList* myProcAuras, AuraApplicationList* targetProcAuras,
                                      Unit* actionTarget, ProcFlagsInit const& typeMaskActor, ProcFlagsInit const& typeMaskActionTarget,
                                      ProcFlagsSpellType spellTypeMask, ProcFlagsSpellPhase spellPhaseMask, ProcFlagsHit hitMask, Spell* spell,
@@ -1207,6 +1233,10 @@ class TC_GAME_API Unit : public WorldObject
         void SendAttackStateUpdate(uint32 HitInfo, Unit* target, uint8 SwingType, SpellSchoolMask damageSchoolMask, uint32 Damage, uint32 AbsorbDamage, uint32 Resist, VictimState TargetState, uint32 BlockedAmount);
         void SendSpellNonMeleeDamageLog(SpellNonMeleeDamage const* log);
         void SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo);
+        // between these calls periodic aura logs of the same caster and spell are sent as one packet, procs send the pending one early
+        void BeginPeriodicAuraLogBatch() { ++_periodicAuraLogBatchDepth; }
+        void EndPeriodicAuraLogBatch();
+        void SendPendingPeriodicAuraLog();
         void SendSpellDamageResist(Unit* target, uint32 spellId);
         void SendSpellDamageImmune(Unit* target, uint32 spellId, bool isPeriodic);
 
@@ -1415,8 +1445,11 @@ class TC_GAME_API Unit : public WorldObject
         void _RemoveAllAuraStatMods();
         void _ApplyAllAuraStatMods();
 
-        AuraEffectList const& GetAuraEffectsByType(AuraType type) const { return m_modAuras[type]; }
-        AuraEffectList& GetAuraEffectsByType(AuraType type) { return m_modAuras[type]; }
+        AuraEffectList const& GetAuraEffectsByType(AuraType type) const
+        {
+            uint16 listIndex = m_modAuraListIndex[type];
+            return listIndex ? *m_modAuraLists[listIndex - 1] : EmptyAuraEffectList;
+        }
         AuraList      & GetSingleCastAuras()       { return m_scAuras; }
         AuraList const& GetSingleCastAuras() const { return m_scAuras; }
 
@@ -1460,6 +1493,10 @@ class TC_GAME_API Unit : public WorldObject
 
         int32 GetTotalAuraModifier(AuraType auraType) const;
         float GetTotalAuraMultiplier(AuraType auraType) const;
+        // totals of the two functions above are remembered per unit when Unit.AuraTotalCache is enabled
+        void InvalidateAuraTotalCache(AuraType auraType);
+        static void InvalidateAllAuraTotalCaches();     // spell group stack rules changed
+        static void ConsumeAuraTotalCacheStatistics(uint64& hits, uint64& misses);
         int32 GetMaxPositiveAuraModifier(AuraType auraType) const;
         int32 GetMaxNegativeAuraModifier(AuraType auraType) const;
 
@@ -1903,6 +1940,8 @@ class TC_GAME_API Unit : public WorldObject
 
         std::string GetDebugInfo() const override;
 
+        // kept in full for every unit: the layout, changes mask bit indexes and WriteCreate/WriteUpdate of UnitData are
+        // produced by the update field generator, so a compact creature variant has to come from there (see m_modAuraListIndex)
         UF::UpdateField<UF::UnitData, 0, TYPEID_UNIT> m_unitData;
 
     protected:
@@ -1914,6 +1953,7 @@ class TC_GAME_API Unit : public WorldObject
 
     public:
         void BuildValuesUpdateWithFlag(ByteBuffer* data, UF::UpdateFieldFlag flags, Player const* target) const override;
+        bool HasViewerDependentChanges() const override;
         void BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::Mask const& requestedObjectMask,
             UF::UnitData::Mask const& requestedUnitMask, Player const* target) const;
 
@@ -1969,9 +2009,28 @@ class TC_GAME_API Unit : public WorldObject
         AuraMap::iterator m_auraUpdateIterator;
         uint32 m_removedAurasCount;
 
-        AuraEffectList m_modAuras[TOTAL_AURAS];
+        // effect lists are only allocated for aura types ever applied to this unit, most units use a handful of them
+        // and a full array of TOTAL_AURAS lists would take ~13KB per creature; 0 means no list, otherwise index + 1
+        std::array<uint16, TOTAL_AURAS> m_modAuraListIndex;
+        std::vector<std::unique_ptr<AuraEffectList>> m_modAuraLists; // lists are never freed while the unit exists, references stay valid
+        static AuraEffectList const EmptyAuraEffectList;
+        struct AuraTotalCacheEntry
+        {
+            Optional<int32> Modifier;
+            Optional<float> Multiplier;
+        };
+        mutable std::unordered_map<AuraType, AuraTotalCacheEntry> m_auraTotalCache;
+        mutable uint32 m_auraTotalCacheGeneration;
         AuraList m_scAuras;                        // cast singlecast auras
         AuraApplicationList m_interruptableAuras;  // auras which have interrupt mask applied on unit
+        struct ProcAuraIndexEntry
+        {
+            AuraApplication* Application;
+            ProcFlagsInit ProcFlags;
+            bool CheckOnAllEvents;                 // failed procs burn charges or start cooldowns
+        };
+        std::vector<ProcAuraIndexEntry> m_procAuraIndex; // applied auras with a spell_proc entry, in m_appliedAuras order
+        uint32 m_procAuraIndexGeneration;
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
         EnumFlag<SpellAuraInterruptFlags> m_interruptMask;
         EnumFlag<SpellAuraInterruptFlags2> m_interruptMask2;
@@ -2028,6 +2087,25 @@ class TC_GAME_API Unit : public WorldObject
         void UpdateSplineMovement(uint32 t_diff);
         void UpdateSplinePosition();
         void InterruptMovementBasedAuras();
+        // predicates are inlined here, the public overloads only wrap them
+        template<typename Predicate>
+        int32 _GetTotalAuraModifier(AuraType auraType, Predicate const& predicate) const;
+        template<typename Predicate>
+        float _GetTotalAuraMultiplier(AuraType auraType, Predicate const& predicate) const;
+        template<typename Predicate>
+        int32 _GetMaxPositiveAuraModifier(AuraType auraType, Predicate const& predicate) const;
+        template<typename Predicate>
+        int32 _GetMaxNegativeAuraModifier(AuraType auraType, Predicate const& predicate) const;
+
+        // nullptr if caching is disabled
+        AuraTotalCacheEntry* GetAuraTotalCacheEntry(AuraType auraType) const;
+
+        void AddProcAuraIndexEntry(AuraApplication* aurApp);
+        void RemoveProcAuraIndexEntry(AuraApplication const* aurApp);
+        void RebuildProcAuraIndexIfNeeded();
+
+        // advances index of a loop over auras after the effect at index was removed
+        static void NextAuraEffectAfterRemoval(AuraEffectList const& auras, std::size_t& index, AuraEffect const* removed, bool removedOthers);
 
         // player or player's pet
         float GetCombatRatingReduction(CombatRating cr) const;
@@ -2088,6 +2166,19 @@ class TC_GAME_API Unit : public WorldObject
         PositionUpdateInfo _positionUpdateInfo;
 
         bool _isCombatDisallowed;
+
+        std::unique_ptr<WorldPackets::CombatLog::SpellPeriodicAuraLog> _pendingPeriodicAuraLog;
+        uint32 _periodicAuraLogBatchDepth;
+
+        void UpdateGridPositionIndex()
+        {
+            if (m_gridPositionIndex)
+                m_gridPositionIndex->Relocate(m_gridPositionIndexSlot, GetPositionX(), GetPositionY(), GetPositionZ());
+        }
+
+        friend class GridPositionIndex;
+        GridPositionIndex* m_gridPositionIndex;
+        uint32 m_gridPositionIndexSlot;
 };
 
 namespace Trinity
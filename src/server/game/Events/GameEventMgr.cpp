@@ -17,6 +17,7 @@
 
 #include "GameEventMgr.h"
 #include "BattlegroundMgr.h"
+#include "ConditionMgr.h"
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "DatabaseEnv.h"
@@ -132,6 +133,18 @@ void GameEventMgr::StartInternalEvent(uint16 event_id)
     StartEvent(event_id);
 }
 
+void GameEventMgr::AddActiveEvent(uint16 event_id)
+{
+    m_ActiveEvents.insert(event_id);
+    sConditionMgr->NotifyConditionTypeChanged(CONDITION_ACTIVE_EVENT);
+}
+
+void GameEventMgr::RemoveActiveEvent(uint16 event_id)
+{
+    m_ActiveEvents.erase(event_id);
+    sConditionMgr->NotifyConditionTypeChanged(CONDITION_ACTIVE_EVENT);
+}
+
 bool GameEventMgr::StartEvent(uint16 event_id, bool overwrite)
 {
     GameEventData &data = mGameEvent[event_id];
@@ -144,6 +157,8 @@ bool GameEventMgr::StartEvent(uint16 event_id, bool overwrite)
             mGameEvent[event_id].start = GameTime::GetGameTime();
             if (data.end <= data.start)
                 data.end = data.start + data.length;
+            if (isSystemInit)
+                ScheduleEventCheck(event_id, GameTime::GetGameTime());
         }
         return false;
     }
@@ -185,6 +200,8 @@ void GameEventMgr::StopEvent(uint16 event_id, bool overwrite)
         data.start = GameTime::GetGameTime() - data.length * MINUTE;
         if (data.end <= data.start)
             data.end = data.start + data.length;
+        if (isSystemInit)
+            ScheduleEventCheck(event_id, GameTime::GetGameTime());
     }
     else if (serverwide_evt)
     {
@@ -558,6 +575,7 @@ void GameEventMgr::LoadFromDB()
 
                 QuestRelList& questlist = mGameEventCreatureQuests[event_id];
                 questlist.push_back(QuestRelation(id, quest));
+                sObjectMgr->AddGameEventCreatureQuestStarter(id, quest);
 
                 ++count;
             }
@@ -595,6 +613,7 @@ void GameEventMgr::LoadFromDB()
 
                 QuestRelList& questlist = mGameEventGameObjectQuests[event_id];
                 questlist.push_back(QuestRelation(id, quest));
+                sObjectMgr->AddGameEventGOQuestStarter(id, quest);
 
                 ++count;
             }
@@ -996,6 +1015,7 @@ void GameEventMgr::Initialize()
 uint32 GameEventMgr::StartSystem()                           // return the next event delay in ms
 {
     m_ActiveEvents.clear();
+    sConditionMgr->NotifyConditionTypeChanged(CONDITION_ACTIVE_EVENT);
     uint32 delay = Update();
     isSystemInit = true;
     return delay;
@@ -1030,13 +1050,12 @@ uint32 GameEventMgr::Update()                               // return the next e
 {
     time_t currenttime = GameTime::GetGameTime();
     uint32 nextEventDelay = max_ge_check_delay;             // 1 day
-    uint32 calcDelay;
     std::set<uint16> activate, deactivate;
-    for (uint16 itr = 1; itr < mGameEvent.size(); ++itr)
+
+    auto checkEvent = [&](uint16 itr)
     {
         // must do the activating first, and after that the deactivating
         // so first queue it
-        //TC_LOG_ERROR("sql.sql", "Checking event {}", itr);
         if (CheckOneGameEvent(itr))
         {
             // if the world event is in NEXTPHASE state, and the time has passed to finish this event, then do so
@@ -1051,20 +1070,18 @@ uint32 GameEventMgr::Update()                               // return the next e
                 if (IsActiveEvent(itr))
                     deactivate.insert(itr);
                 // go to next event, this no longer needs an event update timer
-                continue;
+                return;
             }
             else if (mGameEvent[itr].state == GAMEEVENT_WORLD_CONDITIONS && CheckOneGameEventConditions(itr))
                 // changed, save to DB the gameevent state, will be updated in next update cycle
                 SaveWorldEventStateToDB(itr);
 
-            //TC_LOG_DEBUG("misc", "GameEvent {} is active", itr->first);
             // queue for activation
             if (!IsActiveEvent(itr))
                 activate.insert(itr);
         }
         else
         {
-            //TC_LOG_DEBUG("misc", "GameEvent {} is not active", itr->first);
             if (IsActiveEvent(itr))
                 deactivate.insert(itr);
             else
@@ -1077,10 +1094,40 @@ uint32 GameEventMgr::Update()                               // return the next e
                 }
             }
         }
-        calcDelay = NextCheck(itr);
-        if (calcDelay < nextEventDelay)
-            nextEventDelay = calcDelay;
+
+        ScheduleEventCheck(itr, currenttime + NextCheck(itr));
+    };
+
+    if (!isSystemInit)
+    {
+        // the first update looks at every event to build the schedule
+        _eventNextCheck.assign(mGameEvent.size(), 0);
+        _eventCheckSchedule = {};
+        _worldEventIds.clear();
+        for (uint16 itr = 1; itr < mGameEvent.size(); ++itr)
+        {
+            if (mGameEvent[itr].state != GAMEEVENT_NORMAL && mGameEvent[itr].state != GAMEEVENT_INTERNAL)
+                _worldEventIds.push_back(itr);
+
+            checkEvent(itr);
+        }
     }
+    else
+    {
+        // world events depend on the state of other events and on quest progress, they are always checked
+        std::set<uint16> dueEvents(_worldEventIds.begin(), _worldEventIds.end());
+        while (!_eventCheckSchedule.empty() && _eventCheckSchedule.top().first <= currenttime)
+        {
+            auto [checkTime, eventId] = _eventCheckSchedule.top();
+            _eventCheckSchedule.pop();
+            if (_eventNextCheck[eventId] == checkTime)
+                dueEvents.insert(eventId);
+        }
+
+        for (uint16 eventId : dueEvents)
+            checkEvent(eventId);
+    }
+
     // now activate the queue
     // a now activated event can contain a spawn of a to-be-deactivated one
     // following the activate - deactivate order, deactivating the first event later will leave the spawn in (wont disappear then reappear clientside)
@@ -1092,10 +1139,24 @@ uint32 GameEventMgr::Update()                               // return the next e
             nextEventDelay = 0;
     for (std::set<uint16>::iterator itr = deactivate.begin(); itr != deactivate.end(); ++itr)
         StopEvent(*itr);
+
+    // drop checks that were rescheduled since they were queued
+    while (!_eventCheckSchedule.empty() && _eventNextCheck[_eventCheckSchedule.top().second] != _eventCheckSchedule.top().first)
+        _eventCheckSchedule.pop();
+
+    if (!_eventCheckSchedule.empty())
+        nextEventDelay = std::min<uint32>(nextEventDelay, uint32(std::max<time_t>(_eventCheckSchedule.top().first - currenttime, 0)));
+
     TC_LOG_INFO("gameevent", "Next game event check in {} seconds.", nextEventDelay + 1);
     return (nextEventDelay + 1) * IN_MILLISECONDS;           // Add 1 second to be sure event has started/stopped at next call
 }
 
+void GameEventMgr::ScheduleEventCheck(uint16 event_id, time_t checkTime)
+{
+    _eventNextCheck[event_id] = checkTime;
+    _eventCheckSchedule.emplace(checkTime, event_id);
+}
+
 void GameEventMgr::UnApplyEvent(uint16 event_id)
 {
     TC_LOG_INFO("gameevent", "GameEvent {} \"{}\" removed.", event_id, mGameEvent[event_id].description);
@@ -1218,22 +1279,38 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         return;
     }
 
+    // spawns are collected per map and created by the threads updating those maps
+    std::unordered_map<uint32, std::vector<ObjectGuid::LowType>> creaturesByMap;
     for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
     {
         // Add to correct cell
         if (CreatureData const* data = sObjectMgr->GetCreatureData(*itr))
         {
             sObjectMgr->AddCreatureToGrid(data);
+            creaturesByMap[data->mapId].push_back(*itr);
+        }
+    }
 
-            // Spawn if necessary (loaded grids only)
-            sMapMgr->DoForAllMapsWithMapId(data->mapId, [&itr, data](Map* map)
+    for (auto& [mapId, spawnIds] : creaturesByMap)
+    {
+        sMapMgr->DoForAllMapsWithMapId(mapId, [&spawnIds](Map* map)
+        {
+            map->AddUpdateTask([spawnIds](Map* map)
             {
-                map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, *itr);
-                // We use spawn coords to spawn
-                if (map->IsGridLoaded(data->spawnPoint))
-                    Creature::CreateCreatureFromDB(*itr, map);
+                for (ObjectGuid::LowType spawnId : spawnIds)
+                {
+                    CreatureData const* data = sObjectMgr->GetCreatureData(spawnId);
+                    if (!data)
+                        continue;
+
+                    map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, spawnId);
+                    // Spawn if necessary (loaded grids only)
+                    // We use spawn coords to spawn
+                    if (map->IsGridLoaded(data->spawnPoint))
+                        Creature::CreateCreatureFromDB(spawnId, map);
+                }
             });
-        }
+        });
     }
 
     if (internal_event_id >= int32(mGameEventGameobjectGuids.size()))
@@ -1243,32 +1320,46 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         return;
     }
 
+    std::unordered_map<uint32, std::vector<ObjectGuid::LowType>> gameobjectsByMap;
     for (GuidList::iterator itr = mGameEventGameobjectGuids[internal_event_id].begin(); itr != mGameEventGameobjectGuids[internal_event_id].end(); ++itr)
     {
         // Add to correct cell
         if (GameObjectData const* data = sObjectMgr->GetGameObjectData(*itr))
         {
             sObjectMgr->AddGameobjectToGrid(data);
-            // Spawn if necessary (loaded grids only)
-            // this base map checked as non-instanced and then only existed
-            sMapMgr->DoForAllMapsWithMapId(data->mapId, [&itr, data](Map* map)
+            gameobjectsByMap[data->mapId].push_back(*itr);
+        }
+    }
+
+    for (auto& [mapId, spawnIds] : gameobjectsByMap)
+    {
+        sMapMgr->DoForAllMapsWithMapId(mapId, [&spawnIds](Map* map)
+        {
+            map->AddUpdateTask([spawnIds](Map* map)
             {
-                map->RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, *itr);
-                // We use current coords to unspawn, not spawn coords since creature can have changed grid
-                if (map->IsGridLoaded(data->spawnPoint))
+                for (ObjectGuid::LowType spawnId : spawnIds)
                 {
-                    if (GameObject* go = GameObject::CreateGameObjectFromDB(*itr, map, false))
+                    GameObjectData const* data = sObjectMgr->GetGameObjectData(spawnId);
+                    if (!data)
+                        continue;
+
+                    map->RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, spawnId);
+                    // Spawn if necessary (loaded grids only)
+                    if (map->IsGridLoaded(data->spawnPoint))
                     {
-                        /// @todo find out when it is add to map
-                        if (go->isSpawnedByDefault())
+                        if (GameObject* go = GameObject::CreateGameObjectFromDB(spawnId, map, false))
                         {
-                            if (!map->AddToMap(go))
-                                delete go;
+                            /// @todo find out when it is add to map
+                            if (go->isSpawnedByDefault())
+                            {
+                                if (!map->AddToMap(go))
+                                    delete go;
+                            }
                         }
                     }
                 }
             });
-        }
+        });
     }
 
     if (internal_event_id >= int32(mGameEventPoolIds.size()))
@@ -1282,9 +1373,12 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
     {
         if (PoolTemplateData const* poolTemplate = sPoolMgr->GetPoolTemplate(*itr))
         {
-            sMapMgr->DoForAllMapsWithMapId(poolTemplate->MapId, [&itr](Map* map)
+            sMapMgr->DoForAllMapsWithMapId(poolTemplate->MapId, [poolId = *itr](Map* map)
             {
-                sPoolMgr->SpawnPool(map->GetPoolData(), *itr);
+                map->AddUpdateTask([poolId](Map* map)
+                {
+                    sPoolMgr->SpawnPool(map->GetPoolData(), poolId);
+                });
             });
         }
     }
@@ -1301,6 +1395,8 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         return;
     }
 
+    // despawns go through the same per map queue as spawns so that they are applied in order
+    std::unordered_map<uint32, std::vector<ObjectGuid::LowType>> creaturesByMap;
     for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
     {
         // check if it's needed by another event, if so, don't remove
@@ -1310,19 +1406,29 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         if (CreatureData const* data = sObjectMgr->GetCreatureData(*itr))
         {
             sObjectMgr->RemoveCreatureFromGrid(data);
+            creaturesByMap[data->mapId].push_back(*itr);
+        }
+    }
 
-            sMapMgr->DoForAllMapsWithMapId(data->mapId, [&itr](Map* map)
+    for (auto& [mapId, spawnIds] : creaturesByMap)
+    {
+        sMapMgr->DoForAllMapsWithMapId(mapId, [&spawnIds](Map* map)
+        {
+            map->AddUpdateTask([spawnIds](Map* map)
             {
-                map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, *itr);
-                auto creatureBounds = map->GetCreatureBySpawnIdStore().equal_range(*itr);
-                for (auto itr2 = creatureBounds.first; itr2 != creatureBounds.second;)
+                for (ObjectGuid::LowType spawnId : spawnIds)
                 {
-                    Creature* creature = itr2->second;
-                    ++itr2;
-                    creature->AddObjectToRemoveList();
+                    map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, spawnId);
+                    auto creatureBounds = map->GetCreatureBySpawnIdStore().equal_range(spawnId);
+                    for (auto itr2 = creatureBounds.first; itr2 != creatureBounds.second;)
+                    {
+                        Creature* creature = itr2->second;
+                        ++itr2;
+                        creature->AddObjectToRemoveList();
+                    }
                 }
             });
-        }
+        });
     }
 
     if (internal_event_id < 0 || internal_event_id >= int32(mGameEventGameobjectGuids.size()))
@@ -1332,6 +1438,7 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         return;
     }
 
+    std::unordered_map<uint32, std::vector<ObjectGuid::LowType>> gameobjectsByMap;
     for (GuidList::iterator itr = mGameEventGameobjectGuids[internal_event_id].begin(); itr != mGameEventGameobjectGuids[internal_event_id].end(); ++itr)
     {
         // check if it's needed by another event, if so, don't remove
@@ -1341,19 +1448,29 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         if (GameObjectData const* data = sObjectMgr->GetGameObjectData(*itr))
         {
             sObjectMgr->RemoveGameobjectFromGrid(data);
+            gameobjectsByMap[data->mapId].push_back(*itr);
+        }
+    }
 
-            sMapMgr->DoForAllMapsWithMapId(data->mapId, [&itr](Map* map)
+    for (auto& [mapId, spawnIds] : gameobjectsByMap)
+    {
+        sMapMgr->DoForAllMapsWithMapId(mapId, [&spawnIds](Map* map)
+        {
+            map->AddUpdateTask([spawnIds](Map* map)
             {
-                map->RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, *itr);
-                auto gameobjectBounds = map->GetGameObjectBySpawnIdStore().equal_range(*itr);
-                for (auto itr2 = gameobjectBounds.first; itr2 != gameobjectBounds.second;)
+                for (ObjectGuid::LowType spawnId : spawnIds)
                 {
-                    GameObject* go = itr2->second;
-                    ++itr2;
-                    go->AddObjectToRemoveList();
+                    map->RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, spawnId);
+                    auto gameobjectBounds = map->GetGameObjectBySpawnIdStore().equal_range(spawnId);
+                    for (auto itr2 = gameobjectBounds.first; itr2 != gameobjectBounds.second;)
+                    {
+                        GameObject* go = itr2->second;
+                        ++itr2;
+                        go->AddObjectToRemoveList();
+                    }
                 }
             });
-        }
+        });
     }
 
     if (internal_event_id < 0 || internal_event_id >= int32(mGameEventPoolIds.size()))
@@ -1366,9 +1483,12 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
     {
         if (PoolTemplateData const* poolTemplate = sPoolMgr->GetPoolTemplate(*itr))
         {
-            sMapMgr->DoForAllMapsWithMapId(poolTemplate->MapId, [&itr](Map* map)
+            sMapMgr->DoForAllMapsWithMapId(poolTemplate->MapId, [poolId = *itr](Map* map)
             {
-                sPoolMgr->DespawnPool(map->GetPoolData(), *itr, true);
+                map->AddUpdateTask([poolId](Map* map)
+                {
+                    sPoolMgr->DespawnPool(map->GetPoolData(), poolId, true);
+                });
             });
         }
     }
@@ -1687,11 +1807,15 @@ void GameEventMgr::RunSmartAIScripts(uint16 event_id, bool activate)
 {
     //! Iterate over every supported source type (creature and gameobject)
     //! Not entirely sure how this will affect units in non-loaded grids.
+    //! Queued behind the spawn changes of the event so that the hooks see the same objects as before
     sMapMgr->DoForAllMaps([event_id, activate](Map* map)
     {
-        GameEventAIHookWorker worker(event_id, activate);
-        TypeContainerVisitor<GameEventAIHookWorker, MapStoredObjectTypesContainer> visitor(worker);
-        visitor.Visit(map->GetObjectsStore());
+        map->AddUpdateTask([event_id, activate](Map* map)
+        {
+            GameEventAIHookWorker worker(event_id, activate);
+            TypeContainerVisitor<GameEventAIHookWorker, MapStoredObjectTypesContainer> visitor(worker);
+            visitor.Visit(map->GetObjectsStore());
+        });
     });
 }
 
@@ -24,6 +24,7 @@
 #include "ObjectGuid.h"
 #include <list>
 #include <map>
+#include <queue>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -119,8 +120,8 @@ class TC_GAME_API GameEventMgr
 
     private:
         void SendWorldStateUpdate(Player* player, uint16 event_id);
-        void AddActiveEvent(uint16 event_id) { m_ActiveEvents.insert(event_id); }
-        void RemoveActiveEvent(uint16 event_id) { m_ActiveEvents.erase(event_id); }
+        void AddActiveEvent(uint16 event_id);
+        void RemoveActiveEvent(uint16 event_id);
         void ApplyNewEvent(uint16 event_id);
         void UnApplyEvent(uint16 event_id);
         void GameEventSpawn(int16 event_id);
@@ -140,6 +141,7 @@ class TC_GAME_API GameEventMgr
         bool hasGameObjectActiveEventExcept(ObjectGuid::LowType go_guid, uint16 event_id);
         void SetHolidayEventTime(GameEventData& event);
         time_t GetLastStartTime(uint16 event_id) const;
+        void ScheduleEventCheck(uint16 event_id, time_t checkTime);
 
         typedef std::list<ObjectGuid::LowType> GuidList;
         typedef std::list<uint32> IdList;
@@ -172,6 +174,11 @@ class TC_GAME_API GameEventMgr
         ActiveEvents m_ActiveEvents;
         bool isSystemInit;
 
+        // next time each event has to be checked by Update, entries superseded by a later ScheduleEventCheck are skipped
+        std::priority_queue<std::pair<time_t, uint16>, std::vector<std::pair<time_t, uint16>>, std::greater<>> _eventCheckSchedule;
+        std::vector<time_t> _eventNextCheck;
+        std::vector<uint16> _worldEventIds;
+
     public:
         GameEventGuidMap  mGameEventCreatureGuids;
         GameEventGuidMap  mGameEventGameobjectGuids;
@@ -180,6 +180,17 @@ enum GarrisonFollowerStatus
     FOLLOWER_STATUS_NO_XP_GAIN  = 0x10
 };
 
+// Garrison rows fetched during login, kept by Player until the garrison is first used
+struct GarrisonLoadResults
+{
+    PreparedQueryResult Garrison;
+    PreparedQueryResult Blueprints;
+    PreparedQueryResult Buildings;
+    PreparedQueryResult Followers;
+    PreparedQueryResult Abilities;
+    bool ResetFollowerActivationLimit = false; // daily reset happened before the garrison was built
+};
+
 class TC_GAME_API Garrison
 {
 public:
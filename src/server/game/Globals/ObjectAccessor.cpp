@@ -27,6 +27,59 @@
 #include "Pet.h"
 #include "Player.h"
 #include "Transport.h"
+#include <array>
+
+namespace
+{
+// Lookup index split into independently locked shards, map threads searching for different
+// players do not contend on the same lock. Iteration still goes through HashMapHolder container
+template<typename Key>
+class PlayerLookupShards
+{
+public:
+    void Insert(Key const& key, Player* player)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.Lock);
+        shard.Players[key] = player;
+    }
+
+    void Remove(Key const& key)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.Lock);
+        shard.Players.erase(key);
+    }
+
+    Player* Find(Key const& key)
+    {
+        Shard& shard = GetShard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.Lock);
+        auto itr = shard.Players.find(key);
+        return itr != shard.Players.end() ? itr->second : nullptr;
+    }
+
+private:
+    static constexpr std::size_t ShardCount = 16;
+
+    struct alignas(64) Shard
+    {
+        std::shared_mutex Lock;
+        std::unordered_map<Key, Player*> Players;
+    };
+
+    Shard& GetShard(Key const& key)
+    {
+        // unordered_map uses the same hash for buckets, mix it so that shards and buckets do not correlate
+        uint64 hash = uint64(std::hash<Key>()(key)) * UI64LIT(0x9E3779B97F4A7C15);
+        return _shards[(hash >> 60) % ShardCount];
+    }
+
+    std::array<Shard, ShardCount> _shards;
+};
+
+PlayerLookupShards<ObjectGuid> PlayerGuidIndex;
+}
 
 template<class T>
 void HashMapHolder<T>::Insert(T* o)
@@ -37,6 +90,7 @@ void HashMapHolder<T>::Insert(T* o)
     std::unique_lock<std::shared_mutex> lock(*GetLock());
 
     GetContainer()[o->GetGUID()] = o;
+    PlayerGuidIndex.Insert(o->GetGUID(), o);
 }
 
 template<class T>
@@ -45,15 +99,13 @@ void HashMapHolder<T>::Remove(T* o)
     std::unique_lock<std::shared_mutex> lock(*GetLock());
 
     GetContainer().erase(o->GetGUID());
+    PlayerGuidIndex.Remove(o->GetGUID());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
-
-    typename MapType::iterator itr = GetContainer().find(guid);
-    return (itr != GetContainer().end()) ? itr->second : nullptr;
+    return PlayerGuidIndex.Find(guid);
 }
 
 template<class T>
@@ -74,17 +126,16 @@ template class TC_GAME_API HashMapHolder<Player>;
 
 namespace PlayerNameMapHolder
 {
-    typedef std::unordered_map<std::string, Player*> MapType;
-    static MapType PlayerNameMap;
+    static PlayerLookupShards<std::string> PlayerNameMap;
 
     void Insert(Player* p)
     {
-        PlayerNameMap[p->GetName()] = p;
+        PlayerNameMap.Insert(p->GetName(), p);
     }
 
     void Remove(Player* p)
     {
-        PlayerNameMap.erase(p->GetName());
+        PlayerNameMap.Remove(p->GetName());
     }
 
     Player* Find(std::string_view name)
@@ -93,8 +144,7 @@ namespace PlayerNameMapHolder
         if (!normalizePlayerName(charName))
             return nullptr;
 
-        auto itr = PlayerNameMap.find(charName);
-        return (itr != PlayerNameMap.end()) ? itr->second : nullptr;
+        return PlayerNameMap.Find(charName);
     }
 } // namespace PlayerNameMapHolder
 
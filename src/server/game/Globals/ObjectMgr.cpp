@@ -43,10 +43,12 @@
 #include "LootMgr.h"
 #include "Mail.h"
 #include "MapManager.h"
+#include "MemoryStats.h"
 #include "MotionMaster.h"
 #include "MovementTypedefs.h"
 #include "ObjectAccessor.h"
 #include "ObjectDefines.h"
+#include "ParallelValidation.h"
 #include "PhasingHandler.h"
 #include "Player.h"
 #include "QueryPackets.h"
@@ -68,6 +70,8 @@
 #include "VMapFactory.h"
 #include "VMapManager2.h"
 #include "World.h"
+#include "WorldDatabaseSnapshot.h"
+#include "WorldSocket.h"
 #include <G3D/g3dmath.h>
 #include <numeric>
 #include <limits>
@@ -241,6 +245,35 @@ ObjectMgr::~ObjectMgr()
 {
 }
 
+std::size_t ObjectMgr::GetMemoryUsage() const
+{
+    using Trinity::MemoryStats::EstimateContainerMemory;
+
+    return EstimateContainerMemory(_creatureTemplateStore)
+        + EstimateContainerMemory(_creatureDataStore)
+        + EstimateContainerMemory(_creatureAddonStore)
+        + EstimateContainerMemory(_creatureLocaleStore)
+        + EstimateContainerMemory(_creatureModelStore)
+        + EstimateContainerMemory(_equipmentInfoStore)
+        + EstimateContainerMemory(_gameObjectTemplateStore)
+        + EstimateContainerMemory(_gameObjectDataStore)
+        + EstimateContainerMemory(_gameObjectAddonStore)
+        + EstimateContainerMemory(_gameObjectLocaleStore)
+        + EstimateContainerMemory(_spawnGroupDataStore)
+        + EstimateContainerMemory(_linkedRespawnStore)
+        + EstimateContainerMemory(_itemTemplateStore)
+        + EstimateContainerMemory(_questTemplates)
+        + EstimateContainerMemory(_questTemplateLocaleStore)
+        + EstimateContainerMemory(_questPOIStore)
+        + EstimateContainerMemory(_creatureQuestRelations)
+        + EstimateContainerMemory(_goQuestRelations)
+        + EstimateContainerMemory(_gossipMenuItemsStore)
+        + EstimateContainerMemory(_npcTextStore)
+        + EstimateContainerMemory(_pageTextStore)
+        + EstimateContainerMemory(_pointsOfInterestStore)
+        + EstimateContainerMemory(_spellScriptsStore);
+}
+
 void ObjectMgr::AddLocaleString(std::string_view value, LocaleConstant localeConstant, std::vector<std::string>& data)
 {
     if (!value.empty())
@@ -2314,7 +2347,8 @@ void ObjectMgr::LoadCreatures()
     uint32 oldMSTime = getMSTime();
 
     //                                               0              1   2    3           4           5           6            7        8             9              10
-    QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, position_x, position_y, position_z, orientation, modelid, equipment_id, spawntimesecs, wander_distance, "
+    // streamed, the table is by far the biggest loaded at startup
+    QueryResult result = sWorldDatabaseSnapshot->StreamQuery("SELECT creature.guid, id, map, position_x, position_y, position_z, orientation, modelid, equipment_id, spawntimesecs, wander_distance, "
     //   11               12         13       14            15                 16          17           18                19                   20                    21
         "currentwaypoint, curhealth, curmana, MovementType, spawnDifficulties, eventEntry, poolSpawnId, creature.npcflag, creature.unit_flags, creature.unit_flags2, creature.unit_flags3, "
     //   22                     23                      24                25                   26                       27                   28
@@ -2336,8 +2370,6 @@ void ObjectMgr::LoadCreatures()
 
     PhaseShift phaseShift;
 
-    _creatureDataStore.reserve(result->GetRowCount());
-
     do
     {
         Field* fields = result->Fetch();
@@ -2365,7 +2397,7 @@ void ObjectMgr::LoadCreatures()
         data.curhealth      = fields[12].GetUInt32();
         data.curmana        = fields[13].GetUInt32();
         data.movementType   = fields[14].GetUInt8();
-        data.spawnDifficulties = ParseSpawnDifficulties(fields[15].GetStringView(), "creature", guid, data.mapId, spawnMasks[data.mapId]);
+        data.spawnDifficulties = GetSpawnDifficultySet(ParseSpawnDifficulties(fields[15].GetStringView(), "creature", guid, data.mapId, spawnMasks[data.mapId]));
         int16 gameEvent     = fields[16].GetInt8();
         data.poolId         = fields[17].GetUInt32();
         data.npcflag        = fields[18].GetUInt64();
@@ -2378,7 +2410,7 @@ void ObjectMgr::LoadCreatures()
         data.phaseGroup     = fields[25].GetUInt32();
         data.terrainSwapMap = fields[26].GetInt32();
         data.scriptId       = GetScriptId(fields[27].GetString());
-        data.StringId       = fields[28].GetString();
+        data.StringId       = GetSpawnStringId(fields[28].GetStringView());
         data.spawnGroupData = IsTransportMap(data.mapId) ? GetLegacySpawnGroup() : GetDefaultSpawnGroup(); // transport spawns default to compatibility group
 
         MapEntry const* mapEntry = sMapStore.LookupEntry(data.mapId);
@@ -2632,7 +2664,8 @@ void ObjectMgr::LoadGameObjects()
     uint32 oldMSTime = getMSTime();
 
     //                                                0                1   2    3           4           5           6
-    QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
+    // streamed, the table is among the biggest loaded at startup
+    QueryResult result = sWorldDatabaseSnapshot->StreamQuery("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
     //   7          8          9          10         11             12            13     14                 15          16
         "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnDifficulties, eventEntry, poolSpawnId, "
     //   17             18       19          20              21
@@ -2653,8 +2686,6 @@ void ObjectMgr::LoadGameObjects()
 
     PhaseShift phaseShift;
 
-    _gameObjectDataStore.reserve(result->GetRowCount());
-
     do
     {
         Field* fields = result->Fetch();
@@ -2745,7 +2776,7 @@ void ObjectMgr::LoadGameObjects()
         }
         data.goState       = GOState(go_state);
 
-        data.spawnDifficulties      = ParseSpawnDifficulties(fields[14].GetStringView(), "gameobject", guid, data.mapId, spawnMasks[data.mapId]);
+        data.spawnDifficulties      = GetSpawnDifficultySet(ParseSpawnDifficulties(fields[14].GetStringView(), "gameobject", guid, data.mapId, spawnMasks[data.mapId]));
         if (data.spawnDifficulties.empty())
         {
             TC_LOG_ERROR("sql.sql", "Table `creature` has creature (GUID: {}) that is not spawned in any difficulty, skipped.", guid);
@@ -4644,8 +4675,10 @@ void ObjectMgr::LoadQuests()
     _questObjectives.clear();
 
     _exclusiveQuestGroups.clear();
+    _questStatusDependents.clear();
+    _questsWithReputationOrSkillRequirements.clear();
 
-    QueryResult result = WorldDatabase.Query("SELECT "
+    QueryResult result = sWorldDatabaseSnapshot->Query("SELECT "
         //0  1          2               3                4            5            6                  7                8                   9
         "ID, QuestType, QuestPackageID, ContentTuningID, QuestSortID, QuestInfoID, SuggestedGroupNum, RewardNextQuest, RewardXPDifficulty, RewardXPMultiplier, "
         //10                    11                     12                13           14           15               16
@@ -5466,6 +5499,28 @@ void ObjectMgr::LoadQuests()
         }
     }
 
+    for (auto const& [questId, quest] : _questTemplates)
+    {
+        if (uint32 prevQuestId = std::abs(quest._prevQuestID))
+            AddQuestStatusDependent(prevQuestId, questId);
+
+        for (uint32 prevQuestId : quest.DependentPreviousQuests)
+            AddQuestStatusDependent(prevQuestId, questId);
+
+        if (uint32 nextQuestId = quest.GetNextQuestInChain())
+            AddQuestStatusDependent(questId, nextQuestId);
+
+        // breadcrumbs and their target quest block each other
+        for (uint32 breadcrumbQuestId : quest.DependentBreadcrumbQuests)
+        {
+            AddQuestStatusDependent(breadcrumbQuestId, questId);
+            AddQuestStatusDependent(questId, breadcrumbQuestId);
+        }
+
+        if (quest.GetRequiredMinRepFaction() || quest.GetRequiredMaxRepFaction() || quest.GetRequiredSkill())
+            _questsWithReputationOrSkillRequirements.push_back(questId);
+    }
+
     // check QUEST_SPECIAL_FLAGS_EXPLORATION_OR_EVENT for spell with SPELL_EFFECT_QUEST_COMPLETE
     for (SpellNameEntry const* spellNameEntry : sSpellNameStore)
     {
@@ -6203,9 +6258,10 @@ void ObjectMgr::ValidateSpellScripts()
         return;
     }
 
-    uint32 count = 0;
+    std::atomic<uint32> count = 0;
 
-    for (auto& spell : _spellScriptsStore)
+    // every script only validates against loaded data and updates its own enabled flag
+    Trinity::ValidateInParallel(_spellScriptsStore.begin(), _spellScriptsStore.end(), sWorld->getIntConfig(CONFIG_STARTUP_LOADER_THREADS), [&](SpellScriptsContainer::value_type& spell)
     {
         SpellInfo const* spellEntry = sSpellMgr->AssertSpellInfo(spell.first, DIFFICULTY_NONE);
 
@@ -6221,7 +6277,7 @@ void ObjectMgr::ValidateSpellScripts()
                 TC_LOG_ERROR("scripts", "Functions GetSpellScript() and GetAuraScript() of script `{}` do not return objects - script skipped", GetScriptName(spell.second.first));
 
                 spell.second.second = false;
-                continue;
+                return;
             }
 
             if (spellScript)
@@ -6232,7 +6288,7 @@ void ObjectMgr::ValidateSpellScripts()
                 if (!spellScript->_Validate(spellEntry))
                 {
                     spell.second.second = false;
-                    continue;
+                    return;
                 }
             }
 
@@ -6244,7 +6300,7 @@ void ObjectMgr::ValidateSpellScripts()
                 if (!auraScript->_Validate(spellEntry))
                 {
                     spell.second.second = false;
-                    continue;
+                    return;
                 }
             }
 
@@ -6253,9 +6309,9 @@ void ObjectMgr::ValidateSpellScripts()
         }
         else
             spell.second.second = false;
-    }
+    });
 
-    TC_LOG_INFO("server.loading", ">> Validated {} scripts in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
+    TC_LOG_INFO("server.loading", ">> Validated {} scripts in {} ms", count.load(), GetMSTimeDiffToNow(oldMSTime));
 }
 
 void ObjectMgr::LoadPageTexts()
@@ -6304,6 +6360,40 @@ PageText const* ObjectMgr::GetPageText(uint32 pageEntry)
     return nullptr;
 }
 
+WorldPacket ObjectMgr::BuildPageTextQueryData(uint32 pageEntry, LocaleConstant locale) const
+{
+    WorldPackets::Query::QueryPageTextResponse response;
+    response.PageTextID = pageEntry;
+
+    uint32 pageID = pageEntry;
+    while (pageID)
+    {
+        PageText const* pageText = Trinity::Containers::MapGetValuePtr(_pageTextStore, pageID);
+        if (!pageText)
+            break;
+
+        WorldPackets::Query::QueryPageTextResponse::PageTextInfo page;
+        page.ID = pageID;
+        page.NextPageID = pageText->NextPageID;
+        page.Text = pageText->Text;
+        page.PlayerConditionID = pageText->PlayerConditionID;
+        page.Flags = pageText->Flags;
+
+        if (locale != LOCALE_enUS)
+            if (PageTextLocale const* pageTextLocale = GetPageTextLocale(pageID))
+                GetLocaleString(pageTextLocale->Text, locale, page.Text);
+
+        response.Pages.push_back(page);
+        pageID = pageText->NextPageID;
+    }
+
+    response.Allow = !response.Pages.empty();
+
+    response.Write();
+    response.ShrinkToFit();
+    return response.Move();
+}
+
 void ObjectMgr::LoadPageTextLocales()
 {
     uint32 oldMSTime = getMSTime();
@@ -6583,7 +6673,7 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
     {
         CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EMPTY_EXPIRED_MAIL);
         stmt->setInt64(0, curTime);
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, SQLOperationPriority::Bulk);
     }
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL);
     stmt->setInt64(0, curTime);
@@ -6651,7 +6741,7 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 
                 stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM_BY_ID);
                 stmt->setUInt64(0, m->messageID);
-                CharacterDatabase.Execute(stmt);
+                CharacterDatabase.Execute(stmt, SQLOperationPriority::Bulk);
             }
             else
             {
@@ -6663,19 +6753,19 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
                 stmt->setInt64 (3, curTime);
                 stmt->setUInt8 (4, uint8(MAIL_CHECK_MASK_RETURNED));
                 stmt->setUInt64(5, m->messageID);
-                CharacterDatabase.Execute(stmt);
+                CharacterDatabase.Execute(stmt, SQLOperationPriority::Bulk);
                 for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
                 {
                     // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
                     stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
                     stmt->setUInt64(0, m->sender);
                     stmt->setUInt64(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    CharacterDatabase.Execute(stmt, SQLOperationPriority::Bulk);
 
                     stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_OWNER);
                     stmt->setUInt64(0, m->sender);
                     stmt->setUInt64(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    CharacterDatabase.Execute(stmt, SQLOperationPriority::Bulk);
                 }
                 delete m;
                 ++returnedCount;
@@ -6685,7 +6775,7 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
         stmt->setUInt64(0, m->messageID);
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, SQLOperationPriority::Bulk);
         delete m;
         ++deletedCount;
     }
@@ -8741,6 +8831,8 @@ void ObjectMgr::LoadQuestRelationsHelper(QuestRelations& map, QuestRelationsReve
     uint32 oldMSTime = getMSTime();
 
     map.clear();                                            // need for reload case
+    if (reverseMap)
+        reverseMap->clear();
 
     uint32 count = 0;
 
@@ -8772,9 +8864,19 @@ void ObjectMgr::LoadQuestRelationsHelper(QuestRelations& map, QuestRelationsReve
     TC_LOG_INFO("server.loading", ">> Loaded {} quest relations from {} in {} ms", count, table, GetMSTimeDiffToNow(oldMSTime));
 }
 
+void ObjectMgr::AddQuestStatusDependent(uint32 questId, uint32 dependentQuestId)
+{
+    if (questId == dependentQuestId)
+        return;
+
+    std::vector<uint32>& dependents = _questStatusDependents[questId];
+    if (std::find(dependents.begin(), dependents.end(), dependentQuestId) == dependents.end())
+        dependents.push_back(dependentQuestId);
+}
+
 void ObjectMgr::LoadGameobjectQuestStarters()
 {
-    LoadQuestRelationsHelper(_goQuestRelations, nullptr, "gameobject_queststarter");
+    LoadQuestRelationsHelper(_goQuestRelations, &_goQuestRelationsReverse, "gameobject_queststarter");
 
     for (QuestRelations::iterator itr = _goQuestRelations.begin(); itr != _goQuestRelations.end(); ++itr)
     {
@@ -8802,7 +8904,7 @@ void ObjectMgr::LoadGameobjectQuestEnders()
 
 void ObjectMgr::LoadCreatureQuestStarters()
 {
-    LoadQuestRelationsHelper(_creatureQuestRelations, nullptr, "creature_queststarter");
+    LoadQuestRelationsHelper(_creatureQuestRelations, &_creatureQuestRelationsReverse, "creature_queststarter");
 
     for (QuestRelations::iterator itr = _creatureQuestRelations.begin(); itr != _creatureQuestRelations.end(); ++itr)
     {
@@ -10232,6 +10334,22 @@ uint32 ObjectMgr::GetScriptId(std::string const& name, bool isDatabaseBound)
     return _scriptNamesStore.insert(name, isDatabaseBound);
 }
 
+std::span<Difficulty const> ObjectMgr::GetSpawnDifficultySet(std::span<Difficulty const> difficulties)
+{
+    if (difficulties.empty())
+        return {};
+
+    return *_spawnDifficultySetStore.emplace(difficulties.begin(), difficulties.end()).first;
+}
+
+std::string_view ObjectMgr::GetSpawnStringId(std::string_view stringId)
+{
+    if (stringId.empty())
+        return {};
+
+    return *_spawnStringIdStore.emplace(stringId).first;
+}
+
 CreatureBaseStats const* ObjectMgr::GetCreatureBaseStats(uint8 level, uint8 unitClass)
 {
     CreatureBaseStatsContainer::const_iterator it = _creatureBaseStatsStore.find(MAKE_PAIR16(level, unitClass));
@@ -11062,6 +11180,24 @@ void ObjectMgr::InitializeQueriesData(QueryDataGroup mask)
         for (auto& questTemplatePair : _questTemplates)
             pool.PostWork([quest = &questTemplatePair.second]() { quest->InitializeQueryData(); });
 
+    // Initialize Query Data for items
+    if (mask & QUERY_DATA_ITEMS)
+        for (auto& itemTemplatePair : _itemTemplateStore)
+            pool.PostWork([item = &itemTemplatePair.second]() { item->InitializeQueryData(); });
+
+    // Initialize Query Data for page texts
+    if (mask & QUERY_DATA_PAGE_TEXTS)
+    {
+        for (auto& pageTextPair : _pageTextStore)
+        {
+            pool.PostWork([this, pageEntry = pageTextPair.first, pageText = &pageTextPair.second]()
+            {
+                for (uint8 loc = LOCALE_enUS; loc < TOTAL_LOCALES; ++loc)
+                    pageText->QueryData[loc] = std::make_shared<SharedWorldPacket>(BuildPageTextQueryData(pageEntry, static_cast<LocaleConstant>(loc)));
+            });
+        }
+    }
+
     // Initialize Quest POI data
     if (mask & QUERY_DATA_POIS)
         for (auto& poiWrapperPair : _questPOIStore)
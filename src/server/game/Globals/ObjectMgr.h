@@ -25,6 +25,7 @@
 #include "GameObjectData.h"
 #include "ItemTemplate.h"
 #include "IteratorPair.h"
+#include "MapUtils.h"
 #include "MovementDefines.h"
 #include "NPCHandler.h"
 #include "ObjectDefines.h"
@@ -38,12 +39,14 @@
 #include "VehicleDefines.h"
 #include <iterator>
 #include <map>
+#include <memory>
 #include <unordered_map>
 
 class Item;
 class Unit;
 class Vehicle;
 class Map;
+class SharedWorldPacket;
 enum class GossipOptionFlags : int32;
 enum class GossipOptionNpc : uint8;
 struct AccessRequirement;
@@ -61,6 +64,7 @@ struct PageText
     uint32 NextPageID;
     int32 PlayerConditionID;
     uint8 Flags;
+    std::array<std::shared_ptr<SharedWorldPacket const>, TOTAL_LOCALES> QueryData;  // response starting at this page
 };
 
 enum SummonerType
@@ -1063,6 +1067,7 @@ enum QueryDataGroup
     QUERY_DATA_ITEMS = 0x04,
     QUERY_DATA_QUESTS = 0x08,
     QUERY_DATA_POIS = 0x10,
+    QUERY_DATA_PAGE_TEXTS = 0x20,
 
     QUERY_DATA_ALL = 0xFF
 };
@@ -1087,6 +1092,9 @@ class TC_GAME_API ObjectMgr
 
         static ObjectMgr* instance();
 
+        // shallow estimate of the largest template and spawn stores
+        std::size_t GetMemoryUsage() const;
+
         typedef std::unordered_map<uint32, Quest> QuestContainer;
         typedef std::unordered_map<uint32 /*questObjectiveId*/, QuestObjective const*> QuestObjectivesByIdContainer;
 
@@ -1299,10 +1307,17 @@ class TC_GAME_API ObjectMgr
 
         QuestRelations* GetGOQuestRelationMapHACK() { return &_goQuestRelations; }
         QuestRelationResult GetGOQuestRelations(uint32 entry) const { return GetQuestRelationsFrom(_goQuestRelations, entry, true); }
+        Trinity::IteratorPair<QuestRelationsReverse::const_iterator> GetGOQuestRelationReverseBounds(uint32 questId) const { return _goQuestRelationsReverse.equal_range(questId); }
+        // game event quests are added to the forward map only while active, their givers are kept apart so that reloading the starter tables doesn't drop them
+        Trinity::IteratorPair<QuestRelationsReverse::const_iterator> GetGameEventGOQuestRelationReverseBounds(uint32 questId) const { return _gameEventGOQuestRelationsReverse.equal_range(questId); }
+        void AddGameEventGOQuestStarter(uint32 entry, uint32 questId) { _gameEventGOQuestRelationsReverse.emplace(questId, entry); }
         QuestRelationResult GetGOQuestInvolvedRelations(uint32 entry) const { return GetQuestRelationsFrom(_goQuestInvolvedRelations, entry, false); }
         Trinity::IteratorPair<QuestRelationsReverse::const_iterator> GetGOQuestInvolvedRelationReverseBounds(uint32 questId) const { return _goQuestInvolvedRelationsReverse.equal_range(questId); }
         QuestRelations* GetCreatureQuestRelationMapHACK() { return &_creatureQuestRelations; }
         QuestRelationResult GetCreatureQuestRelations(uint32 entry) const { return GetQuestRelationsFrom(_creatureQuestRelations, entry, true); }
+        Trinity::IteratorPair<QuestRelationsReverse::const_iterator> GetCreatureQuestRelationReverseBounds(uint32 questId) const { return _creatureQuestRelationsReverse.equal_range(questId); }
+        Trinity::IteratorPair<QuestRelationsReverse::const_iterator> GetGameEventCreatureQuestRelationReverseBounds(uint32 questId) const { return _gameEventCreatureQuestRelationsReverse.equal_range(questId); }
+        void AddGameEventCreatureQuestStarter(uint32 entry, uint32 questId) { _gameEventCreatureQuestRelationsReverse.emplace(questId, entry); }
         QuestRelationResult GetCreatureQuestInvolvedRelations(uint32 entry) const { return GetQuestRelationsFrom(_creatureQuestInvolvedRelations, entry, false); }
         Trinity::IteratorPair<QuestRelationsReverse::const_iterator> GetCreatureQuestInvolvedRelationReverseBounds(uint32 questId) const { return _creatureQuestInvolvedRelationsReverse.equal_range(questId); }
 
@@ -1311,6 +1326,11 @@ class TC_GAME_API ObjectMgr
             return _exclusiveQuestGroups.equal_range(exclusiveGroupId);
         }
 
+        // quests whose availability depends on the state of questId through quest chains and breadcrumbs, see ConditionMgr for conditions
+        std::vector<uint32> const* GetQuestStatusDependents(uint32 questId) const { return Trinity::Containers::MapGetValuePtr(_questStatusDependents, questId); }
+        // quests requiring reputation or skill values, rewards of any quest can change their availability
+        std::vector<uint32> const& GetQuestsWithReputationOrSkillRequirements() const { return _questsWithReputationOrSkillRequirements; }
+
         bool LoadTrinityStrings();
 
         void LoadEventScripts();
@@ -1381,6 +1401,7 @@ class TC_GAME_API ObjectMgr
 
         void LoadPageTexts();
         PageText const* GetPageText(uint32 pageEntry);
+        WorldPacket BuildPageTextQueryData(uint32 pageEntry, LocaleConstant locale) const;
 
         void LoadPlayerInfo();
         void LoadPetLevelInfo();
@@ -1481,9 +1502,9 @@ class TC_GAME_API ObjectMgr
             return nullptr;
         }
 
-        CellObjectGuids const& GetCellObjectGuids(uint32 mapid, Difficulty spawnMode, uint32 cell_id)
+        CellObjectGuidsMap const* GetMapObjectGuidsIfExists(uint32 mapid, Difficulty spawnMode) const
         {
-            return _mapObjectGuidsStore[{ mapid, spawnMode }][cell_id];
+            return Trinity::Containers::MapGetValuePtr(_mapObjectGuidsStore, { mapid, spawnMode });
         }
 
         CellObjectGuidsMap const& GetMapObjectGuids(uint32 mapid, Difficulty spawnMode)
@@ -1672,6 +1693,10 @@ class TC_GAME_API ObjectMgr
         bool IsScriptDatabaseBound(uint32 id) const;
         uint32 GetScriptId(std::string const& name, bool isDatabaseBound = true);
 
+        // spawn data of hundreds of thousands of spawns only uses a few distinct difficulty sets and string ids, share them
+        std::span<Difficulty const> GetSpawnDifficultySet(std::span<Difficulty const> difficulties);
+        std::string_view GetSpawnStringId(std::string_view stringId);
+
         Trinity::IteratorPair<SpellClickInfoContainer::const_iterator> GetSpellClickInfoMapBounds(uint32 creature_id) const
         {
             return Trinity::Containers::MapEqualRange(_spellClickInfoStore, creature_id);
@@ -1829,13 +1854,19 @@ class TC_GAME_API ObjectMgr
         QuestPOIContainer _questPOIStore;
 
         QuestRelations _goQuestRelations;
+        QuestRelationsReverse _goQuestRelationsReverse;
         QuestRelations _goQuestInvolvedRelations;
         QuestRelationsReverse _goQuestInvolvedRelationsReverse;
         QuestRelations _creatureQuestRelations;
+        QuestRelationsReverse _creatureQuestRelationsReverse;
         QuestRelations _creatureQuestInvolvedRelations;
         QuestRelationsReverse _creatureQuestInvolvedRelationsReverse;
 
         ExclusiveQuestGroups _exclusiveQuestGroups;
+        std::unordered_map<uint32, std::vector<uint32>> _questStatusDependents;
+        std::vector<uint32> _questsWithReputationOrSkillRequirements;
+        QuestRelationsReverse _gameEventGOQuestRelationsReverse;
+        QuestRelationsReverse _gameEventCreatureQuestRelationsReverse;
 
         //character reserved names
         typedef std::set<std::wstring> ReservedNamesContainer;
@@ -1845,6 +1876,9 @@ class TC_GAME_API ObjectMgr
 
         ScriptNameContainer _scriptNamesStore;
 
+        std::set<std::vector<Difficulty>> _spawnDifficultySetStore;
+        std::unordered_set<std::string> _spawnStringIdStore;
+
         SpellClickInfoContainer _spellClickInfoStore;
 
         SpellScriptsContainer _spellScriptsStore;
@@ -1873,6 +1907,7 @@ class TC_GAME_API ObjectMgr
     private:
         void LoadScripts(ScriptsType type);
         void LoadQuestRelationsHelper(QuestRelations& map, QuestRelationsReverse* reverseMap, std::string const& table);
+        void AddQuestStatusDependent(uint32 questId, uint32 dependentQuestId);
         QuestRelationResult GetQuestRelationsFrom(QuestRelations const& map, uint32 key, bool onlyActive) const { return { map.equal_range(key), onlyActive }; }
         void PlayerCreateInfoAddItemHelper(uint32 race_, uint32 class_, uint32 itemId, int32 count);
 
@@ -0,0 +1,259 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldDatabaseSnapshot.h"
+#include "CryptoHash.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+#include "QueryResultSnapshot.h"
+#include "Timer.h"
+#include "Util.h"
+#include <boost/filesystem/operations.hpp>
+#include <fstream>
+
+namespace
+{
+constexpr uint32 SnapshotMagic = 0x53574354; // "TCWS"
+constexpr uint32 SnapshotVersion = 1;         // bump when the file layout changes
+}
+
+WorldDatabaseSnapshot::WorldDatabaseSnapshot() : _enabled(false), _dirty(false)
+{
+}
+
+WorldDatabaseSnapshot::~WorldDatabaseSnapshot() = default;
+
+std::string WorldDatabaseSnapshot::ComputeKey()
+{
+    Trinity::Crypto::SHA1 hash;
+    if (QueryResult result = WorldDatabase.Query("SELECT `name`, `hash` FROM `updates` ORDER BY `name` ASC"))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            hash.UpdateData(fields[0].GetString());
+            hash.UpdateData(fields[1].GetString());
+        } while (result->NextRow());
+    }
+
+    // catches most edits made by hand, UPDATE_TIME is not kept by every storage engine and
+    // is reset by server restarts (the key then changes and the snapshot is rebuilt once)
+    if (QueryResult result = WorldDatabase.Query("SELECT `TABLE_NAME`, IFNULL(CAST(`UPDATE_TIME` AS CHAR), '') FROM `information_schema`.`TABLES` WHERE `TABLE_SCHEMA` = DATABASE() ORDER BY `TABLE_NAME` ASC"))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            hash.UpdateData(fields[0].GetString());
+            hash.UpdateData(fields[1].GetString());
+        } while (result->NextRow());
+    }
+
+    hash.Finalize();
+    return ByteArrayToHexStr(hash.GetDigest());
+}
+
+void WorldDatabaseSnapshot::Load(std::string const& fileName)
+{
+    uint32 oldMSTime = getMSTime();
+
+    _enabled = true;
+    _dirty = false;
+    _fileName = fileName;
+    _key = ComputeKey();
+    _stored.clear();
+    _queried.clear();
+
+    std::ifstream in(_fileName, std::ios::in | std::ios::binary);
+    if (!in.is_open())
+    {
+        TC_LOG_INFO("server.loading", ">> World database snapshot {} not found, it will be created after startup", _fileName);
+        return;
+    }
+
+    auto readValue = [&in](auto& value) { return bool(in.read(reinterpret_cast<char*>(&value), sizeof(value))); };
+    auto readString = [&](std::string& value)
+    {
+        uint32 size = 0;
+        if (!readValue(size))
+            return false;
+
+        value.resize(size);
+        return bool(in.read(value.data(), size));
+    };
+
+    uint32 magic = 0, version = 0, count = 0;
+    std::string key;
+    if (!readValue(magic) || !readValue(version) || magic != SnapshotMagic || version != SnapshotVersion || !readString(key))
+    {
+        TC_LOG_ERROR("server.loading", ">> World database snapshot {} has an unknown format, ignoring it", _fileName);
+        return;
+    }
+
+    if (key != _key)
+    {
+        TC_LOG_INFO("server.loading", ">> World database snapshot {} was created for different database updates, ignoring it", _fileName);
+        return;
+    }
+
+    if (!readValue(count))
+    {
+        TC_LOG_ERROR("server.loading", ">> World database snapshot {} is truncated, ignoring it", _fileName);
+        return;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        std::string sql;
+        std::shared_ptr<QueryResultSnapshot> snapshot = std::make_shared<QueryResultSnapshot>();
+        if (!readString(sql) || !snapshot->Read(in))
+        {
+            TC_LOG_ERROR("server.loading", ">> World database snapshot {} is corrupt, ignoring it", _fileName);
+            _stored.clear();
+            return;
+        }
+
+        _stored[sql] = std::move(snapshot);
+    }
+
+    TC_LOG_INFO("server.loading", ">> Loaded world database snapshot {} with {} queries in {} ms", _fileName, _stored.size(), GetMSTimeDiffToNow(oldMSTime));
+}
+
+QueryResult WorldDatabaseSnapshot::Query(char const* sql, bool streamed)
+{
+    bool enabled;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        enabled = _enabled;
+        auto itr = _stored.find(sql);
+        if (enabled && itr != _stored.end())
+        {
+            std::shared_ptr<QueryResultSnapshot const> snapshot = itr->second;
+            _queried[itr->first] = snapshot;
+            _stored.erase(itr);
+            return MakeResult(snapshot);
+        }
+    }
+
+    if (!enabled)
+        return streamed ? WorldDatabase.StreamQuery(sql) : WorldDatabase.Query(sql);
+
+    // rows are copied into the snapshot right away, no need to buffer them on the client first
+    std::shared_ptr<QueryResultSnapshot const> snapshot;
+    if (QueryResult result = WorldDatabase.StreamQuery(sql))
+        snapshot = result->TakeSnapshot();
+    else
+        snapshot = std::make_shared<QueryResultSnapshot const>();
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_enabled)
+    {
+        _queried[sql] = snapshot;
+        _dirty = true;
+    }
+
+    return MakeResult(snapshot);
+}
+
+QueryResult WorldDatabaseSnapshot::MakeResult(std::shared_ptr<QueryResultSnapshot const> const& snapshot)
+{
+    if (!snapshot->RowCount)
+        return nullptr;
+
+    QueryResult result = std::make_shared<ResultSet>(snapshot);
+    result->NextRow();
+    return result;
+}
+
+bool WorldDatabaseSnapshot::Invalidate(std::string const& fileName)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _stored.clear();
+    _dirty = true;
+
+    boost::system::error_code error;
+    boost::filesystem::remove(fileName, error);
+    if (error)
+    {
+        TC_LOG_ERROR("server.loading", "Could not delete world database snapshot {}: {}", fileName, error.message());
+        return false;
+    }
+
+    TC_LOG_INFO("server.loading", "World database snapshot {} deleted, it will be created again on the next start", fileName);
+    return true;
+}
+
+void WorldDatabaseSnapshot::Save()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_enabled)
+        return;
+
+    _enabled = false;
+
+    // queries left in _stored are no longer executed by this revision, drop them from the file
+    if (_dirty || !_stored.empty())
+    {
+        uint32 oldMSTime = getMSTime();
+        std::string tempFileName = _fileName + ".tmp";
+        std::ofstream out(tempFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            TC_LOG_ERROR("server.loading", "Failed to create world database snapshot {}", tempFileName);
+        }
+        else
+        {
+            auto writeValue = [&out](auto value) { out.write(reinterpret_cast<char const*>(&value), sizeof(value)); };
+            auto writeString = [&](std::string const& value)
+            {
+                writeValue(uint32(value.size()));
+                out.write(value.data(), value.size());
+            };
+
+            writeValue(SnapshotMagic);
+            writeValue(SnapshotVersion);
+            writeString(_key);
+            writeValue(uint32(_queried.size()));
+            for (auto const& [sql, snapshot] : _queried)
+            {
+                writeString(sql);
+                snapshot->Write(out);
+            }
+
+            out.close();
+
+            boost::system::error_code error;
+            if (!out.fail())
+                boost::filesystem::rename(tempFileName, _fileName, error);
+
+            if (out.fail())
+                TC_LOG_ERROR("server.loading", "Failed to write world database snapshot {}", tempFileName);
+            else if (error)
+                TC_LOG_ERROR("server.loading", "Failed to replace world database snapshot {}: {}", _fileName, error.message());
+            else
+                TC_LOG_INFO("server.loading", ">> Saved world database snapshot {} with {} queries in {} ms", _fileName, _queried.size(), GetMSTimeDiffToNow(oldMSTime));
+        }
+    }
+
+    _stored.clear();
+    _queried.clear();
+}
+
+WorldDatabaseSnapshot* WorldDatabaseSnapshot::Instance()
+{
+    static WorldDatabaseSnapshot instance;
+    return &instance;
+}
@@ -0,0 +1,72 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef WorldDatabaseSnapshot_h__
+#define WorldDatabaseSnapshot_h__
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct QueryResultSnapshot;
+
+/// Keeps the results of static world database queries in a file between restarts.
+/// The file is only used while its key matches the updates applied to the world database and the
+/// last modification time of its tables, any other mismatch (missing query, corrupt file) falls back to querying the database.
+class TC_GAME_API WorldDatabaseSnapshot
+{
+public:
+    WorldDatabaseSnapshot();
+    ~WorldDatabaseSnapshot();
+
+    /// Reads the snapshot file, does nothing if it does not exist or is outdated
+    void Load(std::string const& fileName);
+
+    /// Same as WorldDatabase.Query, served from the snapshot when it contains the exact same query
+    /// Must only be used for tables that are not modified by the server while it is running
+    QueryResult Query(char const* sql) { return Query(sql, false); }
+
+    /// Same as WorldDatabase.StreamQuery when the snapshot is not used
+    QueryResult StreamQuery(char const* sql) { return Query(sql, true); }
+
+    /// Writes the queries executed since Load to the file if any of them were not served from it and stops using the snapshot
+    void Save();
+
+    /// Deletes the snapshot file so the next start reads everything from the database again
+    bool Invalidate(std::string const& fileName);
+
+    static WorldDatabaseSnapshot* Instance();
+
+private:
+    QueryResult Query(char const* sql, bool streamed);
+    static QueryResult MakeResult(std::shared_ptr<QueryResultSnapshot const> const& snapshot);
+    static std::string ComputeKey();
+
+    std::mutex _lock;
+    bool _enabled;
+    bool _dirty;
+    std::string _fileName;
+    std::string _key;
+    std::unordered_map<std::string, std::shared_ptr<QueryResultSnapshot const>> _stored;   ///< read from the file and not yet queried
+    std::unordered_map<std::string, std::shared_ptr<QueryResultSnapshot const>> _queried;  ///< queried since Load, written by Save
+};
+
+#define sWorldDatabaseSnapshot WorldDatabaseSnapshot::Instance()
+
+#endif // WorldDatabaseSnapshot_h__
@@ -95,6 +95,8 @@ class TypeContainerVisitor
             VisitorHelper(i_visitor, c);
         }
 
+        VISITOR const& GetVisitor() const { return i_visitor; }
+
     private:
         VISITOR &i_visitor;
 };
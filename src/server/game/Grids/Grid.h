@@ -47,6 +47,18 @@ class Grid
     // allows the GridLoader to access its internals
     template<class A, class T, class O> friend class GridLoader;
     public:
+        Grid()
+        {
+            OccupancyLinker linker{ &i_occupancy };
+            TypeContainerVisitor<OccupancyLinker, TypeMapContainer<GRID_OBJECT_TYPES>> gridLinker(linker);
+            gridLinker.Visit(i_container);
+            TypeContainerVisitor<OccupancyLinker, TypeMapContainer<WORLD_OBJECT_TYPES>> worldLinker(linker);
+            worldLinker.Visit(i_objects);
+        }
+
+        Grid(Grid const&) = delete;
+        Grid& operator=(Grid const&) = delete;
+
 
         /** destructor to clean up its resources. This includes unloading the
         grid if it has not been unload.
@@ -132,10 +144,23 @@ class Grid
         {
             return i_container.GetElements().isEmpty();
         }*/
+
+        /** Object types with at least one object in either container.
+         */
+        GridOccupancy& GetOccupancy() { return i_occupancy; }
+        GridOccupancy const& GetOccupancy() const { return i_occupancy; }
+
     private:
+        struct OccupancyLinker
+        {
+            GridOccupancy* Occupancy;
+
+            template<class OBJECT> void Visit(GridRefManager<OBJECT>& m) const { m.SetOccupancy(Occupancy); }
+        };
 
         TypeMapContainer<GRID_OBJECT_TYPES> i_container;
         TypeMapContainer<WORLD_OBJECT_TYPES> i_objects;
+        GridOccupancy i_occupancy;
         //typedef std::set<void*> ActiveGridObjects;
         //ActiveGridObjects m_activeGridObjects;
 };
@@ -76,19 +76,6 @@ typedef GridRefManager<AreaTrigger>     AreaTriggerMapType;
 typedef GridRefManager<SceneObject>     SceneObjectMapType;
 typedef GridRefManager<Conversation>    ConversationMapType;
 
-enum GridMapTypeMask
-{
-    GRID_MAP_TYPE_MASK_CORPSE           = 0x01,
-    GRID_MAP_TYPE_MASK_CREATURE         = 0x02,
-    GRID_MAP_TYPE_MASK_DYNAMICOBJECT    = 0x04,
-    GRID_MAP_TYPE_MASK_GAMEOBJECT       = 0x08,
-    GRID_MAP_TYPE_MASK_PLAYER           = 0x10,
-    GRID_MAP_TYPE_MASK_AREATRIGGER      = 0x20,
-    GRID_MAP_TYPE_MASK_SCENEOBJECT      = 0x40,
-    GRID_MAP_TYPE_MASK_CONVERSATION     = 0x80,
-    GRID_MAP_TYPE_MASK_ALL              = 0xFF
-};
-
 extern template class Grid<Player, AllWorldObjectTypes, AllGridObjectTypes>;
 extern template class NGrid<MAX_NUMBER_OF_CELLS, Player, AllWorldObjectTypes, AllGridObjectTypes>;
 
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GRID_DENSE_CONTAINER_H
+#define TRINITY_GRID_DENSE_CONTAINER_H
+
+#include "Define.h"
+#include <vector>
+
+template<class T>
+class GridObject;
+
+/// All objects linked to a single cell container stored in one array, so that visiting them
+/// doesn't follow a list node per object. Every object knows its slot to be removed in O(1).
+/// Objects removed while a visit is in progress leave a hole that is compacted after the
+/// outermost visit finished, objects added during a visit are not visited by it.
+template<class OBJECT>
+class GridDenseContainer
+{
+public:
+    GridDenseContainer() : _visitDepth(0), _holes(0) { }
+
+    GridDenseContainer(GridDenseContainer const&) = delete;
+    GridDenseContainer(GridDenseContainer&&) = delete;
+    GridDenseContainer& operator=(GridDenseContainer const&) = delete;
+    GridDenseContainer& operator=(GridDenseContainer&&) = delete;
+
+    void Insert(OBJECT* obj)
+    {
+        SlotOf(obj) = uint32(_elements.size());
+        _elements.push_back(obj);
+    }
+
+    void Remove(OBJECT* obj)
+    {
+        uint32 slot = SlotOf(obj);
+        if (_visitDepth)
+        {
+            // slots of all other objects must stay where the visits in progress expect them
+            _elements[slot] = nullptr;
+            ++_holes;
+            return;
+        }
+
+        _elements[slot] = _elements.back();
+        SlotOf(_elements[slot]) = slot;
+        _elements.pop_back();
+    }
+
+    std::size_t size() const { return _elements.size() - _holes; }
+
+    template<class Worker>
+    void ForEach(Worker&& worker)
+    {
+        ++_visitDepth;
+
+        std::size_t count = _elements.size();
+        for (std::size_t i = 0; i < count; ++i)
+            if (OBJECT* obj = _elements[i])
+                worker(obj);
+
+        if (!--_visitDepth && _holes)
+            Compact();
+    }
+
+private:
+    static uint32& SlotOf(OBJECT* obj) { return static_cast<GridObject<OBJECT>*>(obj)->_gridSlot; }
+
+    void Compact()
+    {
+        std::size_t i = 0;
+        while (i < _elements.size())
+        {
+            if (_elements[i])
+            {
+                ++i;
+                continue;
+            }
+
+            _elements[i] = _elements.back();
+            _elements.pop_back();
+            if (i < _elements.size() && _elements[i])
+                SlotOf(_elements[i]) = uint32(i);
+        }
+
+        _holes = 0;
+    }
+
+    std::vector<OBJECT*> _elements;
+    uint32 _visitDepth;
+    uint32 _holes;
+};
+
+#endif // TRINITY_GRID_DENSE_CONTAINER_H
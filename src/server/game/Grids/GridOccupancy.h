@@ -0,0 +1,115 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GRID_OCCUPANCY_H
+#define TRINITY_GRID_OCCUPANCY_H
+
+#include "Define.h"
+#include "Types.h"
+#include <array>
+#include <bit>
+#include <concepts>
+
+class AreaTrigger;
+class Conversation;
+class Corpse;
+class Creature;
+class DynamicObject;
+class GameObject;
+class Player;
+class SceneObject;
+
+enum GridMapTypeMask
+{
+    GRID_MAP_TYPE_MASK_CORPSE           = 0x01,
+    GRID_MAP_TYPE_MASK_CREATURE         = 0x02,
+    GRID_MAP_TYPE_MASK_DYNAMICOBJECT    = 0x04,
+    GRID_MAP_TYPE_MASK_GAMEOBJECT       = 0x08,
+    GRID_MAP_TYPE_MASK_PLAYER           = 0x10,
+    GRID_MAP_TYPE_MASK_AREATRIGGER      = 0x20,
+    GRID_MAP_TYPE_MASK_SCENEOBJECT      = 0x40,
+    GRID_MAP_TYPE_MASK_CONVERSATION     = 0x80,
+    GRID_MAP_TYPE_MASK_ALL              = 0xFF
+};
+
+/// Single GridMapTypeMask bit of a grid object type, used as index into the occupancy counts
+template<class OBJECT>
+inline constexpr uint32 GridMapTypeMaskOf = []
+{
+    static_assert(Trinity::dependant_false_v<OBJECT>, "GridMapTypeMaskOf is not specialized for this grid object type");
+    return 0u;
+}();
+
+template<> inline constexpr uint32 GridMapTypeMaskOf<Corpse> = GRID_MAP_TYPE_MASK_CORPSE;
+template<> inline constexpr uint32 GridMapTypeMaskOf<Creature> = GRID_MAP_TYPE_MASK_CREATURE;
+template<> inline constexpr uint32 GridMapTypeMaskOf<DynamicObject> = GRID_MAP_TYPE_MASK_DYNAMICOBJECT;
+template<> inline constexpr uint32 GridMapTypeMaskOf<GameObject> = GRID_MAP_TYPE_MASK_GAMEOBJECT;
+template<> inline constexpr uint32 GridMapTypeMaskOf<Player> = GRID_MAP_TYPE_MASK_PLAYER;
+template<> inline constexpr uint32 GridMapTypeMaskOf<AreaTrigger> = GRID_MAP_TYPE_MASK_AREATRIGGER;
+template<> inline constexpr uint32 GridMapTypeMaskOf<SceneObject> = GRID_MAP_TYPE_MASK_SCENEOBJECT;
+template<> inline constexpr uint32 GridMapTypeMaskOf<Conversation> = GRID_MAP_TYPE_MASK_CONVERSATION;
+
+/// Visitors that only handle some object types return their GridMapTypeMask from
+/// GetVisitedGridMapTypes() so that cells and grids without any of those types are skipped
+template<class VISITOR>
+concept GridMapTypeFilteredVisitor = requires(VISITOR const& visitor)
+{
+    { visitor.GetVisitedGridMapTypes() } -> std::convertible_to<uint32>;
+};
+
+/// Number of objects of every type linked to a cell or to all cells of a grid, cell counts are
+/// forwarded to the grid they belong to
+class GridOccupancy
+{
+public:
+    GridOccupancy() : _parent(nullptr), _counts(), _mask(0) { }
+
+    GridOccupancy(GridOccupancy const&) = delete;
+    GridOccupancy(GridOccupancy&&) = delete;
+    GridOccupancy& operator=(GridOccupancy const&) = delete;
+    GridOccupancy& operator=(GridOccupancy&&) = delete;
+
+    void SetParent(GridOccupancy* parent) { _parent = parent; }
+
+    void Add(uint32 typeMask)
+    {
+        if (!_counts[std::countr_zero(typeMask)]++)
+            _mask |= typeMask;
+
+        if (_parent)
+            _parent->Add(typeMask);
+    }
+
+    void Remove(uint32 typeMask)
+    {
+        if (!--_counts[std::countr_zero(typeMask)])
+            _mask &= ~typeMask;
+
+        if (_parent)
+            _parent->Remove(typeMask);
+    }
+
+    /// GridMapTypeMask of all types with at least one object
+    uint32 GetMask() const { return _mask; }
+
+private:
+    GridOccupancy* _parent;
+    std::array<uint32, 8> _counts;
+    uint32 _mask;
+};
+
+#endif // TRINITY_GRID_OCCUPANCY_H
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridPositionIndex.h"
+#include "Errors.h"
+#include "Unit.h"
+#include <atomic>
+
+namespace
+{
+std::atomic<uint32> NextGridPositionIndexId;
+}
+
+GridPositionIndex::GridPositionIndex() : _version(uint64(++NextGridPositionIndexId) << 32)
+{
+}
+
+GridPositionIndex::~GridPositionIndex()
+{
+    // container destroyed while units are still linked to it
+    for (Unit* unit : _units)
+        unit->m_gridPositionIndex = nullptr;
+}
+
+void GridPositionIndex::Insert(Unit* unit)
+{
+    ASSERT(!unit->m_gridPositionIndex);
+
+    unit->m_gridPositionIndex = this;
+    unit->m_gridPositionIndexSlot = uint32(_units.size());
+    _x.push_back(unit->GetPositionX());
+    _y.push_back(unit->GetPositionY());
+    _z.push_back(unit->GetPositionZ());
+    _combatReach.push_back(unit->GetCombatReach());
+    _units.push_back(unit);
+    ++_version;
+}
+
+void GridPositionIndex::Remove(Unit* unit)
+{
+    ASSERT(unit->m_gridPositionIndex == this);
+
+    uint32 slot = unit->m_gridPositionIndexSlot;
+    uint32 last = uint32(_units.size() - 1);
+    if (slot != last)
+    {
+        _x[slot] = _x[last];
+        _y[slot] = _y[last];
+        _z[slot] = _z[last];
+        _combatReach[slot] = _combatReach[last];
+        _units[slot] = _units[last];
+        _units[slot]->m_gridPositionIndexSlot = slot;
+    }
+
+    _x.pop_back();
+    _y.pop_back();
+    _z.pop_back();
+    _combatReach.pop_back();
+    _units.pop_back();
+    ++_version;
+
+    unit->m_gridPositionIndex = nullptr;
+}
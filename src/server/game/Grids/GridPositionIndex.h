@@ -0,0 +1,108 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GRID_POSITION_INDEX_H
+#define TRINITY_GRID_POSITION_INDEX_H
+
+#include "Define.h"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+class Creature;
+class Player;
+class Unit;
+
+template<class OBJECT>
+inline constexpr bool IsGridPositionIndexed = std::is_same_v<OBJECT, Creature> || std::is_same_v<OBJECT, Player>;
+
+struct GridPositionIndexNone { };
+
+/// Positions of all units linked to a single cell container, stored as dense arrays
+/// so that range searches can reject most units without touching them
+class TC_GAME_API GridPositionIndex
+{
+public:
+    GridPositionIndex();
+    ~GridPositionIndex();
+
+    GridPositionIndex(GridPositionIndex const&) = delete;
+    GridPositionIndex(GridPositionIndex&&) = delete;
+    GridPositionIndex& operator=(GridPositionIndex const&) = delete;
+    GridPositionIndex& operator=(GridPositionIndex&&) = delete;
+
+    void Insert(Unit* unit);
+    void Remove(Unit* unit);
+
+    void Relocate(uint32 slot, float x, float y, float z)
+    {
+        _x[slot] = x;
+        _y[slot] = y;
+        _z[slot] = z;
+        ++_version;
+    }
+
+    void SetCombatReach(uint32 slot, float combatReach)
+    {
+        _combatReach[slot] = combatReach;
+        ++_version;
+    }
+
+    std::size_t size() const { return _units.size(); }
+
+    /// Changes every time a unit is added, removed or moved, starting value is unique per container
+    /// so that version sums taken over several cells also change when one of those cells is reloaded
+    uint64 GetVersion() const { return _version; }
+
+    /// Calls worker for every unit whose combat reach touches the cylinder at x, y, z with given radius and half height
+    template<class Worker>
+    void VisitInRange(float x, float y, float z, float radius, float halfHeight, Worker&& worker) const
+    {
+        constexpr std::size_t BlockSize = 64;
+        Unit* candidates[BlockSize];
+        for (std::size_t blockStart = 0; blockStart < _units.size(); blockStart += BlockSize)
+        {
+            std::size_t blockEnd = std::min(blockStart + BlockSize, _units.size());
+            std::size_t candidateCount = 0;
+
+            // branchless so that the distance tests can be vectorized
+            for (std::size_t i = blockStart; i < blockEnd; ++i)
+            {
+                float dx = _x[i] - x;
+                float dy = _y[i] - y;
+                float dz = _z[i] - z;
+                float dist = radius + _combatReach[i];
+                candidates[candidateCount] = _units[i];
+                candidateCount += (dx * dx + dy * dy <= dist * dist) & (dz * dz <= halfHeight * halfHeight);
+            }
+
+            // the whole block is tested before worker gets to change any positions
+            for (std::size_t i = 0; i < candidateCount; ++i)
+                worker(candidates[i]);
+        }
+    }
+
+private:
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _z;
+    std::vector<float> _combatReach;
+    std::vector<Unit*> _units;
+    uint64 _version;
+};
+
+#endif // TRINITY_GRID_POSITION_INDEX_H
@@ -18,6 +18,9 @@
 #ifndef _GRIDREFMANAGER
 #define _GRIDREFMANAGER
 
+#include "GridDenseContainer.h"
+#include "GridOccupancy.h"
+#include "GridPositionIndex.h"
 #include "RefManager.h"
 
 template<class OBJECT>
@@ -34,5 +37,21 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
 
         iterator begin() { return iterator(getFirst()); }
         iterator end() { return iterator(nullptr); }
+
+        // only containers of units have positions indexed, see GridObject
+        using PositionIndex = std::conditional_t<IsGridPositionIndexed<OBJECT>, GridPositionIndex, GridPositionIndexNone>;
+        PositionIndex& GetPositionIndex() { return _positionIndex; }
+
+        // same objects as the list, prefer it for visits of every object
+        GridDenseContainer<OBJECT>& GetDenseContainer() { return _denseContainer; }
+
+        // occupancy of the cell this container belongs to, see Grid
+        GridOccupancy* GetOccupancy() { return _occupancy; }
+        void SetOccupancy(GridOccupancy* occupancy) { _occupancy = occupancy; }
+
+    private:
+        PositionIndex _positionIndex;
+        GridDenseContainer<OBJECT> _denseContainer;
+        GridOccupancy* _occupancy = nullptr;
 };
 #endif
@@ -73,7 +73,11 @@ class NGrid
         NGrid(uint32 id, int32 x, int32 y, time_t expiry, bool unload = true) :
             i_gridId(id), i_GridInfo(GridInfo(expiry, unload)), i_x(x), i_y(y),
             i_cellstate(GRID_STATE_INVALID), i_GridObjectDataLoaded(false)
-        { }
+        {
+            for (uint32 x = 0; x < N; ++x)
+                for (uint32 y = 0; y < N; ++y)
+                    i_cells[x][y].GetOccupancy().SetParent(&i_occupancy);
+        }
 
         GridType& GetGridType(const uint32 x, const uint32 y)
         {
@@ -101,6 +105,9 @@ class NGrid
         void setGridObjectDataLoaded(bool pLoaded) { i_GridObjectDataLoaded = pLoaded; }
 
         GridInfo* getGridInfoRef() { return &i_GridInfo; }
+
+        // object types with at least one object in any of the cells
+        GridOccupancy const& GetOccupancy() const { return i_occupancy; }
         TimeTracker const& getTimeTracker() const { return i_GridInfo.getTimeTracker(); }
         bool getUnloadLock() const { return i_GridInfo.getUnloadLock(); }
         void setUnloadExplicitLock(bool on) { i_GridInfo.setUnloadExplicitLock(on); }
@@ -178,6 +185,7 @@ class NGrid
         int32 i_y;
         grid_state_t i_cellstate;
         GridType i_cells[N][N];
+        GridOccupancy i_occupancy;
         bool i_GridObjectDataLoaded;
 };
 #endif
@@ -20,9 +20,12 @@
 #include "CreatureAI.h"
 #include "GridNotifiersImpl.h"
 #include "ObjectAccessor.h"
+#include "Pet.h"
 #include "Transport.h"
 #include "UpdateData.h"
+#include "World.h"
 #include "WorldPacket.h"
+#include "WorldSocket.h"
 
 using namespace Trinity;
 
@@ -41,21 +44,26 @@ void VisibleNotifier::SendToSelf()
                 switch ((*itr)->GetTypeId())
                 {
                     case TYPEID_GAMEOBJECT:
-                        i_player.UpdateVisibilityOf((*itr)->ToGameObject(), i_data, i_visibleNow);
+                        i_player.UpdateVisibilityOf((*itr)->ToGameObject(), i_data, i_visibleNow, i_deferred);
                         break;
                     case TYPEID_PLAYER:
-                        i_player.UpdateVisibilityOf((*itr)->ToPlayer(), i_data, i_visibleNow);
+                        i_player.UpdateVisibilityOf((*itr)->ToPlayer(), i_data, i_visibleNow, i_deferred);
                         if (!(*itr)->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-                            (*itr)->ToPlayer()->UpdateVisibilityOf(&i_player);
+                        {
+                            if (i_deferred)
+                                i_deferred->VisibilityUpdates.emplace_back((*itr)->ToPlayer(), &i_player);
+                            else
+                                (*itr)->ToPlayer()->UpdateVisibilityOf(&i_player);
+                        }
                         break;
                     case TYPEID_UNIT:
-                        i_player.UpdateVisibilityOf((*itr)->ToCreature(), i_data, i_visibleNow);
+                        i_player.UpdateVisibilityOf((*itr)->ToCreature(), i_data, i_visibleNow, i_deferred);
                         break;
                     case TYPEID_DYNAMICOBJECT:
-                        i_player.UpdateVisibilityOf((*itr)->ToDynObject(), i_data, i_visibleNow);
+                        i_player.UpdateVisibilityOf((*itr)->ToDynObject(), i_data, i_visibleNow, i_deferred);
                         break;
                     case TYPEID_AREATRIGGER:
-                        i_player.UpdateVisibilityOf((*itr)->ToAreaTrigger(), i_data, i_visibleNow);
+                        i_player.UpdateVisibilityOf((*itr)->ToAreaTrigger(), i_data, i_visibleNow, i_deferred);
                         break;
                     default:
                         break;
@@ -64,6 +72,9 @@ void VisibleNotifier::SendToSelf()
         }
     }
 
+    if (!i_newVisible.empty())
+        i_player.AddVisibleObjects(i_newVisible, i_data, i_visibleNow);
+
     for (auto it = vis_guids.begin(); it != vis_guids.end(); ++it)
     {
         i_player.m_clientGUIDs.erase(*it);
@@ -71,18 +82,25 @@ void VisibleNotifier::SendToSelf()
 
         if (it->IsPlayer())
         {
+            // player is no longer near, it can be anywhere on the map
             Player* player = ObjectAccessor::FindPlayer(*it);
             if (player && !player->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-                player->UpdateVisibilityOf(&i_player);
+            {
+                if (i_deferred)
+                    i_deferred->VisibilityUpdates.emplace_back(player, &i_player);
+                else
+                    player->UpdateVisibilityOf(&i_player);
+            }
         }
     }
 
-    if (!i_data.HasData())
-        return;
-
-    WorldPacket packet;
-    i_data.BuildPacket(&packet);
-    i_player.SendDirectMessage(&packet);
+    // creates may already have been sent in several packets
+    if (i_data.HasData())
+    {
+        WorldPacket packet;
+        i_data.BuildPacket(&packet);
+        i_player.SendDirectMessage(&packet);
+    }
 
     for (std::set<Unit*>::const_iterator it = i_visibleNow.begin(); it != i_visibleNow.end(); ++it)
         i_player.SendInitialVisiblePackets(*it);
@@ -119,66 +137,139 @@ void VisibleChangesNotifier::Visit(DynamicObjectMapType &m)
                     player->UpdateVisibilityOf(i_objects);
 }
 
+void PacketSenderRef::operator()(Player const* player) const
+{
+    if (!HasReceiver)
+    {
+        HasReceiver = true;
+        player->SendDirectMessage(Data);
+        return;
+    }
+
+    if (!SharedData)
+        SharedData = std::make_shared<SharedWorldPacket>(*Data);
+
+    player->SendDirectMessage(SharedData);
+}
+
 inline void CreatureUnitRelocationWorker(Creature* c, Unit* u)
 {
     if (!u->IsAlive() || !c->IsAlive() || c == u || u->IsInFlight())
         return;
 
-    if (!c->HasUnitState(UNIT_STATE_SIGHTLESS))
+    if (c->HasUnitState(UNIT_STATE_SIGHTLESS) || !c->IsAIEnabled())
+        return;
+
+    // creatures whose AI can't react still notice stealthed players they can't see yet
+    bool reactive = c->AI()->IsLineOfSightReactive();
+    bool stealthed = u->GetTypeId() == TYPEID_PLAYER && u->HasStealthAura();
+    if (!reactive && !stealthed)
+        return;
+
+    if (c->CanSeeOrDetect(u, false, true))
     {
-        if (c->IsAIEnabled() && c->CanSeeOrDetect(u, false, true))
+        if (reactive)
             c->AI()->MoveInLineOfSight_Safe(u);
-        else
-            if (u->GetTypeId() == TYPEID_PLAYER && u->HasStealthAura() && c->IsAIEnabled() && c->CanSeeOrDetect(u, false, true, true))
-                c->AI()->TriggerAlert(u);
     }
+    else if (stealthed && c->CanSeeOrDetect(u, false, true, true))
+        c->AI()->TriggerAlert(u);
+}
+
+inline void CreatureUnitRelocationWorker(Creature* c, Unit* u, RelocationDeferredActions* deferred)
+{
+    // AI reactions can affect anything on the map, never run them while regions are processed in parallel
+    if (deferred)
+        deferred->AIRelocations.emplace_back(c, u);
+    else
+        CreatureUnitRelocationWorker(c, u);
 }
 
 void PlayerRelocationNotifier::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    m.GetDenseContainer().ForEach([&](Player* player)
     {
-        Player* player = iter->GetSource();
-
         vis_guids.erase(player->GetGUID());
 
-        i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
+        i_player.UpdateVisibilityOf(player, i_data, i_visibleNow, i_deferred);
 
         if (player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            continue;
+            return;
 
         player->UpdateVisibilityOf(&i_player);
-    }
+    });
 }
 
 void PlayerRelocationNotifier::Visit(CreatureMapType &m)
 {
     bool relocated_for_ai = (&i_player == i_player.m_seer);
 
-    for (CreatureMapType::iterator iter=m.begin(); iter != m.end(); ++iter)
+    m.GetDenseContainer().ForEach([&](Creature* c)
     {
-        Creature* c = iter->GetSource();
-
         vis_guids.erase(c->GetGUID());
 
-        i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
+        if (KeepsVisibilityOf(c))
+            return;
+
+        UpdateVisibilityOf(c);
 
         if (relocated_for_ai && !c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            CreatureUnitRelocationWorker(c, &i_player);
+            CreatureUnitRelocationWorker(c, &i_player, i_deferred);
+    });
+}
+
+static bool IsCellInsideCircle(float cellMinX, float cellMinY, Position const& center, float radiusSq)
+{
+    float dx = std::max(std::abs(cellMinX - center.GetPositionX()), std::abs(cellMinX + SIZE_OF_GRID_CELL - center.GetPositionX()));
+    float dy = std::max(std::abs(cellMinY - center.GetPositionY()), std::abs(cellMinY + SIZE_OF_GRID_CELL - center.GetPositionY()));
+    return dx * dx + dy * dy <= radiusSq;
+}
+
+void PlayerRelocationNotifier::VisitChangedCells(Position const& previousCenter, float radius, float nearDistance, bool dontLoad)
+{
+    TypeContainerVisitor<PlayerRelocationNotifier, WorldTypeMapContainer> worldVisitor(*this);
+    TypeContainerVisitor<PlayerRelocationNotifier, GridTypeMapContainer> gridVisitor(*this);
+    Map& map = *i_player.GetMap();
+
+    // same cells as Cell::VisitAllObjects, the square area minus its corners outside of the search circle
+    float visitRadius = std::min(radius + i_player.GetCombatReach(), SIZE_OF_GRIDS);
+    CellArea area = Cell::CalculateCellArea(i_player.GetPositionX(), i_player.GetPositionY(), visitRadius);
+    float radiusSq = radius * radius;
+    i_nearDistSq = nearDistance * nearDistance;
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            CellCoord cellCoord(x, y);
+            if (!Cell::IsCellInRadius(cellCoord, i_player.GetPositionX(), i_player.GetPositionY(), visitRadius))
+                continue;
+
+            Cell cell(cellCoord);
+            if (dontLoad)
+                cell.SetNoCreate();
+
+            float cellMinX = (float(x) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+            float cellMinY = (float(y) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+            bool stayedInRange = IsCellInsideCircle(cellMinX, cellMinY, i_player, radiusSq) && IsCellInsideCircle(cellMinX, cellMinY, previousCenter, radiusSq);
+
+            i_previousCenter = stayedInRange ? &previousCenter : nullptr;
+            map.Visit(cell, worldVisitor);
+            map.Visit(cell, gridVisitor);
+        }
     }
+
+    i_previousCenter = nullptr;
 }
 
 void CreatureRelocationNotifier::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    m.GetDenseContainer().ForEach([&](Player* player)
     {
-        Player* player = iter->GetSource();
-
         if (!player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
             player->UpdateVisibilityOf(&i_creature);
 
-        CreatureUnitRelocationWorker(&i_creature, player);
-    }
+        CreatureUnitRelocationWorker(&i_creature, player, i_deferred);
+    });
 }
 
 void CreatureRelocationNotifier::Visit(CreatureMapType &m)
@@ -186,51 +277,88 @@ void CreatureRelocationNotifier::Visit(CreatureMapType &m)
     if (!i_creature.IsAlive())
         return;
 
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    m.GetDenseContainer().ForEach([&](Creature* c)
     {
-        Creature* c = iter->GetSource();
-        CreatureUnitRelocationWorker(&i_creature, c);
+        CreatureUnitRelocationWorker(&i_creature, c, i_deferred);
 
         if (!c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            CreatureUnitRelocationWorker(c, &i_creature);
-    }
+            CreatureUnitRelocationWorker(c, &i_creature, i_deferred);
+    });
 }
 
 void DelayedUnitRelocation::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    m.GetDenseContainer().ForEach([&](Creature* unit)
     {
-        Creature* unit = iter->GetSource();
         if (!unit->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            continue;
+            return;
 
-        CreatureRelocationNotifier relocate(*unit);
+        CreatureRelocationNotifier relocate(*unit, i_deferred);
 
         TypeContainerVisitor<CreatureRelocationNotifier, WorldTypeMapContainer > c2world_relocation(relocate);
         TypeContainerVisitor<CreatureRelocationNotifier, GridTypeMapContainer >  c2grid_relocation(relocate);
 
         cell.Visit(p, c2world_relocation, i_map, *unit, i_radius);
         cell.Visit(p, c2grid_relocation, i_map, *unit, i_radius);
-    }
+    });
 }
 
 void DelayedUnitRelocation::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    m.GetDenseContainer().ForEach([&](Player* player)
     {
-        Player* player = iter->GetSource();
         WorldObject const* viewPoint = player->m_seer;
 
         if (!viewPoint->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            continue;
+            return;
 
         if (player != viewPoint && !viewPoint->IsPositionValid())
-            continue;
+            return;
+
+        // viewpoint can be in a different region than the player
+        if (i_deferred && player != viewPoint)
+        {
+            i_deferred->Players.push_back(player);
+            return;
+        }
+
+        // grids must not be loaded while other regions are being processed
+        PlayerRelocationNotifier relocate(*player, i_deferred);
+        if (Position const* previousCenter = player->GetIncrementalVisibilityCenter(i_radius))
+            relocate.VisitChangedCells(*previousCenter, i_radius, sWorld->getFloatConfig(CONFIG_VISIBILITY_INCREMENTAL_NEAR_DISTANCE), i_deferred != nullptr);
+        else
+            Cell::VisitAllObjects(viewPoint, relocate, i_radius, i_deferred != nullptr);
+        relocate.SendToSelf();
+        player->SetVisibilityUpdated(i_radius);
+    });
+}
 
+void RelocationDeferredActions::Execute(float radius)
+{
+    for (Player* player : Players)
+    {
         PlayerRelocationNotifier relocate(*player);
-        Cell::VisitAllObjects(viewPoint, relocate, i_radius, false);
+        Cell::VisitAllObjects(player->m_seer, relocate, radius, false);
         relocate.SendToSelf();
+        player->SetVisibilityUpdated(radius);
     }
+
+    for (auto const& [player, object] : VisibilityUpdates)
+        player->UpdateVisibilityOf(object);
+
+    for (auto const& [creature, unit] : AIRelocations)
+        CreatureUnitRelocationWorker(creature, unit);
+
+    // the pet may have been removed or come back into sight by the actions above
+    for (Player* player : PetRemovals)
+        if (Pet* pet = player->GetPet())
+            if (!player->HaveAtClient(pet))
+                pet->Remove(PET_SAVE_NOT_IN_SLOT, true);
+
+    Players.clear();
+    VisibilityUpdates.clear();
+    AIRelocations.clear();
+    PetRemovals.clear();
 }
 
 void AIRelocationNotifier::Visit(CreatureMapType &m)
@@ -258,9 +386,36 @@ MessageDistDeliverer::VisitObject(Player* player)
 template<class T>
 void ObjectUpdater::Visit(GridRefManager<T> &m)
 {
-    for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->GetSource()->IsInWorld())
-            iter->GetSource()->Update(i_timeDiff);
+    m.GetDenseContainer().ForEach([&](T* obj)
+    {
+        if (obj->IsInWorld())
+            obj->Update(i_timeDiff);
+    });
+}
+
+void ObjectUpdater::Visit(CreatureMapType &m)
+{
+    m.GetDenseContainer().ForEach([&](Creature* creature)
+    {
+        if (!creature->IsInWorld())
+            return;
+
+        if (i_lodMap && creature->CanHaveReducedUpdateRate()
+            && !i_lodMap->IsCellNearPlayers(Trinity::ComputeCellCoord(creature->GetPositionX(), creature->GetPositionY()).GetId())
+            && creature->DeferUpdate(i_timeDiff, i_lodTicks))
+            return;
+
+        // also flushes time of skipped updates when a throttled creature gets close to players again
+        if (!i_profile)
+        {
+            creature->Update(i_timeDiff + creature->ConsumeDeferredUpdateDiff());
+            return;
+        }
+
+        TimePoint start = std::chrono::steady_clock::now();
+        creature->Update(i_timeDiff + creature->ConsumeDeferredUpdateDiff());
+        i_profile->AddCreatureUpdate(creature, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start));
+    });
 }
 
 bool AnyDeadUnitObjectInRangeCheck::operator()(Player* u)
@@ -293,7 +448,6 @@ bool AnyDeadUnitSpellTargetInRangeCheck::operator()(Creature* u)
     return AnyDeadUnitObjectInRangeCheck::operator()(u) && WorldObjectSpellTargetCheck::operator()(u);
 }
 
-template void ObjectUpdater::Visit<Creature>(CreatureMapType&);
 template void ObjectUpdater::Visit<GameObject>(GameObjectMapType&);
 template void ObjectUpdater::Visit<DynamicObject>(DynamicObjectMapType&);
 template void ObjectUpdater::Visit<AreaTrigger>(AreaTriggerMapType &);
@@ -24,6 +24,7 @@
 #include "Conversation.h"
 #include "DynamicObject.h"
 #include "GameObject.h"
+#include "MapUpdateProfiler.h"
 #include "Player.h"
 #include "SceneObject.h"
 #include "Spell.h"
@@ -33,16 +34,40 @@
 
 namespace Trinity
 {
+    // Side effects of relocation notifiers that may reach outside of the map region being processed
+    // Collected while regions are processed in parallel and executed serially afterwards
+    struct TC_GAME_API RelocationDeferredActions
+    {
+        std::vector<std::pair<Creature*, Unit*>> AIRelocations;             // CreatureUnitRelocationWorker(first, second)
+        std::vector<std::pair<Player*, WorldObject*>> VisibilityUpdates;    // first->UpdateVisibilityOf(second)
+        std::vector<Player*> Players;                                       // players with viewpoint away from their own position
+        std::vector<Player*> PetRemovals;                                   // players whose pet went out of their sight
+
+        void Execute(float radius);
+    };
+
     struct TC_GAME_API VisibleNotifier
     {
         Player &i_player;
         UpdateData i_data;
         std::set<Unit*> i_visibleNow;
-        GuidUnorderedSet vis_guids;
-
-        VisibleNotifier(Player &player) : i_player(player), i_data(player.GetMapId()), vis_guids(player.m_clientGUIDs) { }
+        std::vector<WorldObject*> i_newVisible;
+        GuidFlatSet vis_guids;
+        RelocationDeferredActions* i_deferred;
+        Position const* i_previousCenter;   // set while visiting a cell that stayed in range since the last update
+        float i_nearDistSq;
+
+        VisibleNotifier(Player &player, RelocationDeferredActions* deferred = nullptr) : i_player(player), i_data(player.GetMapId()), vis_guids(player.m_clientGUIDs), i_deferred(deferred),
+            i_previousCenter(nullptr), i_nearDistSq(0.0f) { }
         template<class T> void Visit(GridRefManager<T> &m);
+        template<class T> void UpdateVisibilityOf(T* obj);
         void SendToSelf(void);
+
+        // far objects in cells that stayed in range can't change their visibility by player movement alone
+        bool KeepsVisibilityOf(WorldObject const* obj) const
+        {
+            return i_previousCenter && obj->GetExactDist2dSq(&i_player) > i_nearDistSq && obj->GetExactDist2dSq(i_previousCenter) > i_nearDistSq;
+        }
     };
 
     struct VisibleChangesNotifier
@@ -51,6 +76,7 @@ namespace Trinity
 
         explicit VisibleChangesNotifier(IteratorPair<WorldObject**> objects) : i_objects(objects) { }
         template<class T> void Visit(GridRefManager<T> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_DYNAMICOBJECT; }
         void Visit(PlayerMapType &);
         void Visit(CreatureMapType &);
         void Visit(DynamicObjectMapType &);
@@ -58,18 +84,23 @@ namespace Trinity
 
     struct TC_GAME_API PlayerRelocationNotifier : public VisibleNotifier
     {
-        PlayerRelocationNotifier(Player &player) : VisibleNotifier(player) { }
+        PlayerRelocationNotifier(Player &player, RelocationDeferredActions* deferred = nullptr) : VisibleNotifier(player, deferred) { }
 
         template<class T> void Visit(GridRefManager<T> &m) { VisibleNotifier::Visit(m); }
         void Visit(CreatureMapType &);
         void Visit(PlayerMapType &);
+
+        // only checks objects again that could have changed visibility since the update at previousCenter with the same radius
+        void VisitChangedCells(Position const& previousCenter, float radius, float nearDistance, bool dontLoad);
     };
 
     struct TC_GAME_API CreatureRelocationNotifier
     {
         Creature &i_creature;
-        CreatureRelocationNotifier(Creature &c) : i_creature(c) { }
+        RelocationDeferredActions* i_deferred;
+        CreatureRelocationNotifier(Creature &c, RelocationDeferredActions* deferred = nullptr) : i_creature(c), i_deferred(deferred) { }
         template<class T> void Visit(GridRefManager<T> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE; }
         void Visit(CreatureMapType &);
         void Visit(PlayerMapType &);
     };
@@ -80,8 +111,9 @@ namespace Trinity
         Cell &cell;
         CellCoord &p;
         const float i_radius;
-        DelayedUnitRelocation(Cell &c, CellCoord &pair, Map &map, float radius) :
-            i_map(map), cell(c), p(pair), i_radius(radius) { }
+        RelocationDeferredActions* i_deferred;
+        DelayedUnitRelocation(Cell &c, CellCoord &pair, Map &map, float radius, RelocationDeferredActions* deferred = nullptr) :
+            i_map(map), cell(c), p(pair), i_radius(radius), i_deferred(deferred) { }
         template<class T> void Visit(GridRefManager<T> &) { }
         void Visit(CreatureMapType &);
         void Visit(PlayerMapType   &);
@@ -93,6 +125,7 @@ namespace Trinity
         bool isCreature;
         explicit AIRelocationNotifier(Unit &unit) : i_unit(unit), isCreature(unit.GetTypeId() == TYPEID_UNIT)  { }
         template<class T> void Visit(GridRefManager<T> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_CREATURE; }
         void Visit(CreatureMapType &);
     };
 
@@ -118,26 +151,27 @@ namespace Trinity
         void Visit(ConversationMapType &m) { updateObjects<Conversation>(m); }
     };
 
-    struct PacketSenderRef
+    struct TC_GAME_API PacketSenderRef
     {
         WorldPacket const* Data;
+        mutable std::shared_ptr<SharedWorldPacket const> SharedData;    // serialized once when there is more than one receiver
+        mutable bool HasReceiver;
 
-        PacketSenderRef(WorldPacket const* message) : Data(message) { }
+        PacketSenderRef(WorldPacket const* message) : Data(message), HasReceiver(false) { }
 
-        void operator()(Player const* player) const
-        {
-            player->SendDirectMessage(Data);
-        }
+        void operator()(Player const* player) const;
     };
 
     template<typename Packet>
     struct PacketSenderOwning
     {
         Packet Data;
+        mutable PacketSenderRef Sender = { nullptr };   // shares the serialized packet between receivers
 
         void operator()(Player const* player) const
         {
-            player->SendDirectMessage(Data.GetRawPacket());
+            Sender.Data = Data.GetRawPacket();
+            Sender(player);
         }
     };
 
@@ -166,6 +200,7 @@ namespace Trinity
         void Visit(CreatureMapType &m) const;
         void Visit(DynamicObjectMapType &m) const;
         template<class SKIP> void Visit(GridRefManager<SKIP> &) const { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_DYNAMICOBJECT; }
 
         void SendPacket(Player const* player) const
         {
@@ -197,6 +232,7 @@ namespace Trinity
         void Visit(CreatureMapType &m) const;
         void Visit(DynamicObjectMapType &m) const;
         template<class SKIP> void Visit(GridRefManager<SKIP> &) const { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_DYNAMICOBJECT; }
 
         void SendPacket(Player const* player) const
         {
@@ -211,8 +247,13 @@ namespace Trinity
     struct ObjectUpdater
     {
         uint32 i_timeDiff;
-        explicit ObjectUpdater(const uint32 diff) : i_timeDiff(diff) { }
+        Map const* i_lodMap;        // creatures outside of cells near players on this map are throttled
+        uint32 i_lodTicks;
+        MapUpdateProfiler::Update* i_profile;   // times each creature update when the map is being profiled
+        explicit ObjectUpdater(const uint32 diff, Map const* lodMap = nullptr, uint32 lodTicks = 1, MapUpdateProfiler::Update* profile = nullptr)
+            : i_timeDiff(diff), i_lodMap(lodMap), i_lodTicks(lodTicks), i_profile(profile) { }
         template<class T> void Visit(GridRefManager<T> &m);
+        void Visit(CreatureMapType &m);
         void Visit(PlayerMapType &) { }
         void Visit(CorpseMapType &) { }
     };
@@ -268,6 +309,7 @@ namespace Trinity
         void Visit(ConversationMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return i_mapTypeMask; }
     };
 
     template<class Check>
@@ -291,6 +333,15 @@ namespace Trinity
         void Visit(ConversationMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return i_mapTypeMask; }
+    };
+
+    // Cylinder containing every unit that can pass a check, units outside of it are skipped using the cell position index
+    struct UnitSearchArea
+    {
+        Position Center;
+        float Radius;       // combat reach of each unit is added
+        float HalfHeight;
     };
 
     template<class Check>
@@ -299,12 +350,15 @@ namespace Trinity
         uint32 i_mapTypeMask;
         PhaseShift const* i_phaseShift;
         Check& i_check;
+        Optional<UnitSearchArea> i_unitSearchArea;
 
         template<typename Container>
         WorldObjectListSearcher(WorldObject const* searcher, Container& container, Check & check, uint32 mapTypeMask = GRID_MAP_TYPE_MASK_ALL)
             : ContainerInserter<WorldObject*>(container),
               i_mapTypeMask(mapTypeMask), i_phaseShift(&searcher->GetPhaseShift()), i_check(check) { }
 
+        void SetUnitSearchArea(Position const& center, float radius, float halfHeight) { i_unitSearchArea.emplace(UnitSearchArea{ center, radius, halfHeight }); }
+
         void Visit(PlayerMapType &m);
         void Visit(CreatureMapType &m);
         void Visit(CorpseMapType &m);
@@ -315,6 +369,7 @@ namespace Trinity
         void Visit(ConversationMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return i_mapTypeMask; }
     };
 
     template<class Do>
@@ -399,6 +454,7 @@ namespace Trinity
         }
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return i_mapTypeMask; }
     };
 
     // Gameobject searchers
@@ -416,6 +472,7 @@ namespace Trinity
         void Visit(GameObjectMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_GAMEOBJECT; }
     };
 
     // Last accepted by Check GO if any (Check can change requirements at each call)
@@ -432,6 +489,7 @@ namespace Trinity
         void Visit(GameObjectMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_GAMEOBJECT; }
     };
 
     template<class Check>
@@ -448,6 +506,7 @@ namespace Trinity
         void Visit(GameObjectMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_GAMEOBJECT; }
     };
 
     template<class Functor>
@@ -464,6 +523,7 @@ namespace Trinity
         }
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_GAMEOBJECT; }
 
     private:
         Functor& _func;
@@ -487,6 +547,7 @@ namespace Trinity
         void Visit(PlayerMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE; }
     };
 
     // Last accepted by Check Unit if any (Check can change requirements at each call)
@@ -504,6 +565,7 @@ namespace Trinity
         void Visit(PlayerMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE; }
     };
 
     // All accepted by Check units if any
@@ -512,16 +574,20 @@ namespace Trinity
     {
         PhaseShift const* i_phaseShift;
         Check& i_check;
+        Optional<UnitSearchArea> i_unitSearchArea;
 
         template<typename Container>
         UnitListSearcher(WorldObject const* searcher, Container& container, Check& check)
             : ContainerInserter<Unit*>(container),
                 i_phaseShift(&searcher->GetPhaseShift()), i_check(check) { }
 
+        void SetUnitSearchArea(Position const& center, float radius, float halfHeight) { i_unitSearchArea.emplace(UnitSearchArea{ center, radius, halfHeight }); }
+
         void Visit(PlayerMapType &m);
         void Visit(CreatureMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE; }
     };
 
     // Creature searchers
@@ -539,6 +605,7 @@ namespace Trinity
         void Visit(CreatureMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_CREATURE; }
     };
 
     // Last accepted by Check Creature if any (Check can change requirements at each call)
@@ -555,6 +622,7 @@ namespace Trinity
         void Visit(CreatureMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_CREATURE; }
     };
 
     template<class Check>
@@ -571,6 +639,7 @@ namespace Trinity
         void Visit(CreatureMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_CREATURE; }
     };
 
     template<class Do>
@@ -590,6 +659,7 @@ namespace Trinity
         }
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_CREATURE; }
     };
 
     // Player searchers
@@ -607,6 +677,7 @@ namespace Trinity
         void Visit(PlayerMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER; }
     };
 
     template<class Check>
@@ -628,6 +699,7 @@ namespace Trinity
         void Visit(PlayerMapType &m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER; }
     };
 
     template<class Check>
@@ -644,6 +716,7 @@ namespace Trinity
         void Visit(PlayerMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER; }
     };
 
     template<class Do>
@@ -663,6 +736,7 @@ namespace Trinity
         }
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER; }
     };
 
     template<class Do>
@@ -683,6 +757,7 @@ namespace Trinity
         }
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) { }
+        uint32 GetVisitedGridMapTypes() const { return GRID_MAP_TYPE_MASK_PLAYER; }
     };
 
     // CHECKS && DO classes
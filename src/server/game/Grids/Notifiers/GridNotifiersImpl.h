@@ -27,11 +27,22 @@
 template<class T>
 inline void Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
 {
-    for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    m.GetDenseContainer().ForEach([&](T* obj)
     {
-        vis_guids.erase(iter->GetSource()->GetGUID());
-        i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
-    }
+        vis_guids.erase(obj->GetGUID());
+        if (!KeepsVisibilityOf(obj))
+            UpdateVisibilityOf(obj);
+    });
+}
+
+// objects becoming visible are gathered and created together in SendToSelf
+template<class T>
+inline void Trinity::VisibleNotifier::UpdateVisibilityOf(T* obj)
+{
+    if (i_player.HaveAtClient(obj))
+        i_player.UpdateVisibilityOf(obj, i_data, i_visibleNow, i_deferred);
+    else if (i_player.CanSeeOrDetect(obj, false, true))
+        i_newVisible.push_back(obj);
 }
 
 template<typename PacketSender>
@@ -498,6 +509,17 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(PlayerMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
         return;
 
+    if (i_unitSearchArea)
+    {
+        m.GetPositionIndex().VisitInRange(i_unitSearchArea->Center.GetPositionX(), i_unitSearchArea->Center.GetPositionY(), i_unitSearchArea->Center.GetPositionZ(),
+            i_unitSearchArea->Radius, i_unitSearchArea->HalfHeight, [this](Unit* unit)
+        {
+            if (i_check(static_cast<Player*>(unit)))
+                Insert(static_cast<Player*>(unit));
+        });
+        return;
+    }
+
     for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
         if (i_check(itr->GetSource()))
             Insert(itr->GetSource());
@@ -509,6 +531,17 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(CreatureMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
         return;
 
+    if (i_unitSearchArea)
+    {
+        m.GetPositionIndex().VisitInRange(i_unitSearchArea->Center.GetPositionX(), i_unitSearchArea->Center.GetPositionY(), i_unitSearchArea->Center.GetPositionZ(),
+            i_unitSearchArea->Radius, i_unitSearchArea->HalfHeight, [this](Unit* unit)
+        {
+            if (i_check(static_cast<Creature*>(unit)))
+                Insert(static_cast<Creature*>(unit));
+        });
+        return;
+    }
+
     for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
         if (i_check(itr->GetSource()))
             Insert(itr->GetSource());
@@ -695,6 +728,18 @@ void Trinity::UnitLastSearcher<Check>::Visit(PlayerMapType &m)
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(PlayerMapType &m)
 {
+    if (i_unitSearchArea)
+    {
+        m.GetPositionIndex().VisitInRange(i_unitSearchArea->Center.GetPositionX(), i_unitSearchArea->Center.GetPositionY(), i_unitSearchArea->Center.GetPositionZ(),
+            i_unitSearchArea->Radius, i_unitSearchArea->HalfHeight, [this](Unit* unit)
+        {
+            if (unit->InSamePhase(*i_phaseShift))
+                if (i_check(static_cast<Player*>(unit)))
+                    Insert(static_cast<Player*>(unit));
+        });
+        return;
+    }
+
     for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(*i_phaseShift))
             if (i_check(itr->GetSource()))
@@ -704,6 +749,18 @@ void Trinity::UnitListSearcher<Check>::Visit(PlayerMapType &m)
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(CreatureMapType &m)
 {
+    if (i_unitSearchArea)
+    {
+        m.GetPositionIndex().VisitInRange(i_unitSearchArea->Center.GetPositionX(), i_unitSearchArea->Center.GetPositionY(), i_unitSearchArea->Center.GetPositionZ(),
+            i_unitSearchArea->Radius, i_unitSearchArea->HalfHeight, [this](Unit* unit)
+        {
+            if (unit->InSamePhase(*i_phaseShift))
+                if (i_check(static_cast<Creature*>(unit)))
+                    Insert(static_cast<Creature*>(unit));
+        });
+        return;
+    }
+
     for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
         if (itr->GetSource()->InSamePhase(*i_phaseShift))
             if (i_check(itr->GetSource()))
@@ -131,15 +131,15 @@ void LoadHelper(CellGuidSet const& guid_set, CellCoord& cell, GridRefManager<T>&
 void ObjectGridLoader::Visit(GameObjectMapType& m)
 {
     CellCoord cellCoord = i_cell.GetCellCoord();
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetDifficultyID(), cellCoord.GetId());
-    LoadHelper(cell_guids.gameobjects, cellCoord, m, i_gameObjects, i_map);
+    if (i_cellSpawns)
+        LoadHelper(i_cellSpawns->gameobjects, cellCoord, m, i_gameObjects, i_map);
 }
 
 void ObjectGridLoader::Visit(CreatureMapType &m)
 {
     CellCoord cellCoord = i_cell.GetCellCoord();
-    CellObjectGuids const& cell_guids = sObjectMgr->GetCellObjectGuids(i_map->GetId(), i_map->GetDifficultyID(), cellCoord.GetId());
-    LoadHelper(cell_guids.creatures, cellCoord, m, i_creatures, i_map);
+    if (i_cellSpawns)
+        LoadHelper(i_cellSpawns->creatures, cellCoord, m, i_creatures, i_map);
 }
 
 void ObjectGridLoader::Visit(AreaTriggerMapType& m)
@@ -173,12 +173,17 @@ void ObjectGridLoader::LoadN(void)
 {
     i_gameObjects = 0; i_creatures = 0; i_corpses = 0;
     i_cell.data.Part.cell_y = 0;
+
+    // look up the spawn store of the map once per grid, cells without spawns are skipped
+    // and never added to the store (grids of different maps are loaded concurrently)
+    CellObjectGuidsMap const* mapSpawns = sObjectMgr->GetMapObjectGuidsIfExists(i_map->GetId(), i_map->GetDifficultyID());
     for (uint32 x = 0; x < MAX_NUMBER_OF_CELLS; ++x)
     {
         i_cell.data.Part.cell_x = x;
         for (uint32 y = 0; y < MAX_NUMBER_OF_CELLS; ++y)
         {
             i_cell.data.Part.cell_y = y;
+            i_cellSpawns = mapSpawns ? Trinity::Containers::MapGetValuePtr(*mapSpawns, i_cell.GetCellCoord().GetId()) : nullptr;
 
             //Load creatures and game objects
             {
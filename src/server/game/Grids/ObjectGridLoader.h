@@ -23,6 +23,7 @@
 #include "Cell.h"
 
 class MapObject;
+struct CellObjectGuids;
 class ObjectGuid;
 class ObjectWorldLoader;
 
@@ -56,7 +57,7 @@ class TC_GAME_API ObjectGridLoader : public ObjectGridLoaderBase
 
     public:
         ObjectGridLoader(NGridType& grid, Map* map, Cell const& cell)
-            : ObjectGridLoaderBase(grid, map, cell)
+            : ObjectGridLoaderBase(grid, map, cell), i_cellSpawns(nullptr)
             { }
 
         void Visit(GameObjectMapType &m);
@@ -68,6 +69,9 @@ class TC_GAME_API ObjectGridLoader : public ObjectGridLoaderBase
         void Visit(ConversationMapType&) const { }
 
         void LoadN();
+
+    private:
+        CellObjectGuids const* i_cellSpawns;
 };
 
 class TC_GAME_API PersonalPhaseGridLoader : public ObjectGridLoaderBase
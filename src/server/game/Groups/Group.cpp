@@ -923,20 +923,27 @@ void Group::UpdatePlayerOutOfRange(Player* player)
     if (!player || !player->IsInWorld())
         return;
 
-    WorldPackets::Party::PartyMemberFullState packet;
-    packet.Initialize(player);
-    packet.Write();
-
-    Player* member;
+    // members in sight get the changes with object updates, only build the state when someone else needs it
+    std::vector<Player*> recipients;
     for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
-        member = itr->GetSource();
+        Player* member = itr->GetSource();
         if (member && member != player && (!member->IsInMap(player) || !member->IsWithinDist(player, member->GetSightRange(), false)))
-            member->SendDirectMessage(packet.GetRawPacket());
+            recipients.push_back(member);
     }
+
+    if (recipients.empty())
+        return;
+
+    WorldPackets::Party::PartyMemberFullState packet;
+    packet.Initialize(player);
+    packet.Write();
+
+    for (Player* member : recipients)
+        member->SendDirectMessage(packet.GetRawPacket());
 }
 
-void Group::BroadcastAddonMessagePacket(WorldPacket const* packet, const std::string& prefix, bool ignorePlayersInBGRaid, int group /*= -1*/, ObjectGuid ignore /*= ObjectGuid::Empty*/) const
+void Group::BroadcastAddonMessagePacket(WorldPacket const* packet, std::string_view prefix, bool ignorePlayersInBGRaid, int group /*= -1*/, ObjectGuid ignore /*= ObjectGuid::Empty*/) const
 {
     for (GroupReference const* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
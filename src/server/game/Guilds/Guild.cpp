@@ -40,6 +40,7 @@
 #include "SocialMgr.h"
 #include "World.h"
 #include "WorldSession.h"
+#include <unordered_set>
 
 size_t const MAX_GUILD_BANK_TAB_TEXT_LEN = 500;
 
@@ -99,10 +100,42 @@ Entry& Guild::LogHolder<Entry>::AddEvent(CharacterDatabaseTransaction trans, Ts&
     // Add event to list
     Entry& entry = m_log.emplace_back(std::forward<Ts>(args)...);
     // Save to DB
+    if constexpr (!std::is_same_v<Entry, NewsLogEntry>)
+    {
+        if (sWorld->getIntConfig(CONFIG_GUILD_LOG_FLUSH_INTERVAL))
+        {
+            m_pending.push_back(entry);
+            return entry;
+        }
+    }
+
     entry.SaveToDB(trans);
     return entry;
 }
 
+template <typename Entry>
+void Guild::LogHolder<Entry>::FlushToDB(CharacterDatabaseTransaction trans)
+{
+    if (m_pending.empty())
+        return;
+
+    // slots are reused once the log is full, an older queued event in the same slot was already overwritten
+    std::vector<Entry const*> newest;
+    std::unordered_set<uint32> slots;
+    for (auto itr = m_pending.rbegin(); itr != m_pending.rend(); ++itr)
+        if (slots.insert(itr->GetGUID()).second)
+            newest.push_back(&*itr);
+
+    // all deletes go first, consecutive inserts are sent as a single multi row statement
+    for (Entry const* entry : newest)
+        entry->DeleteFromDB(trans);
+
+    for (auto itr = newest.rbegin(); itr != newest.rend(); ++itr)
+        (*itr)->InsertIntoDB(trans);
+
+    m_pending.clear();
+}
+
 template <typename Entry>
 inline uint32 Guild::LogHolder<Entry>::GetNextGUID()
 {
@@ -119,14 +152,23 @@ Guild::LogEntry::LogEntry(ObjectGuid::LowType guildId, uint32 guid) : m_guildId(
 
 // EventLogEntry
 void Guild::EventLogEntry::SaveToDB(CharacterDatabaseTransaction trans) const
+{
+    DeleteFromDB(trans);
+    InsertIntoDB(trans);
+}
+
+void Guild::EventLogEntry::DeleteFromDB(CharacterDatabaseTransaction trans) const
 {
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_EVENTLOG);
     stmt->setUInt64(0, m_guildId);
     stmt->setUInt32(1, m_guid);
     trans->Append(stmt);
+}
 
+void Guild::EventLogEntry::InsertIntoDB(CharacterDatabaseTransaction trans) const
+{
     uint8 index = 0;
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_EVENTLOG);
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_EVENTLOG);
     stmt->setUInt64(  index, m_guildId);
     stmt->setUInt32(++index, m_guid);
     stmt->setUInt8 (++index, uint8(m_eventType));
@@ -153,6 +195,12 @@ void Guild::EventLogEntry::WritePacket(WorldPackets::Guild::GuildEventLogQueryRe
 
 // BankEventLogEntry
 void Guild::BankEventLogEntry::SaveToDB(CharacterDatabaseTransaction trans) const
+{
+    DeleteFromDB(trans);
+    InsertIntoDB(trans);
+}
+
+void Guild::BankEventLogEntry::DeleteFromDB(CharacterDatabaseTransaction trans) const
 {
     uint8 index = 0;
 
@@ -161,9 +209,13 @@ void Guild::BankEventLogEntry::SaveToDB(CharacterDatabaseTransaction trans) cons
     stmt->setUInt32(++index, m_guid);
     stmt->setUInt8 (++index, m_bankTabId);
     trans->Append(stmt);
+}
+
+void Guild::BankEventLogEntry::InsertIntoDB(CharacterDatabaseTransaction trans) const
+{
+    uint8 index = 0;
 
-    index = 0;
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_BANK_EVENTLOG);
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_BANK_EVENTLOG);
     stmt->setUInt64(  index, m_guildId);
     stmt->setUInt32(++index, m_guid);
     stmt->setUInt8 (++index, m_bankTabId);
@@ -1250,8 +1302,22 @@ void Guild::SaveToDB()
     CharacterDatabase.CommitTransaction(trans);
 }
 
+void Guild::SaveLogsToDB()
+{
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+
+    m_eventLog.FlushToDB(trans);
+    for (LogHolder<BankEventLogEntry>& bankLog : m_bankEventLog)
+        bankLog.FlushToDB(trans);
+
+    if (trans->GetSize())
+        CharacterDatabase.CommitTransaction(trans);
+}
+
 void Guild::UpdateMemberData(Player* player, uint8 dataid, uint32 value)
 {
+    _InvalidateRosterCache();
+
     if (Member* member = GetMember(player->GetGUID()))
     {
         switch (dataid)
@@ -1275,6 +1341,8 @@ void Guild::UpdateMemberData(Player* player, uint8 dataid, uint32 value)
 
 void Guild::OnPlayerStatusChange(Player* player, uint32 flag, bool state)
 {
+    _InvalidateRosterCache();
+
     if (Member* member = GetMember(player->GetGUID()))
     {
         if (state)
@@ -1303,6 +1371,25 @@ bool Guild::SetName(std::string_view name)
 }
 
 void Guild::HandleRoster(WorldSession* session)
+{
+    // rosters of large guilds are requested often and change rarely, officer notes make two variants
+    bool sendOfficerNote = _HasRankRight(session->GetPlayer(), GR_RIGHT_VIEWOFFNOTE);
+    std::unique_ptr<WorldPacket>& roster = m_rosterCache[sendOfficerNote ? 1 : 0];
+    time_t& expireTime = m_rosterCacheExpireTime[sendOfficerNote ? 1 : 0];
+
+    // inactive days of offline members change with time
+    time_t now = GameTime::GetGameTime();
+    if (!roster || expireTime <= now)
+    {
+        roster = std::make_unique<WorldPacket>(_BuildRosterPacket(sendOfficerNote));
+        expireTime = now + GUILD_ROSTER_CACHE_TIME;
+    }
+
+    TC_LOG_DEBUG("guild", "SMSG_GUILD_ROSTER [{}]", session->GetPlayerInfo());
+    session->SendPacket(roster.get());
+}
+
+WorldPacket Guild::_BuildRosterPacket(bool sendOfficerNote) const
 {
     WorldPackets::Guild::GuildRoster roster;
 
@@ -1312,7 +1399,6 @@ void Guild::HandleRoster(WorldSession* session)
 
     roster.MemberData.reserve(m_members.size());
 
-    bool sendOfficerNote = _HasRankRight(session->GetPlayer(), GR_RIGHT_VIEWOFFNOTE);
     for (auto const& [guid, member] : m_members)
     {
         WorldPackets::Guild::GuildRosterMemberData& memberData = roster.MemberData.emplace_back();
@@ -1346,8 +1432,15 @@ void Guild::HandleRoster(WorldSession* session)
     roster.WelcomeText = m_motd;
     roster.InfoText = m_info;
 
-    TC_LOG_DEBUG("guild", "SMSG_GUILD_ROSTER [{}]", session->GetPlayerInfo());
-    session->SendPacket(roster.Write());
+    roster.Write();
+    roster.ShrinkToFit();
+    return roster.Move();
+}
+
+void Guild::_InvalidateRosterCache()
+{
+    for (std::unique_ptr<WorldPacket>& roster : m_rosterCache)
+        roster.reset();
 }
 
 void Guild::SendQueryResponse(WorldSession* session)
@@ -1442,6 +1535,8 @@ void Guild::HandleGetAchievementMembers(WorldSession* session, uint32 achievemen
 
 void Guild::HandleSetMOTD(WorldSession* session, std::string_view motd)
 {
+    _InvalidateRosterCache();
+
     if (m_motd == motd)
         return;
 
@@ -1465,6 +1560,8 @@ void Guild::HandleSetMOTD(WorldSession* session, std::string_view motd)
 
 void Guild::HandleSetInfo(WorldSession* session, std::string_view info)
 {
+    _InvalidateRosterCache();
+
     if (m_info == info)
         return;
 
@@ -1570,6 +1667,8 @@ void Guild::HandleSetBankTabInfo(WorldSession* session, uint8 tabId, std::string
 
 void Guild::HandleSetMemberNote(WorldSession* session, std::string_view note, ObjectGuid guid, bool isPublic)
 {
+    _InvalidateRosterCache();
+
     // Player must have rights to set public/officer note
     if (!_HasRankRight(session->GetPlayer(), isPublic ? GR_RIGHT_EDIT_PUBLIC_NOTE : GR_RIGHT_EOFFNOTE))
         SendCommandResult(session, GUILD_COMMAND_EDIT_PUBLIC_NOTE, ERR_GUILD_PERMISSIONS);
@@ -1807,6 +1906,8 @@ void Guild::HandleRemoveMember(WorldSession* session, ObjectGuid guid)
 
 void Guild::HandleUpdateMemberRank(WorldSession* session, ObjectGuid guid, bool demote)
 {
+    _InvalidateRosterCache();
+
     Player* player = session->GetPlayer();
     GuildCommandType type = demote ? GUILD_COMMAND_DEMOTE_PLAYER : GUILD_COMMAND_PROMOTE_PLAYER;
     // Player must have rights to promote
@@ -2100,6 +2201,8 @@ bool Guild::HandleMemberWithdrawMoney(WorldSession* session, uint64 amount, bool
 
 void Guild::HandleMemberLogout(WorldSession* session)
 {
+    _InvalidateRosterCache();
+
     Player* player = session->GetPlayer();
     if (Member* member = GetMember(player->GetGUID()))
     {
@@ -2263,6 +2366,8 @@ void Guild::SendMoneyInfo(WorldSession* session) const
 
 void Guild::SendLoginInfo(WorldSession* session)
 {
+    _InvalidateRosterCache();
+
     Player* player = session->GetPlayer();
     Member* member = GetMember(player->GetGUID());
     if (!member)
@@ -2306,6 +2411,8 @@ void Guild::SendLoginInfo(WorldSession* session)
 
 void Guild::SendEventAwayChanged(ObjectGuid const& memberGuid, bool afk, bool dnd)
 {
+    _InvalidateRosterCache();
+
     Member* member = GetMember(memberGuid);
     if (!member)
         return;
@@ -2731,6 +2838,8 @@ void Guild::MassInviteToEvent(WorldSession* session, uint32 minLevel, uint32 max
 // Members handling
 bool Guild::AddMember(CharacterDatabaseTransaction trans, ObjectGuid guid, Optional<GuildRankId> rankId /*= {}*/)
 {
+    _InvalidateRosterCache();
+
     Player* player = ObjectAccessor::FindConnectedPlayer(guid);
     // Player cannot be in guild
     if (player)
@@ -2822,6 +2931,8 @@ bool Guild::AddMember(CharacterDatabaseTransaction trans, ObjectGuid guid, Optio
 
 void Guild::DeleteMember(CharacterDatabaseTransaction trans, ObjectGuid guid, bool isDisbanding, bool isKicked, bool canDeleteGuild)
 {
+    _InvalidateRosterCache();
+
     // Guild master can be deleted when loading guild and guid doesn't exist in characters table
     // or when he is removed from guild by gm command
     if (m_leaderGuid == guid && !isDisbanding)
@@ -2879,6 +2990,8 @@ void Guild::DeleteMember(CharacterDatabaseTransaction trans, ObjectGuid guid, bo
 
 bool Guild::ChangeMemberRank(CharacterDatabaseTransaction trans, ObjectGuid guid, GuildRankId newRank)
 {
+    _InvalidateRosterCache();
+
     if (GetRankInfo(newRank))                             // Validate rank (allow only existing ranks)
     {
         if (Member* member = GetMember(guid))
@@ -3081,6 +3194,8 @@ bool Guild::_CreateRank(CharacterDatabaseTransaction trans, std::string_view nam
 // Player may have many characters in the guild, but with the same account
 void Guild::_UpdateAccountsNumber()
 {
+    _InvalidateRosterCache();
+
     // We use a set to be sure each element will be unique
     std::unordered_set<uint32> accountsIdSet;
     for (auto const& [guid, member] : m_members)
@@ -3130,6 +3245,8 @@ bool Guild::_ModifyBankMoney(CharacterDatabaseTransaction trans, uint64 amount,
 
 void Guild::_SetLeader(CharacterDatabaseTransaction trans, Member& leader)
 {
+    _InvalidateRosterCache();
+
     bool isInTransaction = bool(trans);
     if (!isInTransaction)
         trans = CharacterDatabase.BeginTransaction();
@@ -3251,7 +3368,8 @@ inline void Guild::_LogEvent(GuildEventLogTypes eventType, ObjectGuid::LowType p
 {
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
     m_eventLog.AddEvent(trans, m_id, m_eventLog.GetNextGUID(), eventType, playerGuid1, playerGuid2, newRank);
-    CharacterDatabase.CommitTransaction(trans);
+    if (trans->GetSize())
+        CharacterDatabase.CommitTransaction(trans);
 
     sScriptMgr->OnGuildEvent(this, uint8(eventType), playerGuid1, playerGuid2, newRank);
 }
@@ -3564,6 +3682,8 @@ void Guild::SendBankList(WorldSession* session, uint8 tabId, bool fullUpdate) co
 
 void Guild::SendGuildRanksUpdate(ObjectGuid setterGuid, ObjectGuid targetGuid, GuildRankId rank)
 {
+    _InvalidateRosterCache();
+
     Member* member = GetMember(targetGuid);
     ASSERT(member);
 
@@ -3583,6 +3703,8 @@ void Guild::SendGuildRanksUpdate(ObjectGuid setterGuid, ObjectGuid targetGuid, G
 
 void Guild::ResetTimes(bool weekly)
 {
+    _InvalidateRosterCache();
+
     for (auto& [guid, member] : m_members)
     {
         member.ResetValues(weekly);
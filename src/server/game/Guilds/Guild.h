@@ -27,6 +27,7 @@
 #include "SharedDefines.h"
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 class GuildAchievementMgr;
 class Item;
@@ -61,7 +62,8 @@ enum GuildMisc
     GUILD_WITHDRAW_SLOT_UNLIMITED       = 0xFFFFFFFF,
     GUILD_EVENT_LOG_GUID_UNDEFINED      = 0xFFFFFFFF,
     TAB_UNDEFINED                       = 0xFF,
-    GUILD_OLD_MAX_LEVEL                 = 25
+    GUILD_OLD_MAX_LEVEL                 = 25,
+    GUILD_ROSTER_CACHE_TIME             = 60                    // seconds a serialized roster is reused while members do not change
 };
 
 constexpr uint64 GUILD_BANK_MONEY_LIMIT = UI64LIT(100000000000);
@@ -430,6 +432,8 @@ class TC_GAME_API Guild
                 ~EventLogEntry() { }
 
                 void SaveToDB(CharacterDatabaseTransaction trans) const override;
+                void DeleteFromDB(CharacterDatabaseTransaction trans) const;
+                void InsertIntoDB(CharacterDatabaseTransaction trans) const;
                 void WritePacket(WorldPackets::Guild::GuildEventLogQueryResults& packet) const;
 
             private:
@@ -468,6 +472,8 @@ class TC_GAME_API Guild
                 ~BankEventLogEntry() { }
 
                 void SaveToDB(CharacterDatabaseTransaction trans) const override;
+                void DeleteFromDB(CharacterDatabaseTransaction trans) const;
+                void InsertIntoDB(CharacterDatabaseTransaction trans) const;
                 void WritePacket(WorldPackets::Guild::GuildBankLogQueryResults& packet) const;
 
             private:
@@ -527,16 +533,20 @@ class TC_GAME_API Guild
                 template <typename... Ts>
                 void LoadEvent(Ts&&... args);
 
-                // Adds new event to collection and saves it to DB
+                // Adds new event to collection and saves it to DB, event and bank logs are only queued when Guild.LogFlushInterval is set
                 template <typename... Ts>
                 Entry& AddEvent(CharacterDatabaseTransaction trans, Ts&&... args);
 
+                // Saves queued events, only the newest event of each reused slot is written
+                void FlushToDB(CharacterDatabaseTransaction trans);
+
                 uint32 GetNextGUID();
                 std::list<Entry>& GetGuildLog() { return m_log; }
                 std::list<Entry> const& GetGuildLog() const { return m_log; }
 
             private:
                 std::list<Entry> m_log;
+                std::vector<Entry> m_pending;
                 uint32 const m_maxRecords;
                 uint32 m_nextGUID;
         };
@@ -724,6 +734,7 @@ class TC_GAME_API Guild
         void Disband();
 
         void SaveToDB();
+        void SaveLogsToDB();
 
         // Getters
         ObjectGuid::LowType GetId() const { return m_id; }
@@ -871,6 +882,10 @@ class TC_GAME_API Guild
         LogHolder<NewsLogEntry> m_newsLog;
         std::unique_ptr<GuildAchievementMgr> m_achievementMgr;
 
+        // [0] without officer notes, [1] with
+        std::array<std::unique_ptr<WorldPacket>, 2> m_rosterCache;
+        std::array<time_t, 2> m_rosterCacheExpireTime = { };
+
     private:
         inline uint8 _GetRanksSize() const { return uint8(m_ranks.size()); }
         RankInfo const* GetRankInfo(GuildRankId rankId) const;
@@ -881,6 +896,9 @@ class TC_GAME_API Guild
 
         inline GuildRankId _GetLowestRankId() const { return m_ranks.back().GetId(); }
 
+        WorldPacket _BuildRosterPacket(bool sendOfficerNote) const;
+        void _InvalidateRosterCache();
+
         inline uint8 _GetPurchasedTabsSize() const { return uint8(m_bankTabs.size()); }
         inline BankTab* GetBankTab(uint8 tabId) { return tabId < m_bankTabs.size() ? &m_bankTabs[tabId] : nullptr; }
         inline BankTab const* GetBankTab(uint8 tabId) const { return tabId < m_bankTabs.size() ? &m_bankTabs[tabId] : nullptr; }
@@ -51,6 +51,12 @@ void GuildMgr::SaveGuilds()
         itr->second->SaveToDB();
 }
 
+void GuildMgr::SaveGuildLogs()
+{
+    for (GuildContainer::iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
+        itr->second->SaveLogsToDB();
+}
+
 ObjectGuid::LowType GuildMgr::GenerateGuildId()
 {
     if (NextGuildId >= 0xFFFFFFFE)
@@ -50,6 +50,7 @@ public:
     void RemoveGuild(ObjectGuid::LowType guildId);
 
     void SaveGuilds();
+    void SaveGuildLogs();
 
     void ResetReputationCaps();
 
@@ -85,6 +85,28 @@ void WorldSession::HandleAuctionBrowseQuery(WorldPackets::AuctionHouse::AuctionB
         }
     }
 
+    // filters depending on player state cannot be answered from another thread
+    if (Trinity::ThreadPool* browsePool = sAuctionMgr->GetBrowsePool())
+    {
+        if (!EnumFlag<AuctionHouseFilterMask>(browseQuery.Filters).HasFlag(AuctionHouseFilterMask::UncollectedOnly | AuctionHouseFilterMask::UsableOnly))
+        {
+            AddAuctionBrowseCallback(auctionHouse->BuildListBucketsAsync(*browsePool, name, browseQuery.MinLevel, browseQuery.MaxLevel, browseQuery.Filters, classFilters,
+                GetSessionDbcLocale(), browseQuery.Offset, browseQuery.Sorts.data(), browseQuery.Sorts.size()))
+                .AfterComplete([this, auctionHouse, delayUntilNext = throttle.DelayUntilNext](AuctionBrowseResult&& browseResult)
+            {
+                if (!_player)
+                    return;
+
+                WorldPackets::AuctionHouse::AuctionListBucketsResult listBucketsResult;
+                auctionHouse->BuildListBuckets(listBucketsResult, _player, browseResult);
+                listBucketsResult.BrowseMode = AuctionHouseBrowseMode::Search;
+                listBucketsResult.DesiredDelay = uint32(delayUntilNext.count());
+                SendPacket(listBucketsResult.Write());
+            });
+            return;
+        }
+    }
+
     auctionHouse->BuildListBuckets(listBucketsResult, _player,
         name, browseQuery.MinLevel, browseQuery.MaxLevel, browseQuery.Filters, classFilters,
         browseQuery.KnownPets.data(), browseQuery.KnownPets.size(), browseQuery.MaxPetLevel,
@@ -38,6 +38,7 @@ Copied events should probably have a new owner
 #include "CalendarMgr.h"
 #include "CalendarPackets.h"
 #include "CharacterCache.h"
+#include "DatabaseCoroutine.h"
 #include "DatabaseEnv.h"
 #include "DB2Stores.h"
 #include "GameTime.h"
@@ -60,7 +61,7 @@ void WorldSession::HandleCalendarGetCalendar(WorldPackets::Calendar::CalendarGet
     WorldPackets::Calendar::CalendarSendCalendar packet;
     packet.ServerTime = currTime;
 
-    CalendarInviteStore playerInvites = sCalendarMgr->GetPlayerInvites(guid);
+    CalendarInviteStore const& playerInvites = sCalendarMgr->GetPlayerInvites(guid);
     for (auto const& invite : playerInvites)
     {
         WorldPackets::Calendar::CalendarSendCalendarInviteInfo inviteInfo;
@@ -363,28 +364,45 @@ void WorldSession::HandleCalendarInvite(WorldPackets::Calendar::CalendarInvite&
         return;
     }
 
-    if (QueryResult result = CharacterDatabase.PQuery("SELECT flags FROM character_social WHERE guid = {} AND friend = {}", inviteeGuid.GetCounter(), playerGuid.GetCounter()))
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_SOCIAL_FLAGS);
+    stmt->setUInt64(0, inviteeGuid.GetCounter());
+    stmt->setUInt64(1, playerGuid.GetCounter());
+    CalendarInviteIfNotIgnored(CharacterDatabase.AsyncQuery(stmt), inviteeGuid, inviteeGuildId, std::move(calendarEventInvite.Name),
+        calendarEventInvite.EventID, calendarEventInvite.Creating, calendarEventInvite.IsSignUp);
+}
+
+Trinity::DatabaseCoroutine WorldSession::CalendarInviteIfNotIgnored(QueryCallback query, ObjectGuid inviteeGuid, ObjectGuid::LowType inviteeGuildId,
+    std::string inviteeName, uint64 eventId, bool creating, bool isSignUp)
+{
+    PreparedQueryResult result = co_await Trinity::AwaitPreparedQuery(_queryProcessor, std::move(query));
+
+    // logged out while waiting
+    if (!_player)
+        co_return;
+
+    ObjectGuid playerGuid = _player->GetGUID();
+    if (result)
     {
         Field* fields = result->Fetch();
         if (fields[0].GetUInt8() & SOCIAL_FLAG_IGNORED)
         {
-            sCalendarMgr->SendCalendarCommandResult(playerGuid, CALENDAR_ERROR_IGNORING_YOU_S, calendarEventInvite.Name.c_str());
-            return;
+            sCalendarMgr->SendCalendarCommandResult(playerGuid, CALENDAR_ERROR_IGNORING_YOU_S, inviteeName.c_str());
+            co_return;
         }
     }
 
-    if (!calendarEventInvite.Creating)
+    if (!creating)
     {
-        if (CalendarEvent* calendarEvent = sCalendarMgr->GetEvent(calendarEventInvite.EventID))
+        if (CalendarEvent* calendarEvent = sCalendarMgr->GetEvent(eventId))
         {
             if (calendarEvent->IsGuildEvent() && calendarEvent->GetGuildId() == inviteeGuildId)
             {
                 // we can't invite guild members to guild events
                 sCalendarMgr->SendCalendarCommandResult(playerGuid, CALENDAR_ERROR_NO_GUILD_INVITES);
-                return;
+                co_return;
             }
 
-            CalendarInvite* invite = new CalendarInvite(sCalendarMgr->GetFreeInviteId(), calendarEventInvite.EventID, inviteeGuid, playerGuid, CALENDAR_DEFAULT_RESPONSE_TIME, CALENDAR_STATUS_INVITED, CALENDAR_RANK_PLAYER, "");
+            CalendarInvite* invite = new CalendarInvite(sCalendarMgr->GetFreeInviteId(), eventId, inviteeGuid, playerGuid, CALENDAR_DEFAULT_RESPONSE_TIME, CALENDAR_STATUS_INVITED, CALENDAR_RANK_PLAYER, "");
             sCalendarMgr->AddInvite(calendarEvent, invite);
         }
         else
@@ -392,10 +410,10 @@ void WorldSession::HandleCalendarInvite(WorldPackets::Calendar::CalendarInvite&
     }
     else
     {
-        if (calendarEventInvite.IsSignUp && inviteeGuildId == _player->GetGuildId())
+        if (isSignUp && inviteeGuildId == _player->GetGuildId())
         {
             sCalendarMgr->SendCalendarCommandResult(playerGuid, CALENDAR_ERROR_NO_GUILD_INVITES);
-            return;
+            co_return;
         }
 
         CalendarInvite invite(sCalendarMgr->GetFreeInviteId(), 0L, inviteeGuid, playerGuid, CALENDAR_DEFAULT_RESPONSE_TIME, CALENDAR_STATUS_INVITED, CALENDAR_RANK_PLAYER, "");
@@ -184,29 +184,33 @@ bool LoginQueryHolder::Initialize()
     stmt->setUInt64(0, lowGuid);
     res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAILS, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS);
-    stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS, stmt);
+    // mailed items are loaded with the first mailbox access when Mail.LoadItemsOnDemand is enabled
+    if (!sWorld->getBoolConfig(CONFIG_MAIL_LOAD_ITEMS_ON_DEMAND))
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS);
+        stmt->setUInt64(0, lowGuid);
+        res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_ARTIFACT);
-    stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_ARTIFACT, stmt);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_ARTIFACT);
+        stmt->setUInt64(0, lowGuid);
+        res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_ARTIFACT, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE);
-    stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE, stmt);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE);
+        stmt->setUInt64(0, lowGuid);
+        res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_MILESTONE_POWER);
-    stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_MILESTONE_POWER, stmt);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_MILESTONE_POWER);
+        stmt->setUInt64(0, lowGuid);
+        res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_MILESTONE_POWER, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_UNLOCKED_ESSENCE);
-    stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_UNLOCKED_ESSENCE, stmt);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_UNLOCKED_ESSENCE);
+        stmt->setUInt64(0, lowGuid);
+        res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_UNLOCKED_ESSENCE, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_EMPOWERED);
-    stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_EMPOWERED, stmt);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_EMPOWERED);
+        stmt->setUInt64(0, lowGuid);
+        res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_EMPOWERED, stmt);
+    }
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_SOCIALLIST);
     stmt->setUInt64(0, lowGuid);
@@ -456,6 +460,18 @@ void WorldSession::HandleCharEnum(CharacterDatabaseQueryHolder const& holder)
         while (result->NextRow() && charEnum.Characters.size() < MAX_CHARACTERS_PER_REALM);
     }
 
+    if (!charEnum.IsDeletedCharacters && _canPrefetchLogin && sWorld->getIntConfig(CONFIG_CHARACTER_LOGIN_PREFETCH_TIME))
+    {
+        // characters with pending at login customizations are not worth loading, they go through another screen first
+        WorldPackets::Character::EnumCharactersResult::CharacterInfo const* lastPlayed = nullptr;
+        for (WorldPackets::Character::EnumCharactersResult::CharacterInfo const& charInfo : charEnum.Characters)
+            if (!charInfo.Flags2 && IsLegitCharacterForAccount(charInfo.Guid) && (!lastPlayed || time_t(charInfo.LastPlayedTime) > time_t(lastPlayed->LastPlayedTime)))
+                lastPlayed = &charInfo;
+
+        if (lastPlayed)
+            PrefetchLoginData(lastPlayed->Guid);
+    }
+
     charEnum.IsAlliedRacesCreationAllowed = CanAccessAlliedRaces();
 
     for (std::pair<uint8 const, RaceUnlockRequirement> const& requirement : sObjectMgr->GetRaceUnlockRequirements())
@@ -472,6 +488,38 @@ void WorldSession::HandleCharEnum(CharacterDatabaseQueryHolder const& holder)
     SendPacket(charEnum.Write());
 }
 
+void WorldSession::PrefetchLoginData(ObjectGuid guid)
+{
+    if (_loginPrefetch && _loginPrefetch->Holder->GetGuid() == guid)
+        return;
+
+    std::shared_ptr<LoginQueryHolder> holder = std::make_shared<LoginQueryHolder>(GetAccountId(), guid);
+    if (!holder->Initialize())
+        return;
+
+    _loginPrefetch = std::make_unique<LoginPrefetch>();
+    _loginPrefetch->Holder = holder;
+
+    // queued behind interactive work, players waiting for something they requested go first
+    AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder, SQLOperationPriority::Normal)).AfterComplete([this](SQLQueryHolderBase const& result)
+    {
+        // discarded or replaced while loading
+        if (!_loginPrefetch || _loginPrefetch->Holder.get() != &result)
+            return;
+
+        if (_loginPrefetch->LoginPending)
+        {
+            std::shared_ptr<LoginQueryHolder> loaded = std::move(_loginPrefetch->Holder);
+            _loginPrefetch.reset();
+            HandlePlayerLogin(*loaded);
+            return;
+        }
+
+        _loginPrefetch->Loaded = true;
+        _loginPrefetch->ExpireTime = GameTime::Now() + Seconds(sWorld->getIntConfig(CONFIG_CHARACTER_LOGIN_PREFETCH_TIME));
+    });
+}
+
 void WorldSession::HandleCharEnumOpcode(WorldPackets::Character::EnumCharacters& /*enumCharacters*/)
 {
     // remove expired bans
@@ -997,6 +1045,8 @@ void WorldSession::HandleCharCreateOpcode(WorldPackets::Character::CreateCharact
 
 void WorldSession::HandleCharDeleteOpcode(WorldPackets::Character::CharDelete& charDelete)
 {
+    DiscardLoginPrefetch();
+
     // Initiating
     uint32 initAccountId = GetAccountId();
 
@@ -1091,6 +1141,26 @@ void WorldSession::HandleContinuePlayerLogin()
         return;
     }
 
+    _canPrefetchLogin = false;
+
+    if (_loginPrefetch && _loginPrefetch->Holder->GetGuid() == m_playerLoading && (!_loginPrefetch->Loaded || _loginPrefetch->ExpireTime > GameTime::Now()))
+    {
+        SendPacket(WorldPackets::Auth::ResumeComms(CONNECTION_TYPE_INSTANCE).Write());
+
+        if (!_loginPrefetch->Loaded)
+        {
+            _loginPrefetch->LoginPending = true;
+            return;
+        }
+
+        std::shared_ptr<LoginQueryHolder> prefetched = std::move(_loginPrefetch->Holder);
+        _loginPrefetch.reset();
+        HandlePlayerLogin(*prefetched);
+        return;
+    }
+
+    _loginPrefetch.reset();
+
     std::shared_ptr<LoginQueryHolder> holder = std::make_shared<LoginQueryHolder>(GetAccountId(), m_playerLoading);
     if (!holder->Initialize())
     {
@@ -1588,6 +1658,8 @@ void WorldSession::HandleCheckCharacterNameAvailability(WorldPackets::Character:
 
 void WorldSession::HandleCharRenameOpcode(WorldPackets::Character::CharacterRenameRequest& request)
 {
+    DiscardLoginPrefetch();
+
     if (!IsLegitCharacterForAccount(request.RenameInfo->Guid))
     {
         TC_LOG_ERROR("network", "Account {}, IP: {} tried to rename character {}, but it does not belong to their account!",
@@ -1786,6 +1858,8 @@ void WorldSession::HandleAlterAppearance(WorldPackets::Character::AlterApperance
 
 void WorldSession::HandleCharCustomizeOpcode(WorldPackets::Character::CharCustomize& packet)
 {
+    DiscardLoginPrefetch();
+
     if (!IsLegitCharacterForAccount(packet.CustomizeInfo->CharGUID))
     {
         TC_LOG_ERROR("entities.player.cheat", "Account {}, IP: {} tried to customise {}, but it does not belong to their account!",
@@ -2060,6 +2134,8 @@ void WorldSession::HandleUseEquipmentSet(WorldPackets::EquipmentSet::UseEquipmen
 
 void WorldSession::HandleCharRaceOrFactionChangeOpcode(WorldPackets::Character::CharRaceOrFactionChange& packet)
 {
+    DiscardLoginPrefetch();
+
     if (!IsLegitCharacterForAccount(packet.RaceOrFactionChangeInfo->Guid))
     {
         TC_LOG_ERROR("entities.player.cheat", "Account {}, IP: {} tried to factionchange character {}, but it does not belong to their account!",
@@ -2675,6 +2751,8 @@ void WorldSession::HandleUndeleteCooldownStatusCallback(PreparedQueryResult resu
 
 void WorldSession::HandleCharUndeleteOpcode(WorldPackets::Character::UndeleteCharacter& undeleteCharacter)
 {
+    DiscardLoginPrefetch();
+
     if (!sWorld->getBoolConfig(CONFIG_FEATURE_SYSTEM_CHARACTER_UNDELETE_ENABLED))
     {
         SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_ERROR_DISABLED, undeleteCharacter.UndeleteInfo.get());
@@ -124,22 +124,22 @@ void WorldSession::HandleChatMessageOpcode(WorldPackets::Chat::ChatMessage& chat
             return;
     }
 
-    HandleChatMessage(type, Language(chatMessage.Language), chatMessage.Text);
+    HandleChatMessage(type, Language(chatMessage.Language), std::string(chatMessage.Text));
 }
 
 void WorldSession::HandleChatMessageWhisperOpcode(WorldPackets::Chat::ChatMessageWhisper& chatMessageWhisper)
 {
-    HandleChatMessage(CHAT_MSG_WHISPER, Language(chatMessageWhisper.Language), chatMessageWhisper.Text, chatMessageWhisper.Target);
+    HandleChatMessage(CHAT_MSG_WHISPER, Language(chatMessageWhisper.Language), std::string(chatMessageWhisper.Text), std::string(chatMessageWhisper.Target));
 }
 
 void WorldSession::HandleChatMessageChannelOpcode(WorldPackets::Chat::ChatMessageChannel& chatMessageChannel)
 {
-    HandleChatMessage(CHAT_MSG_CHANNEL, Language(chatMessageChannel.Language), chatMessageChannel.Text, chatMessageChannel.Target, chatMessageChannel.ChannelGUID);
+    HandleChatMessage(CHAT_MSG_CHANNEL, Language(chatMessageChannel.Language), std::string(chatMessageChannel.Text), std::string(chatMessageChannel.Target), chatMessageChannel.ChannelGUID);
 }
 
 void WorldSession::HandleChatMessageEmoteOpcode(WorldPackets::Chat::ChatMessageEmote& chatMessageEmote)
 {
-    HandleChatMessage(CHAT_MSG_EMOTE, LANG_UNIVERSAL, chatMessageEmote.Text);
+    HandleChatMessage(CHAT_MSG_EMOTE, LANG_UNIVERSAL, std::string(chatMessageEmote.Text));
 }
 
 void WorldSession::HandleChatMessage(ChatMsg type, Language lang, std::string msg, std::string target /*= ""*/, Optional<ObjectGuid> channelGuid /*= {}*/)
@@ -468,7 +468,7 @@ void WorldSession::HandleChatAddonMessageTargetedOpcode(WorldPackets::Chat::Chat
         chatAddonMessageTargeted.Params.IsLogged, chatAddonMessageTargeted.Target, chatAddonMessageTargeted.ChannelGUID);
 }
 
-void WorldSession::HandleChatAddonMessage(ChatMsg type, std::string prefix, std::string text, bool isLogged, std::string target /*= ""*/, Optional<ObjectGuid> channelGuid /*= {}*/)
+void WorldSession::HandleChatAddonMessage(ChatMsg type, std::string_view prefix, std::string_view text, bool isLogged, std::string_view target /*= {}*/, Optional<ObjectGuid> channelGuid /*= {}*/)
 {
     Player* sender = GetPlayer();
 
@@ -491,7 +491,7 @@ void WorldSession::HandleChatAddonMessage(ChatMsg type, std::string prefix, std:
 
     sender->UpdateSpeakTime(Player::ChatFloodThrottle::ADDON);
 
-    if (prefix == AddonChannelCommandHandler::PREFIX && AddonChannelCommandHandler(this).ParseCommands(text.c_str()))
+    if (prefix == AddonChannelCommandHandler::PREFIX && AddonChannelCommandHandler(this).ParseCommands(text))
         return;
 
     if (text.length() > 255)
@@ -510,7 +510,7 @@ void WorldSession::HandleChatAddonMessage(ChatMsg type, std::string prefix, std:
         case CHAT_MSG_WHISPER:
         {
             /// @todo implement cross realm whispers (someday)
-            ExtendedPlayerName extName = ExtractExtendedPlayerName(target);
+            ExtendedPlayerName extName = ExtractExtendedPlayerName(std::string(target));
 
             if (!normalizePlayerName(extName.Name))
                 break;
@@ -551,9 +551,9 @@ void WorldSession::HandleChatAddonMessage(ChatMsg type, std::string prefix, std:
         {
             Channel* chn = channelGuid
                 ? ChannelMgr::GetChannelForPlayerByGuid(*channelGuid, sender)
-                : ChannelMgr::GetChannelForPlayerByNamePart(target, sender);
+                : ChannelMgr::GetChannelForPlayerByNamePart(std::string(target), sender);
             if (chn)
-                chn->AddonSay(sender->GetGUID(), prefix, text.c_str(), isLogged);
+                chn->AddonSay(sender->GetGUID(), prefix, text, isLogged);
             break;
         }
         default:
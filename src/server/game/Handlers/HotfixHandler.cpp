@@ -21,9 +21,32 @@
 #include "GameTime.h"
 #include "HotfixPackets.h"
 #include "Log.h"
+#include "ObjectMgr.h"
 #include "Realm.h"
 #include "World.h"
 
+namespace
+{
+void WriteRecordData(DB2StorageBase const& storage, uint32 recordId, LocaleConstant locale, ByteBuffer& buffer)
+{
+    // item sparse records are requested for every item a client sees, they are serialized once by ObjectMgr::InitializeQueriesData
+    if (storage.GetTableHash() == sItemSparseStore.GetTableHash() && sWorld->getBoolConfig(CONFIG_CACHE_DATA_QUERIES))
+    {
+        if (ItemTemplate const* itemTemplate = sObjectMgr->GetItemTemplate(recordId))
+        {
+            std::vector<uint8> const& recordData = itemTemplate->SparseRecordData[locale];
+            if (!recordData.empty())
+            {
+                buffer.append(recordData.data(), recordData.size());
+                return;
+            }
+        }
+    }
+
+    sDB2Manager.WriteRecordWithOptionalData(storage, recordId, locale, buffer);
+}
+}
+
 void WorldSession::HandleDBQueryBulk(WorldPackets::Hotfix::DBQueryBulk& dbQuery)
 {
     DB2StorageBase const* store = sDB2Manager.GetStorage(dbQuery.TableHash);
@@ -37,16 +60,7 @@ void WorldSession::HandleDBQueryBulk(WorldPackets::Hotfix::DBQueryBulk& dbQuery)
         {
             dbReply.Status = DB2Manager::HotfixRecord::Status::Valid;
             dbReply.Timestamp = GameTime::GetGameTime();
-            store->WriteRecord(record.RecordID, GetSessionDbcLocale(), dbReply.Data);
-
-            if (std::vector<DB2Manager::HotfixOptionalData> const* optionalDataEntries = sDB2Manager.GetHotfixOptionalData(dbQuery.TableHash, record.RecordID, GetSessionDbcLocale()))
-            {
-                for (DB2Manager::HotfixOptionalData const& optionalData : *optionalDataEntries)
-                {
-                    dbReply.Data << uint32(optionalData.Key);
-                    dbReply.Data.append(optionalData.Data.data(), optionalData.Data.size());
-                }
-            }
+            WriteRecordData(*store, record.RecordID, GetSessionDbcLocale(), dbReply.Data);
         }
         else
         {
@@ -80,21 +94,18 @@ void WorldSession::HandleHotfixRequest(WorldPackets::Hotfix::HotfixRequest& hotf
                 hotfixData.Record = hotfixRecord;
                 if (hotfixRecord.HotfixStatus == DB2Manager::HotfixRecord::Status::Valid)
                 {
+                    if (std::vector<uint8> const* replyData = sDB2Manager.GetHotfixReplyData(hotfixRecord.TableHash, hotfixRecord.RecordID, GetSessionDbcLocale()))
+                    {
+                        hotfixData.Size = replyData->size();
+                        hotfixQueryResponse.HotfixContent.append(replyData->data(), replyData->size());
+                        continue;
+                    }
+
                     DB2StorageBase const* storage = sDB2Manager.GetStorage(hotfixRecord.TableHash);
                     if (storage && storage->HasRecord(uint32(hotfixRecord.RecordID)))
                     {
                         std::size_t pos = hotfixQueryResponse.HotfixContent.size();
-                        storage->WriteRecord(uint32(hotfixRecord.RecordID), GetSessionDbcLocale(), hotfixQueryResponse.HotfixContent);
-
-                        if (std::vector<DB2Manager::HotfixOptionalData> const* optionalDataEntries = sDB2Manager.GetHotfixOptionalData(hotfixRecord.TableHash, hotfixRecord.RecordID, GetSessionDbcLocale()))
-                        {
-                            for (DB2Manager::HotfixOptionalData const& optionalData : *optionalDataEntries)
-                            {
-                                hotfixQueryResponse.HotfixContent << uint32(optionalData.Key);
-                                hotfixQueryResponse.HotfixContent.append(optionalData.Data.data(), optionalData.Data.size());
-                            }
-                        }
-
+                        WriteRecordData(*storage, uint32(hotfixRecord.RecordID), GetSessionDbcLocale(), hotfixQueryResponse.HotfixContent);
                         hotfixData.Size = hotfixQueryResponse.HotfixContent.size() - pos;
                     }
                     else if (std::vector<uint8> const* blobData = sDB2Manager.GetHotfixBlobData(hotfixRecord.TableHash, hotfixRecord.RecordID, GetSessionDbcLocale()))
@@ -881,30 +881,31 @@ void WorldSession::HandleWrapItem(WorldPackets::Item::WrapItem& packet)
     stmt->setUInt32(3, item->m_itemData->DynamicFlags);
     trans->Append(stmt);
 
-    item->SetEntry(gift->GetEntry());
-
-    switch (item->GetEntry())
+    uint32 wrappedEntry = gift->GetEntry();
+    switch (wrappedEntry)
     {
         case 5042:
-            item->SetEntry(5043);
+            wrappedEntry = 5043;
             break;
         case 5048:
-            item->SetEntry(5044);
+            wrappedEntry = 5044;
             break;
         case 17303:
-            item->SetEntry(17302);
+            wrappedEntry = 17302;
             break;
         case 17304:
-            item->SetEntry(17305);
+            wrappedEntry = 17305;
             break;
         case 17307:
-            item->SetEntry(17308);
+            wrappedEntry = 17308;
             break;
         case 21830:
-            item->SetEntry(21831);
+            wrappedEntry = 21831;
             break;
     }
 
+    _player->ChangeStoredItemEntry(item, wrappedEntry);
+
     item->SetGiftCreator(_player->GetGUID());
     item->ReplaceAllItemFlags(ITEM_FIELD_FLAG_WRAPPED);
     item->SetState(ITEM_CHANGED, _player);
@@ -557,6 +557,22 @@ void WorldSession::HandleGetMailList(WorldPackets::Mail::MailGetList& getList)
     if (!CanOpenMailBox(getList.Mailbox))
         return;
 
+    // Mail.LoadItemsOnDemand, the list is sent once the attachments were loaded
+    if (!_player->HasMailedItemsLoaded())
+    {
+        _player->StartLoadingMailedItems([this, mailbox = getList.Mailbox]()
+        {
+            if (CanOpenMailBox(mailbox))
+                SendMailList(mailbox);
+        });
+        return;
+    }
+
+    SendMailList(getList.Mailbox);
+}
+
+void WorldSession::SendMailList(ObjectGuid mailbox)
+{
     Player* player = _player;
 
     WorldPackets::Mail::MailListResult response;
@@ -576,7 +592,7 @@ void WorldSession::HandleGetMailList(WorldPackets::Mail::MailGetList& getList)
     }
 
     player->PlayerTalkClass->GetInteractionData().Reset();
-    player->PlayerTalkClass->GetInteractionData().SourceGuid = getList.Mailbox;
+    player->PlayerTalkClass->GetInteractionData().SourceGuid = mailbox;
     SendPacket(response.Write());
 
     // recalculate m_nextMailDelivereTime and unReadMails
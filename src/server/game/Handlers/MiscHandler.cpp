@@ -28,6 +28,7 @@
 #include "Common.h"
 #include "Conversation.h"
 #include "Corpse.h"
+#include "DatabaseCoroutine.h"
 #include "DatabaseEnv.h"
 #include "DB2Stores.h"
 #include "GameTime.h"
@@ -143,49 +144,48 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
     WorldPackets::Who::WhoResponsePkt response;
     response.RequestID = whoRequest.RequestID;
 
-    WhoListInfoVector const& whoList = sWhoListStorageMgr->GetWhoList();
-    for (WhoListPlayerInfo const& target : whoList)
+    sWhoListStorageMgr->VisitCandidates(request.MinLevel, request.MaxLevel, whoRequest.Areas, [&](WhoListPlayerInfo const& target)
     {
         // player can see member of other team only if has RBAC_PERM_TWO_SIDE_WHO_LIST
         if (target.GetTeam() != team && !HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST))
-            continue;
+            return true;
 
         // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if has RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS
         if (target.GetSecurity() > AccountTypes(gmLevelInWhoList) && !HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS))
-            continue;
+            return true;
 
         // check if target is globally visible for player
         if (_player->GetGUID() != target.GetGuid() && !target.IsVisible())
             if (AccountMgr::IsPlayerAccount(_player->GetSession()->GetSecurity()) || target.GetSecurity() > _player->GetSession()->GetSecurity())
-                continue;
+                return true;
 
         // check if target's level is in level range
         uint8 lvl = target.GetLevel();
         if (lvl < request.MinLevel || lvl > request.MaxLevel)
-            continue;
+            return true;
 
         // check if class matches classmask
         if (request.ClassFilter >= 0 && !(request.ClassFilter & (1 << target.GetClass())))
-            continue;
+            return true;
 
         // check if race matches racemask
         if (!request.RaceFilter.HasRace(target.GetRace()))
-            continue;
+            return true;
 
         if (!whoRequest.Areas.empty())
         {
             if (std::find(whoRequest.Areas.begin(), whoRequest.Areas.end(), int32(target.GetZoneId())) == whoRequest.Areas.end())
-                continue;
+                return true;
         }
 
         std::wstring const& wTargetName = target.GetWidePlayerName();
         if (!(wPlayerName.empty() || wTargetName.find(wPlayerName) != std::wstring::npos))
-            continue;
+            return true;
 
         std::wstring const& wTargetGuildName = target.GetWideGuildName();
 
         if (!wGuildName.empty() && wTargetGuildName.find(wGuildName) == std::wstring::npos)
-            continue;
+            return true;
 
         if (!wWords.empty())
         {
@@ -209,12 +209,12 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
             }
 
             if (!show)
-                continue;
+                return true;
         }
 
         WorldPackets::Who::WhoEntry whoEntry;
         if (!whoEntry.PlayerData.Initialize(target.GetGuid(), nullptr))
-            continue;
+            return true;
 
         if (!target.GetGuildGuid().IsEmpty())
         {
@@ -231,8 +231,10 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
         // 50 is maximum player count sent to client - can be overridden
         // through config, but is unstable
         if (response.Response.Entries.size() >= sWorld->getIntConfig(CONFIG_MAX_WHO))
-            break;
-    }
+            return false;
+
+        return true;
+    });
 
     SendPacket(response.Write());
 }
@@ -833,11 +835,16 @@ void WorldSession::HandleWhoIsOpcode(WorldPackets::Who::WhoIsRequest& packet)
     LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_ACCOUNT_WHOIS);
     stmt->setUInt32(0, player->GetSession()->GetAccountId());
 
-    PreparedQueryResult result = LoginDatabase.Query(stmt);
+    SendWhoIsResponse(LoginDatabase.AsyncQuery(stmt), std::move(packet.CharName));
+}
+
+Trinity::DatabaseCoroutine WorldSession::SendWhoIsResponse(QueryCallback query, std::string charName)
+{
+    PreparedQueryResult result = co_await Trinity::AwaitPreparedQuery(_queryProcessor, std::move(query));
     if (!result)
     {
-        SendNotification(LANG_ACCOUNT_FOR_PLAYER_NOT_FOUND, packet.CharName.c_str());
-        return;
+        SendNotification(LANG_ACCOUNT_FOR_PLAYER_NOT_FOUND, charName.c_str());
+        co_return;
     }
 
     Field* fields = result->Fetch();
@@ -854,7 +861,7 @@ void WorldSession::HandleWhoIsOpcode(WorldPackets::Who::WhoIsRequest& packet)
         lastip = "Unknown";
 
     WorldPackets::Who::WhoIsResponse response;
-    response.AccountName = packet.CharName + "'s " + "account is " + acc + ", e-mail: " + email + ", last ip: " + lastip;
+    response.AccountName = charName + "'s " + "account is " + acc + ", e-mail: " + email + ", last ip: " + lastip;
     SendPacket(response.Write());
 }
 
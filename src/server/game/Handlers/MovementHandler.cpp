@@ -17,11 +17,13 @@
 
 #include "WorldSession.h"
 #include "Battleground.h"
+#include "CellImpl.h"
 #include "Corpse.h"
 #include "DB2Stores.h"
 #include "FlightPathMovementGenerator.h"
 #include "GameTime.h"
 #include "Garrison.h"
+#include "GridNotifiersImpl.h"
 #include "InstanceLockMgr.h"
 #include "InstancePackets.h"
 #include "Log.h"
@@ -34,8 +36,10 @@
 #include "MotionMaster.h"
 #include "MovementGenerator.h"
 #include "MoveSpline.h"
+#include "Timer.h"
 #include "Transport.h"
 #include "Vehicle.h"
+#include "World.h"
 #include "SpellMgr.h"
 #include <boost/accumulators/statistics/variance.hpp>
 #include <boost/accumulators/accumulators.hpp>
@@ -427,7 +431,31 @@ void WorldSession::HandleMovementOpcode(OpcodeClient opcode, MovementInfo& movem
 
     WorldPackets::Movement::MoveUpdate moveUpdate;
     moveUpdate.Status = &mover->m_movementInfo;
-    mover->SendMessageToSet(moveUpdate.Write(), _player);
+    moveUpdate.Write();
+
+    // heartbeats only repeat the current movement, players far away get them at a lower rate
+    float relayDistance = mover->GetVisibilityRange();
+    if (opcode == CMSG_MOVE_HEARTBEAT || opcode == CMSG_MOVE_SET_FACING_HEARTBEAT)
+    {
+        if (uint32 farInterval = sWorld->getIntConfig(CONFIG_MOVEMENT_RELAY_FAR_INTERVAL))
+        {
+            uint32 now = GameTime::GetGameTimeMS();
+            if (getMSTimeDiff(_lastFarMovementRelayTime, now) < farInterval)
+                relayDistance = std::min(relayDistance, sWorld->getFloatConfig(CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE));
+            else
+                _lastFarMovementRelayTime = now;
+        }
+    }
+    else
+        _lastFarMovementRelayTime = GameTime::GetGameTimeMS();
+
+    // a mind controlled player still sees its own movement
+    if (plrMover && plrMover != _player)
+        plrMover->SendDirectMessage(moveUpdate.GetRawPacket());
+
+    Trinity::PacketSenderRef sender(moveUpdate.GetRawPacket());
+    Trinity::MessageDistDeliverer<Trinity::PacketSenderRef> notifier(mover, sender, relayDistance, false, _player);
+    Cell::VisitWorldObjects(mover, notifier, relayDistance);
 
     if (plrMover)                                            // nothing is charmed, or player charmed
     {
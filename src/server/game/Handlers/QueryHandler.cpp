@@ -196,35 +196,21 @@ void WorldSession::HandleNpcTextQueryOpcode(WorldPackets::Query::QueryNPCText& p
 /// Only _static_ data is sent in this packet !!!
 void WorldSession::HandleQueryPageText(WorldPackets::Query::QueryPageText& packet)
 {
-    WorldPackets::Query::QueryPageTextResponse response;
-    response.PageTextID = packet.PageTextID;
-
-    uint32 pageID = packet.PageTextID;
-    while (pageID)
+    LocaleConstant locale = GetSessionDbLocaleIndex();
+    if (sWorld->getBoolConfig(CONFIG_CACHE_DATA_QUERIES))
     {
-        PageText const* pageText = sObjectMgr->GetPageText(pageID);
-        if (!pageText)
-            break;
-
-        WorldPackets::Query::QueryPageTextResponse::PageTextInfo page;
-        page.ID = pageID;
-        page.NextPageID = pageText->NextPageID;
-        page.Text = pageText->Text;
-        page.PlayerConditionID = pageText->PlayerConditionID;
-        page.Flags = pageText->Flags;
-
-        LocaleConstant locale = GetSessionDbLocaleIndex();
-        if (locale != LOCALE_enUS)
-            if (PageTextLocale const* pageTextLocale = sObjectMgr->GetPageTextLocale(pageID))
-                ObjectMgr::GetLocaleString(pageTextLocale->Text, locale, page.Text);
-
-        response.Pages.push_back(page);
-        pageID = pageText->NextPageID;
+        if (PageText const* pageText = sObjectMgr->GetPageText(packet.PageTextID))
+        {
+            if (pageText->QueryData[locale])
+            {
+                SendPacket(pageText->QueryData[locale]);
+                return;
+            }
+        }
     }
 
-    response.Allow = !response.Pages.empty();
-
-    SendPacket(response.Write());
+    WorldPacket response = sObjectMgr->BuildPageTextQueryData(packet.PageTextID, locale);
+    SendPacket(&response);
 }
 
 void WorldSession::HandleQueryCorpseTransport(WorldPackets::Query::QueryCorpseTransport& queryCorpseTransport)
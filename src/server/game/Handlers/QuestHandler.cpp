@@ -70,6 +70,7 @@ void WorldSession::HandleQuestgiverStatusQueryOpcode(WorldPackets::Quest::QuestG
     }
 
     //inform client about status of quest
+    _player->SetSentQuestGiverStatus(packet.QuestGiverGUID, questStatus);
     _player->PlayerTalkClass->SendQuestGiverStatus(questStatus, packet.QuestGiverGUID);
 }
 
@@ -255,7 +255,7 @@ void WorldSession::HandleOpenWrappedItemCallback(uint16 pos, ObjectGuid itemGuid
     uint32 flags = fields[1].GetUInt32();
 
     item->SetGiftCreator(ObjectGuid::Empty);
-    item->SetEntry(entry);
+    GetPlayer()->ChangeStoredItemEntry(item, entry);
     item->ReplaceAllItemFlags(ItemFieldFlags(flags));
     item->SetMaxDurability(item->GetTemplate()->MaxDurability);
     item->SetState(ITEM_CHANGED, GetPlayer());
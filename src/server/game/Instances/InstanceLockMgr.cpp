@@ -159,7 +159,7 @@ void InstanceLockMgr::Load()
             instanceLock->GetData()->CompletedEncountersMask = fields[6].GetUInt32();
             instanceLock->SetExtended(fields[8].GetBool());
 
-            _instanceLocksByPlayer[playerGuid][InstanceLockKey{ mapId, lockId }].reset(instanceLock);
+            GetLockShard(playerGuid).InstanceLocksByPlayer[playerGuid][InstanceLockKey{ mapId, lockId }].reset(instanceLock);
 
         } while (result->NextRow());
     }
@@ -168,7 +168,11 @@ void InstanceLockMgr::Load()
 void InstanceLockMgr::Unload()
 {
     _unloading = true;
-    _instanceLocksByPlayer.clear();
+    for (LockShard& shard : _lockShards)
+    {
+        shard.TemporaryInstanceLocksByPlayer.clear();
+        shard.InstanceLocksByPlayer.clear();
+    }
     _instanceLockDataById.clear();
 }
 
@@ -216,9 +220,10 @@ InstanceLock* InstanceLockMgr::FindActiveInstanceLock(ObjectGuid const& playerGu
     if (!entries.MapDifficulty->HasResetSchedule())
         return nullptr;
 
-    std::shared_lock<std::shared_mutex> guard(_locksMutex);
+    LockShard const& shard = GetLockShard(playerGuid);
+    std::shared_lock<std::shared_mutex> guard(shard.Mutex);
 
-    InstanceLock* lock = FindInstanceLock(_instanceLocksByPlayer, playerGuid, entries);
+    InstanceLock* lock = FindInstanceLock(shard.InstanceLocksByPlayer, playerGuid, entries);
 
     // Ignore expired and not extended locks
     if (lock && (!lock->IsExpired() || lock->IsExtended() || !ignoreExpired))
@@ -227,15 +232,16 @@ InstanceLock* InstanceLockMgr::FindActiveInstanceLock(ObjectGuid const& playerGu
     if (ignoreTemporary)
         return nullptr;
 
-    return FindInstanceLock(_temporaryInstanceLocksByPlayer, playerGuid, entries);
+    return FindInstanceLock(shard.TemporaryInstanceLocksByPlayer, playerGuid, entries);
 }
 
 // used in world update thread (THREADUNSAFE packets) - no locking neccessary
 std::vector<InstanceLock const*> InstanceLockMgr::GetInstanceLocksForPlayer(ObjectGuid const& playerGuid) const
 {
     std::vector<InstanceLock const*> locks;
-    auto playerLocksItr = _instanceLocksByPlayer.find(playerGuid);
-    if (playerLocksItr != _instanceLocksByPlayer.end())
+    LockShard const& shard = GetLockShard(playerGuid);
+    auto playerLocksItr = shard.InstanceLocksByPlayer.find(playerGuid);
+    if (playerLocksItr != shard.InstanceLocksByPlayer.end())
     {
         locks.reserve(playerLocksItr->second.size());
         std::transform(playerLocksItr->second.begin(), playerLocksItr->second.end(), std::back_inserter(locks),
@@ -265,7 +271,12 @@ InstanceLock* InstanceLockMgr::CreateInstanceLockForNewInstance(ObjectGuid const
 
     instanceLock->SetIsNew(true);
 
-    _temporaryInstanceLocksByPlayer[playerGuid][entries.GetKey()].reset(instanceLock);
+    {
+        LockShard& shard = GetLockShard(playerGuid);
+        std::unique_lock<std::shared_mutex> guard(shard.Mutex);
+        shard.TemporaryInstanceLocksByPlayer[playerGuid][entries.GetKey()].reset(instanceLock);
+    }
+
     TC_LOG_DEBUG("instance.locks", "[{}-{} | {}-{}] Created new temporary instance lock for {} in instance {}",
         entries.Map->ID, entries.Map->MapName[sWorld->GetDefaultDbcLocale()],
         uint32(entries.MapDifficulty->DifficultyID), sDifficultyStore.AssertEntry(entries.MapDifficulty->DifficultyID)->Name[sWorld->GetDefaultDbcLocale()],
@@ -279,23 +290,24 @@ InstanceLock* InstanceLockMgr::UpdateInstanceLockForPlayer(CharacterDatabaseTran
     InstanceLock* instanceLock = FindActiveInstanceLock(playerGuid, entries, true, true);
     if (!instanceLock)
     {
-        std::unique_lock<std::shared_mutex> guard(_locksMutex);
+        LockShard& shard = GetLockShard(playerGuid);
+        std::unique_lock<std::shared_mutex> guard(shard.Mutex);
 
         // Move lock from temporary storage if it exists there
         // This is to avoid destroying expired locks before any boss is killed in a fresh lock
         // player can still change his mind, exit instance and reactivate old lock
-        auto playerLocksItr = _temporaryInstanceLocksByPlayer.find(playerGuid);
-        if (playerLocksItr != _temporaryInstanceLocksByPlayer.end())
+        auto playerLocksItr = shard.TemporaryInstanceLocksByPlayer.find(playerGuid);
+        if (playerLocksItr != shard.TemporaryInstanceLocksByPlayer.end())
         {
             auto lockItr = playerLocksItr->second.find(entries.GetKey());
             if (lockItr != playerLocksItr->second.end())
             {
                 instanceLock = lockItr->second.release();
-                _instanceLocksByPlayer[playerGuid][entries.GetKey()].reset(instanceLock);
+                shard.InstanceLocksByPlayer[playerGuid][entries.GetKey()].reset(instanceLock);
 
                 playerLocksItr->second.erase(lockItr);
                 if (playerLocksItr->second.empty())
-                    _temporaryInstanceLocksByPlayer.erase(playerLocksItr);
+                    shard.TemporaryInstanceLocksByPlayer.erase(playerLocksItr);
 
                 TC_LOG_DEBUG("instance.locks", "[{}-{} | {}-{}] Promoting temporary lock to permanent for {} in instance {}",
                     entries.Map->ID, entries.Map->MapName[sWorld->GetDefaultDbcLocale()],
@@ -322,9 +334,10 @@ InstanceLock* InstanceLockMgr::UpdateInstanceLockForPlayer(CharacterDatabaseTran
                 GetNextResetTime(entries), updateEvent.InstanceId);
 
         {
-            std::unique_lock<std::shared_mutex> guard(_locksMutex);
+            LockShard& shard = GetLockShard(playerGuid);
+            std::unique_lock<std::shared_mutex> guard(shard.Mutex);
 
-            _instanceLocksByPlayer[playerGuid][entries.GetKey()].reset(instanceLock);
+            shard.InstanceLocksByPlayer[playerGuid][entries.GetKey()].reset(instanceLock);
         }
 
         TC_LOG_DEBUG("instance.locks", "[{}-{} | {}-{}] Created new instance lock for {} in instance {}",
@@ -476,8 +489,9 @@ std::pair<InstanceResetTimePoint, InstanceResetTimePoint> InstanceLockMgr::Updat
 void InstanceLockMgr::ResetInstanceLocksForPlayer(ObjectGuid const& playerGuid, Optional<uint32> mapId, Optional<Difficulty> difficulty,
     std::vector<InstanceLock const*>* locksReset, std::vector<InstanceLock const*>* locksFailedToReset)
 {
-    auto playerLocksItr = _instanceLocksByPlayer.find(playerGuid);
-    if (playerLocksItr == _instanceLocksByPlayer.end())
+    LockShard const& shard = GetLockShard(playerGuid);
+    auto playerLocksItr = shard.InstanceLocksByPlayer.find(playerGuid);
+    if (playerLocksItr == shard.InstanceLocksByPlayer.end())
         return;
 
     for (PlayerLockMap::value_type const& playerLockPair : playerLocksItr->second)
@@ -526,7 +540,8 @@ InstanceLocksStatistics InstanceLockMgr::GetStatistics() const
 {
     InstanceLocksStatistics statistics;
     statistics.InstanceCount = _instanceLockDataById.size();
-    statistics.PlayerCount = _instanceLocksByPlayer.size();
+    for (LockShard const& shard : _lockShards)
+        statistics.PlayerCount += shard.InstanceLocksByPlayer.size();
     return statistics;
 }
 
@@ -24,6 +24,7 @@
 #include "Hash.h"
 #include "ObjectGuid.h"
 #include "Optional.h"
+#include <array>
 #include <shared_mutex>
 #include <unordered_map>
 
@@ -305,12 +306,23 @@ private:
     using PlayerLockMap = std::unordered_map<InstanceLockKey, std::unique_ptr<InstanceLock>>;
     using LockMap = std::unordered_map<ObjectGuid, PlayerLockMap>;
 
+    // player locks are split by player guid so that lookups from different map threads rarely wait for each other
+    struct LockShard
+    {
+        mutable std::shared_mutex Mutex;
+        LockMap TemporaryInstanceLocksByPlayer; // locks stored here before any boss gets killed
+        LockMap InstanceLocksByPlayer;
+    };
+
+    static constexpr std::size_t LOCK_SHARD_COUNT = 32;
+
+    LockShard& GetLockShard(ObjectGuid const& playerGuid) { return _lockShards[playerGuid.GetCounter() % LOCK_SHARD_COUNT]; }
+    LockShard const& GetLockShard(ObjectGuid const& playerGuid) const { return _lockShards[playerGuid.GetCounter() % LOCK_SHARD_COUNT]; }
+
     static InstanceLock* FindInstanceLock(LockMap const& locks, ObjectGuid const& playerGuid, MapDb2Entries const& entries);
     InstanceLock* FindActiveInstanceLock(ObjectGuid const& playerGuid, MapDb2Entries const& entries, bool ignoreTemporary, bool ignoreExpired) const;
 
-    mutable std::shared_mutex _locksMutex;
-    LockMap _temporaryInstanceLocksByPlayer; // locks stored here before any boss gets killed
-    LockMap _instanceLocksByPlayer;
+    std::array<LockShard, LOCK_SHARD_COUNT> _lockShards;
     std::unordered_map<uint32, std::weak_ptr<SharedInstanceLockData>> _instanceLockDataById;
     bool _unloading = false;
 };
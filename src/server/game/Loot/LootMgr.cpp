@@ -28,6 +28,7 @@
 #include "SpellInfo.h"
 #include "SpellMgr.h"
 #include "World.h"
+#include "WorldDatabaseSnapshot.h"
 
 static Rates const qualityToRate[MAX_ITEM_QUALITY] =
 {
@@ -105,8 +106,15 @@ class LootTemplate::LootGroup                               // A set of loot def
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
 
+        // Lookup tables built at loading stage, used when no entry can be filtered out before rolling
+        std::vector<LootStoreItem const*> ExplicitlyChancedTable;
+        std::vector<float> ExplicitlyChancedCumulative;     // running chance sum, infinite from the first entry with 100% chance
+        std::vector<LootStoreItem const*> EqualChancedTable;
+        uint16 UniformLootMode = 0;                         // loot mode shared by all entries, 0 if they differ
+
         // Rolls an item from the group, returns NULL if all miss their chances
         LootStoreItem const* Roll(uint16 lootMode, Player const* personalLooter = nullptr) const;
+        LootStoreItem const* RollUnfiltered() const;
 };
 
 //Remove all data and free all memory
@@ -135,7 +143,7 @@ uint32 LootStore::LoadLootTable()
     Clear();
 
     //                                                  0     1            2               3         4         5             6
-    QueryResult result = WorldDatabase.PQuery("SELECT Entry, Item, Reference, Chance, QuestRequired, LootMode, GroupId, MinCount, MaxCount FROM {}", GetName());
+    QueryResult result = sWorldDatabaseSnapshot->StreamQuery(Trinity::StringFormat("SELECT Entry, Item, Reference, Chance, QuestRequired, LootMode, GroupId, MinCount, MaxCount FROM {}", GetName()).c_str());
 
     if (!result)
         return 0;
@@ -371,15 +379,38 @@ LootTemplate::LootGroup::~LootGroup()
 // Adds an entry to the group (at loading stage)
 void LootTemplate::LootGroup::AddEntry(LootStoreItem* item)
 {
+    if (ExplicitlyChanced.empty() && EqualChanced.empty())
+        UniformLootMode = item->lootmode;
+    else if (UniformLootMode != item->lootmode)
+        UniformLootMode = 0;
+
     if (item->chance != 0)
+    {
         ExplicitlyChanced.push_back(item);
+
+        float cumulative = ExplicitlyChancedCumulative.empty() ? 0.0f : ExplicitlyChancedCumulative.back();
+        if (item->chance >= 100.0f)
+            cumulative = std::numeric_limits<float>::infinity();
+        else
+            cumulative += item->chance;
+
+        ExplicitlyChancedTable.push_back(item);
+        ExplicitlyChancedCumulative.push_back(cumulative);
+    }
     else
+    {
         EqualChanced.push_back(item);
+        EqualChancedTable.push_back(item);
+    }
 }
 
 // Rolls an item from the group, returns NULL if all miss their chances
 LootStoreItem const* LootTemplate::LootGroup::Roll(uint16 lootMode, Player const* personalLooter /*= nullptr*/) const
 {
+    // Nothing can be filtered out - resolve the roll from the precomputed tables
+    if (!personalLooter && (UniformLootMode & lootMode))
+        return RollUnfiltered();
+
     LootStoreItemList possibleLoot = ExplicitlyChanced;
     possibleLoot.remove_if(LootGroupInvalidSelector(lootMode, personalLooter));
 
@@ -407,6 +438,24 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(uint16 lootMode, Player const
     return nullptr;                                            // Empty drop from the group
 }
 
+// Same as Roll when every entry of the group is valid, using one draw and a binary search
+LootStoreItem const* LootTemplate::LootGroup::RollUnfiltered() const
+{
+    if (!ExplicitlyChancedTable.empty())
+    {
+        float roll = (float)rand_chance();
+
+        auto itr = std::upper_bound(ExplicitlyChancedCumulative.begin(), ExplicitlyChancedCumulative.end(), roll);
+        if (itr != ExplicitlyChancedCumulative.end())
+            return ExplicitlyChancedTable[std::distance(ExplicitlyChancedCumulative.begin(), itr)];
+    }
+
+    if (!EqualChancedTable.empty())
+        return Trinity::Containers::SelectRandomContainerElement(EqualChancedTable);
+
+    return nullptr;
+}
+
 bool LootTemplate::LootGroup::HasDropForPlayer(Player const* player, bool strictUsabilityCheck) const
 {
     for (LootStoreItem const* lootStoreItem : ExplicitlyChanced)
@@ -893,7 +942,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
         {
             if ((*i)->itemid == uint32(cond->SourceEntry))
             {
-                (*i)->conditions.push_back(cond);
+                ConditionMgr::AddToConditionContainer((*i)->conditions, cond);
                 return true;
             }
         }
@@ -914,7 +963,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
-                        (*i)->conditions.push_back(cond);
+                        ConditionMgr::AddToConditionContainer((*i)->conditions, cond);
                         return true;
                     }
                 }
@@ -927,7 +976,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
-                        (*i)->conditions.push_back(cond);
+                        ConditionMgr::AddToConditionContainer((*i)->conditions, cond);
                         return true;
                     }
                 }
@@ -21,6 +21,8 @@
 #include "Log.h"
 #include <G3D/Plane.h>
 #include <G3D/Ray.h>
+#include <algorithm>
+#include <type_traits>
 
 // *****************************
 // Grid function
@@ -531,6 +533,61 @@ float GridMap::getHeightFromUint16(float x, float y) const
     return (float)((a * x) + (b * y) + c)*_gridIntHeightMultiplier + _gridHeight;
 }
 
+void GridMap::getHeights(float const* x, float const* y, float* heights, std::size_t count) const
+{
+    // the storage is checked once for the whole batch instead of calling through _gridGetHeight for every point
+    if (_gridGetHeight == &GridMap::getHeightFromFloat && m_V8 && m_V9)
+        getHeightsFromArray(m_V9, m_V8, x, y, heights, count);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint16 && m_uint16_V8 && m_uint16_V9)
+        getHeightsFromArray(m_uint16_V9, m_uint16_V8, x, y, heights, count);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint8 && m_uint8_V8 && m_uint8_V9)
+        getHeightsFromArray(m_uint8_V9, m_uint8_V8, x, y, heights, count);
+    else
+        std::fill_n(heights, count, _gridHeight);
+}
+
+template<typename T>
+void GridMap::getHeightsFromArray(T const* v9, T const* v8, float const* x, float const* y, float* heights, std::size_t count) const
+{
+    // integer heights are interpolated as integers like getHeightFromUint8 and getHeightFromUint16 do
+    using Height = std::conditional_t<std::is_same_v<T, float>, float, int32>;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float px = MAP_RESOLUTION * (CENTER_GRID_ID - x[i] / SIZE_OF_GRIDS);
+        float py = MAP_RESOLUTION * (CENTER_GRID_ID - y[i] / SIZE_OF_GRIDS);
+
+        int x_int = (int)px;
+        int y_int = (int)py;
+        px -= x_int;
+        py -= y_int;
+        x_int &= (MAP_RESOLUTION - 1);
+        y_int &= (MAP_RESOLUTION - 1);
+
+        // all four triangles are computed and the right one is selected, the same way as the single point functions
+        T const* V9_h1_ptr = &v9[x_int * 129 + y_int];
+        Height h1 = V9_h1_ptr[0];
+        Height h2 = V9_h1_ptr[129];
+        Height h3 = V9_h1_ptr[1];
+        Height h4 = V9_h1_ptr[130];
+        Height h5 = 2 * Height(v8[x_int * 128 + y_int]);
+
+        bool lower = px + py < 1;
+        bool right = px > py;
+        Height a = lower ? (right ? h2 - h1 : h5 - h1 - h3) : (right ? h2 + h4 - h5 : h4 - h3);
+        Height b = lower ? (right ? h5 - h1 - h2 : h3 - h1) : (right ? h4 - h2 : h3 + h4 - h5);
+        Height c = lower ? h1 : h5 - h4;
+
+        float height;
+        if constexpr (std::is_same_v<T, float>)
+            height = a * px + b * py + c;
+        else
+            height = (float)((a * px) + (b * py) + c) * _gridIntHeightMultiplier + _gridHeight;
+
+        heights[i] = isHole(x_int, y_int) ? INVALID_HEIGHT : height;
+    }
+}
+
 bool GridMap::isHole(int row, int col) const
 {
     if (!_holes)
@@ -78,6 +78,8 @@ class TC_GAME_API GridMap
     float getHeightFromUint16(float x, float y) const;
     float getHeightFromUint8(float x, float y) const;
     float getHeightFromFlat(float x, float y) const;
+    template<typename T>
+    void getHeightsFromArray(T const* v9, T const* v8, float const* x, float const* y, float* heights, std::size_t count) const;
 
 public:
     GridMap();
@@ -95,6 +97,8 @@ public:
 
     uint16 getArea(float x, float y) const;
     float getHeight(float x, float y) const { return (this->*_gridGetHeight)(x, y); }
+    // same as getHeight for count points at once
+    void getHeights(float const* x, float const* y, float* heights, std::size_t count) const;
     float getMinHeight(float x, float y) const;
     float getLiquidLevel(float x, float y) const;
     ZLiquidStatus GetLiquidStatus(float x, float y, float z, Optional<map_liquidHeaderTypeFlags> ReqLiquidType, LiquidData* data = nullptr, float collisionHeight = 2.03128f) const; // DEFAULT_COLLISION_HEIGHT in Object.h
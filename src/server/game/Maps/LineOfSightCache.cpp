@@ -0,0 +1,77 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LineOfSightCache.h"
+#include "Hash.h"
+#include <cmath>
+
+Optional<uint32> LineOfSightCache::GetPhaseShiftId(PhaseShift const& phaseShift)
+{
+    std::size_t phaseShiftHash = phaseShift.GetCollisionHash();
+    std::lock_guard<std::mutex> lock(_lock);
+    for (std::size_t i = 0; i < _phaseShifts.size(); ++i)
+        if (_phaseShifts[i].first == phaseShiftHash && _phaseShifts[i].second.HasSameCollision(phaseShift))
+            return uint32(i);
+
+    if (_phaseShifts.size() >= MaxPhaseShifts)
+        return {};
+
+    _phaseShifts.emplace_back(phaseShiftHash, phaseShift);
+    return uint32(_phaseShifts.size() - 1);
+}
+
+LineOfSightCache::Key LineOfSightCache::MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseShiftId, uint32 flags)
+{
+    auto quantize = [](float coord) { return int32(std::lround(coord * Precision)); };
+    return { { quantize(x1), quantize(y1), quantize(z1), quantize(x2), quantize(y2), quantize(z2) }, phaseShiftId, flags };
+}
+
+Optional<bool> LineOfSightCache::Find(Key const& key) const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    auto itr = _results.find(key);
+    if (itr == _results.end())
+        return {};
+
+    return itr->second;
+}
+
+void LineOfSightCache::Store(Key const& key, bool inLineOfSight)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_results.size() >= MaxEntries)
+        return;
+
+    _results.emplace(key, inLineOfSight);
+}
+
+void LineOfSightCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _results.clear();
+    _phaseShifts.clear();
+}
+
+std::size_t LineOfSightCache::KeyHash::operator()(Key const& key) const
+{
+    std::size_t hashVal = 0;
+    for (int32 point : key.Points)
+        Trinity::hash_combine(hashVal, point);
+    Trinity::hash_combine(hashVal, key.PhaseShiftId);
+    Trinity::hash_combine(hashVal, key.Flags);
+    return hashVal;
+}
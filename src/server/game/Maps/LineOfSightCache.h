@@ -0,0 +1,68 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_LINE_OF_SIGHT_CACHE_H
+#define TRINITY_LINE_OF_SIGHT_CACHE_H
+
+#include "Define.h"
+#include "Optional.h"
+#include "PhaseShift.h"
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// Results of line of sight checks done during a single map update,
+/// spells and AI tend to check the same pairs of positions many times in a row
+class TC_GAME_API LineOfSightCache
+{
+public:
+    // endpoints are rounded to 1/8 yard
+    static constexpr float Precision = 8.0f;
+    static constexpr std::size_t MaxEntries = 4096;
+    static constexpr std::size_t MaxPhaseShifts = 64;
+
+    struct Key
+    {
+        std::array<int32, 6> Points;
+        uint32 PhaseShiftId;
+        uint32 Flags;
+
+        bool operator==(Key const& right) const = default;
+    };
+
+    // phase shifts with equal collision content share an id until Clear, nullopt once MaxPhaseShifts different ones were seen
+    Optional<uint32> GetPhaseShiftId(PhaseShift const& phaseShift);
+
+    static Key MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseShiftId, uint32 flags);
+
+    Optional<bool> Find(Key const& key) const;
+    void Store(Key const& key, bool inLineOfSight);
+    void Clear();
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const;
+    };
+
+    mutable std::mutex _lock;
+    std::unordered_map<Key, bool, KeyHash> _results;
+    std::vector<std::pair<std::size_t, PhaseShift>> _phaseShifts;
+};
+
+#endif // TRINITY_LINE_OF_SIGHT_CACHE_H
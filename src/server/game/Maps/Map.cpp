@@ -20,6 +20,7 @@
 #include "Battleground.h"
 #include "CellImpl.h"
 #include "CharacterPackets.h"
+#include "ConditionMgr.h"
 #include "Containers.h"
 #include "Conversation.h"
 #include "DatabaseEnv.h"
@@ -42,6 +43,7 @@
 #include "MiscPackets.h"
 #include "MMapFactory.h"
 #include "MotionMaster.h"
+#include "MoveSpline.h"
 #include "ObjectAccessor.h"
 #include "ObjectGridLoader.h"
 #include "ObjectMgr.h"
@@ -52,6 +54,8 @@
 #include "ScriptMgr.h"
 #include "SpellAuras.h"
 #include "TerrainMgr.h"
+#include "Trace.h"
+#include "ThreadPool.h"
 #include "Transport.h"
 #include "Vehicle.h"
 #include "VMapFactory.h"
@@ -63,6 +67,7 @@
 #include "WorldStateMgr.h"
 #include "WorldStatePackets.h"
 #include <boost/heap/fibonacci_heap.hpp>
+#include <future>
 #include <sstream>
 
 #include "Hacks/boost_1_74_fibonacci_heap.h"
@@ -144,11 +149,12 @@ void Map::DeleteStateMachine()
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, Difficulty SpawnMode) :
 _creatureToMoveLock(false), _gameObjectsToMoveLock(false), _dynamicObjectsToMoveLock(false), _areaTriggersToMoveLock(false),
 i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
-m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
+m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), _maxVisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
-i_gridExpiry(expiry), m_terrain(sTerrainMgr.LoadTerrain(id)),
-i_scriptLock(false), _respawnTimes(std::make_unique<RespawnListContainer>()), _respawnCheckTimer(0)
+i_gridExpiry(expiry), _lastUpdateDuration(0), _visibilityAdjustUpdateTime(0), _visibilityAdjustUpdateCount(0), m_terrain(sTerrainMgr.LoadTerrain(id)),
+i_scriptLock(false), _respawnTimes(std::make_unique<RespawnListContainer>()), _seenSpawnGroupConditionChangeCounters(), _changedSpawnGroupConditionTypes(0),
+_spawnGroupConditionsNeedFullUpdate(false), _respawnCheckTimer(0), _gridPreloadTimer(0)
 {
     for (uint32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
     {
@@ -160,11 +166,22 @@ i_scriptLock(false), _respawnTimes(std::make_unique<RespawnListContainer>()), _r
     }
 
     _zonePlayerCountMap.clear();
+    _zonePlayers.clear();
+
+    _updateTimeMetric = sMetric->RegisterHandle(MetricHandleType::Histogram, "map_update_time_diff", { TC_METRIC_TAG("map_id", std::to_string(GetId())) });
+    _creatureCountMetric = sMetric->RegisterHandle(MetricHandleType::Gauge, "map_creatures",
+        { TC_METRIC_TAG("map_id", std::to_string(GetId())), TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())) });
+    _gameObjectCountMetric = sMetric->RegisterHandle(MetricHandleType::Gauge, "map_gameobjects",
+        { TC_METRIC_TAG("map_id", std::to_string(GetId())), TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())) });
+    _visibilityDistanceMetric = sMetric->RegisterHandle(MetricHandleType::Gauge, "map_visibility_distance",
+        { TC_METRIC_TAG("map_id", std::to_string(GetId())), TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())) });
 
     //lets initialize visibility distance for map
     Map::InitVisibilityDistance();
 
     _weatherUpdateTimer.SetInterval(time_t(1 * IN_MILLISECONDS));
+    _coalescedObjectUpdateTimer.SetInterval(sWorld->getIntConfig(CONFIG_MAP_COALESCED_OBJECT_UPDATE_INTERVAL));
+    _visibilityAdjustTimer.SetInterval(time_t(1 * IN_MILLISECONDS));
 
     GetGuidSequenceGenerator(HighGuid::Transport).Set(sObjectMgr->GetGenerator<HighGuid::Transport>().GetNextAfterMaxUsed());
 
@@ -186,6 +203,7 @@ void Map::InitVisibilityDistance()
 {
     //init visibility for continents
     m_VisibleDistance = World::GetMaxVisibleDistanceOnContinents();
+    _maxVisibleDistance = m_VisibleDistance;
     m_VisibilityNotifyPeriod = World::GetVisibilityNotifyPeriodOnContinents();
 }
 
@@ -324,6 +342,11 @@ void Map::DeleteFromWorld(Player* player)
     delete player;
 }
 
+static Trinity::ThreadPool* GetAsyncTerrainLoadPool()
+{
+    return sWorld->getBoolConfig(CONFIG_MAP_ASYNC_TERRAIN_LOADING) ? sMapMgr->GetGridPreloadPool() : nullptr;
+}
+
 //Create NGrid so the object can be added to it
 //But object data is not loaded here
 void Map::EnsureGridCreated(GridCoord const& p)
@@ -344,13 +367,34 @@ void Map::EnsureGridCreated(GridCoord const& p)
         int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
         int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
 
-        m_terrain->LoadMapAndVMap(gx, gy);
+        if (Trinity::ThreadPool* pool = GetAsyncTerrainLoadPool())
+            m_terrain->LoadMapAndVMapAsync(gx, gy, *pool);
+        else
+            m_terrain->LoadMapAndVMap(gx, gy);
     }
 }
 
 //Load NGrid and make it active
-void Map::EnsureGridLoadedForActiveObject(Cell const& cell, WorldObject const* object)
+void Map::EnsureGridLoadedForActiveObject(Cell const& cell, WorldObject const* object, bool deferUntilTerrainLoaded /*= false*/)
 {
+    if (deferUntilTerrainLoaded && GetAsyncTerrainLoadPool())
+    {
+        EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
+        if (!isGridObjectDataLoaded(cell.GridX(), cell.GridY())
+            && !m_terrain->IsGridResident((MAX_NUMBER_OF_GRIDS - 1) - cell.GridX(), (MAX_NUMBER_OF_GRIDS - 1) - cell.GridY()))
+        {
+            NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
+            if (grid->GetGridState() != GRID_STATE_ACTIVE)
+            {
+                ResetGridExpiry(*grid, 0.1f);
+                grid->SetGridState(GRID_STATE_ACTIVE);
+            }
+
+            _gridsWaitingForTerrain.emplace_back(cell, object->GetGUID());
+            return;
+        }
+    }
+
     EnsureGridLoaded(cell);
     NGridType *grid = getNGrid(cell.GridX(), cell.GridY());
     ASSERT(grid != nullptr);
@@ -380,6 +424,9 @@ bool Map::EnsureGridLoaded(Cell const& cell)
 
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
 
+        // spawning needs terrain, wait for the files if they are still being read in the background
+        m_terrain->WaitForGrid((MAX_NUMBER_OF_GRIDS - 1) - cell.GridX(), (MAX_NUMBER_OF_GRIDS - 1) - cell.GridY());
+
         LoadGridObjects(grid, cell);
 
         Balance();
@@ -389,6 +436,34 @@ bool Map::EnsureGridLoaded(Cell const& cell)
     return false;
 }
 
+void Map::LoadGridsWaitingForTerrain()
+{
+    if (_gridsWaitingForTerrain.empty())
+        return;
+
+    // loading objects can relocate active objects into other waiting grids
+    std::vector<std::pair<Cell, ObjectGuid>> waiting;
+    waiting.swap(_gridsWaitingForTerrain);
+
+    for (auto const& [cell, objectGuid] : waiting)
+    {
+        NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
+        if (!grid)
+            continue;
+
+        if (!m_terrain->IsGridResident((MAX_NUMBER_OF_GRIDS - 1) - cell.GridX(), (MAX_NUMBER_OF_GRIDS - 1) - cell.GridY()))
+        {
+            _gridsWaitingForTerrain.emplace_back(cell, objectGuid);
+            continue;
+        }
+
+        EnsureGridLoaded(cell);
+
+        if (Player* player = ObjectAccessor::GetPlayer(this, objectGuid))
+            GetMultiPersonalPhaseTracker().LoadGrid(player->GetPhaseShift(), *grid, this, cell);
+    }
+}
+
 void Map::LoadGridObjects(NGridType* grid, Cell const& cell)
 {
     ObjectGridLoader loader(*grid, this, cell);
@@ -428,6 +503,97 @@ void Map::LoadGridForActiveObject(float x, float y, WorldObject const* object)
     EnsureGridLoadedForActiveObject(Cell(x, y), object);
 }
 
+void Map::PreloadGridsAhead()
+{
+    // runs every GridPreloadInterval, each run samples the predicted positions every SampleInterval of the next LookAhead
+    static constexpr Milliseconds LookAhead = 30s;
+    static constexpr Milliseconds SampleInterval = 2s;
+
+    ReleasePreloadedGrids(false);
+
+    TimePoint now = GameTime::Now();
+    for (MapReference const& ref : m_mapRefManager)
+    {
+        Player const* player = ref.GetSource();
+        if (!player || !player->IsInWorld())
+            continue;
+
+        // taxi flights and other splines know exactly where the player will be
+        if (!player->movespline->Finalized())
+        {
+            // positions of passengers are relative to their transport
+            if (player->movespline->onTransport)
+                continue;
+
+            for (Milliseconds offset = SampleInterval; offset <= LookAhead; offset += SampleInterval)
+            {
+                Movement::Location location = player->movespline->ComputePosition(offset.count());
+                PreloadGrid(location.x, location.y, now);
+            }
+        }
+        else if (player->HasUnitMovementFlag(MOVEMENTFLAG_FORWARD))
+        {
+            // only fast movement can reach grids that are not created around the player yet
+            float speed = player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : MOVE_RUN);
+            if (speed * LookAhead.count() / IN_MILLISECONDS < SIZE_OF_GRIDS / 2)
+                continue;
+
+            for (Milliseconds offset = SampleInterval; offset <= LookAhead; offset += SampleInterval)
+            {
+                float distance = speed * offset.count() / IN_MILLISECONDS;
+                PreloadGrid(player->GetPositionX() + distance * std::cos(player->GetOrientation()),
+                    player->GetPositionY() + distance * std::sin(player->GetOrientation()), now);
+            }
+        }
+    }
+}
+
+void Map::PreloadGrid(float x, float y, TimePoint now)
+{
+    static constexpr Milliseconds Expiry = 1min;
+
+    GridCoord p = Trinity::ComputeGridCoord(x, y);
+    if (!p.IsCoordValid() || getNGrid(p.x_coord, p.y_coord))
+        return;
+
+    auto [itr, inserted] = _preloadedGrids.try_emplace(p.GetId());
+    itr->second.Expiry = now + Expiry;
+    if (!inserted)
+        return;
+
+    TC_LOG_DEBUG("maps", "Preloading terrain of grid[{}, {}] for map {} instance {}", p.x_coord, p.y_coord, GetId(), i_InstanceId);
+
+    int32 gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+    int32 gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+    std::packaged_task<void()> task([terrain = m_terrain, gx, gy]()
+    {
+        terrain->LoadMapAndVMap(gx, gy);
+    });
+    itr->second.Loaded = task.get_future();
+    sMapMgr->GetGridPreloadPool()->PostWork(std::move(task));
+}
+
+void Map::ReleasePreloadedGrids(bool all)
+{
+    TimePoint now = GameTime::Now();
+    for (auto itr = _preloadedGrids.begin(); itr != _preloadedGrids.end();)
+    {
+        uint32 x = itr->first % MAX_NUMBER_OF_GRIDS;
+        uint32 y = itr->first / MAX_NUMBER_OF_GRIDS;
+        if (all)
+            itr->second.Loaded.wait();
+        else if (itr->second.Loaded.wait_for(0s) != std::future_status::ready || (!getNGrid(x, y) && itr->second.Expiry > now))
+        {
+            ++itr;
+            continue;
+        }
+
+        // the grid holds its own reference once created
+        m_terrain->UnloadMap((MAX_NUMBER_OF_GRIDS - 1) - x, (MAX_NUMBER_OF_GRIDS - 1) - y);
+        itr = _preloadedGrids.erase(itr);
+    }
+}
+
 bool Map::AddPlayerToMap(Player* player, bool initPlayer /*= true*/)
 {
     CellCoord cellCoord = Trinity::ComputeCellCoord(player->GetPositionX(), player->GetPositionY());
@@ -452,7 +618,10 @@ bool Map::AddPlayerToMap(Player* player, bool initPlayer /*= true*/)
     SendInitTransports(player);
 
     if (initPlayer)
+    {
         player->m_clientGUIDs.clear();
+        player->ClearPendingVisibleObjects();
+    }
 
     player->UpdateObjectVisibility(false);
     PhasingHandler::SendToPlayer(player);
@@ -489,30 +658,58 @@ void Map::SetWorldStateValue(int32 worldStateId, int32 value, bool hidden)
         return;
 
     itr->second = value;
+    _changedSpawnGroupConditionTypes |= UI64LIT(1) << CONDITION_WORLD_STATE;
 
     WorldStateTemplate const* worldStateTemplate = sWorldStateMgr->GetWorldStateTemplate(worldStateId);
     if (worldStateTemplate)
         sScriptMgr->OnWorldStateValueChange(worldStateTemplate, oldValue, value, this);
 
-    // Broadcast update to all players on the map
-    WorldPackets::WorldState::UpdateWorldState updateWorldState;
-    updateWorldState.VariableID = worldStateId;
-    updateWorldState.Value = value;
-    updateWorldState.Hidden = hidden;
-    updateWorldState.Write();
+    // Broadcast update to players on the map at the end of this update
+    _pendingWorldStateUpdates[worldStateId] = { .Value = value, .Hidden = hidden };
+}
 
-    for (MapReference const& mapReference : m_mapRefManager)
+void Map::SendWorldStateUpdates()
+{
+    if (_pendingWorldStateUpdates.empty())
+        return;
+
+    for (auto const& [worldStateId, pendingUpdate] : _pendingWorldStateUpdates)
     {
-        if (worldStateTemplate && !worldStateTemplate->AreaIds.empty())
+        WorldPackets::WorldState::UpdateWorldState updateWorldState;
+        updateWorldState.VariableID = worldStateId;
+        updateWorldState.Value = pendingUpdate.Value;
+        updateWorldState.Hidden = pendingUpdate.Hidden;
+        updateWorldState.Write();
+
+        WorldStateTemplate const* worldStateTemplate = sWorldStateMgr->GetWorldStateTemplate(worldStateId);
+        if (!worldStateTemplate || worldStateTemplate->AreaIds.empty())
         {
-            bool isInAllowedArea = std::any_of(worldStateTemplate->AreaIds.begin(), worldStateTemplate->AreaIds.end(),
-                [playerAreaId = mapReference.GetSource()->GetAreaId()](uint32 requiredAreaId) { return DB2Manager::IsInArea(playerAreaId, requiredAreaId); });
-            if (!isInAllowedArea)
-                continue;
+            for (MapReference const& mapReference : m_mapRefManager)
+                mapReference.GetSource()->SendDirectMessage(updateWorldState.GetRawPacket());
+
+            continue;
         }
 
-        mapReference.GetSource()->SendDirectMessage(updateWorldState.GetRawPacket());
+        // area limited world states are only sent to players of zones containing one of the required areas
+        for (uint32 zoneId : worldStateTemplate->ZoneIds)
+        {
+            std::vector<Player*> const* zonePlayers = Trinity::Containers::MapGetValuePtr(_zonePlayers, zoneId);
+            if (!zonePlayers)
+                continue;
+
+            for (Player* player : *zonePlayers)
+            {
+                bool isInAllowedArea = std::any_of(worldStateTemplate->AreaIds.begin(), worldStateTemplate->AreaIds.end(),
+                    [playerAreaId = player->GetAreaId()](uint32 requiredAreaId) { return DB2Manager::IsInArea(playerAreaId, requiredAreaId); });
+                if (!isInAllowedArea)
+                    continue;
+
+                player->SendDirectMessage(updateWorldState.GetRawPacket());
+            }
+        }
     }
+
+    _pendingWorldStateUpdates.clear();
 }
 
 template<class T>
@@ -649,7 +846,34 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
     }
 }
 
-void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
+void Map::MarkCellsNearPlayers(float distance)
+{
+    _cellsNearPlayers.reset();
+
+    auto markCellsAround = [&](WorldObject const* obj)
+    {
+        if (!obj->IsPositionValid())
+            return;
+
+        CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), distance);
+        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+                _cellsNearPlayers.set((y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x);
+    };
+
+    for (MapReference const& ref : m_mapRefManager)
+    {
+        Player const* player = ref.GetSource();
+        if (!player || !player->IsInWorld())
+            continue;
+
+        markCellsAround(player);
+        if (WorldObject const* viewPoint = player->GetViewpoint())
+            markCellsAround(viewPoint);
+    }
+}
+
+void Map::UpdatePlayerZoneStats(Player* player, uint32 oldZone, uint32 newZone)
 {
     // Nothing to do if no change
     if (oldZone == newZone)
@@ -660,14 +884,40 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
         uint32& oldZoneCount = _zonePlayerCountMap[oldZone];
         ASSERT(oldZoneCount, "A player left zone %u (went to %u) - but there were no players in the zone!", oldZone, newZone);
         --oldZoneCount;
+
+        if (std::vector<Player*>* zonePlayers = Trinity::Containers::MapGetValuePtr(_zonePlayers, oldZone))
+        {
+            auto itr = std::find(zonePlayers->begin(), zonePlayers->end(), player);
+            if (itr != zonePlayers->end())
+            {
+                *itr = zonePlayers->back();
+                zonePlayers->pop_back();
+            }
+        }
     }
     ++_zonePlayerCountMap[newZone];
+
+    if (newZone != MAP_INVALID_ZONE)
+        _zonePlayers[newZone].push_back(player);
 }
 
 void Map::Update(uint32 t_diff)
 {
+    TC_TRACE_ZONE("Map::Update");
+    MapUpdateProfiler::Update profile(_updateProfiler);
+    {
+        UpdateTask* task;
+        while (_updateTasks.Dequeue(task))
+        {
+            (*task)(this);
+            delete task;
+        }
+    }
+
     _dynamicTree.update(t_diff);
+    _lineOfSightCache.Clear();
     /// update worldsessions for existing players
+    profile.SetPhase(MAP_UPDATE_PHASE_SESSIONS);
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
         Player* player = m_mapRefIter->GetSource();
@@ -681,8 +931,10 @@ void Map::Update(uint32 t_diff)
     }
 
     /// process any due respawns
+    profile.SetPhase(MAP_UPDATE_PHASE_RESPAWNS);
     if (_respawnCheckTimer <= t_diff)
     {
+        TC_TRACE_ZONE("Map::ProcessRespawns");
         ProcessRespawns();
         UpdateSpawnGroupConditions();
         _respawnCheckTimer = sWorld->getIntConfig(CONFIG_RESPAWN_MINCHECKINTERVALMS);
@@ -690,10 +942,31 @@ void Map::Update(uint32 t_diff)
     else
         _respawnCheckTimer -= t_diff;
 
+    profile.SetPhase(MAP_UPDATE_PHASE_GRIDS);
+    if (sMapMgr->GetGridPreloadPool())
+    {
+        if (_gridPreloadTimer <= t_diff)
+        {
+            PreloadGridsAhead();
+            _gridPreloadTimer = GridPreloadInterval.count();
+        }
+        else
+            _gridPreloadTimer -= t_diff;
+    }
+
+    LoadGridsWaitingForTerrain();
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
-    Trinity::ObjectUpdater updater(t_diff);
+    uint32 creatureLodTicks = 0;
+    if (uint32 creatureLodDistance = sWorld->getIntConfig(CONFIG_MAP_UPDATE_CREATURE_LOD_DISTANCE))
+    {
+        MarkCellsNearPlayers(float(creatureLodDistance));
+        creatureLodTicks = sWorld->getIntConfig(CONFIG_MAP_UPDATE_CREATURE_LOD_TICKS);
+    }
+
+    Trinity::ObjectUpdater updater(t_diff, creatureLodTicks > 1 ? this : nullptr, creatureLodTicks, profile.IsActive() ? &profile : nullptr);
     // for creature
     TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
     // for pets
@@ -708,9 +981,13 @@ void Map::Update(uint32 t_diff)
         if (!player || !player->IsInWorld())
             continue;
 
+        TC_TRACE_ZONE("Map::Update player");
+
         // update players at tick
+        profile.SetPhase(MAP_UPDATE_PHASE_PLAYERS);
         player->Update(t_diff);
 
+        profile.SetPhase(MAP_UPDATE_PHASE_CELLS);
         VisitNearbyCellsOf(player, grid_object_update, world_object_update);
 
         // If player is using far sight or mind vision, visit that object too
@@ -765,9 +1042,11 @@ void Map::Update(uint32 t_diff)
         if (!obj || !obj->IsInWorld())
             continue;
 
+        TC_TRACE_ZONE("Map::Update active object");
         VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
     }
 
+    profile.SetPhase(MAP_UPDATE_PHASE_TRANSPORTS);
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
     {
         WorldObject* obj = *_transportsUpdateIter;
@@ -775,16 +1054,21 @@ void Map::Update(uint32 t_diff)
         obj->Update(t_diff);
     }
 
+    profile.SetPhase(MAP_UPDATE_PHASE_OBJECT_UPDATES);
+    _coalescedObjectUpdateTimer.Update(t_diff);
     SendObjectUpdates();
 
     ///- Process necessary scripts
+    profile.SetPhase(MAP_UPDATE_PHASE_SCRIPTS);
     if (!m_scriptSchedule.empty())
     {
+        TC_TRACE_ZONE("Map::ScriptsProcess");
         i_scriptLock = true;
         ScriptsProcess();
         i_scriptLock = false;
     }
 
+    profile.SetPhase(MAP_UPDATE_PHASE_OTHER);
     _weatherUpdateTimer.Update(t_diff);
     if (_weatherUpdateTimer.Passed())
     {
@@ -798,22 +1082,66 @@ void Map::Update(uint32 t_diff)
     // update phase shift objects
     GetMultiPersonalPhaseTracker().Update(this, t_diff);
 
+    profile.SetPhase(MAP_UPDATE_PHASE_MOVE_LISTS);
     MoveAllCreaturesInMoveList();
     MoveAllGameObjectsInMoveList();
     MoveAllAreaTriggersInMoveList();
 
+    profile.SetPhase(MAP_UPDATE_PHASE_RELOCATION_NOTIFIES);
     if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
         ProcessRelocationNotifies(t_diff);
 
+    profile.SetPhase(MAP_UPDATE_PHASE_SCRIPT_HOOK);
     sScriptMgr->OnMapUpdate(this, t_diff);
 
-    TC_METRIC_VALUE("map_creatures", uint64(GetObjectsStore().Size<Creature>()),
-        TC_METRIC_TAG("map_id", std::to_string(GetId())),
-        TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    profile.SetPhase(MAP_UPDATE_PHASE_OTHER);
+    SendWorldStateUpdates();
+
+    UpdateAdaptiveVisibilityDistance(t_diff);
 
-    TC_METRIC_VALUE("map_gameobjects", uint64(GetObjectsStore().Size<GameObject>()),
-        TC_METRIC_TAG("map_id", std::to_string(GetId())),
-        TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    TC_METRIC_HANDLE_VALUE(_creatureCountMetric, int64(GetObjectsStore().Size<Creature>()));
+    TC_METRIC_HANDLE_VALUE(_gameObjectCountMetric, int64(GetObjectsStore().Size<GameObject>()));
+}
+
+void Map::UpdateAdaptiveVisibilityDistance(uint32 diff)
+{
+    if (!sWorld->getBoolConfig(CONFIG_VISIBILITY_ADAPTIVE_ENABLED))
+    {
+        // restore the configured distance if the adaptive mode was disabled by a config reload
+        m_VisibleDistance = _maxVisibleDistance;
+        return;
+    }
+
+    // GetLastUpdateDuration still holds the duration of the previous call
+    _visibilityAdjustUpdateTime += GetLastUpdateDuration();
+    ++_visibilityAdjustUpdateCount;
+
+    _visibilityAdjustTimer.Update(diff);
+    if (!_visibilityAdjustTimer.Passed())
+        return;
+
+    _visibilityAdjustTimer.Reset();
+
+    Milliseconds averageUpdateTime = std::chrono::duration_cast<Milliseconds>(_visibilityAdjustUpdateTime / _visibilityAdjustUpdateCount);
+    _visibilityAdjustUpdateTime = Microseconds::zero();
+    _visibilityAdjustUpdateCount = 0;
+
+    uint32 maxZonePlayers = 0;
+    for (auto const& [zoneId, playerCount] : _zonePlayerCountMap)
+        maxZonePlayers = std::max(maxZonePlayers, playerCount);
+
+    float minDistance = std::min(sWorld->getFloatConfig(CONFIG_VISIBILITY_ADAPTIVE_MIN_DISTANCE), _maxVisibleDistance);
+    float step = (_maxVisibleDistance - minDistance) * 0.1f;
+    uint32 zonePlayerLimit = sWorld->getIntConfig(CONFIG_VISIBILITY_ADAPTIVE_MAX_ZONE_PLAYERS);
+
+    if (averageUpdateTime.count() > sWorld->getIntConfig(CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_HIGH)
+        || (zonePlayerLimit && maxZonePlayers > zonePlayerLimit))
+        m_VisibleDistance = std::max(m_VisibleDistance - step, minDistance);
+    else if (averageUpdateTime.count() < sWorld->getIntConfig(CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_LOW)
+        && (!zonePlayerLimit || maxZonePlayers < zonePlayerLimit * 3 / 4))
+        m_VisibleDistance = std::min(m_VisibleDistance + step * 0.5f, _maxVisibleDistance);
+
+    TC_METRIC_HANDLE_VALUE(_visibilityDistanceMetric, int64(m_VisibleDistance));
 }
 
 struct ResetNotifier
@@ -830,6 +1158,8 @@ struct ResetNotifier
 
 void Map::ProcessRelocationNotifies(const uint32 diff)
 {
+    TC_TRACE_ZONE("Map::ProcessRelocationNotifies");
+    std::vector<NGridType*> relocationGrids;
     for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end(); ++i)
     {
         NGridType *grid = i->GetSource();
@@ -841,30 +1171,46 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
         if (!grid->getGridInfoRef()->getRelocationTimer().TPassed())
             continue;
 
-        uint32 gx = grid->getX(), gy = grid->getY();
+        relocationGrids.push_back(grid);
+    }
 
-        CellCoord cell_min(gx*MAX_NUMBER_OF_CELLS, gy*MAX_NUMBER_OF_CELLS);
-        CellCoord cell_max(cell_min.x_coord + MAX_NUMBER_OF_CELLS, cell_min.y_coord+MAX_NUMBER_OF_CELLS);
+    Trinity::ThreadPool* regionPool = sMapMgr->GetRegionUpdatePool();
+    std::vector<std::vector<NGridType*>> regions;
+    if (regionPool && !Instanceable() && relocationGrids.size() > 1)
+        regions = PartitionRelocationRegions(relocationGrids);
 
-        for (uint32 x = cell_min.x_coord; x < cell_max.x_coord; ++x)
+    if (regions.size() > 1)
+    {
+        // no two regions can reach the same object within MAX_VISIBILITY_DISTANCE,
+        // everything that could is deferred and executed after all regions are done
+        std::vector<Trinity::RelocationDeferredActions> deferred(regions.size());
+        std::vector<std::future<void>> results;
+        results.reserve(regions.size() - 1);
+
+        for (std::size_t i = 1; i < regions.size(); ++i)
         {
-            for (uint32 y = cell_min.y_coord; y < cell_max.y_coord; ++y)
+            std::packaged_task<void()> task([this, &region = regions[i], &deferredActions = deferred[i]]()
             {
-                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                if (!isCellMarked(cell_id))
-                    continue;
+                for (NGridType* grid : region)
+                    ProcessGridRelocationNotifies(*grid, &deferredActions);
+            });
+            results.push_back(task.get_future());
+            regionPool->PostWork(std::move(task));
+        }
 
-                CellCoord pair(x, y);
-                Cell cell(pair);
-                cell.SetNoCreate();
+        for (NGridType* grid : regions[0])
+            ProcessGridRelocationNotifies(*grid, &deferred[0]);
 
-                Trinity::DelayedUnitRelocation cell_relocation(cell, pair, *this, MAX_VISIBILITY_DISTANCE);
-                TypeContainerVisitor<Trinity::DelayedUnitRelocation, GridTypeMapContainer  > grid_object_relocation(cell_relocation);
-                TypeContainerVisitor<Trinity::DelayedUnitRelocation, WorldTypeMapContainer > world_object_relocation(cell_relocation);
-                Visit(cell, grid_object_relocation);
-                Visit(cell, world_object_relocation);
-            }
-        }
+        for (std::future<void>& result : results)
+            result.get();
+
+        for (Trinity::RelocationDeferredActions& deferredActions : deferred)
+            deferredActions.Execute(MAX_VISIBILITY_DISTANCE);
+    }
+    else
+    {
+        for (NGridType* grid : relocationGrids)
+            ProcessGridRelocationNotifies(*grid, nullptr);
     }
 
     ResetNotifier reset;
@@ -905,6 +1251,81 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
     }
 }
 
+void Map::ProcessGridRelocationNotifies(NGridType& grid, Trinity::RelocationDeferredActions* deferred)
+{
+    uint32 gx = grid.getX(), gy = grid.getY();
+
+    CellCoord cell_min(gx*MAX_NUMBER_OF_CELLS, gy*MAX_NUMBER_OF_CELLS);
+    CellCoord cell_max(cell_min.x_coord + MAX_NUMBER_OF_CELLS, cell_min.y_coord+MAX_NUMBER_OF_CELLS);
+
+    for (uint32 x = cell_min.x_coord; x < cell_max.x_coord; ++x)
+    {
+        for (uint32 y = cell_min.y_coord; y < cell_max.y_coord; ++y)
+        {
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (!isCellMarked(cell_id))
+                continue;
+
+            CellCoord pair(x, y);
+            Cell cell(pair);
+            cell.SetNoCreate();
+
+            Trinity::DelayedUnitRelocation cell_relocation(cell, pair, *this, MAX_VISIBILITY_DISTANCE, deferred);
+            TypeContainerVisitor<Trinity::DelayedUnitRelocation, GridTypeMapContainer  > grid_object_relocation(cell_relocation);
+            TypeContainerVisitor<Trinity::DelayedUnitRelocation, WorldTypeMapContainer > world_object_relocation(cell_relocation);
+            Visit(cell, grid_object_relocation);
+            Visit(cell, world_object_relocation);
+        }
+    }
+}
+
+// Groups grids into regions that are at least 3 grids apart from each other
+// Relocation notifiers reach at most MAX_VISIBILITY_DISTANCE (one grid) away from the grid being processed,
+// this halo of one grid around each region never overlaps the halo of another region
+std::vector<std::vector<NGridType*>> Map::PartitionRelocationRegions(std::vector<NGridType*> const& grids)
+{
+    static constexpr uint32 RegionHaloGrids = 1;
+
+    std::vector<std::vector<NGridType*>> regions;
+    std::vector<bool> assigned(grids.size(), false);
+
+    for (std::size_t i = 0; i < grids.size(); ++i)
+    {
+        if (assigned[i])
+            continue;
+
+        std::vector<NGridType*>& region = regions.emplace_back();
+        region.push_back(grids[i]);
+        assigned[i] = true;
+
+        // flood fill, region grows while it is being iterated
+        for (std::size_t r = 0; r < region.size(); ++r)
+        {
+            for (std::size_t j = 0; j < grids.size(); ++j)
+            {
+                if (assigned[j])
+                    continue;
+
+                uint32 dx = std::abs(int32(region[r]->getX()) - int32(grids[j]->getX()));
+                uint32 dy = std::abs(int32(region[r]->getY()) - int32(grids[j]->getY()));
+                if (std::max(dx, dy) > 2 * RegionHaloGrids)
+                    continue;
+
+                region.push_back(grids[j]);
+                assigned[j] = true;
+            }
+        }
+    }
+
+    // biggest region first, it is processed by the calling thread while others run in the pool
+    std::sort(regions.begin(), regions.end(), [](std::vector<NGridType*> const& left, std::vector<NGridType*> const& right)
+    {
+        return left.size() > right.size();
+    });
+
+    return regions;
+}
+
 void Map::RemovePlayerFromMap(Player* player, bool remove)
 {
     // Before leaving map, update zone/area for stats
@@ -1031,13 +1452,13 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
         player->RemoveFromGrid();
 
         if (old_cell.DiffGrid(new_cell))
-            EnsureGridLoadedForActiveObject(new_cell, player);
+            EnsureGridLoadedForActiveObject(new_cell, player, true);
 
         AddToGrid(player, new_cell);
     }
 
     player->UpdatePositionData();
-    player->UpdateObjectVisibility(false);
+    player->UpdateObjectVisibilityOnRelocation();
 }
 
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool respawnRelocationOnFail)
@@ -1445,7 +1866,7 @@ bool Map::MapObjectCellRelocation(T* object, Cell new_cell, [[maybe_unused]] cha
     // in diff. grids but active creature
     if (object->isActiveObject())
     {
-        EnsureGridLoadedForActiveObject(new_cell, object);
+        EnsureGridLoadedForActiveObject(new_cell, object, true);
 
 #ifdef TRINITY_DEBUG
         TC_LOG_DEBUG("maps", "Active {} {} moved from grid[{}, {}]cell[{}, {}] to grid[{}, {}]cell[{}, {}].", objType, object->GetGUID().ToString(), old_cell.GridX(), old_cell.GridY(), old_cell.CellX(), old_cell.CellY(), new_cell.GridX(), new_cell.GridY(), new_cell.CellX(), new_cell.CellY());
@@ -1646,6 +2067,8 @@ void Map::RemoveAllPlayers()
 
 void Map::UnloadAll()
 {
+    ReleasePreloadedGrids(true);
+
     // clear all delayed moves, useless anyway do this moves before map unload.
     _creaturesToMove.clear();
     _gameObjectsToMove.clear();
@@ -1722,6 +2145,11 @@ float Map::GetGridHeight(PhaseShift const& phaseShift, float x, float y)
     return m_terrain->GetGridHeight(phaseShift, GetId(), x, y);
 }
 
+void Map::GetGridHeights(PhaseShift const& phaseShift, float const* x, float const* y, float* heights, std::size_t count)
+{
+    m_terrain->GetGridHeights(phaseShift, GetId(), x, y, heights, count);
+}
+
 float Map::GetStaticHeight(PhaseShift const& phaseShift, float x, float y, float z, bool checkVMap, float maxSearchDist)
 {
     return m_terrain->GetStaticHeight(phaseShift, GetId(), x, y, z, checkVMap, maxSearchDist);
@@ -1748,6 +2176,108 @@ float Map::GetWaterOrGroundLevel(PhaseShift const& phaseShift, float x, float y,
 }
 
 bool Map::isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    if (!sWorld->getBoolConfig(CONFIG_LINE_OF_SIGHT_CACHE))
+        return CheckLineOfSight(phaseShift, x1, y1, z1, x2, y2, z2, checks, ignoreFlags);
+
+    Optional<uint32> phaseShiftId = _lineOfSightCache.GetPhaseShiftId(phaseShift);
+    if (!phaseShiftId)
+        return CheckLineOfSight(phaseShift, x1, y1, z1, x2, y2, z2, checks, ignoreFlags);
+
+    LineOfSightCache::Key key = LineOfSightCache::MakeKey(x1, y1, z1, x2, y2, z2, *phaseShiftId, uint32(checks) | (uint32(ignoreFlags) << 8));
+    if (Optional<bool> result = _lineOfSightCache.Find(key))
+        return *result;
+
+    bool result = CheckLineOfSight(phaseShift, x1, y1, z1, x2, y2, z2, checks, ignoreFlags);
+    _lineOfSightCache.Store(key, result);
+    return result;
+}
+
+void Map::isInLineOfSightBatch(PhaseShift const& phaseShift, float const* positions, bool* results, std::size_t count, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    Optional<uint32> phaseShiftId;
+    if (sWorld->getBoolConfig(CONFIG_LINE_OF_SIGHT_CACHE))
+        phaseShiftId = _lineOfSightCache.GetPhaseShiftId(phaseShift);
+    bool useCache = phaseShiftId.has_value();
+    uint32 cacheFlags = uint32(checks) | (uint32(ignoreFlags) << 8);
+    auto getCacheKey = [&](std::size_t i)
+    {
+        float const* pair = positions + i * 6;
+        return LineOfSightCache::MakeKey(pair[0], pair[1], pair[2], pair[3], pair[4], pair[5], *phaseShiftId, cacheFlags);
+    };
+
+    std::vector<std::size_t> pending;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        results[i] = true;
+        if (useCache)
+        {
+            if (Optional<bool> result = _lineOfSightCache.Find(getCacheKey(i)))
+            {
+                results[i] = *result;
+                continue;
+            }
+        }
+
+        pending.push_back(i);
+    }
+
+    if (pending.empty())
+        return;
+
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+    {
+        // pairs starting on different terrain maps can't share a tree
+        std::vector<uint32> terrainMapIds(pending.size());
+        for (std::size_t i = 0; i < pending.size(); ++i)
+        {
+            float const* pair = positions + pending[i] * 6;
+            terrainMapIds[i] = PhasingHandler::GetTerrainMapId(phaseShift, GetId(), m_terrain.get(), pair[0], pair[1]);
+        }
+
+        std::vector<float> batchPositions;
+        std::vector<std::size_t> batchQueries;
+        std::unique_ptr<bool[]> batchResults = std::make_unique<bool[]>(pending.size());
+        std::vector<bool> done(pending.size(), false);
+        for (std::size_t first = 0; first < pending.size(); ++first)
+        {
+            if (done[first])
+                continue;
+
+            batchPositions.clear();
+            batchQueries.clear();
+            for (std::size_t i = first; i < pending.size(); ++i)
+            {
+                if (done[i] || terrainMapIds[i] != terrainMapIds[first])
+                    continue;
+
+                done[i] = true;
+                batchQueries.push_back(pending[i]);
+                batchPositions.insert(batchPositions.end(), positions + pending[i] * 6, positions + pending[i] * 6 + 6);
+            }
+
+            VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(terrainMapIds[first], batchPositions.data(), batchResults.get(), batchQueries.size(), ignoreFlags);
+            for (std::size_t i = 0; i < batchQueries.size(); ++i)
+                results[batchQueries[i]] = batchResults[i];
+        }
+    }
+
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+    {
+        for (std::size_t query : pending)
+        {
+            float const* pair = positions + query * 6;
+            if (results[query] && !_dynamicTree.isInLineOfSight({ pair[0], pair[1], pair[2] }, { pair[3], pair[4], pair[5] }, phaseShift))
+                results[query] = false;
+        }
+    }
+
+    if (useCache)
+        for (std::size_t query : pending)
+            _lineOfSightCache.Store(getCacheKey(query), results[query]);
+}
+
+bool Map::CheckLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
     if ((checks & LINEOFSIGHT_CHECK_VMAP)
       && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(PhasingHandler::GetTerrainMapId(phaseShift, GetId(), m_terrain.get(), x1, y1), x1, y1, z1, x2, y2, z2, ignoreFlags))
@@ -1927,10 +2457,46 @@ inline void Map::setNGrid(NGridType *grid, uint32 x, uint32 y)
     i_grids[x][y] = grid;
 }
 
+static void SendObjectUpdatePackets(UpdateDataMapType::value_type* const* begin, UpdateDataMapType::value_type* const* end)
+{
+    WorldPacket packet;                                     // storage grows through the ByteBuffer size classes and is reused by every receiver
+    for (UpdateDataMapType::value_type* const* itr = begin; itr != end; ++itr)
+    {
+        (*itr)->second.BuildPacket(&packet);
+        (*itr)->first->SendDirectMessage(&packet);
+        packet.clear();                                     // clean the string
+    }
+}
+
+void Map::AddUpdateObject(Object* obj, UF::UpdateFieldPriority priority)
+{
+    if (priority == UF::UpdateFieldPriority::Coalesced && _coalescedObjectUpdateTimer.GetInterval())
+    {
+        _coalescedUpdateObjects.insert(obj);
+        return;
+    }
+
+    _coalescedUpdateObjects.erase(obj);
+    _updateObjects.insert(obj);
+}
+
+void Map::RemoveUpdateObject(Object* obj)
+{
+    _updateObjects.erase(obj);
+    _coalescedUpdateObjects.erase(obj);
+}
+
 void Map::SendObjectUpdates()
 {
+    TC_TRACE_ZONE("Map::SendObjectUpdates");
     UpdateDataMapType update_players;
 
+    if (_coalescedObjectUpdateTimer.GetInterval() && _coalescedObjectUpdateTimer.Passed())
+    {
+        _coalescedObjectUpdateTimer.Reset();
+        _updateObjects.merge(_coalescedUpdateObjects);
+    }
+
     while (!_updateObjects.empty())
     {
         Object* obj = *_updateObjects.begin();
@@ -1939,13 +2505,40 @@ void Map::SendObjectUpdates()
         obj->BuildUpdate(update_players);
     }
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    std::vector<UpdateDataMapType::value_type*> receivers;
+    receivers.reserve(update_players.size());
+    for (UpdateDataMapType::value_type& receiver : update_players)
+        receivers.push_back(&receiver);
+
+    // every receiver is in exactly one batch and building its packet only reads its own UpdateData
+    static constexpr std::size_t MinReceiversPerBatch = 32;
+
+    Trinity::ThreadPool* pool = sMapMgr->GetRegionUpdatePool();
+    if (!pool || receivers.size() < MinReceiversPerBatch * 2)
     {
-        iter->second.BuildPacket(&packet);
-        iter->first->SendDirectMessage(&packet);
-        packet.clear();                                     // clean the string
+        SendObjectUpdatePackets(receivers.data(), receivers.data() + receivers.size());
+        return;
     }
+
+    std::size_t batchCount = std::min<std::size_t>(receivers.size() / MinReceiversPerBatch, sWorld->getIntConfig(CONFIG_MAP_UPDATE_REGION_THREADS) + 1);
+    std::size_t batchSize = (receivers.size() + batchCount - 1) / batchCount;
+
+    std::vector<std::future<void>> results;
+    results.reserve(batchCount - 1);
+    for (std::size_t begin = batchSize; begin < receivers.size(); begin += batchSize)
+    {
+        std::packaged_task<void()> task([&receivers, begin, end = std::min(begin + batchSize, receivers.size())]()
+        {
+            SendObjectUpdatePackets(receivers.data() + begin, receivers.data() + end);
+        });
+        results.push_back(task.get_future());
+        pool->PostWork(std::move(task));
+    }
+
+    SendObjectUpdatePackets(receivers.data(), receivers.data() + batchSize);
+
+    for (std::future<void>& result : results)
+        result.get();
 }
 
 // CheckRespawn MUST do one of the following:
@@ -2437,6 +3030,8 @@ void Map::SetSpawnGroupActive(uint32 groupId, bool state)
         _toggledSpawnGroupIds.insert(groupId);
     else
         _toggledSpawnGroupIds.erase(groupId);
+
+    _spawnGroupConditionsNeedFullUpdate = true;
 }
 
 bool Map::IsSpawnGroupActive(uint32 groupId) const
@@ -2453,14 +3048,48 @@ bool Map::IsSpawnGroupActive(uint32 groupId) const
     return (_toggledSpawnGroupIds.find(groupId) != _toggledSpawnGroupIds.end()) != !(data->flags & SPAWNGROUP_FLAG_MANUAL_SPAWN);
 }
 
+// inputs of these condition types notify ConditionMgr when they change
+static constexpr std::array<ConditionTypes, 3> NotifiedSpawnGroupConditionTypes = { CONDITION_WORLD_STATE, CONDITION_ACTIVE_EVENT, CONDITION_REALM_ACHIEVEMENT };
+
+// instance data and scenario progress are kept by scripts, spawn groups depending on them are always re-evaluated
+static constexpr uint64 PolledSpawnGroupConditionTypes = (UI64LIT(1) << CONDITION_INSTANCE_INFO) | (UI64LIT(1) << CONDITION_SCENARIO_STEP);
+
 void Map::UpdateSpawnGroupConditions()
 {
+    static_assert(std::tuple_size_v<decltype(_seenSpawnGroupConditionChangeCounters)> == NotifiedSpawnGroupConditionTypes.size());
+
     std::vector<uint32> const* spawnGroups = sObjectMgr->GetSpawnGroupsForMap(GetId());
     if (!spawnGroups)
         return;
 
-    for (uint32 spawnGroupId : *spawnGroups)
+    uint32 reloadCounter = sConditionMgr->GetReloadCounter();
+    if (_spawnGroupConditionsReloadCounter != reloadCounter)
+    {
+        _spawnGroupConditionsReloadCounter = reloadCounter;
+        _spawnGroupConditionTypes.clear();
+        for (uint32 spawnGroupId : *spawnGroups)
+            _spawnGroupConditionTypes.emplace_back(spawnGroupId, sConditionMgr->GetConditionTypeMaskForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPAWN_GROUP, spawnGroupId));
+
+        _spawnGroupConditionsNeedFullUpdate = true;
+    }
+
+    uint64 changedConditionTypes = std::exchange(_changedSpawnGroupConditionTypes, 0) | PolledSpawnGroupConditionTypes;
+    for (std::size_t i = 0; i < NotifiedSpawnGroupConditionTypes.size(); ++i)
+    {
+        uint32 changeCounter = sConditionMgr->GetConditionTypeChangeCounter(NotifiedSpawnGroupConditionTypes[i]);
+        if (_seenSpawnGroupConditionChangeCounters[i] != changeCounter)
+        {
+            _seenSpawnGroupConditionChangeCounters[i] = changeCounter;
+            changedConditionTypes |= UI64LIT(1) << NotifiedSpawnGroupConditionTypes[i];
+        }
+    }
+
+    bool fullUpdate = std::exchange(_spawnGroupConditionsNeedFullUpdate, false);
+    for (auto const& [spawnGroupId, conditionTypes] : _spawnGroupConditionTypes)
     {
+        if (!fullUpdate && !(conditionTypes & changedConditionTypes))
+            continue;
+
         SpawnGroupTemplateData const* spawnGroupTemplate = ASSERT_NOTNULL(GetSpawnGroupData(spawnGroupId));
 
         bool isActive = IsSpawnGroupActive(spawnGroupId);
@@ -2501,6 +3130,11 @@ void Map::AddFarSpellCallback(FarSpellCallback&& callback)
     _farSpellCallbacks.Enqueue(new FarSpellCallback(std::move(callback)));
 }
 
+void Map::AddUpdateTask(UpdateTask&& task)
+{
+    _updateTasks.Enqueue(new UpdateTask(std::move(task)));
+}
+
 void Map::DelayedUpdate(uint32 t_diff)
 {
     {
@@ -2812,6 +3446,7 @@ void InstanceMap::InitVisibilityDistance()
 {
     //init visibility distance for instances
     m_VisibleDistance = World::GetMaxVisibleDistanceInInstances();
+    _maxVisibleDistance = m_VisibleDistance;
     m_VisibilityNotifyPeriod = World::GetVisibilityNotifyPeriodInInstances();
 }
 
@@ -3295,6 +3930,7 @@ void BattlegroundMap::InitVisibilityDistance()
 {
     //init visibility distance for BG/Arenas
     m_VisibleDistance        = IsBattleArena() ? World::GetMaxVisibleDistanceInArenas() : World::GetMaxVisibleDistanceInBG();
+    _maxVisibleDistance      = m_VisibleDistance;
     m_VisibilityNotifyPeriod = IsBattleArena() ? World::GetVisibilityNotifyPeriodInArenas() : World::GetVisibilityNotifyPeriodInBG();
 }
 
@@ -26,17 +26,22 @@
 #include "GridDefines.h"
 #include "GridRefManager.h"
 #include "GroupInstanceReference.h"
+#include "LineOfSightCache.h"
 #include "MapDefines.h"
 #include "MapReference.h"
+#include "MapUpdateProfiler.h"
 #include "MapRefManager.h"
 #include "MPSCQueue.h"
 #include "ObjectGuid.h"
+#include "Optional.h"
 #include "PersonalPhaseTracker.h"
 #include "SharedDefines.h"
 #include "SpawnData.h"
 #include "Timer.h"
 #include "WorldStateDefines.h"
+#include <array>
 #include <bitset>
+#include <future>
 #include <list>
 #include <map>
 #include <memory>
@@ -52,6 +57,7 @@ class InstanceLock;
 class InstanceMap;
 class InstanceScript;
 class InstanceScenario;
+class MetricHandle;
 class Object;
 class PhaseShift;
 class Player;
@@ -77,7 +83,8 @@ enum Difficulty : uint8;
 enum WeatherState : uint32;
 enum class ItemContext : uint8;
 
-namespace Trinity { struct ObjectUpdater; }
+namespace Trinity { struct ObjectUpdater; struct RelocationDeferredActions; }
+namespace UF { enum class UpdateFieldPriority : uint8; }
 namespace VMAP { enum class ModelIgnoreFlags : uint32; }
 
 enum TransferAbortReason : uint32
@@ -210,6 +217,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         template<class T> void RemoveFromMap(T *, bool);
 
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
+        void MarkCellsNearPlayers(float distance);
         virtual void Update(uint32);
 
         float GetVisibilityRange() const { return m_VisibleDistance; }
@@ -253,6 +261,15 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         time_t GetGridExpiry() const { return i_gridExpiry; }
 
+        // duration of the previous Update call, used to schedule most expensive maps first and by Visibility.Adaptive
+        Microseconds GetLastUpdateDuration() const { return _lastUpdateDuration; }
+        void SetLastUpdateDuration(Microseconds duration) { _lastUpdateDuration = duration; }
+
+        // MapUpdater worker this map is kept on by the map affinity scheduler
+        Optional<uint32> GetUpdateWorker() const { return _updateWorker; }
+        void SetUpdateWorker(uint32 worker) { _updateWorker = worker; }
+        MetricHandle* GetUpdateTimeMetric() const { return _updateTimeMetric.get(); }
+
         static void InitStateMachine();
         static void DeleteStateMachine();
 
@@ -271,6 +288,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         float GetMinHeight(PhaseShift const& phaseShift, float x, float y);
         float GetGridHeight(PhaseShift const& phaseShift, float x, float y);
+        void GetGridHeights(PhaseShift const& phaseShift, float const* x, float const* y, float* heights, std::size_t count);
         float GetStaticHeight(PhaseShift const& phaseShift, float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH);
         float GetStaticHeight(PhaseShift const& phaseShift, Position const& pos, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) { return GetStaticHeight(phaseShift, pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), checkVMap, maxSearchDist); }
         float GetHeight(PhaseShift const& phaseShift, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) { return std::max<float>(GetStaticHeight(phaseShift, x, y, z, vmap, maxSearchDist), GetGameObjectFloor(phaseShift, x, y, z, maxSearchDist)); }
@@ -329,6 +347,9 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void resetMarkedCells() { marked_cells.reset(); }
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
+        bool IsCellNearPlayers(uint32 cellId) const { return _cellsNearPlayers.test(cellId); }
+
+        MapUpdateProfiler& GetUpdateProfiler() { return _updateProfiler; }
 
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
         uint32 GetPlayersCountExceptGMs() const;
@@ -434,9 +455,13 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         BattlegroundMap const* ToBattlegroundMap() const { if (IsBattlegroundOrArena()) return reinterpret_cast<BattlegroundMap const*>(this); return nullptr; }
 
         bool isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        // checks count pairs of positions at once, positions holds x1, y1, z1, x2, y2, z2 of every pair
+        void isInLineOfSightBatch(PhaseShift const& phaseShift, float const* positions, bool* results, std::size_t count, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
         void Balance() { _dynamicTree.balance(); }
-        void RemoveGameObjectModel(GameObjectModel const& model) { _dynamicTree.remove(model); }
-        void InsertGameObjectModel(GameObjectModel const& model) { _dynamicTree.insert(model); }
+        void RemoveGameObjectModel(GameObjectModel const& model) { _dynamicTree.remove(model); InvalidateLineOfSightCache(); }
+        void InsertGameObjectModel(GameObjectModel const& model) { _dynamicTree.insert(model); InvalidateLineOfSightCache(); }
+        void RelocateGameObjectModel(GameObjectModel const& model) { _dynamicTree.relocate(model); InvalidateLineOfSightCache(); }
+        void InvalidateLineOfSightCache() { _lineOfSightCache.Clear(); }
         bool ContainsGameObjectModel(GameObjectModel const& model) const { return _dynamicTree.contains(model);}
         float GetGameObjectFloor(PhaseShift const& phaseShift, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const
         {
@@ -461,7 +486,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         time_t GetCreatureRespawnTime(ObjectGuid::LowType spawnId) const { return GetRespawnTime(SPAWN_TYPE_CREATURE, spawnId); }
         time_t GetGORespawnTime(ObjectGuid::LowType spawnId) const { return GetRespawnTime(SPAWN_TYPE_GAMEOBJECT, spawnId); }
 
-        void UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone);
+        void UpdatePlayerZoneStats(Player* player, uint32 oldZone, uint32 newZone);
 
         void SaveRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId, uint32 entry, time_t respawnTime, uint32 gridId, CharacterDatabaseTransaction dbTrans = nullptr, bool startup = false);
         void SaveRespawnInfoDB(RespawnInfo const& info, CharacterDatabaseTransaction dbTrans = nullptr);
@@ -505,15 +530,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
             return GetGuidSequenceGenerator(high).GetNextAfterMaxUsed();
         }
 
-        void AddUpdateObject(Object* obj)
-        {
-            _updateObjects.insert(obj);
-        }
-
-        void RemoveUpdateObject(Object* obj)
-        {
-            _updateObjects.erase(obj);
-        }
+        void AddUpdateObject(Object* obj, UF::UpdateFieldPriority priority);
+        void RemoveUpdateObject(Object* obj);
 
         size_t GetActiveNonPlayersCount() const
         {
@@ -528,6 +546,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void SendInitSelf(Player* player);
 
+        bool CheckLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+
         template <typename T>
         bool MapObjectCellRelocation(T* object, Cell new_cell, char const* objType);
 
@@ -561,7 +581,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         bool IsGridLoaded(GridCoord const&) const;
         void EnsureGridCreated(GridCoord const&);
         bool EnsureGridLoaded(Cell const&);
-        void EnsureGridLoadedForActiveObject(Cell const&, WorldObject const* object);
+        void EnsureGridLoadedForActiveObject(Cell const&, WorldObject const* object, bool deferUntilTerrainLoaded = false);
 
         void buildNGridLinkage(NGridType* pNGridType) { pNGridType->link(this); }
 
@@ -579,6 +599,11 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void SendObjectUpdates();
 
+        void PreloadGridsAhead();
+        void PreloadGrid(float x, float y, TimePoint now);
+        void ReleasePreloadedGrids(bool all);
+        void LoadGridsWaitingForTerrain();
+
     protected:
         virtual void LoadGridObjects(NGridType* grid, Cell const& cell);
 
@@ -587,7 +612,10 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 i_InstanceId;
         uint32 m_unloadTimer;
         float m_VisibleDistance;
+        float _maxVisibleDistance;                          // configured visibility distance, m_VisibleDistance shrinks below it with Visibility.Adaptive
         DynamicMapTree _dynamicTree;
+        mutable LineOfSightCache _lineOfSightCache;
+        MapUpdateProfiler _updateProfiler;
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
@@ -612,18 +640,32 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         Creature* _GetScriptCreature(Object* obj, bool isSource, ScriptInfo const* scriptInfo) const;
         WorldObject* _GetScriptWorldObject(Object* obj, bool isSource, ScriptInfo const* scriptInfo) const;
         void _ScriptProcessDoor(Object* source, Object* target, ScriptInfo const* scriptInfo) const;
+        void UpdateAdaptiveVisibilityDistance(uint32 diff);
         GameObject* _FindGameObject(WorldObject* pWorldObject, ObjectGuid::LowType guid) const;
 
         time_t i_gridExpiry;
+        Microseconds _lastUpdateDuration;
+        Optional<uint32> _updateWorker;
+        std::shared_ptr<MetricHandle> _updateTimeMetric;
+        std::shared_ptr<MetricHandle> _creatureCountMetric;
+        std::shared_ptr<MetricHandle> _gameObjectCountMetric;
+        std::shared_ptr<MetricHandle> _visibilityDistanceMetric;
+
+        IntervalTimer _visibilityAdjustTimer;
+        Microseconds _visibilityAdjustUpdateTime;           // sum of update durations since _visibilityAdjustTimer last passed
+        uint32 _visibilityAdjustUpdateCount;
 
         std::shared_ptr<TerrainInfo> m_terrain;
 
         NGridType* i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> _cellsNearPlayers; // cells where creatures are never throttled by update LOD
 
         //these functions used to process player/mob aggro reactions and
         //visibility calculations. Highly optimized for massive calculations
         void ProcessRelocationNotifies(const uint32 diff);
+        void ProcessGridRelocationNotifies(NGridType& grid, Trinity::RelocationDeferredActions* deferred);
+        static std::vector<std::vector<NGridType*>> PartitionRelocationRegions(std::vector<NGridType*> const& grids);
 
         bool i_scriptLock;
         std::set<WorldObject*> i_objectsToRemove;
@@ -691,6 +733,10 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         typedef std::function<void(Map*)> FarSpellCallback;
         void AddFarSpellCallback(FarSpellCallback&& callback);
 
+        // work posted from outside the map (world thread), executed at the start of the next Update on the thread updating this map
+        typedef std::function<void(Map*)> UpdateTask;
+        void AddUpdateTask(UpdateTask&& task);
+
         void UpdateSpawnGroupConditions();
 
     private:
@@ -757,8 +803,31 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void SetSpawnGroupActive(uint32 groupId, bool state);
         std::unordered_set<uint32> _toggledSpawnGroupIds;
 
+        // spawn groups of the map with the condition types their conditions depend on,
+        // only groups whose condition inputs changed since the last update are re-evaluated
+        std::vector<std::pair<uint32, uint64>> _spawnGroupConditionTypes;
+        Optional<uint32> _spawnGroupConditionsReloadCounter;
+        std::array<uint32, 3> _seenSpawnGroupConditionChangeCounters;
+        uint64 _changedSpawnGroupConditionTypes;
+        bool _spawnGroupConditionsNeedFullUpdate;
+
         uint32 _respawnCheckTimer;
+
+        // terrain of grids players are heading to is loaded in the background, the map holds
+        // a terrain reference for them until loading finished and the grid is created
+        struct PreloadedGrid
+        {
+            std::future<void> Loaded;
+            TimePoint Expiry;
+        };
+        std::unordered_map<uint32, PreloadedGrid> _preloadedGrids;
+        static constexpr Milliseconds GridPreloadInterval = 1s;
+        uint32 _gridPreloadTimer;
+
+        // grids created by relocations whose objects are loaded once their terrain files are resident
+        std::vector<std::pair<Cell, ObjectGuid>> _gridsWaitingForTerrain;
         std::unordered_map<uint32, uint32> _zonePlayerCountMap;
+        std::unordered_map<uint32, std::vector<Player*>> _zonePlayers;
 
         ZoneDynamicInfoMap _zoneDynamicInfo;
         IntervalTimer _weatherUpdateTimer;
@@ -776,8 +845,12 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         std::unordered_set<Corpse*> _corpseBones;
 
         std::unordered_set<Object*> _updateObjects;
+        // objects with only UF::UpdateFieldPriority::Coalesced changes, sent together when _coalescedObjectUpdateTimer passes
+        std::unordered_set<Object*> _coalescedUpdateObjects;
+        IntervalTimer _coalescedObjectUpdateTimer;
 
         MPSCQueue<FarSpellCallback> _farSpellCallbacks;
+        MPSCQueue<UpdateTask> _updateTasks;
 
         /*********************************************************/
         /***                   Phasing                         ***/
@@ -798,7 +871,17 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         WorldStateValueContainer const& GetWorldStateValues() const { return _worldStateValues; }
 
     private:
+        void SendWorldStateUpdates();
+
+        struct PendingWorldStateUpdate
+        {
+            int32 Value;
+            bool Hidden;
+        };
+
         WorldStateValueContainer _worldStateValues;
+        // changes made during an update are sent once at the end of it, only the last value of each world state is sent
+        std::unordered_map<int32, PendingWorldStateUpdate> _pendingWorldStateUpdates;
 };
 
 enum class InstanceResetMethod : uint8
@@ -888,7 +971,15 @@ inline void Map::Visit(Cell const& cell, TypeContainerVisitor<T, CONTAINER>& vis
     if (!cell.NoCreate() || IsGridLoaded(GridCoord(x, y)))
     {
         EnsureGridLoaded(cell);
-        getNGrid(x, y)->VisitGrid(cell_x, cell_y, visitor);
+        NGridType* grid = getNGrid(x, y);
+        if constexpr (GridMapTypeFilteredVisitor<T>)
+        {
+            uint32 visitedTypes = visitor.GetVisitor().GetVisitedGridMapTypes();
+            if (!(grid->GetOccupancy().GetMask() & visitedTypes) || !(grid->GetGridType(cell_x, cell_y).GetOccupancy().GetMask() & visitedTypes))
+                return;
+        }
+
+        grid->VisitGrid(cell_x, cell_y, visitor);
     }
 }
 #endif
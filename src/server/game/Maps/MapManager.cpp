@@ -20,6 +20,7 @@
 #include "Containers.h"
 #include "DatabaseEnv.h"
 #include "DB2Stores.h"
+#include "FlightRecorder.h"
 #include "GarrisonMap.h"
 #include "Group.h"
 #include "InstanceLockMgr.h"
@@ -28,10 +29,17 @@
 #include "Player.h"
 #include "ScenarioMgr.h"
 #include "ScriptMgr.h"
+#include "TerrainMgr.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+#include "VMapFactory.h"
+#include "VMapManager2.h"
 #include "World.h"
 #include "WorldStateMgr.h"
 #include <boost/dynamic_bitset.hpp>
+#include <future>
 #include <numeric>
+#include <unordered_set>
 
 MapManager::MapManager()
     : _freeInstanceIds(std::make_unique<InstanceIds>()), _nextInstanceId(0), _scheduledScripts(0)
@@ -49,7 +57,19 @@ void MapManager::Initialize()
     int num_threads(sWorld->getIntConfig(CONFIG_NUMTHREADS));
     // Start mtmaps if needed.
     if (num_threads > 0)
-        m_updater.activate(num_threads);
+        m_updater.activate(num_threads, MapUpdaterScheduler(sWorld->getIntConfig(CONFIG_MAP_UPDATE_SCHEDULER)));
+
+    if (uint32 regionThreads = sWorld->getIntConfig(CONFIG_MAP_UPDATE_REGION_THREADS))
+        _regionUpdatePool = std::make_unique<Trinity::ThreadPool>(regionThreads);
+
+    if (uint32 preloadThreads = sWorld->getIntConfig(CONFIG_MAP_GRID_PRELOAD_THREADS))
+    {
+        _gridPreloadPool = std::make_unique<Trinity::ThreadPool>(preloadThreads);
+        VMAP::VMapFactory::createOrGetVMapManager()->SetBackgroundTreeLoading(true);
+    }
+
+    if (uint32 pathfindingThreads = sWorld->getIntConfig(CONFIG_MAP_PATHFINDING_THREADS))
+        _pathfindingPool = std::make_unique<Trinity::ThreadPool>(pathfindingThreads);
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -69,18 +89,111 @@ Map* MapManager::FindMap_i(uint32 mapId, uint32 instanceId) const
     return Trinity::Containers::MapGetValuePtr(i_maps, { mapId, instanceId });
 }
 
-Map* MapManager::CreateWorldMap(uint32 mapId, uint32 instanceId)
+Map* MapManager::CreateWorldMap(uint32 mapId, uint32 instanceId, bool loadAllCells /*= true*/)
 {
     Map* map = new Map(mapId, i_gridCleanUpDelay, instanceId, DIFFICULTY_NONE);
     map->LoadRespawnTimes();
     map->LoadCorpseData();
 
-    if (sWorld->getBoolConfig(CONFIG_BASEMAP_LOAD_GRIDS))
+    if (loadAllCells && sWorld->getBoolConfig(CONFIG_BASEMAP_LOAD_GRIDS))
         map->LoadAllCells();
 
     return map;
 }
 
+void MapManager::PreloadBaseMaps()
+{
+    if (!sWorld->getBoolConfig(CONFIG_BASEMAP_LOAD_GRIDS))
+        return;
+
+    uint32 oldMSTime = getMSTime();
+
+    // respawn times and corpses are loaded synchronously from the database, keep map creation here
+    std::vector<Map*> maps;
+    {
+        std::unique_lock<std::shared_mutex> lock(_mapsLock);
+        for (MapEntry const* entry : sMapStore)
+        {
+            if (!entry->IsWorldMap() || entry->IsGarrison() || entry->ParentMapID != -1 || entry->CosmeticParentMapID != -1)
+                continue;
+
+            for (uint32 instanceId : { 0u, 1u })
+            {
+                if (instanceId && !entry->IsSplitByFaction())
+                    break;
+
+                if (FindMap_i(entry->ID, instanceId))
+                    continue;
+
+                Map* map = CreateWorldMap(entry->ID, instanceId, false);
+                i_maps[{ map->GetId(), map->GetInstanceId() }] = map;
+                maps.push_back(map);
+            }
+        }
+    }
+
+    if (maps.empty())
+        return;
+
+    uint32 threads = sWorld->getIntConfig(CONFIG_BASEMAP_LOAD_GRIDS_THREADS);
+    if (!threads)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    std::atomic<uint32> loadedGrids = 0;
+    uint32 totalGrids = 0;
+    std::atomic<uint32> loadedMaps = 0;
+    uint32 lastReport = getMSTime();
+    auto waitForPhase = [&](Trinity::ThreadPool& pool)
+    {
+        std::future<void> finished = std::async(std::launch::async, [&pool]() { pool.Join(); });
+        while (finished.wait_for(100ms) != std::future_status::ready)
+        {
+            if (GetMSTimeDiffToNow(lastReport) < 5000)
+                continue;
+
+            lastReport = getMSTime();
+            TC_LOG_INFO("server.loading", ">> Preloading base maps: terrain {}/{} grids, objects {}/{} maps, {} s elapsed",
+                loadedGrids.load(), totalGrids, loadedMaps.load(), maps.size(), GetMSTimeDiffToNow(oldMSTime) / IN_MILLISECONDS);
+        }
+    };
+
+    // terrain first, all of it is resident before any object is spawned
+    // grids are only created below and creating one of a terrain that is still being preloaded would load its files on the map task
+    {
+        Trinity::ThreadPool pool(threads);
+        std::unordered_set<TerrainInfo*> terrains;
+        for (Map* map : maps)
+        {
+            if (!terrains.insert(map->GetTerrain()).second)
+                continue;
+
+            totalGrids += map->GetTerrain()->GetGridFileCount();
+            map->GetTerrain()->PreloadAllGrids(pool, loadedGrids);
+        }
+
+        waitForPhase(pool);
+    }
+
+    // creatures and gameobjects are spawned by one task per map, no two tasks touch the same map
+    {
+        Trinity::ThreadPool pool(threads);
+        for (Map* map : maps)
+        {
+            pool.PostWork([map, &loadedMaps]()
+            {
+                uint32 mapStartTime = getMSTime();
+                map->LoadAllCells();
+                TC_LOG_DEBUG("server.loading", "Loaded all grids of map {} instance {} in {} ms", map->GetId(), map->GetInstanceId(), GetMSTimeDiffToNow(mapStartTime));
+                ++loadedMaps;
+            });
+        }
+
+        waitForPhase(pool);
+    }
+
+    TC_LOG_INFO("server.loading", ">> Preloaded {} grids of {} base maps using {} threads in {} ms", loadedGrids.load(), maps.size(), threads, GetMSTimeDiffToNow(oldMSTime));
+}
+
 InstanceMap* MapManager::CreateInstance(uint32 mapId, uint32 instanceId, InstanceLock* instanceLock, Difficulty difficulty, TeamId team, Group* group)
 {
     // make sure we have a valid map id
@@ -298,6 +411,8 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    TC_TRACE_ZONE("MapManager::Update");
+
     MapMapType::iterator iter = i_maps.begin();
     while (iter != i_maps.end())
     {
@@ -314,7 +429,13 @@ void MapManager::Update(uint32 diff)
         if (m_updater.activated())
             m_updater.schedule_update(*iter->second, uint32(i_timer.GetCurrent()));
         else
+        {
+            TimePoint start = std::chrono::steady_clock::now();
             iter->second->Update(uint32(i_timer.GetCurrent()));
+            iter->second->SetLastUpdateDuration(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start));
+            if (sFlightRecorder->IsEnabled())
+                sFlightRecorder->RecordMapUpdate(*iter->second, iter->second->GetLastUpdateDuration());
+        }
 
         ++iter;
     }
@@ -364,6 +485,24 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    if (_regionUpdatePool)
+    {
+        _regionUpdatePool->Join();
+        _regionUpdatePool.reset();
+    }
+
+    if (_gridPreloadPool)
+    {
+        _gridPreloadPool->Join();
+        _gridPreloadPool.reset();
+    }
+
+    if (_pathfindingPool)
+    {
+        _pathfindingPool->Join();
+        _pathfindingPool.reset();
+    }
+
     Map::DeleteStateMachine();
 }
 
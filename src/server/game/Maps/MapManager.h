@@ -37,6 +37,11 @@ class Map;
 class Player;
 enum Difficulty : uint8;
 
+namespace Trinity
+{
+class ThreadPool;
+}
+
 class TC_GAME_API MapManager
 {
         MapManager();
@@ -105,6 +110,10 @@ class TC_GAME_API MapManager
 
         void InitializeVisibilityDistanceInfo();
 
+        // creates all world maps and loads all of their grids (BaseMapLoadAllGrids), terrain files are read
+        // concurrently for all maps while each map spawns its objects in a task of its own
+        void PreloadBaseMaps();
+
         /* statistics */
         uint32 GetNumInstances() const;
         uint32 GetNumPlayersInInstances() const;
@@ -116,6 +125,9 @@ class TC_GAME_API MapManager
         void FreeInstanceId(uint32 instanceId);
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
+        Trinity::ThreadPool* GetRegionUpdatePool() { return _regionUpdatePool.get(); }
+        Trinity::ThreadPool* GetGridPreloadPool() { return _gridPreloadPool.get(); }
+        Trinity::ThreadPool* GetPathfindingPool() { return _pathfindingPool.get(); }
 
         template<typename Worker>
         void DoForAllMaps(Worker&& worker);
@@ -137,7 +149,7 @@ class TC_GAME_API MapManager
 
         Map* FindMap_i(uint32 mapId, uint32 instanceId) const;
 
-        Map* CreateWorldMap(uint32 mapId, uint32 instanceId);
+        Map* CreateWorldMap(uint32 mapId, uint32 instanceId, bool loadAllCells = true);
         InstanceMap* CreateInstance(uint32 mapId, uint32 instanceId, InstanceLock* instanceLock, Difficulty difficulty, TeamId team, Group* group);
         BattlegroundMap* CreateBattleground(uint32 mapId, uint32 instanceId, Battleground* bg);
         GarrisonMap* CreateGarrison(uint32 mapId, uint32 instanceId, Player* owner);
@@ -152,6 +164,9 @@ class TC_GAME_API MapManager
         std::unique_ptr<InstanceIds> _freeInstanceIds;
         uint32 _nextInstanceId;
         MapUpdater m_updater;
+        std::unique_ptr<Trinity::ThreadPool> _regionUpdatePool;
+        std::unique_ptr<Trinity::ThreadPool> _gridPreloadPool;
+        std::unique_ptr<Trinity::ThreadPool> _pathfindingPool;
 
         // atomic op counter for active scripts amount
         std::atomic<std::size_t> _scheduledScripts;
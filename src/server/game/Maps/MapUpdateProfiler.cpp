@@ -0,0 +1,161 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapUpdateProfiler.h"
+#include "Creature.h"
+#include <algorithm>
+
+MapUpdateProfiler::Update::Update(MapUpdateProfiler& profiler) : _data(nullptr), _phase(MAP_UPDATE_PHASE_OTHER), _phaseTimes()
+{
+    if (!profiler.IsEnabled())
+        return;
+
+    _data = profiler._data.get();
+    _start = _phaseStart = std::chrono::steady_clock::now();
+}
+
+MapUpdateProfiler::Update::~Update()
+{
+    if (!_data)
+        return;
+
+    SwitchPhase(MAP_UPDATE_PHASE_OTHER);
+
+    std::lock_guard<std::mutex> lock(_data->Lock);
+    for (std::size_t i = 0; i < MAX_MAP_UPDATE_PHASES; ++i)
+        _data->Samples[i][_data->NextSample] = std::chrono::duration_cast<Microseconds>(_phaseTimes[i]);
+    _data->Samples[MAX_MAP_UPDATE_PHASES][_data->NextSample] = std::chrono::duration_cast<Microseconds>(_phaseStart - _start);
+
+    _data->NextSample = (_data->NextSample + 1) % WindowSize;
+    _data->SampleCount = std::min(_data->SampleCount + 1, WindowSize);
+
+    for (CreatureUpdate const& update : _creatureUpdates)
+    {
+        CreatureStats& stats = _data->Creatures[update.Guid];
+        stats.Guid = update.Guid;
+        stats.Entry = update.Entry;
+        ++stats.Updates;
+        stats.Total += update.Time;
+        stats.Max = std::max(stats.Max, update.Time);
+    }
+}
+
+void MapUpdateProfiler::Update::SwitchPhase(MapUpdatePhase phase)
+{
+    TimePoint now = std::chrono::steady_clock::now();
+    _phaseTimes[_phase] += now - _phaseStart;
+    _phaseStart = now;
+    _phase = phase;
+}
+
+void MapUpdateProfiler::Update::AddCreatureUpdate(Creature const* creature, Microseconds time)
+{
+    _creatureUpdates.push_back({ .Guid = creature->GetGUID(), .Entry = creature->GetEntry(), .Time = time });
+}
+
+MapUpdateProfiler::MapUpdateProfiler() : _enabled(false)
+{
+}
+
+MapUpdateProfiler::~MapUpdateProfiler() = default;
+
+void MapUpdateProfiler::SetEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> createLock(_createLock);
+    if (enabled)
+    {
+        if (!_data)
+            _data = std::make_unique<Data>();
+
+        // start from a clean window every time profiling is enabled
+        std::lock_guard<std::mutex> lock(_data->Lock);
+        _data->SampleCount = 0;
+        _data->NextSample = 0;
+        _data->Creatures.clear();
+    }
+
+    _enabled.store(enabled, std::memory_order_release);
+}
+
+MapUpdateProfiler::Report MapUpdateProfiler::BuildReport(std::size_t topCreatureCount) const
+{
+    Report report;
+
+    std::lock_guard<std::mutex> createLock(_createLock);
+    if (!_data)
+        return report;
+
+    std::lock_guard<std::mutex> lock(_data->Lock);
+    report.Updates = _data->SampleCount;
+    if (report.Updates)
+    {
+        auto buildStats = [count = report.Updates](std::array<Microseconds, WindowSize> samples)
+        {
+            std::sort(samples.begin(), samples.begin() + count);
+
+            PhaseStats stats;
+            Microseconds total = Microseconds::zero();
+            for (std::size_t i = 0; i < count; ++i)
+                total += samples[i];
+
+            stats.Min = samples[0];
+            stats.Avg = total / count;
+            stats.P99 = samples[std::min(count - 1, count * 99 / 100)];
+            stats.Max = samples[count - 1];
+            return stats;
+        };
+
+        for (std::size_t i = 0; i < MAX_MAP_UPDATE_PHASES; ++i)
+            report.Phases[i] = buildStats(_data->Samples[i]);
+        report.Total = buildStats(_data->Samples[MAX_MAP_UPDATE_PHASES]);
+    }
+
+    report.TopCreatures.reserve(_data->Creatures.size());
+    for (auto const& [guid, stats] : _data->Creatures)
+        report.TopCreatures.push_back(stats);
+
+    std::size_t creatureCount = std::min(topCreatureCount, report.TopCreatures.size());
+    std::partial_sort(report.TopCreatures.begin(), report.TopCreatures.begin() + creatureCount, report.TopCreatures.end(), [](CreatureStats const& left, CreatureStats const& right)
+    {
+        return left.Total > right.Total;
+    });
+    report.TopCreatures.resize(creatureCount);
+    return report;
+}
+
+char const* MapUpdateProfiler::GetPhaseName(MapUpdatePhase phase)
+{
+    switch (phase)
+    {
+        case MAP_UPDATE_PHASE_SESSIONS: return "Sessions";
+        case MAP_UPDATE_PHASE_RESPAWNS: return "Respawns";
+        case MAP_UPDATE_PHASE_GRIDS: return "Grid loading";
+        case MAP_UPDATE_PHASE_PLAYERS: return "Players";
+        case MAP_UPDATE_PHASE_CELLS: return "Nearby cells";
+        case MAP_UPDATE_PHASE_TRANSPORTS: return "Transports";
+        case MAP_UPDATE_PHASE_OBJECT_UPDATES: return "SendObjectUpdates";
+        case MAP_UPDATE_PHASE_SCRIPTS: return "ScriptsProcess";
+        case MAP_UPDATE_PHASE_MOVE_LISTS: return "Move lists";
+        case MAP_UPDATE_PHASE_RELOCATION_NOTIFIES: return "Relocation notifies";
+        case MAP_UPDATE_PHASE_SCRIPT_HOOK: return "OnMapUpdate";
+        case MAP_UPDATE_PHASE_OTHER: return "Other";
+        default:
+            break;
+    }
+
+    return "Unknown";
+}
@@ -0,0 +1,152 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAPUPDATEPROFILER_H
+#define TRINITY_MAPUPDATEPROFILER_H
+
+#include "Define.h"
+#include "Duration.h"
+#include "ObjectGuid.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class Creature;
+
+enum MapUpdatePhase : uint8
+{
+    MAP_UPDATE_PHASE_SESSIONS,
+    MAP_UPDATE_PHASE_RESPAWNS,
+    MAP_UPDATE_PHASE_GRIDS,
+    MAP_UPDATE_PHASE_PLAYERS,
+    MAP_UPDATE_PHASE_CELLS,                                 // VisitNearbyCellsOf, creature and other grid object updates
+    MAP_UPDATE_PHASE_TRANSPORTS,
+    MAP_UPDATE_PHASE_OBJECT_UPDATES,
+    MAP_UPDATE_PHASE_SCRIPTS,
+    MAP_UPDATE_PHASE_MOVE_LISTS,
+    MAP_UPDATE_PHASE_RELOCATION_NOTIFIES,
+    MAP_UPDATE_PHASE_SCRIPT_HOOK,                           // ScriptMgr::OnMapUpdate
+    MAP_UPDATE_PHASE_OTHER,
+
+    MAX_MAP_UPDATE_PHASES
+};
+
+/**
+ * Per map breakdown of Map::Update time, switched on at runtime with .debug mapprofile.
+ *
+ * Keeps the time of each phase for the last WindowSize updates and the accumulated Creature::Update
+ * time of each creature since profiling was enabled. Disabled profilers cost a null check per phase.
+ */
+class TC_GAME_API MapUpdateProfiler
+{
+public:
+    static constexpr std::size_t WindowSize = 128;
+
+    struct PhaseStats
+    {
+        Microseconds Min = Microseconds::zero();
+        Microseconds Avg = Microseconds::zero();
+        Microseconds P99 = Microseconds::zero();
+        Microseconds Max = Microseconds::zero();
+    };
+
+    struct CreatureStats
+    {
+        ObjectGuid Guid;
+        uint32 Entry = 0;
+        uint32 Updates = 0;
+        Microseconds Total = Microseconds::zero();
+        Microseconds Max = Microseconds::zero();
+    };
+
+    struct Report
+    {
+        std::size_t Updates = 0;                            // number of updates the phase stats were computed from
+        std::array<PhaseStats, MAX_MAP_UPDATE_PHASES> Phases;
+        PhaseStats Total;
+        std::vector<CreatureStats> TopCreatures;
+    };
+
+private:
+    struct Data
+    {
+        std::mutex Lock;
+        std::array<std::array<Microseconds, WindowSize>, MAX_MAP_UPDATE_PHASES + 1> Samples; // last one is the whole update
+        std::size_t SampleCount = 0;
+        std::size_t NextSample = 0;
+        std::unordered_map<ObjectGuid, CreatureStats> Creatures;
+    };
+
+public:
+    // records one Map::Update, time between two SetPhase calls is added to the earlier phase
+    class Update
+    {
+    public:
+        explicit Update(MapUpdateProfiler& profiler);
+        ~Update();
+
+        Update(Update const&) = delete;
+        Update& operator=(Update const&) = delete;
+
+        bool IsActive() const { return _data != nullptr; }
+
+        void SetPhase(MapUpdatePhase phase)
+        {
+            if (_data)
+                SwitchPhase(phase);
+        }
+
+        void AddCreatureUpdate(Creature const* creature, Microseconds time);
+
+    private:
+        void SwitchPhase(MapUpdatePhase phase);
+
+        struct CreatureUpdate
+        {
+            ObjectGuid Guid;
+            uint32 Entry;
+            Microseconds Time;
+        };
+
+        Data* _data;
+        TimePoint _start;
+        TimePoint _phaseStart;
+        MapUpdatePhase _phase;
+        std::array<std::chrono::steady_clock::duration, MAX_MAP_UPDATE_PHASES> _phaseTimes;
+        std::vector<CreatureUpdate> _creatureUpdates;
+    };
+
+    MapUpdateProfiler();
+    ~MapUpdateProfiler();
+
+    // thread safe
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return _enabled.load(std::memory_order_acquire); }
+    Report BuildReport(std::size_t topCreatureCount) const;
+
+    static char const* GetPhaseName(MapUpdatePhase phase);
+
+private:
+    std::atomic<bool> _enabled;
+    std::unique_ptr<Data> _data;                            // created on first enable, kept until the map is destroyed
+    mutable std::mutex _createLock;
+};
+
+#endif // TRINITY_MAPUPDATEPROFILER_H
@@ -17,39 +17,121 @@
 
 #include "MapUpdater.h"
 #include "DatabaseEnv.h"
+#include "FlightRecorder.h"
 #include "Map.h"
+#include "MemoryStats.h"
 #include "Metric.h"
+#include "ProcessPriority.h"
+#include "Trace.h"
 
+#include <algorithm>
 #include <mutex>
 
 class MapUpdateRequest
 {
     private:
 
-        Map& m_map;
-        MapUpdater& m_updater;
+        Map* m_map;
+        MapUpdater* m_updater;
         uint32 m_diff;
 
     public:
 
+        MapUpdateRequest() : m_map(nullptr), m_updater(nullptr), m_diff(0) { }
+
         MapUpdateRequest(Map& m, MapUpdater& u, uint32 d)
-            : m_map(m), m_updater(u), m_diff(d)
+            : m_map(&m), m_updater(&u), m_diff(d)
         {
         }
 
+        Map* GetMap() const { return m_map; }
+
         void call()
         {
-            TC_METRIC_TIMER("map_update_time_diff", TC_METRIC_TAG("map_id", std::to_string(m_map.GetId())));
-            m_map.Update (m_diff);
-            m_updater.update_finished();
+            TC_METRIC_HANDLE_TIMER(m_map->GetUpdateTimeMetric());
+            TimePoint start = std::chrono::steady_clock::now();
+            m_map->Update(m_diff);
+            m_map->SetLastUpdateDuration(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start));
+            if (sFlightRecorder->IsEnabled())
+                sFlightRecorder->RecordMapUpdate(*m_map, m_map->GetLastUpdateDuration());
+            m_updater->update_finished();
         }
 };
 
-void MapUpdater::activate(size_t num_threads)
+// Requests are stored by value, the vector keeps its capacity between ticks so
+// after warmup scheduling a map does not allocate
+// Both the owner and thieves take from the front to preserve dispatch order (most expensive maps first)
+struct MapUpdater::WorkerQueue
+{
+    std::mutex Lock;
+    std::vector<MapUpdateRequest> Requests;
+    size_t Head = 0;
+
+    void Push(MapUpdateRequest const& request)
+    {
+        std::lock_guard<std::mutex> lock(Lock);
+        Requests.push_back(request);
+    }
+
+    bool Pop(MapUpdateRequest& request)
+    {
+        std::lock_guard<std::mutex> lock(Lock);
+        if (Head == Requests.size())
+            return false;
+
+        request = Requests[Head++];
+        Reset();
+        return true;
+    }
+
+    // cheapest request, used by thieves when maps have a home worker
+    bool PopBack(MapUpdateRequest& request)
+    {
+        std::lock_guard<std::mutex> lock(Lock);
+        if (Head == Requests.size())
+            return false;
+
+        request = Requests.back();
+        Requests.pop_back();
+        Reset();
+        return true;
+    }
+
+    void Reset()
+    {
+        if (Head == Requests.size())
+        {
+            Requests.clear();
+            Head = 0;
+        }
+    }
+};
+
+MapUpdater::MapUpdater() : _scheduler(MapUpdaterScheduler::Queue), _cancelationToken(false), pending_requests(0),
+    _nextWorkerQueue(0), _pendingRequests(0), _workGeneration(0)
+{
+}
+
+MapUpdater::~MapUpdater() = default;
+
+void MapUpdater::activate(size_t num_threads, MapUpdaterScheduler scheduler)
 {
+    _scheduler = scheduler;
+
+    if (UsesWorkerQueues())
+    {
+        for (size_t i = 0; i < num_threads; ++i)
+            _workerQueues.push_back(std::make_unique<WorkerQueue>());
+
+        for (size_t i = 0; i < num_threads; ++i)
+            _workerThreads.push_back(std::thread(&MapUpdater::WorkStealingWorkerThread, this, i));
+
+        return;
+    }
+
     for (size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
@@ -59,16 +141,35 @@ void MapUpdater::deactivate()
 
     wait();
 
-    _queue.Cancel();
+    if (UsesWorkerQueues())
+    {
+        ++_workGeneration;
+        _workGeneration.notify_all();
+    }
+    else
+        _queue.Cancel();
 
     for (auto& thread : _workerThreads)
     {
         thread.join();
     }
+
+    _workerThreads.clear();
+    _workerQueues.clear();
 }
 
 void MapUpdater::wait()
 {
+    dispatch_scheduled();
+
+    if (UsesWorkerQueues())
+    {
+        while (size_t pending = _pendingRequests.load(std::memory_order_acquire))
+            _pendingRequests.wait(pending, std::memory_order_acquire);
+
+        return;
+    }
+
     std::unique_lock<std::mutex> lock(_lock);
 
     while (pending_requests > 0)
@@ -79,11 +180,72 @@ void MapUpdater::wait()
 
 void MapUpdater::schedule_update(Map& map, uint32 diff)
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    _scheduledRequests.emplace_back(map, *this, diff);
+}
+
+void MapUpdater::dispatch_scheduled()
+{
+    if (_scheduledRequests.empty())
+        return;
+
+    // longest job first - a single expensive map picked up last would stretch the whole tick
+    std::stable_sort(_scheduledRequests.begin(), _scheduledRequests.end(), [](MapUpdateRequest const& left, MapUpdateRequest const& right)
+    {
+        return left.GetMap()->GetLastUpdateDuration() > right.GetMap()->GetLastUpdateDuration();
+    });
+
+    if (_scheduler == MapUpdaterScheduler::MapAffinity)
+    {
+        _pendingRequests.fetch_add(_scheduledRequests.size(), std::memory_order_relaxed);
+
+        // maps seen before go back to their worker, new ones are given to the worker with the least work this tick
+        std::vector<Microseconds> queuedWork(_workerQueues.size(), Microseconds::zero());
+        for (MapUpdateRequest const& request : _scheduledRequests)
+            if (Optional<uint32> worker = request.GetMap()->GetUpdateWorker(); worker && *worker < _workerQueues.size())
+                queuedWork[*worker] += request.GetMap()->GetLastUpdateDuration();
+
+        for (MapUpdateRequest const& request : _scheduledRequests)
+        {
+            Map* map = request.GetMap();
+            Optional<uint32> worker = map->GetUpdateWorker();
+            if (!worker || *worker >= _workerQueues.size())
+            {
+                // maps that were never updated count as 1ms so several of them created in the same tick are spread out
+                worker = uint32(std::distance(queuedWork.begin(), std::min_element(queuedWork.begin(), queuedWork.end())));
+                queuedWork[*worker] += std::max(map->GetLastUpdateDuration(), Microseconds(1000));
+                map->SetUpdateWorker(*worker);
+            }
+
+            _workerQueues[*worker]->Push(request);
+        }
 
-    ++pending_requests;
+        _workGeneration.fetch_add(1, std::memory_order_release);
+        _workGeneration.notify_all();
+    }
+    else if (_scheduler == MapUpdaterScheduler::WorkStealing)
+    {
+        _pendingRequests.fetch_add(_scheduledRequests.size(), std::memory_order_relaxed);
+
+        for (MapUpdateRequest const& request : _scheduledRequests)
+        {
+            _workerQueues[_nextWorkerQueue]->Push(request);
+            _nextWorkerQueue = (_nextWorkerQueue + 1) % _workerQueues.size();
+        }
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff));
+        _workGeneration.fetch_add(1, std::memory_order_release);
+        _workGeneration.notify_all();
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        pending_requests += _scheduledRequests.size();
+
+        for (MapUpdateRequest const& request : _scheduledRequests)
+            _queue.Push(new MapUpdateRequest(request));
+    }
+
+    _scheduledRequests.clear();
 }
 
 bool MapUpdater::activated()
@@ -93,6 +255,15 @@ bool MapUpdater::activated()
 
 void MapUpdater::update_finished()
 {
+    if (UsesWorkerQueues())
+    {
+        // only the last finisher wakes up the thread blocked in wait()
+        if (_pendingRequests.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            _pendingRequests.notify_all();
+
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(_lock);
 
     --pending_requests;
@@ -100,8 +271,11 @@ void MapUpdater::update_finished()
     _condition.notify_all();
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::WorkerThread(size_t index)
 {
+    TC_TRACE_THREAD_NAME("Map updater");
+    ApplyThreadClassAffinity(ThreadClass::MapUpdate, index);
+    Trinity::MemoryStats::BindThreadArena("Map updater");
     LoginDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
@@ -121,3 +295,48 @@ void MapUpdater::WorkerThread()
         delete request;
     }
 }
+
+void MapUpdater::WorkStealingWorkerThread(size_t index)
+{
+    TC_TRACE_THREAD_NAME("Map updater");
+    ApplyThreadClassAffinity(ThreadClass::MapUpdate, index);
+    Trinity::MemoryStats::BindThreadArena("Map updater");
+    LoginDatabase.WarnAboutSyncQueries(true);
+    CharacterDatabase.WarnAboutSyncQueries(true);
+    WorldDatabase.WarnAboutSyncQueries(true);
+    HotfixDatabase.WarnAboutSyncQueries(true);
+
+    while (1)
+    {
+        // read generation before looking for work, a push that happens after this load
+        // changes the value and makes the wait below return immediately
+        uint32 generation = _workGeneration.load(std::memory_order_acquire);
+
+        MapUpdateRequest request;
+        if (PopOrSteal(index, request))
+        {
+            request.call();
+            continue;
+        }
+
+        if (_cancelationToken)
+            return;
+
+        _workGeneration.wait(generation, std::memory_order_acquire);
+    }
+}
+
+bool MapUpdater::PopOrSteal(size_t index, MapUpdateRequest& request)
+{
+    if (_workerQueues[index]->Pop(request))
+        return true;
+
+    for (size_t i = 1; i < _workerQueues.size(); ++i)
+    {
+        WorkerQueue& victim = *_workerQueues[(index + i) % _workerQueues.size()];
+        if (_scheduler == MapUpdaterScheduler::MapAffinity ? victim.PopBack(request) : victim.Pop(request))
+            return true;
+    }
+
+    return false;
+}
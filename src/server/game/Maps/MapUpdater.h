@@ -19,20 +19,30 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <condition_variable>
+#include <vector>
 #include "ProducerConsumerQueue.h"
 
 class MapUpdateRequest;
 class Map;
 
+enum class MapUpdaterScheduler : uint8
+{
+    Queue           = 0,    // single shared ProducerConsumerQueue
+    WorkStealing    = 1,    // per worker deques, idle workers steal from busy ones
+    MapAffinity     = 2     // work stealing, but every map is always queued to the same worker so its memory stays local to it
+};
+
 class TC_GAME_API MapUpdater
 {
     public:
 
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
-        ~MapUpdater() { };
+        MapUpdater();
+        ~MapUpdater();
 
         friend class MapUpdateRequest;
 
@@ -40,7 +50,7 @@ class TC_GAME_API MapUpdater
 
         void wait();
 
-        void activate(size_t num_threads);
+        void activate(size_t num_threads, MapUpdaterScheduler scheduler = MapUpdaterScheduler::Queue);
 
         void deactivate();
 
@@ -48,8 +58,15 @@ class TC_GAME_API MapUpdater
 
     private:
 
+        struct WorkerQueue;
+
+        MapUpdaterScheduler _scheduler;
+
         ProducerConsumerQueue<MapUpdateRequest*> _queue;
 
+        // requests collected by schedule_update, dispatched by cost when wait() is called
+        std::vector<MapUpdateRequest> _scheduledRequests;
+
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
@@ -57,9 +74,22 @@ class TC_GAME_API MapUpdater
         std::condition_variable _condition;
         size_t pending_requests;
 
+        // work stealing scheduler state
+        std::vector<std::unique_ptr<WorkerQueue>> _workerQueues;
+        size_t _nextWorkerQueue;
+        std::atomic<size_t> _pendingRequests;   // countdown latch, wait() blocks until it reaches 0
+        std::atomic<uint32> _workGeneration;    // bumped on every push, idle workers wait on it
+
+        void dispatch_scheduled();
+
         void update_finished();
 
-        void WorkerThread();
+        bool UsesWorkerQueues() const { return _scheduler != MapUpdaterScheduler::Queue; }
+
+        void WorkerThread(size_t index);
+
+        void WorkStealingWorkerThread(size_t index);
+        bool PopOrSteal(size_t index, MapUpdateRequest& request);
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
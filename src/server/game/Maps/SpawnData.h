@@ -20,7 +20,8 @@
 
 #include "DBCEnums.h"
 #include "Position.h"
-#include <vector>
+#include <span>
+#include <string_view>
 
 class AreaTrigger;
 class Creature;
@@ -109,9 +110,9 @@ struct SpawnData : public SpawnMetadata
     int32 terrainSwapMap = -1;
     uint32 poolId = 0;
     int32 spawntimesecs = 0;
-    std::vector<Difficulty> spawnDifficulties;
+    std::span<Difficulty const> spawnDifficulties; // shared between all spawns with the same set, see ObjectMgr::GetSpawnDifficultySet
     uint32 scriptId = 0;
-    std::string StringId;
+    std::string_view StringId;                     // interned, see ObjectMgr::GetSpawnStringId
 
     protected:
     SpawnData(SpawnObjectType t) : SpawnMetadata(t) {}
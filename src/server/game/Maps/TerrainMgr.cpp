@@ -21,23 +21,33 @@
 #include "DynamicTree.h"
 #include "GridMap.h"
 #include "Log.h"
+#include "MapTree.h"
 #include "Memory.h"
+#include "Metric.h"
 #include "MMapFactory.h"
 #include "PhasingHandler.h"
 #include "Random.h"
 #include "ScriptMgr.h"
+#include "ThreadPool.h"
 #include "Util.h"
 #include "VMapFactory.h"
 #include "VMapManager2.h"
 #include "World.h"
 #include <G3D/g3dmath.h>
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+#include <tuple>
 
-TerrainInfo::TerrainInfo(uint32 mapId) : _mapId(mapId), _parentTerrain(nullptr), _cleanupTimer(randtime(CleanupInterval / 2, CleanupInterval))
+TerrainInfo::TerrainInfo(uint32 mapId) : _mapId(mapId), _parentTerrain(nullptr), _gridMemoryUsage(), _cleanupTimer(randtime(CleanupInterval / 2, CleanupInterval))
 {
 }
 
 TerrainInfo::~TerrainInfo()
 {
+    for (int32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+        for (int32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+            sTerrainMgr.RemoveMemoryUsage(_gridMemoryUsage[x][y]);
+
     VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId());
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId());
 }
@@ -160,7 +170,76 @@ void TerrainInfo::LoadMapAndVMap(int32 gx, int32 gy)
         return;
 
     std::lock_guard<std::mutex> lock(_loadMutex);
-    LoadMapAndVMapImpl(gx, gy);
+    if (!_loadedGrids[GetBitsetIndex(gx, gy)])
+        LoadMapAndVMapImpl(gx, gy);
+}
+
+void TerrainInfo::LoadMapAndVMapAsync(int32 gx, int32 gy, Trinity::ThreadPool& pool)
+{
+    if (++_referenceCountFromMap[gx][gy] != 1)    // check if already loaded
+        return;
+
+    if (_loadedGrids[GetBitsetIndex(gx, gy)])
+        return;
+
+    _loadingInBackground[gx][gy] = true;
+    pool.PostWork([terrain = shared_from_this(), gx, gy]()
+    {
+        std::lock_guard<std::mutex> lock(terrain->_loadMutex);
+        if (!terrain->_loadedGrids[GetBitsetIndex(gx, gy)])
+            terrain->LoadMapAndVMapImpl(gx, gy);
+
+        terrain->_loadingInBackground[gx][gy] = false;
+    });
+}
+
+void TerrainInfo::WaitForGrid(int32 gx, int32 gy)
+{
+    if (_loadedGrids[GetBitsetIndex(gx, gy)])
+        return;
+
+    std::lock_guard<std::mutex> lock(_loadMutex);
+    if (!_loadedGrids[GetBitsetIndex(gx, gy)])
+        LoadMapAndVMapImpl(gx, gy);
+}
+
+void TerrainInfo::PreloadAllGrids(Trinity::ThreadPool& pool, std::atomic<uint32>& loadedGrids)
+{
+    for (int32 gx = 0; gx < MAX_NUMBER_OF_GRIDS; ++gx)
+    {
+        pool.PostWork([terrain = shared_from_this(), gx, &loadedGrids]()
+        {
+            std::bitset<MAX_NUMBER_OF_GRIDS> gridFiles;
+            {
+                std::lock_guard<std::mutex> lock(terrain->_loadMutex);
+                for (int32 gy = 0; gy < MAX_NUMBER_OF_GRIDS; ++gy)
+                    gridFiles[gy] = terrain->_gridFileExists[GetBitsetIndex(gx, gy)] && !terrain->_loadedGrids[GetBitsetIndex(gx, gy)];
+            }
+
+            for (int32 gy = 0; gy < MAX_NUMBER_OF_GRIDS; ++gy)
+            {
+                if (!gridFiles[gy])
+                    continue;
+
+                // parsing the map file only touches the new GridMap, on failure LoadMap below reads it again and reports the error
+                std::unique_ptr<GridMap> gridMap = std::make_unique<GridMap>();
+                std::string fileName = Trinity::StringFormat("{}maps/{:04}_{:02}_{:02}.map", sWorld->GetDataPath(), terrain->GetId(), gx, gy);
+                if (gridMap->loadData(fileName.c_str()) != GridMap::LoadResult::Ok)
+                    gridMap = nullptr;
+
+                std::lock_guard<std::mutex> lock(terrain->_loadMutex);
+                if (!terrain->_loadedGrids[GetBitsetIndex(gx, gy)])
+                {
+                    if (gridMap && !terrain->_gridMap[gx][gy])
+                        terrain->_gridMap[gx][gy] = std::move(gridMap);
+
+                    terrain->LoadMapAndVMapImpl(gx, gy);
+                }
+
+                ++loadedGrids;
+            }
+        });
+    }
 }
 
 void TerrainInfo::LoadMapAndVMapImpl(int32 gx, int32 gy)
@@ -169,6 +248,9 @@ void TerrainInfo::LoadMapAndVMapImpl(int32 gx, int32 gy)
     LoadVMap(gx, gy);
     LoadMMap(gx, gy);
 
+    _gridMemoryUsage[gx][gy] = EstimateGridMemoryUsage(gx, gy);
+    sTerrainMgr.AddMemoryUsage(_gridMemoryUsage[gx][gy]);
+
     for (std::shared_ptr<TerrainInfo> const& childTerrain : _childTerrain)
         childTerrain->LoadMapAndVMapImpl(gx, gy);
 
@@ -234,9 +316,34 @@ void TerrainInfo::LoadMMap(int32 gx, int32 gy)
         TC_LOG_WARN("mmaps.tiles", "Could not load MMAP name:{}, id:{}, x:{}, y:{} (mmap rep.: x:{}, y:{})", GetMapName(), GetId(), gx, gy, gx, gy);
 }
 
+uint32 TerrainInfo::EstimateGridMemoryUsage(int32 gx, int32 gy) const
+{
+    // all three loaders keep the tile data in memory as read from disk, file sizes are a good approximation
+    // models referenced by vmap tiles are shared between tiles and maps and are not attributed to any grid
+    auto fileSize = [](std::string const& fileName) -> uint32
+    {
+        boost::system::error_code error;
+        uintmax_t size = boost::filesystem::file_size(fileName, error);
+        return !error ? uint32(size) : 0;
+    };
+
+    uint32 size = 0;
+    if (_gridMap[gx][gy])
+        size += fileSize(Trinity::StringFormat("{}maps/{:04}_{:02}_{:02}.map", sWorld->GetDataPath(), GetId(), gx, gy));
+
+    if (VMAP::VMapFactory::createOrGetVMapManager()->isMapLoadingEnabled())
+        size += fileSize(sWorld->GetDataPath() + "vmaps/" + VMAP::StaticMapTree::getTileFileName(GetId(), gx, gy));
+
+    if (DisableMgr::IsPathfindingEnabled(GetId()))
+        size += fileSize(Trinity::StringFormat("{}mmaps/{:04}{:02}{:02}.mmtile", sWorld->GetDataPath(), GetId(), gx, gy));
+
+    return size;
+}
+
 void TerrainInfo::UnloadMap(int32 gx, int32 gy)
 {
-    --_referenceCountFromMap[gx][gy];
+    if (!--_referenceCountFromMap[gx][gy])
+        _gridReleaseTime[gx][gy] = getMSTime();
     // unload later
 }
 
@@ -249,6 +356,8 @@ void TerrainInfo::UnloadMapImpl(int32 gx, int32 gy)
     for (std::shared_ptr<TerrainInfo> const& childTerrain : _childTerrain)
         childTerrain->UnloadMapImpl(gx, gy);
 
+    sTerrainMgr.RemoveMemoryUsage(_gridMemoryUsage[gx][gy]);
+    _gridMemoryUsage[gx][gy] = 0;
     _loadedGrids[GetBitsetIndex(gx, gy)] = false;
 }
 
@@ -259,10 +368,17 @@ GridMap* TerrainInfo::GetGrid(uint32 mapId, float x, float y, bool loadIfMissing
     int32 gy = (int)(CENTER_GRID_ID - y / SIZE_OF_GRIDS);                   //grid y
 
     // ensure GridMap is loaded
-    if (!_loadedGrids[GetBitsetIndex(gx, gy)] && loadIfMissing)
+    if (!_loadedGrids[GetBitsetIndex(gx, gy)])
     {
+        // files are being read in the background, callers fall back to no terrain data instead of waiting
+        // the GridMap of a grid that is not resident yet may still be written by the loading thread
+        if (!loadIfMissing || _loadingInBackground[gx][gy])
+            return nullptr;
+
         std::lock_guard<std::mutex> lock(_loadMutex);
-        LoadMapAndVMapImpl(gx, gy);
+        // another thread might have finished loading it while we were waiting for the lock
+        if (!_loadedGrids[GetBitsetIndex(gx, gy)])
+            LoadMapAndVMapImpl(gx, gy);
     }
 
     GridMap* grid = _gridMap[gx][gy].get();
@@ -278,10 +394,17 @@ GridMap* TerrainInfo::GetGrid(uint32 mapId, float x, float y, bool loadIfMissing
 
 void TerrainInfo::CleanUpGrids(uint32 diff)
 {
+    // budget driven eviction replaces periodic cleanup, see TerrainMgr::EvictOverBudget
+    if (sTerrainMgr.GetMemoryBudget())
+        return;
+
     _cleanupTimer.Update(diff);
     if (!_cleanupTimer.Passed())
         return;
 
+    // grids can be preloaded in the background while the world thread gets here
+    std::lock_guard<std::mutex> lock(_loadMutex);
+
     // delete those GridMap objects which have refcount = 0
     for (int32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
         for (int32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
@@ -291,6 +414,28 @@ void TerrainInfo::CleanUpGrids(uint32 diff)
     _cleanupTimer.Reset(CleanupInterval);
 }
 
+void TerrainInfo::GetEvictionCandidates(std::vector<EvictionCandidate>& candidates)
+{
+    std::lock_guard<std::mutex> lock(_loadMutex);
+
+    for (int32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+        for (int32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+            if (_loadedGrids[GetBitsetIndex(x, y)] && !_referenceCountFromMap[x][y])
+                candidates.push_back({ shared_from_this(), x, y, _gridReleaseTime[x][y] });
+}
+
+bool TerrainInfo::EvictGrid(int32 gx, int32 gy)
+{
+    std::lock_guard<std::mutex> lock(_loadMutex);
+
+    // a map could have picked the grid up again since candidates were collected
+    if (!_loadedGrids[GetBitsetIndex(gx, gy)] || _referenceCountFromMap[gx][gy])
+        return false;
+
+    UnloadMapImpl(gx, gy);
+    return true;
+}
+
 static bool IsInWMOInterior(uint32 mogpFlags)
 {
     return (mogpFlags & 0x2000) != 0;
@@ -650,6 +795,31 @@ float TerrainInfo::GetGridHeight(PhaseShift const& phaseShift, uint32 mapId, flo
     return VMAP_INVALID_HEIGHT_VALUE;
 }
 
+void TerrainInfo::GetGridHeights(PhaseShift const& phaseShift, uint32 mapId, float const* x, float const* y, float* heights, std::size_t count)
+{
+    auto getGridKey = [&](std::size_t i)
+    {
+        return std::make_tuple(PhasingHandler::GetTerrainMapId(phaseShift, mapId, this, x[i], y[i]),
+            int32(CENTER_GRID_ID - x[i] / SIZE_OF_GRIDS), int32(CENTER_GRID_ID - y[i] / SIZE_OF_GRIDS));
+    };
+
+    // consecutive points on the same grid, like the points of a spline, are sampled in one go
+    for (std::size_t first = 0; first < count;)
+    {
+        auto gridKey = getGridKey(first);
+        std::size_t last = first + 1;
+        while (last < count && getGridKey(last) == gridKey)
+            ++last;
+
+        if (GridMap* gmap = GetGrid(std::get<0>(gridKey), x[first], y[first]))
+            gmap->getHeights(x + first, y + first, heights + first, last - first);
+        else
+            std::fill(heights + first, heights + last, VMAP_INVALID_HEIGHT_VALUE);
+
+        first = last;
+    }
+}
+
 float TerrainInfo::GetStaticHeight(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/)
 {
     // find raw .map surface under Z coordinates
@@ -790,6 +960,49 @@ void TerrainMgr::Update(uint32 diff)
     for (auto& [mapId, terrainRef] : _terrainMaps)
         if (std::shared_ptr<TerrainInfo> terrain = terrainRef.lock())
             terrain->CleanUpGrids(diff);
+
+    _budgetCheckTimer.Update(diff);
+    if (!_budgetCheckTimer.Passed())
+        return;
+
+    _budgetCheckTimer.Reset(BudgetCheckInterval);
+
+    if (_memoryBudget && _memoryUsage > _memoryBudget)
+        EvictOverBudget();
+
+    TC_METRIC_VALUE("terrain_memory_usage", GetMemoryUsage());
+    TC_METRIC_VALUE("terrain_evictions", _evictionCount);
+}
+
+void TerrainMgr::EvictOverBudget()
+{
+    std::vector<TerrainInfo::EvictionCandidate> candidates;
+    for (auto& [mapId, terrainRef] : _terrainMaps)
+        if (std::shared_ptr<TerrainInfo> terrain = terrainRef.lock())
+            terrain->GetEvictionCandidates(candidates);
+
+    uint32 now = getMSTime();
+    std::sort(candidates.begin(), candidates.end(), [now](TerrainInfo::EvictionCandidate const& left, TerrainInfo::EvictionCandidate const& right)
+    {
+        return getMSTimeDiff(left.ReleaseTime, now) > getMSTimeDiff(right.ReleaseTime, now);
+    });
+
+    uint64 evicted = 0;
+    for (TerrainInfo::EvictionCandidate const& candidate : candidates)
+    {
+        if (_memoryUsage <= _memoryBudget)
+            break;
+
+        if (candidate.Terrain->EvictGrid(candidate.GridX, candidate.GridY))
+            ++evicted;
+    }
+
+    _evictionCount += evicted;
+
+    if (_memoryUsage > _memoryBudget)
+        TC_LOG_DEBUG("maps", "TerrainMgr: evicted {} grids, usage {} bytes is still above budget {} bytes, remaining grids are in use", evicted, GetMemoryUsage(), _memoryBudget);
+    else
+        TC_LOG_DEBUG("maps", "TerrainMgr: evicted {} grids, usage {} bytes, budget {} bytes", evicted, GetMemoryUsage(), _memoryBudget);
 }
 
 uint32 TerrainMgr::GetAreaId(PhaseShift const& phaseShift, uint32 mapid, float x, float y, float z)
@@ -34,7 +34,12 @@ class DynamicMapTree;
 class GridMap;
 class PhaseShift;
 
-class TC_GAME_API TerrainInfo
+namespace Trinity
+{
+class ThreadPool;
+}
+
+class TC_GAME_API TerrainInfo : public std::enable_shared_from_this<TerrainInfo>
 {
 public:
     explicit TerrainInfo(uint32 mapId);
@@ -57,11 +62,25 @@ public:
 
     void LoadMapAndVMap(int32 gx, int32 gy);
 
+    // Takes a reference like LoadMapAndVMap but reads the files on pool; until they are resident
+    // terrain queries for the grid return no data instead of waiting for the disk. vmap and mmap tiles
+    // are added under the exclusive locks of their managers, queries of other grids wait only for that
+    void LoadMapAndVMapAsync(int32 gx, int32 gy, Trinity::ThreadPool& pool);
+    bool IsGridResident(int32 gx, int32 gy) const { return _loadedGrids[GetBitsetIndex(gx, gy)]; }
+    void WaitForGrid(int32 gx, int32 gy);
+
+    // Loads every grid that has a map file without taking references, one task per grid row on pool.
+    // Map files are parsed concurrently, vmap and mmap tiles of a terrain are still added one at a time
+    // under the load lock. loadedGrids is incremented for every grid as it becomes resident
+    void PreloadAllGrids(Trinity::ThreadPool& pool, std::atomic<uint32>& loadedGrids);
+    uint32 GetGridFileCount() const { return uint32(_gridFileExists.count()); }
+
 private:
     void LoadMapAndVMapImpl(int32 gx, int32 gy);
     void LoadMap(int32 gx, int32 gy);
     void LoadVMap(int32 gx, int32 gy);
     void LoadMMap(int32 gx, int32 gy);
+    uint32 EstimateGridMemoryUsage(int32 gx, int32 gy) const;
 
 public:
     void UnloadMap(int32 gx, int32 gy);
@@ -74,6 +93,18 @@ private:
 public:
     void CleanUpGrids(uint32 diff);
 
+    // Unreferenced resident grids (root terrain only, children are unloaded together with their parent grid)
+    struct EvictionCandidate
+    {
+        std::shared_ptr<TerrainInfo> Terrain;
+        int32 GridX;
+        int32 GridY;
+        uint32 ReleaseTime;
+    };
+
+    void GetEvictionCandidates(std::vector<EvictionCandidate>& candidates);
+    bool EvictGrid(int32 gx, int32 gy);
+
     void GetFullTerrainStatusForPosition(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, PositionFullTerrainStatus& data, map_liquidHeaderTypeFlags reqLiquidType = map_liquidHeaderTypeFlags::AllLiquids, float collisionHeight = 2.03128f, DynamicMapTree const* dynamicMapTree = nullptr); // DEFAULT_COLLISION_HEIGHT in Object.h
     ZLiquidStatus GetLiquidStatus(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, map_liquidHeaderTypeFlags ReqLiquidType, LiquidData* data = nullptr, float collisionHeight = 2.03128f); // DEFAULT_COLLISION_HEIGHT in Object.h
 
@@ -87,6 +118,7 @@ public:
 
     float GetMinHeight(PhaseShift const& phaseShift, uint32 mapId, float x, float y);
     float GetGridHeight(PhaseShift const& phaseShift, uint32 mapId, float x, float y);
+    void GetGridHeights(PhaseShift const& phaseShift, uint32 mapId, float const* x, float const* y, float* heights, std::size_t count);
     float GetStaticHeight(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH);
     float GetStaticHeight(PhaseShift const& phaseShift, uint32 mapId, Position const& pos, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) { return GetStaticHeight(phaseShift, mapId, pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), checkVMap, maxSearchDist); }
 
@@ -107,8 +139,11 @@ private:
     std::mutex _loadMutex;
     std::unique_ptr<GridMap> _gridMap[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
     std::atomic<uint16> _referenceCountFromMap[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
-    std::bitset<MAX_NUMBER_OF_GRIDS* MAX_NUMBER_OF_GRIDS> _loadedGrids;
+    std::atomic<bool> _loadedGrids[MAX_NUMBER_OF_GRIDS * MAX_NUMBER_OF_GRIDS]; // only set under _loadMutex, atomic because maps check them without it
     std::bitset<MAX_NUMBER_OF_GRIDS* MAX_NUMBER_OF_GRIDS> _gridFileExists; // cache what grids are available for this map (not including parent/child maps)
+    std::atomic<bool> _loadingInBackground[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+    uint32 _gridMemoryUsage[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS]; // estimated bytes of map, vmap and mmap tile data owned by this terrain, guarded by _loadMutex
+    std::atomic<uint32> _gridReleaseTime[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS]; // getMSTime() when the last map reference was dropped
 
     static constexpr Milliseconds CleanupInterval = 1min;
 
@@ -149,13 +184,30 @@ public:
 
     static bool ExistMapAndVMap(uint32 mapid, float x, float y);
 
+    void SetMemoryBudget(uint64 bytes) { _memoryBudget = bytes; }
+    uint64 GetMemoryBudget() const { return _memoryBudget; }
+    uint64 GetMemoryUsage() const { return _memoryUsage; }
+    uint64 GetEvictionCount() const { return _evictionCount; }
+
+    void AddMemoryUsage(uint32 bytes) { _memoryUsage += bytes; }
+    void RemoveMemoryUsage(uint32 bytes) { _memoryUsage -= bytes; }
+
 private:
     std::shared_ptr<TerrainInfo> LoadTerrainImpl(uint32 mapId);
+    void EvictOverBudget();
 
     std::unordered_map<uint32, std::weak_ptr<TerrainInfo>> _terrainMaps;
 
     // parent map links
     std::unordered_map<uint32, std::vector<uint32>> _parentMapData;
+
+    // with a budget set unreferenced grids stay resident until usage exceeds it, then the least recently released are unloaded first
+    uint64 _memoryBudget = 0;
+    std::atomic<uint64> _memoryUsage = 0;
+    uint64 _evictionCount = 0;
+
+    static constexpr Milliseconds BudgetCheckInterval = 1s;
+    TimeTracker _budgetCheckTimer = TimeTracker(BudgetCheckInterval);
 };
 
 #define sTerrainMgr TerrainMgr::Instance()
@@ -88,10 +88,16 @@ MotionMaster::MotionMaster(Unit* unit) : _owner(unit), _defaultGenerator(nullptr
 
 MotionMaster::~MotionMaster()
 {
+    // generators waiting to be added are owned by their action
+    for (DelayedAction const& action : _delayedActions)
+        if (action.Type == MOTIONMASTER_DELAYED_ADD)
+            MovementGeneratorPointerDeleter(action.Movement);
+
     _delayedActions.clear();
 
-    for (auto itr = _generators.begin(); itr != _generators.end(); itr = _generators.erase(itr))
-        MovementGeneratorPointerDeleter(*itr);
+    for (MovementGenerator* movement : _generators)
+        MovementGeneratorPointerDeleter(movement);
+    _generators.clear();
 }
 
 void MotionMaster::Initialize()
@@ -101,11 +107,7 @@ void MotionMaster::Initialize()
 
     if (HasFlag(MOTIONMASTER_FLAG_UPDATE))
     {
-        DelayedActionDefine action = [this]()
-        {
-            Initialize();
-        };
-        _delayedActions.emplace_back(std::move(action), MOTIONMASTER_DELAYED_INITIALIZE);
+        AddDelayedAction(MOTIONMASTER_DELAYED_INITIALIZE);
         return;
     }
 
@@ -340,13 +342,7 @@ void MotionMaster::Add(MovementGenerator* movement, MovementSlot slot/* = MOTION
     }
 
     if (HasFlag(MOTIONMASTER_FLAG_DELAYED))
-    {
-        DelayedActionDefine action = [this, movement, slot]()
-        {
-            Add(movement, slot);
-        };
-        _delayedActions.emplace_back(std::move(action), MOTIONMASTER_DELAYED_ADD);
-    }
+        AddDelayedAction(MOTIONMASTER_DELAYED_ADD, 0, slot, movement);
     else
         DirectAdd(movement, slot);
 }
@@ -358,11 +354,7 @@ void MotionMaster::Remove(MovementGenerator* movement, MovementSlot slot/* = MOT
 
     if (HasFlag(MOTIONMASTER_FLAG_DELAYED))
     {
-        DelayedActionDefine action = [this, movement, slot]()
-        {
-            Remove(movement, slot);
-        };
-        _delayedActions.emplace_back(std::move(action), MOTIONMASTER_DELAYED_REMOVE);
+        AddDelayedAction(MOTIONMASTER_DELAYED_REMOVE, 0, slot, movement);
         return;
     }
 
@@ -378,9 +370,9 @@ void MotionMaster::Remove(MovementGenerator* movement, MovementSlot slot/* = MOT
         case MOTION_SLOT_ACTIVE:
             if (!_generators.empty())
             {
-                auto bounds = _generators.equal_range(movement);
+                auto bounds = std::equal_range(_generators.begin(), _generators.end(), movement, MovementGeneratorComparator());
                 auto itr = std::find(bounds.first, bounds.second, movement);
-                if (itr != _generators.end())
+                if (itr != bounds.second)
                     Remove(itr, GetCurrentMovementGenerator() == *itr, false);
             }
             break;
@@ -396,11 +388,7 @@ void MotionMaster::Remove(MovementGeneratorType type, MovementSlot slot/* = MOTI
 
     if (HasFlag(MOTIONMASTER_FLAG_DELAYED))
     {
-        DelayedActionDefine action = [this, type, slot]()
-        {
-            Remove(type, slot);
-        };
-        _delayedActions.emplace_back(std::move(action), MOTIONMASTER_DELAYED_REMOVE_TYPE);
+        AddDelayedAction(MOTIONMASTER_DELAYED_REMOVE_TYPE, type, slot);
         return;
     }
 
@@ -434,11 +422,7 @@ void MotionMaster::Clear()
 {
     if (HasFlag(MOTIONMASTER_FLAG_DELAYED))
     {
-        DelayedActionDefine action = [this]()
-        {
-            Clear();
-        };
-        _delayedActions.emplace_back(std::move(action), MOTIONMASTER_DELAYED_CLEAR);
+        AddDelayedAction(MOTIONMASTER_DELAYED_CLEAR);
         return;
     }
 
@@ -453,11 +437,7 @@ void MotionMaster::Clear(MovementSlot slot)
 
     if (HasFlag(MOTIONMASTER_FLAG_DELAYED))
     {
-        DelayedActionDefine action = [this, slot]()
-        {
-            Clear(slot);
-        };
-        _delayedActions.emplace_back(std::move(action), MOTIONMASTER_DELAYED_CLEAR_SLOT);
+        AddDelayedAction(MOTIONMASTER_DELAYED_CLEAR_SLOT, 0, slot);
         return;
     }
 
@@ -481,11 +461,7 @@ void MotionMaster::Clear(MovementGeneratorMode mode)
 {
     if (HasFlag(MOTIONMASTER_FLAG_DELAYED))
     {
-        DelayedActionDefine action = [this, mode]()
-        {
-            Clear(mode);
-        };
-        _delayedActions.emplace_back(std::move(action), MOTIONMASTER_DELAYED_CLEAR_MODE);
+        AddDelayedAction(MOTIONMASTER_DELAYED_CLEAR_MODE, mode);
         return;
     }
 
@@ -503,11 +479,7 @@ void MotionMaster::Clear(MovementGeneratorPriority priority)
 {
     if (HasFlag(MOTIONMASTER_FLAG_DELAYED))
     {
-        DelayedActionDefine action = [this, priority]()
-        {
-            Clear(priority);
-        };
-        _delayedActions.emplace_back(std::move(action), MOTIONMASTER_DELAYED_CLEAR_PRIORITY);
+        AddDelayedAction(MOTIONMASTER_DELAYED_CLEAR_PRIORITY, priority);
         return;
     }
 
@@ -1182,12 +1154,48 @@ void MotionMaster::CalculateJumpSpeeds(float dist, UnitMoveType moveType, float
 
 /******************** Private methods ********************/
 
+void MotionMaster::AddDelayedAction(MotionMasterDelayedActionType type, uint8 argument/* = 0*/, MovementSlot slot/* = MOTION_SLOT_DEFAULT*/, MovementGenerator* movement/* = nullptr*/)
+{
+    _delayedActions.push_back({ type, argument, slot, movement });
+}
+
 void MotionMaster::ResolveDelayedActions()
 {
     while (!_delayedActions.empty())
     {
-        _delayedActions.front().Resolve();
-        _delayedActions.pop_front();
+        // taken out first, resolving may queue new actions
+        DelayedAction action = _delayedActions.front();
+        _delayedActions.erase(_delayedActions.begin());
+
+        switch (action.Type)
+        {
+            case MOTIONMASTER_DELAYED_CLEAR:
+                Clear();
+                break;
+            case MOTIONMASTER_DELAYED_CLEAR_SLOT:
+                Clear(action.Slot);
+                break;
+            case MOTIONMASTER_DELAYED_CLEAR_MODE:
+                Clear(MovementGeneratorMode(action.Argument));
+                break;
+            case MOTIONMASTER_DELAYED_CLEAR_PRIORITY:
+                Clear(MovementGeneratorPriority(action.Argument));
+                break;
+            case MOTIONMASTER_DELAYED_ADD:
+                Add(action.Movement, action.Slot);
+                break;
+            case MOTIONMASTER_DELAYED_REMOVE:
+                Remove(action.Movement, action.Slot);
+                break;
+            case MOTIONMASTER_DELAYED_REMOVE_TYPE:
+                Remove(MovementGeneratorType(action.Argument), action.Slot);
+                break;
+            case MOTIONMASTER_DELAYED_INITIALIZE:
+                Initialize();
+                break;
+            default:
+                break;
+        }
     }
 }
 
@@ -1238,17 +1246,18 @@ void MotionMaster::DirectClear(std::function<bool(MovementGenerator*)> const& fi
     if (_generators.empty())
         return;
 
+    // indexed, finalizing a generator may add another one and move the storage
     MovementGenerator const* top = GetCurrentMovementGenerator();
-    for (auto itr = _generators.begin(); itr != _generators.end();)
+    for (std::size_t i = 0; i < _generators.size();)
     {
-        if (filter(*itr))
+        if (filter(_generators[i]))
         {
-            MovementGenerator* movement = *itr;
-            itr = _generators.erase(itr);
+            MovementGenerator* movement = _generators[i];
+            _generators.erase(_generators.begin() + i);
             Delete(movement, movement == top, false);
         }
         else
-            ++itr;
+            ++i;
     }
 }
 
@@ -1318,7 +1327,7 @@ void MotionMaster::DirectAdd(MovementGenerator* movement, MovementSlot slot/* =
             else
                 _defaultGenerator->Deactivate(_owner);
 
-            _generators.emplace(movement);
+            _generators.insert(std::upper_bound(_generators.begin(), _generators.end(), movement, MovementGeneratorComparator()), movement);
             AddBaseUnitState(movement);
             break;
         default:
@@ -1351,7 +1360,7 @@ void MotionMaster::AddBaseUnitState(MovementGenerator const* movement)
     if (!movement || !movement->BaseUnitState)
         return;
 
-    _baseUnitStatesMap.emplace(movement->BaseUnitState, movement);
+    _baseUnitStates.emplace_back(movement->BaseUnitState, movement);
     _owner->AddUnitState(movement->BaseUnitState);
 }
 
@@ -1360,17 +1369,20 @@ void MotionMaster::ClearBaseUnitState(MovementGenerator const* movement)
     if (!movement || !movement->BaseUnitState)
         return;
 
-    Trinity::Containers::MultimapErasePair(_baseUnitStatesMap, movement->BaseUnitState, movement);
-    if (_baseUnitStatesMap.count(movement->BaseUnitState) == 0)
+    auto itr = std::find(_baseUnitStates.begin(), _baseUnitStates.end(), std::make_pair(movement->BaseUnitState, movement));
+    if (itr != _baseUnitStates.end())
+        _baseUnitStates.erase(itr);
+
+    if (std::ranges::none_of(_baseUnitStates, [state = movement->BaseUnitState](std::pair<uint32, MovementGenerator const*> const& entry) { return entry.first == state; }))
         _owner->ClearUnitState(movement->BaseUnitState);
 }
 
 void MotionMaster::ClearBaseUnitStates()
 {
     uint32 unitState = 0;
-    for (auto itr = _baseUnitStatesMap.begin(); itr != _baseUnitStatesMap.end(); ++itr)
-        unitState |= itr->first;
+    for (std::pair<uint32, MovementGenerator const*> const& entry : _baseUnitStates)
+        unitState |= entry.first;
 
     _owner->ClearUnitState(unitState);
-    _baseUnitStatesMap.clear();
+    _baseUnitStates.clear();
 }
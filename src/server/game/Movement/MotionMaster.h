@@ -25,10 +25,8 @@
 #include "MovementDefines.h"
 #include "MovementGenerator.h"
 #include "SharedDefines.h"
-#include <deque>
+#include <boost/container/small_vector.hpp>
 #include <functional>
-#include <set>
-#include <unordered_map>
 #include <vector>
 
 class PathGenerator;
@@ -88,29 +86,16 @@ struct MovementGeneratorInformation
     std::string TargetName;
 };
 
-static bool EmptyValidator()
-{
-    return true;
-}
-
 class TC_GAME_API MotionMaster
 {
     public:
-        typedef std::function<void()> DelayedActionDefine;
-        typedef std::function<bool()> DelayedActionValidator;
-
-        class DelayedAction
+        // call of a public method postponed until the current update is done, stored without allocating
+        struct DelayedAction
         {
-            public:
-                explicit DelayedAction(DelayedActionDefine&& action, DelayedActionValidator&& validator, MotionMasterDelayedActionType type) : Action(std::move(action)), Validator(std::move(validator)), Type(type) { }
-                explicit DelayedAction(DelayedActionDefine&& action, MotionMasterDelayedActionType type) : Action(std::move(action)), Validator(EmptyValidator), Type(type) { }
-                ~DelayedAction() { }
-
-                void Resolve() { if (Validator()) Action(); }
-
-                DelayedActionDefine Action;
-                DelayedActionValidator Validator;
-                uint8 Type;
+            MotionMasterDelayedActionType Type;
+            uint8 Argument;                 // slot, mode, priority or movement generator type
+            MovementSlot Slot;
+            MovementGenerator* Movement;
         };
 
         explicit MotionMaster(Unit* unit);
@@ -213,13 +198,15 @@ class TC_GAME_API MotionMaster
 
     private:
         typedef std::unique_ptr<MovementGenerator, MovementGeneratorDeleter> MovementGeneratorPointer;
-        typedef std::multiset<MovementGenerator*, MovementGeneratorComparator> MotionMasterContainer;
-        typedef std::unordered_multimap<uint32, MovementGenerator const*> MotionMasterUnitStatesContainer;
+        // sorted by MovementGeneratorComparator, there is rarely more than one generator per priority
+        typedef boost::container::small_vector<MovementGenerator*, 3> MotionMasterContainer;
+        typedef boost::container::small_vector<std::pair<uint32, MovementGenerator const*>, 3> MotionMasterUnitStatesContainer;
 
         void AddFlag(uint8 const flag) { _flags |= flag; }
         bool HasFlag(uint8 const flag) const { return (_flags & flag) != 0; }
         void RemoveFlag(uint8 const flag) { _flags &= ~flag; }
 
+        void AddDelayedAction(MotionMasterDelayedActionType type, uint8 argument = 0, MovementSlot slot = MOTION_SLOT_DEFAULT, MovementGenerator* movement = nullptr);
         void ResolveDelayedActions();
         void Remove(MotionMasterContainer::iterator iterator, bool active, bool movementInform);
         void Pop(bool active, bool movementInform);
@@ -238,8 +225,8 @@ class TC_GAME_API MotionMaster
         Unit* _owner;
         MovementGeneratorPointer _defaultGenerator;
         MotionMasterContainer _generators;
-        MotionMasterUnitStatesContainer _baseUnitStatesMap;
-        std::deque<DelayedAction> _delayedActions;
+        MotionMasterUnitStatesContainer _baseUnitStates;
+        boost::container::small_vector<DelayedAction, 2> _delayedActions;
         uint8 _flags;
 };
 
@@ -22,6 +22,7 @@
 #include "FactoryHolder.h"
 #include "MovementDefines.h"
 #include "ObjectRegistry.h"
+#include "RecyclingAllocator.h"
 
 class Creature;
 class Unit;
@@ -77,10 +78,30 @@ class TC_GAME_API MovementGenerator
 
         virtual std::string GetDebugInfo() const;
 
+        // generators are replaced all the time in combat, sizes are rounded up so that all types share a few recycled size classes
+        static void* operator new(std::size_t size)
+        {
+            if (size > MaxRecycledSize)
+                return ::operator new(size);
+            return Trinity::RecyclingAllocator::Allocate(GetRecycledSize(size));
+        }
+
+        static void operator delete(void* ptr, std::size_t size)
+        {
+            if (size > MaxRecycledSize)
+                ::operator delete(ptr);
+            else
+                Trinity::RecyclingAllocator::Deallocate(ptr, GetRecycledSize(size));
+        }
+
         uint8 Mode;
         uint8 Priority;
         uint16 Flags;
         uint32 BaseUnitState;
+
+    private:
+        static constexpr std::size_t MaxRecycledSize = 256;
+        static constexpr std::size_t GetRecycledSize(std::size_t size) { return (size + 63) & ~std::size_t(63); }
 };
 
 template<class T, class D>
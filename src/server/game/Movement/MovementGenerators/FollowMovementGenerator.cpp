@@ -118,6 +118,15 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
         }
     }
 
+    // keep following the current spline until the path requested on an earlier tick is ready
+    if (_path && _path->IsCalculationPending())
+    {
+        if (_path->TryFinishCalculation())
+            LaunchMovement(owner, target, true);
+
+        return true;
+    }
+
     if (owner->HasUnitState(UNIT_STATE_FOLLOW_MOVE) && owner->movespline->Finalized())
     {
         RemoveFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
@@ -164,26 +173,32 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
                     allowShortcut = true;
             }
 
-            bool success = _path->CalculatePath(x, y, z, allowShortcut);
-            if (!success || (_path->GetPathType() & PATHFIND_NOPATH))
-            {
-                owner->StopMoving();
-                return true;
-            }
-
-            owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
-            AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
-
-            Movement::MoveSplineInit init(owner);
-            init.MovebyPath(_path->GetPath());
-            init.SetWalk(target->IsWalking());
-            init.SetFacing(target->GetOrientation());
-            init.Launch();
+            bool success = _path->CalculatePathAsync(x, y, z, allowShortcut);
+            if (!success || !_path->IsCalculationPending())
+                LaunchMovement(owner, target, success);
         }
     }
     return true;
 }
 
+void FollowMovementGenerator::LaunchMovement(Unit* owner, Unit* target, bool pathCalculated)
+{
+    if (!pathCalculated || (_path->GetPathType() & PATHFIND_NOPATH))
+    {
+        owner->StopMoving();
+        return;
+    }
+
+    owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
+    AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+
+    Movement::MoveSplineInit init(owner);
+    init.MovebyPath(_path->GetPath());
+    init.SetWalk(target->IsWalking());
+    init.SetFacing(target->GetOrientation());
+    init.Launch();
+}
+
 void FollowMovementGenerator::Deactivate(Unit* owner)
 {
     AddFlag(MOVEMENTGENERATOR_FLAG_DEACTIVATED);
@@ -49,6 +49,7 @@ class FollowMovementGenerator : public MovementGenerator, public AbstractFollowe
         static constexpr uint32 CHECK_INTERVAL = 100;
 
         void UpdatePetSpeed(Unit* owner);
+        void LaunchMovement(Unit* owner, Unit* target, bool pathCalculated);
 
         float const _range;
         ChaseAngle const _angle;
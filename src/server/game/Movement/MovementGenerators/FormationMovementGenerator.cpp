@@ -164,9 +164,13 @@ void FormationMovementGenerator::LaunchMovement(Creature* owner, Unit* target)
         // Calculate travel distance to get a 1650ms result
         float travelDist = velocity * 1.65f;
 
-        // Move destination ahead...
-        target->MovePositionToFirstCollision(dest, travelDist, relativeAngle);
-        // ... and apply formation shape
+        // Move destination ahead, the leader's prediction is shared by all members of its formation...
+        CreatureGroup* formation = target->GetTypeId() == TYPEID_UNIT ? target->ToCreature()->GetFormation() : nullptr;
+        if (formation && formation->IsLeader(target->ToCreature()))
+            dest = formation->PredictLeaderDestination(travelDist, relativeAngle);
+        else
+            target->MovePositionToFirstCollision(dest, travelDist, relativeAngle);
+        // ... and apply formation shape, this also validates the member's own destination
         target->MovePositionToFirstCollision(dest, _range, _angle + relativeAngle);
 
         float distance = owner->GetExactDist(dest);
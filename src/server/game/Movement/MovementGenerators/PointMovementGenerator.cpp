@@ -75,6 +75,7 @@ void PointMovementGenerator::Initialize(Unit* owner)
         if (_generatePath)
         {
             PathGenerator path(owner);
+            path.SetUseLongPath(true);
             G3D::Vector3 dest = PositionToVector3(_destination);
             bool result = path.CalculatePath(dest.x, dest.y, dest.z, false);
             if (result && !(path.GetPathType() & PATHFIND_NOPATH))
@@ -26,6 +26,7 @@
 #include "MoveSpline.h"
 #include "MoveSplineInit.h"
 #include "ObjectMgr.h"
+#include "PathGenerator.h"
 #include "Transport.h"
 #include "WaypointManager.h"
 #include <sstream>
@@ -322,9 +323,11 @@ void WaypointMovementGenerator<Creature>::StartMove(Creature* owner, bool relaun
     }
 
     bool const transportPath = !owner->GetTransGUID().IsEmpty();
+    Optional<uint32> previousNode;
 
     if (HasFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED) && HasFlag(MOVEMENTGENERATOR_FLAG_INITIALIZED))
     {
+        previousNode = _currentNode;
         if (ComputeNextNode())
         {
             ASSERT(_currentNode < _path->nodes.size(), "WaypointMovementGenerator::StartMove: tried to reference a node id (%u) which is not included in path (%u)", _currentNode, _path->id);
@@ -387,7 +390,14 @@ void WaypointMovementGenerator<Creature>::StartMove(Creature* owner, bool relaun
 
     //! Do not use formationDest here, MoveTo requires transport offsets due to DisableTransportPathTransformations() call
     //! but formationDest contains global coordinates
-    init.MoveTo(waypoint.x, waypoint.y, waypoint.z, _generatePath);
+    Movement::PointsArray const* segmentPath = nullptr;
+    if (_generatePath && !transportPath && previousNode)
+        segmentPath = GetSegmentPath(owner, *previousNode);
+
+    if (segmentPath)
+        init.MovebyPath(*segmentPath);
+    else
+        init.MoveTo(waypoint.x, waypoint.y, waypoint.z, _generatePath);
 
     if (waypoint.orientation.has_value() && waypoint.delay > 0)
         init.SetFacing(*waypoint.orientation);
@@ -462,6 +472,29 @@ bool WaypointMovementGenerator<Creature>::ComputeNextNode()
     return true;
 }
 
+Movement::PointsArray const* WaypointMovementGenerator<Creature>::GetSegmentPath(Creature* owner, uint32 fromNode)
+{
+    // a path generated for this segment is only valid if we are still standing where it started
+    // (script events and random movement at path ends can move the creature away from the node)
+    WaypointNode const& from = _path->nodes[fromNode];
+    if (!owner->IsInDist(from.x, from.y, from.z, 2.0f))
+        return nullptr;
+
+    uint64 key = MAKE_PAIR64(fromNode, _currentNode);
+    auto itr = _segmentPaths.find(key);
+    if (itr != _segmentPaths.end())
+        return &itr->second;
+
+    WaypointNode const& to = _path->nodes[_currentNode];
+    PathGenerator path(owner);
+    path.SetUseLongPath(true);
+    bool result = path.CalculatePath(to.x, to.y, to.z);
+    if (!result || (path.GetPathType() & PATHFIND_NOPATH))
+        return nullptr;
+
+    return &_segmentPaths.emplace(key, path.GetPath()).first->second;
+}
+
 std::string WaypointMovementGenerator<Creature>::GetDebugInfo() const
 {
     std::stringstream sstr;
@@ -18,9 +18,11 @@
 #ifndef TRINITY_WAYPOINTMOVEMENTGENERATOR_H
 #define TRINITY_WAYPOINTMOVEMENTGENERATOR_H
 
+#include "MoveSplineInitArgs.h"
 #include "MovementGenerator.h"
 #include "PathMovementBase.h"
 #include "Timer.h"
+#include <unordered_map>
 
 class Creature;
 class Unit;
@@ -64,6 +66,7 @@ class WaypointMovementGenerator<Creature> : public MovementGeneratorMedium<Creat
         void OnArrived(Creature*);
         void StartMove(Creature*, bool relaunch = false);
         bool ComputeNextNode();
+        Movement::PointsArray const* GetSegmentPath(Creature* owner, uint32 fromNode);
         bool UpdateTimer(uint32 diff)
         {
             _nextMoveTime.Update(diff);
@@ -88,6 +91,10 @@ class WaypointMovementGenerator<Creature> : public MovementGeneratorMedium<Creat
         bool _followPathBackwardsFromEndToStart;
         bool _isReturningToStart;
         bool _generatePath;
+
+        // generated paths between two consecutive nodes, keyed by MAKE_PAIR64(from node, to node)
+        // patrols repeat the same segments, so pathfinding is only done on the first lap
+        std::unordered_map<uint64, Movement::PointsArray> _segmentPaths;
 };
 
 #endif
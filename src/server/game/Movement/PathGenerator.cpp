@@ -24,26 +24,32 @@
 #include "MMapFactory.h"
 #include "MMapManager.h"
 #include "Map.h"
+#include "MapManager.h"
 #include "Metric.h"
+#include "PhaseShift.h"
 #include "PhasingHandler.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <queue>
+#include <unordered_map>
 
 ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
-    _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
-    _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
-    _navMeshQuery(nullptr)
+    _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false), _useLongPath(false),
+    _endPosition(G3D::Vector3::zero()), _source(owner), _terrainMapId(0), _navMesh(nullptr),
+    _navMeshQuery(nullptr), _corridorCache(nullptr), _deferNormalization(false), _normalizationPending(false), _actualEndIsPathEnd(false), _pathEndForced(false)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
     TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::PathGenerator for {}", _source->GetGUID().ToString());
 
-    uint32 mapId = PhasingHandler::GetTerrainMapId(_source->GetPhaseShift(), _source->GetMapId(), _source->GetMap()->GetTerrain(), _source->GetPositionX(), _source->GetPositionY());
+    _terrainMapId = PhasingHandler::GetTerrainMapId(_source->GetPhaseShift(), _source->GetMapId(), _source->GetMap()->GetTerrain(), _source->GetPositionX(), _source->GetPositionY());
     if (DisableMgr::IsPathfindingEnabled(_source->GetMapId()))
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetInstanceId());
+        _navMesh = mmap->GetNavMesh(_terrainMapId);
+        _corridorCache = mmap->GetPathCorridorCache(_terrainMapId);
     }
 
     CreateFilter();
@@ -51,10 +57,96 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
 
 PathGenerator::~PathGenerator()
 {
+    // the worker still writes to this generator
+    if (_pendingCalculation.valid())
+        _pendingCalculation.wait();
+
     TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::~PathGenerator() for {}", _source->GetGUID().ToString());
 }
 
 bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool forceDest)
+{
+    ASSERT(!IsCalculationPending());
+
+    if (Optional<bool> result = PrepareCalculation(destX, destY, destZ, forceDest))
+        return *result;
+
+    // normalizing can load terrain and with it navmesh tiles, which waits for the lock
+    _deferNormalization = true;
+    {
+        std::shared_lock<std::shared_mutex> lock = MMAP::MMapFactory::createOrGetMMapManager()->LockNavMeshForQuery(_terrainMapId);
+        BuildPolyPath(GetStartPosition(), GetEndPosition());
+    }
+    _deferNormalization = false;
+
+    FinishNormalization();
+    return true;
+}
+
+bool PathGenerator::CalculatePathAsync(float destX, float destY, float destZ, bool forceDest)
+{
+    ASSERT(!IsCalculationPending());
+
+    Trinity::ThreadPool* pool = sMapMgr->GetPathfindingPool();
+    if (!pool)
+        return CalculatePath(destX, destY, destZ, forceDest);
+
+    if (Optional<bool> result = PrepareCalculation(destX, destY, destZ, forceDest))
+        return *result;
+
+    // the worker only uses _sourceState and the navmesh, heights are adjusted by TryFinishCalculation
+    _deferNormalization = true;
+
+    std::packaged_task<void()> task([this, start = GetStartPosition(), end = GetEndPosition()]()
+    {
+        MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+        _navMeshQuery = mmap->GetNavMeshQueryForCurrentThread(_terrainMapId);
+        if (!_navMeshQuery)
+        {
+            BuildShortcut();
+            _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+            return;
+        }
+
+        std::shared_lock<std::shared_mutex> lock = mmap->LockNavMeshForQuery(_terrainMapId);
+        BuildPolyPath(start, end);
+    });
+
+    _pendingCalculation = task.get_future();
+    pool->PostWork(std::move(task));
+    return true;
+}
+
+bool PathGenerator::TryFinishCalculation()
+{
+    if (!_pendingCalculation.valid())
+        return true;
+
+    if (_pendingCalculation.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return false;
+
+    _pendingCalculation.get();
+    _deferNormalization = false;
+
+    FinishNormalization();
+    return true;
+}
+
+void PathGenerator::FinishNormalization()
+{
+    if (std::exchange(_normalizationPending, false))
+    {
+        // a forced destination replaced the last point after it was normalized
+        G3D::Vector3 pathEnd = _pathPoints.back();
+        NormalizePath();
+        if (_pathEndForced)
+            _pathPoints.back() = pathEnd;
+        else if (_actualEndIsPathEnd)
+            SetActualEndPosition(_pathPoints.back());
+    }
+}
+
+Optional<bool> PathGenerator::PrepareCalculation(float destX, float destY, float destZ, bool forceDest)
 {
     float x, y, z;
     _source->GetPosition(x, y, z);
@@ -71,14 +163,25 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
     SetStartPosition(start);
 
     _forceDestination = forceDest;
+    _actualEndIsPathEnd = false;
+    _pathEndForced = false;
 
     TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::CalculatePath() for {}", _source->GetGUID().ToString());
 
+    // queries are per thread and the owner can be updated by a different map thread every time
+    _navMeshQuery = _navMesh ? MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQueryForCurrentThread(_terrainMapId) : nullptr;
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     Unit const* _sourceUnit = _source->ToUnit();
-    if (!_navMesh || !_navMeshQuery || (_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)) ||
-        !HaveTile(start) || !HaveTile(dest))
+    bool haveTiles = false;
+    if (_navMesh && _navMeshQuery && !(_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)))
+    {
+        std::shared_lock<std::shared_mutex> lock = MMAP::MMapFactory::createOrGetMMapManager()->LockNavMeshForQuery(_terrainMapId);
+        haveTiles = HaveTile(start) && HaveTile(dest);
+    }
+
+    if (!haveTiles)
     {
         BuildShortcut();
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
@@ -87,8 +190,37 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 
     UpdateFilter();
 
-    BuildPolyPath(start, dest);
-    return true;
+    _sourceState = { };
+    if (Creature const* creature = _source->ToCreature())
+    {
+        _sourceState.CreatureCanFly = creature->CanFly();
+        _sourceState.CreatureCanSwim = creature->CanSwim();
+    }
+    if (_sourceUnit)
+    {
+        _sourceState.UnitCanFly = _sourceUnit->CanFly();
+        _sourceState.UnitCanSwim = _sourceUnit->CanSwim();
+        _sourceState.UnitIsFalling = _sourceUnit->IsFalling();
+    }
+
+    // BuildPolyPath may run on a worker or hold the navmesh lock, liquids of both ends are looked up here
+    Map* map = _source->GetMap();
+    PhaseShift const& phaseShift = _source->GetPhaseShift();
+    if (!_sourceState.CreatureCanFly && _sourceState.CreatureCanSwim)
+    {
+        float collisionHeight = _source->GetCollisionHeight();
+        _sourceState.StartInWater = map->GetLiquidStatus(phaseShift, start.x, start.y, start.z, map_liquidHeaderTypeFlags::AllLiquids, nullptr, collisionHeight) != LIQUID_MAP_NO_WATER;
+        _sourceState.EndInWater = map->GetLiquidStatus(phaseShift, dest.x, dest.y, dest.z, map_liquidHeaderTypeFlags::AllLiquids, nullptr, collisionHeight) != LIQUID_MAP_NO_WATER;
+    }
+
+    // being under water only matters when it changes whether a shortcut is allowed
+    if (_sourceState.UnitCanSwim != (_sourceState.UnitCanFly || (_sourceState.UnitIsFalling && dest.z < start.z)))
+    {
+        _sourceState.StartUnderWater = map->IsUnderWater(phaseShift, start.x, start.y, start.z);
+        _sourceState.EndUnderWater = map->IsUnderWater(phaseShift, dest.x, dest.y, dest.z);
+    }
+
+    return {};
 }
 
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
@@ -177,23 +309,12 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     {
         TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (startPoly == 0 || endPoly == 0)");
         BuildShortcut();
-        bool path = _source->GetTypeId() == TYPEID_UNIT && _source->ToCreature()->CanFly();
+        bool path = _sourceState.CreatureCanFly;
 
-        bool waterPath = _source->GetTypeId() == TYPEID_UNIT && _source->ToCreature()->CanSwim();
+        bool waterPath = _sourceState.CreatureCanSwim;
+        // Check both start and end points, if they're both in water, then we can *safely* let the creature move
         if (waterPath)
-        {
-            // Check both start and end points, if they're both in water, then we can *safely* let the creature move
-            for (uint32 i = 0; i < _pathPoints.size(); ++i)
-            {
-                ZLiquidStatus status = _source->GetMap()->GetLiquidStatus(_source->GetPhaseShift(), _pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z, map_liquidHeaderTypeFlags::AllLiquids, nullptr, _source->GetCollisionHeight());
-                // One of the points is not in the water, cancel movement.
-                if (status == LIQUID_MAP_NO_WATER)
-                {
-                    waterPath = false;
-                    break;
-                }
-            }
-        }
+            waterPath = _sourceState.StartInWater && _sourceState.EndInWater;
 
         if (path || waterPath)
         {
@@ -218,25 +339,20 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
         bool buildShotrcut = false;
 
-        G3D::Vector3 const& p = (distToStartPoly > 7.0f) ? startPos : endPos;
-        if (_source->GetMap()->IsUnderWater(_source->GetPhaseShift(), p.x, p.y, p.z))
+        if (startFarFromPoly ? _sourceState.StartUnderWater : _sourceState.EndUnderWater)
         {
             TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: underWater case");
-            if (Unit const* _sourceUnit = _source->ToUnit())
-                if (_sourceUnit->CanSwim())
-                    buildShotrcut = true;
+            if (_sourceState.UnitCanSwim)
+                buildShotrcut = true;
         }
         else
         {
             TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: flying case");
-            if (Unit const* _sourceUnit = _source->ToUnit())
-            {
-                if (_sourceUnit->CanFly())
-                    buildShotrcut = true;
-                // Allow to build a shortcut if the unit is falling and it's trying to move downwards towards a target (i.e. charging)
-                else if (_sourceUnit->IsFalling() && endPos.z < startPos.z)
-                    buildShotrcut = true;
-            }
+            if (_sourceState.UnitCanFly)
+                buildShotrcut = true;
+            // Allow to build a shortcut if the unit is falling and it's trying to move downwards towards a target (i.e. charging)
+            else if (_sourceState.UnitIsFalling && endPos.z < startPos.z)
+                buildShotrcut = true;
         }
 
         if (buildShotrcut)
@@ -403,7 +519,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
             // this is probably an error state, but we'll leave it
             // and hopefully recover on the next Update
             // we still need to copy our preffix
-            TC_LOG_ERROR("maps.mmaps", "Path Build failed\n{}", _source->GetDebugInfo());
+            TC_LOG_ERROR("maps.mmaps", "Path Build failed for {}", _source->GetGUID().ToString());
         }
 
         TC_LOG_DEBUG("maps.mmaps", "++  m_polyLength={} prefixPolyLength={} suffixPolyLength={}", _polyLength, prefixPolyLength, suffixPolyLength);
@@ -494,15 +610,27 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
-                            startPoly,          // start polygon
-                            endPoly,            // end polygon
-                            startPoint,         // start position
-                            endPoint,           // end position
-                            &_filter,           // polygon search filter
-                            _pathPolyRefs,     // [out] path
-                            (int*)&_polyLength,
-                            MAX_PATH_LENGTH);   // max number of polygons in output path
+            // guards returning home and evading creatures search the same corridors over and over
+            if (_corridorCache)
+                _polyLength = _corridorCache->Find(startPoly, endPoly, _filter.getIncludeFlags(), _filter.getExcludeFlags(), _pathPolyRefs, MAX_PATH_LENGTH);
+
+            if (_polyLength)
+                dtResult = DT_SUCCESS;
+            else
+            {
+                dtResult = _navMeshQuery->findPath(
+                                startPoly,          // start polygon
+                                endPoly,            // end polygon
+                                startPoint,         // start position
+                                endPoint,           // end position
+                                &_filter,           // polygon search filter
+                                _pathPolyRefs,     // [out] path
+                                (int*)&_polyLength,
+                                MAX_PATH_LENGTH);   // max number of polygons in output path
+
+                if (_corridorCache && _polyLength && dtStatusSucceed(dtResult))
+                    _corridorCache->Store(startPoly, endPoly, _filter.getIncludeFlags(), _filter.getExcludeFlags(), _pathPolyRefs, _polyLength);
+            }
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
@@ -513,6 +641,17 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
             _type = PATHFIND_NOPATH;
             return;
         }
+
+        // the destination is further away than a single search can reach
+        if (_useLongPath && _pathPolyRefs[_polyLength - 1] != endPoly && (_polyLength == MAX_PATH_LENGTH || (dtResult & DT_OUT_OF_NODES)))
+        {
+            if (BuildLongPolyPath(startPoly, startPoint, endPoly, endPoint))
+            {
+                AddFarFromPolyFlags(startFarFromPoly, endFarFromPoly);
+                BuildLongPointPath(startPoint, endPoint);
+                return;
+            }
+        }
     }
 
     // by now we know what type of path we can get
@@ -594,10 +733,18 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
     for (uint32 i = 0; i < pointCount; ++i)
         _pathPoints[i] = G3D::Vector3(pathPoints[i*VERTEX_SIZE+2], pathPoints[i*VERTEX_SIZE], pathPoints[i*VERTEX_SIZE+1]);
 
+    FinalizePointPath();
+
+    TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::BuildPointPath path type {} size {} poly-size {}", _type, pointCount, _polyLength);
+}
+
+void PathGenerator::FinalizePointPath()
+{
     NormalizePath();
 
     // first point is always our current location - we need the next one
-    SetActualEndPosition(_pathPoints[pointCount-1]);
+    SetActualEndPosition(_pathPoints.back());
+    _actualEndIsPathEnd = true;
 
     // force the given destination, if needed
     if (_forceDestination &&
@@ -608,6 +755,7 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
         {
             SetActualEndPosition(GetEndPosition());
             _pathPoints[_pathPoints.size()-1] = GetEndPosition();
+            _pathEndForced = true;
         }
         else
         {
@@ -615,14 +763,266 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
             BuildShortcut();
         }
 
+        _actualEndIsPathEnd = false;
+
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
     }
+}
 
-    TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::BuildPointPath path type {} size {} poly-size {}", _type, pointCount, _polyLength);
+bool PathGenerator::FindLongPathWaypoints(dtPolyRef startPoly, float const* startPoint, dtPolyRef endPoly, float const* endPoint, std::vector<LongPathWaypoint>& waypoints) const
+{
+    // coarse A* over square sectors of the nav mesh, each represented by a polygon near its center
+    // connections between sectors are not known yet, they are verified when the route is refined
+    struct SectorNode
+    {
+        dtPolyRef Ref = INVALID_POLYREF;
+        float Point[VERTEX_SIZE] = { };
+        float Cost = FLT_MAX;
+        uint64 Parent = 0;
+        bool Closed = false;
+    };
+
+    auto getSectorKey = [](int32 x, int32 z) { return (uint64(uint32(x)) << 32) | uint32(z); };
+    auto getSectorCoord = [](float coord) { return int32(std::floor(coord / LONG_PATH_SECTOR_SIZE)); };
+
+    uint64 startKey = getSectorKey(getSectorCoord(startPoint[0]), getSectorCoord(startPoint[2]));
+    uint64 endKey = getSectorKey(getSectorCoord(endPoint[0]), getSectorCoord(endPoint[2]));
+
+    std::unordered_map<uint64, SectorNode> nodes;
+    std::priority_queue<std::pair<float, uint64>, std::vector<std::pair<float, uint64>>, std::greater<>> open;
+
+    SectorNode& start = nodes[startKey];
+    start.Ref = startPoly;
+    dtVcopy(start.Point, startPoint);
+    start.Cost = 0.0f;
+    start.Parent = startKey;
+    open.emplace(dtVdist(startPoint, endPoint), startKey);
+
+    uint32 expandedSectors = 0;
+    while (!open.empty())
+    {
+        uint64 key = open.top().second;
+        open.pop();
+
+        // references to elements of unordered_map stay valid while it grows
+        SectorNode& node = nodes[key];
+        if (node.Closed)
+            continue;
+
+        node.Closed = true;
+        if (key == endKey)
+            break;
+
+        if (++expandedSectors > MAX_LONG_PATH_SECTORS)
+            return false;
+
+        int32 x = int32(uint32(key >> 32));
+        int32 z = int32(uint32(key));
+        for (int32 dx = -1; dx <= 1; ++dx)
+        {
+            for (int32 dz = -1; dz <= 1; ++dz)
+            {
+                if (!dx && !dz)
+                    continue;
+
+                uint64 neighbourKey = getSectorKey(x + dx, z + dz);
+                auto itr = nodes.find(neighbourKey);
+                if (itr == nodes.end())
+                {
+                    SectorNode neighbour;
+                    if (neighbourKey == endKey)
+                    {
+                        neighbour.Ref = endPoly;
+                        dtVcopy(neighbour.Point, endPoint);
+                    }
+                    else
+                    {
+                        // sectors without a polygon near their center are left out of the route
+                        float center[VERTEX_SIZE] = { (x + dx + 0.5f) * LONG_PATH_SECTOR_SIZE, node.Point[1], (z + dz + 0.5f) * LONG_PATH_SECTOR_SIZE };
+                        float extents[VERTEX_SIZE] = { 8.0f, 50.0f, 8.0f };
+                        if (dtStatusFailed(_navMeshQuery->findNearestPoly(center, extents, &_filter, &neighbour.Ref, neighbour.Point)))
+                            neighbour.Ref = INVALID_POLYREF;
+                    }
+
+                    itr = nodes.emplace(neighbourKey, neighbour).first;
+                }
+
+                SectorNode& neighbour = itr->second;
+                if (neighbour.Closed || neighbour.Ref == INVALID_POLYREF)
+                    continue;
+
+                float cost = node.Cost + dtVdist(node.Point, neighbour.Point);
+                if (cost >= neighbour.Cost)
+                    continue;
+
+                neighbour.Cost = cost;
+                neighbour.Parent = key;
+                open.emplace(cost + dtVdist(neighbour.Point, endPoint), neighbourKey);
+            }
+        }
+    }
+
+    auto end = nodes.find(endKey);
+    if (end == nodes.end() || !end->second.Closed)
+        return false;
+
+    waypoints.clear();
+    for (uint64 key = endKey; key != startKey; key = nodes[key].Parent)
+    {
+        SectorNode const& node = nodes[key];
+        LongPathWaypoint& waypoint = waypoints.emplace_back();
+        waypoint.Ref = node.Ref;
+        dtVcopy(waypoint.Point, node.Point);
+    }
+
+    std::reverse(waypoints.begin(), waypoints.end());
+    return true;
+}
+
+bool PathGenerator::BuildLongPolyPath(dtPolyRef startPoly, float const* startPoint, dtPolyRef endPoly, float const* endPoint)
+{
+    std::vector<LongPathWaypoint> waypoints;
+    if (!FindLongPathWaypoints(startPoly, startPoint, endPoly, endPoint, waypoints))
+    {
+        TC_LOG_DEBUG("maps.mmaps", "++ BuildLongPolyPath :: no sector route found for {}", _source->GetGUID().ToString());
+        return false;
+    }
+
+    _longPathPolyRefs.clear();
+    _longPathPolyRefs.push_back(startPoly);
+
+    float segmentStart[VERTEX_SIZE];
+    dtVcopy(segmentStart, startPoint);
+
+    dtPolyRef segmentPolyRefs[MAX_PATH_LENGTH];
+    bool complete = true;
+    for (LongPathWaypoint const& waypoint : waypoints)
+    {
+        // a single search might not reach the waypoint, continue from where it stopped
+        while (complete && _longPathPolyRefs.back() != waypoint.Ref)
+        {
+            int segmentLength = 0;
+            dtStatus dtResult = _navMeshQuery->findPath(_longPathPolyRefs.back(), waypoint.Ref, segmentStart, waypoint.Point, &_filter,
+                segmentPolyRefs, &segmentLength, MAX_PATH_LENGTH);
+
+            if (dtStatusFailed(dtResult) || segmentLength < 2)
+            {
+                complete = false;
+                break;
+            }
+
+            for (int i = 1; i < segmentLength; ++i)
+            {
+                // the corridor went back to a polygon it already passed, cut out the loop
+                auto itr = std::find(_longPathPolyRefs.begin(), _longPathPolyRefs.end(), segmentPolyRefs[i]);
+                if (itr != _longPathPolyRefs.end())
+                    _longPathPolyRefs.erase(itr + 1, _longPathPolyRefs.end());
+                else
+                    _longPathPolyRefs.push_back(segmentPolyRefs[i]);
+            }
+
+            if (_longPathPolyRefs.size() >= MAX_LONG_PATH_LENGTH)
+            {
+                _longPathPolyRefs.resize(MAX_LONG_PATH_LENGTH);
+                complete = false;
+                break;
+            }
+
+            // waypoint is not reachable from here, keep what brings us closer
+            if (_longPathPolyRefs.back() != waypoint.Ref && !(dtResult & DT_BUFFER_TOO_SMALL))
+            {
+                complete = false;
+                break;
+            }
+
+            if (dtStatusFailed(_navMeshQuery->closestPointOnPoly(_longPathPolyRefs.back(), waypoint.Point, segmentStart, nullptr)))
+            {
+                complete = false;
+                break;
+            }
+        }
+
+        if (!complete)
+            break;
+    }
+
+    // the sector route didn't get further than a single search
+    if (_longPathPolyRefs.size() <= MAX_PATH_LENGTH && _longPathPolyRefs.back() != endPoly)
+    {
+        _longPathPolyRefs.clear();
+        return false;
+    }
+
+    _polyLength = 0;
+
+    if (_longPathPolyRefs.back() == endPoly && !(_type & PATHFIND_INCOMPLETE))
+        _type = PATHFIND_NORMAL;
+    else
+        _type = PATHFIND_INCOMPLETE;
+
+    TC_LOG_DEBUG("maps.mmaps", "++ BuildLongPolyPath :: {} waypoints poly-size {} for {}", waypoints.size(), _longPathPolyRefs.size(), _source->GetGUID().ToString());
+    return true;
+}
+
+void PathGenerator::BuildLongPointPath(float const* startPoint, float const* endPoint)
+{
+    std::vector<float> cornerPoints(MAX_LONG_POINT_PATH_LENGTH * VERTEX_SIZE);
+    int cornerCount = 0;
+    dtStatus dtResult = _navMeshQuery->findStraightPath(startPoint, endPoint, _longPathPolyRefs.data(), int(_longPathPolyRefs.size()),
+        cornerPoints.data(), nullptr, nullptr, &cornerCount, MAX_LONG_POINT_PATH_LENGTH);
+
+    if (cornerCount < 2 || dtStatusFailed(dtResult))
+    {
+        TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::BuildLongPointPath FAILED! path sized {} returned", cornerCount);
+        BuildShortcut();
+        _type = PathType(_type | PATHFIND_NOPATH);
+        return;
+    }
+
+    if (dtResult & DT_BUFFER_TOO_SMALL)
+        _type = PATHFIND_INCOMPLETE;
+
+    auto getCorner = [&](int index) { return G3D::Vector3(cornerPoints[index * VERTEX_SIZE + 2], cornerPoints[index * VERTEX_SIZE], cornerPoints[index * VERTEX_SIZE + 1]); };
+
+    _pathPoints.clear();
+    if (_useStraightPath)
+    {
+        for (int i = 0; i < cornerCount; ++i)
+            _pathPoints.push_back(getCorner(i));
+    }
+    else
+    {
+        // points in between corners follow the ground once the path is normalized, spread them further apart on very long paths
+        float length = 0.0f;
+        for (int i = 1; i < cornerCount; ++i)
+            length += (getCorner(i) - getCorner(i - 1)).length();
+
+        float stepSize = std::max(SMOOTH_PATH_STEP_SIZE, length / MAX_LONG_POINT_PATH_LENGTH);
+        _pathPoints.push_back(getCorner(0));
+        for (int i = 1; i < cornerCount; ++i)
+        {
+            G3D::Vector3 from = getCorner(i - 1);
+            G3D::Vector3 to = getCorner(i);
+            uint32 steps = uint32((to - from).length() / stepSize);
+            for (uint32 step = 1; step < steps; ++step)
+                _pathPoints.push_back(from.lerp(to, float(step) / steps));
+            _pathPoints.push_back(to);
+        }
+    }
+
+    FinalizePointPath();
+
+    TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::BuildLongPointPath path type {} size {} poly-size {}", _type, _pathPoints.size(), _longPathPolyRefs.size());
 }
 
 void PathGenerator::NormalizePath()
 {
+    if (_deferNormalization)
+    {
+        _normalizationPending = true;
+        return;
+    }
+
     for (uint32 i = 0; i < _pathPoints.size(); ++i)
         _source->UpdateAllowedPositionZ(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z);
 }
@@ -884,7 +1284,7 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
         npolys = FixupCorridor(polys, npolys, MAX_PATH_LENGTH, visited, nvisited);
 
         if (dtStatusFailed(_navMeshQuery->getPolyHeight(polys[0], result, &result[1])))
-            TC_LOG_DEBUG("maps.mmaps", "Cannot find height at position X: {} Y: {} Z: {} for {}", result[2], result[0], result[1], _source->GetDebugInfo());
+            TC_LOG_DEBUG("maps.mmaps", "Cannot find height at position X: {} Y: {} Z: {} for {}", result[2], result[0], result[1], _source->GetGUID().ToString());
         result[1] += 0.5f;
         dtVcopy(iterPos, result);
 
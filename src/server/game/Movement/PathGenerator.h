@@ -22,16 +22,31 @@
 #include "DetourNavMeshQuery.h"
 #include "MMapDefines.h"
 #include "MoveSplineInitArgs.h"
+#include "Optional.h"
 #include <G3D/Vector3.h>
+#include <future>
+#include <vector>
 
 class WorldObject;
 
+namespace MMAP
+{
+    class PathCorridorCache;
+}
+
 // 74*4.0f=296y number_of_points*interval = max_path_len
 // this is way more than actual evade range
 // I think we can safely cut those down even more
 #define MAX_PATH_LENGTH         74
 #define MAX_POINT_PATH_LENGTH   74
 
+// paths allowed with SetUseLongPath are first routed over sectors of the nav mesh
+// and then refined locally, up to these limits
+#define MAX_LONG_PATH_LENGTH        1024
+#define MAX_LONG_POINT_PATH_LENGTH  1024
+#define MAX_LONG_PATH_SECTORS       1024
+#define LONG_PATH_SECTOR_SIZE       64.0f
+
 #define SMOOTH_PATH_STEP_SIZE   4.0f
 #define SMOOTH_PATH_SLOP        0.3f
 
@@ -66,12 +81,19 @@ class TC_GAME_API PathGenerator
         // Calculate the path from owner to given destination
         // return: true if new path was calculated, false otherwise (no change needed)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false);
+        // Same as CalculatePath, but the navmesh part runs on a pathfinding worker when MapUpdate.PathfindingThreads is set
+        // no other method may be called until TryFinishCalculation returned true
+        bool CalculatePathAsync(float destX, float destY, float destZ, bool forceDest = false);
+        bool IsCalculationPending() const { return _pendingCalculation.valid(); }
+        // return: true if no calculation is pending anymore and the result getters can be used
+        bool TryFinishCalculation();
         bool IsInvalidDestinationZ(WorldObject const* target) const;
 
         // option setters - use optional
         void SetUseStraightPath(bool useStraightPath) { _useStraightPath = useStraightPath; }
         void SetPathLengthLimit(float distance) { _pointPathLimit = std::min<uint32>(uint32(distance/SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); }
         void SetUseRaycast(bool useRaycast) { _useRaycast = useRaycast; }
+        void SetUseLongPath(bool useLongPath) { _useLongPath = useLongPath; }
 
         // result getters
         G3D::Vector3 const& GetStartPosition() const { return _startPosition; }
@@ -90,6 +112,7 @@ class TC_GAME_API PathGenerator
 
         dtPolyRef _pathPolyRefs[MAX_PATH_LENGTH];   // array of detour polygon references
         uint32 _polyLength;                         // number of polygons in the path
+        std::vector<dtPolyRef> _longPathPolyRefs;   // corridor of a path that didn't fit into _pathPolyRefs, only allocated for long paths
 
         Movement::PointsArray _pathPoints;  // our actual (x,y,z) path to the target
         PathType _type;                     // tells what kind of path this is
@@ -98,14 +121,39 @@ class TC_GAME_API PathGenerator
         bool _forceDestination; // when set, we will always arrive at given point
         uint32 _pointPathLimit; // limit point path size; min(this, MAX_POINT_PATH_LENGTH)
         bool _useRaycast;       // use raycast if true for a straight line path
+        bool _useLongPath;      // allow paths longer than MAX_PATH_LENGTH polygons
 
         G3D::Vector3 _startPosition;        // {x, y, z} of current location
         G3D::Vector3 _endPosition;          // {x, y, z} of the destination
         G3D::Vector3 _actualEndPosition;    // {x, y, z} of the closest possible point to given destination
 
         WorldObject const* const _source;       // the object that is moving
+        uint32 _terrainMapId;                   // the map of the nav mesh
         dtNavMesh const* _navMesh;              // the nav mesh
-        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
+        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query of the thread building the path, resolved for every calculation
+        MMAP::PathCorridorCache* _corridorCache; // corridors of earlier paths on the nav mesh
+
+        // state of the moving object and the map used while building the path, captured before so that it can be built on another thread
+        struct SourceState
+        {
+            bool CreatureCanFly = false;
+            bool CreatureCanSwim = false;
+            bool UnitCanFly = false;
+            bool UnitCanSwim = false;
+            bool UnitIsFalling = false;
+            bool StartInWater = false;
+            bool EndInWater = false;
+            bool StartUnderWater = false;
+            bool EndUnderWater = false;
+        };
+        SourceState _sourceState;
+
+        std::future<void> _pendingCalculation;
+        // heights of path points depend on terrain and dynamic objects of the map, they are adjusted on the owner's thread after the navmesh was released
+        bool _deferNormalization;
+        bool _normalizationPending;
+        bool _actualEndIsPathEnd;
+        bool _pathEndForced;
 
         dtQueryFilter _filter;  // use single filter for all movements, update it when needed
 
@@ -113,10 +161,13 @@ class TC_GAME_API PathGenerator
         void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
         void NormalizePath();
+        void FinishNormalization();
+        Optional<bool> PrepareCalculation(float destX, float destY, float destZ, bool forceDest);
 
         void Clear()
         {
             _polyLength = 0;
+            _longPathPolyRefs.clear();
             _pathPoints.clear();
         }
 
@@ -131,6 +182,17 @@ class TC_GAME_API PathGenerator
         void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
+        void FinalizePointPath();
+
+        struct LongPathWaypoint
+        {
+            dtPolyRef Ref;
+            float Point[VERTEX_SIZE];
+        };
+
+        bool FindLongPathWaypoints(dtPolyRef startPoly, float const* startPoint, dtPolyRef endPoly, float const* endPoint, std::vector<LongPathWaypoint>& waypoints) const;
+        bool BuildLongPolyPath(dtPolyRef startPoly, float const* startPoint, dtPolyRef endPoly, float const* endPoint);
+        void BuildLongPointPath(float const* startPoint, float const* endPoint);
 
         NavTerrainFlag GetNavTerrain(float x, float y, float z);
         void CreateFilter();
@@ -33,9 +33,16 @@ Location MoveSpline::computePosition(int32 time_point, int32 point_index) const
     if (seg_time > 0)
         u = (time_point - spline.length(point_index)) / (float)seg_time;
 
+    bool useFacing = splineflags.done && facing.type != MONSTER_MOVE_NORMAL;
+    bool orientationFromPath = !useFacing && !splineflags.hasFlag(MoveSplineFlag::OrientationFixed | MoveSplineFlag::Falling | MoveSplineFlag::Unknown_0x8);
+
     Location c;
+    Vector3 hermite;
     c.orientation = initialOrientation;
-    spline.evaluate_percent(point_index, u, c);
+    if (orientationFromPath)
+        spline.evaluate_percent_and_derivative(point_index, u, c, hermite);
+    else
+        spline.evaluate_percent(point_index, u, c);
 
     if (splineflags.animation)
         ;// MoveSplineFlag::Animation disables falling or parabolic movement
@@ -44,7 +51,7 @@ Location MoveSpline::computePosition(int32 time_point, int32 point_index) const
     else if (splineflags.falling)
         computeFallElevation(time_point, c.z);
 
-    if (splineflags.done && facing.type != MONSTER_MOVE_NORMAL)
+    if (useFacing)
     {
         if (facing.type == MONSTER_MOVE_FACING_ANGLE)
             c.orientation = facing.angle;
@@ -54,13 +61,9 @@ Location MoveSpline::computePosition(int32 time_point, int32 point_index) const
     }
     else
     {
-        if (!splineflags.hasFlag(MoveSplineFlag::OrientationFixed | MoveSplineFlag::Falling | MoveSplineFlag::Unknown_0x8))
-        {
-            Vector3 hermite;
-            spline.evaluate_derivative(point_Idx, u, hermite);
+        if (orientationFromPath)
             if (hermite.x != 0.f || hermite.y != 0.f)
                 c.orientation = std::atan2(hermite.y, hermite.x);
-        }
 
         if (splineflags.backward)
             c.orientation = c.orientation - float(M_PI);
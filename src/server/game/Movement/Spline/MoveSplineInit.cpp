@@ -263,6 +263,7 @@ namespace Movement
         if (generatePath)
         {
             PathGenerator path(unit);
+            path.SetUseLongPath(true);
             bool result = path.CalculatePath(dest.x, dest.y, dest.z, forceDestination);
             if (result && !(path.GetPathType() & PATHFIND_NOPATH))
             {
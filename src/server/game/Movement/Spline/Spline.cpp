@@ -57,11 +57,6 @@ SplineBase::InitMethtod SplineBase::initializers[SplineBase::ModesEnd] =
 ///////////
 
 using G3D::Matrix4;
-static const Matrix4 s_catmullRomCoeffs(
-    -0.5f, 1.5f, -1.5f, 0.5f,
-    1.f, -2.5f, 2.f, -0.5f,
-    -0.5f, 0.f,  0.5f, 0.f,
-    0.f,  1.f,  0.f,  0.f);
 
 static const Matrix4 s_Bezier3Coeffs(
     -1.f,  3.f, -3.f, 1.f,
@@ -93,6 +88,33 @@ inline void C_Evaluate(const Vector3 *vertice, float t, const float (&matrix)[4]
     position.z = z;
 }*/
 
+// Catmull-Rom basis matrix
+// -0.5  1.5 -1.5  0.5
+//  1   -2.5  2   -0.5
+// -0.5  0    0.5  0
+//  0    1    0    0
+// multiplied out for (t^3, t^2, t, 1) and its derivative (3t^2, 2t, 1, 0)
+inline void C_EvaluateCatmullRom(Vector3 const* vertice, float t, Vector3& result)
+{
+    float t2 = t * t;
+    float t3 = t2 * t;
+
+    result = vertice[0] * (-0.5f * t3 + t2 - 0.5f * t)
+           + vertice[1] * (1.5f * t3 - 2.5f * t2 + 1.f)
+           + vertice[2] * (-1.5f * t3 + 2.f * t2 + 0.5f * t)
+           + vertice[3] * (0.5f * t3 - 0.5f * t2);
+}
+
+inline void C_EvaluateCatmullRom_Derivative(Vector3 const* vertice, float t, Vector3& result)
+{
+    float t2 = t * t;
+
+    result = vertice[0] * (-1.5f * t2 + 2.f * t - 0.5f)
+           + vertice[1] * (4.5f * t2 - 5.f * t)
+           + vertice[2] * (-4.5f * t2 + 4.f * t + 0.5f)
+           + vertice[3] * (1.5f * t2 - t);
+}
+
 inline void C_Evaluate(Vector3 const* vertice, float t, Matrix4 const& matr, Vector3 &result)
 {
     Vector4 tvec(t*t*t, t*t, t, 1.f);
@@ -120,7 +142,7 @@ void SplineBase::EvaluateLinear(index_type index, float u, Vector3& result) cons
 void SplineBase::EvaluateCatmullRom( index_type index, float t, Vector3& result) const
 {
     ASSERT(index >= index_lo && index < index_hi);
-    C_Evaluate(&points[index - 1], t, s_catmullRomCoeffs, result);
+    C_EvaluateCatmullRom(&points[index - 1], t, result);
 }
 
 void SplineBase::EvaluateBezier3(index_type index, float t, Vector3& result) const
@@ -139,7 +161,7 @@ void SplineBase::EvaluateDerivativeLinear(index_type index, float, Vector3& resu
 void SplineBase::EvaluateDerivativeCatmullRom(index_type index, float t, Vector3& result) const
 {
     ASSERT(index >= index_lo && index < index_hi);
-    C_Evaluate_Derivative(&points[index - 1], t, s_catmullRomCoeffs, result);
+    C_EvaluateCatmullRom_Derivative(&points[index - 1], t, result);
 }
 
 void SplineBase::EvaluateDerivativeBezier3(index_type index, float t, Vector3& result) const
@@ -149,6 +171,22 @@ void SplineBase::EvaluateDerivativeBezier3(index_type index, float t, Vector3& r
     C_Evaluate_Derivative(&points[index], t, s_Bezier3Coeffs, result);
 }
 
+void SplineBase::evaluate_percent_and_derivative(index_type index, float u, Vector3& c, Vector3& hermite) const
+{
+    // most moving units use Catmull-Rom splines, evaluate them without going through the function tables twice
+    if (m_mode == ModeCatmullrom)
+    {
+        ASSERT(index >= index_lo && index < index_hi);
+        Vector3 const* p = &points[index - 1];
+        C_EvaluateCatmullRom(p, u, c);
+        C_EvaluateCatmullRom_Derivative(p, u, hermite);
+        return;
+    }
+
+    evaluate_percent(index, u, c);
+    evaluate_derivative(index, u, hermite);
+}
+
 float SplineBase::SegLengthLinear(index_type index) const
 {
     ASSERT(index >= index_lo && index < index_hi);
@@ -167,7 +205,7 @@ float SplineBase::SegLengthCatmullRom(index_type index) const
     float length = 0;
     while (i <= stepsPerSegment)
     {
-        C_Evaluate(p, float(i) / float(stepsPerSegment), s_catmullRomCoeffs, nextPos);
+        C_EvaluateCatmullRom(p, float(i) / float(stepsPerSegment), nextPos);
         length += (nextPos - curPos).length();
         curPos = nextPos;
         ++i;
@@ -106,6 +106,12 @@ public:
      */
     void evaluate_derivative(index_type Idx, float u, Vector3& hermite) const {(this->*derivative_evaluators[m_mode])(Idx, u, hermite);}
 
+    /** Caclulates both the position and the derivation in segment Idx, sharing the work of both for Catmull-Rom splines
+        @param Idx - spline segment index, should be in range [first, last)
+        @param t  - percent of spline segment length, assumes that t in range [0, 1]
+     */
+    void evaluate_percent_and_derivative(index_type Idx, float u, Vector3& c, Vector3& hermite) const;
+
     /**  Bounds for spline indexes. All indexes should be in range [first, last). */
     index_type first() const { return index_lo;}
     index_type last()  const { return index_hi;}
@@ -17,6 +17,8 @@
 
 #include "PhaseShift.h"
 #include "Containers.h"
+#include "Hash.h"
+#include <algorithm>
 
 PhaseShift::PhaseShift() = default;
 PhaseShift::PhaseShift(PhaseShift const& right) = default;
@@ -29,6 +31,7 @@ bool PhaseShift::AddPhase(uint32 phaseId, PhaseFlags flags, std::vector<Conditio
 {
     auto insertResult = Phases.emplace(phaseId, flags, nullptr);
     ModifyPhasesReferences(insertResult.first, references);
+    PhaseIdMask |= GetPhaseIdBit(phaseId);
     if (areaConditions)
         insertResult.first->AreaConditions = areaConditions;
 
@@ -42,7 +45,11 @@ PhaseShift::EraseResult<PhaseShift::PhaseContainer> PhaseShift::RemovePhase(uint
     {
         ModifyPhasesReferences(itr, -1);
         if (!itr->References)
-            return { Phases.erase(itr), true };
+        {
+            itr = Phases.erase(itr);
+            UpdatePhaseIdMask();
+            return { itr, true };
+        }
         return { itr, false };
     }
     return { Phases.end(), false };
@@ -98,6 +105,7 @@ void PhaseShift::ClearPhases()
     Flags &= PhaseShiftFlags::AlwaysVisible | PhaseShiftFlags::Inverse;
     PersonalGuid.Clear();
     Phases.clear();
+    PhaseIdMask = 0;
     NonCosmeticReferences = 0;
     CosmeticReferences = 0;
     PersonalReferences = 0;
@@ -120,6 +128,10 @@ bool PhaseShift::CanSee(PhaseShift const& other) const
 
     if (!Flags.HasFlag(PhaseShiftFlags::Inverse) && !other.Flags.HasFlag(PhaseShiftFlags::Inverse))
     {
+        // no shared phase id is possible, skip walking both sets
+        if (!(PhaseIdMask & other.PhaseIdMask))
+            return false;
+
         ObjectGuid ownerGuid = PersonalGuid;
         ObjectGuid otherPersonalGuid = other.PersonalGuid;
         return Trinity::Containers::Intersects(Phases.begin(), Phases.end(), other.Phases.begin(), other.Phases.end(),
@@ -152,6 +164,13 @@ bool PhaseShift::CanSee(PhaseShift const& other) const
     return checkInversePhaseShift(other, *this);
 }
 
+void PhaseShift::UpdatePhaseIdMask()
+{
+    PhaseIdMask = 0;
+    for (PhaseRef const& phase : Phases)
+        PhaseIdMask |= GetPhaseIdBit(phase.Id);
+}
+
 void PhaseShift::ModifyPhasesReferences(PhaseContainer::iterator itr, int32 references)
 {
     itr->References += references;
@@ -201,3 +220,35 @@ bool PhaseShift::HasPersonalPhase() const
             return true;
     return false;
 }
+
+std::size_t PhaseShift::GetCollisionHash() const
+{
+    std::size_t hashVal = 0;
+    Trinity::hash_combine(hashVal, Flags.AsUnderlyingType());
+    Trinity::hash_combine(hashVal, PersonalGuid);
+    for (PhaseRef const& phaseRef : Phases)
+    {
+        Trinity::hash_combine(hashVal, phaseRef.Id);
+        Trinity::hash_combine(hashVal, phaseRef.Flags.AsUnderlyingType());
+    }
+    for (auto const& [visibleMapId, _] : VisibleMapIds)
+        Trinity::hash_combine(hashVal, visibleMapId);
+    return hashVal;
+}
+
+bool PhaseShift::HasSameCollision(PhaseShift const& other) const
+{
+    if (Flags.AsUnderlyingType() != other.Flags.AsUnderlyingType() || PersonalGuid != other.PersonalGuid)
+        return false;
+
+    if (!std::equal(Phases.begin(), Phases.end(), other.Phases.begin(), other.Phases.end(), [](PhaseRef const& left, PhaseRef const& right)
+    {
+        return left.Id == right.Id && left.Flags.AsUnderlyingType() == right.Flags.AsUnderlyingType();
+    }))
+        return false;
+
+    return std::equal(VisibleMapIds.begin(), VisibleMapIds.end(), other.VisibleMapIds.begin(), other.VisibleMapIds.end(), [](auto const& left, auto const& right)
+    {
+        return left.first == right.first;
+    });
+}
@@ -117,6 +117,10 @@ public:
 
     bool HasPersonalPhase() const;
 
+    // identifies everything collision checks depend on
+    std::size_t GetCollisionHash() const;
+    bool HasSameCollision(PhaseShift const& other) const;
+
 protected:
     friend class PhasingHandler;
 
@@ -134,6 +138,11 @@ protected:
     int32 PersonalReferences = 0;
     int32 DefaultReferences = 0;
     bool IsDbPhaseShift = false;
+
+    // one bit per phase id modulo 64, may keep bits of removed phases but never misses a stored one
+    uint64 PhaseIdMask = 0;
+    static uint64 GetPhaseIdBit(uint32 phaseId) { return UI64LIT(1) << (phaseId % 64); }
+    void UpdatePhaseIdMask();
 };
 
 #endif // PhaseShift_h__
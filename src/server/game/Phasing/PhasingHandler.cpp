@@ -257,12 +257,14 @@ void PhasingHandler::ResetPhaseShift(WorldObject* object)
 {
     object->GetPhaseShift().Clear();
     object->GetSuppressedPhaseShift().Clear();
+    object->InvalidateTerrainStatusCache();
 }
 
 void PhasingHandler::InheritPhaseShift(WorldObject* target, WorldObject const* source)
 {
     target->GetPhaseShift() = source->GetPhaseShift();
     target->GetSuppressedPhaseShift() = source->GetSuppressedPhaseShift();
+    target->InvalidateTerrainStatusCache();
 }
 
 void PhasingHandler::OnMapChange(WorldObject* object)
@@ -684,6 +686,10 @@ bool PhasingHandler::IsPersonalPhase(uint32 phaseId)
 
 void PhasingHandler::UpdateVisibilityIfNeeded(WorldObject* object, bool updateVisibility, bool changed)
 {
+    // terrain swaps and phased gameobjects change the terrain under the object
+    if (changed)
+        object->InvalidateTerrainStatusCache();
+
     if (changed && object->IsInWorld())
     {
         if (Player* player = object->ToPlayer())
@@ -23,6 +23,7 @@
 #include "Log.h"
 #include "Map.h"
 #include "ObjectMgr.h"
+#include <algorithm>
 #include <sstream>
 
 PoolObject::PoolObject(uint64 _guid, float _chance) : guid(_guid), chance(std::fabs(_chance))
@@ -35,6 +36,11 @@ PoolObject::PoolObject(uint64 _guid, float _chance) : guid(_guid), chance(std::f
 SpawnedPoolData::SpawnedPoolData(Map* owner) : mOwner(owner) { }
 SpawnedPoolData::~SpawnedPoolData() = default;
 
+void SpawnedPoolData::Reserve(std::size_t poolCount)
+{
+    mSpawnedPools.reserve(poolCount);
+}
+
 // Method that tell amount spawned objects/subpools
 uint32 SpawnedPoolData::GetSpawnedObjects(uint32 pool_id) const
 {
@@ -46,21 +52,21 @@ uint32 SpawnedPoolData::GetSpawnedObjects(uint32 pool_id) const
 template<>
 TC_GAME_API bool SpawnedPoolData::IsSpawnedObject<Creature>(uint64 db_guid) const
 {
-    return mSpawnedCreatures.find(db_guid) != mSpawnedCreatures.end();
+    return mSpawnedCreatures.contains(db_guid);
 }
 
 // Method that tell if a gameobject is spawned currently
 template<>
 TC_GAME_API bool SpawnedPoolData::IsSpawnedObject<GameObject>(uint64 db_guid) const
 {
-    return mSpawnedGameobjects.find(db_guid) != mSpawnedGameobjects.end();
+    return mSpawnedGameobjects.contains(db_guid);
 }
 
 // Method that tell if a pool is spawned currently
 template<>
 TC_GAME_API bool SpawnedPoolData::IsSpawnedObject<Pool>(uint64 sub_pool_id) const
 {
-    return mSpawnedPools.find(sub_pool_id) != mSpawnedPools.end();
+    return mSpawnedPools.contains(sub_pool_id);
 }
 
 bool SpawnedPoolData::IsSpawnedObject(SpawnObjectType type, uint64 db_guid_or_pool_id) const
@@ -160,11 +166,26 @@ template <class T>
 void PoolGroup<T>::AddEntry(PoolObject& poolitem, uint32 maxentries)
 {
     if (poolitem.chance != 0 && maxentries == 1)
+    {
         ExplicitlyChanced.push_back(poolitem);
+        ExplicitlyChancedCumulative.push_back((ExplicitlyChancedCumulative.empty() ? 0.0f : ExplicitlyChancedCumulative.back()) + poolitem.chance);
+    }
     else
         EqualChanced.push_back(poolitem);
 }
 
+template <class T>
+void PoolGroup<T>::RebuildCumulativeChances()
+{
+    ExplicitlyChancedCumulative.resize(ExplicitlyChanced.size());
+    float chance = 0.0f;
+    for (std::size_t i = 0; i < ExplicitlyChanced.size(); ++i)
+    {
+        chance += ExplicitlyChanced[i].chance;
+        ExplicitlyChancedCumulative[i] = chance;
+    }
+}
+
 // Method to check the chances are proper in this object pool
 template <class T>
 bool PoolGroup<T>::CheckPool() const
@@ -272,6 +293,7 @@ void PoolGroup<Pool>::RemoveOneRelation(uint32 child_pool_id)
         if (itr->guid == child_pool_id)
         {
             ExplicitlyChanced.erase(itr);
+            RebuildCumulativeChances();
             break;
         }
     }
@@ -306,12 +328,16 @@ void PoolGroup<T>::SpawnObject(SpawnedPoolData& spawns, uint32 limit, uint64 tri
         {
             float roll = (float)rand_chance();
 
-            for (PoolObject& obj : ExplicitlyChanced)
+            // skip straight to the first object whose cumulative chance exceeds the roll
+            std::size_t first = std::distance(ExplicitlyChancedCumulative.begin(),
+                std::upper_bound(ExplicitlyChancedCumulative.begin(), ExplicitlyChancedCumulative.end(), roll));
+
+            for (std::size_t i = first; i < ExplicitlyChanced.size(); ++i)
             {
-                roll -= obj.chance;
+                PoolObject& obj = ExplicitlyChanced[i];
                 // Triggering object is marked as spawned at this time and can be also rolled (respawn case)
                 // so this need explicit check for this case
-                if (roll < 0 && (obj.guid == triggerFrom || !spawns.IsSpawnedObject<T>(obj.guid)))
+                if (obj.guid == triggerFrom || !spawns.IsSpawnedObject<T>(obj.guid))
                 {
                     rolledObjects.push_back(obj);
                     break;
@@ -923,8 +949,11 @@ std::unique_ptr<SpawnedPoolData> PoolMgr::InitPoolsForMap(Map* map)
 {
     std::unique_ptr<SpawnedPoolData> spawnedPoolData = std::make_unique<SpawnedPoolData>(map);
     if (std::vector<uint32> const* poolIds = Trinity::Containers::MapGetValuePtr(mAutoSpawnPoolsPerMap, spawnedPoolData->GetMap()->GetId()))
+    {
+        spawnedPoolData->Reserve(poolIds->size());
         for (uint32 poolId : *poolIds)
             SpawnPool(*spawnedPoolData, poolId);
+    }
 
     return spawnedPoolData;
 }
@@ -19,10 +19,11 @@
 #define TRINITY_POOLHANDLER_H
 
 #include "Define.h"
+#include "FlatHashMap.h"
+#include "FlatHashSet.h"
 #include "SpawnData.h"
 #include <map>
 #include <memory>
-#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -48,8 +49,8 @@ class Pool                                                  // for Pool of Pool
 {
 };
 
-typedef std::set<uint64> SpawnedPoolObjects;
-typedef std::map<uint64, uint32> SpawnedPoolPools;
+typedef Trinity::Containers::FlatHashSet<uint64> SpawnedPoolObjects;
+typedef Trinity::Containers::FlatHashMap<uint64, uint32> SpawnedPoolPools;
 
 class TC_GAME_API SpawnedPoolData
 {
@@ -64,6 +65,8 @@ class TC_GAME_API SpawnedPoolData
 
         Map* GetMap() const { return mOwner; }
 
+        void Reserve(std::size_t poolCount);
+
         template<typename T>
         bool IsSpawnedObject(uint64 db_guid_or_pool_id) const;
 
@@ -111,8 +114,11 @@ class TC_GAME_API PoolGroup
         void RemoveOneRelation(uint32 child_pool_id);
         uint32 GetPoolId() const { return poolId; }
     private:
+        void RebuildCumulativeChances();
+
         uint32 poolId;
         PoolObjectList ExplicitlyChanced;
+        std::vector<float> ExplicitlyChancedCumulative;     // running sum of ExplicitlyChanced[0..i].chance, used to binary search rolls
         PoolObjectList EqualChanced;
 };
 
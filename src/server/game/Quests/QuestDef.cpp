@@ -28,6 +28,7 @@
 #include "SpellMgr.h"
 #include "World.h"
 #include "WorldSession.h"
+#include "WorldSocket.h"
 
 Quest::Quest(Field* questRecord)
 {
@@ -573,7 +574,7 @@ bool Quest::CanIncreaseRewardedQuestCounters() const
 void Quest::InitializeQueryData()
 {
     for (uint8 loc = LOCALE_enUS; loc < TOTAL_LOCALES; ++loc)
-        QueryData[loc] = BuildQueryData(static_cast<LocaleConstant>(loc), nullptr);
+        QueryData[loc] = std::make_shared<SharedWorldPacket>(BuildQueryData(static_cast<LocaleConstant>(loc), nullptr));
 }
 
 WorldPacket Quest::BuildQueryData(LocaleConstant loc, Player* player) const
@@ -27,9 +27,11 @@
 #include "SharedDefines.h"
 #include "WorldPacket.h"
 #include <bitset>
+#include <memory>
 #include <vector>
 
 class Player;
+class SharedWorldPacket;
 enum Difficulty : uint8;
 
 namespace WorldPackets
@@ -680,7 +682,7 @@ class TC_GAME_API Quest
 
         std::vector<uint32> DependentPreviousQuests;
         std::vector<uint32> DependentBreadcrumbQuests;
-        std::array<WorldPacket, TOTAL_LOCALES> QueryData;
+        std::array<std::shared_ptr<SharedWorldPacket const>, TOTAL_LOCALES> QueryData;
 
     private:
         uint32 _rewChoiceItemsCount = 0;
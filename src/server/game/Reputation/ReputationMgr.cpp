@@ -364,6 +364,13 @@ void ReputationMgr::SendState(FactionState const* faction)
     _player->SendDirectMessage(setFactionStanding.Write());
 
     _sendFactionIncreased = false; // Reset
+    _hasPendingStates = false;
+}
+
+void ReputationMgr::SendPendingStates()
+{
+    if (_hasPendingStates)
+        SendState(nullptr);
 }
 
 void ReputationMgr::SendInitialReputations()
@@ -395,11 +402,13 @@ void ReputationMgr::SendVisible(FactionState const* faction, bool visible) const
 void ReputationMgr::Initialize()
 {
     _factions.clear();
+    _factionsByIndex.clear();
     _visibleFactionCount = 0;
     _honoredFactionCount = 0;
     _reveredFactionCount = 0;
     _exaltedFactionCount = 0;
     _sendFactionIncreased = false;
+    _hasPendingStates = false;
 
     for (FactionEntry const* factionEntry : sFactionStore)
     {
@@ -423,6 +432,12 @@ void ReputationMgr::Initialize()
             _factions[newFaction.ReputationListID] = newFaction;
         }
     }
+
+    if (!_factions.empty())
+        _factionsByIndex.resize(_factions.rbegin()->first + 1, nullptr);
+
+    for (auto& [reputationListId, state] : _factions)
+        _factionsByIndex[reputationListId] = &state;
 }
 
 bool ReputationMgr::SetReputation(FactionEntry const* factionEntry, int32 standing, bool incremental, bool spillOverOnly, bool noSpillover)
@@ -458,9 +473,9 @@ bool ReputationMgr::SetReputation(FactionEntry const* factionEntry, int32 standi
                 spillOverRepOut *= factionEntry->ParentFactionMod[1];
                 if (FactionEntry const* parent = sFactionStore.LookupEntry(factionEntry->ParentFactionID))
                 {
-                    FactionStateList::iterator parentState = _factions.find(parent->ReputationIndex);
+                    FactionState const* parentState = GetState(parent->ReputationIndex);
                     // some team factions have own reputation standing, in this case do not spill to other sub-factions
-                    if (parentState != _factions.end() && parentState->second.Flags.HasFlag(ReputationFlags::HeaderShowsBar))
+                    if (parentState && parentState->Flags.HasFlag(ReputationFlags::HeaderShowsBar))
                     {
                         SetOneFactionReputation(parent, int32(spillOverRepOut), incremental);
                     }
@@ -489,24 +504,26 @@ bool ReputationMgr::SetReputation(FactionEntry const* factionEntry, int32 standi
     }
 
     // spillover done, update faction itself
-    FactionStateList::iterator faction = _factions.find(factionEntry->ReputationIndex);
-    if (faction != _factions.end())
+    FactionState* faction = GetMutableState(factionEntry->ReputationIndex);
+    if (faction)
     {
         FactionEntry const* primaryFactionToModify = factionEntry;
         if (incremental && standing > 0 && CanGainParagonReputationForFaction(factionEntry))
         {
             primaryFactionToModify = sFactionStore.AssertEntry(factionEntry->ParagonFactionID);
-            faction = _factions.find(primaryFactionToModify->ReputationIndex);
+            faction = GetMutableState(primaryFactionToModify->ReputationIndex);
         }
 
-        if (faction != _factions.end())
+        if (faction)
         {
             // if we update spillover only, do not update main reputation (rank exceeds creature reward rate)
             if (!spillOverOnly)
                 res = SetOneFactionReputation(primaryFactionToModify, standing, incremental);
 
             // only this faction gets reported to client, even if it has no own visible standing
-            SendState(&faction->second);
+            // changes are collected and sent in a single packet on next player update
+            faction->needSend = true;
+            _hasPendingStates = true;
         }
     }
     return res;
@@ -514,19 +531,18 @@ bool ReputationMgr::SetReputation(FactionEntry const* factionEntry, int32 standi
 
 bool ReputationMgr::SetOneFactionReputation(FactionEntry const* factionEntry, int32 standing, bool incremental)
 {
-    FactionStateList::iterator itr = _factions.find(factionEntry->ReputationIndex);
-    if (itr != _factions.end())
+    if (FactionState* state = GetMutableState(factionEntry->ReputationIndex))
     {
         // Ignore renown reputation already raised to the maximum level
         if (HasMaximumRenownReputation(factionEntry) && standing > 0)
         {
-            itr->second.needSend = false;
-            itr->second.needSave = false;
+            state->needSend = false;
+            state->needSave = false;
             return false;
         }
 
         int32 baseRep = GetBaseReputation(factionEntry);
-        int32 oldStanding = itr->second.Standing + baseRep;
+        int32 oldStanding = state->Standing + baseRep;
 
         if (incremental || IsRenownReputation(factionEntry))
         {
@@ -547,7 +563,7 @@ bool ReputationMgr::SetOneFactionReputation(FactionEntry const* factionEntry, in
             ReputationRank newRank = ReputationToRank(factionEntry, standing);
 
             if (newRank <= REP_HOSTILE)
-                SetAtWar(&itr->second, true);
+                SetAtWar(state, true);
 
             if (newRank > oldRank)
                 _sendFactionIncreased = true;
@@ -581,7 +597,7 @@ bool ReputationMgr::SetOneFactionReputation(FactionEntry const* factionEntry, in
                     reputationChange += (GetRenownMaxLevel(factionEntry) * renownLevelThreshold) - totalReputation;
                 }
 
-                itr->second.VisualStandingIncrease = reputationChange;
+                state->VisualStandingIncrease = reputationChange;
 
                 // If the reputation is decreased by command, we will send CurrencyDestroyReason::Cheat
                 if (oldRenownLevel != newRenownLevel)
@@ -591,11 +607,11 @@ bool ReputationMgr::SetOneFactionReputation(FactionEntry const* factionEntry, in
 
         _player->ReputationChanged(factionEntry, reputationChange);
 
-        itr->second.Standing = newStanding;
-        itr->second.needSend = true;
-        itr->second.needSave = true;
+        state->Standing = newStanding;
+        state->needSend = true;
+        state->needSave = true;
 
-        SetVisible(&itr->second);
+        SetVisible(state);
 
         ParagonReputationEntry const* paragonReputation = sDB2Manager.GetParagonReputation(factionEntry->ID);
         if (paragonReputation)
@@ -634,11 +650,11 @@ void ReputationMgr::SetVisible(FactionEntry const* factionEntry)
     if (!factionEntry->CanHaveReputation())
         return;
 
-    FactionStateList::iterator itr = _factions.find(factionEntry->ReputationIndex);
-    if (itr == _factions.end())
+    FactionState* faction = GetMutableState(factionEntry->ReputationIndex);
+    if (!faction)
         return;
 
-    SetVisible(&itr->second);
+    SetVisible(faction);
 }
 
 void ReputationMgr::SetVisible(FactionState* faction)
@@ -668,15 +684,15 @@ void ReputationMgr::SetVisible(FactionState* faction)
 
 void ReputationMgr::SetAtWar(RepListID repListID, bool on)
 {
-    FactionStateList::iterator itr = _factions.find(repListID);
-    if (itr == _factions.end())
+    FactionState* faction = GetMutableState(repListID);
+    if (!faction)
         return;
 
     // always invisible or hidden faction can't change war state
-    if (itr->second.Flags.HasFlag(ReputationFlags::Hidden | ReputationFlags::Header))
+    if (faction->Flags.HasFlag(ReputationFlags::Hidden | ReputationFlags::Header))
         return;
 
-    SetAtWar(&itr->second, on);
+    SetAtWar(faction, on);
 }
 
 void ReputationMgr::SetAtWar(FactionState* faction, bool atWar) const
@@ -700,11 +716,11 @@ void ReputationMgr::SetAtWar(FactionState* faction, bool atWar) const
 
 void ReputationMgr::SetInactive(RepListID repListID, bool on)
 {
-    FactionStateList::iterator itr = _factions.find(repListID);
-    if (itr == _factions.end())
+    FactionState* faction = GetMutableState(repListID);
+    if (!faction)
         return;
 
-    SetInactive(&itr->second, on);
+    SetInactive(faction, on);
 }
 
 void ReputationMgr::SetInactive(FactionState* faction, bool inactive) const
@@ -742,7 +758,9 @@ void ReputationMgr::LoadFromDB(PreparedQueryResult result)
             FactionEntry const* factionEntry = sFactionStore.LookupEntry(fields[0].GetUInt16());
             if (factionEntry && factionEntry->CanHaveReputation())
             {
-                FactionState* faction = &_factions[factionEntry->ReputationIndex];
+                FactionState* faction = GetMutableState(factionEntry->ReputationIndex);
+                if (!faction)
+                    continue;
 
                 // update standing to current
                 faction->Standing = fields[1].GetInt32();
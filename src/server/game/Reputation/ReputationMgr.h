@@ -24,6 +24,7 @@
 #include "SharedDefines.h"
 #include <set>
 #include <map>
+#include <vector>
 
 struct FactionEntry;
 struct FactionTemplateEntry;
@@ -69,7 +70,8 @@ class TC_GAME_API ReputationMgr
 {
     public:                                                 // constructors and global modifiers
         explicit ReputationMgr(Player* owner) : _player(owner),
-            _visibleFactionCount(0), _honoredFactionCount(0), _reveredFactionCount(0), _exaltedFactionCount(0), _sendFactionIncreased(false) { }
+            _visibleFactionCount(0), _honoredFactionCount(0), _reveredFactionCount(0), _exaltedFactionCount(0), _sendFactionIncreased(false),
+            _hasPendingStates(false) { }
         ~ReputationMgr() { }
 
         void SaveToDB(CharacterDatabaseTransaction trans);
@@ -92,8 +94,7 @@ class TC_GAME_API ReputationMgr
 
         FactionState const* GetState(RepListID id) const
         {
-            FactionStateList::const_iterator repItr = _factions.find (id);
-            return repItr != _factions.end() ? &repItr->second : nullptr;
+            return id < _factionsByIndex.size() ? _factionsByIndex[id] : nullptr;
         }
 
         bool IsAtWar(uint32 faction_id) const;
@@ -151,9 +152,14 @@ class TC_GAME_API ReputationMgr
         void SendInitialReputations();
         void SendForceReactions();
         void SendState(FactionState const* faction);
+        void SendPendingStates();
 
     private:                                                // internal helper functions
         void Initialize();
+        FactionState* GetMutableState(RepListID id)
+        {
+            return id < _factionsByIndex.size() ? _factionsByIndex[id] : nullptr;
+        }
         ReputationFlags GetDefaultStateFlags(FactionEntry const* factionEntry) const;
         bool SetReputation(FactionEntry const* factionEntry, int32 standing, bool incremental, bool spillOverOnly, bool noSpillover);
         void SetVisible(FactionState* faction);
@@ -167,12 +173,14 @@ class TC_GAME_API ReputationMgr
     private:
         Player* _player;
         FactionStateList _factions;
+        std::vector<FactionState*> _factionsByIndex;            // points into _factions, indexed by ReputationListID
         ForcedReactions _forcedReactions;
         uint8 _visibleFactionCount :8;
         uint8 _honoredFactionCount :8;
         uint8 _reveredFactionCount :8;
         uint8 _exaltedFactionCount :8;
         bool _sendFactionIncreased; //! Play visual effect on next SMSG_SET_FACTION_STANDING sent
+        bool _hasPendingStates;     //! Standing changes waiting to be sent together by SendPendingStates
 };
 
 #endif
@@ -16,6 +16,7 @@
  */
 
 #include "Scenario.h"
+#include "AchievementPackets.h"
 #include "Log.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -45,6 +46,11 @@ Scenario::~Scenario()
     _players.clear();
 }
 
+void Scenario::Update(uint32 /*diff*/)
+{
+    SendPendingCriteriaUpdates();
+}
+
 void Scenario::Reset()
 {
     CriteriaHandler::Reset();
@@ -83,6 +89,9 @@ void Scenario::CompleteStep(ScenarioStepEntry const* step)
 
 void Scenario::CompleteScenario()
 {
+    // final progress must reach players before the completion
+    SendPendingCriteriaUpdates();
+
     return SendPacket(WorldPackets::Scenario::ScenarioCompleted(_data->Entry->ID).Write());
 }
 
@@ -95,6 +104,9 @@ void Scenario::SetStep(ScenarioStepEntry const* step)
     WorldPackets::Scenario::ScenarioState scenarioState;
     BuildScenarioState(&scenarioState);
     SendPacket(scenarioState.Write());
+
+    // full state already contains all progress
+    _pendingCriteriaUpdates.clear();
 }
 
 void Scenario::OnPlayerEnter(Player* player)
@@ -139,18 +151,55 @@ ScenarioStepState Scenario::GetStepState(ScenarioStepEntry const* step)
 
 void Scenario::SendCriteriaUpdate(Criteria const * criteria, CriteriaProgress const * progress, Seconds timeElapsed, bool timedCompleted) const
 {
-    WorldPackets::Scenario::ScenarioProgressUpdate progressUpdate;
-    progressUpdate.CriteriaProgress.Id = criteria->ID;
-    progressUpdate.CriteriaProgress.Quantity = progress->Counter;
-    progressUpdate.CriteriaProgress.Player = progress->PlayerGUID;
-    progressUpdate.CriteriaProgress.Date = progress->Date;
+    // progress is only sent on next update, repeated changes of the same criteria are merged
+    auto itr = std::find_if(_pendingCriteriaUpdates.begin(), _pendingCriteriaUpdates.end(), [criteria](WorldPackets::Achievement::CriteriaProgress const& pending)
+    {
+        return pending.Id == criteria->ID;
+    });
+
+    WorldPackets::Achievement::CriteriaProgress& criteriaProgress = itr != _pendingCriteriaUpdates.end() ? *itr : _pendingCriteriaUpdates.emplace_back();
+    criteriaProgress.Id = criteria->ID;
+    criteriaProgress.Quantity = progress->Counter;
+    criteriaProgress.Player = progress->PlayerGUID;
+    criteriaProgress.Date = progress->Date;
     if (criteria->Entry->StartTimer)
-        progressUpdate.CriteriaProgress.Flags = timedCompleted ? 1 : 0;
+        criteriaProgress.Flags = timedCompleted ? 1 : 0;
+
+    criteriaProgress.TimeFromStart = timeElapsed;
+    criteriaProgress.TimeFromCreate = Seconds::zero();
+}
+
+void Scenario::SendPendingCriteriaUpdates()
+{
+    if (_pendingCriteriaUpdates.empty())
+        return;
+
+    if (_pendingCriteriaUpdates.size() == 1)
+    {
+        WorldPackets::Scenario::ScenarioProgressUpdate progressUpdate;
+        progressUpdate.CriteriaProgress = _pendingCriteriaUpdates.front();
+        SendPacket(progressUpdate.Write());
+    }
+    else
+    {
+        // multiple criteria changed, a single state packet built once replaces one update per criteria
+        WorldPackets::Scenario::ScenarioState scenarioState;
+        BuildScenarioState(&scenarioState);
+        for (WorldPackets::Achievement::CriteriaProgress& criteriaProgress : scenarioState.CriteriaProgress)
+        {
+            auto itr = std::find_if(_pendingCriteriaUpdates.begin(), _pendingCriteriaUpdates.end(), [&](WorldPackets::Achievement::CriteriaProgress const& pending)
+            {
+                return pending.Id == criteriaProgress.Id;
+            });
 
-    progressUpdate.CriteriaProgress.TimeFromStart = timeElapsed;
-    progressUpdate.CriteriaProgress.TimeFromCreate = Seconds::zero();
+            if (itr != _pendingCriteriaUpdates.end())
+                criteriaProgress = *itr;
+        }
+
+        SendPacket(scenarioState.Write());
+    }
 
-    SendPacket(progressUpdate.Write());
+    _pendingCriteriaUpdates.clear();
 }
 
 bool Scenario::CanUpdateCriteriaTree(Criteria const * /*criteria*/, CriteriaTree const * tree, Player * /*referencePlayer*/) const
@@ -61,7 +61,7 @@ class TC_GAME_API Scenario : public CriteriaHandler
 
         virtual void OnPlayerEnter(Player* player);
         virtual void OnPlayerExit(Player* player);
-        virtual void Update(uint32 /*diff*/) { }
+        virtual void Update(uint32 diff);
 
         bool IsComplete();
         bool IsCompletedStep(ScenarioStepEntry const* step);
@@ -91,6 +91,7 @@ class TC_GAME_API Scenario : public CriteriaHandler
         void SendAllData(Player const* /*receiver*/) const override { }
 
         void BuildScenarioState(WorldPackets::Scenario::ScenarioState* scenarioState);
+        void SendPendingCriteriaUpdates();
 
         std::vector<WorldPackets::Scenario::BonusObjectiveData> GetBonusObjectivesData();
         std::vector<WorldPackets::Achievement::CriteriaProgress> GetCriteriasProgress();
@@ -101,6 +102,9 @@ class TC_GAME_API Scenario : public CriteriaHandler
     private:
         ScenarioStepEntry const* _currentstep;
         std::map<ScenarioStepEntry const*, ScenarioStepState> _stepStates;
+
+        // criteria progress changed since last update, sent together by SendPendingCriteriaUpdates
+        mutable std::vector<WorldPackets::Achievement::CriteriaProgress> _pendingCriteriaUpdates;
 };
 
 #endif // Scenario_h__
@@ -38,6 +38,7 @@
 #include "ObjectMgr.h"
 #include "OutdoorPvPMgr.h"
 #include "Player.h"
+#include "ScriptProfiler.h"
 #include "ScriptReloadMgr.h"
 #include "ScriptSystem.h"
 #include "SmartAI.h"
@@ -137,6 +138,28 @@ template<>
 struct is_script_database_bound<WorldStateScript>
     : std::true_type { };
 
+// Trait which indicates whether this script type
+// keeps subscriber lists for its hooks.
+template<typename>
+struct is_script_hook_subscribable
+    : std::false_type { };
+
+template<>
+struct is_script_hook_subscribable<ServerScript>
+    : std::true_type { };
+
+template<>
+struct is_script_hook_subscribable<WorldScript>
+    : std::true_type { };
+
+template<>
+struct is_script_hook_subscribable<UnitScript>
+    : std::true_type { };
+
+template<>
+struct is_script_hook_subscribable<PlayerScript>
+    : std::true_type { };
+
 enum Spells
 {
     SPELL_HOTSWAP_VISUAL_SPELL_EFFECT = 40162 // 59084
@@ -1102,6 +1125,7 @@ public:
         this->BeforeReleaseContext(context);
 
         _scripts.erase(context);
+        UpdateHookSubscribers();
     }
 
     void SwapContext(bool initialize) final override
@@ -1120,6 +1144,7 @@ public:
         this->BeforeUnload();
 
         _scripts.clear();
+        UpdateHookSubscribers();
     }
 
     void SyncScriptNames() final override
@@ -1148,6 +1173,7 @@ public:
 
         // We're dealing with a code-only script, just add it.
         _scripts.insert(std::make_pair(sScriptMgr->GetCurrentScriptContext(), std::move(script_ptr)));
+        UpdateHookSubscribers();
     }
 
     ScriptStoreType& GetScripts()
@@ -1155,8 +1181,32 @@ public:
         return _scripts;
     }
 
+    // Scripts subscribed to the hook, in the same order as GetScripts()
+    template<typename Hook>
+    std::vector<ScriptType*> const& GetHookSubscribers(Hook hook) const
+    {
+        static_assert(std::is_same_v<Hook, typename ScriptType::HookType>, "Script type has no hook subscriber lists for this hook type");
+        return _hookSubscribers[std::size_t(hook)];
+    }
+
 private:
+    void UpdateHookSubscribers()
+    {
+        if constexpr (is_script_hook_subscribable<ScriptType>::value)
+        {
+            using HookType = typename ScriptType::HookType;
+
+            _hookSubscribers.assign(std::size_t(HookType::Max), { });
+            for (auto const& [context, script] : _scripts)
+                for (std::size_t hook = 0; hook < _hookSubscribers.size(); ++hook)
+                    if (script->IsSubscribedTo(HookType(hook)))
+                        _hookSubscribers[hook].push_back(script.get());
+        }
+    }
+
     ScriptStoreType _scripts;
+
+    std::vector<std::vector<ScriptType*>> _hookSubscribers;
 };
 
 // Utility macros to refer to the script registry.
@@ -1181,6 +1231,13 @@ private:
     FOR_SCRIPTS(T, itr, end) \
         itr->second
 
+#define SCR_HOOK_SUBSCRIBERS(T, H) ScriptRegistry<T>::Instance()->GetHookSubscribers(T::HookType::H)
+
+#define FOREACH_SCRIPT_HOOK(T, H) \
+    for (T* script : SCR_HOOK_SUBSCRIBERS(T, H)) \
+        if (ScriptProfiler::Sample scriptProfilerSample(script->GetName(), #H); true) \
+            script
+
 // Utility macros for finding specific scripts.
 #define GET_SCRIPT(T, I, V) \
     T* V = ScriptRegistry<T>::Instance()->GetScriptById(I); \
@@ -1392,76 +1449,76 @@ SpellScriptLoader* ScriptMgr::GetSpellScriptLoader(uint32 scriptId)
 
 void ScriptMgr::OnNetworkStart()
 {
-    FOREACH_SCRIPT(ServerScript)->OnNetworkStart();
+    FOREACH_SCRIPT_HOOK(ServerScript, OnNetworkStart)->OnNetworkStart();
 }
 
 void ScriptMgr::OnNetworkStop()
 {
-    FOREACH_SCRIPT(ServerScript)->OnNetworkStop();
+    FOREACH_SCRIPT_HOOK(ServerScript, OnNetworkStop)->OnNetworkStop();
 }
 
 void ScriptMgr::OnSocketOpen(std::shared_ptr<WorldSocket> socket)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnSocketOpen(socket);
+    FOREACH_SCRIPT_HOOK(ServerScript, OnSocketOpen)->OnSocketOpen(socket);
 }
 
 void ScriptMgr::OnSocketClose(std::shared_ptr<WorldSocket> socket)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnSocketClose(socket);
+    FOREACH_SCRIPT_HOOK(ServerScript, OnSocketClose)->OnSocketClose(socket);
 }
 
 void ScriptMgr::OnPacketReceive(WorldSession* session, WorldPacket const& packet)
 {
-    if (SCR_REG_LST(ServerScript).empty())
+    if (SCR_HOOK_SUBSCRIBERS(ServerScript, OnPacketReceive).empty())
         return;
 
     WorldPacket copy(packet);
-    FOREACH_SCRIPT(ServerScript)->OnPacketReceive(session, copy);
+    FOREACH_SCRIPT_HOOK(ServerScript, OnPacketReceive)->OnPacketReceive(session, copy);
 }
 
 void ScriptMgr::OnPacketSend(WorldSession* session, WorldPacket const& packet)
 {
     ASSERT(session);
 
-    if (SCR_REG_LST(ServerScript).empty())
+    if (SCR_HOOK_SUBSCRIBERS(ServerScript, OnPacketSend).empty())
         return;
 
     WorldPacket copy(packet);
-    FOREACH_SCRIPT(ServerScript)->OnPacketSend(session, copy);
+    FOREACH_SCRIPT_HOOK(ServerScript, OnPacketSend)->OnPacketSend(session, copy);
 }
 
 void ScriptMgr::OnOpenStateChange(bool open)
 {
-    FOREACH_SCRIPT(WorldScript)->OnOpenStateChange(open);
+    FOREACH_SCRIPT_HOOK(WorldScript, OnOpenStateChange)->OnOpenStateChange(open);
 }
 
 void ScriptMgr::OnConfigLoad(bool reload)
 {
-    FOREACH_SCRIPT(WorldScript)->OnConfigLoad(reload);
+    FOREACH_SCRIPT_HOOK(WorldScript, OnConfigLoad)->OnConfigLoad(reload);
 }
 
 void ScriptMgr::OnMotdChange(std::string& newMotd)
 {
-    FOREACH_SCRIPT(WorldScript)->OnMotdChange(newMotd);
+    FOREACH_SCRIPT_HOOK(WorldScript, OnMotdChange)->OnMotdChange(newMotd);
 }
 
 void ScriptMgr::OnShutdownInitiate(ShutdownExitCode code, ShutdownMask mask)
 {
-    FOREACH_SCRIPT(WorldScript)->OnShutdownInitiate(code, mask);
+    FOREACH_SCRIPT_HOOK(WorldScript, OnShutdownInitiate)->OnShutdownInitiate(code, mask);
 }
 
 void ScriptMgr::OnShutdownCancel()
 {
-    FOREACH_SCRIPT(WorldScript)->OnShutdownCancel();
+    FOREACH_SCRIPT_HOOK(WorldScript, OnShutdownCancel)->OnShutdownCancel();
 }
 
 void ScriptMgr::OnWorldUpdate(uint32 diff)
 {
-    FOREACH_SCRIPT(WorldScript)->OnUpdate(diff);
+    FOREACH_SCRIPT_HOOK(WorldScript, OnUpdate)->OnUpdate(diff);
 }
 
 void ScriptMgr::OnHonorCalculation(float& honor, uint8 level, float multiplier)
@@ -1558,7 +1615,7 @@ void ScriptMgr::OnPlayerEnterMap(Map* map, Player* player)
     ASSERT(map);
     ASSERT(player);
 
-    FOREACH_SCRIPT(PlayerScript)->OnMapChanged(player);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnMapChanged)->OnMapChanged(player);
 
     SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
         itr->second->OnPlayerEnter(map, player);
@@ -1912,12 +1969,12 @@ void ScriptMgr::OnRelocate(Transport* transport, uint32 mapId, float x, float y,
 
 void ScriptMgr::OnStartup()
 {
-    FOREACH_SCRIPT(WorldScript)->OnStartup();
+    FOREACH_SCRIPT_HOOK(WorldScript, OnStartup)->OnStartup();
 }
 
 void ScriptMgr::OnShutdown()
 {
-    FOREACH_SCRIPT(WorldScript)->OnShutdown();
+    FOREACH_SCRIPT_HOOK(WorldScript, OnShutdown)->OnShutdown();
 }
 
 // Achievement
@@ -1942,167 +1999,167 @@ bool ScriptMgr::OnCriteriaCheck(uint32 scriptId, Player* source, Unit* target)
 // Player
 void ScriptMgr::OnPVPKill(Player* killer, Player* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPVPKill(killer, killed);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnPVPKill)->OnPVPKill(killer, killed);
 }
 
 void ScriptMgr::OnCreatureKill(Player* killer, Creature* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnCreatureKill(killer, killed);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnCreatureKill)->OnCreatureKill(killer, killed);
 }
 
 void ScriptMgr::OnPlayerKilledByCreature(Creature* killer, Player* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPlayerKilledByCreature(killer, killed);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnPlayerKilledByCreature)->OnPlayerKilledByCreature(killer, killed);
 }
 
 void ScriptMgr::OnPlayerLevelChanged(Player* player, uint8 oldLevel)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLevelChanged(player, oldLevel);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnLevelChanged)->OnLevelChanged(player, oldLevel);
 }
 
 void ScriptMgr::OnPlayerFreeTalentPointsChanged(Player* player, uint32 points)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnFreeTalentPointsChanged(player, points);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnFreeTalentPointsChanged)->OnFreeTalentPointsChanged(player, points);
 }
 
 void ScriptMgr::OnPlayerTalentsReset(Player* player, bool noCost)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnTalentsReset(player, noCost);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnTalentsReset)->OnTalentsReset(player, noCost);
 }
 
 void ScriptMgr::OnPlayerMoneyChanged(Player* player, int64& amount)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnMoneyChanged(player, amount);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnMoneyChanged)->OnMoneyChanged(player, amount);
 }
 
 void ScriptMgr::OnPlayerMoneyLimit(Player* player, int64 amount)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnMoneyLimit(player, amount);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnMoneyLimit)->OnMoneyLimit(player, amount);
 }
 
 void ScriptMgr::OnGivePlayerXP(Player* player, uint32& amount, Unit* victim)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnGiveXP(player, amount, victim);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnGiveXP)->OnGiveXP(player, amount, victim);
 }
 
 void ScriptMgr::OnPlayerReputationChange(Player* player, uint32 factionID, int32& standing, bool incremental)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnReputationChange(player, factionID, standing, incremental);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnReputationChange)->OnReputationChange(player, factionID, standing, incremental);
 }
 
 void ScriptMgr::OnPlayerDuelRequest(Player* target, Player* challenger)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelRequest(target, challenger);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnDuelRequest)->OnDuelRequest(target, challenger);
 }
 
 void ScriptMgr::OnPlayerDuelStart(Player* player1, Player* player2)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelStart(player1, player2);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnDuelStart)->OnDuelStart(player1, player2);
 }
 
 void ScriptMgr::OnPlayerDuelEnd(Player* winner, Player* loser, DuelCompleteType type)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelEnd(winner, loser, type);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnDuelEnd)->OnDuelEnd(winner, loser, type);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnChat)->OnChat(player, type, lang, msg);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Player* receiver)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, receiver);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnChat)->OnChat(player, type, lang, msg, receiver);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Group* group)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, group);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnChat)->OnChat(player, type, lang, msg, group);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Guild* guild)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, guild);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnChat)->OnChat(player, type, lang, msg, guild);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Channel* channel)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, channel);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnChat)->OnChat(player, type, lang, msg, channel);
 }
 
 void ScriptMgr::OnPlayerClearEmote(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnClearEmote(player);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnClearEmote)->OnClearEmote(player);
 }
 
 void ScriptMgr::OnPlayerTextEmote(Player* player, uint32 textEmote, uint32 emoteNum, ObjectGuid guid)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnTextEmote(player, textEmote, emoteNum, guid);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnTextEmote)->OnTextEmote(player, textEmote, emoteNum, guid);
 }
 
 void ScriptMgr::OnPlayerSpellCast(Player* player, Spell* spell, bool skipCheck)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnSpellCast(player, spell, skipCheck);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnSpellCast)->OnSpellCast(player, spell, skipCheck);
 }
 
 void ScriptMgr::OnPlayerLogin(Player* player, bool firstLogin)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLogin(player, firstLogin);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnLogin)->OnLogin(player, firstLogin);
 }
 
 void ScriptMgr::OnPlayerLogout(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLogout(player);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnLogout)->OnLogout(player);
 }
 
 void ScriptMgr::OnPlayerCreate(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnCreate(player);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnCreate)->OnCreate(player);
 }
 
 void ScriptMgr::OnPlayerDelete(ObjectGuid guid, uint32 accountId)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDelete(guid, accountId);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnDelete)->OnDelete(guid, accountId);
 }
 
 void ScriptMgr::OnPlayerFailedDelete(ObjectGuid guid, uint32 accountId)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnFailedDelete(guid, accountId);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnFailedDelete)->OnFailedDelete(guid, accountId);
 }
 
 void ScriptMgr::OnPlayerSave(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnSave(player);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnSave)->OnSave(player);
 }
 
 void ScriptMgr::OnPlayerBindToInstance(Player* player, Difficulty difficulty, uint32 mapid, bool permanent, uint8 extendState)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnBindToInstance(player, difficulty, mapid, permanent, extendState);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnBindToInstance)->OnBindToInstance(player, difficulty, mapid, permanent, extendState);
 }
 
 void ScriptMgr::OnPlayerUpdateZone(Player* player, uint32 newZone, uint32 newArea)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnUpdateZone(player, newZone, newArea);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnUpdateZone)->OnUpdateZone(player, newZone, newArea);
 }
 
 void ScriptMgr::OnQuestStatusChange(Player* player, uint32 questId)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnQuestStatusChange(player, questId);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnQuestStatusChange)->OnQuestStatusChange(player, questId);
 }
 
 void ScriptMgr::OnPlayerRepop(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPlayerRepop(player);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnPlayerRepop)->OnPlayerRepop(player);
 }
 
 void ScriptMgr::OnMovieComplete(Player* player, uint32 movieId)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnMovieComplete(player, movieId);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnMovieComplete)->OnMovieComplete(player, movieId);
 }
 
 void ScriptMgr::OnPlayerChoiceResponse(Player* player, uint32 choiceId, uint32 responseId)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPlayerChoiceResponse(player, choiceId, responseId);
+    FOREACH_SCRIPT_HOOK(PlayerScript, OnPlayerChoiceResponse)->OnPlayerChoiceResponse(player, choiceId, responseId);
 }
 
 // Account
@@ -2227,27 +2284,27 @@ void ScriptMgr::OnGroupDisband(Group* group)
 // Unit
 void ScriptMgr::OnHeal(Unit* healer, Unit* reciever, uint32& gain)
 {
-    FOREACH_SCRIPT(UnitScript)->OnHeal(healer, reciever, gain);
+    FOREACH_SCRIPT_HOOK(UnitScript, OnHeal)->OnHeal(healer, reciever, gain);
 }
 
 void ScriptMgr::OnDamage(Unit* attacker, Unit* victim, uint32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->OnDamage(attacker, victim, damage);
+    FOREACH_SCRIPT_HOOK(UnitScript, OnDamage)->OnDamage(attacker, victim, damage);
 }
 
 void ScriptMgr::ModifyPeriodicDamageAurasTick(Unit* target, Unit* attacker, uint32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifyPeriodicDamageAurasTick(target, attacker, damage);
+    FOREACH_SCRIPT_HOOK(UnitScript, ModifyPeriodicDamageAurasTick)->ModifyPeriodicDamageAurasTick(target, attacker, damage);
 }
 
 void ScriptMgr::ModifyMeleeDamage(Unit* target, Unit* attacker, uint32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifyMeleeDamage(target, attacker, damage);
+    FOREACH_SCRIPT_HOOK(UnitScript, ModifyMeleeDamage)->ModifyMeleeDamage(target, attacker, damage);
 }
 
 void ScriptMgr::ModifySpellDamageTaken(Unit* target, Unit* attacker, int32& damage, SpellInfo const* spellInfo)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifySpellDamageTaken(target, attacker, damage, spellInfo);
+    FOREACH_SCRIPT_HOOK(UnitScript, ModifySpellDamageTaken)->ModifySpellDamageTaken(target, attacker, damage, spellInfo);
 }
 
 // Conversation
@@ -2358,8 +2415,8 @@ AuraScript* SpellScriptLoader::GetAuraScript() const
     return nullptr;
 }
 
-ServerScript::ServerScript(char const* name)
-    : ScriptObject(name)
+ServerScript::ServerScript(char const* name, std::initializer_list<ServerScriptHook> hooks)
+    : ScriptObject(name), ScriptHookSubscriptions(hooks)
 {
     ScriptRegistry<ServerScript>::Instance()->AddScript(this);
 }
@@ -2390,8 +2447,8 @@ void ServerScript::OnPacketReceive(WorldSession* /*session*/, WorldPacket& /*pac
 {
 }
 
-WorldScript::WorldScript(char const* name)
-    : ScriptObject(name)
+WorldScript::WorldScript(char const* name, std::initializer_list<WorldScriptHook> hooks)
+    : ScriptObject(name), ScriptHookSubscriptions(hooks)
 {
     ScriptRegistry<WorldScript>::Instance()->AddScript(this);
 }
@@ -2586,8 +2643,8 @@ bool ItemScript::OnCastItemCombatSpell(Player* /*player*/, Unit* /*victim*/, Spe
     return true;
 }
 
-UnitScript::UnitScript(char const* name)
-    : ScriptObject(name)
+UnitScript::UnitScript(char const* name, std::initializer_list<UnitScriptHook> hooks)
+    : ScriptObject(name), ScriptHookSubscriptions(hooks)
 {
     ScriptRegistry<UnitScript>::Instance()->AddScript(this);
 }
@@ -2842,8 +2899,8 @@ AchievementCriteriaScript::AchievementCriteriaScript(char const* name)
 
 AchievementCriteriaScript::~AchievementCriteriaScript() = default;
 
-PlayerScript::PlayerScript(char const* name)
-    : ScriptObject(name)
+PlayerScript::PlayerScript(char const* name, std::initializer_list<PlayerScriptHook> hooks)
+    : ScriptObject(name), ScriptHookSubscriptions(hooks)
 {
     ScriptRegistry<PlayerScript>::Instance()->AddScript(this);
 }
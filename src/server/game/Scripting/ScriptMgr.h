@@ -22,6 +22,8 @@
 #include "ObjectGuid.h"
 #include "Tuples.h"
 #include "Types.h"
+#include <bitset>
+#include <initializer_list>
 #include <memory>
 #include <vector>
 
@@ -169,6 +171,12 @@ enum XPColorChar : uint8;
 
     Now you simply call these two functions from anywhere in the core to trigger the
     event on all registered scripts of that type.
+
+    Script types whose events fire often can also derive from ScriptHookSubscriptions
+    with an enum of their hooks, see PlayerScript. ScriptMgr then triggers each event
+    only on the scripts subscribed to it:
+
+    FOREACH_SCRIPT_HOOK(MyScriptType, OnSomeEvent)->OnSomeEvent(someArg1, someArg2);
 */
 
 class TC_GAME_API ScriptObject
@@ -194,6 +202,29 @@ class TC_GAME_API ScriptObject
         std::string const _name;
 };
 
+// Lets scripts list the hooks they override when they are registered, scripts that list none are subscribed to all hooks
+template<typename Hook>
+class ScriptHookSubscriptions
+{
+    public:
+
+        typedef Hook HookType;
+
+        bool IsSubscribedTo(Hook hook) const { return _hooks.none() || _hooks.test(std::size_t(hook)); }
+
+    protected:
+
+        explicit ScriptHookSubscriptions(std::initializer_list<Hook> hooks)
+        {
+            for (Hook hook : hooks)
+                _hooks.set(std::size_t(hook));
+        }
+
+    private:
+
+        std::bitset<std::size_t(Hook::Max)> _hooks;
+};
+
 class TC_GAME_API SpellScriptLoader : public ScriptObject
 {
     protected:
@@ -209,11 +240,23 @@ class TC_GAME_API SpellScriptLoader : public ScriptObject
         virtual AuraScript* GetAuraScript() const;
 };
 
-class TC_GAME_API ServerScript : public ScriptObject
+enum class ServerScriptHook : uint8
+{
+    OnNetworkStart,
+    OnNetworkStop,
+    OnSocketOpen,
+    OnSocketClose,
+    OnPacketSend,
+    OnPacketReceive,
+
+    Max
+};
+
+class TC_GAME_API ServerScript : public ScriptObject, public ScriptHookSubscriptions<ServerScriptHook>
 {
     protected:
 
-        explicit ServerScript(char const* name);
+        explicit ServerScript(char const* name, std::initializer_list<ServerScriptHook> hooks = { });
 
     public:
 
@@ -241,11 +284,25 @@ class TC_GAME_API ServerScript : public ScriptObject
         virtual void OnPacketReceive(WorldSession* session, WorldPacket& packet);
 };
 
-class TC_GAME_API WorldScript : public ScriptObject
+enum class WorldScriptHook : uint8
+{
+    OnOpenStateChange,
+    OnConfigLoad,
+    OnMotdChange,
+    OnShutdownInitiate,
+    OnShutdownCancel,
+    OnUpdate,
+    OnStartup,
+    OnShutdown,
+
+    Max
+};
+
+class TC_GAME_API WorldScript : public ScriptObject, public ScriptHookSubscriptions<WorldScriptHook>
 {
     protected:
 
-        explicit WorldScript(char const* name);
+        explicit WorldScript(char const* name, std::initializer_list<WorldScriptHook> hooks = { });
 
     public:
 
@@ -399,11 +456,22 @@ class TC_GAME_API ItemScript : public ScriptObject
         virtual bool OnCastItemCombatSpell(Player* player, Unit* victim, SpellInfo const* spellInfo, Item* item);
 };
 
-class TC_GAME_API UnitScript : public ScriptObject
+enum class UnitScriptHook : uint8
+{
+    OnHeal,
+    OnDamage,
+    ModifyPeriodicDamageAurasTick,
+    ModifyMeleeDamage,
+    ModifySpellDamageTaken,
+
+    Max
+};
+
+class TC_GAME_API UnitScript : public ScriptObject, public ScriptHookSubscriptions<UnitScriptHook>
 {
     protected:
 
-        explicit UnitScript(char const* name);
+        explicit UnitScript(char const* name, std::initializer_list<UnitScriptHook> hooks = { });
 
     public:
 
@@ -690,11 +758,47 @@ class TC_GAME_API AchievementCriteriaScript : public ScriptObject
         virtual bool OnCheck(Player* source, Unit* target) = 0;
 };
 
-class TC_GAME_API PlayerScript : public ScriptObject
+enum class PlayerScriptHook : uint8
+{
+    OnPVPKill,
+    OnCreatureKill,
+    OnPlayerKilledByCreature,
+    OnLevelChanged,
+    OnFreeTalentPointsChanged,
+    OnTalentsReset,
+    OnMoneyChanged,
+    OnMoneyLimit,
+    OnGiveXP,
+    OnReputationChange,
+    OnDuelRequest,
+    OnDuelStart,
+    OnDuelEnd,
+    OnChat,                     // all OnChat overloads
+    OnClearEmote,
+    OnTextEmote,
+    OnSpellCast,
+    OnLogin,
+    OnLogout,
+    OnCreate,
+    OnDelete,
+    OnFailedDelete,
+    OnSave,
+    OnBindToInstance,
+    OnUpdateZone,
+    OnMapChanged,
+    OnQuestStatusChange,
+    OnPlayerRepop,
+    OnMovieComplete,
+    OnPlayerChoiceResponse,
+
+    Max
+};
+
+class TC_GAME_API PlayerScript : public ScriptObject, public ScriptHookSubscriptions<PlayerScriptHook>
 {
     protected:
 
-        explicit PlayerScript(char const* name);
+        explicit PlayerScript(char const* name, std::initializer_list<PlayerScriptHook> hooks = { });
 
     public:
 
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ScriptProfiler.h"
+#include "Creature.h"
+#include "Metric.h"
+#include "StringFormat.h"
+#include <algorithm>
+
+ScriptProfiler::ScriptProfiler() : _sampleRate(0)
+{
+}
+
+ScriptProfiler* ScriptProfiler::instance()
+{
+    static ScriptProfiler instance;
+    return &instance;
+}
+
+bool ScriptProfiler::NextSample(uint32 sampleRate)
+{
+    thread_local uint32 calls = 0;
+    return ++calls % sampleRate == 0;
+}
+
+void ScriptProfiler::Record(std::string_view script, char const* hook, Microseconds duration)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    auto scriptItr = _stats.find(script);
+    if (scriptItr == _stats.end())
+        scriptItr = _stats.emplace(std::string(script), std::map<std::string_view, Entry>()).first;
+
+    auto [itr, inserted] = scriptItr->second.try_emplace(hook);
+    Entry& entry = itr->second;
+    if (inserted)
+    {
+        entry.Stats.Script = scriptItr->first;
+        entry.Stats.Hook = itr->first;
+        entry.Metric = sMetric->RegisterHandle(MetricHandleType::Histogram, "script_hook_time_us",
+            { TC_METRIC_TAG("script", scriptItr->first), TC_METRIC_TAG("hook", hook) });
+    }
+
+    ++entry.Stats.SampledCalls;
+    entry.Stats.Total += duration;
+    entry.Stats.Max = std::max(entry.Stats.Max, duration);
+    TC_METRIC_HANDLE_VALUE(entry.Metric, int64(duration.count()));
+}
+
+void ScriptProfiler::RecordCreatureAI(Creature const& creature, Microseconds duration)
+{
+    std::string scriptName = creature.GetScriptName();
+    if (scriptName.empty())
+        scriptName = Trinity::StringFormat("creature {}", creature.GetEntry());
+
+    Record(scriptName, "UpdateAI", duration);
+}
+
+void ScriptProfiler::VisitStats(std::function<void(HookStats const&)> const& visitor)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::vector<HookStats const*> stats;
+    for (auto const& [script, hooks] : _stats)
+        for (auto const& [hook, entry] : hooks)
+            stats.push_back(&entry.Stats);
+
+    std::sort(stats.begin(), stats.end(), [](HookStats const* left, HookStats const* right)
+    {
+        return left->Total > right->Total;
+    });
+
+    for (HookStats const* hookStats : stats)
+        visitor(*hookStats);
+}
+
+void ScriptProfiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _stats.clear();
+}
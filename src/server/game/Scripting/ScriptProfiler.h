@@ -0,0 +1,120 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TRINITY_SCRIPTPROFILER_H
+#define TRINITY_SCRIPTPROFILER_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Creature;
+class MetricHandle;
+
+/**
+ * Accumulates sampled call counts and inclusive time of script hooks per script name and hook.
+ *
+ * One of every ScriptProfiler.SampleRate hook calls of each thread is timed, nothing is timed when the rate is 0.
+ * Sampled times are also recorded to the script_hook_time_us metric tagged with script and hook.
+ */
+class TC_GAME_API ScriptProfiler
+{
+public:
+    static ScriptProfiler* instance();
+
+    struct HookStats
+    {
+        std::string_view Script;
+        std::string_view Hook;
+        uint64 SampledCalls = 0;
+        Microseconds Total = Microseconds::zero();
+        Microseconds Max = Microseconds::zero();
+    };
+
+    // times the rest of the scope if this call is sampled, hook must be a string literal
+    class Sample
+    {
+    public:
+        Sample(std::string const& script, char const* hook) : _script(nullptr), _hook(nullptr)
+        {
+            if (ScriptProfiler::instance()->ShouldSample())
+            {
+                _script = &script;
+                _hook = hook;
+                _start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~Sample()
+        {
+            if (_hook)
+                ScriptProfiler::instance()->Record(*_script, _hook, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - _start));
+        }
+
+        Sample(Sample const&) = delete;
+        Sample& operator=(Sample const&) = delete;
+
+    private:
+        std::string const* _script;
+        char const* _hook;
+        TimePoint _start;
+    };
+
+    void SetSampleRate(uint32 sampleRate) { _sampleRate.store(sampleRate, std::memory_order_relaxed); }
+    uint32 GetSampleRate() const { return _sampleRate.load(std::memory_order_relaxed); }
+
+    // thread safe
+    bool ShouldSample()
+    {
+        uint32 sampleRate = GetSampleRate();
+        return sampleRate && NextSample(sampleRate);
+    }
+    void Record(std::string_view script, char const* hook, Microseconds duration);
+    void RecordCreatureAI(Creature const& creature, Microseconds duration);
+
+    // calls the visitor with all stats sorted by total time, longest first
+    void VisitStats(std::function<void(HookStats const&)> const& visitor);
+    void Reset();
+
+private:
+    ScriptProfiler();
+
+    bool NextSample(uint32 sampleRate);
+
+    struct Entry
+    {
+        HookStats Stats;
+        std::shared_ptr<MetricHandle> Metric;
+    };
+
+    std::atomic<uint32> _sampleRate;
+
+    std::mutex _lock;
+    std::map<std::string, std::map<std::string_view /*hook*/, Entry>, std::less<>> _stats;
+};
+
+#define sScriptProfiler ScriptProfiler::instance()
+
+#endif // TRINITY_SCRIPTPROFILER_H
@@ -0,0 +1,212 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PacketReplay.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include "PacketLog.h"
+#include "StringFormat.h"
+#include "World.h"
+#include "WorldPacket.h"
+#include "WorldSession.h"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+void Summarize(std::vector<Microseconds> values, Microseconds& mean, Microseconds& p95, Microseconds& max)
+{
+    if (values.empty())
+        return;
+
+    std::sort(values.begin(), values.end());
+    mean = std::accumulate(values.begin(), values.end(), 0us) / values.size();
+    p95 = values[(values.size() - 1) * 95 / 100];
+    max = values.back();
+}
+}
+
+PacketReplay::PacketReplay() : _running(false), _tickDiff(0), _time(0), _nextPacket(0), _packetsQueued(0), _packetsSkipped(0), _mapUpdate(0)
+{
+}
+
+PacketReplay* PacketReplay::instance()
+{
+    static PacketReplay instance;
+    return &instance;
+}
+
+bool PacketReplay::Start(std::string const& fileName, std::vector<uint32> const& accountIds, Milliseconds tickDiff, std::string& error)
+{
+    if (_running)
+    {
+        error = "a replay is already running";
+        return false;
+    }
+
+    std::vector<LoggedPacket> loggedPackets;
+    if (!PacketLogReader::Read(fileName, loggedPackets, error))
+        return false;
+
+    // a connection is identified by the client socket address, connections get a session in order of appearance
+    std::vector<std::pair<std::array<uint8, 16>, uint32>> connections;
+    std::vector<ReplayPacket> packets;
+    for (LoggedPacket& loggedPacket : loggedPackets)
+    {
+        if (loggedPacket.PacketDirection != CLIENT_TO_SERVER || loggedPacket.Opcode >= NUM_OPCODE_HANDLERS)
+            continue;
+
+        ClientOpcodeHandler const* handler = opcodeTable[static_cast<OpcodeClient>(loggedPacket.Opcode)];
+        if (!handler || handler->Status != STATUS_LOGGEDIN)
+            continue;
+
+        auto connectionKey = std::make_pair(loggedPacket.Address, loggedPacket.Port);
+        auto connectionItr = std::find(connections.begin(), connections.end(), connectionKey);
+        if (connectionItr == connections.end())
+        {
+            if (connections.size() >= accountIds.size())
+                continue;
+
+            connectionItr = connections.insert(connections.end(), connectionKey);
+        }
+
+        ReplayPacket& packet = packets.emplace_back();
+        packet.Time = loggedPacket.ArrivalTicks;
+        packet.Connection = uint32(std::distance(connections.begin(), connectionItr));
+        packet.Opcode = uint16(loggedPacket.Opcode);
+        packet.ConnectionType = uint8(loggedPacket.ConnectionType);
+        packet.Data = std::move(loggedPacket.Data);
+    }
+
+    if (packets.empty())
+    {
+        error = Trinity::StringFormat("{} contains no client packets handled in world", fileName);
+        return false;
+    }
+
+    // the log is written by several network threads, arrival order is what the world thread would have seen
+    std::stable_sort(packets.begin(), packets.end(), [](ReplayPacket const& left, ReplayPacket const& right) { return left.Time < right.Time; });
+
+    _packets = std::move(packets);
+    _nextPacket = 0;
+    _connectionAccounts.assign(accountIds.begin(), accountIds.begin() + connections.size());
+    _tickDiff = tickDiff;
+    _time = _packets.front().Time;
+    _packetsQueued = 0;
+    _packetsSkipped = 0;
+    _worldUpdateTimes.clear();
+    _mapUpdateTimes.clear();
+    _running = true;
+
+    TC_LOG_INFO("server.replay", "Replaying {} packets of {} connections from {} in {} ms ticks",
+        _packets.size(), _connectionAccounts.size(), fileName, _tickDiff.count());
+    return true;
+}
+
+void PacketReplay::Stop()
+{
+    if (!_running)
+        return;
+
+    Summary summary = GetSummary();
+    TC_LOG_INFO("server.replay", "Replay stopped after {} ticks, {} packets queued, {} skipped, {} left. "
+        "World update mean {} us, p95 {} us, max {} us. Map update mean {} us, p95 {} us, max {} us",
+        summary.Ticks, summary.PacketsQueued, summary.PacketsSkipped, summary.PacketsLeft,
+        summary.WorldUpdateMean.count(), summary.WorldUpdateP95.count(), summary.WorldUpdateMax.count(),
+        summary.MapUpdateMean.count(), summary.MapUpdateP95.count(), summary.MapUpdateMax.count());
+
+    _running = false;
+    _packets.clear();
+    _packets.shrink_to_fit();
+    _connectionAccounts.clear();
+}
+
+PacketReplay::Summary PacketReplay::GetSummary() const
+{
+    Summary summary;
+    summary.Ticks = uint32(_worldUpdateTimes.size());
+    summary.PacketsQueued = _packetsQueued;
+    summary.PacketsSkipped = _packetsSkipped;
+    summary.PacketsLeft = uint32(_packets.size() - _nextPacket);
+    Summarize(_worldUpdateTimes, summary.WorldUpdateMean, summary.WorldUpdateP95, summary.WorldUpdateMax);
+    Summarize(_mapUpdateTimes, summary.MapUpdateMean, summary.MapUpdateP95, summary.MapUpdateMax);
+    return summary;
+}
+
+void PacketReplay::BeginTick()
+{
+    _time += _tickDiff.count();
+    _mapUpdate = 0us;
+
+    for (; _nextPacket < _packets.size() && _packets[_nextPacket].Time < _time; ++_nextPacket)
+    {
+        ReplayPacket const& replayPacket = _packets[_nextPacket];
+        WorldSession* session = sWorld->FindSession(_connectionAccounts[replayPacket.Connection]);
+        if (!session)
+        {
+            ++_packetsSkipped;
+            continue;
+        }
+
+        // same layout as packets read by WorldSocket, the opcode is already consumed
+        WorldPacket* packet = new WorldPacket(replayPacket.Opcode, sizeof(uint16) + replayPacket.Data.size(), ConnectionType(replayPacket.ConnectionType));
+        *packet << uint16(replayPacket.Opcode);
+        packet->append(replayPacket.Data.data(), replayPacket.Data.size());
+        packet->read_skip<uint16>();
+        session->QueuePacket(packet);
+        ++_packetsQueued;
+    }
+}
+
+void PacketReplay::EndTick(Microseconds duration)
+{
+    _worldUpdateTimes.push_back(duration);
+    _mapUpdateTimes.push_back(_mapUpdate);
+
+    // the last packets were handled by this tick
+    if (_nextPacket >= _packets.size())
+        Stop();
+}
+
+PacketReplay::WorldTick::WorldTick(uint32& diff)
+{
+    if (!sPacketReplay->IsRunning())
+        return;
+
+    diff = uint32(sPacketReplay->_tickDiff.count());
+    sPacketReplay->BeginTick();
+    _start = std::chrono::steady_clock::now();
+}
+
+PacketReplay::WorldTick::~WorldTick()
+{
+    // a replay started by a command during this tick is measured from the next one
+    if (sPacketReplay->IsRunning() && _start != TimePoint())
+        sPacketReplay->EndTick(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - _start));
+}
+
+PacketReplay::MapUpdate::MapUpdate()
+{
+    if (sPacketReplay->IsRunning())
+        _start = std::chrono::steady_clock::now();
+}
+
+PacketReplay::MapUpdate::~MapUpdate()
+{
+    if (sPacketReplay->IsRunning() && _start != TimePoint())
+        sPacketReplay->_mapUpdate += std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - _start);
+}
@@ -0,0 +1,116 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PACKETREPLAY_H
+#define TRINITY_PACKETREPLAY_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <string>
+#include <vector>
+
+/**
+ * Replays the client packets of a PacketLog capture into online sessions to measure the server under a
+ * recorded load. Every connection of the capture is bound to one session, in order of appearance.
+ *
+ * While a replay runs World::Update ignores the real time that passed and advances by a fixed step, each
+ * tick receiving the packets captured during that step, so repeated runs from the same world state execute
+ * the same work per tick and their World::Update and map update times can be compared.
+ *
+ * Only packets of opcodes handled while in world are replayed, the bound sessions must already be logged in.
+ * World thread only.
+ */
+class TC_GAME_API PacketReplay
+{
+public:
+    static PacketReplay* instance();
+
+    bool Start(std::string const& fileName, std::vector<uint32> const& accountIds, Milliseconds tickDiff, std::string& error);
+    void Stop();
+
+    bool IsRunning() const { return _running; }
+
+    struct Summary
+    {
+        uint32 Ticks = 0;
+        uint32 PacketsQueued = 0;
+        uint32 PacketsSkipped = 0;              // the bound session was no longer online
+        uint32 PacketsLeft = 0;
+        Microseconds WorldUpdateMean = 0us;
+        Microseconds WorldUpdateP95 = 0us;
+        Microseconds WorldUpdateMax = 0us;
+        Microseconds MapUpdateMean = 0us;
+        Microseconds MapUpdateP95 = 0us;
+        Microseconds MapUpdateMax = 0us;
+    };
+
+    Summary GetSummary() const;
+
+    /// Replaces the diff of the World::Update it is created in and queues the packets of the tick
+    class TC_GAME_API WorldTick
+    {
+    public:
+        explicit WorldTick(uint32& diff);
+        ~WorldTick();
+
+    private:
+        TimePoint _start;
+    };
+
+    /// Times the map update phase of a replayed tick
+    class TC_GAME_API MapUpdate
+    {
+    public:
+        MapUpdate();
+        ~MapUpdate();
+
+    private:
+        TimePoint _start;
+    };
+
+private:
+    PacketReplay();
+
+    void BeginTick();
+    void EndTick(Microseconds duration);
+
+    struct ReplayPacket
+    {
+        uint32 Time;
+        uint32 Connection;
+        uint16 Opcode;
+        uint8 ConnectionType;
+        std::vector<uint8> Data;
+    };
+
+    bool _running;
+    Milliseconds _tickDiff;
+    uint32 _time;
+    std::vector<ReplayPacket> _packets;
+    std::size_t _nextPacket;
+    std::vector<uint32> _connectionAccounts;
+
+    uint32 _packetsQueued;
+    uint32 _packetsSkipped;
+    Microseconds _mapUpdate;
+    std::vector<Microseconds> _worldUpdateTimes;
+    std::vector<Microseconds> _mapUpdateTimes;
+};
+
+#define sPacketReplay PacketReplay::instance()
+
+#endif // TRINITY_PACKETREPLAY_H
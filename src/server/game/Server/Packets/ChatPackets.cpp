@@ -38,7 +38,7 @@ void WorldPackets::Chat::ChatMessage::Read()
         default:
             break;
     }
-    Text = _worldPacket.ReadString(len);
+    Text = _worldPacket.ReadStringView(len);
 }
 
 void WorldPackets::Chat::ChatMessageWhisper::Read()
@@ -46,8 +46,8 @@ void WorldPackets::Chat::ChatMessageWhisper::Read()
     _worldPacket >> Language;
     uint32 targetLen = _worldPacket.ReadBits(9);
     uint32 textLen = _worldPacket.ReadBits(11);
-    Target = _worldPacket.ReadString(targetLen);
-    Text = _worldPacket.ReadString(textLen);
+    Target = _worldPacket.ReadStringView(targetLen);
+    Text = _worldPacket.ReadStringView(textLen);
 }
 
 void WorldPackets::Chat::ChatMessageChannel::Read()
@@ -59,8 +59,8 @@ void WorldPackets::Chat::ChatMessageChannel::Read()
     if (_worldPacket.ReadBit())
         IsSecure = _worldPacket.ReadBit();
 
-    Target = _worldPacket.ReadString(targetLen);
-    Text = _worldPacket.ReadString(textLen);
+    Target = _worldPacket.ReadStringView(targetLen);
+    Text = _worldPacket.ReadStringView(textLen);
 }
 
 ByteBuffer& operator>>(ByteBuffer& data, WorldPackets::Chat::ChatAddonMessageParams& params)
@@ -69,8 +69,8 @@ ByteBuffer& operator>>(ByteBuffer& data, WorldPackets::Chat::ChatAddonMessagePar
     uint32 textLen = data.ReadBits(8);
     params.IsLogged = data.ReadBit();
     params.Type = ChatMsg(data.read<int32>());
-    params.Prefix = data.ReadString(prefixLen);
-    params.Text = data.ReadString(textLen, false);
+    params.Prefix = data.ReadStringView(prefixLen);
+    params.Text = data.ReadStringView(textLen, false);
 
     return data;
 }
@@ -87,7 +87,7 @@ void WorldPackets::Chat::ChatAddonMessageTargeted::Read()
 
     _worldPacket >> Params;
     _worldPacket >> *ChannelGUID;
-    Target = _worldPacket.ReadString(targetLen);
+    Target = _worldPacket.ReadStringView(targetLen);
 }
 
 void WorldPackets::Chat::ChatMessageDND::Read()
@@ -105,7 +105,7 @@ void WorldPackets::Chat::ChatMessageAFK::Read()
 void WorldPackets::Chat::ChatMessageEmote::Read()
 {
     uint32 len = _worldPacket.ReadBits(11);
-    Text = _worldPacket.ReadString(len);
+    Text = _worldPacket.ReadStringView(len);
 }
 
 WorldPackets::Chat::Chat::Chat(Chat const& chat) : ServerPacket(SMSG_CHAT, chat._worldPacket.size()),
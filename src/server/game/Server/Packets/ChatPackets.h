@@ -47,7 +47,7 @@ namespace WorldPackets
 
             void Read() override;
 
-            std::string Text;
+            std::string_view Text;
             int32 Language = LANG_UNIVERSAL;
             bool IsSecure = true;
         };
@@ -61,8 +61,8 @@ namespace WorldPackets
             void Read() override;
 
             int32 Language = LANG_UNIVERSAL;
-            std::string Text;
-            std::string Target;
+            std::string_view Text;
+            std::string_view Target;
         };
 
         // CMSG_CHAT_MESSAGE_CHANNEL
@@ -75,15 +75,15 @@ namespace WorldPackets
 
             int32 Language = LANG_UNIVERSAL;
             ObjectGuid ChannelGUID;
-            std::string Text;
-            std::string Target;
+            std::string_view Text;
+            std::string_view Target;
             Optional<bool> IsSecure;
         };
 
         struct ChatAddonMessageParams
         {
-            std::string Prefix;
-            std::string Text;
+            std::string_view Prefix;
+            std::string_view Text;
             ChatMsg Type = CHAT_MSG_PARTY;
             bool IsLogged = false;
         };
@@ -110,7 +110,7 @@ namespace WorldPackets
 
             void Read() override;
 
-            std::string Target;
+            std::string_view Target;
             ChatAddonMessageParams Params;
             Optional<ObjectGuid> ChannelGUID; // not optional in the packet. Optional for api reasons
         };
@@ -142,7 +142,7 @@ namespace WorldPackets
 
             void Read() override;
 
-            std::string Text;
+            std::string_view Text;
         };
 
         // SMSG_CHAT
@@ -56,7 +56,7 @@ namespace WorldPackets
 
             void Read() override;
 
-            GuidUnorderedSet QuestGiverGUIDs;
+            GuidFlatSet QuestGiverGUIDs;
         };
 
         struct QuestGiverInfo
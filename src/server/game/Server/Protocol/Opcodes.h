@@ -23,6 +23,7 @@
 #define _OPCODES_H
 
 #include "Define.h"
+#include <memory>
 #include <string>
 
 enum ConnectionType : int8
@@ -2111,9 +2112,11 @@ enum PacketProcessing
 {
     PROCESS_INPLACE = 0,                                    //process packet whenever we receive it - mostly for non-handled or non-implemented packets
     PROCESS_THREADUNSAFE,                                   //packet is not thread-safe - process it in World::UpdateSessions()
-    PROCESS_THREADSAFE                                      //packet is thread-safe - process it in Map::Update()
+    PROCESS_THREADSAFE,                                     //packet is thread-safe - process it in Map::Update()
+    PROCESS_QUERY                                           //packet only reads static data - process it in the query thread pool (PROCESS_INPLACE if disabled)
 };
 
+class MetricHandle;
 class WorldPacket;
 class WorldSession;
 
@@ -2136,6 +2139,7 @@ public:
     virtual void Call(WorldSession* session, WorldPacket& packet) const = 0;
 
     PacketProcessing ProcessingPlace;
+    std::shared_ptr<MetricHandle> CostMetric;   // time spent in handler, in microseconds
 };
 
 class ServerOpcodeHandler : public OpcodeHandler
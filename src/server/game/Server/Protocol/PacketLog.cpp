@@ -19,10 +19,15 @@
 #include "Config.h"
 #include "GameTime.h"
 #include "IpAddress.h"
+#include "Log.h"
 #include "Realm.h"
+#include "StringConvert.h"
+#include "StringFormat.h"
 #include "Timer.h"
+#include "Util.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include <zlib.h>
 
 #pragma pack(push, 1)
 
@@ -60,17 +65,34 @@ struct PacketHeader
 
 #pragma pack(pop)
 
-PacketLog::PacketLog() : _file(nullptr)
+namespace
+{
+std::size_t constexpr AsyncWriteBufferSize = 1024 * 1024;
+Milliseconds constexpr AsyncWriteInterval = 10ms;
+Milliseconds constexpr AsyncFlushInterval = 1s;
+}
+
+PacketLog::PacketLog() : _file(nullptr), _compressedFile(nullptr), _stopWriter(false)
 {
     std::call_once(_initializeFlag, &PacketLog::Initialize, this);
 }
 
 PacketLog::~PacketLog()
 {
+    if (_writerThread.joinable())
+    {
+        _stopWriter = true;
+        _writerThread.join();
+    }
+
     if (_file)
         fclose(_file);
 
+    if (_compressedFile)
+        gzclose(_compressedFile);
+
     _file = nullptr;
+    _compressedFile = nullptr;
 }
 
 PacketLog* PacketLog::instance()
@@ -90,7 +112,26 @@ void PacketLog::Initialize()
     std::string logname = sConfigMgr->GetStringDefault("PacketLogFile", "");
     if (!logname.empty())
     {
-        _file = fopen((logsDir + logname).c_str(), "wb");
+        bool async = sConfigMgr->GetBoolDefault("PacketLog.Async", false);
+        if (sConfigMgr->GetBoolDefault("PacketLog.Compress", false))
+        {
+            _compressedFile = gzopen((logsDir + logname).c_str(), "wb");
+            if (_compressedFile)
+                gzbuffer(_compressedFile, AsyncWriteBufferSize);
+        }
+        else
+        {
+            _file = fopen((logsDir + logname).c_str(), "wb");
+            if (_file && async)
+                setvbuf(_file, nullptr, _IOFBF, AsyncWriteBufferSize);
+        }
+
+        std::string accountIds = sConfigMgr->GetStringDefault("PacketLog.AccountIds", "");
+        for (std::string_view accountId : Trinity::Tokenize(accountIds, ' ', false))
+            if (Optional<uint32> id = Trinity::StringTo<uint32>(accountId))
+                _accountIds.push_back(*id);
+
+        std::sort(_accountIds.begin(), _accountIds.end());
 
         if (CanLogPacket())
         {
@@ -105,14 +146,21 @@ void PacketLog::Initialize()
             header.SniffStartTicks = getMSTime();
             header.OptionalDataSize = 0;
 
-            fwrite(&header, sizeof(header), 1, _file);
+            Write(&header, sizeof(header));
+
+            if (async)
+            {
+                _queue = std::make_unique<Trinity::MPSCQueueBounded<std::vector<uint8>>>(sConfigMgr->GetIntDefault("PacketLog.AsyncQueueSize", 65536));
+                _writerThread = std::thread(&PacketLog::WriterThread, this);
+            }
         }
     }
 }
 
-void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port, ConnectionType connectionType)
+void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port, ConnectionType connectionType, uint32 accountId)
 {
-    std::lock_guard<std::mutex> lock(_logPacketLock);
+    if (!_accountIds.empty() && !std::binary_search(_accountIds.begin(), _accountIds.end(), accountId))
+        return;
 
     PacketHeader header;
     header.Direction = direction == CLIENT_TO_SERVER ? 0x47534d43 : 0x47534d53;
@@ -134,20 +182,172 @@ void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, boost:
 
     header.OptionalData.SocketPort = port;
     std::size_t size = packet.size();
+    uint8 const* data = packet.contents();
     if (direction == CLIENT_TO_SERVER)
+    {
         size -= 2;
+        data += 2;
+    }
 
     header.Length = size + sizeof(header.Opcode);
     header.Opcode = packet.GetOpcode();
 
-    fwrite(&header, sizeof(header), 1, _file);
-    if (size)
+    if (_queue)
     {
-        uint8 const* data = packet.contents();
-        if (direction == CLIENT_TO_SERVER)
-            data += 2;
+        std::vector<uint8> record(sizeof(header) + size);
+        memcpy(record.data(), &header, sizeof(header));
+        if (size)
+            memcpy(record.data() + sizeof(header), data, size);
+
+        _queue->Enqueue(std::move(record));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_logPacketLock);
+
+    Write(&header, sizeof(header));
+    if (size)
+        Write(data, size);
+
+    Flush();
+}
+
+void PacketLog::Write(void const* data, std::size_t size)
+{
+    if (_compressedFile)
+        gzwrite(_compressedFile, data, unsigned(size));
+    else
         fwrite(data, 1, size, _file);
+}
+
+void PacketLog::Flush()
+{
+    if (_compressedFile)
+        gzflush(_compressedFile, Z_SYNC_FLUSH);
+    else
+        fflush(_file);
+}
+
+void PacketLog::WriterThread()
+{
+    TimePoint lastFlush = std::chrono::steady_clock::now();
+    bool pendingFlush = false;
+    bool stopping = false;
+    std::vector<uint8> record;
+    while (!stopping)
+    {
+        // drain everything enqueued before the stop request
+        stopping = _stopWriter;
+
+        while (_queue->Dequeue(record))
+        {
+            Write(record.data(), record.size());
+            pendingFlush = true;
+        }
+
+        if (std::size_t dropped = _queue->ConsumeRejectedCount())
+            TC_LOG_ERROR("network", "PacketLog: queue full, dropped {} packets. Increase PacketLog.AsyncQueueSize", dropped);
+
+        TimePoint now = std::chrono::steady_clock::now();
+        if (pendingFlush && (stopping || now - lastFlush >= AsyncFlushInterval))
+        {
+            Flush();
+            pendingFlush = false;
+            lastFlush = now;
+        }
+
+        if (!stopping)
+            std::this_thread::sleep_for(AsyncWriteInterval);
+    }
+}
+
+bool PacketLogReader::Read(std::string const& fileName, std::vector<LoggedPacket>& packets, std::string& error)
+{
+    // reads compressed and uncompressed logs alike
+    std::unique_ptr<gzFile_s, int(*)(gzFile)> file(gzopen(fileName.c_str(), "rb"), &gzclose);
+    if (!file)
+    {
+        error = Trinity::StringFormat("cannot open {}", fileName);
+        return false;
+    }
+
+    auto read = [&](void* data, std::size_t size) { return gzread(file.get(), data, unsigned(size)); };
+    auto skip = [&](uint32 size) { return gzseek(file.get(), size, SEEK_CUR) != -1; };
+
+    LogHeader logHeader;
+    if (read(&logHeader, sizeof(logHeader)) != int(sizeof(logHeader))
+        || memcmp(logHeader.Signature, "PKT", sizeof(logHeader.Signature)) != 0
+        || logHeader.FormatVersion != 0x0301)
+    {
+        error = Trinity::StringFormat("{} is not a PKT 3.1 packet log", fileName);
+        return false;
+    }
+
+    if (logHeader.OptionalDataSize && !skip(logHeader.OptionalDataSize))
+    {
+        error = Trinity::StringFormat("{} is truncated", fileName);
+        return false;
+    }
+
+    std::size_t const fixedHeaderSize = sizeof(PacketHeader) - sizeof(PacketHeader::OptionalData) - sizeof(PacketHeader::Opcode);
+    PacketHeader header;
+    std::size_t complete = packets.size();
+    bool truncated = false;
+    while (int headerRead = read(&header, fixedHeaderSize))
+    {
+        if (headerRead != int(fixedHeaderSize))
+        {
+            truncated = true;
+            break;
+        }
+
+        // PacketLog always writes the socket address, other sniffers may not
+        LoggedPacket& packet = packets.emplace_back();
+        packet.Address = { };
+        packet.Port = 0;
+        if (header.OptionalDataSize == sizeof(header.OptionalData))
+        {
+            if (read(&header.OptionalData, sizeof(header.OptionalData)) != int(sizeof(header.OptionalData)))
+            {
+                truncated = true;
+                break;
+            }
+
+            memcpy(packet.Address.data(), header.OptionalData.SocketIPBytes, packet.Address.size());
+            packet.Port = header.OptionalData.SocketPort;
+        }
+        else if (header.OptionalDataSize && !skip(header.OptionalDataSize))
+        {
+            truncated = true;
+            break;
+        }
+
+        if (header.Length < sizeof(header.Opcode) || read(&header.Opcode, sizeof(header.Opcode)) != int(sizeof(header.Opcode)))
+        {
+            truncated = true;
+            break;
+        }
+
+        packet.PacketDirection = header.Direction == 0x47534d43 ? CLIENT_TO_SERVER : SERVER_TO_CLIENT;
+        packet.ConnectionType = header.ConnectionId;
+        packet.ArrivalTicks = header.ArrivalTicks - logHeader.SniffStartTicks;
+        packet.Opcode = header.Opcode;
+        packet.Data.resize(header.Length - sizeof(header.Opcode));
+        if (!packet.Data.empty() && read(packet.Data.data(), packet.Data.size()) != int(packet.Data.size()))
+        {
+            truncated = true;
+            break;
+        }
+
+        ++complete;
+    }
+
+    if (truncated)
+    {
+        packets.resize(complete);
+        error = Trinity::StringFormat("{} is truncated after {} packets", fileName, packets.size());
+        return false;
     }
 
-    fflush(_file);
+    return true;
 }
@@ -19,7 +19,12 @@
 #define TRINITY_PACKETLOG_H
 
 #include "Common.h"
+#include "MPSCQueue.h"
+#include <array>
+#include <atomic>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 enum Direction
 {
@@ -29,6 +34,7 @@ enum Direction
 
 class WorldPacket;
 enum ConnectionType : int8;
+struct gzFile_s;
 
 namespace boost
 {
@@ -53,12 +59,41 @@ class TC_GAME_API PacketLog
         static PacketLog* instance();
 
         void Initialize();
-        bool CanLogPacket() const { return (_file != nullptr); }
-        void LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port, ConnectionType connectionType);
+        bool CanLogPacket() const { return (_file != nullptr || _compressedFile != nullptr); }
+        void LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port, ConnectionType connectionType, uint32 accountId);
 
     private:
+        void Write(void const* data, std::size_t size);
+        void Flush();
+        void WriterThread();
+
         FILE* _file;
+        gzFile_s* _compressedFile;
+        std::vector<uint32> _accountIds;    // sorted, empty when all accounts are logged
+
+        // async mode, the calling threads only serialize the packet and the writer thread does all file access
+        std::unique_ptr<Trinity::MPSCQueueBounded<std::vector<uint8>>> _queue;
+        std::thread _writerThread;
+        std::atomic<bool> _stopWriter;
 };
 
 #define sPacketLog PacketLog::instance()
+
+struct LoggedPacket
+{
+    Direction PacketDirection;
+    uint32 ConnectionType;
+    uint32 ArrivalTicks;                // milliseconds since the log was started
+    std::array<uint8, 16> Address;
+    uint32 Port;
+    uint32 Opcode;
+    std::vector<uint8> Data;            // without the opcode
+};
+
+class TC_GAME_API PacketLogReader
+{
+    public:
+        /// Reads all packets of a log written by PacketLog, fails on anything else than PKT 3.1
+        static bool Read(std::string const& fileName, std::vector<LoggedPacket>& packets, std::string& error);
+};
 #endif
@@ -22,6 +22,7 @@
 #include "WorldSession.h"
 #include "QueryHolder.h"
 #include "AccountMgr.h"
+#include "AuctionHouseMgr.h"
 #include "AuthenticationPackets.h"
 #include "BattlePetMgr.h"
 #include "BattlegroundMgr.h"
@@ -30,6 +31,7 @@
 #include "ChatPackets.h"
 #include "ClientConfigPackets.h"
 #include "DatabaseEnv.h"
+#include "FlightRecorder.h"
 #include "GameTime.h"
 #include "Group.h"
 #include "Guild.h"
@@ -50,9 +52,11 @@
 #include "Realm.h"
 #include "ScriptMgr.h"
 #include "SocialMgr.h"
+#include "Trace.h"
 #include "WardenWin.h"
 #include "World.h"
 #include "WorldSocket.h"
+#include <atomic>
 #include <boost/circular_buffer.hpp>
 
 namespace {
@@ -69,6 +73,10 @@ bool MapSessionFilter::Process(WorldPacket* packet)
     if (opHandle->ProcessingPlace == PROCESS_INPLACE)
         return true;
 
+    //query packets are collected in World::UpdateSessions() if the query pool is active
+    if (opHandle->ProcessingPlace == PROCESS_QUERY)
+        return !sWorld->IsQueryPacketPoolActive();
+
     //we do not process thread-unsafe packets
     if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE)
         return false;
@@ -81,6 +89,30 @@ bool MapSessionFilter::Process(WorldPacket* packet)
     return player->IsInWorld();
 }
 
+bool CharacterScreenSessionFilter::Process(WorldPacket* packet)
+{
+    OpcodeClient opcode = static_cast<OpcodeClient>(packet->GetOpcode());
+    if (opcodeTable[opcode]->ProcessingPlace == PROCESS_INPLACE)
+        return true;
+
+    // these handlers are thread-unsafe only because they may be sent by players in world,
+    // without a player they only queue database requests and (de)compress account data
+    switch (opcode)
+    {
+        case CMSG_ENUM_CHARACTERS:
+        case CMSG_ENUM_CHARACTERS_DELETED_BY_CLIENT:
+        case CMSG_GET_UNDELETE_CHARACTER_COOLDOWN_STATUS:
+        case CMSG_REORDER_CHARACTERS:
+        case CMSG_REQUEST_ACCOUNT_DATA:
+        case CMSG_UPDATE_ACCOUNT_DATA:
+            return m_pSession->IsOnCharacterScreen();
+        default:
+            break;
+    }
+
+    return false;
+}
+
 //we should process ALL packets when player is not in world/logged in
 //OR packet handler is not thread-safe!
 bool WorldSessionFilter::Process(WorldPacket* packet)
@@ -88,7 +120,7 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())];
 
     //check if packet handler is supposed to be safe
-    if (opHandle->ProcessingPlace == PROCESS_INPLACE)
+    if (opHandle->ProcessingPlace == PROCESS_INPLACE || opHandle->ProcessingPlace == PROCESS_QUERY)
         return true;
 
     //thread-unsafe packets should be processed in World::UpdateSessions()
@@ -122,6 +154,7 @@ WorldSession::WorldSession(uint32 id, std::string&& name, uint32 battlenetAccoun
     _battlenetRequestToken(0),
     _logoutTime(0),
     m_inQueue(false),
+    _canPrefetchLogin(true),
     m_playerLogout(false),
     m_playerRecentlyLogout(false),
     m_playerSave(false),
@@ -140,6 +173,7 @@ WorldSession::WorldSession(uint32 id, std::string&& name, uint32 battlenetAccoun
     _pendingTimeSyncRequests(),
     _timeSyncNextCounter(0),
     _timeSyncTimer(0),
+    _lastFarMovementRelayTime(0),
     _calendarEventCreationCooldown(0),
     _battlePetMgr(std::make_unique<BattlePets::BattlePetMgr>(this)),
     _collectionMgr(std::make_unique<CollectionMgr>(this))
@@ -178,9 +212,12 @@ WorldSession::~WorldSession()
 
     ///- empty incoming packet queue
     WorldPacket* packet = nullptr;
-    while (_recvQueue.next(packet))
+    while (NextRecvPacket(packet))
         delete packet;
 
+    for (WorldPacket* queryPacket : _queryPackets)
+        delete queryPacket;
+
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = {};", GetAccountId());     // One-time query
 }
 
@@ -210,102 +247,165 @@ std::string WorldSession::GetPlayerInfo() const
     return ss.str();
 }
 
-/// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/)
+/// Validate a packet before sending and select its connection
+WorldSocket* WorldSession::GetSocketForPacket(WorldPacket const& packet, bool forced)
 {
-    if (packet->GetOpcode() == NULL_OPCODE)
+    if (packet.GetOpcode() == NULL_OPCODE)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of NULL_OPCODE to {}", GetPlayerInfo());
-        return;
+        return nullptr;
     }
-    else if (packet->GetOpcode() == UNKNOWN_OPCODE)
+    else if (packet.GetOpcode() == UNKNOWN_OPCODE)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of UNKNOWN_OPCODE to {}", GetPlayerInfo());
-        return;
+        return nullptr;
     }
 
-    ServerOpcodeHandler const* handler = opcodeTable[static_cast<OpcodeServer>(packet->GetOpcode())];
+    ServerOpcodeHandler const* handler = opcodeTable[static_cast<OpcodeServer>(packet.GetOpcode())];
 
     if (!handler)
     {
-        TC_LOG_ERROR("network.opcode", "Prevented sending of opcode {} with non existing handler to {}", packet->GetOpcode(), GetPlayerInfo());
-        return;
+        TC_LOG_ERROR("network.opcode", "Prevented sending of opcode {} with non existing handler to {}", packet.GetOpcode(), GetPlayerInfo());
+        return nullptr;
     }
 
     // Default connection index defined in Opcodes.cpp table
     ConnectionType conIdx = handler->ConnectionIndex;
 
     // Override connection index
-    if (packet->GetConnection() != CONNECTION_TYPE_DEFAULT)
+    if (packet.GetConnection() != CONNECTION_TYPE_DEFAULT)
     {
-        if (packet->GetConnection() != CONNECTION_TYPE_INSTANCE && IsInstanceOnlyOpcode(packet->GetOpcode()))
+        if (packet.GetConnection() != CONNECTION_TYPE_INSTANCE && IsInstanceOnlyOpcode(packet.GetOpcode()))
         {
-            TC_LOG_ERROR("network.opcode", "Prevented sending of instance only opcode {} with connection type {} to {}", packet->GetOpcode(), uint32(packet->GetConnection()), GetPlayerInfo());
-            return;
+            TC_LOG_ERROR("network.opcode", "Prevented sending of instance only opcode {} with connection type {} to {}", packet.GetOpcode(), uint32(packet.GetConnection()), GetPlayerInfo());
+            return nullptr;
         }
 
-        conIdx = packet->GetConnection();
+        conIdx = packet.GetConnection();
     }
 
     if (!m_Socket[conIdx])
     {
-        TC_LOG_ERROR("network.opcode", "Prevented sending of {} to non existent socket {} to {}", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())), uint32(conIdx), GetPlayerInfo());
-        return;
+        TC_LOG_ERROR("network.opcode", "Prevented sending of {} to non existent socket {} to {}", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet.GetOpcode())), uint32(conIdx), GetPlayerInfo());
+        return nullptr;
     }
 
     if (!forced)
     {
         if (handler->Status == STATUS_UNHANDLED)
         {
-            TC_LOG_ERROR("network.opcode", "Prevented sending disabled opcode {} to {}", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())), GetPlayerInfo());
-            return;
+            TC_LOG_ERROR("network.opcode", "Prevented sending disabled opcode {} to {}", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet.GetOpcode())), GetPlayerInfo());
+            return nullptr;
         }
     }
 
 #ifdef TRINITY_DEBUG
-    // Code for network use statistic
-    static uint64 sendPacketCount = 0;
-    static uint64 sendPacketBytes = 0;
+    // Code for network use statistic, packets are also sent from map update threads
+    static std::atomic<uint64> sendPacketCount = 0;
+    static std::atomic<uint64> sendPacketBytes = 0;
 
-    static time_t firstTime = GameTime::GetGameTime();
-    static time_t lastTime = firstTime;                     // next 60 secs start time
+    static time_t const firstTime = GameTime::GetGameTime();
+    static std::atomic<time_t> lastTime = firstTime;        // next 60 secs start time
 
-    static uint64 sendLastPacketCount = 0;
-    static uint64 sendLastPacketBytes = 0;
+    static std::atomic<uint64> sendLastPacketCount = 0;
+    static std::atomic<uint64> sendLastPacketBytes = 0;
 
     time_t cur_time = GameTime::GetGameTime();
+    time_t last = lastTime.load(std::memory_order_relaxed);
 
-    if ((cur_time - lastTime) < 60)
+    // only the thread that moves lastTime forward reports the past minute
+    if ((cur_time - last) >= 60 && lastTime.compare_exchange_strong(last, cur_time, std::memory_order_relaxed))
     {
-        sendPacketCount += 1;
-        sendPacketBytes += packet->size();
-
-        sendLastPacketCount += 1;
-        sendLastPacketBytes += packet->size();
-    }
-    else
-    {
-        uint64 minTime = uint64(cur_time - lastTime);
-        uint64 fullTime = uint64(lastTime - firstTime);
-        TC_LOG_DEBUG("misc", "Send all time packets count: {} bytes: {} avr.count/sec: {} avr.bytes/sec: {} time: {}", sendPacketCount, sendPacketBytes, float(sendPacketCount)/fullTime, float(sendPacketBytes)/fullTime, uint32(fullTime));
-        TC_LOG_DEBUG("misc", "Send last min packets count: {} bytes: {} avr.count/sec: {} avr.bytes/sec: {}", sendLastPacketCount, sendLastPacketBytes, float(sendLastPacketCount)/minTime, float(sendLastPacketBytes)/minTime);
-
-        lastTime = cur_time;
-        sendLastPacketCount = 1;
-        sendLastPacketBytes = packet->wpos();               // wpos is real written size
+        uint64 minTime = uint64(cur_time - last);
+        uint64 fullTime = uint64(last - firstTime);
+        uint64 lastPacketCount = sendLastPacketCount.exchange(0, std::memory_order_relaxed);
+        uint64 lastPacketBytes = sendLastPacketBytes.exchange(0, std::memory_order_relaxed);
+        uint64 packetCount = sendPacketCount.load(std::memory_order_relaxed);
+        uint64 packetBytes = sendPacketBytes.load(std::memory_order_relaxed);
+        TC_LOG_DEBUG("misc", "Send all time packets count: {} bytes: {} avr.count/sec: {} avr.bytes/sec: {} time: {}", packetCount, packetBytes, float(packetCount)/fullTime, float(packetBytes)/fullTime, uint32(fullTime));
+        TC_LOG_DEBUG("misc", "Send last min packets count: {} bytes: {} avr.count/sec: {} avr.bytes/sec: {}", lastPacketCount, lastPacketBytes, float(lastPacketCount)/minTime, float(lastPacketBytes)/minTime);
     }
+
+    sendPacketCount.fetch_add(1, std::memory_order_relaxed);
+    sendPacketBytes.fetch_add(packet.size(), std::memory_order_relaxed);
+    sendLastPacketCount.fetch_add(1, std::memory_order_relaxed);
+    sendLastPacketBytes.fetch_add(packet.size(), std::memory_order_relaxed);
 #endif                                                      // !TRINITY_DEBUG
 
-    sScriptMgr->OnPacketSend(this, *packet);
+    sScriptMgr->OnPacketSend(this, packet);
+
+    TC_LOG_TRACE("network.opcode", "S->C: {} {}", GetPlayerInfo(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet.GetOpcode())));
+    return m_Socket[conIdx].get();
+}
+
+/// Send a packet to the client
+void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/)
+{
+    if (WorldSocket* socket = GetSocketForPacket(*packet, forced))
+        socket->SendPacket(*packet);
+}
 
-    TC_LOG_TRACE("network.opcode", "S->C: {} {}", GetPlayerInfo(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())));
-    m_Socket[conIdx]->SendPacket(*packet);
+/// Send a packet serialized once for many clients
+void WorldSession::SendPacket(std::shared_ptr<SharedWorldPacket const> const& packet)
+{
+    if (WorldSocket* socket = GetSocketForPacket(packet->GetPacket(), false))
+        socket->SendPacket(packet);
 }
 
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
-    _recvQueue.add(new_packet);
+    _recvQueue.Enqueue(new_packet);
+}
+
+bool WorldSession::NextRecvPacket(WorldPacket*& packet)
+{
+    if (!_recvQueueFront.empty())
+    {
+        packet = _recvQueueFront.front();
+        _recvQueueFront.pop_front();
+        return true;
+    }
+
+    return _recvQueue.Dequeue(packet);
+}
+
+bool WorldSession::DeferQueryPacket(ClientOpcodeHandler const* opHandle, WorldPacket* packet)
+{
+    // only reached from World::UpdateSessions(), MapSessionFilter does not accept these while the pool is active
+    if (opHandle->ProcessingPlace != PROCESS_QUERY || !sWorld->IsQueryPacketPoolActive())
+        return false;
+
+    _queryPackets.push_back(packet);
+    return true;
+}
+
+void WorldSession::ProcessQueryPackets()
+{
+    TC_TRACE_ZONE("WorldSession::ProcessQueryPackets");
+
+    for (WorldPacket* packet : _queryPackets)
+    {
+        try
+        {
+            opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())]->Call(this, *packet);
+        }
+        catch (WorldPackets::PacketArrayMaxCapacityException const& pamce)
+        {
+            TC_LOG_ERROR("network", "PacketArrayMaxCapacityException: {} while parsing {} from {}.",
+                pamce.what(), GetOpcodeNameForLogging(static_cast<OpcodeClient>(packet->GetOpcode())), GetPlayerInfo());
+        }
+        catch (ByteBufferException const&)
+        {
+            TC_LOG_ERROR("network", "WorldSession::ProcessQueryPackets ByteBufferException occured while parsing a packet (opcode: {}) from client {}, accountid={}. Skipped packet.",
+                packet->GetOpcode(), GetRemoteAddress(), GetAccountId());
+            packet->hexlike();
+        }
+
+        delete packet;
+    }
+
+    _queryPackets.clear();
 }
 
 /// Logging helper for unexpected opcodes
@@ -329,6 +429,8 @@ void WorldSession::LogUnprocessedTail(WorldPacket const* packet)
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 {
+    TC_TRACE_ZONE("WorldSession::Update");
+
     ///- Before we process anything:
     /// If necessary, kick the player because the client didn't send anything for too long
     /// (or they've been idling in character select)
@@ -343,14 +445,29 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     std::vector<WorldPacket*> requeuePackets;
     uint32 processedPackets = 0;
     time_t currentTime = GameTime::GetGameTime();
+    bool stopProcessing = false;
 
     constexpr uint32 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE = 100;
 
-    while (m_Socket[CONNECTION_TYPE_REALM] && _recvQueue.next(packet, updater))
+    // with a time budget set, packets are limited by what they cost instead of their count
+    Microseconds const timeBudget(sWorld->getIntConfig(CONFIG_SESSION_PACKET_TIME_BUDGET));
+    Microseconds timeSpent = 0us;
+
+    while (m_Socket[CONNECTION_TYPE_REALM] && NextRecvPacket(packet))
     {
+        // packets the filter does not accept stay at the front of the queue
+        if (!updater.Process(packet))
+        {
+            _recvQueueFront.push_front(packet);
+            break;
+        }
+
         OpcodeClient opcode = static_cast<OpcodeClient>(packet->GetOpcode());
         ClientOpcodeHandler const* opHandle = opcodeTable[opcode];
         TC_METRIC_DETAILED_TIMER("worldsession_update_opcode_time", TC_METRIC_TAG("opcode", opHandle->Name));
+        Optional<TimePoint> opcodeStart;
+        if (timeBudget > 0us || sFlightRecorder->IsEnabled() || sMetric->IsEnabled())
+            opcodeStart = std::chrono::steady_clock::now();
 
         try
         {
@@ -375,10 +492,13 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                         if(AntiDOS.EvaluateOpcode(*packet, currentTime))
                         {
                             sScriptMgr->OnPacketReceive(this, *packet);
-                            opHandle->Call(this, *packet);
+                            if (DeferQueryPacket(opHandle, packet))
+                                deletePacket = false;
+                            else
+                                opHandle->Call(this, *packet);
                         }
                         else
-                            processedPackets = MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;   // break out of packet processing loop
+                            stopProcessing = true;
                     }
                     // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
                     break;
@@ -390,10 +510,13 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     {
                         // not expected _player or must checked in packet hanlder
                         sScriptMgr->OnPacketReceive(this, *packet);
-                        opHandle->Call(this, *packet);
+                        if (DeferQueryPacket(opHandle, packet))
+                            deletePacket = false;
+                        else
+                            opHandle->Call(this, *packet);
                     }
                     else
-                        processedPackets = MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;   // break out of packet processing loop
+                        stopProcessing = true;
                     break;
                 case STATUS_TRANSFER:
                     if (!_player)
@@ -403,10 +526,13 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     else if (AntiDOS.EvaluateOpcode(*packet, currentTime))
                     {
                         sScriptMgr->OnPacketReceive(this, *packet);
-                        opHandle->Call(this, *packet);
+                        if (DeferQueryPacket(opHandle, packet))
+                            deletePacket = false;
+                        else
+                            opHandle->Call(this, *packet);
                     }
                     else
-                        processedPackets = MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;   // break out of packet processing loop
+                        stopProcessing = true;
                     break;
                 case STATUS_AUTHED:
                     // prevent cheating with skip queue wait
@@ -424,10 +550,13 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                     if (AntiDOS.EvaluateOpcode(*packet, currentTime))
                     {
                         sScriptMgr->OnPacketReceive(this, *packet);
-                        opHandle->Call(this, *packet);
+                        if (DeferQueryPacket(opHandle, packet))
+                            deletePacket = false;
+                        else
+                            opHandle->Call(this, *packet);
                     }
                     else
-                        processedPackets = MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;   // break out of packet processing loop
+                        stopProcessing = true;
                     break;
                 case STATUS_NEVER:
                     TC_LOG_ERROR("network.opcode", "Received not allowed opcode {} from {}", GetOpcodeNameForLogging(static_cast<OpcodeClient>(packet->GetOpcode()))
@@ -467,6 +596,15 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             packet->hexlike();
         }
 
+        if (opcodeStart)
+        {
+            Microseconds opcodeTime = std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - *opcodeStart);
+            timeSpent += opcodeTime;
+            TC_METRIC_HANDLE_VALUE(opHandle->CostMetric, int64(opcodeTime.count()));
+            if (sFlightRecorder->IsEnabled())
+                sFlightRecorder->RecordOpcode(uint16(opcode), opcodeTime);
+        }
+
         if (deletePacket)
             delete packet;
 
@@ -474,15 +612,23 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
         processedPackets++;
 
-        //process only a max amout of packets in 1 Update() call.
+        // AntiDOS rejected the packet, stop processing
+        if (stopProcessing)
+            break;
+
+        //process only a max amout of packets (or packet time) in 1 Update() call.
         //Any leftover will be processed in next update
-        if (processedPackets > MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE)
+        if (timeBudget > 0us ? timeSpent >= timeBudget : processedPackets > MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE)
             break;
     }
 
-    TC_METRIC_VALUE("processed_packets", processedPackets);
+    static std::shared_ptr<MetricHandle> const processedPacketsMetric = sMetric->RegisterHandle(MetricHandleType::Counter, "processed_packets");
+    TC_METRIC_HANDLE_VALUE(processedPacketsMetric, int64(processedPackets));
+
+    _recvQueueFront.insert(_recvQueueFront.begin(), requeuePackets.begin(), requeuePackets.end());
 
-    _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
+    if (updater.ProcessPacketsOnly())
+        return true;
 
     if (!updater.ProcessUnsafe()) // <=> updater is of type MapSessionFilter
     {
@@ -505,6 +651,9 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
         if (m_Socket[CONNECTION_TYPE_REALM] && m_Socket[CONNECTION_TYPE_REALM]->IsOpen() && _warden)
             _warden->Update(diff);
 
+        // auction house data may only be accessed from world thread
+        _auctionBrowseCallbacks.ProcessReadyCallbacks();
+
         ///- If necessary, log the player out
         if (ShouldLogOut(currentTime) && m_playerLoading.IsEmpty())
             LogoutPlayer(true);
@@ -803,7 +952,11 @@ void WorldSession::Handle_EarlyProccess(WorldPackets::Null& null)
 void WorldSession::SendConnectToInstance(WorldPackets::Auth::ConnectToSerial serial)
 {
     boost::system::error_code ignored_error;
-    boost::asio::ip::address instanceAddress = realm.GetAddressForClient(Trinity::Net::make_address(GetRemoteAddress(), ignored_error));
+    boost::asio::ip::address instanceAddress;
+    if (!sWorld->GetInstanceServerAddress().empty())
+        instanceAddress = Trinity::Net::make_address(sWorld->GetInstanceServerAddress(), ignored_error);
+    else
+        instanceAddress = realm.GetAddressForClient(Trinity::Net::make_address(GetRemoteAddress(), ignored_error));
 
     _instanceConnectKey.Fields.AccountId = GetAccountId();
     _instanceConnectKey.Fields.ConnectionType = CONNECTION_TYPE_INSTANCE;
@@ -998,6 +1151,11 @@ SQLQueryHolderCallback& WorldSession::AddQueryHolderCallback(SQLQueryHolderCallb
     return _queryHolderProcessor.AddCallback(std::move(callback));
 }
 
+AuctionBrowseCallback& WorldSession::AddAuctionBrowseCallback(AuctionBrowseCallback&& callback)
+{
+    return _auctionBrowseCallbacks.AddCallback(std::move(callback));
+}
+
 bool WorldSession::CanAccessAlliedRaces() const
 {
     return GetAccountExpansion() >= EXPANSION_BATTLE_FOR_AZEROTH;
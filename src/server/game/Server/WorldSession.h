@@ -28,7 +28,7 @@
 #include "DatabaseEnvFwd.h"
 #include "Duration.h"
 #include "IteratorPair.h"
-#include "LockedQueue.h"
+#include "MPSCQueue.h"
 #include "ObjectGuid.h"
 #include "Opcodes.h"
 #include "Optional.h"
@@ -36,11 +36,14 @@
 #include "SharedDefines.h"
 #include <boost/circular_buffer_fwd.hpp>
 #include <array>
+#include <deque>
 #include <map>
 #include <memory>
 #include <unordered_map>
 
+class AuctionBrowseCallback;
 class BlackMarketEntry;
+class ClientOpcodeHandler;
 class CollectionMgr;
 class Creature;
 class InstanceLock;
@@ -48,6 +51,7 @@ class Item;
 class LoginQueryHolder;
 class MessageBuffer;
 class Player;
+class SharedWorldPacket;
 class Unit;
 class Warden;
 class WorldPacket;
@@ -89,6 +93,11 @@ namespace rbac
 class RBACData;
 }
 
+namespace Trinity
+{
+    struct DatabaseCoroutine;
+}
+
 namespace UF
 {
     struct ChrCustomizationChoice;
@@ -909,6 +918,8 @@ public:
 
     virtual bool Process(WorldPacket* /*packet*/) { return true; }
     virtual bool ProcessUnsafe() const { return true; }
+    // the update stops after handling packets, timers and callbacks are left to the next update with another filter
+    virtual bool ProcessPacketsOnly() const { return false; }
 
 protected:
     WorldSession* const m_pSession;
@@ -942,6 +953,19 @@ public:
     bool ProcessUnsafe() const override { return true; }
 };
 
+//process only character screen packets that touch nothing but the session itself
+//used for sessions without a player on several threads before World::UpdateSessions() updates them
+class CharacterScreenSessionFilter : public PacketFilter
+{
+public:
+    explicit CharacterScreenSessionFilter(WorldSession* pSession) : PacketFilter(pSession) { }
+    ~CharacterScreenSessionFilter() { }
+
+    bool Process(WorldPacket* packet) override;
+    bool ProcessUnsafe() const override { return false; }
+    bool ProcessPacketsOnly() const override { return true; }
+};
+
 struct PacketCounter
 {
     time_t lastReceiveTime;
@@ -958,6 +982,7 @@ class TC_GAME_API WorldSession
 
         bool PlayerLoading() const { return !m_playerLoading.IsEmpty(); }
         bool PlayerLogout() const { return m_playerLogout; }
+        bool IsOnCharacterScreen() const { return !_player && m_playerLoading.IsEmpty() && !m_playerLogout; }
         bool PlayerLogoutWithSave() const { return m_playerLogout && m_playerSave; }
         bool PlayerRecentlyLoggedOut() const { return m_playerRecentlyLogout; }
         bool PlayerDisconnected() const;
@@ -965,6 +990,7 @@ class TC_GAME_API WorldSession
         bool IsAddonRegistered(std::string_view prefix) const;
 
         void SendPacket(WorldPacket const* packet, bool forced = false);
+        void SendPacket(std::shared_ptr<SharedWorldPacket const> const& packet);
         void AddInstanceConnection(std::shared_ptr<WorldSocket> sock) { m_Socket[CONNECTION_TYPE_INSTANCE] = sock; }
 
         void SendNotification(char const* format, ...) ATTR_PRINTF(2, 3);
@@ -1039,6 +1065,10 @@ class TC_GAME_API WorldSession
         void QueuePacket(WorldPacket* new_packet);
         bool Update(uint32 diff, PacketFilter& updater);
 
+        /// PROCESS_QUERY packets deferred by Update(), handled outside of the world thread by World
+        bool HasQueryPackets() const { return !_queryPackets.empty(); }
+        void ProcessQueryPackets();
+
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQueue(uint32 position);
 
@@ -1173,6 +1203,8 @@ class TC_GAME_API WorldSession
         void LogUnprocessedTail(WorldPacket const* packet);
 
         void HandleCharEnum(CharacterDatabaseQueryHolder const& holder);
+        void PrefetchLoginData(ObjectGuid guid);
+        void DiscardLoginPrefetch() { _loginPrefetch.reset(); }
         void HandleCharEnumOpcode(WorldPackets::Character::EnumCharacters& /*enumCharacters*/);
         void HandleCharUndeleteEnumOpcode(WorldPackets::Character::EnumCharacters& /*enumCharacters*/);
         void HandleCharDeleteOpcode(WorldPackets::Character::CharDelete& charDelete);
@@ -1459,6 +1491,7 @@ class TC_GAME_API WorldSession
         void HandleBlackMarketBidOnItem(WorldPackets::BlackMarket::BlackMarketBidOnItem& blackMarketBidOnItem);
 
         void HandleGetMailList(WorldPackets::Mail::MailGetList& getList);
+        void SendMailList(ObjectGuid mailbox);
         void HandleSendMail(WorldPackets::Mail::SendMail& sendMail);
         void HandleMailTakeMoney(WorldPackets::Mail::MailTakeMoney& takeMoney);
         void HandleMailTakeItem(WorldPackets::Mail::MailTakeItem& takeItem);
@@ -1539,7 +1572,7 @@ class TC_GAME_API WorldSession
         void HandleChatMessage(ChatMsg type, Language lang, std::string msg, std::string target = "", Optional<ObjectGuid> channelGuid = {});
         void HandleChatAddonMessageOpcode(WorldPackets::Chat::ChatAddonMessage& chatAddonMessage);
         void HandleChatAddonMessageTargetedOpcode(WorldPackets::Chat::ChatAddonMessageTargeted& chatAddonMessageTargeted);
-        void HandleChatAddonMessage(ChatMsg type, std::string prefix, std::string text, bool isLogged, std::string target = "", Optional<ObjectGuid> channelGuid = {});
+        void HandleChatAddonMessage(ChatMsg type, std::string_view prefix, std::string_view text, bool isLogged, std::string_view target = {}, Optional<ObjectGuid> channelGuid = {});
         void HandleChatMessageAFKOpcode(WorldPackets::Chat::ChatMessageAFK& chatMessageAFK);
         void HandleChatMessageDNDOpcode(WorldPackets::Chat::ChatMessageDND& chatMessageDND);
         void HandleChatMessageEmoteOpcode(WorldPackets::Chat::ChatMessageEmote& chatMessageEmote);
@@ -1615,6 +1648,7 @@ class TC_GAME_API WorldSession
         void HandleSetTitleOpcode(WorldPackets::Character::SetTitle& packet);
         void HandleTimeSyncResponse(WorldPackets::Misc::TimeSyncResponse& timeSyncResponse);
         void HandleWhoIsOpcode(WorldPackets::Who::WhoIsRequest& packet);
+        Trinity::DatabaseCoroutine SendWhoIsResponse(QueryCallback query, std::string charName);
         void HandleResetInstancesOpcode(WorldPackets::Instance::ResetInstances& packet);
         void HandleInstanceLockResponse(WorldPackets::Instance::InstanceLockResponse& packet);
 
@@ -1694,6 +1728,8 @@ class TC_GAME_API WorldSession
         void HandleCalendarRemoveEvent(WorldPackets::Calendar::CalendarRemoveEvent& calendarRemoveEvent);
         void HandleCalendarCopyEvent(WorldPackets::Calendar::CalendarCopyEvent& calendarCopyEvent);
         void HandleCalendarInvite(WorldPackets::Calendar::CalendarInvite& calendarEventInvite);
+        Trinity::DatabaseCoroutine CalendarInviteIfNotIgnored(QueryCallback query, ObjectGuid inviteeGuid, ObjectGuid::LowType inviteeGuildId,
+            std::string inviteeName, uint64 eventId, bool creating, bool isSignUp);
         void HandleCalendarRsvp(WorldPackets::Calendar::CalendarRSVP& calendarRSVP);
         void HandleCalendarEventRemoveInvite(WorldPackets::Calendar::CalendarRemoveInvite& calendarRemoveInvite);
         void HandleCalendarStatus(WorldPackets::Calendar::CalendarStatus& calendarStatus);
@@ -1837,8 +1873,11 @@ class TC_GAME_API WorldSession
 
     public:
         QueryCallbackProcessor& GetQueryProcessor() { return _queryProcessor; }
+        AsyncCallbackProcessor<TransactionCallback>& GetTransactionProcessor() { return _transactionCallbacks; }
+        AsyncCallbackProcessor<SQLQueryHolderCallback>& GetQueryHolderProcessor() { return _queryHolderProcessor; }
         TransactionCallback& AddTransactionCallback(TransactionCallback&& callback);
         SQLQueryHolderCallback& AddQueryHolderCallback(SQLQueryHolderCallback&& callback);
+        AuctionBrowseCallback& AddAuctionBrowseCallback(AuctionBrowseCallback&& callback);
 
     private:
         void ProcessQueryCallbacks();
@@ -1846,6 +1885,7 @@ class TC_GAME_API WorldSession
         QueryCallbackProcessor _queryProcessor;
         AsyncCallbackProcessor<TransactionCallback> _transactionCallbacks;
         AsyncCallbackProcessor<SQLQueryHolderCallback> _queryHolderProcessor;
+        AsyncCallbackProcessor<AuctionBrowseCallback> _auctionBrowseCallbacks;
 
     friend class World;
     protected:
@@ -1886,6 +1926,9 @@ class TC_GAME_API WorldSession
         // logging helper
         void LogUnexpectedOpcode(WorldPacket* packet, char const* status, const char *reason);
 
+        // validates outgoing packet and selects connection it should be sent on
+        WorldSocket* GetSocketForPacket(WorldPacket const& packet, bool forced);
+
         // EnumData helpers
         bool IsLegitCharacterForAccount(ObjectGuid lowGUID)
         {
@@ -1921,6 +1964,17 @@ class TC_GAME_API WorldSession
         time_t _logoutTime;
         bool m_inQueue;                                     // session wait in auth.queue
         ObjectGuid m_playerLoading;                         // code processed in LoginPlayer
+
+        // login data of the last played character, loaded when the character list is sent
+        struct LoginPrefetch
+        {
+            std::shared_ptr<LoginQueryHolder> Holder;
+            TimePoint ExpireTime;
+            bool Loaded = false;
+            bool LoginPending = false;                      // HandleContinuePlayerLogin is waiting for Holder
+        };
+        std::unique_ptr<LoginPrefetch> _loginPrefetch;
+        bool _canPrefetchLogin;                             // only until the first login, saves of a logged out character could still be pending
         bool m_playerLogout;                                // code processed in LogoutPlayer
         bool m_playerRecentlyLogout;
         bool m_playerSave;
@@ -1934,7 +1988,12 @@ class TC_GAME_API WorldSession
         bool _filterAddonMessages;
         uint32 recruiterId;
         bool isRecruiter;
-        LockedQueue<WorldPacket*> _recvQueue;
+        // network threads push without locking, only one thread at a time updates the session and consumes packets
+        MPSCQueue<WorldPacket> _recvQueue;
+        std::deque<WorldPacket*> _recvQueueFront;   // packets put back by the consumer, processed before _recvQueue
+        bool NextRecvPacket(WorldPacket*& packet);
+        bool DeferQueryPacket(ClientOpcodeHandler const* opHandle, WorldPacket* packet);
+        std::vector<WorldPacket*> _queryPackets;
         rbac::RBACData* _RBACData;
         uint32 expireTime;
         bool forceExit;
@@ -1947,6 +2006,8 @@ class TC_GAME_API WorldSession
         uint32 _timeSyncNextCounter;
         uint32 _timeSyncTimer;
 
+        uint32 _lastFarMovementRelayTime;                   // last heartbeat of our mover sent to far away players
+
         // Packets cooldown
         time_t _calendarEventCreationCooldown;
 
@@ -21,11 +21,14 @@
 #include "CharacterPackets.h"
 #include "CryptoHash.h"
 #include "CryptoRandom.h"
+#include "CryptoWorkerPool.h"
 #include "DatabaseEnv.h"
 #include "Errors.h"
 #include "GameTime.h"
 #include "HMAC.h"
 #include "IPLocation.h"
+#include "Metric.h"
+#include "NetworkThread.h"
 #include "PacketLog.h"
 #include "RealmList.h"
 #include "RBAC.h"
@@ -53,6 +56,75 @@ std::string const WorldSocket::ServerConnectionInitialize("WORLD OF WARCRAFT CON
 std::string const WorldSocket::ClientConnectionInitialize("WORLD OF WARCRAFT CONNECTION - CLIENT TO SERVER - V2");
 uint32 const WorldSocket::MinSizeForCompression = 0x400;
 
+// empty stored block emitted by Z_FULL_FLUSH right after a Z_SYNC_FLUSH
+static constexpr uint32 FullFlushMarkerSize = 5;
+
+// Compression results per opcode, shared by all connections
+// Opcodes that repeatedly fail to shrink below Compression.SkipRatio are sent uncompressed for a while and then probed again
+class PacketCompressionStats
+{
+    static constexpr uint8 PoorResultsBeforeSkip = 8;
+    static constexpr int32 SkippedPackets = 256;
+
+public:
+    static PacketCompressionStats& Instance()
+    {
+        static PacketCompressionStats instance;
+        return instance;
+    }
+
+    bool ShouldCompress(uint16 opcode)
+    {
+        if (opcode >= NUM_OPCODE_HANDLERS || _skippedPackets[opcode].load(std::memory_order_relaxed) <= 0)
+            return true;
+
+        _skippedPackets[opcode].fetch_sub(1, std::memory_order_relaxed);
+        TC_METRIC_HANDLE_VALUE(_skippedMetric, 1);
+        return false;
+    }
+
+    void Record(uint16 opcode, uint32 uncompressedSize, uint32 compressedSize)
+    {
+        TC_METRIC_HANDLE_VALUE(_inputBytesMetric, int64(uncompressedSize));
+        TC_METRIC_HANDLE_VALUE(_outputBytesMetric, int64(compressedSize));
+
+        uint32 skipRatio = sWorld->getIntConfig(CONFIG_COMPRESSION_SKIP_RATIO);
+        if (!skipRatio || opcode >= NUM_OPCODE_HANDLERS)
+            return;
+
+        if (uint64(compressedSize) * 100 < uint64(uncompressedSize) * skipRatio)
+        {
+            _poorResults[opcode].store(0, std::memory_order_relaxed);
+            return;
+        }
+
+        if (_poorResults[opcode].fetch_add(1, std::memory_order_relaxed) + 1 >= PoorResultsBeforeSkip)
+        {
+            _poorResults[opcode].store(0, std::memory_order_relaxed);
+            _skippedPackets[opcode].store(SkippedPackets, std::memory_order_relaxed);
+        }
+    }
+
+    std::shared_ptr<MetricHandle> const& GetTimeMetric() const { return _timeMetric; }
+
+private:
+    PacketCompressionStats() :
+        _inputBytesMetric(sMetric->RegisterHandle(MetricHandleType::Counter, "packet_compression_input_bytes")),
+        _outputBytesMetric(sMetric->RegisterHandle(MetricHandleType::Counter, "packet_compression_output_bytes")),
+        _skippedMetric(sMetric->RegisterHandle(MetricHandleType::Counter, "packet_compression_skipped")),
+        _timeMetric(sMetric->RegisterHandle(MetricHandleType::Histogram, "packet_compression_time"))
+    {
+    }
+
+    std::array<std::atomic<uint8>, NUM_OPCODE_HANDLERS> _poorResults = { };
+    std::array<std::atomic<int32>, NUM_OPCODE_HANDLERS> _skippedPackets = { };
+
+    std::shared_ptr<MetricHandle> _inputBytesMetric;
+    std::shared_ptr<MetricHandle> _outputBytesMetric;
+    std::shared_ptr<MetricHandle> _skippedMetric;
+    std::shared_ptr<MetricHandle> _timeMetric;
+};
+
 uint8 const WorldSocket::AuthCheckSeed[16] = { 0xC5, 0xC6, 0x98, 0x95, 0x76, 0x3F, 0x1D, 0xCD, 0xB6, 0xA1, 0x37, 0x28, 0xB3, 0x12, 0xFF, 0x8A };
 uint8 const WorldSocket::SessionKeySeed[16] = { 0x58, 0xCB, 0xCF, 0x40, 0xFE, 0x2E, 0xCE, 0xA6, 0x5A, 0x90, 0xB8, 0x01, 0x68, 0x6C, 0x28, 0x0B };
 uint8 const WorldSocket::ContinuedSessionSeed[16] = { 0x16, 0xAD, 0x0C, 0xD4, 0x46, 0xF9, 0x4F, 0xB2, 0xEF, 0x7D, 0xEA, 0x2A, 0x17, 0x66, 0x4D, 0x2F };
@@ -60,7 +132,8 @@ uint8 const WorldSocket::EncryptionKeySeed[16] = { 0xE9, 0x75, 0x3C, 0x50, 0x90,
 
 WorldSocket::WorldSocket(tcp::socket&& socket) : Socket(std::move(socket)),
     _type(CONNECTION_TYPE_REALM), _key(0), _OverSpeedPings(0),
-    _worldSession(nullptr), _authed(false), _canRequestHotfixes(true), _sendBufferSize(4096), _compressionStream(nullptr)
+    _worldSession(nullptr), _accountId(0), _authed(false), _canRequestHotfixes(true), _sendBufferSize(4096), _networkThread(nullptr),
+    _compressionStream(nullptr), _compressionLevel(0), _compressionNeedsFullFlush(false)
 {
     Trinity::Crypto::GetRandomBytes(_serverChallenge);
     _sessionKey.fill(0);
@@ -129,15 +202,13 @@ void WorldSocket::InitializeHandler(boost::system::error_code error, std::size_t
 
     GetReadBuffer().WriteCompleted(transferedBytes);
 
-    MessageBuffer& packet = GetReadBuffer();
+    MessageRingBuffer& packet = GetReadBuffer();
     if (packet.GetActiveSize() > 0)
     {
         if (_packetBuffer.GetRemainingSpace() > 0)
         {
             // need to receive the header
-            std::size_t readHeaderSize = std::min(packet.GetActiveSize(), _packetBuffer.GetRemainingSpace());
-            _packetBuffer.Write(packet.GetReadPointer(), readHeaderSize);
-            packet.ReadCompleted(readHeaderSize);
+            _packetBuffer.WriteCompleted(packet.Read(_packetBuffer.GetWritePointer(), _packetBuffer.GetRemainingSpace()));
 
             if (_packetBuffer.GetRemainingSpace() > 0)
             {
@@ -179,7 +250,8 @@ void WorldSocket::InitializeHandler(boost::system::error_code error, std::size_t
             _compressionStream->opaque = (voidpf)nullptr;
             _compressionStream->avail_in = 0;
             _compressionStream->next_in = nullptr;
-            int32 z_res = deflateInit2(_compressionStream, sWorld->getIntConfig(CONFIG_COMPRESSION), Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+            _compressionLevel = sWorld->getIntConfig(CONFIG_COMPRESSION);
+            int32 z_res = deflateInit2(_compressionStream, _compressionLevel, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
             if (z_res != Z_OK)
             {
                 CloseSocket();
@@ -200,39 +272,45 @@ void WorldSocket::InitializeHandler(boost::system::error_code error, std::size_t
 bool WorldSocket::Update()
 {
     EncryptablePacket* queued;
-    MessageBuffer buffer(_sendBufferSize);
-    while (_bufferQueue.Dequeue(queued))
+    if (_bufferQueue.Dequeue(queued))
     {
-        uint32 packetSize = queued->size() + 2 /*opcode*/;
-        if (packetSize > MinSizeForCompression && queued->NeedsEncryption())
-            packetSize = deflateBound(_compressionStream, packetSize) + sizeof(CompressedWorldPacket);
+        UpdateCompressionLevel();
 
-        // Flush current buffer if too small for next packet
-        if (buffer.GetRemainingSpace() < packetSize + sizeof(PacketHeader))
+        MessageBuffer buffer = AcquireSendBuffer(_sendBufferSize);
+        do
         {
-            QueuePacket(std::move(buffer));
-            buffer.Resize(_sendBufferSize);
-        }
+            uint32 packetSize = GetPacketBufferSize(*queued);
 
-        if (buffer.GetRemainingSpace() >= packetSize + sizeof(PacketHeader))
-            WritePacketToBuffer(*queued, buffer);
-        else    // single packet larger than _sendBufferSize
-        {
-            MessageBuffer packetBuffer(packetSize + sizeof(PacketHeader));
-            WritePacketToBuffer(*queued, packetBuffer);
-            QueuePacket(std::move(packetBuffer));
-        }
+            // Flush current buffer if too small for next packet
+            if (buffer.GetRemainingSpace() < packetSize + sizeof(PacketHeader))
+            {
+                QueueEncryptedBuffer(std::move(buffer));
+                buffer = AcquireSendBuffer(_sendBufferSize);
+            }
 
-        delete queued;
-    }
+            if (buffer.GetRemainingSpace() >= packetSize + sizeof(PacketHeader))
+                WritePacketToBuffer(*queued, buffer);
+            else    // single packet larger than _sendBufferSize
+            {
+                MessageBuffer packetBuffer = AcquireSendBuffer(packetSize + sizeof(PacketHeader));
+                WritePacketToBuffer(*queued, packetBuffer);
+                QueueEncryptedBuffer(std::move(packetBuffer));
+            }
 
-    if (buffer.GetActiveSize() > 0)
-        QueuePacket(std::move(buffer));
+            delete queued;
+        } while (_bufferQueue.Dequeue(queued));
+
+        if (buffer.GetActiveSize() > 0)
+            QueueEncryptedBuffer(std::move(buffer));
+        else
+            ReleaseSendBuffer(std::move(buffer));
+    }
 
     if (!BaseSocket::Update())
         return false;
 
     _queryProcessor.ProcessReadyCallbacks();
+    _cryptoProcessor.ProcessReadyCallbacks();
 
     return true;
 }
@@ -260,15 +338,13 @@ void WorldSocket::ReadHandler()
     if (!IsOpen())
         return;
 
-    MessageBuffer& packet = GetReadBuffer();
+    MessageRingBuffer& packet = GetReadBuffer();
     while (packet.GetActiveSize() > 0)
     {
         if (_headerBuffer.GetRemainingSpace() > 0)
         {
-            // need to receive the header
-            std::size_t readHeaderSize = std::min(packet.GetActiveSize(), _headerBuffer.GetRemainingSpace());
-            _headerBuffer.Write(packet.GetReadPointer(), readHeaderSize);
-            packet.ReadCompleted(readHeaderSize);
+            // need to receive the header, it may wrap around the end of the read buffer
+            _headerBuffer.WriteCompleted(packet.Read(_headerBuffer.GetWritePointer(), _headerBuffer.GetRemainingSpace()));
 
             if (_headerBuffer.GetRemainingSpace() > 0)
             {
@@ -289,9 +365,7 @@ void WorldSocket::ReadHandler()
         if (_packetBuffer.GetRemainingSpace() > 0)
         {
             // need more data in the payload
-            std::size_t readDataSize = std::min(packet.GetActiveSize(), _packetBuffer.GetRemainingSpace());
-            _packetBuffer.Write(packet.GetReadPointer(), readDataSize);
-            packet.ReadCompleted(readDataSize);
+            _packetBuffer.WriteCompleted(packet.Read(_packetBuffer.GetWritePointer(), _packetBuffer.GetRemainingSpace()));
 
             if (_packetBuffer.GetRemainingSpace() > 0)
             {
@@ -320,6 +394,7 @@ void WorldSocket::SetWorldSession(WorldSession* session)
 {
     std::lock_guard<std::mutex> sessionGuard(_worldSessionLock);
     _worldSession = session;
+    _accountId = session->GetAccountId();
     _authed = true;
 }
 
@@ -371,7 +446,7 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     packet.SetOpcode(opcode);
 
     if (sPacketLog->CanLogPacket())
-        sPacketLog->LogPacket(packet, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType());
+        sPacketLog->LogPacket(packet, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType(), _accountId);
 
     std::unique_lock<std::mutex> sessionGuard(_worldSessionLock, std::defer_lock);
 
@@ -528,13 +603,47 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
         return;
 
     if (sPacketLog->CanLogPacket())
-        sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType());
+        sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType(), _accountId);
 
     _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
 }
 
+void WorldSocket::SendPacket(std::shared_ptr<SharedWorldPacket const> packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(packet->GetPacket(), SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType(), _accountId);
+
+    _bufferQueue.Enqueue(new EncryptablePacket(std::move(packet), _authCrypt.IsInitialized()));
+}
+
+uint32 WorldSocket::GetPacketBufferSize(EncryptablePacket const& packet) const
+{
+    if (SharedWorldPacket const* shared = packet.GetShared())
+    {
+        if (shared->IsCompressed() && packet.NeedsEncryption())
+            return shared->GetCompressedData().size() + 2 /*opcode*/;
+
+        return shared->GetPacket().size() + 2 /*opcode*/;
+    }
+
+    uint32 packetSize = packet.size() + 2 /*opcode*/;
+    if (packetSize > MinSizeForCompression && packet.NeedsEncryption())
+        packetSize = deflateBound(_compressionStream, packetSize) + sizeof(CompressedWorldPacket) + FullFlushMarkerSize;
+
+    return packetSize;
+}
+
 void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer)
 {
+    if (packet.GetShared())
+    {
+        WriteSharedPacketToBuffer(packet, buffer);
+        return;
+    }
+
     uint16 opcode = packet.GetOpcode();
     uint32 packetSize = packet.size();
 
@@ -544,8 +653,10 @@ void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBu
     uint8* dataPos = buffer.GetWritePointer();
     buffer.WriteCompleted(sizeof(opcode));
 
-    if (packetSize > MinSizeForCompression && packet.NeedsEncryption())
+    if (packetSize > MinSizeForCompression && packet.NeedsEncryption() && PacketCompressionStats::Instance().ShouldCompress(opcode))
     {
+        TC_METRIC_HANDLE_TIMER(PacketCompressionStats::Instance().GetTimeMetric());
+
         CompressedWorldPacket cmp;
         cmp.UncompressedSize = packetSize + 2;
         cmp.UncompressedAdler = adler32(adler32(0x9827D8F1, (Bytef*)&opcode, 2), packet.contents(), packetSize);
@@ -560,6 +671,7 @@ void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBu
 
         memcpy(compressionInfo, &cmp, sizeof(CompressedWorldPacket));
         buffer.WriteCompleted(compressedSize);
+        PacketCompressionStats::Instance().Record(opcode, packetSize + 2, compressedSize);
         packetSize = compressedSize + sizeof(CompressedWorldPacket);
 
         opcode = SMSG_COMPRESSED_PACKET;
@@ -570,24 +682,112 @@ void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBu
     memcpy(dataPos, &opcode, sizeof(opcode));
     packetSize += 2 /*opcode*/;
 
-    PacketHeader header;
-    header.Size = packetSize;
-    _authCrypt.EncryptSend(dataPos, header.Size, header.Tag);
+    // tag is filled by QueueEncryptedBuffer
+    memcpy(headerPos, &packetSize, sizeof(PacketHeader::Size));
+    _pendingEncryption.push_back({ dataPos, packetSize, headerPos + offsetof(PacketHeader, Tag) });
+}
+
+void WorldSocket::WriteSharedPacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer)
+{
+    SharedWorldPacket const* shared = packet.GetShared();
+    uint16 opcode = shared->GetPacket().GetOpcode();
 
-    memcpy(headerPos, &header, sizeof(PacketHeader));
+    // Reserve space for buffer
+    uint8* headerPos = buffer.GetWritePointer();
+    buffer.WriteCompleted(sizeof(PacketHeader));
+    uint8* dataPos = buffer.GetWritePointer();
+    buffer.WriteCompleted(sizeof(opcode));
+
+    uint32 packetSize;
+    if (shared->IsCompressed() && packet.NeedsEncryption())
+    {
+        // client inflates this as a continuation of our own stream, data compressed after it must not refer to anything before
+        _compressionNeedsFullFlush = true;
+
+        buffer.Write(shared->GetCompressedData().data(), shared->GetCompressedData().size());
+        packetSize = shared->GetCompressedData().size();
+        opcode = SMSG_COMPRESSED_PACKET;
+    }
+    else
+    {
+        buffer.Write(shared->GetPacket().contents(), shared->GetPacket().size());
+        packetSize = shared->GetPacket().size();
+    }
+
+    memcpy(dataPos, &opcode, sizeof(opcode));
+    packetSize += 2 /*opcode*/;
+
+    // tag is filled by QueueEncryptedBuffer
+    memcpy(headerPos, &packetSize, sizeof(PacketHeader::Size));
+    _pendingEncryption.push_back({ dataPos, packetSize, headerPos + offsetof(PacketHeader, Tag) });
+}
+
+void WorldSocket::UpdateCompressionLevel()
+{
+    if (!_compressionStream)
+        return;
+
+    int32 level = sWorld->getIntConfig(CONFIG_COMPRESSION);
+    uint32 busyThreshold = sWorld->getIntConfig(CONFIG_COMPRESSION_BUSY_THRESHOLD);
+    if (busyThreshold && _networkThread && _networkThread->GetBusyPercent() >= busyThreshold)
+        level = Z_BEST_SPEED;
+
+    if (level == _compressionLevel)
+        return;
+
+    // every packet ends with a sync flush so there is no pending output, give deflateParams a scratch buffer instead of a dangling pointer
+    std::array<uint8, 16> scratch;
+    _compressionStream->next_in = nullptr;
+    _compressionStream->avail_in = 0;
+    _compressionStream->next_out = scratch.data();
+    _compressionStream->avail_out = scratch.size();
+
+    int32 z_res = deflateParams(_compressionStream, level, Z_DEFAULT_STRATEGY);
+    if (z_res != Z_OK || _compressionStream->avail_out != scratch.size())
+    {
+        TC_LOG_ERROR("network", "Can't change packet compression level to {} (zlib: deflateParams) Error code: {} ({})", level, z_res, zError(z_res));
+        return;
+    }
+
+    _compressionLevel = level;
+}
+
+void WorldSocket::QueueEncryptedBuffer(MessageBuffer&& buffer)
+{
+    _authCrypt.EncryptSend(_pendingEncryption);
+    _pendingEncryption.clear();
+
+    QueuePacket(std::move(buffer));
 }
 
 uint32 WorldSocket::CompressPacket(uint8* buffer, WorldPacket const& packet)
 {
     uint32 opcode = packet.GetOpcode();
-    uint32 bufferSize = deflateBound(_compressionStream, packet.size() + sizeof(uint16));
+    uint32 bufferSize = deflateBound(_compressionStream, packet.size() + sizeof(uint16)) + FullFlushMarkerSize;
 
     _compressionStream->next_out = buffer;
     _compressionStream->avail_out = bufferSize;
+
+    int32 z_res;
+    if (_compressionNeedsFullFlush)
+    {
+        _compressionStream->next_in = nullptr;
+        _compressionStream->avail_in = 0;
+
+        z_res = deflate(_compressionStream, Z_FULL_FLUSH);
+        if (z_res != Z_OK)
+        {
+            TC_LOG_ERROR("network", "Can't reset packet compression history (zlib: deflate) Error code: {} ({}, msg: {})", z_res, zError(z_res), _compressionStream->msg);
+            return 0;
+        }
+
+        _compressionNeedsFullFlush = false;
+    }
+
     _compressionStream->next_in = (Bytef*)&opcode;
     _compressionStream->avail_in = sizeof(uint16);
 
-    int32 z_res = deflate(_compressionStream, Z_NO_FLUSH);
+    z_res = deflate(_compressionStream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         TC_LOG_ERROR("network", "Can't compress packet opcode (zlib: deflate) Error code: {} ({}, msg: {})", z_res, zError(z_res), _compressionStream->msg);
@@ -607,6 +807,76 @@ uint32 WorldSocket::CompressPacket(uint8* buffer, WorldPacket const& packet)
     return bufferSize - _compressionStream->avail_out;
 }
 
+namespace
+{
+// Raw deflate stream reset before every shared packet, the output never refers to data outside of that packet
+struct SharedPacketCompressor
+{
+    SharedPacketCompressor() : Stream(), Initialized(false)
+    {
+        Initialized = deflateInit2(&Stream, sWorld->getIntConfig(CONFIG_COMPRESSION), Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+    }
+
+    ~SharedPacketCompressor()
+    {
+        if (Initialized)
+            deflateEnd(&Stream);
+    }
+
+    SharedPacketCompressor(SharedPacketCompressor const&) = delete;
+    SharedPacketCompressor& operator=(SharedPacketCompressor const&) = delete;
+
+    z_stream Stream;
+    bool Initialized;
+};
+}
+
+SharedWorldPacket::SharedWorldPacket(WorldPacket const& packet) : _packet(packet)
+{
+    if (_packet.size() + 2 /*opcode*/ <= WorldSocket::MinSizeForCompression)
+        return;
+
+    // packets are shared by the thread that builds them (map updates), every thread gets its own stream
+    thread_local SharedPacketCompressor compressor;
+    if (!compressor.Initialized || deflateReset(&compressor.Stream) != Z_OK)
+        return; // sockets will compress it themselves
+
+    z_stream* stream = &compressor.Stream;
+    uint32 opcode = _packet.GetOpcode();
+    uint32 bufferSize = deflateBound(stream, _packet.size() + sizeof(uint16));
+
+    _compressed.resize(sizeof(CompressedWorldPacket) + bufferSize);
+    stream->next_out = _compressed.data() + sizeof(CompressedWorldPacket);
+    stream->avail_out = bufferSize;
+    stream->next_in = (Bytef*)&opcode;
+    stream->avail_in = sizeof(uint16);
+
+    if (deflate(stream, Z_NO_FLUSH) != Z_OK)
+    {
+        _compressed.clear();
+        return;
+    }
+
+    stream->next_in = (Bytef*)_packet.contents();
+    stream->avail_in = _packet.size();
+
+    if (deflate(stream, Z_SYNC_FLUSH) != Z_OK)
+    {
+        _compressed.clear();
+        return;
+    }
+
+    uint32 compressedSize = bufferSize - stream->avail_out;
+
+    CompressedWorldPacket cmp;
+    cmp.UncompressedSize = _packet.size() + 2;
+    cmp.UncompressedAdler = adler32(adler32(0x9827D8F1, (Bytef*)&opcode, 2), _packet.contents(), _packet.size());
+    cmp.CompressedAdler = adler32(0x9827D8F1, _compressed.data() + sizeof(CompressedWorldPacket), compressedSize);
+    memcpy(_compressed.data(), &cmp, sizeof(CompressedWorldPacket));
+
+    _compressed.resize(sizeof(CompressedWorldPacket) + compressedSize);
+}
+
 struct AccountInfo
 {
     struct
@@ -665,6 +935,26 @@ struct AccountInfo
     }
 };
 
+struct AuthSessionKeys
+{
+    SessionKey Key;
+    std::array<uint8, 16> EncryptKey;
+};
+
+std::array<uint8, 16> WorldSocket::GenerateEncryptKey(SessionKey const& sessionKey, std::array<uint8, 16> const& localChallenge, std::array<uint8, 16> const& serverChallenge)
+{
+    Trinity::Crypto::HMAC_SHA256 encryptKeyGen(sessionKey);
+    encryptKeyGen.UpdateData(localChallenge);
+    encryptKeyGen.UpdateData(serverChallenge);
+    encryptKeyGen.UpdateData(EncryptionKeySeed, 16);
+    encryptKeyGen.Finalize();
+
+    // only first 16 bytes of the hmac are used
+    std::array<uint8, 16> encryptKey;
+    memcpy(encryptKey.data(), encryptKeyGen.GetDigest().data(), 16);
+    return encryptKey;
+}
+
 void WorldSocket::HandleAuthSession(std::shared_ptr<WorldPackets::Auth::AuthSession> authSession)
 {
     // Get the account information from the auth database
@@ -695,55 +985,83 @@ void WorldSocket::HandleAuthSessionCallback(std::shared_ptr<WorldPackets::Auth::
         return;
     }
 
-    AccountInfo account(result->Fetch());
-
-    // For hook purposes, we get Remoteaddress at this point.
-    std::string address = GetRemoteIpAddress().to_string();
-
-    Trinity::Crypto::SHA256 digestKeyHash;
-    digestKeyHash.UpdateData(account.Game.KeyData.data(), account.Game.KeyData.size());
-    if (account.Game.OS == "Wn64")
-        digestKeyHash.UpdateData(buildInfo->Win64AuthSeed.data(), buildInfo->Win64AuthSeed.size());
-    else if (account.Game.OS == "Mc64")
-        digestKeyHash.UpdateData(buildInfo->Mac64AuthSeed.data(), buildInfo->Mac64AuthSeed.size());
+    std::shared_ptr<AccountInfo> account = std::make_shared<AccountInfo>(result->Fetch());
 
-    digestKeyHash.Finalize();
+    std::array<uint8, 16> authSeed = { };
+    bool hasAuthSeed = true;
+    if (account->Game.OS == "Wn64")
+        authSeed = buildInfo->Win64AuthSeed;
+    else if (account->Game.OS == "Mc64")
+        authSeed = buildInfo->Mac64AuthSeed;
+    else
+        hasAuthSeed = false;
 
-    Trinity::Crypto::HMAC_SHA256 hmac(digestKeyHash.GetDigest());
-    hmac.UpdateData(authSession->LocalChallenge);
-    hmac.UpdateData(_serverChallenge);
-    hmac.UpdateData(AuthCheckSeed, 16);
-    hmac.Finalize();
+    Optional<Trinity::Crypto::CryptoCallback> keysCallback = sCryptoWorkerPool.Post(GetRemoteIpAddress().to_string(),
+        [keyData = account->Game.KeyData, authSeed, hasAuthSeed, localChallenge = authSession->LocalChallenge, digest = authSession->Digest, serverChallenge = _serverChallenge]() -> Optional<AuthSessionKeys>
+    {
+        Trinity::Crypto::SHA256 digestKeyHash;
+        digestKeyHash.UpdateData(keyData.data(), keyData.size());
+        if (hasAuthSeed)
+            digestKeyHash.UpdateData(authSeed.data(), authSeed.size());
+
+        digestKeyHash.Finalize();
+
+        Trinity::Crypto::HMAC_SHA256 hmac(digestKeyHash.GetDigest());
+        hmac.UpdateData(localChallenge);
+        hmac.UpdateData(serverChallenge);
+        hmac.UpdateData(AuthCheckSeed, 16);
+        hmac.Finalize();
+
+        // Check that Key and account name are the same on client and server
+        if (memcmp(hmac.GetDigest().data(), digest.data(), digest.size()) != 0)
+            return {};
+
+        Trinity::Crypto::SHA256 keyDataHash;
+        keyDataHash.UpdateData(keyData.data(), keyData.size());
+        keyDataHash.Finalize();
+
+        Trinity::Crypto::HMAC_SHA256 sessionKeyHmac(keyDataHash.GetDigest());
+        sessionKeyHmac.UpdateData(serverChallenge);
+        sessionKeyHmac.UpdateData(localChallenge);
+        sessionKeyHmac.UpdateData(SessionKeySeed, 16);
+        sessionKeyHmac.Finalize();
+
+        AuthSessionKeys keys;
+        SessionKeyGenerator<Trinity::Crypto::SHA256> sessionKeyGenerator(sessionKeyHmac.GetDigest());
+        sessionKeyGenerator.Generate(keys.Key.data(), 40);
+        keys.EncryptKey = GenerateEncryptKey(keys.Key, localChallenge, serverChallenge);
+        return keys;
+    },
+        [this, authSession, account](Optional<AuthSessionKeys> keys)
+    {
+        HandleAuthSessionKeys(authSession, *account, keys);
+    });
 
-    // Check that Key and account name are the same on client and server
-    if (memcmp(hmac.GetDigest().data(), authSession->Digest.data(), authSession->Digest.size()) != 0)
+    if (!keysCallback)
     {
-        TC_LOG_ERROR("network", "WorldSocket::HandleAuthSession: Authentication failed for account: {} ('{}') address: {}", account.Game.Id, authSession->RealmJoinTicket, address);
+        TC_LOG_ERROR("network", "WorldSocket::HandleAuthSession: Too many pending authentication requests, denying client ({}).", GetRemoteIpAddress().to_string());
+        SendAuthResponseError(ERROR_DENIED);
         DelayedCloseSocket();
         return;
     }
 
-    Trinity::Crypto::SHA256 keyData;
-    keyData.UpdateData(account.Game.KeyData.data(), account.Game.KeyData.size());
-    keyData.Finalize();
-
-    Trinity::Crypto::HMAC_SHA256 sessionKeyHmac(keyData.GetDigest());
-    sessionKeyHmac.UpdateData(_serverChallenge);
-    sessionKeyHmac.UpdateData(authSession->LocalChallenge);
-    sessionKeyHmac.UpdateData(SessionKeySeed, 16);
-    sessionKeyHmac.Finalize();
+    _cryptoProcessor.AddCallback(std::move(*keysCallback));
+}
 
-    SessionKeyGenerator<Trinity::Crypto::SHA256> sessionKeyGenerator(sessionKeyHmac.GetDigest());
-    sessionKeyGenerator.Generate(_sessionKey.data(), 40);
+void WorldSocket::HandleAuthSessionKeys(std::shared_ptr<WorldPackets::Auth::AuthSession> authSession, AccountInfo const& account, Optional<AuthSessionKeys> const& keys)
+{
+    // For hook purposes, we get Remoteaddress at this point.
+    std::string address = GetRemoteIpAddress().to_string();
 
-    Trinity::Crypto::HMAC_SHA256 encryptKeyGen(_sessionKey);
-    encryptKeyGen.UpdateData(authSession->LocalChallenge);
-    encryptKeyGen.UpdateData(_serverChallenge);
-    encryptKeyGen.UpdateData(EncryptionKeySeed, 16);
-    encryptKeyGen.Finalize();
+    if (!keys)
+    {
+        TC_LOG_ERROR("network", "WorldSocket::HandleAuthSession: Authentication failed for account: {} ('{}') address: {}", account.Game.Id, authSession->RealmJoinTicket, address);
+        DelayedCloseSocket();
+        return;
+    }
 
-    // only first 16 bytes of the hmac are used
-    memcpy(_encryptKey.data(), encryptKeyGen.GetDigest().data(), 16);
+    _sessionKey = keys->Key;
+    _encryptKey = keys->EncryptKey;
 
     LoginDatabasePreparedStatement* stmt = nullptr;
 
@@ -869,6 +1187,7 @@ void WorldSocket::HandleAuthSessionCallback(std::shared_ptr<WorldPackets::Auth::
     sScriptMgr->OnAccountLogin(account.Game.Id);
 
     _authed = true;
+    _accountId = account.Game.Id;
     _worldSession = new WorldSession(account.Game.Id, std::move(authSession->RealmJoinTicket), account.BattleNet.Id, shared_from_this(), account.Game.Security,
         account.Game.Expansion, mutetime, account.Game.OS, account.BattleNet.Locale, account.Game.Recruiter, account.Game.IsRectuiter);
 
@@ -925,31 +1244,44 @@ void WorldSocket::HandleAuthContinuedSessionCallback(std::shared_ptr<WorldPacket
     std::string login = fields[0].GetString();
     _sessionKey = fields[1].GetBinary<SESSION_KEY_LENGTH>();
 
-    Trinity::Crypto::HMAC_SHA256 hmac(_sessionKey);
-    hmac.UpdateData(reinterpret_cast<uint8 const*>(&authSession->Key), sizeof(authSession->Key));
-    hmac.UpdateData(authSession->LocalChallenge);
-    hmac.UpdateData(_serverChallenge);
-    hmac.UpdateData(ContinuedSessionSeed, 16);
-    hmac.Finalize();
+    Optional<Trinity::Crypto::CryptoCallback> keysCallback = sCryptoWorkerPool.Post(GetRemoteIpAddress().to_string(),
+        [sessionKey = _sessionKey, key = authSession->Key, localChallenge = authSession->LocalChallenge, digest = authSession->Digest, serverChallenge = _serverChallenge]() -> Optional<std::array<uint8, 16>>
+    {
+        Trinity::Crypto::HMAC_SHA256 hmac(sessionKey);
+        hmac.UpdateData(reinterpret_cast<uint8 const*>(&key), sizeof(key));
+        hmac.UpdateData(localChallenge);
+        hmac.UpdateData(serverChallenge);
+        hmac.UpdateData(ContinuedSessionSeed, 16);
+        hmac.Finalize();
+
+        if (memcmp(hmac.GetDigest().data(), digest.data(), digest.size()))
+            return {};
+
+        return GenerateEncryptKey(sessionKey, localChallenge, serverChallenge);
+    },
+        [this, accountId, login](Optional<std::array<uint8, 16>> encryptKey)
+    {
+        if (!encryptKey)
+        {
+            TC_LOG_ERROR("network", "WorldSocket::HandleAuthContinuedSession: Authentication failed for account: {} ('{}') address: {}", accountId, login, GetRemoteIpAddress().to_string());
+            DelayedCloseSocket();
+            return;
+        }
+
+        _encryptKey = *encryptKey;
+        SendPacketAndLogOpcode(*WorldPackets::Auth::EnterEncryptedMode(_encryptKey, true).Write());
+        AsyncRead();
+    });
 
-    if (memcmp(hmac.GetDigest().data(), authSession->Digest.data(), authSession->Digest.size()))
+    if (!keysCallback)
     {
-        TC_LOG_ERROR("network", "WorldSocket::HandleAuthContinuedSession: Authentication failed for account: {} ('{}') address: {}", accountId, login, GetRemoteIpAddress().to_string());
+        TC_LOG_ERROR("network", "WorldSocket::HandleAuthContinuedSession: Too many pending authentication requests, denying client ({}).", GetRemoteIpAddress().to_string());
+        SendAuthResponseError(ERROR_DENIED);
         DelayedCloseSocket();
         return;
     }
 
-    Trinity::Crypto::HMAC_SHA256 encryptKeyGen(_sessionKey);
-    encryptKeyGen.UpdateData(authSession->LocalChallenge);
-    encryptKeyGen.UpdateData(_serverChallenge);
-    encryptKeyGen.UpdateData(EncryptionKeySeed, 16);
-    encryptKeyGen.Finalize();
-
-    // only first 16 bytes of the hmac are used
-    memcpy(_encryptKey.data(), encryptKeyGen.GetDigest().data(), 16);
-
-    SendPacketAndLogOpcode(*WorldPackets::Auth::EnterEncryptedMode(_encryptKey, true).Write());
-    AsyncRead();
+    _cryptoProcessor.AddCallback(std::move(*keysCallback));
 }
 
 void WorldSocket::HandleConnectToFailed(WorldPackets::Auth::ConnectToFailed& connectToFailed)
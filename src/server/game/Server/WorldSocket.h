@@ -20,23 +20,50 @@
 
 #include "AsyncCallbackProcessor.h"
 #include "AuthDefines.h"
+#include "CryptoWorkerPool.h"
 #include "DatabaseEnvFwd.h"
 #include "MessageBuffer.h"
+#include "MessageRingBuffer.h"
 #include "Socket.h"
 #include "WorldPacket.h"
 #include "WorldPacketCrypt.h"
 #include "MPSCQueue.h"
 #include <array>
 #include <boost/asio/ip/tcp.hpp>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 typedef struct z_stream_s z_stream;
 class EncryptablePacket;
 class WorldPacket;
 class WorldSession;
+struct AccountInfo;
+template<class SocketType>
+class NetworkThread;
+struct AuthSessionKeys;
 enum ConnectionType : int8;
 enum OpcodeClient : uint16;
 
+/// Immutable packet serialized once and queued to many sockets without copying its contents
+/// Large packets are compressed as self contained deflate blocks that can be spliced into any connection's stream
+class TC_GAME_API SharedWorldPacket
+{
+public:
+    explicit SharedWorldPacket(WorldPacket const& packet);
+
+    WorldPacket const& GetPacket() const { return _packet; }
+
+    bool IsCompressed() const { return !_compressed.empty(); }
+
+    /// CompressedWorldPacket header followed by compressed opcode and packet contents
+    std::vector<uint8> const& GetCompressedData() const { return _compressed; }
+
+private:
+    WorldPacket _packet;
+    std::vector<uint8> _compressed;
+};
+
 class EncryptablePacket : public WorldPacket
 {
 public:
@@ -45,12 +72,22 @@ public:
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    EncryptablePacket(std::shared_ptr<SharedWorldPacket const> packet, bool encrypt)
+        : WorldPacket(packet->GetPacket().GetOpcode(), packet->GetPacket().GetConnection()), _encrypt(encrypt), _shared(std::move(packet))
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
     bool NeedsEncryption() const { return _encrypt; }
 
+    /// Contents of this packet are empty when it refers to a shared one
+    SharedWorldPacket const* GetShared() const { return _shared.get(); }
+
     std::atomic<EncryptablePacket*> SocketQueueLink;
 
 private:
     bool _encrypt;
+    std::shared_ptr<SharedWorldPacket const> _shared;
 };
 
 namespace WorldPackets
@@ -82,7 +119,7 @@ struct IncomingPacketHeader : PacketHeader
 
 #pragma pack(pop)
 
-class TC_GAME_API WorldSocket : public Socket<WorldSocket>
+class TC_GAME_API WorldSocket : public Socket<WorldSocket, tcp::socket, MessageRingBuffer>
 {
     static std::string const ServerConnectionInitialize;
     static std::string const ClientConnectionInitialize;
@@ -93,7 +130,9 @@ class TC_GAME_API WorldSocket : public Socket<WorldSocket>
     static uint8 const ContinuedSessionSeed[16];
     static uint8 const EncryptionKeySeed[16];
 
-    typedef Socket<WorldSocket> BaseSocket;
+    typedef Socket<WorldSocket, tcp::socket, MessageRingBuffer> BaseSocket;
+
+    friend class SharedWorldPacket;
 
 public:
     WorldSocket(boost::asio::ip::tcp::socket&& socket);
@@ -106,12 +145,14 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(std::shared_ptr<SharedWorldPacket const> packet);
 
     ConnectionType GetConnectionType() const { return _type; }
 
     void SendAuthResponseError(uint32 code);
     void SetWorldSession(WorldSession* session);
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
+    void SetNetworkThread(NetworkThread<WorldSocket> const* networkThread) { _networkThread = networkThread; }
 
 protected:
     void OnClose() override;
@@ -135,12 +176,18 @@ private:
     void LogOpcodeText(OpcodeClient opcode, std::unique_lock<std::mutex> const& guard) const;
     /// sends and logs network.opcode without accessing WorldSession
     void SendPacketAndLogOpcode(WorldPacket const& packet);
+    uint32 GetPacketBufferSize(EncryptablePacket const& packet) const;
     void WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer);
+    void WriteSharedPacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer);
+    void QueueEncryptedBuffer(MessageBuffer&& buffer);
     uint32 CompressPacket(uint8* buffer, WorldPacket const& packet);
+    void UpdateCompressionLevel();
 
     void HandleSendAuthSession();
     void HandleAuthSession(std::shared_ptr<WorldPackets::Auth::AuthSession> authSession);
     void HandleAuthSessionCallback(std::shared_ptr<WorldPackets::Auth::AuthSession> authSession, PreparedQueryResult result);
+    void HandleAuthSessionKeys(std::shared_ptr<WorldPackets::Auth::AuthSession> authSession, AccountInfo const& account, Optional<AuthSessionKeys> const& keys);
+    static std::array<uint8, 16> GenerateEncryptKey(SessionKey const& sessionKey, std::array<uint8, 16> const& localChallenge, std::array<uint8, 16> const& serverChallenge);
     void HandleAuthContinuedSession(std::shared_ptr<WorldPackets::Auth::AuthContinuedSession> authSession);
     void HandleAuthContinuedSessionCallback(std::shared_ptr<WorldPackets::Auth::AuthContinuedSession> authSession, PreparedQueryResult result);
     void LoadSessionPermissionsCallback(PreparedQueryResult result);
@@ -161,6 +208,7 @@ private:
 
     std::mutex _worldSessionLock;
     WorldSession* _worldSession;
+    std::atomic<uint32> _accountId;     // readable without _worldSessionLock, for PacketLog filtering
     bool _authed;
     bool _canRequestHotfixes;
 
@@ -168,10 +216,16 @@ private:
     MessageBuffer _packetBuffer;
     MPSCQueue<EncryptablePacket, &EncryptablePacket::SocketQueueLink> _bufferQueue;
     std::size_t _sendBufferSize;
+    std::vector<WorldPacketCrypt::SendBatchEntry> _pendingEncryption;   // packets written to the current send buffer, encrypted together before queueing it
+
+    NetworkThread<WorldSocket> const* _networkThread;
 
     z_stream* _compressionStream;
+    int32 _compressionLevel;
+    bool _compressionNeedsFullFlush;    // stream must not reference data sent before a shared compressed packet
 
     QueryCallbackProcessor _queryProcessor;
+    Trinity::Crypto::CryptoCallbackProcessor _cryptoProcessor;
     std::string _ipCountry;
 };
 
@@ -33,6 +33,8 @@ public:
     void SocketAdded(std::shared_ptr<WorldSocket> sock) override
     {
         sock->SetSendBufferSize(sWorldSocketMgr.GetApplicationSendBufferSize());
+        sock->SetWriteBatchSize(sWorldSocketMgr.GetWriteBatchSize());
+        sock->SetNetworkThread(this);
         sScriptMgr->OnSocketOpen(sock);
     }
 
@@ -42,7 +44,7 @@ public:
     }
 };
 
-WorldSocketMgr::WorldSocketMgr() : BaseSocketMgr(), _instanceAcceptor(nullptr), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536), _tcpNoDelay(true)
+WorldSocketMgr::WorldSocketMgr() : BaseSocketMgr(), _instanceAcceptor(nullptr), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536), _writeBatchSize(16), _tcpNoDelay(true)
 {
 }
 
@@ -75,6 +77,16 @@ bool WorldSocketMgr::StartWorldNetwork(Trinity::Asio::IoContext& ioContext, std:
         return false;
     }
 
+    _writeBatchSize = sConfigMgr->GetIntDefault("Network.WriteBatchSize", 16);
+
+    if (_writeBatchSize <= 0)
+    {
+        TC_LOG_ERROR("misc", "Network.WriteBatchSize is wrong in your config file");
+        return false;
+    }
+
+    SetPerThreadAcceptors(sConfigMgr->GetBoolDefault("Network.ReusePortAcceptors", false));
+
     if (!BaseSocketMgr::StartNetwork(ioContext, bindIp, port, threadCount))
         return false;
 
@@ -100,7 +112,7 @@ bool WorldSocketMgr::StartWorldNetwork(Trinity::Asio::IoContext& ioContext, std:
 
     _instanceAcceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
 
-    _acceptor->AsyncAcceptWithCallback<&OnSocketAccept>();
+    AsyncAcceptWithCallback<&OnSocketAccept>();
     _instanceAcceptor->AsyncAcceptWithCallback<&OnSocketAccept>();
 
     sScriptMgr->OnNetworkStart();
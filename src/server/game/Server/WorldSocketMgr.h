@@ -47,6 +47,7 @@ public:
     void OnSocketOpen(tcp::socket&& sock, uint32 threadIndex) override;
 
     std::size_t GetApplicationSendBufferSize() const { return _socketApplicationSendBufferSize; }
+    std::size_t GetWriteBatchSize() const { return _writeBatchSize; }
 
 protected:
     WorldSocketMgr();
@@ -63,6 +64,7 @@ private:
     AsyncAcceptor* _instanceAcceptor;
     int32 _socketSystemSendBufferSize;
     int32 _socketApplicationSendBufferSize;
+    int32 _writeBatchSize;
     bool _tcpNoDelay;
 };
 
@@ -648,6 +648,17 @@ void AuraEffect::GetApplicationList(Container& applicationContainer) const
     }
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    _amount = amount;
+    m_canBeRecalculated = false;
+
+    // totals of targets include the old amount
+    for (auto const& [guid, aurApp] : GetBase()->GetApplicationMap())
+        if (aurApp->HasEffect(GetEffIndex()))
+            aurApp->GetTarget()->InvalidateAuraTotalCache(GetAuraType());
+}
+
 int32 AuraEffect::CalculateAmount(Unit* caster)
 {
     // default amount calculation
@@ -36,6 +36,7 @@
 #include "Util.h"
 #include "Vehicle.h"
 #include "World.h"
+#include <deque>
 #include <sstream>
 
 class ChargeDropEvent : public BasicEvent
@@ -794,10 +795,18 @@ void Aura::UpdateOwner(uint32 diff, WorldObject* owner)
         m_updateTargetMapInterval -= diff;
 
     // update aura effects
+    // effects of auras owned by units tick on their owner, so all of their combat log entries share one packet
+    Unit* unitOwner = owner->ToUnit();
+    if (unitOwner)
+        unitOwner->BeginPeriodicAuraLogBatch();
+
     for (AuraEffect* effect : GetAuraEffects())
         if (effect)
             effect->Update(diff, caster);
 
+    if (unitOwner)
+        unitOwner->EndPeriodicAuraLogBatch();
+
     // remove spellmods after effects update
     if (modSpell)
         modOwner->SetSpellModTakingSpell(modSpell, false);
@@ -2488,6 +2497,40 @@ void UnitAura::Remove(AuraRemoveMode removeMode)
     GetUnitOwner()->RemoveOwnedAura(this, removeMode);
 }
 
+namespace
+{
+// grid searches done by one target map update
+class AreaAuraTargetSearches
+{
+public:
+    template<typename Search>
+    std::vector<Unit*> const& Find(SpellTargetCheckTypes selectionType, float radius, ConditionContainer const* condList, Search&& search)
+    {
+        for (Entry const& entry : _entries)
+            if (entry.SelectionType == selectionType && entry.Radius == radius && entry.Conditions == condList)
+                return entry.Units;
+
+        Entry& entry = _entries.emplace_back();
+        entry.SelectionType = selectionType;
+        entry.Radius = radius;
+        entry.Conditions = condList;
+        search(entry.Units);
+        return entry.Units;
+    }
+
+private:
+    struct Entry
+    {
+        SpellTargetCheckTypes SelectionType;
+        float Radius;
+        ConditionContainer const* Conditions;
+        std::vector<Unit*> Units;
+    };
+
+    std::deque<Entry> _entries;     // references to earlier results stay valid
+};
+}
+
 void UnitAura::FillTargetMap(std::unordered_map<Unit*, uint32>& targets, Unit* caster)
 {
     Unit* ref = caster;
@@ -2506,6 +2549,7 @@ void UnitAura::FillTargetMap(std::unordered_map<Unit*, uint32>& targets, Unit* c
             targets.emplace(target, targetPair.second);
     }
 
+    AreaAuraTargetSearches searches;
     for (SpellEffectInfo const& spellEffectInfo : GetSpellInfo()->GetEffects())
     {
         if (!HasEffect(spellEffectInfo.EffectIndex))
@@ -2576,18 +2620,26 @@ void UnitAura::FillTargetMap(std::unordered_map<Unit*, uint32>& targets, Unit* c
                 break;
         }
 
+        for (Unit* unit : units)
+            targets[unit] |= 1 << spellEffectInfo.EffectIndex;
+
         if (selectionType != TARGET_CHECK_DEFAULT)
         {
-            Trinity::WorldObjectSpellAreaTargetCheck check(radius, GetUnitOwner(), ref, GetUnitOwner(), m_spellInfo, selectionType, condList, TARGET_OBJECT_TYPE_UNIT);
-            Trinity::UnitListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(GetUnitOwner(), units, check);
-            Cell::VisitAllObjects(GetUnitOwner(), searcher, radius + extraSearchRadius);
+            // effects with equal search parameters share one grid search
+            std::vector<Unit*> const& areaUnits = searches.Find(selectionType, radius, condList, [&](std::vector<Unit*>& found)
+            {
+                Trinity::WorldObjectSpellAreaTargetCheck check(radius, GetUnitOwner(), ref, GetUnitOwner(), m_spellInfo, selectionType, condList, TARGET_OBJECT_TYPE_UNIT);
+                Trinity::UnitListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(GetUnitOwner(), found, check);
+                searcher.SetUnitSearchArea(*GetUnitOwner(), radius, radius);
+                Cell::VisitAllObjects(GetUnitOwner(), searcher, radius + extraSearchRadius);
 
-            // by design WorldObjectSpellAreaTargetCheck allows not-in-world units (for spells) but for auras it is not acceptable
-            units.erase(std::remove_if(units.begin(), units.end(), [this](Unit* unit) { return !unit->IsSelfOrInSameMap(GetUnitOwner()); }), units.end());
-        }
+                // by design WorldObjectSpellAreaTargetCheck allows not-in-world units (for spells) but for auras it is not acceptable
+                found.erase(std::remove_if(found.begin(), found.end(), [this](Unit* unit) { return !unit->IsSelfOrInSameMap(GetUnitOwner()); }), found.end());
+            });
 
-        for (Unit* unit : units)
-            targets[unit] |= 1 << spellEffectInfo.EffectIndex;
+            for (Unit* unit : areaUnits)
+                targets[unit] |= 1 << spellEffectInfo.EffectIndex;
+        }
     }
 }
 
@@ -2630,6 +2682,7 @@ void DynObjAura::FillTargetMap(std::unordered_map<Unit*, uint32>& targets, Unit*
     Unit* dynObjOwnerCaster = GetDynobjOwner()->GetCaster();
     float radius = GetDynobjOwner()->GetRadius();
 
+    AreaAuraTargetSearches searches;
     for (SpellEffectInfo const& spellEffectInfo : GetSpellInfo()->GetEffects())
     {
         if (!HasEffect(spellEffectInfo.EffectIndex))
@@ -2640,15 +2693,19 @@ void DynObjAura::FillTargetMap(std::unordered_map<Unit*, uint32>& targets, Unit*
         if (spellEffectInfo.TargetB.GetReferenceType() == TARGET_REFERENCE_TYPE_DEST)
             selectionType = spellEffectInfo.TargetB.GetCheckType();
 
-        std::vector<Unit*> units;
         ConditionContainer* condList = spellEffectInfo.ImplicitTargetConditions;
 
-        Trinity::WorldObjectSpellAreaTargetCheck check(radius, GetDynobjOwner(), dynObjOwnerCaster, dynObjOwnerCaster, m_spellInfo, selectionType, condList, TARGET_OBJECT_TYPE_UNIT);
-        Trinity::UnitListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(GetDynobjOwner(), units, check);
-        Cell::VisitAllObjects(GetDynobjOwner(), searcher, radius);
+        // effects with equal search parameters share one grid search
+        std::vector<Unit*> const& units = searches.Find(selectionType, radius, condList, [&](std::vector<Unit*>& found)
+        {
+            Trinity::WorldObjectSpellAreaTargetCheck check(radius, GetDynobjOwner(), dynObjOwnerCaster, dynObjOwnerCaster, m_spellInfo, selectionType, condList, TARGET_OBJECT_TYPE_UNIT);
+            Trinity::UnitListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(GetDynobjOwner(), found, check);
+            searcher.SetUnitSearchArea(*GetDynobjOwner(), radius, radius);
+            Cell::VisitAllObjects(GetDynobjOwner(), searcher, radius);
 
-        // by design WorldObjectSpellAreaTargetCheck allows not-in-world units (for spells) but for auras it is not acceptable
-        units.erase(std::remove_if(units.begin(), units.end(), [this](Unit* unit) { return !unit->IsSelfOrInSameMap(GetDynobjOwner()); }), units.end());
+            // by design WorldObjectSpellAreaTargetCheck allows not-in-world units (for spells) but for auras it is not acceptable
+            found.erase(std::remove_if(found.begin(), found.end(), [this](Unit* unit) { return !unit->IsSelfOrInSameMap(GetDynobjOwner()); }), found.end());
+        });
 
         for (Unit* unit : units)
             targets[unit] |= 1 << spellEffectInfo.EffectIndex;
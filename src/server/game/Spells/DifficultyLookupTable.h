@@ -0,0 +1,126 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_DIFFICULTYLOOKUPTABLE_H
+#define TRINITY_DIFFICULTYLOOKUPTABLE_H
+
+#include "Define.h"
+#include "Optional.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+enum Difficulty : uint8;
+
+/**
+ * Read only lookup of values by id and difficulty, built once after loading.
+ *
+ * Ids index a dense offset array pointing at the few difficulties stored for that id,
+ * fallback chains of all difficulties are resolved at build time so a lookup
+ * never has to consult the difficulty store.
+ *
+ * T must have Id and Difficulty members and must not move while the table is in use.
+ */
+template<typename T>
+class DifficultyLookupTable
+{
+public:
+    DifficultyLookupTable() : _fallbackOffsets() { }
+
+    /**
+     * @param values    range of all values to index
+     * @param fallback  callable returning the difficulty to try after the given one, if any
+     */
+    template<typename Range, typename FallbackGetter>
+    void Build(Range const& values, FallbackGetter fallback)
+    {
+        Clear();
+
+        uint32 maxId = 0;
+        for (T const& value : values)
+            maxId = std::max(maxId, uint32(value.Id));
+
+        _offsets.assign(std::size_t(maxId) + 2, 0);
+        for (T const& value : values)
+            ++_offsets[value.Id + 1];
+
+        for (std::size_t i = 1; i < _offsets.size(); ++i)
+            _offsets[i] += _offsets[i - 1];
+
+        std::vector<uint32> insertPos(_offsets.begin(), _offsets.end() - 1);
+        _values.resize(_offsets.back());
+        for (T const& value : values)
+            _values[insertPos[value.Id]++] = { value.Difficulty, &value };
+
+        for (std::size_t difficulty = 0; difficulty < _fallbackOffsets.size() - 1; ++difficulty)
+        {
+            _fallbackOffsets[difficulty] = uint32(_fallbacks.size());
+
+            // stop at cycles, difficulty data is not trusted to be free of them
+            std::array<bool, std::numeric_limits<uint8>::max() + 1> visited = { };
+            Optional<Difficulty> current = Difficulty(difficulty);
+            while (current && !visited[*current])
+            {
+                visited[*current] = true;
+                _fallbacks.push_back(*current);
+                current = fallback(*current);
+            }
+        }
+        _fallbackOffsets.back() = uint32(_fallbacks.size());
+    }
+
+    void Clear()
+    {
+        std::vector<uint32>().swap(_offsets);
+        std::vector<Entry>().swap(_values);
+        std::vector<Difficulty>().swap(_fallbacks);
+        _fallbackOffsets = { };
+    }
+
+    T const* Find(uint32 id, Difficulty difficulty) const
+    {
+        if (std::size_t(id) + 1 >= _offsets.size())
+            return nullptr;
+
+        Entry const* begin = _values.data() + _offsets[id];
+        Entry const* end = _values.data() + _offsets[id + 1];
+        if (begin == end)
+            return nullptr;
+
+        for (uint32 i = _fallbackOffsets[difficulty]; i < _fallbackOffsets[difficulty + 1]; ++i)
+            for (Entry const* itr = begin; itr != end; ++itr)
+                if (itr->Difficulty == _fallbacks[i])
+                    return itr->Value;
+
+        return nullptr;
+    }
+
+private:
+    struct Entry
+    {
+        ::Difficulty Difficulty;
+        T const* Value;
+    };
+
+    std::vector<uint32> _offsets;                   // _values range of id is [_offsets[id], _offsets[id + 1])
+    std::vector<Entry> _values;
+    std::vector<Difficulty> _fallbacks;             // difficulties to try for a lookup, in order
+    std::array<uint32, std::numeric_limits<uint8>::max() + 2> _fallbackOffsets;
+};
+
+#endif // TRINITY_DIFFICULTYLOOKUPTABLE_H
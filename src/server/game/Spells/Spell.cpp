@@ -55,6 +55,7 @@
 #include "SpellPackets.h"
 #include "SpellScript.h"
 #include "TemporarySummon.h"
+#include "Trace.h"
 #include "TradeData.h"
 #include "TraitPackets.h"
 #include "Util.h"
@@ -1260,6 +1261,7 @@ void Spell::SelectImplicitConeTargets(SpellEffectInfo const& spellEffectInfo, Sp
         float extraSearchRadius = radius > 0.0f ? EXTRA_CELL_SEARCH_RADIUS : 0.0f;
         Trinity::WorldObjectSpellConeTargetCheck check(coneSrc, DegToRad(coneAngle), m_spellInfo->Width ? m_spellInfo->Width : m_caster->GetCombatReach(), radius, m_caster, m_spellInfo, selectionType, condList, objectType);
         Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
+        searcher.SetUnitSearchArea(*m_caster, radius, radius);
         SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> >(searcher, containerTypeMask, m_caster, m_caster, radius + extraSearchRadius);
 
         CallScriptObjectAreaTargetSelectHandlers(targets, spellEffectInfo.EffectIndex, targetType);
@@ -1395,6 +1397,8 @@ void Spell::SelectImplicitAreaTargets(SpellEffectInfo const& spellEffectInfo, Sp
                 targets.resize(maxTargets);
         }
 
+        PrefetchAreaTargetsLineOfSight(targets, center);
+
         for (WorldObject* itr : targets)
         {
             if (Unit* unit = itr->ToUnit())
@@ -1407,6 +1411,72 @@ void Spell::SelectImplicitAreaTargets(SpellEffectInfo const& spellEffectInfo, Sp
     }
 }
 
+void Spell::PrefetchAreaTargetsLineOfSight(std::list<WorldObject*> const& targets, Position const* losPosition) const
+{
+    // the checks of CheckEffectTarget find these results in the line of sight cache of the map
+    if (!sWorld->getBoolConfig(CONFIG_LINE_OF_SIGHT_CACHE) || targets.size() < 2)
+        return;
+
+    if (m_spellInfo->HasAttribute(SPELL_ATTR2_IGNORE_LINE_OF_SIGHT) || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_spellInfo->Id, nullptr, SPELL_DISABLE_LOS))
+        return;
+
+    if (GameObject const* gobCaster = m_caster->ToGameObject())
+        if (!gobCaster->GetGOInfo()->GetRequireLOS())
+            return;
+
+    WorldObject* caster = nullptr;
+    if (m_originalCasterGUID.IsGameObject())
+        caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
+    if (!caster)
+        caster = m_caster;
+
+    bool checkCaster = !losPosition || m_spellInfo->HasAttribute(SPELL_ATTR5_ALWAYS_AOE_LINE_OF_SIGHT);
+
+    // queries are batched per phase shift of the targets, most of them share the same one
+    std::vector<Unit const*> units;
+    for (WorldObject const* target : targets)
+        if (Unit const* unit = target->ToUnit())
+            if (unit != m_caster && unit->IsInMap(caster))
+                units.push_back(unit);
+
+    std::vector<std::size_t> phaseShiftHashes(units.size());
+    for (std::size_t i = 0; i < units.size(); ++i)
+        phaseShiftHashes[i] = units[i]->GetPhaseShift().GetCollisionHash();
+
+    std::vector<float> positions;
+    std::unique_ptr<bool[]> results = std::make_unique<bool[]>(units.size() * 2);
+    std::vector<bool> done(units.size(), false);
+    for (std::size_t first = 0; first < units.size(); ++first)
+    {
+        if (done[first])
+            continue;
+
+        PhaseShift const& phaseShift = units[first]->GetPhaseShift();
+        positions.clear();
+        for (std::size_t i = first; i < units.size(); ++i)
+        {
+            if (done[i] || phaseShiftHashes[i] != phaseShiftHashes[first] || !units[i]->GetPhaseShift().HasSameCollision(phaseShift))
+                continue;
+
+            done[i] = true;
+            float pair[6];
+            if (checkCaster)
+            {
+                units[i]->GetLineOfSightPositions(caster, pair);
+                positions.insert(positions.end(), std::begin(pair), std::end(pair));
+            }
+
+            if (losPosition)
+            {
+                units[i]->GetLineOfSightPositions(losPosition->GetPositionX(), losPosition->GetPositionY(), losPosition->GetPositionZ(), pair);
+                positions.insert(positions.end(), std::begin(pair), std::end(pair));
+            }
+        }
+
+        m_caster->GetMap()->isInLineOfSightBatch(phaseShift, positions.data(), results.get(), positions.size() / 6, LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::M2);
+    }
+}
+
 void Spell::SelectImplicitCasterDestTargets(SpellEffectInfo const& spellEffectInfo, SpellImplicitTargetInfo const& targetType)
 {
     SpellDestination dest(*m_caster);
@@ -2123,6 +2193,7 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
     float extraSearchRadius = range > 0.0f ? EXTRA_CELL_SEARCH_RADIUS : 0.0f;
     Trinity::WorldObjectSpellAreaTargetCheck check(range, position, m_caster, referer, m_spellInfo, selectionType, condList, objectType);
     Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
+    searcher.SetUnitSearchArea(*position, range, range);
     SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> > (searcher, containerTypeMask, m_caster, position, range + extraSearchRadius);
 }
 
@@ -3984,7 +4055,7 @@ uint64 Spell::handle_delayed(uint64 t_offset)
 
     // now recheck units targeting correctness (need before any effects apply to prevent adding immunity at first effect not allow apply second spell effect and similar cases)
     {
-        std::vector<TargetInfo> delayedTargets;
+        TargetInfoContainer delayedTargets;
         m_UniqueTargetInfo.erase(std::remove_if(m_UniqueTargetInfo.begin(), m_UniqueTargetInfo.end(), [&](TargetInfo& target) -> bool
         {
             if (ignoreTargetInfoTimeDelay || target.TimeDelay <= t_offset)
@@ -4004,7 +4075,7 @@ uint64 Spell::handle_delayed(uint64 t_offset)
 
     // now recheck gameobject targeting correctness
     {
-        std::vector<GOTargetInfo> delayedGOTargets;
+        GOTargetInfoContainer delayedGOTargets;
         m_UniqueGOTargetInfo.erase(std::remove_if(m_UniqueGOTargetInfo.begin(), m_UniqueGOTargetInfo.end(), [&](GOTargetInfo& goTarget) -> bool
         {
             if (ignoreTargetInfoTimeDelay || goTarget.TimeDelay <= t_offset)
@@ -4131,6 +4202,8 @@ void Spell::SendSpellCooldown()
 
 void Spell::update(uint32 difftime)
 {
+    TC_TRACE_ZONE("Spell::update");
+
     // update pointers based at it's GUIDs
     if (!UpdatePointers())
     {
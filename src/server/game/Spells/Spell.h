@@ -23,8 +23,10 @@
 #include "ObjectGuid.h"
 #include "Optional.h"
 #include "Position.h"
+#include "RecyclingAllocator.h"
 #include "SharedDefines.h"
 #include "SpellDefines.h"
+#include <boost/container/small_vector.hpp>
 #include <memory>
 
 namespace WorldPackets
@@ -421,6 +423,9 @@ class TC_GAME_API Spell
         Spell(WorldObject* caster, SpellInfo const* info, TriggerCastFlags triggerFlags, ObjectGuid originalCasterGUID = ObjectGuid::Empty, ObjectGuid originalCastId = ObjectGuid::Empty);
         ~Spell();
 
+        // a spell is created for every cast, recycle their memory
+        TRINITY_RECYCLED_ALLOCATION
+
         void InitExplicitTargets(SpellCastTargets const& targets);
         void SelectExplicitTargets();
 
@@ -430,6 +435,7 @@ class TC_GAME_API Spell
         void SelectImplicitNearbyTargets(SpellEffectInfo const& spellEffectInfo, SpellImplicitTargetInfo const& targetType, uint32 effMask);
         void SelectImplicitConeTargets(SpellEffectInfo const& spellEffectInfo, SpellImplicitTargetInfo const& targetType, uint32 effMask);
         void SelectImplicitAreaTargets(SpellEffectInfo const& spellEffectInfo, SpellImplicitTargetInfo const& targetType, uint32 effMask);
+        void PrefetchAreaTargetsLineOfSight(std::list<WorldObject*> const& targets, Position const* losPosition) const;
         void SelectImplicitCasterDestTargets(SpellEffectInfo const& spellEffectInfo, SpellImplicitTargetInfo const& targetType);
         void SelectImplicitTargetDestTargets(SpellEffectInfo const& spellEffectInfo, SpellImplicitTargetInfo const& targetType);
         void SelectImplicitDestDestTargets(SpellEffectInfo const& spellEffectInfo, SpellImplicitTargetInfo const& targetType);
@@ -778,7 +784,9 @@ class TC_GAME_API Spell
             Unit* _spellHitTarget = nullptr; // changed for example by reflect
             bool _enablePVP = false;         // need to enable PVP at DoDamageAndTriggers?
         };
-        std::vector<TargetInfo> m_UniqueTargetInfo;
+        // most casts hit only a few targets, keep them inside the spell
+        using TargetInfoContainer = boost::container::small_vector<TargetInfo, 4>;
+        TargetInfoContainer m_UniqueTargetInfo;
         uint32 m_channelTargetEffectMask;                       // Mask req. alive targets
 
         struct GOTargetInfo : public TargetInfoBase
@@ -788,7 +796,8 @@ class TC_GAME_API Spell
             ObjectGuid TargetGUID;
             uint64 TimeDelay = 0ULL;
         };
-        std::vector<GOTargetInfo> m_UniqueGOTargetInfo;
+        using GOTargetInfoContainer = boost::container::small_vector<GOTargetInfo, 1>;
+        GOTargetInfoContainer m_UniqueGOTargetInfo;
 
         struct ItemTargetInfo : public TargetInfoBase
         {
@@ -796,7 +805,7 @@ class TC_GAME_API Spell
 
             Item* TargetItem = nullptr;
         };
-        std::vector<ItemTargetInfo> m_UniqueItemInfo;
+        boost::container::small_vector<ItemTargetInfo, 1> m_UniqueItemInfo;
 
         struct CorpseTargetInfo : public TargetInfoBase
         {
@@ -805,7 +814,7 @@ class TC_GAME_API Spell
             ObjectGuid TargetGUID;
             uint64 TimeDelay = 0ULL;
         };
-        std::vector<CorpseTargetInfo> m_UniqueCorpseTargetInfo;
+        boost::container::small_vector<CorpseTargetInfo, 1> m_UniqueCorpseTargetInfo;
 
         template <class Container>
         void DoProcessTargetContainer(Container& targetContainer);
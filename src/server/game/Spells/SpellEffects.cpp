@@ -3301,6 +3301,7 @@ void Spell::EffectApplyGlyph()
     else if (glyphId)
         glyphs.push_back(glyphId);
 
+    player->SetSaveDirty(PlayerSaveDirtyFlags::Glyphs);
     player->RemoveAurasWithInterruptFlags(SpellAuraInterruptFlags2::ChangeGlyph);
 
     if (GlyphPropertiesEntry const* glyphProperties = sGlyphPropertiesStore.LookupEntry(glyphId))
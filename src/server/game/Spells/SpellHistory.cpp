@@ -136,7 +136,7 @@ struct SpellHistory::PersistenceHelper<Pet>
     }
 };
 
-SpellHistory::SpellHistory(Unit* owner) : _owner(owner), _schoolLockouts()
+SpellHistory::SpellHistory(Unit* owner) : _owner(owner), _schoolLockouts(), _nextExpiryCheck(Clock::time_point::min())
 {
 }
 
@@ -158,6 +158,8 @@ void SpellHistory::LoadFromDB(PreparedQueryResult cooldownsResult, PreparedQuery
                 _spellCooldowns[spellId] = cooldown;
                 if (cooldown.CategoryId)
                     _categoryCooldowns[cooldown.CategoryId] = &_spellCooldowns[spellId];
+
+                ScheduleExpiryCheck(std::min(cooldown.CooldownEnd, cooldown.CategoryEnd));
             }
 
         } while (cooldownsResult->NextRow());
@@ -171,7 +173,10 @@ void SpellHistory::LoadFromDB(PreparedQueryResult cooldownsResult, PreparedQuery
             uint32 categoryId = 0;
             ChargeEntry charges;
             if (StatementInfo::ReadCharge(fields, &categoryId, &charges))
+            {
                 _categoryCharges[categoryId].push_back(charges);
+                ScheduleExpiryCheck(charges.RechargeEnd);
+            }
 
         } while (chargesResult->NextRow());
     }
@@ -219,12 +224,19 @@ void SpellHistory::SaveToDB(CharacterDatabaseTransaction trans)
 void SpellHistory::Update()
 {
     Clock::time_point now = GameTime::GetTime<Clock>();
+    if (now < _nextExpiryCheck)
+        return;
+
+    Clock::time_point nextExpiryCheck = Clock::time_point::max();
     for (auto itr = _categoryCooldowns.begin(); itr != _categoryCooldowns.end();)
     {
         if (itr->second->CategoryEnd < now)
             itr = _categoryCooldowns.erase(itr);
         else
+        {
+            nextExpiryCheck = std::min(nextExpiryCheck, itr->second->CategoryEnd);
             ++itr;
+        }
     }
 
     for (auto itr = _spellCooldowns.begin(); itr != _spellCooldowns.end();)
@@ -232,7 +244,10 @@ void SpellHistory::Update()
         if (itr->second.CooldownEnd < now)
             itr = EraseCooldown(itr);
         else
+        {
+            nextExpiryCheck = std::min(nextExpiryCheck, itr->second.CooldownEnd);
             ++itr;
+        }
     }
 
     for (auto& p : _categoryCharges)
@@ -240,7 +255,12 @@ void SpellHistory::Update()
         std::deque<ChargeEntry>& chargeRefreshTimes = p.second;
         while (!chargeRefreshTimes.empty() && chargeRefreshTimes.front().RechargeEnd <= now)
             chargeRefreshTimes.pop_front();
+
+        if (!chargeRefreshTimes.empty())
+            nextExpiryCheck = std::min(nextExpiryCheck, chargeRefreshTimes.front().RechargeEnd);
     }
+
+    _nextExpiryCheck = nextExpiryCheck;
 }
 
 void SpellHistory::HandleCooldowns(SpellInfo const* spellInfo, Item const* item, Spell* spell /*= nullptr*/)
@@ -566,6 +586,8 @@ void SpellHistory::AddCooldown(uint32 spellId, uint32 itemId, Clock::time_point
         if (categoryId)
             _categoryCooldowns[categoryId] = &cooldownEntry;
     }
+
+    ScheduleExpiryCheck(std::min(cooldownEntry.CooldownEnd, cooldownEntry.CategoryEnd));
 }
 
 void SpellHistory::ModifySpellCooldown(uint32 spellId, Duration cooldownMod, bool withoutCategoryCooldown)
@@ -593,6 +615,8 @@ void SpellHistory::ModifySpellCooldown(CooldownStorageType::iterator& itr, Durat
             itr->second.CooldownEnd = itr->second.CategoryEnd;
     }
 
+    ScheduleExpiryCheck(std::min(itr->second.CooldownEnd, itr->second.CategoryEnd));
+
     if (Player* playerOwner = GetPlayerOwner())
     {
         WorldPackets::Spells::ModifyCooldown modifyCooldown;
@@ -815,6 +839,7 @@ bool SpellHistory::ConsumeCharge(uint32 chargeCategoryId)
             recoveryStart = charges.back().RechargeEnd;
 
         charges.emplace_back(recoveryStart, Milliseconds(chargeRecovery));
+        ScheduleExpiryCheck(charges.front().RechargeEnd);
         return true;
     }
 
@@ -842,6 +867,9 @@ void SpellHistory::ModifyChargeRecoveryTime(uint32 chargeCategoryId, Duration co
     while (!itr->second.empty() && itr->second.front().RechargeEnd < now)
         itr->second.pop_front();
 
+    if (!itr->second.empty())
+        ScheduleExpiryCheck(itr->second.front().RechargeEnd);
+
     SendSetSpellCharges(chargeCategoryId, itr->second);
 }
 
@@ -1043,7 +1071,11 @@ void SpellHistory::RestoreCooldownStateAfterDuel()
             if (!pair.second.OnHold &&
                 _spellCooldowns.find(pair.first) != _spellCooldowns.end() &&
                 !_spellCooldowns[pair.first].OnHold)
-                _spellCooldowns[pair.first] = _spellCooldownsBeforeDuel[pair.first];
+            {
+                CooldownEntry& cooldownEntry = _spellCooldowns[pair.first];
+                cooldownEntry = pair.second;
+                ScheduleExpiryCheck(std::min(cooldownEntry.CooldownEnd, cooldownEntry.CategoryEnd));
+            }
         }
 
         // update the client: restore old cooldowns
@@ -23,6 +23,7 @@
 #include "Duration.h"
 #include "GameTime.h"
 #include "Optional.h"
+#include <algorithm>
 #include <deque>
 #include <vector>
 #include <unordered_map>
@@ -187,6 +188,9 @@ private:
         return _spellCooldowns.erase(itr);
     }
 
+    // Update only scans the storages once the earliest stored expiry time is reached
+    void ScheduleExpiryCheck(Clock::time_point expiry) { _nextExpiryCheck = std::min(_nextExpiryCheck, expiry); }
+
     void SendSetSpellCharges(uint32 chargeCategoryId, ChargeEntryCollection const& chargeCollection);
 
     static void GetCooldownDurations(SpellInfo const* spellInfo, uint32 itemId, Duration* cooldown, uint32* categoryId, Duration* categoryCooldown);
@@ -198,6 +202,7 @@ private:
     Clock::time_point _schoolLockouts[MAX_SPELL_SCHOOL];
     ChargeStorageType _categoryCharges;
     GlobalCooldownStorageType _globalCooldowns;
+    Clock::time_point _nextExpiryCheck;
 
     template<class T>
     struct PersistenceHelper { };
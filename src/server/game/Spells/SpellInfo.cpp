@@ -1144,7 +1144,7 @@ std::array<SpellEffectInfo::StaticData, TOTAL_SPELL_EFFECTS> SpellEffectInfo::_d
     {EFFECT_IMPLICIT_TARGET_NONE,     TARGET_OBJECT_TYPE_NONE}, // 314 SPELL_EFFECT_314
 } };
 
-SpellInfo::SpellInfo(SpellNameEntry const* spellName, ::Difficulty difficulty, SpellInfoLoadHelper const& data)
+SpellInfo::SpellInfo(SpellNameEntry const* spellName, ::Difficulty difficulty, SpellInfoLoadHelper const& data, SpellInfoListStore& lists)
     : Id(spellName->ID), Difficulty(difficulty)
 {
     _effects.reserve(32);
@@ -1213,7 +1213,7 @@ SpellInfo::SpellInfo(SpellNameEntry const* spellName, ::Difficulty difficulty, S
         if (SpellProcsPerMinuteEntry const* _ppm = sSpellProcsPerMinuteStore.LookupEntry(_options->SpellProcsPerMinuteID))
         {
             ProcBasePPM = _ppm->BaseProcRate;
-            ProcPPMMods = sDB2Manager.GetSpellProcsPerMinuteMods(_ppm->ID);
+            ProcPPMMods = lists.Store(sDB2Manager.GetSpellProcsPerMinuteMods(_ppm->ID));
         }
     }
 
@@ -1288,8 +1288,14 @@ SpellInfo::SpellInfo(SpellNameEntry const* spellName, ::Difficulty difficulty, S
         ChannelInterruptFlags2 = SpellAuraInterruptFlags2(_interrupt->ChannelInterruptFlags[1]);
     }
 
+    std::vector<uint32> labels;
+    labels.reserve(data.Labels.size());
     for (SpellLabelEntry const* label : data.Labels)
-        Labels.insert(label->LabelID);
+        labels.push_back(label->LabelID);
+
+    std::sort(labels.begin(), labels.end());
+    labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+    Labels = lists.Store(std::move(labels));
 
     // SpellLevelsEntry
     if (SpellLevelsEntry const* _levels = data.Levels)
@@ -1309,7 +1315,7 @@ SpellInfo::SpellInfo(SpellNameEntry const* spellName, ::Difficulty difficulty, S
         ReagentCount = _reagents->ReagentCount;
     }
 
-    ReagentsCurrency = data.ReagentsCurrency;
+    ReagentsCurrency = lists.Store(data.ReagentsCurrency);
 
     // SpellShapeshiftEntry
     if (SpellShapeshiftEntry const* _shapeshift = data.Shapeshift)
@@ -1336,7 +1342,7 @@ SpellInfo::SpellInfo(SpellNameEntry const* spellName, ::Difficulty difficulty, S
         Totem = _totem->Totem;
     }
 
-    _visuals = data.Visuals;
+    _visuals = lists.Store(data.Visuals);
 }
 
 SpellInfo::SpellInfo(SpellNameEntry const* spellName, ::Difficulty difficulty, std::vector<SpellEffectEntry> const& effects)
@@ -5010,5 +5016,5 @@ bool SpellInfo::MeetsFutureSpellPlayerCondition(Player const* player) const
 
 bool SpellInfo::HasLabel(uint32 labelId) const
 {
-    return Labels.find(labelId) != Labels.end();
+    return std::binary_search(Labels.begin(), Labels.end(), labelId);
 }
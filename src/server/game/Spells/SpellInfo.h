@@ -24,6 +24,9 @@
 #include "SpellAuraDefines.h"
 #include "SpellDefines.h"
 #include <bitset>
+#include <set>
+#include <span>
+#include <tuple>
 
 class AuraEffect;
 class Item;
@@ -318,6 +321,47 @@ struct SpellPowerCost
     int32 Amount;
 };
 
+/// Variable length lists of SpellInfo are usually identical for all difficulties of a spell (and often for different spells),
+/// every distinct list is stored once here and SpellInfo only references it
+class TC_GAME_API SpellInfoListStore
+{
+public:
+    template <typename T>
+    std::span<T const> Store(std::vector<T> list)
+    {
+        if (list.empty())
+            return {};
+
+        _requestedBytes += list.size() * sizeof(T);
+        auto [itr, inserted] = std::get<std::set<std::vector<T>>>(_lists).insert(std::move(list));
+        if (inserted)
+            _storedBytes += itr->size() * sizeof(T);
+
+        return *itr;
+    }
+
+    void Clear()
+    {
+        std::apply([](auto&... lists) { (lists.clear(), ...); }, _lists);
+        _requestedBytes = 0;
+        _storedBytes = 0;
+    }
+
+    std::size_t GetListCount() const { return std::apply([](auto const&... lists) { return (lists.size() + ...); }, _lists); }
+    std::size_t GetRequestedBytes() const { return _requestedBytes; }
+    std::size_t GetStoredBytes() const { return _storedBytes; }
+
+private:
+    std::tuple<
+        std::set<std::vector<uint32>>,
+        std::set<std::vector<SpellProcsPerMinuteModEntry const*>>,
+        std::set<std::vector<SpellReagentsCurrencyEntry const*>>,
+        std::set<std::vector<SpellXSpellVisualEntry const*>>
+    > _lists;
+    std::size_t _requestedBytes = 0;
+    std::size_t _storedBytes = 0;
+};
+
 class TC_GAME_API SpellInfo
 {
     friend class SpellMgr;
@@ -379,7 +423,7 @@ class TC_GAME_API SpellInfo
         uint32 ProcCharges = 0;
         uint32 ProcCooldown = 0;
         float ProcBasePPM = 0.0f;
-        std::vector<SpellProcsPerMinuteModEntry const*> ProcPPMMods;
+        std::span<SpellProcsPerMinuteModEntry const* const> ProcPPMMods;
         uint32 MaxLevel = 0;
         uint32 BaseLevel = 0;
         uint32 SpellLevel = 0;
@@ -393,7 +437,7 @@ class TC_GAME_API SpellInfo
         std::array<uint16, MAX_SPELL_TOTEMS> TotemCategory = {};
         std::array<int32, MAX_SPELL_REAGENTS> Reagent = {};
         std::array<int16, MAX_SPELL_REAGENTS> ReagentCount = {};
-        std::vector<SpellReagentsCurrencyEntry const*> ReagentsCurrency;
+        std::span<SpellReagentsCurrencyEntry const* const> ReagentsCurrency;
         int32 EquippedItemClass = -1;
         int32 EquippedItemSubClassMask = 0;
         int32 EquippedItemInventoryTypeMask = 0;
@@ -413,7 +457,7 @@ class TC_GAME_API SpellInfo
         int32 RequiredAreasID = -1;
         uint32 SchoolMask = 0;
         uint32 ChargeCategoryId = 0;
-        std::unordered_set<uint32> Labels;
+        std::span<uint32 const> Labels; // sorted
 
         // SpellScalingEntry
         struct ScalingInfo
@@ -426,7 +470,7 @@ class TC_GAME_API SpellInfo
         uint32 ExplicitTargetMask = 0;
         SpellChainNode const* ChainEntry = nullptr;
 
-        explicit SpellInfo(SpellNameEntry const* spellName, ::Difficulty difficulty, SpellInfoLoadHelper const& data);
+        explicit SpellInfo(SpellNameEntry const* spellName, ::Difficulty difficulty, SpellInfoLoadHelper const& data, SpellInfoListStore& lists);
         explicit SpellInfo(SpellNameEntry const* spellName, ::Difficulty difficulty, std::vector<SpellEffectEntry> const& effects);
         SpellInfo(SpellInfo const&) = delete;
         SpellInfo(SpellInfo&&) = delete;
@@ -607,7 +651,7 @@ class TC_GAME_API SpellInfo
 
     private:
         std::vector<SpellEffectInfo> _effects;
-        SpellVisualVector _visuals;
+        std::span<SpellXSpellVisualEntry const* const> _visuals;
         SpellSpecificType _spellSpecific = SPELL_SPECIFIC_NORMAL;
         AuraStateType _auraState = AURA_STATE_NONE;
 
@@ -23,6 +23,7 @@
 #include "Containers.h"
 #include "DB2Stores.h"
 #include "DatabaseEnv.h"
+#include "DifficultyLookupTable.h"
 #include "LanguageMgr.h"
 #include "Log.h"
 #include "MotionMaster.h"
@@ -61,6 +62,22 @@ namespace
         >
     > mSpellInfoMap;
 
+    // lists referenced by SpellInfo, shared by all spells that have the same list
+    SpellInfoListStore mSpellInfoLists;
+
+    // frozen copy of mSpellInfoMap for GetSpellInfo, rebuilt whenever spells are added
+    DifficultyLookupTable<SpellInfo> mSpellInfoLookup;
+
+    void BuildSpellInfoLookup()
+    {
+        mSpellInfoLookup.Build(mSpellInfoMap, [](Difficulty difficulty) -> Optional<Difficulty>
+        {
+            if (DifficultyEntry const* difficultyEntry = sDifficultyStore.LookupEntry(difficulty))
+                return Difficulty(difficultyEntry->FallbackDifficultyID);
+            return {};
+        });
+    }
+
     class ServersideSpellName
     {
     public:
@@ -674,23 +691,7 @@ SpellAreaForAreaMapBounds SpellMgr::GetSpellAreaForAreaMapBounds(uint32 area_id)
 
 SpellInfo const* SpellMgr::GetSpellInfo(uint32 spellId, Difficulty difficulty) const
 {
-    auto itr = mSpellInfoMap.find(boost::make_tuple(spellId, difficulty));
-    if (itr != mSpellInfoMap.end())
-        return &*itr;
-
-    if (DifficultyEntry const* difficultyEntry = sDifficultyStore.LookupEntry(difficulty))
-    {
-        do
-        {
-            itr = mSpellInfoMap.find(boost::make_tuple(spellId, Difficulty(difficultyEntry->FallbackDifficultyID)));
-            if (itr != mSpellInfoMap.end())
-                return &*itr;
-
-            difficultyEntry = sDifficultyStore.LookupEntry(difficultyEntry->FallbackDifficultyID);
-        } while (difficultyEntry);
-    }
-
-    return nullptr;
+    return mSpellInfoLookup.Find(spellId, difficulty);
 }
 
 auto _GetSpellInfo(uint32 spellId)
@@ -2639,15 +2640,20 @@ void SpellMgr::LoadSpellInfoStore()
             } while (difficultyEntry);
         }
 
-        mSpellInfoMap.emplace(spellNameEntry, data.first.second, data.second);
+        mSpellInfoMap.emplace(spellNameEntry, data.first.second, data.second, mSpellInfoLists);
     }
 
-    TC_LOG_INFO("server.loading", ">> Loaded SpellInfo store in {} ms", GetMSTimeDiffToNow(oldMSTime));
+    BuildSpellInfoLookup();
+
+    TC_LOG_INFO("server.loading", ">> Loaded SpellInfo store in {} ms ({} distinct labels, visuals, reagent currencies and ppm modifier lists, {} bytes instead of {} for {} spell difficulties)",
+        GetMSTimeDiffToNow(oldMSTime), mSpellInfoLists.GetListCount(), mSpellInfoLists.GetStoredBytes(), mSpellInfoLists.GetRequestedBytes(), mSpellInfoMap.size());
 }
 
 void SpellMgr::UnloadSpellInfoStore()
 {
+    mSpellInfoLookup.Clear();
     mSpellInfoMap.clear();
+    mSpellInfoLists.Clear();
     mServersideSpellNames.clear();
 }
 
@@ -2898,6 +2904,8 @@ void SpellMgr::LoadSpellInfoServerside()
         } while (spellsResult->NextRow());
     }
 
+    BuildSpellInfoLookup();
+
     TC_LOG_INFO("server.loading", ">> Loaded {} serverside spells {} ms", mServersideSpellNames.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
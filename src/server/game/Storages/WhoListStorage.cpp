@@ -16,10 +16,8 @@
  */
 
 #include "WhoListStorage.h"
-#include "World.h"
 #include "ObjectAccessor.h"
 #include "Player.h"
-#include "GuildMgr.h"
 #include "WorldSession.h"
 #include "Guild.h"
 
@@ -31,38 +29,111 @@ WhoListStorageMgr* WhoListStorageMgr::instance()
 
 void WhoListStorageMgr::Update()
 {
-    // clear current list
-    _whoListStorage.clear();
-    _whoListStorage.reserve(sWorld->GetPlayerCount()+1);
+    ++_updateGeneration;
 
     HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
     for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
     {
-        if (!itr->second->FindMap() || itr->second->GetSession()->PlayerLoading())
+        Player* player = itr->second;
+        if (!player->FindMap() || player->GetSession()->PlayerLoading())
             continue;
 
-        std::string playerName = itr->second->GetName();
-        std::wstring widePlayerName;
-        if (!Utf8toWStr(playerName, widePlayerName))
-            continue;
+        static std::string const NoGuildName;
+        Guild* guild = player->GetGuild();
+        std::string const& playerName = player->GetName();
+        std::string const& guildName = guild ? guild->GetName() : NoGuildName;
+
+        WhoListPlayerInfo* info = nullptr;
+        auto indexItr = _storageIndexByGuid.find(player->GetGUID());
+        if (indexItr != _storageIndexByGuid.end())
+            info = &_whoListStorage[indexItr->second];
+
+        // names are the expensive part, only convert them again when they changed
+        if (!info || info->_playerName != playerName || info->_guildName != guildName)
+        {
+            std::wstring widePlayerName;
+            if (!Utf8toWStr(playerName, widePlayerName))
+                continue;
+
+            wstrToLower(widePlayerName);
+
+            std::wstring wideGuildName;
+            if (!Utf8toWStr(guildName, wideGuildName))
+                continue;
 
-        wstrToLower(widePlayerName);
+            wstrToLower(wideGuildName);
 
-        std::string guildName = sGuildMgr->GetGuildNameById(itr->second->GetGuildId());
-        std::wstring wideGuildName;
-        if (!Utf8toWStr(guildName, wideGuildName))
+            if (!info)
+            {
+                _storageIndexByGuid[player->GetGUID()] = uint32(_whoListStorage.size());
+                info = &_whoListStorage.emplace_back(player->GetGUID(), player->GetTeam(), player->GetSession()->GetSecurity(), player->GetLevel(),
+                    player->GetClass(), player->GetRace(), player->GetZoneId(), player->GetNativeGender(), player->IsVisible(),
+                    player->IsGameMaster(), widePlayerName, wideGuildName, playerName, guildName, guild ? guild->GetGUID() : ObjectGuid::Empty);
+            }
+            else
+            {
+                info->_widePlayerName = std::move(widePlayerName);
+                info->_wideGuildName = std::move(wideGuildName);
+                info->_playerName = playerName;
+                info->_guildName = guildName;
+            }
+        }
+
+        info->_team = player->GetTeam();
+        info->_security = player->GetSession()->GetSecurity();
+        info->_level = player->GetLevel();
+        info->_class = player->GetClass();
+        info->_race = player->GetRace();
+        info->_zoneid = player->GetZoneId();
+        info->_gender = player->GetNativeGender();
+        info->_visible = player->IsVisible();
+        info->_gamemaster = player->IsGameMaster();
+        info->_guildguid = guild ? guild->GetGUID() : ObjectGuid::Empty;
+        info->_updateGeneration = _updateGeneration;
+    }
+
+    // drop players that were not found by moving the last entry into their place
+    for (std::size_t i = 0; i < _whoListStorage.size();)
+    {
+        if (_whoListStorage[i]._updateGeneration == _updateGeneration)
+        {
+            ++i;
             continue;
+        }
 
-        wstrToLower(wideGuildName);
+        _storageIndexByGuid.erase(_whoListStorage[i].GetGuid());
+        if (i + 1 != _whoListStorage.size())
+        {
+            _whoListStorage[i] = std::move(_whoListStorage.back());
+            _storageIndexByGuid[_whoListStorage[i].GetGuid()] = uint32(i);
+        }
 
-        Guild* guild = itr->second->GetGuild();
-        ObjectGuid guildGuid;
+        _whoListStorage.pop_back();
+    }
+
+    RebuildIndexes();
+}
+
+void WhoListStorageMgr::RebuildIndexes()
+{
+    for (std::vector<uint32>& players : _playersByLevel)
+        players.clear();
 
-        if (guild)
-            guildGuid = guild->GetGUID();
+    for (auto& [zoneId, players] : _playersByZone)
+        players.clear();
 
-        _whoListStorage.emplace_back(itr->second->GetGUID(), itr->second->GetTeam(), itr->second->GetSession()->GetSecurity(), itr->second->GetLevel(),
-            itr->second->GetClass(), itr->second->GetRace(), itr->second->GetZoneId(), itr->second->GetNativeGender(), itr->second->IsVisible(),
-            itr->second->IsGameMaster(), widePlayerName, wideGuildName, playerName, guildName, guildGuid);
+    for (uint32 i = 0; i < _whoListStorage.size(); ++i)
+    {
+        _playersByLevel[_whoListStorage[i].GetLevel()].push_back(i);
+        _playersByZone[_whoListStorage[i].GetZoneId()].push_back(i);
+    }
+
+    // zones nobody was in for a whole update
+    for (auto itr = _playersByZone.begin(); itr != _playersByZone.end();)
+    {
+        if (itr->second.empty())
+            itr = _playersByZone.erase(itr);
+        else
+            ++itr;
     }
 }
@@ -19,15 +19,23 @@
 #define _WHOLISTSTORAGE_H
 
 #include "Common.h"
+#include "Containers.h"
+#include "DBCEnums.h"
 #include "ObjectGuid.h"
+#include <array>
+#include <span>
+#include <unordered_map>
 
 class WhoListPlayerInfo
 {
+    friend class WhoListStorageMgr;
+
 public:
     WhoListPlayerInfo(ObjectGuid guid, uint32 team, AccountTypes security, uint8 level, uint8 clss, uint8 race, uint32 zoneid, uint8 gender, bool visible, bool gamemaster, std::wstring const& widePlayerName,
         std::wstring const& wideGuildName, std::string const& playerName, std::string const& guildName, ObjectGuid guildguid) :
         _guid(guid), _team(team), _security(security), _level(level), _class(clss), _race(race), _zoneid(zoneid), _gender(gender), _visible(visible),
-        _gamemaster(gamemaster), _widePlayerName(widePlayerName), _wideGuildName(wideGuildName), _playerName(playerName), _guildName(guildName), _guildguid(guildguid) {}
+        _gamemaster(gamemaster), _widePlayerName(widePlayerName), _wideGuildName(wideGuildName), _playerName(playerName), _guildName(guildName), _guildguid(guildguid),
+        _updateGeneration(0) {}
 
     ObjectGuid GetGuid() const { return _guid; }
     uint32 GetTeam() const { return _team; }
@@ -61,6 +69,7 @@ private:
     std::string _playerName;
     std::string _guildName;
     ObjectGuid _guildguid;
+    uint32 _updateGeneration;                               // last WhoListStorageMgr::Update that found the player online
 };
 
 typedef std::vector<WhoListPlayerInfo> WhoListInfoVector;
@@ -68,17 +77,66 @@ typedef std::vector<WhoListPlayerInfo> WhoListInfoVector;
 class TC_GAME_API WhoListStorageMgr
 {
 private:
-    WhoListStorageMgr() { };
+    WhoListStorageMgr() : _updateGeneration(0) { };
     ~WhoListStorageMgr() { };
 
 public:
     static WhoListStorageMgr* instance();
 
+    /// Refreshes entries of online players in place, names are only converted again when they changed
     void Update();
     WhoListInfoVector const& GetWhoList() const { return _whoListStorage; }
 
+    /// Calls visitor for every entry that can match the level range and areas, from the smaller of the level and zone indexes
+    /// Visiting stops when visitor returns false
+    template<typename Visitor>
+    void VisitCandidates(int32 minLevel, int32 maxLevel, std::span<int32 const> areas, Visitor&& visitor) const
+    {
+        minLevel = std::max(minLevel, 0);
+        maxLevel = std::min<int32>(maxLevel, _playersByLevel.size() - 1);
+
+        std::size_t levelCandidates = 0;
+        for (int32 level = minLevel; level <= maxLevel; ++level)
+            levelCandidates += _playersByLevel[level].size();
+
+        if (!areas.empty())
+        {
+            std::size_t zoneCandidates = 0;
+            for (int32 area : areas)
+                if (std::vector<uint32> const* players = Trinity::Containers::MapGetValuePtr(_playersByZone, uint32(area)))
+                    zoneCandidates += players->size();
+
+            if (zoneCandidates < levelCandidates)
+            {
+                for (std::size_t i = 0; i < areas.size(); ++i)
+                {
+                    // client can send the same zone more than once
+                    if (std::find(areas.begin(), areas.begin() + i, areas[i]) != areas.begin() + i)
+                        continue;
+
+                    if (std::vector<uint32> const* players = Trinity::Containers::MapGetValuePtr(_playersByZone, uint32(areas[i])))
+                        for (uint32 index : *players)
+                            if (!visitor(_whoListStorage[index]))
+                                return;
+                }
+                return;
+            }
+        }
+
+        for (int32 level = minLevel; level <= maxLevel; ++level)
+            for (uint32 index : _playersByLevel[level])
+                if (!visitor(_whoListStorage[index]))
+                    return;
+    }
+
 protected:
+    void RebuildIndexes();
+
     WhoListInfoVector _whoListStorage;
+    std::unordered_map<ObjectGuid, uint32> _storageIndexByGuid;
+    std::array<std::vector<uint32>, STRONG_MAX_LEVEL + 1> _playersByLevel;
+    std::unordered_map<uint32, std::vector<uint32>> _playersByZone;
+    uint32 _updateGeneration;
 };
 
 #define sWhoListStorageMgr WhoListStorageMgr::instance()
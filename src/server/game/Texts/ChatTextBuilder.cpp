@@ -28,9 +28,9 @@ namespace Trinity
 {
 ChatPacketSender::ChatPacketSender(ChatMsg chatType, ::Language language, WorldObject const* sender, WorldObject const* receiver,
     std::string message, uint32 achievementId /*= 0*/, LocaleConstant locale /*= LOCALE_enUS*/)
-    : Type(chatType), Language(language), Sender(sender), Receiver(receiver), Text(std::move(message)), AchievementId(achievementId), Locale(locale)
+    : Language(language), Text(std::move(message))
 {
-    UntranslatedPacket.Initialize(Type, Language, Sender, Receiver, Text, AchievementId, "", Locale);
+    UntranslatedPacket.Initialize(chatType, Language, sender, receiver, Text, achievementId, "", locale);
     UntranslatedPacket.Write();
 }
 
@@ -42,13 +42,12 @@ void ChatPacketSender::operator()(Player const* player) const
         return;
     }
 
-    if (!TranslatedPacket)
+    std::call_once(TranslatedPacketBuilt, [&]
     {
-        TranslatedPacket.emplace();
-        TranslatedPacket->Initialize(Type, Language, Sender, Receiver, sLanguageMgr->Translate(Text, Language, player->GetSession()->GetSessionDbcLocale()),
-            AchievementId, "", Locale);
+        TranslatedPacket.emplace(UntranslatedPacket);
+        TranslatedPacket->ChatText = sLanguageMgr->Translate(Text, Language, player->GetSession()->GetSessionDbcLocale());
         TranslatedPacket->Write();
-    }
+    });
 
     player->SendDirectMessage(TranslatedPacket->GetRawPacket());
 }
@@ -21,6 +21,7 @@
 #include "Common.h"
 #include "ChatPackets.h"
 #include "SharedDefines.h"
+#include <mutex>
 #include <string>
 
 class Player;
@@ -28,22 +29,19 @@ class WorldObject;
 
 namespace Trinity
 {
+    // does not reference sender or receiver after construction, may be kept around and used from any thread
     class ChatPacketSender
     {
     private:
         // params
-        ChatMsg Type;
         ::Language Language;
-        WorldObject const* Sender;
-        WorldObject const* Receiver;
         std::string Text;
-        uint32 AchievementId;
-        LocaleConstant Locale;
 
     public:
         // caches
         WorldPackets::Chat::Chat UntranslatedPacket;
         mutable Optional<WorldPackets::Chat::Chat> TranslatedPacket;
+        mutable std::once_flag TranslatedPacketBuilt;
 
         ChatPacketSender(ChatMsg chatType, ::Language language, WorldObject const* sender, WorldObject const* receiver, std::string message,
             uint32 achievementId = 0, LocaleConstant locale = LOCALE_enUS);
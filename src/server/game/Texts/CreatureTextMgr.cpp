@@ -31,6 +31,31 @@
 #include "ObjectMgr.h"
 #include "World.h"
 
+namespace
+{
+class CachedCreatureTextBuilder
+{
+public:
+    CachedCreatureTextBuilder(Trinity::CreatureTextTextBuilder const& builder, CreatureTextPacketKey const& key) : _builder(builder), _key(key) { }
+
+    std::shared_ptr<Trinity::ChatPacketSender> operator()(LocaleConstant locale) const
+    {
+        CreatureTextPacketKey key = _key;
+        key.Locale = locale;
+        if (std::shared_ptr<Trinity::ChatPacketSender> packet = sCreatureTextMgr->GetCachedChatPacket(key))
+            return packet;
+
+        std::shared_ptr<Trinity::ChatPacketSender> packet(_builder(locale));
+        sCreatureTextMgr->CacheChatPacket(key, packet);
+        return packet;
+    }
+
+private:
+    Trinity::CreatureTextTextBuilder const& _builder;
+    CreatureTextPacketKey _key;
+};
+}
+
 CreatureTextMgr::CreatureTextMgr() = default;
 CreatureTextMgr::~CreatureTextMgr() = default;
 
@@ -45,6 +70,7 @@ void CreatureTextMgr::LoadCreatureTexts()
     uint32 oldMSTime = getMSTime();
 
     mTextMap.clear(); // for reload case
+    ClearChatPacketCache();
     //all currently used temp texts are NOT reset
 
     WorldDatabasePreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_CREATURE_TEXT);
@@ -144,6 +170,7 @@ void CreatureTextMgr::LoadCreatureTextLocales()
     uint32 oldMSTime = getMSTime();
 
     mLocaleTextMap.clear(); // for reload case
+    ClearChatPacketCache();
 
     QueryResult result = WorldDatabase.Query("SELECT CreatureId, GroupId, ID, Locale, Text FROM creature_text_locale");
 
@@ -242,14 +269,45 @@ uint32 CreatureTextMgr::SendChat(Creature* source, uint8 textGroup, WorldObject
     }
     else
     {
+        // player speakers are not cached, their chat flags and guild are part of the packet
         Trinity::CreatureTextTextBuilder builder(finalSource, finalSource, finalSource->GetGender(), finalType, iter->groupId, iter->id, finalLang, whisperTarget);
-        SendChatPacket(finalSource, builder, finalType, whisperTarget, range, team, gmOnly);
+        CreatureTextPacketKey key{ source->GetEntry(), iter->groupId, iter->id, finalSource->GetGender(), finalType, finalLang, finalSource->GetGUID(),
+            whisperTarget ? whisperTarget->GetGUID() : ObjectGuid::Empty, LOCALE_enUS };
+        SendChatPacket(finalSource, CachedCreatureTextBuilder(builder, key), finalType, whisperTarget, range, team, gmOnly);
     }
 
     source->SetTextRepeatId(textGroup, iter->id);
     return iter->duration;
 }
 
+std::shared_ptr<Trinity::ChatPacketSender> CreatureTextMgr::GetCachedChatPacket(CreatureTextPacketKey const& key)
+{
+    std::lock_guard<std::mutex> lock(_chatPacketCacheLock);
+    auto itr = _chatPacketCache.find(key);
+    return itr != _chatPacketCache.end() ? itr->second : nullptr;
+}
+
+void CreatureTextMgr::CacheChatPacket(CreatureTextPacketKey const& key, std::shared_ptr<Trinity::ChatPacketSender> packet)
+{
+    std::lock_guard<std::mutex> lock(_chatPacketCacheLock);
+    if (!_chatPacketCache.try_emplace(key, std::move(packet)).second)
+        return;
+
+    _chatPacketCacheOrder.push_back(key);
+    if (_chatPacketCacheOrder.size() > MaxCachedChatPackets)
+    {
+        _chatPacketCache.erase(_chatPacketCacheOrder.front());
+        _chatPacketCacheOrder.pop_front();
+    }
+}
+
+void CreatureTextMgr::ClearChatPacketCache()
+{
+    std::lock_guard<std::mutex> lock(_chatPacketCacheLock);
+    _chatPacketCache.clear();
+    _chatPacketCacheOrder.clear();
+}
+
 float CreatureTextMgr::GetRangeForChatType(ChatMsg msgType)
 {
     float dist = sWorld->getFloatConfig(CONFIG_LISTEN_RANGE_SAY);
@@ -19,8 +19,12 @@
 #define TRINITY_CREATURE_TEXT_MGR_H
 
 #include "Common.h"
+#include "ObjectGuid.h"
 #include "SharedDefines.h"
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -30,6 +34,11 @@ class Unit;
 class WorldObject;
 class WorldPacket;
 
+namespace Trinity
+{
+    class ChatPacketSender;
+}
+
 enum CreatureTextRange
 {
     TEXT_RANGE_NORMAL   = 0,
@@ -86,6 +95,22 @@ typedef std::unordered_map<uint32, CreatureTextHolder> CreatureTextMap;     // a
 
 typedef std::map<CreatureTextId, CreatureTextLocale> LocaleCreatureTextMap;
 
+// everything a creature text chat packet is built from
+struct CreatureTextPacketKey
+{
+    friend std::strong_ordering operator<=>(CreatureTextPacketKey const& left, CreatureTextPacketKey const& right) = default;
+
+    uint32 Entry;
+    uint8 TextGroup;
+    uint32 TextId;
+    uint8 Gender;
+    ChatMsg Type;
+    Language Lang;
+    ObjectGuid Talker;
+    ObjectGuid Target;
+    LocaleConstant Locale;
+};
+
 class TC_GAME_API CreatureTextMgr
 {
     private:
@@ -118,11 +143,22 @@ class TC_GAME_API CreatureTextMgr
 
         static float GetRangeForChatType(ChatMsg msgType);
 
+        // packets of texts said by creatures, kept across sends so repeated texts are not built again for every locale
+        std::shared_ptr<Trinity::ChatPacketSender> GetCachedChatPacket(CreatureTextPacketKey const& key);
+        void CacheChatPacket(CreatureTextPacketKey const& key, std::shared_ptr<Trinity::ChatPacketSender> packet);
+        void ClearChatPacketCache();
+
+        static constexpr std::size_t MaxCachedChatPackets = 4096;
+
     private:
         static void SendNonChatPacket(WorldObject* source, WorldPacket const* data, ChatMsg msgType, WorldObject const* whisperTarget, CreatureTextRange range, Team team, bool gmOnly);
 
         CreatureTextMap mTextMap;
         LocaleCreatureTextMap mLocaleTextMap;
+
+        std::mutex _chatPacketCacheLock;
+        std::map<CreatureTextPacketKey, std::shared_ptr<Trinity::ChatPacketSender>> _chatPacketCache;
+        std::deque<CreatureTextPacketKey> _chatPacketCacheOrder;   // oldest first, evicted when the cache is full
 };
 
 #define sCreatureTextMgr CreatureTextMgr::instance()
@@ -37,16 +37,12 @@ public:
     void operator()(Player const* player) const
     {
         LocaleConstant loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-        Trinity::ChatPacketSender* sender;
 
         // create if not cached yet
         if (!_cache[loc_idx])
-        {
-            sender = _builder(loc_idx);
-            _cache[loc_idx].reset(sender);
-        }
-        else
-            sender = _cache[loc_idx].get();
+            _cache[loc_idx] = MakeShared(_builder(loc_idx));
+
+        Trinity::ChatPacketSender* sender = _cache[loc_idx].get();
 
         switch (_msgType)
         {
@@ -66,7 +62,11 @@ public:
     }
 
 private:
-    mutable std::array<std::unique_ptr<Trinity::ChatPacketSender>, TOTAL_LOCALES> _cache;
+    // builders either return a new sender or one shared with CreatureTextMgr's packet cache
+    static std::shared_ptr<Trinity::ChatPacketSender> MakeShared(Trinity::ChatPacketSender* sender) { return std::shared_ptr<Trinity::ChatPacketSender>(sender); }
+    static std::shared_ptr<Trinity::ChatPacketSender> MakeShared(std::shared_ptr<Trinity::ChatPacketSender> sender) { return sender; }
+
+    mutable std::array<std::shared_ptr<Trinity::ChatPacketSender>, TOTAL_LOCALES> _cache;
     Builder const& _builder;
     ChatMsg _msgType;
 };
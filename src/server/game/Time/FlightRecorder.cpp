@@ -0,0 +1,205 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FlightRecorder.h"
+#include "Creature.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+#include "Map.h"
+#include "Opcodes.h"
+#include "StringFormat.h"
+#include "World.h"
+#include <algorithm>
+
+static_assert(FlightRecorder::MaxOpcodes == NUM_OPCODE_HANDLERS);
+
+namespace
+{
+void AppendJsonString(std::string& out, std::string_view value)
+{
+    out.push_back('"');
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+            out.push_back('\\');
+        if (uint8(c) >= 0x20)
+            out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+template<typename T, typename Compare>
+void KeepFirst(std::vector<T>& values, std::size_t count, Compare compare)
+{
+    if (values.size() > count)
+    {
+        std::partial_sort(values.begin(), values.begin() + count, values.end(), compare);
+        values.resize(count);
+    }
+    else
+        std::sort(values.begin(), values.end(), compare);
+}
+}
+
+FlightRecorder::FlightRecorder() : _enabled(false), _worldTickThreshold(0), _mapUpdateThreshold(0), _opcodes(), _usedOpcodes(), _usedOpcodeCount(0)
+{
+}
+
+FlightRecorder* FlightRecorder::instance()
+{
+    static FlightRecorder instance;
+    return &instance;
+}
+
+FlightRecorder::WorldTick::WorldTick(uint32 diff) : _diff(diff)
+{
+    sFlightRecorder->BeginWorldTick();
+    _start = std::chrono::steady_clock::now();
+}
+
+FlightRecorder::WorldTick::~WorldTick()
+{
+    sFlightRecorder->EndWorldTick(_diff, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - _start));
+}
+
+FlightRecorder::WorldPhase::~WorldPhase()
+{
+    if (sFlightRecorder->IsEnabled())
+        sFlightRecorder->_phases.emplace_back(_name, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - _start));
+}
+
+void FlightRecorder::BeginWorldTick()
+{
+    _worldTickThreshold = Milliseconds(sWorld->getIntConfig(CONFIG_FLIGHT_RECORDER_WORLD_TICK_THRESHOLD));
+    _mapUpdateThreshold.store(int64(sWorld->getIntConfig(CONFIG_FLIGHT_RECORDER_MAP_UPDATE_THRESHOLD)) * 1000, std::memory_order_relaxed);
+    _enabled.store(_worldTickThreshold > 0ms || _mapUpdateThreshold.load(std::memory_order_relaxed) > 0, std::memory_order_relaxed);
+}
+
+void FlightRecorder::RecordOpcode(uint16 opcode, Microseconds duration)
+{
+    if (opcode >= MaxOpcodes)
+        return;
+
+    OpcodeStats& stats = _opcodes[opcode];
+    if (stats.Count.fetch_add(1, std::memory_order_relaxed) == 0)
+        _usedOpcodes[_usedOpcodeCount.fetch_add(1, std::memory_order_relaxed)].store(opcode, std::memory_order_relaxed);
+
+    stats.Duration.fetch_add(duration.count(), std::memory_order_relaxed);
+}
+
+void FlightRecorder::RecordScript(Creature const& creature, Microseconds duration)
+{
+    if (duration < ScriptRecordThreshold)
+        return;
+
+    std::string scriptName = creature.GetScriptName();
+    if (scriptName.empty())
+        scriptName = Trinity::StringFormat("creature {}", creature.GetEntry());
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_scripts.size() < MaxRecordedScripts)
+        _scripts.push_back({ std::move(scriptName), duration });
+}
+
+void FlightRecorder::RecordMapUpdate(Map& map, Microseconds duration)
+{
+    MapStats stats{ map.GetId(), map.GetInstanceId(), duration, map.GetPlayersCountExceptGMs(), uint32(map.GetObjectsStore().Size<Creature>()) };
+
+    int64 threshold = _mapUpdateThreshold.load(std::memory_order_relaxed);
+    if (threshold > 0 && duration.count() >= threshold)
+        TC_LOG_INFO("server.flightrecorder", R"({{"type":"map_update","map_id":{},"instance_id":{},"us":{},"players":{},"creatures":{}}})",
+            stats.Id, stats.InstanceId, stats.Duration.count(), stats.Players, stats.Creatures);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _maps.push_back(stats);
+}
+
+void FlightRecorder::EndWorldTick(uint32 diff, Microseconds duration)
+{
+    // map threads are idle at this point, nothing records concurrently
+    if (IsEnabled() && _worldTickThreshold > 0ms && duration >= _worldTickThreshold)
+    {
+        std::string json = Trinity::StringFormat(R"({{"type":"world_tick","us":{},"diff_ms":{},"phases":[)", duration.count(), diff);
+        for (std::size_t i = 0; i < _phases.size(); ++i)
+        {
+            if (i)
+                json.push_back(',');
+            json.append(R"({"name":)");
+            AppendJsonString(json, _phases[i].first);
+            json.append(Trinity::StringFormat(R"(,"us":{}}})", _phases[i].second.count()));
+        }
+
+        std::vector<std::pair<uint16, Microseconds>> opcodes;
+        opcodes.reserve(_usedOpcodeCount.load(std::memory_order_relaxed));
+        for (uint32 i = 0; i < _usedOpcodeCount.load(std::memory_order_relaxed); ++i)
+        {
+            uint16 opcode = _usedOpcodes[i].load(std::memory_order_relaxed);
+            opcodes.emplace_back(opcode, Microseconds(_opcodes[opcode].Duration.load(std::memory_order_relaxed)));
+        }
+        KeepFirst(opcodes, ReportedEntries, [](auto const& left, auto const& right) { return left.second > right.second; });
+
+        json.append(R"(],"opcodes":[)");
+        for (std::size_t i = 0; i < opcodes.size(); ++i)
+        {
+            if (i)
+                json.push_back(',');
+            json.append(R"({"name":)");
+            ClientOpcodeHandler const* handler = opcodeTable[OpcodeClient(opcodes[i].first)];
+            AppendJsonString(json, handler ? handler->Name : "UNKNOWN");
+            json.append(Trinity::StringFormat(R"(,"count":{},"us":{}}})", _opcodes[opcodes[i].first].Count.load(std::memory_order_relaxed), opcodes[i].second.count()));
+        }
+
+        KeepFirst(_maps, ReportedEntries, [](MapStats const& left, MapStats const& right) { return left.Duration > right.Duration; });
+        json.append(R"(],"maps":[)");
+        for (std::size_t i = 0; i < _maps.size(); ++i)
+        {
+            if (i)
+                json.push_back(',');
+            json.append(Trinity::StringFormat(R"({{"map_id":{},"instance_id":{},"us":{},"players":{},"creatures":{}}})",
+                _maps[i].Id, _maps[i].InstanceId, _maps[i].Duration.count(), _maps[i].Players, _maps[i].Creatures));
+        }
+
+        KeepFirst(_scripts, ReportedEntries, [](ScriptStats const& left, ScriptStats const& right) { return left.Duration > right.Duration; });
+        json.append(R"(],"scripts":[)");
+        for (std::size_t i = 0; i < _scripts.size(); ++i)
+        {
+            if (i)
+                json.push_back(',');
+            json.append(R"({"name":)");
+            AppendJsonString(json, _scripts[i].Name);
+            json.append(Trinity::StringFormat(R"(,"us":{}}})", _scripts[i].Duration.count()));
+        }
+
+        json.append(Trinity::StringFormat(R"(],"db_queue":{{"login":{},"character":{},"world":{}}}}})",
+            LoginDatabase.QueueSize(), CharacterDatabase.QueueSize(), WorldDatabase.QueueSize()));
+
+        TC_LOG_INFO("server.flightrecorder", "{}", json);
+    }
+
+    _phases.clear();
+    for (uint32 i = 0; i < _usedOpcodeCount.load(std::memory_order_relaxed); ++i)
+    {
+        OpcodeStats& stats = _opcodes[_usedOpcodes[i].load(std::memory_order_relaxed)];
+        stats.Count.store(0, std::memory_order_relaxed);
+        stats.Duration.store(0, std::memory_order_relaxed);
+    }
+    _usedOpcodeCount.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _maps.clear();
+    _scripts.clear();
+}
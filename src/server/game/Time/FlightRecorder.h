@@ -0,0 +1,124 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_FLIGHTRECORDER_H
+#define TRINITY_FLIGHTRECORDER_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Creature;
+class Map;
+
+/**
+ * Collects what happened during a world tick and writes it to the server.flightrecorder
+ * log as one JSON line when the tick, or a single map update, took longer than configured.
+ *
+ * Nothing is collected unless FlightRecorder.WorldTickThreshold or FlightRecorder.MapUpdateThreshold is set.
+ */
+class TC_GAME_API FlightRecorder
+{
+public:
+    static FlightRecorder* instance();
+
+    bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    class TC_GAME_API WorldTick
+    {
+    public:
+        explicit WorldTick(uint32 diff);
+        ~WorldTick();
+
+    private:
+        uint32 _diff;
+        TimePoint _start;
+    };
+
+    class TC_GAME_API WorldPhase
+    {
+    public:
+        explicit WorldPhase(char const* name) : _name(name), _start(std::chrono::steady_clock::now()) { }
+        ~WorldPhase();
+
+    private:
+        char const* _name;
+        TimePoint _start;
+    };
+
+    // thread safe, may be called from map threads
+    void RecordOpcode(uint16 opcode, Microseconds duration);
+    void RecordScript(Creature const& creature, Microseconds duration);
+    void RecordMapUpdate(Map& map, Microseconds duration);
+
+    // matches NUM_OPCODE_HANDLERS
+    static constexpr std::size_t MaxOpcodes = 0x4000;
+    // AI updates faster than this are not worth reporting and are not recorded
+    static constexpr Microseconds ScriptRecordThreshold = Microseconds(100);
+    static constexpr std::size_t MaxRecordedScripts = 256;
+    static constexpr std::size_t ReportedEntries = 10;
+
+private:
+    FlightRecorder();
+
+    void BeginWorldTick();
+    void EndWorldTick(uint32 diff, Microseconds duration);
+
+    struct OpcodeStats
+    {
+        std::atomic<uint32> Count;
+        std::atomic<int64> Duration;
+    };
+
+    struct MapStats
+    {
+        uint32 Id;
+        uint32 InstanceId;
+        Microseconds Duration;
+        uint32 Players;
+        uint32 Creatures;
+    };
+
+    struct ScriptStats
+    {
+        std::string Name;
+        Microseconds Duration;
+    };
+
+    std::atomic<bool> _enabled;
+    Milliseconds _worldTickThreshold;
+    std::atomic<int64> _mapUpdateThreshold;  // microseconds
+
+    // world thread only
+    std::vector<std::pair<char const*, Microseconds>> _phases;
+
+    std::array<OpcodeStats, MaxOpcodes> _opcodes;
+    std::array<std::atomic<uint16>, MaxOpcodes> _usedOpcodes;  // opcodes with a non zero count, to reset only them
+    std::atomic<uint32> _usedOpcodeCount;
+
+    std::mutex _lock;
+    std::vector<MapStats> _maps;
+    std::vector<ScriptStats> _scripts;
+};
+
+#define sFlightRecorder FlightRecorder::instance()
+
+#endif // TRINITY_FLIGHTRECORDER_H
@@ -21,17 +21,143 @@
 #include "DatabaseEnv.h"
 #include "DB2Stores.h"
 #include "Log.h"
+#include "QueryCallback.h"
 #include "World.h"
 #include "SpellMgr.h"
 #include "SpellInfo.h"
 #include <sstream>
 
+namespace
+{
+struct BackgroundCleaningPass
+{
+    CharacterDatabaseCleaner::CleaningFlags Flag;
+    char const* Column;
+    char const* Table;
+    bool (*Check)(uint32);          // nullptr deletes every row of the batch matching Filter, key is a bigint character guid
+    char const* Filter;
+
+    uint64 GetKey(Field const* fields) const { return Check ? fields[0].GetUInt32() : fields[0].GetUInt64(); }
+};
+
+BackgroundCleaningPass const BackgroundCleaningPasses[] =
+{
+    { CharacterDatabaseCleaner::CLEANING_FLAG_ACHIEVEMENT_PROGRESS, "criteria", "character_achievement_progress", &CharacterDatabaseCleaner::AchievementProgressCheck, nullptr },
+    { CharacterDatabaseCleaner::CLEANING_FLAG_SKILLS, "skill", "character_skills", &CharacterDatabaseCleaner::SkillCheck, nullptr },
+    { CharacterDatabaseCleaner::CLEANING_FLAG_SPELLS, "spell", "character_spell", &CharacterDatabaseCleaner::SpellCheck, nullptr },
+    { CharacterDatabaseCleaner::CLEANING_FLAG_TALENTS, "talentId", "character_talent", &CharacterDatabaseCleaner::TalentCheck, nullptr },
+    { CharacterDatabaseCleaner::CLEANING_FLAG_QUESTSTATUS, "guid", "character_queststatus", nullptr, "status = 0" },
+};
+
+struct BackgroundCleaningState
+{
+    bool Initialized = false;
+    bool BatchInProgress = false;
+    uint32 PendingFlags = 0;        // passes not finished yet, lowest bit first
+    uint64 LastKey = 0;             // keyset position inside the current pass
+    uint32 BatchTimer = 0;
+    QueryCallbackProcessor QueryProcessor;
+};
+
+BackgroundCleaningState BackgroundCleaning;
+
+BackgroundCleaningPass const* GetCurrentBackgroundPass()
+{
+    for (BackgroundCleaningPass const& pass : BackgroundCleaningPasses)
+        if (BackgroundCleaning.PendingFlags & pass.Flag)
+            return &pass;
+
+    return nullptr;
+}
+
+void SaveBackgroundCleaningProgress()
+{
+    sWorld->SetPersistentWorldVariable(World::CharacterDatabaseCleaningPendingVarId, int32(BackgroundCleaning.PendingFlags));
+    // world variables are 32 bit, keys are guids
+    sWorld->SetPersistentWorldVariable(World::CharacterDatabaseCleaningProgressVarId, int32(uint32(BackgroundCleaning.LastKey)));
+    sWorld->SetPersistentWorldVariable(World::CharacterDatabaseCleaningProgressHighVarId, int32(uint32(BackgroundCleaning.LastKey >> 32)));
+}
+
+void HandleBackgroundCleaningBatch(BackgroundCleaningPass const& pass, QueryResult result)
+{
+    BackgroundCleaning.BatchInProgress = false;
+
+    uint64 rowCount = result ? result->GetRowCount() : 0;
+    if (result)
+    {
+        uint64 firstKey = pass.GetKey(result->Fetch());
+        bool found = false;
+        std::ostringstream ss;
+        do
+        {
+            uint64 key = pass.GetKey(result->Fetch());
+            BackgroundCleaning.LastKey = key;
+
+            if (!pass.Check || pass.Check(uint32(key)))
+                continue;
+
+            ss << (found ? "," : "") << key;
+            found = true;
+        }
+        while (result->NextRow());
+
+        if (!pass.Check)
+            CharacterDatabase.PExecute("DELETE FROM {} WHERE {} BETWEEN {} AND {} AND {}", pass.Table, pass.Column, firstKey, BackgroundCleaning.LastKey, pass.Filter);
+        else if (found)
+            CharacterDatabase.PExecute("DELETE FROM {} WHERE {} IN ({})", pass.Table, pass.Column, ss.str());
+    }
+
+    if (rowCount < sWorld->getIntConfig(CONFIG_CLEAN_CHARACTER_DB_BATCH_SIZE))
+    {
+        TC_LOG_INFO("misc", "Background character database cleaning finished table {}.", pass.Table);
+        BackgroundCleaning.PendingFlags &= ~pass.Flag;
+        BackgroundCleaning.LastKey = 0;
+    }
+
+    SaveBackgroundCleaningProgress();
+}
+
+void StartBackgroundCleaning()
+{
+    BackgroundCleaning.Initialized = true;
+
+    // resume a run interrupted by shutdown, otherwise start a new one from the requested flags
+    BackgroundCleaning.PendingFlags = uint32(sWorld->GetPersistentWorldVariable(World::CharacterDatabaseCleaningPendingVarId));
+    BackgroundCleaning.LastKey = uint64(uint32(sWorld->GetPersistentWorldVariable(World::CharacterDatabaseCleaningProgressHighVarId))) << 32
+        | uint32(sWorld->GetPersistentWorldVariable(World::CharacterDatabaseCleaningProgressVarId));
+    if (!BackgroundCleaning.PendingFlags)
+    {
+        uint32 flags = sWorld->GetPersistentWorldVariable(World::CharacterDatabaseCleaningFlagsVarId);
+        BackgroundCleaning.PendingFlags = flags;
+        BackgroundCleaning.LastKey = 0;
+
+        flags &= sWorld->getIntConfig(CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS);
+        sWorld->SetPersistentWorldVariable(World::CharacterDatabaseCleaningFlagsVarId, flags);
+        sWorld->SetCleaningFlags(flags);
+
+        if (BackgroundCleaning.PendingFlags & CharacterDatabaseCleaner::CLEANING_FLAG_TALENTS)
+            CharacterDatabase.PExecute("DELETE FROM character_talent WHERE talentGroup > {}", MAX_SPECIALIZATIONS);
+
+        SaveBackgroundCleaningProgress();
+    }
+
+    if (BackgroundCleaning.PendingFlags)
+        TC_LOG_INFO("misc", "Cleaning character database in background (flags {}, resuming after key {})...", BackgroundCleaning.PendingFlags, BackgroundCleaning.LastKey);
+}
+}
+
 void CharacterDatabaseCleaner::CleanDatabase()
 {
     // config to disable
     if (!sWorld->getBoolConfig(CONFIG_CLEAN_CHARACTER_DB))
         return;
 
+    if (sWorld->getBoolConfig(CONFIG_CLEAN_CHARACTER_DB_BACKGROUND))
+    {
+        TC_LOG_INFO("server.loading", ">> Character database will be cleaned in background after startup");
+        return;
+    }
+
     TC_LOG_INFO("misc", "Cleaning character database...");
 
     uint32 oldMSTime = getMSTime();
@@ -64,6 +190,42 @@ void CharacterDatabaseCleaner::CleanDatabase()
     TC_LOG_INFO("server.loading", ">> Cleaned character database in {} ms", GetMSTimeDiffToNow(oldMSTime));
 }
 
+void CharacterDatabaseCleaner::Update(uint32 diff)
+{
+    if (!sWorld->getBoolConfig(CONFIG_CLEAN_CHARACTER_DB) || !sWorld->getBoolConfig(CONFIG_CLEAN_CHARACTER_DB_BACKGROUND))
+        return;
+
+    if (!BackgroundCleaning.Initialized)
+        StartBackgroundCleaning();
+
+    BackgroundCleaning.QueryProcessor.ProcessReadyCallbacks();
+
+    if (BackgroundCleaning.BatchInProgress)
+        return;
+
+    BackgroundCleaningPass const* pass = GetCurrentBackgroundPass();
+    if (!pass)
+        return;
+
+    BackgroundCleaning.BatchTimer += diff;
+    if (BackgroundCleaning.BatchTimer < sWorld->getIntConfig(CONFIG_CLEAN_CHARACTER_DB_BATCH_INTERVAL))
+        return;
+
+    // back off while the database is busy with real work
+    if (CharacterDatabase.QueueSize() > sWorld->getIntConfig(CONFIG_CLEAN_CHARACTER_DB_MAX_QUEUE_SIZE))
+        return;
+
+    BackgroundCleaning.BatchTimer = 0;
+    BackgroundCleaning.BatchInProgress = true;
+
+    std::string sql = Trinity::StringFormat("SELECT DISTINCT {0} FROM {1} WHERE {0} > {2} ORDER BY {0} LIMIT {3}",
+        pass->Column, pass->Table, BackgroundCleaning.LastKey, sWorld->getIntConfig(CONFIG_CLEAN_CHARACTER_DB_BATCH_SIZE));
+    BackgroundCleaning.QueryProcessor.AddCallback(CharacterDatabase.AsyncQuery(sql.c_str()).WithCallback([pass](QueryResult result)
+    {
+        HandleBackgroundCleaningBatch(*pass, std::move(result));
+    }));
+}
+
 void CharacterDatabaseCleaner::CheckUnique(char const* column, char const* table, bool (*check)(uint32))
 {
     QueryResult result = CharacterDatabase.PQuery("SELECT DISTINCT {} FROM {}", column, table);
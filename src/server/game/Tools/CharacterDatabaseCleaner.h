@@ -31,6 +31,9 @@ namespace CharacterDatabaseCleaner
 
     TC_GAME_API void CleanDatabase();
 
+    // Runs the cleanup passes in small batches while the realm is online, see CleanCharacterDB.Background
+    TC_GAME_API void Update(uint32 diff);
+
     TC_GAME_API void CheckUnique(char const* column, char const* table, bool (*check)(uint32));
 
     TC_GAME_API bool AchievementProgressCheck(uint32 criteria);
@@ -22,6 +22,7 @@
 #include "CryptoHash.h"
 #include "GameTime.h"
 #include "Log.h"
+#include "Random.h"
 #include "SmartEnum.h"
 #include "Util.h"
 #include "WardenPackets.h"
@@ -33,6 +34,8 @@
 Warden::Warden() : _session(nullptr), _checkTimer(10 * IN_MILLISECONDS), _clientResponseTimer(0),
                    _dataSent(false), _initialized(false)
 {
+    // Spread the first request over the hold off period, sessions created at the same time would otherwise stay in lockstep
+    _checkTimer += urand(0, sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_CHECK_HOLDOFF) * IN_MILLISECONDS);
 }
 
 Warden::~Warden()
@@ -123,12 +126,39 @@ void Warden::Update(uint32 diff)
     else
     {
         if (diff >= _checkTimer)
-            RequestChecks();
+        {
+            _checkTimer = 0;
+            if (ReserveCheckRequest())
+                RequestChecks();
+        }
         else
             _checkTimer -= diff;
     }
 }
 
+bool Warden::ReserveCheckRequest()
+{
+    // Warden is only updated from WorldSession::Update on the world thread
+    static uint32 updateTime = 0;
+    static uint32 requestsThisUpdate = 0;
+
+    uint32 maxRequests = sWorld->getIntConfig(CONFIG_WARDEN_MAX_CHECK_REQUESTS_PER_UPDATE);
+    if (!maxRequests)
+        return true;
+
+    if (updateTime != GameTime::GetGameTimeMS())
+    {
+        updateTime = GameTime::GetGameTimeMS();
+        requestsThisUpdate = 0;
+    }
+
+    if (requestsThisUpdate >= maxRequests)
+        return false;
+
+    ++requestsThisUpdate;
+    return true;
+}
+
 void Warden::DecryptData(uint8* buffer, uint32 length)
 {
     _inputCrypto.UpdateData(buffer, length);
@@ -241,7 +271,7 @@ void Warden::HandleData(ByteBuffer& buff)
     }
 }
 
-bool Warden::ProcessLuaCheckResponse(std::string const& msg)
+bool Warden::ProcessLuaCheckResponse(std::string_view msg)
 {
     static constexpr char WARDEN_TOKEN[] = "_TW\t";
     if (!StringStartsWith(msg, WARDEN_TOKEN))
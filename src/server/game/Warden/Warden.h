@@ -90,7 +90,7 @@ class TC_GAME_API Warden
         virtual void Init(WorldSession* session, SessionKey const& K) = 0;
         void Update(uint32 diff);
         void HandleData(ByteBuffer& buff);
-        bool ProcessLuaCheckResponse(std::string const& msg);
+        bool ProcessLuaCheckResponse(std::string_view msg);
 
         virtual size_t DEBUG_ForceSpecificChecks(std::vector<uint16> const& checks) = 0;
 
@@ -112,6 +112,9 @@ class TC_GAME_API Warden
         static bool IsValidCheckSum(uint32 checksum, const uint8 *data, const uint16 length);
         static uint32 BuildChecksum(const uint8 *data, uint32 length);
 
+        // Limits the number of check requests sent by all sessions during one world update
+        static bool ReserveCheckRequest();
+
         // If nullptr is passed, the default action from config is executed
         char const* ApplyPenalty(WardenCheck const* check);
 
@@ -50,6 +50,7 @@
 #include "DB2Stores.h"
 #include "DetourMemoryFunctions.h"
 #include "DisableMgr.h"
+#include "FlightRecorder.h"
 #include "GameEventMgr.h"
 #include "GameObjectModel.h"
 #include "GameTables.h"
@@ -61,6 +62,7 @@
 #include "GuildMgr.h"
 #include "InstanceLockMgr.h"
 #include "IPLocation.h"
+#include "IpAddress.h"
 #include "Language.h"
 #include "LanguageMgr.h"
 #include "LFGMgr.h"
@@ -70,12 +72,14 @@
 #include "M2Stores.h"
 #include "Map.h"
 #include "MapManager.h"
+#include "MemoryStats.h"
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "MMapFactory.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "OutdoorPvPMgr.h"
+#include "PacketReplay.h"
 #include "PetitionMgr.h"
 #include "Player.h"
 #include "PlayerDump.h"
@@ -84,14 +88,18 @@
 #include "Realm.h"
 #include "ScenarioMgr.h"
 #include "ScriptMgr.h"
+#include "ScriptProfiler.h"
 #include "ScriptReloadMgr.h"
 #include "SkillDiscovery.h"
 #include "SkillExtraItems.h"
 #include "SpellMgr.h"
 #include "SmartScriptMgr.h"
 #include "SupportMgr.h"
+#include "TaskGraph.h"
 #include "TaxiPathGraph.h"
 #include "TerrainMgr.h"
+#include "ThreadPool.h"
+#include "Trace.h"
 #include "TraitMgr.h"
 #include "TransportMgr.h"
 #include "Unit.h"
@@ -103,10 +111,12 @@
 #include "WeatherMgr.h"
 #include "WhoListStorage.h"
 #include "WorldSession.h"
+#include "WorldDatabaseSnapshot.h"
 #include "WorldSocket.h"
 #include "WorldStateMgr.h"
 
 #include <boost/algorithm/string.hpp>
+#include <span>
 
 TC_GAME_API std::atomic<bool> World::m_stopEvent(false);
 TC_GAME_API uint8 World::m_ExitCode = SHUTDOWN_EXIT_CODE;
@@ -132,6 +142,9 @@ PersistentWorldVariable const World::NextCurrencyResetTimeVarId{ "NextCurrencyRe
 PersistentWorldVariable const World::NextWeeklyQuestResetTimeVarId{ "NextWeeklyQuestResetTime" };
 PersistentWorldVariable const World::NextBGRandomDailyResetTimeVarId{ "NextBGRandomDailyResetTime" };
 PersistentWorldVariable const World::CharacterDatabaseCleaningFlagsVarId{ "PersistentCharacterCleanFlags" };
+PersistentWorldVariable const World::CharacterDatabaseCleaningPendingVarId{ "CharacterCleanPendingFlags" };
+PersistentWorldVariable const World::CharacterDatabaseCleaningProgressVarId{ "CharacterCleanProgress" };
+PersistentWorldVariable const World::CharacterDatabaseCleaningProgressHighVarId{ "CharacterCleanProgressHigh" };
 PersistentWorldVariable const World::NextGuildDailyResetTimeVarId{ "NextGuildDailyResetTime" };
 PersistentWorldVariable const World::NextMonthlyQuestResetTimeVarId{ "NextMonthlyQuestResetTime" };
 PersistentWorldVariable const World::NextDailyQuestResetTimeVarId{ "NextDailyQuestResetTime" };
@@ -761,9 +774,20 @@ void World::LoadConfigSettings(bool reload)
         TC_LOG_ERROR("server.loading", "Compression level ({}) must be in range 1..9. Using default compression level (1).", m_int_configs[CONFIG_COMPRESSION]);
         m_int_configs[CONFIG_COMPRESSION] = 1;
     }
+    m_int_configs[CONFIG_COMPRESSION_SKIP_RATIO] = sConfigMgr->GetIntDefault("Compression.SkipRatio", 0);
+    if (m_int_configs[CONFIG_COMPRESSION_SKIP_RATIO] > 100)
+    {
+        TC_LOG_ERROR("server.loading", "Compression.SkipRatio ({}) must be in range 0..100. Set to 0.", m_int_configs[CONFIG_COMPRESSION_SKIP_RATIO]);
+        m_int_configs[CONFIG_COMPRESSION_SKIP_RATIO] = 0;
+    }
+    m_int_configs[CONFIG_COMPRESSION_BUSY_THRESHOLD] = sConfigMgr->GetIntDefault("Compression.BusyThreshold", 0);
     m_bool_configs[CONFIG_ADDON_CHANNEL] = sConfigMgr->GetBoolDefault("AddonChannel", true);
     m_bool_configs[CONFIG_CLEAN_CHARACTER_DB] = sConfigMgr->GetBoolDefault("CleanCharacterDB", false);
     m_int_configs[CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS] = sConfigMgr->GetIntDefault("PersistentCharacterCleanFlags", 0);
+    m_bool_configs[CONFIG_CLEAN_CHARACTER_DB_BACKGROUND] = sConfigMgr->GetBoolDefault("CleanCharacterDB.Background", false);
+    m_int_configs[CONFIG_CLEAN_CHARACTER_DB_BATCH_SIZE] = std::max(1, sConfigMgr->GetIntDefault("CleanCharacterDB.Background.BatchSize", 1000));
+    m_int_configs[CONFIG_CLEAN_CHARACTER_DB_BATCH_INTERVAL] = sConfigMgr->GetIntDefault("CleanCharacterDB.Background.Interval", 1000);
+    m_int_configs[CONFIG_CLEAN_CHARACTER_DB_MAX_QUEUE_SIZE] = sConfigMgr->GetIntDefault("CleanCharacterDB.Background.MaxQueueSize", 100);
     m_int_configs[CONFIG_AUCTION_REPLICATE_DELAY] = sConfigMgr->GetIntDefault("Auction.ReplicateItemsCooldown", 900);
     m_int_configs[CONFIG_AUCTION_SEARCH_DELAY] = sConfigMgr->GetIntDefault("Auction.SearchDelay", 300);
     if (m_int_configs[CONFIG_AUCTION_SEARCH_DELAY] < 100 || m_int_configs[CONFIG_AUCTION_SEARCH_DELAY] > 10000)
@@ -777,6 +801,8 @@ void World::LoadConfigSettings(bool reload)
         TC_LOG_ERROR("server.loading", "Auction.TaintedSearchDelay ({}) must be between 100 and 10000. Using default of 3s", m_int_configs[CONFIG_AUCTION_SEARCH_DELAY]);
         m_int_configs[CONFIG_AUCTION_TAINTED_SEARCH_DELAY] = 3000;
     }
+    m_int_configs[CONFIG_AUCTION_BROWSE_THREADS] = sConfigMgr->GetIntDefault("Auction.BrowseThreads", 0);
+    m_int_configs[CONFIG_AUCTION_BROWSE_SNAPSHOT_INTERVAL] = sConfigMgr->GetIntDefault("Auction.BrowseSnapshotInterval", 1000);
     m_int_configs[CONFIG_CHAT_CHANNEL_LEVEL_REQ] = sConfigMgr->GetIntDefault("ChatLevelReq.Channel", 1);
     m_int_configs[CONFIG_CHAT_WHISPER_LEVEL_REQ] = sConfigMgr->GetIntDefault("ChatLevelReq.Whisper", 1);
     m_int_configs[CONFIG_CHAT_EMOTE_LEVEL_REQ] = sConfigMgr->GetIntDefault("ChatLevelReq.Emote", 1);
@@ -796,6 +822,7 @@ void World::LoadConfigSettings(bool reload)
         TC_LOG_ERROR("server.loading", "BaseMapLoadAllGrids enabled, but GridUnload also enabled. GridUnload must be disabled to enable base map pre-loading. Base map pre-loading disabled");
         m_bool_configs[CONFIG_BASEMAP_LOAD_GRIDS] = false;
     }
+    m_int_configs[CONFIG_BASEMAP_LOAD_GRIDS_THREADS] = sConfigMgr->GetIntDefault("BaseMapLoadAllGrids.Threads", 0);
     m_bool_configs[CONFIG_INSTANCEMAP_LOAD_GRIDS] = sConfigMgr->GetBoolDefault("InstanceMapLoadAllGrids", false);
     if (m_bool_configs[CONFIG_INSTANCEMAP_LOAD_GRIDS] && m_bool_configs[CONFIG_GRID_UNLOAD])
     {
@@ -805,6 +832,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_SAVE] = sConfigMgr->GetIntDefault("PlayerSaveInterval", 15 * MINUTE * IN_MILLISECONDS);
     m_int_configs[CONFIG_INTERVAL_DISCONNECT_TOLERANCE] = sConfigMgr->GetIntDefault("DisconnectToleranceInterval", 0);
     m_bool_configs[CONFIG_STATS_SAVE_ONLY_ON_LOGOUT] = sConfigMgr->GetBoolDefault("PlayerSave.Stats.SaveOnlyOnLogout", true);
+    m_bool_configs[CONFIG_PLAYER_SAVE_INCREMENTAL] = sConfigMgr->GetBoolDefault("PlayerSave.Incremental", true);
 
     m_int_configs[CONFIG_MIN_LEVEL_STAT_SAVE] = sConfigMgr->GetIntDefault("PlayerSave.Stats.MinLevel", 0);
     if (m_int_configs[CONFIG_MIN_LEVEL_STAT_SAVE] > MAX_LEVEL)
@@ -822,6 +850,9 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr->SetGridCleanUpDelay(m_int_configs[CONFIG_INTERVAL_GRIDCLEAN]);
 
+    m_int_configs[CONFIG_TERRAIN_MEMORY_BUDGET] = sConfigMgr->GetIntDefault("Terrain.MemoryBudget", 0);
+    sTerrainMgr.SetMemoryBudget(uint64(m_int_configs[CONFIG_TERRAIN_MEMORY_BUDGET]) * 1024 * 1024);
+
     m_int_configs[CONFIG_INTERVAL_MAPUPDATE] = sConfigMgr->GetIntDefault("MapUpdateInterval", 10);
     if (m_int_configs[CONFIG_INTERVAL_MAPUPDATE] < MIN_MAP_UPDATE_DELAY)
     {
@@ -842,11 +873,27 @@ void World::LoadConfigSettings(bool reload)
         val = sConfigMgr->GetIntDefault("InstanceServerPort", 8086);
         if (val != m_int_configs[CONFIG_PORT_INSTANCE])
             TC_LOG_ERROR("server.loading", "InstanceServerPort option can't be changed at worldserver.conf reload, using current value ({}).", m_int_configs[CONFIG_PORT_INSTANCE]);
+
+        // read by sessions on map threads, only set at startup
+        if (sConfigMgr->GetStringDefault("InstanceServerAddress", "") != _instanceServerAddress)
+            TC_LOG_ERROR("server.loading", "InstanceServerAddress option can't be changed at worldserver.conf reload, using current value ({}).", _instanceServerAddress);
     }
     else
     {
         m_int_configs[CONFIG_PORT_WORLD] = sConfigMgr->GetIntDefault("WorldServerPort", 8085);
         m_int_configs[CONFIG_PORT_INSTANCE] = sConfigMgr->GetIntDefault("InstanceServerPort", 8086);
+
+        _instanceServerAddress = sConfigMgr->GetStringDefault("InstanceServerAddress", "");
+        if (!_instanceServerAddress.empty())
+        {
+            boost::system::error_code error;
+            Trinity::Net::make_address(_instanceServerAddress, error);
+            if (error)
+            {
+                TC_LOG_ERROR("server.loading", "InstanceServerAddress ({}) is not a valid IP address, using realm address instead.", _instanceServerAddress);
+                _instanceServerAddress.clear();
+            }
+        }
     }
 
     // Config values are in "milliseconds" but we handle SocketTimeOut only as "seconds" so divide by 1000
@@ -942,6 +989,8 @@ void World::LoadConfigSettings(bool reload)
     m_int64_configs[CONFIG_CHARACTER_CREATING_DISABLED_RACEMASK] = sConfigMgr->GetInt64Default("CharacterCreating.Disabled.RaceMask", 0);
     m_int_configs[CONFIG_CHARACTER_CREATING_DISABLED_CLASSMASK] = sConfigMgr->GetIntDefault("CharacterCreating.Disabled.ClassMask", 0);
 
+    m_int_configs[CONFIG_CHARACTER_LOGIN_PREFETCH_TIME] = sConfigMgr->GetIntDefault("CharacterLogin.PrefetchTime", 0);
+
     m_int_configs[CONFIG_CHARACTERS_PER_REALM] = sConfigMgr->GetIntDefault("CharactersPerRealm", 60);
     if (m_int_configs[CONFIG_CHARACTERS_PER_REALM] < 1 || m_int_configs[CONFIG_CHARACTERS_PER_REALM] > MAX_CHARACTERS_PER_REALM)
     {
@@ -1160,6 +1209,13 @@ void World::LoadConfigSettings(bool reload)
 
     m_int_configs[CONFIG_GROUP_VISIBILITY] = sConfigMgr->GetIntDefault("Visibility.GroupMode", 1);
 
+    m_int_configs[CONFIG_GROUP_OUT_OF_RANGE_UPDATE_INTERVAL] = sConfigMgr->GetIntDefault("Group.OutOfRangeUpdateInterval", 5000);
+    if (m_int_configs[CONFIG_GROUP_OUT_OF_RANGE_UPDATE_INTERVAL] < 500)
+    {
+        TC_LOG_ERROR("server.loading", "Group.OutOfRangeUpdateInterval ({}) must be >= 500. Using 500 instead.", m_int_configs[CONFIG_GROUP_OUT_OF_RANGE_UPDATE_INTERVAL]);
+        m_int_configs[CONFIG_GROUP_OUT_OF_RANGE_UPDATE_INTERVAL] = 500;
+    }
+
     m_int_configs[CONFIG_MAIL_DELIVERY_DELAY] = sConfigMgr->GetIntDefault("MailDeliveryDelay", HOUR);
     m_int_configs[CONFIG_CLEAN_OLD_MAIL_TIME] = sConfigMgr->GetIntDefault("CleanOldMailTime", 4);
     if (m_int_configs[CONFIG_CLEAN_OLD_MAIL_TIME] > 23)
@@ -1168,6 +1224,15 @@ void World::LoadConfigSettings(bool reload)
         m_int_configs[CONFIG_CLEAN_OLD_MAIL_TIME] = 4;
     }
 
+    if (reload)
+    {
+        bool val = sConfigMgr->GetBoolDefault("Mail.LoadItemsOnDemand", false);
+        if (val != m_bool_configs[CONFIG_MAIL_LOAD_ITEMS_ON_DEMAND])
+            TC_LOG_ERROR("server.loading", "Mail.LoadItemsOnDemand option can't be changed at worldserver.conf reload, using current value ({}).", m_bool_configs[CONFIG_MAIL_LOAD_ITEMS_ON_DEMAND]);
+    }
+    else
+        m_bool_configs[CONFIG_MAIL_LOAD_ITEMS_ON_DEMAND] = sConfigMgr->GetBoolDefault("Mail.LoadItemsOnDemand", false);
+
     m_int_configs[CONFIG_UPTIME_UPDATE] = sConfigMgr->GetIntDefault("UpdateUptimeInterval", 10);
     if (int32(m_int_configs[CONFIG_UPTIME_UPDATE]) <= 0)
     {
@@ -1289,6 +1354,8 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY] = sConfigMgr->GetIntDefault("ChatStrictLinkChecking.Severity", 0);
     m_int_configs[CONFIG_CHAT_STRICT_LINK_CHECKING_KICK] = sConfigMgr->GetIntDefault("ChatStrictLinkChecking.Kick", 0);
 
+    m_bool_configs[CONFIG_CORPSE_LOOT_ON_DEMAND] = sConfigMgr->GetBoolDefault("Corpse.LootOnDemand", false);
+
     m_int_configs[CONFIG_CORPSE_DECAY_NORMAL]    = sConfigMgr->GetIntDefault("Corpse.Decay.NORMAL", 60);
     m_int_configs[CONFIG_CORPSE_DECAY_RARE]      = sConfigMgr->GetIntDefault("Corpse.Decay.RARE", 300);
     m_int_configs[CONFIG_CORPSE_DECAY_ELITE]     = sConfigMgr->GetIntDefault("Corpse.Decay.ELITE", 300);
@@ -1431,6 +1498,50 @@ void World::LoadConfigSettings(bool reload)
         m_MaxVisibleDistanceInArenas = MAX_VISIBILITY_DISTANCE;
     }
 
+    m_float_configs[CONFIG_VISIBILITY_INCREMENTAL_NEAR_DISTANCE] = sConfigMgr->GetFloatDefault("Visibility.Incremental.NearDistance", 0.0f);
+    if (m_float_configs[CONFIG_VISIBILITY_INCREMENTAL_NEAR_DISTANCE] > 0.0f
+        && m_float_configs[CONFIG_VISIBILITY_INCREMENTAL_NEAR_DISTANCE] < std::max(VISIBILITY_DISTANCE_SMALL, 45 * getRate(RATE_CREATURE_AGGRO)))
+    {
+        TC_LOG_ERROR("server.loading", "Visibility.Incremental.NearDistance can't be less than {}", std::max(VISIBILITY_DISTANCE_SMALL, 45 * getRate(RATE_CREATURE_AGGRO)));
+        m_float_configs[CONFIG_VISIBILITY_INCREMENTAL_NEAR_DISTANCE] = std::max(VISIBILITY_DISTANCE_SMALL, 45 * getRate(RATE_CREATURE_AGGRO));
+    }
+
+    m_float_configs[CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE] = sConfigMgr->GetFloatDefault("Movement.Relay.NearDistance", 60.0f);
+    if (m_float_configs[CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE] < VISIBILITY_DISTANCE_TINY)
+    {
+        TC_LOG_ERROR("server.loading", "Movement.Relay.NearDistance can't be less than {}", VISIBILITY_DISTANCE_TINY);
+        m_float_configs[CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE] = VISIBILITY_DISTANCE_TINY;
+    }
+
+    m_int_configs[CONFIG_MOVEMENT_RELAY_FAR_INTERVAL] = sConfigMgr->GetIntDefault("Movement.Relay.FarInterval", 0);
+
+    m_bool_configs[CONFIG_VISIBILITY_ADAPTIVE_ENABLED] = sConfigMgr->GetBoolDefault("Visibility.Adaptive.Enabled", false);
+    m_float_configs[CONFIG_VISIBILITY_ADAPTIVE_MIN_DISTANCE] = sConfigMgr->GetFloatDefault("Visibility.Adaptive.MinDistance", 60.0f);
+    if (m_float_configs[CONFIG_VISIBILITY_ADAPTIVE_MIN_DISTANCE] < 45 * getRate(RATE_CREATURE_AGGRO))
+    {
+        TC_LOG_ERROR("server.loading", "Visibility.Adaptive.MinDistance can't be less max aggro radius {}", 45 * getRate(RATE_CREATURE_AGGRO));
+        m_float_configs[CONFIG_VISIBILITY_ADAPTIVE_MIN_DISTANCE] = 45 * getRate(RATE_CREATURE_AGGRO);
+    }
+
+    m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_HIGH] = sConfigMgr->GetIntDefault("Visibility.Adaptive.UpdateTimeHigh", 50);
+    m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_LOW] = sConfigMgr->GetIntDefault("Visibility.Adaptive.UpdateTimeLow", 25);
+    if (m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_LOW] >= m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_HIGH])
+    {
+        TC_LOG_ERROR("server.loading", "Visibility.Adaptive.UpdateTimeLow ({}) must be less than Visibility.Adaptive.UpdateTimeHigh ({}), set to {}",
+            m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_LOW], m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_HIGH], m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_HIGH] / 2);
+        m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_LOW] = m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_HIGH] / 2;
+    }
+
+    m_int_configs[CONFIG_VISIBILITY_ADAPTIVE_MAX_ZONE_PLAYERS] = sConfigMgr->GetIntDefault("Visibility.Adaptive.MaxZonePlayers", 0);
+
+    m_int_configs[CONFIG_VISIBILITY_PACED_CREATE_BATCH_SIZE] = sConfigMgr->GetIntDefault("Visibility.PacedCreate.BatchSize", 0);
+    m_int_configs[CONFIG_VISIBILITY_PACED_CREATE_PACKET_SIZE] = sConfigMgr->GetIntDefault("Visibility.PacedCreate.PacketSize", 32768);
+    if (m_int_configs[CONFIG_VISIBILITY_PACED_CREATE_PACKET_SIZE] < 4096)
+    {
+        TC_LOG_ERROR("server.loading", "Visibility.PacedCreate.PacketSize ({}) must be >= 4096. Using 4096 instead.", m_int_configs[CONFIG_VISIBILITY_PACED_CREATE_PACKET_SIZE]);
+        m_int_configs[CONFIG_VISIBILITY_PACED_CREATE_PACKET_SIZE] = 4096;
+    }
+
     m_visibility_notify_periodOnContinents = sConfigMgr->GetIntDefault("Visibility.Notify.Period.OnContinents", DEFAULT_VISIBILITY_NOTIFY_PERIOD);
     m_visibility_notify_periodInInstances  = sConfigMgr->GetIntDefault("Visibility.Notify.Period.InInstances",  DEFAULT_VISIBILITY_NOTIFY_PERIOD);
     m_visibility_notify_periodInBG         = sConfigMgr->GetIntDefault("Visibility.Notify.Period.InBG",         DEFAULT_VISIBILITY_NOTIFY_PERIOD);
@@ -1568,6 +1679,33 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_MUTE_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowMuteInWorld", false);
     m_bool_configs[CONFIG_SHOW_BAN_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowBanInWorld", false);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_MAP_UPDATE_SCHEDULER] = sConfigMgr->GetIntDefault("MapUpdate.Scheduler", 0);
+    if (m_int_configs[CONFIG_MAP_UPDATE_SCHEDULER] > 2)
+    {
+        TC_LOG_ERROR("server.loading", "MapUpdate.Scheduler ({}) must be 0, 1 or 2. Using 0 instead.", m_int_configs[CONFIG_MAP_UPDATE_SCHEDULER]);
+        m_int_configs[CONFIG_MAP_UPDATE_SCHEDULER] = 0;
+    }
+    m_int_configs[CONFIG_MAP_UPDATE_REGION_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.RegionThreads", 0);
+    m_int_configs[CONFIG_MAP_UPDATE_CREATURE_LOD_DISTANCE] = sConfigMgr->GetIntDefault("MapUpdate.CreatureLOD.Distance", 0);
+    m_int_configs[CONFIG_MAP_UPDATE_CREATURE_LOD_TICKS] = sConfigMgr->GetIntDefault("MapUpdate.CreatureLOD.Ticks", 4);
+    if (m_int_configs[CONFIG_MAP_UPDATE_CREATURE_LOD_TICKS] < 1)
+    {
+        TC_LOG_ERROR("server.loading", "MapUpdate.CreatureLOD.Ticks ({}) must be at least 1. Using 1 instead.", m_int_configs[CONFIG_MAP_UPDATE_CREATURE_LOD_TICKS]);
+        m_int_configs[CONFIG_MAP_UPDATE_CREATURE_LOD_TICKS] = 1;
+    }
+    m_int_configs[CONFIG_MAP_COALESCED_OBJECT_UPDATE_INTERVAL] = sConfigMgr->GetIntDefault("MapUpdate.CoalescedObjectUpdateInterval", 0);
+    m_int_configs[CONFIG_FLIGHT_RECORDER_WORLD_TICK_THRESHOLD] = sConfigMgr->GetIntDefault("FlightRecorder.WorldTickThreshold", 0);
+    m_int_configs[CONFIG_FLIGHT_RECORDER_MAP_UPDATE_THRESHOLD] = sConfigMgr->GetIntDefault("FlightRecorder.MapUpdateThreshold", 0);
+    m_int_configs[CONFIG_SCRIPT_PROFILER_SAMPLE_RATE] = sConfigMgr->GetIntDefault("ScriptProfiler.SampleRate", 0);
+    sScriptProfiler->SetSampleRate(m_int_configs[CONFIG_SCRIPT_PROFILER_SAMPLE_RATE]);
+    m_int_configs[CONFIG_MAP_GRID_PRELOAD_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.GridPreloadThreads", 0);
+    m_int_configs[CONFIG_MAP_PATHFINDING_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.PathfindingThreads", 0);
+    m_bool_configs[CONFIG_MAP_ASYNC_TERRAIN_LOADING] = sConfigMgr->GetBoolDefault("MapUpdate.AsyncTerrainLoading", false);
+    m_int_configs[CONFIG_DB2_LOAD_THREADS] = sConfigMgr->GetIntDefault("DB2.LoadThreads", 0);
+    m_bool_configs[CONFIG_DB2_MEMORY_MAPPED] = sConfigMgr->GetBoolDefault("DB2.MemoryMapped", false);
+    m_int_configs[CONFIG_DB2_LOCALE_MASK] = sConfigMgr->GetIntDefault("DB2.Locales", 0);
+    m_bool_configs[CONFIG_STARTUP_SNAPSHOT] = sConfigMgr->GetBoolDefault("Startup.Snapshot", false);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = sConfigMgr->GetIntDefault("Startup.LoaderThreads", 0);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1579,6 +1717,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_WARDEN_CLIENT_CHECK_HOLDOFF]  = sConfigMgr->GetIntDefault("Warden.ClientCheckHoldOff", 30);
     m_int_configs[CONFIG_WARDEN_CLIENT_FAIL_ACTION]    = sConfigMgr->GetIntDefault("Warden.ClientCheckFailAction", 0);
     m_int_configs[CONFIG_WARDEN_CLIENT_RESPONSE_DELAY] = sConfigMgr->GetIntDefault("Warden.ClientResponseDelay", 600);
+    m_int_configs[CONFIG_WARDEN_MAX_CHECK_REQUESTS_PER_UPDATE] = sConfigMgr->GetIntDefault("Warden.MaxCheckRequestsPerUpdate", 100);
 
     // Feature System
     m_bool_configs[CONFIG_FEATURE_SYSTEM_BPAY_STORE_ENABLED]         = sConfigMgr->GetBoolDefault("FeatureSystem.BpayStore.Enabled", false);
@@ -1587,6 +1726,7 @@ void World::LoadConfigSettings(bool reload)
 
     // Dungeon finder
     m_int_configs[CONFIG_LFG_OPTIONSMASK] = sConfigMgr->GetIntDefault("DungeonFinder.OptionsMask", 1);
+    m_bool_configs[CONFIG_LFG_ASYNC_MATCHING] = sConfigMgr->GetBoolDefault("DungeonFinder.AsyncMatching", false);
 
     // DBC_ItemAttributes
     m_bool_configs[CONFIG_DBC_ENFORCE_ITEM_ATTRIBUTES] = sConfigMgr->GetBoolDefault("DBC.EnforceItemAttributes", true);
@@ -1623,6 +1763,7 @@ void World::LoadConfigSettings(bool reload)
 
     // Guild save interval
     m_int_configs[CONFIG_GUILD_SAVE_INTERVAL] = sConfigMgr->GetIntDefault("Guild.SaveInterval", 15);
+    m_int_configs[CONFIG_GUILD_LOG_FLUSH_INTERVAL] = sConfigMgr->GetIntDefault("Guild.LogFlushInterval", 10);
 
     // misc
     m_bool_configs[CONFIG_PDUMP_NO_PATHS] = sConfigMgr->GetBoolDefault("PlayerDump.DisallowPaths", true);
@@ -1662,6 +1803,10 @@ void World::LoadConfigSettings(bool reload)
 
     m_int_configs[CONFIG_PACKET_SPOOF_BANDURATION] = sConfigMgr->GetIntDefault("PacketSpoof.BanDuration", 86400);
 
+    m_int_configs[CONFIG_SESSION_PACKET_TIME_BUDGET] = sConfigMgr->GetIntDefault("PacketProcessing.SessionTimeBudget", 0);
+    m_int_configs[CONFIG_QUERY_PACKET_THREADS] = sConfigMgr->GetIntDefault("PacketProcessing.QueryThreads", 0);
+    m_int_configs[CONFIG_CHARACTER_SCREEN_PACKET_THREADS] = sConfigMgr->GetIntDefault("PacketProcessing.CharacterScreenThreads", 0);
+
     m_bool_configs[CONFIG_IP_BASED_ACTION_LOGGING] = sConfigMgr->GetBoolDefault("Allow.IP.Based.Action.Logging", false);
 
     // AHBot
@@ -1699,6 +1844,9 @@ void World::LoadConfigSettings(bool reload)
 
     // Whether to use LoS from game objects
     m_bool_configs[CONFIG_CHECK_GOBJECT_LOS] = sConfigMgr->GetBoolDefault("CheckGameObjectLoS", true);
+    m_bool_configs[CONFIG_LINE_OF_SIGHT_CACHE] = sConfigMgr->GetBoolDefault("LineOfSightCache", true);
+
+    m_bool_configs[CONFIG_AURA_TOTAL_CACHE] = sConfigMgr->GetBoolDefault("AuraTotalCache", false);
 
     // FactionBalance
     m_int_configs[CONFIG_FACTION_BALANCE_LEVEL_CHECK_DIFF] = sConfigMgr->GetIntDefault("Pvp.FactionBalance.LevelCheckDiff", 0);
@@ -1742,6 +1890,12 @@ void World::SetInitialWorldSettings()
     ///- Init highest guids before any table loading to prevent using not initialized guids in some code.
     sObjectMgr->SetHighestGuids();
 
+    if (getBoolConfig(CONFIG_STARTUP_SNAPSHOT))
+    {
+        TC_LOG_INFO("server.loading", "Loading world database snapshot...");
+        sWorldDatabaseSnapshot->Load(sConfigMgr->GetStringDefault("Startup.SnapshotFile", "world_snapshot.bin"));
+    }
+
     ///- Check the existence of the map files for all races' startup areas.
     if (!TerrainMgr::ExistMapAndVMap(0, -6240.32f, 331.033f)
         || !TerrainMgr::ExistMapAndVMap(0, -8949.95f, -132.493f)
@@ -1800,6 +1954,11 @@ void World::SetInitialWorldSettings()
     sDB2Manager.LoadHotfixData();
     TC_LOG_INFO("misc", "Loading hotfix optional data...");
     sDB2Manager.LoadHotfixOptionalData(m_availableDbcLocaleMask);
+    if (getBoolConfig(CONFIG_CACHE_DATA_QUERIES))
+    {
+        TC_LOG_INFO("misc", "Serializing hotfix records...");
+        sDB2Manager.InitializeHotfixReplyData(m_availableDbcLocaleMask);
+    }
     ///- Close hotfix database - it is only used during DB2 loading
     HotfixDatabase.Close();
     ///- Load M2 fly by cameras
@@ -1885,17 +2044,26 @@ void World::SetInitialWorldSettings()
     sMapMgr->InitInstanceIds();
     sInstanceLockMgr.Load();
 
+    // loaders grouped in a Trinity::TaskGraph only fill their own containers and read data loaded before the graph
+    std::size_t loaderThreads = getIntConfig(CONFIG_STARTUP_LOADER_THREADS);
+    if (!loaderThreads)
+        loaderThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
     TC_LOG_INFO("server.loading", "Loading Localization strings...");
     uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadQuestTemplateLocale();
-    sObjectMgr->LoadQuestOfferRewardLocale();
-    sObjectMgr->LoadQuestRequestItemsLocale();
-    sObjectMgr->LoadQuestObjectivesLocale();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
+    {
+        Trinity::TaskGraph localeLoaders;
+        localeLoaders.AddTask([] { sObjectMgr->LoadCreatureLocales(); });
+        localeLoaders.AddTask([] { sObjectMgr->LoadGameObjectLocales(); });
+        localeLoaders.AddTask([] { sObjectMgr->LoadQuestTemplateLocale(); });
+        localeLoaders.AddTask([] { sObjectMgr->LoadQuestOfferRewardLocale(); });
+        localeLoaders.AddTask([] { sObjectMgr->LoadQuestRequestItemsLocale(); });
+        localeLoaders.AddTask([] { sObjectMgr->LoadQuestObjectivesLocale(); });
+        localeLoaders.AddTask([] { sObjectMgr->LoadPageTextLocales(); });
+        localeLoaders.AddTask([] { sObjectMgr->LoadGossipMenuItemsLocales(); });
+        localeLoaders.AddTask([] { sObjectMgr->LoadPointOfInterestLocales(); });
+        localeLoaders.Run(loaderThreads);
+    }
 
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
     TC_LOG_INFO("server.loading", ">> Localization strings loaded in {} ms", GetMSTimeDiffToNow(oldMSTime));
@@ -2289,23 +2457,40 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Conditions...");
     sConditionMgr->LoadConditions();
 
-    TC_LOG_INFO("server.loading", "Loading faction change achievement pairs...");
-    sObjectMgr->LoadFactionChangeAchievements();
-
-    TC_LOG_INFO("server.loading", "Loading faction change spell pairs...");
-    sObjectMgr->LoadFactionChangeSpells();
-
-    TC_LOG_INFO("server.loading", "Loading faction change quest pairs...");
-    sObjectMgr->LoadFactionChangeQuests();
-
-    TC_LOG_INFO("server.loading", "Loading faction change item pairs...");
-    sObjectMgr->LoadFactionChangeItems();
-
-    TC_LOG_INFO("server.loading", "Loading faction change reputation pairs...");
-    sObjectMgr->LoadFactionChangeReputations();
-
-    TC_LOG_INFO("server.loading", "Loading faction change title pairs...");
-    sObjectMgr->LoadFactionChangeTitles();
+    {
+        Trinity::TaskGraph factionChangeLoaders;
+        factionChangeLoaders.AddTask([]
+        {
+            TC_LOG_INFO("server.loading", "Loading faction change achievement pairs...");
+            sObjectMgr->LoadFactionChangeAchievements();
+        });
+        factionChangeLoaders.AddTask([]
+        {
+            TC_LOG_INFO("server.loading", "Loading faction change spell pairs...");
+            sObjectMgr->LoadFactionChangeSpells();
+        });
+        factionChangeLoaders.AddTask([]
+        {
+            TC_LOG_INFO("server.loading", "Loading faction change quest pairs...");
+            sObjectMgr->LoadFactionChangeQuests();                  // must be after LoadQuests
+        });
+        factionChangeLoaders.AddTask([]
+        {
+            TC_LOG_INFO("server.loading", "Loading faction change item pairs...");
+            sObjectMgr->LoadFactionChangeItems();                   // must be after LoadItemTemplates
+        });
+        factionChangeLoaders.AddTask([]
+        {
+            TC_LOG_INFO("server.loading", "Loading faction change reputation pairs...");
+            sObjectMgr->LoadFactionChangeReputations();
+        });
+        factionChangeLoaders.AddTask([]
+        {
+            TC_LOG_INFO("server.loading", "Loading faction change title pairs...");
+            sObjectMgr->LoadFactionChangeTitles();
+        });
+        factionChangeLoaders.Run(loaderThreads);
+    }
 
     TC_LOG_INFO("server.loading", "Loading mount definitions...");
     CollectionMgr::LoadMountDefinitions();
@@ -2399,12 +2584,18 @@ void World::SetInitialWorldSettings()
 
     m_timers[WUPDATE_GUILDSAVE].SetInterval(getIntConfig(CONFIG_GUILD_SAVE_INTERVAL) * MINUTE * IN_MILLISECONDS);
 
+    m_timers[WUPDATE_GUILD_LOG_FLUSH].SetInterval(std::max<uint32>(getIntConfig(CONFIG_GUILD_LOG_FLUSH_INTERVAL), 1) * IN_MILLISECONDS);
+
     m_timers[WUPDATE_BLACKMARKET].SetInterval(10 * IN_MILLISECONDS);
 
     m_timers[WUPDATE_CHECK_FILECHANGES].SetInterval(500);
 
     m_timers[WUPDATE_WHO_LIST].SetInterval(5 * IN_MILLISECONDS); // update who list cache every 5 seconds
 
+    m_timers[WUPDATE_MEMORY_STATS].SetInterval(MINUTE * IN_MILLISECONDS);
+
+    m_timers[WUPDATE_DB_WORKERS].SetInterval(5 * IN_MILLISECONDS);
+
     m_timers[WUPDATE_CHANNEL_SAVE].SetInterval(getIntConfig(CONFIG_PRESERVE_CUSTOM_CHANNEL_INTERVAL) * MINUTE * IN_MILLISECONDS);
 
     //to set mailtimer to return mails every day between 4 and 5 am
@@ -2439,6 +2630,10 @@ void World::SetInitialWorldSettings()
 
     TC_LOG_INFO("server.loading", "Initializing Opcodes...");
     opcodeTable.Initialize();
+    if (uint32 queryThreads = getIntConfig(CONFIG_QUERY_PACKET_THREADS))
+        _queryPacketPool = std::make_unique<Trinity::ThreadPool>(queryThreads);
+    if (uint32 characterScreenThreads = getIntConfig(CONFIG_CHARACTER_SCREEN_PACKET_THREADS))
+        _characterScreenPool = std::make_unique<Trinity::ThreadPool>(characterScreenThreads);
     WorldPackets::Auth::ConnectTo::InitializeEncryption();
     WorldPackets::Auth::EnterEncryptedMode::InitializeEncryption();
 
@@ -2504,6 +2699,21 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading phase names...");
     sObjectMgr->LoadPhaseNames();
 
+    // also stops using the snapshot, later reloads always query the database
+    sWorldDatabaseSnapshot->Save();
+
+    if (getBoolConfig(CONFIG_BASEMAP_LOAD_GRIDS))
+    {
+        TC_LOG_INFO("server.loading", "Preloading base maps...");
+        sMapMgr->PreloadBaseMaps();
+    }
+
+    Trinity::MemoryStats::RegisterOwner("ObjectMgr", [] { return sObjectMgr->GetMemoryUsage(); });
+    Trinity::MemoryStats::RegisterOwner("DB2Manager", [] { return sDB2Manager.GetMemoryUsage(); });
+    Trinity::MemoryStats::RegisterOwner("AuctionHouseMgr", [] { return sAuctionMgr->GetMemoryUsage(); });
+    Trinity::MemoryStats::RegisterOwner("MMapManager tiles", [] { return MMAP::MMapFactory::createOrGetMMapManager()->getLoadedTilesMemory(); });
+    Trinity::MemoryStats::RegisterOwner("TerrainMgr grids", [] { return std::size_t(sTerrainMgr.GetMemoryUsage()); });
+
     uint32 startupDuration = GetMSTimeDiffToNow(startupBegin);
 
     TC_LOG_INFO("server.worldserver", "World initialized in {} minutes {} seconds", (startupDuration / 60000), ((startupDuration % 60000) / 1000));
@@ -2550,10 +2760,18 @@ void World::LoadAutobroadcasts()
     TC_LOG_INFO("server.loading", ">> Loaded {} autobroadcast definitions in {} ms", m_Autobroadcasts.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
+// reports the duration of a World::Update phase to metrics and the flight recorder
+#define WORLD_UPDATE_PHASE(name) \
+    TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", name)); \
+    FlightRecorder::WorldPhase TC_METRIC_UNIQUE_NAME(flightRecorderPhase)(name)
+
 /// Update the World !
 void World::Update(uint32 diff)
 {
     TC_METRIC_TIMER("world_update_time_total");
+    TC_TRACE_ZONE("World::Update");
+    PacketReplay::WorldTick packetReplayTick(diff);
+    FlightRecorder::WorldTick flightRecorderTick(diff);
     ///- Update the game time and check for shutdown time
     _UpdateGameTime();
     time_t currentGameTime = GameTime::GetGameTime();
@@ -2569,10 +2787,12 @@ void World::Update(uint32 diff)
             m_timers[i].SetCurrent(0);
     }
 
+    sAchievementMgr->Update();
+
     ///- Update Who List Storage
     if (m_timers[WUPDATE_WHO_LIST].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update who list"));
+        WORLD_UPDATE_PHASE("Update who list");
         m_timers[WUPDATE_WHO_LIST].Reset();
         sWhoListStorageMgr->Update();
     }
@@ -2583,7 +2803,7 @@ void World::Update(uint32 diff)
 
         if (getBoolConfig(CONFIG_PRESERVE_CUSTOM_CHANNELS))
         {
-            TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Save custom channels"));
+            WORLD_UPDATE_PHASE("Save custom channels");
             ChannelMgr* mgr1 = ASSERT_NOTNULL(ChannelMgr::ForTeam(ALLIANCE));
             mgr1->SaveToDB();
             ChannelMgr* mgr2 = ASSERT_NOTNULL(ChannelMgr::ForTeam(HORDE));
@@ -2593,38 +2813,38 @@ void World::Update(uint32 diff)
     }
 
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Check daily reset times"));
+        WORLD_UPDATE_PHASE("Check daily reset times");
         CheckScheduledResetTimes();
     }
 
     if (currentGameTime > m_NextRandomBGReset)
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Reset random BG"));
+        WORLD_UPDATE_PHASE("Reset random BG");
         ResetRandomBG();
     }
 
     if (currentGameTime > m_NextCalendarOldEventsDeletionTime)
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Delete old calendar events"));
+        WORLD_UPDATE_PHASE("Delete old calendar events");
         CalendarDeleteOldEvents();
     }
 
     if (currentGameTime > m_NextGuildReset)
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Reset guild cap"));
+        WORLD_UPDATE_PHASE("Reset guild cap");
         ResetGuildCap();
     }
 
     if (currentGameTime > m_NextCurrencyReset)
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Reset currency weekly cap"));
+        WORLD_UPDATE_PHASE("Reset currency weekly cap");
         ResetCurrencyWeekCap();
     }
 
     /// <ul><li> Handle auctions when the timer has passed
     if (m_timers[WUPDATE_AUCTIONS].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update expired auctions"));
+        WORLD_UPDATE_PHASE("Update expired auctions");
         m_timers[WUPDATE_AUCTIONS].Reset();
 
         ///- Update mails (return old mails with item, or delete them)
@@ -2641,7 +2861,7 @@ void World::Update(uint32 diff)
 
     if (m_timers[WUPDATE_AUCTIONS_PENDING].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update pending auctions"));
+        WORLD_UPDATE_PHASE("Update pending auctions");
         m_timers[WUPDATE_AUCTIONS_PENDING].Reset();
 
         sAuctionMgr->UpdatePendingAuctions();
@@ -2649,7 +2869,7 @@ void World::Update(uint32 diff)
 
     if (m_timers[WUPDATE_BLACKMARKET].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update pending black market auctions"));
+        WORLD_UPDATE_PHASE("Update pending black market auctions");
         m_timers[WUPDATE_BLACKMARKET].Reset();
 
         ///- Update blackmarket, refresh auctions if necessary
@@ -2670,7 +2890,7 @@ void World::Update(uint32 diff)
     /// <li> Handle AHBot operations
     if (m_timers[WUPDATE_AHBOT].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update AHBot"));
+        WORLD_UPDATE_PHASE("Update AHBot");
         sAuctionBot->Update();
         m_timers[WUPDATE_AHBOT].Reset();
     }
@@ -2681,21 +2901,26 @@ void World::Update(uint32 diff)
     /// <li> Handle file changes
     if (m_timers[WUPDATE_CHECK_FILECHANGES].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update HotSwap"));
+        WORLD_UPDATE_PHASE("Update HotSwap");
         sScriptReloadMgr->Update();
         m_timers[WUPDATE_CHECK_FILECHANGES].Reset();
     }
 
+    /// <li> Swap in reloaded hotfixes before query packets, which read them, are processed again
+    sDB2Manager.PublishReloadedHotfixes();
+
     {
         /// <li> Handle session updates when the timer has passed
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update sessions"));
+        WORLD_UPDATE_PHASE("Update sessions");
+        TC_TRACE_ZONE("World::UpdateSessions");
         UpdateSessions(diff);
+        ProcessQueryPackets();
     }
 
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update uptime"));
+        WORLD_UPDATE_PHASE("Update uptime");
         uint32 tmpDiff = GameTime::GetUptime();
         uint32 maxOnlinePlayers = GetMaxPlayerCount();
 
@@ -2716,7 +2941,7 @@ void World::Update(uint32 diff)
     {
         if (m_timers[WUPDATE_CLEANDB].Passed())
         {
-            TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Clean logs table"));
+            WORLD_UPDATE_PHASE("Clean logs table");
             m_timers[WUPDATE_CLEANDB].Reset();
 
             LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_DEL_OLD_LOGS);
@@ -2732,12 +2957,18 @@ void World::Update(uint32 diff)
     /// <li> Handle all other objects
     ///- Update objects when the timer has passed (maps, transport, creatures, ...)
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update maps"));
+        WORLD_UPDATE_PHASE("Update maps");
+        PacketReplay::MapUpdate packetReplayMapUpdate;
         sMapMgr->Update(diff);
     }
 
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Terrain data cleanup"));
+        WORLD_UPDATE_PHASE("Wait query packets");
+        WaitForQueryPackets();
+    }
+
+    {
+        WORLD_UPDATE_PHASE("Terrain data cleanup");
         sTerrainMgr.Update(diff);
     }
 
@@ -2745,55 +2976,60 @@ void World::Update(uint32 diff)
     {
         if (m_timers[WUPDATE_AUTOBROADCAST].Passed())
         {
-            TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Send autobroadcast"));
+            WORLD_UPDATE_PHASE("Send autobroadcast");
             m_timers[WUPDATE_AUTOBROADCAST].Reset();
             SendAutoBroadcast();
         }
     }
 
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update battlegrounds"));
+        WORLD_UPDATE_PHASE("Update battlegrounds");
         sBattlegroundMgr->Update(diff);
     }
 
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update outdoor pvp"));
+        WORLD_UPDATE_PHASE("Update outdoor pvp");
         sOutdoorPvPMgr->Update(diff);
     }
 
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update battlefields"));
+        WORLD_UPDATE_PHASE("Update battlefields");
         sBattlefieldMgr->Update(diff);
     }
 
     ///- Delete all characters which have been deleted X days before
     if (m_timers[WUPDATE_DELETECHARS].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Delete old characters"));
+        WORLD_UPDATE_PHASE("Delete old characters");
         m_timers[WUPDATE_DELETECHARS].Reset();
         Player::DeleteOldCharacters();
     }
 
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update groups"));
+        WORLD_UPDATE_PHASE("Update groups");
         sGroupMgr->Update(diff);
     }
 
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update LFG"));
+        WORLD_UPDATE_PHASE("Update LFG");
         sLFGMgr->Update(diff);
     }
 
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Process query callbacks"));
+        WORLD_UPDATE_PHASE("Process query callbacks");
         // execute callbacks from sql queries that were queued recently
         ProcessQueryCallbacks();
     }
 
+    {
+        WORLD_UPDATE_PHASE("Clean character database");
+        CharacterDatabaseCleaner::Update(diff);
+    }
+
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Remove old corpses"));
+        WORLD_UPDATE_PHASE("Remove old corpses");
         m_timers[WUPDATE_CORPSES].Reset();
         sMapMgr->DoForAllMaps([](Map* map)
         {
@@ -2804,17 +3040,24 @@ void World::Update(uint32 diff)
     ///- Process Game events when necessary
     if (m_timers[WUPDATE_EVENTS].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update game events"));
+        WORLD_UPDATE_PHASE("Update game events");
         m_timers[WUPDATE_EVENTS].Reset();                   // to give time for Update() to be processed
         uint32 nextGameEvent = sGameEventMgr->Update();
         m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);
         m_timers[WUPDATE_EVENTS].Reset();
     }
 
+    if (m_timers[WUPDATE_MEMORY_STATS].Passed())
+    {
+        WORLD_UPDATE_PHASE("Update memory stats");
+        m_timers[WUPDATE_MEMORY_STATS].Reset();
+        Trinity::MemoryStats::LogMetrics();
+    }
+
     ///- Ping to keep MySQL connections alive
     if (m_timers[WUPDATE_PINGDB].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Ping MySQL"));
+        WORLD_UPDATE_PHASE("Ping MySQL");
         m_timers[WUPDATE_PINGDB].Reset();
         TC_LOG_DEBUG("misc", "Ping MySQL to keep connection alive");
         CharacterDatabase.KeepAlive();
@@ -2822,13 +3065,30 @@ void World::Update(uint32 diff)
         WorldDatabase.KeepAlive();
     }
 
+    if (m_timers[WUPDATE_DB_WORKERS].Passed())
+    {
+        WORLD_UPDATE_PHASE("Adjust MySQL workers");
+        m_timers[WUPDATE_DB_WORKERS].Reset();
+        CharacterDatabase.AdjustAsyncWorkers();
+        LoginDatabase.AdjustAsyncWorkers();
+        WorldDatabase.AdjustAsyncWorkers();
+        HotfixDatabase.AdjustAsyncWorkers();
+    }
+
     if (m_timers[WUPDATE_GUILDSAVE].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Save guilds"));
+        WORLD_UPDATE_PHASE("Save guilds");
         m_timers[WUPDATE_GUILDSAVE].Reset();
         sGuildMgr->SaveGuilds();
     }
 
+    if (m_timers[WUPDATE_GUILD_LOG_FLUSH].Passed())
+    {
+        WORLD_UPDATE_PHASE("Save guild logs");
+        m_timers[WUPDATE_GUILD_LOG_FLUSH].Reset();
+        sGuildMgr->SaveGuildLogs();
+    }
+
     // Check for shutdown warning
     if (_guidWarn && !_guidAlert)
     {
@@ -2840,18 +3100,18 @@ void World::Update(uint32 diff)
     }
 
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Process cli commands"));
+        WORLD_UPDATE_PHASE("Process cli commands");
         // And last, but not least handle the issued cli commands
         ProcessCliCommands();
     }
 
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update world scripts"));
+        WORLD_UPDATE_PHASE("Update world scripts");
         sScriptMgr->OnWorldUpdate(diff);
     }
 
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update metrics"));
+        WORLD_UPDATE_PHASE("Update metrics");
         // Stats logger update
         sMetric->Update();
         TC_METRIC_VALUE("update_time_diff", diff);
@@ -3391,6 +3651,12 @@ void World::UpdateSessions(uint32 diff)
             AddSession_(sess);
     }
 
+    // sessions left over by an UpdateSessions call outside of World::Update are added again below
+    _queryPacketSessions.clear();
+
+    if (_characterScreenPool)
+        UpdateCharacterScreenSessions(diff);
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = m_sessions.begin(), next; itr != m_sessions.end(); itr = next)
     {
@@ -3413,9 +3679,68 @@ void World::UpdateSessions(uint32 diff)
             Trinity::Containers::MultimapErasePair(m_sessionsByBnetGuid, pSession->GetBattlenetAccountGUID(), pSession);
             delete pSession;
         }
+        else if (pSession->HasQueryPackets())
+            _queryPacketSessions.push_back(pSession);
     }
 }
 
+void World::UpdateCharacterScreenSessions(uint32 diff)
+{
+    TC_METRIC_DETAILED_NO_THRESHOLD_TIMER("world_update_time",
+        TC_METRIC_TAG("type", "Update character screen sessions"),
+        TC_METRIC_TAG("parent_type", "Update sessions"));
+
+    std::vector<WorldSession*> sessions;
+    for (auto const& [accountId, session] : m_sessions)
+        if (session->IsOnCharacterScreen())
+            sessions.push_back(session);
+
+    // sessions are handed out in batches, most of them have nothing to do
+    constexpr std::size_t SessionsPerTask = 32;
+
+    std::vector<std::future<void>> results;
+    results.reserve(sessions.size() / SessionsPerTask + 1);
+    for (std::size_t i = 0; i < sessions.size(); i += SessionsPerTask)
+    {
+        std::packaged_task<void()> task([batch = std::span(sessions).subspan(i, std::min(SessionsPerTask, sessions.size() - i)), diff]()
+        {
+            for (WorldSession* session : batch)
+            {
+                CharacterScreenSessionFilter updater(session);
+                session->Update(diff, updater);
+            }
+        });
+        results.push_back(task.get_future());
+        _characterScreenPool->PostWork(std::move(task));
+    }
+
+    for (std::future<void>& result : results)
+        result.get();
+}
+
+void World::ProcessQueryPackets()
+{
+    // handlers only read static data, nothing changes it until the world thread is done with map updates
+    // sessions are not deleted before the next UpdateSessions and Map::Update leaves query packets queued
+    _queryPacketResults.reserve(_queryPacketSessions.size());
+    for (WorldSession* session : _queryPacketSessions)
+    {
+        std::packaged_task<void()> task([session]() { session->ProcessQueryPackets(); });
+        _queryPacketResults.push_back(task.get_future());
+        _queryPacketPool->PostWork(std::move(task));
+    }
+
+    _queryPacketSessions.clear();
+}
+
+void World::WaitForQueryPackets()
+{
+    for (std::future<void>& result : _queryPacketResults)
+        result.get();
+
+    _queryPacketResults.clear();
+}
+
 // This handles the issued and queued CLI commands
 void World::ProcessCliCommands()
 {
@@ -31,6 +31,7 @@
 #include "Timer.h"
 
 #include <atomic>
+#include <future>
 #include <list>
 #include <map>
 #include <memory>
@@ -43,6 +44,11 @@ class WorldSession;
 class WorldSocket;
 struct Realm;
 
+namespace Trinity
+{
+    class ThreadPool;
+}
+
 // ServerMessages.dbc
 enum ServerMessageType
 {
@@ -90,10 +96,13 @@ enum WorldTimers
     WUPDATE_AHBOT,
     WUPDATE_PINGDB,
     WUPDATE_GUILDSAVE,
+    WUPDATE_GUILD_LOG_FLUSH,
     WUPDATE_BLACKMARKET,
     WUPDATE_CHECK_FILECHANGES,
     WUPDATE_WHO_LIST,
     WUPDATE_CHANNEL_SAVE,
+    WUPDATE_MEMORY_STATS,
+    WUPDATE_DB_WORKERS,
     WUPDATE_COUNT
 };
 
@@ -103,8 +112,10 @@ enum WorldBoolConfigs
     CONFIG_DURABILITY_LOSS_IN_PVP = 0,
     CONFIG_ADDON_CHANNEL,
     CONFIG_CLEAN_CHARACTER_DB,
+    CONFIG_CLEAN_CHARACTER_DB_BACKGROUND,
     CONFIG_GRID_UNLOAD,
     CONFIG_STATS_SAVE_ONLY_ON_LOGOUT,
+    CONFIG_PLAYER_SAVE_INCREMENTAL,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CALENDAR,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CHANNEL,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP,
@@ -165,6 +176,9 @@ enum WorldBoolConfigs
     CONFIG_QUEST_ENABLE_QUEST_TRACKER,
     CONFIG_WARDEN_ENABLED,
     CONFIG_ENABLE_MMAPS,
+    CONFIG_DB2_MEMORY_MAPPED,
+    CONFIG_STARTUP_SNAPSHOT,
+    CONFIG_MAP_ASYNC_TERRAIN_LOADING,
     CONFIG_WINTERGRASP_ENABLE,
     CONFIG_TOLBARAD_ENABLE,
     CONFIG_EVENT_ANNOUNCE,
@@ -191,10 +205,16 @@ enum WorldBoolConfigs
     CONFIG_CREATURE_CHECK_INVALID_POSITION,
     CONFIG_GAME_OBJECT_CHECK_INVALID_POSITION,
     CONFIG_CHECK_GOBJECT_LOS,
+    CONFIG_LINE_OF_SIGHT_CACHE,
+    CONFIG_AURA_TOTAL_CACHE,
     CONFIG_RESPAWN_DYNAMIC_ESCORTNPC,
     CONFIG_REGEN_HP_CANNOT_REACH_TARGET_IN_RAID,
     CONFIG_ALLOW_LOGGING_IP_ADDRESSES_IN_DATABASE,
     CONFIG_CHARACTER_CREATING_DISABLE_ALLIED_RACE_ACHIEVEMENT_REQUIREMENT,
+    CONFIG_LFG_ASYNC_MATCHING,
+    CONFIG_CORPSE_LOOT_ON_DEMAND,
+    CONFIG_MAIL_LOAD_ITEMS_ON_DEMAND,
+    CONFIG_VISIBILITY_ADAPTIVE_ENABLED,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -203,6 +223,7 @@ enum WorldFloatConfigs
     CONFIG_GROUP_XP_DISTANCE = 0,
     CONFIG_MAX_RECRUIT_A_FRIEND_DISTANCE,
     CONFIG_SIGHT_MONSTER,
+    CONFIG_VISIBILITY_INCREMENTAL_NEAR_DISTANCE,
     CONFIG_LISTEN_RANGE_SAY,
     CONFIG_LISTEN_RANGE_TEXTEMOTE,
     CONFIG_LISTEN_RANGE_YELL,
@@ -222,14 +243,20 @@ enum WorldFloatConfigs
     CONFIG_CALL_TO_ARMS_5_PCT,
     CONFIG_CALL_TO_ARMS_10_PCT,
     CONFIG_CALL_TO_ARMS_20_PCT,
+    CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE,
+    CONFIG_VISIBILITY_ADAPTIVE_MIN_DISTANCE,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
 enum WorldIntConfigs
 {
     CONFIG_COMPRESSION = 0,
+    CONFIG_COMPRESSION_SKIP_RATIO,
+    CONFIG_COMPRESSION_BUSY_THRESHOLD,
     CONFIG_INTERVAL_SAVE,
     CONFIG_INTERVAL_GRIDCLEAN,
+    CONFIG_TERRAIN_MEMORY_BUDGET,
+    CONFIG_BASEMAP_LOAD_GRIDS_THREADS,
     CONFIG_INTERVAL_MAPUPDATE,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
@@ -249,6 +276,7 @@ enum WorldIntConfigs
     CONFIG_CHARACTER_CREATING_DISABLED_CLASSMASK,
     CONFIG_CHARACTERS_PER_ACCOUNT,
     CONFIG_CHARACTERS_PER_REALM,
+    CONFIG_CHARACTER_LOGIN_PREFETCH_TIME,
     CONFIG_CHARACTER_CREATING_EVOKERS_PER_REALM,
     CONFIG_CHARACTER_CREATING_MIN_LEVEL_FOR_DEMON_HUNTER,
     CONFIG_CHARACTER_CREATING_MIN_LEVEL_FOR_EVOKER,
@@ -290,6 +318,8 @@ enum WorldIntConfigs
     CONFIG_START_GM_LEVEL,
     CONFIG_FORCE_SHUTDOWN_THRESHOLD,
     CONFIG_GROUP_VISIBILITY,
+    CONFIG_GROUP_OUT_OF_RANGE_UPDATE_INTERVAL,
+    CONFIG_MOVEMENT_RELAY_FAR_INTERVAL,
     CONFIG_MAIL_DELIVERY_DELAY,
     CONFIG_CLEAN_OLD_MAIL_TIME,
     CONFIG_UPTIME_UPDATE,
@@ -351,6 +381,19 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_UPDATE_SCHEDULER,
+    CONFIG_MAP_UPDATE_REGION_THREADS,
+    CONFIG_MAP_UPDATE_CREATURE_LOD_DISTANCE,
+    CONFIG_MAP_UPDATE_CREATURE_LOD_TICKS,
+    CONFIG_MAP_COALESCED_OBJECT_UPDATE_INTERVAL,
+    CONFIG_FLIGHT_RECORDER_WORLD_TICK_THRESHOLD,
+    CONFIG_FLIGHT_RECORDER_MAP_UPDATE_THRESHOLD,
+    CONFIG_SCRIPT_PROFILER_SAMPLE_RATE,
+    CONFIG_MAP_GRID_PRELOAD_THREADS,
+    CONFIG_MAP_PATHFINDING_THREADS,
+    CONFIG_DB2_LOAD_THREADS,
+    CONFIG_DB2_LOCALE_MASK,
+    CONFIG_STARTUP_LOADER_THREADS,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -373,6 +416,9 @@ enum WorldIntConfigs
     CONFIG_PRESERVE_CUSTOM_CHANNEL_DURATION,
     CONFIG_PRESERVE_CUSTOM_CHANNEL_INTERVAL,
     CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS,
+    CONFIG_CLEAN_CHARACTER_DB_BATCH_SIZE,
+    CONFIG_CLEAN_CHARACTER_DB_BATCH_INTERVAL,
+    CONFIG_CLEAN_CHARACTER_DB_MAX_QUEUE_SIZE,
     CONFIG_LFG_OPTIONSMASK,
     CONFIG_MAX_INSTANCES_PER_HOUR,
     CONFIG_XP_BOOST_DAYMASK,
@@ -383,6 +429,7 @@ enum WorldIntConfigs
     CONFIG_WARDEN_NUM_INJECT_CHECKS,
     CONFIG_WARDEN_NUM_LUA_CHECKS,
     CONFIG_WARDEN_NUM_CLIENT_MOD_CHECKS,
+    CONFIG_WARDEN_MAX_CHECK_REQUESTS_PER_UPDATE,
     CONFIG_WINTERGRASP_PLR_MAX,
     CONFIG_WINTERGRASP_PLR_MIN,
     CONFIG_WINTERGRASP_PLR_MIN_LVL,
@@ -397,9 +444,13 @@ enum WorldIntConfigs
     CONFIG_TOLBARAD_NOBATTLETIME,
     CONFIG_TOLBARAD_RESTART_AFTER_CRASH,
     CONFIG_GUILD_SAVE_INTERVAL,
+    CONFIG_GUILD_LOG_FLUSH_INTERVAL,
     CONFIG_PACKET_SPOOF_POLICY,
     CONFIG_PACKET_SPOOF_BANMODE,
     CONFIG_PACKET_SPOOF_BANDURATION,
+    CONFIG_SESSION_PACKET_TIME_BUDGET,
+    CONFIG_QUERY_PACKET_THREADS,
+    CONFIG_CHARACTER_SCREEN_PACKET_THREADS,
     CONFIG_ACC_PASSCHANGESEC,
     CONFIG_BG_REWARD_WINNER_HONOR_FIRST,
     CONFIG_BG_REWARD_WINNER_HONOR_LAST,
@@ -420,6 +471,8 @@ enum WorldIntConfigs
     CONFIG_AUCTION_REPLICATE_DELAY,
     CONFIG_AUCTION_SEARCH_DELAY,
     CONFIG_AUCTION_TAINTED_SEARCH_DELAY,
+    CONFIG_AUCTION_BROWSE_THREADS,
+    CONFIG_AUCTION_BROWSE_SNAPSHOT_INTERVAL,
     CONFIG_TALENTS_INSPECTING,
     CONFIG_RESPAWN_MINCHECKINTERVALMS,
     CONFIG_RESPAWN_DYNAMICMODE,
@@ -433,6 +486,11 @@ enum WorldIntConfigs
     CONFIG_BLACKMARKET_MAXAUCTIONS,
     CONFIG_BLACKMARKET_UPDATE_PERIOD,
     CONFIG_FACTION_BALANCE_LEVEL_CHECK_DIFF,
+    CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_HIGH,
+    CONFIG_VISIBILITY_ADAPTIVE_UPDATE_TIME_LOW,
+    CONFIG_VISIBILITY_ADAPTIVE_MAX_ZONE_PLAYERS,
+    CONFIG_VISIBILITY_PACED_CREATE_BATCH_SIZE,
+    CONFIG_VISIBILITY_PACED_CREATE_PACKET_SIZE,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -662,6 +720,9 @@ class TC_GAME_API World
         /// Get the string for new characters (first login)
         std::string const& GetNewCharString() const { return m_newCharString; }
 
+        /// Get the address sent to clients for the instance connection, empty when realm address is used
+        std::string const& GetInstanceServerAddress() const { return _instanceServerAddress; }
+
         LocaleConstant GetDefaultDbcLocale() const { return m_defaultDbcLocale; }
 
         /// Get the path where data (dbc, maps) are stored on disk
@@ -704,6 +765,8 @@ class TC_GAME_API World
         void Update(uint32 diff);
 
         void UpdateSessions(uint32 diff);
+        /// PROCESS_QUERY packets are handled in a thread pool while maps update, PROCESS_INPLACE otherwise
+        bool IsQueryPacketPoolActive() const { return _queryPacketPool != nullptr; }
         /// Set a server rate (see #Rates)
         void setRate(Rates rate, float value) { rate_values[rate]=value; }
         /// Get a server rate (see #Rates)
@@ -757,6 +820,9 @@ class TC_GAME_API World
         static PersistentWorldVariable const NextWeeklyQuestResetTimeVarId;                 // Next weekly quest reset time
         static PersistentWorldVariable const NextBGRandomDailyResetTimeVarId;               // Next daily BG reset time
         static PersistentWorldVariable const CharacterDatabaseCleaningFlagsVarId;           // Cleaning Flags
+        static PersistentWorldVariable const CharacterDatabaseCleaningPendingVarId;         // Cleaning Flags not yet finished by background cleaning
+        static PersistentWorldVariable const CharacterDatabaseCleaningProgressVarId;        // Last key cleaned by background cleaning, low 32 bits
+        static PersistentWorldVariable const CharacterDatabaseCleaningProgressHighVarId;    // Last key cleaned by background cleaning, high 32 bits
         static PersistentWorldVariable const NextGuildDailyResetTimeVarId;                  // Next guild cap reset time
         static PersistentWorldVariable const NextMonthlyQuestResetTimeVarId;                // Next monthly quest reset time
         static PersistentWorldVariable const NextDailyQuestResetTimeVarId;                  // Next daily quest reset time
@@ -798,6 +864,7 @@ class TC_GAME_API World
         void UpdateRealmCharCount(uint32 accid);
 
         LocaleConstant GetAvailableDbcLocale(LocaleConstant locale) const { if (m_availableDbcLocaleMask & (1 << locale)) return locale; else return m_defaultDbcLocale; }
+        uint32 GetAvailableDbcLocaleMask() const { return m_availableDbcLocaleMask; }
 
         // used World DB version
         void LoadDBVersion();
@@ -873,6 +940,7 @@ class TC_GAME_API World
         uint32 m_MaxPlayerCount;
 
         std::string m_newCharString;
+        std::string _instanceServerAddress;
 
         float rate_values[MAX_RATES];
         uint32 m_int_configs[INT_CONFIG_VALUE_COUNT];
@@ -921,6 +989,17 @@ class TC_GAME_API World
         void ProcessLinkInstanceSocket(std::pair<std::weak_ptr<WorldSocket>, uint64> linkInfo);
         LockedQueue<std::pair<std::weak_ptr<WorldSocket>, uint64>> _linkSocketQueue;
 
+        // sessions with query packets left by UpdateSessions, handled until maps finished updating
+        void ProcessQueryPackets();
+        void WaitForQueryPackets();
+        std::unique_ptr<Trinity::ThreadPool> _queryPacketPool;
+        std::vector<WorldSession*> _queryPacketSessions;
+        std::vector<std::future<void>> _queryPacketResults;
+
+        // sessions on the character screen handle their own packets concurrently at the start of UpdateSessions
+        void UpdateCharacterScreenSessions(uint32 diff);
+        std::unique_ptr<Trinity::ThreadPool> _characterScreenPool;
+
         // used versions
         std::string m_DBVersion;
 
@@ -30,6 +30,7 @@ struct WorldStateTemplate
 
     std::unordered_set<uint32> MapIds;
     std::unordered_set<uint32> AreaIds;
+    std::unordered_set<uint32> ZoneIds;     // zones containing any of AreaIds, used to limit update fan-out to players of these zones
 };
 
 using WorldStateValueContainer = std::unordered_map<int32 /*worldStateId*/, int32 /*value*/>;
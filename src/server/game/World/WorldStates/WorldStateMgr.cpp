@@ -16,6 +16,7 @@
  */
 
 #include "WorldStateMgr.h"
+#include "ConditionMgr.h"
 #include "Containers.h"
 #include "DatabaseEnv.h"
 #include "DB2Stores.h"
@@ -119,6 +120,17 @@ void WorldStateMgr::LoadFromDB()
                     id, areaIds);
                 continue;
             }
+
+            if (!worldState.AreaIds.empty())
+            {
+                for (AreaTableEntry const* areaTableEntry : sAreaTableStore)
+                {
+                    bool isInAllowedArea = std::any_of(worldState.AreaIds.begin(), worldState.AreaIds.end(),
+                        [areaId = areaTableEntry->ID](uint32 requiredAreaId) { return DB2Manager::IsInArea(areaId, requiredAreaId); });
+                    if (isInAllowedArea)
+                        worldState.ZoneIds.insert(areaTableEntry->ParentAreaID ? areaTableEntry->ParentAreaID : areaTableEntry->ID);
+                }
+            }
         }
         else if (!areaIds.empty())
         {
@@ -208,6 +220,7 @@ void WorldStateMgr::SetValue(int32 worldStateId, int32 value, bool hidden, Map*
             return;
 
         itr->second = value;
+        sConditionMgr->NotifyConditionTypeChanged(CONDITION_WORLD_STATE);
 
         if (worldStateTemplate)
             sScriptMgr->OnWorldStateValueChange(worldStateTemplate, oldValue, value, nullptr);
@@ -32,6 +32,7 @@ EndScriptData */
 #include "Chat.h"
 #include "ChatCommand.h"
 #include "ChatPackets.h"
+#include "Config.h"
 #include "Conversation.h"
 #include "CreatureAI.h"
 #include "DB2Stores.h"
@@ -43,16 +44,20 @@ EndScriptData */
 #include "M2Stores.h"
 #include "MapManager.h"
 #include "MovementPackets.h"
+#include "PacketReplay.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "PhasingHandler.h"
 #include "PoolMgr.h"
 #include "RBAC.h"
+#include "ScriptProfiler.h"
 #include "SpellMgr.h"
 #include "SpellPackets.h"
+#include "Trace.h"
 #include "Transport.h"
 #include "Warden.h"
 #include "World.h"
+#include "WorldDatabaseSnapshot.h"
 #include "WorldSession.h"
 #include <fstream>
 #include <limits>
@@ -129,7 +134,14 @@ public:
             { "objectcount",        HandleDebugObjectCountCommand,         rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
             { "questreset",         HandleDebugQuestResetCommand,          rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
             { "warden force",       HandleDebugWardenForce,                rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
-            { "personalclone",      HandleDebugBecomePersonalClone,        rbac::RBAC_PERM_COMMAND_DEBUG,   Console::No }
+            { "personalclone",      HandleDebugBecomePersonalClone,        rbac::RBAC_PERM_COMMAND_DEBUG,   Console::No },
+            { "trace dump",         HandleDebugTraceDumpCommand,           rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "scriptstats",        HandleDebugScriptStatsCommand,         rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "mapprofile",         HandleDebugMapProfileCommand,          rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "replay start",       HandleDebugReplayStartCommand,         rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "replay stop",        HandleDebugReplayStopCommand,          rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "replay status",      HandleDebugReplayStatusCommand,        rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "snapshot invalidate", HandleDebugSnapshotInvalidateCommand, rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes }
         };
         static ChatCommandTable commandTable =
         {
@@ -1702,6 +1714,180 @@ public:
         return true;
     }
 
+    static bool HandleDebugTraceDumpCommand([[maybe_unused]] ChatHandler* handler, [[maybe_unused]] Optional<uint32> seconds)
+    {
+#ifdef WITH_TRACING
+        std::string fileName = Trinity::StringFormat("{}trace_{}.json", sLog->GetLogsDir(), GameTime::GetGameTime());
+        std::size_t zones = 0;
+        if (!Trinity::Trace::WriteChromeTrace(fileName, Seconds(seconds.value_or(10)), &zones))
+        {
+            handler->PSendSysMessage("Could not write trace file %s", fileName.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Wrote " SZFMTD " zones to %s", zones, fileName.c_str());
+#else
+        handler->SendSysMessage("Tracing is not enabled, build with WITH_TRACING defined");
+#endif
+        return true;
+    }
+
+    static bool HandleDebugSnapshotInvalidateCommand(ChatHandler* handler)
+    {
+        std::string fileName = sConfigMgr->GetStringDefault("Startup.SnapshotFile", "world_snapshot.bin");
+        if (!sWorldDatabaseSnapshot->Invalidate(fileName))
+        {
+            handler->PSendSysMessage("Could not delete world database snapshot %s", fileName.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Deleted world database snapshot %s, it will be rebuilt on the next start", fileName.c_str());
+        return true;
+    }
+
+    static bool HandleDebugScriptStatsCommand(ChatHandler* handler, Optional<Variant<uint32, EXACT_SEQUENCE("reset")>> arg)
+    {
+        if (arg && arg->holds_alternative<EXACT_SEQUENCE("reset")>())
+        {
+            sScriptProfiler->Reset();
+            handler->SendSysMessage("Script stats reset");
+            return true;
+        }
+
+        uint32 sampleRate = sScriptProfiler->GetSampleRate();
+        if (!sampleRate)
+            handler->SendSysMessage("Script profiling is disabled, set ScriptProfiler.SampleRate to enable it");
+
+        uint32 count = arg ? arg->get<uint32>() : 20;
+        handler->PSendSysMessage("Script hooks by sampled time, one of every %u calls is timed:", sampleRate);
+        sScriptProfiler->VisitStats([handler, &count](ScriptProfiler::HookStats const& stats)
+        {
+            if (!count)
+                return;
+
+            --count;
+            handler->PSendSysMessage("%.*s %.*s: " UI64FMTD " calls, total " SI64FMTD " us, avg " UI64FMTD " us, max " SI64FMTD " us",
+                int(stats.Script.size()), stats.Script.data(), int(stats.Hook.size()), stats.Hook.data(), stats.SampledCalls,
+                int64(stats.Total.count()), uint64(stats.Total.count()) / std::max<uint64>(stats.SampledCalls, 1), int64(stats.Max.count()));
+        });
+        return true;
+    }
+
+    static bool HandleDebugMapProfileCommand(ChatHandler* handler, Optional<Variant<EXACT_SEQUENCE("on"), EXACT_SEQUENCE("off")>> toggle, uint32 mapId, Optional<uint32> instanceId)
+    {
+        // USAGE: .debug mapprofile [on|off] <mapId> [instanceId]
+        // without on/off prints the phase breakdown and most expensive creatures of each matching map
+        std::vector<Map*> maps;
+        if (instanceId)
+        {
+            if (Map* map = sMapMgr->FindMap(mapId, *instanceId))
+                maps.push_back(map);
+        }
+        else
+            sMapMgr->DoForAllMapsWithMapId(mapId, [&maps](Map* map) { maps.push_back(map); });
+
+        if (maps.empty())
+        {
+            handler->PSendSysMessage("No map %u is loaded", mapId);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        for (Map* map : maps)
+        {
+            MapUpdateProfiler& profiler = map->GetUpdateProfiler();
+            if (toggle)
+            {
+                bool enable = toggle->holds_alternative<EXACT_SEQUENCE("on")>();
+                profiler.SetEnabled(enable);
+                handler->PSendSysMessage("Map %u instance %u: update profiling %s", map->GetId(), map->GetInstanceId(), enable ? "enabled" : "disabled");
+                continue;
+            }
+
+            MapUpdateProfiler::Report report = profiler.BuildReport(10);
+            if (!report.Updates)
+            {
+                handler->PSendSysMessage("Map %u instance %u: no profiled updates%s", map->GetId(), map->GetInstanceId(),
+                    profiler.IsEnabled() ? "" : ", enable profiling with .debug mapprofile on");
+                continue;
+            }
+
+            handler->PSendSysMessage("Map %u instance %u: last " SZFMTD " updates%s (min/avg/p99/max us)", map->GetId(), map->GetInstanceId(), report.Updates,
+                profiler.IsEnabled() ? "" : ", profiling disabled");
+            auto printStats = [handler](char const* name, MapUpdateProfiler::PhaseStats const& stats)
+            {
+                handler->PSendSysMessage("  %s: " SI64FMTD " / " SI64FMTD " / " SI64FMTD " / " SI64FMTD, name,
+                    int64(stats.Min.count()), int64(stats.Avg.count()), int64(stats.P99.count()), int64(stats.Max.count()));
+            };
+
+            for (uint8 i = 0; i < MAX_MAP_UPDATE_PHASES; ++i)
+                printStats(MapUpdateProfiler::GetPhaseName(MapUpdatePhase(i)), report.Phases[i]);
+            printStats("Total", report.Total);
+
+            for (MapUpdateProfiler::CreatureStats const& stats : report.TopCreatures)
+                handler->PSendSysMessage("  %s (entry %u): %u updates, total " SI64FMTD " us, avg " SI64FMTD " us, max " SI64FMTD " us",
+                    stats.Guid.ToString().c_str(), stats.Entry, stats.Updates, int64(stats.Total.count()), int64(stats.Total.count()) / std::max<int64>(stats.Updates, 1),
+                    int64(stats.Max.count()));
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugReplayStartCommand(ChatHandler* handler, std::string const& fileName, Optional<uint32> tickDiff)
+    {
+        // every player in world except the one starting the replay receives the packets of one captured connection
+        std::vector<uint32> accountIds;
+        for (auto const& [accountId, session] : sWorld->GetAllSessions())
+            if (session != handler->GetSession() && session->GetPlayer() && session->GetPlayer()->IsInWorld())
+                accountIds.push_back(accountId);
+
+        std::sort(accountIds.begin(), accountIds.end());
+
+        std::string error;
+        if (!sPacketReplay->Start(fileName, accountIds, Milliseconds(tickDiff.value_or(50)), error))
+        {
+            handler->PSendSysMessage("Could not start replay: %s", error.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Replaying %s into " SZFMTD " sessions", fileName.c_str(), accountIds.size());
+        return true;
+    }
+
+    static bool HandleDebugReplayStopCommand(ChatHandler* handler)
+    {
+        if (!sPacketReplay->IsRunning())
+        {
+            handler->SendSysMessage("No replay is running");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        HandleDebugReplayStatusCommand(handler);
+        sPacketReplay->Stop();
+        return true;
+    }
+
+    static bool HandleDebugReplayStatusCommand(ChatHandler* handler)
+    {
+        if (!sPacketReplay->IsRunning())
+        {
+            handler->SendSysMessage("No replay is running, the results of the last one are in the server.replay log");
+            return true;
+        }
+
+        PacketReplay::Summary summary = sPacketReplay->GetSummary();
+        handler->PSendSysMessage("%u ticks, %u packets queued, %u skipped, %u left", summary.Ticks, summary.PacketsQueued, summary.PacketsSkipped, summary.PacketsLeft);
+        handler->PSendSysMessage("World update mean " SI64FMTD " us, p95 " SI64FMTD " us, max " SI64FMTD " us",
+            int64(summary.WorldUpdateMean.count()), int64(summary.WorldUpdateP95.count()), int64(summary.WorldUpdateMax.count()));
+        handler->PSendSysMessage("Map update mean " SI64FMTD " us, p95 " SI64FMTD " us, max " SI64FMTD " us",
+            int64(summary.MapUpdateMean.count()), int64(summary.MapUpdateP95.count()), int64(summary.MapUpdateMax.count()));
+        return true;
+    }
+
     class CreatureCountWorker
     {
     public:
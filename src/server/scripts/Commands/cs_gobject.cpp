@@ -140,7 +140,7 @@ public:
             object->SetRespawnTime(*spawnTimeSecs);
 
         // fill the gameobject data and save to the db
-        object->SaveToDB(map->GetId(), { map->GetDifficultyID() });
+        object->SaveToDB(map->GetId(), std::array{ map->GetDifficultyID() });
         ObjectGuid::LowType spawnId = object->GetSpawnId();
 
         // delete the old object and do a clean load from DB with a fresh new GameObject instance.
@@ -135,7 +135,7 @@ public:
             data.spawnPoint.Relocate(chr->GetTransOffsetX(), chr->GetTransOffsetY(), chr->GetTransOffsetZ(), chr->GetTransOffsetO());
             if (Creature* creature = trans->CreateNPCPassenger(guid, &data))
             {
-                creature->SaveToDB(trans->GetGOInfo()->moTransport.SpawnMap, { map->GetDifficultyID() });
+                creature->SaveToDB(trans->GetGOInfo()->moTransport.SpawnMap, std::array{ map->GetDifficultyID() });
                 sObjectMgr->AddCreatureToGrid(&data);
             }
             return true;
@@ -146,7 +146,7 @@ public:
             return false;
 
         PhasingHandler::InheritPhaseShift(creature, chr);
-        creature->SaveToDB(map->GetId(), { map->GetDifficultyID() });
+        creature->SaveToDB(map->GetId(), std::array{ map->GetDifficultyID() });
 
         ObjectGuid::LowType db_guid = creature->GetSpawnId();
 
@@ -34,6 +34,7 @@ EndScriptData */
 #include "ConversationDataStore.h"
 #include "CreatureTextMgr.h"
 #include "DatabaseEnv.h"
+#include "DB2Stores.h"
 #include "DisableMgr.h"
 #include "ItemEnchantmentMgr.h"
 #include "Language.h"
@@ -48,6 +49,7 @@ EndScriptData */
 #include "SpellMgr.h"
 #include "StringConvert.h"
 #include "SupportMgr.h"
+#include "Unit.h"
 #include "WaypointManager.h"
 #include "World.h"
 
@@ -113,6 +115,7 @@ public:
             { "gameobject_queststarter",       rbac::RBAC_PERM_COMMAND_RELOAD_GAMEOBJECT_QUESTSTARTER,          true,  &HandleReloadGOQuestStarterCommand,             "" },
             { "gossip_menu",                   rbac::RBAC_PERM_COMMAND_RELOAD_GOSSIP_MENU,                      true,  &HandleReloadGossipMenuCommand,                 "" },
             { "gossip_menu_option",            rbac::RBAC_PERM_COMMAND_RELOAD_GOSSIP_MENU_OPTION,               true,  &HandleReloadGossipMenuOptionCommand,           "" },
+            { "hotfixes",                      rbac::RBAC_PERM_COMMAND_RELOAD_HOTFIXES,                         true,  &HandleReloadHotfixesCommand,                   "" },
             { "item_random_bonus_list_template", rbac::RBAC_PERM_COMMAND_RELOAD_ITEM_RANDOM_BONUS_LIST_TEMPLATE, true, &HandleReloadItemRandomBonusListTemplatesCommand, "" },
             { "item_loot_template",            rbac::RBAC_PERM_COMMAND_RELOAD_ITEM_LOOT_TEMPLATE,               true,  &HandleReloadLootTemplatesItemCommand,          "" },
             { "lfg_dungeon_rewards",           rbac::RBAC_PERM_COMMAND_RELOAD_LFG_DUNGEON_REWARDS,              true,  &HandleReloadLfgRewardsCommand,                 "" },
@@ -811,6 +814,7 @@ public:
     {
         TC_LOG_INFO("misc", "Re-Loading Spell Groups...");
         sSpellMgr->LoadSpellGroups();
+        Unit::InvalidateAllAuraTotalCaches();
         handler->SendGlobalGMSysMessage("DB table `spell_group` (spell groups) reloaded.");
         return true;
     }
@@ -835,6 +839,7 @@ public:
     {
         TC_LOG_INFO("misc", "Re-Loading Spell Proc conditions and data...");
         sSpellMgr->LoadSpellProcs();
+        Unit::InvalidateAllProcAuraIndexes();
         handler->SendGlobalGMSysMessage("DB table `spell_proc` (spell proc conditions and data) reloaded.");
         return true;
     }
@@ -859,6 +864,7 @@ public:
     {
         TC_LOG_INFO("misc", "Re-Loading Spell Group Stack Rules...");
         sSpellMgr->LoadSpellGroupStackRules();
+        Unit::InvalidateAllAuraTotalCaches();
         handler->SendGlobalGMSysMessage("DB table `spell_group_stack_rules` (spell stacking definitions) reloaded.");
         return true;
     }
@@ -875,6 +881,7 @@ public:
     {
         TC_LOG_INFO("misc", "Re-Loading Page Text...");
         sObjectMgr->LoadPageTexts();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_PAGE_TEXTS);
         handler->SendGlobalGMSysMessage("DB table `page_text` reloaded.");
         return true;
     }
@@ -981,6 +988,20 @@ public:
         return true;
     }
 
+    static bool HandleReloadHotfixesCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        TC_LOG_INFO("misc", "Re-Loading hotfixes...");
+        if (!sDB2Manager.ReloadHotfixesAsync(sWorld->GetAvailableDbcLocaleMask()))
+        {
+            handler->SendSysMessage("Hotfixes are already being reloaded.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->SendGlobalGMSysMessage("DB tables `hotfix_data` and `hotfix_blob` are being reloaded, new hotfixes are sent to clients logging in after the reload.");
+        return true;
+    }
+
     static bool HandleReloadGameTeleCommand(ChatHandler* handler, char const* /*args*/)
     {
         TC_LOG_INFO("misc", "Re-Loading Game Tele coordinates...");
@@ -1054,6 +1075,7 @@ public:
     {
         TC_LOG_INFO("misc", "Re-Loading Page Text Locale... ");
         sObjectMgr->LoadPageTextLocales();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_PAGE_TEXTS);
         handler->SendGlobalGMSysMessage("DB table `page_text_locale` reloaded.");
         return true;
     }
@@ -32,6 +32,7 @@ EndScriptData */
 #include "GitRevision.h"
 #include "Language.h"
 #include "Log.h"
+#include "MemoryStats.h"
 #include "MySQLThreading.h"
 #include "RBAC.h"
 #include "Realm.h"
@@ -98,6 +99,7 @@ public:
             { "idlerestart",  rbac::RBAC_PERM_COMMAND_SERVER_IDLERESTART,  true, nullptr,                     "", serverIdleRestartCommandTable },
             { "idleshutdown", rbac::RBAC_PERM_COMMAND_SERVER_IDLESHUTDOWN, true, nullptr,                     "", serverIdleShutdownCommandTable },
             { "info",         rbac::RBAC_PERM_COMMAND_SERVER_INFO,         true, &HandleServerInfoCommand,    "" },
+            { "memory",       rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,        true, &HandleServerMemoryCommand,  "" },
             { "motd",         rbac::RBAC_PERM_COMMAND_SERVER_MOTD,         true, &HandleServerMotdCommand,    "" },
             { "plimit",       rbac::RBAC_PERM_COMMAND_SERVER_PLIMIT,       true, &HandleServerPLimitCommand,  "" },
             { "restart",      rbac::RBAC_PERM_COMMAND_SERVER_RESTART,      true, nullptr,                     "", serverRestartCommandTable },
@@ -278,6 +280,29 @@ public:
 
         return true;
     }
+
+    static bool HandleServerMemoryCommand(ChatHandler* handler)
+    {
+        auto toMB = [](uint64 bytes) { return double(bytes) / (1024.0 * 1024.0); };
+
+        Trinity::MemoryStats::AllocatorStats allocator;
+        if (Trinity::MemoryStats::GetAllocatorStats(allocator))
+        {
+            handler->PSendSysMessage("Allocator: %.2f MB allocated, %.2f MB active, %.2f MB metadata, %.2f MB resident, %.2f MB mapped, %.2f MB retained",
+                toMB(allocator.Allocated), toMB(allocator.Active), toMB(allocator.Metadata), toMB(allocator.Resident), toMB(allocator.Mapped), toMB(allocator.Retained));
+
+            for (Trinity::MemoryStats::ArenaStats const& arena : Trinity::MemoryStats::GetArenaStats())
+                handler->PSendSysMessage("Arena %s (%u threads): %.2f MB allocated", arena.Name.c_str(), arena.Threads, toMB(arena.Allocated));
+        }
+        else
+            handler->SendSysMessage("Allocator statistics are not available, the server is not linked against jemalloc");
+
+        for (Trinity::MemoryStats::OwnerStats const& owner : Trinity::MemoryStats::GetOwnerStats())
+            handler->PSendSysMessage("%s: ~%.2f MB", owner.Name.c_str(), toMB(owner.Size));
+
+        return true;
+    }
+
     // Display the 'Message of the day' for the realm
     static bool HandleServerMotdCommand(ChatHandler* handler, char const* /*args*/)
     {
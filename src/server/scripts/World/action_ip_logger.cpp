@@ -168,7 +168,7 @@ class AccountActionIpLogger : public AccountScript
 class CharacterActionIpLogger : public PlayerScript
 {
     public:
-        CharacterActionIpLogger() : PlayerScript("CharacterActionIpLogger") { }
+        CharacterActionIpLogger() : PlayerScript("CharacterActionIpLogger", { PlayerScriptHook::OnCreate, PlayerScriptHook::OnLogin, PlayerScriptHook::OnLogout }) { }
 
         // CHARACTER_CREATE = 7
         void OnCreate(Player* player) override
@@ -253,7 +253,7 @@ class CharacterActionIpLogger : public PlayerScript
 class CharacterDeleteActionIpLogger : public PlayerScript
 {
 public:
-    CharacterDeleteActionIpLogger() : PlayerScript("CharacterDeleteActionIpLogger") { }
+    CharacterDeleteActionIpLogger() : PlayerScript("CharacterDeleteActionIpLogger", { PlayerScriptHook::OnDelete, PlayerScriptHook::OnFailedDelete }) { }
 
     // CHARACTER_DELETE = 10
     void OnDelete(ObjectGuid guid, uint32 accountId) override
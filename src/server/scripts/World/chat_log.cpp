@@ -31,7 +31,7 @@
 class ChatLogScript : public PlayerScript
 {
     public:
-        ChatLogScript() : PlayerScript("ChatLogScript") { }
+        ChatLogScript() : PlayerScript("ChatLogScript", { PlayerScriptHook::OnChat }) { }
 
         void OnChat(Player* player, uint32 type, uint32 lang, std::string& msg) override
         {
@@ -27,7 +27,7 @@
 class DuelResetScript : public PlayerScript
 {
     public:
-        DuelResetScript() : PlayerScript("DuelResetScript") { }
+        DuelResetScript() : PlayerScript("DuelResetScript", { PlayerScriptHook::OnDuelStart, PlayerScriptHook::OnDuelEnd }) { }
 
         // Called when a duel starts (after 3s countdown)
         void OnDuelStart(Player* player1, Player* player2) override
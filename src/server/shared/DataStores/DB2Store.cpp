@@ -20,6 +20,7 @@
 #include "DB2DatabaseLoader.h"
 #include "DB2FileSystemSource.h"
 #include "DB2Meta.h"
+#include "MemoryStats.h"
 #include "StringFormat.h"
 
 DB2StorageBase::DB2StorageBase(char const* fileName, DB2LoadInfo const* loadInfo)
@@ -38,10 +39,25 @@ DB2StorageBase::~DB2StorageBase()
     delete[] _indexTable;
 }
 
+std::size_t DB2StorageBase::GetMemoryUsage() const
+{
+    // strings of memory mapped files are not counted, they are backed by the page cache
+    std::size_t size = Trinity::MemoryStats::GetAllocationSize(_dataTable)
+        + Trinity::MemoryStats::GetAllocationSize(_dataTableEx[0])
+        + Trinity::MemoryStats::GetAllocationSize(_dataTableEx[1])
+        + Trinity::MemoryStats::GetAllocationSize(_indexTable)
+        + _compactIndexIds.capacity() * sizeof(uint32)
+        + _compactIndexRecords.capacity() * sizeof(char*);
+
+    for (char const* strings : _stringPool)
+        size += Trinity::MemoryStats::GetAllocationSize(strings);
+
+    return size;
+}
+
 void DB2StorageBase::WriteRecord(uint32 id, LocaleConstant locale, ByteBuffer& buffer) const
 {
-    ASSERT(id < _indexTableSize);
-    char const* entry = ASSERT_NOTNULL(_indexTable[id]);
+    char const* entry = ASSERT_NOTNULL(GetRecord(id));
 
     if (!_loadInfo->Meta->HasIndexFieldInData())
         entry += 4;
@@ -85,10 +101,27 @@ void DB2StorageBase::WriteRecord(uint32 id, LocaleConstant locale, ByteBuffer& b
     }
 }
 
-void DB2StorageBase::Load(std::string const& path, LocaleConstant locale)
+void DB2StorageBase::EraseRecord(uint32 id)
+{
+    if (id >= _indexTableSize)
+        return;
+
+    if (_indexTable)
+    {
+        _indexTable[id] = nullptr;
+        return;
+    }
+
+    // keep the id, iterators skip null records
+    auto itr = std::lower_bound(_compactIndexIds.begin(), _compactIndexIds.end(), id);
+    if (itr != _compactIndexIds.end() && *itr == id)
+        _compactIndexRecords[itr - _compactIndexIds.begin()] = nullptr;
+}
+
+void DB2StorageBase::Load(std::string const& path, LocaleConstant locale, bool memoryMapped /*= false*/)
 {
     DB2FileLoader db2;
-    DB2FileSystemSource source(path + _fileName);
+    DB2FileSystemSource source(path + _fileName, memoryMapped);
     // Check if load was successful, only then continue
     db2.Load(&source, _loadInfo);
 
@@ -104,24 +137,33 @@ void DB2StorageBase::Load(std::string const& path, LocaleConstant locale)
     if (char* stringBlock = db2.AutoProduceStrings(_indexTable, _indexTableSize, locale))
         _stringPool.push_back(stringBlock);
 
+    if (_loadInfo->GetStringFieldCount(false))
+        if (std::shared_ptr<uint8 const> mappedData = db2.GetMappedData())
+            _mappedFiles.push_back(std::move(mappedData));
+
     db2.AutoProduceRecordCopies(_indexTableSize, _indexTable, _dataTable);
 }
 
-void DB2StorageBase::LoadStringsFrom(std::string const& path, LocaleConstant locale)
+void DB2StorageBase::LoadStringsFrom(std::string const& path, LocaleConstant locale, bool memoryMapped /*= false*/)
 {
     // DB2 must be already loaded using Load
     if (!_indexTable)
         throw DB2FileLoadException(Trinity::StringFormat("{} was not loaded properly, cannot load strings", path));
 
     DB2FileLoader db2;
-    DB2FileSystemSource source(path + _fileName);
+    DB2FileSystemSource source(path + _fileName, memoryMapped);
     // Check if load was successful, only then continue
     db2.Load(&source, _loadInfo);
 
     // load strings from another locale db2 data
     if (_loadInfo->GetStringFieldCount(true))
+    {
         if (char* stringBlock = db2.AutoProduceStrings(_indexTable, _indexTableSize, locale))
             _stringPool.push_back(stringBlock);
+
+        if (std::shared_ptr<uint8 const> mappedData = db2.GetMappedData())
+            _mappedFiles.push_back(std::move(mappedData));
+    }
 }
 
 void DB2StorageBase::LoadFromDB()
@@ -143,3 +185,30 @@ void DB2StorageBase::LoadStringsFromDB(LocaleConstant locale)
     loader.LoadStrings(true, locale, _indexTableSize, _indexTable, _stringPool);
     _stringPool.shrink_to_fit();
 }
+
+void DB2StorageBase::CompactIndex()
+{
+    if (!_indexTable)
+        return;
+
+    uint32 recordCount = uint32(std::count_if(_indexTable + _minId, _indexTable + _indexTableSize, [](char const* record) { return record != nullptr; }));
+
+    // a compact index costs a binary search per lookup, only use it for tables that waste most of their index
+    // (small tables are not worth it, 12 bytes per record instead of 8 bytes per possible id)
+    if (_indexTableSize < 4096 || recordCount >= _indexTableSize / 16)
+        return;
+
+    _compactIndexIds.reserve(recordCount);
+    _compactIndexRecords.reserve(recordCount);
+    for (uint32 id = _minId; id < _indexTableSize; ++id)
+    {
+        if (!_indexTable[id])
+            continue;
+
+        _compactIndexIds.push_back(id);
+        _compactIndexRecords.push_back(_indexTable[id]);
+    }
+
+    delete[] _indexTable;
+    _indexTable = nullptr;
+}
@@ -21,6 +21,8 @@
 #include "Common.h"
 #include "Errors.h"
 #include "DBStorageIterator.h"
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 class ByteBuffer;
@@ -40,21 +42,41 @@ public:
     uint32 GetTableHash() const { return _tableHash; }
     uint32 GetLayoutHash() const { return _layoutHash; }
 
-    bool HasRecord(uint32 id) const { return id < _indexTableSize && _indexTable[id] != nullptr; }
+    bool HasRecord(uint32 id) const { return GetRecord(id) != nullptr; }
     void WriteRecord(uint32 id, LocaleConstant locale, ByteBuffer& buffer) const;
-    void EraseRecord(uint32 id) { if (id < _indexTableSize) _indexTable[id] = nullptr; }
+    void EraseRecord(uint32 id);
 
     std::string const& GetFileName() const { return _fileName; }
     uint32 GetFieldCount() const { return _fieldCount; }
     DB2LoadInfo const* GetLoadInfo() const { return _loadInfo; }
     uint32 GetNumRows() const { return _indexTableSize; }
+    std::size_t GetMemoryUsage() const;
 
-    void Load(std::string const& path, LocaleConstant locale);
-    void LoadStringsFrom(std::string const& path, LocaleConstant locale);
+    void Load(std::string const& path, LocaleConstant locale, bool memoryMapped = false);
+    void LoadStringsFrom(std::string const& path, LocaleConstant locale, bool memoryMapped = false);
     void LoadFromDB();
     void LoadStringsFromDB(LocaleConstant locale);
 
+    /// Replaces the index by record id with a sorted list of ids if most ids have no record, must be called after all data was loaded
+    void CompactIndex();
+    bool HasCompactIndex() const { return !_indexTable && !_compactIndexIds.empty(); }
+
 protected:
+    char const* GetRecord(uint32 id) const
+    {
+        if (id >= _indexTableSize)
+            return nullptr;
+
+        if (_indexTable)
+            return _indexTable[id];
+
+        auto itr = std::lower_bound(_compactIndexIds.begin(), _compactIndexIds.end(), id);
+        if (itr == _compactIndexIds.end() || *itr != id)
+            return nullptr;
+
+        return _compactIndexRecords[itr - _compactIndexIds.begin()];
+    }
+
     uint32 _tableHash;
     uint32 _layoutHash;
     std::string _fileName;
@@ -63,9 +85,12 @@ protected:
     char* _dataTable;
     char* _dataTableEx[2];
     std::vector<char*> _stringPool;
+    std::vector<std::shared_ptr<uint8 const>> _mappedFiles;     // read-only file mappings that strings point into
     char** _indexTable;
     uint32 _indexTableSize;
     uint32 _minId;
+    std::vector<uint32> _compactIndexIds;                       // sorted ids of records when _indexTable was compacted
+    std::vector<char*> _compactIndexRecords;                    // records matching _compactIndexIds
 
     friend class UnitTestDataLoader;
 };
@@ -80,11 +105,24 @@ public:
 
     using DB2StorageBase::DB2StorageBase;
 
-    T const* LookupEntry(uint32 id) const { return (id >= _indexTableSize) ? nullptr : reinterpret_cast<T const*>(_indexTable[id]); }
+    T const* LookupEntry(uint32 id) const { return reinterpret_cast<T const*>(GetRecord(id)); }
     T const* AssertEntry(uint32 id) const { return ASSERT_NOTNULL(LookupEntry(id)); }
 
-    iterator begin() const { return iterator(reinterpret_cast<T const* const*>(_indexTable), _indexTableSize, _minId); }
-    iterator end() const { return iterator(reinterpret_cast<T const* const*>(_indexTable), _indexTableSize, _indexTableSize); }
+    iterator begin() const
+    {
+        if (!_indexTable)
+            return iterator(reinterpret_cast<T const* const*>(_compactIndexRecords.data()), _compactIndexRecords.size(), 0);
+
+        return iterator(reinterpret_cast<T const* const*>(_indexTable), _indexTableSize, _minId);
+    }
+
+    iterator end() const
+    {
+        if (!_indexTable)
+            return iterator(reinterpret_cast<T const* const*>(_compactIndexRecords.data()), _compactIndexRecords.size(), _compactIndexRecords.size());
+
+        return iterator(reinterpret_cast<T const* const*>(_indexTable), _indexTableSize, _indexTableSize);
+    }
 };
 
 #endif
@@ -29,6 +29,10 @@ using boost::asio::ip::tcp;
 
 #define TRINITY_MAX_LISTEN_CONNECTIONS boost::asio::socket_base::max_listen_connections
 
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX && defined(SO_REUSEPORT)
+#define TRINITY_ACCEPTOR_HAS_REUSE_PORT
+#endif
+
 class AsyncAcceptor
 {
 public:
@@ -36,7 +40,7 @@ public:
 
     AsyncAcceptor(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port) :
         _acceptor(ioContext), _endpoint(Trinity::Net::make_address(bindIp), port),
-        _socket(ioContext), _closed(false), _socketFactory(std::bind(&AsyncAcceptor::DefeaultSocketFactory, this))
+        _socket(ioContext), _closed(false), _reusePort(false), _socketFactory(std::bind(&AsyncAcceptor::DefeaultSocketFactory, this))
     {
     }
 
@@ -90,6 +94,18 @@ public:
         }
 #endif
 
+#ifdef TRINITY_ACCEPTOR_HAS_REUSE_PORT
+        if (_reusePort)
+        {
+            _acceptor.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true), errorCode);
+            if (errorCode)
+            {
+                TC_LOG_INFO("network", "Failed to set reuse_port option on acceptor {}", errorCode.message());
+                return false;
+            }
+        }
+#endif
+
         _acceptor.bind(_endpoint, errorCode);
         if (errorCode)
         {
@@ -118,6 +134,18 @@ public:
 
     void SetSocketFactory(std::function<std::pair<tcp::socket*, uint32>()> func) { _socketFactory = func; }
 
+    /// Allows multiple acceptors to bind the same endpoint, the kernel distributes incoming connections between them. Must be called before Bind()
+    void SetReusePort(bool reusePort) { _reusePort = reusePort; }
+
+    static constexpr bool IsReusePortSupported()
+    {
+#ifdef TRINITY_ACCEPTOR_HAS_REUSE_PORT
+        return true;
+#else
+        return false;
+#endif
+    }
+
 private:
     std::pair<tcp::socket*, uint32> DefeaultSocketFactory() { return std::make_pair(&_socket, 0); }
 
@@ -125,6 +153,7 @@ private:
     tcp::endpoint _endpoint;
     tcp::socket _socket;
     std::atomic<bool> _closed;
+    bool _reusePort;
     std::function<std::pair<tcp::socket*, uint32>()> _socketFactory;
 };
 
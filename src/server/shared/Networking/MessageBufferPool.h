@@ -0,0 +1,67 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MessageBufferPool_h__
+#define MessageBufferPool_h__
+
+#include "MessageBuffer.h"
+#include <vector>
+
+/**
+    @class MessageBufferPool
+
+    Free list of send buffers owned by a NetworkThread.
+    Not thread safe, only sockets updated by the owning thread may use it.
+*/
+class MessageBufferPool
+{
+public:
+    static constexpr std::size_t MaxPooledBuffers = 512;
+    static constexpr std::size_t MaxPooledBufferSize = 64 * 1024;
+
+    MessageBufferPool() = default;
+    MessageBufferPool(MessageBufferPool const&) = delete;
+    MessageBufferPool& operator=(MessageBufferPool const&) = delete;
+
+    MessageBuffer Acquire(std::size_t size)
+    {
+        if (_buffers.empty())
+            return MessageBuffer(size);
+
+        MessageBuffer buffer(std::move(_buffers.back()));
+        _buffers.pop_back();
+        buffer.Reset();
+        buffer.Resize(size);    // does not reallocate when previous capacity was big enough
+        return buffer;
+    }
+
+    void Release(MessageBuffer&& buffer)
+    {
+        // don't keep huge buffers around, they were made for a single big packet
+        if (_buffers.size() >= MaxPooledBuffers || !buffer.GetBufferSize() || buffer.GetBufferSize() > MaxPooledBufferSize)
+            return;
+
+        _buffers.push_back(std::move(buffer));
+    }
+
+    std::size_t GetSize() const { return _buffers.size(); }
+
+private:
+    std::vector<MessageBuffer> _buffers;
+};
+
+#endif // MessageBufferPool_h__
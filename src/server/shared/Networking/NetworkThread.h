@@ -19,10 +19,14 @@
 #define NetworkThread_h__
 
 #include "Define.h"
+#include "Duration.h"
 #include "DeadlineTimer.h"
 #include "Errors.h"
 #include "IoContext.h"
 #include "Log.h"
+#include "MemoryStats.h"
+#include "MessageBufferPool.h"
+#include "ProcessPriority.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <atomic>
 #include <memory>
@@ -36,7 +40,7 @@ class NetworkThread
 {
 public:
     NetworkThread() : _connections(0), _stopped(false), _thread(nullptr), _ioContext(1),
-        _acceptSocket(_ioContext), _updateTimer(_ioContext)
+        _acceptSocket(_ioContext), _updateTimer(_ioContext), _busyTime(0), _busyPercent(0)
     {
     }
 
@@ -79,6 +83,12 @@ public:
         return _connections;
     }
 
+    /// Percentage of time spent updating sockets during the last second
+    uint32 GetBusyPercent() const
+    {
+        return _busyPercent;
+    }
+
     virtual void AddSocket(std::shared_ptr<SocketType> sock)
     {
         std::lock_guard<std::mutex> lock(_newSocketsLock);
@@ -90,6 +100,8 @@ public:
 
     tcp::socket* GetSocketForAccept() { return &_acceptSocket; }
 
+    Trinity::Asio::IoContext& GetIoContext() { return _ioContext; }
+
 protected:
     virtual void SocketAdded(std::shared_ptr<SocketType> /*sock*/) { }
     virtual void SocketRemoved(std::shared_ptr<SocketType> /*sock*/) { }
@@ -109,7 +121,10 @@ protected:
                 --_connections;
             }
             else
+            {
+                sock->SetSendBufferPool(&_sendBufferPool);
                 _sockets.push_back(sock);
+            }
         }
 
         _newSockets.clear();
@@ -118,6 +133,8 @@ protected:
     void Run()
     {
         TC_LOG_DEBUG("misc", "Network Thread Starting");
+        Trinity::MemoryStats::BindThreadArena("Network");
+        ApplyThreadClassAffinity(ThreadClass::Network);
 
         _updateTimer.expires_from_now(boost::posix_time::milliseconds(1));
         _updateTimer.async_wait([this](boost::system::error_code const&) { Update(); });
@@ -136,6 +153,8 @@ protected:
         _updateTimer.expires_from_now(boost::posix_time::milliseconds(1));
         _updateTimer.async_wait([this](boost::system::error_code const&) { Update(); });
 
+        std::chrono::steady_clock::time_point updateStart = std::chrono::steady_clock::now();
+
         AddNewSockets();
 
         _sockets.erase(std::remove_if(_sockets.begin(), _sockets.end(), [this](std::shared_ptr<SocketType> sock)
@@ -153,6 +172,22 @@ protected:
 
             return false;
         }), _sockets.end());
+
+        UpdateBusyTime(updateStart);
+    }
+
+    void UpdateBusyTime(std::chrono::steady_clock::time_point updateStart)
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        _busyTime += now - updateStart;
+
+        std::chrono::steady_clock::duration window = now - _busyWindowStart;
+        if (window >= 1s)
+        {
+            _busyPercent = uint32(_busyTime * 100 / window);
+            _busyTime = std::chrono::steady_clock::duration::zero();
+            _busyWindowStart = now;
+        }
     }
 
 private:
@@ -171,6 +206,12 @@ private:
     Trinity::Asio::IoContext _ioContext;
     tcp::socket _acceptSocket;
     Trinity::Asio::DeadlineTimer _updateTimer;
+
+    MessageBufferPool _sendBufferPool;
+
+    std::chrono::steady_clock::time_point _busyWindowStart;
+    std::chrono::steady_clock::duration _busyTime;
+    std::atomic<uint32> _busyPercent;
 };
 
 #endif // NetworkThread_h__
@@ -19,10 +19,15 @@
 #define __SOCKET_H__
 
 #include "MessageBuffer.h"
+#include "MessageBufferPool.h"
+#include "MessageRingBuffer.h"
 #include "Log.h"
+#include <algorithm>
+#include <array>
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <memory>
+#include <vector>
 #include <functional>
 #include <type_traits>
 #include <boost/asio/ip/tcp.hpp>
@@ -30,8 +35,10 @@
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
-#ifdef BOOST_ASIO_HAS_IOCP
-#define TC_SOCKET_USE_IOCP
+// completion based backends (IOCP, io_uring) write queued buffers with async_write_some,
+// reactor based backends wait for writability with null_buffers and write synchronously
+#if defined(BOOST_ASIO_HAS_IOCP) || (defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL))
+#define TC_SOCKET_USE_COMPLETION_WRITES
 #endif
 
 /**
@@ -60,13 +67,15 @@ using boost::asio::ip::tcp;
             void set_option(SettableSocketOption const& option, boost::system::error_code& error);
 
             tcp::socket::endpoint_type remote_endpoint() const;
+    @tparam ReadBuffer receive buffer type, MessageBuffer or MessageRingBuffer
+            MessageRingBuffer never moves unread data but requires the derived class to consume it with Read()
 */
-template<class T, class Stream = tcp::socket>
+template<class T, class Stream = tcp::socket, class ReadBuffer = MessageBuffer>
 class Socket : public std::enable_shared_from_this<T>
 {
 public:
     explicit Socket(tcp::socket&& socket) : _socket(std::move(socket)), _remoteAddress(_socket.remote_endpoint().address()),
-        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _closed(false), _closing(false), _isWritingAsync(false)
+        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _sendBufferPool(nullptr), _writeBatchSize(1), _closed(false), _closing(false), _isWritingAsync(false)
     {
         _readBuffer.Resize(READ_BLOCK_SIZE);
     }
@@ -85,12 +94,16 @@ public:
         if (_closed)
             return false;
 
-#ifndef TC_SOCKET_USE_IOCP
+#ifndef TC_SOCKET_USE_COMPLETION_WRITES
         if (_isWritingAsync || (_writeQueue.empty() && !_closing))
             return true;
 
         for (; HandleQueue();)
             ;
+#else
+        // nothing left to write for DelayedCloseSocket, WriteHandler only closes after a write
+        if (_closing && !_isWritingAsync && _writeQueue.empty())
+            CloseSocket();
 #endif
 
         return true;
@@ -113,8 +126,8 @@ public:
 
         _readBuffer.Normalize();
         _readBuffer.EnsureFreeSpace();
-        _socket.async_read_some(boost::asio::buffer(_readBuffer.GetWritePointer(), _readBuffer.GetRemainingSpace()),
-            std::bind(&Socket<T, Stream>::ReadHandlerInternal, this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
+        _socket.async_read_some(GetReadBufferSequence(_readBuffer),
+            std::bind(&Socket<T, Stream, ReadBuffer>::ReadHandlerInternal, this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
     }
 
     void AsyncReadWithCallback(void (T::*callback)(boost::system::error_code, std::size_t))
@@ -124,15 +137,15 @@ public:
 
         _readBuffer.Normalize();
         _readBuffer.EnsureFreeSpace();
-        _socket.async_read_some(boost::asio::buffer(_readBuffer.GetWritePointer(), _readBuffer.GetRemainingSpace()),
+        _socket.async_read_some(GetReadBufferSequence(_readBuffer),
             std::bind(callback, this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
     }
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.push_back(std::move(buffer));
 
-#ifdef TC_SOCKET_USE_IOCP
+#ifdef TC_SOCKET_USE_COMPLETION_WRITES
         AsyncProcessQueue();
 #endif
     }
@@ -156,7 +169,13 @@ public:
     /// Marks the socket for closing after write buffer becomes empty
     void DelayedCloseSocket() { _closing = true; }
 
-    MessageBuffer& GetReadBuffer() { return _readBuffer; }
+    ReadBuffer& GetReadBuffer() { return _readBuffer; }
+
+    /// Sets free list used to recycle written buffers, must be owned by the thread updating this socket
+    void SetSendBufferPool(MessageBufferPool* pool) { _sendBufferPool = pool; }
+
+    /// Sets maximum number of queued buffers handed to the socket in a single write call
+    void SetWriteBatchSize(std::size_t batchSize) { _writeBatchSize = std::max<std::size_t>(batchSize, 1); }
 
 protected:
     virtual void OnClose() { }
@@ -170,12 +189,12 @@ protected:
 
         _isWritingAsync = true;
 
-#ifdef TC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T, Stream>::WriteHandler,
+#ifdef TC_SOCKET_USE_COMPLETION_WRITES
+        PrepareWriteBuffers();
+        _socket.async_write_some(_writeBuffers, std::bind(&Socket<T, Stream, ReadBuffer>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
-        _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T, Stream>::WriteHandlerWrapper,
+        _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T, Stream, ReadBuffer>::WriteHandlerWrapper,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #endif
 
@@ -196,7 +215,35 @@ protected:
         return _socket;
     }
 
+    MessageBuffer AcquireSendBuffer(std::size_t size)
+    {
+        if (_sendBufferPool)
+            return _sendBufferPool->Acquire(size);
+
+        return MessageBuffer(size);
+    }
+
+    void ReleaseSendBuffer(MessageBuffer&& buffer)
+    {
+        if (_sendBufferPool)
+            _sendBufferPool->Release(std::move(buffer));
+    }
+
 private:
+    static boost::asio::mutable_buffer GetReadBufferSequence(MessageBuffer& buffer)
+    {
+        return boost::asio::buffer(buffer.GetWritePointer(), buffer.GetRemainingSpace());
+    }
+
+    static std::array<boost::asio::mutable_buffer, 2> GetReadBufferSequence(MessageRingBuffer& buffer)
+    {
+        return
+        {
+            boost::asio::buffer(buffer.GetWritePointer(), buffer.GetWriteRegion()),
+            boost::asio::buffer(buffer.GetBasePointer(), buffer.GetWrapWriteRegion())
+        };
+    }
+
     void ReadHandlerInternal(boost::system::error_code error, size_t transferredBytes)
     {
         if (error)
@@ -209,16 +256,14 @@ private:
         ReadHandler();
     }
 
-#ifdef TC_SOCKET_USE_IOCP
+#ifdef TC_SOCKET_USE_COMPLETION_WRITES
 
     void WriteHandler(boost::system::error_code error, std::size_t transferedBytes)
     {
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            WriteCompleted(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -242,37 +287,35 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        std::size_t bytesToSend = PrepareWriteBuffers();
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(_writeBuffers, error);
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
+            PopWriteQueue();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            PopWriteQueue();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent < bytesToSend) // now n > 0
         {
-            queuedMessage.ReadCompleted(bytesSent);
+            WriteCompleted(bytesSent);
             return AsyncProcessQueue();
         }
 
-        _writeQueue.pop();
+        WriteCompleted(bytesSent);
         if (_closing && _writeQueue.empty())
             CloseSocket();
         return !_writeQueue.empty();
@@ -280,13 +323,56 @@ private:
 
 #endif
 
+    /// Gathers up to _writeBatchSize queued buffers into _writeBuffers, returns total number of bytes in them
+    std::size_t PrepareWriteBuffers()
+    {
+        _writeBuffers.clear();
+
+        std::size_t bytesToSend = 0;
+        std::size_t bufferCount = std::min(_writeQueue.size(), _writeBatchSize);
+        for (std::size_t i = 0; i < bufferCount; ++i)
+        {
+            MessageBuffer& buffer = _writeQueue[i];
+            _writeBuffers.emplace_back(buffer.GetReadPointer(), buffer.GetActiveSize());
+            bytesToSend += buffer.GetActiveSize();
+        }
+
+        return bytesToSend;
+    }
+
+    /// Consumes written bytes from the front of the queue, fully written buffers are removed
+    void WriteCompleted(std::size_t bytesWritten)
+    {
+        while (bytesWritten && !_writeQueue.empty())
+        {
+            MessageBuffer& buffer = _writeQueue.front();
+            std::size_t bufferBytes = std::min(bytesWritten, buffer.GetActiveSize());
+            buffer.ReadCompleted(bufferBytes);
+            bytesWritten -= bufferBytes;
+
+            if (buffer.GetActiveSize())
+                break;
+
+            PopWriteQueue();
+        }
+    }
+
+    void PopWriteQueue()
+    {
+        ReleaseSendBuffer(std::move(_writeQueue.front()));
+        _writeQueue.pop_front();
+    }
+
     Stream _socket;
 
     boost::asio::ip::address _remoteAddress;
     uint16 _remotePort;
 
-    MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    ReadBuffer _readBuffer;
+    std::deque<MessageBuffer> _writeQueue;
+    std::vector<boost::asio::const_buffer> _writeBuffers;
+    MessageBufferPool* _sendBufferPool;
+    std::size_t _writeBatchSize;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
@@ -23,6 +23,7 @@
 #include "NetworkThread.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <memory>
+#include <vector>
 
 using boost::asio::ip::tcp;
 
@@ -40,21 +41,11 @@ public:
         ASSERT(threadCount > 0);
 
         AsyncAcceptor* acceptor = nullptr;
-        try
-        {
-            acceptor = new AsyncAcceptor(ioContext, bindIp, port);
-        }
-        catch (boost::system::system_error const& err)
-        {
-            TC_LOG_ERROR("network", "Exception caught in SocketMgr.StartNetwork ({}:{}): {}", bindIp, port, err.what());
-            return false;
-        }
-
-        if (!acceptor->Bind())
+        if (!_perThreadAcceptors)
         {
-            TC_LOG_ERROR("network", "StartNetwork failed to bind socket acceptor");
-            delete acceptor;
-            return false;
+            acceptor = CreateAcceptor(ioContext, bindIp, port, false);
+            if (!acceptor)
+                return false;
         }
 
         _acceptor = acceptor;
@@ -63,17 +54,44 @@ public:
 
         ASSERT(_threads);
 
+        if (_perThreadAcceptors)
+        {
+            for (int32 i = 0; i < _threadCount; ++i)
+            {
+                AsyncAcceptor* threadAcceptor = CreateAcceptor(_threads[i].GetIoContext(), bindIp, port, true);
+                if (!threadAcceptor)
+                {
+                    for (AsyncAcceptor* created : _threadAcceptors)
+                        delete created;
+
+                    _threadAcceptors.clear();
+                    delete[] _threads;
+                    _threads = nullptr;
+                    _threadCount = 0;
+                    return false;
+                }
+
+                threadAcceptor->SetSocketFactory([this, threadIndex = uint32(i)]() { return std::make_pair(_threads[threadIndex].GetSocketForAccept(), threadIndex); });
+                _threadAcceptors.push_back(threadAcceptor);
+            }
+        }
+
         for (int32 i = 0; i < _threadCount; ++i)
             _threads[i].Start();
 
-        _acceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
+        if (_acceptor)
+            _acceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
 
         return true;
     }
 
     virtual void StopNetwork()
     {
-        _acceptor->Close();
+        if (_acceptor)
+            _acceptor->Close();
+
+        for (AsyncAcceptor* threadAcceptor : _threadAcceptors)
+            threadAcceptor->Close();
 
         if (_threadCount != 0)
             for (int32 i = 0; i < _threadCount; ++i)
@@ -83,6 +101,9 @@ public:
 
         delete _acceptor;
         _acceptor = nullptr;
+        for (AsyncAcceptor* threadAcceptor : _threadAcceptors)
+            delete threadAcceptor;
+        _threadAcceptors.clear();
         delete[] _threads;
         _threads = nullptr;
         _threadCount = 0;
@@ -130,15 +151,67 @@ public:
     }
 
 protected:
-    SocketMgr() : _acceptor(nullptr), _threads(nullptr), _threadCount(0)
+    SocketMgr() : _acceptor(nullptr), _threads(nullptr), _threadCount(0), _perThreadAcceptors(false)
     {
     }
 
     virtual NetworkThread<SocketType>* CreateThreads() const = 0;
 
+    /// Gives every network thread its own acceptor bound with SO_REUSEPORT instead of accepting on ioContext and handing sockets over.
+    /// Must be called before StartNetwork, ignored on platforms without SO_REUSEPORT
+    void SetPerThreadAcceptors(bool enable)
+    {
+        if (enable && !AsyncAcceptor::IsReusePortSupported())
+        {
+            TC_LOG_ERROR("network", "Per network thread acceptors require SO_REUSEPORT which is not supported on this platform, using a single acceptor");
+            enable = false;
+        }
+
+        _perThreadAcceptors = enable;
+    }
+
+    /// Starts accepting connections on all acceptors owned by this manager
+    template<AsyncAcceptor::AcceptCallback acceptCallback>
+    void AsyncAcceptWithCallback()
+    {
+        if (_acceptor)
+            _acceptor->AsyncAcceptWithCallback<acceptCallback>();
+
+        for (AsyncAcceptor* threadAcceptor : _threadAcceptors)
+            threadAcceptor->AsyncAcceptWithCallback<acceptCallback>();
+    }
+
     AsyncAcceptor* _acceptor;
     NetworkThread<SocketType>* _threads;
     int32 _threadCount;
+
+private:
+    static AsyncAcceptor* CreateAcceptor(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, bool reusePort)
+    {
+        AsyncAcceptor* acceptor = nullptr;
+        try
+        {
+            acceptor = new AsyncAcceptor(ioContext, bindIp, port);
+        }
+        catch (boost::system::system_error const& err)
+        {
+            TC_LOG_ERROR("network", "Exception caught in SocketMgr.StartNetwork ({}:{}): {}", bindIp, port, err.what());
+            return nullptr;
+        }
+
+        acceptor->SetReusePort(reusePort);
+        if (!acceptor->Bind())
+        {
+            TC_LOG_ERROR("network", "StartNetwork failed to bind socket acceptor");
+            delete acceptor;
+            return nullptr;
+        }
+
+        return acceptor;
+    }
+
+    std::vector<AsyncAcceptor*> _threadAcceptors;
+    bool _perThreadAcceptors;
 };
 
 #endif // SocketMgr_h__
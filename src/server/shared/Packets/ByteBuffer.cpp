@@ -77,18 +77,23 @@ std::string ByteBuffer::ReadCString(bool requireValidUtf8 /*= true*/)
 }
 
 std::string ByteBuffer::ReadString(uint32 length, bool requireValidUtf8 /*= true*/)
+{
+    return std::string(ReadStringView(length, requireValidUtf8));
+}
+
+std::string_view ByteBuffer::ReadStringView(uint32 length, bool requireValidUtf8 /*= true*/)
 {
     if (_rpos + length > size())
         throw ByteBufferPositionException(_rpos, length, size());
 
     ResetBitPos();
     if (!length)
-        return std::string();
+        return {};
 
-    std::string value(reinterpret_cast<char const*>(&_storage[_rpos]), length);
+    std::string_view value(reinterpret_cast<char const*>(&_storage[_rpos]), length);
     _rpos += length;
     if (requireValidUtf8 && !utf8::is_valid(value.begin(), value.end()))
-        throw ByteBufferInvalidValueException("string", value.c_str());
+        throw ByteBufferInvalidValueException("string", std::string(value).c_str());
     return value;
 }
 
@@ -116,14 +121,10 @@ void ByteBuffer::append(uint8 const* src, size_t cnt)
     FlushBits();
 
     size_t const newSize = _wpos + cnt;
-    if (_storage.capacity() < newSize) // custom memory allocation rules
+    if (_storage.capacity() < newSize) // grow to the next recycled size class
     {
-        if (newSize < 100)
-            _storage.reserve(300);
-        else if (newSize < 750)
-            _storage.reserve(2500);
-        else if (newSize < 6000)
-            _storage.reserve(10000);
+        if (size_t sizeClass = Trinity::ByteBufferAllocator<uint8>::GetSizeClass(newSize))
+            _storage.reserve(sizeClass);
         else
             _storage.reserve(400000);
     }
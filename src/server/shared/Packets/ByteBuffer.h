@@ -19,9 +19,11 @@
 #define _BYTEBUFFER_H
 
 #include "Define.h"
+#include "ByteBufferAllocator.h"
 #include "ByteConverter.h"
 #include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstring>
 
@@ -64,6 +66,9 @@ class TC_SHARED_API ByteBuffer
         constexpr static size_t DEFAULT_SIZE = 0x1000;
         constexpr static uint8 InitialBitPos = 8;
 
+        // same as MessageBuffer so that received packets take over the socket buffer without a copy
+        using Storage = std::vector<uint8, Trinity::ByteBufferAllocator<uint8>>;
+
         // constructor
         ByteBuffer() : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0)
         {
@@ -91,7 +96,7 @@ class TC_SHARED_API ByteBuffer
 
         ByteBuffer(MessageBuffer&& buffer);
 
-        std::vector<uint8>&& Move() noexcept
+        Storage&& Move() noexcept
         {
             _rpos = 0;
             _wpos = 0;
@@ -519,6 +524,9 @@ class TC_SHARED_API ByteBuffer
 
         std::string ReadString(uint32 length, bool requireValidUtf8 = true);
 
+        // points into the storage of this buffer, only valid as long as the buffer is not modified or destroyed
+        std::string_view ReadStringView(uint32 length, bool requireValidUtf8 = true);
+
         uint32 ReadPackedTime();
 
         uint8* contents()
@@ -637,7 +645,7 @@ class TC_SHARED_API ByteBuffer
     protected:
         size_t _rpos, _wpos, _bitpos;
         uint8 _curbitval;
-        std::vector<uint8> _storage;
+        Storage _storage;
 };
 
 /// @todo Make a ByteBuffer.cpp and move all this inlining to it.
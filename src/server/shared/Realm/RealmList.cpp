@@ -32,7 +32,7 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <zlib.h>
 
-RealmList::RealmList() : _updateInterval(0)
+RealmList::RealmList() : _realmsVersion(0), _updateInterval(0)
 {
 }
 
@@ -116,6 +116,30 @@ void RealmList::UpdateRealm(Realm& realm, Battlenet::RealmHandle const& id, uint
     realm.Port = port;
 }
 
+static bool IsSameAddress(std::unique_ptr<boost::asio::ip::address> const& left, std::unique_ptr<boost::asio::ip::address> const& right)
+{
+    if (!left || !right)
+        return left == right;
+
+    return *left == *right;
+}
+
+static bool IsSameRealm(Realm const& left, Realm const& right)
+{
+    return left.Id.GetAddress() == right.Id.GetAddress()
+        && left.Build == right.Build
+        && IsSameAddress(left.ExternalAddress, right.ExternalAddress)
+        && IsSameAddress(left.LocalAddress, right.LocalAddress)
+        && IsSameAddress(left.LocalSubnetMask, right.LocalSubnetMask)
+        && left.Port == right.Port
+        && left.Name == right.Name
+        && left.Type == right.Type
+        && left.Flags == right.Flags
+        && left.Timezone == right.Timezone
+        && left.AllowedSecurityLevel == right.AllowedSecurityLevel
+        && left.PopulationLevel == right.PopulationLevel;
+}
+
 void RealmList::UpdateRealms(boost::system::error_code const& error)
 {
     if (error)
@@ -208,11 +232,27 @@ void RealmList::UpdateRealms(boost::system::error_code const& error)
     for (auto itr = existingRealms.begin(); itr != existingRealms.end(); ++itr)
         TC_LOG_INFO("realmlist", "Removed realm \"{}\".", itr->second);
 
+    // _realms is only modified on this thread, no lock needed to read it here
+    bool changed = newRealms.size() != _realms.size() || newSubRegions != _subRegions
+        || !std::equal(newRealms.begin(), newRealms.end(), _realms.begin(), [](RealmMap::value_type const& left, RealmMap::value_type const& right)
+    {
+        return IsSameRealm(left.second, right.second);
+    });
+
+    // keep existing Realm objects and cached responses when nothing changed
+    if (changed)
     {
-        std::unique_lock<std::shared_mutex> lock(_realmsMutex);
+        {
+            std::unique_lock<std::shared_mutex> lock(_realmsMutex);
+
+            _subRegions.swap(newSubRegions);
+            _realms.swap(newRealms);
+            ++_realmsVersion;
+        }
 
-        _subRegions.swap(newSubRegions);
-        _realms.swap(newRealms);
+        std::lock_guard<std::mutex> cacheLock(_responseCacheMutex);
+        _realmEntryCache.clear();
+        _realmListCache.clear();
     }
 
     if (_updateInterval)
@@ -266,10 +306,30 @@ void RealmList::WriteSubRegions(bgs::protocol::game_utilities::v1::GetAllValuesF
 }
 
 std::vector<uint8> RealmList::GetRealmEntryJSON(Battlenet::RealmHandle const& id, uint32 build) const
+{
+    std::pair<Battlenet::RealmHandle, uint32> key(id, build);
+    {
+        std::lock_guard<std::mutex> cacheLock(_responseCacheMutex);
+        if (std::vector<uint8> const* cached = Trinity::Containers::MapGetValuePtr(_realmEntryCache, key))
+            return *cached;
+    }
+
+    uint32 version;
+    std::vector<uint8> compressed = BuildRealmEntryJSON(id, build, &version);
+
+    std::lock_guard<std::mutex> cacheLock(_responseCacheMutex);
+    if (version == _realmsVersion)
+        _realmEntryCache[key] = compressed;
+
+    return compressed;
+}
+
+std::vector<uint8> RealmList::BuildRealmEntryJSON(Battlenet::RealmHandle const& id, uint32 build, uint32* version) const
 {
     std::vector<uint8> compressed;
     std::shared_lock<std::shared_mutex> lock(_realmsMutex);
-    if (Realm const* realm = GetRealm(id))
+    *version = _realmsVersion;
+    if (Realm const* realm = Trinity::Containers::MapGetValuePtr(_realms, id))
     {
         if (!(realm->Flags & REALM_FLAG_OFFLINE) && realm->Build == build)
         {
@@ -320,10 +380,30 @@ std::vector<uint8> RealmList::GetRealmEntryJSON(Battlenet::RealmHandle const& id
 }
 
 std::vector<uint8> RealmList::GetRealmList(uint32 build, std::string const& subRegion) const
+{
+    std::pair<uint32, std::string> key(build, subRegion);
+    {
+        std::lock_guard<std::mutex> cacheLock(_responseCacheMutex);
+        if (std::vector<uint8> const* cached = Trinity::Containers::MapGetValuePtr(_realmListCache, key))
+            return *cached;
+    }
+
+    uint32 version;
+    std::vector<uint8> compressed = BuildRealmList(build, subRegion, &version);
+
+    std::lock_guard<std::mutex> cacheLock(_responseCacheMutex);
+    if (version == _realmsVersion)
+        _realmListCache[key] = compressed;
+
+    return compressed;
+}
+
+std::vector<uint8> RealmList::BuildRealmList(uint32 build, std::string const& subRegion, uint32* version) const
 {
     JSON::RealmList::RealmListUpdates realmList;
     {
         std::shared_lock<std::shared_mutex> lock(_realmsMutex);
+        *version = _realmsVersion;
         for (auto const& realm : _realms)
         {
             if (realm.second.Id.GetSubRegionAddress() != subRegion)
@@ -21,7 +21,9 @@
 #include "Define.h"
 #include "Realm.h"
 #include <array>
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <shared_mutex>
 #include <vector>
 #include <unordered_set>
@@ -97,6 +99,8 @@ private:
 
     void LoadBuildInfo();
     void UpdateRealms(boost::system::error_code const& error);
+    std::vector<uint8> BuildRealmEntryJSON(Battlenet::RealmHandle const& id, uint32 build, uint32* version) const;
+    std::vector<uint8> BuildRealmList(uint32 build, std::string const& subRegion, uint32* version) const;
     void UpdateRealm(Realm& realm, Battlenet::RealmHandle const& id, uint32 build, std::string const& name,
         boost::asio::ip::address&& address, boost::asio::ip::address&& localAddr, boost::asio::ip::address&& localSubmask,
         uint16 port, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float population);
@@ -105,6 +109,13 @@ private:
     mutable std::shared_mutex _realmsMutex;
     RealmMap _realms;
     std::unordered_set<std::string> _subRegions;
+    std::atomic<uint32> _realmsVersion;         // incremented every time _realms changes, responses built from older data are not cached
+
+    // compressed JSON responses, shared by all sessions until the realm list changes
+    mutable std::mutex _responseCacheMutex;
+    mutable std::map<std::pair<Battlenet::RealmHandle, uint32>, std::vector<uint8>> _realmEntryCache;
+    mutable std::map<std::pair<uint32, std::string>, std::vector<uint8>> _realmListCache;
+
     uint32 _updateInterval;
     std::unique_ptr<Trinity::Asio::DeadlineTimer> _updateTimer;
     std::unique_ptr<Trinity::Asio::Resolver> _resolver;
@@ -28,18 +28,22 @@
 #include "BigNumber.h"
 #include "CliRunnable.h"
 #include "Configuration/Config.h"
+#include "CryptoWorkerPool.h"
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
 #include "DeadlineTimer.h"
 #include "GitRevision.h"
+#include "GuildMgr.h"
 #include "InstanceLockMgr.h"
 #include "IoContext.h"
 #include "MapManager.h"
 #include "Metric.h"
+#include "MMapManager.h"
 #include "MySQLThreading.h"
 #include "ObjectAccessor.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvP/OutdoorPvPMgr.h"
+#include "PreparedStatementStatistics.h"
 #include "ProcessPriority.h"
 #include "RASession.h"
 #include "RealmList.h"
@@ -50,6 +54,8 @@
 #include "TCSoap.h"
 #include "TerrainMgr.h"
 #include "ThreadPool.h"
+#include "Trace.h"
+#include "Unit.h"
 #include "World.h"
 #include "WorldSocket.h"
 #include "WorldSocketMgr.h"
@@ -119,6 +125,8 @@ void WorldUpdateLoop();
 void ClearOnlineAccounts();
 void ShutdownCLIThread(std::thread* cliThread);
 bool LoadRealmInfo();
+template <class T>
+void LogDatabaseMetrics(char const* name, DatabaseWorkerPool<T>& database);
 variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile, std::string& cfg_service);
 
 /// Launch the Trinity server
@@ -261,6 +269,9 @@ extern int main(int argc, char** argv)
 
     // Set process priority according to configuration settings
     SetProcessPriority("server.worldserver", sConfigMgr->GetIntDefault(CONFIG_PROCESSOR_AFFINITY, 0), sConfigMgr->GetBoolDefault(CONFIG_HIGH_PRIORITY, false));
+    SetThreadClassAffinity("server.worldserver", ThreadClass::MapUpdate, sConfigMgr->GetStringDefault("ThreadAffinity.MapUpdate", ""));
+    SetThreadClassAffinity("server.worldserver", ThreadClass::Network, sConfigMgr->GetStringDefault("ThreadAffinity.Network", ""));
+    SetThreadClassAffinity("server.worldserver", ThreadClass::Database, sConfigMgr->GetStringDefault("ThreadAffinity.Database", ""));
 
     // Start the databases
     if (!StartDB())
@@ -282,10 +293,27 @@ extern int main(int argc, char** argv)
 
     sMetric->Initialize(realm.Name, *ioContext, []()
     {
-        TC_METRIC_VALUE("online_players", sWorld->GetPlayerCount());
-        TC_METRIC_VALUE("db_queue_login", uint64(LoginDatabase.QueueSize()));
-        TC_METRIC_VALUE("db_queue_character", uint64(CharacterDatabase.QueueSize()));
-        TC_METRIC_VALUE("db_queue_world", uint64(WorldDatabase.QueueSize()));
+        static std::shared_ptr<MetricHandle> const onlinePlayers = sMetric->RegisterHandle(MetricHandleType::Gauge, "online_players");
+        static std::shared_ptr<MetricHandle> const loginQueue = sMetric->RegisterHandle(MetricHandleType::Gauge, "db_queue_login");
+        static std::shared_ptr<MetricHandle> const characterQueue = sMetric->RegisterHandle(MetricHandleType::Gauge, "db_queue_character");
+        static std::shared_ptr<MetricHandle> const worldQueue = sMetric->RegisterHandle(MetricHandleType::Gauge, "db_queue_world");
+        TC_METRIC_HANDLE_VALUE(onlinePlayers, int64(sWorld->GetPlayerCount()));
+        TC_METRIC_HANDLE_VALUE(loginQueue, int64(LoginDatabase.QueueSize()));
+        TC_METRIC_HANDLE_VALUE(characterQueue, int64(CharacterDatabase.QueueSize()));
+        TC_METRIC_HANDLE_VALUE(worldQueue, int64(WorldDatabase.QueueSize()));
+        LogDatabaseMetrics("login", LoginDatabase);
+        LogDatabaseMetrics("character", CharacterDatabase);
+        LogDatabaseMetrics("world", WorldDatabase);
+
+        uint64 pathCacheHits, pathCacheMisses;
+        MMAP::PathCorridorCache::ConsumeStatistics(pathCacheHits, pathCacheMisses);
+        TC_METRIC_VALUE("mmap_path_cache_hits", pathCacheHits);
+        TC_METRIC_VALUE("mmap_path_cache_misses", pathCacheMisses);
+
+        uint64 auraTotalCacheHits, auraTotalCacheMisses;
+        Unit::ConsumeAuraTotalCacheStatistics(auraTotalCacheHits, auraTotalCacheMisses);
+        TC_METRIC_VALUE("aura_total_cache_hits", auraTotalCacheHits);
+        TC_METRIC_VALUE("aura_total_cache_misses", auraTotalCacheMisses);
     });
 
     TC_METRIC_EVENT("events", "Worldserver started", "");
@@ -349,6 +377,12 @@ extern int main(int argc, char** argv)
         return 1;
     }
 
+    sCryptoWorkerPool.Start(std::max(sConfigMgr->GetIntDefault("Network.CryptoThreads", 0), 0),
+        std::max(sConfigMgr->GetIntDefault("Network.CryptoMaxQueue", 1000), 0),
+        std::max(sConfigMgr->GetIntDefault("Network.CryptoMaxQueuePerIP", 4), 0));
+
+    std::shared_ptr<void> cryptoWorkerPoolHandle(nullptr, [](void*) { sCryptoWorkerPool.Stop(); });
+
     if (!sWorldSocketMgr.StartWorldNetwork(*ioContext, worldListener, worldPort, instancePort, networkThreads))
     {
         TC_LOG_ERROR("server.worldserver", "Failed to initialize network");
@@ -360,6 +394,7 @@ extern int main(int argc, char** argv)
     {
         sWorld->KickAll();                                       // save and kick all players
         sWorld->UpdateSessions(1);                             // real players unload required UpdateSessions call
+        sGuildMgr->SaveGuildLogs();                            // guild bank withdrawals of kicked players are logged too
 
         sWorldSocketMgr.StopNetwork();
 
@@ -422,6 +457,41 @@ extern int main(int argc, char** argv)
     return World::GetExitCode();
 }
 
+template <class T>
+void LogDatabaseMetrics(char const* name, DatabaseWorkerPool<T>& database)
+{
+    static constexpr std::array<std::pair<SQLOperationPriority, char const*>, 3> Priorities =
+    { {
+        { SQLOperationPriority::Interactive, "interactive" },
+        { SQLOperationPriority::Normal, "normal" },
+        { SQLOperationPriority::Bulk, "bulk" }
+    } };
+
+    for (auto const& [priority, priorityName] : Priorities)
+    {
+        TC_METRIC_VALUE(Trinity::StringFormat("db_queue_{}_priority", name), uint64(database.QueueSize(priority)), TC_METRIC_TAG("priority", priorityName));
+        TC_METRIC_VALUE(Trinity::StringFormat("db_queue_{}_wait", name), std::chrono::nanoseconds(database.PopMaxQueueWaitTime(priority)), TC_METRIC_TAG("priority", priorityName));
+    }
+
+    PreparedStatementStatistics* statistics = database.GetStatementStatistics();
+    if (!statistics)
+        return;
+
+    statistics->Collect([name](uint32 index, PreparedStatementPhase phase, PreparedStatementStatistics::Histogram const& histogram)
+    {
+        std::string category = Trinity::StringFormat("db_statement_{}_{}", name, phase == PREPARED_STATEMENT_PHASE_EXECUTE ? "execute" : "fetch");
+        std::string statement = std::to_string(index);
+        for (std::size_t bucket = 0; bucket < histogram.size(); ++bucket)
+        {
+            if (!histogram[bucket])
+                continue;
+
+            std::string upperBound = bucket < PreparedStatementStatistics::BucketUpperBounds.size() ? std::to_string(PreparedStatementStatistics::BucketUpperBounds[bucket]) : "inf";
+            TC_METRIC_VALUE(category, uint64(histogram[bucket]), TC_METRIC_TAG("statement", statement), TC_METRIC_TAG("le_us", upperBound));
+        }
+    });
+}
+
 void ShutdownCLIThread(std::thread* cliThread)
 {
     if (cliThread != nullptr)
@@ -498,6 +568,8 @@ void WorldUpdateLoop()
     if (!halfMaxCoreStuckTime)
         halfMaxCoreStuckTime = std::numeric_limits<uint32>::max();
 
+    TC_TRACE_THREAD_NAME("World");
+
     LoginDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
@@ -27,6 +27,7 @@
 #include "adt.h"
 #include "wdt.h"
 #include <CascLib.h>
+#include <atomic>
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <bitset>
@@ -34,6 +35,7 @@
 #include <deque>
 #include <fstream>
 #include <set>
+#include <thread>
 #include <unordered_map>
 #include <cstdlib>
 #include <cstring>
@@ -43,7 +45,8 @@
 #include <unistd.h>
 #endif
 
-std::shared_ptr<CASC::Storage> CascStorage;
+// every thread converting map tiles opens its own storage
+thread_local std::shared_ptr<CASC::Storage> CascStorage;
 
 struct MapEntry
 {
@@ -111,6 +114,8 @@ char const* CONF_Product = "wow";
 char const* CONF_Region = "eu";
 bool CONF_UseRemoteCasc = false;
 
+uint32 CONF_Threads = 1;
+
 #define CASC_LOCALES_COUNT 17
 
 char const* CascLocaleNames[CASC_LOCALES_COUNT] =
@@ -165,6 +170,7 @@ void Usage(char const* prg)
         "-p which installed product to open (wow/wowt/wow_beta)\n"\
         "-c use remote casc\n"\
         "-r set remote casc region - standard: eu\n"\
+        "-t number of threads converting map tiles, each opens its own casc storage - standard: 1\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"\n", prg, prg);
     exit(1);
 }
@@ -181,6 +187,7 @@ void HandleArgs(int argc, char* arg[])
         // l - dbc locale
         // c - use remote casc
         // r - set casc remote region - standard: eu
+        // t - number of threads converting map tiles
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -243,6 +250,12 @@ void HandleArgs(int argc, char* arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 't':
+                if (c + 1 < argc)                            // all ok
+                    CONF_Threads = std::max(1, atoi(arg[c++ + 1]));
+                else
+                    Usage(arg[0]);
+                break;
             case 'h':
                 Usage(arg[0]);
                 break;
@@ -418,24 +431,24 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, per thread converting tiles
+thread_local uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-map_liquidHeaderTypeFlags liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local map_liquidHeaderTypeFlags liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
 
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
+thread_local int16 flight_box_max[3][3];
+thread_local int16 flight_box_min[3][3];
 
 LiquidVertexFormatType adt_MH2O::GetLiquidVertexFormat(adt_liquid_instance const* liquidInstance) const
 {
@@ -1064,10 +1077,41 @@ bool IsDeepWaterIgnored(uint32 mapId, uint32 x, uint32 y)
     return false;
 }
 
-void ExtractMaps(uint32 build)
+bool OpenCascStorage(int locale);
+
+struct MapTileJob
 {
-    std::string outputFileName;
+    std::size_t MapIndex;
+    uint32 X;
+    uint32 Y;
+    uint32 RootAdtFileDataId;       // 0 when the tile is loaded by name
+};
+
+void ConvertMapTiles(std::vector<MapTileJob> const& jobs, std::atomic<std::size_t>& nextJob, std::atomic<std::size_t>& doneJobs, std::vector<uint8>& converted, uint32 build)
+{
+    for (std::size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+    {
+        MapTileJob const& job = jobs[i];
+        MapEntry const& mapEntry = map_ids[job.MapIndex];
+        std::string outputFileName = Trinity::StringFormat("{}/maps/{:04}_{:02}_{:02}.map", output_path.string(), mapEntry.Id, job.Y, job.X);
+        bool ignoreDeepWater = IsDeepWaterIgnored(mapEntry.Id, job.Y, job.X);
+        if (job.RootAdtFileDataId)
+            converted[i] = ConvertADT(job.RootAdtFileDataId, mapEntry.Name, outputFileName, job.Y, job.X, build, ignoreDeepWater);
+        else
+        {
+            std::string storagePath = Trinity::StringFormat(R"(World\Maps\{}\{}_{}_{}.adt)", mapEntry.Directory, mapEntry.Directory, job.X, job.Y);
+            converted[i] = ConvertADT(storagePath, mapEntry.Name, outputFileName, job.Y, job.X, build, ignoreDeepWater);
+        }
+
+        // draw progress bar
+        std::size_t done = ++doneJobs;
+        if (PrintProgress && (done * 100 / jobs.size()) != ((done - 1) * 100 / jobs.size()))
+            printf("Processing........................" SZFMTD "%%\r", done * 100 / jobs.size());
+    }
+}
 
+void ExtractMaps(uint32 build, int locale)
+{
     printf("Extracting maps...\n");
 
     ReadMapDBC();
@@ -1078,43 +1122,63 @@ void ExtractMaps(uint32 build)
 
     CreateDir(output_path / "maps");
 
-    printf("Convert map files\n");
+    // tiles are independent, collect all of them first and convert them in parallel
+    std::vector<MapTileJob> jobs;
     for (std::size_t z = 0; z < map_ids.size(); ++z)
     {
         printf("Extract %s (" SZFMTD "/" SZFMTD ")                  \n", map_ids[z].Name.c_str(), z + 1, map_ids.size());
         // Loadup map grid data
         ChunkedFile wdt;
-        std::bitset<(WDT_MAP_SIZE) * (WDT_MAP_SIZE)> existingTiles;
-        if (wdt.loadFile(CascStorage, map_ids[z].WdtFileDataId, Trinity::StringFormat("WDT for map {}", map_ids[z].Id), false))
+        if (!wdt.loadFile(CascStorage, map_ids[z].WdtFileDataId, Trinity::StringFormat("WDT for map {}", map_ids[z].Id), false))
+            continue;
+
+        FileChunk* mphd = wdt.GetChunk("MPHD");
+        FileChunk* main = wdt.GetChunk("MAIN");
+        FileChunk* maid = wdt.GetChunk("MAID");
+        for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
         {
-            FileChunk* mphd = wdt.GetChunk("MPHD");
-            FileChunk* main = wdt.GetChunk("MAIN");
-            FileChunk* maid = wdt.GetChunk("MAID");
-            for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
+            for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
             {
-                for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
-                {
-                    if (!(main->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1))
-                        continue;
+                if (!(main->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1))
+                    continue;
 
-                    outputFileName = Trinity::StringFormat("{}/maps/{:04}_{:02}_{:02}.map", output_path.string(), map_ids[z].Id, y, x);
-                    bool ignoreDeepWater = IsDeepWaterIgnored(map_ids[z].Id, y, x);
-                    if (mphd && mphd->As<wdt_MPHD>()->flags & 0x200)
-                    {
-                        existingTiles[y * WDT_MAP_SIZE + x] = ConvertADT(maid->As<wdt_MAID>()->adt_files[y][x].rootADT, map_ids[z].Name, outputFileName, y, x, build, ignoreDeepWater);
-                    }
-                    else
-                    {
-                        std::string storagePath = Trinity::StringFormat(R"(World\Maps\{}\{}_{}_{}.adt)", map_ids[z].Directory, map_ids[z].Directory, x, y);
-                        existingTiles[y * WDT_MAP_SIZE + x] = ConvertADT(storagePath, map_ids[z].Name, outputFileName, y, x, build, ignoreDeepWater);
-                    }
-                }
+                uint32 rootAdtFileDataId = 0;
+                if (mphd && mphd->As<wdt_MPHD>()->flags & 0x200)
+                    rootAdtFileDataId = maid->As<wdt_MAID>()->adt_files[y][x].rootADT;
 
-                // draw progress bar
-                if (PrintProgress)
-                    printf("Processing........................%d%%\r", (100 * (y + 1)) / WDT_MAP_SIZE);
+                jobs.push_back({ z, x, y, rootAdtFileDataId });
             }
         }
+    }
+
+    printf("Convert " SZFMTD " map files using %u threads\n", jobs.size(), CONF_Threads);
+    std::vector<uint8> converted(jobs.size());
+    std::atomic<std::size_t> nextJob(0);
+    std::atomic<std::size_t> doneJobs(0);
+    std::vector<std::thread> threads;
+    for (uint32 i = 1; i < CONF_Threads; ++i)
+    {
+        threads.emplace_back([&, locale]()
+        {
+            if (!OpenCascStorage(locale))
+                return;
+
+            ConvertMapTiles(jobs, nextJob, doneJobs, converted, build);
+            CascStorage.reset();
+        });
+    }
+
+    ConvertMapTiles(jobs, nextJob, doneJobs, converted, build);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // tile lists are written in map order once every tile is done, independent of the thread count
+    std::size_t job = 0;
+    for (std::size_t z = 0; z < map_ids.size(); ++z)
+    {
+        std::bitset<(WDT_MAP_SIZE) * (WDT_MAP_SIZE)> existingTiles;
+        for (; job < jobs.size() && jobs[job].MapIndex == z; ++job)
+            existingTiles[jobs[job].Y * WDT_MAP_SIZE + jobs[job].X] = converted[job] != 0;
 
         if (FILE* tileList = fopen(Trinity::StringFormat("{}/maps/{:04}.tilelist", output_path.string(), map_ids[z].Id).c_str(), "wb"))
         {
@@ -1552,7 +1616,7 @@ int main(int argc, char * arg[])
     if (CONF_extract & EXTRACT_MAP)
     {
         OpenCascStorage(firstInstalledLocale);
-        ExtractMaps(build);
+        ExtractMaps(build, firstInstalledLocale);
         CascStorage.reset();
     }
 
@@ -25,6 +25,8 @@
 #include "StringFormat.h"
 #include <DetourNavMesh.h>
 #include <DetourNavMeshBuilder.h>
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
 #include <climits>
 
 namespace MMAP
@@ -241,9 +243,10 @@ namespace MMAP
             m_tileBuilders.push_back(new TileBuilder(this, m_skipLiquid, m_bigBaseUnit, m_debugOutput));
         }
 
+        std::vector<TileInfo> tiles;
         if (mapID)
         {
-            buildMap(*mapID);
+            buildMap(*mapID, tiles);
         }
         else
         {
@@ -251,10 +254,19 @@ namespace MMAP
             for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
             {
                 if (!shouldSkipMap(it->m_mapId))
-                    buildMap(it->m_mapId);
+                    buildMap(it->m_mapId, tiles);
             }
         }
 
+        // start with the biggest tiles so that no thread is left building a huge tile alone at the end
+        std::stable_sort(tiles.begin(), tiles.end(), [](TileInfo const& left, TileInfo const& right)
+        {
+            return left.m_inputSize > right.m_inputSize;
+        });
+
+        for (TileInfo const& tileInfo : tiles)
+            _queue.Push(tileInfo);
+
         while (!_queue.Empty())
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -395,7 +407,7 @@ namespace MMAP
 
         // build navmesh tile
         TileBuilder tileBuilder = TileBuilder(this, m_skipLiquid, m_bigBaseUnit, m_debugOutput);
-        tileBuilder.buildMoveMapTile(mapId, tileX, tileY, data, bmin, bmax, navMesh);
+        tileBuilder.buildMoveMapTile(mapId, tileX, tileY, data, bmin, bmax, navMesh, {});
         fclose(file);
     }
 
@@ -422,7 +434,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMap(uint32 mapID)
+    void MapBuilder::buildMap(uint32 mapID, std::vector<TileInfo>& tileInfos)
     {
         std::set<uint32>* tiles = getTileList(mapID);
 
@@ -451,8 +463,9 @@ namespace MMAP
                 tileInfo.m_mapId = mapID;
                 tileInfo.m_tileX = tileX;
                 tileInfo.m_tileY = tileY;
+                tileInfo.m_inputSize = getTileInputSize(mapID, tileX, tileY);
                 memcpy(&tileInfo.m_navMeshParams, navMesh->getParams(), sizeof(dtNavMeshParams));
-                _queue.Push(tileInfo);
+                tileInfos.push_back(tileInfo);
             }
 
             dtFreeNavMesh(navMesh);
@@ -460,16 +473,26 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void TileBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    uint64 MapBuilder::getTileInputSize(uint32 mapID, uint32 tileX, uint32 tileY) const
     {
-        if(shouldSkipTile(mapID, tileX, tileY))
-        {
-            ++m_mapBuilder->m_totalTilesProcessed;
-            return;
-        }
+        // same file names as used by TerrainBuilder::loadMap and TerrainBuilder::loadVMap
+        boost::system::error_code error;
+        uint64 size = 0;
 
-        printf("%u%% [Map %04i] Building tile [%02u,%02u]\n", m_mapBuilder->currentPercentageDone(), mapID, tileX, tileY);
+        uintmax_t mapSize = boost::filesystem::file_size(Trinity::StringFormat("maps/{:04}_{:02}_{:02}.map", mapID, tileY, tileX), error);
+        if (!error)
+            size += mapSize;
 
+        uintmax_t vmapSize = boost::filesystem::file_size("vmaps/" + StaticMapTree::getTileFileName(mapID, tileY, tileX), error);
+        if (!error)
+            size += vmapSize;
+
+        return size;
+    }
+
+    /**************************************************************************/
+    void TileBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    {
         MeshData meshData;
 
         // get heightmap data
@@ -506,8 +529,18 @@ namespace MMAP
 
         m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_mapBuilder->m_offMeshFilePath);
 
+        // loading the input is cheap compared to building it, rebuild only tiles whose input changed
+        Trinity::Crypto::SHA1::Digest inputHash = getTileInputHash(meshData, m_mapBuilder->GetMapSpecificConfig(mapID, bmin, bmax, TileConfig(m_bigBaseUnit)));
+        if (shouldSkipTile(mapID, tileX, tileY, inputHash))
+        {
+            ++m_mapBuilder->m_totalTilesProcessed;
+            return;
+        }
+
+        printf("%u%% [Map %04i] Building tile [%02u,%02u]\n", m_mapBuilder->currentPercentageDone(), mapID, tileX, tileY);
+
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh, inputHash);
 
         ++m_mapBuilder->m_totalTilesProcessed;
     }
@@ -600,7 +633,7 @@ namespace MMAP
     /**************************************************************************/
     void TileBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
         MeshData &meshData, float bmin[3], float bmax[3],
-        dtNavMesh* navMesh)
+        dtNavMesh* navMesh, Trinity::Crypto::SHA1::Digest const& inputHash)
     {
         // console output
         std::string tileString = Trinity::StringFormat("[Map {:04}] [{:02},{:02}]: ", mapID, tileX, tileY);
@@ -910,6 +943,7 @@ namespace MMAP
             MmapTileHeader header;
             header.usesLiquids = m_terrainBuilder->usesLiquids();
             header.size = uint32(navDataSize);
+            std::copy(inputHash.begin(), inputHash.end(), std::begin(header.inputHash));
             fwrite(&header, sizeof(MmapTileHeader), 1, file);
 
             /*
@@ -1034,7 +1068,38 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    bool TileBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY) const
+    Trinity::Crypto::SHA1::Digest TileBuilder::getTileInputHash(MeshData const& meshData, rcConfig const& config) const
+    {
+        Trinity::Crypto::SHA1 hash;
+        auto hashArray = [&hash]<typename T>(G3D::Array<T> const& array)
+        {
+            uint32 size = array.size();
+            hash.UpdateData(reinterpret_cast<uint8 const*>(&size), sizeof(size));
+            hash.UpdateData(reinterpret_cast<uint8 const*>(array.getCArray()), array.size() * sizeof(T));
+        };
+
+        hashArray(meshData.solidVerts);
+        hashArray(meshData.solidTris);
+        hashArray(meshData.liquidVerts);
+        hashArray(meshData.liquidTris);
+        hashArray(meshData.liquidType);
+        hashArray(meshData.offMeshConnections);
+        hashArray(meshData.offMeshConnectionRads);
+        hashArray(meshData.offMeshConnectionDirs);
+        hashArray(meshData.offMeshConnectionsAreas);
+        hashArray(meshData.offMeshConnectionsFlags);
+
+        // GetMapSpecificConfig clears the whole struct, there is no uninitialized padding
+        hash.UpdateData(reinterpret_cast<uint8 const*>(&config), sizeof(config));
+        char usesLiquids = m_terrainBuilder->usesLiquids();
+        hash.UpdateData(reinterpret_cast<uint8 const*>(&usesLiquids), sizeof(usesLiquids));
+
+        hash.Finalize();
+        return hash.GetDigest();
+    }
+
+    /**************************************************************************/
+    bool TileBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, Trinity::Crypto::SHA1::Digest const& inputHash) const
     {
         char fileName[255];
         sprintf(fileName, "mmaps/%04u%02i%02i.mmtile", mapID, tileY, tileX);
@@ -1054,7 +1119,8 @@ namespace MMAP
         if (header.mmapVersion != MMAP_VERSION)
             return false;
 
-        return true;
+        static_assert(sizeof(header.inputHash) == Trinity::Crypto::SHA1::DIGEST_LENGTH);
+        return std::equal(inputHash.begin(), inputHash.end(), std::begin(header.inputHash));
     }
 
     rcConfig MapBuilder::GetMapSpecificConfig(uint32 mapID, float bmin[3], float bmax[3], const TileConfig &tileConfig) const
@@ -25,6 +25,7 @@
 #include <thread>
 
 #include "TerrainBuilder.h"
+#include "CryptoHash.h"
 
 #include "Recast.h"
 #include "DetourNavMesh.h"
@@ -94,11 +95,12 @@ namespace MMAP
 
     struct TileInfo
     {
-        TileInfo() : m_mapId(uint32(-1)), m_tileX(), m_tileY(), m_navMeshParams() {}
+        TileInfo() : m_mapId(uint32(-1)), m_tileX(), m_tileY(), m_inputSize(), m_navMeshParams() {}
 
         uint32 m_mapId;
         uint32 m_tileX;
         uint32 m_tileY;
+        uint64 m_inputSize; // size of the terrain and vmap files, used to queue the most expensive tiles first
         dtNavMeshParams m_navMeshParams;
     };
 
@@ -126,9 +128,13 @@ namespace MMAP
                 MeshData& meshData,
                 float bmin[3],
                 float bmax[3],
-                dtNavMesh* navMesh);
+                dtNavMesh* navMesh,
+                Trinity::Crypto::SHA1::Digest const& inputHash);
 
-            bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY) const;
+            // hash of everything the tile is built from: terrain, vmap geometry, off mesh connections and config
+            Trinity::Crypto::SHA1::Digest getTileInputHash(MeshData const& meshData, rcConfig const& config) const;
+            // checks if the existing tile was built by this generator version from the same input
+            bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, Trinity::Crypto::SHA1::Digest const& inputHash) const;
 
         private:
             bool m_bigBaseUnit;
@@ -169,8 +175,9 @@ namespace MMAP
             void buildMaps(Optional<uint32> mapID);
 
         private:
-            // builds all mmap tiles for the specified map id (ignores skip settings)
-            void buildMap(uint32 mapID);
+            // queues all mmap tiles for the specified map id (ignores skip settings)
+            void buildMap(uint32 mapID, std::vector<TileInfo>& tiles);
+            uint64 getTileInputSize(uint32 mapID, uint32 tileX, uint32 tileY) const;
             // detect maps and tiles
             void discoverTiles();
             std::set<uint32>* getTileList(uint32 mapID);
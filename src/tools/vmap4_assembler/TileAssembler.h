@@ -107,19 +107,24 @@ namespace VMAP
         private:
             std::string iDestDir;
             std::string iSrcDir;
+            uint32 iThreads;
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
 
+            template<typename Work>
+            bool runParallel(std::size_t count, Work&& work) const;
+
         public:
-            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
+            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 threads = 1);
             virtual ~TileAssembler();
 
             bool convertWorld2();
+            bool convertMap(MapSpawns& data, std::set<std::string>& modelFiles) const;
             bool readMapSpawns();
-            bool calculateTransformedBound(ModelSpawn &spawn);
+            bool calculateTransformedBound(ModelSpawn &spawn) const;
             void exportGameobjectModels();
 
-            bool convertRawFile(const std::string& pModelFilename);
+            bool convertRawFile(const std::string& pModelFilename) const;
     };
 
 }                                                           // VMAP
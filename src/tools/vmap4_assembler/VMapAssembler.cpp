@@ -15,8 +15,11 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstring>
 #include <string>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "TileAssembler.h"
 #include "Banner.h"
@@ -27,23 +30,35 @@ int main(int argc, char* argv[])
 
     std::string src = "Buildings";
     std::string dest = "vmaps";
+    uint32 threads = std::thread::hardware_concurrency();
 
-    if (argc > 3)
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
     {
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = static_cast<uint32>(std::max(0, atoi(argv[++i])));
+        else
+            paths.emplace_back(argv[i]);
+    }
+
+    if (paths.size() > 2)
+    {
+        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir> [--threads <count>]" << std::endl;
         return 1;
     }
     else
     {
-        if (argc > 1)
-            src = argv[1];
-        if (argc > 2)
-            dest = argv[2];
+        if (paths.size() > 0)
+            src = paths[0];
+        if (paths.size() > 1)
+            dest = paths[1];
     }
 
     std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
 
-    VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
+    std::cout << "using " << std::max(1u, threads) << " threads" << std::endl;
+
+    VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest, threads);
 
     if (!ta->convertWorld2())
     {
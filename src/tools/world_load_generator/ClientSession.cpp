@@ -0,0 +1,491 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ClientSession.h"
+#include "CryptoHash.h"
+#include "CryptoRandom.h"
+#include "HMAC.h"
+#include "LoadStats.h"
+#include "Opcodes.h"
+#include "SessionKeyGenerator.h"
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+std::string const ServerConnectionInitialize("WORLD OF WARCRAFT CONNECTION - SERVER TO CLIENT - V2\n");
+std::string const ClientConnectionInitialize("WORLD OF WARCRAFT CONNECTION - CLIENT TO SERVER - V2\n");
+
+// must match the seeds used by WorldSocket
+uint8 const AuthCheckSeed[16] = { 0xC5, 0xC6, 0x98, 0x95, 0x76, 0x3F, 0x1D, 0xCD, 0xB6, 0xA1, 0x37, 0x28, 0xB3, 0x12, 0xFF, 0x8A };
+uint8 const SessionKeySeed[16] = { 0x58, 0xCB, 0xCF, 0x40, 0xFE, 0x2E, 0xCE, 0xA6, 0x5A, 0x90, 0xB8, 0x01, 0x68, 0x6C, 0x28, 0x0B };
+uint8 const EncryptionKeySeed[16] = { 0xE9, 0x75, 0x3C, 0x50, 0x90, 0x93, 0x61, 0xDA, 0x3B, 0x07, 0xEE, 0xFA, 0xFF, 0x9D, 0x41, 0xB8 };
+
+uint32 const ClientPacketMagic = 0x544E4C43; // CLNT
+uint32 const ServerPacketMagic = 0x52565253; // SRVR
+
+std::size_t const PacketHeaderSize = 16;     // uint32 size followed by the 12 byte tag
+std::size_t const Ed25519SignatureSize = 64;
+uint32 const MaxPacketSize = 0x100000;
+
+Trinity::Crypto::AES::IV MakeIV(uint64 counter, uint32 magic)
+{
+    Trinity::Crypto::AES::IV iv;
+    memcpy(iv.data(), &counter, sizeof(counter));
+    memcpy(iv.data() + sizeof(counter), &magic, sizeof(magic));
+    return iv;
+}
+
+template<typename T>
+void Append(std::vector<uint8>& buffer, T value)
+{
+    uint8 const* bytes = reinterpret_cast<uint8 const*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+T Read(uint8 const* data)
+{
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+}
+}
+
+ClientSession::ClientSession(boost::asio::io_context& ioContext, LoadGeneratorConfig const& config, GameAccount const& account, LoadStats& stats)
+    : _config(config), _account(account), _stats(stats), _socket(ioContext), _enumCharactersTimer(ioContext), _pingTimer(ioContext),
+    _state(State::Connecting), _header(), _localChallenge(), _encryptKey(), _encrypt(true), _decrypt(false),
+    _sendCounter(0), _receiveCounter(0), _encrypted(false), _queued(false), _inflateStream(), _pingSerial(0), _latency(0)
+{
+    _inflateStream.zalloc = Z_NULL;
+    _inflateStream.zfree = Z_NULL;
+    _inflateStream.opaque = Z_NULL;
+    inflateInit2(&_inflateStream, -15);
+}
+
+ClientSession::~ClientSession()
+{
+    inflateEnd(&_inflateStream);
+}
+
+void ClientSession::Start(boost::asio::ip::tcp::endpoint const& endpoint)
+{
+    ++_stats.Connecting;
+    _connectTime = std::chrono::steady_clock::now();
+    _socket.async_connect(endpoint, [self = shared_from_this()](boost::system::error_code const& error)
+    {
+        --self->_stats.Connecting;
+        if (error)
+        {
+            self->Fail("connect failed");
+            return;
+        }
+
+        ++self->_stats.Connected;
+        self->_state = State::Initializing;
+
+        std::vector<uint8> initializer(ClientConnectionInitialize.begin(), ClientConnectionInitialize.end());
+        self->_sendQueue.push_back(std::move(initializer));
+        self->WriteNext();
+        self->ReadInitializer();
+    });
+}
+
+void ClientSession::Stop()
+{
+    if (_state == State::Closed)
+        return;
+
+    if (_state != State::Connecting)
+        --_stats.Connected;
+
+    if (_state == State::Authenticated)
+        --_stats.Authenticated;
+
+    if (_queued)
+        --_stats.Queued;
+
+    _state = State::Closed;
+    _enumCharactersTimer.cancel();
+    _pingTimer.cancel();
+
+    boost::system::error_code error;
+    _socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
+    _socket.close(error);
+}
+
+void ClientSession::Fail(char const* reason)
+{
+    if (_state == State::Closed)
+        return;
+
+    ++_stats.Failed;
+    std::cerr << "Session " << _account.Name << ": " << reason << std::endl;
+    Stop();
+}
+
+void ClientSession::ReadInitializer()
+{
+    _payload.resize(ServerConnectionInitialize.length());
+    boost::asio::async_read(_socket, boost::asio::buffer(_payload), [self = shared_from_this()](boost::system::error_code const& error, std::size_t /*transferred*/)
+    {
+        if (self->_state == State::Closed)
+            return;
+
+        if (error || memcmp(self->_payload.data(), ServerConnectionInitialize.data(), ServerConnectionInitialize.length()) != 0)
+        {
+            self->Fail("invalid connection initializer");
+            return;
+        }
+
+        self->_state = State::Authenticating;
+        self->ReadHeader();
+    });
+}
+
+void ClientSession::ReadHeader()
+{
+    boost::asio::async_read(_socket, boost::asio::buffer(_header), [self = shared_from_this()](boost::system::error_code const& error, std::size_t /*transferred*/)
+    {
+        if (self->_state == State::Closed)
+            return;
+
+        if (error)
+        {
+            self->Fail("connection closed by server");
+            return;
+        }
+
+        uint32 size = Read<uint32>(self->_header.data());
+        if (size < sizeof(uint16) || size > MaxPacketSize)
+        {
+            self->Fail("invalid packet size");
+            return;
+        }
+
+        self->ReadPayload(size);
+    });
+}
+
+void ClientSession::ReadPayload(uint32 size)
+{
+    _payload.resize(size);
+    boost::asio::async_read(_socket, boost::asio::buffer(_payload), [self = shared_from_this()](boost::system::error_code const& error, std::size_t /*transferred*/)
+    {
+        if (self->_state == State::Closed)
+            return;
+
+        if (error)
+        {
+            self->Fail("connection closed by server");
+            return;
+        }
+
+        ++self->_stats.PacketsReceived;
+        self->_stats.BytesReceived += PacketHeaderSize + self->_payload.size();
+
+        if (self->HandleRawPacket())
+            self->ReadHeader();
+    });
+}
+
+bool ClientSession::HandleRawPacket()
+{
+    // the server counts every packet, including the ones sent before encryption was enabled
+    if (_encrypted)
+    {
+        Trinity::Crypto::AES::Tag tag;
+        memcpy(tag, _header.data() + sizeof(uint32), sizeof(tag));
+        if (!_decrypt.Process(MakeIV(_receiveCounter, ServerPacketMagic), _payload.data(), _payload.size(), tag))
+        {
+            Fail("failed to decrypt packet");
+            return false;
+        }
+    }
+    ++_receiveCounter;
+
+    uint16 opcode = Read<uint16>(_payload.data());
+    if (opcode != SMSG_COMPRESSED_PACKET)
+        return HandlePacket(opcode, _payload.data() + sizeof(uint16), _payload.size() - sizeof(uint16));
+
+    // uncompressed size, uncompressed adler and compressed adler, then a deflate stream shared by all packets of the connection
+    std::size_t const compressionInfoSize = 3 * sizeof(uint32);
+    if (_payload.size() < sizeof(uint16) + compressionInfoSize)
+    {
+        Fail("truncated compressed packet");
+        return false;
+    }
+
+    uint32 uncompressedSize = Read<uint32>(_payload.data() + sizeof(uint16));
+    if (uncompressedSize < sizeof(uint16) || uncompressedSize > MaxPacketSize)
+    {
+        Fail("invalid compressed packet size");
+        return false;
+    }
+
+    _inflated.resize(uncompressedSize);
+    _inflateStream.next_in = _payload.data() + sizeof(uint16) + compressionInfoSize;
+    _inflateStream.avail_in = uInt(_payload.size() - sizeof(uint16) - compressionInfoSize);
+    _inflateStream.next_out = _inflated.data();
+    _inflateStream.avail_out = uncompressedSize;
+    int32 result = inflate(&_inflateStream, Z_SYNC_FLUSH);
+    if ((result != Z_OK && result != Z_STREAM_END) || _inflateStream.avail_out)
+    {
+        Fail("failed to decompress packet");
+        return false;
+    }
+
+    return HandlePacket(Read<uint16>(_inflated.data()), _inflated.data() + sizeof(uint16), _inflated.size() - sizeof(uint16));
+}
+
+bool ClientSession::HandlePacket(uint16 opcode, uint8 const* data, std::size_t size)
+{
+    switch (opcode)
+    {
+        case SMSG_AUTH_CHALLENGE:
+            return HandleAuthChallenge(data, size);
+        case SMSG_ENTER_ENCRYPTED_MODE:
+            return HandleEnterEncryptedMode(data, size);
+        case SMSG_AUTH_RESPONSE:
+            return HandleAuthResponse(data, size);
+        case SMSG_WAIT_QUEUE_FINISH:
+            if (_queued)
+            {
+                --_stats.Queued;
+                _queued = false;
+            }
+            break;
+        case SMSG_ENUM_CHARACTERS_RESULT:
+            if (_enumCharactersSentTime)
+            {
+                _stats.EnumCharacters.Record(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - *_enumCharactersSentTime));
+                _enumCharactersSentTime.reset();
+            }
+            break;
+        case SMSG_PONG:
+            if (_pingSentTime && size >= sizeof(uint32) && Read<uint32>(data) == _pingSerial)
+            {
+                Microseconds latency = std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - *_pingSentTime);
+                _stats.Ping.Record(latency);
+                _latency = uint32(std::chrono::duration_cast<Milliseconds>(latency).count());
+                _pingSentTime.reset();
+            }
+            break;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+bool ClientSession::HandleAuthChallenge(uint8 const* data, std::size_t size)
+{
+    // DosChallenge, Challenge and DosZeroBits
+    if (size < 32 + 16 + 1)
+    {
+        Fail("truncated SMSG_AUTH_CHALLENGE");
+        return false;
+    }
+
+    std::array<uint8, 16> serverChallenge;
+    memcpy(serverChallenge.data(), data + 32, serverChallenge.size());
+    Trinity::Crypto::GetRandomBytes(_localChallenge);
+
+    // same derivation as WorldSocket::HandleAuthSessionCallback, accounts log in as Wn64 clients
+    Trinity::Crypto::SHA256 digestKeyHash;
+    digestKeyHash.UpdateData(_account.KeyData.data(), _account.KeyData.size());
+    digestKeyHash.UpdateData(_config.AuthSeed.data(), _config.AuthSeed.size());
+    digestKeyHash.Finalize();
+
+    Trinity::Crypto::HMAC_SHA256 hmac(digestKeyHash.GetDigest());
+    hmac.UpdateData(_localChallenge);
+    hmac.UpdateData(serverChallenge);
+    hmac.UpdateData(AuthCheckSeed, 16);
+    hmac.Finalize();
+
+    Trinity::Crypto::SHA256 keyDataHash;
+    keyDataHash.UpdateData(_account.KeyData.data(), _account.KeyData.size());
+    keyDataHash.Finalize();
+
+    Trinity::Crypto::HMAC_SHA256 sessionKeyHmac(keyDataHash.GetDigest());
+    sessionKeyHmac.UpdateData(serverChallenge);
+    sessionKeyHmac.UpdateData(_localChallenge);
+    sessionKeyHmac.UpdateData(SessionKeySeed, 16);
+    sessionKeyHmac.Finalize();
+
+    std::array<uint8, 40> sessionKey;
+    SessionKeyGenerator<Trinity::Crypto::SHA256> sessionKeyGenerator(sessionKeyHmac.GetDigest());
+    sessionKeyGenerator.Generate(sessionKey.data(), sessionKey.size());
+
+    Trinity::Crypto::HMAC_SHA256 encryptKeyGen(sessionKey);
+    encryptKeyGen.UpdateData(_localChallenge);
+    encryptKeyGen.UpdateData(serverChallenge);
+    encryptKeyGen.UpdateData(EncryptionKeySeed, 16);
+    encryptKeyGen.Finalize();
+    memcpy(_encryptKey.data(), encryptKeyGen.GetDigest().data(), _encryptKey.size());
+
+    std::vector<uint8> authSession;
+    Append<uint64>(authSession, 0);                 // DosResponse
+    Append<uint32>(authSession, _config.RegionId);
+    Append<uint32>(authSession, _config.BattlegroupId);
+    Append<uint32>(authSession, _config.RealmId);
+    authSession.insert(authSession.end(), _localChallenge.begin(), _localChallenge.end());
+    authSession.insert(authSession.end(), hmac.GetDigest().begin(), hmac.GetDigest().begin() + 24);
+    authSession.push_back(0);                       // UseIPv6 bit
+    Append<uint32>(authSession, uint32(_account.Name.length()));
+    authSession.insert(authSession.end(), _account.Name.begin(), _account.Name.end());
+    SendPacket(CMSG_AUTH_SESSION, authSession);
+    return true;
+}
+
+bool ClientSession::HandleEnterEncryptedMode(uint8 const* data, std::size_t size)
+{
+    // the signature is not checked, the load generator trusts the server it was pointed at
+    if (size < Ed25519SignatureSize + 1 || !(data[Ed25519SignatureSize] & 0x80))
+    {
+        Fail("server did not enable encryption");
+        return false;
+    }
+
+    // the acknowledgement is the last packet sent in plain text
+    SendPacket(CMSG_ENTER_ENCRYPTED_MODE_ACK);
+    _encrypt.Init(_encryptKey);
+    _decrypt.Init(_encryptKey);
+    _encrypted = true;
+    return true;
+}
+
+bool ClientSession::HandleAuthResponse(uint8 const* data, std::size_t size)
+{
+    if (size < sizeof(uint32) + 1)
+    {
+        Fail("truncated SMSG_AUTH_RESPONSE");
+        return false;
+    }
+
+    if (uint32 result = Read<uint32>(data))
+    {
+        std::cerr << "Session " << _account.Name << ": authentication failed with result " << result << std::endl;
+        Fail("authentication failed");
+        return false;
+    }
+
+    // sent again when leaving the login queue
+    if (_state == State::Authenticated)
+        return true;
+
+    _state = State::Authenticated;
+    ++_stats.Authenticated;
+    _stats.Authentication.Record(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - _connectTime));
+
+    // SuccessInfo and WaitInfo presence bits
+    if (data[sizeof(uint32)] & 0x40)
+    {
+        ++_stats.Queued;
+        _queued = true;
+    }
+
+    ScheduleEnumCharacters(0ms);
+    SchedulePing(_config.PingInterval);
+    return true;
+}
+
+void ClientSession::SendPacket(uint16 opcode, std::vector<uint8> const& payload)
+{
+    std::vector<uint8> packet(PacketHeaderSize);
+    packet.reserve(PacketHeaderSize + sizeof(opcode) + payload.size());
+    Append(packet, opcode);
+    packet.insert(packet.end(), payload.begin(), payload.end());
+
+    uint32 size = uint32(sizeof(opcode) + payload.size());
+    memcpy(packet.data(), &size, sizeof(size));
+    if (_encrypted)
+    {
+        Trinity::Crypto::AES::Tag tag;
+        _encrypt.Process(MakeIV(_sendCounter, ClientPacketMagic), packet.data() + PacketHeaderSize, size, tag);
+        memcpy(packet.data() + sizeof(size), tag, sizeof(tag));
+    }
+    ++_sendCounter;
+
+    ++_stats.PacketsSent;
+    _stats.BytesSent += packet.size();
+
+    _sendQueue.push_back(std::move(packet));
+    if (_sendQueue.size() == 1)
+        WriteNext();
+}
+
+void ClientSession::WriteNext()
+{
+    boost::asio::async_write(_socket, boost::asio::buffer(_sendQueue.front()), [self = shared_from_this()](boost::system::error_code const& error, std::size_t /*transferred*/)
+    {
+        if (self->_state == State::Closed)
+            return;
+
+        if (error)
+        {
+            self->Fail("write failed");
+            return;
+        }
+
+        self->_sendQueue.pop_front();
+        if (!self->_sendQueue.empty())
+            self->WriteNext();
+    });
+}
+
+void ClientSession::ScheduleEnumCharacters(Milliseconds delay)
+{
+    _enumCharactersTimer.expires_after(delay);
+    _enumCharactersTimer.async_wait([self = shared_from_this()](boost::system::error_code const& error)
+    {
+        if (error || self->_state != State::Authenticated)
+            return;
+
+        // a request still waiting for its answer is reported as the time it takes, do not restart it
+        if (!self->_enumCharactersSentTime)
+        {
+            self->_enumCharactersSentTime = std::chrono::steady_clock::now();
+            self->SendPacket(CMSG_ENUM_CHARACTERS);
+        }
+
+        self->ScheduleEnumCharacters(self->_config.EnumCharactersInterval);
+    });
+}
+
+void ClientSession::SchedulePing(Milliseconds delay)
+{
+    _pingTimer.expires_after(delay);
+    _pingTimer.async_wait([self = shared_from_this()](boost::system::error_code const& error)
+    {
+        if (error || self->_state != State::Authenticated)
+            return;
+
+        if (!self->_pingSentTime)
+        {
+            self->_pingSentTime = std::chrono::steady_clock::now();
+            std::vector<uint8> ping;
+            Append<uint32>(ping, ++self->_pingSerial);
+            Append<uint32>(ping, self->_latency);
+            self->SendPacket(CMSG_PING, ping);
+        }
+
+        self->SchedulePing(self->_config.PingInterval);
+    });
+}
@@ -0,0 +1,126 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ClientSession_h__
+#define ClientSession_h__
+
+#include "AES.h"
+#include "Define.h"
+#include "Duration.h"
+#include "Optional.h"
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <array>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+struct LoadStats;
+
+struct LoadGeneratorConfig
+{
+    uint32 RegionId = 0;
+    uint32 BattlegroupId = 0;
+    uint32 RealmId = 0;
+    std::array<uint8, 16> AuthSeed = { };
+    Milliseconds EnumCharactersInterval = 10s;
+    Milliseconds PingInterval = 30s;
+};
+
+struct GameAccount
+{
+    std::string Name;
+    std::array<uint8, 64> KeyData;
+};
+
+/// One headless client connection to the worldserver. Performs the connection handshake,
+/// authentication and encryption like the game client, then keeps sending requests that
+/// exercise the realm (character list, ping) and records their latency.
+class ClientSession : public std::enable_shared_from_this<ClientSession>
+{
+public:
+    ClientSession(boost::asio::io_context& ioContext, LoadGeneratorConfig const& config, GameAccount const& account, LoadStats& stats);
+    ~ClientSession();
+
+    ClientSession(ClientSession const&) = delete;
+    ClientSession& operator=(ClientSession const&) = delete;
+
+    void Start(boost::asio::ip::tcp::endpoint const& endpoint);
+    void Stop();
+
+private:
+    enum class State
+    {
+        Connecting,
+        Initializing,
+        Authenticating,
+        Authenticated,
+        Closed
+    };
+
+    void ReadInitializer();
+    void ReadHeader();
+    void ReadPayload(uint32 size);
+    bool HandleRawPacket();
+    bool HandlePacket(uint16 opcode, uint8 const* data, std::size_t size);
+
+    bool HandleAuthChallenge(uint8 const* data, std::size_t size);
+    bool HandleEnterEncryptedMode(uint8 const* data, std::size_t size);
+    bool HandleAuthResponse(uint8 const* data, std::size_t size);
+
+    void SendPacket(uint16 opcode, std::vector<uint8> const& payload = {});
+    void WriteNext();
+
+    void ScheduleEnumCharacters(Milliseconds delay);
+    void SchedulePing(Milliseconds delay);
+
+    void Fail(char const* reason);
+
+    LoadGeneratorConfig const& _config;
+    GameAccount const& _account;
+    LoadStats& _stats;
+
+    boost::asio::ip::tcp::socket _socket;
+    boost::asio::steady_timer _enumCharactersTimer;
+    boost::asio::steady_timer _pingTimer;
+    State _state;
+    TimePoint _connectTime;
+
+    std::array<uint8, 16> _header;
+    std::vector<uint8> _payload;
+    std::vector<uint8> _inflated;
+    std::deque<std::vector<uint8>> _sendQueue;
+
+    std::array<uint8, 16> _localChallenge;
+    std::array<uint8, 16> _encryptKey;
+    Trinity::Crypto::AES _encrypt;
+    Trinity::Crypto::AES _decrypt;
+    uint64 _sendCounter;
+    uint64 _receiveCounter;
+    bool _encrypted;
+    bool _queued;
+    z_stream _inflateStream;
+
+    Optional<TimePoint> _enumCharactersSentTime;
+    uint32 _pingSerial;
+    Optional<TimePoint> _pingSentTime;
+    uint32 _latency;
+};
+
+#endif // ClientSession_h__
@@ -0,0 +1,252 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Banner.h"
+#include "ClientSession.h"
+#include "CryptoHash.h"
+#include "GitRevision.h"
+#include "LoadStats.h"
+#include "Util.h"
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/program_options.hpp>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+using namespace boost::program_options;
+
+namespace
+{
+struct Options
+{
+    std::string Host;
+    uint16 Port = 8085;
+    std::string AuthSeed;
+    std::string AccountsFile;
+    std::string KeySecret;
+    uint32 Connections = 0;
+    uint32 Threads = 0;
+    uint32 RampUpSeconds = 0;
+    uint32 DurationSeconds = 0;
+    uint32 EnumCharactersIntervalSeconds = 0;
+    uint32 PingIntervalSeconds = 0;
+    uint32 ReportIntervalSeconds = 0;
+    bool Json = false;
+    bool PrintProvisioningSql = false;
+};
+
+// Key data is derived from the account name so that the load generator and the provisioning
+// script agree on it without having to store per account secrets anywhere
+std::array<uint8, 64> MakeKeyData(std::string const& secret, std::string const& accountName)
+{
+    std::array<uint8, 64> keyData;
+    for (uint8 half = 0; half < 2; ++half)
+    {
+        Trinity::Crypto::SHA256 hash;
+        hash.UpdateData(secret);
+        hash.UpdateData(accountName);
+        hash.UpdateData(&half, 1);
+        hash.Finalize();
+        memcpy(keyData.data() + half * Trinity::Crypto::SHA256::DIGEST_LENGTH, hash.GetDigest().data(), Trinity::Crypto::SHA256::DIGEST_LENGTH);
+    }
+    return keyData;
+}
+
+bool LoadAccounts(Options const& options, std::vector<GameAccount>& accounts)
+{
+    std::ifstream file(options.AccountsFile);
+    if (!file)
+    {
+        std::cerr << "Cannot open accounts file " << options.AccountsFile << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        accounts.push_back({ line, MakeKeyData(options.KeySecret, line) });
+    }
+
+    if (accounts.empty())
+    {
+        std::cerr << "Accounts file " << options.AccountsFile << " does not contain any game account" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+}
+
+int main(int argc, char** argv)
+{
+    Trinity::Banner::Show("World load generator", [](char const* text) { printf("%s\n", text); }, nullptr);
+
+    Options options;
+    options_description all("Allowed options");
+    all.add_options()
+        ("help,h", "print usage message")
+        ("version,v", "print version build info")
+        ("host", value<std::string>(&options.Host)->default_value("127.0.0.1"), "worldserver address")
+        ("port", value<uint16>(&options.Port)->default_value(8085), "worldserver port")
+        ("realm-id", value<uint32>()->default_value(1), "realm id as configured in the auth database")
+        ("region-id", value<uint32>()->default_value(1), "realm region id")
+        ("battlegroup-id", value<uint32>()->default_value(1), "realm battlegroup id")
+        ("auth-seed", value<std::string>(&options.AuthSeed), "Win64AuthSeed of the build the server expects, in hex")
+        ("accounts", value<std::string>(&options.AccountsFile), "file listing one game account name (e.g. 1#1) per line")
+        ("key-secret", value<std::string>(&options.KeySecret)->default_value("loadtest"), "secret used to derive the session keys of the accounts")
+        ("connections", value<uint32>(&options.Connections)->default_value(100), "number of concurrent clients")
+        ("threads", value<uint32>(&options.Threads)->default_value(std::max(1u, std::thread::hardware_concurrency())), "network threads")
+        ("ramp-up", value<uint32>(&options.RampUpSeconds)->default_value(10), "seconds over which clients connect")
+        ("duration", value<uint32>(&options.DurationSeconds)->default_value(60), "seconds to run, 0 to run until killed")
+        ("enum-characters-interval", value<uint32>(&options.EnumCharactersIntervalSeconds)->default_value(10), "seconds between character list requests")
+        ("ping-interval", value<uint32>(&options.PingIntervalSeconds)->default_value(30), "seconds between pings, lower values trigger the server's over-speed ping kick")
+        ("report-interval", value<uint32>(&options.ReportIntervalSeconds)->default_value(5), "seconds between reports")
+        ("json", bool_switch(&options.Json), "print reports as one JSON object per line")
+        ("print-provisioning-sql", bool_switch(&options.PrintProvisioningSql), "print the SQL that installs the session keys of the accounts and exit")
+        ;
+
+    variables_map variablesMap;
+    try
+    {
+        store(command_line_parser(argc, argv).options(all).run(), variablesMap);
+        notify(variablesMap);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    if (variablesMap.count("help"))
+    {
+        std::cout << all << "\n";
+        return 0;
+    }
+
+    if (variablesMap.count("version"))
+    {
+        std::cout << GitRevision::GetFullVersion() << "\n";
+        return 0;
+    }
+
+    if (options.AccountsFile.empty())
+    {
+        std::cerr << "--accounts is required\n";
+        return 1;
+    }
+
+    std::vector<GameAccount> accounts;
+    if (!LoadAccounts(options, accounts))
+        return 1;
+
+    if (options.PrintProvisioningSql)
+    {
+        // Wn64 selects the auth seed passed with --auth-seed and has no warden module to answer
+        for (GameAccount const& account : accounts)
+            std::cout << "UPDATE account SET session_key_bnet = 0x" << ByteArrayToHexStr(account.KeyData) << ", os = 'Wn64' WHERE username = '" << account.Name << "';\n";
+        return 0;
+    }
+
+    LoadGeneratorConfig config;
+    config.RegionId = variablesMap["region-id"].as<uint32>();
+    config.BattlegroupId = variablesMap["battlegroup-id"].as<uint32>();
+    config.RealmId = variablesMap["realm-id"].as<uint32>();
+    config.EnumCharactersInterval = Seconds(std::max(1u, options.EnumCharactersIntervalSeconds));
+    config.PingInterval = Seconds(std::max(1u, options.PingIntervalSeconds));
+    if (options.AuthSeed.length() != config.AuthSeed.size() * 2)
+    {
+        std::cerr << "--auth-seed must be " << config.AuthSeed.size() * 2 << " hex characters\n";
+        return 1;
+    }
+    HexStrToByteArray(options.AuthSeed, config.AuthSeed);
+
+    if (options.Connections > accounts.size())
+    {
+        std::cerr << "Only " << accounts.size() << " accounts available for " << options.Connections << " connections, a game account can only be logged in once\n";
+        return 1;
+    }
+
+    boost::system::error_code error;
+    boost::asio::ip::address address = boost::asio::ip::make_address(options.Host, error);
+    if (error)
+    {
+        std::cerr << "Invalid worldserver address " << options.Host << "\n";
+        return 1;
+    }
+
+    boost::asio::ip::tcp::endpoint endpoint(address, options.Port);
+
+    LoadStats stats;
+    uint32 threadCount = std::max(1u, options.Threads);
+    std::vector<std::unique_ptr<boost::asio::io_context>> ioContexts;
+    std::vector<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> workGuards;
+    std::vector<std::thread> threads;
+    for (uint32 i = 0; i < threadCount; ++i)
+    {
+        ioContexts.push_back(std::make_unique<boost::asio::io_context>(1));
+        workGuards.push_back(boost::asio::make_work_guard(*ioContexts.back()));
+    }
+
+    for (std::unique_ptr<boost::asio::io_context>& ioContext : ioContexts)
+        threads.emplace_back([ioContext = ioContext.get()]() { ioContext->run(); });
+
+    std::vector<std::shared_ptr<ClientSession>> sessions;
+    sessions.reserve(options.Connections);
+
+    TimePoint start = std::chrono::steady_clock::now();
+    TimePoint nextReport = start + Seconds(options.ReportIntervalSeconds);
+    Seconds duration(options.DurationSeconds);
+    Milliseconds connectInterval = options.Connections ? Milliseconds(options.RampUpSeconds * 1000 / options.Connections) : 0ms;
+
+    while (!options.DurationSeconds || std::chrono::steady_clock::now() - start < duration)
+    {
+        TimePoint now = std::chrono::steady_clock::now();
+        while (sessions.size() < options.Connections && now - start >= connectInterval * sessions.size())
+        {
+            boost::asio::io_context& ioContext = *ioContexts[sessions.size() % ioContexts.size()];
+            std::shared_ptr<ClientSession> session = std::make_shared<ClientSession>(ioContext, config, accounts[sessions.size()], stats);
+            boost::asio::post(ioContext, [session, endpoint]() { session->Start(endpoint); });
+            sessions.push_back(std::move(session));
+        }
+
+        if (options.ReportIntervalSeconds && now >= nextReport)
+        {
+            std::cout << stats.Report(std::chrono::duration_cast<Seconds>(now - start), Seconds(options.ReportIntervalSeconds), options.Json) << std::endl;
+            nextReport += Seconds(options.ReportIntervalSeconds);
+        }
+
+        std::this_thread::sleep_for(std::min<Milliseconds>(std::max(connectInterval, 1ms), 100ms));
+    }
+
+    for (std::size_t i = 0; i < sessions.size(); ++i)
+        boost::asio::post(*ioContexts[i % ioContexts.size()], [session = sessions[i]]() { session->Stop(); });
+
+    workGuards.clear();
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::cout << stats.Report(duration, duration, options.Json) << std::endl;
+    return 0;
+}
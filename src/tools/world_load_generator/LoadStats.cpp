@@ -0,0 +1,102 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoadStats.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <numeric>
+
+void LatencyRecorder::Record(Microseconds latency)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _samples.push_back(latency.count());
+}
+
+LatencyRecorder::Summary LatencyRecorder::Consume()
+{
+    std::vector<int64> samples;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        samples.swap(_samples);
+    }
+
+    Summary summary;
+    if (samples.empty())
+        return summary;
+
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](double p)
+    {
+        std::size_t index = std::min(samples.size() - 1, std::size_t(p * double(samples.size())));
+        return double(samples[index]) / 1000.0;
+    };
+
+    summary.Count = samples.size();
+    summary.MeanMs = double(std::accumulate(samples.begin(), samples.end(), int64(0))) / double(samples.size()) / 1000.0;
+    summary.P50Ms = percentile(0.5);
+    summary.P90Ms = percentile(0.9);
+    summary.P99Ms = percentile(0.99);
+    summary.MaxMs = double(samples.back()) / 1000.0;
+    return summary;
+}
+
+namespace
+{
+std::string FormatLatency(char const* name, LatencyRecorder::Summary const& summary, bool json)
+{
+    if (json)
+        return Trinity::StringFormat(R"("{}":{{"count":{},"meanMs":{:.3f},"p50Ms":{:.3f},"p90Ms":{:.3f},"p99Ms":{:.3f},"maxMs":{:.3f}}})",
+            name, summary.Count, summary.MeanMs, summary.P50Ms, summary.P90Ms, summary.P99Ms, summary.MaxMs);
+
+    if (!summary.Count)
+        return Trinity::StringFormat(" | {}: -", name);
+
+    return Trinity::StringFormat(" | {}: n={} mean={:.1f}ms p50={:.1f}ms p90={:.1f}ms p99={:.1f}ms max={:.1f}ms",
+        name, summary.Count, summary.MeanMs, summary.P50Ms, summary.P90Ms, summary.P99Ms, summary.MaxMs);
+}
+}
+
+std::string LoadStats::Report(Seconds elapsed, Seconds interval, bool json)
+{
+    uint64 packetsReceived = PacketsReceived;
+    uint64 bytesReceived = BytesReceived;
+    uint64 packetsSent = PacketsSent;
+    double seconds = std::max<double>(1.0, double(interval.count()));
+
+    double receivedPacketRate = double(packetsReceived - _lastPacketsReceived) / seconds;
+    double receivedByteRate = double(bytesReceived - _lastBytesReceived) / seconds;
+    double sentPacketRate = double(packetsSent - _lastPacketsSent) / seconds;
+    _lastPacketsReceived = packetsReceived;
+    _lastBytesReceived = bytesReceived;
+    _lastPacketsSent = packetsSent;
+
+    LatencyRecorder::Summary authentication = Authentication.Consume();
+    LatencyRecorder::Summary enumCharacters = EnumCharacters.Consume();
+    LatencyRecorder::Summary ping = Ping.Consume();
+
+    if (json)
+        return Trinity::StringFormat(R"({{"elapsed":{},"connecting":{},"connected":{},"authenticated":{},"queued":{},"failed":{},)"
+            R"("receivedPacketsPerSecond":{:.1f},"receivedBytesPerSecond":{:.1f},"sentPacketsPerSecond":{:.1f},{},{},{}}})",
+            elapsed.count(), uint32(Connecting), uint32(Connected), uint32(Authenticated), uint32(Queued), uint32(Failed),
+            receivedPacketRate, receivedByteRate, sentPacketRate,
+            FormatLatency("authentication", authentication, true), FormatLatency("enumCharacters", enumCharacters, true), FormatLatency("ping", ping, true));
+
+    return Trinity::StringFormat("[{:>5}s] sessions: {} connecting, {} connected, {} authenticated, {} queued, {} failed | in: {:.0f} packets/s {:.1f} KB/s, out: {:.0f} packets/s{}{}{}",
+        elapsed.count(), uint32(Connecting), uint32(Connected), uint32(Authenticated), uint32(Queued), uint32(Failed),
+        receivedPacketRate, receivedByteRate / 1024.0, sentPacketRate,
+        FormatLatency("auth", authentication, false), FormatLatency("enum characters", enumCharacters, false), FormatLatency("ping", ping, false));
+}
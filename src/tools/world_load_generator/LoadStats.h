@@ -0,0 +1,76 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LoadStats_h__
+#define LoadStats_h__
+
+#include "Define.h"
+#include "Duration.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class LatencyRecorder
+{
+public:
+    struct Summary
+    {
+        std::size_t Count = 0;
+        double MeanMs = 0.0;
+        double P50Ms = 0.0;
+        double P90Ms = 0.0;
+        double P99Ms = 0.0;
+        double MaxMs = 0.0;
+    };
+
+    void Record(Microseconds latency);
+
+    // summarizes the samples recorded since the previous call
+    Summary Consume();
+
+private:
+    std::mutex _lock;
+    std::vector<int64> _samples;
+};
+
+struct LoadStats
+{
+    std::atomic<uint32> Connecting = 0;
+    std::atomic<uint32> Connected = 0;
+    std::atomic<uint32> Authenticated = 0;
+    std::atomic<uint32> Queued = 0;
+    std::atomic<uint32> Failed = 0;
+    std::atomic<uint64> PacketsReceived = 0;
+    std::atomic<uint64> BytesReceived = 0;
+    std::atomic<uint64> PacketsSent = 0;
+    std::atomic<uint64> BytesSent = 0;
+
+    LatencyRecorder Authentication;
+    LatencyRecorder EnumCharacters;
+    LatencyRecorder Ping;
+
+    // one report line per interval, or a JSON object per line when json is set
+    std::string Report(Seconds elapsed, Seconds interval, bool json);
+
+private:
+    uint64 _lastPacketsReceived = 0;
+    uint64 _lastBytesReceived = 0;
+    uint64 _lastPacketsSent = 0;
+};
+
+#endif // LoadStats_h__
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "GitRevision.h"
+#include <iomanip>
+#include <vector>
+
+namespace
+{
+// Writes the results of all benchmarks run as one JSON document, select with "--reporter json"
+class JsonReporter : public Catch::StreamingReporterBase<JsonReporter>
+{
+public:
+    using StreamingReporterBase::StreamingReporterBase;
+
+    static std::string getDescription() { return "Reports benchmark results as JSON"; }
+
+    void assertionStarting(Catch::AssertionInfo const& /*assertionInfo*/) override { }
+    bool assertionEnded(Catch::AssertionStats const& /*assertionStats*/) override { return true; }
+
+    void benchmarkEnded(Catch::BenchmarkStats<> const& stats) override
+    {
+        Result& result = _results.emplace_back();
+        result.TestCase = currentTestCaseInfo->name;
+        result.Stats = stats;
+    }
+
+    void testRunEnded(Catch::TestRunStats const& testRunStats) override
+    {
+        stream << "{\n";
+        stream << "  \"revision\": \"" << GitRevision::GetHash() << "\",\n";
+        stream << "  \"revisionDate\": \"" << GitRevision::GetDate() << "\",\n";
+        stream << "  \"benchmarks\": [";
+        for (std::size_t i = 0; i < _results.size(); ++i)
+        {
+            Catch::BenchmarkStats<> const& stats = _results[i].Stats;
+            stream << (i ? ",\n" : "\n");
+            stream << "    {\n";
+            stream << "      \"testCase\": "; WriteString(_results[i].TestCase); stream << ",\n";
+            stream << "      \"name\": "; WriteString(stats.info.name); stream << ",\n";
+            stream << "      \"samples\": " << stats.info.samples << ",\n";
+            stream << "      \"iterations\": " << stats.info.iterations << ",\n";
+            stream << std::fixed << std::setprecision(3);
+            stream << "      \"meanNs\": " << stats.mean.point.count() << ",\n";
+            stream << "      \"meanLowerBoundNs\": " << stats.mean.lower_bound.count() << ",\n";
+            stream << "      \"meanUpperBoundNs\": " << stats.mean.upper_bound.count() << ",\n";
+            stream << "      \"standardDeviationNs\": " << stats.standardDeviation.point.count() << ",\n";
+            stream << "      \"outlierVariance\": " << stats.outlierVariance << "\n";
+            stream << std::defaultfloat;
+            stream << "    }";
+        }
+        stream << "\n  ]\n}\n";
+
+        StreamingReporterBase::testRunEnded(testRunStats);
+    }
+
+private:
+    void WriteString(std::string const& value)
+    {
+        stream << '"';
+        for (char c : value)
+        {
+            if (c == '"' || c == '\\')
+                stream << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec << std::setfill(' ');
+            else
+                stream << c;
+        }
+        stream << '"';
+    }
+
+    struct Result
+    {
+        std::string TestCase;
+        Catch::BenchmarkStats<> Stats;
+    };
+
+    std::vector<Result> _results;
+};
+}
+
+CATCH_REGISTER_REPORTER("json", JsonReporter)
@@ -0,0 +1,125 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Define.h"
+#include "FlatSet.h"
+#include "MPSCQueue.h"
+#include <random>
+#include <set>
+#include <thread>
+
+namespace
+{
+struct Message
+{
+    uint32 Value;
+};
+}
+
+TEST_CASE("FlatSet", "[FlatSet]")
+{
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<uint32> value(0, 10000);
+    std::vector<uint32> values(64);
+    for (uint32& v : values)
+        v = value(rng);
+
+    BENCHMARK("insert 64")
+    {
+        Trinity::Containers::FlatSet<uint32> flat;
+        for (uint32 v : values)
+            flat.insert(v);
+        return flat.size();
+    };
+
+    Trinity::Containers::FlatSet<uint32> flat;
+    for (uint32 v : values)
+        flat.insert(v);
+
+    BENCHMARK("find 64")
+    {
+        uint32 found = 0;
+        for (uint32 v : values)
+            found += flat.find(v) != flat.end();
+        return found;
+    };
+}
+
+TEST_CASE("MPSCQueue", "[MPSCQueue]")
+{
+    BENCHMARK("bounded, single producer")
+    {
+        Trinity::MPSCQueueBounded<uint32> queue(1024);
+        uint32 sum = 0;
+        for (uint32 i = 0; i < 1000; ++i)
+            queue.Enqueue(i);
+
+        uint32 value;
+        while (queue.Dequeue(value))
+            sum += value;
+        return sum;
+    };
+
+    BENCHMARK("bounded, four producers")
+    {
+        constexpr uint32 ValuesPerProducer = 1000;
+        Trinity::MPSCQueueBounded<uint32, Trinity::MPSCQueueOverflowPolicy::Block> queue(256);
+        std::vector<std::thread> producers;
+        for (uint32 producer = 0; producer < 4; ++producer)
+        {
+            producers.emplace_back([&queue]
+            {
+                for (uint32 i = 0; i < ValuesPerProducer; ++i)
+                    queue.Enqueue(i);
+            });
+        }
+
+        uint64 sum = 0;
+        uint32 received = 0;
+        uint32 value;
+        while (received < 4 * ValuesPerProducer)
+        {
+            if (queue.Dequeue(value))
+            {
+                sum += value;
+                ++received;
+            }
+        }
+
+        for (std::thread& producer : producers)
+            producer.join();
+        return sum;
+    };
+
+    BENCHMARK("unbounded, single producer")
+    {
+        MPSCQueue<Message> queue;
+        for (uint32 i = 0; i < 1000; ++i)
+            queue.Enqueue(new Message{ i });
+
+        Message* message;
+        uint32 sum = 0;
+        while (queue.Dequeue(message))
+        {
+            sum += message->Value;
+            delete message;
+        }
+        return sum;
+    };
+}
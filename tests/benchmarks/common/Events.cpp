@@ -0,0 +1,86 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "EventMap.h"
+#include "EventProcessor.h"
+#include "TaskScheduler.h"
+
+TEST_CASE("EventMap", "[EventMap]")
+{
+    BENCHMARK("boss fight")
+    {
+        uint32 executed = 0;
+        EventMap events;
+        for (uint32 i = 1; i <= 8; ++i)
+            events.ScheduleEvent(i, Milliseconds(500 * i), i % 2 + 1);
+
+        for (uint32 update = 0; update < 1000; ++update)
+        {
+            events.Update(100);
+            while (uint32 eventId = events.ExecuteEvent())
+            {
+                ++executed;
+                events.Repeat(Milliseconds(1000 + eventId * 100));
+            }
+
+            if (update % 200 == 199)
+                events.DelayEvents(1s, update / 200 % 2 + 1);
+        }
+        return executed;
+    };
+}
+
+TEST_CASE("EventProcessor", "[EventProcessor]")
+{
+    BENCHMARK("lambda events")
+    {
+        uint32 executed = 0;
+        EventProcessor events;
+        for (uint32 update = 0; update < 1000; ++update)
+        {
+            for (uint32 i = 0; i < 4; ++i)
+                events.AddEventAtOffset([&executed] { ++executed; }, Milliseconds(100 + i * 250));
+
+            events.Update(100);
+        }
+
+        events.KillAllEvents(true);
+        return executed;
+    };
+}
+
+TEST_CASE("TaskScheduler", "[TaskScheduler]")
+{
+    BENCHMARK("1000 creature scripts")
+    {
+        uint32 executed = 0;
+        std::vector<TaskScheduler> schedulers(1000);
+        for (TaskScheduler& scheduler : schedulers)
+        {
+            scheduler.Schedule(2s, [&executed](TaskContext context) { ++executed; context.Repeat(5s); });
+            scheduler.Schedule(3s, 6s, [&executed](TaskContext context) { ++executed; context.Repeat(8s, 12s); });
+            scheduler.Schedule(10s, [&executed](TaskContext /*context*/) { ++executed; });
+        }
+
+        for (uint32 update = 0; update < 100; ++update)
+            for (TaskScheduler& scheduler : schedulers)
+                scheduler.Update(200ms);
+        return executed;
+    };
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ByteBuffer.h"
+#include "MessageBuffer.h"
+
+TEST_CASE("ByteBuffer", "[ByteBuffer]")
+{
+    std::string_view name = "Stormwind Guard";
+
+    BENCHMARK("write update block")
+    {
+        ByteBuffer buffer;
+        for (uint32 i = 0; i < 500; ++i)
+        {
+            buffer << uint32(i);
+            buffer << float(i * 0.5f);
+            buffer << uint64(i) * 3;
+            buffer.WriteBit(i & 1);
+            buffer.WriteBits(i, 7);
+            buffer.FlushBits();
+            buffer.WriteString(name);
+        }
+        return buffer.size();
+    };
+
+    ByteBuffer packet;
+    for (uint32 i = 0; i < 500; ++i)
+    {
+        packet << uint32(i);
+        packet << float(i * 0.5f);
+        packet << uint64(i) * 3;
+        packet.WriteBits(name.length(), 8);
+        packet.FlushBits();
+        packet.WriteString(name);
+    }
+
+    BENCHMARK("read update block")
+    {
+        packet.rpos(0);
+        uint64 sum = 0;
+        for (uint32 i = 0; i < 500; ++i)
+        {
+            sum += packet.read<uint32>();
+            sum += uint64(packet.read<float>());
+            sum += packet.read<uint64>();
+            uint32 length = packet.ReadBits(8);
+            packet.ResetBitPos();
+            sum += packet.ReadString(length).size();
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("MessageBuffer", "[MessageBuffer]")
+{
+    std::vector<uint8> message(60, 0x2A);
+
+    BENCHMARK("write and consume packets")
+    {
+        MessageBuffer buffer;
+        std::size_t consumed = 0;
+        for (uint32 i = 0; i < 2000; ++i)
+        {
+            buffer.Normalize();
+            buffer.EnsureFreeSpace();
+            buffer.Write(message.data(), message.size());
+            if (i % 4 == 3)
+            {
+                consumed += buffer.GetActiveSize();
+                buffer.ReadCompleted(buffer.GetActiveSize());
+            }
+        }
+        return consumed;
+    };
+}
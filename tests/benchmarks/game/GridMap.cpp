@@ -0,0 +1,92 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "GridMap.h"
+#include <filesystem>
+#include <random>
+
+namespace
+{
+// map file with float heights and no liquid, like most extracted tiles
+std::string WriteMapFile()
+{
+    std::string fileName = (std::filesystem::temp_directory_path() / "tc_benchmarks_gridmap.map").string();
+    FILE* file = fopen(fileName.c_str(), "wb");
+    REQUIRE(file);
+
+    uint32 heightSize = sizeof(map_heightHeader) + sizeof(float) * (129 * 129 + 128 * 128);
+    map_fileheader header = { };
+    header.mapMagic = MapMagic;
+    header.versionMagic = MapVersionMagic;
+    header.heightMapOffset = sizeof(map_fileheader);
+    header.heightMapSize = heightSize;
+    fwrite(&header, sizeof(header), 1, file);
+
+    map_heightHeader heightHeader;
+    heightHeader.heightMagic = MapHeightMagic;
+    heightHeader.flags = map_heightHeaderFlags::None;
+    heightHeader.gridHeight = -10.0f;
+    heightHeader.gridMaxHeight = 90.0f;
+    fwrite(&heightHeader, sizeof(heightHeader), 1, file);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> height(-10.0f, 90.0f);
+    std::vector<float> heights(129 * 129 + 128 * 128);
+    for (float& h : heights)
+        h = height(rng);
+    fwrite(heights.data(), sizeof(float), heights.size(), file);
+
+    fclose(file);
+    return fileName;
+}
+}
+
+TEST_CASE("GridMap", "[GridMap]")
+{
+    std::string fileName = WriteMapFile();
+    GridMap grid;
+    REQUIRE(grid.loadData(fileName.c_str()) == GridMap::LoadResult::Ok);
+    std::filesystem::remove(fileName);
+
+    std::mt19937 rng(4321);
+    std::uniform_real_distribution<float> coord(-533.0f, 0.0f);
+    std::vector<float> x(1000);
+    std::vector<float> y(1000);
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = coord(rng);
+        y[i] = coord(rng);
+    }
+
+    BENCHMARK("getHeight 1000 points")
+    {
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < x.size(); ++i)
+            sum += grid.getHeight(x[i], y[i]);
+        return sum;
+    };
+
+    std::vector<float> heights(x.size());
+
+    BENCHMARK("getHeights 1000 points")
+    {
+        grid.getHeights(x.data(), y.data(), heights.data(), x.size());
+        return heights[0];
+    };
+}
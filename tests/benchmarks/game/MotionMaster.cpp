@@ -0,0 +1,206 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "MovementGenerator.h"
+#include <boost/container/small_vector.hpp>
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <functional>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+template<std::size_t StateSize, MovementGeneratorType Type>
+class CombatMovementGenerator : public MovementGenerator
+{
+public:
+    explicit CombatMovementGenerator(uint8 priority) { Priority = priority; }
+
+    void Initialize(Unit*) override { }
+    void Reset(Unit*) override { }
+    bool Update(Unit*, uint32) override { return true; }
+    void Deactivate(Unit*) override { }
+    void Finalize(Unit*, bool, bool) override { }
+    MovementGeneratorType GetMovementGeneratorType() const override { return Type; }
+
+private:
+    std::array<uint8, StateSize> _state = { };
+};
+
+// same sizes as the chase, point, fleeing and home generators
+using ChaseGenerator = CombatMovementGenerator<88, CHASE_MOTION_TYPE>;
+using PointGenerator = CombatMovementGenerator<72, POINT_MOTION_TYPE>;
+using FleeingGenerator = CombatMovementGenerator<32, FLEEING_MOTION_TYPE>;
+using HomeGenerator = CombatMovementGenerator<0, HOME_MOTION_TYPE>;
+
+struct GeneratorComparator
+{
+    bool operator()(MovementGenerator const* a, MovementGenerator const* b) const
+    {
+        return a->Mode > b->Mode || (a->Mode == b->Mode && a->Priority > b->Priority);
+    }
+};
+
+constexpr uint32 Creatures = 200;
+constexpr uint32 Changes = 20000;
+
+// previous MotionMaster storage: multiset, generators from the heap and delayed actions in std::function
+struct MultisetStorage
+{
+    using Container = std::multiset<MovementGenerator*, GeneratorComparator>;
+
+    template<class T>
+    static MovementGenerator* Create(uint8 priority) { return ::new T(priority); }
+    static void Destroy(MovementGenerator* movement) { ::delete movement; }
+
+    void Queue(uint32 creature, MovementGenerator* movement)
+    {
+        Delayed.emplace_back([this, creature, movement] { Add(Generators[creature], movement); });
+    }
+
+    void Resolve()
+    {
+        while (!Delayed.empty())
+        {
+            Delayed.front()();
+            Delayed.pop_front();
+        }
+    }
+
+    static void Add(Container& generators, MovementGenerator* movement)
+    {
+        auto itr = std::ranges::find(generators, movement->Priority, &MovementGenerator::Priority);
+        if (itr != generators.end())
+        {
+            Destroy(*itr);
+            generators.erase(itr);
+        }
+        generators.insert(movement);
+    }
+
+    std::vector<Container> Generators = std::vector<Container>(Creatures);
+    std::deque<std::function<void()>> Delayed;
+};
+
+// current MotionMaster storage: sorted priority slots, recycled generators and plain delayed actions
+struct PrioritySlotStorage
+{
+    using Container = boost::container::small_vector<MovementGenerator*, 3>;
+
+    struct DelayedAction
+    {
+        uint32 Creature;
+        MovementGenerator* Movement;
+    };
+
+    template<class T>
+    static MovementGenerator* Create(uint8 priority) { return new T(priority); }
+    static void Destroy(MovementGenerator* movement) { delete movement; }
+
+    void Queue(uint32 creature, MovementGenerator* movement)
+    {
+        Delayed.push_back({ creature, movement });
+    }
+
+    void Resolve()
+    {
+        while (!Delayed.empty())
+        {
+            DelayedAction action = Delayed.front();
+            Delayed.erase(Delayed.begin());
+            Add(Generators[action.Creature], action.Movement);
+        }
+    }
+
+    static void Add(Container& generators, MovementGenerator* movement)
+    {
+        auto itr = std::ranges::find(generators, movement->Priority, &MovementGenerator::Priority);
+        if (itr != generators.end())
+        {
+            Destroy(*itr);
+            generators.erase(itr);
+        }
+        generators.insert(std::upper_bound(generators.begin(), generators.end(), movement, GeneratorComparator()), movement);
+    }
+
+    std::vector<Container> Generators = std::vector<Container>(Creatures);
+    boost::container::small_vector<DelayedAction, 2> Delayed;
+};
+
+// creatures switching targets, getting feared, knocked back and evading in random order
+template<class Storage>
+uint32 SimulateCombat()
+{
+    Storage storage;
+    std::mt19937 rng(42);
+    uint32 expired = 0;
+
+    for (uint32 i = 0; i < Changes; ++i)
+    {
+        uint32 creature = rng() % Creatures;
+        switch (rng() % 8)
+        {
+            case 0: case 1: case 2: case 3: case 4:
+                storage.Queue(creature, Storage::template Create<ChaseGenerator>(MOTION_PRIORITY_NORMAL));
+                break;
+            case 5:
+                storage.Queue(creature, Storage::template Create<FleeingGenerator>(MOTION_PRIORITY_HIGHEST));
+                break;
+            case 6:
+                storage.Queue(creature, Storage::template Create<PointGenerator>(MOTION_PRIORITY_HIGHEST));
+                break;
+            default:
+                storage.Queue(creature, Storage::template Create<HomeGenerator>(MOTION_PRIORITY_NORMAL));
+                break;
+        }
+        storage.Resolve();
+
+        // fear and knockbacks run out
+        auto& generators = storage.Generators[rng() % Creatures];
+        if (!generators.empty() && (*generators.begin())->Priority == MOTION_PRIORITY_HIGHEST)
+        {
+            Storage::Destroy(*generators.begin());
+            generators.erase(generators.begin());
+            ++expired;
+        }
+    }
+
+    for (auto& generators : storage.Generators)
+        for (MovementGenerator* movement : generators)
+            Storage::Destroy(movement);
+
+    return expired;
+}
+}
+
+TEST_CASE("MotionMaster", "[MotionMaster]")
+{
+    BENCHMARK("multiset with heap allocated generators")
+    {
+        return SimulateCombat<MultisetStorage>();
+    };
+
+    BENCHMARK("priority slots with recycled generators")
+    {
+        return SimulateCombat<PrioritySlotStorage>();
+    };
+}
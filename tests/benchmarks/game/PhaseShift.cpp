@@ -0,0 +1,55 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "PhaseShift.h"
+
+TEST_CASE("PhaseShift", "[PhaseShift]")
+{
+    PhaseShift player;
+    for (uint32 phaseId : { 169u, 2500u, 3100u, 4200u, 5100u, 6000u })
+        player.AddPhase(phaseId, PhaseFlags::None, nullptr);
+
+    std::vector<PhaseShift> creatures(1000);
+    for (std::size_t i = 0; i < creatures.size(); ++i)
+    {
+        // most creatures share no phase with the player, some are in one of its phases
+        if (i % 10 == 0)
+            creatures[i].AddPhase(3100, PhaseFlags::None, nullptr);
+        else
+            creatures[i].AddPhase(7000 + i, PhaseFlags::None, nullptr);
+    }
+
+    BENCHMARK("CanSee 1000 phased creatures")
+    {
+        uint32 visible = 0;
+        for (PhaseShift const& creature : creatures)
+            visible += player.CanSee(creature);
+        return visible;
+    };
+
+    std::vector<PhaseShift> unphased(1000);
+
+    BENCHMARK("CanSee 1000 unphased creatures")
+    {
+        uint32 visible = 0;
+        for (PhaseShift const& creature : unphased)
+            visible += player.CanSee(creature);
+        return visible;
+    };
+}
@@ -0,0 +1,200 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "BoundingIntervalHierarchy.h"
+#include <random>
+
+namespace
+{
+struct BoxBounds
+{
+    void operator()(G3D::AABox const& box, G3D::AABox& bounds) const { bounds = box; }
+};
+
+bool IntersectBox(G3D::Ray const& ray, G3D::AABox const& box, float& distance)
+{
+    float tMin = 0.0f;
+    float tMax = distance;
+    for (int i = 0; i < 3; ++i)
+    {
+        float t1 = (box.low()[i] - ray.origin()[i]) * ray.invDirection()[i];
+        float t2 = (box.high()[i] - ray.origin()[i]) * ray.invDirection()[i];
+        tMin = std::max(tMin, std::min(t1, t2));
+        tMax = std::min(tMax, std::max(t1, t2));
+    }
+
+    if (tMin > tMax)
+        return false;
+
+    distance = tMin;
+    return true;
+}
+
+struct BoxRayCallback
+{
+    explicit BoxRayCallback(std::vector<G3D::AABox> const& boxes) : Boxes(boxes) { }
+
+    bool operator()(G3D::Ray const& ray, uint32 entry, float& distance, bool /*stopAtFirst*/)
+    {
+        return IntersectBox(ray, Boxes[entry], distance);
+    }
+
+    bool operator()(uint32 /*ray*/, G3D::Ray const& ray, uint32 entry, float& distance, bool /*stopAtFirst*/)
+    {
+        return IntersectBox(ray, Boxes[entry], distance);
+    }
+
+    std::vector<G3D::AABox> const& Boxes;
+};
+
+struct Scene
+{
+    Scene()
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> position(0.0f, 500.0f);
+        std::uniform_real_distribution<float> size(0.5f, 10.0f);
+        for (uint32 i = 0; i < 2000; ++i)
+        {
+            G3D::Vector3 low(position(rng), position(rng), position(rng) * 0.1f);
+            Boxes.emplace_back(low, low + G3D::Vector3(size(rng), size(rng), size(rng)));
+        }
+
+        BoxBounds getBounds;
+        Tree.build(Boxes, getBounds);
+
+        // like area spells, many targets around one caster
+        std::uniform_real_distribution<float> offset(-30.0f, 30.0f);
+        for (uint32 caster = 0; caster < 128; ++caster)
+        {
+            G3D::Vector3 end(position(rng), position(rng), position(rng) * 0.1f);
+            for (uint32 target = 0; target < 8; ++target)
+            {
+                G3D::Vector3 start = end + G3D::Vector3(offset(rng), offset(rng), offset(rng) * 0.1f);
+                float dist = (end - start).magnitude();
+                Rays.push_back(G3D::Ray::fromOriginAndDirection(start, (end - start) / dist));
+                Distances.push_back(dist);
+            }
+        }
+    }
+
+    std::vector<G3D::AABox> Boxes;
+    BIH Tree;
+    std::vector<G3D::Ray> Rays;
+    std::vector<float> Distances;
+};
+}
+
+TEST_CASE("Ray packets find the same hits as single rays", "[BIH]")
+{
+    Scene scene;
+    BoxRayCallback callback(scene.Boxes);
+    bool stopAtFirst = GENERATE(true, false);
+
+    for (std::size_t packetStart = 0; packetStart < scene.Rays.size(); packetStart += BIH::RayPacketSize)
+    {
+        float packetDistances[BIH::RayPacketSize];
+        std::copy_n(scene.Distances.begin() + packetStart, BIH::RayPacketSize, packetDistances);
+        scene.Tree.intersectRays(scene.Rays.data() + packetStart, (1 << BIH::RayPacketSize) - 1, callback, packetDistances, stopAtFirst);
+
+        for (uint32 ray = 0; ray < BIH::RayPacketSize; ++ray)
+        {
+            float distance = scene.Distances[packetStart + ray];
+            scene.Tree.intersectRay(scene.Rays[packetStart + ray], callback, distance, stopAtFirst);
+
+            // any hit ends the search with stopAtFirst, only whether the ray was blocked must match
+            if (stopAtFirst)
+                REQUIRE((distance < scene.Distances[packetStart + ray]) == (packetDistances[ray] < scene.Distances[packetStart + ray]));
+            else
+                REQUIRE(distance == packetDistances[ray]);
+        }
+    }
+}
+
+TEST_CASE("Ray packets skip rays outside of the mask", "[BIH]")
+{
+    Scene scene;
+    BoxRayCallback callback(scene.Boxes);
+
+    float packetDistances[BIH::RayPacketSize];
+    std::copy_n(scene.Distances.begin(), BIH::RayPacketSize, packetDistances);
+    scene.Tree.intersectRays(scene.Rays.data(), 0, callback, packetDistances, false);
+    REQUIRE(std::equal(packetDistances, packetDistances + BIH::RayPacketSize, scene.Distances.begin()));
+}
+
+TEST_CASE("Refitted tree finds the same hits as a rebuilt one", "[BIH]")
+{
+    Scene scene;
+    BoxBounds getBounds;
+    float buildCost = scene.Tree.refit(scene.Boxes, getBounds);
+    REQUIRE(scene.Tree.refit(scene.Boxes, getBounds) == buildCost);
+
+    // like transports and doors, some of the models move a bit
+    std::mt19937 rng(4321);
+    std::uniform_real_distribution<float> offset(-15.0f, 15.0f);
+    for (std::size_t i = 0; i < scene.Boxes.size(); i += 5)
+        scene.Boxes[i] = scene.Boxes[i] + G3D::Vector3(offset(rng), offset(rng), offset(rng) * 0.1f);
+
+    REQUIRE(scene.Tree.refit(scene.Boxes, getBounds) > buildCost);
+
+    BIH rebuilt;
+    rebuilt.build(scene.Boxes, getBounds);
+
+    BoxRayCallback callback(scene.Boxes);
+    for (std::size_t i = 0; i < scene.Rays.size(); ++i)
+    {
+        float refitDistance = scene.Distances[i];
+        float rebuiltDistance = scene.Distances[i];
+        scene.Tree.intersectRay(scene.Rays[i], callback, refitDistance, false);
+        rebuilt.intersectRay(scene.Rays[i], callback, rebuiltDistance, false);
+        REQUIRE(refitDistance == rebuiltDistance);
+    }
+}
+
+TEST_CASE("Line of sight through bounding interval hierarchy", "[.benchmark][BIH]")
+{
+    Scene scene;
+    BoxRayCallback callback(scene.Boxes);
+
+    BENCHMARK("single rays")
+    {
+        uint32 blocked = 0;
+        for (std::size_t i = 0; i < scene.Rays.size(); ++i)
+        {
+            float distance = scene.Distances[i];
+            scene.Tree.intersectRay(scene.Rays[i], callback, distance, true);
+            blocked += distance < scene.Distances[i];
+        }
+        return blocked;
+    };
+
+    BENCHMARK("ray packets")
+    {
+        uint32 blocked = 0;
+        for (std::size_t packetStart = 0; packetStart < scene.Rays.size(); packetStart += BIH::RayPacketSize)
+        {
+            float distances[BIH::RayPacketSize];
+            std::copy_n(scene.Distances.begin() + packetStart, BIH::RayPacketSize, distances);
+            scene.Tree.intersectRays(scene.Rays.data() + packetStart, (1 << BIH::RayPacketSize) - 1, callback, distances, true);
+            for (uint32 ray = 0; ray < BIH::RayPacketSize; ++ray)
+                blocked += distances[ray] < scene.Distances[packetStart + ray];
+        }
+        return blocked;
+    };
+}
@@ -376,6 +376,35 @@ TEST_CASE("Delay grouped events", "[EventMap]")
     REQUIRE(eventMap.GetTimeUntilEvent(EVENT_3) == 4s);
 }
 
+TEST_CASE("Events with the same time execute in scheduling order", "[EventMap]")
+{
+    EventMap eventMap;
+    eventMap.ScheduleEvent(EVENT_1, 1s, GROUP_1);
+    eventMap.ScheduleEvent(EVENT_2, 2s);
+    eventMap.ScheduleEvent(EVENT_3, 1s);
+
+    SECTION("Without delay")
+    {
+        eventMap.Update(2000);
+
+        REQUIRE(eventMap.ExecuteEvent() == EVENT_1);
+        REQUIRE(eventMap.ExecuteEvent() == EVENT_3);
+        REQUIRE(eventMap.ExecuteEvent() == EVENT_2);
+        REQUIRE(eventMap.Empty());
+    }
+
+    SECTION("Delayed group moves behind events of its new time")
+    {
+        eventMap.DelayEvents(1s, GROUP_1);
+        eventMap.Update(2000);
+
+        REQUIRE(eventMap.ExecuteEvent() == EVENT_3);
+        REQUIRE(eventMap.ExecuteEvent() == EVENT_2);
+        REQUIRE(eventMap.ExecuteEvent() == EVENT_1);
+        REQUIRE(eventMap.Empty());
+    }
+}
+
 TEST_CASE("Reset map", "[EventMap]")
 {
     EventMap eventMap;
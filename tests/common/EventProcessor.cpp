@@ -0,0 +1,185 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "EventProcessor.h"
+#include <map>
+#include <memory>
+#include <random>
+
+namespace
+{
+class RecordingEvent : public BasicEvent
+{
+public:
+    RecordingEvent(std::vector<int>& executed, int id, bool deletable = true) : _executed(executed), _id(id), _deletable(deletable) { }
+
+    bool Execute(uint64, uint32) override
+    {
+        _executed.push_back(_id);
+        return true;
+    }
+
+    bool IsDeletable() const override { return _deletable; }
+
+    void Abort(uint64) override { _executed.push_back(-_id); }
+
+private:
+    std::vector<int>& _executed;
+    int _id;
+    bool _deletable;
+};
+
+// the multimap queue EventProcessor used before
+class MultimapEventProcessor
+{
+public:
+    ~MultimapEventProcessor()
+    {
+        for (auto& [time, event] : _events)
+            delete event;
+    }
+
+    void Update(uint32 diff)
+    {
+        _time += diff;
+        std::multimap<uint64, BasicEvent*>::iterator i;
+        while (((i = _events.begin()) != _events.end()) && i->first <= _time)
+        {
+            BasicEvent* event = i->second;
+            _events.erase(i);
+            if (event->Execute(_time, diff))
+                delete event;
+        }
+    }
+
+    template<typename T>
+    void AddEventAtOffset(T&& event, Milliseconds offset)
+    {
+        _events.insert(std::pair<uint64, BasicEvent*>(_time + offset.count(), new CallbackEvent<T>(std::move(event))));
+    }
+
+private:
+    template<typename T>
+    class CallbackEvent : public BasicEvent
+    {
+    public:
+        CallbackEvent(T&& callback) : _callback(std::move(callback)) { }
+
+        bool Execute(uint64, uint32) override
+        {
+            _callback();
+            return true;
+        }
+
+    private:
+        T _callback;
+    };
+
+    uint64 _time = 0;
+    std::multimap<uint64, BasicEvent*> _events;
+};
+
+// units keep a few events around, spells and delayed callbacks get added again as they fire
+template<typename Processor>
+uint64 SimulateUnits(std::vector<Processor>& processors, uint32 updates)
+{
+    uint64 executed = 0;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32> delay(0, 3000);
+    for (Processor& processor : processors)
+        for (uint32 i = 0; i < 4; ++i)
+            processor.AddEventAtOffset([&executed] { ++executed; }, Milliseconds(delay(rng)));
+
+    for (uint32 update = 0; update < updates; ++update)
+    {
+        for (Processor& processor : processors)
+        {
+            processor.Update(50);
+            if (rng() % 8 == 0)
+            {
+                uint64 captured[3] = { update, executed, 0 };
+                processor.AddEventAtOffset([&executed, captured] { executed += captured[2] + 1; }, Milliseconds(delay(rng)));
+            }
+        }
+    }
+    return executed;
+}
+}
+
+TEST_CASE("Events execute in time and insertion order", "[EventProcessor]")
+{
+    std::vector<int> executed;
+    EventProcessor events;
+    events.AddEventAtOffset(new RecordingEvent(executed, 1), 100ms);
+    events.AddEventAtOffset(new RecordingEvent(executed, 2), 50ms);
+    events.AddEventAtOffset(new RecordingEvent(executed, 3), 100ms);
+    events.AddEventAtOffset([&executed] { executed.push_back(4); }, 50ms);
+
+    events.Update(40);
+    REQUIRE(executed.empty());
+
+    events.Update(60);
+    REQUIRE(executed == std::vector<int>{ 2, 4, 1, 3 });
+}
+
+TEST_CASE("Event time can be modified", "[EventProcessor]")
+{
+    std::vector<int> executed;
+    EventProcessor events;
+    BasicEvent* delayed = new RecordingEvent(executed, 1);
+    events.AddEventAtOffset(delayed, 100ms);
+    events.AddEventAtOffset(new RecordingEvent(executed, 2), 200ms);
+    events.ModifyEventTime(delayed, 300ms);
+
+    events.Update(250);
+    REQUIRE(executed == std::vector<int>{ 2 });
+
+    events.Update(50);
+    REQUIRE(executed == std::vector<int>{ 2, 1 });
+}
+
+TEST_CASE("Killing events keeps non deletable ones", "[EventProcessor]")
+{
+    std::vector<int> executed;
+    EventProcessor events;
+    events.AddEventAtOffset(new RecordingEvent(executed, 1), 100ms);
+    events.AddEventAtOffset(new RecordingEvent(executed, 2, false), 100ms);
+
+    events.KillAllEvents(false);
+    REQUIRE(executed == std::vector<int>{ -1, -2 });
+    REQUIRE(events.GetEvents().size() == 1);
+
+    events.KillAllEvents(true);
+    REQUIRE(events.GetEvents().empty());
+}
+
+TEST_CASE("Unit event queues", "[.benchmark][EventProcessor]")
+{
+    BENCHMARK("multimap")
+    {
+        std::vector<MultimapEventProcessor> processors(10000);
+        return SimulateUnits(processors, 100);
+    };
+
+    BENCHMARK("EventProcessor")
+    {
+        std::vector<EventProcessor> processors(10000);
+        return SimulateUnits(processors, 100);
+    };
+}
@@ -0,0 +1,208 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "FlatHashMap.h"
+#include "FlatHashSet.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+TEST_CASE("Insertion and lookup", "[FlatHashMap]")
+{
+    Trinity::Containers::FlatHashMap<int, std::string> map;
+
+    REQUIRE(map.try_emplace(1, "one").second == true);
+    REQUIRE(map.emplace(2, "two").second == true);
+    REQUIRE(map.insert({ 3, "three" }).second == true);
+    REQUIRE(map.try_emplace(1, "uno").second == false);
+    map[4] = "four";
+
+    REQUIRE(map.size() == 4);
+    REQUIRE(map.at(1) == "one");
+    REQUIRE(map[4] == "four");
+    REQUIRE(map.find(5) == map.end());
+    REQUIRE(map.count(2) == 1);
+    REQUIRE(map.size() == 4);
+}
+
+TEST_CASE("Growing keeps all elements", "[FlatHashMap]")
+{
+    Trinity::Containers::FlatHashMap<int, std::unique_ptr<int>> map;
+    for (int i = 0; i < 10000; ++i)
+        map.try_emplace(i, std::make_unique<int>(i * 2));
+
+    REQUIRE(map.size() == 10000);
+    for (int i = 0; i < 10000; ++i)
+    {
+        auto itr = map.find(i);
+        REQUIRE(itr != map.end());
+        REQUIRE(*itr->second == i * 2);
+    }
+
+    std::size_t visited = 0;
+    for (auto const& [key, value] : map)
+    {
+        REQUIRE(*value == key * 2);
+        ++visited;
+    }
+    REQUIRE(visited == 10000);
+}
+
+TEST_CASE("Erase", "[FlatHashSet]")
+{
+    Trinity::Containers::FlatHashSet<int> set;
+    for (int i = 0; i < 100; ++i)
+        set.insert(i);
+
+    SECTION("by key")
+    {
+        for (int i = 0; i < 100; i += 2)
+            REQUIRE(set.erase(i) == 1);
+
+        REQUIRE(set.erase(0) == 0);
+        REQUIRE(set.size() == 50);
+        for (int i = 0; i < 100; ++i)
+            REQUIRE(set.contains(i) == (i % 2 == 1));
+    }
+
+    SECTION("while iterating")
+    {
+        for (auto itr = set.begin(); itr != set.end();)
+        {
+            if (*itr % 3 == 0)
+                itr = set.erase(itr);
+            else
+                ++itr;
+        }
+
+        REQUIRE(set.size() == 66);
+        for (int i = 0; i < 100; ++i)
+            REQUIRE(set.contains(i) == (i % 3 != 0));
+    }
+
+    SECTION("from the front until empty")
+    {
+        while (!set.empty())
+            set.erase(set.begin());
+
+        REQUIRE(set.begin() == set.end());
+        REQUIRE(set.insert(5).second == true);
+        REQUIRE(set.size() == 1);
+    }
+}
+
+TEST_CASE("Reusing erased slots", "[FlatHashSet]")
+{
+    // insertions and erasures that keep the size constant must not keep growing the table
+    Trinity::Containers::FlatHashSet<int> set;
+    for (int i = 0; i < 50; ++i)
+        set.insert(i);
+
+    for (int i = 50; i < 1000; ++i)
+    {
+        set.erase(i - 50);
+        set.insert(i);
+    }
+
+    std::size_t capacity = set.capacity();
+    for (int i = 1000; i < 100000; ++i)
+    {
+        set.erase(i - 50);
+        set.insert(i);
+    }
+
+    REQUIRE(set.size() == 50);
+    REQUIRE(set.capacity() == capacity);
+    for (int i = 100000 - 50; i < 100000; ++i)
+        REQUIRE(set.contains(i));
+}
+
+TEST_CASE("Copy and move", "[FlatHashSet]")
+{
+    Trinity::Containers::FlatHashSet<int> set = { 1, 2, 3 };
+    Trinity::Containers::FlatHashSet<int> copy = set;
+    REQUIRE(copy == set);
+
+    copy.erase(2);
+    REQUIRE(copy != set);
+    REQUIRE(set.contains(2));
+
+    Trinity::Containers::FlatHashSet<int> moved = std::move(set);
+    REQUIRE(moved.size() == 3);
+    REQUIRE(set.empty());
+
+    moved.clear();
+    REQUIRE(moved.empty());
+    REQUIRE(moved.begin() == moved.end());
+}
+
+TEST_CASE("Lookups compared to std::unordered_set", "[.benchmark][FlatHashSet]")
+{
+    std::mt19937_64 rng(42);
+    std::vector<uint64> keys(10000);
+    for (uint64& key : keys)
+        key = rng();
+
+    std::unordered_set<uint64> stdSet(keys.begin(), keys.end());
+    Trinity::Containers::FlatHashSet<uint64> flatSet;
+    flatSet.insert(keys.begin(), keys.end());
+
+    std::vector<uint64> lookups = keys;
+    for (std::size_t i = 0; i < lookups.size(); i += 2)
+        lookups[i] = rng(); // half of them misses
+
+    BENCHMARK("std::unordered_set find")
+    {
+        std::size_t found = 0;
+        for (uint64 key : lookups)
+            found += stdSet.count(key);
+        return found;
+    };
+
+    BENCHMARK("FlatHashSet find")
+    {
+        std::size_t found = 0;
+        for (uint64 key : lookups)
+            found += flatSet.count(key);
+        return found;
+    };
+
+    BENCHMARK("std::unordered_set insert and erase")
+    {
+        std::unordered_set<uint64> set;
+        for (uint64 key : keys)
+            set.insert(key);
+        for (uint64 key : keys)
+            set.erase(key);
+        return set.size();
+    };
+
+    BENCHMARK("FlatHashSet insert and erase")
+    {
+        Trinity::Containers::FlatHashSet<uint64> set;
+        for (uint64 key : keys)
+            set.insert(key);
+        for (uint64 key : keys)
+            set.erase(key);
+        return set.size();
+    };
+}
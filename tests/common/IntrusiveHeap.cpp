@@ -0,0 +1,256 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Define.h"
+#include "IntrusiveHeap.h"
+#include <boost/heap/fibonacci_heap.hpp>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+struct TestThreat
+{
+    explicit TestThreat(float threat) : Threat(threat), HeapIndex(0) { }
+
+    float Threat;
+    mutable std::size_t HeapIndex;
+};
+
+struct CompareTestThreat
+{
+    bool operator()(TestThreat const* a, TestThreat const* b) const { return a->Threat < b->Threat; }
+};
+
+struct TestThreatHeapIndex
+{
+    std::size_t& operator()(TestThreat const* threat) const { return threat->HeapIndex; }
+};
+
+using TestHeap = Trinity::Containers::IntrusiveHeap<TestThreat const*, CompareTestThreat, TestThreatHeapIndex>;
+
+std::vector<float> OrderedThreats(TestHeap const& heap)
+{
+    std::vector<float> threats;
+    for (auto itr = heap.ordered_begin(); itr != heap.ordered_end(); ++itr)
+        threats.push_back((*itr)->Threat);
+    return threats;
+}
+
+std::vector<float> SortedThreats(std::vector<std::unique_ptr<TestThreat>> const& threats)
+{
+    std::vector<float> sorted;
+    for (std::unique_ptr<TestThreat> const& threat : threats)
+        sorted.push_back(threat->Threat);
+    std::sort(sorted.begin(), sorted.end(), std::greater<>());
+    return sorted;
+}
+}
+
+TEST_CASE("Top is the greatest element", "[IntrusiveHeap]")
+{
+    TestHeap heap;
+    REQUIRE(heap.empty());
+    REQUIRE(heap.ordered_begin() == heap.ordered_end());
+
+    std::vector<std::unique_ptr<TestThreat>> threats;
+    for (float threat : { 5.0f, 1.0f, 9.0f, 3.0f, 7.0f, 2.0f })
+    {
+        threats.push_back(std::make_unique<TestThreat>(threat));
+        heap.push(threats.back().get());
+    }
+
+    REQUIRE(heap.size() == 6);
+    REQUIRE(heap.top()->Threat == 9.0f);
+    REQUIRE(OrderedThreats(heap) == SortedThreats(threats));
+    // ordered iteration doesn't change the heap
+    REQUIRE(heap.size() == 6);
+    REQUIRE(heap.top()->Threat == 9.0f);
+}
+
+TEST_CASE("Changed and removed elements", "[IntrusiveHeap]")
+{
+    TestHeap heap;
+    std::vector<std::unique_ptr<TestThreat>> threats;
+    for (uint32 i = 0; i < 10; ++i)
+    {
+        threats.push_back(std::make_unique<TestThreat>(float(i)));
+        heap.push(threats.back().get());
+    }
+
+    threats[2]->Threat = 20.0f;
+    heap.increase(threats[2].get());
+    REQUIRE(heap.top() == threats[2].get());
+
+    threats[2]->Threat = -1.0f;
+    heap.decrease(threats[2].get());
+    REQUIRE(heap.top() == threats[9].get());
+
+    threats[5]->Threat = 15.0f;
+    heap.update(threats[5].get());
+    REQUIRE(heap.top() == threats[5].get());
+
+    heap.erase(threats[5].get());
+    threats.erase(threats.begin() + 5);
+    REQUIRE(heap.top() == threats[8].get());
+
+    // last element in the array
+    TestThreat const* last = *std::prev(heap.end());
+    heap.erase(last);
+    threats.erase(std::find_if(threats.begin(), threats.end(), [&](std::unique_ptr<TestThreat> const& threat) { return threat.get() == last; }));
+
+    REQUIRE(heap.size() == threats.size());
+    REQUIRE(OrderedThreats(heap) == SortedThreats(threats));
+}
+
+TEST_CASE("Random updates keep the heap ordered", "[IntrusiveHeap]")
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> threatChange(-500.0f, 1000.0f);
+
+    TestHeap heap;
+    std::vector<std::unique_ptr<TestThreat>> threats;
+    for (uint32 i = 0; i < 2000; ++i)
+    {
+        uint32 action = rng() % 10;
+        if (action == 0 || threats.empty())
+        {
+            threats.push_back(std::make_unique<TestThreat>(threatChange(rng)));
+            heap.push(threats.back().get());
+        }
+        else if (action == 1)
+        {
+            std::size_t index = rng() % threats.size();
+            heap.erase(threats[index].get());
+            threats.erase(threats.begin() + index);
+        }
+        else
+        {
+            TestThreat* threat = threats[rng() % threats.size()].get();
+            float change = threatChange(rng);
+            threat->Threat += change;
+            if (change > 0.0f)
+                heap.increase(threat);
+            else
+                heap.decrease(threat);
+        }
+
+        if (!threats.empty())
+            REQUIRE(heap.top()->Threat == SortedThreats(threats).front());
+    }
+
+    REQUIRE(OrderedThreats(heap) == SortedThreats(threats));
+}
+
+TEST_CASE("Raid threat updates", "[.benchmark][IntrusiveHeap]")
+{
+    // a raid boss: 25 players on the threat list, every damage or heal event raises the threat of one of them,
+    // the boss reselects its victim every few events by walking the list from the top
+    // and players occasionally die and get back into combat
+    constexpr uint32 PlayerCount = 25;
+    constexpr uint32 EventCount = 10000;
+    constexpr uint32 EventsPerUpdate = 10;
+    constexpr uint32 VictimCandidates = 3;
+
+    enum class EventType { Increase, Decrease, Reset };
+    struct ThreatEvent
+    {
+        EventType Type;
+        uint32 Target;
+        float Threat;
+    };
+
+    std::mt19937 rng(42);
+    std::vector<ThreatEvent> events;
+    for (uint32 i = 0; i < EventCount; ++i)
+    {
+        uint32 roll = rng() % 100;
+        // tanks generate most of the threat events
+        uint32 target = roll < 25 ? rng() % 2 : rng() % PlayerCount;
+        if (roll < 95)
+            events.push_back({ EventType::Increase, target, float(rng() % 5000) });
+        else if (roll < 99)
+            events.push_back({ EventType::Decrease, target, 0.5f });
+        else
+            events.push_back({ EventType::Reset, target, 0.0f });
+    }
+
+    auto run = [&]<typename Heap, typename Handle>(Heap& heap, std::vector<std::unique_ptr<TestThreat>>& threats, std::vector<Handle>& handles, auto push, auto erase)
+    {
+        for (uint32 i = 0; i < PlayerCount; ++i)
+        {
+            threats.push_back(std::make_unique<TestThreat>(0.0f));
+            handles.push_back(push(threats.back().get()));
+        }
+
+        float victimThreat = 0.0f;
+        for (uint32 i = 0; i < EventCount; ++i)
+        {
+            ThreatEvent const& event = events[i];
+            TestThreat* threat = threats[event.Target].get();
+            switch (event.Type)
+            {
+                case EventType::Increase:
+                    threat->Threat += event.Threat;
+                    heap.increase(handles[event.Target]);
+                    break;
+                case EventType::Decrease:
+                    threat->Threat *= event.Threat;
+                    heap.decrease(handles[event.Target]);
+                    break;
+                case EventType::Reset:
+                    erase(handles[event.Target]);
+                    threat->Threat = 0.0f;
+                    handles[event.Target] = push(threat);
+                    break;
+            }
+
+            if ((i % EventsPerUpdate) == 0)
+            {
+                uint32 candidates = 0;
+                for (auto itr = heap.ordered_begin(); itr != heap.ordered_end() && candidates < VictimCandidates; ++itr, ++candidates)
+                    victimThreat += (*itr)->Threat;
+            }
+        }
+        return victimThreat;
+    };
+
+    BENCHMARK("boost::heap::fibonacci_heap")
+    {
+        using FibonacciHeap = boost::heap::fibonacci_heap<TestThreat const*, boost::heap::compare<CompareTestThreat>>;
+        FibonacciHeap heap;
+        std::vector<std::unique_ptr<TestThreat>> threats;
+        std::vector<FibonacciHeap::handle_type> handles;
+        return run(heap, threats, handles,
+            [&](TestThreat const* threat) { return heap.push(threat); },
+            [&](FibonacciHeap::handle_type handle) { heap.erase(handle); });
+    };
+
+    BENCHMARK("IntrusiveHeap")
+    {
+        TestHeap heap;
+        std::vector<std::unique_ptr<TestThreat>> threats;
+        std::vector<TestThreat const*> handles;
+        return run(heap, threats, handles,
+            [&](TestThreat const* threat) { heap.push(threat); return threat; },
+            [&](TestThreat const* threat) { heap.erase(threat); });
+    };
+}
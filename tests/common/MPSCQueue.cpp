@@ -0,0 +1,87 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "MPSCQueue.h"
+#include <thread>
+#include <vector>
+
+TEST_CASE("Bounded queue drops values over capacity", "[MPSCQueue]")
+{
+    Trinity::MPSCQueueBounded<int> queue(3);
+    for (int i = 0; i < 6; ++i)
+        queue.Enqueue(i);
+
+    // capacity is rounded up to 4
+    REQUIRE(queue.ConsumeRejectedCount() == 2);
+    REQUIRE(queue.ConsumeRejectedCount() == 0);
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.Dequeue(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(queue.Dequeue(value));
+
+    // cells are reused after wrapping around
+    REQUIRE(queue.Enqueue(10));
+    REQUIRE(queue.Dequeue(value));
+    REQUIRE(value == 10);
+}
+
+TEST_CASE("Bounded queue keeps the order of each producer", "[MPSCQueue]")
+{
+    constexpr int Producers = 4;
+    constexpr int ValuesPerProducer = 20000;
+
+    Trinity::MPSCQueueBounded<int, Trinity::MPSCQueueOverflowPolicy::Block> queue(64);
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < Producers; ++producer)
+    {
+        producers.emplace_back([&queue, producer]
+        {
+            for (int i = 0; i < ValuesPerProducer; ++i)
+                queue.Enqueue(producer * ValuesPerProducer + i);
+        });
+    }
+
+    std::vector<int> next(Producers, 0);
+    int received = 0;
+    bool ordered = true;
+    while (received < Producers * ValuesPerProducer)
+    {
+        int value;
+        if (!queue.Dequeue(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        int producer = value / ValuesPerProducer;
+        ordered = ordered && value % ValuesPerProducer == next[producer];
+        ++next[producer];
+        ++received;
+    }
+
+    for (std::thread& producer : producers)
+        producer.join();
+
+    REQUIRE(ordered);
+    REQUIRE(queue.ConsumeRejectedCount() == 0);
+}
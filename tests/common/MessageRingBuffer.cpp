@@ -0,0 +1,80 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "tc_catch2.h"
+
+#include "MessageRingBuffer.h"
+#include <array>
+#include <numeric>
+
+TEST_CASE("Free space wraps around the end of the buffer", "[MessageRingBuffer]")
+{
+    MessageRingBuffer buffer(8);
+    std::array<uint8, 6> data;
+    std::iota(data.begin(), data.end(), uint8(1));
+
+    buffer.Write(data.data(), data.size());
+    std::array<uint8, 4> consumed;
+    REQUIRE(buffer.Read(consumed.data(), consumed.size()) == 4);
+
+    buffer.Normalize();
+    REQUIRE(buffer.GetActiveSize() == 2);
+    REQUIRE(buffer.GetRemainingSpace() == 6);
+    REQUIRE(buffer.GetWriteRegion() == 2);
+    REQUIRE(buffer.GetWrapWriteRegion() == 4);
+}
+
+TEST_CASE("Reads are copied across the wrap boundary", "[MessageRingBuffer]")
+{
+    MessageRingBuffer buffer(8);
+    std::array<uint8, 6> first = { 1, 2, 3, 4, 5, 6 };
+    std::array<uint8, 6> second = { 7, 8, 9, 10, 11, 12 };
+    std::array<uint8, 8> received;
+
+    buffer.Write(first.data(), first.size());
+    REQUIRE(buffer.Read(received.data(), 5) == 5);
+    uint8* base = buffer.GetBasePointer();
+
+    buffer.Write(second.data(), second.size());
+    REQUIRE(buffer.GetBasePointer() == base);
+    REQUIRE(buffer.GetContiguousActiveSize() == 3);
+    REQUIRE(buffer.Read(received.data(), received.size()) == 7);
+    REQUIRE(received[0] == 6);
+    REQUIRE(received[6] == 12);
+    REQUIRE(buffer.GetActiveSize() == 0);
+}
+
+TEST_CASE("Full buffers grow without losing unread data", "[MessageRingBuffer]")
+{
+    MessageRingBuffer buffer(4);
+    std::array<uint8, 4> data = { 1, 2, 3, 4 };
+    std::array<uint8, 2> consumed;
+
+    buffer.Write(data.data(), data.size());
+    buffer.Read(consumed.data(), consumed.size());
+    buffer.Write(data.data(), 2);
+    REQUIRE(buffer.GetRemainingSpace() == 0);
+
+    buffer.EnsureFreeSpace();
+    REQUIRE(buffer.GetBufferSize() == 6);
+    REQUIRE(buffer.GetActiveSize() == 4);
+
+    std::array<uint8, 4> received;
+    REQUIRE(buffer.Read(received.data(), received.size()) == 4);
+    REQUIRE(received == std::array<uint8, 4>{ 3, 4, 1, 2 });
+}
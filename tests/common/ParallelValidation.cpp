@@ -0,0 +1,63 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ParallelValidation.h"
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Every element is checked once", "[ParallelValidation]")
+{
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+
+    SECTION("serial")
+    {
+        Trinity::ValidateInParallel(values.begin(), values.end(), 1, [](int& value) { value = value * 2 + 1; });
+    }
+
+    SECTION("parallel")
+    {
+        Trinity::ValidateInParallel(values.begin(), values.end(), 4, [](int& value) { value = value * 2 + 1; });
+    }
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+        REQUIRE(values[i] == int(i * 2 + 1));
+}
+
+TEST_CASE("Non random access ranges and more threads than elements", "[ParallelValidation]")
+{
+    std::list<int> values = { 1, 2, 3 };
+
+    Trinity::ValidateInParallel(values.begin(), values.end(), 8, [](int& value) { value = -value; });
+
+    REQUIRE(values == std::list<int>{ -1, -2, -3 });
+}
+
+TEST_CASE("Exceptions thrown by checks are rethrown", "[ParallelValidation]")
+{
+    std::vector<int> values(100, 0);
+
+    REQUIRE_THROWS_AS(Trinity::ValidateInParallel(values.begin(), values.end(), 4, [&](int& value)
+    {
+        if (&value == &values[50])
+            throw std::runtime_error("invalid");
+    }), std::runtime_error);
+}
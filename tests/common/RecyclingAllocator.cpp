@@ -0,0 +1,57 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "RecyclingAllocator.h"
+#include <vector>
+
+TEST_CASE("Freed memory is reused for objects of the same size", "[RecyclingAllocator]")
+{
+    void* first = Trinity::RecyclingAllocator::Allocate(3000);
+    Trinity::RecyclingAllocator::Deallocate(first, 3000);
+
+    void* other = Trinity::RecyclingAllocator::Allocate(3008);
+    REQUIRE(other != first);
+
+    void* second = Trinity::RecyclingAllocator::Allocate(3000);
+    REQUIRE(second == first);
+
+    Trinity::RecyclingAllocator::Deallocate(other, 3008);
+    Trinity::RecyclingAllocator::Deallocate(second, 3000);
+}
+
+TEST_CASE("Free lists only keep a bounded number of blocks", "[RecyclingAllocator]")
+{
+    std::vector<void*> blocks;
+    for (std::size_t i = 0; i < Trinity::RecyclingAllocator::MaxCachedBlocksPerSizeClass + 10; ++i)
+        blocks.push_back(Trinity::RecyclingAllocator::Allocate(512));
+
+    for (void* block : blocks)
+        Trinity::RecyclingAllocator::Deallocate(block, 512);
+
+    // the most recently cached blocks come back first, the last ones freed were released to the heap
+    std::vector<void*> reused;
+    for (std::size_t i = 0; i < Trinity::RecyclingAllocator::MaxCachedBlocksPerSizeClass; ++i)
+        reused.push_back(Trinity::RecyclingAllocator::Allocate(512));
+
+    for (std::size_t i = 0; i < reused.size(); ++i)
+        REQUIRE(reused[i] == blocks[reused.size() - 1 - i]);
+
+    for (void* block : reused)
+        Trinity::RecyclingAllocator::Deallocate(block, 512);
+}
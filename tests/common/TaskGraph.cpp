@@ -0,0 +1,69 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "tc_catch2.h"
+
+#include "TaskGraph.h"
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Serial execution keeps insertion order", "[TaskGraph]")
+{
+    Trinity::TaskGraph graph;
+    std::vector<int> order;
+
+    Trinity::TaskGraph::TaskId first = graph.AddTask([&]() { order.push_back(1); });
+    graph.AddTask([&]() { order.push_back(2); });
+    graph.AddTask([&]() { order.push_back(3); }, { first });
+
+    graph.Run(1);
+
+    REQUIRE(order == std::vector<int>{ 1, 2, 3 });
+}
+
+TEST_CASE("Dependencies finish before dependents", "[TaskGraph]")
+{
+    Trinity::TaskGraph graph;
+    std::mutex lock;
+    std::vector<int> order;
+    auto record = [&](int value) { std::lock_guard<std::mutex> guard(lock); order.push_back(value); };
+
+    Trinity::TaskGraph::TaskId a = graph.AddTask([&]() { record(1); });
+    Trinity::TaskGraph::TaskId b = graph.AddTask([&]() { record(2); });
+    Trinity::TaskGraph::TaskId c = graph.AddTask([&]() { record(3); }, { a, b });
+    graph.AddTask([&]() { record(4); }, { c });
+
+    graph.Run(4);
+
+    REQUIRE(order.size() == 4);
+    REQUIRE(order[2] == 3);
+    REQUIRE(order[3] == 4);
+}
+
+TEST_CASE("Failed task stops its dependents", "[TaskGraph]")
+{
+    Trinity::TaskGraph graph;
+    std::atomic<int> executed(0);
+
+    Trinity::TaskGraph::TaskId failing = graph.AddTask([&]() { throw std::runtime_error("fail"); });
+    graph.AddTask([&]() { ++executed; });
+    graph.AddTask([&]() { ++executed; }, { failing });
+
+    REQUIRE_THROWS_AS(graph.Run(2), std::runtime_error);
+    REQUIRE(executed == 1);
+}
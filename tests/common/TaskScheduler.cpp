@@ -0,0 +1,112 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "TaskScheduler.h"
+
+TEST_CASE("Tasks run in end and schedule order", "[TaskScheduler]")
+{
+    std::vector<int> executed;
+    TaskScheduler scheduler;
+    scheduler.Schedule(2s, [&executed](TaskContext) { executed.push_back(1); });
+    scheduler.Schedule(1s, [&executed](TaskContext) { executed.push_back(2); });
+    scheduler.Schedule(2s, [&executed](TaskContext) { executed.push_back(3); });
+    scheduler.Schedule(1s, [&executed](TaskContext) { executed.push_back(4); });
+
+    scheduler.Update(500ms);
+    REQUIRE(executed.empty());
+
+    scheduler.Update(1500ms);
+    REQUIRE(executed == std::vector<int>{ 2, 4, 1, 3 });
+}
+
+TEST_CASE("Repeated tasks keep their counter", "[TaskScheduler]")
+{
+    std::vector<uint32> repeats;
+    TaskScheduler scheduler;
+    scheduler.Schedule(1s, [&repeats](TaskContext context)
+    {
+        repeats.push_back(context.GetRepeatCounter());
+        if (context.GetRepeatCounter() < 2)
+            context.Repeat();
+    });
+
+    for (int i = 0; i < 5; ++i)
+        scheduler.Update(1s);
+
+    REQUIRE(repeats == std::vector<uint32>{ 0, 1, 2 });
+}
+
+TEST_CASE("Groups can be cancelled and delayed", "[TaskScheduler]")
+{
+    std::vector<int> executed;
+    TaskScheduler scheduler;
+    scheduler.Schedule(1s, 1, [&executed](TaskContext) { executed.push_back(1); });
+    scheduler.Schedule(1s, 2, [&executed](TaskContext) { executed.push_back(2); });
+    scheduler.Schedule(2s, 3, [&executed](TaskContext) { executed.push_back(3); });
+    scheduler.Schedule(2s, [&executed](TaskContext) { executed.push_back(4); });
+
+    SECTION("cancel")
+    {
+        scheduler.CancelGroup(2);
+        scheduler.Update(2s);
+        REQUIRE(executed == std::vector<int>{ 1, 3, 4 });
+    }
+
+    SECTION("delay")
+    {
+        // delayed tasks run after the ones that already had the same end
+        scheduler.DelayGroup(1, 1s);
+        scheduler.Update(2s);
+        REQUIRE(executed == std::vector<int>{ 2, 3, 4, 1 });
+    }
+
+    SECTION("cancel from a task")
+    {
+        scheduler.Schedule(500ms, [](TaskContext context) { context.CancelGroup(1); });
+        scheduler.Update(2s);
+        REQUIRE(executed == std::vector<int>{ 2, 3, 4 });
+    }
+}
+
+TEST_CASE("Boss script scheduling", "[.benchmark][TaskScheduler]")
+{
+    BENCHMARK("Schedule, Repeat, CancelGroup and Update")
+    {
+        uint32 executed = 0;
+        TaskScheduler scheduler;
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            scheduler.Schedule(Milliseconds(100 + i * 10), i % 4, [&executed](TaskContext context)
+            {
+                ++executed;
+                if (context.GetRepeatCounter() < 20)
+                    context.Repeat(1s);
+            });
+        }
+
+        for (uint32 update = 0; update < 200; ++update)
+        {
+            if (update % 50 == 49)
+                scheduler.CancelGroup(update / 50);
+
+            scheduler.Update(100ms);
+        }
+        return executed;
+    };
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Trace.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+TEST_CASE("Zones of all threads are written", "[Trace]")
+{
+    Trinity::Trace::SetThreadName("Test main");
+    {
+        Trinity::Trace::Zone outer("Outer");
+        Trinity::Trace::Zone inner("Inner \"quoted\"");
+    }
+
+    std::thread([]
+    {
+        Trinity::Trace::SetThreadName("Test worker");
+        for (int i = 0; i < 100; ++i)
+            Trinity::Trace::Zone zone("Worker");
+    }).join();
+
+    std::string fileName = "trace_test.json";
+    std::size_t zones = 0;
+    REQUIRE(Trinity::Trace::WriteChromeTrace(fileName, 60s, &zones));
+    REQUIRE(zones == 102);
+
+    std::ostringstream json;
+    json << std::ifstream(fileName).rdbuf();
+    std::remove(fileName.c_str());
+
+    REQUIRE(json.str().find(R"("name":"Inner \"quoted\"")") != std::string::npos);
+    REQUIRE(json.str().find(R"("args":{"name":"Test worker"})") != std::string::npos);
+
+    SECTION("rings of exited threads are dropped after their last dump")
+    {
+        REQUIRE(Trinity::Trace::WriteChromeTrace(fileName, 60s, &zones));
+        std::remove(fileName.c_str());
+        REQUIRE(zones == 2);
+    }
+}
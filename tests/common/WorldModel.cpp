@@ -0,0 +1,89 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ModelIgnoreFlags.h"
+#include "WorldModel.h"
+#include <filesystem>
+
+using namespace VMAP;
+
+namespace
+{
+GroupModel MakeGroup(G3D::Vector3 const& offset, uint32 wmoId, bool withLiquid)
+{
+    // a wall of two triangles facing the x axis
+    std::vector<G3D::Vector3> vertices =
+    {
+        offset + G3D::Vector3(0.0f, 0.0f, 0.0f),
+        offset + G3D::Vector3(0.0f, 10.0f, 0.0f),
+        offset + G3D::Vector3(0.0f, 10.0f, 10.0f),
+        offset + G3D::Vector3(0.0f, 0.0f, 10.0f)
+    };
+    std::vector<MeshTriangle> triangles = { { 0, 1, 2 }, { 0, 2, 3 } };
+
+    GroupModel group(0, wmoId, G3D::AABox(offset, offset + G3D::Vector3(0.0f, 10.0f, 10.0f)));
+    group.setMeshData(vertices, triangles);
+    if (withLiquid)
+    {
+        // 3x3 tiles leave the flags unaligned without padding
+        WmoLiquid* liquid = new WmoLiquid(3, 3, offset, 1);
+        std::fill_n(liquid->GetHeightStorage(), 16, offset.z + 5.0f);
+        std::fill_n(liquid->GetFlagsStorage(), 9, uint8(0));
+        group.setLiquidData(liquid);
+    }
+    return group;
+}
+}
+
+TEST_CASE("Mapped model files match read ones", "[WorldModel]")
+{
+    std::string fileName = (std::filesystem::temp_directory_path() / "tc_tests_worldmodel.vmo").string();
+    {
+        std::vector<GroupModel> groups;
+        groups.push_back(MakeGroup(G3D::Vector3(10.0f, 0.0f, 0.0f), 1, true));
+        groups.push_back(MakeGroup(G3D::Vector3(20.0f, 0.0f, 0.0f), 2, false));
+        WorldModel model;
+        model.setGroupModels(groups);
+        REQUIRE(model.writeFile(fileName));
+    }
+
+    WorldModel readModel;
+    REQUIRE(readModel.readFile(fileName));
+    WorldModel mappedModel;
+    REQUIRE(mappedModel.mapFile(fileName));
+
+    for (float y = -2.0f; y < 12.0f; y += 1.5f)
+    {
+        G3D::Ray ray = G3D::Ray::fromOriginAndDirection({ 0.0f, y, 5.0f }, { 1.0f, 0.0f, 0.0f });
+        float readDistance = 100.0f;
+        float mappedDistance = 100.0f;
+        bool readHit = readModel.IntersectRay(ray, readDistance, false, ModelIgnoreFlags::Nothing);
+        bool mappedHit = mappedModel.IntersectRay(ray, mappedDistance, false, ModelIgnoreFlags::Nothing);
+        REQUIRE(readHit == mappedHit);
+        REQUIRE(readDistance == mappedDistance);
+    }
+
+    // the second group is behind the liquid of the first one in the file
+    G3D::Ray ray = G3D::Ray::fromOriginAndDirection({ 15.0f, 5.0f, 5.0f }, { 1.0f, 0.0f, 0.0f });
+    float distance = 100.0f;
+    REQUIRE(mappedModel.IntersectRay(ray, distance, false, ModelIgnoreFlags::Nothing));
+    REQUIRE(distance == Approx(5.0f));
+
+    std::filesystem::remove(fileName);
+}
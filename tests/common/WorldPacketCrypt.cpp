@@ -0,0 +1,64 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "tc_catch2.h"
+
+#include "WorldPacketCrypt.h"
+#include <vector>
+
+TEST_CASE("Batched encryption matches encrypting packets one by one", "[WorldPacketCrypt]")
+{
+    Trinity::Crypto::AES::Key key = { 0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE, 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF };
+    std::vector<uint32> const sizes = { 2, 13, 64, 1100, 7 };
+
+    std::vector<std::vector<uint8>> single;
+    std::vector<std::vector<uint8>> batched;
+    for (uint32 size : sizes)
+    {
+        std::vector<uint8> data(size);
+        for (uint32 i = 0; i < size; ++i)
+            data[i] = uint8(i * 7 + size);
+
+        single.push_back(data);
+        batched.push_back(data);
+    }
+
+    WorldPacketCrypt singleCrypt;
+    singleCrypt.Init(key);
+    std::vector<std::array<uint8, Trinity::Crypto::AES::TAG_SIZE_BYTES>> singleTags(sizes.size());
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+    {
+        Trinity::Crypto::AES::Tag tag;
+        REQUIRE(singleCrypt.EncryptSend(single[i].data(), single[i].size(), tag));
+        std::copy(std::begin(tag), std::end(tag), singleTags[i].begin());
+    }
+
+    WorldPacketCrypt batchCrypt;
+    batchCrypt.Init(key);
+    std::vector<std::array<uint8, Trinity::Crypto::AES::TAG_SIZE_BYTES>> batchTags(sizes.size());
+    std::vector<WorldPacketCrypt::SendBatchEntry> entries;
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+        entries.push_back({ batched[i].data(), uint32(batched[i].size()), batchTags[i].data() });
+
+    // split in two batches to check the counter carries over
+    REQUIRE(batchCrypt.EncryptSend(std::span(entries).first(2)));
+    REQUIRE(batchCrypt.EncryptSend(std::span(entries).subspan(2)));
+
+    REQUIRE(batched == single);
+    REQUIRE(batchTags == singleTags);
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "tc_catch2.h"
+
+#include "DatabaseCoroutine.h"
+#include "Optional.h"
+
+namespace
+{
+struct FrameGuard
+{
+    explicit FrameGuard(bool& destroyed) : Destroyed(destroyed) { }
+    ~FrameGuard() { Destroyed = true; }
+    bool& Destroyed;
+};
+
+Trinity::DatabaseCoroutine AwaitTwoQueries(QueryCallbackProcessor& processor, QueryCallback first, QueryCallback second, int& step, bool& destroyed)
+{
+    FrameGuard guard(destroyed);
+    step = 1;
+    co_await Trinity::AwaitPreparedQuery(processor, std::move(first));
+    step = 2;
+    co_await Trinity::AwaitPreparedQuery(processor, std::move(second));
+    step = 3;
+}
+
+Trinity::DatabaseCoroutine AwaitTransaction(AsyncCallbackProcessor<TransactionCallback>& processor, TransactionCallback callback, Optional<bool>& result)
+{
+    result = co_await Trinity::AwaitTransaction(processor, std::move(callback));
+}
+}
+
+TEST_CASE("Coroutine is resumed by the processor once the result is ready", "[DatabaseCoroutine]")
+{
+    QueryCallbackProcessor processor;
+    PreparedQueryResultPromise first;
+    PreparedQueryResultPromise second;
+    int step = 0;
+    bool destroyed = false;
+
+    AwaitTwoQueries(processor, QueryCallback(first.get_future()), QueryCallback(second.get_future()), step, destroyed);
+    REQUIRE(step == 1);
+
+    processor.ProcessReadyCallbacks();
+    REQUIRE(step == 1);
+
+    first.set_value(nullptr);
+    processor.ProcessReadyCallbacks();
+    REQUIRE(step == 2);
+    REQUIRE(!processor.Empty());
+
+    second.set_value(nullptr);
+    processor.ProcessReadyCallbacks();
+    REQUIRE(step == 3);
+    REQUIRE(destroyed);
+    REQUIRE(processor.Empty());
+}
+
+TEST_CASE("Coroutine is destroyed with the processor it waits on", "[DatabaseCoroutine]")
+{
+    PreparedQueryResultPromise first;
+    PreparedQueryResultPromise second;
+    int step = 0;
+    bool destroyed = false;
+
+    {
+        QueryCallbackProcessor processor;
+        AwaitTwoQueries(processor, QueryCallback(first.get_future()), QueryCallback(second.get_future()), step, destroyed);
+        REQUIRE(!destroyed);
+    }
+
+    REQUIRE(step == 1);
+    REQUIRE(destroyed);
+}
+
+TEST_CASE("Transaction result is returned from co_await", "[DatabaseCoroutine]")
+{
+    AsyncCallbackProcessor<TransactionCallback> processor;
+    TransactionPromise promise;
+    Optional<bool> result;
+
+    AwaitTransaction(processor, TransactionCallback(promise.get_future()), result);
+    REQUIRE(!result);
+
+    promise.set_value(true);
+    processor.ProcessReadyCallbacks();
+    REQUIRE(result == true);
+}
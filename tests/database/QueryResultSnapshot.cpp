@@ -0,0 +1,78 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "tc_catch2.h"
+
+#include "Field.h"
+#include "QueryResult.h"
+#include "QueryResultSnapshot.h"
+#include <sstream>
+
+namespace
+{
+std::shared_ptr<QueryResultSnapshot> MakeSnapshot()
+{
+    std::shared_ptr<QueryResultSnapshot> snapshot = std::make_shared<QueryResultSnapshot>();
+    snapshot->Columns.resize(2);
+    snapshot->Columns[0].Name = "entry";
+    snapshot->Columns[0].Type = DatabaseFieldTypes::UInt32;
+    snapshot->Columns[1].Name = "name";
+    snapshot->Columns[1].Type = DatabaseFieldTypes::Binary;
+
+    // row 1: 12, "abc"; row 2: 7, NULL
+    snapshot->Lengths = { 2, 3, 1, QueryResultSnapshot::NullLength };
+    snapshot->Data = std::string("12\0abc\0" "7\0", 9);
+    snapshot->RowCount = 2;
+    return snapshot;
+}
+}
+
+TEST_CASE("Snapshot survives a write and read", "[QueryResultSnapshot]")
+{
+    std::stringstream stream;
+    MakeSnapshot()->Write(stream);
+
+    std::shared_ptr<QueryResultSnapshot> snapshot = std::make_shared<QueryResultSnapshot>();
+    REQUIRE(snapshot->Read(stream));
+    REQUIRE(snapshot->RowCount == 2);
+    REQUIRE(snapshot->Columns.size() == 2);
+    REQUIRE(snapshot->Columns[1].Name == "name");
+
+    ResultSet result(snapshot);
+    REQUIRE(result.GetRowCount() == 2);
+
+    REQUIRE(result.NextRow());
+    REQUIRE(result[0].GetUInt32() == 12);
+    REQUIRE(result[1].GetString() == "abc");
+
+    REQUIRE(result.NextRow());
+    REQUIRE(result[0].GetUInt32() == 7);
+    REQUIRE(result[1].IsNull());
+
+    REQUIRE(!result.NextRow());
+}
+
+TEST_CASE("Truncated snapshot is rejected", "[QueryResultSnapshot]")
+{
+    std::stringstream stream;
+    MakeSnapshot()->Write(stream);
+
+    std::string data = stream.str();
+    std::stringstream truncated(data.substr(0, data.size() - 1));
+
+    QueryResultSnapshot snapshot;
+    REQUIRE(!snapshot.Read(truncated));
+}
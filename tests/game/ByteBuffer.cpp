@@ -0,0 +1,86 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ByteBuffer.h"
+#include "MessageBuffer.h"
+
+TEST_CASE("Buffer sizes are rounded up to size classes", "[ByteBuffer]")
+{
+    using Allocator = Trinity::ByteBufferAllocator<uint8>;
+    REQUIRE(Allocator::GetSizeClass(1) == 0x100);
+    REQUIRE(Allocator::GetSizeClass(0x100) == 0x100);
+    REQUIRE(Allocator::GetSizeClass(0x101) == 0x1000);
+    REQUIRE(Allocator::GetSizeClass(0x10000) == 0x10000);
+    REQUIRE(Allocator::GetSizeClass(0x10001) == 0);
+}
+
+TEST_CASE("Storage of destroyed buffers is reused", "[ByteBuffer]")
+{
+    uint8 const* first;
+    {
+        ByteBuffer buffer(200, ByteBuffer::Reserve{});
+        buffer << uint32(1);
+        first = buffer.contents();
+    }
+
+    ByteBuffer other(150, ByteBuffer::Reserve{});
+    other << uint32(2);
+    REQUIRE(other.contents() == first);
+}
+
+TEST_CASE("Appending grows storage to the next size class", "[ByteBuffer]")
+{
+    ByteBuffer buffer(0, ByteBuffer::Reserve{});
+    buffer << uint8(1);
+    REQUIRE(buffer.size() == 1);
+
+    std::array<uint8, 0x200> data = { };
+    buffer.append(data.data(), data.size());
+    REQUIRE(buffer.size() == data.size() + 1);
+    REQUIRE(buffer.read<uint8>() == 1);
+}
+
+TEST_CASE("Buffers read from sockets take over the socket storage", "[ByteBuffer]")
+{
+    MessageBuffer socketBuffer(8);
+    uint32 value = 12345;
+    socketBuffer.Write(&value, sizeof(value));
+    socketBuffer.Write(&value, sizeof(value));
+    uint8 const* received = socketBuffer.GetBasePointer();
+
+    ByteBuffer buffer(std::move(socketBuffer));
+    REQUIRE(buffer.size() == 8);
+    REQUIRE(buffer.contents() == received);
+    REQUIRE(buffer.read<uint32>() == 12345);
+    REQUIRE(socketBuffer.GetActiveSize() == 0);
+}
+
+TEST_CASE("String views point into the buffer", "[ByteBuffer]")
+{
+    ByteBuffer buffer;
+    buffer.WriteString(std::string_view("prefixtext"));
+
+    std::string_view prefix = buffer.ReadStringView(6);
+    std::string_view text = buffer.ReadStringView(4);
+    REQUIRE(prefix == "prefix");
+    REQUIRE(text == "text");
+    REQUIRE(prefix.data() == reinterpret_cast<char const*>(buffer.contents()));
+    REQUIRE(buffer.ReadStringView(0).empty());
+    REQUIRE_THROWS_AS(buffer.ReadStringView(1), ByteBufferPositionException);
+}
@@ -0,0 +1,98 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "DB2Store.h"
+#include "DummyData.h"
+#include <vector>
+
+namespace
+{
+struct TestEntry
+{
+    uint32 ID;
+    int32 Value;
+};
+
+std::vector<uint32> GetIds(DB2Storage<TestEntry> const& store)
+{
+    std::vector<uint32> ids;
+    for (TestEntry const* entry : store)
+        ids.push_back(entry->ID);
+    return ids;
+}
+}
+
+TEST_CASE("Sparse DB2 stores use a compact index", "[DB2Store]")
+{
+    DB2Storage<TestEntry> store("Test.db2", nullptr);
+    UnitTestDataLoader::DB2<TestEntry, &TestEntry::ID> data(store);
+    std::vector<uint32> ids = { 3, 17, 500, 4096, 70000, 200000 };
+    {
+        auto loader = data.Loader();
+        for (uint32 id : ids)
+        {
+            TestEntry& entry = loader.Add();
+            entry.ID = id;
+            entry.Value = int32(id) * 2;
+        }
+    }
+
+    store.CompactIndex();
+    REQUIRE(store.HasCompactIndex());
+    REQUIRE(store.GetNumRows() == 200001);
+
+    for (uint32 id : ids)
+    {
+        REQUIRE(store.HasRecord(id));
+        REQUIRE(store.LookupEntry(id)->Value == int32(id) * 2);
+    }
+
+    REQUIRE(store.LookupEntry(0) == nullptr);
+    REQUIRE(store.LookupEntry(18) == nullptr);
+    REQUIRE(store.LookupEntry(199999) == nullptr);
+    REQUIRE(store.LookupEntry(200001) == nullptr);
+    REQUIRE(GetIds(store) == ids);
+
+    store.EraseRecord(500);
+    REQUIRE(!store.HasRecord(500));
+    REQUIRE(GetIds(store) == std::vector<uint32>{ 3, 17, 4096, 70000, 200000 });
+}
+
+TEST_CASE("Dense DB2 stores keep their index", "[DB2Store]")
+{
+    DB2Storage<TestEntry> store("Test.db2", nullptr);
+    UnitTestDataLoader::DB2<TestEntry, &TestEntry::ID> data(store);
+    std::vector<uint32> ids;
+    {
+        auto loader = data.Loader();
+        for (uint32 id = 1; id < 10000; id += 3)
+        {
+            TestEntry& entry = loader.Add();
+            entry.ID = id;
+            entry.Value = int32(id);
+            ids.push_back(id);
+        }
+    }
+
+    store.CompactIndex();
+    REQUIRE(!store.HasCompactIndex());
+    REQUIRE(store.LookupEntry(4)->Value == 4);
+    REQUIRE(store.LookupEntry(5) == nullptr);
+    REQUIRE(GetIds(store) == ids);
+}
@@ -0,0 +1,179 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "DBCEnums.h"
+#include "DifficultyLookupTable.h"
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <random>
+#include <unordered_map>
+
+namespace
+{
+struct TestSpellInfo
+{
+    TestSpellInfo(uint32 id, ::Difficulty difficulty) : Id(id), Difficulty(difficulty) { }
+
+    uint32 const Id;
+    ::Difficulty const Difficulty;
+};
+
+// same layout as the SpellInfo store
+using TestSpellInfoMap = boost::multi_index::multi_index_container<
+    TestSpellInfo,
+    boost::multi_index::indexed_by<
+        boost::multi_index::hashed_unique<
+            boost::multi_index::composite_key<
+                TestSpellInfo,
+                boost::multi_index::member<TestSpellInfo, uint32 const, &TestSpellInfo::Id>,
+                boost::multi_index::member<TestSpellInfo, Difficulty const, &TestSpellInfo::Difficulty>
+            >
+        >
+    >
+>;
+
+// a few chains like in Difficulty.db2, DIFFICULTY_MYTHIC_KEYSTONE -> DIFFICULTY_MYTHIC -> DIFFICULTY_HEROIC -> DIFFICULTY_NORMAL
+std::unordered_map<uint8, uint8> const Fallbacks =
+{
+    { DIFFICULTY_NORMAL, DIFFICULTY_NONE },
+    { DIFFICULTY_HEROIC, DIFFICULTY_NORMAL },
+    { DIFFICULTY_MYTHIC, DIFFICULTY_HEROIC },
+    { DIFFICULTY_MYTHIC_KEYSTONE, DIFFICULTY_MYTHIC },
+    { DIFFICULTY_NORMAL_RAID, DIFFICULTY_NONE },
+    { DIFFICULTY_HEROIC_RAID, DIFFICULTY_NORMAL_RAID },
+    { DIFFICULTY_MYTHIC_RAID, DIFFICULTY_HEROIC_RAID },
+    { DIFFICULTY_LFR_NEW, DIFFICULTY_NORMAL_RAID },
+    { DIFFICULTY_TIMEWALKING, DIFFICULTY_NORMAL }
+};
+
+Optional<Difficulty> GetFallback(Difficulty difficulty)
+{
+    auto itr = Fallbacks.find(difficulty);
+    if (itr == Fallbacks.end())
+        return {};
+    return Difficulty(itr->second);
+}
+
+// the lookup SpellMgr::GetSpellInfo did before the table
+TestSpellInfo const* FindWithFallback(TestSpellInfoMap const& store, uint32 id, Difficulty difficulty)
+{
+    Optional<Difficulty> current = difficulty;
+    while (current)
+    {
+        auto itr = store.find(boost::make_tuple(id, *current));
+        if (itr != store.end())
+            return &*itr;
+
+        current = GetFallback(*current);
+    }
+    return nullptr;
+}
+
+std::vector<Difficulty> const Difficulties =
+{
+    DIFFICULTY_NONE, DIFFICULTY_NORMAL, DIFFICULTY_HEROIC, DIFFICULTY_MYTHIC, DIFFICULTY_MYTHIC_KEYSTONE, DIFFICULTY_NORMAL_RAID,
+    DIFFICULTY_HEROIC_RAID, DIFFICULTY_MYTHIC_RAID, DIFFICULTY_LFR_NEW, DIFFICULTY_TIMEWALKING, DIFFICULTY_EVENT_DUNGEON
+};
+
+TestSpellInfoMap CreateStore(uint32 spellCount)
+{
+    // most spells only exist for DIFFICULTY_NONE
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> difficulty(0, Difficulties.size() - 1);
+    TestSpellInfoMap store;
+    for (uint32 id = 1; id <= spellCount; id += 1 + rng() % 3)
+    {
+        if (rng() % 10)
+            store.emplace(id, DIFFICULTY_NONE);
+
+        if (rng() % 10 == 0)
+            for (uint32 i = 0; i < 3; ++i)
+                store.emplace(id, Difficulties[difficulty(rng)]);
+    }
+    return store;
+}
+}
+
+TEST_CASE("Difficulty lookup table matches fallback search", "[DifficultyLookupTable]")
+{
+    TestSpellInfoMap store = CreateStore(20000);
+    DifficultyLookupTable<TestSpellInfo> table;
+    table.Build(store, &GetFallback);
+
+    for (uint32 id = 0; id <= 20010; ++id)
+        for (Difficulty difficulty : Difficulties)
+            REQUIRE(table.Find(id, difficulty) == FindWithFallback(store, id, difficulty));
+
+    SECTION("fallback cycles do not hang")
+    {
+        TestSpellInfoMap cycleStore;
+        cycleStore.emplace(1, DIFFICULTY_NONE);
+        cycleStore.emplace(1, DIFFICULTY_HEROIC);
+        cycleStore.emplace(2, DIFFICULTY_NONE);
+        table.Build(cycleStore, [](Difficulty difficulty) -> Optional<Difficulty>
+        {
+            if (difficulty == DIFFICULTY_HEROIC)
+                return DIFFICULTY_MYTHIC;
+            if (difficulty == DIFFICULTY_MYTHIC)
+                return DIFFICULTY_HEROIC;
+            return {};
+        });
+
+        REQUIRE(table.Find(1, DIFFICULTY_MYTHIC) == &*cycleStore.find(boost::make_tuple(1, DIFFICULTY_HEROIC)));
+        REQUIRE(!table.Find(2, DIFFICULTY_MYTHIC));
+    }
+
+    SECTION("clearing drops all values")
+    {
+        table.Clear();
+        REQUIRE(!table.Find(1, DIFFICULTY_NONE));
+    }
+}
+
+TEST_CASE("Spell info lookup", "[.benchmark][DifficultyLookupTable]")
+{
+    TestSpellInfoMap store = CreateStore(400000);
+    DifficultyLookupTable<TestSpellInfo> table;
+    table.Build(store, &GetFallback);
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<uint32> spellId(1, 400000);
+    std::uniform_int_distribution<std::size_t> difficulty(0, Difficulties.size() - 1);
+    std::vector<std::pair<uint32, Difficulty>> queries(10000);
+    for (std::pair<uint32, Difficulty>& query : queries)
+        query = { spellId(rng), Difficulties[difficulty(rng)] };
+
+    BENCHMARK("multi_index with fallback search")
+    {
+        std::size_t found = 0;
+        for (auto [id, queryDifficulty] : queries)
+            found += FindWithFallback(store, id, queryDifficulty) != nullptr;
+        return found;
+    };
+
+    BENCHMARK("DifficultyLookupTable")
+    {
+        std::size_t found = 0;
+        for (auto [id, queryDifficulty] : queries)
+            found += table.Find(id, queryDifficulty) != nullptr;
+        return found;
+    };
+}
@@ -0,0 +1,169 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "GridObject.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+struct TestGridObject : public GridObject<TestGridObject>
+{
+    explicit TestGridObject(uint32 value) : Value(value) { }
+
+    uint32 Value;
+};
+
+std::vector<std::unique_ptr<TestGridObject>> CreateObjects(uint32 count)
+{
+    std::vector<std::unique_ptr<TestGridObject>> objects;
+    for (uint32 i = 0; i < count; ++i)
+        objects.push_back(std::make_unique<TestGridObject>(i));
+    return objects;
+}
+
+std::vector<uint32> VisitValues(GridRefManager<TestGridObject>& container)
+{
+    std::vector<uint32> values;
+    container.GetDenseContainer().ForEach([&](TestGridObject* obj) { values.push_back(obj->Value); });
+    std::sort(values.begin(), values.end());
+    return values;
+}
+}
+
+TEST_CASE("Dense container holds the same objects as the list", "[GridDenseContainer]")
+{
+    GridRefManager<TestGridObject> container;
+    std::vector<std::unique_ptr<TestGridObject>> objects = CreateObjects(8);
+    for (std::unique_ptr<TestGridObject>& obj : objects)
+        obj->AddToGrid(container);
+
+    objects[0]->RemoveFromGrid();
+    objects[5]->RemoveFromGrid();
+    objects[7]->RemoveFromGrid();
+
+    REQUIRE(container.GetDenseContainer().size() == 5);
+    REQUIRE(VisitValues(container) == std::vector<uint32>{ 1, 2, 3, 4, 6 });
+
+    for (std::unique_ptr<TestGridObject>& obj : objects)
+        if (obj->IsInGrid())
+            obj->RemoveFromGrid();
+
+    REQUIRE(container.GetDenseContainer().size() == 0);
+}
+
+TEST_CASE("Dense container stays consistent when modified while visiting", "[GridDenseContainer]")
+{
+    GridRefManager<TestGridObject> container;
+    std::vector<std::unique_ptr<TestGridObject>> objects = CreateObjects(10);
+    for (uint32 i = 0; i < 6; ++i)
+        objects[i]->AddToGrid(container);
+
+    SECTION("removed objects are not visited")
+    {
+        std::vector<uint32> visited;
+        container.GetDenseContainer().ForEach([&](TestGridObject* obj)
+        {
+            visited.push_back(obj->Value);
+            // removes the visited object itself and one that was not visited yet
+            if (obj->Value == 0)
+            {
+                objects[0]->RemoveFromGrid();
+                objects[5]->RemoveFromGrid();
+            }
+        });
+
+        REQUIRE(std::find(visited.begin(), visited.end(), 5) == visited.end());
+        REQUIRE(visited.size() == 5);
+        REQUIRE(VisitValues(container) == std::vector<uint32>{ 1, 2, 3, 4 });
+    }
+
+    SECTION("added objects are not visited")
+    {
+        std::vector<uint32> visited;
+        container.GetDenseContainer().ForEach([&](TestGridObject* obj)
+        {
+            visited.push_back(obj->Value);
+            if (obj->Value == 2)
+                objects[8]->AddToGrid(container);
+        });
+
+        REQUIRE(visited.size() == 6);
+        REQUIRE(VisitValues(container) == std::vector<uint32>{ 0, 1, 2, 3, 4, 5, 8 });
+    }
+
+    SECTION("nested visits compact after the outermost one")
+    {
+        container.GetDenseContainer().ForEach([&](TestGridObject* obj)
+        {
+            if (obj->Value != 3)
+                return;
+
+            container.GetDenseContainer().ForEach([&](TestGridObject* inner)
+            {
+                if (inner->Value % 2)
+                    inner->RemoveFromGrid();
+            });
+        });
+
+        REQUIRE(VisitValues(container) == std::vector<uint32>{ 0, 2, 4 });
+
+        // slots must be valid again after compaction
+        objects[2]->RemoveFromGrid();
+        REQUIRE(VisitValues(container) == std::vector<uint32>{ 0, 4 });
+    }
+
+    for (std::unique_ptr<TestGridObject>& obj : objects)
+        if (obj->IsInGrid())
+            obj->RemoveFromGrid();
+}
+
+TEST_CASE("Visiting grid objects", "[.benchmark][GridDenseContainer]")
+{
+    // objects allocated in a different order than they are linked, like in a running map
+    std::vector<std::unique_ptr<TestGridObject>> objects = CreateObjects(10000);
+    std::vector<TestGridObject*> linkOrder;
+    for (std::unique_ptr<TestGridObject>& obj : objects)
+        linkOrder.push_back(obj.get());
+    std::shuffle(linkOrder.begin(), linkOrder.end(), std::mt19937(42));
+
+    GridRefManager<TestGridObject> container;
+    for (TestGridObject* obj : linkOrder)
+        obj->AddToGrid(container);
+
+    BENCHMARK("GridRefManager list")
+    {
+        uint64 sum = 0;
+        for (GridRefManager<TestGridObject>::iterator itr = container.begin(); itr != container.end(); ++itr)
+            sum += itr->GetSource()->Value;
+        return sum;
+    };
+
+    BENCHMARK("GridDenseContainer")
+    {
+        uint64 sum = 0;
+        container.GetDenseContainer().ForEach([&](TestGridObject* obj) { sum += obj->Value; });
+        return sum;
+    };
+
+    for (TestGridObject* obj : linkOrder)
+        obj->RemoveFromGrid();
+}
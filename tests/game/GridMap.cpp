@@ -0,0 +1,125 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "GridMap.h"
+#include <filesystem>
+#include <random>
+
+namespace
+{
+template<typename T>
+void WriteHeights(FILE* file, std::mt19937& rng, std::size_t count)
+{
+    std::vector<T> heights(count);
+    if constexpr (std::is_same_v<T, float>)
+    {
+        std::uniform_real_distribution<float> height(-20.0f, 80.0f);
+        for (T& h : heights)
+            h = height(rng);
+    }
+    else
+    {
+        std::uniform_int_distribution<uint32> height(0, std::numeric_limits<T>::max());
+        for (T& h : heights)
+            h = T(height(rng));
+    }
+
+    fwrite(heights.data(), sizeof(T), count, file);
+}
+
+template<typename T>
+std::string WriteMapFile(map_heightHeaderFlags heightFlags)
+{
+    std::string fileName = (std::filesystem::temp_directory_path() / "tc_tests_gridmap.map").string();
+    FILE* file = fopen(fileName.c_str(), "wb");
+    REQUIRE(file);
+
+    uint32 heightSize = sizeof(map_heightHeader) + sizeof(T) * (129 * 129 + 128 * 128);
+    map_fileheader header = { };
+    header.mapMagic = MapMagic;
+    header.versionMagic = MapVersionMagic;
+    header.heightMapOffset = sizeof(map_fileheader);
+    header.heightMapSize = heightSize;
+    header.holesOffset = sizeof(map_fileheader) + heightSize;
+    header.holesSize = 16 * 16 * 8;
+    fwrite(&header, sizeof(header), 1, file);
+
+    map_heightHeader heightHeader;
+    heightHeader.heightMagic = MapHeightMagic;
+    heightHeader.flags = heightFlags;
+    heightHeader.gridHeight = -10.0f;
+    heightHeader.gridMaxHeight = 90.0f;
+    fwrite(&heightHeader, sizeof(heightHeader), 1, file);
+
+    std::mt19937 rng(1234);
+    WriteHeights<T>(file, rng, 129 * 129);
+    WriteHeights<T>(file, rng, 128 * 128);
+
+    // a few holes
+    std::vector<uint8> holes(16 * 16 * 8);
+    for (std::size_t i = 0; i < holes.size(); i += 37)
+        holes[i] = 0x81;
+    fwrite(holes.data(), 1, holes.size(), file);
+
+    fclose(file);
+    return fileName;
+}
+
+template<typename T>
+void CheckHeights(map_heightHeaderFlags heightFlags)
+{
+    std::string fileName = WriteMapFile<T>(heightFlags);
+    GridMap grid;
+    REQUIRE(grid.loadData(fileName.c_str()) == GridMap::LoadResult::Ok);
+    std::filesystem::remove(fileName);
+
+    std::mt19937 rng(4321);
+    std::uniform_real_distribution<float> coord(-533.0f, 0.0f);
+    std::vector<float> x(1000);
+    std::vector<float> y(1000);
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = coord(rng);
+        y[i] = coord(rng);
+    }
+
+    std::vector<float> heights(x.size());
+    grid.getHeights(x.data(), y.data(), heights.data(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+        REQUIRE(heights[i] == grid.getHeight(x[i], y[i]));
+}
+}
+
+TEST_CASE("Batched grid heights match single points", "[GridMap]")
+{
+    SECTION("float")
+    {
+        CheckHeights<float>(map_heightHeaderFlags::None);
+    }
+
+    SECTION("uint16")
+    {
+        CheckHeights<uint16>(map_heightHeaderFlags::HeightAsInt16);
+    }
+
+    SECTION("uint8")
+    {
+        CheckHeights<uint8>(map_heightHeaderFlags::HeightAsInt8);
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "GridObject.h"
+#include <memory>
+#include <vector>
+
+namespace
+{
+struct TestOccupancyObject : public GridObject<TestOccupancyObject> { };
+struct OtherOccupancyObject : public GridObject<OtherOccupancyObject> { };
+}
+
+template<> inline constexpr uint32 GridMapTypeMaskOf<TestOccupancyObject> = GRID_MAP_TYPE_MASK_PLAYER;
+template<> inline constexpr uint32 GridMapTypeMaskOf<OtherOccupancyObject> = GRID_MAP_TYPE_MASK_GAMEOBJECT;
+
+TEST_CASE("Cell occupancy follows added and removed objects", "[GridOccupancy]")
+{
+    GridOccupancy gridOccupancy;
+    GridOccupancy cellOccupancy;
+    cellOccupancy.SetParent(&gridOccupancy);
+
+    GridRefManager<TestOccupancyObject> players;
+    players.SetOccupancy(&cellOccupancy);
+    GridRefManager<OtherOccupancyObject> gameObjects;
+    gameObjects.SetOccupancy(&cellOccupancy);
+
+    REQUIRE(cellOccupancy.GetMask() == 0);
+
+    std::vector<std::unique_ptr<TestOccupancyObject>> objects;
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        objects.push_back(std::make_unique<TestOccupancyObject>());
+        objects.back()->AddToGrid(players);
+    }
+
+    OtherOccupancyObject gameObject;
+    gameObject.AddToGrid(gameObjects);
+
+    REQUIRE(cellOccupancy.GetMask() == (GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_GAMEOBJECT));
+    REQUIRE(gridOccupancy.GetMask() == cellOccupancy.GetMask());
+
+    objects[0]->RemoveFromGrid();
+    objects[2]->RemoveFromGrid();
+    REQUIRE(cellOccupancy.GetMask() == (GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_GAMEOBJECT));
+
+    objects[1]->RemoveFromGrid();
+    REQUIRE(cellOccupancy.GetMask() == GRID_MAP_TYPE_MASK_GAMEOBJECT);
+    REQUIRE(gridOccupancy.GetMask() == GRID_MAP_TYPE_MASK_GAMEOBJECT);
+
+    gameObject.RemoveFromGrid();
+    REQUIRE(cellOccupancy.GetMask() == 0);
+    REQUIRE(gridOccupancy.GetMask() == 0);
+}
+
+TEST_CASE("Grid occupancy keeps types of other cells", "[GridOccupancy]")
+{
+    GridOccupancy gridOccupancy;
+    GridOccupancy firstCell;
+    firstCell.SetParent(&gridOccupancy);
+    GridOccupancy secondCell;
+    secondCell.SetParent(&gridOccupancy);
+
+    GridRefManager<TestOccupancyObject> firstCellPlayers;
+    firstCellPlayers.SetOccupancy(&firstCell);
+    GridRefManager<TestOccupancyObject> secondCellPlayers;
+    secondCellPlayers.SetOccupancy(&secondCell);
+
+    TestOccupancyObject first;
+    first.AddToGrid(firstCellPlayers);
+    TestOccupancyObject second;
+    second.AddToGrid(secondCellPlayers);
+
+    // moving to another cell of the same grid
+    first.RemoveFromGrid();
+    first.AddToGrid(secondCellPlayers);
+    REQUIRE(firstCell.GetMask() == 0);
+    REQUIRE(secondCell.GetMask() == GRID_MAP_TYPE_MASK_PLAYER);
+    REQUIRE(gridOccupancy.GetMask() == GRID_MAP_TYPE_MASK_PLAYER);
+
+    second.RemoveFromGrid();
+    REQUIRE(gridOccupancy.GetMask() == GRID_MAP_TYPE_MASK_PLAYER);
+
+    first.RemoveFromGrid();
+    REQUIRE(gridOccupancy.GetMask() == 0);
+}
+
+TEST_CASE("Containers outside of cells don't track occupancy", "[GridOccupancy]")
+{
+    GridRefManager<TestOccupancyObject> container;
+    TestOccupancyObject obj;
+    obj.AddToGrid(container);
+    REQUIRE(container.GetOccupancy() == nullptr);
+    obj.RemoveFromGrid();
+}
@@ -90,3 +90,39 @@ TEST_CASE("|Hachievement validation", "[Hyperlinks]")
 
     REQUIRE(true  == CheckAllLinks("|cffffff00|Hachievement:4298:Player-0-000000FD:1:12:20:12:0:0:0:0|h[Heroico: Prueba del Campe\xc3\xb3n]|h|r"));
 }
+
+TEST_CASE("Repeated link validation", "[Hyperlinks]")
+{
+    UnitTestDataLoader::LoadItemTemplates();
+    sWorld->setIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY, 1);
+
+    REQUIRE(true  == CheckAllLinks("No links here"));
+    REQUIRE(true  == CheckAllLinks("WTS |cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r"));
+    REQUIRE(true  == CheckAllLinks("WTS |cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r |cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r"));
+    REQUIRE(false == CheckAllLinks("WTS |cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r |cffffffff|Hitem:6948::::::::60:::::|h[Doormat]|h|r"));
+    REQUIRE(false == CheckAllLinks("WTS |cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r|"));
+
+    SECTION("severity change is picked up")
+    {
+        sWorld->setIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY, 0);
+        REQUIRE(true  == CheckAllLinks("|cffffffff|Hitem:6948::::::::60:::::|h[Doormat]|h|r"));
+        sWorld->setIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY, 1);
+        REQUIRE(false == CheckAllLinks("|cffffffff|Hitem:6948::::::::60:::::|h[Doormat]|h|r"));
+    }
+}
+
+TEST_CASE("Trade chat link validation", "[.benchmark][Hyperlinks]")
+{
+    UnitTestDataLoader::LoadItemTemplates();
+    sWorld->setIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY, 1);
+
+    BENCHMARK("plain text")
+    {
+        return CheckAllLinks("LF tank for Trial of the Champion, need 1 more then go");
+    };
+
+    BENCHMARK("repeated item link")
+    {
+        return CheckAllLinks("WTS |cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r cheap, pst");
+    };
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "LineOfSightCache.h"
+
+TEST_CASE("Line of sight cache", "[LineOfSightCache]")
+{
+    LineOfSightCache cache;
+    LineOfSightCache::Key key = LineOfSightCache::MakeKey(10.0f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 1, 3);
+
+    REQUIRE(!cache.Find(key));
+
+    cache.Store(key, false);
+    REQUIRE(cache.Find(key) == false);
+
+    SECTION("positions are compared with limited precision")
+    {
+        REQUIRE(cache.Find(LineOfSightCache::MakeKey(10.01f, 20.0f, 30.0f, 40.0f, 50.0f, 60.01f, 1, 3)) == false);
+        REQUIRE(!cache.Find(LineOfSightCache::MakeKey(10.5f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 1, 3)));
+    }
+
+    SECTION("phases and flags are part of the key")
+    {
+        REQUIRE(!cache.Find(LineOfSightCache::MakeKey(10.0f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 2, 3)));
+        REQUIRE(!cache.Find(LineOfSightCache::MakeKey(10.0f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 1, 1)));
+    }
+
+    SECTION("direction matters")
+    {
+        REQUIRE(!cache.Find(LineOfSightCache::MakeKey(40.0f, 50.0f, 60.0f, 10.0f, 20.0f, 30.0f, 1, 3)));
+    }
+
+    SECTION("clearing drops all results")
+    {
+        cache.Clear();
+        REQUIRE(!cache.Find(key));
+    }
+}
+
+TEST_CASE("Line of sight cache phase shift ids", "[LineOfSightCache]")
+{
+    LineOfSightCache cache;
+    PhaseShift first;
+    first.AddPhase(169, PhaseFlags::None, nullptr);
+    PhaseShift same;
+    same.AddPhase(169, PhaseFlags::None, nullptr);
+    PhaseShift other;
+    other.AddPhase(170, PhaseFlags::None, nullptr);
+
+    Optional<uint32> firstId = cache.GetPhaseShiftId(first);
+    REQUIRE(firstId);
+    REQUIRE(cache.GetPhaseShiftId(same) == firstId);
+    REQUIRE(cache.GetPhaseShiftId(other) != firstId);
+
+    SECTION("ids are limited")
+    {
+        for (uint32 i = 0; i < LineOfSightCache::MaxPhaseShifts; ++i)
+        {
+            PhaseShift phaseShift;
+            phaseShift.AddPhase(1000 + i, PhaseFlags::None, nullptr);
+            cache.GetPhaseShiftId(phaseShift);
+        }
+
+        PhaseShift overflow;
+        overflow.AddPhase(999, PhaseFlags::None, nullptr);
+        REQUIRE(!cache.GetPhaseShiftId(overflow));
+        REQUIRE(cache.GetPhaseShiftId(same) == firstId);
+    }
+}
+
+TEST_CASE("Line of sight cache is bounded", "[LineOfSightCache]")
+{
+    LineOfSightCache cache;
+    for (std::size_t i = 0; i < LineOfSightCache::MaxEntries; ++i)
+        cache.Store(LineOfSightCache::MakeKey(float(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0, 0), true);
+
+    LineOfSightCache::Key overflow = LineOfSightCache::MakeKey(-1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0, 0);
+    cache.Store(overflow, true);
+    REQUIRE(!cache.Find(overflow));
+    REQUIRE(cache.Find(LineOfSightCache::MakeKey(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0, 0)) == true);
+}
@@ -0,0 +1,72 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "MapUpdateProfiler.h"
+#include <thread>
+
+TEST_CASE("MapUpdateProfiler", "[MapUpdateProfiler]")
+{
+    MapUpdateProfiler profiler;
+
+    SECTION("Disabled profiler records nothing")
+    {
+        {
+            MapUpdateProfiler::Update update(profiler);
+            REQUIRE(!update.IsActive());
+            update.SetPhase(MAP_UPDATE_PHASE_SESSIONS);
+        }
+
+        REQUIRE(profiler.BuildReport(10).Updates == 0);
+    }
+
+    SECTION("Time between phase switches goes to the earlier phase")
+    {
+        profiler.SetEnabled(true);
+        for (int i = 0; i < 3; ++i)
+        {
+            MapUpdateProfiler::Update update(profiler);
+            REQUIRE(update.IsActive());
+            update.SetPhase(MAP_UPDATE_PHASE_SCRIPTS);
+            std::this_thread::sleep_for(Milliseconds(2));
+            update.SetPhase(MAP_UPDATE_PHASE_SESSIONS);
+        }
+
+        MapUpdateProfiler::Report report = profiler.BuildReport(10);
+        REQUIRE(report.Updates == 3);
+        REQUIRE(report.Phases[MAP_UPDATE_PHASE_SCRIPTS].Min >= Milliseconds(2));
+        REQUIRE(report.Phases[MAP_UPDATE_PHASE_SCRIPTS].Min <= report.Phases[MAP_UPDATE_PHASE_SCRIPTS].P99);
+        REQUIRE(report.Phases[MAP_UPDATE_PHASE_SCRIPTS].P99 <= report.Phases[MAP_UPDATE_PHASE_SCRIPTS].Max);
+        REQUIRE(report.Phases[MAP_UPDATE_PHASE_SCRIPT_HOOK].Max == Microseconds::zero());
+        REQUIRE(report.Total.Min >= report.Phases[MAP_UPDATE_PHASE_SCRIPTS].Min);
+        REQUIRE(report.TopCreatures.empty());
+
+        // enabling again starts a new window
+        profiler.SetEnabled(true);
+        REQUIRE(profiler.BuildReport(10).Updates == 0);
+    }
+
+    SECTION("Window keeps the last updates only")
+    {
+        profiler.SetEnabled(true);
+        for (std::size_t i = 0; i < MapUpdateProfiler::WindowSize + 5; ++i)
+            MapUpdateProfiler::Update update(profiler);
+
+        REQUIRE(profiler.BuildReport(10).Updates == MapUpdateProfiler::WindowSize);
+    }
+}
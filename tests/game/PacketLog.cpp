@@ -0,0 +1,132 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "PacketLog.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <zlib.h>
+
+namespace
+{
+template<typename T>
+void Append(std::vector<uint8>& buffer, T value)
+{
+    uint8 const* bytes = reinterpret_cast<uint8 const*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void AppendLogHeader(std::vector<uint8>& buffer, uint32 startTicks)
+{
+    buffer.insert(buffer.end(), { 'P', 'K', 'T' });
+    Append<uint16>(buffer, 0x0301);
+    Append<uint8>(buffer, 'T');
+    Append<uint32>(buffer, 0);                      // Build
+    buffer.insert(buffer.end(), { 'e', 'n', 'U', 'S' });
+    buffer.insert(buffer.end(), 40, 0);             // SessionKey
+    Append<uint32>(buffer, 0);                      // SniffStartUnixtime
+    Append<uint32>(buffer, startTicks);
+    Append<uint32>(buffer, 0);                      // OptionalDataSize
+}
+
+void AppendPacket(std::vector<uint8>& buffer, uint32 direction, uint32 ticks, uint8 ip, uint32 port, uint32 opcode, std::vector<uint8> const& data)
+{
+    Append<uint32>(buffer, direction);
+    Append<uint32>(buffer, 1);                      // ConnectionId
+    Append<uint32>(buffer, ticks);
+    Append<uint32>(buffer, 20);                     // OptionalDataSize
+    Append<uint32>(buffer, uint32(sizeof(uint32) + data.size()));
+    buffer.push_back(ip);
+    buffer.insert(buffer.end(), 15, 0);
+    Append<uint32>(buffer, port);
+    Append<uint32>(buffer, opcode);
+    buffer.insert(buffer.end(), data.begin(), data.end());
+}
+
+std::string WriteLog(std::vector<uint8> const& buffer)
+{
+    std::string fileName = (std::filesystem::temp_directory_path() / "tc_packetlog_test.pkt").string();
+    FILE* file = fopen(fileName.c_str(), "wb");
+    REQUIRE(file);
+    fwrite(buffer.data(), 1, buffer.size(), file);
+    fclose(file);
+    return fileName;
+}
+}
+
+TEST_CASE("Packet log reader", "[PacketLog]")
+{
+    std::vector<uint8> buffer;
+    AppendLogHeader(buffer, 1000);
+    AppendPacket(buffer, 0x47534d43, 1250, 127, 50000, 0x1234, { 1, 2, 3 });
+    AppendPacket(buffer, 0x47534d53, 1300, 10, 8085, 0x2345, { });
+
+    std::vector<LoggedPacket> packets;
+    std::string error;
+
+    SECTION("reads every packet")
+    {
+        std::string fileName = WriteLog(buffer);
+        REQUIRE(PacketLogReader::Read(fileName, packets, error));
+        REQUIRE(packets.size() == 2);
+
+        REQUIRE(packets[0].PacketDirection == CLIENT_TO_SERVER);
+        REQUIRE(packets[0].ArrivalTicks == 250);
+        REQUIRE(packets[0].Address[0] == 127);
+        REQUIRE(packets[0].Port == 50000);
+        REQUIRE(packets[0].Opcode == 0x1234);
+        REQUIRE(packets[0].Data == std::vector<uint8>{ 1, 2, 3 });
+
+        REQUIRE(packets[1].PacketDirection == SERVER_TO_CLIENT);
+        REQUIRE(packets[1].ArrivalTicks == 300);
+        REQUIRE(packets[1].Data.empty());
+        std::filesystem::remove(fileName);
+    }
+
+    SECTION("reads compressed logs")
+    {
+        std::string fileName = (std::filesystem::temp_directory_path() / "tc_packetlog_test.pkt.gz").string();
+        gzFile file = gzopen(fileName.c_str(), "wb");
+        REQUIRE(file);
+        gzwrite(file, buffer.data(), unsigned(buffer.size()));
+        gzclose(file);
+
+        REQUIRE(PacketLogReader::Read(fileName, packets, error));
+        REQUIRE(packets.size() == 2);
+        REQUIRE(packets[0].Data == std::vector<uint8>{ 1, 2, 3 });
+        std::filesystem::remove(fileName);
+    }
+
+    SECTION("rejects truncated logs")
+    {
+        buffer.resize(buffer.size() - 2);
+        std::string fileName = WriteLog(buffer);
+        REQUIRE(!PacketLogReader::Read(fileName, packets, error));
+        REQUIRE(packets.size() == 1);
+        std::filesystem::remove(fileName);
+    }
+
+    SECTION("rejects other files")
+    {
+        buffer[0] = 'X';
+        std::string fileName = WriteLog(buffer);
+        REQUIRE(!PacketLogReader::Read(fileName, packets, error));
+        std::filesystem::remove(fileName);
+    }
+}
@@ -18,7 +18,10 @@
 #include "tc_catch2.h"
 
 #include "IteratorPair.h"
+#include <functional>
+#include <unordered_map>
 
+// the iterator ThreatManager used before, kept as reference for the benchmark
 class ThreatListIterator
 {
 private:
@@ -63,3 +66,108 @@ TEST_CASE("Check generator logic", "[ThreatListIterator]")
 
     REQUIRE(iterated == ints);
 }
+
+// same layout as ThreatManager::ThreatListIterator
+template<typename Iterator>
+class StorageThreatListIterator
+{
+private:
+    Iterator _itr;
+
+    static int const* Get(int const* value) { return value; }
+    static int const* Get(std::pair<int const, int*> const& entry) { return entry.second; }
+
+public:
+    explicit StorageThreatListIterator(Iterator itr) : _itr(itr) { }
+
+    int const* operator*() const { return Get(*_itr); }
+    int const* operator->() const { return Get(*_itr); }
+    StorageThreatListIterator& operator++() { ++_itr; return *this; }
+    bool operator==(StorageThreatListIterator const& o) const { return _itr == o._itr; }
+    bool operator!=(StorageThreatListIterator const& o) const { return _itr != o._itr; }
+};
+
+template<typename Container>
+auto MakeStorageThreatList(Container const& container)
+{
+    using Iterator = StorageThreatListIterator<typename Container::const_iterator>;
+    return Trinity::IteratorPair<Iterator>(Iterator(container.begin()), Iterator(container.end()));
+}
+
+template<typename Container>
+auto MakeGeneratorThreatList(Container const& container)
+{
+    auto itr = container.begin();
+    auto end = container.end();
+    std::function<int const* ()> generator = [itr, end]() mutable -> int const*
+    {
+        if (itr == end)
+            return nullptr;
+
+        if constexpr (std::is_pointer_v<typename Container::value_type>)
+            return *(itr++);
+        else
+            return (itr++)->second;
+    };
+    return Trinity::IteratorPair<ThreatListIterator, std::nullptr_t>(ThreatListIterator{ std::move(generator) }, nullptr);
+}
+
+TEST_CASE("Storage iterator visits the same entries", "[ThreatListIterator]")
+{
+    std::vector<int> values(40);
+    std::unordered_map<int, int*> entries;
+    std::vector<int const*> sorted;
+    for (int i = 0; i < int(values.size()); ++i)
+    {
+        values[i] = i;
+        entries[i] = &values[i];
+        sorted.push_back(&values[i]);
+    }
+
+    std::vector<int const*> fromGenerator;
+    for (int const* i : MakeGeneratorThreatList(entries))
+        fromGenerator.push_back(i);
+
+    std::vector<int const*> fromStorage;
+    for (int const* i : MakeStorageThreatList(entries))
+        fromStorage.push_back(i);
+
+    REQUIRE(fromStorage == fromGenerator);
+
+    fromStorage.clear();
+    for (int const* i : MakeStorageThreatList(sorted))
+        fromStorage.push_back(i);
+
+    REQUIRE(fromStorage == sorted);
+
+    std::vector<int*> empty;
+    REQUIRE(MakeStorageThreatList(empty).begin() == MakeStorageThreatList(empty).end());
+}
+
+TEST_CASE("Threat list iteration", "[.benchmark][ThreatListIterator]")
+{
+    // a raid on the threat list of a boss
+    std::vector<int> values(40);
+    std::unordered_map<int, int*> entries;
+    for (int i = 0; i < int(values.size()); ++i)
+    {
+        values[i] = i;
+        entries[i] = &values[i];
+    }
+
+    BENCHMARK("std::function generator")
+    {
+        int sum = 0;
+        for (int const* i : MakeGeneratorThreatList(entries))
+            sum += *i;
+        return sum;
+    };
+
+    BENCHMARK("storage iterator")
+    {
+        int sum = 0;
+        for (int const* i : MakeStorageThreatList(entries))
+            sum += *i;
+        return sum;
+    };
+}